@@ -0,0 +1,114 @@
+#ifndef CASM_config_CanonicalPrimitiveCache
+#define CASM_config_CanonicalPrimitiveCache
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Least recently used cache of canonical primitive configurations
+///
+/// The canonical primitive configuration,
+/// `make_in_canonical_supercell(make_primitive(configuration))`, is the same
+/// for all configurations that are equivalent as infinite crystals, in any
+/// supercell, so it can be used for supercell-independent duplicate
+/// detection. A CanonicalPrimitiveCache finds it once for each distinct
+/// primitive configuration and shares the result as an immutable
+/// Configuration. Tilings of one primitive configuration into many
+/// supercells then only require `make_primitive`.
+///
+/// `make_canonical_form` also uses the primitive configuration to find the
+/// canonical form in the configuration's own supercell, by
+/// `make_canonical_form_via_primitive`, so duplicate detection and
+/// canonicalization share one `make_primitive`.
+///
+/// Notes:
+/// - The key is the primitive configuration, as found by `make_primitive`.
+///   Entries hold their key, so they keep the prim and supercell alive.
+/// - If more than `max_size()` entries are held, or more memory is used
+///   than allowed by the memory budget (see `set_memory_budget`), least
+///   recently used entries are evicted. Held results remain valid after
+///   eviction.
+/// - Thread-safe. Canonical primitive configurations are found outside of
+///   the lock, so concurrent requests for the same new key may each find
+///   it, and the first stored result is returned to all.
+class CanonicalPrimitiveCache {
+ public:
+  CanonicalPrimitiveCache(Index _max_size = 100000);
+
+  /// \brief Return the canonical primitive configuration, in the canonical
+  ///     supercell
+  std::shared_ptr<Configuration const> canonical_primitive(
+      Configuration const &configuration);
+
+  /// \brief Return the canonical primitive configuration, in the canonical
+  ///     supercell, of a primitive configuration
+  std::shared_ptr<Configuration const> canonical_primitive_of_primitive(
+      Configuration const &primitive);
+
+  /// \brief Return the canonical form of a configuration in its supercell,
+  ///     and its canonical primitive configuration
+  std::pair<Configuration, std::shared_ptr<Configuration const>>
+  make_canonical_form(Configuration const &configuration);
+
+  /// \brief Maximum number of entries
+  Index max_size() const;
+
+  /// \brief Set the maximum number of entries
+  void set_max_size(Index _max_size);
+
+  /// \brief Number of cached canonical primitive configurations
+  Index size() const;
+
+  /// \brief Memory used by cached entries, in bytes (approximate)
+  Index total_bytes() const;
+
+  /// \brief Evict least recently used entries until the memory used by
+  ///     cached entries is at most `max_total_bytes`
+  Index evict_to(Index max_total_bytes);
+
+  /// \brief Clear all cached canonical primitive configurations
+  void clear();
+
+ private:
+  /// Prim pointers are compared first, so configurations with different
+  /// prim are never compared
+  typedef std::pair<Prim const *, Configuration> key_type;
+
+  struct Entry {
+    key_type key;
+    std::shared_ptr<Configuration const> value;
+
+    /// Memory used by the entry, in bytes (approximate)
+    Index bytes;
+  };
+
+  /// \brief Evict least recently used entries, requires holding m_mutex
+  void _evict();
+
+  mutable std::mutex m_mutex;
+
+  Index m_max_size;
+
+  Index m_total_bytes;
+
+  /// Entries, most recently used first
+  std::list<Entry> m_lru;
+
+  std::map<key_type, std::list<Entry>::iterator> m_index;
+};
+
+/// \brief Process-wide CanonicalPrimitiveCache
+CanonicalPrimitiveCache &default_canonical_primitive_cache();
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
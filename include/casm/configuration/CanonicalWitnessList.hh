@@ -0,0 +1,112 @@
+#ifndef CASM_config_CanonicalWitnessList
+#define CASM_config_CanonicalWitnessList
+
+#include <algorithm>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Recent witnesses of non-canonical configurations, in
+///     move-to-front order
+///
+/// When checking many similar configurations in a row, such as in
+/// ConfigEnumAllOccupations order, the operation showing one configuration
+/// is not canonical (the "witness", which makes a greater configuration)
+/// often shows the next is not canonical either. A CanonicalWitnessList
+/// holds the indices, into a fixed group of operations, of the most recent
+/// witnesses, and `find` tries them first, before scanning the group.
+///
+/// Example:
+/// \code
+/// CanonicalWitnessList recent;
+/// for (...) {
+///   auto it = find_non_canonical_witness(configuration, group.begin(),
+///                                        group.end(), recent);
+///   bool is_canonical = (it == group.end());
+/// }
+/// \endcode
+///
+/// Notes:
+/// - Indices are only meaningful for one group; call `clear` if the group
+///   changes
+/// - Not thread safe; use one CanonicalWitnessList per thread
+class CanonicalWitnessList {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _max_size Maximum number of recent witnesses kept
+  explicit CanonicalWitnessList(Index _max_size = 4)
+      : m_max_size(_max_size), m_n_hits(0), m_n_scans(0) {}
+
+  /// \brief Return the index of a witness in `[0, n)`, trying recent
+  ///     witnesses first, or -1 if there is none
+  template <typename IsWitness>
+  Index find(Index n, IsWitness &&is_witness);
+
+  /// \brief Recent witness indices, most recent first
+  std::vector<Index> const &indices() const { return m_indices; }
+
+  /// \brief Number of `find` calls that found a recent witness
+  Index n_hits() const { return m_n_hits; }
+
+  /// \brief Number of `find` calls that scanned the group
+  Index n_scans() const { return m_n_scans; }
+
+  /// \brief Remove all recent witnesses
+  void clear() { m_indices.clear(); }
+
+ private:
+  Index m_max_size;
+
+  std::vector<Index> m_indices;
+
+  Index m_n_hits;
+
+  Index m_n_scans;
+};
+
+/// \brief Return the index of a witness in `[0, n)`, trying recent
+///     witnesses first, or -1 if there is none
+///
+/// \param n Size of the group of operations
+/// \param is_witness Function with signature `bool is_witness(Index i)`,
+///     which returns true if operation `i` is a witness
+///
+/// \returns If a recent witness `i` satisfies `is_witness(i)`, it is moved
+///     to the front and returned. Otherwise, returns the first `i` in `[0,
+///     n)` satisfying `is_witness(i)`, which is added to the front, or -1 if
+///     there is none. Recent witnesses are not tested twice.
+template <typename IsWitness>
+Index CanonicalWitnessList::find(Index n, IsWitness &&is_witness) {
+  for (auto it = m_indices.begin(); it != m_indices.end(); ++it) {
+    if (*it < n && is_witness(*it)) {
+      std::rotate(m_indices.begin(), it, it + 1);
+      ++m_n_hits;
+      return m_indices.front();
+    }
+  }
+  ++m_n_scans;
+  for (Index i = 0; i < n; ++i) {
+    if (std::find(m_indices.begin(), m_indices.end(), i) != m_indices.end()) {
+      continue;
+    }
+    if (is_witness(i)) {
+      if (m_max_size > 0) {
+        if (m_indices.size() >= m_max_size) {
+          m_indices.pop_back();
+        }
+        m_indices.insert(m_indices.begin(), i);
+      }
+      return i;
+    }
+  }
+  return -1;
+}
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
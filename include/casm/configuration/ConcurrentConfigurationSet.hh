@@ -0,0 +1,111 @@
+#ifndef CASM_config_ConcurrentConfigurationSet
+#define CASM_config_ConcurrentConfigurationSet
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Thread-safe data structure for inserting canonical configurations
+///     from multiple threads
+///
+/// Configurations are held in a number of shards, each a ConfigurationSet
+/// protected by its own mutex. A configuration is held in the shard
+/// selected by its supercell_name, so all configurations in one supercell,
+/// and the next configuration id for that supercell, are in the same
+/// shard. Threads inserting into different supercells rarely contend.
+///
+/// Notes:
+/// - Has the same usage requirements as ConfigurationSet: configurations
+///   must be in canonical supercells
+/// - If each supercell is only inserted into by one thread at a time, in a
+///   deterministic order, then configuration ids are deterministic
+/// - Use `to_configuration_set` to collect the results once all insertions
+///   are complete
+class ConcurrentConfigurationSet {
+ public:
+  ConcurrentConfigurationSet(std::map<std::string, Index> _next_config_id = {},
+                             Index n_shards = 64);
+
+  typedef ConfigurationSet::size_type size_type;
+
+  /// \brief Insert Configuration, setting supercell_name and
+  ///     configuration_id automatically
+  std::pair<std::string, bool> insert(Configuration const &configuration);
+
+  /// \brief Insert Configuration with known supercell_name, setting
+  ///     configuration_id automatically
+  std::pair<std::string, bool> insert(std::string const &supercell_name,
+                                      Configuration const &configuration);
+
+  /// \brief Insert ConfigurationRecord, allowing custom configuration_id
+  bool insert(ConfigurationRecord const &record);
+
+  size_type count(Configuration const &configuration) const;
+
+  size_type size() const;
+
+  /// \brief Copy all configurations and next configuration ids into a
+  ///     ConfigurationSet
+  ConfigurationSet to_configuration_set() const;
+
+ private:
+  struct Shard {
+    mutable std::mutex mutex;
+    ConfigurationSet configurations;
+  };
+
+  Shard &_shard(std::string const &supercell_name) const;
+
+  std::vector<std::unique_ptr<Shard>> m_shards;
+};
+
+/// \brief Thread-safe data structure for inserting supercells from
+///     multiple threads
+///
+/// Wraps a SupercellSet with a mutex. Supercells and records are
+/// constructed outside of the lock, so only the set update is serialized.
+/// Returned pointers remain valid for the lifetime of the
+/// ConcurrentSupercellSet.
+class ConcurrentSupercellSet {
+ public:
+  ConcurrentSupercellSet(std::shared_ptr<Prim const> const &_prim);
+
+  typedef SupercellSet::size_type size_type;
+
+  std::shared_ptr<Prim const> prim() const;
+
+  std::pair<SupercellRecord const *, bool> insert(
+      std::shared_ptr<Supercell const> supercell);
+
+  std::pair<SupercellRecord const *, bool> insert(
+      Eigen::Matrix3l const &transformation_matrix_to_super);
+
+  std::pair<SupercellRecord const *, bool> insert_canonical(
+      std::string supercell_name);
+
+  /// \brief Find a canonical supercell by name, or return nullptr
+  SupercellRecord const *find_canonical_by_name(std::string name) const;
+
+  size_type size() const;
+
+  /// \brief Access the underlying SupercellSet; not safe during concurrent
+  ///     insertion
+  SupercellSet const &data() const;
+
+ private:
+  mutable std::mutex m_mutex;
+  SupercellSet m_supercells;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -13,6 +13,10 @@ class ConfigCompare {
  public:
   explicit ConfigCompare(ConfigIsEquivalent const &_eq) : m_eq(_eq) {}
 
+  /// \brief Compare against another configuration in the same supercell,
+  ///     without reallocating (see ConfigIsEquivalent::rebind)
+  void rebind(Configuration const &_config) { m_eq.rebind(_config); }
+
   template <typename... Args>
   bool operator()(Args &&...args) const {
     if (m_eq(std::forward<Args>(args)...)) {
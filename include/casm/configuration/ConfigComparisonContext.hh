@@ -0,0 +1,120 @@
+#ifndef CASM_config_ConfigComparisonContext
+#define CASM_config_ConfigComparisonContext
+
+#include <set>
+#include <string>
+#include <utility>
+
+#include "casm/configuration/ConfigIsEquivalent.hh"
+
+namespace CASM {
+namespace config {
+
+class ConfigComparisonContext;
+
+/// \brief Immutable definition of a Configuration comparison, which may be
+///     shared between threads
+///
+/// ConfigIsEquivalent and ConfigCompare hold temporary storage (transformed
+/// DoF values and the last "less than" result) that their const call
+/// operators update, so one comparator must not be used by more than one
+/// thread at a time. A ConfigComparisonDefinition selects the compared DoF
+/// and comparator once, and is not modified after construction, so it may
+/// be shared. Each thread makes its own ConfigComparisonContext, which owns
+/// a copy of the comparator and its temporary storage.
+///
+/// Example:
+/// \code
+/// ConfigComparisonDefinition definition(configuration);
+/// parallel_for_chunks(n, n_threads, [&](Index c, Index begin, Index end) {
+///   ConfigComparisonContext context = definition.make_context();
+///   for (Index i = begin; i < end; ++i) {
+///     if (context.less(ops[i])) { ... }
+///   }
+/// });
+/// \endcode
+///
+/// Notes:
+/// - The configuration must outlive the definition and its contexts
+/// - Making a context copies the comparator, without repeating DoF
+///   selection or looking up the supercell's CombinedPermutationTable
+class ConfigComparisonDefinition {
+ public:
+  /// \brief Constructor
+  ConfigComparisonDefinition(Configuration const &_config, double _tol,
+                             std::set<std::string> const &_which_dofs = {
+                                 "all"})
+      : m_prototype(_config, _tol, _which_dofs) {}
+
+  /// \brief Constructor, using the prim lattice tolerance
+  ConfigComparisonDefinition(Configuration const &_config,
+                             std::set<std::string> const &_which_dofs = {
+                                 "all"})
+      : m_prototype(_config, _which_dofs) {}
+
+  /// \brief The configuration compared against
+  Configuration const &config() const { return m_prototype.config(); }
+
+  /// \brief Make a context, for use by one thread at a time
+  ConfigComparisonContext make_context() const;
+
+ private:
+  friend class ConfigComparisonContext;
+
+  /// Copied by each context, never called
+  ConfigIsEquivalent m_prototype;
+};
+
+/// \brief Comparison of Configurations, owning the temporary storage used
+///     by one thread
+///
+/// Comparison methods are not const, because they update the temporary
+/// storage. Arguments are the same as the ConfigIsEquivalent call operators.
+class ConfigComparisonContext {
+ public:
+  /// \brief Constructor
+  explicit ConfigComparisonContext(
+      ConfigComparisonDefinition const &_definition)
+      : m_equal_to(_definition.m_prototype) {}
+
+  /// \brief The configuration compared against
+  Configuration const &config() const { return m_equal_to.config(); }
+
+  /// \brief Return true if equivalent (i.e. `config == other`,
+  ///     `A*config == B*config`)
+  template <typename... Args>
+  bool equal(Args &&...args) {
+    return m_equal_to(std::forward<Args>(args)...);
+  }
+
+  /// \brief Return true if less than (i.e. `config < other`,
+  ///     `A*config < B*config`)
+  template <typename... Args>
+  bool less(Args &&...args) {
+    if (m_equal_to(std::forward<Args>(args)...)) {
+      return false;
+    }
+    return m_equal_to.is_less();
+  }
+
+  /// \brief Call `f(comparator)` with the selected comparator (see
+  ///     ConfigIsEquivalent::visit)
+  template <typename F>
+  decltype(auto) visit(F &&f) {
+    return m_equal_to.visit(std::forward<F>(f));
+  }
+
+ private:
+  ConfigIsEquivalent m_equal_to;
+};
+
+/// \brief Make a context, for use by one thread at a time
+inline ConfigComparisonContext ConfigComparisonDefinition::make_context()
+    const {
+  return ConfigComparisonContext(*this);
+}
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
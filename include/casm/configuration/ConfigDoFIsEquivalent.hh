@@ -11,16 +11,88 @@ namespace CASM {
 namespace config {
 
 /// Namespace containing DoF comparison functors
+///
+/// The functors store the last "less than" result, and some store
+/// transformed DoF values, in mutable members updated by the const call
+/// operators, so each functor must be used by one thread at a time (see
+/// ConfigComparisonContext).
 namespace ConfigDoFIsEquivalent {
 
+/// Evaluates `op.permute_index(i)`, using a CombinedPermutationTable if
+/// provided
+///
+/// - With a table, this is a single lookup into a contiguous row, by
+///   compressed active site index if not all sites are active, of the
+///   compact integer type used by the table
+/// - Sites that are not active are evaluated by `op.permute_index(i)`
+/// - The table, if provided, must be for the supercell of `op`
+class PermuteIndex {
+ public:
+  PermuteIndex(SupercellSymOp const &_op,
+               CombinedPermutationTable const *_combined_permutations)
+      : m_op(&_op),
+        m_has_permutation(false),
+        m_permutation(nullptr, nullptr, 0),
+        m_active_index(nullptr) {
+    if (_combined_permutations) {
+      m_has_permutation = true;
+      m_permutation = _combined_permutations->permutation(
+          _op.supercell_factor_group_index() *
+              _combined_permutations->n_translations() +
+          _op.translation_index());
+      if (!_combined_permutations->all_active()) {
+        m_active_index = _combined_permutations->active_index().data();
+      }
+    }
+  }
+
+  Index operator()(Index i) const {
+    if (!m_has_permutation) {
+      return m_op->permute_index(i);
+    }
+    if (!m_active_index) {
+      return m_permutation[i];
+    }
+    std::int32_t k = m_active_index[i];
+    return k >= 0 ? m_permutation[k] : m_op->permute_index(i);
+  }
+
+ private:
+  SupercellSymOp const *m_op;
+  bool m_has_permutation;
+  sym_info::PermutationTable::Row m_permutation;
+  std::int32_t const *m_active_index;
+};
+
+/// Return the site index ranges `[begin, end)` compared by Occupation,
+/// AnisoOccupation, and Local: `_site_ranges` if provided, else all sites
+inline std::vector<std::pair<Index, Index>> make_site_compare_ranges(
+    Index n_sites,
+    std::optional<std::vector<std::pair<Index, Index>>> const &_site_ranges) {
+  if (_site_ranges.has_value()) {
+    return *_site_ranges;
+  }
+  return {{0, n_sites}};
+}
+
 /// Compare isotropic occupation values
 ///
 /// - The protected '_check' method provides for both checking equality and if
 ///   not equivalent, storing the 'less than' result
+/// - If `_site_ranges` are provided, only sites in those ranges are compared,
+///   sublattice block by sublattice block. Use
+///   `make_occupation_site_ranges` to skip sublattices with a single allowed
+///   occupant, which can never differ.
 class Occupation {
  public:
-  Occupation(Eigen::VectorXi const &_occupation)
-      : m_occupation_ptr(&_occupation) {}
+  Occupation(Eigen::VectorXi const &_occupation,
+             CombinedPermutationTable const *_combined_permutations = nullptr,
+             std::optional<std::vector<std::pair<Index, Index>>> const
+                 &_site_ranges = std::nullopt)
+      : m_occupation_ptr(&_occupation),
+        m_combined_permutations(_combined_permutations),
+        m_site_ranges(
+            make_site_compare_ranges(_occupation.size(), _site_ranges)) {}
 
   /// \brief Return config == other, store config < other
   bool operator()(Eigen::VectorXi const &other) const {
@@ -30,30 +102,44 @@ class Occupation {
 
   /// \brief Return config == A*config, store config < A*config
   bool operator()(SupercellSymOp const &A) const {
-    return _for_each(
-        [&](Index i) { return (*m_occupation_ptr)[i]; },
-        [&](Index i) { return (*m_occupation_ptr)[A.permute_index(i)]; });
+    PermuteIndex pA(A, m_combined_permutations);
+    return _for_each([&](Index i) { return (*m_occupation_ptr)[i]; },
+                     [&](Index i) { return (*m_occupation_ptr)[pA(i)]; });
   }
 
   /// \brief Return A*config == B*config, store A*config < B*config
   bool operator()(SupercellSymOp const &A, SupercellSymOp const &B) const {
-    return _for_each(
-        [&](Index i) { return (*m_occupation_ptr)[A.permute_index(i)]; },
-        [&](Index i) { return (*m_occupation_ptr)[B.permute_index(i)]; });
+    PermuteIndex pA(A, m_combined_permutations);
+    PermuteIndex pB(B, m_combined_permutations);
+    return _for_each([&](Index i) { return (*m_occupation_ptr)[pA(i)]; },
+                     [&](Index i) { return (*m_occupation_ptr)[pB(i)]; });
   }
 
   /// \brief Return config == A*other, store config < A*other
   bool operator()(SupercellSymOp const &A, Eigen::VectorXi const &other) const {
+    PermuteIndex pA(A, m_combined_permutations);
     return _for_each([&](Index i) { return (*m_occupation_ptr)[i]; },
-                     [&](Index i) { return other[A.permute_index(i)]; });
+                     [&](Index i) { return other[pA(i)]; });
   }
 
   /// \brief Return A*config == B*other, store A*config < B*other
   bool operator()(SupercellSymOp const &A, SupercellSymOp const &B,
                   Eigen::VectorXi const &other) const {
-    return _for_each(
-        [&](Index i) { return (*m_occupation_ptr)[A.permute_index(i)]; },
-        [&](Index i) { return other[B.permute_index(i)]; });
+    PermuteIndex pA(A, m_combined_permutations);
+    PermuteIndex pB(B, m_combined_permutations);
+    return _for_each([&](Index i) { return (*m_occupation_ptr)[pA(i)]; },
+                     [&](Index i) { return other[pB(i)]; });
+  }
+
+  /// \brief Set the combined permutations for the supercell, or nullptr
+  void set_combined_permutations(
+      CombinedPermutationTable const *_combined_permutations) {
+    m_combined_permutations = _combined_permutations;
+  }
+
+  /// \brief Compare against other occupation values, of the same size
+  void rebind(Eigen::VectorXi const &_occupation) {
+    m_occupation_ptr = &_occupation;
   }
 
   /// \brief Returns less than comparison
@@ -64,10 +150,11 @@ class Occupation {
  protected:
   template <typename F, typename G>
   bool _for_each(F f, G g) const {
-    Index i;
-    for (i = 0; i < m_occupation_ptr->size(); i++) {
-      if (!_check(f(i), g(i))) {
-        return false;
+    for (auto const &range : m_site_ranges) {
+      for (Index i = range.first; i < range.second; i++) {
+        if (!_check(f(i), g(i))) {
+          return false;
+        }
       }
     }
     return true;
@@ -85,6 +172,12 @@ class Occupation {
 
   Eigen::VectorXi const *m_occupation_ptr;
 
+  // Combined permutations for the supercell, or nullptr
+  CombinedPermutationTable const *m_combined_permutations;
+
+  // Ranges of site indices compared
+  std::vector<std::pair<Index, Index>> m_site_ranges;
+
   /// Stores (A < B) if A != B
   mutable bool m_less;
 };
@@ -93,6 +186,8 @@ class Occupation {
 ///
 /// - The protected '_check' method provides for both checking equality and if
 ///   not equivalent, storing the 'less than' result
+/// - If `_site_ranges` are provided, only sites in those ranges are compared,
+///   as for Occupation
 ///
 /// Method:
 /// - To improve efficiency when comparisons are being made repeatedly under
@@ -106,10 +201,17 @@ class Occupation {
 ///   is called because it cannot be guaranteed that the "other" is the same.
 class AnisoOccupation {
  public:
-  AnisoOccupation(Eigen::VectorXi const &_occupation, Index n_sublat)
+  AnisoOccupation(
+      Eigen::VectorXi const &_occupation, Index n_sublat,
+      CombinedPermutationTable const *_combined_permutations = nullptr,
+      std::optional<std::vector<std::pair<Index, Index>>> const &_site_ranges =
+          std::nullopt)
       : m_n_sublat(n_sublat),
         m_n_vol(_occupation.size() / m_n_sublat),
         m_occupation_ptr(&_occupation),
+        m_combined_permutations(_combined_permutations),
+        m_site_ranges(
+            make_site_compare_ranges(_occupation.size(), _site_ranges)),
         m_tmp_valid(true),
         m_fg_index_A(0),
         m_new_occ_A(_occupation),
@@ -124,45 +226,64 @@ class AnisoOccupation {
 
   /// \brief Return config == B*config, store config < B*config
   bool operator()(SupercellSymOp const &B) const {
+    PermuteIndex pB(B, m_combined_permutations);
     _update_B(B, *m_occupation_ptr);
     m_tmp_valid = true;
 
-    return _for_each(
-        [&](Index i) { return (*m_occupation_ptr)[i]; },
-        [&](Index i) { return this->m_new_occ_B[B.permute_index(i)]; });
+    return _for_each([&](Index i) { return (*m_occupation_ptr)[i]; },
+                     [&](Index i) { return this->m_new_occ_B[pB(i)]; });
   }
 
   /// \brief Return A*config == B*config, store A*config < B*config
   bool operator()(SupercellSymOp const &A, SupercellSymOp const &B) const {
+    PermuteIndex pA(A, m_combined_permutations);
+    PermuteIndex pB(B, m_combined_permutations);
     _update_A(A, *m_occupation_ptr);
     _update_B(B, *m_occupation_ptr);
     m_tmp_valid = true;
 
-    return _for_each(
-        [&](Index i) { return this->m_new_occ_A[A.permute_index(i)]; },
-        [&](Index i) { return this->m_new_occ_B[B.permute_index(i)]; });
+    return _for_each([&](Index i) { return this->m_new_occ_A[pA(i)]; },
+                     [&](Index i) { return this->m_new_occ_B[pB(i)]; });
   }
 
   /// \brief Return config == B*other, store config < B*other
   bool operator()(SupercellSymOp const &B, Eigen::VectorXi const &other) const {
+    PermuteIndex pB(B, m_combined_permutations);
     _update_B(B, other);
     m_tmp_valid = false;
 
-    return _for_each(
-        [&](Index i) { return (*m_occupation_ptr)[i]; },
-        [&](Index i) { return this->m_new_occ_B[B.permute_index(i)]; });
+    return _for_each([&](Index i) { return (*m_occupation_ptr)[i]; },
+                     [&](Index i) { return this->m_new_occ_B[pB(i)]; });
   }
 
   /// \brief Return A*config == B*other, store A*config < B*other
   bool operator()(SupercellSymOp const &A, SupercellSymOp const &B,
                   Eigen::VectorXi const &other) const {
+    PermuteIndex pA(A, m_combined_permutations);
+    PermuteIndex pB(B, m_combined_permutations);
     _update_A(A, *m_occupation_ptr);
     _update_B(B, other);
     m_tmp_valid = false;
 
-    return _for_each(
-        [&](Index i) { return this->m_new_occ_A[A.permute_index(i)]; },
-        [&](Index i) { return this->m_new_occ_B[B.permute_index(i)]; });
+    return _for_each([&](Index i) { return this->m_new_occ_A[pA(i)]; },
+                     [&](Index i) { return this->m_new_occ_B[pB(i)]; });
+  }
+
+  /// \brief Set the combined permutations for the supercell, or nullptr
+  void set_combined_permutations(
+      CombinedPermutationTable const *_combined_permutations) {
+    m_combined_permutations = _combined_permutations;
+  }
+
+  /// \brief Compare against other occupation values, of the same size,
+  ///     re-using the temporary vectors
+  void rebind(Eigen::VectorXi const &_occupation) {
+    m_occupation_ptr = &_occupation;
+    m_tmp_valid = true;
+    m_fg_index_A = 0;
+    m_new_occ_A = _occupation;
+    m_fg_index_B = 0;
+    m_new_occ_B = _occupation;
   }
 
   /// \brief Returns less than comparison
@@ -173,48 +294,48 @@ class AnisoOccupation {
  protected:
   template <typename F, typename G>
   bool _for_each(F f, G g) const {
-    Index i;
-    for (i = 0; i < m_occupation_ptr->size(); i++) {
-      if (!_check(f(i), g(i))) {
-        return false;
+    for (auto const &range : m_site_ranges) {
+      for (Index i = range.first; i < range.second; i++) {
+        if (!_check(f(i), g(i))) {
+          return false;
+        }
       }
     }
     return true;
   }
 
+  /// Set `after[l]` to the occupant index `before[l]` transformed by the
+  /// factor group operation of `op`, for sites in m_site_ranges
+  ///
+  /// Site ranges are whole sublattices, so each sublattice block is a
+  /// contiguous lookup into one row of `PrimSymInfo::occ_remap_table`.
+  void _remap(SupercellSymOp const &op, Eigen::VectorXi const &before,
+              Eigen::VectorXi &after) const {
+    PrimSymInfo const &prim_sym_info = op.supercell()->prim->sym_info;
+    Index prim_fg_index = op.prim_factor_group_index();
+    for (auto const &range : m_site_ranges) {
+      for (Index b = range.first / m_n_vol; b < range.second / m_n_vol; ++b) {
+        std::int32_t const *remap = prim_sym_info.occ_remap(prim_fg_index, b);
+        int const *in = before.data() + b * m_n_vol;
+        int *out = after.data() + b * m_n_vol;
+        for (Index n = 0; n < m_n_vol; ++n) {
+          out[n] = remap[in[n]];
+        }
+      }
+    }
+  }
+
   void _update_A(SupercellSymOp const &A, Eigen::VectorXi const &before) const {
     if (A.supercell_factor_group_index() != m_fg_index_A || !m_tmp_valid) {
       m_fg_index_A = A.supercell_factor_group_index();
-      Index l = 0;
-      PrimSymInfo const &prim_sym_info = A.supercell()->prim->sym_info;
-      SupercellSymInfo const &supercell_sym_info = A.supercell()->sym_info;
-      Index prim_fg_index =
-          supercell_sym_info.factor_group->head_group_index[m_fg_index_A];
-      for (Index b = 0; b < m_n_sublat; ++b) {
-        sym_info::Permutation const &occ_perm =
-            prim_sym_info.occ_symgroup_rep[prim_fg_index][b];
-        for (Index n = 0; n < m_n_vol; ++n, ++l) {
-          m_new_occ_A[l] = occ_perm[before[l]];
-        }
-      }
+      _remap(A, before, m_new_occ_A);
     }
   }
 
   void _update_B(SupercellSymOp const &B, Eigen::VectorXi const &before) const {
     if (B.supercell_factor_group_index() != m_fg_index_B || !m_tmp_valid) {
       m_fg_index_B = B.supercell_factor_group_index();
-      Index l = 0;
-      PrimSymInfo const &prim_sym_info = B.supercell()->prim->sym_info;
-      SupercellSymInfo const &supercell_sym_info = B.supercell()->sym_info;
-      Index prim_fg_index =
-          supercell_sym_info.factor_group->head_group_index[m_fg_index_B];
-      for (Index b = 0; b < m_n_sublat; ++b) {
-        sym_info::Permutation const &occ_perm =
-            prim_sym_info.occ_symgroup_rep[prim_fg_index][b];
-        for (Index n = 0; n < m_n_vol; ++n, ++l) {
-          m_new_occ_B[l] = occ_perm[before[l]];
-        }
-      }
+      _remap(B, before, m_new_occ_B);
     }
   }
 
@@ -235,6 +356,12 @@ class AnisoOccupation {
   // Points to ConfigDoF this was constructed with
   Eigen::VectorXi const *m_occupation_ptr;
 
+  // Combined permutations for the supercell, or nullptr
+  CombinedPermutationTable const *m_combined_permutations;
+
+  // Ranges of site indices compared
+  std::vector<std::pair<Index, Index>> m_site_ranges;
+
   // Set to false when comparison is made to "other" ConfigDoF, to force update
   // of temporary dof during the next comparison
   mutable bool m_tmp_valid;
@@ -263,15 +390,24 @@ class AnisoOccupation {
 ///   comparison is made against an "other" ConfigDoF to force update of the
 ///   transformed variables in the temporary vectors the next time the functor
 ///   is called because it cannot be guaranteed that the "other" is the same.
+/// - If `_site_ranges` are provided, only sites in those ranges are compared.
+///   Use `make_local_dof_site_ranges` to skip sublattices without this DoF
+///   type, which have no values.
 class Local {
  public:
   Local(Eigen::MatrixXd const &_values, DoFKey const &_key, Index n_sublat,
-        double _tol)
+        double _tol,
+        CombinedPermutationTable const *_combined_permutations = nullptr,
+        std::optional<std::vector<std::pair<Index, Index>>> const
+            &_site_ranges = std::nullopt)
       : m_values_ptr(&_values),
         m_key(_key),
+        m_dof_id(-1),
         m_n_sublat(n_sublat),
         m_n_vol(_values.cols() / n_sublat),
         m_tol(_tol),
+        m_combined_permutations(_combined_permutations),
+        m_site_ranges(make_site_compare_ranges(_values.cols(), _site_ranges)),
         m_tmp_valid(true),
         m_fg_index_A(0),
         m_new_dof_A(*m_values_ptr),
@@ -286,56 +422,79 @@ class Local {
 
   /// \brief Return config == B*config, store config < B*config
   bool operator()(SupercellSymOp const &B) const {
+    PermuteIndex pB(B, m_combined_permutations);
     _update_B(B, _values());
     m_tmp_valid = true;
 
     return _for_each([&](Index i, Index j) { return this->_values()(i, j); },
                      [&](Index i, Index j) {
-                       return this->new_dof_B(i, B.permute_index(j));
+                       return this->new_dof_B(i, pB(j));
                      });
   }
 
   /// \brief Return A*config == B*config, store A*config < B*config
   bool operator()(SupercellSymOp const &A, SupercellSymOp const &B) const {
+    PermuteIndex pA(A, m_combined_permutations);
+    PermuteIndex pB(B, m_combined_permutations);
     _update_A(A, _values());
     _update_B(B, _values());
     m_tmp_valid = true;
     return _for_each(
         [&](Index i, Index j) {
-          return this->new_dof_A(i, A.permute_index(j));
+          return this->new_dof_A(i, pA(j));
         },
         [&](Index i, Index j) {
-          return this->new_dof_B(i, B.permute_index(j));
+          return this->new_dof_B(i, pB(j));
         });
   }
 
   /// \brief Return config == B*other, store config < B*other
   bool operator()(SupercellSymOp const &B, Eigen::MatrixXd const &other) const {
+    PermuteIndex pB(B, m_combined_permutations);
     _update_B(B, other);
     m_tmp_valid = false;
 
     return _for_each([&](Index i, Index j) { return this->_values()(i, j); },
                      [&](Index i, Index j) {
-                       return this->new_dof_B(i, B.permute_index(j));
+                       return this->new_dof_B(i, pB(j));
                      });
   }
 
   /// \brief Return A*config == B*other, store A*config < B*other
   bool operator()(SupercellSymOp const &A, SupercellSymOp const &B,
                   Eigen::MatrixXd const &other) const {
+    PermuteIndex pA(A, m_combined_permutations);
+    PermuteIndex pB(B, m_combined_permutations);
     _update_A(A, _values());
     _update_B(B, other);
     m_tmp_valid = false;
 
     return _for_each(
         [&](Index i, Index j) {
-          return this->new_dof_A(i, A.permute_index(j));
+          return this->new_dof_A(i, pA(j));
         },
         [&](Index i, Index j) {
-          return this->new_dof_B(i, B.permute_index(j));
+          return this->new_dof_B(i, pB(j));
         });
   }
 
+  /// \brief Set the combined permutations for the supercell, or nullptr
+  void set_combined_permutations(
+      CombinedPermutationTable const *_combined_permutations) {
+    m_combined_permutations = _combined_permutations;
+  }
+
+  /// \brief Compare against other DoF values, of the same shape, re-using
+  ///     the temporary matrices
+  void rebind(Eigen::MatrixXd const &_values) {
+    m_values_ptr = &_values;
+    m_tmp_valid = true;
+    m_fg_index_A = 0;
+    m_new_dof_A = _values;
+    m_fg_index_B = 0;
+    m_new_dof_B = _values;
+  }
+
   /// \brief Returns less than comparison
   ///
   /// - Only valid after call operator returns false
@@ -349,13 +508,17 @@ class Local {
     if (A.supercell_factor_group_index() != m_fg_index_A || !m_tmp_valid) {
       PrimSymInfo const &prim_sym_info = A.supercell()->prim->sym_info;
       m_fg_index_A = A.supercell_factor_group_index();
-      SupercellSymInfo const &supercell_sym_info = A.supercell()->sym_info;
+      SupercellSymInfo const &supercell_sym_info = A.supercell()->sym_info();
       Index prim_fg_index =
           supercell_sym_info.factor_group->head_group_index[m_fg_index_A];
+      if (m_dof_id == -1) {
+        m_dof_id = prim_sym_info.local_dof_id(m_key);
+      }
       for (Index b = 0; b < m_n_sublat; ++b) {
-        Eigen::MatrixXd const &M =
-            prim_sym_info.local_dof_symgroup_rep.at(m_key)[prim_fg_index][b];
-        Index dim = M.cols();
+        Index dim = prim_sym_info.local_dof_dim(m_dof_id, b);
+        if (dim == 0) continue;
+        Eigen::Map<Eigen::MatrixXd const> M =
+            prim_sym_info.local_dof_rep(m_dof_id, prim_fg_index, b);
         sublattice_block(m_new_dof_A, b, m_n_vol).topRows(dim) =
             M * sublattice_block(before, b, m_n_vol).topRows(dim);
       }
@@ -367,13 +530,17 @@ class Local {
     if (B.supercell_factor_group_index() != m_fg_index_B || !m_tmp_valid) {
       PrimSymInfo const &prim_sym_info = B.supercell()->prim->sym_info;
       m_fg_index_B = B.supercell_factor_group_index();
-      SupercellSymInfo const &supercell_sym_info = B.supercell()->sym_info;
+      SupercellSymInfo const &supercell_sym_info = B.supercell()->sym_info();
       Index prim_fg_index =
           supercell_sym_info.factor_group->head_group_index[m_fg_index_B];
+      if (m_dof_id == -1) {
+        m_dof_id = prim_sym_info.local_dof_id(m_key);
+      }
       for (Index b = 0; b < m_n_sublat; ++b) {
-        Eigen::MatrixXd const &M =
-            prim_sym_info.local_dof_symgroup_rep.at(m_key)[prim_fg_index][b];
-        Index dim = M.cols();
+        Index dim = prim_sym_info.local_dof_dim(m_dof_id, b);
+        if (dim == 0) continue;
+        Eigen::Map<Eigen::MatrixXd const> M =
+            prim_sym_info.local_dof_rep(m_dof_id, prim_fg_index, b);
         sublattice_block(m_new_dof_B, b, m_n_vol).topRows(dim) =
             M * sublattice_block(before, b, m_n_vol).topRows(dim);
       }
@@ -400,10 +567,12 @@ class Local {
   template <typename F, typename G>
   bool _for_each(F f, G g) const {
     Index i, j;
-    for (j = 0; j < _values().cols(); j++) {
-      for (i = 0; i < _values().rows(); i++) {
-        if (!_check(f(i, j), g(i, j))) {
-          return false;
+    for (auto const &range : m_site_ranges) {
+      for (j = range.first; j < range.second; j++) {
+        for (i = 0; i < _values().rows(); i++) {
+          if (!_check(f(i, j), g(i, j))) {
+            return false;
+          }
         }
       }
     }
@@ -417,6 +586,9 @@ class Local {
   // DoF type (used to obtain matrix rep)
   DoFKey m_key;
 
+  // Integer DoF id (used to obtain packed matrix rep), set on first use
+  mutable Index m_dof_id;
+
   // Number of sublattices
   Index m_n_sublat;
 
@@ -426,6 +598,12 @@ class Local {
   // Tolerance for comparisons
   double m_tol;
 
+  // Combined permutations for the supercell, or nullptr
+  CombinedPermutationTable const *m_combined_permutations;
+
+  // Site index ranges, `[begin, end)`, which are compared
+  std::vector<std::pair<Index, Index>> m_site_ranges;
+
   // Set to false when comparison is made to "other" ConfigDoF, to force update
   // of temporary dof during the next comparison
   mutable bool m_tmp_valid;
@@ -498,6 +676,17 @@ class Global {
                      [&](Index i) { return _new_dof_B(i); });
   }
 
+  /// \brief Compare against other DoF values, of the same size, re-using
+  ///     the temporary vectors
+  void rebind(Eigen::VectorXd const &_values) {
+    m_values_ptr = &_values;
+    m_tmp_valid = true;
+    m_fg_index_A = 0;
+    m_new_dof_A = _values;
+    m_fg_index_B = 0;
+    m_new_dof_B = _values;
+  }
+
   /// \brief Returns less than comparison
   ///
   /// - Only valid after call operator returns false
@@ -508,7 +697,7 @@ class Global {
     if (A.supercell_factor_group_index() != m_fg_index_A || !m_tmp_valid) {
       PrimSymInfo const &prim_sym_info = A.supercell()->prim->sym_info;
       m_fg_index_A = A.supercell_factor_group_index();
-      SupercellSymInfo const &supercell_sym_info = A.supercell()->sym_info;
+      SupercellSymInfo const &supercell_sym_info = A.supercell()->sym_info();
       Index prim_fg_index =
           supercell_sym_info.factor_group->head_group_index[m_fg_index_A];
       Eigen::MatrixXd const &M =
@@ -521,7 +710,7 @@ class Global {
     if (B.supercell_factor_group_index() != m_fg_index_B || !m_tmp_valid) {
       PrimSymInfo const &prim_sym_info = B.supercell()->prim->sym_info;
       m_fg_index_B = B.supercell_factor_group_index();
-      SupercellSymInfo const &supercell_sym_info = B.supercell()->sym_info;
+      SupercellSymInfo const &supercell_sym_info = B.supercell()->sym_info();
       Index prim_fg_index =
           supercell_sym_info.factor_group->head_group_index[m_fg_index_B];
       Eigen::MatrixXd const &M =
@@ -1,17 +1,391 @@
 #ifndef CASM_config_ConfigIsEquivalent
 #define CASM_config_ConfigIsEquivalent
 
+#include <optional>
+#include <type_traits>
+#include <variant>
+
 #include "casm/configuration/ConfigDoFIsEquivalent.hh"
 #include "casm/configuration/Configuration.hh"
 #include "casm/configuration/Supercell.hh"
+#include "casm/configuration/instrumentation.hh"
 
 namespace CASM {
 namespace config {
 
+/// Namespace containing the comparators used by ConfigIsEquivalent
+namespace ConfigIsEquivalentImpl {
+
+/// Placeholder for a DoF that is not compared by FixedDoFIsEquivalent
+struct NoDoF {};
+
+/// Compare the DoF of configurations, for a DoF set fixed at compile time
+///
+/// Template parameters:
+/// - CheckOccupation: If true, occupation is compared
+/// - AnisoOccupation: If true, occupation is compared using
+///   ConfigDoFIsEquivalent::AnisoOccupation, else using
+///   ConfigDoFIsEquivalent::Occupation
+/// - HasGlobal: If true, the prim has exactly one global continuous DoF, and
+///   it is compared
+/// - HasLocal: If true, the prim has exactly one local continuous DoF, and it
+///   is compared
+///
+/// Because the compared global and local DoF are the only ones of their kind
+/// in the prim, the values of other configurations with the same prim are
+/// the first and only element of their DoF values maps, so comparison does
+/// not iterate over maps or look up DoF by key, and checks for DoF that are
+/// not compared are removed at compile time.
+///
+/// Common DoF sets, such as occupation only, occupation and strain,
+/// displacement and strain, or occupation and magnetic spin, use this. Use
+/// `make_config_is_equivalent_impl` to select the comparator for a
+/// configuration.
+template <bool CheckOccupation, bool AnisoOccupation, bool HasGlobal,
+          bool HasLocal>
+class FixedDoFIsEquivalent {
+ public:
+  typedef std::conditional_t<
+      CheckOccupation,
+      std::conditional_t<AnisoOccupation,
+                         ConfigDoFIsEquivalent::AnisoOccupation,
+                         ConfigDoFIsEquivalent::Occupation>,
+      NoDoF>
+      occupation_equiv_type;
+  typedef std::conditional_t<HasGlobal, ConfigDoFIsEquivalent::Global, NoDoF>
+      global_equiv_type;
+  typedef std::conditional_t<HasLocal, ConfigDoFIsEquivalent::Local, NoDoF>
+      local_equiv_type;
+
+  FixedDoFIsEquivalent(Configuration const &_config, double _tol)
+      : m_has_combined_permutations(false),
+        m_occupation_equiv(_make_occupation_equiv(_config)),
+        m_global_equiv(_make_global_equiv(_config, _tol)),
+        m_local_equiv(_make_local_equiv(_config, _tol)) {}
+
+  /// \brief Check if config == other, store config < other
+  bool operator()(Configuration const &other) const {
+    clexulator::ConfigDoFValues const &v = other.dof_values;
+    if constexpr (HasGlobal) {
+      if (!m_global_equiv(_global_values(v))) {
+        return _fail(m_global_equiv);
+      }
+    }
+    if constexpr (CheckOccupation) {
+      if (!m_occupation_equiv(v.occupation)) {
+        return _fail(m_occupation_equiv);
+      }
+    }
+    if constexpr (HasLocal) {
+      if (!m_local_equiv(_local_values(v))) {
+        return _fail(m_local_equiv);
+      }
+    }
+    return true;
+  }
+
+  /// \brief Check if config == A*config, store config < A*config
+  bool operator()(SupercellSymOp const &A) const {
+    _fetch_combined_permutations(A);
+    if constexpr (HasGlobal) {
+      if (!m_global_equiv(A)) {
+        return _fail(m_global_equiv);
+      }
+    }
+    if constexpr (CheckOccupation) {
+      if (!m_occupation_equiv(A)) {
+        return _fail(m_occupation_equiv);
+      }
+    }
+    if constexpr (HasLocal) {
+      if (!m_local_equiv(A)) {
+        return _fail(m_local_equiv);
+      }
+    }
+    return true;
+  }
+
+  /// \brief Check if A*config == B*config, store A*config < B*config
+  bool operator()(SupercellSymOp const &A, SupercellSymOp const &B) const {
+    _fetch_combined_permutations(A);
+    if constexpr (HasGlobal) {
+      if (A.supercell_factor_group_index() !=
+              B.supercell_factor_group_index() &&
+          !m_global_equiv(A, B)) {
+        return _fail(m_global_equiv);
+      }
+    }
+    if constexpr (CheckOccupation) {
+      if (!m_occupation_equiv(A, B)) {
+        return _fail(m_occupation_equiv);
+      }
+    }
+    if constexpr (HasLocal) {
+      if (!m_local_equiv(A, B)) {
+        return _fail(m_local_equiv);
+      }
+    }
+    return true;
+  }
+
+  /// \brief Check if config == A*other, store config < A*other
+  bool operator()(SupercellSymOp const &A, Configuration const &other) const {
+    _fetch_combined_permutations(A);
+    clexulator::ConfigDoFValues const &v = other.dof_values;
+    if constexpr (HasGlobal) {
+      if (!m_global_equiv(A, _global_values(v))) {
+        return _fail(m_global_equiv);
+      }
+    }
+    if constexpr (CheckOccupation) {
+      if (!m_occupation_equiv(A, v.occupation)) {
+        return _fail(m_occupation_equiv);
+      }
+    }
+    if constexpr (HasLocal) {
+      if (!m_local_equiv(A, _local_values(v))) {
+        return _fail(m_local_equiv);
+      }
+    }
+    return true;
+  }
+
+  /// \brief Check if A*config == B*other, store A*config < B*other
+  bool operator()(SupercellSymOp const &A, SupercellSymOp const &B,
+                  Configuration const &other) const {
+    _fetch_combined_permutations(A);
+    clexulator::ConfigDoFValues const &v = other.dof_values;
+    if constexpr (HasGlobal) {
+      if (!m_global_equiv(A, B, _global_values(v))) {
+        return _fail(m_global_equiv);
+      }
+    }
+    if constexpr (CheckOccupation) {
+      if (!m_occupation_equiv(A, B, v.occupation)) {
+        return _fail(m_occupation_equiv);
+      }
+    }
+    if constexpr (HasLocal) {
+      if (!m_local_equiv(A, B, _local_values(v))) {
+        return _fail(m_local_equiv);
+      }
+    }
+    return true;
+  }
+
+  /// \brief Compare against another configuration in the same supercell
+  void rebind(Configuration const &_config) {
+    clexulator::ConfigDoFValues const &v = _config.dof_values;
+    if constexpr (HasGlobal) {
+      m_global_equiv.rebind(_global_values(v));
+    }
+    if constexpr (CheckOccupation) {
+      m_occupation_equiv.rebind(v.occupation);
+    }
+    if constexpr (HasLocal) {
+      m_local_equiv.rebind(_local_values(v));
+    }
+  }
+
+  /// \brief Returns less than comparison
+  ///
+  /// - Only valid after call operator returns false
+  bool is_less() const { return m_less; }
+
+ private:
+  static Eigen::VectorXd const &_global_values(
+      clexulator::ConfigDoFValues const &v) {
+    return v.global_dof_values.begin()->second;
+  }
+
+  static Eigen::MatrixXd const &_local_values(
+      clexulator::ConfigDoFValues const &v) {
+    return v.local_dof_values.begin()->second;
+  }
+
+  template <typename EquivType>
+  bool _fail(EquivType const &f) const {
+    m_less = f.is_less();
+    return false;
+  }
+
+  /// \brief Get the supercell's combined permutation table, on first
+  ///     comparison using an operation
+  void _fetch_combined_permutations(SupercellSymOp const &A) const {
+    if (m_has_combined_permutations) {
+      return;
+    }
+    m_combined_permutations =
+        A.supercell()->sym_info().combined_permutation_table();
+    if constexpr (CheckOccupation) {
+      m_occupation_equiv.set_combined_permutations(
+          m_combined_permutations.get());
+    }
+    if constexpr (HasLocal) {
+      m_local_equiv.set_combined_permutations(m_combined_permutations.get());
+    }
+    m_has_combined_permutations = true;
+  }
+
+  occupation_equiv_type _make_occupation_equiv(
+      Configuration const &_config) const {
+    if constexpr (CheckOccupation) {
+      auto const &prim_sym_info = _config.supercell->prim->sym_info;
+      Index n_vol = _config.supercell->superlattice.size();
+      if constexpr (AnisoOccupation) {
+        return occupation_equiv_type(
+            _config.dof_values.occupation,
+            _config.supercell->prim->basicstructure->basis().size(),
+            nullptr, make_occupation_site_ranges(prim_sym_info, n_vol));
+      } else {
+        return occupation_equiv_type(
+            _config.dof_values.occupation, nullptr,
+            make_occupation_site_ranges(prim_sym_info, n_vol));
+      }
+    } else {
+      return NoDoF();
+    }
+  }
+
+  global_equiv_type _make_global_equiv(Configuration const &_config,
+                                       double _tol) const {
+    if constexpr (HasGlobal) {
+      auto const &dof = *_config.dof_values.global_dof_values.begin();
+      return global_equiv_type(dof.second, dof.first, _tol);
+    } else {
+      return NoDoF();
+    }
+  }
+
+  local_equiv_type _make_local_equiv(Configuration const &_config,
+                                     double _tol) const {
+    if constexpr (HasLocal) {
+      auto const &dof = *_config.dof_values.local_dof_values.begin();
+      Index n_sublat = _config.supercell->prim->basicstructure->basis().size();
+      return local_equiv_type(
+          dof.second, dof.first, n_sublat, _tol, nullptr,
+          make_local_dof_site_ranges(_config.supercell->prim->sym_info,
+                                     dof.first,
+                                     _config.supercell->superlattice.size()));
+    } else {
+      return NoDoF();
+    }
+  }
+
+  // The combined permutation table is obtained on first use with an
+  // operation, so comparisons without operations do not construct it
+  mutable bool m_has_combined_permutations;
+  mutable std::shared_ptr<CombinedPermutationTable const>
+      m_combined_permutations;
+  mutable occupation_equiv_type m_occupation_equiv;
+  global_equiv_type m_global_equiv;
+  mutable local_equiv_type m_local_equiv;
+  mutable bool m_less;
+};
+
+/// Compare the DoF of configurations, for any DoF set selected at runtime
+///
+/// Compares global DoF values, then occupation, then local DoF values, for
+/// each DoF in `_which_dofs`, looking up the values of other configurations
+/// by DoF key.
+class GeneralIsEquivalent {
+ public:
+  GeneralIsEquivalent(Configuration const &_config, double _tol,
+                      std::set<std::string> const &_which_dofs);
+
+  /// \brief Check if config == other, store config < other
+  bool operator()(Configuration const &other) const;
+
+  /// \brief Check if config == A*config, store config < A*config
+  bool operator()(SupercellSymOp const &A) const;
+
+  /// \brief Check if A*config == B*config, store A*config < B*config
+  bool operator()(SupercellSymOp const &A, SupercellSymOp const &B) const;
+
+  /// \brief Check if config == A*other, store config < A*other
+  bool operator()(SupercellSymOp const &A, Configuration const &other) const;
+
+  /// \brief Check if A*config == B*other, store A*config < B*other
+  bool operator()(SupercellSymOp const &A, SupercellSymOp const &B,
+                  Configuration const &other) const;
+
+  /// \brief Compare against another configuration in the same supercell
+  void rebind(Configuration const &_config);
+
+  /// \brief Returns less than comparison
+  ///
+  /// - Only valid after call operator returns false
+  bool is_less() const { return m_less; }
+
+ private:
+  template <typename... Args>
+  bool _occupation_is_equivalent(Args &&...args) const;
+
+  /// \brief Get the supercell's combined permutation table, on first
+  ///     comparison using an operation
+  void _fetch_combined_permutations(SupercellSymOp const &A) const;
+
+  Index m_n_sublat;
+  bool m_check_occupation;
+  bool m_has_aniso_occs;
+
+  // The combined permutation table is obtained on first use with an
+  // operation, so comparisons without operations do not construct it
+  mutable bool m_has_combined_permutations;
+  mutable std::shared_ptr<CombinedPermutationTable const>
+      m_combined_permutations;
+  mutable ConfigDoFIsEquivalent::Occupation m_occupation_equiv;
+  // Only constructed if occupation is compared and the prim has anisotropic
+  // occupants, because it copies the occupation values
+  mutable std::optional<ConfigDoFIsEquivalent::AnisoOccupation>
+      m_aniso_occupation_equiv;
+  std::map<DoFKey, ConfigDoFIsEquivalent::Global> m_global_equivs;
+  mutable std::map<DoFKey, ConfigDoFIsEquivalent::Local> m_local_equivs;
+  mutable bool m_less;
+};
+
+/// The comparators of ConfigIsEquivalent
+typedef std::variant<FixedDoFIsEquivalent<true, false, false, false>,
+                     FixedDoFIsEquivalent<true, true, false, false>,
+                     FixedDoFIsEquivalent<true, false, true, false>,
+                     FixedDoFIsEquivalent<true, true, true, false>,
+                     FixedDoFIsEquivalent<true, false, false, true>,
+                     FixedDoFIsEquivalent<true, true, false, true>,
+                     FixedDoFIsEquivalent<false, false, true, true>,
+                     GeneralIsEquivalent>
+    ConfigIsEquivalentVariant;
+
+/// \brief Make the comparator for a configuration and DoF selection
+ConfigIsEquivalentVariant make_config_is_equivalent_impl(
+    Configuration const &_config, double _tol,
+    std::set<std::string> const &_which_dofs);
+
+}  // namespace ConfigIsEquivalentImpl
+
 /// \brief Class for comparison of Configurations (with the same Supercell)
 ///
 /// - The call operators return the value for equality comparison,
 ///   and if not equivalent, also store the result for less than comparison
+/// - If available, the supercell's CombinedPermutationTable is held and used
+///   to evaluate permutations of site DoF, so SupercellSymOp must be for the
+///   supercell of the configuration. It is obtained on the first comparison
+///   using a SupercellSymOp, so comparisons without operations (such as
+///   Configuration::operator<) do not construct it or the supercell's
+///   SupercellSymInfo.
+/// - Construction looks up which DoF to compare and allocates temporary
+///   storage. To compare against many configurations in the same supercell,
+///   construct once and use `rebind` to change the configuration compared
+///   against, which re-uses the DoF selection and temporary storage.
+/// - Construction selects a comparator specialized at compile time for the
+///   compared DoF (see ConfigIsEquivalentImpl::FixedDoFIsEquivalent) if the
+///   DoF set is a common one, else a general comparator. For the lowest
+///   overhead in loops over many operations, use `visit` to dispatch once,
+///   outside of the loop.
+/// - The const call operators update temporary storage and the stored less
+///   than result, so a ConfigIsEquivalent must not be used by more than one
+///   thread at a time. To compare in parallel, share a
+///   ConfigComparisonDefinition and make one ConfigComparisonContext per
+///   thread.
 ///
 class ConfigIsEquivalent {
  public:
@@ -26,6 +400,10 @@ class ConfigIsEquivalent {
 
   Configuration const &config() const;
 
+  /// \brief Compare against another configuration in the same supercell,
+  ///     without reallocating
+  void rebind(Configuration const &_config);
+
   /// \brief Returns less than comparison
   ///
   /// - Only valid after call operator returns false
@@ -50,99 +428,89 @@ class ConfigIsEquivalent {
   bool operator()(SupercellSymOp const &A, SupercellSymOp const &B,
                   Configuration const &other) const;
 
+  /// \brief Call `f(comparator)` with the selected comparator
+  template <typename F>
+  decltype(auto) visit(F &&f) const;
+
  private:
-  template <typename... Args>
-  bool _occupation_is_equivalent(Args &&...args) const;
+  template <typename F>
+  bool _compare(F f) const;
 
   Configuration const *m_config;
-  Index m_n_sublat;
-  bool m_all_dofs;
-  bool m_check_occupation;
-  bool m_has_aniso_occs;
-  Eigen::VectorXi const *m_occupation_ptr;
-  std::map<DoFKey, ConfigDoFIsEquivalent::Global> m_global_equivs;
-  std::map<DoFKey, ConfigDoFIsEquivalent::Local> m_local_equivs;
+  ConfigIsEquivalentImpl::ConfigIsEquivalentVariant m_impl;
   mutable bool m_less;
 };
 
-/// Construct with config to be compared against, tolerance for comparison,
-/// and (optional) list of DoFs to compare if _wich_dofs is empty, no dofs
-/// will be compared (default is "all", in which case all DoFs are compared)
-inline ConfigIsEquivalent::ConfigIsEquivalent(
+// --- Inline definitions ---
+
+namespace ConfigIsEquivalentImpl {
+
+inline GeneralIsEquivalent::GeneralIsEquivalent(
     Configuration const &_config, double _tol,
     std::set<std::string> const &_which_dofs)
-    : m_config(&_config),
-      m_n_sublat(config().supercell->prim->basicstructure->basis().size()),
-      m_all_dofs(_which_dofs.count("all")),
+    : m_n_sublat(_config.supercell->prim->basicstructure->basis().size()),
       m_check_occupation(
-          (m_all_dofs || _which_dofs.count("occ")) &&
-          config().supercell->prim->sym_info.has_occupation_dofs),
-      m_has_aniso_occs(config().supercell->prim->sym_info.has_aniso_occs),
-      m_occupation_ptr(nullptr) {
-  clexulator::ConfigDoFValues const &dof_values = config().dof_values;
+          (_which_dofs.count("all") || _which_dofs.count("occ")) &&
+          _config.supercell->prim->sym_info.has_occupation_dofs),
+      m_has_aniso_occs(_config.supercell->prim->sym_info.has_aniso_occs),
+      m_has_combined_permutations(false),
+      m_occupation_equiv(_config.dof_values.occupation, nullptr,
+                         make_occupation_site_ranges(
+                             _config.supercell->prim->sym_info,
+                             _config.supercell->superlattice.size())) {
+  clexulator::ConfigDoFValues const &dof_values = _config.dof_values;
+  bool all_dofs = _which_dofs.count("all");
+
+  if (m_check_occupation && m_has_aniso_occs) {
+    m_aniso_occupation_equiv.emplace(
+        dof_values.occupation, m_n_sublat, nullptr,
+        make_occupation_site_ranges(_config.supercell->prim->sym_info,
+                                    _config.supercell->superlattice.size()));
+  }
 
   for (auto const &dof : dof_values.global_dof_values) {
     DoFKey const &key = dof.first;
     Eigen::VectorXd const &values = dof.second;
-    if (m_all_dofs || _which_dofs.count(key)) {
+    if (all_dofs || _which_dofs.count(key)) {
       m_global_equivs.emplace(std::piecewise_construct,
                               std::forward_as_tuple(key),
                               std::forward_as_tuple(values, key, _tol));
     }
   }
 
-  if (m_check_occupation) {
-    m_occupation_ptr = &dof_values.occupation;
-  }
-
   for (auto const &dof : dof_values.local_dof_values) {
     DoFKey const &key = dof.first;
     Eigen::MatrixXd const &values = dof.second;
-    if (m_all_dofs || _which_dofs.count(key)) {
+    if (all_dofs || _which_dofs.count(key)) {
       m_local_equivs.emplace(
           std::piecewise_construct, std::forward_as_tuple(key),
-          std::forward_as_tuple(values, key, m_n_sublat, _tol));
+          std::forward_as_tuple(values, key, m_n_sublat, _tol, nullptr,
+                                make_local_dof_site_ranges(
+                                    _config.supercell->prim->sym_info, key,
+                                    _config.supercell->superlattice.size())));
     }
   }
 }
 
-inline ConfigIsEquivalent::ConfigIsEquivalent(
-    Configuration const &_config, std::set<std::string> const &_which_dofs)
-    : ConfigIsEquivalent(
-          _config, _config.supercell->prim->basicstructure->lattice().tol(),
-          _which_dofs) {}
-
-inline Configuration const &ConfigIsEquivalent::config() const {
-  return *m_config;
-}
-
-/// \brief Returns less than comparison
-///
-/// - Only valid after call operator returns false
-inline bool ConfigIsEquivalent::is_less() const { return m_less; }
-
-/// \brief Check if config == other, store config < other
-///
-/// - Currently assumes that both Configuration have the same Prim, but may
-///   have different supercells
-inline bool ConfigIsEquivalent::operator()(Configuration const &other) const {
-  if (&config() == &other) {
-    return true;
+inline void GeneralIsEquivalent::rebind(Configuration const &_config) {
+  clexulator::ConfigDoFValues const &dof_values = _config.dof_values;
+  for (auto &dof_is_equiv_f : m_global_equivs) {
+    dof_is_equiv_f.second.rebind(
+        dof_values.global_dof_values.at(dof_is_equiv_f.first));
   }
-
-  if (config().supercell->prim != other.supercell->prim) {
-    throw std::runtime_error(
-        "Error comparing Configuration with ConfigIsEquivalent: "
-        "Only Configuration with shared prim may be compared this way.");
+  m_occupation_equiv.rebind(dof_values.occupation);
+  if (m_aniso_occupation_equiv.has_value()) {
+    m_aniso_occupation_equiv->rebind(dof_values.occupation);
+  }
+  for (auto &dof_is_equiv_f : m_local_equivs) {
+    dof_is_equiv_f.second.rebind(
+        dof_values.local_dof_values.at(dof_is_equiv_f.first));
   }
+}
 
+inline bool GeneralIsEquivalent::operator()(Configuration const &other) const {
   clexulator::ConfigDoFValues const &other_dof_values = other.dof_values;
 
-  if (*config().supercell != *other.supercell) {
-    m_less = *config().supercell < *other.supercell;
-    return false;
-  }
-
   for (auto const &dof_is_equiv_f : m_global_equivs) {
     DoFKey const &key = dof_is_equiv_f.first;
     ConfigDoFIsEquivalent::Global const &f = dof_is_equiv_f.second;
@@ -172,8 +540,8 @@ inline bool ConfigIsEquivalent::operator()(Configuration const &other) const {
   return true;
 }
 
-/// \brief Check if config == A*config, store config < A*config
-inline bool ConfigIsEquivalent::operator()(SupercellSymOp const &A) const {
+inline bool GeneralIsEquivalent::operator()(SupercellSymOp const &A) const {
+  _fetch_combined_permutations(A);
   for (auto const &dof_is_equiv_f : m_global_equivs) {
     ConfigDoFIsEquivalent::Global const &f = dof_is_equiv_f.second;
     if (!f(A)) {
@@ -197,9 +565,9 @@ inline bool ConfigIsEquivalent::operator()(SupercellSymOp const &A) const {
   return true;
 }
 
-/// \brief Check if A*config == B*config, store A*config < B*config
-inline bool ConfigIsEquivalent::operator()(SupercellSymOp const &A,
-                                           SupercellSymOp const &B) const {
+inline bool GeneralIsEquivalent::operator()(SupercellSymOp const &A,
+                                            SupercellSymOp const &B) const {
+  _fetch_combined_permutations(A);
   if (A.supercell_factor_group_index() != B.supercell_factor_group_index()) {
     for (auto const &dof_is_equiv_f : m_global_equivs) {
       ConfigDoFIsEquivalent::Global const &f = dof_is_equiv_f.second;
@@ -225,9 +593,9 @@ inline bool ConfigIsEquivalent::operator()(SupercellSymOp const &A,
   return true;
 }
 
-/// \brief Check if config == A*other, store config < A*other
-inline bool ConfigIsEquivalent::operator()(SupercellSymOp const &A,
-                                           Configuration const &other) const {
+inline bool GeneralIsEquivalent::operator()(SupercellSymOp const &A,
+                                            Configuration const &other) const {
+  _fetch_combined_permutations(A);
   clexulator::ConfigDoFValues const &other_dof_values = other.dof_values;
 
   for (auto const &dof_is_equiv_f : m_global_equivs) {
@@ -259,10 +627,10 @@ inline bool ConfigIsEquivalent::operator()(SupercellSymOp const &A,
   return true;
 }
 
-/// \brief Check if A*config == B*other, store A*config < B*other
-inline bool ConfigIsEquivalent::operator()(SupercellSymOp const &A,
-                                           SupercellSymOp const &B,
-                                           Configuration const &other) const {
+inline bool GeneralIsEquivalent::operator()(SupercellSymOp const &A,
+                                            SupercellSymOp const &B,
+                                            Configuration const &other) const {
+  _fetch_combined_permutations(A);
   clexulator::ConfigDoFValues const &other_dof_values = other.dof_values;
 
   for (auto const &dof_is_equiv_f : m_global_equivs) {
@@ -295,16 +663,17 @@ inline bool ConfigIsEquivalent::operator()(SupercellSymOp const &A,
 }
 
 template <typename... Args>
-bool ConfigIsEquivalent::_occupation_is_equivalent(Args &&...args) const {
+bool GeneralIsEquivalent::_occupation_is_equivalent(Args &&...args) const {
   if (m_check_occupation) {
     if (m_has_aniso_occs) {
-      ConfigDoFIsEquivalent::AnisoOccupation f(*m_occupation_ptr, m_n_sublat);
+      ConfigDoFIsEquivalent::AnisoOccupation const &f =
+          *m_aniso_occupation_equiv;
       if (!f(std::forward<Args>(args)...)) {
         m_less = f.is_less();
         return false;
       }
     } else {
-      ConfigDoFIsEquivalent::Occupation f(*m_occupation_ptr);
+      ConfigDoFIsEquivalent::Occupation const &f = m_occupation_equiv;
       if (!f(std::forward<Args>(args)...)) {
         m_less = f.is_less();
         return false;
@@ -314,6 +683,210 @@ bool ConfigIsEquivalent::_occupation_is_equivalent(Args &&...args) const {
   return true;
 }
 
+inline void GeneralIsEquivalent::_fetch_combined_permutations(
+    SupercellSymOp const &A) const {
+  if (m_has_combined_permutations) {
+    return;
+  }
+  m_combined_permutations =
+      A.supercell()->sym_info().combined_permutation_table();
+  CombinedPermutationTable const *table = m_combined_permutations.get();
+  m_occupation_equiv.set_combined_permutations(table);
+  if (m_aniso_occupation_equiv.has_value()) {
+    m_aniso_occupation_equiv->set_combined_permutations(table);
+  }
+  for (auto &dof_is_equiv_f : m_local_equivs) {
+    dof_is_equiv_f.second.set_combined_permutations(table);
+  }
+  m_has_combined_permutations = true;
+}
+
+/// \brief Make the comparator for a configuration and DoF selection
+///
+/// Selects a FixedDoFIsEquivalent if each of the compared global and local
+/// continuous DoF kinds has no DoF or exactly one DoF, which is the only one
+/// of its kind in the prim, and the combination is one of the instantiated
+/// specializations. Otherwise, selects GeneralIsEquivalent.
+inline ConfigIsEquivalentVariant make_config_is_equivalent_impl(
+    Configuration const &_config, double _tol,
+    std::set<std::string> const &_which_dofs) {
+  auto const &prim_sym_info = _config.supercell->prim->sym_info;
+  clexulator::ConfigDoFValues const &dof_values = _config.dof_values;
+
+  bool all_dofs = _which_dofs.count("all");
+  bool check_occupation = (all_dofs || _which_dofs.count("occ")) &&
+                          prim_sym_info.has_occupation_dofs;
+  bool aniso = prim_sym_info.has_aniso_occs;
+
+  // 0: none compared, 1: the only DoF of its kind is compared, -1: other
+  auto _count = [&](auto const &values_map) {
+    Index n_compared = 0;
+    for (auto const &dof : values_map) {
+      if (all_dofs || _which_dofs.count(dof.first)) {
+        ++n_compared;
+      }
+    }
+    if (n_compared == 0) {
+      return 0;
+    }
+    return (n_compared == 1 && values_map.size() == 1) ? 1 : -1;
+  };
+  int n_global = _count(dof_values.global_dof_values);
+  int n_local = _count(dof_values.local_dof_values);
+
+  if (check_occupation && n_global == 0 && n_local == 0) {
+    if (aniso) {
+      return FixedDoFIsEquivalent<true, true, false, false>(_config, _tol);
+    }
+    return FixedDoFIsEquivalent<true, false, false, false>(_config, _tol);
+  }
+  if (check_occupation && n_global == 1 && n_local == 0) {
+    if (aniso) {
+      return FixedDoFIsEquivalent<true, true, true, false>(_config, _tol);
+    }
+    return FixedDoFIsEquivalent<true, false, true, false>(_config, _tol);
+  }
+  if (check_occupation && n_global == 0 && n_local == 1) {
+    if (aniso) {
+      return FixedDoFIsEquivalent<true, true, false, true>(_config, _tol);
+    }
+    return FixedDoFIsEquivalent<true, false, false, true>(_config, _tol);
+  }
+  if (!check_occupation && n_global == 1 && n_local == 1) {
+    return FixedDoFIsEquivalent<false, false, true, true>(_config, _tol);
+  }
+  return GeneralIsEquivalent(_config, _tol, _which_dofs);
+}
+
+}  // namespace ConfigIsEquivalentImpl
+
+/// Construct with config to be compared against, tolerance for comparison,
+/// and (optional) list of DoFs to compare if _wich_dofs is empty, no dofs
+/// will be compared (default is "all", in which case all DoFs are compared)
+inline ConfigIsEquivalent::ConfigIsEquivalent(
+    Configuration const &_config, double _tol,
+    std::set<std::string> const &_which_dofs)
+    : m_config(&_config),
+      m_impl(ConfigIsEquivalentImpl::make_config_is_equivalent_impl(
+          _config, _tol, _which_dofs)) {}
+
+inline ConfigIsEquivalent::ConfigIsEquivalent(
+    Configuration const &_config, std::set<std::string> const &_which_dofs)
+    : ConfigIsEquivalent(
+          _config, _config.supercell->prim->basicstructure->lattice().tol(),
+          _which_dofs) {}
+
+inline Configuration const &ConfigIsEquivalent::config() const {
+  return *m_config;
+}
+
+/// \brief Compare against another configuration in the same supercell,
+///     without reallocating
+///
+/// After calling, this compares as if constructed with `_config` and the
+/// same tolerance and DoF selection. The DoF values of `_config` must have
+/// the same shape as those of `config()`, so `_config` must be in the same
+/// supercell; an exception is thrown if the supercells are not equal.
+inline void ConfigIsEquivalent::rebind(Configuration const &_config) {
+  if (_config.supercell != config().supercell &&
+      *_config.supercell != *config().supercell) {
+    throw std::runtime_error(
+        "Error in ConfigIsEquivalent::rebind: supercell mismatch");
+  }
+  m_config = &_config;
+  std::visit([&](auto &impl) { impl.rebind(_config); }, m_impl);
+}
+
+/// \brief Returns less than comparison
+///
+/// - Only valid after call operator returns false
+inline bool ConfigIsEquivalent::is_less() const { return m_less; }
+
+/// \brief Check if config == other, store config < other
+///
+/// - Currently assumes that both Configuration have the same Prim, but may
+///   have different supercells
+inline bool ConfigIsEquivalent::operator()(Configuration const &other) const {
+  CASM_CONFIG_COUNT(comparisons);
+  if (&config() == &other) {
+    return true;
+  }
+
+  if (config().supercell->prim != other.supercell->prim) {
+    throw std::runtime_error(
+        "Error comparing Configuration with ConfigIsEquivalent: "
+        "Only Configuration with shared prim may be compared this way.");
+  }
+
+  if (*config().supercell != *other.supercell) {
+    m_less = *config().supercell < *other.supercell;
+    return false;
+  }
+
+  return _compare([&](auto const &impl) { return impl(other); });
+}
+
+/// \brief Check if config == A*config, store config < A*config
+inline bool ConfigIsEquivalent::operator()(SupercellSymOp const &A) const {
+  CASM_CONFIG_COUNT(comparisons);
+  return _compare([&](auto const &impl) { return impl(A); });
+}
+
+/// \brief Check if A*config == B*config, store A*config < B*config
+inline bool ConfigIsEquivalent::operator()(SupercellSymOp const &A,
+                                           SupercellSymOp const &B) const {
+  CASM_CONFIG_COUNT(comparisons);
+  return _compare([&](auto const &impl) { return impl(A, B); });
+}
+
+/// \brief Check if config == A*other, store config < A*other
+inline bool ConfigIsEquivalent::operator()(SupercellSymOp const &A,
+                                           Configuration const &other) const {
+  CASM_CONFIG_COUNT(comparisons);
+  return _compare([&](auto const &impl) { return impl(A, other); });
+}
+
+/// \brief Check if A*config == B*other, store A*config < B*other
+inline bool ConfigIsEquivalent::operator()(SupercellSymOp const &A,
+                                           SupercellSymOp const &B,
+                                           Configuration const &other) const {
+  CASM_CONFIG_COUNT(comparisons);
+  return _compare([&](auto const &impl) { return impl(A, B, other); });
+}
+
+/// \brief Call `f(comparator)` with the selected comparator
+///
+/// The comparator is one of the types of
+/// `ConfigIsEquivalentImpl::ConfigIsEquivalentVariant`, which have the same
+/// call operators and `is_less` as ConfigIsEquivalent, but do not check
+/// that configurations have the same prim and supercell, and do not count
+/// comparisons. This allows loops to dispatch once:
+///
+/// \code
+/// equal_to_f.visit([&](auto const &f) {
+///   for (auto it = begin; it != end; ++it) {
+///     if (f(*it)) { ... }
+///   }
+/// });
+/// \endcode
+template <typename F>
+decltype(auto) ConfigIsEquivalent::visit(F &&f) const {
+  return std::visit(std::forward<F>(f), m_impl);
+}
+
+template <typename F>
+bool ConfigIsEquivalent::_compare(F f) const {
+  return std::visit(
+      [&](auto const &impl) {
+        if (f(impl)) {
+          return true;
+        }
+        m_less = impl.is_less();
+        return false;
+      },
+      m_impl);
+}
+
 }  // namespace config
 }  // namespace CASM
 
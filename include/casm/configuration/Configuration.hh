@@ -26,6 +26,10 @@ struct Configuration : public Comparisons<CRTPBase<Configuration>> {
   /// \brief Less than comparison of Configuration
   bool operator<(Configuration const &rhs) const;
 
+  /// \brief Memory used by the configuration, in bytes, not including the
+  ///     shared supercell
+  Index memory_bytes() const;
+
  private:
   friend struct Comparisons<CRTPBase<Configuration>>;
 
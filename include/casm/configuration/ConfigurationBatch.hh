@@ -0,0 +1,118 @@
+#ifndef CASM_config_ConfigurationBatch
+#define CASM_config_ConfigurationBatch
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+struct AtomicStructures;
+class ConfigurationSet;
+
+/// \brief Many configurations in one supercell, with DoF values stored as
+///     stacked arrays
+///
+/// A ConfigurationBatch holds the DoF values of `size()` configurations in
+/// one shared supercell, without constructing a Configuration for each:
+/// - `occupation`: shape `(size(), n_sites)`, row `i` is the occupation of
+///   configuration `i`
+/// - `global_dof_values[key]`: shape `(size(), dim)`, row `i` is the global
+///   DoF values of configuration `i`, in the prim basis
+/// - `local_dof_values[key]`: shape `(size(), dim * n_sites)`, row `i` is the
+///   `(dim, n_sites)` local DoF values matrix of configuration `i`, in the
+///   prim basis, in column-major order (so that the value of component `d`
+///   on site `l` is column `l * dim + d`)
+///
+/// Continuous DoF values are optional: a DoF that is not in
+/// `global_dof_values` or `local_dof_values` has value zero in all
+/// configurations.
+///
+/// Arrays are row-major, so the values of one configuration are contiguous.
+struct ConfigurationBatch {
+  typedef Eigen::Matrix<std::int8_t, Eigen::Dynamic, Eigen::Dynamic,
+                        Eigen::RowMajor>
+      OccupationArray;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic,
+                        Eigen::RowMajor>
+      ValuesArray;
+
+  /// \brief Constructor
+  explicit ConfigurationBatch(
+      std::shared_ptr<Supercell const> const &_supercell,
+      Index n_configurations = 0, bool include_continuous_dof = true);
+
+  /// \brief The shared supercell of all configurations
+  std::shared_ptr<Supercell const> supercell;
+
+  /// \brief Occupation, shape `(size(), n_sites)`
+  OccupationArray occupation;
+
+  /// \brief Global DoF values, by key, shape `(size(), dim)`
+  std::map<DoFKey, ValuesArray> global_dof_values;
+
+  /// \brief Local DoF values, by key, shape `(size(), dim * n_sites)`
+  std::map<DoFKey, ValuesArray> local_dof_values;
+
+  /// \brief Number of configurations
+  Index size() const;
+
+  /// \brief Number of sites in the supercell
+  Index n_sites() const;
+
+  /// \brief Change the number of configurations, keeping existing values and
+  ///     setting new values to zero
+  void resize(Index n_configurations);
+
+  /// \brief Make configuration `i`
+  Configuration configuration(Index i) const;
+
+  /// \brief Set the values of configuration `i`
+  void set(Index i, Configuration const &configuration);
+
+  /// \brief Append a configuration
+  ///
+  /// This reallocates all arrays, so to add many configurations use
+  /// `resize` and then `set`.
+  void push_back(Configuration const &configuration);
+};
+
+/// \brief Make the canonical forms of all configurations in a batch
+ConfigurationBatch make_canonical_forms(ConfigurationBatch const &batch,
+                                        Index n_threads = 1);
+
+/// \brief Check if each configuration in a batch is primitive
+Eigen::Matrix<bool, Eigen::Dynamic, 1> is_primitive(
+    ConfigurationBatch const &batch, Index n_threads = 1);
+
+/// \brief Count the distinct equivalents of each configuration in a batch
+Eigen::VectorXl make_n_equivalents(ConfigurationBatch const &batch,
+                                   Index n_threads = 1);
+
+/// \brief Construct the atomic structures of all configurations in a batch
+AtomicStructures make_atomic_structures(
+    ConfigurationBatch const &batch,
+    std::string atom_type_naming_method = "chemical_name",
+    std::set<std::string> excluded_species = {"Va", "VA", "va"});
+
+/// \brief Insert all configurations in a batch into a ConfigurationSet
+Index insert_batch(ConfigurationSet &configurations,
+                   ConfigurationBatch const &batch);
+
+/// \brief Make a batch of the configurations in a ConfigurationSet that are
+///     in one supercell
+ConfigurationBatch make_configuration_batch(
+    ConfigurationSet const &configurations,
+    std::shared_ptr<Supercell const> const &supercell,
+    std::vector<std::string> *configuration_ids = nullptr);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
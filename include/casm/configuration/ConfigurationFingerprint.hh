@@ -0,0 +1,103 @@
+#ifndef CASM_config_ConfigurationFingerprint
+#define CASM_config_ConfigurationFingerprint
+
+#include <set>
+#include <vector>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/definitions.hh"
+#include "casm/misc/Comparisons.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Symmetry-invariant summary of a configuration's occupation
+///
+/// Configurations that are equivalent by supercell symmetry always have
+/// equal fingerprints, so configurations with different fingerprints can
+/// be determined to be not equivalent without applying any symmetry
+/// operations. Equal fingerprints do not imply equivalence.
+///
+/// Fingerprints made by different ConfigurationFingerprintCalculator may
+/// not be compared.
+struct ConfigurationFingerprint
+    : public Comparisons<CRTPBase<ConfigurationFingerprint>> {
+  /// \brief Number of sites, by occupant class
+  ///
+  /// See `ConfigurationFingerprintCalculator::occupant_class`.
+  std::vector<Index> occupant_class_counts;
+
+  /// \brief Number of pair clusters, by pair orbit and occupant classes
+  ///
+  /// Usage:
+  /// \code
+  /// // c1 <= c2
+  /// Index count = pair_class_counts[(orbit_index * n_classes + c1) *
+  ///                                 n_classes + c2];
+  /// \endcode
+  std::vector<Index> pair_class_counts;
+
+  bool operator<(ConfigurationFingerprint const &rhs) const;
+
+ private:
+  friend struct Comparisons<CRTPBase<ConfigurationFingerprint>>;
+
+  bool eq_impl(ConfigurationFingerprint const &rhs) const;
+};
+
+/// \brief Makes ConfigurationFingerprint for configurations with the same
+///     prim
+///
+/// Method:
+/// - Occupants are sorted into classes, such that symmetry operations only
+///   transform occupants amongst members of the same class. This takes into
+///   account both the permutation of sublattices and the transformation of
+///   anisotropic occupants.
+/// - The fingerprint is the number of sites occupied by each class of
+///   occupant, and the number of pair clusters, in each prim periodic orbit
+///   of pair clusters up to a maximum length, with each combination of
+///   occupant classes.
+class ConfigurationFingerprintCalculator {
+ public:
+  /// \brief Constructor
+  ConfigurationFingerprintCalculator(std::shared_ptr<Prim const> const &_prim,
+                                     double max_pair_length);
+
+  /// \brief The prim
+  std::shared_ptr<Prim const> const &prim() const;
+
+  /// \brief Number of occupant classes
+  Index n_occupant_classes() const;
+
+  /// \brief Occupant class, `occupant_class()[b][occ]`, for occupant `occ`
+  ///     on sublattice `b`
+  std::vector<std::vector<Index>> const &occupant_class() const;
+
+  /// \brief Orbits of pair clusters included in the fingerprint
+  std::vector<std::set<clust::IntegralCluster>> const &pair_orbits() const;
+
+  /// \brief Make the fingerprint of a configuration
+  ConfigurationFingerprint operator()(Configuration const &configuration) const;
+
+ private:
+  std::shared_ptr<Prim const> m_prim;
+
+  Index m_n_occupant_classes;
+
+  std::vector<std::vector<Index>> m_occupant_class;
+
+  std::vector<std::set<clust::IntegralCluster>> m_pair_orbits;
+};
+
+/// \brief Return true if two configurations are equivalent by supercell
+///     symmetry, using fingerprints to skip symmetry checks when possible
+bool is_equivalent(Configuration const &A,
+                   ConfigurationFingerprint const &A_fingerprint,
+                   Configuration const &B,
+                   ConfigurationFingerprint const &B_fingerprint);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
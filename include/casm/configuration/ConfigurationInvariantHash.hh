@@ -0,0 +1,161 @@
+#ifndef CASM_config_ConfigurationInvariantHash
+#define CASM_config_ConfigurationInvariantHash
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Makes approximate symmetry-invariant hashes of configurations,
+///     from cluster occupant class counts
+///
+/// Exact canonicalization is too expensive for configurations in very large
+/// supercells, such as Monte Carlo snapshots. An InvariantConfigurationHasher
+/// instead counts, for each prim periodic orbit of clusters, the number of
+/// clusters in the supercell with each sorted combination of occupant
+/// classes, and hashes the counts.
+///
+/// Method:
+/// - Occupant classes are as in ConfigurationFingerprintCalculator, so
+///   symmetry operations only transform occupants amongst members of the
+///   same class.
+/// - Clusters are counted once for each orbit element and each translation
+///   within the supercell, in a single pass over unit cells. This counts
+///   the same clusters as `clust::make_orbits_as_indices`, including
+///   periodic images, without constructing the sets of site indices.
+/// - The hash combines the supercell transformation matrix and the counts.
+///
+/// Configurations that are equivalent by supercell symmetry always have
+/// equal hashes. Configurations with unequal hashes are not equivalent.
+/// Equal hashes do not imply equivalence, by construction (the counts do
+/// not determine the configuration) and by hash collision. Continuous DoF
+/// values are not included.
+class InvariantConfigurationHasher {
+ public:
+  /// \brief Constructor, using given orbits
+  InvariantConfigurationHasher(
+      std::shared_ptr<Prim const> const &_prim,
+      std::vector<std::set<clust::IntegralCluster>> const &_orbits);
+
+  /// \brief Constructor, generating orbits of sites with occupation DoF
+  InvariantConfigurationHasher(std::shared_ptr<Prim const> const &_prim,
+                               std::vector<double> const &max_length);
+
+  /// \brief The prim
+  std::shared_ptr<Prim const> const &prim() const;
+
+  /// \brief Number of occupant classes
+  Index n_occupant_classes() const;
+
+  /// \brief Orbits of clusters included in the hash
+  std::vector<std::set<clust::IntegralCluster>> const &orbits() const;
+
+  /// \brief Make the cluster occupant class counts of a configuration
+  std::vector<Index> make_counts(Configuration const &configuration) const;
+
+  /// \brief Make the hash of a configuration
+  std::uint64_t operator()(Configuration const &configuration) const;
+
+ private:
+  std::shared_ptr<Prim const> m_prim;
+
+  Index m_n_occupant_classes;
+
+  std::vector<std::vector<Index>> m_occupant_class;
+
+  std::vector<std::set<clust::IntegralCluster>> m_orbits;
+
+  /// Offset of the counts of each orbit, with size `m_orbits.size() + 1`
+  std::vector<Index> m_count_offsets;
+};
+
+/// \brief Hash-based container that identifies configurations that are
+///     approximately equivalent, using InvariantConfigurationHasher
+///
+/// Configurations are considered duplicates if their hashes, made by the
+/// same InvariantConfigurationHasher, are equal. If `verify_exact` is true,
+/// duplicates must also be in the same supercell and have equal canonical
+/// forms; canonical forms are only made for configurations whose hashes
+/// are equal, and are stored for later comparisons.
+///
+/// Notes:
+/// - Stores configurations as given, not in canonical form
+/// - Iteration is in order of insertion
+/// - Not thread safe
+class InvariantHashConfigurationSet {
+ public:
+  struct Entry {
+    Entry(Configuration const &_configuration, std::uint64_t _hash)
+        : configuration(_configuration), hash(_hash) {}
+
+    /// \brief The configuration, as inserted
+    Configuration configuration;
+
+    /// \brief The configuration hash
+    std::uint64_t hash;
+
+    /// \brief The canonical form, made on first use if `verify_exact`
+    mutable std::shared_ptr<Configuration const> canonical_form;
+  };
+
+  typedef std::list<Entry>::size_type size_type;
+  typedef std::list<Entry>::const_iterator const_iterator;
+
+  /// \brief Constructor
+  InvariantHashConfigurationSet(
+      std::shared_ptr<InvariantConfigurationHasher const> const &_hasher,
+      bool _verify_exact = false);
+
+  /// \brief The hasher
+  std::shared_ptr<InvariantConfigurationHasher const> const &hasher() const;
+
+  /// \brief If true, duplicates are verified by comparing canonical forms
+  bool verify_exact() const;
+
+  bool empty() const;
+
+  size_type size() const;
+
+  void clear();
+
+  const_iterator begin() const;
+
+  const_iterator end() const;
+
+  /// \brief Insert a configuration, if no duplicate is present
+  std::pair<const_iterator, bool> insert(Configuration const &configuration);
+
+  /// \brief Find a duplicate of a configuration
+  const_iterator find(Configuration const &configuration) const;
+
+  /// \brief Count duplicates of a configuration (0 or 1)
+  size_type count(Configuration const &configuration) const;
+
+ private:
+  /// \brief Find a duplicate of a configuration with the given hash
+  const_iterator _find(
+      Configuration const &configuration, std::uint64_t hash,
+      std::shared_ptr<Configuration const> &canonical_form) const;
+
+  std::shared_ptr<InvariantConfigurationHasher const> m_hasher;
+
+  bool m_verify_exact;
+
+  std::list<Entry> m_data;
+
+  std::unordered_multimap<std::uint64_t, const_iterator> m_index;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
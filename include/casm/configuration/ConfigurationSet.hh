@@ -1,22 +1,94 @@
 #ifndef CASM_config_ConfigurationSet
 #define CASM_config_ConfigurationSet
 
+#include <cstdint>
+#include <list>
 #include <map>
+#include <memory>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "casm/configuration/Configuration.hh"
+#include "casm/configuration/ContinuousDoFIndex.hh"
+#include "casm/configuration/NamePool.hh"
 #include "casm/configuration/definitions.hh"
 #include "casm/misc/Comparisons.hh"
 
 namespace CASM {
 namespace config {
 
+/// \brief Supercell-independent canonical key of a configuration
+///
+/// Configurations that are equivalent as infinite crystals, in any
+/// supercell, have the same canonical primitive configuration, and so the
+/// same key.
+struct PrimitiveCanonicalKey {
+  /// \brief Name of the canonical supercell of the canonical primitive
+  ///     configuration
+  std::string supercell_name;
+
+  /// \brief Occupation of the canonical primitive configuration, one byte
+  ///     per site
+  std::string occupation_bytes;
+
+  /// \brief Hash of the canonical primitive configuration, as by
+  ///     `make_configuration_hash`
+  std::uint64_t hash;
+
+  /// \brief The canonical primitive configuration
+  std::shared_ptr<Configuration const> canonical_primitive;
+
+  /// \brief True if keys are equal, including continuous DoF values of the
+  ///     canonical primitive configurations
+  bool operator==(PrimitiveCanonicalKey const &rhs) const;
+
+  bool operator!=(PrimitiveCanonicalKey const &rhs) const {
+    return !(*this == rhs);
+  }
+};
+
+/// \brief Make the supercell-independent canonical key of a configuration
+PrimitiveCanonicalKey make_primitive_canonical_key(
+    Configuration const &configuration);
+
+/// \brief Operations that make a configuration canonical in its supercell
+///
+/// Operations are given as the supercell factor group index and translation
+/// index that construct a SupercellSymOp.
+struct CanonicalOpInfo {
+  /// \brief Supercell factor group index of `to_canonical`
+  Index to_canonical_factor_group_index;
+
+  /// \brief Translation index of `to_canonical`
+  Index to_canonical_translation_index;
+
+  /// \brief Supercell factor group index of `from_canonical`
+  Index from_canonical_factor_group_index;
+
+  /// \brief Translation index of `from_canonical`
+  Index from_canonical_translation_index;
+
+  /// \brief Number of supercell operations that leave the configuration
+  ///     invariant
+  Index invariant_subgroup_size;
+};
+
+/// \brief Make the operations that make a configuration canonical in its
+///     supercell
+CanonicalOpInfo make_canonical_op_info(Configuration const &configuration);
+
 /// \brief Data structure for holding / reading / writing configurations
 struct ConfigurationRecord : public Comparisons<CRTPBase<ConfigurationRecord>> {
   ConfigurationRecord(Configuration const &_configuration,
                       std::string _supercell_name,
                       std::string _configuration_id);
 
+  ConfigurationRecord(Configuration &&_configuration,
+                      std::string _supercell_name,
+                      std::string _configuration_id);
+
   /// \brief Shared pointer to the configuration
   Configuration configuration;
 
@@ -36,8 +108,33 @@ struct ConfigurationRecord : public Comparisons<CRTPBase<ConfigurationRecord>> {
     return this->configuration < rhs.configuration;
   }
 
+  /// \brief Supercell-independent canonical key, made on first use
+  PrimitiveCanonicalKey const &primitive_canonical_key() const;
+
+  /// \brief Operations that make the configuration canonical, made on first
+  ///     use
+  CanonicalOpInfo const &canonical_op_info() const;
+
+  /// \brief Return rep that makes the configuration canonical
+  SupercellSymOp to_canonical() const;
+
+  /// \brief Return rep that makes the configuration from the canonical
+  ///     configuration
+  SupercellSymOp from_canonical() const;
+
+  /// \brief Number of supercell operations that leave the configuration
+  ///     invariant
+  Index invariant_subgroup_size() const;
+
  private:
   friend struct Comparisons<CRTPBase<ConfigurationRecord>>;
+
+  /// Made on first use by `primitive_canonical_key`
+  mutable std::shared_ptr<PrimitiveCanonicalKey const>
+      m_primitive_canonical_key;
+
+  /// Made on first use by `canonical_op_info`
+  mutable std::shared_ptr<CanonicalOpInfo const> m_canonical_op_info;
 };
 
 /// \brief Data structure for holding / reading / writing canonical
@@ -52,10 +149,19 @@ struct ConfigurationRecord : public Comparisons<CRTPBase<ConfigurationRecord>> {
 ///   use a std::vector<Configuration> or other container
 /// - Includes a map of supercell_name -> next configuration id that can
 ///   be used to automatically provide new configurations with sequential IDs
+/// - Lookups by primitive canonical key use an index that is built on first
+///   use and then updated on insert and erase
+/// - For prims with continuous DoF, `find_within_tol` finds configurations
+///   using an index by continuous DoF values, built on first use
 class ConfigurationSet {
  public:
   ConfigurationSet(std::map<std::string, Index> _next_config_id = {});
 
+  ConfigurationSet(ConfigurationSet const &other);
+  ConfigurationSet(ConfigurationSet &&other) = default;
+  ConfigurationSet &operator=(ConfigurationSet const &other);
+  ConfigurationSet &operator=(ConfigurationSet &&other) = default;
+
   typedef std::set<ConfigurationRecord>::size_type size_type;
   typedef std::set<ConfigurationRecord>::iterator iterator;
   typedef std::set<ConfigurationRecord>::const_iterator const_iterator;
@@ -66,6 +172,10 @@ class ConfigurationSet {
 
   void clear();
 
+  /// \brief Memory used by the records and indexes, in bytes
+  ///     (approximate), not including the shared supercells
+  Index memory_bytes() const;
+
   const_iterator begin() const;
 
   const_iterator end() const;
@@ -82,6 +192,32 @@ class ConfigurationSet {
   /// \brief Insert ConfigurationRecord, allowing custom configuration_id
   std::pair<iterator, bool> insert(ConfigurationRecord const &record);
 
+  /// \brief Insert Configuration, moving its DoF values into the set if
+  ///     inserted, setting supercell_name and configuration_id
+  ///     automatically
+  std::pair<iterator, bool> insert(Configuration &&configuration);
+
+  /// \brief Insert Configuration with known supercell_name, moving its DoF
+  ///     values into the set if inserted, setting configuration_id
+  ///     automatically
+  std::pair<iterator, bool> insert(std::string const &supercell_name,
+                                   Configuration &&configuration);
+
+  /// \brief Insert ConfigurationRecord, moved from, allowing custom
+  ///     configuration_id
+  std::pair<iterator, bool> insert(ConfigurationRecord &&record);
+
+  /// \brief Make canonical forms of many Configuration, in parallel, and
+  ///     insert them, setting supercell_name and configuration_id
+  ///     automatically
+  std::vector<std::pair<iterator, bool>> insert_many(
+      std::vector<Configuration> &&configurations, Index n_threads = 0);
+
+  /// \brief Insert the configurations of a shard of an enumeration, in the
+  ///     order they were inserted in the shard, setting configuration_id
+  ///     automatically
+  void merge(ConfigurationSet const &shard);
+
   const_iterator find(Configuration const &configuration) const;
 
   const_iterator find_by_name(std::string configuration_name) const;
@@ -90,6 +226,33 @@ class ConfigurationSet {
 
   size_type count_by_name(std::string configuration_name) const;
 
+  /// \brief Find a configuration in the same supercell whose DoF values are
+  ///     all within tolerance of those of `configuration`
+  const_iterator find_within_tol(Configuration const &configuration) const;
+
+  /// \brief Find configurations, in any supercell, that are equivalent to
+  ///     `configuration` as infinite crystals
+  std::vector<const_iterator> find_by_primitive(
+      Configuration const &configuration) const;
+
+  /// \brief Count configurations, in any supercell, that are equivalent to
+  ///     `configuration` as infinite crystals
+  size_type count_by_primitive(Configuration const &configuration) const;
+
+  /// \brief Find configurations in the supercell with name `supercell_name`
+  std::vector<const_iterator> find_by_supercell_name(
+      std::string const &supercell_name) const;
+
+  /// \brief Find configurations with supercell volume in a range
+  std::vector<const_iterator> find_by_volume(Index min_volume,
+                                             Index max_volume) const;
+
+  /// \brief Find configurations with the number of sites of one sublattice
+  ///     occupied by one occupant in a range
+  std::vector<const_iterator> find_by_occupant_count(
+      Index sublattice_index, std::string const &occupant_name,
+      Index min_count, Index max_count) const;
+
   const_iterator erase(const_iterator it);
 
   size_type erase(Configuration const &configuration);
@@ -108,12 +271,219 @@ class ConfigurationSet {
   std::set<ConfigurationRecord> const &data() const;
 
  private:
+  /// \brief Add a newly inserted record to the indexes that are in use
+  std::pair<iterator, bool> _insert_and_index(std::pair<iterator, bool> result);
+
+  /// \brief Clear all indexes, so they are rebuilt on next use
+  void _invalidate_indexes();
+
+  /// \brief Build the primitive canonical key index, if not valid
+  void _validate_primitive_key_index() const;
+
+  /// \brief Build the configuration name index, if not valid
+  void _validate_name_index() const;
+
+  /// \brief Build the supercell name, volume, and occupant count indexes,
+  ///     if not valid
+  void _validate_secondary_indexes() const;
+
+  /// \brief Add a record to the supercell name, volume, and occupant count
+  ///     indexes
+  void _add_to_secondary_indexes(const_iterator it) const;
+
+  /// \brief Remove a record from the supercell name, volume, and occupant
+  ///     count indexes
+  void _remove_from_secondary_indexes(const_iterator it);
+
+  /// \brief Build the continuous DoF values index, if not valid
+  void _validate_dof_values_index() const;
+
+  /// \brief Add a record to the continuous DoF values index
+  void _add_to_dof_values_index(const_iterator it) const;
+
   std::set<ConfigurationRecord> m_data;
 
+  // primitive canonical key hash -> element of m_data
+  mutable std::unordered_multimap<std::uint64_t, const_iterator>
+      m_index_by_primitive_key;
+
+  /// False until the primitive canonical key index is first used, or if
+  /// `data()` was accessed, so the index must be rebuilt
+  mutable bool m_primitive_key_index_is_valid;
+
+  // configuration_name -> element of m_data, the first in order if names
+  // are not unique
+  mutable ConfigurationNameIndex<const_iterator> m_index_by_name;
+
+  /// False until the configuration name index is first used, or if `data()`
+  /// was accessed, so the index must be rebuilt
+  mutable bool m_name_index_is_valid;
+
+  /// True if the configuration name index was built or updated with
+  /// non-unique names, so erasing a record requires rebuilding it
+  mutable bool m_name_index_has_duplicates;
+
+  // supercell_name -> elements of m_data
+  mutable std::multimap<std::string, const_iterator> m_index_by_supercell_name;
+
+  // supercell volume -> elements of m_data
+  mutable std::multimap<Index, const_iterator> m_index_by_volume;
+
+  // (sublattice index, occupant name) -> occupant count -> elements of m_data
+  mutable std::map<std::pair<Index, std::string>,
+                   std::multimap<Index, const_iterator>>
+      m_index_by_occupant_count;
+
+  /// False until the supercell name, volume, or occupant count index is
+  /// first used, or if `data()` was accessed, so the indexes must be rebuilt
+  mutable bool m_secondary_indexes_are_valid;
+
+  // supercell name -> continuous DoF values -> elements of m_data
+  mutable std::map<std::string, ContinuousDoFIndex<const_iterator>>
+      m_index_by_dof_values;
+
+  /// False until the continuous DoF values index is first used, or if
+  /// `data()` was accessed, so the index must be rebuilt
+  mutable bool m_dof_values_index_is_valid;
+
   // map of supercell_name -> next id to assign to a new Configuration
   std::map<std::string, Index> m_next_config_id;
 };
 
+/// \brief Merge ConfigurationSet, by a k-way merge of their sorted
+///     records
+ConfigurationSet make_merged_configuration_set(
+    std::vector<ConfigurationSet const *> const &sets, Index n_threads = 1);
+
+/// \brief Make a hash value for a Configuration, consistent with
+///     Configuration::operator==
+std::uint64_t make_configuration_hash(
+    Configuration const &configuration,
+    std::optional<double> quantum = std::nullopt);
+
+/// \brief Hash-based data structure for holding canonical configurations
+///
+/// This holds the same data as ConfigurationSet, and has the same usage
+/// requirements, but does not keep ConfigurationRecord sorted. It uses
+/// `make_configuration_hash` and `Configuration::operator==` to find
+/// configurations, and an index by configuration name, so that `find`,
+/// `insert`, and `find_by_name` take O(1) expected time instead of
+/// requiring full DoF comparisons at every level of a tree.
+///
+/// Notes:
+/// - Iteration is in order of insertion
+/// - Iterators and references are invalidated only by erasing the
+///   corresponding element
+/// - Each configuration_name must be unique; inserting a new configuration
+///   with an existing configuration_name throws
+/// - If `quantum` is given, continuous DoF values are included in the hash,
+///   rounded to multiples of `quantum`. This is only valid if all
+///   continuous DoF values are set exactly to multiples of `quantum`, as by
+///   `QuantizedCanonicalizer::make_canonical_form`.
+class UnorderedConfigurationSet {
+ public:
+  UnorderedConfigurationSet(std::map<std::string, Index> _next_config_id = {},
+                            std::optional<double> _quantum = std::nullopt);
+
+  typedef std::list<ConfigurationRecord>::size_type size_type;
+  typedef std::list<ConfigurationRecord>::iterator iterator;
+  typedef std::list<ConfigurationRecord>::const_iterator const_iterator;
+
+  bool empty() const;
+
+  size_type size() const;
+
+  void clear();
+
+  const_iterator begin() const;
+
+  const_iterator end() const;
+
+  /// \brief Insert Configuration, setting supercell_name and
+  ///     configuration_id automatically
+  std::pair<iterator, bool> insert(Configuration const &configuration);
+
+  /// \brief Insert Configuration with known supercell_name, setting
+  ///     configuration_id automatically
+  std::pair<iterator, bool> insert(std::string const &supercell_name,
+                                   Configuration const &configuration);
+
+  /// \brief Insert ConfigurationRecord, allowing custom configuration_id
+  std::pair<iterator, bool> insert(ConfigurationRecord const &record);
+
+  /// \brief Insert Configuration, moving its DoF values into the set if
+  ///     inserted, setting supercell_name and configuration_id
+  ///     automatically
+  std::pair<iterator, bool> insert(Configuration &&configuration);
+
+  /// \brief Insert Configuration with known supercell_name, moving its DoF
+  ///     values into the set if inserted, setting configuration_id
+  ///     automatically
+  std::pair<iterator, bool> insert(std::string const &supercell_name,
+                                   Configuration &&configuration);
+
+  /// \brief Insert ConfigurationRecord, moved from, allowing custom
+  ///     configuration_id
+  std::pair<iterator, bool> insert(ConfigurationRecord &&record);
+
+  /// \brief Make canonical forms of many Configuration, in parallel, and
+  ///     insert them, setting supercell_name and configuration_id
+  ///     automatically
+  std::vector<std::pair<iterator, bool>> insert_many(
+      std::vector<Configuration> &&configurations, Index n_threads = 0);
+
+  const_iterator find(Configuration const &configuration) const;
+
+  const_iterator find_by_name(std::string configuration_name) const;
+
+  size_type count(Configuration const &configuration) const;
+
+  size_type count_by_name(std::string configuration_name) const;
+
+  const_iterator erase(const_iterator it);
+
+  size_type erase(Configuration const &configuration);
+
+  size_type erase_by_name(std::string configuration_name);
+
+  /// \brief Set IDs, by supercell_name, used to automatically ID new
+  /// configurations
+  void set_next_config_id(std::map<std::string, Index> const &next_config_id);
+
+  /// \brief IDs, by supercell_name, used to automatically ID new configurations
+  std::map<std::string, Index> const &next_config_id() const;
+
+  /// \brief Grid spacing of continuous DoF values included in the hash, if
+  ///     any
+  std::optional<double> quantum() const;
+
+ private:
+  const_iterator _find(Configuration const &configuration,
+                       std::uint64_t hash) const;
+
+  /// \brief Insert a configuration that is not in the set, setting
+  ///     configuration_id automatically
+  iterator _insert_new(std::string const &supercell_name,
+                       Configuration &&configuration, std::uint64_t hash);
+
+  /// \brief Insert a record whose configuration is not in the set
+  iterator _insert_new(ConfigurationRecord &&record, std::uint64_t hash);
+
+  std::list<ConfigurationRecord> m_data;
+
+  // configuration hash -> element of m_data
+  std::unordered_multimap<std::uint64_t, iterator> m_index_by_hash;
+
+  // configuration_name -> element of m_data
+  ConfigurationNameIndex<iterator> m_index_by_name;
+
+  // map of supercell_name -> next id to assign to a new Configuration
+  std::map<std::string, Index> m_next_config_id;
+
+  // grid spacing of continuous DoF values included in the hash, if any
+  std::optional<double> m_quantum;
+};
+
 /// \brief Make a map for finding ConfigurationRecord by configuration_name
 std::map<std::string, ConfigurationRecord const *>
 make_index_by_configuration_name(
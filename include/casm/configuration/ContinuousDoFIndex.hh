@@ -0,0 +1,376 @@
+#ifndef CASM_config_ContinuousDoFIndex
+#define CASM_config_ContinuousDoFIndex
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Index of values by coordinate vectors, for finding values whose
+///     coordinates are all within tolerance of a query
+///
+/// A ContinuousDoFIndex answers "which values have coordinates `y` with
+/// `|y(k) - x(k)| <= half_width(k)` for every `k`?" for a query `x`, the
+/// same test that ConfigIsEquivalent makes on each continuous DoF value, in
+/// sublinear time for well-spread coordinates, instead of comparing
+/// against every value.
+///
+/// Coordinates may be continuous DoF values, or linear combinations of them
+/// such as normal coordinates in a DoF space. For coordinates `P * v` of
+/// DoF values `v` compared with tolerance `tol`, use
+/// `make_projected_half_width(P, tol)`, so no match is missed.
+///
+/// Method:
+/// - Values are held in a list of static k-d trees, with tree `k` holding
+///   at most `2^k` values (a logarithmic method). Inserting merges the
+///   smallest trees into the next empty one, so insertion takes amortized
+///   O(log(n)^2) k-d tree build time, and queries search O(log(n)) trees.
+/// - Each k-d tree node splits on the coordinate with the largest spread
+/// - Erasing marks a value as erased, and all trees are rebuilt once more
+///   than half of the held values are erased
+///
+/// Example:
+/// \code
+/// ContinuousDoFIndex<Index> index(dim, tol);
+/// index.insert(x, 0);
+/// std::vector<Index> found = index.find_within(y);
+/// \endcode
+template <typename ValueType>
+class ContinuousDoFIndex {
+ public:
+  /// \brief Constructor, with a half width for each coordinate
+  explicit ContinuousDoFIndex(Eigen::VectorXd const &_half_width)
+      : m_half_width(_half_width), m_size(0), m_n_erased(0) {}
+
+  /// \brief Constructor, with the same half width for every coordinate
+  ContinuousDoFIndex(Index _dim, double _half_width)
+      : ContinuousDoFIndex(Eigen::VectorXd::Constant(_dim, _half_width)) {}
+
+  /// \brief Number of coordinates
+  Index dim() const { return m_half_width.size(); }
+
+  /// \brief Half width of the query box, for each coordinate
+  Eigen::VectorXd const &half_width() const { return m_half_width; }
+
+  /// \brief Number of values held, not counting erased values
+  Index size() const { return m_size; }
+
+  bool empty() const { return m_size == 0; }
+
+  void clear();
+
+  /// \brief Add a value with the given coordinates
+  void insert(Eigen::VectorXd const &coordinates, ValueType const &value);
+
+  /// \brief Erase a value, found by its coordinates, and return true if it
+  ///     was found
+  bool erase(Eigen::VectorXd const &coordinates, ValueType const &value);
+
+  /// \brief Call `f(value)` for values within the half widths of
+  ///     `coordinates`, until `f` returns true, and return true if it did
+  template <typename F>
+  bool find_if(Eigen::VectorXd const &coordinates, F f) const;
+
+  /// \brief Return the values within the half widths of `coordinates`, in
+  ///     no particular order
+  std::vector<ValueType> find_within(Eigen::VectorXd const &coordinates) const;
+
+ private:
+  /// \brief A static k-d tree
+  ///
+  /// The node of range `[begin, end)` is the point at `mid = (begin + end) /
+  /// 2`, which splits on coordinate `split_dim[mid]`: points in `[begin,
+  /// mid)` are less than or equal to it, and points in `(mid, end)` are
+  /// greater than or equal to it, in that coordinate.
+  struct Tree {
+    /// Coordinates of point `i` are `coordinates.col(i)`
+    Eigen::MatrixXd coordinates;
+    std::vector<ValueType> values;
+    std::vector<Index> split_dim;
+    std::vector<char> is_erased;
+
+    Index size() const { return values.size(); }
+  };
+
+  /// \brief Check the dimension of coordinates
+  void _check_dim(Eigen::VectorXd const &coordinates) const;
+
+  /// \brief Move the points of tree `k`, that are not erased, to the back
+  ///     of `coordinates` and `values`, and clear the tree
+  void _take(Index k, std::vector<Eigen::VectorXd> &coordinates,
+             std::vector<ValueType> &values);
+
+  /// \brief Build a tree from points
+  static Tree _build(std::vector<Eigen::VectorXd> &coordinates,
+                     std::vector<ValueType> &values);
+
+  /// \brief Order points `order[begin, end)` as a k-d tree
+  static void _build(std::vector<Eigen::VectorXd> const &coordinates,
+                     std::vector<Index> &order, std::vector<Index> &split_dim,
+                     Index begin, Index end);
+
+  /// \brief Call `f(i)` for points `i` of a tree within the half widths,
+  ///     until `f` returns true, and return true if it did
+  template <typename F>
+  bool _search(Tree const &tree, Eigen::VectorXd const &coordinates,
+               Index begin, Index end, F &f) const;
+
+  Eigen::VectorXd m_half_width;
+
+  /// Tree `k` holds at most `2^k` points, or is empty
+  std::vector<Tree> m_trees;
+
+  /// Number of points not erased
+  Index m_size;
+
+  /// Number of erased points still held by the trees
+  Index m_n_erased;
+};
+
+/// \brief Return the half widths of coordinates `projection * v`, for
+///     values `v` compared with tolerance `tol`
+Eigen::VectorXd make_projected_half_width(Eigen::MatrixXd const &projection,
+                                          double tol);
+
+// --- Inline definitions ---
+
+template <typename ValueType>
+void ContinuousDoFIndex<ValueType>::clear() {
+  m_trees.clear();
+  m_size = 0;
+  m_n_erased = 0;
+}
+
+/// \brief Add a value with the given coordinates
+///
+/// Values are not checked for duplicates.
+template <typename ValueType>
+void ContinuousDoFIndex<ValueType>::insert(Eigen::VectorXd const &coordinates,
+                                           ValueType const &value) {
+  _check_dim(coordinates);
+  std::vector<Eigen::VectorXd> tmp_coordinates({coordinates});
+  std::vector<ValueType> tmp_values({value});
+  Index k = 0;
+  for (; k < m_trees.size() && m_trees[k].size(); ++k) {
+    _take(k, tmp_coordinates, tmp_values);
+  }
+  if (k == m_trees.size()) {
+    m_trees.emplace_back();
+  }
+  m_trees[k] = _build(tmp_coordinates, tmp_values);
+  ++m_size;
+}
+
+/// \brief Erase a value, found by its coordinates, and return true if it
+///     was found
+///
+/// \param coordinates The coordinates the value was inserted with, or
+///     coordinates within the half widths of them
+/// \param value The value, compared with `operator==`. If more than one
+///     matching value was inserted, one is erased.
+template <typename ValueType>
+bool ContinuousDoFIndex<ValueType>::erase(Eigen::VectorXd const &coordinates,
+                                          ValueType const &value) {
+  _check_dim(coordinates);
+  for (auto &tree : m_trees) {
+    auto f = [&](Index i) {
+      if (tree.values[i] == value) {
+        tree.is_erased[i] = 1;
+        return true;
+      }
+      return false;
+    };
+    if (_search(tree, coordinates, 0, tree.size(), f)) {
+      --m_size;
+      ++m_n_erased;
+      if (m_n_erased > m_size) {
+        std::vector<Eigen::VectorXd> tmp_coordinates;
+        std::vector<ValueType> tmp_values;
+        for (Index k = 0; k < m_trees.size(); ++k) {
+          _take(k, tmp_coordinates, tmp_values);
+        }
+        m_trees.clear();
+        m_n_erased = 0;
+        if (!tmp_values.empty()) {
+          Index k = 0;
+          while ((Index(1) << k) < Index(tmp_values.size())) {
+            ++k;
+          }
+          m_trees.resize(k + 1);
+          m_trees[k] = _build(tmp_coordinates, tmp_values);
+        }
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+/// \brief Call `f(value)` for values within the half widths of
+///     `coordinates`, until `f` returns true, and return true if it did
+///
+/// Values `y` are within the half widths of `coordinates` if
+/// `|y(k) - coordinates(k)| <= half_width(k)` for every `k`.
+template <typename ValueType>
+template <typename F>
+bool ContinuousDoFIndex<ValueType>::find_if(Eigen::VectorXd const &coordinates,
+                                            F f) const {
+  _check_dim(coordinates);
+  for (auto const &tree : m_trees) {
+    auto g = [&](Index i) { return bool(f(tree.values[i])); };
+    if (_search(tree, coordinates, 0, tree.size(), g)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// \brief Return the values within the half widths of `coordinates`, in
+///     no particular order
+template <typename ValueType>
+std::vector<ValueType> ContinuousDoFIndex<ValueType>::find_within(
+    Eigen::VectorXd const &coordinates) const {
+  std::vector<ValueType> result;
+  find_if(coordinates, [&](ValueType const &value) {
+    result.push_back(value);
+    return false;
+  });
+  return result;
+}
+
+template <typename ValueType>
+void ContinuousDoFIndex<ValueType>::_check_dim(
+    Eigen::VectorXd const &coordinates) const {
+  if (coordinates.size() != dim()) {
+    throw std::runtime_error(
+        "Error in ContinuousDoFIndex: coordinates size mismatch");
+  }
+}
+
+template <typename ValueType>
+void ContinuousDoFIndex<ValueType>::_take(
+    Index k, std::vector<Eigen::VectorXd> &coordinates,
+    std::vector<ValueType> &values) {
+  Tree &tree = m_trees[k];
+  for (Index i = 0; i < tree.size(); ++i) {
+    if (tree.is_erased[i]) {
+      --m_n_erased;
+    } else {
+      coordinates.push_back(tree.coordinates.col(i));
+      values.push_back(std::move(tree.values[i]));
+    }
+  }
+  tree = Tree();
+}
+
+template <typename ValueType>
+typename ContinuousDoFIndex<ValueType>::Tree
+ContinuousDoFIndex<ValueType>::_build(
+    std::vector<Eigen::VectorXd> &coordinates,
+    std::vector<ValueType> &values) {
+  Index n = values.size();
+  std::vector<Index> order(n);
+  for (Index i = 0; i < n; ++i) {
+    order[i] = i;
+  }
+  Tree tree;
+  tree.split_dim.resize(n, 0);
+  _build(coordinates, order, tree.split_dim, 0, n);
+
+  Index dim = n ? coordinates[0].size() : 0;
+  tree.coordinates.resize(dim, n);
+  tree.values.reserve(n);
+  for (Index i = 0; i < n; ++i) {
+    tree.coordinates.col(i) = coordinates[order[i]];
+    tree.values.push_back(std::move(values[order[i]]));
+  }
+  tree.is_erased.resize(n, 0);
+  return tree;
+}
+
+template <typename ValueType>
+void ContinuousDoFIndex<ValueType>::_build(
+    std::vector<Eigen::VectorXd> const &coordinates, std::vector<Index> &order,
+    std::vector<Index> &split_dim, Index begin, Index end) {
+  if (end - begin <= 1) {
+    return;
+  }
+  Index dim = coordinates[order[begin]].size();
+  Eigen::VectorXd min = coordinates[order[begin]];
+  Eigen::VectorXd max = min;
+  for (Index i = begin + 1; i < end; ++i) {
+    min = min.cwiseMin(coordinates[order[i]]);
+    max = max.cwiseMax(coordinates[order[i]]);
+  }
+  Index d = 0;
+  if (dim) {
+    (max - min).maxCoeff(&d);
+  }
+  Index mid = (begin + end) / 2;
+  if (dim) {
+    std::nth_element(order.begin() + begin, order.begin() + mid,
+                     order.begin() + end, [&](Index lhs, Index rhs) {
+                       return coordinates[lhs][d] < coordinates[rhs][d];
+                     });
+  }
+  split_dim[mid] = d;
+  _build(coordinates, order, split_dim, begin, mid);
+  _build(coordinates, order, split_dim, mid + 1, end);
+}
+
+template <typename ValueType>
+template <typename F>
+bool ContinuousDoFIndex<ValueType>::_search(Tree const &tree,
+                                            Eigen::VectorXd const &coordinates,
+                                            Index begin, Index end,
+                                            F &f) const {
+  if (begin >= end) {
+    return false;
+  }
+  Index mid = (begin + end) / 2;
+  auto const &point = tree.coordinates.col(mid);
+  if (!tree.is_erased[mid] &&
+      ((point - coordinates).cwiseAbs().array() <= m_half_width.array())
+          .all() &&
+      f(mid)) {
+    return true;
+  }
+  if (dim() == 0) {
+    return _search(tree, coordinates, begin, mid, f) ||
+           _search(tree, coordinates, mid + 1, end, f);
+  }
+  Index d = tree.split_dim[mid];
+  if (coordinates[d] - m_half_width[d] <= point[d] &&
+      _search(tree, coordinates, begin, mid, f)) {
+    return true;
+  }
+  if (coordinates[d] + m_half_width[d] >= point[d] &&
+      _search(tree, coordinates, mid + 1, end, f)) {
+    return true;
+  }
+  return false;
+}
+
+/// \brief Return the half widths of coordinates `projection * v`, for
+///     values `v` compared with tolerance `tol`
+///
+/// If every `|v(j) - w(j)| <= tol`, then `|(projection * (v - w))(k)| <=
+/// tol * sum_j |projection(k, j)|`, so using these half widths finds every
+/// value whose DoF values are within `tol`. For normal coordinates in a
+/// DoF space, `projection` is the pseudo-inverse of the basis. Matches
+/// found this way should then be checked by comparing DoF values.
+inline Eigen::VectorXd make_projected_half_width(
+    Eigen::MatrixXd const &projection, double tol) {
+  return tol * projection.cwiseAbs().rowwise().sum();
+}
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef CASM_config_DoFSpaceAnalysisCache
+#define CASM_config_DoFSpaceAnalysisCache
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "casm/configuration/config_space_analysis.hh"
+#include "casm/configuration/dof_space_analysis.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Cache of DoFSpace and configuration space symmetry analysis
+///     results, keyed by the contents of the inputs
+///
+/// Symmetry analysis of a DoFSpace, by `dof_space_analysis`, or of a set of
+/// configurations, by `config_space_analysis`, is done once for each
+/// distinct set of inputs and shared as immutable results by all later
+/// requests.
+///
+/// Notes:
+/// - The key is a JSON string containing the prim, the inputs, and the
+///   method options that affect the results. Results do not depend on the
+///   number of threads used, so it is not part of the key.
+/// - If a cache directory is set, results are also written to
+///   `<cache_dir>/<hash>.json` and read from there when not in memory.
+///   The full key is stored in the file and checked when reading, so hash
+///   collisions and stale files only result in repeating the analysis.
+/// - Results are read from memory or from file without calling `log`.
+/// - Thread-safe. Analysis is done outside of the lock, so concurrent
+///   requests for the same new key may each do the analysis, and the first
+///   stored result is returned to all.
+class DoFSpaceAnalysisCache {
+ public:
+  typedef std::map<DoFKey, ConfigSpaceAnalysisResults>
+      config_space_results_type;
+
+  DoFSpaceAnalysisCache(std::optional<fs::path> _cache_dir = std::nullopt);
+
+  /// \brief Return `dof_space_analysis` results
+  std::shared_ptr<DoFSpaceAnalysisResults const> dof_space_analysis(
+      clexulator::DoFSpace const &dof_space, std::shared_ptr<Prim const> prim,
+      std::optional<Configuration> configuration = std::nullopt,
+      std::optional<bool> exclude_homogeneous_modes = std::nullopt,
+      bool include_default_occ_modes = false,
+      std::optional<std::map<int, int>> sublattice_index_to_default_occ =
+          std::nullopt,
+      std::optional<std::map<Index, int>> site_index_to_default_occ =
+          std::nullopt,
+      bool calc_wedges = false, std::optional<Log> log = std::nullopt,
+      bool use_character_projection = false, bool use_kstar_blocks = false,
+      Index n_threads = 1);
+
+  /// \brief Return `config_space_analysis` results
+  std::shared_ptr<config_space_results_type const> config_space_analysis(
+      std::map<std::string, Configuration> const &configurations,
+      std::optional<std::vector<DoFKey>> dofs = std::nullopt,
+      std::optional<bool> exclude_homogeneous_modes = std::nullopt,
+      bool include_default_occ_modes = false,
+      std::optional<std::map<int, int>> sublattice_index_to_default_occ =
+          std::nullopt,
+      std::optional<std::map<Index, int>> site_index_to_default_occ =
+          std::nullopt,
+      double tol = TOL, bool store_equivalents = true, Index batch_size = 256,
+      Index n_threads = 1,
+      std::shared_ptr<ProgressMonitor> progress = nullptr);
+
+  /// \brief Directory for results files, or std::nullopt for memory only
+  std::optional<fs::path> cache_dir() const;
+
+  /// \brief Set the directory for results files, or std::nullopt for memory
+  ///     only
+  void set_cache_dir(std::optional<fs::path> _cache_dir);
+
+  /// \brief Number of results held in memory
+  Index size() const;
+
+  /// \brief Clear results held in memory, leaving any results files
+  void clear();
+
+ private:
+  mutable std::mutex m_mutex;
+
+  std::optional<fs::path> m_cache_dir;
+
+  std::map<std::string, std::shared_ptr<DoFSpaceAnalysisResults const>>
+      m_dof_space_results;
+
+  std::map<std::string, std::shared_ptr<config_space_results_type const>>
+      m_config_space_results;
+};
+
+/// \brief Process-wide DoFSpaceAnalysisCache, memory only unless a cache
+///     directory is set
+DoFSpaceAnalysisCache &default_dof_space_analysis_cache();
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
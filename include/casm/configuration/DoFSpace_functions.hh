@@ -1,9 +1,13 @@
 #ifndef CASM_config_dof_space_functions
 #define CASM_config_dof_space_functions
 
+#include <Eigen/SparseCore>
 #include <map>
+#include <set>
+#include <vector>
 
 #include "casm/clexulator/DoFSpace.hh"
+#include "casm/configuration/Configuration.hh"
 
 namespace CASM {
 namespace clexulator {
@@ -36,6 +40,116 @@ clexulator::DoFSpace exclude_homogeneous_mode_space(
     clexulator::DoFSpace const &dof_space_in,
     std::optional<bool> exclude_homogeneous_modes = std::nullopt);
 
+/// \brief Return DoF values vectors of many configurations, as columns
+Eigen::MatrixXd make_dof_vector_values(
+    std::vector<Configuration> const &configurations,
+    clexulator::DoFSpace const &dof_space);
+
+/// \brief Return normal coordinates of many configurations, as rows
+Eigen::MatrixXd make_normal_coordinates(
+    std::vector<Configuration> const &configurations,
+    clexulator::DoFSpace const &dof_space);
+
+// --- SparseDoFSpace ---
+
+/// \brief A DoF space with a sparse basis
+///
+/// A SparseDoFSpace has the same axes, in the same order, as the standard
+/// clexulator::DoFSpace with the same `dof_key`,
+/// `transformation_matrix_to_super`, and `sites`, and a basis of the same
+/// space, but the basis and its pseudo-inverse are sparse and the dense
+/// standard basis is never constructed. Occupation DoF spaces of large
+/// supercells, whose bases are selections of standard axes, take O(dim)
+/// memory, and projecting DoF values onto the basis costs O(nnz).
+///
+/// Use `make_dense_dof_space` to construct the equivalent DoFSpace, for
+/// example to store results.
+struct SparseDoFSpace {
+  /// \brief The prim
+  std::shared_ptr<xtal::BasicStructure const> prim;
+
+  /// \brief The DoF type
+  DoFKey dof_key;
+
+  /// \brief True for global DoF
+  bool is_global;
+
+  /// \brief Supercell transformation matrix, for local DoF
+  std::optional<Eigen::Matrix3l> transformation_matrix_to_super;
+
+  /// \brief Supercell sites included, if not all sites, for local DoF
+  std::optional<std::set<Index>> sites;
+
+  /// \brief Supercell site index of each axis, for local DoF
+  std::vector<Index> axis_site_index;
+
+  /// \brief DoF component (or occupant index) of each axis
+  std::vector<Index> axis_dof_component;
+
+  /// \brief Basis, as columns, with one row per axis
+  Eigen::SparseMatrix<double> basis;
+
+  /// \brief Pseudo-inverse of `basis`
+  Eigen::SparseMatrix<double> basis_inv;
+
+  /// \brief Number of axes
+  Index dim() const { return basis.rows(); }
+};
+
+/// \brief Make the standard SparseDoFSpace, with identity basis
+SparseDoFSpace make_sparse_dof_space(
+    DoFKey const &dof_key,
+    std::shared_ptr<xtal::BasicStructure const> const &prim,
+    std::optional<Eigen::Matrix3l> transformation_matrix_to_super =
+        std::nullopt,
+    std::optional<std::set<Index>> sites = std::nullopt);
+
+/// \brief Make a SparseDoFSpace from a DoFSpace
+SparseDoFSpace make_sparse_dof_space(clexulator::DoFSpace const &dof_space,
+                                     double tol = TOL);
+
+/// \brief Make the DoFSpace equivalent to a SparseDoFSpace
+clexulator::DoFSpace make_dense_dof_space(SparseDoFSpace const &dof_space);
+
+/// Removes specified occupation modes from the SparseDoFSpace basis, by
+/// sublattice
+SparseDoFSpace exclude_default_occ_modes_by_sublattice(
+    SparseDoFSpace const &dof_space,
+    std::map<int, int> sublattice_index_to_default_occ);
+
+/// Removes specified occupation modes from the SparseDoFSpace basis, by
+/// supercell site index
+SparseDoFSpace exclude_default_occ_modes_by_site(
+    SparseDoFSpace const &dof_space,
+    std::map<Index, int> site_index_to_default_occ);
+
+/// Removes specified occupation modes from the SparseDoFSpace basis
+SparseDoFSpace exclude_default_occ_modes(
+    SparseDoFSpace const &dof_space_in, bool include_default_occ_modes = false,
+    std::optional<std::map<int, int>> sublattice_index_to_default_occ =
+        std::nullopt,
+    std::optional<std::map<Index, int>> site_index_to_default_occ =
+        std::nullopt);
+
+/// Removes homogeneous modes from the SparseDoFSpace basis
+SparseDoFSpace exclude_homogeneous_mode_space(
+    SparseDoFSpace const &dof_space_in,
+    std::optional<bool> exclude_homogeneous_modes = std::nullopt);
+
+/// \brief Return DoF values vectors of many configurations, as columns
+Eigen::MatrixXd make_dof_vector_values(
+    std::vector<Configuration> const &configurations,
+    SparseDoFSpace const &dof_space);
+
+/// \brief Return normal coordinates of many configurations, as rows
+Eigen::MatrixXd make_normal_coordinates(
+    std::vector<Configuration> const &configurations,
+    SparseDoFSpace const &dof_space);
+
+/// \brief Return the normal coordinate of DoF values in a SparseDoFSpace
+Eigen::VectorXd get_normal_coordinate(ConfigDoFValues const &dof_values,
+                                      SparseDoFSpace const &dof_space);
+
 }  // namespace config
 }  // namespace CASM
 
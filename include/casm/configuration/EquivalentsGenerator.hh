@@ -0,0 +1,121 @@
+#ifndef CASM_config_EquivalentsGenerator
+#define CASM_config_EquivalentsGenerator
+
+#include <memory>
+#include <vector>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Generate the distinct symmetrically equivalent configurations one
+///     at a time
+///
+/// This generates the same configurations as `make_equivalents`, without
+/// storing them or comparing each against the previous ones. The subgroup,
+/// H, of supercell operations that leave the configuration invariant is
+/// found once. Operations g and g' generate the same equivalent if and only
+/// if g' is in the left coset gH, so each equivalent is generated by
+/// applying the first operation in `[begin, end)` of each coset that is
+/// not yet covered.
+///
+/// Example:
+/// \code
+/// EquivalentsGenerator generator(configuration, begin, end);
+/// while (generator.is_valid()) {
+///   Configuration const &equivalent = generator.value();
+///   ...
+///   generator.advance();
+/// }
+/// \endcode
+///
+/// Notes:
+/// - Equivalents are generated in the order of the first operation in
+///   `[begin, end)` that generates them, not the sorted order returned by
+///   `make_equivalents`.
+/// - `size()` is the number of distinct equivalents, known at construction
+///   without transforming any configuration.
+/// - The operations in `[begin, end)` need not form a group.
+class EquivalentsGenerator {
+ public:
+  /// \brief Constructor
+  template <typename SupercellSymOpIt>
+  EquivalentsGenerator(Configuration const &_configuration,
+                       SupercellSymOpIt begin, SupercellSymOpIt end);
+
+  /// \brief Get the current equivalent configuration
+  Configuration const &value() const { return m_current; }
+
+  /// \brief Get the operation that generates the current equivalent
+  ///
+  /// Satisfies `value() == copy_apply(op(), configuration)`.
+  SupercellSymOp const &op() const { return m_op; }
+
+  /// \brief Generate the next distinct equivalent configuration
+  void advance();
+
+  /// \brief Return true if `value` is valid, false if no more equivalents
+  bool is_valid() const { return m_position < m_representatives.size(); }
+
+  /// \brief Number of distinct equivalent configurations
+  Index size() const { return m_representatives.size(); }
+
+  /// \brief The subgroup of all supercell operations that leave the
+  ///     configuration invariant
+  std::vector<SupercellSymOpHandle> const &invariant_subgroup() const {
+    return m_invariant_subgroup;
+  }
+
+  /// \brief The first operation in `[begin, end)` of each left coset of the
+  ///     invariant subgroup, in the order the equivalents are generated
+  std::vector<SupercellSymOpHandle> const &representatives() const {
+    return m_representatives;
+  }
+
+ private:
+  /// \brief Find the invariant subgroup and coset representatives
+  void _init(std::vector<SupercellSymOpHandle> const &ops);
+
+  /// \brief Set m_op and m_current for m_position, if valid
+  void _set_current();
+
+  Configuration m_configuration;
+
+  std::vector<SupercellSymOpHandle> m_invariant_subgroup;
+
+  std::vector<SupercellSymOpHandle> m_representatives;
+
+  Index m_position;
+
+  SupercellSymOp m_op;
+
+  Configuration m_current;
+};
+
+/// \brief Constructor
+///
+/// \param _configuration The configuration to generate equivalents of
+/// \param begin,end The operations used to generate equivalents. Must be
+///     operations of the supercell of `_configuration`.
+template <typename SupercellSymOpIt>
+EquivalentsGenerator::EquivalentsGenerator(Configuration const &_configuration,
+                                           SupercellSymOpIt begin,
+                                           SupercellSymOpIt end)
+    : m_configuration(_configuration),
+      m_position(0),
+      m_op(SupercellSymOp::begin(_configuration.supercell)),
+      m_current(_configuration) {
+  std::vector<SupercellSymOpHandle> ops;
+  for (auto it = begin; it != end; ++it) {
+    ops.emplace_back(*it);
+  }
+  _init(ops);
+}
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -2,8 +2,10 @@
 #define CASM_config_FromStructure
 
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "casm/global/definitions.hh"
 #include "casm/global/eigen.hh"
@@ -265,6 +267,23 @@ class FromDiscreteMagneticAtomicStructure : public FromStructure {
   double m_magspin_tol;
 };
 
+/// \brief Find the supercell site at each of a set of Cartesian
+///     coordinates
+std::vector<Index> make_site_indices_by_coordinate(
+    Eigen::MatrixXd const &cart_coords, Supercell const &supercell,
+    double tol);
+
+/// \brief Construct configurations with properties from many mapped
+///     structures, in parallel
+std::vector<std::optional<ConfigurationWithProperties>>
+make_configurations_from_structures(
+    std::shared_ptr<Prim const> const &prim,
+    std::vector<xtal::SimpleStructure> const &mapped_structures,
+    std::vector<std::string> &error_messages,
+    std::string converter = "isotropic_atomic",
+    std::shared_ptr<SupercellSet> supercells = nullptr,
+    double magspin_tol = 1.0, Index n_threads = 1);
+
 }  // namespace config
 }  // namespace CASM
 
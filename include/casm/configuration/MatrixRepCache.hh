@@ -0,0 +1,126 @@
+#ifndef CASM_config_MatrixRepCache
+#define CASM_config_MatrixRepCache
+
+#include <Eigen/SparseCore>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief A matrix representation of a group of SupercellSymOp, as
+///     constructed by `make_sparse_matrix_rep`
+struct MatrixRep {
+  /// \brief The sparse matrix representation
+  std::vector<Eigen::SparseMatrix<double>> sparse_matrix_rep;
+
+  /// \brief The represented group, as a SymGroup
+  std::shared_ptr<SymGroup const> symgroup;
+
+  /// \brief Memory used by the matrices, in bytes (approximate)
+  Index memory_bytes() const;
+};
+
+/// \brief Least recently used cache of matrix representations of groups of
+///     SupercellSymOp
+///
+/// Constructing the matrix representation of a group for a DoF, by
+/// `make_sparse_matrix_rep`, also constructs the represented SymGroup,
+/// which is costly for large groups. A MatrixRepCache does this once for
+/// each distinct (supercell, group, DoF key, sites) and shares the result
+/// as an immutable MatrixRep.
+///
+/// Notes:
+/// - The key is the prim, the supercell transformation matrix, the
+///   `(supercell_factor_group_index, translation_index)` of each operation
+///   in the group, in order, the DoF key, and, for occupation and local
+///   DoF, the site indices. Equal supercells constructed separately share
+///   entries. Entries hold the prim, so a key is not re-used by a
+///   different prim at the same address.
+/// - If the total memory used by cached matrices is larger than
+///   `max_total_bytes()`, or than allowed by the memory budget (see
+///   `set_memory_budget`), least recently used entries are evicted. Held
+///   results remain valid after eviction.
+/// - Thread-safe. Matrix representations are constructed outside of the
+///   lock, so concurrent requests for the same new key may each construct
+///   it, and the first stored result is returned to all.
+class MatrixRepCache {
+ public:
+  MatrixRepCache(Index _max_total_bytes = Index(1) << 28);
+
+  /// \brief Return the sparse matrix representation of `group` that
+  ///     describes the transformation of the specified DoF
+  std::shared_ptr<MatrixRep const> matrix_rep(
+      std::vector<SupercellSymOp> const &group, DoFKey key,
+      std::optional<std::set<Index>> site_indices);
+
+  /// \brief Return the dense matrix representation of `group` that
+  ///     describes the transformation of the specified DoF
+  std::vector<Eigen::MatrixXd> make_matrix_rep(
+      std::vector<SupercellSymOp> const &group, DoFKey key,
+      std::optional<std::set<Index>> site_indices,
+      std::shared_ptr<SymGroup const> &symgroup);
+
+  /// \brief Maximum total memory used by cached matrices, in bytes
+  Index max_total_bytes() const;
+
+  /// \brief Set the maximum total memory used by cached matrices, in bytes
+  void set_max_total_bytes(Index _max_total_bytes);
+
+  /// \brief Total memory used by cached matrices, in bytes
+  Index total_bytes() const;
+
+  /// \brief Evict least recently used entries until the total memory used
+  ///     by cached matrices is at most `max_total_bytes`
+  Index evict_to(Index max_total_bytes);
+
+  /// \brief Number of cached matrix representations
+  Index size() const;
+
+  /// \brief Clear all cached matrix representations
+  void clear();
+
+ private:
+  typedef std::tuple<Prim const *, std::vector<long>,
+                     std::vector<std::pair<Index, Index>>, DoFKey,
+                     std::optional<std::set<Index>>>
+      key_type;
+
+  struct Entry {
+    key_type key;
+    std::shared_ptr<Prim const> prim;
+    std::shared_ptr<MatrixRep const> value;
+  };
+
+  /// \brief Evict least recently used entries, requires holding m_mutex
+  void _evict();
+
+  mutable std::mutex m_mutex;
+
+  Index m_max_total_bytes;
+
+  Index m_total_bytes;
+
+  /// Entries, most recently used first
+  std::list<Entry> m_lru;
+
+  std::map<key_type, std::list<Entry>::iterator> m_index;
+};
+
+/// \brief Process-wide MatrixRepCache, used by `dof_space_analysis` and
+///     `make_dof_space_rep`
+MatrixRepCache &default_matrix_rep_cache();
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef CASM_config_NamePool
+#define CASM_config_NamePool
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Interned names, each distinct name given a small integer id
+///
+/// Ids are assigned in order of first insertion, starting from 0, and are
+/// not reused.
+class NamePool {
+ public:
+  /// \brief Return the id of `name`, adding it if not already present
+  Index intern(std::string const &name);
+
+  /// \brief Return the id of `name`, or -1 if not present
+  Index find(std::string const &name) const;
+
+  /// \brief Return the name with id `id`
+  std::string const &name(Index id) const { return m_names[id]; }
+
+  /// \brief Number of distinct names
+  Index size() const { return m_names.size(); }
+
+  void clear();
+
+ private:
+  std::vector<std::string> m_names;
+
+  std::unordered_map<std::string, Index> m_ids;
+};
+
+/// \brief Split a configuration name, "<supercell_name>/<configuration_id>",
+///     at the last '/'
+///
+/// If there is no '/', the whole name is returned as the supercell name,
+/// with an empty configuration id.
+std::pair<std::string, std::string> split_configuration_name(
+    std::string const &configuration_name);
+
+/// \brief Index of records by configuration name, with supercell names
+///     interned
+///
+/// Configuration names share a few supercell names, so the supercell name
+/// part of each name is stored once, in a NamePool, and records are found
+/// by supercell name id and then by the short configuration id. This
+/// avoids storing and hashing a full copy of every configuration name.
+template <typename IteratorType>
+class ConfigurationNameIndex {
+ public:
+  /// \brief Add `it` as the record named `configuration_name`, return false
+  ///     and do nothing if the name is already present
+  bool insert(std::string const &configuration_name, IteratorType it) {
+    auto parts = split_configuration_name(configuration_name);
+    Index id = m_supercell_names.intern(parts.first);
+    if (id == m_by_configuration_id.size()) {
+      m_by_configuration_id.emplace_back();
+    }
+    return m_by_configuration_id[id].emplace(parts.second, it).second;
+  }
+
+  /// \brief Find the record named `configuration_name`, return nullptr if
+  ///     not present
+  IteratorType const *find(std::string const &configuration_name) const {
+    auto parts = split_configuration_name(configuration_name);
+    Index id = m_supercell_names.find(parts.first);
+    if (id == -1) {
+      return nullptr;
+    }
+    auto const &records = m_by_configuration_id[id];
+    auto it = records.find(parts.second);
+    if (it == records.end()) {
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  /// \brief Remove the record named `configuration_name`, if present
+  void erase(std::string const &configuration_name) {
+    auto parts = split_configuration_name(configuration_name);
+    Index id = m_supercell_names.find(parts.first);
+    if (id != -1) {
+      m_by_configuration_id[id].erase(parts.second);
+    }
+  }
+
+  void clear() {
+    m_supercell_names.clear();
+    m_by_configuration_id.clear();
+  }
+
+  /// \brief The interned supercell names
+  NamePool const &supercell_names() const { return m_supercell_names; }
+
+ private:
+  NamePool m_supercell_names;
+
+  // supercell name id -> configuration_id -> record
+  std::vector<std::unordered_map<std::string, IteratorType>>
+      m_by_configuration_id;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
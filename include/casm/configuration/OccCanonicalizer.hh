@@ -0,0 +1,336 @@
+#ifndef CASM_config_OccCanonicalizer
+#define CASM_config_OccCanonicalizer
+
+#include <cstdint>
+
+#include "casm/configuration/CanonicalWitnessList.hh"
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/PackedOccupation.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Fast canonical form methods for occupation-only configurations
+///
+/// For prim with occupation DoF only (no continuous global or local DoF),
+/// this gives the same results as `is_canonical`, `to_canonical`, and
+/// `make_canonical_form` in `canonical_form.hh`, but with a faster comparison
+/// method.
+///
+/// Method:
+/// - The occupation is stored as a contiguous `std::uint8_t` buffer
+/// - When the supercell factor group operation changes, the occupation
+///   is permuted by the factor group operation once (and occupant indices
+///   transformed, if anisotropic), so that comparisons under translations
+///   only require a single indirection per site
+/// - Permuted values are gathered in blocks and compared to the current
+///   greatest occupation with `std::memcmp`, exiting at the first differing
+///   block
+///
+/// The `_pruned` methods use an alternate search which avoids most full
+/// comparisons for dilute occupations in large supercells. For each factor
+/// group operation, the set of candidate translations is narrowed site by
+/// site, keeping only those translations that give the greatest value on
+/// that site, and the factor group operation is abandoned as soon as the
+/// greatest value on a site is less than the current best. Results are
+/// identical to the exhaustive methods.
+///
+/// Notes:
+/// - Construct once per supercell and re-use for many occupations
+/// - Not thread safe; use one OccCanonicalizer per thread
+class OccCanonicalizer {
+ public:
+  /// \brief Constructor
+  explicit OccCanonicalizer(std::shared_ptr<Supercell const> const &_supercell);
+
+  /// \brief Return true if prim has occupation DoF only
+  static bool is_supported(Prim const &prim);
+
+  /// \brief The supercell
+  std::shared_ptr<Supercell const> const &supercell() const;
+
+  /// \brief Return true if occupation is in canonical form
+  template <typename SupercellSymOpIt>
+  bool is_canonical(Eigen::VectorXi const &occupation, SupercellSymOpIt begin,
+                    SupercellSymOpIt end);
+
+  /// \brief Return true if packed occupation is in canonical form
+  template <typename SupercellSymOpIt>
+  bool is_canonical(PackedOccupation const &occupation,
+                    SupercellSymOpIt begin, SupercellSymOpIt end);
+
+  /// \brief Return the first rep in [begin, end) showing that the
+  ///     occupation is not in canonical form, or `end`
+  template <typename SupercellSymOpIt>
+  SupercellSymOpIt find_witness(Eigen::VectorXi const &occupation,
+                                SupercellSymOpIt begin, SupercellSymOpIt end);
+
+  /// \brief Return a rep in [begin, end) showing that the occupation is not
+  ///     in canonical form, trying recent witnesses first, or `end`
+  template <typename SupercellSymOpIt>
+  SupercellSymOpIt find_witness(Eigen::VectorXi const &occupation,
+                                SupercellSymOpIt begin, SupercellSymOpIt end,
+                                CanonicalWitnessList &recent);
+
+  /// \brief Return the first rep in [begin, end) that makes the occupation
+  ///     canonical
+  template <typename SupercellSymOpIt>
+  SupercellSymOp to_canonical(Eigen::VectorXi const &occupation,
+                              SupercellSymOpIt begin, SupercellSymOpIt end);
+
+  /// \brief Return the canonical occupation
+  template <typename SupercellSymOpIt>
+  Eigen::VectorXi make_canonical_occupation(Eigen::VectorXi const &occupation,
+                                            SupercellSymOpIt begin,
+                                            SupercellSymOpIt end);
+
+  /// \brief Return true if configuration is in canonical form, using all
+  ///     supercell operations
+  bool is_canonical(Configuration const &configuration);
+
+  /// \brief Return rep that makes a configuration canonical, using all
+  ///     supercell operations
+  SupercellSymOp to_canonical(Configuration const &configuration);
+
+  /// \brief Return the canonical configuration, using all supercell
+  ///     operations
+  Configuration make_canonical_form(Configuration const &configuration);
+
+  /// \brief Return rep that makes a configuration canonical, using all
+  ///     supercell operations and translation pruning
+  SupercellSymOp to_canonical_pruned(Configuration const &configuration);
+
+  /// \brief Return the canonical configuration, using all supercell
+  ///     operations and translation pruning
+  Configuration make_canonical_form_pruned(Configuration const &configuration);
+
+  /// \brief Return true if configuration is in canonical form, using all
+  ///     supercell operations
+  bool is_canonical(OccConfiguration const &configuration);
+
+  /// \brief Return the canonical configuration, using all supercell
+  ///     operations
+  OccConfiguration make_canonical_form(OccConfiguration const &configuration);
+
+  /// \brief Return the canonical configuration, using all supercell
+  ///     operations and translation pruning
+  OccConfiguration make_canonical_form_pruned(
+      OccConfiguration const &configuration);
+
+ private:
+  /// \brief Copy occupation into m_occ, and invalidate m_fg_index
+  void _set_occupation(Eigen::VectorXi const &occupation);
+
+  /// \brief Copy packed occupation into m_occ, and invalidate m_fg_index
+  void _set_occupation(PackedOccupation const &occupation);
+
+  /// \brief Return true if m_occ is in canonical form
+  template <typename SupercellSymOpIt>
+  bool _is_canonical(SupercellSymOpIt begin, SupercellSymOpIt end);
+
+  /// \brief Return the first rep in [begin, end) showing that m_occ is not
+  ///     in canonical form, or `end`
+  template <typename SupercellSymOpIt>
+  SupercellSymOpIt _find_witness(SupercellSymOpIt begin, SupercellSymOpIt end);
+
+  /// \brief Find the canonical form of m_occ
+  template <typename SupercellSymOpIt>
+  SupercellSymOp _to_canonical(SupercellSymOpIt begin, SupercellSymOpIt end);
+
+  /// \brief Compare copy_apply(op, occupation) to m_best
+  ///
+  /// Returns -1, 0, or 1 if less than, equal, or greater than m_best. If
+  /// greater and `complete_if_greater`, m_candidate holds the complete
+  /// transformed occupation on return.
+  int _compare_to_best(SupercellSymOp const &op, bool complete_if_greater);
+
+  /// \brief Gather copy_apply(op, occupation) into m_candidate
+  void _gather(SupercellSymOp const &op, Index begin, Index end);
+
+  /// \brief Update m_occ_fg if op has a different factor group operation
+  void _update_fg(SupercellSymOp const &op);
+
+  /// \brief Find the canonical form of m_occ, with translation pruning
+  SupercellSymOp _to_canonical_pruned();
+
+  /// \brief Index of the site permuted onto site i by translation t
+  Index _translation_permute_index(Index t, Index i) const;
+
+  std::shared_ptr<Supercell const> m_supercell;
+
+  Index m_n_sites;
+
+  bool m_has_aniso_occs;
+
+  /// Sublattice index, by site index
+  std::vector<Index> m_site_sublattice;
+
+  /// Occupation being canonicalized
+  std::vector<std::uint8_t> m_occ;
+
+  /// Occupation transformed by factor group operation m_fg_index only
+  std::vector<std::uint8_t> m_occ_fg;
+
+  /// Supercell factor group index of m_occ_fg, or -1 if invalid
+  Index m_fg_index;
+
+  /// Greatest occupation found so far
+  std::vector<std::uint8_t> m_best;
+
+  /// Transformed occupation being compared
+  std::vector<std::uint8_t> m_candidate;
+
+  /// Translations still able to give the greatest occupation, used by
+  /// _to_canonical_pruned
+  std::vector<Index> m_candidate_translations;
+
+  /// Values on the current site for m_candidate_translations
+  std::vector<std::uint8_t> m_candidate_values;
+
+  /// Ranges of sites on sublattices with more than one allowed occupant,
+  /// the only sites which are gathered and compared
+  std::vector<std::pair<Index, Index>> m_site_ranges;
+};
+
+// --- Inline definitions ---
+
+/// \brief Return true if occupation is in canonical form
+///
+/// If true, then `occupation` satisfies, for all `rep` in `[begin, end)`:
+///     occupation >= copy_apply(rep, occupation)
+template <typename SupercellSymOpIt>
+bool OccCanonicalizer::is_canonical(Eigen::VectorXi const &occupation,
+                                    SupercellSymOpIt begin,
+                                    SupercellSymOpIt end) {
+  _set_occupation(occupation);
+  return _is_canonical(begin, end);
+}
+
+/// \brief Return true if packed occupation is in canonical form
+///
+/// Same as `is_canonical(occupation.unpack(), begin, end)`, without
+/// unpacking.
+template <typename SupercellSymOpIt>
+bool OccCanonicalizer::is_canonical(PackedOccupation const &occupation,
+                                    SupercellSymOpIt begin,
+                                    SupercellSymOpIt end) {
+  _set_occupation(occupation);
+  return _is_canonical(begin, end);
+}
+
+/// \brief Return the first rep in [begin, end) showing that the
+///     occupation is not in canonical form, or `end`
+///
+/// \returns The first `it` in `[begin, end)` such that
+///     `occupation < copy_apply(*it, occupation)`, the "witness", or `end`
+///     if `occupation` is in canonical form.
+template <typename SupercellSymOpIt>
+SupercellSymOpIt OccCanonicalizer::find_witness(
+    Eigen::VectorXi const &occupation, SupercellSymOpIt begin,
+    SupercellSymOpIt end) {
+  _set_occupation(occupation);
+  return _find_witness(begin, end);
+}
+
+/// \brief Return a rep in [begin, end) showing that the occupation is not
+///     in canonical form, trying recent witnesses first, or `end`
+///
+/// Same as `find_witness(occupation, begin, end)`, except that the
+/// witnesses in `recent` are tried first (see CanonicalWitnessList), so the
+/// witness returned may not be the first. Requires random access
+/// iterators, and `recent` must only be used with the same range of
+/// operations.
+template <typename SupercellSymOpIt>
+SupercellSymOpIt OccCanonicalizer::find_witness(
+    Eigen::VectorXi const &occupation, SupercellSymOpIt begin,
+    SupercellSymOpIt end, CanonicalWitnessList &recent) {
+  _set_occupation(occupation);
+  m_best = m_occ;
+  Index i = recent.find(std::distance(begin, end), [&](Index k) {
+    return _compare_to_best(*(begin + k), false) > 0;
+  });
+  return i == -1 ? end : begin + i;
+}
+
+/// \brief Return true if m_occ is in canonical form
+template <typename SupercellSymOpIt>
+bool OccCanonicalizer::_is_canonical(SupercellSymOpIt begin,
+                                     SupercellSymOpIt end) {
+  return _find_witness(begin, end) == end;
+}
+
+/// \brief Return the first rep in [begin, end) showing that m_occ is not
+///     in canonical form, or `end`
+template <typename SupercellSymOpIt>
+SupercellSymOpIt OccCanonicalizer::_find_witness(SupercellSymOpIt begin,
+                                                 SupercellSymOpIt end) {
+  m_best = m_occ;
+  for (auto it = begin; it != end; ++it) {
+    if (_compare_to_best(*it, false) > 0) {
+      return it;
+    }
+  }
+  return end;
+}
+
+/// \brief Return the first rep in [begin, end) that makes the occupation
+///     canonical
+///
+/// The result, `rep`, is the first in `[begin, end)` that satisfies:
+///     canonical_occupation == copy_apply(rep, occupation)
+template <typename SupercellSymOpIt>
+SupercellSymOp OccCanonicalizer::to_canonical(Eigen::VectorXi const &occupation,
+                                              SupercellSymOpIt begin,
+                                              SupercellSymOpIt end) {
+  _set_occupation(occupation);
+  return _to_canonical(begin, end);
+}
+
+/// \brief Find the canonical form of m_occ
+///
+/// On return, m_best holds the canonical occupation.
+template <typename SupercellSymOpIt>
+SupercellSymOp OccCanonicalizer::_to_canonical(SupercellSymOpIt begin,
+                                               SupercellSymOpIt end) {
+  if (begin == end) {
+    throw std::runtime_error(
+        "Error in OccCanonicalizer::to_canonical: empty range");
+  }
+  auto it = begin;
+  SupercellSymOp best_op = *it;
+  _update_fg(best_op);
+  _gather(best_op, 0, m_n_sites);
+  std::swap(m_best, m_candidate);
+  ++it;
+  for (; it != end; ++it) {
+    if (_compare_to_best(*it, true) > 0) {
+      std::swap(m_best, m_candidate);
+      best_op = *it;
+    }
+  }
+  return best_op;
+}
+
+/// \brief Return the canonical occupation
+///
+/// The result, `canonical_occupation`, satisfies for all `rep` in
+/// `[begin, end)`:
+///     canonical_occupation >= copy_apply(rep, occupation)
+template <typename SupercellSymOpIt>
+Eigen::VectorXi OccCanonicalizer::make_canonical_occupation(
+    Eigen::VectorXi const &occupation, SupercellSymOpIt begin,
+    SupercellSymOpIt end) {
+  this->to_canonical(occupation, begin, end);
+  Eigen::VectorXi result(m_n_sites);
+  for (Index i = 0; i < m_n_sites; ++i) {
+    result[i] = m_best[i];
+  }
+  return result;
+}
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
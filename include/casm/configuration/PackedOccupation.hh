@@ -0,0 +1,230 @@
+#ifndef CASM_config_PackedOccupation
+#define CASM_config_PackedOccupation
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "casm/clexulator/ConfigDoFValues.hh"
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/definitions.hh"
+#include "casm/misc/Comparisons.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Memory-compact occupation values
+///
+/// Occupant indices are packed 2 per byte if all are < 16, otherwise 1 per
+/// byte, instead of 4 bytes per site in Eigen::VectorXi. Sites are packed in
+/// order, with the lower index site in the high bits of a byte, so that
+/// comparison of packed bytes gives the same lexicographical order as
+/// comparison of occupant indices.
+///
+/// Notes:
+/// - Occupant indices must be in range [0, 256)
+/// - The packing is determined by the values, so equal occupations always
+///   have equal packed representations
+class PackedOccupation : public Comparisons<CRTPBase<PackedOccupation>> {
+ public:
+  /// \brief Construct empty PackedOccupation
+  PackedOccupation();
+
+  /// \brief Construct from occupation values
+  explicit PackedOccupation(Eigen::VectorXi const &occupation);
+
+  /// \brief Construct from occupation values
+  explicit PackedOccupation(std::vector<std::uint8_t> const &occupation);
+
+  /// \brief Number of sites
+  Index size() const { return m_size; }
+
+  /// \brief Number of bits used per site, 4 or 8
+  int bits_per_site() const { return m_bits_per_site; }
+
+  /// \brief Return occupant index on site i
+  int operator[](Index i) const {
+    if (m_bits_per_site == 8) {
+      return m_data[i];
+    }
+    std::uint8_t byte = m_data[i >> 1];
+    return (i & 1) ? (byte & 0x0f) : (byte >> 4);
+  }
+
+  /// \brief Packed data
+  std::vector<std::uint8_t> const &data() const { return m_data; }
+
+  /// \brief Return occupation values as Eigen::VectorXi
+  Eigen::VectorXi unpack() const;
+
+  /// \brief Lexicographical less than comparison of occupant indices
+  bool operator<(PackedOccupation const &rhs) const;
+
+ private:
+  friend struct Comparisons<CRTPBase<PackedOccupation>>;
+
+  bool eq_impl(PackedOccupation const &rhs) const;
+
+  Index m_size;
+
+  int m_bits_per_site;
+
+  std::vector<std::uint8_t> m_data;
+};
+
+/// \brief Memory-compact storage of a Configuration
+///
+/// Stores the occupation as PackedOccupation, and any continuous DoF values
+/// as-is. Comparisons match those of Configuration. If there are no
+/// continuous DoF, comparisons are made directly on the packed form.
+struct PackedConfiguration : public Comparisons<CRTPBase<PackedConfiguration>> {
+  /// \brief Construct from a Configuration
+  explicit PackedConfiguration(Configuration const &configuration);
+
+  /// \brief The supercell
+  std::shared_ptr<Supercell const> supercell;
+
+  /// \brief Packed occupation values
+  PackedOccupation occupation;
+
+  /// \brief Continuous DoF values (occupation is empty)
+  clexulator::ConfigDoFValues continuous_dof_values;
+
+  /// \brief True if there are any continuous DoF values
+  bool has_continuous_dof() const;
+
+  /// \brief Construct the Configuration
+  Configuration unpack() const;
+
+  /// \brief Less than comparison, equivalent to Configuration::operator<
+  bool operator<(PackedConfiguration const &rhs) const;
+
+ private:
+  friend struct Comparisons<CRTPBase<PackedConfiguration>>;
+
+  bool eq_impl(PackedConfiguration const &rhs) const;
+};
+
+/// \brief Lightweight occupation-only configuration
+///
+/// Holds only the supercell and the occupation, as PackedOccupation, so
+/// copying, comparing, and storing in sets is much cheaper than for a
+/// Configuration, which holds maps of DoF values and constructs a
+/// ConfigIsEquivalent for each comparison. Intended for enumeration loops
+/// over configurations of prim with occupation DoF only, converting to
+/// Configuration at the API boundary.
+///
+/// Accepted by:
+/// - `OccCanonicalizer::is_canonical`, `OccCanonicalizer::make_canonical_form`
+///   and `OccCanonicalizer::make_canonical_form_pruned`
+/// - `is_primitive`
+/// - `std::set<OccConfiguration>`, with the same order as
+///   `std::set<Configuration>`
+///
+/// Notes:
+/// - Only for prim with occupation DoF only (see
+///   `OccCanonicalizer::is_supported`)
+struct OccConfiguration : public Comparisons<CRTPBase<OccConfiguration>> {
+  /// \brief Constructor
+  OccConfiguration(std::shared_ptr<Supercell const> const &_supercell,
+                   PackedOccupation const &_occupation);
+
+  /// \brief Construct from a Configuration, which must not have continuous
+  ///     DoF
+  explicit OccConfiguration(Configuration const &configuration);
+
+  /// \brief The supercell
+  std::shared_ptr<Supercell const> supercell;
+
+  /// \brief Packed occupation values
+  PackedOccupation occupation;
+
+  /// \brief Construct the Configuration
+  Configuration to_configuration() const;
+
+  /// \brief Less than comparison, equivalent to Configuration::operator<
+  bool operator<(OccConfiguration const &rhs) const;
+
+ private:
+  friend struct Comparisons<CRTPBase<OccConfiguration>>;
+
+  bool eq_impl(OccConfiguration const &rhs) const;
+};
+
+/// \brief Convert OccConfiguration to Configuration
+std::set<Configuration> to_configurations(
+    std::set<OccConfiguration> const &occ_configurations);
+
+/// \brief Compare packed occupation values, with the same interface as
+///     ConfigDoFIsEquivalent::Occupation and AnisoOccupation
+///
+/// Handles both isotropic and anisotropic occupants.
+class PackedOccupationIsEquivalent {
+ public:
+  PackedOccupationIsEquivalent(PackedOccupation const &_occupation,
+                               Supercell const &_supercell);
+
+  /// \brief Return config == other, store config < other
+  bool operator()(PackedOccupation const &other) const {
+    return _for_each([&](Index i) { return (*m_occupation_ptr)[i]; },
+                     [&](Index i) { return other[i]; });
+  }
+
+  /// \brief Return config == A*config, store config < A*config
+  bool operator()(SupercellSymOp const &A) const {
+    return _for_each([&](Index i) { return (*m_occupation_ptr)[i]; },
+                     [&](Index i) { return _value(A, i); });
+  }
+
+  /// \brief Return A*config == B*config, store A*config < B*config
+  bool operator()(SupercellSymOp const &A, SupercellSymOp const &B) const {
+    return _for_each([&](Index i) { return _value(A, i); },
+                     [&](Index i) { return _value(B, i); });
+  }
+
+  /// \brief Returns less than comparison
+  ///
+  /// - Only valid after call operator returns false
+  bool is_less() const { return m_less; }
+
+ private:
+  /// \brief Value of A*config on site i
+  int _value(SupercellSymOp const &A, Index i) const {
+    Index from = A.permute_index(i);
+    int occ = (*m_occupation_ptr)[from];
+    if (!m_occ_symgroup_rep) {
+      return occ;
+    }
+    return (*m_occ_symgroup_rep)[A.prim_factor_group_index()][from / m_n_vol]
+                                [occ];
+  }
+
+  template <typename F, typename G>
+  bool _for_each(F f, G g) const {
+    for (Index i = 0; i < m_occupation_ptr->size(); i++) {
+      int a = f(i);
+      int b = g(i);
+      if (a != b) {
+        m_less = (a < b);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  PackedOccupation const *m_occupation_ptr;
+
+  Index m_n_vol;
+
+  /// Null if isotropic occupants
+  sym_info::OccSymGroupRep const *m_occ_symgroup_rep;
+
+  /// Stores (A < B) if A != B
+  mutable bool m_less;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
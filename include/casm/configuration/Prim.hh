@@ -20,6 +20,10 @@ struct Prim {
   Prim(std::vector<xtal::SymOp> const &factor_group_elements,
        std::shared_ptr<BasicStructure const> const &_basicstructure);
 
+  /// \brief Construct using existing symmetry representations
+  Prim(PrimSymInfo const &_sym_info,
+       std::shared_ptr<BasicStructure const> const &_basicstructure);
+
   /// \brief The BasicStructure specifies the primitive crystal structure
   /// (lattice and basis) and allowed degrees of freedom (DoF)
   std::shared_ptr<BasicStructure const> const basicstructure;
@@ -1,6 +1,11 @@
 #ifndef CASM_config_PrimSymInfo
 #define CASM_config_PrimSymInfo
 
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include "casm/configuration/definitions.hh"
 #include "casm/configuration/group/Group.hh"
 #include "casm/configuration/sym_info/definitions.hh"
@@ -24,6 +29,17 @@ struct PrimSymInfo {
   PrimSymInfo(std::shared_ptr<SymGroup const> const &_factor_group,
               BasicStructure const &prim);
 
+  /// \brief Construct using given factor group and symmetry representations
+  PrimSymInfo(
+      std::shared_ptr<SymGroup const> const &_factor_group,
+      sym_info::UnitCellCoordSymGroupRep _unitcellcoord_symgroup_rep,
+      sym_info::OccSymGroupRep _occ_symgroup_rep,
+      sym_info::AtomPositionSymGroupRep _atom_position_symgroup_rep,
+      std::map<DoFKey, sym_info::LocalDoFSymGroupRep> _local_dof_symgroup_rep,
+      std::map<DoFKey, sym_info::GlobalDoFSymGroupRep>
+          _global_dof_symgroup_rep,
+      BasicStructure const &prim);
+
   /// \brief Structure factor group
   std::shared_ptr<SymGroup const> factor_group;
 
@@ -44,6 +60,10 @@ struct PrimSymInfo {
   /// \brief True if any occupation DoF
   bool has_occupation_dofs;
 
+  /// \brief True for sublattices that allow more than one occupant, by
+  ///     sublattice index
+  std::vector<bool> sublattice_has_occupation_dofs;
+
   /// \brief True if any permutation in occ_symgroup_rep is non-trivial
   bool has_aniso_occs;
 
@@ -63,6 +83,36 @@ struct PrimSymInfo {
   /// occupant into another *before* permutating among sites.
   sym_info::OccSymGroupRep occ_symgroup_rep;
 
+  /// \brief Maximum number of allowed occupants on any sublattice
+  Index max_n_occupants;
+
+  /// \brief Occupant index transformations, as one contiguous table
+  ///
+  /// Usage:
+  /// \code
+  /// std::int32_t const *remap =
+  ///     occ_remap(group_element_index, sublattice_index_before);
+  /// Index occupant_index_after = remap[occupant_index_before];
+  /// \endcode
+  ///
+  /// Note:
+  /// - Equivalent to `occ_symgroup_rep`, stored as rows of length
+  ///   `max_n_occupants`, by `group_element_index * n_sublat +
+  ///   sublattice_index_before`, so that transforming occupation is a single
+  ///   lookup without indirection through nested vectors. Row entries past
+  ///   the number of occupants on the sublattice are unused.
+  std::vector<std::int32_t> occ_remap_table;
+
+  /// \brief Return the row of `occ_remap_table` for a group element and
+  ///     sublattice
+  std::int32_t const *occ_remap(Index group_element_index,
+                                Index sublattice_index) const {
+    return occ_remap_table.data() +
+           (group_element_index * sublattice_has_occupation_dofs.size() +
+            sublattice_index) *
+               max_n_occupants;
+  }
+
   /// \brief Permutations describe atom position index transformation under
   /// symmetry
   ///
@@ -102,6 +152,67 @@ struct PrimSymInfo {
   ///
   std::map<DoFKey, sym_info::LocalDoFSymGroupRep> local_dof_symgroup_rep;
 
+  /// \brief Local DoF types, by integer DoF id, in `local_dof_symgroup_rep`
+  ///     key order
+  std::vector<DoFKey> local_dof_keys;
+
+  /// \brief Local DoF matrix dimensions, as `local_dof_dim_table[dof_id *
+  ///     n_sublat + sublattice_index]`
+  std::vector<Index> local_dof_dim_table;
+
+  /// \brief Offsets of matrices in `local_dof_rep_table`, as
+  ///     `local_dof_rep_offset[(dof_id * n_group_elements +
+  ///     group_element_index) * n_sublat + sublattice_index]`
+  std::vector<Index> local_dof_rep_offset;
+
+  /// \brief Local DoF matrix representations, as one contiguous table
+  ///
+  /// Usage:
+  /// \code
+  /// Index dof_id = local_dof_id(dof_type);
+  /// Eigen::Map<Eigen::MatrixXd const> M =
+  ///     local_dof_rep(dof_id, group_element_index, sublattice_index_before);
+  /// \endcode
+  ///
+  /// Note:
+  /// - Equivalent to `local_dof_symgroup_rep`, with column-major matrices
+  ///   stored in order of DoF id, group element, and sublattice, so that
+  ///   transforming values by one group element reads consecutive matrices
+  ///   without map lookups or indirection through nested vectors
+  std::vector<double> local_dof_rep_table;
+
+  /// \brief Return the integer DoF id of local DoF type `key`, or -1 if
+  ///     there is no local DoF of that type
+  Index local_dof_id(DoFKey const &key) const {
+    auto it = std::lower_bound(local_dof_keys.begin(), local_dof_keys.end(),
+                               key);
+    if (it == local_dof_keys.end() || *it != key) {
+      return -1;
+    }
+    return it - local_dof_keys.begin();
+  }
+
+  /// \brief Return the local DoF matrix dimension, for a DoF id and
+  ///     sublattice (0 if the sublattice does not have the DoF)
+  Index local_dof_dim(Index dof_id, Index sublattice_index) const {
+    return local_dof_dim_table[dof_id * sublattice_has_occupation_dofs.size() +
+                               sublattice_index];
+  }
+
+  /// \brief Return a local DoF matrix representation, for a DoF id, group
+  ///     element, and sublattice
+  Eigen::Map<Eigen::MatrixXd const> local_dof_rep(
+      Index dof_id, Index group_element_index, Index sublattice_index) const {
+    Index n_sublat = sublattice_has_occupation_dofs.size();
+    Index dim = local_dof_dim_table[dof_id * n_sublat + sublattice_index];
+    Index offset = local_dof_rep_offset
+        [(dof_id * factor_group->element.size() + group_element_index) *
+             n_sublat +
+         sublattice_index];
+    return Eigen::Map<Eigen::MatrixXd const>(
+        local_dof_rep_table.data() + offset, dim, dim);
+  }
+
   /// \brief Matrices describe local DoF value transformation under symmetry
   ///
   /// Usage:
@@ -113,8 +224,27 @@ struct PrimSymInfo {
   /// \endcode
   ///
   std::map<DoFKey, sym_info::GlobalDoFSymGroupRep> global_dof_symgroup_rep;
+
+  /// \brief Memory used by the symmetry representations, in bytes
+  ///     (approximate)
+  Index memory_bytes() const;
 };
 
+/// \brief Return the ranges of linear site indices, `[begin, end)`, on
+///     sublattices that allow more than one occupant
+std::vector<std::pair<Index, Index>> make_occupation_site_ranges(
+    PrimSymInfo const &prim_sym_info, Index n_vol);
+
+/// \brief Return the ranges of linear site indices, `[begin, end)`, on
+///     sublattices with local continuous DoF of type `key`
+std::vector<std::pair<Index, Index>> make_local_dof_site_ranges(
+    PrimSymInfo const &prim_sym_info, DoFKey const &key, Index n_vol);
+
+/// \brief Return the ranges of linear site indices, `[begin, end)`, of
+///     active sites
+std::vector<std::pair<Index, Index>> make_active_site_ranges(
+    PrimSymInfo const &prim_sym_info, Index n_vol);
+
 }  // namespace config
 }  // namespace CASM
 
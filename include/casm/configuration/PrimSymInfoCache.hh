@@ -0,0 +1,86 @@
+#ifndef CASM_config_PrimSymInfoCache
+#define CASM_config_PrimSymInfoCache
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "casm/configuration/definitions.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Make a string that uniquely specifies the PrimSymInfo generated
+///     for a prim
+std::string make_prim_sym_info_cache_key(BasicStructure const &prim);
+
+/// \brief Make a hexadecimal hash of a PrimSymInfo cache key
+std::string make_prim_sym_info_cache_hash(std::string const &key);
+
+/// \brief Cache of PrimSymInfo, keyed by the contents of the prim
+///
+/// Finding the factor group and generating the symmetry representations of a
+/// prim is done once for each distinct prim, and shared as immutable
+/// PrimSymInfo by all later requests. This is most useful with a cache
+/// directory, so that programs which construct the same prim each time they
+/// run, only to read or write configurations, skip symmetry analysis.
+///
+/// Notes:
+/// - The key is a JSON string containing the prim, as written by
+///   `write_prim`, and the lattice tolerance.
+/// - If a cache directory is set, PrimSymInfo is also written to
+///   `<cache_dir>/<hash>.json` and read from there when not in memory.
+///   The full key is stored in the file and checked when reading, so hash
+///   collisions and stale files only result in repeating symmetry analysis.
+/// - Thread-safe. Symmetry analysis is done outside of the lock, so
+///   concurrent requests for the same new key may each do the analysis, and
+///   the first stored result is returned to all.
+class PrimSymInfoCache {
+ public:
+  PrimSymInfoCache(std::optional<fs::path> _cache_dir = std::nullopt);
+
+  /// \brief Return PrimSymInfo, equal to `PrimSymInfo(prim)`
+  std::shared_ptr<PrimSymInfo const> prim_sym_info(
+      BasicStructure const &prim);
+
+  /// \brief Return Prim, with PrimSymInfo from the cache
+  std::shared_ptr<Prim const> make_prim(
+      std::shared_ptr<BasicStructure const> const &basicstructure);
+
+  /// \brief Directory for PrimSymInfo files, or std::nullopt for memory
+  ///     only
+  std::optional<fs::path> cache_dir() const;
+
+  /// \brief Set the directory for PrimSymInfo files, or std::nullopt for
+  ///     memory only
+  void set_cache_dir(std::optional<fs::path> _cache_dir);
+
+  /// \brief Number of PrimSymInfo held in memory
+  Index size() const;
+
+  /// \brief Memory used by PrimSymInfo held in memory, in bytes
+  ///     (approximate)
+  Index total_bytes() const;
+
+  /// \brief Clear PrimSymInfo held in memory, leaving any files
+  void clear();
+
+ private:
+  mutable std::mutex m_mutex;
+
+  std::optional<fs::path> m_cache_dir;
+
+  std::map<std::string, std::shared_ptr<PrimSymInfo const>> m_prim_sym_info;
+};
+
+/// \brief Process-wide PrimSymInfoCache, memory only unless a cache
+///     directory is set
+PrimSymInfoCache &default_prim_sym_info_cache();
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef CASM_config_ProgressMonitor
+#define CASM_config_ProgressMonitor
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Thrown by a long-running function when cancellation is requested
+///     through its ProgressMonitor
+class OperationCancelled : public std::runtime_error {
+ public:
+  OperationCancelled() : std::runtime_error("Operation cancelled") {}
+};
+
+/// \brief Optional progress reporting and cancellation for long-running
+///     functions
+///
+/// Long-running functions accept an optional
+/// `std::shared_ptr<ProgressMonitor> progress` (default nullptr, for no
+/// reporting or cancellation checks), and call:
+/// - `begin(stage, n_total)`, on the calling thread, at the start of each
+///   stage of work
+/// - `advance(n)`, from any thread, as work items are completed
+/// - `check()`, from any thread, at points where it is safe to stop
+///
+/// If cancellation has been requested, `advance` and `check` throw
+/// OperationCancelled, and the function exits without a result.
+/// Cancellation may be requested from any thread by `cancel()` or by
+/// setting the shared cancel flag.
+///
+/// The callback is called with `(stage, n_done, n_total)`:
+/// - only on the thread that constructed the ProgressMonitor, so a callback
+///   may call into Python holding the GIL (work done by other threads is
+///   included in `n_done` at the next report)
+/// - at `begin`, and by `advance` and `check` at most once per
+///   `min_interval` seconds
+/// - with `n_total == -1` if the total is not known
+///
+/// If the callback throws, the exception propagates out of the
+/// long-running function.
+class ProgressMonitor {
+ public:
+  typedef std::function<void(std::string const &stage, Index n_done,
+                             Index n_total)>
+      CallbackFunction;
+
+  /// \brief Constructor
+  explicit ProgressMonitor(
+      CallbackFunction _callback = CallbackFunction(),
+      std::shared_ptr<std::atomic<bool>> _cancel_flag = nullptr,
+      double _min_interval = 0.1);
+
+  /// \brief Start a stage of work, and report it
+  void begin(std::string const &stage, Index n_total = -1);
+
+  /// \brief Record completed work items, report if due, and throw if
+  ///     cancelled
+  void advance(Index n = 1);
+
+  /// \brief Report if due, and throw if cancelled
+  void check();
+
+  /// \brief Request cancellation
+  void cancel();
+
+  /// \brief Return true if cancellation has been requested
+  bool is_cancelled() const;
+
+  /// \brief The shared cancel flag
+  std::shared_ptr<std::atomic<bool>> const &cancel_flag() const;
+
+  /// \brief Current stage
+  std::string const &stage() const;
+
+  /// \brief Number of work items completed in the current stage
+  Index n_done() const;
+
+  /// \brief Number of work items in the current stage, or -1 if unknown
+  Index n_total() const;
+
+ private:
+  /// \brief Call the callback, if on the owning thread and due
+  void _report(bool force);
+
+  CallbackFunction m_callback;
+
+  std::shared_ptr<std::atomic<bool>> m_cancel_flag;
+
+  std::chrono::steady_clock::duration m_min_interval;
+
+  std::thread::id m_owner;
+
+  std::string m_stage;
+
+  std::atomic<Index> m_n_done;
+
+  Index m_n_total;
+
+  std::chrono::steady_clock::time_point m_last_report;
+};
+
+/// \brief Call `progress->begin(stage, n_total)`, if `progress`
+inline void begin_progress(std::shared_ptr<ProgressMonitor> const &progress,
+                           std::string const &stage, Index n_total = -1) {
+  if (progress) {
+    progress->begin(stage, n_total);
+  }
+}
+
+/// \brief Call `progress->advance(n)`, if `progress`
+inline void advance_progress(std::shared_ptr<ProgressMonitor> const &progress,
+                             Index n = 1) {
+  if (progress) {
+    progress->advance(n);
+  }
+}
+
+/// \brief Call `progress->check()`, if `progress`
+inline void check_progress(std::shared_ptr<ProgressMonitor> const &progress) {
+  if (progress) {
+    progress->check();
+  }
+}
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef CASM_config_QuantizedCanonicalizer
+#define CASM_config_QuantizedCanonicalizer
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Configuration DoF values as integers, in the standard comparison
+///     order
+///
+/// Layout, for a QuantizedCanonicalizer with grid spacing `quantum`:
+/// - global DoF values, for each DoF type in key order:
+///   `llround(value(i) / quantum)`
+/// - occupation: `occupation(l)`
+/// - local DoF values, for each DoF type in key order, site by site:
+///   `llround(value(i, l) / quantum)`
+///
+/// Lexicographical comparison of the quantized values gives the same order
+/// as `Configuration::operator<` for configurations with continuous DoF
+/// values on the grid.
+typedef std::vector<std::int64_t> QuantizedDoFValues;
+
+/// \brief Hash function object for QuantizedDoFValues
+struct QuantizedDoFValuesHash {
+  std::size_t operator()(QuantizedDoFValues const &values) const;
+};
+
+/// \brief Canonical form methods for configurations with continuous DoF
+///     values quantized to a grid
+///
+/// This is an opt-in alternative to the canonical form methods of
+/// `canonical_form.hh`, for configurations, such as those generated by
+/// `ConfigEnumMeshGrid`, with continuous DoF values which are integer
+/// multiples of `quantum` in the prim DoF basis. Continuous DoF values are
+/// converted to integers once, the symmetry representation matrices are
+/// converted to integer matrices, and transformation and comparison are
+/// done with integer arithmetic and exact comparison, exiting at the first
+/// differing value. Results are the same as `make_canonical_form`, etc. for
+/// values on the grid.
+///
+/// Quantized canonical forms are exact, so they can also be hashed, using
+/// `QuantizedDoFValuesHash`, or `make_configuration_hash` with the same
+/// `quantum`, such as by an `UnorderedConfigurationSet` constructed with
+/// `quantum`.
+///
+/// Notes:
+/// - The prim must satisfy `QuantizedCanonicalizer::is_supported`, which
+///   requires that all continuous DoF symmetry representation matrices are
+///   integer-valued, as for signed permutation matrices of Cartesian DoF
+///   bases in cubic, tetragonal, and orthorhombic prims. Otherwise
+///   transformed values would not be on the grid.
+/// - Values that are not within the prim lattice tolerance of the grid
+///   throw.
+/// - Construct once per supercell and re-use for many configurations
+/// - Not thread safe; use one QuantizedCanonicalizer per thread
+class QuantizedCanonicalizer {
+ public:
+  /// \brief Constructor
+  QuantizedCanonicalizer(std::shared_ptr<Supercell const> const &_supercell,
+                         double _quantum);
+
+  /// \brief Return true if all prim continuous DoF symmetry representation
+  ///     matrices are integer-valued
+  static bool is_supported(Prim const &prim);
+
+  /// \brief The supercell
+  std::shared_ptr<Supercell const> const &supercell() const;
+
+  /// \brief The grid spacing of continuous DoF values
+  double quantum() const;
+
+  /// \brief Convert DoF values to quantized values
+  QuantizedDoFValues quantize(ConfigDoFValues const &dof_values) const;
+
+  /// \brief Convert quantized values to a configuration
+  Configuration dequantize(QuantizedDoFValues const &quantized) const;
+
+  /// \brief Return true if configuration is in canonical form
+  template <typename SupercellSymOpIt>
+  bool is_canonical(Configuration const &configuration, SupercellSymOpIt begin,
+                    SupercellSymOpIt end);
+
+  /// \brief Return the first rep in [begin, end) that makes the
+  ///     configuration canonical
+  template <typename SupercellSymOpIt>
+  SupercellSymOp to_canonical(Configuration const &configuration,
+                              SupercellSymOpIt begin, SupercellSymOpIt end);
+
+  /// \brief Return the quantized canonical form
+  template <typename SupercellSymOpIt>
+  QuantizedDoFValues make_canonical_quantized(
+      Configuration const &configuration, SupercellSymOpIt begin,
+      SupercellSymOpIt end);
+
+  /// \brief Return true if configuration is in canonical form, using all
+  ///     supercell operations
+  bool is_canonical(Configuration const &configuration);
+
+  /// \brief Return rep that makes a configuration canonical, using all
+  ///     supercell operations
+  SupercellSymOp to_canonical(Configuration const &configuration);
+
+  /// \brief Return the quantized canonical form, using all supercell
+  ///     operations
+  QuantizedDoFValues make_canonical_quantized(
+      Configuration const &configuration);
+
+  /// \brief Return the canonical configuration, with continuous DoF values
+  ///     set exactly to the grid, using all supercell operations
+  Configuration make_canonical_form(Configuration const &configuration);
+
+ private:
+  /// \brief Quantize configuration into m_values
+  void _set_configuration(Configuration const &configuration);
+
+  /// \brief Compare copy_apply(op, m_values) to m_best
+  ///
+  /// Returns -1, 0, or 1 if less than, equal, or greater than m_best. If
+  /// greater and `complete_if_greater`, m_candidate holds the complete
+  /// transformed values on return.
+  int _compare_to_best(SupercellSymOp const &op, bool complete_if_greater);
+
+  /// \brief Integer symmetry representation of a global DoF type
+  struct GlobalRep {
+    DoFKey key;
+    Index dim;
+    /// Offset of values in QuantizedDoFValues
+    Index offset;
+    /// Row-major integer matrices, by prim factor group index
+    std::vector<std::vector<std::int64_t>> matrices;
+  };
+
+  /// \brief Integer symmetry representation of a local DoF type
+  struct LocalRep {
+    DoFKey key;
+    /// Number of rows of the local DoF values matrix
+    Index rows;
+    /// Offset of values in QuantizedDoFValues
+    Index offset;
+    /// DoF dimension, by sublattice
+    std::vector<Index> dim;
+    /// Row-major integer matrices, by prim factor group index and
+    /// sublattice
+    std::vector<std::vector<std::vector<std::int64_t>>> matrices;
+  };
+
+  std::shared_ptr<Supercell const> m_supercell;
+
+  double m_quantum;
+
+  double m_tol;
+
+  Index m_n_vol;
+
+  Index m_n_sites;
+
+  /// Offset of occupation values in QuantizedDoFValues
+  Index m_occ_offset;
+
+  /// Total size of QuantizedDoFValues
+  Index m_size;
+
+  std::vector<GlobalRep> m_global;
+
+  std::vector<LocalRep> m_local;
+
+  /// Quantized values being canonicalized
+  QuantizedDoFValues m_values;
+
+  /// Greatest transformed values found so far
+  QuantizedDoFValues m_best;
+
+  /// Transformed values being compared
+  QuantizedDoFValues m_candidate;
+};
+
+// --- Inline definitions ---
+
+/// \brief Return true if configuration is in canonical form
+///
+/// If true, then `configuration` satisfies, for all `rep` in `[begin, end)`:
+///     configuration >= copy_apply(rep, configuration)
+template <typename SupercellSymOpIt>
+bool QuantizedCanonicalizer::is_canonical(Configuration const &configuration,
+                                          SupercellSymOpIt begin,
+                                          SupercellSymOpIt end) {
+  _set_configuration(configuration);
+  m_best = m_values;
+  for (auto it = begin; it != end; ++it) {
+    if (_compare_to_best(*it, false) > 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Return the first rep in [begin, end) that makes the
+///     configuration canonical
+///
+/// The result, `rep`, is the first in `[begin, end)` that satisfies:
+///     canonical_configuration == copy_apply(rep, configuration)
+template <typename SupercellSymOpIt>
+SupercellSymOp QuantizedCanonicalizer::to_canonical(
+    Configuration const &configuration, SupercellSymOpIt begin,
+    SupercellSymOpIt end) {
+  if (begin == end) {
+    throw std::runtime_error(
+        "Error in QuantizedCanonicalizer::to_canonical: empty range");
+  }
+  _set_configuration(configuration);
+  auto it = begin;
+  SupercellSymOp best_op = *it;
+  m_best.assign(m_size, std::numeric_limits<std::int64_t>::min());
+  _compare_to_best(best_op, true);
+  std::swap(m_best, m_candidate);
+  ++it;
+  for (; it != end; ++it) {
+    if (_compare_to_best(*it, true) > 0) {
+      std::swap(m_best, m_candidate);
+      best_op = *it;
+    }
+  }
+  return best_op;
+}
+
+/// \brief Return the quantized canonical form
+///
+/// The result, `canonical`, satisfies for all `rep` in `[begin, end)`:
+///     canonical >= quantize(copy_apply(rep, configuration).dof_values)
+template <typename SupercellSymOpIt>
+QuantizedDoFValues QuantizedCanonicalizer::make_canonical_quantized(
+    Configuration const &configuration, SupercellSymOpIt begin,
+    SupercellSymOpIt end) {
+  this->to_canonical(configuration, begin, end);
+  return m_best;
+}
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
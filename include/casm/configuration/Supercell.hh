@@ -1,6 +1,12 @@
 #ifndef CASM_config_Supercell
 #define CASM_config_Supercell
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "casm/configuration/Prim.hh"
 #include "casm/configuration/SupercellSymInfo.hh"
 #include "casm/crystallography/LinearIndexConverter.hh"
@@ -12,6 +18,22 @@ namespace config {
 
 /// \brief Specifies all the structural and symmetry information common for all
 /// configurations with the same supercell. All members are const.
+///
+/// Notes:
+/// - The symmetry information, `sym_info()`, is constructed on first access,
+///   so that supercells used only for I/O or structure generation do not
+///   pay the cost of generating the supercell factor group and factor
+///   group permutations. Construction is thread safe.
+/// - The supercell name, `name`, is computed on construction, and the
+///   canonical supercell name, `canonical_name()`, is computed on first
+///   access, so that they are never recomputed for the same Supercell.
+/// - A Supercell may be constructed with an equivalent supercell, in which
+///   case `sym_info()` is constructed by conjugating the equivalent
+///   supercell's factor group permutations, and the equivalent supercell's
+///   `sym_info()` is shared by all supercells constructed with it.
+/// - If NUMA replication is enabled (see `set_numa_replication_enabled`),
+///   parallel functions use `numa_replica(node)`, an equal supercell whose
+///   `sym_info()` is a copy allocated on NUMA node `node`.
 struct Supercell : public Comparisons<CRTPBase<Supercell>> {
   Supercell(std::shared_ptr<Prim const> const &_prim,
             Lattice const &_superlattice,
@@ -22,6 +44,10 @@ struct Supercell : public Comparisons<CRTPBase<Supercell>> {
   Supercell(std::shared_ptr<Prim const> const &_prim,
             Eigen::Matrix3l const &_superlattice_matrix,
             Index max_n_translation_permutations = 100);
+  Supercell(std::shared_ptr<Prim const> const &_prim,
+            Eigen::Matrix3l const &_superlattice_matrix,
+            Index max_n_translation_permutations,
+            std::shared_ptr<Supercell const> const &_equivalent_supercell);
 
   /// \brief Species the primitive crystal structure (lattice and basis) and
   /// allowed degrees of freedom (DoF), and also symmetry representations
@@ -32,6 +58,10 @@ struct Supercell : public Comparisons<CRTPBase<Supercell>> {
   /// transformation matrix
   Superlattice const superlattice;
 
+  /// \brief The supercell name, generated from the hermite normal form of
+  /// the transformation matrix (see `make_supercell_name`)
+  std::string const name;
+
   /// \brief Converts between ijk (UnitCell) values and their corresponding
   /// index in an unrolled vector
   xtal::UnitCellIndexConverter const unitcell_index_converter;
@@ -42,7 +72,27 @@ struct Supercell : public Comparisons<CRTPBase<Supercell>> {
 
   /// \brief Holds symmetry representations used for all configurations with
   /// the same supercell
-  SupercellSymInfo const sym_info;
+  ///
+  /// This replaces the public data member `sym_info` of earlier versions
+  /// (before 2.0a4); use `sym_info().X` where `sym_info.X` was used.
+  SupercellSymInfo const &sym_info() const;
+
+  /// \brief The name of the canonical equivalent supercell
+  std::string const &canonical_name() const;
+
+  /// \brief The maximum number of translation permutations stored by
+  ///     sym_info()
+  Index max_n_translation_permutations() const;
+
+  /// \brief True if sym_info() has been constructed
+  bool has_sym_info() const { return m_has_sym_info; }
+
+  /// \brief Memory used by the supercell, in bytes (approximate)
+  Index memory_bytes() const;
+
+  /// \brief Return an equal supercell, with a copy of sym_info() made on
+  ///     NUMA node `node`
+  std::shared_ptr<Supercell const> numa_replica(Index node) const;
 
   /// \brief Less than comparison of Supercell
   bool operator<(Supercell const &B) const;
@@ -52,6 +102,42 @@ struct Supercell : public Comparisons<CRTPBase<Supercell>> {
 
   /// \brief Equality comparison of Supercell
   bool eq_impl(Supercell const &rhs) const;
+
+  /// \brief Passed to the SupercellSymInfo constructor
+  Index const m_max_n_translation_permutations;
+
+  /// \brief If not nullptr, m_sym_info is constructed from the equivalent
+  ///     supercell's sym_info; released once m_sym_info is constructed.
+  ///     Read and reset with std::atomic_load and std::atomic_store.
+  mutable std::shared_ptr<Supercell const> m_equivalent_supercell;
+
+  /// \brief Index of a prim factor group operation that transforms the
+  ///     equivalent supercell lattice to this supercell lattice
+  Index m_equivalent_prim_factor_group_index;
+
+  /// \brief Used to publish m_sym_info once, on first access
+  mutable std::once_flag m_sym_info_flag;
+
+  /// \brief Supercell symmetry info, constructed on first access
+  mutable std::unique_ptr<SupercellSymInfo const> m_sym_info;
+
+  /// \brief Set once m_sym_info is constructed
+  mutable std::atomic<bool> m_has_sym_info{false};
+
+  /// \brief NUMA node of the thread that constructed m_sym_info
+  mutable Index m_sym_info_numa_node = 0;
+
+  /// \brief Protects m_numa_replicas
+  mutable std::mutex m_numa_replicas_mutex;
+
+  /// \brief Replicas, by NUMA node, constructed on first use
+  mutable std::vector<std::shared_ptr<Supercell const>> m_numa_replicas;
+
+  /// \brief Used to construct m_canonical_name once, on first access
+  mutable std::once_flag m_canonical_name_flag;
+
+  /// \brief Canonical supercell name, constructed on first access
+  mutable std::string m_canonical_name;
 };
 
 struct CompareSharedSupercell {
@@ -61,6 +147,13 @@ struct CompareSharedSupercell {
   }
 };
 
+/// \brief Return a shared Supercell, re-using an existing one if possible
+std::shared_ptr<Supercell const> make_shared_supercell(
+    std::shared_ptr<Prim const> const &prim,
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    Index max_n_translation_permutations = 100,
+    std::shared_ptr<Supercell const> const &equivalent_supercell = nullptr);
+
 }  // namespace config
 }  // namespace CASM
 
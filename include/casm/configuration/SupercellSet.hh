@@ -1,8 +1,10 @@
 #ifndef CASM_config_SupercellSet
 #define CASM_config_SupercellSet
 
+#include <array>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 #include "casm/configuration/Supercell.hh"
 #include "casm/configuration/definitions.hh"
@@ -30,10 +32,20 @@ struct SupercellRecord : public Comparisons<CRTPBase<SupercellRecord>> {
 };
 
 /// \brief Data structure for holding / reading / writing supercells
+///
+/// Notes:
+/// - Lookups by transformation matrix, by Supercell with the same prim, and
+///   by canonical supercell name use indexes that are updated on insert and
+///   erase, and do not construct a Supercell or SupercellRecord.
 class SupercellSet {
  public:
   SupercellSet(std::shared_ptr<Prim const> const &_prim);
 
+  SupercellSet(SupercellSet const &other);
+  SupercellSet(SupercellSet &&other) = default;
+  SupercellSet &operator=(SupercellSet const &other);
+  SupercellSet &operator=(SupercellSet &&other) = default;
+
   typedef std::set<SupercellRecord>::size_type size_type;
   typedef std::set<SupercellRecord>::iterator iterator;
   typedef std::set<SupercellRecord>::const_iterator const_iterator;
@@ -86,6 +98,12 @@ class SupercellSet {
 
   size_type erase_canonical_by_name(std::string name);
 
+  /// \brief Return the canonical equivalent supercell, inserted in this set,
+  ///     and the index of a prim factor group operation that transforms
+  ///     `supercell` to it
+  std::pair<std::shared_ptr<Supercell const>, Index> canonical_supercell(
+      std::shared_ptr<Supercell const> const &supercell);
+
   std::set<SupercellRecord> &data();
 
   std::set<SupercellRecord> const &data() const;
@@ -93,6 +111,45 @@ class SupercellSet {
  private:
   std::shared_ptr<Prim const> m_prim;
   std::set<SupercellRecord> m_data;
+
+  typedef std::array<Eigen::Matrix3l::Scalar, 9> matrix_key_type;
+
+  static matrix_key_type _matrix_key(
+      Eigen::Matrix3l const &transformation_matrix_to_super);
+
+  Eigen::Matrix3l const &_canonical_transformation_matrix_to_super(
+      Eigen::Matrix3l const &transformation_matrix_to_super);
+
+  std::pair<iterator, bool> _insert_and_index(std::pair<iterator, bool> result);
+
+  void _add_to_index(const_iterator it) const;
+
+  void _validate_index() const;
+
+  /// Records by transformation matrix
+  mutable std::map<matrix_key_type, const_iterator> m_index_by_matrix;
+
+  /// Canonical records by supercell name
+  mutable std::unordered_map<std::string, const_iterator>
+      m_index_by_canonical_name;
+
+  /// False if `data()` was accessed, so the indexes must be rebuilt
+  mutable bool m_index_is_valid;
+
+  /// Memo of `canonical_supercell` results, by the supercell transformation
+  /// matrix, cleared by `clear` and `erase`
+  std::map<matrix_key_type, std::pair<std::shared_ptr<Supercell const>, Index>>
+      m_canonical_supercell;
+
+  /// Prim point group operations, as by `make_frac_point_matrices`
+  std::vector<Eigen::Matrix3l> m_frac_point_group;
+
+  /// Prim factor group point operations, as by `make_frac_point_matrices`
+  std::vector<Eigen::Matrix3l> m_frac_factor_group;
+
+  /// Memo of canonical supercell transformation matrices, by canonical HNF.
+  /// Depends only on the prim, so it is never cleared.
+  std::map<matrix_key_type, Eigen::Matrix3l> m_canonical_matrix_by_hnf;
 };
 
 /// \brief Make a map for finding canonical SupercellRecord by supercell_name
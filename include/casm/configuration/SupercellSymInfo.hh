@@ -1,12 +1,209 @@
 #ifndef CASM_config_SupercellSymInfo
 #define CASM_config_SupercellSymInfo
 
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "casm/configuration/definitions.hh"
+#include "casm/configuration/sym_info/PermutationTable.hh"
 #include "casm/configuration/sym_info/definitions.hh"
 
 namespace CASM {
 namespace config {
 
+/// \brief Compact representation of supercell translation permutations
+///
+/// Translation permutations are evaluated by integer arithmetic on unit cell
+/// coordinates reduced into the box defined by the Hermite normal form of the
+/// supercell transformation matrix. Memory use scales with the number of
+/// sites, not the number of translations times the number of sites, and
+/// `permute_index` is O(1) and allocation free.
+///
+/// The following is equivalent, for all `translation_index` and `i`:
+///
+/// \code
+/// sym_info::Permutation perm = make_translation_permutation(
+///     translation_index, unitcell_index_converter,
+///     unitcellcoord_index_converter);
+/// perm[i] == table.permute_index(translation_index, i);
+/// \endcode
+class SupercellTranslationTable {
+ public:
+  /// \brief Constructor
+  SupercellTranslationTable(
+      Eigen::Matrix3l const &transformation_matrix_to_super,
+      xtal::UnitCellIndexConverter const &unitcell_index_converter,
+      xtal::UnitCellCoordIndexConverter const &unitcellcoord_index_converter);
+
+  /// \brief Number of translations (equal to the number of unit cells)
+  Index n_translations() const { return m_n_unitcells; }
+
+  /// \brief Number of sites
+  Index n_sites() const { return m_site_unitcell.size(); }
+
+  /// \brief Returns the index of the site containing the site DoF values that
+  ///     will be permuted onto site i by the specified translation
+  Index permute_index(Index translation_index, Index i) const {
+    std::int32_t const *t = &m_unitcell_box[3 * translation_index];
+    std::int32_t const *n = &m_unitcell_box[3 * m_site_unitcell[i]];
+    std::int32_t unitcell_index =
+        m_box_to_unitcell[_box_key(n[0] - t[0], n[1] - t[1], n[2] - t[2])];
+    return m_sublattice_site_index[m_site_sublattice[i] * m_n_unitcells +
+                                   unitcell_index];
+  }
+
+  /// \brief Write translation permutation into `perm`, re-using its capacity
+  void make_permutation(Index translation_index,
+                        sym_info::Permutation &perm) const;
+
+  /// \brief Returns the integral coordinates, reduced into the HNF box, of
+  ///     the unit cell with linear index `unitcell_index` (pointer to 3
+  ///     values)
+  std::int32_t const *unitcell_coordinates(Index unitcell_index) const {
+    return &m_unitcell_box[3 * unitcell_index];
+  }
+
+  /// \brief Returns the linear index of the site on `sublattice` in the unit
+  ///     cell with linear index `unitcell_index`
+  Index sublattice_site_index(Index sublattice, Index unitcell_index) const {
+    return m_sublattice_site_index[sublattice * m_n_unitcells +
+                                   unitcell_index];
+  }
+
+  /// \brief Returns the linear index of the site on `sublattice` in the unit
+  ///     cell with (unreduced) integral coordinates (i, j, k)
+  Index site_index(Index sublattice, std::int32_t i, std::int32_t j,
+                   std::int32_t k) const {
+    return m_sublattice_site_index[sublattice * m_n_unitcells +
+                                   m_box_to_unitcell[_box_key(i, j, k)]];
+  }
+
+  /// \brief Memory used by the table, in bytes
+  Index memory_bytes() const {
+    return (m_unitcell_box.size() + m_box_to_unitcell.size() +
+            m_site_unitcell.size() + m_site_sublattice.size() +
+            m_sublattice_site_index.size()) *
+           sizeof(std::int32_t);
+  }
+
+ private:
+  /// \brief Return the linear index in the HNF box of the (unreduced)
+  ///     integral coordinate (i, j, k)
+  std::int32_t _box_key(std::int32_t i, std::int32_t j, std::int32_t k) const {
+    // reduce k, then j, then i, using upper triangular HNF columns
+    std::int32_t q = _floor_div(k, m_hnf[5]);
+    i -= q * m_hnf[2];
+    j -= q * m_hnf[4];
+    k -= q * m_hnf[5];
+    q = _floor_div(j, m_hnf[3]);
+    i -= q * m_hnf[1];
+    j -= q * m_hnf[3];
+    i -= _floor_div(i, m_hnf[0]) * m_hnf[0];
+    return i + m_hnf[0] * (j + m_hnf[3] * k);
+  }
+
+  static std::int32_t _floor_div(std::int32_t a, std::int32_t b) {
+    std::int32_t q = a / b;
+    return (a % b != 0 && a < 0) ? q - 1 : q;
+  }
+
+  Index m_n_unitcells;
+
+  /// Upper triangular HNF, row-major: H00, H01, H02, H11, H12, H22
+  std::int32_t m_hnf[6];
+
+  /// Unit cell coordinates, reduced into the HNF box, by linear unit cell index
+  /// (size = 3 * n_unitcells)
+  std::vector<std::int32_t> m_unitcell_box;
+
+  /// Linear unit cell index, by HNF box key (size = n_unitcells)
+  std::vector<std::int32_t> m_box_to_unitcell;
+
+  /// Linear unit cell index, by site index (size = n_sites)
+  std::vector<std::int32_t> m_site_unitcell;
+
+  /// Sublattice index, by site index (size = n_sites)
+  std::vector<std::int32_t> m_site_sublattice;
+
+  /// Site index, by `sublattice * n_unitcells + unitcell_index`
+  std::vector<std::int32_t> m_sublattice_site_index;
+};
+
+class CombinedPermutationTable;
+
+/// \brief The sites of a supercell whose DoF values can differ between
+///     configurations
+///
+/// Active sites are on sublattices that allow more than one occupant or
+/// that have any local continuous DoF. Values on other sites are fixed (the
+/// single occupant, and no local continuous DoF values), and symmetry maps
+/// sublattices only to symmetrically equivalent sublattices, so comparison
+/// and transformation of DoF values only need to consider active sites.
+///
+/// Sites are in sublattice-major order, so active sites are given as merged
+/// ranges of linear site indices, and by a compressed index.
+struct SupercellActiveSites {
+  /// \brief Constructor
+  SupercellActiveSites(std::vector<std::pair<Index, Index>> const &_ranges,
+                       Index _n_sites);
+
+  /// \brief Number of sites
+  Index n_sites;
+
+  /// \brief Number of active sites
+  Index n_active_sites;
+
+  /// \brief True if all sites are active
+  bool all_active;
+
+  /// \brief Active sites, as ranges of linear site index, `[begin, end)`
+  std::vector<std::pair<Index, Index>> ranges;
+
+  /// \brief Compressed active site index, by linear site index, or -1 if
+  ///     the site is not active
+  std::vector<std::int32_t> active_index;
+};
+
+/// \brief Integer action of supercell factor group operations on lattice
+///     translations
+///
+/// Supercell operation `(f, t)` is the translation by prim lattice vector
+/// `t` applied after factor group operation `f`. With prim lattice column
+/// matrix L, the factor group operation `f` has point operation
+/// `R_f = L * frac_matrix[f] * L.inverse()`, and its translation is only
+/// defined up to a lattice vector, so products and inverses are, in prim
+/// fractional coordinates:
+///
+/// \code
+/// (f1, t1) * (f2, t2) = (f1 * f2,
+///                         t1 + frac_matrix[f1] * t2 +
+///                             product_translation[f1][f2])
+/// inverse((f, t)) = (inverse(f),
+///                    inverse_translation[f] - frac_matrix[inverse(f)] * t)
+/// \endcode
+///
+/// This allows SupercellSymOp products and inverses to be evaluated with
+/// integer arithmetic only.
+struct SupercellFactorGroupAction {
+  /// \brief Constructor
+  SupercellFactorGroupAction(SymGroup const &factor_group,
+                             Lattice const &prim_lattice);
+
+  /// \brief Point operations, in prim fractional coordinates, by supercell
+  ///     factor group index
+  std::vector<Eigen::Matrix3l> frac_matrix;
+
+  /// \brief Product lattice translations, in prim fractional coordinates,
+  ///     by supercell factor group indices `[f1][f2]`
+  std::vector<std::vector<Eigen::Vector3l>> product_translation;
+
+  /// \brief Inverse lattice translations, in prim fractional coordinates, by
+  ///     supercell factor group index
+  std::vector<Eigen::Vector3l> inverse_translation;
+};
+
 /// \brief Data structure describing application of symmetry in a supercell
 struct SupercellSymInfo {
   /// \brief Constructor
@@ -16,6 +213,31 @@ struct SupercellSymInfo {
       xtal::UnitCellCoordIndexConverter const &unitcellcoord_index_converter,
       Index max_n_translation_permutations = 100);
 
+  /// \brief Constructor, conjugating the factor group permutations of an
+  ///     equivalent supercell
+  SupercellSymInfo(
+      std::shared_ptr<Prim const> const &prim, Superlattice const &superlattice,
+      xtal::UnitCellIndexConverter const &unitcell_index_converter,
+      xtal::UnitCellCoordIndexConverter const &unitcellcoord_index_converter,
+      Index max_n_translation_permutations,
+      SupercellSymInfo const &equivalent_sym_info,
+      xtal::UnitCellCoordIndexConverter const
+          &equivalent_unitcellcoord_index_converter,
+      Index prim_factor_group_index);
+
+  /// \brief Copy constructor, copying all tables
+  SupercellSymInfo(SupercellSymInfo const &other);
+
+  ~SupercellSymInfo();
+
+  /// \brief Return the combined permutation table for all supercell
+  ///     operations, or nullptr if it is larger than allowed
+  std::shared_ptr<CombinedPermutationTable const> combined_permutation_table()
+      const;
+
+  /// \brief Memory used by the symmetry tables, in bytes (approximate)
+  Index memory_bytes() const;
+
   /// \brief The subgroup of the prim factor group that leaves
   /// the supercell lattice vectors invariant
   std::shared_ptr<SymGroup const> factor_group;
@@ -25,16 +247,136 @@ struct SupercellSymInfo {
   ///
   /// The number of translations is equal the supercell volume (as an integer
   /// multiple of the prim unit cell). Not populated for large supercells
-  /// (n_unitcells > max_n_translation_permutations).
-  std::optional<std::vector<sym_info::Permutation>> translation_permutations;
+  /// (n_unitcells > max_n_translation_permutations), or if storing them
+  /// would exceed the memory budget (see `set_memory_budget`).
+  ///
+  /// Stored with compact integer entries (see sym_info::PermutationTable).
+  std::optional<sym_info::PermutationTable> translation_permutations;
+
+  /// \brief Compact representation of the translation permutations, always
+  ///     populated, used when `translation_permutations` is not
+  SupercellTranslationTable translation_table;
 
   /// \brief Describes how sites permute due to supercell factor group
   /// operations.
   ///
   /// There is one element for each element in the supercell factor group.
-  std::vector<sym_info::Permutation> factor_group_permutations;
+  /// Stored with compact integer entries (see sym_info::PermutationTable).
+  sym_info::PermutationTable factor_group_permutations;
+
+  /// \brief The sites whose DoF values can differ between configurations
+  SupercellActiveSites active_sites;
+
+  /// \brief Integer action of the factor group on lattice translations, for
+  ///     evaluating products and inverses of supercell operations
+  SupercellFactorGroupAction factor_group_action;
 };
 
+/// \brief Combined factor group and translation permutations for all
+///     supercell operations, in one contiguous table
+///
+/// Operations are indexed in the order of iterating from
+/// `SupercellSymOp::begin(supercell)`, so that operation `op_index`
+/// has supercell factor group index `op_index / n_translations` and
+/// translation index `op_index % n_translations`. The following is
+/// equivalent, for all operations and `i`:
+///
+/// \code
+/// op.permute_index(i) == table.permute_index(op_index, i);
+/// \endcode
+///
+/// Only columns for active sites (see SupercellActiveSites) are stored, so
+/// `permute_index(op_index, i)` requires that site `i` is active. Rows are
+/// indexed by compressed active site index, which is the linear site index
+/// if `all_active()`.
+///
+/// Tables are obtained from `SupercellSymInfo::combined_permutation_table`,
+/// which shares them through a process-wide cache. The cache holds tables
+/// no larger than a maximum size, and evicts the least recently used tables
+/// once their total size exceeds a maximum (see
+/// `set_combined_permutation_table_limits`). An evicted table stays valid
+/// for as long as a `std::shared_ptr` to it is held.
+class CombinedPermutationTable {
+ public:
+  /// \brief Constructor
+  explicit CombinedPermutationTable(SupercellSymInfo const &sym_info);
+
+  /// \brief Number of operations
+  Index n_ops() const { return m_n_ops; }
+
+  /// \brief Number of translations
+  Index n_translations() const { return m_n_translations; }
+
+  /// \brief Number of sites
+  Index n_sites() const { return m_n_sites; }
+
+  /// \brief Number of active sites, the length of each row
+  Index n_active_sites() const { return m_n_active_sites; }
+
+  /// \brief True if all sites are active
+  bool all_active() const { return m_n_active_sites == m_n_sites; }
+
+  /// \brief Compressed active site index, by linear site index, or -1 if
+  ///     the site is not active
+  std::vector<std::int32_t> const &active_index() const {
+    return m_active_index;
+  }
+
+  /// \brief Returns the index of the site containing the site DoF values that
+  ///     will be permuted onto active site i by the specified operation
+  Index permute_index(Index op_index, Index i) const {
+    return m_data(op_index, m_active_index[i]);
+  }
+
+  /// \brief View of the combined permutation for one operation, by
+  ///     compressed active site index
+  sym_info::PermutationTable::Row permutation(Index op_index) const {
+    return m_data[op_index];
+  }
+
+  /// \brief The combined permutations, by operation and compressed active
+  ///     site index
+  sym_info::PermutationTable const &data() const { return m_data; }
+
+  /// \brief Memory used by the table, in bytes
+  Index memory_bytes() const { return m_data.memory_bytes(); }
+
+ private:
+  Index m_n_ops;
+
+  Index m_n_translations;
+
+  Index m_n_sites;
+
+  Index m_n_active_sites;
+
+  /// Compressed active site index, by linear site index, or -1
+  std::vector<std::int32_t> m_active_index;
+
+  /// Combined permutations, by `(op_index, active_index[i])`
+  sym_info::PermutationTable m_data;
+};
+
+/// \brief Set size limits for cached combined permutation tables
+void set_combined_permutation_table_limits(Index max_table_bytes,
+                                           Index max_total_bytes);
+
+/// \brief Maximum size of a single combined permutation table, in bytes
+Index combined_permutation_table_max_bytes();
+
+/// \brief Maximum total size of cached combined permutation tables, in bytes
+Index combined_permutation_table_max_total_bytes();
+
+/// \brief Total size of cached combined permutation tables, in bytes
+Index combined_permutation_table_total_bytes();
+
+/// \brief Evict least recently used combined permutation tables until
+///     their total size is at most `max_total_bytes`
+Index evict_combined_permutation_tables(Index max_total_bytes);
+
+/// \brief Total memory used by all existing SupercellSymInfo, in bytes
+Index supercell_sym_info_total_bytes();
+
 /// \brief Construct supercell factor group
 SymGroup make_factor_group(std::shared_ptr<Prim const> const &prim,
                            Superlattice const &superlattice);
@@ -50,12 +392,37 @@ std::vector<sym_info::Permutation> make_translation_permutations(
     xtal::UnitCellIndexConverter const &ijk_index_converter,
     xtal::UnitCellCoordIndexConverter const &bijk_index_converter);
 
+/// \brief Construct supercell translation permutations, from a
+///     SupercellTranslationTable, using multiple threads
+sym_info::PermutationTable make_translation_permutations(
+    SupercellTranslationTable const &translation_table, Index n_threads = 1);
+
 /// \brief Construct supercell factor group permutations
 std::vector<sym_info::Permutation> make_factor_group_permutations(
     std::vector<Index> const &head_group_index,
     sym_info::UnitCellCoordSymGroupRep const &unitcellcoord_symgroup_rep,
     xtal::UnitCellCoordIndexConverter const &bijk_index_converter);
 
+/// \brief Construct supercell factor group permutations, using integer
+///     arithmetic on HNF box coordinates and multiple threads
+sym_info::PermutationTable make_factor_group_permutations(
+    std::vector<Index> const &head_group_index,
+    sym_info::UnitCellCoordSymGroupRep const &unitcellcoord_symgroup_rep,
+    SupercellTranslationTable const &translation_table, Index n_threads = 1);
+
+/// \brief Construct supercell factor group permutations by conjugating the
+///     factor group permutations of an equivalent supercell
+sym_info::PermutationTable make_equivalent_factor_group_permutations(
+    std::vector<Index> const &head_group_index, Index prim_factor_group_index,
+    std::vector<Index> const &equivalent_head_group_index,
+    sym_info::PermutationTable const &equivalent_factor_group_permutations,
+    SymGroup const &prim_factor_group,
+    sym_info::UnitCellCoordSymGroupRep const &unitcellcoord_symgroup_rep,
+    xtal::UnitCellCoordIndexConverter const &equivalent_bijk_index_converter,
+    xtal::UnitCellIndexConverter const &ijk_index_converter,
+    xtal::UnitCellCoordIndexConverter const &bijk_index_converter,
+    SupercellTranslationTable const &translation_table, Index n_threads = 1);
+
 }  // namespace config
 }  // namespace CASM
 
@@ -1,15 +1,21 @@
 #ifndef CASM_config_SupercellSymOp
 #define CASM_config_SupercellSymOp
 
+#include <Eigen/SparseCore>
 #include <iterator>
+#include <map>
+#include <set>
 
 #include "casm/configuration/definitions.hh"
+#include "casm/configuration/group/Group.hh"
 #include "casm/configuration/sym_info/definitions.hh"
 #include "casm/misc/Comparisons.hh"
 
 namespace CASM {
 namespace config {
 
+class SupercellSymOpHandle;
+
 /// \brief Represents and allows iteration over symmetry operations consistent
 /// with a given Supercell, combining pure factor group and pure translation
 /// operations.
@@ -20,24 +26,48 @@ namespace config {
 /// - When iterating over all operations the translation operations are
 ///   iterated in the inner loop and factor group operations iterated in the
 ///   outer loop
-/// - Overall, the following sequence of permutations is replicated (if
-///   sym_info.translation_permutations.has_value()):
+/// - Overall, the following sequence of permutations is replicated, where
+///   `fg_perms(f, j)` and `table.permute_index(t, i)` are the factor group
+///   and translation permutations (translation permutations are also stored
+///   in `sym_info.translation_permutations` for small supercells):
 ///
 /// \code
 /// Container before;
-/// SupercellSymInfo sym_info = ...
-/// for( f=0; f<sym_info.factor_group_permutations.size(); f++) {
-///   sym_info::Permutation const &factor_group_permute =
-///       sym_info.factor_group_permutations[g];
+/// SupercellSymInfo const &sym_info = supercell->sym_info();
+/// auto const &fg_perms = sym_info.factor_group_permutations;
+/// auto const &table = sym_info.translation_table;
+/// for (Index f = 0; f < fg_perms.size(); ++f) {
+///   for (Index t = 0; t < table.n_translations(); ++t) {
+///     // SupercellSymOp(supercell, f, t).permute_index(i) is
+///     // fg_perms(f, table.permute_index(t, i))
+///     Container after = before;
+///     for (Index i = 0; i < before.size(); ++i) {
+///       after[i] = before[fg_perms(f, table.permute_index(t, i))];
+///     }
+///   }
+/// }
+/// \endcode
+///
+/// - To store many operations, store SupercellSymOpHandle, which does not
+///   allocate, and use `reset` to make one SupercellSymOp refer to each in
+///   turn:
 ///
-///   for( t=0; t<supercell.superlattice.size(); t++) {
-///     sym_info::Permutation const &trans_permute =
-///         (*sym_info.translation_permutations)[t];
-///     Container after = copy_apply(trans_permute,
-///                           copy_apply(factor_group_permute, before));
+/// \code
+/// std::vector<SupercellSymOpHandle> handles = ...;
+/// ConfigIsEquivalent equal_to_f(configuration);
+/// SupercellSymOp op = SupercellSymOp::begin(supercell);
+/// for (SupercellSymOpHandle const &handle : handles) {
+///   op.reset(handle.supercell_factor_group_index(),
+///            handle.translation_index());
+///   if (equal_to_f(op)) {
+///     ...
 ///   }
 /// }
 /// \endcode
+///
+/// - SupercellSymOp holds no mutable state, so const SupercellSymOp may be
+///   shared between threads. Iterating (`++`, `--`, `reset`) modifies the
+///   operation, so each thread iterates with its own SupercellSymOp.
 class SupercellSymOp : public Comparisons<CRTPBase<SupercellSymOp>> {
  public:
   using iterator_category = std::bidirectional_iterator_tag;
@@ -63,6 +93,10 @@ class SupercellSymOp : public Comparisons<CRTPBase<SupercellSymOp>> {
                  Index _supercell_factor_group_index,
                  Eigen::Vector3d const &_translation_cart);
 
+  /// Construct SupercellSymOp from a SupercellSymOpHandle
+  SupercellSymOp(std::shared_ptr<Supercell const> const &_supercell,
+                 SupercellSymOpHandle const &_handle);
+
   /// \brief Make supercell symop begin iterator
   static SupercellSymOp begin(
       std::shared_ptr<Supercell const> const &_supercell);
@@ -92,6 +126,10 @@ class SupercellSymOp : public Comparisons<CRTPBase<SupercellSymOp>> {
   ///     will be permuted onto site i
   Index permute_index(Index i) const;
 
+  /// \brief Change to another operation in the same supercell, without
+  ///     allocating
+  void reset(Index _supercell_factor_group_index, Index _translation_index);
+
   /// Returns a reference to this -- allows SupercellSymOp to be treated
   /// as an iterator to SupercellSymOp object
   SupercellSymOp const &operator*() const;
@@ -115,8 +153,11 @@ class SupercellSymOp : public Comparisons<CRTPBase<SupercellSymOp>> {
   /// \brief Return the SymOp for the current operation
   SymOp to_symop() const;
 
-  /// Returns the translation permutation. Reference not valid after increment.
-  sym_info::Permutation const &translation_permute() const;
+  /// Returns the translation permutation
+  sym_info::Permutation translation_permute() const;
+
+  /// Set `permute` to the translation permutation, re-using its storage
+  void translation_permute(sym_info::Permutation &permute) const;
 
   /// Returns the combination of factor group operation permutation and
   /// translation permutation
@@ -144,12 +185,12 @@ class SupercellSymOp : public Comparisons<CRTPBase<SupercellSymOp>> {
   /// \brief Supercell factor group index
   ///
   /// This is an index into:
-  /// - m_supercell->sym_info.factor_group_permutations
-  /// - m_supercell->sym_info.factor_group->element
+  /// - m_supercell->sym_info().factor_group_permutations
+  /// - m_supercell->sym_info().factor_group->element
   ///
   /// To get the prim factor group index for this operation do:
   /// \code
-  /// Index prim_fg_index = m_supercell->sym_info.factor_group->
+  /// Index prim_fg_index = m_supercell->sym_info().factor_group->
   ///                           head_group_index[m_supercell_factor_group_index];
   /// \endcode
   Index m_supercell_factor_group_index;
@@ -160,7 +201,7 @@ class SupercellSymOp : public Comparisons<CRTPBase<SupercellSymOp>> {
   /// the unitcell with the same linear index.
   ///
   /// For small supercells, this is an index into:
-  /// - m_supercell->sym_info.translation_permutations
+  /// - m_supercell->sym_info().translation_permutations
   ///
   /// The corresponding lattice translation, fractional with respect to the
   /// prim lattice, can be obtained with:
@@ -176,13 +217,121 @@ class SupercellSymOp : public Comparisons<CRTPBase<SupercellSymOp>> {
   /// - m_supercell->unitcell_index_converter.total_sites()
   /// - m_supercell->superlattice.size()
   Index m_N_translation;
+};
+
+/// \brief Lightweight, non-owning handle to a supercell symmetry operation
+///
+/// Holds a raw pointer to the Supercell and the operation indices only. It
+/// is trivially copyable, and copying, storing, or comparing handles does
+/// not allocate or change reference counts, so large numbers of operations
+/// can be stored and iterated over cheaply. The Supercell must outlive the
+/// handle.
+///
+/// Handles are ordered and iterated the same way as SupercellSymOp:
+/// translations in the inner loop and factor group operations in the outer
+/// loop. `op_index()` is the position in that order.
+///
+/// Example, storing the operations that leave a configuration invariant:
+/// \code
+/// std::vector<SupercellSymOpHandle> subgroup;
+/// ConfigIsEquivalent equal_to_f(configuration);
+/// SupercellSymOp op = SupercellSymOp::begin(supercell);
+/// SupercellSymOp end = SupercellSymOp::end(supercell);
+/// for (; op != end; ++op) {
+///   if (equal_to_f(op)) {
+///     subgroup.emplace_back(op);
+///   }
+/// }
+/// \endcode
+class SupercellSymOpHandle
+    : public Comparisons<CRTPBase<SupercellSymOpHandle>> {
+ public:
+  /// Default invalid SupercellSymOpHandle
+  SupercellSymOpHandle()
+      : m_supercell(nullptr),
+        m_supercell_factor_group_index(0),
+        m_translation_index(0) {}
+
+  /// Construct SupercellSymOpHandle
+  SupercellSymOpHandle(Supercell const *_supercell,
+                       Index _supercell_factor_group_index,
+                       Index _translation_index)
+      : m_supercell(_supercell),
+        m_supercell_factor_group_index(_supercell_factor_group_index),
+        m_translation_index(_translation_index) {}
+
+  /// Construct SupercellSymOpHandle referring to the same operation as `op`
+  explicit SupercellSymOpHandle(SupercellSymOp const &op)
+      : m_supercell(op.supercell().get()),
+        m_supercell_factor_group_index(op.supercell_factor_group_index()),
+        m_translation_index(op.translation_index()) {}
+
+  Supercell const *supercell() const { return m_supercell; }
+
+  Index supercell_factor_group_index() const {
+    return m_supercell_factor_group_index;
+  }
+
+  Index prim_factor_group_index() const;
+
+  Index translation_index() const { return m_translation_index; }
+
+  /// \brief Position in the order of iterating over all operations
+  Index op_index() const;
+
+  /// \brief Returns the index of the site containing the site DoF values that
+  ///     will be permuted onto site i
+  Index permute_index(Index i) const;
+
+  /// \brief Write the combined permutation into `perm`, re-using its capacity
+  void combined_permute(sym_info::Permutation &perm) const;
+
+  /// \brief Returns the combined permutation, in a thread-local buffer
+  sym_info::Permutation const &combined_permute() const;
+
+  /// \brief Write the combined permutation on active sites into `perm`,
+  ///     re-using its capacity
+  void active_combined_permute(sym_info::Permutation &perm) const;
+
+  /// \brief Returns the combined permutation on active sites, in a
+  ///     thread-local buffer
+  sym_info::Permutation const &active_combined_permute() const;
+
+  /// \brief Return the SymOp for the current operation
+  SymOp to_symop() const;
+
+  /// \brief Returns the inverse supercell operation
+  SupercellSymOpHandle inverse() const;
+
+  /// \brief Returns the supercell operation equivalent to applying first RHS
+  /// and then *this
+  SupercellSymOpHandle operator*(SupercellSymOpHandle const &RHS) const;
+
+  /// \brief Less than comparison
+  bool operator<(SupercellSymOpHandle const &RHS) const {
+    if (m_supercell_factor_group_index ==
+        RHS.m_supercell_factor_group_index) {
+      return m_translation_index < RHS.m_translation_index;
+    }
+    return m_supercell_factor_group_index < RHS.m_supercell_factor_group_index;
+  }
+
+ private:
+  friend Comparisons<CRTPBase<SupercellSymOpHandle>>;
 
-  /// \brief Use to hold current translation permutation, if not
-  ///     held by SymInfo
-  mutable sym_info::Permutation m_tmp_translation_permute;
+  /// \brief Equality comparison (used to implement operator==)
+  bool eq_impl(SupercellSymOpHandle const &RHS) const {
+    return m_supercell == RHS.m_supercell &&
+           m_supercell_factor_group_index ==
+               RHS.m_supercell_factor_group_index &&
+           m_translation_index == RHS.m_translation_index;
+  }
+
+  Supercell const *m_supercell;
 
-  /// \brief Index of translation currently stored in m_tmp_translation_permute
-  mutable Index m_tmp_translation_index;
+  Index m_supercell_factor_group_index;
+
+  Index m_translation_index;
 };
 
 /// \brief Return inverse SymOp
@@ -192,10 +341,104 @@ SymOp inverse(SymOp const &op);
 /// ConfigDoFValues
 ConfigDoFValues &apply(SupercellSymOp const &op, ConfigDoFValues &dof_values);
 
+/// \brief Apply a symmetry operation specified by a SupercellSymOp to
+///     ConfigDoFValues, using caller-owned scratch storage
+ConfigDoFValues &apply(SupercellSymOp const &op, ConfigDoFValues &dof_values,
+                       ConfigDoFValues &workspace);
+
 /// \brief Apply a symmetry operation specified by a SupercellSymOp to
 /// ConfigDoFValues
 ConfigDoFValues copy_apply(SupercellSymOp const &op,
-                           ConfigDoFValues dof_values);
+                           ConfigDoFValues const &dof_values);
+
+/// \brief Write the result of applying a symmetry operation specified by a
+///     SupercellSymOp to ConfigDoFValues into existing ConfigDoFValues
+ConfigDoFValues &copy_apply(SupercellSymOp const &op,
+                            ConfigDoFValues const &source,
+                            ConfigDoFValues &dest);
+
+/// \brief ConfigDoFValues with continuous DoF values transformed by many
+///     prim factor group operations at once
+///
+/// For each local DoF type and each sublattice, the point group matrices of
+/// all requested prim factor group operations are stacked and every
+/// transformed sublattice block is computed in one matrix-matrix product.
+/// Transformed global DoF values are also computed once per operation.
+/// Applying a SupercellSymOp is then only a gather of the pre-transformed
+/// values, by the operation's combined site permutation.
+///
+/// Notes:
+/// - `source` must outlive the BatchedDoFTransform and must not be
+///   modified.
+/// - Results are equal to `copy_apply(op, source, dest)`, up to
+///   floating-point rounding.
+/// - Useful when the same DoF values are transformed by many operations,
+///   such as when making equivalents.
+class BatchedDoFTransform {
+ public:
+  /// \brief Constructor, for the given prim factor group operations
+  BatchedDoFTransform(ConfigDoFValues const &_source,
+                      Supercell const &supercell,
+                      std::set<Index> const &prim_fg_indices);
+
+  /// \brief Constructor, for the prim factor group operations of
+  ///     `[begin, end)`
+  template <typename SupercellSymOpIt>
+  BatchedDoFTransform(ConfigDoFValues const &_source, SupercellSymOpIt begin,
+                      SupercellSymOpIt end)
+      : m_source(&_source), m_n_vol(0) {
+    std::shared_ptr<Supercell const> supercell;
+    std::set<Index> prim_fg_indices;
+    for (; begin != end; ++begin) {
+      SupercellSymOp const &op = *begin;
+      if (!supercell) {
+        supercell = op.supercell();
+      }
+      prim_fg_indices.insert(op.prim_factor_group_index());
+    }
+    if (supercell) {
+      _init(*supercell, prim_fg_indices);
+    }
+  }
+
+  /// \brief The untransformed DoF values
+  ConfigDoFValues const &source() const { return *m_source; }
+
+  /// \brief Return true if values were transformed by the prim factor group
+  ///     operation
+  bool contains(Index prim_fg_index) const {
+    return prim_fg_index >= 0 && prim_fg_index < m_position.size() &&
+           m_position[prim_fg_index] != -1;
+  }
+
+  /// \brief Write `copy_apply(op, source())` into existing ConfigDoFValues
+  ConfigDoFValues &copy_apply(SupercellSymOp const &op,
+                              ConfigDoFValues &dest) const;
+
+ private:
+  void _init(Supercell const &supercell,
+             std::set<Index> const &prim_fg_indices);
+
+  ConfigDoFValues const *m_source;
+
+  Index m_n_vol;
+
+  /// Position of each prim factor group operation in the stacked results,
+  /// or -1 if not transformed
+  std::vector<Index> m_position;
+
+  /// Transformed global DoF values, `m_global[key][position]`
+  std::map<DoFKey, std::vector<Eigen::VectorXd>> m_global;
+
+  /// Transformed local DoF values, `m_local[key][b]`, with the values
+  /// transformed by the operation at `position` on unit cell `n` of
+  /// sublattice `b` in rows `[position * dim, (position + 1) * dim)` of
+  /// column `n`, where `dim` is the sublattice DoF dimension
+  std::map<DoFKey, std::vector<Eigen::MatrixXd>> m_local;
+
+  /// Sublattice DoF dimensions, `m_local_dim[key][b]`
+  std::map<DoFKey, std::vector<Index>> m_local_dim;
+};
 
 /// \brief Apply a symmetry operation specified by a SupercellSymOp to
 ///     xtal::UnitCellCoord
@@ -219,6 +462,26 @@ std::shared_ptr<SymGroup const> make_local_symgroup(
     std::vector<SupercellSymOp> const &local_supercell_symgroup_rep,
     std::shared_ptr<Supercell const> const &supercell);
 
+/// \brief A group::Group of SupercellSymOpHandle, for all operations of a
+///     supercell, or a subgroup
+///
+/// For the group of all operations, from `make_supercell_symgroup`, element
+/// `i` is the operation with `op_index() == i`.
+typedef group::Group<SupercellSymOpHandle> SupercellSymGroup;
+
+/// \brief Make the group of all operations of a supercell, with products
+///     and inverses as precomputed tables
+std::shared_ptr<SupercellSymGroup const> make_supercell_symgroup(
+    std::shared_ptr<Supercell const> const &supercell,
+    Index max_table_bytes = Index(1) << 24);
+
+/// \brief Make the subgroup of a supercell group for local property
+///     symmetry
+std::shared_ptr<SupercellSymGroup const> make_local_supercell_subgroup(
+    std::shared_ptr<SymGroup const> const &local_prim_subgroup,
+    std::shared_ptr<Supercell const> const &supercell,
+    std::shared_ptr<SupercellSymGroup const> const &supercell_symgroup);
+
 /// \brief Make the matrix representation of `group` that describes the
 ///     transformation of the specified DoF
 std::vector<Eigen::MatrixXd> make_matrix_rep(
@@ -240,6 +503,21 @@ std::vector<Eigen::MatrixXd> make_local_dof_matrix_rep(
     std::set<Index> const &site_indices,
     std::shared_ptr<SymGroup const> &symgroup);
 
+/// \brief Make the sparse matrix representation of `group` that describes
+///     the transformation of the specified DoF
+std::vector<Eigen::SparseMatrix<double>> make_sparse_matrix_rep(
+    std::vector<SupercellSymOp> const &group, DoFKey key,
+    std::optional<std::set<Index>> site_indices,
+    std::shared_ptr<SymGroup const> &symgroup);
+
+/// \brief Make the sparse matrix representation of `group` that describes
+///     the transformation of occupation DoF or a particular local DoF of
+///     amongst a subset of supercell sites
+std::vector<Eigen::SparseMatrix<double>> make_local_dof_sparse_matrix_rep(
+    std::vector<SupercellSymOp> const &group, DoFKey key,
+    std::set<Index> const &site_indices,
+    std::shared_ptr<SymGroup const> &symgroup);
+
 /// \brief Make the matrix representation of `group` that describes the
 ///     transformation of values in the basis of the given DoFSpace
 std::vector<Eigen::MatrixXd> make_dof_space_rep(
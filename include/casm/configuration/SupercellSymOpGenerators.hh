@@ -0,0 +1,111 @@
+#ifndef CASM_config_SupercellSymOpGenerators
+#define CASM_config_SupercellSymOpGenerators
+
+#include <memory>
+#include <vector>
+
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/definitions.hh"
+#include "casm/configuration/group/IndexBitset.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Return a small set of operations that generates a group of
+///     SupercellSymOp
+std::vector<SupercellSymOp> make_generators(
+    std::vector<SupercellSymOp> const &group);
+
+/// \brief Base and strong generating set of a group of SupercellSymOp,
+///     acting on supercell sites
+///
+/// For a group G, and base points b_0, b_1, ..., b_{k-1} (linear site
+/// indices), the stabilizer chain is
+///
+///     G = G_0 >= G_1 >= ... >= G_k = K,
+///
+/// where G_{i+1} are the operations in G_i that leave site b_i invariant,
+/// and K, the kernel, are the operations that leave every site invariant
+/// (for example, operations that differ only by their effect on local DoF).
+/// For each level, the basic orbit is the orbit of b_i under G_i, and the
+/// transversal holds one operation of G_i for each site of the basic orbit.
+///
+/// The strong generating set, S, generates G, and the operations of S in
+/// G_i generate G_i, for every level. It is found greedily, starting from
+/// generators of K and working up the chain, so it is also a small
+/// generating set of G.
+///
+/// Membership is tested by sifting: an operation g is in G if, at each
+/// level, the site permuted onto b_i is in the basic orbit, and after
+/// dividing out the transversal operation the result is in K. This costs
+/// one operation product per level, and the chain stores only one
+/// operation per basic orbit site and the kernel, instead of all of G.
+///
+/// Notes:
+/// - Base points are chosen as the smallest site moved by G_i
+/// - All operations must be in the same supercell
+class SupercellSymOpStabilizerChain {
+ public:
+  /// \brief Constructor
+  explicit SupercellSymOpStabilizerChain(
+      std::vector<SupercellSymOp> const &group);
+
+  /// \brief The supercell
+  std::shared_ptr<Supercell const> const &supercell() const;
+
+  /// \brief The number of operations in the group
+  Index group_size() const;
+
+  /// \brief The base points, as linear site indices
+  std::vector<Index> const &base() const;
+
+  /// \brief The strong generating set
+  std::vector<SupercellSymOp> const &strong_generators() const;
+
+  /// \brief The orbit of `base()[i]` under the stabilizer of
+  ///     `base()[0], ..., base()[i-1]`, as linear site indices
+  std::vector<Index> const &basic_orbit(Index i) const;
+
+  /// \brief The operations that leave every site invariant
+  std::vector<SupercellSymOp> const &kernel() const;
+
+  /// \brief Return true if an operation is in the group
+  bool contains(SupercellSymOp const &op) const;
+
+ private:
+  struct Level {
+    /// Base point, as a linear site index
+    Index base_point;
+
+    /// Basic orbit, as linear site indices
+    std::vector<Index> orbit;
+
+    /// Index into `transversal_inverse`, by linear site index, or -1 if
+    /// the site is not in the basic orbit
+    std::vector<Index> transversal_index;
+
+    /// For each site p of the basic orbit, the inverse of an operation u
+    /// of the level for which `u.permute_index(base_point) == p`
+    std::vector<SupercellSymOpHandle> transversal_inverse;
+  };
+
+  std::shared_ptr<Supercell const> m_supercell;
+
+  Index m_group_size;
+
+  std::vector<Index> m_base;
+
+  std::vector<Level> m_levels;
+
+  std::vector<SupercellSymOp> m_strong_generators;
+
+  std::vector<SupercellSymOp> m_kernel;
+
+  /// Kernel membership, by op_index
+  group::IndexBitset m_kernel_bits;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef CASM_config_TimeReversalCanonicalizer
+#define CASM_config_TimeReversalCanonicalizer
+
+#include <vector>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/ConfigIsEquivalent.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Canonical form methods that use the time reversal coset structure
+///     of magnetic factor groups
+///
+/// For prim with magnetic DoF, such as continuous `Cmagspin` DoF or
+/// occupants with magnetic spin properties, the factor group contains pure
+/// time reversal, `theta` (identity matrix, zero translation, time reversal
+/// active), so it is the union of the spatial operations `g` (without time
+/// reversal) and their partners `theta * g`. Operations are transformed by
+/// `g` as usual, and the effect of the partner `theta * g` is obtained from
+/// the `g` result by a single pass over the values that flips magnetic
+/// values, rather than by transforming all DoF values again. This halves
+/// the number of symmetry representation matrix applications and site
+/// permutations.
+///
+/// Results, including the returned operation, are the same as
+/// `is_canonical`, `to_canonical`, and `make_canonical_form` of
+/// `canonical_form.hh` using all supercell operations.
+///
+/// Notes:
+/// - The prim must satisfy `TimeReversalCanonicalizer::is_supported`,
+///   which requires that the prim factor group contains pure time reversal
+///   and that its representation is a sign flip of continuous DoF
+///   components (diagonal, with entries +1 or -1) and site-independent
+///   occupant permutations, as for `Cmagspin`, `NCmagspin`, and discrete
+///   magnetic atomic occupants.
+/// - Construct once per supercell and re-use for many configurations
+/// - Not thread safe; use one TimeReversalCanonicalizer per thread
+class TimeReversalCanonicalizer {
+ public:
+  /// \brief Constructor
+  explicit TimeReversalCanonicalizer(
+      std::shared_ptr<Supercell const> const &_supercell);
+
+  /// \brief Return true if the prim factor group contains pure time
+  ///     reversal represented by sign flips and occupant permutations
+  static bool is_supported(Prim const &prim);
+
+  /// \brief The supercell
+  std::shared_ptr<Supercell const> const &supercell() const;
+
+  /// \brief Supercell factor group indices of operations without time
+  ///     reversal
+  std::vector<Index> const &spatial_factor_group_indices() const;
+
+  /// \brief Supercell factor group index of `theta * element[i]`, by
+  ///     supercell factor group index `i`
+  std::vector<Index> const &time_reversal_partner() const;
+
+  /// \brief Return true if configuration is in canonical form, using all
+  ///     supercell operations
+  bool is_canonical(Configuration const &configuration);
+
+  /// \brief Return rep that makes a configuration canonical, using all
+  ///     supercell operations
+  SupercellSymOp to_canonical(Configuration const &configuration);
+
+  /// \brief Return the canonical configuration, using all supercell
+  ///     operations
+  Configuration make_canonical_form(Configuration const &configuration);
+
+ private:
+  /// \brief Write the time reversal of `source` into `dest`
+  void _flip(ConfigDoFValues const &source, ConfigDoFValues &dest) const;
+
+  /// \brief If `candidate` is greater than m_best, or equal and `op` is
+  ///     before m_best_op, swap it into m_best and set m_best_op
+  void _update(Configuration &candidate, SupercellSymOpHandle const &op);
+
+  struct GlobalFlip {
+    DoFKey key;
+    /// Sign of each component under time reversal
+    Eigen::VectorXd sign;
+  };
+
+  struct LocalFlip {
+    DoFKey key;
+    /// Sign of each component under time reversal, by row of the local DoF
+    /// values matrix and sublattice
+    Eigen::MatrixXd sign;
+  };
+
+  std::shared_ptr<Supercell const> m_supercell;
+
+  Index m_n_vol;
+
+  std::vector<Index> m_spatial_factor_group_indices;
+
+  std::vector<Index> m_time_reversal_partner;
+
+  /// Occupant index after time reversal, by sublattice and occupant index,
+  /// or empty if time reversal does not permute occupants
+  std::vector<std::vector<int>> m_occ_flip;
+
+  std::vector<GlobalFlip> m_global_flip;
+
+  std::vector<LocalFlip> m_local_flip;
+
+  /// Transformed configuration being compared
+  Configuration m_transformed;
+
+  /// Time reversed m_transformed
+  Configuration m_flipped;
+
+  /// Greatest configuration found so far
+  Configuration m_best;
+
+  SupercellSymOpHandle m_best_op;
+
+  /// Compares against m_best
+  ConfigIsEquivalent m_best_eq;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
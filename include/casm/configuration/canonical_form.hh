@@ -4,14 +4,17 @@
 #include <set>
 
 #include "casm/configuration/definitions.hh"
+#include "casm/configuration/group/IndexBitset.hh"
 
 namespace CASM {
 namespace config {
 
+class CanonicalWitnessList;
 struct Configuration;
 struct ConfigurationWithProperties;
 struct Supercell;
 class SupercellSymOp;
+class SupercellSymOpHandle;
 
 // --- Supercell ---
 
@@ -28,6 +31,36 @@ std::shared_ptr<Supercell const> make_canonical_form(
 std::vector<std::shared_ptr<Supercell const>> make_equivalents(
     Supercell const &supercell);
 
+// --- Supercell, by integer transformation matrix ---
+
+/// \brief Return symmetry operations as integer matrices that transform
+///     supercell transformation matrices
+std::vector<Eigen::Matrix3l> make_frac_point_matrices(
+    Lattice const &prim_lattice, std::vector<SymOp> const &ops);
+
+/// \brief Return the Hermite normal form of a supercell transformation
+///     matrix
+Eigen::Matrix3l make_hnf(Eigen::Matrix3l transformation_matrix_to_super);
+
+/// \brief Return the least Hermite normal form of the symmetrically
+///     equivalent supercell transformation matrices
+Eigen::Matrix3l make_canonical_hnf(
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    std::vector<Eigen::Matrix3l> const &frac_point_group);
+
+/// \brief Return the distinct Hermite normal forms of the symmetrically
+///     equivalent supercell transformation matrices
+std::vector<Eigen::Matrix3l> make_equivalent_hnfs(
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    std::vector<Eigen::Matrix3l> const &frac_point_group);
+
+/// \brief Return the index of the first operation that transforms a
+///     supercell to an equivalent supercell, or -1
+Index find_frac_op_index_to_supercell(
+    Eigen::Matrix3l const &current_transformation_matrix_to_super,
+    Eigen::Matrix3l const &new_transformation_matrix_to_super,
+    std::vector<Eigen::Matrix3l> const &frac_ops);
+
 // --- Configuration ---
 
 /// \brief Return true if configuration is in canonical form
@@ -35,6 +68,21 @@ template <typename SupercellSymOpIt>
 bool is_canonical(Configuration const &configuration, SupercellSymOpIt begin,
                   SupercellSymOpIt end);
 
+/// \brief Return the first operation showing that a configuration is not in
+///     canonical form, or `end`
+template <typename SupercellSymOpIt>
+SupercellSymOpIt find_non_canonical_witness(Configuration const &configuration,
+                                            SupercellSymOpIt begin,
+                                            SupercellSymOpIt end);
+
+/// \brief Return an operation showing that a configuration is not in
+///     canonical form, trying recent witnesses first, or `end`
+template <typename SupercellSymOpIt>
+SupercellSymOpIt find_non_canonical_witness(Configuration const &configuration,
+                                            SupercellSymOpIt begin,
+                                            SupercellSymOpIt end,
+                                            CanonicalWitnessList &recent);
+
 /// \brief Return the configuration that compares greater to all equivalents in
 ///     the same supercell
 template <typename SupercellSymOpIt>
@@ -58,6 +106,45 @@ std::vector<SupercellSymOp> make_invariant_subgroup(
     Configuration const &configuration, SupercellSymOpIt begin,
     SupercellSymOpIt end);
 
+/// \brief Return true if configuration is in canonical form, using multiple
+///     threads
+template <typename SupercellSymOpIt>
+bool is_canonical(Configuration const &configuration, SupercellSymOpIt begin,
+                  SupercellSymOpIt end, Index n_threads);
+
+/// \brief Return the configuration that compares greater to all equivalents in
+///     the same supercell, using multiple threads
+template <typename SupercellSymOpIt>
+Configuration make_canonical_form(Configuration const &configuration,
+                                  SupercellSymOpIt begin, SupercellSymOpIt end,
+                                  Index n_threads);
+
+/// \brief Return rep that makes a configuration canonical, using multiple
+///     threads
+template <typename SupercellSymOpIt>
+SupercellSymOp to_canonical(Configuration const &configuration,
+                            SupercellSymOpIt begin, SupercellSymOpIt end,
+                            Index n_threads);
+
+/// \brief Return rep that leave configuration invariant, using multiple
+///     threads
+template <typename SupercellSymOpIt>
+std::vector<SupercellSymOp> make_invariant_subgroup(
+    Configuration const &configuration, SupercellSymOpIt begin,
+    SupercellSymOpIt end, Index n_threads);
+
+/// \brief Return the supercell operations that leave configuration
+///     invariant, finding the invariant translations first
+std::vector<SupercellSymOp> make_invariant_subgroup(
+    Configuration const &configuration);
+
+/// \brief Return the canonical forms of many configurations in the same
+///     supercell
+std::vector<Configuration> make_canonical_forms(
+    std::vector<Configuration> const &configurations,
+    std::shared_ptr<Supercell const> const &supercell, Index n_threads = 1,
+    std::vector<Index> *to_canonical_op_indices = nullptr);
+
 /// \brief Return the distinct symmetrically equivalent configurations (using
 ///     operations that leave the supercell lattice invariant)
 template <typename SupercellSymOpIt>
@@ -89,6 +176,11 @@ std::vector<std::vector<SupercellSymOp>> make_equivalence_map(
 bool site_indices_are_invariant(SupercellSymOp const &op,
                                 std::set<Index> const &site_indices);
 
+/// \brief Return true if the operation does not mix given sites and other
+/// sites
+bool site_indices_are_invariant(SupercellSymOp const &op,
+                                group::IndexBitset const &site_indices);
+
 /// \brief Return the subgroup of [begin, end] that does not mix given sites and
 ///     other sites
 template <typename SupercellSymOpIt>
@@ -103,18 +195,55 @@ std::vector<SupercellSymOp> make_invariant_subgroup(
     Configuration const &configuration, std::set<Index> const &site_indices,
     SupercellSymOpIt begin, SupercellSymOpIt end);
 
+/// \brief Return the subgroup of a supercell group that leaves
+///     configuration invariant
+std::shared_ptr<group::Group<SupercellSymOpHandle> const>
+make_invariant_subgroup(
+    Configuration const &configuration,
+    std::shared_ptr<group::Group<SupercellSymOpHandle> const> const
+        &supercell_symgroup);
+
 }  // namespace config
 }  // namespace CASM
 
 // --- Implementation ---
 
 #include <algorithm>
+#include <atomic>
 
+#include "casm/configuration/CanonicalWitnessList.hh"
 #include "casm/configuration/ConfigCompare.hh"
+#include "casm/configuration/ConfigComparisonContext.hh"
+#include "casm/configuration/EquivalentsGenerator.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/instrumentation.hh"
+#include "casm/configuration/parallel.hh"
 
 namespace CASM {
 namespace config {
 
+namespace canonical_form_impl {
+
+/// \brief Store the operations in `[begin, end)` as SupercellSymOpHandle
+///
+/// Sets `supercell` to the supercell of the first operation, if any.
+template <typename SupercellSymOpIt>
+std::vector<SupercellSymOpHandle> make_handles(
+    SupercellSymOpIt begin, SupercellSymOpIt end,
+    std::shared_ptr<Supercell const> &supercell) {
+  std::vector<SupercellSymOpHandle> handles;
+  for (; begin != end; ++begin) {
+    SupercellSymOp const &op = *begin;
+    if (!supercell) {
+      supercell = op.supercell();
+    }
+    handles.emplace_back(op);
+  }
+  return handles;
+}
+
+}  // namespace canonical_form_impl
+
 /// \brief Return true if configuration is in canonical form
 ///
 /// If true, then `configuration` satisfies, for all `rep` in `[begin,
@@ -123,8 +252,40 @@ namespace config {
 template <typename SupercellSymOpIt>
 bool is_canonical(Configuration const &configuration, SupercellSymOpIt begin,
                   SupercellSymOpIt end) {
+  return find_non_canonical_witness(configuration, begin, end) == end;
+}
+
+/// \brief Return the first operation showing that a configuration is not in
+///     canonical form, or `end`
+///
+/// \returns The first `it` in `[begin, end)` such that
+///     `configuration < copy_apply(*it, configuration)`, the "witness", or
+///     `end` if `configuration` is in canonical form.
+template <typename SupercellSymOpIt>
+SupercellSymOpIt find_non_canonical_witness(Configuration const &configuration,
+                                            SupercellSymOpIt begin,
+                                            SupercellSymOpIt end) {
   ConfigCompare compare_f(configuration);
-  return std::none_of(begin, end, compare_f);
+  return std::find_if(begin, end, compare_f);
+}
+
+/// \brief Return an operation showing that a configuration is not in
+///     canonical form, trying recent witnesses first, or `end`
+///
+/// Same as `find_non_canonical_witness(configuration, begin, end)`, except
+/// that the witnesses in `recent` are tried first (see
+/// CanonicalWitnessList), so the witness returned may not be the first.
+/// Requires random access iterators, and `recent` must only be used with
+/// the same range of operations.
+template <typename SupercellSymOpIt>
+SupercellSymOpIt find_non_canonical_witness(Configuration const &configuration,
+                                            SupercellSymOpIt begin,
+                                            SupercellSymOpIt end,
+                                            CanonicalWitnessList &recent) {
+  ConfigCompare compare_f(configuration);
+  Index i = recent.find(std::distance(begin, end),
+                        [&](Index k) { return compare_f(*(begin + k)); });
+  return i == -1 ? end : begin + i;
 }
 
 /// \brief Return the configuration that compares greater to all equivalents in
@@ -137,6 +298,8 @@ template <typename SupercellSymOpIt>
 Configuration make_canonical_form(Configuration const &configuration,
                                   SupercellSymOpIt begin,
                                   SupercellSymOpIt end) {
+  CASM_CONFIG_COUNT(canonical_forms);
+  CASM_CONFIG_SCOPED_TIMER(canonical_form);
   return copy_apply(to_canonical(configuration, begin, end), configuration);
 }
 
@@ -194,7 +357,176 @@ std::vector<SupercellSymOp> make_invariant_subgroup(
     SupercellSymOpIt end) {
   std::vector<SupercellSymOp> subgroup;
   ConfigIsEquivalent equal_to_f(configuration);
-  std::copy_if(begin, end, std::back_inserter(subgroup), equal_to_f);
+  equal_to_f.visit([&](auto const &f) {
+    for (auto it = begin; it != end; ++it) {
+      CASM_CONFIG_COUNT(comparisons);
+      if (f(*it)) {
+        subgroup.push_back(*it);
+      }
+    }
+  });
+  return subgroup;
+}
+
+/// \brief Return true if configuration is in canonical form, using multiple
+///     threads
+///
+/// Equivalent to `is_canonical(configuration, begin, end)`, but `[begin,
+/// end)` is partitioned into `n_threads` contiguous ranges which are checked
+/// in parallel, each with its own ConfigComparisonContext. Checking stops
+/// early on all threads once any operation makes a greater configuration.
+///
+/// Operations are stored as SupercellSymOpHandle, and each thread uses a
+/// single SupercellSymOp as a cursor, so the number of allocations does not
+/// scale with the number of operations.
+///
+/// \param n_threads Number of threads to use. If <= 0, uses
+///     `std::thread::hardware_concurrency()`.
+template <typename SupercellSymOpIt>
+bool is_canonical(Configuration const &configuration, SupercellSymOpIt begin,
+                  SupercellSymOpIt end, Index n_threads) {
+  std::shared_ptr<Supercell const> supercell;
+  std::vector<SupercellSymOpHandle> ops =
+      canonical_form_impl::make_handles(begin, end, supercell);
+  std::atomic<bool> found_greater(false);
+  ConfigComparisonDefinition definition(configuration);
+  parallel_for_chunks(
+      ops.size(), n_threads,
+      [&](Index chunk_index, Index chunk_begin, Index chunk_end) {
+        ConfigComparisonContext context = definition.make_context();
+        SupercellSymOp op(supercell, ops[chunk_begin]);
+        for (Index i = chunk_begin; i < chunk_end; ++i) {
+          if (found_greater.load(std::memory_order_relaxed)) {
+            return;
+          }
+          op.reset(ops[i].supercell_factor_group_index(),
+                   ops[i].translation_index());
+          if (context.less(op)) {
+            found_greater = true;
+            return;
+          }
+        }
+      });
+  return !found_greater;
+}
+
+/// \brief Return the configuration that compares greater to all equivalents in
+///     the same supercell, using multiple threads
+///
+/// Equivalent to `make_canonical_form(configuration, begin, end)`, using
+/// `to_canonical(configuration, begin, end, n_threads)`.
+template <typename SupercellSymOpIt>
+Configuration make_canonical_form(Configuration const &configuration,
+                                  SupercellSymOpIt begin, SupercellSymOpIt end,
+                                  Index n_threads) {
+  CASM_CONFIG_COUNT(canonical_forms);
+  CASM_CONFIG_SCOPED_TIMER(canonical_form);
+  return copy_apply(to_canonical(configuration, begin, end, n_threads),
+                    configuration);
+}
+
+/// \brief Return rep that makes a configuration canonical, using multiple
+///     threads
+///
+/// The result is the same as `to_canonical(configuration, begin, end)`: the
+/// first `rep` in `[begin, end)` that satisfies:
+///     canonical_configuration == copy_apply(rep, configuration)
+///
+/// Method:
+/// - `[begin, end)` is partitioned into `n_threads` contiguous ranges
+/// - The first greatest element of each range is found in parallel, each
+///   with its own ConfigComparisonContext
+/// - The per-range results are reduced in order, replacing the current
+///   result only if strictly greater, which preserves "first greatest"
+///
+/// \param n_threads Number of threads to use. If <= 0, uses
+///     `std::thread::hardware_concurrency()`.
+template <typename SupercellSymOpIt>
+SupercellSymOp to_canonical(Configuration const &configuration,
+                            SupercellSymOpIt begin, SupercellSymOpIt end,
+                            Index n_threads) {
+  std::shared_ptr<Supercell const> supercell;
+  std::vector<SupercellSymOpHandle> ops =
+      canonical_form_impl::make_handles(begin, end, supercell);
+  if (ops.empty()) {
+    throw std::runtime_error("Error in to_canonical: empty range");
+  }
+  std::vector<Index> chunk_max(resolve_n_threads(n_threads), -1);
+  ConfigComparisonDefinition definition(configuration);
+  parallel_for_chunks(
+      ops.size(), n_threads,
+      [&](Index chunk_index, Index chunk_begin, Index chunk_end) {
+        ConfigComparisonContext context = definition.make_context();
+        SupercellSymOp max_op(supercell, ops[chunk_begin]);
+        SupercellSymOp op(max_op);
+        Index max_i = chunk_begin;
+        for (Index i = chunk_begin + 1; i < chunk_end; ++i) {
+          op.reset(ops[i].supercell_factor_group_index(),
+                   ops[i].translation_index());
+          if (context.less(max_op, op)) {
+            max_op.reset(op.supercell_factor_group_index(),
+                         op.translation_index());
+            max_i = i;
+          }
+        }
+        chunk_max[chunk_index] = max_i;
+      });
+
+  ConfigComparisonContext context = definition.make_context();
+  Index result = -1;
+  for (Index i : chunk_max) {
+    if (i == -1) {
+      continue;
+    }
+    if (result == -1 || context.less(SupercellSymOp(supercell, ops[result]),
+                                     SupercellSymOp(supercell, ops[i]))) {
+      result = i;
+    }
+  }
+  return SupercellSymOp(supercell, ops[result]);
+}
+
+/// \brief Return rep that leave configuration invariant, using multiple
+///     threads
+///
+/// The result is the same as `make_invariant_subgroup(configuration, begin,
+/// end)`, in the same order.
+///
+/// \param n_threads Number of threads to use. If <= 0, uses
+///     `std::thread::hardware_concurrency()`.
+template <typename SupercellSymOpIt>
+std::vector<SupercellSymOp> make_invariant_subgroup(
+    Configuration const &configuration, SupercellSymOpIt begin,
+    SupercellSymOpIt end, Index n_threads) {
+  std::shared_ptr<Supercell const> supercell;
+  std::vector<SupercellSymOpHandle> ops =
+      canonical_form_impl::make_handles(begin, end, supercell);
+  std::vector<std::vector<SupercellSymOpHandle>> chunk_subgroup(
+      resolve_n_threads(n_threads));
+  ConfigComparisonDefinition definition(configuration);
+  parallel_for_chunks(
+      ops.size(), n_threads,
+      [&](Index chunk_index, Index chunk_begin, Index chunk_end) {
+        ConfigComparisonContext context = definition.make_context();
+        SupercellSymOp op(supercell, ops[chunk_begin]);
+        context.visit([&](auto const &f) {
+          for (Index i = chunk_begin; i < chunk_end; ++i) {
+            op.reset(ops[i].supercell_factor_group_index(),
+                     ops[i].translation_index());
+            CASM_CONFIG_COUNT(comparisons);
+            if (f(op)) {
+              chunk_subgroup[chunk_index].push_back(ops[i]);
+            }
+          }
+        });
+      });
+
+  std::vector<SupercellSymOp> subgroup;
+  for (auto const &chunk : chunk_subgroup) {
+    for (auto const &handle : chunk) {
+      subgroup.emplace_back(supercell, handle);
+    }
+  }
   return subgroup;
 }
 
@@ -214,8 +546,20 @@ std::vector<Configuration> make_equivalents(Configuration const &configuration,
                                             SupercellSymOpIt begin,
                                             SupercellSymOpIt end) {
   std::set<Configuration> equivalents;
-  for (auto it = begin; it != end; ++it) {
-    equivalents.emplace(copy_apply(*it, configuration));
+  // transform into re-used storage, and only copy distinct equivalents
+  Configuration equivalent = configuration;
+  if (configuration.dof_values.local_dof_values.empty()) {
+    for (auto it = begin; it != end; ++it) {
+      copy_apply(*it, configuration.dof_values, equivalent.dof_values);
+      equivalents.insert(equivalent);
+    }
+  } else {
+    // transform local DoF values by all point group ops at once
+    BatchedDoFTransform transform(configuration.dof_values, begin, end);
+    for (auto it = begin; it != end; ++it) {
+      transform.copy_apply(*it, equivalent.dof_values);
+      equivalents.insert(equivalent);
+    }
   }
   return std::vector<Configuration>(equivalents.begin(), equivalents.end());
 }
@@ -245,8 +589,23 @@ std::vector<ConfigurationWithProperties> make_equivalents(
   };
   std::set<std::pair<Configuration, SupercellSymOp>, decltype(compare)>
       equivalents(compare);
-  for (auto it = begin; it != end; ++it) {
-    equivalents.emplace(copy_apply(*it, configuration), *it);
+  if (begin != end) {
+    // transform into re-used storage, and only copy distinct equivalents
+    std::pair<Configuration, SupercellSymOp> equivalent(configuration, *begin);
+    std::optional<BatchedDoFTransform> transform;
+    if (!configuration.dof_values.local_dof_values.empty()) {
+      // transform local DoF values by all point group ops at once
+      transform.emplace(configuration.dof_values, begin, end);
+    }
+    for (auto it = begin; it != end; ++it) {
+      if (transform.has_value()) {
+        transform->copy_apply(*it, equivalent.first.dof_values);
+      } else {
+        copy_apply(*it, configuration.dof_values, equivalent.first.dof_values);
+      }
+      equivalent.second = *it;
+      equivalents.insert(equivalent);
+    }
   }
 
   std::vector<ConfigurationWithProperties> equivalents_with_properties;
@@ -276,6 +635,17 @@ std::vector<ConfigurationWithProperties> make_equivalents(
 ///     the SupercellSymOp that transform the first element in
 ///     equivalents into the i-th element in equivalents.
 ///
+/// Method:
+/// - The operations that generate the same equivalent are a left coset,
+///   gH, of the subgroup H that leaves the first equivalent invariant. H
+///   and one representative of each coset are found once (see
+///   EquivalentsGenerator), then only the representatives are applied and
+///   compared to `equivalents`, and their cosets are filled in by
+///   multiplying through H.
+/// - Operations in each equivalence_map[i] are in the order of `[begin,
+///   end)`.
+/// - If `equivalents` is sorted, as returned by `make_equivalents`, each
+///   representative's equivalent is found by binary search.
 template <typename SupercellSymOpIt>
 std::vector<std::vector<SupercellSymOp>> make_equivalence_map(
     std::vector<Configuration> const &equivalents, SupercellSymOpIt begin,
@@ -284,22 +654,54 @@ std::vector<std::vector<SupercellSymOp>> make_equivalence_map(
     throw std::runtime_error(
         "Error in make_equivalence_map: equivalents.size() == 0");
   }
-  std::vector<std::vector<SupercellSymOp>> equivalence_map;
-  equivalence_map.resize(equivalents.size());
-  auto equiv_begin = equivalents.begin();
-  auto equiv_end = equivalents.end();
-  for (auto symop_it = begin; symop_it != end; ++symop_it) {
-    auto equiv = copy_apply_f(*symop_it, *equiv_begin);
-    Index d = 0;
-    auto equiv_it = equiv_begin;
-    while (equiv_it != equiv_end && equiv != *equiv_it) {
-      ++equiv_it;
-      ++d;
+  Configuration const &prototype = equivalents[0];
+  auto const &supercell = prototype.supercell;
+
+  // position in [begin, end), by op_index, or -1
+  std::vector<SupercellSymOp> ops(begin, end);
+  Index n_ops = supercell->sym_info().factor_group_permutations.size() *
+                supercell->superlattice.size();
+  std::vector<Index> position(n_ops, -1);
+  for (Index i = 0; i < ops.size(); ++i) {
+    position[SupercellSymOpHandle(ops[i]).op_index()] = i;
+  }
+
+  EquivalentsGenerator generator(prototype, ops.begin(), ops.end());
+  bool is_sorted = std::is_sorted(equivalents.begin(), equivalents.end());
+  std::vector<std::vector<Index>> positions(equivalents.size());
+  while (generator.is_valid()) {
+    Configuration const &equiv = generator.value();
+    auto equiv_it = equivalents.end();
+    if (is_sorted) {
+      equiv_it =
+          std::lower_bound(equivalents.begin(), equivalents.end(), equiv);
+      if (equiv_it != equivalents.end() && *equiv_it != equiv) {
+        equiv_it = equivalents.end();
+      }
+    } else {
+      equiv_it = std::find(equivalents.begin(), equivalents.end(), equiv);
     }
-    if (equiv_it == equiv_end) {
+    if (equiv_it == equivalents.end()) {
       throw std::runtime_error("Error in make_equivalence_map: failed");
     }
-    equivalence_map[d].push_back(*symop_it);
+    std::vector<Index> &coset = positions[equiv_it - equivalents.begin()];
+    SupercellSymOpHandle rep(generator.op());
+    for (SupercellSymOpHandle const &h : generator.invariant_subgroup()) {
+      Index i = position[(rep * h).op_index()];
+      if (i != -1) {
+        coset.push_back(i);
+      }
+    }
+    generator.advance();
+  }
+
+  std::vector<std::vector<SupercellSymOp>> equivalence_map;
+  equivalence_map.resize(equivalents.size());
+  for (Index d = 0; d < positions.size(); ++d) {
+    std::sort(positions[d].begin(), positions[d].end());
+    for (Index i : positions[d]) {
+      equivalence_map[d].push_back(ops[i]);
+    }
   }
   return equivalence_map;
 }
@@ -322,6 +724,8 @@ std::vector<std::vector<SupercellSymOp>> make_equivalence_map(
 ///     the SupercellSymOp that transform the first element in
 ///     equivalents into the i-th element in equivalents.
 ///
+/// See `make_equivalence_map(std::vector<Configuration> const &, ...)` for
+/// the method.
 template <typename SupercellSymOpIt>
 std::vector<std::vector<SupercellSymOp>> make_equivalence_map(
     std::vector<ConfigurationWithProperties> const &equivalents_with_properties,
@@ -331,38 +735,31 @@ std::vector<std::vector<SupercellSymOp>> make_equivalence_map(
         "Error in make_equivalence_map: equivalents_with_properties.size() == "
         "0");
   }
-  std::vector<std::vector<SupercellSymOp>> equivalence_map;
-  equivalence_map.resize(equivalents_with_properties.size());
-  auto equiv_begin = equivalents_with_properties.begin();
-  auto equiv_end = equivalents_with_properties.end();
-  for (auto symop_it = begin; symop_it != end; ++symop_it) {
-    auto equiv = copy_apply_f(*symop_it, *equiv_begin);
-    Index d = 0;
-    auto equiv_it = equiv_begin;
-    while (equiv_it != equiv_end &&
-           equiv.configuration != equiv_it->configuration) {
-      ++equiv_it;
-      ++d;
-    }
-    if (equiv_it == equiv_end) {
-      throw std::runtime_error(
-          "Error in make_equivalence_map (with properties): failed");
-    }
-    equivalence_map[d].push_back(*symop_it);
+  std::vector<Configuration> equivalents;
+  for (auto const &equiv : equivalents_with_properties) {
+    equivalents.push_back(equiv.configuration);
   }
-  return equivalence_map;
+  return make_equivalence_map(equivalents, begin, end);
 }
 
 /// \brief Return the subgroup of [begin, end] that does not mix given sites and
 ///     other sites
+///
+/// Site membership is checked using a bit set, so the cost per operation is
+/// linear in the number of given sites.
 template <typename SupercellSymOpIt>
 std::vector<SupercellSymOp> make_invariant_subgroup(
     std::set<Index> const &site_indices, SupercellSymOpIt begin,
     SupercellSymOpIt end) {
   std::vector<SupercellSymOp> invariant_subgroup;
+  if (site_indices.empty()) {
+    invariant_subgroup.assign(begin, end);
+    return invariant_subgroup;
+  }
+  group::IndexBitset site_bits(*site_indices.rbegin() + 1, site_indices);
 
   for (auto it = begin; it != end; ++it) {
-    if (site_indices_are_invariant(*it, site_indices)) {
+    if (site_indices_are_invariant(*it, site_bits)) {
       invariant_subgroup.push_back(*it);
     }
   }
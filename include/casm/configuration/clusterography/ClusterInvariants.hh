@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "casm/configuration/clusterography/definitions.hh"
+#include "casm/global/eigen.hh"
 
 namespace CASM {
 namespace clust {
@@ -37,6 +38,15 @@ class ClusterInvariants {
                     IntegralCluster const &phenomenal,
                     xtal::BasicStructure const &basicstructure);
 
+  /// \brief Construct and calculate cluster invariants from the Cartesian
+  ///     coordinates of the cluster sites
+  explicit ClusterInvariants(Eigen::Ref<Eigen::Matrix3Xd const> const &cart);
+
+  /// \brief Construct and calculate cluster invariants from the Cartesian
+  ///     coordinates of the cluster sites and phenomenal cluster sites
+  ClusterInvariants(Eigen::Ref<Eigen::Matrix3Xd const> const &cart,
+                    Eigen::Ref<Eigen::Matrix3Xd const> const &phenomenal_cart);
+
   /// \brief Number of elements in the cluster
   int size() const;
 
@@ -61,6 +71,43 @@ class ClusterInvariants {
   std::vector<double> m_phenom_distances;
 };
 
+/// \brief Calculates Cartesian coordinates of sites, and ClusterInvariants,
+///     using the lattice and basis Cartesian coordinates of a prim
+///
+/// Equivalent to `xtal::UnitCellCoord::coordinate`, without constructing a
+/// xtal::Coordinate for each site. When generating clusters by adding
+/// candidate sites to a cluster, the Cartesian coordinates of the cluster
+/// sites and candidate sites can be calculated once and reused for each
+/// ClusterInvariants.
+class ClusterInvariantsCalculator {
+ public:
+  explicit ClusterInvariantsCalculator(
+      xtal::BasicStructure const &basicstructure);
+
+  /// \brief Cartesian coordinate of a site
+  Eigen::Vector3d cart(xtal::UnitCellCoord const &site) const;
+
+  /// \brief Cartesian coordinates of sites, as columns
+  Eigen::Matrix3Xd cart(std::vector<xtal::UnitCellCoord> const &sites) const;
+
+  /// \brief Cartesian coordinates of cluster sites, as columns
+  Eigen::Matrix3Xd cart(IntegralCluster const &cluster) const;
+
+  /// \brief Calculate cluster invariants
+  ClusterInvariants operator()(IntegralCluster const &cluster) const;
+
+  /// \brief Calculate cluster invariants, including phenomenal cluster sites
+  ClusterInvariants operator()(IntegralCluster const &cluster,
+                               IntegralCluster const &phenomenal) const;
+
+ private:
+  /// \brief Lattice vectors, as columns
+  Eigen::Matrix3d m_lat_column_mat;
+
+  /// \brief Cartesian coordinates of basis sites, as columns
+  Eigen::Matrix3Xd m_basis_cart;
+};
+
 /// \brief Check if ClusterInvariants are equal
 bool almost_equal(ClusterInvariants const &A, ClusterInvariants const &B,
                   double tol);
@@ -64,6 +64,17 @@ CandidateSitesFunction cutoff_radius_neighborhood(
     IntegralCluster const &phenomenal, double cutoff_radius,
     bool include_phenomenal_sites = false);
 
+/// \brief Make cluster orbits, as specified by ClusterSpecs
+std::vector<std::set<IntegralCluster>> make_orbits(
+    ClusterSpecs const &cluster_specs, Index n_threads = 1);
+
+/// \brief Extend prim periodic cluster orbits to the max_length specified
+///     by ClusterSpecs
+std::vector<std::set<IntegralCluster>> extend_orbits(
+    std::vector<std::set<IntegralCluster>> const &prev_orbits,
+    std::vector<double> const &prev_max_length,
+    ClusterSpecs const &cluster_specs);
+
 }  // namespace clust
 }  // namespace CASM
 
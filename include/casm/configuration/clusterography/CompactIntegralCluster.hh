@@ -0,0 +1,108 @@
+#ifndef CASM_clust_CompactIntegralCluster
+#define CASM_clust_CompactIntegralCluster
+
+#include <array>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "casm/configuration/clusterography/definitions.hh"
+#include "casm/misc/Comparisons.hh"
+
+namespace CASM {
+namespace clust {
+
+/// \brief A fixed-capacity IntegralCluster, without heap allocation
+///
+/// Sites are stored as packed int32 (i, j, k, b) values in a fixed size
+/// array, for clusters of up to `max_size` sites. CompactIntegralCluster
+/// can be copied, compared, and hashed without allocating, so it is useful
+/// for holding many small clusters, for example as keys of hash sets or as
+/// orbits in flat sorted vectors.
+///
+/// Notes:
+/// - Comparison is consistent with IntegralCluster: if
+///   `A < B` for IntegralCluster, then `CompactIntegralCluster(A) <
+///   CompactIntegralCluster(B)`. So, the clusters of a
+///   `std::set<IntegralCluster>` orbit, converted in order, form a sorted
+///   `std::vector<CompactIntegralCluster>`.
+/// - Constructing from an IntegralCluster throws if it has more than
+///   `max_size` sites, or if a unit cell or sublattice index does not fit
+///   in int32.
+class CompactIntegralCluster
+    : public Comparisons<CRTPBase<CompactIntegralCluster>> {
+ public:
+  /// \brief Maximum number of sites
+  static constexpr Index max_size = 8;
+
+  /// \brief Construct an empty cluster
+  CompactIntegralCluster();
+
+  /// \brief Construct from an IntegralCluster
+  explicit CompactIntegralCluster(IntegralCluster const &cluster);
+
+  /// \brief Number of sites in the cluster
+  Index size() const { return m_size; }
+
+  /// \brief Return the i-th site
+  xtal::UnitCellCoord element(Index i) const;
+
+  /// \brief Sublattice index of the i-th site
+  Index sublattice(Index i) const { return m_data[4 * i + 3]; }
+
+  /// \brief Packed (i, j, k, b) values, `4 * size()` in total
+  std::int32_t const *data() const { return m_data.data(); }
+
+  /// \brief Convert to IntegralCluster
+  IntegralCluster to_integral_cluster() const;
+
+  /// \brief Sort sites, as IntegralCluster::sort
+  CompactIntegralCluster &sort();
+
+  /// \brief Translate the cluster by a UnitCell translation
+  CompactIntegralCluster &operator+=(xtal::UnitCell const &trans);
+
+  /// \brief Translate the cluster by a UnitCell translation
+  CompactIntegralCluster &operator-=(xtal::UnitCell const &trans);
+
+  /// \brief Compare as IntegralCluster: by size, then lexicographically
+  ///     by site
+  bool operator<(CompactIntegralCluster const &B) const;
+
+ private:
+  friend struct Comparisons<CRTPBase<CompactIntegralCluster>>;
+
+  bool eq_impl(CompactIntegralCluster const &B) const;
+
+  /// \brief Number of sites
+  std::int32_t m_size;
+
+  /// \brief Packed (i, j, k, b) values of each site, with unused values 0
+  std::array<std::int32_t, 4 * max_size> m_data;
+};
+
+/// \brief Hash for CompactIntegralCluster, consistent with
+///     CompactIntegralCluster::operator==
+struct CompactIntegralClusterHash {
+  std::size_t operator()(CompactIntegralCluster const &cluster) const;
+};
+
+/// \brief Convert an orbit of IntegralCluster to a sorted vector of
+///     CompactIntegralCluster
+std::vector<CompactIntegralCluster> make_compact_orbit(
+    std::set<IntegralCluster> const &orbit);
+
+/// \brief Convert orbits of IntegralCluster to sorted vectors of
+///     CompactIntegralCluster
+std::vector<std::vector<CompactIntegralCluster>> make_compact_orbits(
+    std::vector<std::set<IntegralCluster>> const &orbits);
+
+/// \brief Convert a vector of CompactIntegralCluster to an orbit of
+///     IntegralCluster
+std::set<IntegralCluster> make_integral_cluster_orbit(
+    std::vector<CompactIntegralCluster> const &compact_orbit);
+
+}  // namespace clust
+}  // namespace CASM
+
+#endif
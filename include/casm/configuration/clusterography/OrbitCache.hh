@@ -0,0 +1,99 @@
+#ifndef CASM_clust_OrbitCache
+#define CASM_clust_OrbitCache
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "casm/configuration/clusterography/definitions.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+namespace clust {
+
+/// \brief Make a string that uniquely specifies the orbits generated
+///     by ClusterSpecs, or std::nullopt if the site filter is custom
+std::optional<std::string> make_orbit_cache_key(
+    ClusterSpecs const &cluster_specs);
+
+/// \brief Make a hexadecimal hash of an orbit cache key
+std::string make_orbit_cache_hash(std::string const &key);
+
+/// \brief Cache of cluster orbits, keyed by the contents of ClusterSpecs
+///
+/// Orbits are generated once for each distinct ClusterSpecs, as
+/// determined by `make_orbit_cache_key`, and shared as immutable
+/// orbit vectors by all later requests.
+///
+/// Notes:
+/// - The key includes the prim, the generating group elements,
+///   `site_filter_method`, the branch specs, the custom generators, and the
+///   local-cluster parameters. ClusterSpecs with a `site_filter_method`
+///   other than "dof_sites", "alloy_sites", or "all_sites" may have a
+///   custom `site_filter`, so their orbits are generated without caching.
+/// - If a cache directory is set, orbits are also written to
+///   `<cache_dir>/<hash>.orbits`, in the compact cluster binary format (see
+///   ClusterBinaryReader), and mapped from there when not in memory. The
+///   full key is stored in the file and checked when reading, so hash
+///   collisions and stale files only result in re-generating orbits.
+/// - Orbits held in memory are cleared if the memory budget is exceeded
+///   after evicting other caches (see `config::enforce_memory_budget`).
+/// - Thread-safe. Orbits are generated outside of the lock, so concurrent
+///   requests for the same new key may each generate the orbits, and the
+///   first stored result is returned to all.
+class OrbitCache {
+ public:
+  typedef std::vector<std::set<IntegralCluster>> orbits_type;
+
+  OrbitCache(std::optional<fs::path> _cache_dir = std::nullopt);
+
+  /// \brief Return cluster orbits, as specified by ClusterSpecs
+  std::shared_ptr<orbits_type const> make_orbits(
+      ClusterSpecs const &cluster_specs, Index n_threads = 1);
+
+  /// \brief Directory for orbit files, or std::nullopt for memory only
+  std::optional<fs::path> cache_dir() const;
+
+  /// \brief Set the directory for orbit files, or std::nullopt for memory
+  ///     only
+  void set_cache_dir(std::optional<fs::path> _cache_dir);
+
+  /// \brief Number of orbit vectors held in memory
+  Index size() const;
+
+  /// \brief Memory used by orbits held in memory, in bytes (approximate)
+  Index total_bytes() const;
+
+  /// \brief Clear orbits held in memory, leaving any orbit files
+  void clear();
+
+ private:
+  std::shared_ptr<orbits_type const> _read(
+      fs::path const &cache_dir, std::string const &key,
+      ClusterSpecs const &cluster_specs) const;
+
+  void _write(fs::path const &cache_dir, std::string const &key,
+              ClusterSpecs const &cluster_specs,
+              orbits_type const &orbits) const;
+
+  mutable std::mutex m_mutex;
+
+  std::optional<fs::path> m_cache_dir;
+
+  std::map<std::string, std::shared_ptr<orbits_type const>> m_orbits;
+
+  Index m_total_bytes;
+};
+
+/// \brief Process-wide OrbitCache, memory only unless a cache directory
+///     is set
+OrbitCache &default_orbit_cache();
+
+}  // namespace clust
+}  // namespace CASM
+
+#endif
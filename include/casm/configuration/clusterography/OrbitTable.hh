@@ -0,0 +1,113 @@
+#ifndef CASM_clust_OrbitTable
+#define CASM_clust_OrbitTable
+
+#include <set>
+#include <vector>
+
+#include "casm/configuration/clusterography/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clust {
+
+/// \brief Orbits of IntegralCluster in compressed sparse row (CSR) form
+///
+/// All cluster sites are held in one contiguous array, in order of orbit
+/// and then cluster, with offsets giving the range of each cluster and
+/// each orbit:
+/// - Sites of cluster `c` are rows `[cluster_offsets(c),
+///   cluster_offsets(c+1))` of `sites`
+/// - Clusters of orbit `o` are `[orbit_offsets(o), orbit_offsets(o+1))`
+///
+/// When made from `std::vector<std::set<IntegralCluster>>` the order of
+/// orbits, clusters, and sites is preserved, so conversion back to orbits
+/// gives the original value.
+struct OrbitTable {
+  typedef Eigen::Matrix<long, Eigen::Dynamic, 4, Eigen::RowMajor>
+      site_matrix_type;
+
+  OrbitTable();
+
+  /// \brief Cluster sites, as rows of (b, i, j, k)
+  site_matrix_type sites;
+
+  /// \brief Offset of the first site of each cluster, with size
+  ///     `n_clusters() + 1`
+  Eigen::VectorXl cluster_offsets;
+
+  /// \brief Offset of the first cluster of each orbit, with size
+  ///     `n_orbits() + 1`
+  Eigen::VectorXl orbit_offsets;
+
+  /// \brief Number of orbits
+  Index n_orbits() const { return orbit_offsets.size() - 1; }
+
+  /// \brief Total number of clusters, in all orbits
+  Index n_clusters() const { return cluster_offsets.size() - 1; }
+
+  /// \brief Number of clusters in orbit `o`
+  Index orbit_size(Index o) const {
+    return orbit_offsets(o + 1) - orbit_offsets(o);
+  }
+
+  /// \brief Number of sites in cluster `c`
+  Index cluster_size(Index c) const {
+    return cluster_offsets(c + 1) - cluster_offsets(c);
+  }
+
+  /// \brief Return cluster `c` as IntegralCluster
+  IntegralCluster cluster(Index c) const;
+};
+
+/// \brief Make an OrbitTable from orbits of IntegralCluster
+OrbitTable make_orbit_table(
+    std::vector<std::set<IntegralCluster>> const &orbits);
+
+/// \brief Convert an OrbitTable to orbits of IntegralCluster
+std::vector<std::set<IntegralCluster>> make_orbits(
+    OrbitTable const &orbit_table);
+
+/// \brief Orbits of clusters of linear site indices in a supercell, in
+///     compressed sparse row (CSR) form
+///
+/// Same layout as OrbitTable, with `sites(s)` the linear supercell site
+/// index of site `s`. Clusters and orbits are ordered as in the result of
+/// `make_orbits_as_indices`.
+struct OrbitIndexTable {
+  OrbitIndexTable();
+
+  /// \brief Cluster linear site indices
+  Eigen::VectorXl sites;
+
+  /// \brief Offset of the first site of each cluster, with size
+  ///     `n_clusters() + 1`
+  Eigen::VectorXl cluster_offsets;
+
+  /// \brief Offset of the first cluster of each orbit, with size
+  ///     `n_orbits() + 1`
+  Eigen::VectorXl orbit_offsets;
+
+  /// \brief Number of orbits
+  Index n_orbits() const { return orbit_offsets.size() - 1; }
+
+  /// \brief Total number of clusters, in all orbits
+  Index n_clusters() const { return cluster_offsets.size() - 1; }
+};
+
+/// \brief Make an OrbitIndexTable from orbits of linear site indices
+OrbitIndexTable make_orbit_index_table(
+    std::vector<std::set<std::set<Index>>> const &orbits_as_indices);
+
+/// \brief Make an OrbitIndexTable from an OrbitTable
+OrbitIndexTable make_orbit_index_table(
+    OrbitTable const &orbit_table,
+    xtal::UnitCellCoordIndexConverter const &converter);
+
+/// \brief Convert an OrbitIndexTable to orbits of linear site indices
+std::vector<std::set<std::set<Index>>> make_orbits_as_indices(
+    OrbitIndexTable const &orbit_index_table);
+
+}  // namespace clust
+}  // namespace CASM
+
+#endif
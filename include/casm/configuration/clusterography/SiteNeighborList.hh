@@ -0,0 +1,120 @@
+#ifndef CASM_clust_SiteNeighborList
+#define CASM_clust_SiteNeighborList
+
+#include <unordered_map>
+#include <vector>
+
+#include "casm/configuration/clusterography/definitions.hh"
+#include "casm/crystallography/Lattice.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+
+namespace CASM {
+namespace clust {
+
+/// \brief Sites within a cutoff distance of the sites in the origin unit
+///     cell of a prim, with distances and distance shells
+///
+/// A SiteNeighborList is constructed once per prim, site filter, and
+/// maximum radius, and then used to generate candidate sites and check
+/// site-to-site distances when generating clusters, instead of computing
+/// coordinates and distances for each candidate.
+///
+/// Notes:
+/// - "Included" sites are those for which `site_filter` returns true.
+///   Neighbors are always included sites, but may be neighbors of any site
+///   in the origin unit cell.
+/// - Distances are computed the same way as in `max_length_neighborhood`,
+///   so `origin_neighborhood(radius)` gives the same sites in the same order
+///   as `max_length_neighborhood(radius)`
+/// - By translation symmetry, `distance` accepts sites in any unit cell
+///
+class SiteNeighborList {
+ public:
+  /// \brief A neighbor of a site in the origin unit cell
+  struct Neighbor {
+    /// \brief The neighboring site
+    xtal::UnitCellCoord site;
+
+    /// \brief Distance to the site in the origin unit cell
+    double distance;
+
+    /// \brief Index into `shells()` of `distance`
+    Index shell;
+  };
+
+  /// \brief Constructor
+  SiteNeighborList(xtal::BasicStructure const &prim, double max_radius,
+                   SiteFilterFunction site_filter);
+
+  /// \brief Maximum distance (exclusive) of stored neighbors
+  double max_radius() const;
+
+  /// \brief True if sites on sublattice `b` pass the site filter
+  bool is_included(Index b) const;
+
+  /// \brief Distinct neighbor distances, in ascending order, within the
+  ///     lattice tolerance
+  std::vector<double> const &shells() const;
+
+  /// \brief Neighbors of site {b, 0, 0, 0}, sorted by distance
+  std::vector<Neighbor> const &neighbors(Index b) const;
+
+  /// \brief Included sites within `radius` of any site in the origin unit
+  ///     cell
+  std::vector<xtal::UnitCellCoord> origin_neighborhood(double radius) const;
+
+  /// \brief Distance between two sites, or infinity if >= max_radius()
+  double distance(xtal::UnitCellCoord const &site_a,
+                  xtal::UnitCellCoord const &site_b) const;
+
+ private:
+  /// \brief Hash for the site neighbor lookup
+  struct UnitCellCoordHash {
+    std::size_t operator()(xtal::UnitCellCoord const &site) const;
+  };
+
+  /// \brief An entry of the origin unit cell neighborhood
+  struct NeighborhoodSite {
+    /// \brief The site
+    xtal::UnitCellCoord site;
+
+    /// \brief Lattice point the site was generated from
+    Eigen::Vector3i lattice_point;
+
+    /// \brief Distance to the nearest site in the origin unit cell
+    double min_distance;
+  };
+
+  /// \brief Lattice tolerance
+  double m_tol;
+
+  /// \brief Maximum distance (exclusive) of stored neighbors
+  double m_max_radius;
+
+  /// \brief Prim lattice, used to size neighborhoods as
+  ///     max_length_neighborhood does
+  xtal::Lattice m_lattice;
+
+  /// \brief True if sites on sublattice `b` pass the site filter
+  std::vector<bool> m_is_included;
+
+  /// \brief Distinct neighbor distances
+  std::vector<double> m_shells;
+
+  /// \brief Neighbors, by origin unit cell sublattice
+  std::vector<std::vector<Neighbor>> m_neighbors;
+
+  /// \brief Distance to neighbor, by origin unit cell sublattice
+  std::vector<std::unordered_map<xtal::UnitCellCoord, double,
+                                 UnitCellCoordHash>>
+      m_distance;
+
+  /// \brief Included sites near the origin unit cell, in the order
+  ///     max_length_neighborhood generates them
+  std::vector<NeighborhoodSite> m_neighborhood;
+};
+
+}  // namespace clust
+}  // namespace CASM
+
+#endif
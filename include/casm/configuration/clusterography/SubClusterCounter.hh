@@ -1,6 +1,10 @@
 #ifndef CASM_clust_SubClusterCounter
 #define CASM_clust_SubClusterCounter
 
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
 #include "casm/configuration/clusterography/IntegralCluster.hh"
 #include "casm/container/Counter.hh"
 
@@ -57,6 +61,121 @@ class SubClusterCounter {
   Counter<std::vector<int> > m_site_counter;
 };
 
+/// \brief Generates the subclusters of a cluster which are distinct under
+///     its cluster group, with their multiplicities
+///
+/// - Includes the null cluster and the original cluster
+/// - The cluster group is given by its site permutations, as from
+///   `make_prim_periodic_cluster_site_reps` or
+///   `make_local_cluster_site_reps`
+/// - One subcluster is generated for each orbit of subclusters under the
+///   cluster group, the first of the orbit in the order generated by
+///   SubClusterCounter
+/// - The multiplicity is the number of subclusters in the orbit, so the
+///   multiplicities sum to 2^n, for a cluster of n sites
+///
+/// Subclusters are compared as site index bit sets, so no IntegralCluster
+/// is constructed or transformed for subclusters which are not generated.
+class DistinctSubClusterCounter {
+ public:
+  /// \brief Construct with the cluster to find subclusters of, and the
+  ///     site permutations of its cluster group
+  DistinctSubClusterCounter(
+      IntegralCluster const &cluster,
+      std::vector<std::vector<Index> > const &cluster_site_reps)
+      : m_cluster(cluster),
+        m_site_reps(cluster_site_reps),
+        m_sites(0),
+        m_multiplicity(0) {
+    if (m_cluster.size() >= 63) {
+      throw std::runtime_error(
+          "Error in DistinctSubClusterCounter: cluster is too large");
+    }
+    m_end = (Bits(1) << m_cluster.size());
+    _find_distinct();
+  }
+
+  /// \brief Generate the next distinct subcluster (if valid)
+  void next() {
+    ++m_sites;
+    _find_distinct();
+  }
+
+  IntegralCluster const &value() const { return m_current; }
+
+  /// \brief Number of subclusters equivalent to the current subcluster
+  Index multiplicity() const { return m_multiplicity; }
+
+  bool valid() const { return m_sites < m_end; }
+
+ private:
+  typedef unsigned long long Bits;
+
+  /// \brief Return the image of the sites of a subcluster
+  Bits _apply(std::vector<Index> const &site_rep, Bits sites) const {
+    Bits image = 0;
+    for (Index i = 0; i < site_rep.size(); ++i) {
+      if (sites & (Bits(1) << i)) {
+        image |= (Bits(1) << site_rep[i]);
+      }
+    }
+    return image;
+  }
+
+  /// \brief Advance `m_sites` to the next subcluster which is the first
+  ///     of its orbit, and set the current value and multiplicity
+  void _find_distinct() {
+    std::vector<Bits> images;
+    for (; m_sites < m_end; ++m_sites) {
+      images.clear();
+      images.push_back(m_sites);
+      bool is_first = true;
+      for (auto const &site_rep : m_site_reps) {
+        Bits image = _apply(site_rep, m_sites);
+        if (image < m_sites) {
+          is_first = false;
+          break;
+        }
+        images.push_back(image);
+      }
+      if (is_first) {
+        break;
+      }
+    }
+    m_current.elements().clear();
+    if (!valid()) {
+      m_multiplicity = 0;
+      return;
+    }
+    std::sort(images.begin(), images.end());
+    m_multiplicity =
+        std::unique(images.begin(), images.end()) - images.begin();
+    for (Index i = 0; i < m_cluster.size(); ++i) {
+      if (m_sites & (Bits(1) << i)) {
+        m_current.elements().push_back(m_cluster.element(i));
+      }
+    }
+  }
+
+  /// the cluster we're finding subclusters of
+  IntegralCluster m_cluster;
+
+  /// Site permutations of the cluster group
+  std::vector<std::vector<Index> > m_site_reps;
+
+  /// The current subcluster
+  IntegralCluster m_current;
+
+  /// Sites included in the current subcluster, as bits
+  Bits m_sites;
+
+  /// One past the last subcluster, as bits
+  Bits m_end;
+
+  /// Number of subclusters equivalent to the current subcluster
+  Index m_multiplicity;
+};
+
 }  // namespace clust
 }  // namespace CASM
 
@@ -1,16 +1,15 @@
 #ifndef CASM_clust_impact_neighborhood
 #define CASM_clust_impact_neighborhood
 
+#include <cstdint>
 #include <set>
 #include <vector>
 
-namespace CASM {
-namespace xtal {
-class UnitCellCoord;
-}
+#include "casm/configuration/clusterography/definitions.hh"
+#include "casm/global/eigen.hh"
 
+namespace CASM {
 namespace clust {
-class IntegralCluster;
 
 /// \brief Using prim periodic translation symmetry, add all sites
 ///     that share a cluster with phenomenal sites to neighborhood
@@ -45,6 +44,96 @@ void add_to_local_neighborhood(
     std::set<xtal::UnitCellCoord> &neighborhood,
     std::vector<std::set<IntegralCluster>> const &orbits);
 
+/// \brief Using prim periodic translation symmetry, make the sorted sites
+///     that share a cluster with phenomenal sites
+std::vector<xtal::UnitCellCoord> make_flower_neighborhood(
+    IntegralCluster const &phenomenal,
+    std::vector<std::set<IntegralCluster>> const &orbits);
+
+/// \brief Make the sorted sites of all clusters in all orbits
+std::vector<xtal::UnitCellCoord> make_local_neighborhood(
+    std::vector<std::set<IntegralCluster>> const &orbits);
+
+/// \brief Flower neighborhoods of each site in the origin unit cell, in
+///     compressed sparse row (CSR) form
+///
+/// The flower neighborhood of site `{b, 0, 0, 0}`, the same sites as
+/// `add_to_flower_neighborhood` gives with that site as the phenomenal
+/// cluster, are rows `[offsets(b), offsets(b+1))` of `sites`, sorted. The
+/// neighborhood of site `{b, i, j, k}` is found by translating by
+/// `(i, j, k)`.
+struct NeighborhoodTable {
+  typedef Eigen::Matrix<long, Eigen::Dynamic, 4, Eigen::RowMajor>
+      site_matrix_type;
+
+  NeighborhoodTable();
+
+  /// \brief Neighborhood sites, as rows of (b, i, j, k)
+  site_matrix_type sites;
+
+  /// \brief Offset of the first site of the neighborhood of each
+  ///     sublattice, with size `n_sublattice() + 1`
+  Eigen::VectorXl offsets;
+
+  /// \brief Number of sublattices
+  Index n_sublattice() const { return offsets.size() - 1; }
+
+  /// \brief Number of sites in the neighborhood of sublattice `b`
+  Index neighborhood_size(Index b) const {
+    return offsets(b + 1) - offsets(b);
+  }
+};
+
+/// \brief Make the flower neighborhoods of each site in the origin unit cell
+NeighborhoodTable make_flower_neighborhood_table(
+    Index n_sublattice, std::vector<std::set<IntegralCluster>> const &orbits);
+
+/// \brief Neighborhoods of linear site indices in a supercell, in
+///     compressed sparse row (CSR) form
+///
+/// The sorted linear site indices of neighborhood `r` are
+/// `[neighbors.data() + offsets(r), neighbors.data() + offsets(r+1))`.
+/// When made from a NeighborhoodTable, neighborhood `l` is the neighborhood
+/// of supercell site `l`.
+struct SupercellNeighborhoodTable {
+  SupercellNeighborhoodTable();
+
+  /// \brief Neighborhood linear site indices
+  Eigen::Matrix<std::int32_t, Eigen::Dynamic, 1> neighbors;
+
+  /// \brief Offset of the first site of each neighborhood, with size
+  ///     `n_neighborhoods() + 1`
+  Eigen::VectorXl offsets;
+
+  /// \brief Number of neighborhoods
+  Index n_neighborhoods() const { return offsets.size() - 1; }
+
+  /// \brief Number of sites in neighborhood `r`
+  Index neighborhood_size(Index r) const {
+    return offsets(r + 1) - offsets(r);
+  }
+
+  /// \brief Pointer to the first site of neighborhood `r`
+  std::int32_t const *begin(Index r) const {
+    return neighbors.data() + offsets(r);
+  }
+
+  /// \brief Pointer past the last site of neighborhood `r`
+  std::int32_t const *end(Index r) const {
+    return neighbors.data() + offsets(r + 1);
+  }
+};
+
+/// \brief Make the neighborhood of each site in a supercell
+SupercellNeighborhoodTable make_supercell_neighborhood_table(
+    NeighborhoodTable const &neighborhood_table,
+    xtal::UnitCellCoordIndexConverter const &converter);
+
+/// \brief Make the neighborhoods of sites in a supercell
+SupercellNeighborhoodTable make_supercell_neighborhood_table(
+    std::vector<std::vector<xtal::UnitCellCoord>> const &neighborhoods,
+    xtal::UnitCellCoordIndexConverter const &converter);
+
 }  // namespace clust
 }  // namespace CASM
 
@@ -0,0 +1,151 @@
+#ifndef CASM_clust_Cluster_binary_io
+#define CASM_clust_Cluster_binary_io
+
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "casm/configuration/clusterography/definitions.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+
+namespace clust {
+struct EquivalentsInfo;
+}
+
+/// \brief Write cluster orbits in the compact cluster binary format
+void write_orbits_binary(
+    std::vector<std::set<clust::IntegralCluster>> const &orbits,
+    std::ostream &out, std::string const &key = "");
+
+/// \brief Write equivalents info in the compact cluster binary format
+void write_equivalents_info_binary(
+    clust::EquivalentsInfo const &equivalents_info, std::ostream &out,
+    std::string const &key = "");
+
+/// \brief Read cluster orbits from the compact cluster binary format
+std::vector<std::set<clust::IntegralCluster>> read_orbits_binary(
+    std::istream &in);
+
+/// \brief Read equivalents info from the compact cluster binary format
+clust::EquivalentsInfo read_equivalents_info_binary(std::istream &in);
+
+/// \brief Read cluster orbits or equivalents info in the compact cluster
+///     binary format, from a stream or a memory-mapped file
+///
+/// Binary format (integers are little-endian):
+/// - Header: magic "CASMCLST", version (unsigned 64-bit), kind (unsigned
+///   64-bit: 0 for orbits, 1 for equivalents info), key size (unsigned
+///   64-bit), key bytes
+/// - Counts: number of orbits, clusters, and sites (unsigned 64-bit each)
+/// - Orbit table: index of the first cluster of each orbit, and the number
+///   of clusters (unsigned 64-bit each)
+/// - Cluster table: index of the first site of each cluster, and the number
+///   of sites (unsigned 64-bit each)
+/// - Sites: sublattice index, and unit cell indices i, j, k (signed 32-bit
+///   each)
+/// - For equivalents info only: the generating operation index of each
+///   cluster (signed 64-bit)
+///
+/// Equivalents info is written as one orbit holding the phenomenal
+/// clusters, in order. The key is any string identifying the contents, such
+/// as the `make_orbit_cache_key` of the ClusterSpecs used to generate the
+/// orbits, so readers can check that a file holds what they expect.
+///
+/// Notes:
+/// - Clusters are read without a prim, and are not re-sorted
+/// - Construction reads only the header and counts and checks the tables.
+///   Clusters are decoded only when read, so reading one orbit of a mapped
+///   file only reads the pages holding it.
+/// - Files are mapped read-only and shared, so processes reading the same
+///   file, such as orbit generation and basis function generation, share
+///   one copy in the page cache
+/// - The file must not be modified while mapped
+class ClusterBinaryReader {
+ public:
+  /// \brief Constructor, reading a stream to its end
+  explicit ClusterBinaryReader(std::istream &in);
+
+  /// \brief Constructor, mapping a file
+  explicit ClusterBinaryReader(fs::path const &path);
+
+  /// \brief Unmaps the file, if mapped
+  ~ClusterBinaryReader();
+
+  ClusterBinaryReader(ClusterBinaryReader const &) = delete;
+  ClusterBinaryReader &operator=(ClusterBinaryReader const &) = delete;
+
+  /// \brief The key written with the contents
+  std::string const &key() const { return m_key; }
+
+  /// \brief True if the contents are equivalents info, false if orbits
+  bool is_equivalents_info() const { return m_is_equivalents_info; }
+
+  /// \brief Number of orbits
+  Index n_orbits() const { return m_n_orbits; }
+
+  /// \brief Number of clusters, in all orbits
+  Index n_clusters() const { return m_n_clusters; }
+
+  /// \brief Number of clusters in orbit i
+  Index orbit_size(Index i) const;
+
+  /// \brief Read cluster c, counting clusters in all orbits in order
+  clust::IntegralCluster cluster(Index c) const;
+
+  /// \brief Read orbit i
+  std::set<clust::IntegralCluster> orbit(Index i) const;
+
+  /// \brief Read all orbits
+  std::vector<std::set<clust::IntegralCluster>> orbits() const;
+
+  /// \brief Read equivalents info
+  clust::EquivalentsInfo equivalents_info() const;
+
+ private:
+  /// \brief Read the header and counts, and check the tables
+  void _parse();
+
+  /// \brief Entry i of the orbit table
+  Index _orbit_offset(Index i) const;
+
+  /// \brief Entry c of the cluster table
+  Index _cluster_offset(Index c) const;
+
+  /// Data read from a stream, if not mapped
+  std::vector<std::uint8_t> m_buffer;
+
+  /// Start of the mapped file, or null
+  void *m_mapped;
+
+  /// Start of the data
+  std::uint8_t const *m_data;
+
+  /// Size of the data
+  Index m_size;
+
+  std::string m_key;
+
+  bool m_is_equivalents_info;
+
+  Index m_n_orbits;
+
+  Index m_n_clusters;
+
+  Index m_n_sites;
+
+  /// Offsets of the orbit table, cluster table, sites, and operation
+  /// indices in the data
+  Index m_orbit_table;
+  Index m_cluster_table;
+  Index m_site_table;
+  Index m_op_table;
+};
+
+}  // namespace CASM
+
+#endif
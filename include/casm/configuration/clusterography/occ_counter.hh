@@ -3,6 +3,8 @@
 
 #include <vector>
 
+#include "casm/configuration/clusterography/definitions.hh"
+#include "casm/configuration/sym_info/definitions.hh"
 #include "casm/container/Counter.hh"
 
 namespace CASM {
@@ -17,6 +19,87 @@ class IntegralCluster;
 Counter<std::vector<int>> make_occ_counter(IntegralCluster const &cluster,
                                            xtal::BasicStructure const &prim);
 
+/// \brief Transforms cluster occupations, for one operation of a cluster
+///     group
+///
+/// Occupant `occ[i]` on cluster site `i` is transformed to occupant
+/// `occupant_rep[i][occ[i]]` on cluster site `site_rep[i]`.
+struct ClusterOccSymOpRep {
+  /// \brief Cluster site `i` is transformed to cluster site `site_rep[i]`
+  std::vector<Index> site_rep;
+
+  /// \brief Occupant index transformation, by cluster site before
+  ///     transformation
+  std::vector<sym_info::Permutation> occupant_rep;
+};
+
+/// \brief Make the representation of a cluster group that transforms
+///     cluster occupations
+std::vector<ClusterOccSymOpRep> make_cluster_occ_symgroup_rep(
+    IntegralCluster const &cluster, SymGroup const &cluster_group,
+    std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep,
+    sym_info::OccSymGroupRep const &occ_symgroup_rep);
+
+/// \brief Apply a cluster group operation to a cluster occupation
+std::vector<int> copy_apply(ClusterOccSymOpRep const &op,
+                            std::vector<int> const &occ);
+
+/// \brief Return true if a cluster occupation is the canonical element of
+///     its orbit under a cluster group
+bool is_canonical_occ(
+    std::vector<int> const &occ,
+    std::vector<ClusterOccSymOpRep> const &cluster_occ_symgroup_rep);
+
+/// \brief Counter over cluster occupations which are the canonical element
+///     of their orbit under a cluster group
+///
+/// Generates one occupation per orbit of cluster occupations, instead of
+/// every occupation as `make_occ_counter`. The canonical element is the
+/// greatest, as by `is_canonical_occ`.
+///
+/// Occupations are generated by assigning sites in order, and a partial
+/// occupation of sites `[0, k)` is not completed if any cluster group
+/// operation which maps sites `[0, k)` onto themselves gives a greater
+/// partial occupation, because every completion would then be
+/// non-canonical. Every operation maps all sites onto themselves, so
+/// complete occupations are compared with every cluster group operation.
+///
+/// Occupations are in the same order as generated by `make_occ_counter`,
+/// with the first site varying fastest.
+class CanonicalOccCounter {
+ public:
+  /// \brief Constructor
+  CanonicalOccCounter(
+      IntegralCluster const &cluster, xtal::BasicStructure const &prim,
+      std::vector<ClusterOccSymOpRep> const &cluster_occ_symgroup_rep);
+
+  /// \brief Return true if not finished
+  bool valid() const { return m_index < m_values.size(); }
+
+  /// \brief Advance to the next canonical occupation
+  CanonicalOccCounter &operator++() {
+    ++m_index;
+    return *this;
+  }
+
+  /// \brief The current canonical occupation
+  std::vector<int> const &operator()() const { return m_values[m_index]; }
+
+  /// \brief Reset to the first canonical occupation
+  void reset() { m_index = 0; }
+
+  /// \brief Number of canonical occupations
+  Index size() const { return m_values.size(); }
+
+  /// \brief All canonical occupations
+  std::vector<std::vector<int>> const &values() const { return m_values; }
+
+ private:
+  std::vector<std::vector<int>> m_values;
+
+  Index m_index;
+};
+
 }  // namespace clust
 }  // namespace CASM
 
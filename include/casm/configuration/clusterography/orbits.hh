@@ -5,6 +5,7 @@
 #include <set>
 #include <vector>
 
+#include "casm/configuration/ProgressMonitor.hh"
 #include "casm/configuration/clusterography/definitions.hh"
 #include "casm/global/eigen.hh"
 
@@ -17,6 +18,12 @@ class IntegralCluster;
 IntegralCluster prim_periodic_integral_cluster_copy_apply(
     xtal::UnitCellCoordRep const &op, IntegralCluster clust);
 
+/// \brief Write the result of applying a symmetry operation to a cluster,
+///     translation-normalized, into existing storage
+void prim_periodic_integral_cluster_apply_to(xtal::UnitCellCoordRep const &op,
+                                            IntegralCluster const &clust,
+                                            IntegralCluster &dest);
+
 /// \brief Find translation that leave cluster sites invariant after
 ///     transformation, up to a permutation
 xtal::UnitCell prim_periodic_integral_cluster_frac_translation(
@@ -84,8 +91,26 @@ std::shared_ptr<SymGroup const> make_cluster_group(
     Eigen::Matrix3d const &lat_column_mat,
     std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep);
 
+/// \brief Make the site permutations of the operations which leave a
+///     cluster invariant, with periodic symmetry of a prim
+std::vector<std::vector<Index>> make_prim_periodic_cluster_site_reps(
+    IntegralCluster const &cluster,
+    std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep);
+
 /// \brief Make orbits of clusters, with periodic symmetry of a prim
 std::vector<std::set<IntegralCluster>> make_prim_periodic_orbits(
+    std::shared_ptr<xtal::BasicStructure const> const &prim,
+    std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep,
+    SiteFilterFunction site_filter, std::vector<double> const &max_length,
+    std::vector<IntegralClusterOrbitGenerator> const &custom_generators,
+    Index n_threads = 1,
+    std::shared_ptr<config::ProgressMonitor> progress = nullptr);
+
+/// \brief Extend orbits of clusters, with periodic symmetry of a prim, to
+///     a larger max_length
+std::vector<std::set<IntegralCluster>> extend_prim_periodic_orbits(
+    std::vector<std::set<IntegralCluster>> const &prev_orbits,
+    std::vector<double> const &prev_max_length,
     std::shared_ptr<xtal::BasicStructure const> const &prim,
     std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep,
     SiteFilterFunction site_filter, std::vector<double> const &max_length,
@@ -114,6 +139,12 @@ struct EquivalentsInfo {
 IntegralCluster local_integral_cluster_copy_apply(
     xtal::UnitCellCoordRep const &op, IntegralCluster clust);
 
+/// \brief Write the result of applying a symmetry operation to a cluster,
+///     sorted, into existing storage
+void local_integral_cluster_apply_to(xtal::UnitCellCoordRep const &op,
+                                     IntegralCluster const &clust,
+                                     IntegralCluster &dest);
+
 /// \brief Make an orbit of local clusters
 std::set<IntegralCluster> make_local_orbit(
     IntegralCluster const &orbit_element,
@@ -138,6 +169,12 @@ std::vector<std::shared_ptr<SymGroup const>> make_local_cluster_groups(
     std::shared_ptr<SymGroup const> const &phenomenal_group,
     std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep);
 
+/// \brief Make the site permutations of the operations which leave a
+///     local cluster invariant
+std::vector<std::vector<Index>> make_local_cluster_site_reps(
+    IntegralCluster const &cluster,
+    std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep);
+
 /// \brief Make local-cluster orbits
 std::vector<std::set<IntegralCluster>> make_local_orbits(
     std::shared_ptr<xtal::BasicStructure const> const &prim,
@@ -147,6 +184,17 @@ std::vector<std::set<IntegralCluster>> make_local_orbits(
     IntegralCluster const &phenomenal, std::vector<double> const &cutoff_radius,
     bool include_phenomenal_sites = false);
 
+/// \brief Make local-cluster orbits for many phenomenal clusters
+std::vector<std::vector<std::set<IntegralCluster>>> make_local_orbits(
+    std::shared_ptr<xtal::BasicStructure const> const &prim,
+    std::vector<std::shared_ptr<SymGroup const>> const &cluster_groups,
+    SiteFilterFunction site_filter, std::vector<double> const &max_length,
+    std::vector<std::vector<IntegralClusterOrbitGenerator>> const
+        &custom_generators,
+    std::vector<IntegralCluster> const &phenomenal_clusters,
+    std::vector<double> const &cutoff_radius,
+    bool include_phenomenal_sites = false, Index n_threads = 1);
+
 }  // namespace clust
 }  // namespace CASM
 
@@ -1,8 +1,12 @@
 #ifndef CASM_config_config_space_analysis
 #define CASM_config_config_space_analysis
 
+#include <set>
+
 #include "casm/clexulator/DoFSpace.hh"
 #include "casm/configuration/Configuration.hh"
+#include "casm/configuration/DoFSpace_functions.hh"
+#include "casm/configuration/ProgressMonitor.hh"
 #include "casm/configuration/definitions.hh"
 
 namespace CASM {
@@ -24,12 +28,14 @@ struct ConfigSpaceAnalysisResults {
 
   /// \brief DoF values of all equivalent configurations in the
   ///     fully commensurate supercell, expressed in the basis of the
-  ///     standard DoF space, with key == input configuration identifier
+  ///     standard DoF space, with key == input configuration identifier.
+  ///     Empty if equivalents were not stored.
   std::map<std::string, std::vector<Eigen::VectorXd>> const
       equivalent_dof_values;
 
   /// \brief All equivalent configurations in the fully commensurate
-  ///     supercell, with key == input configuration identifier
+  ///     supercell, with key == input configuration identifier. Empty if
+  ///     equivalents were not stored.
   std::map<std::string, std::vector<Configuration>> const
       equivalent_configurations;
 
@@ -53,7 +59,182 @@ std::map<DoFKey, ConfigSpaceAnalysisResults> config_space_analysis(
         std::nullopt,
     std::optional<std::map<Index, int>> site_index_to_default_occ =
         std::nullopt,
-    double tol = TOL);
+    double tol = TOL, bool store_equivalents = true, Index batch_size = 256,
+    Index n_threads = 1, std::shared_ptr<ProgressMonitor> progress = nullptr);
+
+/// \brief Accumulate the config_space_analysis projector as configurations
+///     are added
+///
+/// The projector, P = sum x*x^T over the DoF values x of all equivalents
+/// of the added configurations, is held and updated by rank-k updates as
+/// configurations are added, and the eigendecomposition is only done when
+/// `results` is called. Adding configurations and then calling `results`
+/// gives the same results as `config_space_analysis` with all of the
+/// configurations, for one DoF type.
+///
+/// Example:
+/// \code
+/// ConfigSpaceAnalysisAccumulator accumulator(prim, "occ");
+/// accumulator.insert(initial_configurations);
+/// ConfigSpaceAnalysisResults r1 = accumulator.results();
+/// accumulator.insert(new_configurations);
+/// ConfigSpaceAnalysisResults r2 = accumulator.results();
+/// \endcode
+///
+/// Notes:
+/// - Configurations that are equivalent to a configuration already added
+///   are skipped
+/// - If an added configuration is not commensurate with the current fully
+///   commensurate supercell, the supercell grows and the projector is
+///   rebuilt from all added configurations. This is not allowed if
+///   `site_index_to_default_occ` is given, because it depends on the
+///   supercell, except for the first configurations added.
+class ConfigSpaceAnalysisAccumulator {
+ public:
+  /// \brief Constructor, with no configurations
+  ConfigSpaceAnalysisAccumulator(
+      std::shared_ptr<Prim const> const &prim, DoFKey const &dof_key,
+      std::optional<bool> exclude_homogeneous_modes = std::nullopt,
+      bool include_default_occ_modes = false,
+      std::optional<std::map<int, int>> sublattice_index_to_default_occ =
+          std::nullopt,
+      std::optional<std::map<Index, int>> site_index_to_default_occ =
+          std::nullopt,
+      double tol = TOL, bool store_equivalents = true, Index batch_size = 256,
+      Index n_threads = 1);
+
+  /// \brief Constructor, continuing from config_space_analysis results
+  ConfigSpaceAnalysisAccumulator(
+      ConfigSpaceAnalysisResults const &results,
+      std::optional<bool> exclude_homogeneous_modes = std::nullopt,
+      bool include_default_occ_modes = false,
+      std::optional<std::map<int, int>> sublattice_index_to_default_occ =
+          std::nullopt,
+      std::optional<std::map<Index, int>> site_index_to_default_occ =
+          std::nullopt,
+      double tol = TOL, bool store_equivalents = true, Index batch_size = 256,
+      Index n_threads = 1);
+
+  /// \brief Add configurations, return the number that were not equivalent
+  ///     to a configuration already added
+  Index insert(std::map<std::string, Configuration> const &configurations);
+
+  /// \brief The fully commensurate supercell of the added configurations
+  std::shared_ptr<Supercell const> const &supercell() const;
+
+  /// \brief Dimension of the standard DoF space
+  Index dim() const;
+
+  /// \brief Number of distinct primitive configurations added
+  Index n_prototypes() const;
+
+  /// \brief Make results, by eigendecomposition of the current projector
+  ConfigSpaceAnalysisResults results() const;
+
+ private:
+  /// \brief Set the supercell and standard DoF space, and rebuild the
+  ///     projector from all prototypes
+  void _rebuild(std::shared_ptr<Supercell const> const &supercell);
+
+  /// \brief Add the equivalents of one prototype to the projector
+  void _add(Configuration const &prim_config, std::string const &id);
+
+  std::shared_ptr<Prim const> m_prim;
+  DoFKey m_dof_key;
+  std::optional<bool> m_exclude_homogeneous_modes;
+  bool m_include_default_occ_modes;
+  std::optional<std::map<int, int>> m_sublattice_index_to_default_occ;
+  std::optional<std::map<Index, int>> m_site_index_to_default_occ;
+  double m_tol;
+  bool m_store_equivalents;
+  Index m_batch_size;
+  Index m_n_threads;
+
+  /// Primitive, canonical configuration -> ID
+  std::map<Configuration, std::string> m_prim_configs;
+
+  /// IDs of m_prim_configs
+  std::set<std::string> m_ids;
+
+  /// Superlattices of m_prim_configs
+  std::set<xtal::Lattice> m_lattices;
+
+  std::shared_ptr<Supercell const> m_supercell;
+
+  SparseDoFSpace m_dof_space;
+
+  /// Lower triangle of the projector
+  Eigen::MatrixXd m_P_lower;
+
+  std::map<std::string, std::vector<Eigen::VectorXd>> m_equivalent_dof_values;
+
+  std::map<std::string, std::vector<Configuration>>
+      m_equivalent_configurations;
+};
+
+/// \brief Projector and symmetry adapted axes of a config space at one
+///     k-point
+struct ConfigSpaceKPoint {
+  /// \brief k-point, as `numerator / denominator`, fractional with respect
+  ///     to the prim reciprocal lattice vectors, with `0 <= numerator(i) <
+  ///     denominator` and the fraction in lowest terms
+  Eigen::Vector3l numerator;
+
+  Index denominator;
+
+  /// \brief Projection matrix, in the basis of the standard DoF space for
+  ///     this k-point
+  Eigen::MatrixXcd projector;
+
+  /// \brief Non-zero eigenvalues of projector
+  Eigen::VectorXd eigenvalues;
+
+  /// \brief Eigenvectors of projector with non-zero eigenvalues, as columns
+  Eigen::MatrixXcd eigenvectors;
+
+  /// \brief Return true if this is k = 0
+  bool is_zero() const { return denominator == 1; }
+};
+
+struct ConfigSpaceKPointAnalysisResults {
+  ConfigSpaceKPointAnalysisResults(
+      clexulator::DoFSpace const &_standard_dof_space,
+      clexulator::DoFSpace const &_standard_dof_space_k0,
+      std::vector<ConfigSpaceKPoint> _kpoints);
+
+  /// \brief Standard DoF space of the prim unit cell, may exclude default
+  ///     occupation modes, depending on method options. Used for k != 0.
+  clexulator::DoFSpace const standard_dof_space;
+
+  /// \brief Standard DoF space of the prim unit cell used for k = 0, may
+  ///     also exclude homogeneous modes, depending on method options
+  clexulator::DoFSpace const standard_dof_space_k0;
+
+  /// \brief The k-points with a non-null symmetry adapted config space,
+  ///     sorted by numerator and then denominator
+  std::vector<ConfigSpaceKPoint> const kpoints;
+
+  /// \brief Dimension of the symmetry adapted config space
+  Index dim() const;
+};
+
+/// \brief Construct symmetry adapted bases, by k-point, in the DoF space
+///    spanned by the set of configurations symmetrically equivalent to the
+///    input configurations
+std::map<DoFKey, ConfigSpaceKPointAnalysisResults> config_space_kpoint_analysis(
+    std::map<std::string, Configuration> const &configurations,
+    std::optional<std::vector<DoFKey>> dofs = std::nullopt,
+    std::optional<bool> exclude_homogeneous_modes = std::nullopt,
+    bool include_default_occ_modes = false,
+    std::optional<std::map<int, int>> sublattice_index_to_default_occ =
+        std::nullopt,
+    double tol = TOL, std::shared_ptr<ProgressMonitor> progress = nullptr);
+
+/// \brief Return the symmetry adapted config space of k-point analysis
+///     results in a supercell
+clexulator::DoFSpace make_kpoint_symmetry_adapted_dof_space(
+    ConfigSpaceKPointAnalysisResults const &results,
+    std::shared_ptr<Supercell const> const &supercell, double tol = TOL);
 
 }  // namespace config
 }  // namespace CASM
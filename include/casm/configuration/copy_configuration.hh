@@ -1,14 +1,24 @@
 #ifndef CASM_config_copy_configuration
 #define CASM_config_copy_configuration
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "casm/configuration/definitions.hh"
 #include "casm/crystallography/UnitCellCoord.hh"
 
 namespace CASM {
 namespace config {
 
+class SupercellSet;
+
 struct Configuration;
 struct ConfigurationWithProperties;
+struct OccConfiguration;
 struct Supercell;
 
 /// \brief Copy configuration DoF values into a supercell
@@ -24,6 +34,114 @@ Configuration copy_configuration(
     std::shared_ptr<Supercell const> const &supercell,
     UnitCell const &origin = UnitCell(0, 0, 0));
 
+/// \brief Site index map used to copy configuration DoF values from a motif
+///     supercell into a supercell
+///
+/// A ConfigurationCopyMap stores, for each site in the new supercell, the
+/// motif site it is copied from, and the motif sublattice, so that copying
+/// is a gather of occupation values and local DoF columns instead of two
+/// UnitCellCoord conversions per site and DoF type.
+///
+/// Usage:
+/// \code
+/// std::shared_ptr<ConfigurationCopyMap const> copy_map =
+///     make_configuration_copy_map(motif.supercell, supercell);
+/// Configuration new_config = copy_map->copy(motif);
+/// \endcode
+///
+/// Notes:
+/// - `copy_configuration` uses maps from `make_configuration_copy_map`,
+///   which holds recently used maps in a process-wide cache.
+/// - A ConfigurationCopyMap does not keep the supercells alive, so that
+///   cached maps do not hold on to supercells and their symmetry info.
+///   Copying after the new supercell is destroyed is an error.
+class ConfigurationCopyMap {
+ public:
+  /// \brief Constructor, for copying without transformation
+  ConfigurationCopyMap(std::shared_ptr<Supercell const> const &_motif_supercell,
+                       std::shared_ptr<Supercell const> const &_supercell,
+                       UnitCell const &origin = UnitCell(0, 0, 0));
+
+  /// \brief Constructor, for copying with a prim factor group operation and
+  ///     translation
+  ConfigurationCopyMap(Index _prim_factor_group_index, UnitCell translation,
+                       std::shared_ptr<Supercell const> const &_motif_supercell,
+                       std::shared_ptr<Supercell const> const &_supercell,
+                       UnitCell const &origin = UnitCell(0, 0, 0));
+
+  /// \brief Copy DoF values of a configuration in the motif supercell
+  Configuration copy(Configuration const &motif) const;
+
+  /// \brief Copy local property values, as for local DoF values
+  std::map<std::string, Eigen::MatrixXd> copy_local_properties(
+      std::map<std::string, Eigen::MatrixXd> const &local_properties) const;
+
+  /// \brief Copy and transform global values, with the representation
+  ///     used for global DoF values
+  std::map<std::string, Eigen::VectorXd> copy_global_properties(
+      std::map<std::string, Eigen::VectorXd> const &global_properties) const;
+
+  /// \brief The motif supercell, or nullptr if it no longer exists
+  std::shared_ptr<Supercell const> motif_supercell() const {
+    return m_motif_supercell.lock();
+  }
+
+  /// \brief The new supercell, or nullptr if it no longer exists
+  std::shared_ptr<Supercell const> supercell() const {
+    return m_supercell.lock();
+  }
+
+  /// \brief The prim factor group operation, or std::nullopt if copying
+  ///     without transformation
+  std::optional<Index> prim_factor_group_index() const {
+    return m_prim_factor_group_index;
+  }
+
+  /// \brief Motif site index copied onto each site of the new supercell
+  std::vector<Index> const &motif_site_index() const {
+    return m_motif_site_index;
+  }
+
+  /// \brief Motif sublattice index of `motif_site_index()`
+  std::vector<Index> const &motif_sublattice() const {
+    return m_motif_sublattice;
+  }
+
+ private:
+  /// \brief Copy local values, transformed using the local DoF
+  ///     representation for `name` if there is a prim factor group operation
+  Eigen::MatrixXd _copy_local(std::string const &name,
+                              Eigen::MatrixXd const &M_motif) const;
+
+  std::shared_ptr<Prim const> m_prim;
+
+  std::weak_ptr<Supercell const> m_motif_supercell;
+
+  std::weak_ptr<Supercell const> m_supercell;
+
+  std::optional<Index> m_prim_factor_group_index;
+
+  std::vector<Index> m_motif_site_index;
+
+  std::vector<Index> m_motif_sublattice;
+};
+
+/// \brief Return a ConfigurationCopyMap, from a process-wide cache of
+///     recently used maps
+std::shared_ptr<ConfigurationCopyMap const> make_configuration_copy_map(
+    std::shared_ptr<Supercell const> const &motif_supercell,
+    std::shared_ptr<Supercell const> const &supercell,
+    UnitCell const &origin = UnitCell(0, 0, 0));
+
+/// \brief Return a ConfigurationCopyMap, for copying with a prim factor
+///     group operation and translation, from a process-wide cache of
+///     recently used maps
+std::shared_ptr<ConfigurationCopyMap const> make_configuration_copy_map(
+    Index prim_factor_group_index, UnitCell translation,
+    std::shared_ptr<Supercell const> const &motif_supercell,
+    std::shared_ptr<Supercell const> const &supercell,
+    UnitCell const &origin = UnitCell(0, 0, 0));
+
 /// \brief Copy configuration DoF values and properties into a supercell
 ConfigurationWithProperties copy_configuration_with_properties(
     ConfigurationWithProperties const &motif_with_properties,
@@ -49,7 +167,7 @@ std::set<Index> unique_generating_prim_factor_group_indices(
 /// group that fill a supercell
 std::vector<Configuration> make_all_super_configurations(
     Configuration const &motif,
-    std::shared_ptr<Supercell const> const &supercell);
+    std::shared_ptr<Supercell const> const &supercell, Index n_threads = 1);
 
 /// \brief Make all equivalent configurations with respect to the prim factor
 /// group that fill a supercell, sorted by subsets of equivalents generated by
@@ -57,7 +175,16 @@ std::vector<Configuration> make_all_super_configurations(
 std::vector<std::vector<Configuration>>
 make_all_super_configurations_by_subsets(
     Configuration const &motif,
-    std::shared_ptr<Supercell const> const &supercell);
+    std::shared_ptr<Supercell const> const &supercell, Index n_threads = 1);
+
+/// \brief Call `f(subset_index, subset)` for each subset of
+///     `make_all_super_configurations_by_subsets`, in order, making subsets
+///     in parallel
+Index for_each_super_configuration_subset(
+    Configuration const &motif,
+    std::shared_ptr<Supercell const> const &supercell,
+    std::function<void(Index, std::vector<Configuration> &)> f,
+    Index n_threads = 1);
 
 /// \brief Make configurations that fill a supercell and are equivalent with
 /// respect to the prim factor group, but distinct by supercell factor group
@@ -66,6 +193,12 @@ std::vector<Configuration> make_distinct_super_configurations(
     Configuration const &motif,
     std::shared_ptr<Supercell const> const &supercell);
 
+/// \brief Make the distinct configurations, in canonical form, that fill a
+/// supercell and are equivalent with respect to the prim factor group
+std::vector<Configuration> make_canonical_super_configurations(
+    Configuration const &motif,
+    std::shared_ptr<Supercell const> const &supercell);
+
 /// \brief Make all equivalent configurations with respect to the prim factor
 /// group that fill a supercell
 std::vector<ConfigurationWithProperties> make_all_super_configurations(
@@ -91,6 +224,15 @@ std::vector<ConfigurationWithProperties> make_distinct_super_configurations(
 ///     same configuration
 bool is_primitive(Configuration const &configuration);
 
+/// \brief Return true if no translations within the supercell result in the
+///     same occupation
+bool is_primitive(OccConfiguration const &configuration);
+
+/// \brief Return the unit cell indices of the translations within the
+///     supercell that leave a configuration invariant
+std::vector<Index> make_invariant_translations(
+    Configuration const &configuration);
+
 /// \brief Return the primitive configuration
 Configuration make_primitive(Configuration const &configuration);
 
@@ -99,6 +241,16 @@ Configuration make_primitive(Configuration const &configuration);
 ConfigurationWithProperties make_primitive(
     ConfigurationWithProperties const &configuration_with_properties);
 
+/// \brief Return the canonical form of a configuration, found by filling
+///     its supercell with its primitive configuration
+Configuration make_canonical_form_via_primitive(
+    Configuration const &configuration, Configuration const &primitive);
+
+/// \brief Return the canonical form of a configuration, found by filling
+///     its supercell with its primitive configuration
+Configuration make_canonical_form_via_primitive(
+    Configuration const &configuration);
+
 /// \brief Return a prim factor group index that transforms a supercell to an
 ///     a particular equivalent supercell
 Index prim_factor_group_index_to_supercell(
@@ -113,6 +265,24 @@ Configuration make_in_canonical_supercell(Configuration const &configuration);
 ConfigurationWithProperties make_in_canonical_supercell(
     ConfigurationWithProperties const &configuration_with_properties);
 
+/// \brief Return the canonical configuration in the canonical supercell,
+///     using and updating a SupercellSet
+Configuration make_in_canonical_supercell(Configuration const &configuration,
+                                          SupercellSet &supercells);
+
+/// \brief Transform a configuration with properties so that it has the
+///     canonical configuration in the canonical supercell, using and updating
+///     a SupercellSet
+ConfigurationWithProperties make_in_canonical_supercell(
+    ConfigurationWithProperties const &configuration_with_properties,
+    SupercellSet &supercells);
+
+/// \brief Return the canonical configurations in the canonical supercells,
+///     using and updating a SupercellSet
+std::vector<Configuration> make_in_canonical_supercell(
+    std::vector<Configuration> const &configurations,
+    SupercellSet &supercells);
+
 }  // namespace config
 }  // namespace CASM
 
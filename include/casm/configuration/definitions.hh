@@ -18,7 +18,7 @@
 //          ConfigDoFValues &dof_values)`;
 //   - `ConfigDoFValues copy_apply(
 //          SupercellOpIterator const &op,
-//          ConfigDoFValues dof_values);`
+//          ConfigDoFValues const &dof_values);`
 // - Methods for comparing configurations and finding canonical forms:
 //  - `class ConfigCompare`: Provides "less than" comparison of Configuration
 //  - `class ConfigIsEquivalent`: Provides "equal to" comparison of
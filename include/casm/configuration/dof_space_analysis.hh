@@ -3,6 +3,8 @@
 
 #include "casm/clexulator/DoFSpace.hh"
 #include "casm/configuration/Configuration.hh"
+#include "casm/configuration/DoFSpace_functions.hh"
+#include "casm/configuration/SupercellSymOp.hh"
 #include "casm/configuration/irreps/VectorSpaceSymReport.hh"
 
 namespace CASM {
@@ -43,7 +45,29 @@ DoFSpaceAnalysisResults dof_space_analysis(
         std::nullopt,
     std::optional<std::map<Index, int>> site_index_to_default_occ =
         std::nullopt,
-    bool calc_wedges = false, std::optional<Log> log = std::nullopt);
+    bool calc_wedges = false, std::optional<Log> log = std::nullopt,
+    bool use_character_projection = false, bool use_kstar_blocks = false,
+    Index n_threads = 1);
+
+/// \brief Symmetry analysis of a SparseDoFSpace
+DoFSpaceAnalysisResults dof_space_analysis(
+    SparseDoFSpace const &dof_space, std::shared_ptr<Prim const> prim,
+    std::optional<Configuration> configuration = std::nullopt,
+    std::optional<bool> exclude_homogeneous_modes = std::nullopt,
+    bool include_default_occ_modes = false,
+    std::optional<std::map<int, int>> sublattice_index_to_default_occ =
+        std::nullopt,
+    std::optional<std::map<Index, int>> site_index_to_default_occ =
+        std::nullopt,
+    bool calc_wedges = false, std::optional<Log> log = std::nullopt,
+    bool use_character_projection = false, bool use_kstar_blocks = false,
+    Index n_threads = 1);
+
+/// \brief Decompose a local DoF space into components for each star of
+///     k-points commensurate with the superlattice
+std::vector<Eigen::MatrixXd> make_kstar_subspaces(
+    clexulator::DoFSpace const &dof_space, Supercell const &supercell,
+    std::vector<SupercellSymOp> const &group);
 
 }  // namespace config
 }  // namespace CASM
@@ -0,0 +1,134 @@
+#ifndef CASM_config_enum_BatchPrefetcher
+#define CASM_config_enum_BatchPrefetcher
+
+#include <exception>
+#include <functional>
+#include <thread>
+
+#include "casm/configuration/definitions.hh"
+#include "casm/configuration/enumeration/BoundedQueue.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Produce batches on a background thread, ahead of the consumer
+///
+/// A dedicated thread calls `produce` repeatedly, holding up to
+/// `n_batches_ahead` batches that have not yet been taken by `next`, so
+/// that the consumer's work on one batch overlaps with producing the
+/// following batches. Batches are returned by `next` in the order they
+/// were produced.
+///
+/// Usage:
+/// \code
+/// ConfigEnumAllOccupations enumerator(background, sites);
+/// BatchPrefetcher<std::vector<Configuration>> prefetcher(
+///     [&](std::vector<Configuration> &batch) {
+///       if (!enumerator.is_valid()) {
+///         return false;
+///       }
+///       batch = enumerator.next_batch(1000);
+///       return true;
+///     },
+///     4);
+/// std::vector<Configuration> batch;
+/// while (prefetcher.next(batch)) {
+///   // use batch, while the following batches are enumerated
+/// }
+/// \endcode
+///
+/// Notes:
+/// - `produce` runs on the background thread, so anything it uses (for
+///   example, an enumerator) must not be used by other threads until the
+///   prefetcher is stopped or complete
+/// - If `produce` throws, the exception is rethrown by `next` after the
+///   batches produced before it are returned
+/// - Destroying the prefetcher, or calling `stop`, stops the background
+///   thread after the batch in progress, and discards unused batches
+template <typename BatchType>
+class BatchPrefetcher {
+ public:
+  /// \brief Set `batch` to the next batch and return true, or return false
+  ///     when there are no more batches
+  typedef std::function<bool(BatchType &batch)> ProducerFunction;
+
+  /// \brief Constructor, starts the background thread
+  ///
+  /// \param _produce Produces the batches, in order
+  /// \param _n_batches_ahead Maximum number of batches produced but not yet
+  ///     taken by `next`. Values < 1 are treated as 1.
+  BatchPrefetcher(ProducerFunction _produce, Index _n_batches_ahead)
+      : m_produce(std::move(_produce)),
+        m_queue(_n_batches_ahead),
+        m_thread(&BatchPrefetcher::_run, this) {}
+
+  BatchPrefetcher(BatchPrefetcher const &) = delete;
+  BatchPrefetcher &operator=(BatchPrefetcher const &) = delete;
+
+  ~BatchPrefetcher() { stop(); }
+
+  /// \brief Maximum number of batches produced but not yet taken
+  Index n_batches_ahead() const { return m_queue.capacity(); }
+
+  /// \brief Set `batch` to the next batch, blocking until it is produced
+  ///
+  /// \returns False, without setting `batch`, when there are no more
+  ///     batches
+  ///
+  /// \throws The exception thrown by `produce`, if it threw, once the
+  ///     batches produced before it have been returned
+  bool next(BatchType &batch) {
+    if (m_queue.pop(batch)) {
+      return true;
+    }
+    // the queue is closed after m_error is set
+    if (m_error) {
+      std::exception_ptr error = m_error;
+      m_error = nullptr;
+      std::rethrow_exception(error);
+    }
+    return false;
+  }
+
+  /// \brief Stop the background thread and discard unused batches
+  ///
+  /// Blocks until the batch in progress, if any, is complete. After
+  /// `stop`, `next` returns false.
+  void stop() {
+    m_queue.close();
+    m_queue.clear();
+    if (m_thread.joinable()) {
+      m_thread.join();
+    }
+    m_error = nullptr;
+  }
+
+ private:
+  void _run() {
+    try {
+      while (true) {
+        BatchType batch;
+        if (!m_produce(batch) || !m_queue.push(std::move(batch))) {
+          break;
+        }
+      }
+    } catch (...) {
+      m_error = std::current_exception();
+    }
+    m_queue.close();
+  }
+
+  ProducerFunction m_produce;
+
+  BoundedQueue<BatchType> m_queue;
+
+  /// Set by the background thread before closing m_queue
+  std::exception_ptr m_error;
+
+  std::thread m_thread;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
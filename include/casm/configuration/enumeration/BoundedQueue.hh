@@ -0,0 +1,104 @@
+#ifndef CASM_config_enum_BoundedQueue
+#define CASM_config_enum_BoundedQueue
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief A first-in, first-out queue with a maximum size, for passing
+///     values between threads
+///
+/// `push` blocks while the queue is full and `pop` blocks while it is
+/// empty. After `close`, `push` fails and `pop` returns the remaining
+/// values and then fails, so consumers finish once producers are done.
+///
+/// Notes:
+/// - All member functions are safe to call concurrently
+/// - Threads that block on a BoundedQueue should be dedicated threads, not
+///   tasks of the process-wide thread pool (see `run_on_thread_pool`),
+///   which could otherwise deadlock waiting for each other
+template <typename T>
+class BoundedQueue {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _capacity Maximum number of values held. Values < 1 are treated
+  ///     as 1.
+  explicit BoundedQueue(Index _capacity)
+      : m_capacity(_capacity < 1 ? 1 : _capacity), m_closed(false) {}
+
+  /// \brief Maximum number of values held
+  Index capacity() const { return m_capacity; }
+
+  /// \brief Add a value, blocking while the queue is full
+  ///
+  /// \returns False, without adding the value, if the queue is closed
+  bool push(T value) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_not_full.wait(lock, [&] {
+      return m_closed || Index(m_data.size()) < m_capacity;
+    });
+    if (m_closed) {
+      return false;
+    }
+    m_data.push_back(std::move(value));
+    lock.unlock();
+    m_not_empty.notify_one();
+    return true;
+  }
+
+  /// \brief Remove the oldest value, blocking while the queue is empty and
+  ///     not closed
+  ///
+  /// \returns False, without setting `value`, if the queue is closed and
+  ///     empty
+  bool pop(T &value) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_not_empty.wait(lock, [&] { return m_closed || !m_data.empty(); });
+    if (m_data.empty()) {
+      return false;
+    }
+    value = std::move(m_data.front());
+    m_data.pop_front();
+    lock.unlock();
+    m_not_full.notify_one();
+    return true;
+  }
+
+  /// \brief Stop accepting values and wake all waiting threads
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_closed = true;
+    }
+    m_not_full.notify_all();
+    m_not_empty.notify_all();
+  }
+
+  /// \brief Remove all values
+  void clear() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_data.clear();
+    }
+    m_not_full.notify_all();
+  }
+
+ private:
+  Index m_capacity;
+  bool m_closed;
+  std::deque<T> m_data;
+  std::mutex m_mutex;
+  std::condition_variable m_not_full;
+  std::condition_variable m_not_empty;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
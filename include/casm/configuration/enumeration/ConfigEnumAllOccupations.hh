@@ -1,12 +1,21 @@
 #ifndef CASM_config_enum_ConfigEnumAllOccupations
 #define CASM_config_enum_ConfigEnumAllOccupations
 
+#include <memory>
+#include <optional>
+
+#include "casm/configuration/CanonicalWitnessList.hh"
 #include "casm/configuration/Configuration.hh"
+#include "casm/configuration/SupercellSymOp.hh"
 #include "casm/container/Counter.hh"
 
 namespace CASM {
 namespace config {
 
+class OccCanonicalizer;
+class OccupationStabilizerChain;
+struct ConfigurationFilter;
+
 /// Enumerate over all possible occupations on particular sites in a
 /// Configuration
 ///
@@ -25,6 +34,41 @@ namespace config {
 /// }
 /// \endcode
 ///
+/// Alternately, the enumerator can skip non-primitive configurations,
+/// configurations that are not canonical with respect to a subgroup, and
+/// configurations rejected by a ConfigurationFilter, so that only the
+/// remaining configurations are visited:
+/// \code
+/// std::vector<SupercellSymOp> subgroup =
+///     make_invariant_subgroup(background, sites, begin, end);
+/// ConfigEnumAllOccupations enumerator(background, sites, true, subgroup);
+/// while (enumerator.is_valid()) {
+///   std::vector<Configuration> batch = enumerator.next_batch(1000);
+///   ...
+/// }
+/// \endcode
+///
+/// Canonical checks try the operations that most recently showed a value
+/// was not canonical first (see CanonicalWitnessList), because consecutive
+/// values often share a witness, so most non-canonical values are rejected
+/// after one or two comparisons.
+///
+/// The invariant subgroup of each value can be obtained with
+/// `invariant_subgroup()`. It is refined incrementally from the invariant
+/// subgroups of the slowest varying sites (see OccupationStabilizerChain),
+/// which are re-used while enumerating the faster varying sites, so the
+/// cost is small compared to `make_invariant_subgroup`.
+///
+/// An enumeration can be checkpointed by saving `state()`, and resumed by
+/// constructing an enumerator with the same arguments and calling
+/// `resume(state)`.
+///
+/// An enumeration can be split across processes by constructing enumerators
+/// with the same arguments and each `shard_index` in `[0, n_shards)`. Each
+/// shard visits a contiguous range of the occupation counter, in order, so
+/// the shards together visit each value once, in the same order as a single
+/// enumerator when taken in order of `shard_index`.
+///
 class ConfigEnumAllOccupations {
  public:
   /// \brief Constructor
@@ -37,6 +81,14 @@ class ConfigEnumAllOccupations {
   ConfigEnumAllOccupations(Configuration const &background,
                            std::set<Index> const &sites);
 
+  /// \brief Constructor, skipping filtered configurations
+  ConfigEnumAllOccupations(
+      Configuration const &background, std::set<Index> const &sites,
+      bool skip_non_primitive,
+      std::optional<std::vector<SupercellSymOp>> canonical_subgroup,
+      std::shared_ptr<ConfigurationFilter const> filter = nullptr,
+      Index shard_index = 0, Index n_shards = 1);
+
   /// \brief Get the current Configuration
   Configuration const &value() const;
 
@@ -46,7 +98,48 @@ class ConfigEnumAllOccupations {
   /// \brief Return true if `value` is valid, false if no more valid values
   bool is_valid() const;
 
+  /// \brief Return up to `max_size` Configuration, starting with the current
+  ///     value, and advance past them
+  std::vector<Configuration> next_batch(Index max_size);
+
+  /// \brief Return the occupation on `sites` of the current value, which
+  ///     may be used to resume the enumeration
+  std::vector<int> const &state() const;
+
+  /// \brief Set the current value to a state previously returned by
+  ///     `state`
+  void resume(std::vector<int> const &state);
+
+  /// \brief Return the operations that leave the current value invariant
+  std::vector<SupercellSymOp> invariant_subgroup();
+
+  /// \brief Return the number of operations that leave the current value
+  ///     invariant
+  Index invariant_subgroup_size();
+
+  /// \brief Recent witnesses of non-canonical values, by index into the
+  ///     canonical subgroup
+  CanonicalWitnessList const &recent_witnesses() const;
+
  private:
+  /// \brief Return true if m_current passes all filters
+  bool _is_allowed();
+
+  /// \brief Advance m_counter until m_current passes all filters, or the
+  ///     enumeration is complete
+  void _skip_not_allowed();
+
+  /// \brief Restrict the enumeration to a shard of the counter range, and
+  ///     advance m_counter to the beginning of the shard
+  void _begin_shard(Index shard_index, Index n_shards);
+
+  /// \brief Index of the current value of the shard prefix
+  Index _prefix_index() const;
+
+  /// \brief Increment m_counter, and return true if the result is valid
+  ///     and in the shard
+  bool _increment();
+
   /// The current configuration
   Configuration m_current;
 
@@ -55,6 +148,38 @@ class ConfigEnumAllOccupations {
 
   /// Counter over allowed occupation indices on sites in m_sites
   Counter<std::vector<int> > m_counter;
+
+  /// If true, skip non-primitive configurations
+  bool m_skip_non_primitive;
+
+  /// If has value, skip configurations that are not canonical with respect
+  /// to this group
+  std::optional<std::vector<SupercellSymOp>> m_canonical_subgroup;
+
+  /// If not null, skip configurations for which `(*m_filter)(configuration)`
+  /// is false
+  std::shared_ptr<ConfigurationFilter const> m_filter;
+
+  /// Used for canonical checks if the prim has occupation DoF only
+  std::shared_ptr<OccCanonicalizer> m_canonicalizer;
+
+  /// Recent witnesses of non-canonical values, tried first by canonical
+  /// checks
+  CanonicalWitnessList m_recent_witnesses;
+
+  /// Constructed on first use by `invariant_subgroup`
+  std::shared_ptr<OccupationStabilizerChain> m_stabilizer_chain;
+
+  /// Number of occupation values, for each of the last sites in m_sites,
+  /// which vary slowest in m_counter and determine the shard. Empty if not
+  /// sharded.
+  std::vector<Index> m_prefix_size;
+
+  /// The shard includes values with `_prefix_index() < m_shard_end`
+  Index m_shard_end;
+
+  /// True if m_counter has passed the end of the shard
+  bool m_shard_finished;
 };
 
 }  // namespace config
@@ -0,0 +1,207 @@
+#ifndef CASM_config_enum_ConfigEnumCanonicalOccupations
+#define CASM_config_enum_ConfigEnumCanonicalOccupations
+
+#include <limits>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Bounds on the number of sites, amongst a set of sites, with a
+///     particular occupant
+///
+/// Example, fixing the number of "B" on sublattice 0 of `supercell` to 2:
+/// \code
+/// OccupantCountConstraint constraint;
+/// constraint.occupant_name = "B";
+/// for (Index l = 0; l < n_sites; ++l) {
+///   if (supercell->unitcellcoord_index_converter(l).sublattice() == 0) {
+///     constraint.site_indices.insert(l);
+///   }
+/// }
+/// constraint.min_count = constraint.max_count = 2;
+/// \endcode
+struct OccupantCountConstraint {
+  /// \brief Name of the occupant being counted, as given by
+  ///     `xtal::Molecule::name()`
+  std::string occupant_name;
+
+  /// \brief Linear site indices on which the occupant is counted
+  std::set<Index> site_indices;
+
+  /// \brief Minimum allowed count
+  Index min_count = 0;
+
+  /// \brief Maximum allowed count
+  Index max_count = std::numeric_limits<Index>::max();
+};
+
+/// Enumerate occupations on particular sites in a Configuration which are
+/// canonical with respect to a group, without generating most non-canonical
+/// occupations
+///
+/// The result is the same as using ConfigEnumAllOccupations and skipping
+/// configurations for which `is_canonical(configuration, group.begin(),
+/// group.end())` is false, but the enumeration order may differ.
+///
+/// Method (orderly generation):
+/// - Occupants are assigned to `sites` one at a time, in increasing site
+///   index order, with sites not in `sites` fixed to the background values
+/// - After each assignment, for each group operation, the transformed
+///   occupation is compared to the partial occupation on the leading sites
+///   on which both are known. If the transformed occupation is greater, no
+///   completion of the partial occupation can be canonical, and the branch is
+///   pruned. Operations for which the transformed occupation is found to be
+///   lesser are not checked again in that branch.
+/// - Complete occupations that survive pruning are checked with
+///   `is_canonical` only if continuous DoF may affect the result
+///
+/// Occupant count constraints:
+/// - Optionally, only occupations that satisfy a set of
+///   OccupantCountConstraint (for example, a fixed composition on each
+///   sublattice) are enumerated
+/// - After each assignment, partial occupations for which a constraint is
+///   already violated, or cannot be satisfied by the remaining sites, are
+///   pruned. With per-sublattice or total count constraints this walks only
+///   the permutations of the allowed occupant multisets.
+/// - If `group` is empty, all occupations satisfying the constraints are
+///   enumerated
+///
+/// Notes:
+/// - Configurations compare global DoF before occupation, so pruning only
+///   uses operations that leave the background global DoF values invariant.
+///   All operations are used in the final check.
+/// - An appropriate group is the subgroup that leaves the background
+///   configuration invariant and does not mix `sites` and other sites (see
+///   `make_invariant_subgroup`)
+/// - An enumeration can be checkpointed by saving `state()`, and resumed by
+///   constructing an enumerator with the same arguments and calling
+///   `resume(state)`.
+///
+/// Example:
+/// \code
+/// std::vector<SupercellSymOp> group =
+///     make_invariant_subgroup(background, sites, begin, end);
+/// ConfigEnumCanonicalOccupations enumerator(background, sites, group);
+/// while (enumerator.is_valid()) {
+///   configurations.insert(enumerator.value());
+///   enumerator.advance();
+/// }
+/// \endcode
+///
+class ConfigEnumCanonicalOccupations {
+ public:
+  /// \brief Constructor
+  ConfigEnumCanonicalOccupations(Configuration const &background,
+                                 std::set<Index> const &sites,
+                                 std::vector<SupercellSymOp> const &group,
+                                 bool skip_non_primitive = false,
+                                 std::vector<OccupantCountConstraint> const
+                                     &occupant_count_constraints = {});
+
+  /// \brief Get the current Configuration
+  Configuration const &value() const;
+
+  /// \brief Generate the next Configuration
+  void advance();
+
+  /// \brief Return true if `value` is valid, false if no more valid values
+  bool is_valid() const;
+
+  /// \brief Return up to `max_size` Configuration, starting with the current
+  ///     value, and advance past them
+  std::vector<Configuration> next_batch(Index max_size);
+
+  /// \brief Return the occupation on `sites` of the current value, which
+  ///     may be used to resume the enumeration
+  std::vector<int> const &state() const;
+
+  /// \brief Set the current value to a state previously returned by
+  ///     `state`
+  void resume(std::vector<int> const &state);
+
+ private:
+  /// Status of an operation used for pruning: the operation index and the
+  /// first site at which the transformed occupation has not yet been found
+  /// equal to the current occupation
+  typedef std::pair<Index, Index> OpStatus;
+
+  /// \brief Find the next complete occupation, starting by incrementing the
+  ///     occupant on m_sites[k]
+  bool _search(Index k);
+
+  /// \brief Make m_undecided[k + 1] from m_undecided[k]; return false if
+  ///     the current partial occupation cannot be canonical
+  bool _update(Index k);
+
+  /// \brief Compare transformed and current occupation on known sites
+  int _compare(OpStatus &status) const;
+
+  /// \brief Final checks on a complete occupation
+  bool _is_allowed_leaf() const;
+
+  /// \brief Update constraint counts to assign m_value[k] to m_sites[k]
+  void _count_assign(Index k, int sign);
+
+  /// \brief Return true if constraints on m_sites[k] may still be satisfied
+  bool _is_feasible(Index k) const;
+
+  /// The current configuration
+  Configuration m_current;
+
+  /// Site indices to enumerate on, in increasing order
+  std::vector<Index> m_sites;
+
+  /// Maximum occupant index, by index into m_sites
+  std::vector<int> m_max_occupation;
+
+  /// Current occupant index, by index into m_sites, or -1 if not assigned
+  std::vector<int> m_value;
+
+  /// 1 if the occupant on a site is known, by supercell site index
+  std::vector<char> m_is_known;
+
+  /// All operations, for the final check
+  std::vector<SupercellSymOp> m_group;
+
+  /// Combined site permutation, for each operation used for pruning
+  std::vector<sym_info::Permutation> m_permute;
+
+  /// Prim factor group index, for each operation used for pruning
+  std::vector<Index> m_prim_factor_group_index;
+
+  /// Sublattice index, by supercell site index
+  std::vector<Index> m_sublattice;
+
+  /// Undecided operations, after assigning the first k sites
+  std::vector<std::vector<OpStatus>> m_undecided;
+
+  /// Occupant count constraints
+  std::vector<OccupantCountConstraint> m_constraints;
+
+  /// Current count on known sites, by constraint
+  std::vector<Index> m_count;
+
+  /// Number of unknown sites that may have the counted occupant, by
+  /// constraint
+  std::vector<Index> m_n_possible;
+
+  /// (constraint index, counted occupant index), by index into m_sites
+  std::vector<std::vector<std::pair<Index, int>>> m_site_constraints;
+
+  /// If true, check is_canonical on complete occupations
+  bool m_check_leaf_canonical;
+
+  /// If true, skip non-primitive configurations
+  bool m_skip_non_primitive;
+
+  /// True if m_current is valid
+  bool m_is_valid;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
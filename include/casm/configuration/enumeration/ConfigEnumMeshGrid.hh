@@ -0,0 +1,149 @@
+#ifndef CASM_config_enum_ConfigEnumMeshGrid
+#define CASM_config_enum_ConfigEnumMeshGrid
+
+#include <string>
+#include <vector>
+
+#include "casm/clexulator/DoFSpace.hh"
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/irreps/IrrepWedge.hh"
+#include "casm/container/Counter.hh"
+
+namespace CASM {
+namespace config {
+
+/// Enumerate configurations with continuous DoF values on a mesh grid of
+/// DoFSpace coordinates, or on a mesh grid in each SubWedge of an
+/// irreducible wedge
+///
+/// DoF values are an affine function of the DoFSpace coordinates, so they
+/// are found for each point by a matrix-vector product, and for a batch of
+/// points by one matrix-matrix product, instead of by calling
+/// `set_dof_space_values` for each point.
+///
+/// Example:
+/// \code
+/// Configuration background = ...;
+/// clexulator::DoFSpace dof_space = ...;
+/// std::vector<irreps::SubWedge> irreducible_wedge = ...;
+/// ConfigEnumMeshGrid enumerator(background, dof_space, irreducible_wedge,
+///                               0.1, 11);
+/// while (enumerator.is_valid()) {
+///   std::vector<Configuration> batch = enumerator.next_batch(1000);
+///   ...
+/// }
+/// \endcode
+///
+/// Notes:
+/// - Occupation DoFSpace are not supported.
+/// - Points are visited in the order of a Counter over grid indices, grid
+///   after grid, the same as `libcasm.enumerate.irreducible_wedge_points`.
+class ConfigEnumMeshGrid {
+ public:
+  /// \brief Constructor, enumerate on a mesh grid of DoFSpace coordinates
+  ConfigEnumMeshGrid(Configuration const &background,
+                     clexulator::DoFSpace const &dof_space,
+                     std::vector<Eigen::VectorXd> const &xi);
+
+  /// \brief Constructor, enumerate on a mesh grid in each SubWedge of an
+  ///     irreducible wedge
+  ConfigEnumMeshGrid(Configuration const &background,
+                     clexulator::DoFSpace const &dof_space,
+                     std::vector<irreps::SubWedge> const &irreducible_wedge,
+                     double stop, Index num, bool trim_corners = true,
+                     double abs_tol = TOL);
+
+  /// \brief Get the current Configuration
+  Configuration const &value() const;
+
+  /// \brief Get the DoFSpace coordinates of the current Configuration
+  Eigen::VectorXd const &order_parameters() const;
+
+  /// \brief Get the index of the SubWedge of the current Configuration
+  Index subwedge_index() const;
+
+  /// \brief Generate the next Configuration
+  void advance();
+
+  /// \brief Return true if `value` is valid, false if no more valid values
+  bool is_valid() const;
+
+  /// \brief Return up to `max_size` Configuration, starting with the current
+  ///     value, and advance past them
+  std::vector<Configuration> next_batch(Index max_size);
+
+  /// \brief Return up to `max_size` Configuration, starting with the current
+  ///     value, and advance past them, with their DoFSpace coordinates and
+  ///     SubWedge indices
+  std::vector<Configuration> next_batch(Index max_size,
+                                        Eigen::MatrixXd &order_parameters,
+                                        std::vector<Index> &subwedge_indices);
+
+ private:
+  /// A mesh grid, with DoFSpace coordinates `trans_mat * x`, where
+  /// `x(i)` is one of `xi[i]`
+  struct Grid {
+    std::vector<std::vector<double>> xi;
+    Eigen::MatrixXd trans_mat;
+  };
+
+  /// \brief Shared constructor implementation
+  void _init(clexulator::DoFSpace const &dof_space);
+
+  /// \brief Begin the grid `m_grid_index`, or later grids if it is empty
+  void _begin_grid();
+
+  /// \brief Advance to the next point that is not trimmed, or the end
+  void _advance_point();
+
+  /// \brief Set m_order_parameters for the current point of m_counter,
+  ///     return false if the point is trimmed
+  bool _set_point();
+
+  /// \brief Set the DoF values of `configuration` from DoFSpace
+  ///     coordinates
+  void _set_dof_values(Configuration &configuration,
+                       Eigen::VectorXd const &order_parameters) const;
+
+  /// The current configuration
+  Configuration m_current;
+
+  /// The DoF key
+  std::string m_dof_key;
+
+  /// True if m_dof_key is a global DoF
+  bool m_is_global;
+
+  /// DoF values, flattened, for DoFSpace coordinates of zero
+  Eigen::VectorXd m_offset;
+
+  /// Change in flattened DoF values per unit DoFSpace coordinate
+  Eigen::MatrixXd m_linear;
+
+  /// Grids enumerated, in order
+  std::vector<Grid> m_grids;
+
+  /// If true, skip points outside the ellipsoid inscribed within the
+  /// extrema of the grid, with semi-axes `m_stop`
+  bool m_trim_corners;
+
+  double m_stop;
+
+  double m_abs_tol;
+
+  /// Index of the current grid
+  Index m_grid_index;
+
+  /// Counter over grid indices for the current grid
+  Counter<std::vector<int>> m_counter;
+
+  /// DoFSpace coordinates of the current point
+  Eigen::VectorXd m_order_parameters;
+
+  bool m_is_valid;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef CASM_config_enum_ConfigEnumOccupationsGrayCode
+#define CASM_config_enum_ConfigEnumOccupationsGrayCode
+
+#include "casm/configuration/Configuration.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief A change of occupant on one site
+struct OccupationDelta {
+  /// \brief Linear site index of the site that changed, or -1 if none
+  Index site_index = -1;
+
+  /// \brief Occupant index before the change
+  int old_value = 0;
+
+  /// \brief Occupant index after the change
+  int new_value = 0;
+};
+
+/// Enumerate over all possible occupations on particular sites in a
+/// Configuration, in Gray code order
+///
+/// This visits the same occupations as ConfigEnumAllOccupations, in a
+/// reflected mixed-radix Gray code order, so that each `advance` changes the
+/// occupant on exactly one site, by one occupant index. The change is
+/// available from `last_change`, which allows properties of the current
+/// configuration (correlations, fingerprints, etc.) to be updated
+/// incrementally.
+///
+/// Example:
+/// \code
+/// Configuration background = ...;
+/// std::set<Index> sites = ...;
+/// ConfigEnumOccupationsGrayCode enumerator(background, sites);
+/// ... initialize from enumerator.value() ...
+/// enumerator.advance();
+/// while (enumerator.is_valid()) {
+///   OccupationDelta const &delta = enumerator.last_change();
+///   ... update using delta.site_index, delta.old_value, delta.new_value ...
+///   enumerator.advance();
+/// }
+/// \endcode
+///
+class ConfigEnumOccupationsGrayCode {
+ public:
+  /// \brief Constructor
+  ConfigEnumOccupationsGrayCode(Configuration const &background,
+                                std::set<Index> const &sites);
+
+  /// \brief Get the current Configuration
+  Configuration const &value() const;
+
+  /// \brief Generate the next Configuration, by changing one site
+  void advance();
+
+  /// \brief Return true if `value` is valid, false if no more valid values
+  bool is_valid() const;
+
+  /// \brief The change made by the last `advance`
+  OccupationDelta const &last_change() const;
+
+ private:
+  /// The current configuration
+  Configuration m_current;
+
+  /// Site index to enumerate on, in increasing order
+  std::vector<Index> m_sites;
+
+  /// Maximum occupant index, by index into m_sites
+  std::vector<int> m_max_occupation;
+
+  /// Current step direction (+1 or -1), by index into m_sites
+  std::vector<int> m_direction;
+
+  /// The change made by the last `advance`
+  OccupationDelta m_last_change;
+
+  /// True if m_current is valid
+  bool m_is_valid;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef CASM_config_enum_ConfigEnumRandomOccupations
+#define CASM_config_enum_ConfigEnumRandomOccupations
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+class OccCanonicalizer;
+
+/// \brief Exact number of each occupant on a set of sites
+///
+/// Example, half "A" and half "B" on sublattice 0 of a supercell with 8
+/// unit cells:
+/// \code
+/// SiteComposition composition =
+///     make_sublattice_composition(supercell, {0}, {{"A", 0.5}, {"B", 0.5}});
+/// // composition.occupant_counts == {{"A", 4}, {"B", 4}}
+/// \endcode
+struct SiteComposition {
+  /// \brief Linear site indices
+  std::set<Index> site_indices;
+
+  /// \brief Number of sites with each occupant, by occupant name as given by
+  ///     `xtal::Molecule::name()`. Counts must sum to the number of sites.
+  std::map<std::string, Index> occupant_counts;
+};
+
+/// \brief Make the SiteComposition of the sites on some sublattices, from
+///     occupant fractions
+SiteComposition make_sublattice_composition(
+    Supercell const &supercell, std::set<Index> const &sublattice_indices,
+    std::map<std::string, double> const &occupant_fractions);
+
+/// \brief Generate random, symmetrically distinct occupations at fixed
+///     composition
+///
+/// Each candidate occupation is a uniformly random arrangement of the
+/// occupants of each SiteComposition on its sites, with sites not in any
+/// SiteComposition fixed to the background values. Candidates are put in
+/// canonical form, with respect to all supercell operations, and kept only
+/// if not equivalent to a configuration already generated, so each
+/// generated configuration is symmetrically distinct.
+///
+/// Method:
+/// - Candidates are drawn and canonicalized in parallel. Candidate `i` uses
+///   a random number engine seeded by `(seed, i)`, so the generated
+///   configurations depend on `seed` but not on the number of threads.
+/// - Canonical forms are found with OccCanonicalizer, one per thread, if
+///   the prim has occupation DoF only, else with `make_canonical_form`
+/// - Duplicates are rejected by inserting the canonical forms, in candidate
+///   order, into an UnorderedConfigurationSet
+///
+/// Example:
+/// \code
+/// ConfigEnumRandomOccupations generator(background, compositions, seed);
+/// while (generator.n_unique() < 1000) {
+///   std::vector<Configuration> batch = generator.next_batch(100, 10000);
+///   if (batch.empty()) {
+///     break;  // few distinct configurations remain
+///   }
+///   ... use batch ...
+/// }
+/// \endcode
+///
+/// Notes:
+/// - Generated configurations are in the background supercell
+/// - To generate configurations that are distinct from previously
+///   generated configurations, use the same `seed` and `n_attempts` to
+///   resume with `set_n_attempts`, or call `insert` for each previously
+///   generated configuration
+class ConfigEnumRandomOccupations {
+ public:
+  /// \brief Constructor
+  ConfigEnumRandomOccupations(Configuration const &background,
+                              std::vector<SiteComposition> const &compositions,
+                              std::uint64_t seed = 0,
+                              bool skip_non_primitive = false,
+                              Index n_threads = 0);
+
+  ~ConfigEnumRandomOccupations();
+
+  /// \brief Return up to `max_size` new distinct configurations, in
+  ///     canonical form, drawing at most `max_attempts` candidates
+  std::vector<Configuration> next_batch(Index max_size, Index max_attempts);
+
+  /// \brief Make the candidate occupation with index `i`, before
+  ///     canonicalization
+  Configuration make_candidate(Index i) const;
+
+  /// \brief Mark a configuration as already generated, return true if it
+  ///     was not already
+  bool insert(Configuration const &configuration);
+
+  /// \brief The number of candidates drawn
+  Index n_attempts() const;
+
+  /// \brief Set the index of the next candidate drawn
+  void set_n_attempts(Index n_attempts);
+
+  /// \brief The number of candidates rejected because they were equivalent
+  ///     to a configuration already generated
+  Index n_duplicates() const;
+
+  /// \brief The number of candidates rejected because they were not
+  ///     primitive
+  Index n_non_primitive() const;
+
+  /// \brief The number of distinct configurations generated or inserted
+  Index n_unique() const;
+
+  /// \brief The distinct configurations generated or inserted, in canonical
+  ///     form
+  UnorderedConfigurationSet const &unique_configurations() const;
+
+ private:
+  /// \brief Make the canonical form of a candidate, using canonicalizer `c`
+  Configuration _make_canonical(Configuration const &candidate, Index c);
+
+  Configuration m_background;
+
+  /// Sites of each SiteComposition, in increasing order
+  std::vector<std::vector<Index>> m_sites;
+
+  /// Occupant label of each site, before shuffling, by SiteComposition
+  std::vector<std::vector<int>> m_labels;
+
+  /// Occupant index, by SiteComposition, site (as index into m_sites), and
+  /// occupant label
+  std::vector<std::vector<std::vector<int>>> m_occupant_index;
+
+  std::uint64_t m_seed;
+
+  bool m_skip_non_primitive;
+
+  Index m_n_threads;
+
+  /// One canonicalizer per thread, if the prim has occupation DoF only
+  std::vector<std::unique_ptr<OccCanonicalizer>> m_canonicalizers;
+
+  Index m_n_attempts;
+
+  Index m_n_duplicates;
+
+  Index m_n_non_primitive;
+
+  UnorderedConfigurationSet m_unique;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
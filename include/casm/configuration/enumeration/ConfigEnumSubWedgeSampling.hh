@@ -0,0 +1,248 @@
+#ifndef CASM_config_enum_ConfigEnumSubWedgeSampling
+#define CASM_config_enum_ConfigEnumSubWedgeSampling
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "casm/clexulator/DoFSpace.hh"
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/irreps/IrrepWedge.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Sobol low-discrepancy sequence in the unit hypercube
+///
+/// Uses the primitive polynomials and direction numbers of S. Joe and
+/// F. Y. Kuo, "Constructing Sobol sequences with better two-dimensional
+/// projections", SIAM J. Sci. Comput. 30, 2635-2654 (2008), for up to
+/// `max_dim()` dimensions, and Gray code ordering. The first point of the
+/// sequence, the origin, is skipped.
+class SobolSequence {
+ public:
+  /// \brief Constructor
+  explicit SobolSequence(Index _dim);
+
+  /// \brief Maximum supported dimension
+  static Index max_dim();
+
+  /// \brief Dimension
+  Index dim() const { return m_x.size(); }
+
+  /// \brief Number of points generated
+  std::uint64_t size() const { return m_index; }
+
+  /// \brief Return the next point
+  Eigen::VectorXd next();
+
+ private:
+  /// Direction numbers, by dimension
+  std::vector<std::vector<std::uint32_t>> m_directions;
+
+  /// Current point, scaled by 2^32
+  std::vector<std::uint32_t> m_x;
+
+  /// Number of points generated
+  std::uint64_t m_index;
+};
+
+/// \brief Method used to sample points by ConfigEnumSubWedgeSampling
+///
+/// - `sobol`: Sobol low-discrepancy sequence, for up to
+///   `SobolSequence::max_dim()` dimensions
+/// - `latin_hypercube`: Latin hypercube sampling, in any dimension
+/// - `uniform`: independent uniformly distributed points, in any dimension
+enum class SubWedgeSamplingMethod { sobol, latin_hypercube, uniform };
+
+/// \brief A box of SubWedge coordinates sampled by
+///     ConfigEnumSubWedgeSampling
+struct SubWedgeSamplingRegion {
+  /// \brief Index of the SubWedge
+  Index subwedge_index;
+
+  /// \brief Lower bounds of the SubWedge coordinates
+  Eigen::VectorXd lower;
+
+  /// \brief Upper bounds of the SubWedge coordinates
+  Eigen::VectorXd upper;
+
+  /// \brief Number of points to sample in the region
+  Index n_points;
+};
+
+/// Enumerate configurations with continuous DoF values on points sampled in
+/// each SubWedge of an irreducible wedge
+///
+/// ConfigEnumMeshGrid visits every point of a mesh grid in each SubWedge,
+/// so the number of points grows exponentially with dimension. This
+/// samples a fixed number of points instead, from a Sobol sequence, Latin
+/// hypercube, or uniform distribution, in the same coordinate ranges: along
+/// each SubWedge axis the range is [0, stop], unless the axis has symmetric
+/// multiplicity of 1, in which case it is [-stop, stop]. For adaptive
+/// refinement, a second constructor samples boxes centered on previously
+/// sampled points (for example, those with the largest model uncertainty)
+/// with a number of points for each, clipped to the same ranges, so that
+/// points stay in the SubWedge of the center.
+///
+/// Example:
+/// \code
+/// Configuration background = ...;
+/// clexulator::DoFSpace dof_space = ...;
+/// std::vector<irreps::SubWedge> irreducible_wedge = ...;
+/// ConfigEnumSubWedgeSampling enumerator(background, dof_space,
+///                                       irreducible_wedge, 0.1, 100);
+/// while (enumerator.is_valid()) {
+///   std::vector<Configuration> batch = enumerator.next_batch(1000);
+///   ...
+/// }
+/// \endcode
+///
+/// Notes:
+/// - Occupation DoFSpace are not supported.
+/// - DoF values are found as by ConfigEnumMeshGrid, using an affine map
+///   from DoFSpace coordinates, one matrix-matrix product per batch
+/// - With `trim_corners`, points outside the ellipsoid inscribed within the
+///   extrema of the coordinate ranges are rejected and others drawn
+///   instead, up to 1000 draws per point. For `latin_hypercube`, exactly
+///   `n_points` are drawn, so rejected points are not replaced.
+/// - Regions are sampled in order. For each region, the Sobol sequence
+///   starts over, and for the other methods a random number engine seeded
+///   with `seed` continues.
+class ConfigEnumSubWedgeSampling {
+ public:
+  /// \brief Constructor, sample points in each SubWedge of an irreducible
+  ///     wedge
+  ConfigEnumSubWedgeSampling(
+      Configuration const &background, clexulator::DoFSpace const &dof_space,
+      std::vector<irreps::SubWedge> const &irreducible_wedge, double stop,
+      Index n_points,
+      SubWedgeSamplingMethod method = SubWedgeSamplingMethod::sobol,
+      bool trim_corners = true, std::uint64_t seed = 0, double abs_tol = TOL);
+
+  /// \brief Constructor, sample points around previously sampled points
+  ConfigEnumSubWedgeSampling(
+      Configuration const &background, clexulator::DoFSpace const &dof_space,
+      std::vector<irreps::SubWedge> const &irreducible_wedge, double stop,
+      Eigen::MatrixXd const &centers,
+      std::vector<Index> const &center_subwedge_indices, double half_width,
+      std::vector<Index> const &n_points,
+      SubWedgeSamplingMethod method = SubWedgeSamplingMethod::sobol,
+      bool trim_corners = true, std::uint64_t seed = 0, double abs_tol = TOL);
+
+  /// \brief Get the current Configuration
+  Configuration const &value() const;
+
+  /// \brief Get the DoFSpace coordinates of the current Configuration
+  Eigen::VectorXd const &order_parameters() const;
+
+  /// \brief Get the index of the SubWedge of the current Configuration
+  Index subwedge_index() const;
+
+  /// \brief Generate the next Configuration
+  void advance();
+
+  /// \brief Return true if `value` is valid, false if no more valid values
+  bool is_valid() const;
+
+  /// \brief Return up to `max_size` Configuration, starting with the current
+  ///     value, and advance past them
+  std::vector<Configuration> next_batch(Index max_size);
+
+  /// \brief Return up to `max_size` Configuration, starting with the current
+  ///     value, and advance past them, with their DoFSpace coordinates and
+  ///     SubWedge indices
+  std::vector<Configuration> next_batch(Index max_size,
+                                        Eigen::MatrixXd &order_parameters,
+                                        std::vector<Index> &subwedge_indices);
+
+  /// \brief The regions sampled, in order
+  std::vector<SubWedgeSamplingRegion> const &regions() const;
+
+ private:
+  /// \brief Shared constructor implementation
+  void _init(clexulator::DoFSpace const &dof_space,
+             std::vector<irreps::SubWedge> const &irreducible_wedge,
+             double stop);
+
+  /// \brief Begin the region `m_region_index`, or later regions if no
+  ///     point is accepted
+  void _begin_region();
+
+  /// \brief Advance to the next accepted point, or the end
+  void _advance_point();
+
+  /// \brief Draw points in the current region until one is accepted, and
+  ///     set m_order_parameters, or return false if the region is done
+  bool _next_point_in_region();
+
+  /// \brief Set the DoF values of `configuration` from DoFSpace
+  ///     coordinates
+  void _set_dof_values(Configuration &configuration,
+                       Eigen::VectorXd const &order_parameters) const;
+
+  /// The current configuration
+  Configuration m_current;
+
+  /// The DoF key
+  std::string m_dof_key;
+
+  /// True if m_dof_key is a global DoF
+  bool m_is_global;
+
+  /// DoF values, flattened, for DoFSpace coordinates of zero
+  Eigen::VectorXd m_offset;
+
+  /// Change in flattened DoF values per unit DoFSpace coordinate
+  Eigen::MatrixXd m_linear;
+
+  /// DoFSpace coordinates per unit SubWedge coordinate, by SubWedge
+  std::vector<Eigen::MatrixXd> m_trans_mat;
+
+  /// Lower bounds of the SubWedge coordinates, by SubWedge
+  std::vector<Eigen::VectorXd> m_lower;
+
+  /// Upper bounds of the SubWedge coordinates, by SubWedge
+  std::vector<Eigen::VectorXd> m_upper;
+
+  /// Regions sampled, in order
+  std::vector<SubWedgeSamplingRegion> m_regions;
+
+  SubWedgeSamplingMethod m_method;
+
+  /// If true, reject points outside the ellipsoid inscribed within the
+  /// extrema of the SubWedge coordinate ranges, with semi-axes `m_stop`
+  bool m_trim_corners;
+
+  double m_stop;
+
+  double m_abs_tol;
+
+  std::mt19937_64 m_engine;
+
+  /// Index of the current region
+  Index m_region_index;
+
+  /// Sobol sequence for the current region
+  SobolSequence m_sobol;
+
+  /// Latin hypercube strata, by dimension, for the current region
+  std::vector<std::vector<Index>> m_strata;
+
+  /// Number of points drawn in the current region
+  Index m_n_drawn;
+
+  /// Number of points accepted in the current region
+  Index m_n_accepted;
+
+  /// DoFSpace coordinates of the current point
+  Eigen::VectorXd m_order_parameters;
+
+  bool m_is_valid;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -2,8 +2,17 @@
 #define CASM_config_enum_ConfigurationFilter
 
 #include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
 #include <vector>
 
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/definitions.hh"
+#include "casm/configuration/enumeration/ConfigEnumCanonicalOccupations.hh"
 #include "casm/misc/cloneable_ptr.hh"
 
 namespace CASM {
@@ -87,6 +96,165 @@ struct ChainedConfigurationFilter : public ConfigurationFilter {
   }
 };
 
+/// \brief Accepts configurations with a supercell volume in a range
+///
+/// Volume is the number of unit cells of the supercell.
+struct SupercellVolumeFilter : public ConfigurationFilter {
+  /// \brief Minimum allowed volume
+  Index min_volume = 1;
+
+  /// \brief Maximum allowed volume
+  Index max_volume = std::numeric_limits<Index>::max();
+
+  bool operator()(Configuration const &configuration) const override;
+
+  bool primitive_guarantee() const override { return false; }
+
+  bool canonical_guarantee() const override { return false; }
+};
+
+/// \brief Accepts configurations with the fraction of sites on a group of
+///     sublattices occupied by one occupant in a range
+///
+/// The fraction is the number of sites, on sublattices in
+/// `sublattice_indices`, occupied by `occupant_name`, divided by the
+/// number of sites on those sublattices (including sites that do not allow
+/// `occupant_name`). Bounds are inclusive, to within `TOL`.
+///
+/// Example, for 0.25 <= x <= 0.5 in A(1-x)B(x) on sublattice 0:
+/// \code
+/// SublatticeCompositionFilter filter;
+/// filter.sublattice_indices = {0};
+/// filter.occupant_name = "B";
+/// filter.min_fraction = 0.25;
+/// filter.max_fraction = 0.5;
+/// \endcode
+struct SublatticeCompositionFilter : public ConfigurationFilter {
+  /// \brief Sublattices on which the occupant is counted. If empty, all
+  ///     sublattices are used.
+  std::set<Index> sublattice_indices;
+
+  /// \brief Name of the occupant being counted, as given by
+  ///     `xtal::Molecule::name()`
+  std::string occupant_name;
+
+  /// \brief Minimum allowed fraction
+  double min_fraction = 0.0;
+
+  /// \brief Maximum allowed fraction
+  double max_fraction = 1.0;
+
+  bool operator()(Configuration const &configuration) const override;
+
+  bool primitive_guarantee() const override { return false; }
+
+  bool canonical_guarantee() const override { return false; }
+};
+
+/// \brief Accepts configurations, in one supercell, satisfying occupant
+///     count constraints
+///
+/// Sites that do not allow a constraint's occupant do not count towards
+/// it. The sites counted are found once, on construction. Throws if given
+/// a configuration in another supercell.
+class OccupantCountFilter : public ConfigurationFilter {
+ public:
+  /// \brief Constructor
+  OccupantCountFilter(std::shared_ptr<Supercell const> const &_supercell,
+                      std::vector<OccupantCountConstraint> const &_constraints);
+
+  bool operator()(Configuration const &configuration) const override;
+
+  bool primitive_guarantee() const override { return false; }
+
+  bool canonical_guarantee() const override { return false; }
+
+  /// \brief The supercell of the constraint site indices
+  std::shared_ptr<Supercell const> const &supercell() const;
+
+  /// \brief The constraints
+  std::vector<OccupantCountConstraint> const &constraints() const;
+
+ private:
+  std::shared_ptr<Supercell const> m_supercell;
+
+  std::vector<OccupantCountConstraint> m_constraints;
+
+  /// For each constraint, the (site index, occupant index) that count
+  std::vector<std::vector<std::pair<Index, int>>> m_counted;
+};
+
+/// \brief Accepts configurations with the number of clusters of an orbit,
+///     per unit cell, fully occupied by one occupant in a range
+///
+/// A cluster counts if every one of its sites is occupied by
+/// `occupant_name`. Clusters are counted as sets of supercell site
+/// indices, as given by `clust::make_orbits_as_indices` for all
+/// translations of the orbit within the supercell, so in small supercells
+/// periodic images that map onto the same sites are counted once. Bounds
+/// on the count per unit cell are inclusive, to within `TOL`.
+///
+/// The cluster site indices are found the first time a configuration in a
+/// particular supercell is checked, and shared by copies of the filter.
+/// Thread-safe.
+///
+/// Example, to accept configurations with no B-B nearest neighbor pairs:
+/// \code
+/// ClusterCountFilter filter(nn_pair_orbit, "B", 0.0, 0.0);
+/// \endcode
+class ClusterCountFilter : public ConfigurationFilter {
+ public:
+  /// \brief Constructor
+  ClusterCountFilter(
+      std::set<clust::IntegralCluster> const &_orbit,
+      std::string const &_occupant_name, double _min_per_unitcell = 0.0,
+      double _max_per_unitcell = std::numeric_limits<double>::max());
+
+  bool operator()(Configuration const &configuration) const override;
+
+  bool primitive_guarantee() const override { return false; }
+
+  bool canonical_guarantee() const override { return false; }
+
+  /// \brief The prim periodic orbit of clusters counted
+  std::set<clust::IntegralCluster> const &orbit() const;
+
+  /// \brief Name of the occupant
+  std::string const &occupant_name() const;
+
+  /// \brief Minimum allowed number of clusters per unit cell
+  double min_per_unitcell() const;
+
+  /// \brief Maximum allowed number of clusters per unit cell
+  double max_per_unitcell() const;
+
+ private:
+  /// Clusters that can count, as (site index, occupant index) for each site
+  typedef std::vector<std::vector<std::pair<Index, int>>> ClusterSites;
+
+  std::shared_ptr<ClusterSites const> _cluster_sites(
+      std::shared_ptr<Supercell const> const &supercell) const;
+
+  std::set<clust::IntegralCluster> m_orbit;
+
+  std::string m_occupant_name;
+
+  double m_min_per_unitcell;
+
+  double m_max_per_unitcell;
+
+  struct Cache {
+    std::mutex mutex;
+
+    /// Cluster sites, by supercell
+    std::map<std::shared_ptr<Supercell const>,
+             std::shared_ptr<ClusterSites const>>
+        cluster_sites;
+  };
+
+  std::shared_ptr<Cache> m_cache;
+};
+
 }  // namespace config
 }  // namespace CASM
 
@@ -0,0 +1,147 @@
+#ifndef CASM_config_enum_ConfigurationSink
+#define CASM_config_enum_ConfigurationSink
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+#include "casm/configuration/enumeration/EnumerationPipeline.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+
+class ConfigurationJsonLinesWriter;
+class ConfigurationSetBinaryWriter;
+
+namespace config {
+
+class ConfigurationSet;
+
+/// \brief Receives enumerated configurations, for example to store or write
+///     them
+///
+/// Configurations are given in batches, in enumeration order, by
+/// `insert`, and `finish` is called once after the last batch. Sinks are
+/// used by `run_enumeration_pipeline`, which calls them from one thread at a
+/// time.
+struct ConfigurationSink {
+  virtual ~ConfigurationSink() {}
+
+  /// \brief Receive a batch of configurations, in enumeration order
+  virtual void insert(std::vector<Configuration> &configurations) = 0;
+
+  /// \brief Complete storing or writing configurations
+  virtual void finish() {}
+
+  /// \brief Number of configurations stored or written
+  virtual Index size() const = 0;
+};
+
+/// \brief Insert configurations into a ConfigurationSet
+///
+/// Configurations already in the set are skipped, and `configuration_id` is
+/// set automatically, as by `ConfigurationSet::insert`. The size is the
+/// number of configurations inserted by this sink.
+///
+/// Notes:
+/// - `configurations` must remain valid for the lifetime of the sink
+struct ConfigurationSetSink : public ConfigurationSink {
+  explicit ConfigurationSetSink(ConfigurationSet &_configurations);
+
+  void insert(std::vector<Configuration> &configurations) override;
+
+  Index size() const override { return m_n_inserted; }
+
+ private:
+  ConfigurationSet &m_configurations;
+
+  Index m_n_inserted;
+};
+
+/// \brief Write configurations to a file in JSON Lines format
+///
+/// Configurations are written as they are received, by
+/// ConfigurationJsonLinesWriter. `configuration_id` is set automatically,
+/// counting up from `next_config_id` for each supercell, as by
+/// `ConfigurationSet::insert`, so reading the file into an empty
+/// ConfigurationSet gives the same names as inserting the configurations.
+///
+/// Notes:
+/// - Configurations are not checked for duplicates, so the enumeration
+///   should give distinct configurations (for example, only canonical
+///   configurations)
+/// - The file is flushed and closed by `finish`
+struct JsonLinesConfigurationSink : public ConfigurationSink {
+  JsonLinesConfigurationSink(
+      fs::path const &path, bool write_prim_basis = false,
+      std::map<std::string, Index> _next_config_id = {});
+
+  ~JsonLinesConfigurationSink();
+
+  void insert(std::vector<Configuration> &configurations) override;
+
+  void finish() override;
+
+  Index size() const override;
+
+  /// \brief IDs, by supercell_name, of the next configuration written
+  std::map<std::string, Index> const &next_config_id() const {
+    return m_next_config_id;
+  }
+
+ private:
+  std::ofstream m_out;
+
+  std::unique_ptr<ConfigurationJsonLinesWriter> m_writer;
+
+  std::map<std::string, Index> m_next_config_id;
+};
+
+/// \brief Write configurations to a file in binary columnar format
+///
+/// Configurations are written as they are received, by
+/// ConfigurationSetBinaryWriter, and the file is completed by `finish`.
+/// `configuration_id` is set automatically, as for
+/// JsonLinesConfigurationSink, and the file can be read with `read_binary`,
+/// ConfigurationSetBinaryReader, or ConfigurationSetMappedReader.
+///
+/// Notes:
+/// - Configurations are not checked for duplicates
+struct BinaryConfigurationSink : public ConfigurationSink {
+  BinaryConfigurationSink(fs::path const &path, bool compress = true,
+                          Index chunk_size = 1024,
+                          std::map<std::string, Index> _next_config_id = {});
+
+  ~BinaryConfigurationSink();
+
+  void insert(std::vector<Configuration> &configurations) override;
+
+  void finish() override;
+
+  Index size() const override;
+
+  /// \brief IDs, by supercell_name, of the next configuration written
+  std::map<std::string, Index> const &next_config_id() const {
+    return m_next_config_id;
+  }
+
+ private:
+  std::unique_ptr<ConfigurationSetBinaryWriter> m_writer;
+
+  std::map<std::string, Index> m_next_config_id;
+};
+
+/// \brief Run an enumeration pipeline, passing accepted configurations to a
+///     ConfigurationSink, and finish the sink
+EnumerationPipelineStats run_enumeration_pipeline(
+    EnumerationSource const &source, ConfigurationTransform const &transform,
+    ConfigurationPredicate const &filter, ConfigurationSink &sink,
+    EnumerationPipelineOptions const &options = EnumerationPipelineOptions());
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
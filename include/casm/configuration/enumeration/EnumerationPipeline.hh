@@ -0,0 +1,110 @@
+#ifndef CASM_config_enum_EnumerationPipeline
+#define CASM_config_enum_EnumerationPipeline
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+struct Configuration;
+class ConfigEnumAllOccupations;
+struct ConfigurationFilter;
+struct OccupantCountConstraint;
+struct Supercell;
+
+/// \brief Return up to `max_size` configurations, in enumeration order, or
+///     an empty vector when the enumeration is complete
+typedef std::function<std::vector<Configuration>(Index max_size)>
+    EnumerationSource;
+
+/// \brief Modify a configuration in place (for example, to make it
+///     canonical)
+typedef std::function<void(Configuration &)> ConfigurationTransform;
+
+/// \brief Return true if a configuration is allowed, false otherwise
+typedef std::function<bool(Configuration const &)> ConfigurationPredicate;
+
+/// \brief Receive a batch of configurations (for example, to insert them
+///     into a ConfigurationSet or write them)
+typedef std::function<void(std::vector<Configuration> &)>
+    ConfigurationBatchSink;
+
+/// \brief Options controlling `run_enumeration_pipeline`
+struct EnumerationPipelineOptions {
+  /// \brief Maximum number of configurations requested from the source at
+  ///     once, and passed between stages as one batch
+  Index batch_size = 1000;
+
+  /// \brief Maximum number of batches waiting between each pair of stages
+  Index queue_capacity = 4;
+
+  /// \brief Number of threads running the transform stage. If <= 0, uses
+  ///     `resolve_n_threads(n_transform_threads)`.
+  Index n_transform_threads = 0;
+
+  /// \brief Number of threads running the filter stage. If <= 0, uses
+  ///     `resolve_n_threads(n_filter_threads)`.
+  Index n_filter_threads = 0;
+};
+
+/// \brief Counts of configurations passed through
+///     `run_enumeration_pipeline`
+struct EnumerationPipelineStats {
+  /// \brief Number of configurations returned by the source
+  Index n_enumerated = 0;
+
+  /// \brief Number of configurations passed to the sink
+  Index n_accepted = 0;
+
+  /// \brief Number of batches returned by the source
+  Index n_batches = 0;
+};
+
+/// \brief Run enumerate -> transform -> filter -> sink stages concurrently,
+///     with bounded queues between stages
+EnumerationPipelineStats run_enumeration_pipeline(
+    EnumerationSource const &source, ConfigurationTransform const &transform,
+    ConfigurationPredicate const &filter, ConfigurationBatchSink const &sink,
+    EnumerationPipelineOptions const &options = EnumerationPipelineOptions());
+
+/// \brief Return an EnumerationSource that takes batches from a
+///     ConfigEnumAllOccupations
+EnumerationSource make_enumeration_source(
+    ConfigEnumAllOccupations &enumerator);
+
+/// \brief Return a ConfigurationTransform that makes a configuration the
+///     canonical form in its supercell
+ConfigurationTransform make_canonical_form_transform();
+
+/// \brief Return a ConfigurationPredicate that accepts primitive
+///     configurations
+ConfigurationPredicate make_is_primitive_predicate();
+
+/// \brief Return a ConfigurationPredicate that accepts configurations in
+///     canonical form in their supercell
+ConfigurationPredicate make_is_canonical_predicate();
+
+/// \brief Return a ConfigurationPredicate that accepts configurations
+///     satisfying occupant count constraints
+ConfigurationPredicate make_occupant_count_predicate(
+    std::shared_ptr<Supercell const> const &supercell,
+    std::vector<OccupantCountConstraint> const &constraints);
+
+/// \brief Return a ConfigurationPredicate that accepts configurations
+///     accepted by a ConfigurationFilter
+ConfigurationPredicate make_filter_predicate(
+    std::shared_ptr<ConfigurationFilter const> const &filter);
+
+/// \brief Return a ConfigurationPredicate that accepts configurations
+///     accepted by all of `predicates`
+ConfigurationPredicate make_all_of_predicate(
+    std::vector<ConfigurationPredicate> const &predicates);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
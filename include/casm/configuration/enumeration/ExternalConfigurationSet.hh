@@ -0,0 +1,101 @@
+#ifndef CASM_config_enum_ExternalConfigurationSet
+#define CASM_config_enum_ExternalConfigurationSet
+
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Set of configurations in one supercell, for de-duplication of
+///     enumeration results, optionally spilling to files
+///
+/// Configurations are stored as compact fixed-length keys: one byte per
+/// site for the occupation, and continuous DoF values rounded to
+/// multiples of the prim lattice tolerance. Only membership is tracked, so
+/// configurations themselves are not stored.
+///
+/// If a spill directory is given, then when the number of keys held in
+/// memory reaches `max_size_in_memory`, they are sorted and written to a
+/// new run file in the spill directory. Membership checks search the keys
+/// in memory, then each run file by binary search, so memory use is
+/// bounded by `max_size_in_memory` keys plus one open file per run. Run
+/// files are removed on destruction.
+///
+/// Notes:
+/// - All configurations must be in `supercell`.
+/// - Occupant indices must be in the range [0, 256).
+/// - Not thread safe.
+class ExternalConfigurationSet {
+ public:
+  ExternalConfigurationSet(std::shared_ptr<Supercell const> const &_supercell,
+                           std::optional<fs::path> _spill_dir = std::nullopt,
+                           Index _max_size_in_memory = 1000000);
+
+  ~ExternalConfigurationSet();
+
+  ExternalConfigurationSet(ExternalConfigurationSet const &) = delete;
+  ExternalConfigurationSet &operator=(ExternalConfigurationSet const &) =
+      delete;
+
+  /// \brief Insert a configuration, return true if it was not already
+  ///     in the set
+  bool insert(Configuration const &configuration);
+
+  /// \brief Return true if the configuration is in the set
+  bool contains(Configuration const &configuration) const;
+
+  /// \brief Number of configurations in the set
+  Index size() const { return m_size; }
+
+  /// \brief Number of run files written
+  Index n_runs() const { return m_runs.size(); }
+
+ private:
+  /// \brief Make the fixed-length key for a configuration
+  std::string _make_key(Configuration const &configuration) const;
+
+  /// \brief Return true if `key` is in memory or in any run file
+  bool _contains(std::string const &key) const;
+
+  /// \brief Sort the keys in memory and write them to a new run file
+  void _spill();
+
+  struct Run {
+    fs::path path;
+    Index size;
+    std::unique_ptr<std::ifstream> in;
+  };
+
+  std::shared_ptr<Supercell const> m_supercell;
+
+  std::optional<fs::path> m_spill_dir;
+
+  Index m_max_size_in_memory;
+
+  double m_tol;
+
+  /// Prefix of run file names
+  std::string m_run_prefix;
+
+  Index m_size;
+
+  std::unordered_set<std::string> m_memory;
+
+  std::vector<Run> m_runs;
+
+  /// Buffer for reading keys from run files
+  mutable std::string m_buffer;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
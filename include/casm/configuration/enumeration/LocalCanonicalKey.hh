@@ -0,0 +1,147 @@
+#ifndef CASM_config_enum_LocalCanonicalKey
+#define CASM_config_enum_LocalCanonicalKey
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Distance-ordered occupation keys for configurations in the
+///     context of an occupation event
+///
+/// `make_canonical_form(configuration, event_sites, occ_init, occ_final,
+/// event_group)` compares transformed configurations in linear site order.
+/// For local perturbations of a background, differences are near the event,
+/// but are only reached after comparing many unchanged sites. A
+/// LocalCanonicalKey instead compares occupations on sites ordered by
+/// distance from the event sites, exiting at the first difference.
+///
+/// Sites are ordered by:
+/// - sites in the neighborhood (for example, the impact neighborhood of the
+///   event's local-cluster orbits), before other sites,
+/// - minimum image distance from the nearest event site, grouped in shells
+///   of distances within `tol` of the first distance in the shell,
+/// - linear site index.
+/// Sites on sublattices with a single allowed occupant are not included.
+///
+/// The key is the greatest, lexicographically in that order, of the
+/// occupation of `copy_apply(op, config_init)` and
+/// `copy_apply(op, config_final)`, for all `op` in the event group, where
+/// `config_init` and `config_final` have `occ_init` and `occ_final` on the
+/// event sites. Methods:
+/// - `neighborhood_key`: Only the neighborhood sites are compared.
+///   Configurations with different neighborhood keys are not equivalent,
+///   but configurations with equal neighborhood keys may not be.
+/// - `key`: All sites are compared. For prim with occupation DoF only,
+///   configurations are equivalent if and only if their keys are equal.
+/// - `is_equivalent`: Compares neighborhood keys, then, if equal, full keys
+///   or, for prim with continuous DoF, the canonical forms given by
+///   `make_canonical_form(configuration, event_sites, occ_init, occ_final,
+///   event_group)`.
+///
+/// Notes:
+/// - Key order is not the linear site order, so the configuration that
+///   gives the key is not the result of `make_canonical_form`. Use keys for
+///   identifying duplicates, not as the canonical form.
+/// - Construct once per (supercell, event) and re-use for many
+///   configurations
+/// - Not thread safe; use one LocalCanonicalKey per thread
+class LocalCanonicalKey {
+ public:
+  /// \brief Constructor
+  LocalCanonicalKey(std::shared_ptr<Supercell const> const &_supercell,
+                    std::vector<Index> const &_event_sites,
+                    std::vector<int> const &_occ_init,
+                    std::vector<int> const &_occ_final,
+                    std::vector<SupercellSymOp> const &_event_group,
+                    std::set<Index> const &_neighborhood_sites = {},
+                    double tol = TOL);
+
+  /// \brief The supercell
+  std::shared_ptr<Supercell const> const &supercell() const;
+
+  /// \brief Linear site indices, in key order
+  std::vector<Index> const &ordered_sites() const;
+
+  /// \brief Minimum image distance from the nearest event site, for each
+  ///     site in `ordered_sites()`
+  std::vector<double> const &ordered_distances() const;
+
+  /// \brief Number of leading `ordered_sites()` in the neighborhood
+  Index n_neighborhood_sites() const;
+
+  /// \brief True if equal full keys imply equivalence, which is the case
+  ///     for prim with occupation DoF only
+  bool is_complete() const;
+
+  /// \brief Return the key, comparing neighborhood sites only
+  std::vector<int> const &neighborhood_key(Configuration const &configuration);
+
+  /// \brief Return the key, comparing all sites
+  std::vector<int> const &key(Configuration const &configuration);
+
+  /// \brief Return true if configurations are equivalent in the context of
+  ///     the event
+  bool is_equivalent(Configuration const &A, Configuration const &B);
+
+ private:
+  /// \brief Set m_occ from configuration and the event occupations
+  void _set_occupation(Configuration const &configuration);
+
+  /// \brief Occupation of `copy_apply(op k, variant v)` on ordered site i
+  int _value(Index k, Index v, Index i) const {
+    Index l = m_perm[k * m_ordered_sites.size() + i];
+    return m_remap[k][m_site_sublattice[l] * m_max_n_occupants +
+                      m_occ[v][l]];
+  }
+
+  /// \brief Set m_key to the greatest of the first n ordered values
+  void _search(Index n);
+
+  std::shared_ptr<Supercell const> m_supercell;
+
+  std::vector<Index> m_event_sites;
+
+  std::vector<int> m_occ_init;
+
+  std::vector<int> m_occ_final;
+
+  std::vector<SupercellSymOp> m_event_group;
+
+  bool m_is_complete;
+
+  std::vector<Index> m_ordered_sites;
+
+  std::vector<double> m_ordered_distances;
+
+  Index m_n_neighborhood_sites;
+
+  /// Sublattice index, by site index
+  std::vector<Index> m_site_sublattice;
+
+  Index m_max_n_occupants;
+
+  /// Site permuted onto ordered site i by op k, by
+  /// `k * ordered_sites().size() + i`
+  std::vector<Index> m_perm;
+
+  /// Occupant index remapping, by op
+  std::vector<std::int32_t const *> m_remap;
+
+  /// Initial and final variants of the occupation
+  std::vector<int> m_occ[2];
+
+  std::vector<int> m_key;
+
+  std::vector<int> m_other_key;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
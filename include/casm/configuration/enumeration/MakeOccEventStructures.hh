@@ -21,6 +21,7 @@ struct OccSystem;
 namespace config {
 
 struct Configuration;
+struct Supercell;
 
 /// \brief Generate xtal::SimpleStructure, properly aligned for NEB
 ///     calculations
@@ -62,6 +63,101 @@ class MakeOccEventStructures {
   Eigen::Matrix3d m_F;
 };
 
+/// \brief Coordinates of interpolated images of many events, in one
+///     buffer
+///
+/// For each event `e`, images have `n_atoms(e)` atoms and are listed in
+/// order of interpolation factor. The atoms of an image are in the same
+/// order as in the structures constructed by MakeOccEventStructures.
+///
+/// Usage:
+/// \code
+/// // Cartesian coordinates, as columns, of image `k` of event `e`
+/// auto image_coords = images.coords.middleCols(images.image_begin(e, k),
+///                                              images.n_atoms(e));
+///
+/// // chemical type of atom `a` of event `e`, as an index into
+/// // occ_events::OccSystem::chemical_name_list
+/// int chemical_index = images.atom_type(images.atom_offsets(e) + a);
+/// \endcode
+struct OccEventImages {
+  /// \brief Lattice vectors of all images, as columns, including strain
+  Eigen::Matrix3d lat_column_mat;
+
+  /// \brief Number of images of each event
+  Index n_images;
+
+  /// \brief Offset of the first atom of each event in `atom_type`, with
+  ///     size `n_events + 1`
+  Eigen::VectorXl atom_offsets;
+
+  /// \brief Chemical type of each atom, as an index into
+  ///     occ_events::OccSystem::chemical_name_list, for all events
+  Eigen::VectorXi atom_type;
+
+  /// \brief Cartesian coordinates, as columns, of all atoms of all images of
+  ///     all events, including strain
+  Eigen::MatrixXd coords;
+
+  /// \brief Number of events
+  Index n_events() const { return atom_offsets.size() - 1; }
+
+  /// \brief Number of atoms in each image of event `e`
+  Index n_atoms(Index e) const {
+    return atom_offsets(e + 1) - atom_offsets(e);
+  }
+
+  /// \brief Column in `coords` of the first atom of image `k` of event `e`
+  Index image_begin(Index e, Index k) const {
+    return n_images * atom_offsets(e) + k * n_atoms(e);
+  }
+};
+
+/// \brief Generate interpolated image coordinates for many events in one
+///     background configuration, for NEB calculations
+///
+/// This gives the same atom names and coordinates as MakeOccEventStructures,
+/// but the background coordinates are computed once, when constructed, and
+/// the images of all events are written into one preallocated buffer,
+/// without constructing an xtal::SimpleStructure for each image.
+///
+/// Notes:
+/// - Same restrictions as MakeOccEventStructures
+class MakeOccEventImages {
+ public:
+  /// \brief MakeOccEventImages constructor
+  MakeOccEventImages(Configuration const &configuration,
+                     std::shared_ptr<occ_events::OccSystem const> const &system,
+                     bool skip_event_occupants = false);
+
+  /// \brief Construct interpolated image coordinates of many events
+  OccEventImages operator()(
+      std::vector<occ_events::OccEvent> const &occ_events,
+      std::vector<double> const &interpolation_factors) const;
+
+ private:
+  std::shared_ptr<Supercell const> m_supercell;
+
+  std::shared_ptr<occ_events::OccSystem const> m_system;
+
+  bool m_skip_event_occupants;
+
+  /// Lattice, including strain
+  Eigen::Matrix3d m_lat_column_mat;
+
+  /// Configuration deformation gradient
+  Eigen::Matrix3d m_F;
+
+  /// Cartesian coordinates of the occupant on each site, including strain
+  Eigen::Matrix3Xd m_site_coords;
+
+  /// Chemical index of the occupant on each site
+  std::vector<Index> m_site_chemical_index;
+
+  /// Sites, by chemical index, sorted (empty for vacancies)
+  std::vector<std::vector<Index>> m_sites_by_chemical_index;
+};
+
 }  // namespace config
 }  // namespace CASM
 
@@ -1,14 +1,23 @@
 #ifndef CASM_config_enum_OccEventInfo
 #define CASM_config_enum_OccEventInfo
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <vector>
+
 #include "casm/configuration/Prim.hh"
 #include "casm/configuration/Supercell.hh"
 #include "casm/configuration/SupercellSymOp.hh"
 #include "casm/configuration/clusterography/IntegralCluster.hh"
 #include "casm/configuration/definitions.hh"
+#include "casm/configuration/enumeration/SupercellOrbitSiteTable.hh"
 #include "casm/configuration/group/Group.hh"
 #include "casm/configuration/occ_events/OccEvent.hh"
 #include "casm/configuration/occ_events/OccEventRep.hh"
+#include "casm/configuration/occ_events/orbits.hh"
 #include "casm/crystallography/UnitCellCoordRep.hh"
 
 namespace CASM {
@@ -20,6 +29,18 @@ namespace config {
 /// They are not meant to handle all use cases or be a dependency for
 /// other methods in this library.
 
+/// \brief Make the OccEventRep symgroup rep of a prim's factor group,
+///     shared with later calls using the same prim
+std::shared_ptr<std::vector<occ_events::OccEventRep> const>
+make_shared_occevent_symgroup_rep(std::shared_ptr<Prim const> const &prim);
+
+/// \brief Make the OccEventRep symgroup rep of a prim factor group, shared
+///     with later calls using the same prim and factor group
+std::shared_ptr<std::vector<occ_events::OccEventRep> const>
+make_shared_occevent_symgroup_rep(
+    std::shared_ptr<SymGroup const> const &factor_group,
+    std::shared_ptr<xtal::BasicStructure const> const &prim);
+
 struct OccEventPrimInfo {
   OccEventPrimInfo(std::shared_ptr<Prim const> const &_prim,
                    occ_events::OccEvent const &_event);
@@ -29,8 +50,10 @@ struct OccEventPrimInfo {
 
   /// \brief Symgroup rep of prim->sym_info.factor_group
   ///
-  /// Use to apply prim factor group elements to `event`
-  std::vector<occ_events::OccEventRep> occevent_symgroup_rep;
+  /// Use to apply prim factor group elements to `event`. Shared with other
+  /// OccEventPrimInfo using the same prim.
+  std::shared_ptr<std::vector<occ_events::OccEventRep> const>
+      occevent_symgroup_rep;
 
   /// \brief Subgroup of prim factor group that leaves `event` invariant
   std::shared_ptr<SymGroup const> invariant_group;
@@ -44,13 +67,42 @@ struct OccEventPrimInfo {
   /// \brief Make local-cluster orbits from clusters
   std::vector<std::set<clust::IntegralCluster>> make_local_orbits(
       std::set<clust::IntegralCluster> const &local_clusters) const;
+
+  /// \brief Make local-cluster orbits from clusters, shared with later
+  ///     calls using the same clusters
+  std::shared_ptr<std::vector<std::set<clust::IntegralCluster>> const>
+  make_shared_local_orbits(
+      std::set<clust::IntegralCluster> const &local_clusters) const;
+
+ private:
+  mutable std::mutex m_local_orbits_mutex;
+
+  /// \brief Local-cluster orbits, by local clusters
+  mutable std::map<
+      std::set<clust::IntegralCluster>,
+      std::shared_ptr<std::vector<std::set<clust::IntegralCluster>> const>>
+      m_local_orbits;
 };
 
+/// \brief Make local-cluster orbits for many events, in parallel
+std::vector<
+    std::shared_ptr<std::vector<std::set<clust::IntegralCluster>> const>>
+make_shared_local_orbits(
+    std::vector<std::shared_ptr<OccEventPrimInfo const>> const
+        &event_prim_info,
+    std::vector<std::set<clust::IntegralCluster>> const &local_clusters,
+    Index n_threads = 1);
+
 struct OccEventSupercellInfo {
   OccEventSupercellInfo(
       std::shared_ptr<OccEventPrimInfo const> const &_event_info,
       std::shared_ptr<Supercell const> const &_supercell);
 
+  OccEventSupercellInfo(
+      std::shared_ptr<OccEventPrimInfo const> const &_event_info,
+      std::shared_ptr<Supercell const> const &_supercell,
+      std::vector<SupercellSymOp> const &_supercellsymop_symgroup_rep);
+
   std::shared_ptr<OccEventPrimInfo const> event_prim_info;
   std::shared_ptr<Supercell const> supercell;
 
@@ -76,7 +128,7 @@ struct OccEventSupercellInfo {
   ///     factor group operations, that fit into the same supercell, but are
   ///     inequivalent under the action of a local group.
   std::set<Configuration> make_distinct_background_configurations(
-      Configuration const &motif) const;
+      Configuration const &motif, Index n_threads = 1) const;
 
   /// \brief Make configurations that are distinct perturbations of local
   /// clusters
@@ -84,6 +136,12 @@ struct OccEventSupercellInfo {
       Configuration const &background,
       std::vector<std::set<clust::IntegralCluster>> const &local_orbits) const;
 
+  /// \brief Make configurations that are distinct perturbations of local
+  /// clusters, using local orbits as supercell site indices
+  std::set<Configuration> make_distinct_local_perturbations(
+      Configuration const &background,
+      SupercellOrbitSiteTable const &local_orbit_site_table) const;
+
   /// \brief Generate local-cluster orbits and make configurations that are
   ///     distinct perturbations of local clusters
   std::set<Configuration> make_distinct_local_perturbations(
@@ -94,20 +152,155 @@ struct OccEventSupercellInfo {
   /// clusters, using all equivalents of motif that fill the supercell
   std::set<Configuration> make_all_distinct_local_perturbations(
       Configuration const &motif,
-      std::vector<std::set<clust::IntegralCluster>> const &local_orbits) const;
+      std::vector<std::set<clust::IntegralCluster>> const &local_orbits,
+      Index n_threads = 1) const;
 
   /// \brief Generate local-cluster orbits and make configurations that are
   ///     distinct perturbations of local clusters, using all equivalents
   ///     of motif that fill the supercell
   std::set<Configuration> make_all_distinct_local_perturbations(
       Configuration const &motif,
-      std::set<clust::IntegralCluster> const &local_clusters) const;
+      std::set<clust::IntegralCluster> const &local_clusters,
+      Index n_threads = 1) const;
 
   /// \brief Generate local-cluster orbits and make configurations that are
   ///     distinct perturbations of sites within a cutoff radius of sites
   ///     in the event
   std::set<Configuration> make_all_distinct_local_perturbations(
-      Configuration const &motif, double cutoff_radius) const;
+      Configuration const &motif, double cutoff_radius,
+      Index n_threads = 1) const;
+};
+
+/// \brief Cache of OccEventSupercellInfo and local-cluster orbit tables,
+///     for symmetrically equivalent events in supercells
+///
+/// When preparing event libraries, the same supercell symgroup reps and
+/// local-cluster orbits as supercell site indices would otherwise be made
+/// for every equivalent event. An OccEventSupercellInfoCache makes them
+/// once per (event orbit, supercell), for the orbit prototype, and derives
+/// those of an equivalent event by conjugation:
+///
+///     event = g * prototype
+///     event_group = g * prototype_group * g^-1
+///     event_local_orbits = g * prototype_local_orbits
+///
+/// where g is a supercell operation. The prototype is the canonical form
+/// of the event orbit (see occ_events::PrimPeriodicOccEventOrbitCache).
+/// If no supercell operation transforms the prototype into the event, as
+/// when the supercell has lower symmetry than the prim, the event group is
+/// made directly, and local-cluster orbits are transformed by a prim
+/// factor group operation before conversion to site indices.
+///
+/// Notes:
+/// - Results are the same as constructing OccEventSupercellInfo directly,
+///   including the order of `supercellsymop_symgroup_rep`. Rows of a
+///   derived local orbit table are in the order of the prototype table.
+/// - Entries hold a shared_ptr to their supercell, so supercells remain in
+///   memory as long as the cache
+/// - Thread-safe; calls are serialized by a mutex
+class OccEventSupercellInfoCache {
+ public:
+  /// \brief Constructor
+  explicit OccEventSupercellInfoCache(
+      std::shared_ptr<Prim const> const &_prim);
+
+  /// \brief The prim
+  std::shared_ptr<Prim const> const &prim() const;
+
+  /// \brief Return the OccEventSupercellInfo of an event in a supercell
+  std::shared_ptr<OccEventSupercellInfo const> supercell_info(
+      occ_events::OccEvent const &event,
+      std::shared_ptr<Supercell const> const &supercell);
+
+  /// \brief Return the local-cluster orbits of an event, as supercell site
+  ///     indices, from local clusters of the event orbit prototype
+  std::shared_ptr<SupercellOrbitSiteTable const> local_orbit_site_table(
+      occ_events::OccEvent const &event,
+      std::shared_ptr<Supercell const> const &supercell,
+      std::set<clust::IntegralCluster> const &prototype_local_clusters);
+
+  /// \brief Return the supercell operation, g, that derives data for an
+  ///     event from the orbit prototype, if one exists
+  std::optional<SupercellSymOp> prototype_op(
+      occ_events::OccEvent const &event,
+      std::shared_ptr<Supercell const> const &supercell);
+
+  /// \brief Return the OccEventPrimInfo of the prototype of the orbit
+  ///     containing an event
+  std::shared_ptr<OccEventPrimInfo const> prototype_prim_info(
+      occ_events::OccEvent const &event);
+
+  /// \brief Clear all cached data
+  void clear();
+
+ private:
+  struct EventData {
+    /// Standardized event, as the prototype is stored
+    occ_events::OccEvent event;
+
+    /// Orbit index, in `m_orbit_cache`
+    Index orbit_index;
+  };
+
+  /// \brief Standardize an event and find its orbit (requires lock)
+  EventData _event_data(occ_events::OccEvent const &event);
+
+  /// \brief Prototype OccEventPrimInfo for an orbit (requires lock)
+  std::shared_ptr<OccEventPrimInfo const> const &_prototype_prim_info(
+      Index orbit_index);
+
+  /// \brief Prototype OccEventSupercellInfo for an orbit (requires lock)
+  std::shared_ptr<OccEventSupercellInfo const> const &
+  _prototype_supercell_info(Index orbit_index,
+                            std::shared_ptr<Supercell const> const &supercell);
+
+  /// \brief Supercell operation transforming the orbit prototype into
+  ///     `data.event` (requires lock)
+  std::optional<SupercellSymOp> _prototype_op(
+      EventData const &data,
+      std::shared_ptr<Supercell const> const &supercell);
+
+  /// \brief Local-cluster orbits of `data.event`, as images of the orbit
+  ///     prototype local-cluster orbits under a prim factor group
+  ///     operation and lattice translation (requires lock)
+  std::vector<std::set<clust::IntegralCluster>> _prim_local_orbits(
+      EventData const &data,
+      std::set<clust::IntegralCluster> const &prototype_local_clusters);
+
+  std::shared_ptr<Prim const> m_prim;
+
+  std::shared_ptr<std::vector<occ_events::OccEventRep> const>
+      m_occevent_symgroup_rep;
+
+  mutable std::mutex m_mutex;
+
+  occ_events::PrimPeriodicOccEventOrbitCache m_orbit_cache;
+
+  /// Prototype OccEventPrimInfo, by orbit index
+  std::map<Index, std::shared_ptr<OccEventPrimInfo const>> m_prototype_info;
+
+  typedef std::pair<Index, std::shared_ptr<Supercell const>> OrbitSupercell;
+
+  /// Prototype OccEventSupercellInfo, by (orbit index, supercell)
+  std::map<OrbitSupercell, std::shared_ptr<OccEventSupercellInfo const>>
+      m_prototype_supercell_info;
+
+  typedef std::pair<occ_events::OccEvent, std::shared_ptr<Supercell const>>
+      EventSupercell;
+
+  /// OccEventSupercellInfo, by (standardized event, supercell)
+  std::map<EventSupercell, std::shared_ptr<OccEventSupercellInfo const>>
+      m_supercell_info;
+
+  /// Prototype local orbit tables, by (orbit index, supercell, clusters)
+  std::map<std::pair<OrbitSupercell, std::set<clust::IntegralCluster>>,
+           std::shared_ptr<SupercellOrbitSiteTable const>>
+      m_prototype_tables;
+
+  /// Local orbit tables, by (standardized event, supercell, clusters)
+  std::map<std::pair<EventSupercell, std::set<clust::IntegralCluster>>,
+           std::shared_ptr<SupercellOrbitSiteTable const>>
+      m_tables;
 };
 
 }  // namespace config
@@ -0,0 +1,103 @@
+#ifndef CASM_config_enum_OccupationStabilizerChain
+#define CASM_config_enum_OccupationStabilizerChain
+
+#include <set>
+#include <vector>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Invariant subgroups of occupations on a subset of sites, refined
+///     site by site
+///
+/// For enumeration of occupation on `sites` over a background, such as by
+/// ConfigEnumAllOccupations, the operations that leave an enumerated
+/// configuration invariant are a subgroup of the operations that leave
+/// the background invariant on the other sites and do not mix `sites` and
+/// other sites. An OccupationStabilizerChain holds that group, and for
+/// each position `p` in `sites`, the subgroup of operations consistent
+/// with the occupation on positions `[p, n_sites)`, which are the slowest
+/// varying positions of a Counter. When the occupation changes, only the
+/// levels at and below the highest changed position are refined again,
+/// each from the level above, so that following an enumeration the cost
+/// per configuration is usually a small number of site comparisons per
+/// candidate operation.
+///
+/// An operation is consistent with the occupation on a set of positions
+/// if, for all pairs of sites in the set such that the operation permutes
+/// the value of one onto the other, the transformed value equals the
+/// value. When all positions are assigned this is exactly invariance of
+/// the configuration.
+///
+/// Notes:
+/// - Operations are kept in the order of `group()`, so the invariant
+///   subgroup is in the order that `make_invariant_subgroup` would return
+/// - Not thread safe; use one OccupationStabilizerChain per thread
+class OccupationStabilizerChain {
+ public:
+  /// \brief Constructor
+  OccupationStabilizerChain(Configuration const &background,
+                            std::set<Index> const &sites,
+                            std::vector<SupercellSymOp> const &group);
+
+  /// \brief The operations that leave the background invariant on sites
+  ///     not in `sites`, and do not mix `sites` and other sites
+  std::vector<SupercellSymOp> const &group() const;
+
+  /// \brief Refine for new occupation values on `sites`, and return the
+  ///     indices in `group()` of the operations that leave the
+  ///     configuration invariant
+  std::vector<Index> const &update(std::vector<int> const &values);
+
+  /// \brief Make the invariant subgroup of the last values passed to
+  ///     `update`
+  std::vector<SupercellSymOp> make_invariant_subgroup() const;
+
+ private:
+  /// \brief Return true if group operation `k` is consistent with the
+  ///     value at position `p`, given values at positions `> p`
+  bool _is_consistent(Index k, Index p) const;
+
+  std::vector<SupercellSymOp> m_group;
+
+  /// Enumerated sites, in position order (increasing site index)
+  std::vector<Index> m_sites;
+
+  /// Position in m_sites, by linear site index, or -1
+  std::vector<Index> m_position;
+
+  /// Sublattice index, by linear site index
+  std::vector<Index> m_sublattice;
+
+  /// Combined permutation of each group operation
+  std::vector<sym_info::Permutation> m_permute;
+
+  /// Inverse combined permutation of each group operation
+  std::vector<sym_info::Permutation> m_inverse_permute;
+
+  /// Prim factor group index of each group operation
+  std::vector<Index> m_prim_factor_group_index;
+
+  /// Occupant index transformations, by prim factor group index and
+  /// sublattice, as by PrimSymInfo::occ_remap
+  std::vector<std::int32_t> const *m_occ_remap_table;
+
+  Index m_n_sublat;
+
+  Index m_max_n_occupants;
+
+  /// m_chain[p]: indices of group operations consistent with the values
+  /// on positions `[p, n)`; m_chain[n] includes all group operations
+  std::vector<std::vector<Index>> m_chain;
+
+  /// Values for which m_chain is valid, or empty if not yet updated
+  std::vector<int> m_values;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
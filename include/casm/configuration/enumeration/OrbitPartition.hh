@@ -0,0 +1,72 @@
+#ifndef CASM_config_enum_OrbitPartition
+#define CASM_config_enum_OrbitPartition
+
+#include <set>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+#include "casm/configuration/enumeration/SiteSet.hh"
+#include "casm/configuration/sym_info/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Disjoint-set forest, with path halving and union by size
+class DisjointSets {
+ public:
+  /// \brief Constructor, with each element in its own set
+  explicit DisjointSets(Index _n_elements);
+
+  /// \brief Number of elements
+  Index size() const { return m_parent.size(); }
+
+  /// \brief Number of disjoint sets
+  Index n_sets() const { return m_n_sets; }
+
+  /// \brief Return the root element of the set containing element i
+  Index find(Index i);
+
+  /// \brief Join the sets containing elements i and j, return true if they
+  ///     were different sets
+  bool join(Index i, Index j);
+
+ private:
+  std::vector<Index> m_parent;
+
+  std::vector<Index> m_size;
+
+  Index m_n_sets;
+};
+
+/// \brief Partition site indices into orbits, applying only the generators
+///     of a group
+std::vector<std::vector<Index>> make_site_orbits(
+    Index n_sites,
+    std::vector<sym_info::Permutation> const &generators_indices_rep);
+
+/// \brief Partition supercell site indices into orbits, applying only the
+///     generators of a group
+std::vector<std::vector<Index>> make_site_orbits(
+    std::vector<SupercellSymOp> const &generators);
+
+/// \brief Partition clusters of sites into orbits, applying only the
+///     generators of a group, and return the canonical element of each
+std::vector<SiteSet> make_cluster_orbit_generators(
+    std::vector<SiteSet> clusters,
+    std::vector<sym_info::Permutation> const &generators_indices_rep);
+
+/// \brief Partition clusters of sites into orbits, applying only the
+///     generators of a group, and return the canonical element of each
+std::set<std::set<Index>> make_cluster_orbit_generators(
+    std::set<std::set<Index>> const &clusters,
+    std::vector<SupercellSymOp> const &generators);
+
+/// \brief Make the permutations that transform linear site indices, for
+///     each operation
+std::vector<sym_info::Permutation> make_indices_group_rep(
+    std::vector<SupercellSymOp> const &group);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
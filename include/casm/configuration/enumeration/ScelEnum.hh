@@ -0,0 +1,157 @@
+#ifndef CASM_config_enum_ScelEnum
+#define CASM_config_enum_ScelEnum
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Enumerate symmetrically distinct supercells, by volume
+///
+/// Supercell lattices satisfy `S = L * U * H`, where `L` is the prim
+/// lattice, `U` is an integer unit cell transformation matrix (identity by
+/// default), and `H` is an integer matrix in Hermite normal form, upper
+/// triangular with `0 <= H(i, j) < H(i, i)` for `j > i`. For each volume,
+/// `det(H)`, in `[min_volume, max_volume]`, every such `H` is visited and
+/// rejected if another `H'` in the enumeration that precedes it is
+/// equivalent by a prim point group operation. This check only uses the
+/// integer action of the point group on `H`, so no Supercell is constructed
+/// for rejected `H`.
+///
+/// For each accepted `H`, `value()` is the canonical Supercell equal by
+/// prim point group symmetry to `S`. It is constructed on first access, so
+/// scans that only need the transformation matrices do not construct
+/// Supercell at all.
+///
+/// Example:
+/// \code
+/// ScelEnum enumerator(prim, 1, 10);
+/// while (enumerator.is_valid()) {
+///   Eigen::Matrix3l const &T = enumerator.transformation_matrix_to_super();
+///   std::shared_ptr<Supercell const> supercell = enumerator.value();
+///   ...
+///   enumerator.advance();
+/// }
+/// \endcode
+///
+/// An enumeration can be split across processes by constructing enumerators
+/// with the same arguments and each `shard_index` in `[0, n_shards)`. The
+/// `i`-th distinct supercell belongs to shard `i % n_shards`, so that shards
+/// have a similar distribution of supercell volumes.
+class ScelEnum {
+ public:
+  /// \brief Constructor
+  ScelEnum(std::shared_ptr<Prim const> const &prim, Index min_volume,
+           Index max_volume, std::string dirs = "abc",
+           std::optional<Eigen::Matrix3l> unit_cell = std::nullopt,
+           bool diagonal_only = false, bool fixed_shape = false,
+           Index shard_index = 0, Index n_shards = 1);
+
+  /// \brief The current canonical Supercell, constructed on first access
+  std::shared_ptr<Supercell const> const &value() const;
+
+  /// \brief The transformation matrix from the prim lattice to the current
+  ///     canonical Supercell lattice
+  Eigen::Matrix3l const &transformation_matrix_to_super() const;
+
+  /// \brief The current Hermite normal form matrix, `H`, such that the
+  ///     current superlattice is equivalent to `L * U * H`
+  Eigen::Matrix3l const &hermite_normal_form() const;
+
+  /// \brief The current volume, `det(H)`, relative to the unit cell
+  Index volume() const;
+
+  /// \brief Generate the next distinct supercell
+  void advance();
+
+  /// \brief Return true if `value` is valid, false if no more valid values
+  bool is_valid() const;
+
+ private:
+  /// \brief Set m_diagonals to the allowed diagonals of H for m_volume
+  void _make_diagonals();
+
+  /// \brief Advance to the next allowed diagonal, starting the next volume
+  ///     if necessary, and return false if past the maximum volume
+  bool _next_diagonal();
+
+  /// \brief Set m_current from the counter state
+  void _set_current();
+
+  /// \brief Increment the counter over H, and return true if the result is
+  ///     valid
+  bool _increment();
+
+  /// \brief Return true if H is a value of the enumeration
+  bool _is_enumerated(Eigen::Matrix3l const &H) const;
+
+  /// \brief Return true if no symmetrically equivalent value of the
+  ///     enumeration precedes m_current
+  bool _is_canonical() const;
+
+  /// \brief Advance the counter until m_current is canonical and in the
+  ///     shard, or the enumeration is complete
+  void _skip_not_allowed();
+
+  /// \brief Set the transformation matrix to the canonical supercell
+  void _set_transformation_matrix_to_super();
+
+  std::shared_ptr<Prim const> m_prim;
+
+  Index m_max_volume;
+
+  /// Unit cell transformation matrix, U
+  Eigen::Matrix3l m_unit_cell;
+
+  /// Point group operations acting on H, as `adj(U) * R * U`, where R is
+  /// the point group operation in prim fractional coordinates. The result
+  /// of operation `R` on `H` is `(m_ops[i] * H) / m_unit_cell_det`, when it
+  /// is an integer matrix.
+  std::vector<Eigen::Matrix3l> m_ops;
+
+  Index m_unit_cell_det;
+
+  /// If m_enumerate[i], H(i, i) may be > 1
+  std::array<bool, 3> m_enumerate;
+
+  bool m_diagonal_only;
+
+  bool m_fixed_shape;
+
+  Index m_shard_index;
+
+  Index m_n_shards;
+
+  /// Number of canonical values found, including the current value
+  Index m_n_canonical;
+
+  Index m_volume;
+
+  /// Allowed (H(0, 0), H(1, 1), H(2, 2)) for m_volume, in lexicographic
+  /// order
+  std::vector<std::array<Index, 3>> m_diagonals;
+
+  Index m_diagonal_index;
+
+  /// Values of (H(0, 1), H(0, 2), H(1, 2))
+  std::array<Index, 3> m_off_diagonal;
+
+  bool m_is_valid;
+
+  Eigen::Matrix3l m_current;
+
+  Eigen::Matrix3l m_transformation_matrix_to_super;
+
+  mutable std::shared_ptr<Supercell const> m_value;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
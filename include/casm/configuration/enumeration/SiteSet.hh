@@ -0,0 +1,145 @@
+#ifndef CASM_config_enum_SiteSet
+#define CASM_config_enum_SiteSet
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <set>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+#include "casm/configuration/sym_info/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief A sorted set of linear site indices, stored inline for small sets
+///
+/// SiteSet is used in place of `std::set<Index>` for the sites of clusters
+/// when generating orbits and sub-orbits of clusters in a supercell. Sets
+/// of up to `inline_capacity` sites, which includes nearly all clusters,
+/// are stored without allocation, so copying, applying permutations, and
+/// comparison do not use the allocator.
+///
+/// Notes:
+/// - Sites are unique and sorted in ascending order.
+/// - Comparison is lexicographical, the same as for `std::set<Index>`, so
+///   canonical elements and orbit generators are the same as when using
+///   `std::set<Index>`.
+/// - Sets larger than `inline_capacity` are stored in a std::vector.
+class SiteSet {
+ public:
+  static constexpr Index inline_capacity = 8;
+
+  typedef Index const *const_iterator;
+
+  /// \brief Construct an empty SiteSet
+  SiteSet() : m_size(0) {}
+
+  /// \brief Construct from a range of unique site indices, in any order
+  template <typename SiteIt>
+  SiteSet(SiteIt begin, SiteIt end) : m_size(std::distance(begin, end)) {
+    Index *data = _allocate();
+    std::copy(begin, end, data);
+    std::sort(data, data + m_size);
+  }
+
+  /// \brief Construct from a std::set<Index>
+  explicit SiteSet(std::set<Index> const &sites)
+      : SiteSet(sites.begin(), sites.end()) {}
+
+  /// \brief Number of sites
+  Index size() const { return m_size; }
+
+  bool empty() const { return m_size == 0; }
+
+  const_iterator begin() const { return _data(); }
+
+  const_iterator end() const { return _data() + m_size; }
+
+  /// \brief Set to the image of `sites` under a site index permutation
+  ///
+  /// The image of site `l` is `perm[l]`. The images are gathered and then
+  /// sorted, re-using the existing storage if possible.
+  void assign_permuted(sym_info::Permutation const &perm,
+                       SiteSet const &sites) {
+    m_size = sites.m_size;
+    Index *data = _allocate();
+    Index const *other = sites._data();
+    for (Index i = 0; i < m_size; ++i) {
+      data[i] = perm[other[i]];
+    }
+    // insertion sort, which is fastest for small sets
+    for (Index i = 1; i < m_size; ++i) {
+      Index value = data[i];
+      Index j = i;
+      for (; j > 0 && data[j - 1] > value; --j) {
+        data[j] = data[j - 1];
+      }
+      data[j] = value;
+    }
+  }
+
+  /// \brief Convert to std::set<Index>
+  std::set<Index> to_set() const { return std::set<Index>(begin(), end()); }
+
+  /// \brief Hash of the site indices
+  std::size_t hash() const {
+    std::size_t seed = m_size;
+    for (Index l : *this) {
+      seed ^= std::hash<Index>()(l) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+  }
+
+  bool operator==(SiteSet const &other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+  }
+
+  bool operator!=(SiteSet const &other) const { return !(*this == other); }
+
+  /// \brief Lexicographical comparison, the same as for std::set<Index>
+  bool operator<(SiteSet const &other) const {
+    return std::lexicographical_compare(begin(), end(), other.begin(),
+                                        other.end());
+  }
+
+ private:
+  Index const *_data() const {
+    return m_size <= inline_capacity ? m_inline.data() : m_heap.data();
+  }
+
+  /// \brief Return storage for m_size sites
+  Index *_allocate() {
+    if (m_size <= inline_capacity) {
+      return m_inline.data();
+    }
+    m_heap.resize(m_size);
+    return m_heap.data();
+  }
+
+  Index m_size;
+
+  std::array<Index, inline_capacity> m_inline;
+
+  std::vector<Index> m_heap;
+};
+
+/// \brief Hash function object for SiteSet, for use in std::unordered_set
+struct SiteSetHash {
+  std::size_t operator()(SiteSet const &sites) const { return sites.hash(); }
+};
+
+/// \brief Return the image of `sites` under a site index permutation
+inline SiteSet copy_apply(sym_info::Permutation const &perm,
+                          SiteSet const &sites) {
+  SiteSet image;
+  image.assign_permuted(perm, sites);
+  return image;
+}
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef CASM_config_enum_SupercellOccEventTable
+#define CASM_config_enum_SupercellOccEventTable
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+#include "casm/configuration/occ_events/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief All instances of OccEvent orbits in a supercell, as linear site
+///     indices and initial and final occupations, with a per-site index of
+///     the events that involve each site
+///
+/// A SupercellOccEventTable is constructed once per supercell and set of
+/// prim periodic OccEvent orbits, so that methods such as kinetic Monte
+/// Carlo can look up the sites and occupation of any event instance, or the
+/// event instances involving a site, without applying symmetry or
+/// converting coordinates.
+///
+/// Event instances are stored in compressed sparse row (CSR) form:
+/// - Event `r = row(o, e, t)` is equivalent `e` of orbit `o`, translated
+///   by supercell translation `t`
+/// - The linear site indices of event `r` are
+///   `sites[event_offsets[r], event_offsets[r+1])`, in the order of the
+///   cluster given by `occ_events::make_cluster_occupation`, and
+///   `occ_init` and `occ_final` give the initial and final occupation of
+///   the same sites
+/// - Events of orbit `o` are `[orbit_offsets[o], orbit_offsets[o+1])`
+/// - The events that involve site `l` are
+///   `site_events[site_event_offsets[l], site_event_offsets[l+1])`, in
+///   increasing order, without repeats
+///
+/// Notes:
+/// - `t` indexes `supercell->unitcell_index_converter`
+/// - Periodic boundary conditions may cause events to alias, so the same
+///   sites may appear in more than one event, or more than once in one
+///   event.
+struct SupercellOccEventTable {
+  SupercellOccEventTable(
+      std::shared_ptr<Supercell const> const &_supercell,
+      std::vector<std::vector<occ_events::OccEvent>> const &event_orbits);
+
+  SupercellOccEventTable(
+      std::shared_ptr<Supercell const> const &_supercell,
+      std::vector<std::set<occ_events::OccEvent>> const &event_orbits);
+
+  /// \brief The supercell
+  std::shared_ptr<Supercell const> supercell;
+
+  /// \brief Number of translations of each equivalent event
+  Index n_translations;
+
+  /// \brief Linear site indices of all events
+  std::vector<Index> sites;
+
+  /// \brief Initial occupation on `sites`
+  std::vector<int> occ_init;
+
+  /// \brief Final occupation on `sites`
+  std::vector<int> occ_final;
+
+  /// \brief Offset of the first site of each event, with size
+  ///     `n_events() + 1`
+  std::vector<Index> event_offsets;
+
+  /// \brief Offset of the first event of each orbit, with size
+  ///     `n_orbits() + 1`
+  std::vector<Index> orbit_offsets;
+
+  /// \brief Events involving each site, in CSR form
+  std::vector<Index> site_events;
+
+  /// \brief Offset of the first event involving each site, with size
+  ///     `n_sites + 1`
+  std::vector<Index> site_event_offsets;
+
+  /// \brief Number of orbits
+  Index n_orbits() const { return orbit_offsets.size() - 1; }
+
+  /// \brief Total number of events, in all orbits
+  Index n_events() const { return event_offsets.size() - 1; }
+
+  /// \brief Number of equivalent events in orbit `o`, not including
+  ///     translations
+  Index orbit_size(Index o) const {
+    return (orbit_offsets[o + 1] - orbit_offsets[o]) / n_translations;
+  }
+
+  /// \brief Number of sites in event `r`
+  Index event_size(Index r) const {
+    return event_offsets[r + 1] - event_offsets[r];
+  }
+
+  /// \brief Index of the event that is equivalent `e` of orbit `o`,
+  ///     translated by `t`
+  Index row(Index o, Index e, Index t) const {
+    return orbit_offsets[o] + e * n_translations + t;
+  }
+
+  /// \brief Orbit index of event `r`
+  Index orbit_index(Index r) const;
+
+  /// \brief Pointer to the first site index of event `r`
+  Index const *sites_begin(Index r) const {
+    return sites.data() + event_offsets[r];
+  }
+
+  /// \brief Pointer past the last site index of event `r`
+  Index const *sites_end(Index r) const {
+    return sites.data() + event_offsets[r + 1];
+  }
+
+  /// \brief Pointer to the first initial occupation value of event `r`
+  int const *occ_init_begin(Index r) const {
+    return occ_init.data() + event_offsets[r];
+  }
+
+  /// \brief Pointer to the first final occupation value of event `r`
+  int const *occ_final_begin(Index r) const {
+    return occ_final.data() + event_offsets[r];
+  }
+
+  /// \brief Pointer to the first event involving site `l`
+  Index const *site_events_begin(Index l) const {
+    return site_events.data() + site_event_offsets[l];
+  }
+
+  /// \brief Pointer past the last event involving site `l`
+  Index const *site_events_end(Index l) const {
+    return site_events.data() + site_event_offsets[l + 1];
+  }
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
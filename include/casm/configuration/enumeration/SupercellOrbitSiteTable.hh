@@ -0,0 +1,99 @@
+#ifndef CASM_config_enum_SupercellOrbitSiteTable
+#define CASM_config_enum_SupercellOrbitSiteTable
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Clusters of orbits in a supercell, as sorted linear site indices,
+///     for every (orbit, equivalent, translation)
+///
+/// A SupercellOrbitSiteTable is constructed once per supercell and set of
+/// orbits, and then used for every background configuration in that
+/// supercell, instead of converting orbits to site indices and applying
+/// supercell symmetry for each background.
+///
+/// Clusters are stored in compressed sparse row (CSR) form:
+/// - Cluster `r = row(o, e, t)` is equivalent `e` of orbit `o`, translated
+///   by supercell translation `t`
+/// - The sorted site indices of cluster `r` are
+///   `sites[cluster_offsets[r], cluster_offsets[r+1])`
+/// - Clusters of orbit `o` are `[orbit_offsets[o], orbit_offsets[o+1])`
+///
+/// Notes:
+/// - `t` indexes `supercell->unitcell_index_converter`. If
+///   `n_translations == 1`, clusters are not translated, as for
+///   local-cluster orbits.
+/// - Periodic boundary conditions may cause clusters to alias, so the same
+///   site indices may appear in more than one row.
+struct SupercellOrbitSiteTable {
+  SupercellOrbitSiteTable(
+      std::shared_ptr<Supercell const> const &_supercell,
+      std::vector<std::set<clust::IntegralCluster>> const &orbits,
+      bool include_translations = true);
+
+  /// \brief The supercell
+  std::shared_ptr<Supercell const> supercell;
+
+  /// \brief Number of translations of each equivalent cluster
+  Index n_translations;
+
+  /// \brief Sorted linear site indices of all clusters
+  std::vector<Index> sites;
+
+  /// \brief Offset of the first site of each cluster, with size
+  ///     `n_clusters() + 1`
+  std::vector<Index> cluster_offsets;
+
+  /// \brief Offset of the first cluster of each orbit, with size
+  ///     `n_orbits() + 1`
+  std::vector<Index> orbit_offsets;
+
+  /// \brief Number of orbits
+  Index n_orbits() const { return orbit_offsets.size() - 1; }
+
+  /// \brief Total number of clusters, in all orbits
+  Index n_clusters() const { return cluster_offsets.size() - 1; }
+
+  /// \brief Number of equivalent clusters in orbit `o`, not including
+  ///     translations
+  Index orbit_size(Index o) const {
+    return (orbit_offsets[o + 1] - orbit_offsets[o]) / n_translations;
+  }
+
+  /// \brief Index of the cluster that is equivalent `e` of orbit `o`,
+  ///     translated by `t`
+  Index row(Index o, Index e, Index t) const {
+    return orbit_offsets[o] + e * n_translations + t;
+  }
+
+  /// \brief Pointer to the first site index of cluster `r`
+  Index const *cluster_begin(Index r) const {
+    return sites.data() + cluster_offsets[r];
+  }
+
+  /// \brief Pointer past the last site index of cluster `r`
+  Index const *cluster_end(Index r) const {
+    return sites.data() + cluster_offsets[r + 1];
+  }
+};
+
+/// \brief Apply a symmetry operation to the clusters of a
+///     SupercellOrbitSiteTable
+SupercellOrbitSiteTable &apply(SupercellSymOp const &op,
+                               SupercellOrbitSiteTable &table);
+
+/// \brief Copy a SupercellOrbitSiteTable and apply a symmetry operation to
+///     its clusters
+SupercellOrbitSiteTable copy_apply(SupercellSymOp const &op,
+                                   SupercellOrbitSiteTable table);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -51,7 +51,7 @@ std::set<Configuration> make_distinct_background_configurations(
     std::shared_ptr<Supercell const> const &supercell,
     std::vector<Index> const &event_sites, std::vector<int> const &occ_init,
     std::vector<int> const &occ_final,
-    std::vector<SupercellSymOp> const &event_group);
+    std::vector<SupercellSymOp> const &event_group, Index n_threads = 1);
 
 }  // namespace config
 }  // namespace CASM
@@ -0,0 +1,25 @@
+#ifndef CASM_config_enum_count_occupations
+#define CASM_config_enum_count_occupations
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+struct Supercell;
+
+/// \brief Count symmetrically distinct occupations in a supercell, without
+///     enumerating them
+std::string count_distinct_occupations(
+    std::shared_ptr<Supercell const> const &supercell,
+    std::map<std::string, Index> const &occupant_counts = {},
+    Index n_threads = 0);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
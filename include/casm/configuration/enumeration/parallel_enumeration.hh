@@ -0,0 +1,71 @@
+#ifndef CASM_config_enum_parallel_enumeration
+#define CASM_config_enum_parallel_enumeration
+
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+struct Configuration;
+class ConfigurationSet;
+
+/// \brief Enumerate occupations in many background configurations, in
+///     parallel
+std::vector<Configuration> make_occupations_parallel(
+    std::vector<Configuration> const &backgrounds, bool skip_non_primitive,
+    bool skip_non_canonical, Index n_threads = 0);
+
+/// \brief Enumerate occupations in many background configurations, in
+///     parallel, and insert them into a ConfigurationSet
+void insert_occupations_parallel(ConfigurationSet &configurations,
+                                 std::vector<Configuration> const &backgrounds,
+                                 bool skip_non_primitive,
+                                 bool skip_non_canonical, Index n_threads = 0);
+
+/// \brief Estimated cost of enumerating occupations in one background
+///     configuration with `make_occupations_parallel`
+struct OccupationEnumerationEstimate {
+  /// \brief Number of sites with more than one allowed occupant
+  Index n_variable_sites = 0;
+
+  /// \brief Number of candidate occupations (the occupation counter size)
+  double n_candidates = 0.0;
+
+  /// \brief Size of the group used to check for canonical occupations, or 0
+  ///     if not skipping non-canonical configurations
+  Index group_size = 0;
+
+  /// \brief Number of tasks the candidates are split into for sampling,
+  ///     each fixing the occupants of leading sites
+  double n_tasks = 0.0;
+
+  /// \brief Number of tasks enumerated to estimate the cost
+  Index n_sampled_tasks = 0;
+
+  /// \brief Estimated number of enumerated configurations
+  double n_configurations = 0.0;
+
+  /// \brief True if `n_configurations` is exact
+  bool n_configurations_is_exact = false;
+
+  /// \brief Estimated serial enumeration time, in seconds
+  double seconds = 0.0;
+
+  /// \brief Estimated memory used to hold the enumerated configurations,
+  ///     in bytes (approximate)
+  double bytes = 0.0;
+};
+
+/// \brief Estimate the cost of `make_occupations_parallel`, by sampling,
+///     without enumerating all occupations
+std::vector<OccupationEnumerationEstimate> estimate_occupations_parallel(
+    std::vector<Configuration> const &backgrounds, bool skip_non_primitive,
+    bool skip_non_canonical, Index max_sampled_tasks = 16,
+    double max_task_candidates = 65536.0, Index n_threads = 0);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
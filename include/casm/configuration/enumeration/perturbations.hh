@@ -1,21 +1,61 @@
 #ifndef CASM_config_enum_perturbations
 #define CASM_config_enum_perturbations
 
+#include <functional>
+#include <memory>
+
+#include "casm/configuration/ProgressMonitor.hh"
 #include "casm/configuration/definitions.hh"
 
 namespace CASM {
 namespace config {
 
+class ExternalConfigurationSet;
+struct OccConfiguration;
+struct SupercellOrbitSiteTable;
+
 /// \brief Make the distinct clusters of sites, taking into account the
 ///     background configuration symmetry
 std::set<std::set<Index>> make_distinct_cluster_sites(
     Configuration const &background,
     std::vector<std::set<std::set<Index>>> const &orbits_as_indices);
 
+/// \brief Make the distinct clusters of sites, taking into account the
+///     background configuration symmetry, using a SupercellOrbitSiteTable
+std::set<std::set<Index>> make_distinct_cluster_sites(
+    Configuration const &background,
+    SupercellOrbitSiteTable const &orbit_site_table);
+
+/// \brief Call `f` with the canonical form of occupation perturbations of
+///     a background, including all distinct perturbations
+void for_each_distinct_perturbation(
+    Configuration const &background,
+    std::set<std::set<Index>> const &distinct_cluster_sites,
+    std::function<void(Configuration const &)> f,
+    std::shared_ptr<ProgressMonitor> progress = nullptr);
+
+/// \brief Call `f` with the canonical form of occupation perturbations of
+///     a background, as OccConfiguration, including all distinct
+///     perturbations
+void for_each_distinct_occ_perturbation(
+    Configuration const &background,
+    std::set<std::set<Index>> const &distinct_cluster_sites,
+    std::function<void(OccConfiguration const &)> f,
+    std::shared_ptr<ProgressMonitor> progress = nullptr);
+
 /// \brief Make configurations that are distinct occupation perturbations
 std::set<Configuration> make_distinct_perturbations(
     Configuration const &background,
-    std::set<std::set<Index>> const &distinct_cluster_sites);
+    std::set<std::set<Index>> const &distinct_cluster_sites,
+    std::shared_ptr<ProgressMonitor> progress = nullptr);
+
+/// \brief Call `f` once with each distinct periodic perturbation of a
+///     motif, as it is found
+Index for_each_distinct_periodic_perturbation(
+    Configuration const &motif,
+    SupercellOrbitSiteTable const &orbit_site_table,
+    std::function<void(Configuration const &)> f,
+    ExternalConfigurationSet &distinct);
 
 /// \brief Make the distinct clusters of sites, taking into account the
 ///     event group, supercell, and background configuration symmetry
@@ -25,6 +65,15 @@ std::set<std::set<Index>> make_distinct_local_cluster_sites(
     std::vector<SupercellSymOp> const &event_group,
     std::vector<std::set<std::set<Index>>> const &local_orbits_as_indices);
 
+/// \brief Make the distinct clusters of sites, taking into account the
+///     event group, supercell, and background configuration symmetry, using
+///     a SupercellOrbitSiteTable
+std::set<std::set<Index>> make_distinct_local_cluster_sites(
+    Configuration const &background, std::vector<Index> const &event_sites,
+    std::vector<int> const &occ_init, std::vector<int> const &occ_final,
+    std::vector<SupercellSymOp> const &event_group,
+    SupercellOrbitSiteTable const &local_orbit_site_table);
+
 /// \brief Make configurations that are distinct local occupation perturbations
 std::set<Configuration> make_distinct_local_perturbations(
     Configuration const &background, std::vector<Index> const &event_sites,
@@ -2,6 +2,7 @@
 #define CASM_group_Group
 
 #include <memory>
+#include <mutex>
 #include <set>
 
 #include "casm/configuration/group/definitions.hh"
@@ -10,6 +11,10 @@
 namespace CASM {
 namespace group {
 
+namespace Group_impl {
+struct ConjugacyClassData;
+}
+
 /// \brief Holds group elements and multiplication table
 template <typename ElementType>
 struct Group {
@@ -73,6 +78,22 @@ struct Group {
   /// \param i Element index
   /// \returns i_inv, The index of the inverse element of element i
   Index inv(Index i) const { return inverse_index[i]; }
+
+  /// \brief Conjugacy classes, as sorted element indices
+  std::vector<std::vector<Index>> const &conjugacy_classes() const;
+
+  /// \brief Conjugacy class index of each element
+  std::vector<Index> const &class_index() const;
+
+  /// \brief Number of elements in each conjugacy class
+  std::vector<Index> const &class_size() const;
+
+ private:
+  /// \brief Conjugacy class data, computed on first access and shared by
+  ///     copies
+  std::shared_ptr<Group_impl::ConjugacyClassData> m_conjugacy_class_data;
+
+  Group_impl::ConjugacyClassData const &_conjugacy_class_data() const;
 };
 
 template <typename ElementType,
@@ -100,6 +121,36 @@ namespace group {
 
 namespace Group_impl {
 
+/// \brief Conjugacy class data of a Group, computed on first access
+struct ConjugacyClassData {
+  std::once_flag once;
+  std::vector<std::vector<Index>> conjugacy_classes;
+  std::vector<Index> class_index;
+  std::vector<Index> class_size;
+};
+
+/// \brief Determine conjugacy classes, in order of their first element
+inline void _make_conjugacy_class_data(
+    MultiplicationTable const &multiplication_table,
+    std::vector<Index> const &inverse_index, ConjugacyClassData &data) {
+  Index group_size = multiplication_table.size();
+  data.class_index.assign(group_size, -1);
+  for (Index i = 0; i < group_size; i++) {
+    if (data.class_index[i] != -1) continue;
+
+    std::set<Index> curr_class;
+    for (Index j = 0; j < group_size; j++) {
+      curr_class.insert(
+          multiplication_table[j][multiplication_table[i][inverse_index[j]]]);
+    }
+    for (Index k : curr_class) {
+      data.class_index[k] = data.conjugacy_classes.size();
+    }
+    data.class_size.push_back(curr_class.size());
+    data.conjugacy_classes.emplace_back(curr_class.begin(), curr_class.end());
+  }
+}
+
 inline std::vector<Index> _identity_indices(Index n) {
   std::vector<Index> result(n);
   std::iota(result.begin(), result.end(), 0);
@@ -212,7 +263,9 @@ Group<ElementType>::Group(std::vector<ElementType> const &_element,
       element(_element),
       head_group_index(Group_impl::_identity_indices(element.size())),
       multiplication_table(_multiplication_table),
-      inverse_index(Group_impl::_make_inverse_index(multiplication_table)) {}
+      inverse_index(Group_impl::_make_inverse_index(multiplication_table)),
+      m_conjugacy_class_data(
+          std::make_shared<Group_impl::ConjugacyClassData>()) {}
 
 /// \brief Construct a subgroup
 ///
@@ -230,7 +283,9 @@ Group<ElementType>::Group(
       head_group_index(_head_group_index.begin(), _head_group_index.end()),
       multiplication_table(Group_impl::_make_subgroup_multiplication_table(
           _head_group, _head_group_index)),
-      inverse_index(Group_impl::_make_inverse_index(multiplication_table)) {}
+      inverse_index(Group_impl::_make_inverse_index(multiplication_table)),
+      m_conjugacy_class_data(
+          std::make_shared<Group_impl::ConjugacyClassData>()) {}
 
 /// \brief Construct a subgroup
 ///
@@ -251,7 +306,47 @@ Group<ElementType>::Group(
       head_group_index(_head_group_index.begin(), _head_group_index.end()),
       multiplication_table(Group_impl::_make_subgroup_multiplication_table(
           _head_group, _head_group_index)),
-      inverse_index(Group_impl::_make_inverse_index(multiplication_table)) {}
+      inverse_index(Group_impl::_make_inverse_index(multiplication_table)),
+      m_conjugacy_class_data(
+          std::make_shared<Group_impl::ConjugacyClassData>()) {}
+
+/// \brief Conjugacy classes, as sorted element indices
+///
+/// Classes are ordered by their smallest element index, as by
+/// `make_conjugacy_classes`. Computed on first access, thread-safe.
+template <typename ElementType>
+std::vector<std::vector<Index>> const &Group<ElementType>::conjugacy_classes()
+    const {
+  return _conjugacy_class_data().conjugacy_classes;
+}
+
+/// \brief Conjugacy class index of each element
+///
+/// `conjugacy_classes()[class_index()[i]]` contains element `i`. Computed on
+/// first access, thread-safe.
+template <typename ElementType>
+std::vector<Index> const &Group<ElementType>::class_index() const {
+  return _conjugacy_class_data().class_index;
+}
+
+/// \brief Number of elements in each conjugacy class
+///
+/// Computed on first access, thread-safe.
+template <typename ElementType>
+std::vector<Index> const &Group<ElementType>::class_size() const {
+  return _conjugacy_class_data().class_size;
+}
+
+template <typename ElementType>
+Group_impl::ConjugacyClassData const &
+Group<ElementType>::_conjugacy_class_data() const {
+  Group_impl::ConjugacyClassData &data = *m_conjugacy_class_data;
+  std::call_once(data.once, [&]() {
+    Group_impl::_make_conjugacy_class_data(multiplication_table,
+                                           inverse_index, data);
+  });
+  return data;
+}
 
 template <typename ElementType, typename MultiplyFunctionType,
           typename EqualToFunctionType>
@@ -283,36 +378,16 @@ Group<ElementType> make_group(std::vector<ElementType> const &element,
 
 /// \brief Determine conjugacy classes
 ///
+/// Equivalent to `group.conjugacy_classes()`, which is computed once per
+/// group and can be used without copying.
+///
 /// \returns conjugacy_classes, where conjugacy_classes[i] is a vector of
 ///     the indices of elements in class 'i'
 ///
 template <typename ElementType>
 std::vector<std::vector<Index>> make_conjugacy_classes(
     Group<ElementType> const &group) {
-  std::vector<std::vector<Index>> conjugacy_classes;
-
-  // check if operation i is in an existing class
-  auto is_in_existing_class = [&](Index i) {
-    for (auto const &cclass : conjugacy_classes) {
-      if (contains(cclass, i)) {
-        return true;
-      }
-    }
-    return false;
-  };
-
-  Index group_size = group.element.size();
-  for (Index i = 0; i < group_size; i++) {
-    if (is_in_existing_class(i)) continue;
-
-    std::set<Index> curr_class;
-    for (Index j = 0; j < group_size; j++) {
-      curr_class.insert(group.mult(j, group.mult(i, group.inv(j))));
-    }
-    conjugacy_classes.emplace_back(curr_class.begin(), curr_class.end());
-  }
-
-  return conjugacy_classes;
+  return group.conjugacy_classes();
 }
 
 }  // namespace group
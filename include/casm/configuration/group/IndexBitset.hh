@@ -0,0 +1,221 @@
+#ifndef CASM_group_IndexBitset
+#define CASM_group_IndexBitset
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/configuration/group/definitions.hh"
+
+namespace CASM {
+namespace group {
+
+/// \brief A set of indices in the range [0, size), stored as one bit per
+///     index
+///
+/// IndexBitset is used for sets of group element indices, such as
+/// subgroups and cosets, or for sets of site indices, when the range of
+/// indices is known. Membership checks are constant time, and intersection,
+/// union, and comparison operate on 64 indices at a time, which is much
+/// faster than `std::set<Index>` for large groups, such as supercell groups
+/// with (factor group size) x (number of translations) elements.
+///
+/// Notes:
+/// - Operations that combine two IndexBitset require equal `size()`.
+/// - Iterate over members using `find_first` and `find_next`, or convert
+///   using `to_vector` or `to_set`.
+class IndexBitset {
+ public:
+  typedef std::uint64_t word_type;
+
+  /// \brief Returned by `find_first` and `find_next` if no index is found
+  static constexpr Index npos = -1;
+
+  /// \brief Construct an empty set of indices in the range [0, size)
+  explicit IndexBitset(Index _size = 0)
+      : m_size(_size), m_words((_size + 63) / 64, 0) {}
+
+  /// \brief Construct a set of indices in the range [0, size), containing
+  ///     `indices`
+  template <typename IndexContainer>
+  IndexBitset(Index _size, IndexContainer const &indices) : IndexBitset(_size) {
+    for (Index i : indices) {
+      insert(i);
+    }
+  }
+
+  /// \brief Size of the range of indices
+  Index size() const { return m_size; }
+
+  /// \brief Number of indices in the set
+  Index count() const {
+    Index n = 0;
+    for (word_type w : m_words) {
+      n += __builtin_popcountll(w);
+    }
+    return n;
+  }
+
+  /// \brief Return true if the set contains no indices
+  bool empty() const {
+    for (word_type w : m_words) {
+      if (w) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Return true if the set contains index `i`
+  bool contains(Index i) const { return (m_words[i / 64] >> (i % 64)) & 1; }
+
+  /// \brief Insert index `i`, return true if it was not already in the set
+  bool insert(Index i) {
+    word_type mask = word_type(1) << (i % 64);
+    word_type &w = m_words[i / 64];
+    bool inserted = !(w & mask);
+    w |= mask;
+    return inserted;
+  }
+
+  /// \brief Erase index `i`
+  void erase(Index i) { m_words[i / 64] &= ~(word_type(1) << (i % 64)); }
+
+  /// \brief Erase all indices
+  void clear() { std::fill(m_words.begin(), m_words.end(), 0); }
+
+  /// \brief Return the smallest index in the set, or npos if empty
+  Index find_first() const { return _find_from(0); }
+
+  /// \brief Return the smallest index in the set greater than `i`, or npos
+  ///     if none
+  Index find_next(Index i) const { return _find_from(i + 1); }
+
+  /// \brief Return the indices in the set, in ascending order
+  std::vector<Index> to_vector() const {
+    std::vector<Index> indices;
+    indices.reserve(count());
+    for (Index i = find_first(); i != npos; i = find_next(i)) {
+      indices.push_back(i);
+    }
+    return indices;
+  }
+
+  /// \brief Return the indices in the set
+  std::set<Index> to_set() const {
+    std::vector<Index> indices = to_vector();
+    return std::set<Index>(indices.begin(), indices.end());
+  }
+
+  /// \brief Return true if all indices in this set are in `other`
+  bool is_subset_of(IndexBitset const &other) const {
+    _check_size(other);
+    for (Index k = 0; k < m_words.size(); ++k) {
+      if (m_words[k] & ~other.m_words[k]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Intersection
+  IndexBitset &operator&=(IndexBitset const &other) {
+    _check_size(other);
+    for (Index k = 0; k < m_words.size(); ++k) {
+      m_words[k] &= other.m_words[k];
+    }
+    return *this;
+  }
+
+  /// \brief Union
+  IndexBitset &operator|=(IndexBitset const &other) {
+    _check_size(other);
+    for (Index k = 0; k < m_words.size(); ++k) {
+      m_words[k] |= other.m_words[k];
+    }
+    return *this;
+  }
+
+  /// \brief Set difference
+  IndexBitset &operator-=(IndexBitset const &other) {
+    _check_size(other);
+    for (Index k = 0; k < m_words.size(); ++k) {
+      m_words[k] &= ~other.m_words[k];
+    }
+    return *this;
+  }
+
+  bool operator==(IndexBitset const &other) const {
+    return m_size == other.m_size && m_words == other.m_words;
+  }
+
+  bool operator!=(IndexBitset const &other) const { return !(*this == other); }
+
+  /// \brief Lexicographical comparison of the bits, for use in std::set
+  bool operator<(IndexBitset const &other) const {
+    if (m_size != other.m_size) {
+      return m_size < other.m_size;
+    }
+    return m_words < other.m_words;
+  }
+
+  /// \brief The bits, 64 indices per word, index `i` is bit `i % 64` of
+  ///     word `i / 64`
+  std::vector<word_type> const &words() const { return m_words; }
+
+ private:
+  Index _find_from(Index i) const {
+    if (i >= m_size) {
+      return npos;
+    }
+    Index k = i / 64;
+    word_type w = m_words[k] & (~word_type(0) << (i % 64));
+    while (!w) {
+      if (++k == m_words.size()) {
+        return npos;
+      }
+      w = m_words[k];
+    }
+    return 64 * k + __builtin_ctzll(w);
+  }
+
+  void _check_size(IndexBitset const &other) const {
+    if (m_size != other.m_size) {
+      throw std::runtime_error("Error in IndexBitset: size mismatch");
+    }
+  }
+
+  Index m_size;
+
+  std::vector<word_type> m_words;
+};
+
+inline IndexBitset operator&(IndexBitset A, IndexBitset const &B) {
+  return A &= B;
+}
+
+inline IndexBitset operator|(IndexBitset A, IndexBitset const &B) {
+  return A |= B;
+}
+
+inline IndexBitset operator-(IndexBitset A, IndexBitset const &B) {
+  return A -= B;
+}
+
+/// \brief Hash of IndexBitset, for use in unordered containers
+struct IndexBitsetHash {
+  std::size_t operator()(IndexBitset const &bits) const {
+    std::uint64_t hash = 14695981039346656037ULL ^ std::uint64_t(bits.size());
+    for (IndexBitset::word_type w : bits.words()) {
+      hash ^= w + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+  }
+};
+
+}  // namespace group
+}  // namespace CASM
+
+#endif
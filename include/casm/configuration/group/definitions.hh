@@ -7,6 +7,9 @@
 // - make_equivalence_map: function to construct an equivalence map
 // - make_cyclic_subgroups: function to make cyclic (small) subgroups
 // - make_all_subgroups: combines cyclic subgroups to form all subgroups
+// - SubgroupCache: memoizes subgroups by multiplication table
+// - IndexBitset: bit set of element indices, with make_closure,
+//   make_left_cosets, and make_conjugate using the multiplication table
 // - make_invariant_subgroups: make the invariant subgroup of each element of
 //   an orbit
 //
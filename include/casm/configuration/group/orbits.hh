@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <set>
+#include <utility>
 
 #include "casm/configuration/group/definitions.hh"
 
@@ -52,6 +53,73 @@ OrbitElementType make_canonical_element(OrbitElementType const &orbit_element,
   return best;
 }
 
+/// \brief Make an orbit, reusing one scratch element for the images
+///
+/// \param orbit_element One element of the orbit
+/// \param group_begin,group_end Group elements used to generate the
+///     orbit
+/// \param compare_f, Binary function used to compare orbit elements.
+/// \param apply_to_f Function used to apply group element to orbit
+///     elements, according to
+///     `apply_to_f(group_element, orbit_element, dest)`, which writes the
+///     new orbit element into `dest`
+///
+/// \returns orbit, A set containing the unique orbit elements
+///
+/// Gives the same result as `make_orbit`, but each image is written into
+/// the same scratch element and only copied into the orbit if it is new.
+/// If `apply_to_f` reuses the storage of `dest`, images that are already in
+/// the orbit do not allocate.
+template <typename OrbitElementType, typename GroupElementIt,
+          typename CompareType, typename ApplyToType>
+std::set<OrbitElementType, CompareType> make_orbit_with_scratch(
+    OrbitElementType const &orbit_element, GroupElementIt group_begin,
+    GroupElementIt group_end, CompareType compare_f, ApplyToType apply_to_f) {
+  std::set<OrbitElementType, CompareType> orbit(compare_f);
+  OrbitElementType scratch = orbit_element;
+  for (; group_begin != group_end; ++group_begin) {
+    apply_to_f(*group_begin, orbit_element, scratch);
+    auto hint = orbit.lower_bound(scratch);
+    if (hint == orbit.end() || compare_f(scratch, *hint)) {
+      orbit.emplace_hint(hint, scratch);
+    }
+  }
+  return orbit;
+}
+
+/// \brief Make the canonical element of an orbit, reusing scratch
+///     elements for the images
+///
+/// \param orbit_element One element of the orbit
+/// \param group_begin,group_end Group elements used to generate the
+///     orbit. Must not be empty.
+/// \param compare_f, Binary function used to compare orbit elements.
+/// \param apply_to_f Function used to apply group element to orbit
+///     elements, according to
+///     `apply_to_f(group_element, orbit_element, dest)`, which writes the
+///     new orbit element into `dest`
+///
+/// Gives the same result as `make_canonical_element`, but images are
+/// written into two scratch elements, which are swapped when a greater
+/// image is found. If `apply_to_f` reuses the storage of `dest`, the loop
+/// over the group does not allocate.
+template <typename OrbitElementType, typename GroupElementIt,
+          typename CompareType, typename ApplyToType>
+OrbitElementType make_canonical_element_with_scratch(
+    OrbitElementType const &orbit_element, GroupElementIt group_begin,
+    GroupElementIt group_end, CompareType compare_f, ApplyToType apply_to_f) {
+  OrbitElementType best = orbit_element;
+  apply_to_f(*group_begin++, orbit_element, best);
+  OrbitElementType test = orbit_element;
+  for (; group_begin != group_end; ++group_begin) {
+    apply_to_f(*group_begin, orbit_element, test);
+    if (compare_f(best, test)) {
+      std::swap(best, test);
+    }
+  }
+  return best;
+}
+
 template <typename OrbitElementContainer, typename GroupElementIt,
           typename CompareType, typename CopyApplyType>
 std::set<typename OrbitElementContainer::value_type, CompareType>
@@ -1,7 +1,11 @@
 #ifndef CASM_group_subgroups
 #define CASM_group_subgroups
 
+#include <map>
+#include <mutex>
+
 #include "casm/configuration/group/Group.hh"
+#include "casm/configuration/group/IndexBitset.hh"
 #include "casm/configuration/group/definitions.hh"
 
 namespace CASM {
@@ -14,10 +18,99 @@ typedef std::set<SubgroupIndices> SubgroupOrbit;
 template <typename ElementType>
 std::set<SubgroupOrbit> make_cyclic_subgroups(Group<ElementType> const &group);
 
+/// \brief Return all cyclic subgroups, using the multiplication table
+std::set<SubgroupOrbit> make_cyclic_subgroups(
+    MultiplicationTable const &multiplication_table);
+
 /// \brief Return all subgroups
 template <typename ElementType>
 std::set<SubgroupOrbit> make_all_subgroups(Group<ElementType> const &group);
 
+/// \brief Return all subgroups, using the multiplication table
+std::set<SubgroupOrbit> make_all_subgroups(
+    MultiplicationTable const &multiplication_table);
+
+/// \brief Return the index of the inverse of each group element
+std::vector<Index> make_inverse_index(
+    MultiplicationTable const &multiplication_table);
+
+/// \brief Return the subgroup generated by a set of group elements
+IndexBitset make_closure(MultiplicationTable const &multiplication_table,
+                         IndexBitset const &elements);
+
+/// \brief Return a small set of elements that generates a subgroup
+std::vector<Index> make_generators(
+    MultiplicationTable const &multiplication_table,
+    IndexBitset const &subgroup);
+
+/// \brief Return a small set of elements that generates a group
+template <typename ElementType>
+std::vector<Index> make_generators(Group<ElementType> const &group);
+
+/// \brief Return true if a set of group elements is closed under
+///     multiplication
+bool is_closed(MultiplicationTable const &multiplication_table,
+               IndexBitset const &elements);
+
+/// \brief Return the left cosets, X*subgroup, of a subgroup
+std::vector<IndexBitset> make_left_cosets(
+    MultiplicationTable const &multiplication_table,
+    IndexBitset const &subgroup);
+
+/// \brief Return the conjugate subgroup, X*subgroup*X^-1
+IndexBitset make_conjugate(MultiplicationTable const &multiplication_table,
+                           std::vector<Index> const &inverse_index,
+                           IndexBitset const &subgroup, Index X_index);
+
+/// \brief Return the normalizer of a subgroup, the elements X for which
+///     X*subgroup*X^-1 == subgroup
+IndexBitset make_normalizer(MultiplicationTable const &multiplication_table,
+                            std::vector<Index> const &inverse_index,
+                            IndexBitset const &subgroup);
+
+/// \brief Cache of subgroups, keyed by the group multiplication table
+///
+/// Subgroups, as indices of group elements, depend only on the
+/// multiplication table. They are generated once for each distinct
+/// multiplication table, and shared as immutable sets by all later
+/// requests, for example when the same factor group is used for every
+/// configuration of a project.
+///
+/// Notes:
+/// - Thread-safe. Subgroups are generated outside of the lock, so
+///   concurrent requests for the same new multiplication table may each
+///   generate the subgroups, and the first stored result is returned to all.
+class SubgroupCache {
+ public:
+  typedef std::set<SubgroupOrbit> subgroups_type;
+
+  /// \brief Return all cyclic subgroups
+  std::shared_ptr<subgroups_type const> make_cyclic_subgroups(
+      MultiplicationTable const &multiplication_table);
+
+  /// \brief Return all subgroups
+  std::shared_ptr<subgroups_type const> make_all_subgroups(
+      MultiplicationTable const &multiplication_table);
+
+  /// \brief Number of subgroup sets held in memory
+  Index size() const;
+
+  /// \brief Clear subgroups held in memory
+  void clear();
+
+ private:
+  mutable std::mutex m_mutex;
+
+  std::map<MultiplicationTable, std::shared_ptr<subgroups_type const>>
+      m_cyclic_subgroups;
+
+  std::map<MultiplicationTable, std::shared_ptr<subgroups_type const>>
+      m_all_subgroups;
+};
+
+/// \brief Process-wide SubgroupCache
+SubgroupCache &default_subgroup_cache();
+
 /// \brief Make the invariant subgroup for each orbit element, as
 ///     indices of group elements
 template <typename GroupElementType>
@@ -30,99 +123,9 @@ std::vector<SubgroupIndices> make_invariant_subgroups(
 
 // --- Implementation ---
 
-#include <numeric>
-
 namespace CASM {
 namespace group {
 
-namespace subgroups_impl {
-
-typedef std::set<Index> CosetIndices;
-
-/// \brief Return the unique left cosets of a subgroup
-///
-/// - If subgroup B of group G contains elements: (E, B1, B2, …, Bg),
-/// the "left coset” of X is (X*E, X*B1, X*B2, …, X*Bg),
-/// where X is an element of G.
-/// - A coset need not be a subgroup.
-/// - If X is an element of B, then the coset will be a subgroup of B.
-/// - Two left cosets of a given subgroup either contain exactly the same
-/// elements, or have no elements in common.
-template <typename ElementType>
-std::set<CosetIndices> _make_left_cosets(
-    Group<ElementType> const &group, SubgroupIndices const &subgroup_indices) {
-  std::set<CosetIndices> left_cosets;
-
-  // each group element is only included in one coset
-  std::vector<bool> check(group.element.size(), false);
-  Index product_index;
-  Index group_element_index = 0;
-  while (group_element_index < group.element.size()) {
-    if (check[group_element_index]) {
-      ++group_element_index;
-      continue;
-    }
-    CosetIndices left_coset;
-    for (auto subgroup_element_index : subgroup_indices) {
-      product_index = group.mult(group_element_index, subgroup_element_index);
-      left_coset.insert(product_index);
-      check[product_index] = true;
-    }
-    left_cosets.insert(left_coset);
-    ++group_element_index;
-  }
-  return left_cosets;
-}
-
-template <typename ElementType>
-SubgroupOrbit _make_subgroup_orbit(Group<ElementType> const &group,
-                                   SubgroupIndices const &subgroup) {
-  SubgroupOrbit orbit;
-  std::set<subgroups_impl::CosetIndices> left_cosets =
-      subgroups_impl::_make_left_cosets(group, subgroup);
-  for (auto const &coset : left_cosets) {
-    Index X_index = *coset.begin();
-    Index X_inv_index = group.inv(X_index);
-    SubgroupIndices equiv_subgroup;
-    for (auto const &A_index : subgroup) {
-      equiv_subgroup.insert(
-          group.mult(X_index, group.mult(A_index, X_inv_index)));
-    }
-    orbit.insert(equiv_subgroup);
-  }
-  return orbit;
-}
-
-inline std::function<bool(SubgroupIndices const &)> _make_subgroup_count(
-    std::set<SubgroupOrbit> const &subgroups) {
-  return [&](SubgroupIndices const &subgroup) {
-    for (auto const &orbit : subgroups) {
-      if (orbit.count(subgroup)) {
-        return true;
-      }
-    }
-    return false;
-  };
-}
-
-template <typename ElementType>
-std::function<void(SubgroupIndices &)> _make_close_subgroup(
-    Group<ElementType> const &group) {
-  return [&](SubgroupIndices &subgroup) {
-    std::vector<Index> vgroup(subgroup.begin(), subgroup.end());
-    for (Index i = 0; i < vgroup.size(); i++) {
-      for (Index j = 0; j < vgroup.size(); j++) {
-        Index product_index = group.mult(vgroup[i], vgroup[j]);
-        if (subgroup.insert(product_index).second) {
-          vgroup.push_back(product_index);
-        }
-      }
-    }
-  };
-}
-
-}  // namespace subgroups_impl
-
 /// \brief Return all cyclic subgroups
 ///
 /// - A cyclic subgroup, A, is the subgroup generated by repeated multiplication
@@ -137,79 +140,34 @@ std::function<void(SubgroupIndices &)> _make_close_subgroup(
 ///
 template <typename ElementType>
 std::set<SubgroupOrbit> make_cyclic_subgroups(Group<ElementType> const &group) {
-  using namespace subgroups_impl;
-
-  std::set<SubgroupOrbit> cyclic_subgroups;
-  Index group_element_index = 0;
-  while (group_element_index < group.element.size()) {
-    // Make cyclic subgroup of element `group_element_index`
-    SubgroupIndices cyclic_subgroup;
-    cyclic_subgroup.insert(group_element_index);
-    Index product_index = group_element_index;
-    while (product_index != 0) {
-      product_index = group.mult(group_element_index, product_index);
-      cyclic_subgroup.insert(product_index);
-    }
-
-    // Make orbit of subgroups equivalent to `cyclic_subgroup` && Insert orbit
-    cyclic_subgroups.insert(_make_subgroup_orbit(group, cyclic_subgroup));
-
-    ++group_element_index;
-  }
-  return cyclic_subgroups;
+  return make_cyclic_subgroups(group.multiplication_table);
 }
 
 /// \brief Return all subgroups
 ///
-/// Method:
-/// - Start with m_subgroups = m_small_subgroups, then add new subgroups by
-/// finding the closure of a union of a large_group and a small_group.
-/// - If the the new large_group is unique, add it as a large_group.
-/// - Repeat for all (large_group, small_group) pairs, until no new
-/// m_subgroups are found.
-///
-/// Note:
-/// - This is probably not the fastest algorithm, but it is complete
+/// Subgroups are found by growing subgroups one generator at a time, see
+/// `make_all_subgroups(MultiplicationTable const &)`.
 ///
 /// \param group The group to find subgroups of
 /// \returns A set of orbits of all subgroups
 ///
 template <typename ElementType>
 std::set<SubgroupOrbit> make_all_subgroups(Group<ElementType> const &group) {
-  using namespace subgroups_impl;
-  std::set<SubgroupOrbit> small_subgroups = make_cyclic_subgroups(group);
-  std::set<SubgroupOrbit> all_subgroups = small_subgroups;
-
-  // functor to close incomplete subgroup
-  auto _close_subgroup = _make_close_subgroup(group);
-
-  // functor to find if any orbit contains a particular subgroup
-  auto _subgroup_count = _make_subgroup_count(all_subgroups);
-
-  auto all_subgroups_it = all_subgroups.begin();
-  while (all_subgroups_it != all_subgroups.end()) {
-    for (auto const &small_subgroups_orbit : small_subgroups) {
-      for (auto const &small_subgroups_equiv : small_subgroups_orbit) {
-        // Combine an existing subgroup and a small (cyclic) subgroup
-        SubgroupIndices subgroup = *(all_subgroups_it->begin());
-        Index init_size = subgroup.size();
-        subgroup.insert(small_subgroups_equiv.begin(),
-                        small_subgroups_equiv.end());
-        if (subgroup.size() == init_size) continue;
-
-        // Find group closure
-        _close_subgroup(subgroup);
-
-        // If subgroup already exists in all_subgroups, continue
-        if (_subgroup_count(subgroup)) continue;
-
-        // Else, make orbit and insert
-        all_subgroups.insert(_make_subgroup_orbit(group, subgroup));
-      }
-    }
-    ++all_subgroups_it;
+  return make_all_subgroups(group.multiplication_table);
+}
+
+/// \brief Return a small set of elements that generates a group
+///
+/// \param group The group
+/// \returns Indices of generating elements of `group`, as by
+///     `make_generators(group.multiplication_table, <all elements>)`
+template <typename ElementType>
+std::vector<Index> make_generators(Group<ElementType> const &group) {
+  IndexBitset all(group.element.size());
+  for (Index i = 0; i < group.element.size(); ++i) {
+    all.insert(i);
   }
-  return all_subgroups;
+  return make_generators(group.multiplication_table, all);
 }
 
 /// \brief Make the invariant subgroup for each orbit element, as
@@ -0,0 +1,206 @@
+#ifndef CASM_config_instrumentation
+#define CASM_config_instrumentation
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Opt-in counters and timers for hot paths
+///
+/// Instrumentation is compiled in if `CASM_CONFIG_ENABLE_INSTRUMENTATION` is
+/// defined (CMake option `CASM_CONFIG_ENABLE_INSTRUMENTATION`, ON by
+/// default), and records only after `instrumentation::set_enabled(true)`.
+/// When compiled in but not enabled, each instrumentation point costs one
+/// relaxed atomic load. When not compiled in, the instrumentation macros
+/// expand to nothing.
+///
+/// Values are accumulated per thread, without locking or shared cache lines,
+/// and summed over all threads by `instrumentation::results()`.
+///
+/// Usage:
+/// \code
+/// instrumentation::reset();
+/// instrumentation::set_enabled(true);
+/// ... run code ...
+/// instrumentation::set_enabled(false);
+/// instrumentation::Results results = instrumentation::results();
+/// \endcode
+namespace instrumentation {
+
+/// \brief Counted events
+enum class Counter {
+  /// Applications of a SupercellSymOp to ConfigDoFValues
+  op_applications,
+  /// Configuration comparisons by ConfigIsEquivalent
+  comparisons,
+  /// Translation permutations constructed by SupercellTranslationTable
+  permutations_built,
+  /// Supercell constructed
+  supercells_constructed,
+  /// Configuration canonical forms made
+  canonical_forms,
+  n_counters
+};
+
+/// \brief Timed regions
+///
+/// Nested scopes with the same Timer on the same thread are timed once, by
+/// the outermost scope.
+enum class Timer {
+  /// SupercellSymInfo construction
+  supercell_sym_info,
+  /// Translation permutation construction
+  translation_permute,
+  /// make_canonical_form for Configuration
+  canonical_form,
+  /// Configuration JSON input and output
+  json_io,
+  n_timers
+};
+
+/// \brief Name of a Counter
+std::string to_string(Counter counter);
+
+/// \brief Name of a Timer
+std::string to_string(Timer timer);
+
+/// \brief Return true if instrumentation is compiled in
+bool is_compiled();
+
+/// \brief Return true if instrumentation is recording
+bool is_enabled();
+
+/// \brief Start or stop recording
+void set_enabled(bool enabled);
+
+/// \brief Set all counts and times, on all threads, to zero
+void reset();
+
+/// \brief Instrumentation results, summed over all threads
+struct Results {
+  /// Counter name -> count
+  std::map<std::string, Index> counts;
+
+  /// Timer name -> total time, in seconds
+  std::map<std::string, double> seconds;
+
+  /// Timer name -> number of timed scopes
+  std::map<std::string, Index> calls;
+};
+
+/// \brief Return instrumentation results, summed over all threads
+Results results();
+
+namespace detail {
+
+extern std::atomic<bool> enabled;
+
+constexpr int n_counters = static_cast<int>(Counter::n_counters);
+constexpr int n_timers = static_cast<int>(Timer::n_timers);
+
+/// \brief Values recorded by one thread
+///
+/// Values are only written by the owning thread. They are atomic so that
+/// `results` and `reset` may read and write them from other threads.
+struct ThreadData {
+  ThreadData();
+
+  std::array<std::atomic<Index>, n_counters> counts;
+  std::array<std::atomic<Index>, n_timers> nanoseconds;
+  std::array<std::atomic<Index>, n_timers> calls;
+
+  /// Depth of nested scopes, by Timer. Only used by the owning thread.
+  std::array<int, n_timers> depth;
+};
+
+/// \brief Return the calling thread's ThreadData
+ThreadData &thread_data();
+
+/// \brief Add to a value only written by the calling thread
+inline void add(std::atomic<Index> &value, Index increment) {
+  value.store(value.load(std::memory_order_relaxed) + increment,
+              std::memory_order_relaxed);
+}
+
+}  // namespace detail
+
+/// \brief Return true if instrumentation is recording
+inline bool is_enabled() {
+  return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/// \brief Add to a counter, if recording
+inline void count(Counter counter, Index increment = 1) {
+  if (is_enabled()) {
+    detail::add(detail::thread_data().counts[static_cast<int>(counter)],
+                increment);
+  }
+}
+
+/// \brief Times the scope it is constructed in, if recording when
+///     constructed
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Timer timer)
+      : m_timer(static_cast<int>(timer)), m_data(nullptr) {
+    if (is_enabled()) {
+      m_data = &detail::thread_data();
+      if (m_data->depth[m_timer]++ == 0) {
+        m_start = std::chrono::steady_clock::now();
+      }
+    }
+  }
+
+  ~ScopedTimer() {
+    if (m_data && --m_data->depth[m_timer] == 0) {
+      auto elapsed = std::chrono::steady_clock::now() - m_start;
+      detail::add(
+          m_data->nanoseconds[m_timer],
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count());
+      detail::add(m_data->calls[m_timer], 1);
+    }
+  }
+
+  ScopedTimer(ScopedTimer const &) = delete;
+  ScopedTimer &operator=(ScopedTimer const &) = delete;
+
+ private:
+  int m_timer;
+  detail::ThreadData *m_data;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+}  // namespace instrumentation
+}  // namespace config
+}  // namespace CASM
+
+#ifdef CASM_CONFIG_ENABLE_INSTRUMENTATION
+
+/// \brief Count one `CASM::config::instrumentation::Counter::counter` event
+#define CASM_CONFIG_COUNT(counter)             \
+  ::CASM::config::instrumentation::count(      \
+      ::CASM::config::instrumentation::Counter::counter)
+
+/// \brief Time the enclosing scope as
+///     `CASM::config::instrumentation::Timer::timer`
+#define CASM_CONFIG_SCOPED_TIMER(timer)                  \
+  ::CASM::config::instrumentation::ScopedTimer           \
+      casm_config_scoped_timer_##timer(                  \
+          ::CASM::config::instrumentation::Timer::timer)
+
+#else
+
+#define CASM_CONFIG_COUNT(counter) ((void)0)
+#define CASM_CONFIG_SCOPED_TIMER(timer) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,512 @@
+#ifndef CASM_config_ConfigurationSet_binary_io
+#define CASM_config_ConfigurationSet_binary_io
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+namespace config {
+struct Configuration;
+class ConfigurationSet;
+struct ConfigurationRecord;
+class SupercellSet;
+}  // namespace config
+
+/// \brief Write ConfigurationSet in binary columnar format
+void write_binary(config::ConfigurationSet const &configurations,
+                  std::ostream &out, bool compress = true,
+                  Index chunk_size = 1024, bool single_precision = false);
+
+/// \brief Read ConfigurationSet from binary columnar format
+void read_binary(config::SupercellSet &supercells,
+                 config::ConfigurationSet &configurations, std::istream &in);
+
+/// \brief Write configurations in binary columnar format, as they are
+///     produced
+///
+/// Writes the same format as `write_binary` (see
+/// ConfigurationSetBinaryReader), without holding the configurations in a
+/// ConfigurationSet. Each chunk block is written to a temporary file next to
+/// `path` as soon as it is full, so memory use is proportional to
+/// `chunk_size` configurations plus the names of the configurations
+/// written. Because the metadata block, which lists the names, precedes the
+/// chunk blocks, `finish` writes `path` by writing the header and metadata
+/// block and then copying the chunk blocks from the temporary file.
+///
+/// Usage:
+/// \code
+/// ConfigurationSetBinaryWriter writer(path);
+/// for (...) {
+///   writer.write(supercell_name, configuration_id, configuration);
+/// }
+/// writer.finish(next_config_id);
+/// \endcode
+///
+/// Notes:
+/// - Configurations are written in the order given. Names are not checked
+///   for duplicates.
+/// - DoF values must be in the prim basis, as in a ConfigurationSet
+/// - If `finish` is not called, the temporary file is removed on destruction
+///   and `path` is not written
+class ConfigurationSetBinaryWriter {
+ public:
+  /// \brief Constructor
+  ConfigurationSetBinaryWriter(fs::path const &_path, bool _compress = true,
+                               Index _chunk_size = 1024,
+                               bool _single_precision = false);
+
+  /// \brief Removes the temporary file
+  ~ConfigurationSetBinaryWriter();
+
+  ConfigurationSetBinaryWriter(ConfigurationSetBinaryWriter const &) = delete;
+  ConfigurationSetBinaryWriter &operator=(
+      ConfigurationSetBinaryWriter const &) = delete;
+
+  /// \brief Write one configuration
+  void write(std::string const &supercell_name,
+             std::string const &configuration_id,
+             config::Configuration const &configuration);
+
+  /// \brief Number of configurations written
+  Index size() const { return m_config_supercell_index.size(); }
+
+  /// \brief Write the file
+  void finish(std::map<std::string, Index> const &next_config_id);
+
+ private:
+  /// \brief Write the configurations held in m_chunk to the temporary file
+  void _write_chunk();
+
+  fs::path m_path;
+
+  fs::path m_chunk_path;
+
+  std::ofstream m_chunk_out;
+
+  bool m_compress;
+
+  bool m_single_precision;
+
+  Index m_chunk_size;
+
+  bool m_finished;
+
+  /// Prim basis dimension, by global DoF key
+  std::vector<std::pair<std::string, Index>> m_global_dof_dim;
+
+  /// Prim basis dimension, by local DoF key
+  std::vector<std::pair<std::string, Index>> m_local_dof_dim;
+
+  std::vector<std::string> m_supercell_names;
+
+  /// Supercell index (into m_supercell_names), by supercell name
+  std::map<std::string, Index> m_supercell_index;
+
+  /// Supercell index, by configuration index
+  std::vector<Index> m_config_supercell_index;
+
+  /// configuration_id, by configuration index
+  std::vector<std::string> m_configuration_id;
+
+  /// Configurations of the chunk not yet written
+  std::vector<config::Configuration> m_chunk;
+
+  /// Offset of each chunk block in the temporary file
+  std::vector<std::uint64_t> m_chunk_offset;
+
+  /// Bytes written to the temporary file
+  std::uint64_t m_n_chunk_bytes;
+};
+
+/// \brief Read configurations from binary columnar format, one at a time or
+///     by name
+///
+/// Binary format (all integers are unsigned 64-bit little-endian, doubles
+/// are IEEE 754 64-bit little-endian, strings are a length followed by
+/// characters):
+/// - Header: magic "CASMCSET", version, flags (bit 0: zlib compressed,
+///   bit 1: continuous DoF values stored as IEEE 754 32-bit little-endian
+///   floats), chunk_size
+/// - Metadata block: supercell names; global and local DoF keys and prim
+///   basis dimensions; next_config_id; number of configurations; the
+///   supercell index of each configuration; the configuration_id of each
+///   configuration
+/// - Chunk blocks: DoF values for `chunk_size` consecutive configurations,
+///   in columns: occupation (1 byte per site) for all configurations in the
+///   chunk, then values of each global DoF, then values of each local DoF
+/// - Chunk table: number of chunks, stream offset of each chunk block
+/// - Footer: stream offset of the chunk table, magic "CASMCSET"
+///
+/// Each block is stored as its uncompressed size, stored size, and data
+/// (compressed independently with zlib, if compressed). DoF values are
+/// stored in the prim basis.
+///
+/// Notes:
+/// - Constructing the reader reads the metadata block only, so
+///   configuration names can be listed and found without reading DoF values
+/// - Reading configurations in order reads chunks sequentially and does not
+///   require a seekable stream
+/// - Random access reads the chunk table from the footer and seeks to the
+///   chunk requested; at most one decompressed chunk is held in memory
+/// - Continuous DoF values stored as floats are promoted to double when read
+/// - The stream must remain valid for the lifetime of the reader
+class ConfigurationSetBinaryReader {
+ public:
+  /// \brief Constructor
+  ConfigurationSetBinaryReader(std::istream &in,
+                               config::SupercellSet &supercells);
+
+  /// \brief Number of configurations
+  Index size() const;
+
+  /// \brief IDs, by supercell_name, used to automatically ID new
+  ///     configurations
+  std::map<std::string, Index> const &next_config_id() const;
+
+  /// \brief Name of configuration i (i.e. "SCEL4_2_2_1_0_0_0/2")
+  std::string configuration_name(Index i) const;
+
+  /// \brief Index of configuration by name, or size() if not found
+  Index find_by_name(std::string const &configuration_name) const;
+
+  /// \brief Read configuration i
+  config::ConfigurationRecord read(Index i);
+
+ private:
+  /// \brief Read chunk c into m_chunk, if not already held
+  void _load_chunk(Index c);
+
+  std::istream &m_in;
+
+  bool m_compressed;
+
+  bool m_single_precision;
+
+  Index m_chunk_size;
+
+  std::vector<std::shared_ptr<config::Supercell const>> m_supercells;
+
+  std::vector<std::string> m_supercell_names;
+
+  /// Prim basis dimension, by global DoF key
+  std::vector<std::pair<std::string, Index>> m_global_dof_dim;
+
+  /// Prim basis dimension, by local DoF key
+  std::vector<std::pair<std::string, Index>> m_local_dof_dim;
+
+  std::map<std::string, Index> m_next_config_id;
+
+  /// Supercell index (into m_supercells), by configuration index
+  std::vector<Index> m_supercell_index;
+
+  /// configuration_id, by configuration index
+  std::vector<std::string> m_configuration_id;
+
+  /// configuration_name -> configuration index
+  std::unordered_map<std::string, Index> m_index_by_name;
+
+  /// Stream offset of the start of the binary data
+  std::streamoff m_begin;
+
+  /// Index of the next chunk in a sequential read
+  Index m_next_chunk;
+
+  /// Stream offset of each chunk block, read from the chunk table lazily
+  std::vector<std::streamoff> m_chunk_offset;
+
+  /// Index of the chunk held in m_chunk, or -1 if none
+  Index m_chunk_index;
+
+  /// Uncompressed data of chunk m_chunk_index
+  std::vector<std::uint8_t> m_chunk;
+};
+
+/// \brief Read-only, memory-mapped access to a ConfigurationSet binary file
+///
+/// The file is written by `write_binary` (see ConfigurationSetBinaryReader
+/// for the format) and mapped read-only and shared, so that processes on
+/// the same node reading the same file share one copy of its pages in the
+/// page cache, and pages are only read from disk when used.
+///
+/// Notes:
+/// - Construction reads only the header, metadata block, and footer, and
+///   sorts configuration indices by name, so configurations can be found by
+///   name or by supercell by binary search
+/// - Configurations are decoded only when read, from the mapped chunk
+///   holding them
+/// - Files written with `compress=false` are read directly from the shared
+///   pages. Compressed chunks are decompressed into private memory when
+///   read, and the most recently read chunk is kept.
+/// - `read` may be called concurrently
+/// - The file must not be modified while mapped
+class ConfigurationSetMappedReader {
+ public:
+  /// \brief Constructor
+  ConfigurationSetMappedReader(fs::path const &path,
+                               config::SupercellSet &supercells);
+
+  /// \brief Unmaps the file
+  ~ConfigurationSetMappedReader();
+
+  ConfigurationSetMappedReader(ConfigurationSetMappedReader const &) = delete;
+  ConfigurationSetMappedReader &operator=(
+      ConfigurationSetMappedReader const &) = delete;
+
+  /// \brief Number of configurations
+  Index size() const;
+
+  /// \brief True if blocks are compressed
+  bool is_compressed() const;
+
+  /// \brief True if continuous DoF values are stored as 32-bit floats
+  bool is_single_precision() const;
+
+  /// \brief IDs, by supercell_name, used to automatically ID new
+  ///     configurations
+  std::map<std::string, Index> const &next_config_id() const;
+
+  /// \brief Supercell name of configuration i
+  std::string const &supercell_name(Index i) const;
+
+  /// \brief Configuration id of configuration i
+  std::string const &configuration_id(Index i) const;
+
+  /// \brief Name of configuration i (i.e. "SCEL4_2_2_1_0_0_0/2")
+  std::string configuration_name(Index i) const;
+
+  /// \brief Configuration indices, sorted by supercell_name and then
+  ///     configuration_id
+  std::vector<Index> const &name_index() const;
+
+  /// \brief Index of configuration by name, or size() if not found
+  Index find_by_name(std::string const &configuration_name) const;
+
+  /// \brief Range `[begin, end)` of `name_index()` holding the
+  ///     configurations in a supercell
+  std::pair<Index, Index> find_by_supercell(
+      std::string const &_supercell_name) const;
+
+  /// \brief Read configuration i
+  config::ConfigurationRecord read(Index i) const;
+
+ private:
+  /// \brief Compare the name of configuration i to a name
+  int _compare(Index i, std::string const &other_supercell_name,
+               std::string const &other_configuration_id) const;
+
+  /// Start of the mapped file
+  std::uint8_t const *m_data;
+
+  /// Size of the mapped file
+  Index m_size;
+
+  bool m_compressed;
+
+  bool m_single_precision;
+
+  Index m_chunk_size;
+
+  /// Offset of the chunk table in the file
+  Index m_chunk_table_offset;
+
+  std::vector<std::shared_ptr<config::Supercell const>> m_supercells;
+
+  std::vector<std::string> m_supercell_names;
+
+  /// Prim basis dimension, by global DoF key
+  std::vector<std::pair<std::string, Index>> m_global_dof_dim;
+
+  /// Prim basis dimension, by local DoF key
+  std::vector<std::pair<std::string, Index>> m_local_dof_dim;
+
+  std::map<std::string, Index> m_next_config_id;
+
+  /// Supercell index (into m_supercells), by configuration index
+  std::vector<Index> m_supercell_index;
+
+  /// configuration_id, by configuration index
+  std::vector<std::string> m_configuration_id;
+
+  /// Configuration indices, sorted by name
+  std::vector<Index> m_name_index;
+
+  /// Protects m_chunk_index and m_chunk
+  mutable std::mutex m_chunk_mutex;
+
+  /// Index of the compressed chunk held in m_chunk, or -1 if none
+  mutable Index m_chunk_index;
+
+  /// Uncompressed data of compressed chunk m_chunk_index
+  mutable std::shared_ptr<std::vector<std::uint8_t> const> m_chunk;
+};
+
+/// \brief ConfigurationSet persisted as a binary file plus an append-only
+///     write-ahead log, so that committing new configurations costs time
+///     proportional to the number of new configurations
+///
+/// Files:
+/// - `path`: the store, written by `write_binary` (see
+///   ConfigurationSetBinaryReader for the format)
+/// - `path` + ".log": the write-ahead log
+///
+/// Log format (integers are unsigned 64-bit little-endian):
+/// - Header: magic "CASMCLOG", version, CRC-32 of the store the log
+///   follows (0 if there is no store)
+/// - Frames, one per `commit`: payload size, CRC-32 of the payload, payload.
+///   The payload holds the number of records, then for each record the
+///   supercell_name, configuration_id, and DoF values (occupation as 1
+///   byte per site, then values of each global DoF, then each local DoF, in
+///   the prim basis), and then whether next_config_id is replaced, and the
+///   next_config_id entries that changed.
+///
+/// Inserted configurations are held in memory in a ConfigurationSet
+/// (`data()`) and are pending until `commit` appends them, with the
+/// changed next_config_id entries, to the log as one frame, and flushes it
+/// to disk with `fsync`. When the log holds at least `min_compaction_size`
+/// records and at least `compaction_ratio` times the number of records in
+/// the store, `commit` compacts: the whole set is written to a temporary
+/// file, flushed, and renamed over the store, and then the log is reset to
+/// a header with the new store's checksum. So compaction costs time
+/// proportional to the size of the set, but happens only after a number
+/// of commits proportional to it.
+///
+/// Recovery, on construction: the store is read, if it exists, and then
+/// each complete log frame with a valid checksum is replayed in order. A
+/// frame that is incomplete or has an invalid checksum, as left by a crash
+/// during `commit`, and anything after it, is discarded and truncated from
+/// the log, so each commit is applied entirely or not at all. If the store
+/// checksum in the log header does not match the store, as left by a crash
+/// during compaction after renaming, the log is already included in the
+/// store and is reset.
+///
+/// Notes:
+/// - Configurations are only added; there is no erase
+/// - Configurations must be in canonical supercells, as for
+///   ConfigurationSet, and have DoF values in the prim basis
+/// - Uncommitted configurations are lost on destruction
+/// - Only one PersistentConfigurationSet may use a path at a time
+/// - Not thread safe
+class PersistentConfigurationSet {
+ public:
+  /// \brief Constructor, opens or creates the store and log and recovers
+  PersistentConfigurationSet(fs::path const &_path,
+                             config::SupercellSet &_supercells,
+                             bool _compress = true,
+                             Index _min_compaction_size = 10000,
+                             double _compaction_ratio = 1.0);
+
+  /// \brief Closes the log, without committing
+  ~PersistentConfigurationSet();
+
+  PersistentConfigurationSet(PersistentConfigurationSet const &) = delete;
+  PersistentConfigurationSet &operator=(PersistentConfigurationSet const &) =
+      delete;
+
+  /// \brief The configurations, including uncommitted configurations
+  config::ConfigurationSet const &data() const;
+
+  /// \brief Insert Configuration, setting supercell_name and
+  ///     configuration_id automatically
+  std::pair<config::ConfigurationRecord const *, bool> insert(
+      config::Configuration const &configuration);
+
+  /// \brief Insert ConfigurationRecord, allowing custom configuration_id
+  std::pair<config::ConfigurationRecord const *, bool> insert(
+      config::ConfigurationRecord const &record);
+
+  /// \brief Set IDs, by supercell_name, used to automatically ID new
+  ///     configurations
+  void set_next_config_id(std::map<std::string, Index> const &next_config_id);
+
+  /// \brief Append pending configurations and next_config_id changes to the
+  ///     log, and compact if the log is large enough
+  void commit();
+
+  /// \brief Commit, then write all configurations to the store and truncate
+  ///     the log
+  void compact();
+
+  /// \brief Number of configurations inserted but not committed
+  Index n_pending() const { return m_pending.size(); }
+
+  /// \brief Number of configurations in the log
+  Index n_logged() const { return m_n_logged; }
+
+  /// \brief Number of configurations in the store
+  Index n_stored() const { return m_n_stored; }
+
+  /// \brief Path of the store
+  fs::path const &path() const { return m_path; }
+
+  /// \brief Path of the write-ahead log
+  fs::path const &log_path() const { return m_log_path; }
+
+ private:
+  /// \brief Replay the log, truncating an incomplete or invalid tail
+  void _recover_log(std::uint64_t store_crc);
+
+  /// \brief Replay one frame payload
+  void _replay(std::vector<std::uint8_t> const &payload);
+
+  /// \brief Truncate the log and write a header for store checksum
+  ///     `store_crc`
+  void _reset_log(std::uint64_t store_crc);
+
+  /// \brief Write all configurations to the store and reset the log
+  void _write_store();
+
+  /// \brief Record a successful insert as pending
+  std::pair<config::ConfigurationRecord const *, bool> _pending(
+      std::pair<config::ConfigurationRecord const *, bool> result);
+
+  fs::path m_path;
+
+  fs::path m_log_path;
+
+  config::SupercellSet &m_supercells;
+
+  bool m_compress;
+
+  Index m_min_compaction_size;
+
+  double m_compaction_ratio;
+
+  std::unique_ptr<config::ConfigurationSet> m_configurations;
+
+  /// Prim basis dimension, by global DoF key
+  std::vector<std::pair<std::string, Index>> m_global_dof_dim;
+
+  /// Prim basis dimension, by local DoF key
+  std::vector<std::pair<std::string, Index>> m_local_dof_dim;
+
+  /// Inserted records not yet committed
+  std::vector<config::ConfigurationRecord const *> m_pending;
+
+  /// Supercell names with next_config_id changed since the last commit
+  std::set<std::string> m_changed_next_config_id;
+
+  /// True if next_config_id was replaced since the last commit
+  bool m_replace_next_config_id;
+
+  /// File descriptor of the log, open for appending
+  int m_log_fd;
+
+  Index m_n_logged;
+
+  Index m_n_stored;
+};
+
+}  // namespace CASM
+
+#endif
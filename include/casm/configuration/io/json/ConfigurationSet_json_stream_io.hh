@@ -0,0 +1,152 @@
+#ifndef CASM_config_ConfigurationSet_json_stream_io
+#define CASM_config_ConfigurationSet_json_stream_io
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+
+namespace config {
+struct ConfigurationRecord;
+class ConfigurationSet;
+struct SupercellRecord;
+class SupercellSet;
+}  // namespace config
+
+/// \brief Read ConfigurationSet from JSON, one configuration at a time
+void read_json_stream(config::SupercellSet &supercells,
+                      config::ConfigurationSet &configurations,
+                      std::istream &in);
+
+/// \brief Read ConfigurationSet JSON, one configuration at a time
+///
+/// Reads the format written by `to_json(config::ConfigurationSet const &,
+/// jsonParser &, bool)` without constructing a jsonParser for the whole
+/// document. The stream is scanned incrementally, and only the JSON of one
+/// configuration at a time is parsed, so memory use while reading is
+/// proportional to the size of one configuration. Each configuration is
+/// validated as by `from_json(config::SupercellSet &,
+/// config::ConfigurationSet &, jsonParser const &, ...)`.
+///
+/// Usage:
+/// \code
+/// ConfigurationSetJsonStreamReader reader(in, supercells);
+/// while (auto record = reader.read()) {
+///   ... use *record ...
+/// }
+/// configurations.set_next_config_id(reader.next_config_id());
+/// \endcode
+///
+/// Notes:
+/// - Supercells are added to `supercells`, by name, as they are reached
+/// - If the stream is seekable, "version", "basis", and "config_id" are read
+///   on construction, wherever they are in the document. Otherwise, they are
+///   read as they are reached, and if "basis" is "prim" it must precede
+///   "supercells".
+/// - "version" is checked on construction if it can be, and otherwise when
+///   the end of the document is reached
+/// - The stream must remain valid for the lifetime of the reader
+class ConfigurationSetJsonStreamReader {
+ public:
+  /// \brief Constructor
+  ConfigurationSetJsonStreamReader(std::istream &in,
+                                   config::SupercellSet &supercells);
+
+  /// \brief Read the next configuration, return nullptr if there are no more
+  ///     configurations
+  std::unique_ptr<config::ConfigurationRecord> read();
+
+  /// \brief Number of configurations read
+  Index index() const { return m_index; }
+
+  /// \brief True if DoF values are read from the prim basis
+  bool read_prim_basis() const { return m_read_prim_basis; }
+
+  /// \brief IDs, by supercell_name, used to automatically ID new
+  ///     configurations
+  ///
+  /// Complete on construction if the stream is seekable, and otherwise
+  /// after `read` returns nullptr.
+  std::map<std::string, Index> const &next_config_id() const {
+    return m_next_config_id;
+  }
+
+ private:
+  enum class State { supercells, configurations, finished };
+
+  /// \brief Read top-level members until "supercells" is reached
+  void _find_supercells(bool handle_members);
+
+  /// \brief Read the top-level members after "supercells" and check the
+  ///     document
+  void _finish();
+
+  /// \brief Read the value of a top-level member other than "supercells"
+  void _read_member(std::string const &key);
+
+  /// \brief Throw if "version" is not "1.0"
+  void _check_version() const;
+
+  /// \brief Return true if there is another member in the current object,
+  ///     reading the separating ',' if necessary
+  bool _next_member(bool &first);
+
+  /// \brief Read an object key and the following ':'
+  std::string _read_key();
+
+  /// \brief Read a JSON string
+  std::string _read_string();
+
+  /// \brief Read a JSON value, appending its text to raw if not nullptr
+  void _read_value(std::string *raw);
+
+  /// \brief Read the rest of a JSON string, after the opening '"'
+  void _read_string_tail(std::string *raw);
+
+  /// \brief Skip whitespace and return the next character without reading it
+  int _peek();
+
+  /// \brief Read the expected character, or throw
+  void _expect(char c);
+
+  std::istream &m_in;
+
+  config::SupercellSet &m_supercells;
+
+  State m_state;
+
+  /// Top-level members were already read by the scan on construction
+  bool m_prescanned;
+
+  bool m_read_prim_basis;
+
+  /// "version" value, or empty if not yet read
+  std::string m_version;
+
+  std::map<std::string, Index> m_next_config_id;
+
+  bool m_first_supercell;
+
+  bool m_first_configuration;
+
+  bool m_first_member;
+
+  /// Current supercell name
+  std::string m_supercell_name;
+
+  /// Current supercell
+  config::SupercellRecord const *m_supercell_record;
+
+  Index m_index;
+
+  /// Text of the current configuration's JSON value
+  std::string m_raw;
+};
+
+}  // namespace CASM
+
+#endif
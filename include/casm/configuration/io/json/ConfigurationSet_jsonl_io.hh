@@ -0,0 +1,98 @@
+#ifndef CASM_config_ConfigurationSet_jsonl_io
+#define CASM_config_ConfigurationSet_jsonl_io
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+
+namespace config {
+struct Configuration;
+struct ConfigurationRecord;
+class SupercellSet;
+}  // namespace config
+
+/// \brief Write configurations in JSON Lines format, one configuration at a
+///     time
+///
+/// Each configuration is written on a single line, as it is given, as the
+/// object
+///
+///     {"supercell_name": <name>, "configuration_id": <id>, "dof": <dof>}
+///
+/// where "dof" is written as in a ConfigurationSet JSON document, so memory
+/// use does not depend on the number of configurations written.
+///
+/// Notes:
+/// - DoF values are written in the standard basis, unless
+///   `write_prim_basis` is true. The reader must use the same basis.
+/// - The stream must remain valid for the lifetime of the writer
+class ConfigurationJsonLinesWriter {
+ public:
+  /// \brief Constructor
+  ConfigurationJsonLinesWriter(std::ostream &out,
+                               bool write_prim_basis = false);
+
+  /// \brief Write one configuration
+  void write(std::string const &supercell_name,
+             std::string const &configuration_id,
+             config::Configuration const &configuration);
+
+  /// \brief Write one configuration
+  void write(config::ConfigurationRecord const &record);
+
+  /// \brief Number of configurations written by this writer
+  Index n_written() const { return m_n_written; }
+
+ private:
+  std::ostream &m_out;
+
+  bool m_write_prim_basis;
+
+  Index m_n_written;
+};
+
+/// \brief Read configurations in JSON Lines format, one configuration at a
+///     time
+///
+/// Reads the format written by ConfigurationJsonLinesWriter.
+///
+/// Notes:
+/// - Supercells are added to `supercells`, by name, as they are reached
+/// - Empty lines are skipped
+/// - The stream must remain valid for the lifetime of the reader
+class ConfigurationJsonLinesReader {
+ public:
+  /// \brief Constructor
+  ConfigurationJsonLinesReader(std::istream &in,
+                               config::SupercellSet &supercells,
+                               bool read_prim_basis = false);
+
+  /// \brief Read the next configuration, return nullptr if there are no more
+  ///     configurations
+  std::unique_ptr<config::ConfigurationRecord> read();
+
+  /// \brief Number of configurations read
+  Index index() const { return m_index; }
+
+ private:
+  /// \brief Read the next non-empty line, return false if none
+  bool _next_line();
+
+  std::istream &m_in;
+
+  config::SupercellSet &m_supercells;
+
+  bool m_read_prim_basis;
+
+  Index m_index;
+
+  std::string m_line;
+};
+
+}  // namespace CASM
+
+#endif
@@ -1,16 +1,20 @@
 #ifndef CASM_config_Configuration_json_io
 #define CASM_config_Configuration_json_io
 
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 
 namespace CASM {
 namespace config {
 struct Configuration;
+struct ConfigurationRecord;
 struct ConfigurationWithProperties;
 class ConfigurationSet;
 struct Prim;
+struct Supercell;
 class SupercellSet;
 }  // namespace config
 
@@ -25,6 +29,12 @@ void from_json(config::SupercellSet &supercells,
 jsonParser &to_json(config::ConfigurationSet const &configurations,
                     jsonParser &json, bool write_prim_basis = false);
 
+/// \brief Read one configuration of a ConfigurationSet from JSON
+config::ConfigurationRecord make_configuration_record(
+    jsonParser const &json, std::string const &supercell_name,
+    std::shared_ptr<config::Supercell const> const &supercell,
+    std::string const &configuration_id, bool read_prim_basis);
+
 template <typename T>
 struct jsonConstructor;
 template <typename T>
@@ -57,6 +67,15 @@ struct jsonMake<config::Configuration> {
 jsonParser &to_json(config::Configuration const &configuration,
                     jsonParser &json, bool write_prim_basis = false);
 
+/// \brief Append Configuration JSON text to a string, without constructing
+///     a jsonParser
+void write_json(config::Configuration const &configuration, std::string &out);
+
+/// \brief Write Configuration JSON text to a stream, without constructing
+///     a jsonParser
+void write_json(config::Configuration const &configuration,
+                std::ostream &out);
+
 /// Parser Configuration from JSON with error messages
 void parse(InputParser<config::Configuration> &parser,
            std::shared_ptr<config::Prim const> const &prim);
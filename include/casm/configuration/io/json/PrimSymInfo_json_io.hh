@@ -0,0 +1,31 @@
+#ifndef CASM_config_PrimSymInfo_json_io
+#define CASM_config_PrimSymInfo_json_io
+
+namespace CASM {
+
+namespace config {
+struct PrimSymInfo;
+}
+
+namespace xtal {
+class BasicStructure;
+}
+
+template <typename T>
+struct jsonConstructor;
+class jsonParser;
+
+/// \brief Write PrimSymInfo to JSON
+jsonParser &to_json(config::PrimSymInfo const &prim_sym_info,
+                    jsonParser &json);
+
+template <>
+struct jsonConstructor<config::PrimSymInfo> {
+  /// \brief Construct PrimSymInfo from JSON
+  static config::PrimSymInfo from_json(jsonParser const &json,
+                                       xtal::BasicStructure const &prim);
+};
+
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef CASM_irreps_CharacterTable
+#define CASM_irreps_CharacterTable
+
+#include <complex>
+
+#include "casm/configuration/irreps/definitions.hh"
+
+namespace CASM {
+namespace irreps {
+
+/// \brief Character table of a finite group
+struct CharacterTable {
+  /// \brief Conjugacy classes, as vectors of group element indices
+  std::vector<std::vector<Index>> conjugacy_classes;
+
+  /// \brief Conjugacy class index of each group element
+  std::vector<Index> class_index;
+
+  /// \brief Irreducible characters
+  ///
+  /// characters(i, c) is the character of irrep i for the elements of
+  /// conjugacy class c. Irreps are ordered by dimension, with identity
+  /// first.
+  Eigen::MatrixXcd characters;
+
+  /// \brief Dimension of each irrep
+  std::vector<Index> irrep_dim;
+
+  /// \brief Number of group elements
+  Index group_size() const { return class_index.size(); }
+
+  /// \brief Number of irreps (equal to the number of conjugacy classes)
+  Index n_irreps() const { return irrep_dim.size(); }
+
+  /// \brief Character of irrep `irrep_index` for a group element
+  std::complex<double> character(Index irrep_index, Index element_index) const {
+    return characters(irrep_index, class_index[element_index]);
+  }
+};
+
+/// \brief Make the character table of a finite group
+CharacterTable make_character_table(
+    std::vector<std::vector<Index>> const &multiplication_table,
+    std::vector<std::vector<Index>> const &conjugacy_classes);
+
+}  // namespace irreps
+}  // namespace CASM
+
+#endif
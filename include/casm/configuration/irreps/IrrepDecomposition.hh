@@ -4,6 +4,8 @@
 #include <optional>
 
 #include "casm/casm_io/Log.hh"
+#include "casm/configuration/ProgressMonitor.hh"
+#include "casm/configuration/irreps/CharacterTable.hh"
 #include "casm/configuration/irreps/definitions.hh"
 
 namespace CASM {
@@ -65,21 +67,46 @@ struct IrrepDecomposition {
       Eigen::MatrixXd const &_init_subspace,
       std::function<GroupIndicesOrbitSet()> make_cyclic_subgroups_f,
       std::function<GroupIndicesOrbitSet()> make_all_subgroups_f,
-      bool allow_complex, std::optional<Log> _log = std::nullopt);
+      bool allow_complex, std::optional<Log> _log = std::nullopt,
+      std::shared_ptr<CharacterTable const> _character_table = nullptr,
+      std::vector<Eigen::MatrixXd> const &_invariant_blocks = {},
+      std::shared_ptr<config::ProgressMonitor> _progress = nullptr,
+      Index _n_threads = 1);
+
+  /// IrrepDecomposition constructor, using a sparse full space matrix rep
+  IrrepDecomposition(
+      SparseMatrixRep const &_sparse_fullspace_rep,
+      GroupIndices const &_head_group, Eigen::MatrixXd const &_init_subspace,
+      std::function<GroupIndicesOrbitSet()> make_cyclic_subgroups_f,
+      std::function<GroupIndicesOrbitSet()> make_all_subgroups_f,
+      bool allow_complex, std::optional<Log> _log = std::nullopt,
+      std::shared_ptr<CharacterTable const> _character_table = nullptr,
+      std::vector<Eigen::MatrixXd> const &_invariant_blocks = {},
+      std::shared_ptr<config::ProgressMonitor> _progress = nullptr,
+      Index _n_threads = 1);
 
   /// Full space matrix representation
   ///
   /// fullspace_rep[i].rows() == full space dimension
   /// fullspace_rep[i].cols() == full space dimension
+  ///
+  /// Empty if constructed with a sparse full space matrix representation.
   MatrixRep fullspace_rep;
 
+  /// Sparse full space matrix representation
+  ///
+  /// Empty unless constructed with a sparse full space matrix
+  /// representation.
+  SparseMatrixRep sparse_fullspace_rep;
+
   /// Group (as indices into fullspace_rep) used to find irreps
   GroupIndices head_group;
 
   /// Space in which to find irreducible subspaces. This space is formed by
   /// expanding `init_subspace`, if necessary, by application of `rep` and
   /// orthogonalization to form an invariant subspace (i.e. column space does
-  /// not change upon application of elements in head_group)
+  /// not change upon application of elements in head_group). If constructed
+  /// with invariant blocks, this is the blocks, concatenated.
   ///
   /// subspace.rows() == full space dimension
   /// subspace.cols() == dimension of invariant subspace
@@ -100,8 +127,47 @@ struct IrrepDecomposition {
 
   /// If provided, log progress
   std::optional<Log> log;
+
+  /// If not null, irreps are found using character projection operators
+  /// constructed from this character table of the group `head_group`.
+  /// Otherwise, irreps are found using the commuter method.
+  std::shared_ptr<CharacterTable const> character_table;
+
+  /// If provided, report progress, as the number of subspace dimensions
+  /// decomposed, and allow cancellation
+  std::shared_ptr<config::ProgressMonitor> progress;
+
+  /// Number of threads used to symmetrize irreps. If <= 0, uses
+  /// `config::default_n_threads()`. Results do not depend on the number of
+  /// threads.
+  Index n_threads;
+
+ private:
+  template <typename RepType>
+  void _decompose(RepType const &rep, Eigen::MatrixXd const &init_subspace,
+                  std::vector<Eigen::MatrixXd> const &invariant_blocks,
+                  std::function<GroupIndicesOrbitSet()> make_cyclic_subgroups_f,
+                  std::function<GroupIndicesOrbitSet()> make_all_subgroups_f,
+                  bool allow_complex);
+
+  template <typename RepType>
+  void _decompose_block(
+      RepType const &rep, Eigen::MatrixXd const &block,
+      std::function<GroupIndicesOrbitSet()> make_cyclic_subgroups_f,
+      std::function<GroupIndicesOrbitSet()> make_all_subgroups_f,
+      bool allow_complex);
 };
 
+/// \brief Return the full space matrix representation of one element
+Eigen::MatrixXd make_fullspace_matrix(
+    IrrepDecomposition const &irrep_decomposition, Index element_index);
+
+/// \brief Apply the full space matrix representation of one element to the
+///     columns of a matrix
+Eigen::MatrixXd apply_fullspace_rep(
+    IrrepDecomposition const &irrep_decomposition, Index element_index,
+    Eigen::MatrixXd const &M);
+
 }  // namespace irreps
 }  // namespace CASM
 
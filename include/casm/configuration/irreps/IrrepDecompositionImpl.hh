@@ -1,6 +1,7 @@
 #ifndef CASM_irreps_IrrepDecompositionImpl
 #define CASM_irreps_IrrepDecompositionImpl
 
+#include "casm/configuration/irreps/CharacterTable.hh"
 #include "casm/configuration/irreps/IrrepDecomposition.hh"
 
 namespace CASM {
@@ -11,11 +12,14 @@ namespace IrrepDecompositionImpl {
 
 /// Counts over pairs of columns (i,j), where j>=i, and phase=[1, i]
 /// - skips i==j when phase==i
+/// - for a real kernel, only phase=1 is counted
 struct CommuterParamsCounter {
   CommuterParamsCounter();
 
   void reset(Eigen::MatrixXcd const &kernel);
 
+  void reset(Eigen::MatrixXd const &kernel);
+
   bool valid() const;
 
   bool increment();
@@ -28,6 +32,7 @@ struct CommuterParamsCounter {
   bool m_valid;
   Index m_max_cols;
   Index m_phase_index;  // 0: 1+0i,  1: 0+i
+  Index m_n_phases;     // 2: complex kernel, 1: real kernel
 };
 
 Eigen::MatrixXcd make_commuter(CommuterParamsCounter const &params,
@@ -35,6 +40,11 @@ Eigen::MatrixXcd make_commuter(CommuterParamsCounter const &params,
                                GroupIndices const &head_group,
                                Eigen::MatrixXcd const &kernel);
 
+Eigen::MatrixXd make_commuter(CommuterParamsCounter const &params,
+                              MatrixRep const &rep,
+                              GroupIndices const &head_group,
+                              Eigen::MatrixXd const &kernel);
+
 Eigen::MatrixXcd make_kernel(Eigen::MatrixXcd const &subspace);
 Eigen::MatrixXd make_kernel(Eigen::MatrixXd const &subspace);
 
@@ -46,6 +56,10 @@ Eigen::MatrixXcd make_irrep_subspace(Eigen::MatrixXcd const &KV_matrix,
                                      Index begin, Index end,
                                      bool allow_complex);
 
+/// Make an irreducible subspace, for a real (K * V) matrix
+Eigen::MatrixXd make_irrep_subspace(Eigen::MatrixXd const &KV_matrix,
+                                    Index begin, Index end);
+
 /// Calculate character for all matrices in rep
 Eigen::VectorXcd make_characters(std::vector<Eigen::MatrixXcd> const &rep);
 
@@ -56,10 +70,18 @@ Eigen::VectorXd make_characters(std::vector<Eigen::MatrixXd> const &rep);
 bool make_is_block_diagonal(std::vector<Eigen::MatrixXcd> const &rep,
                             Index begin, Index end, double tol);
 
+/// Check if approximately zero outside block along diagonal
+bool make_is_block_diagonal(std::vector<Eigen::MatrixXd> const &rep,
+                            Index begin, Index end, double tol);
+
 /// Find characters for block in range [begin, end)
 Eigen::VectorXcd make_irrep_characters(std::vector<Eigen::MatrixXcd> const &rep,
                                        Index begin, Index end);
 
+/// Find characters for block in range [begin, end)
+Eigen::VectorXd make_irrep_characters(std::vector<Eigen::MatrixXd> const &rep,
+                                      Index begin, Index end);
+
 double make_squared_norm(Eigen::VectorXcd const &characters);
 
 double make_squared_norm(Eigen::VectorXd const &characters);
@@ -72,6 +94,10 @@ Eigen::MatrixXcd normalize_commuter(Eigen::MatrixXcd const &commuter);
 bool is_extended_by(Eigen::MatrixXcd const &space_A,
                     Eigen::MatrixXcd const &space_B);
 
+/// Return true if space_A is extended by space_B
+bool is_extended_by(Eigen::MatrixXd const &space_A,
+                    Eigen::MatrixXd const &space_B);
+
 /// Return matrix combining columns of space_A and space_B
 Eigen::MatrixXcd extend(Eigen::MatrixXcd const &space_A,
                         Eigen::MatrixXcd const &space_B);
@@ -95,6 +121,13 @@ struct PossibleIrrep {
                 Index _head_group_size, double _tol, bool allow_complex,
                 Index _begin, Index _end);
 
+  /// \brief Constructor, for a real (K * V) matrix and real transformed
+  ///     rep
+  PossibleIrrep(Eigen::VectorXd const &eigenvalues,
+                Eigen::MatrixXd const &KV_matrix,
+                std::vector<Eigen::MatrixXd> const &transformed_rep,
+                Index _head_group_size, double _tol, Index _begin, Index _end);
+
   Index head_group_size;
   double tol;
   Index begin;      /// col index in eigenvalues/eigvectors for this irrep
@@ -124,7 +157,16 @@ struct PossibleIrrep {
 /// and construct possible irreps
 std::vector<PossibleIrrep> make_possible_irreps(
     Eigen::MatrixXcd const &commuter, Eigen::MatrixXcd const &kernel,
-    MatrixRep const &rep, GroupIndices const &head_group, bool allow_complex);
+    MatrixRep const &rep, GroupIndices const &head_group, double is_irrep_tol,
+    bool allow_complex);
+
+/// Given a new real commuter matrix,
+/// perform eigenvalue decomposition,
+/// and construct possible irreps
+std::vector<PossibleIrrep> make_possible_irreps(
+    Eigen::MatrixXd const &commuter, Eigen::MatrixXd const &kernel,
+    MatrixRep const &rep, GroupIndices const &head_group,
+    double is_irrep_tol);
 
 /// Make a vector of IrrepInfo from PossibleIrreps
 std::vector<IrrepInfo> make_irrep_info(std::set<PossibleIrrep> const &irreps);
@@ -155,10 +197,29 @@ IrrepInfo make_dummy_irrep_info(Eigen::MatrixXcd const &trans_mat);
 /// equals the group size
 bool is_irrep(MatrixRep const &rep, GroupIndices const &head_group);
 
+/// \brief Frobenius-Schur indicator of a representation
+double make_frobenius_schur_indicator(MatrixRep const &rep,
+                                      GroupIndices const &head_group);
+
+/// \brief Return true if the Frobenius-Schur indicator allows all irreps of
+///     a representation to be of real type
+bool allows_real_irreps(MatrixRep const &rep, GroupIndices const &head_group);
+
+/// Finds irreducible subspaces of real type, in real arithmetic
+std::vector<IrrepInfo> real_irrep_decomposition(
+    MatrixRep const &rep, GroupIndices const &head_group,
+    std::shared_ptr<config::ProgressMonitor> progress = nullptr);
+
 /// Finds irreducible subspaces that comprise an underlying subspace
-std::vector<IrrepInfo> irrep_decomposition(MatrixRep const &rep,
-                                           GroupIndices const &head_group,
-                                           bool allow_complex);
+std::vector<IrrepInfo> irrep_decomposition(
+    MatrixRep const &rep, GroupIndices const &head_group, bool allow_complex,
+    std::shared_ptr<config::ProgressMonitor> progress = nullptr);
+
+/// Finds irreducible subspaces using character projection operators
+std::vector<IrrepInfo> irrep_decomposition(
+    MatrixRep const &rep, GroupIndices const &head_group,
+    CharacterTable const &character_table, bool allow_complex,
+    std::shared_ptr<config::ProgressMonitor> progress = nullptr);
 
 /// Convert irreps generated for a subspace to full space dimension
 std::vector<IrrepInfo> make_fullspace_irreps(
@@ -170,17 +231,27 @@ Eigen::MatrixXd make_invariant_space(MatrixRep const &rep,
                                      GroupIndices const &head_group,
                                      Eigen::MatrixXd const &subspace);
 
+/// Expand subspace by application of group, and orthogonalize
+Eigen::MatrixXd make_invariant_space(SparseMatrixRep const &rep,
+                                     GroupIndices const &head_group,
+                                     Eigen::MatrixXd const &subspace);
+
 /// \brief Create the subspace rep from the fullspace rep
 MatrixRep make_subspace_rep(MatrixRep const &fullspace_rep,
                             Eigen::MatrixXd const &subspace);
 
+/// \brief Create the subspace rep from the sparse fullspace rep
+MatrixRep make_subspace_rep(SparseMatrixRep const &fullspace_rep,
+                            Eigen::MatrixXd const &subspace);
+
 /// \brief Symmetrize IrrepInfo, by finding high symmetry directions and
 /// aligning the irrep subspace basis with those directions
 std::vector<IrrepInfo> symmetrize_irreps(
     MatrixRep const &subspace_rep, GroupIndices const &head_group,
     std::vector<IrrepInfo> const &irreps,
     std::function<GroupIndicesOrbitSet()> make_cyclic_subgroups_f,
-    std::function<GroupIndicesOrbitSet()> make_all_subgroups_f);
+    std::function<GroupIndicesOrbitSet()> make_all_subgroups_f,
+    Index n_threads = 1);
 
 }  // namespace IrrepDecompositionImpl
 
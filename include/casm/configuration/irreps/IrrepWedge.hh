@@ -53,12 +53,12 @@ SubWedge make_dummy_subwedge(Eigen::MatrixXd const &axes);
 
 /// Make IrrepWedges from an IrrepDecomposition
 std::vector<IrrepWedge> make_irrep_wedges(
-    IrrepDecomposition const &irrep_decomposition);
+    IrrepDecomposition const &irrep_decomposition, Index n_threads = 1);
 
 /// \brief Find full irreducible wedge of a group-represented vector space, as
 /// a vector of SubWedges, from an IrrepDecomposition
 std::vector<SubWedge> make_symrep_subwedges(
-    IrrepDecomposition const &irrep_decomposition);
+    IrrepDecomposition const &irrep_decomposition, Index n_threads = 1);
 
 }  // namespace irreps
 }  // namespace CASM
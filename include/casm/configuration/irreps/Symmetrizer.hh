@@ -1,18 +1,78 @@
 #ifndef CASM_irreps_Symmetrizer
 #define CASM_irreps_Symmetrizer
 
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
 #include "casm/configuration/irreps/definitions.hh"
 
 namespace CASM {
 namespace irreps {
 
+/// \brief Reynolds operators of subgroups, shared by the high-symmetry
+///     direction searches of all irreps of one matrix representation
+///
+/// For each orbit of subgroups (subgroups related by conjugation by a
+/// group element), `make_irrep_special_directions` uses the Reynolds
+/// operator, `R = sum_{h in H} rep[h]`, of one representative subgroup,
+/// `H`, the first in the orbit. The directions invariant to the conjugate
+/// subgroups are obtained from it by application of the group. The
+/// Reynolds operators do not depend on the irrep, so SubgroupProjectors
+/// constructs them once, on first use, and re-uses them for each irrep.
+/// Operators of cyclic subgroups are re-used for the all subgroups search.
+///
+/// Not thread-safe.
+class SubgroupProjectors {
+ public:
+  typedef std::vector<std::pair<GroupIndices, Eigen::MatrixXd>>
+      projectors_type;
+
+  SubgroupProjectors(
+      MatrixRep const &_rep,
+      std::function<GroupIndicesOrbitSet()> _make_cyclic_subgroups_f,
+      std::function<GroupIndicesOrbitSet()> _make_all_subgroups_f,
+      Index _n_threads = 1);
+
+  /// \brief The matrix representation
+  MatrixRep const &rep() const { return m_rep; }
+
+  /// \brief Representative subgroups, one per orbit, and their Reynolds
+  ///     operators, for cyclic subgroups or for all subgroups
+  projectors_type const &projectors(bool use_all_subgroups);
+
+ private:
+  projectors_type _make_projectors(GroupIndicesOrbitSet const &sgroups,
+                                   projectors_type const *existing) const;
+
+  MatrixRep m_rep;
+
+  std::function<GroupIndicesOrbitSet()> m_make_cyclic_subgroups_f;
+
+  std::function<GroupIndicesOrbitSet()> m_make_all_subgroups_f;
+
+  Index m_n_threads;
+
+  std::optional<projectors_type> m_cyclic;
+
+  std::optional<projectors_type> m_all;
+};
+
 /// Find high-symmetry directions in a irreducible space
 multivector<Eigen::VectorXcd>::X<2> make_irrep_special_directions(
     MatrixRep const &rep, GroupIndices const &head_group,
     Eigen::MatrixXcd const &irrep_subspace, double vec_compare_tol,
     std::function<GroupIndicesOrbitSet()> make_cyclic_subgroups_f,
     std::function<GroupIndicesOrbitSet()> make_all_subgroups_f,
-    bool use_all_subgroups = false);
+    bool use_all_subgroups = false, Index n_threads = 1);
+
+/// Find high-symmetry directions in a irreducible space, using shared
+/// subgroup Reynolds operators
+multivector<Eigen::VectorXcd>::X<2> make_irrep_special_directions(
+    SubgroupProjectors &projectors, GroupIndices const &head_group,
+    Eigen::MatrixXcd const &irrep_subspace, double vec_compare_tol,
+    bool use_all_subgroups = false, Index n_threads = 1);
 
 /// Make an irreducible space symmetrizer matrix using special directions
 Eigen::MatrixXcd make_irrep_symmetrizer_matrix(
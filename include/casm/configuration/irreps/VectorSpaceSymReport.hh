@@ -15,12 +15,26 @@ struct VectorSpaceSymReport {
                        std::vector<IrrepInfo> _irreps,
                        std::vector<SubWedge> _irreducible_wedge,
                        Eigen::MatrixXd const &_symmetry_adapted_subspace,
-                       std::vector<std::string> _axis_glossary);
+                       std::vector<std::string> _axis_glossary,
+                       std::vector<std::vector<Eigen::MatrixXd>>
+                           _irrep_symgroup_rep = {});
 
   /// \brief Matrix representation for each operation in the group -- defines
   /// action of group on vector space
+  ///
+  /// May be empty, if not requested from `vector_space_sym_report`.
   std::vector<Eigen::MatrixXd> symgroup_rep;
 
+  /// \brief Matrix representation for each operation in the group, in each
+  /// irreducible subspace
+  ///
+  /// The value `irrep_symgroup_rep[i][o]` is the real part of
+  /// `irreps[i].trans_mat * M_o * irreps[i].trans_mat.transpose()`, where
+  /// `M_o` is the full matrix representation of the `o`-th operation in the
+  /// group. Together, these are the blocks of the block-diagonal matrix
+  /// representation in the symmetry adapted basis.
+  std::vector<std::vector<Eigen::MatrixXd>> irrep_symgroup_rep;
+
   /// \brief A list of all irreducible representation that make up the full
   /// representation
   std::vector<IrrepInfo> irreps;
@@ -65,7 +79,8 @@ struct VectorSpaceSymReport {
 /// Construct VectorSpaceSymReport
 VectorSpaceSymReport vector_space_sym_report(
     IrrepDecomposition const &irrep_decomposition, bool calc_wedges = false,
-    std::optional<std::vector<std::string>> axis_glossary = std::nullopt);
+    std::optional<std::vector<std::string>> axis_glossary = std::nullopt,
+    Index n_threads = 1, bool include_symgroup_rep = true);
 
 }  // namespace irreps
 }  // namespace CASM
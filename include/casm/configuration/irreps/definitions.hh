@@ -11,6 +11,7 @@
 #ifndef CASM_irreps_definitions
 #define CASM_irreps_definitions
 
+#include <Eigen/SparseCore>
 #include <memory>
 #include <set>
 #include <vector>
@@ -25,6 +26,11 @@ namespace irreps {
 
 typedef long Index;
 typedef std::vector<Eigen::MatrixXd> MatrixRep;
+
+/// Matrix representation using sparse matrices, for large vector spaces
+/// in which each matrix has few non-zero elements per row, such as the
+/// block-permutation representation of site DoF in a supercell
+typedef std::vector<Eigen::SparseMatrix<double>> SparseMatrixRep;
 typedef std::set<Index> GroupIndices;
 typedef std::set<GroupIndices> GroupIndicesOrbit;
 typedef std::set<GroupIndicesOrbit> GroupIndicesOrbitSet;
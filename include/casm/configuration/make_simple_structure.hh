@@ -4,6 +4,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "casm/global/eigen.hh"
 
@@ -84,6 +85,60 @@ class ToAtomicStructure {
   std::set<std::string> m_excluded_species;
 };
 
+/// \brief Atomic structures of many configurations, in one buffer
+///
+/// Structures have the atom types, coordinates, and lattice vectors that
+/// ToAtomicStructure gives for each configuration, without properties.
+///
+/// Usage:
+/// \code
+/// // lattice vectors, as columns, of structure `i`
+/// Eigen::Matrix3d L = structures.lat_column_mat.middleCols(3 * i, 3);
+///
+/// // Cartesian coordinates, as columns, of the atoms of structure `i`
+/// auto coords = structures.coords.middleCols(structures.atom_offsets(i),
+///                                            structures.n_atoms(i));
+///
+/// // name of atom `a` of structure `i`
+/// std::string name = structures.atom_type_names[structures.atom_type(
+///     structures.atom_offsets(i) + a)];
+/// \endcode
+struct AtomicStructures {
+  /// \brief Lattice vectors, as columns, including strain; the lattice
+  ///     vectors of structure `i` are columns `[3*i, 3*i + 3)`
+  Eigen::MatrixXd lat_column_mat;
+
+  /// \brief Offset of the first atom of each structure in `atom_type` and
+  ///     `coords`, with size `n_structures + 1`
+  Eigen::VectorXl atom_offsets;
+
+  /// \brief Type of each atom, as an index into `atom_type_names`, for all
+  ///     structures
+  Eigen::VectorXi atom_type;
+
+  /// \brief Atom type names
+  std::vector<std::string> atom_type_names;
+
+  /// \brief Cartesian coordinates, as columns, of all atoms of all
+  ///     structures, including displacement and strain
+  Eigen::MatrixXd coords;
+
+  /// \brief Number of structures
+  Index n_structures() const { return atom_offsets.size() - 1; }
+
+  /// \brief Number of atoms in structure `i`
+  Index n_atoms(Index i) const {
+    return atom_offsets(i + 1) - atom_offsets(i);
+  }
+};
+
+/// \brief Construct the atomic structures of many configurations, in one
+///     buffer
+AtomicStructures make_atomic_structures(
+    std::vector<Configuration> const &configurations,
+    std::string atom_type_naming_method = "chemical_name",
+    std::set<std::string> excluded_species = {"Va", "VA", "va"});
+
 }  // namespace config
 }  // namespace CASM
 
@@ -0,0 +1,69 @@
+#ifndef CASM_config_memory_usage
+#define CASM_config_memory_usage
+
+#include <optional>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Memory used by a symmetry group, in bytes (approximate)
+Index memory_bytes(SymGroup const &group);
+
+/// \brief Memory used by process-wide symmetry tables and caches, in bytes
+///
+/// Values are approximate: they count the entries of tables and cached
+/// values, and a fixed size for each container node, not allocator
+/// overhead. Memory used by individual objects is given by
+/// `Supercell::memory_bytes`, `PrimSymInfo::memory_bytes`,
+/// `Configuration::memory_bytes`, and `ConfigurationSet::memory_bytes`.
+struct MemoryUsage {
+  /// \brief All existing SupercellSymInfo, including translation and factor
+  ///     group permutations (see `supercell_sym_info_total_bytes`)
+  Index supercell_sym_info_bytes = 0;
+
+  /// \brief Cached combined permutation tables (see
+  ///     `combined_permutation_table_total_bytes`)
+  Index combined_permutation_table_bytes = 0;
+
+  /// \brief Matrix representations held by `default_matrix_rep_cache()`
+  Index matrix_rep_cache_bytes = 0;
+
+  /// \brief Configurations held by `default_canonical_primitive_cache()`
+  Index canonical_primitive_cache_bytes = 0;
+
+  /// \brief Orbits held by `clust::default_orbit_cache()`
+  Index orbit_cache_bytes = 0;
+
+  /// \brief PrimSymInfo held by `default_prim_sym_info_cache()`
+  Index prim_sym_info_cache_bytes = 0;
+
+  /// \brief Total of all categories
+  Index total_bytes() const;
+};
+
+/// \brief Return the memory used by process-wide symmetry tables and
+///     caches
+MemoryUsage memory_usage();
+
+/// \brief Set the process-wide memory budget, in bytes, or std::nullopt
+///     for no budget
+void set_memory_budget(std::optional<Index> max_bytes);
+
+/// \brief The process-wide memory budget, in bytes, or std::nullopt if
+///     there is no budget
+std::optional<Index> memory_budget();
+
+/// \brief Evict cached values until `memory_usage().total_bytes() +
+///     reserve_bytes` is within the memory budget
+Index enforce_memory_budget(Index reserve_bytes = 0);
+
+/// \brief Return true if `n_bytes` more may be used within the memory
+///     budget, after evicting cached values if necessary
+bool memory_budget_allows(Index n_bytes);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef CASM_config_numa
+#define CASM_config_numa
+
+#include <memory>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+struct Supercell;
+
+/// \brief Return the number of NUMA nodes
+Index numa_node_count();
+
+/// \brief Return the NUMA node of the CPU running the calling thread
+Index current_numa_node();
+
+/// \brief Set whether supercell symmetry tables are replicated per NUMA
+///     node
+void set_numa_replication_enabled(bool enabled);
+
+/// \brief Return true if supercell symmetry tables are replicated per NUMA
+///     node
+bool numa_replication_is_enabled();
+
+/// \brief Return the supercell, or a replica with symmetry tables local to
+///     the NUMA node of the calling thread
+std::shared_ptr<Supercell const> local_supercell(
+    std::shared_ptr<Supercell const> const &supercell);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
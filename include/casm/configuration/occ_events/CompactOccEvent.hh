@@ -0,0 +1,100 @@
+#ifndef CASM_occ_events_CompactOccEvent
+#define CASM_occ_events_CompactOccEvent
+
+#include <cstdint>
+#include <vector>
+
+#include "casm/configuration/occ_events/definitions.hh"
+#include "casm/misc/Comparisons.hh"
+
+namespace CASM {
+namespace occ_events {
+
+class OccEvent;
+
+/// \brief An OccEvent packed into a single contiguous int32 array
+///
+/// An OccEvent holds a vector of trajectories, each holding a vector of
+/// OccPosition, so it requires one heap allocation per trajectory plus one
+/// for the event. CompactOccEvent stores the same information in one
+/// `std::vector<std::int32_t>`:
+///
+///     [n_trajectories,
+///      n_positions(0), position(0, 0), position(0, 1), ...,
+///      n_positions(1), position(1, 0), ...]
+///
+/// Each position is `position_width` values, (kind, i, j, k, b,
+/// occupant_index, atom_position_index), with `kind` = 0 for a molecule,
+/// 1 for an atom, 2 for a molecule in the resevoir, and 3 for an atom in
+/// the resevoir. Values that are not used by OccPosition comparison (the
+/// site of a position in the resevoir, and the atom position index of a
+/// position in the resevoir or of a molecule) are stored as 0.
+///
+/// This is useful for holding large libraries of events, for example as
+/// keys of hash sets or in flat sorted vectors.
+///
+/// Notes:
+/// - Comparison is consistent with OccEvent: if `A < B` for OccEvent, then
+///   `CompactOccEvent(A) < CompactOccEvent(B)`, and equality is the same.
+/// - Constructing from an OccEvent throws if an index value does not fit
+///   in int32.
+/// - Converting back to OccEvent gives an OccEvent equal to the original.
+class CompactOccEvent : public Comparisons<CRTPBase<CompactOccEvent>> {
+ public:
+  /// \brief Number of int32 values used for each OccPosition
+  static constexpr Index position_width = 7;
+
+  /// \brief Construct an empty event
+  CompactOccEvent();
+
+  /// \brief Construct from an OccEvent
+  explicit CompactOccEvent(OccEvent const &occ_event);
+
+  /// \brief Construct from packed values
+  explicit CompactOccEvent(std::vector<std::int32_t> data);
+
+  /// \brief Number of trajectories in the event
+  Index size() const { return m_data[0]; }
+
+  /// \brief Packed values
+  std::vector<std::int32_t> const &data() const { return m_data; }
+
+  /// \brief Convert to OccEvent
+  OccEvent to_occevent() const;
+
+  /// \brief Translate the event by a UnitCell translation
+  CompactOccEvent &operator+=(xtal::UnitCell const &trans);
+
+  /// \brief Translate the event by a UnitCell translation
+  CompactOccEvent &operator-=(xtal::UnitCell const &trans);
+
+  /// \brief Compare as OccEvent
+  bool operator<(CompactOccEvent const &B) const;
+
+ private:
+  friend struct Comparisons<CRTPBase<CompactOccEvent>>;
+
+  bool eq_impl(CompactOccEvent const &B) const;
+
+  /// \brief Packed values
+  std::vector<std::int32_t> m_data;
+};
+
+/// \brief Hash for CompactOccEvent, consistent with
+///     CompactOccEvent::operator==
+struct CompactOccEventHash {
+  std::size_t operator()(CompactOccEvent const &occ_event) const;
+};
+
+/// \brief Convert OccEvent to CompactOccEvent
+std::vector<CompactOccEvent> make_compact_occevents(
+    std::vector<OccEvent> const &occ_events);
+
+/// \brief Convert CompactOccEvent to OccEvent
+std::vector<OccEvent> make_occevents(
+    std::vector<CompactOccEvent> const &compact_occ_events);
+
+}  // namespace occ_events
+}  // namespace CASM
+
+#endif
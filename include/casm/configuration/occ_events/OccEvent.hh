@@ -110,6 +110,11 @@ OccEvent &apply(OccEventRep const &rep, OccEvent &occ_event);
 /// \brief Apply SymOp to OccEvent
 OccEvent copy_apply(OccEventRep const &rep, OccEvent occ_event);
 
+/// \brief Hash OccEvent, consistent with OccEvent equality
+struct OccEventHash {
+  std::size_t operator()(OccEvent const &occ_event) const;
+};
+
 // --- Implementation ---
 
 template <typename Iterator>
@@ -1,13 +1,16 @@
 #ifndef CASM_occ_events_OccEventCounter
 #define CASM_occ_events_OccEventCounter
 
+#include <memory>
 #include <optional>
 #include <set>
 #include <vector>
 
+#include "casm/configuration/ProgressMonitor.hh"
 #include "casm/configuration/clusterography/IntegralCluster.hh"
 #include "casm/configuration/clusterography/occ_counter.hh"
 #include "casm/configuration/occ_events/OccEvent.hh"
+#include "casm/configuration/occ_events/OccEventRep.hh"
 #include "casm/configuration/occ_events/OccSystem.hh"
 #include "casm/configuration/occ_events/misc/MultiStepMethod.hh"
 #include "casm/container/Counter.hh"
@@ -155,6 +158,43 @@ struct OccEventCounterParameters {
   ///     and position_final. Return true to allow, false to skip.
   std::function<bool(OccEventCounterData const &)> trajectory_filter;
 
+  /// \brief If true, check the trajectories of each sublattice and
+  ///     occupation pattern once, and re-use the allowed trajectories on
+  ///     every cluster with the same pattern
+  ///
+  /// The events generated are the same either way. Not used if
+  /// `trajectory_filter` is set or state info is printed or saved, because
+  /// those require checking each trajectory on each cluster.
+  bool memoize_trajectories = true;
+
+  // --- sharding ---
+
+  /// \brief Number of shards the prototype clusters are split into, so
+  ///     that counting may be split across processes
+  ///
+  /// Prototype `i` belongs to shard `i % n_shards`, and only prototypes in
+  /// shard `shard_index` are counted over. Clusters are assigned in a
+  /// strided order because the number of events usually increases with
+  /// cluster size and clusters are typically ordered by size. The events
+  /// generated by all shards together are the events generated with
+  /// `n_shards == 1`.
+  Index n_shards = 1;
+
+  /// \brief Index of the shard of prototype clusters to count over, in
+  ///     the range `[0, n_shards)`
+  Index shard_index = 0;
+
+  // --- progress ---
+
+  /// \brief Optional progress reporting and cancellation
+  ///
+  /// If set, OccEventCounter::advance calls `progress->check()`, and calls
+  /// `progress->advance()` each time counting over a prototype cluster is
+  /// finished, so it throws OperationCancelled if cancellation is
+  /// requested. The stage is started by the caller, with `progress->begin`,
+  /// if `n_total` should be reported. Not included in JSON input/output.
+  std::shared_ptr<config::ProgressMonitor> progress;
+
   // --- debugging ---
 
   /// \brief If true, print information about which states are
@@ -222,12 +262,28 @@ struct OccEventCounterStateInfo {
   std::string fails;
 };
 
+/// \brief OccEventCounter position, which may be saved to resume counting
+///
+/// The state of a finished OccEventCounter has
+/// `prototype_index == prototypes.size()`, where `prototypes` are the
+/// prototypes in the counter's shard (see `OccEventCounterData::prototypes`).
+struct OccEventCounterState {
+  /// \brief Index into the prototypes of the cluster of the current
+  ///     OccEvent
+  Index prototype_index = 0;
+
+  /// \brief Number of allowed OccEvent preceding the current OccEvent on
+  ///     the current cluster
+  Index event_index = 0;
+};
+
 /// \brief Data structure used internally by OccEventCounter
 struct OccEventCounterData {
   /// \brief Defines OccPosition indices, helps check OccEvents
   std::shared_ptr<OccSystem const> system;
 
-  /// \brief All clusters on which OccEvents will be generated
+  /// \brief All clusters on which OccEvents will be generated, the
+  ///     constructor argument `prototypes` in shard `params.shard_index`
   std::vector<clust::IntegralCluster> prototypes;
 
   /// \brief Parameters controlling the OccEventCounter
@@ -237,18 +293,35 @@ struct OccEventCounterData {
   ///     the outer-most step (step index 3).
   Index prototype_index;
 
+  /// \brief Value `prototype_index` is initialized to, which is non-zero
+  ///     when resuming counting
+  Index begin_prototype_index = 0;
+
   /// \brief Current cluster on which OccEvents are being generated,
   ///     a copy of prototype[prototype_index].
   clust::IntegralCluster cluster;
 
-  /// \brief Counter generates initial occupation states on
-  ///     the cluster. Incremented in second-outer-most step
-  ///     (step index 2).
+  /// \brief Cluster group representations that transform occupations on
+  ///     each of `prototypes`, if constructed with cluster groups
+  ///
+  /// If not empty, only initial occupations which are the canonical element
+  /// of their orbit under the cluster group of the current cluster are
+  /// counted over. Empty if not constructed with cluster groups, or if
+  /// any parameter which may not be invariant under the cluster group is
+  /// set (see the OccEventCounter constructor).
+  std::vector<std::vector<clust::ClusterOccSymOpRep>>
+      cluster_occ_symgroup_reps;
+
+  /// \brief Counter holding the current initial occupation state on
+  ///     the cluster, as its single value. Updated in second-outer-most
+  ///     step (step index 2), which skips occupations that cannot
+  ///     satisfy the count criteria.
   Counter<std::vector<int>> occ_init_counter;
 
-  /// \brief Counter generates final occupation states on
-  ///     the cluster. Incremented in third-outer-most step
-  ///     (step index 1).
+  /// \brief Counter holding the current final occupation state on
+  ///     the cluster, as its single value. Updated in third-outer-most
+  ///     step (step index 1), which skips occupations that cannot
+  ///     satisfy the count criteria.
   Counter<std::vector<int>> occ_final_counter;
 
   /// \brief Initial OccPosition, determined directly from occ_init_counter.
@@ -295,6 +368,10 @@ struct OccEventCounterData {
 /// - At each step, a number of criteria, specified by
 /// OccEventCounterParameters,
 ///   are checked to skip invalid or undesired OccEvent.
+/// - Counting may be split between workers at any step, including while
+///   counting over a single cluster, with `split` (see
+///   `MultiStepMethod::split`). Step indices are 0 (trajectories, inner-most)
+///   to 3 (cluster prototypes, outer-most).
 class OccEventCounter {
  public:
   /// \brief Constructor
@@ -308,6 +385,22 @@ class OccEventCounter {
                   std::vector<clust::IntegralCluster> const &prototypes,
                   OccEventCounterParameters const &params);
 
+  /// \brief Constructor, resuming from a saved state
+  OccEventCounter(std::shared_ptr<OccSystem const> const &system,
+                  std::vector<clust::IntegralCluster> const &prototypes,
+                  OccEventCounterParameters const &params,
+                  OccEventCounterState const &state);
+
+  /// \brief Constructor, using cluster groups to skip equivalent initial
+  ///     occupations
+  OccEventCounter(
+      std::shared_ptr<OccSystem const> const &system,
+      std::vector<std::set<clust::IntegralCluster>> const &orbits,
+      std::vector<std::vector<std::shared_ptr<SymGroup const>>> const
+          &cluster_groups,
+      std::vector<OccEventRep> const &occevent_symgroup_rep,
+      OccEventCounterParameters const &params);
+
   std::shared_ptr<OccEventCounterData> const &data() const;
 
   /// \brief Advance to the next allowed OccEvent
@@ -319,7 +412,33 @@ class OccEventCounter {
   /// \brief True if counting is finished
   bool is_finished() const;
 
+  /// \brief Current position, which may be used to resume counting
+  OccEventCounterState state() const;
+
+  /// \brief Split off the events after the current subtree at step
+  ///     `level`, so they may be counted by another worker
+  std::unique_ptr<OccEventCounter> split(Index level);
+
+  /// \brief Steps with index less than this may be split at
+  Index end_level() const;
+
  private:
+  /// \brief Construct an empty counter, for `split`
+  OccEventCounter() = default;
+
+  /// \brief Advance `params.progress` by the prototypes finished since it
+  ///     was last advanced, or check for cancellation
+  void _report_progress();
+
+  /// \brief Construct `m_data` and `m_stepper`, beginning at
+  ///     `begin_prototype_index`
+  void _initialize(std::shared_ptr<OccSystem const> const &system,
+                   std::vector<clust::IntegralCluster> const &prototypes,
+                   OccEventCounterParameters const &params,
+                   Index begin_prototype_index,
+                   std::vector<std::vector<clust::ClusterOccSymOpRep>> const
+                       &cluster_occ_symgroup_reps = {});
+
   /// This holds current method state and parameters
   std::shared_ptr<OccEventCounterData> m_data;
 
@@ -332,6 +451,21 @@ class OccEventCounter {
   /// OccEventCounterParameters,
   ///   are checked to skip invalid or undesired OccEvent.
   std::unique_ptr<MultiStepMethod<OccEventCounterData>> m_stepper;
+
+  /// Number of allowed OccEvent preceding the current OccEvent on the
+  /// current cluster
+  Index m_event_index = 0;
+
+  /// Prototypes before this index were reported finished to
+  /// `params.progress` by this counter
+  Index m_progress_index = 0;
+
+  /// Prototypes at and after this index are reported finished by counters
+  /// split from this one
+  Index m_end_prototype_index = 0;
+
+  /// True if split from, or split off, another counter
+  bool m_is_split = false;
 };
 
 }  // namespace occ_events
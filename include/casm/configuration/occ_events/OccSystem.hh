@@ -25,6 +25,7 @@ class IntegralCluster;
 
 namespace occ_events {
 
+class OccEvent;
 struct OccPosition;
 
 /// \brief Defines the system for OccPosition / OccTrajectory / OccEvent
@@ -114,6 +115,52 @@ struct OccSystem {
   /// - -1 if invalid
   std::vector<std::vector<int>> orientation_to_occupant_index;
 
+  // --- Flattened lookup tables ---
+
+  /// \brief Offsets of sublattices in the flattened occupant tables
+  ///
+  /// Usage:
+  /// - occupant_offset[b] + occupant_index -> flat occupant index
+  /// - occupant_offset[n_sublat] is the total number of occupants
+  std::vector<Index> occupant_offset;
+
+  /// \brief Chemical index, by flat occupant index
+  ///
+  /// Equivalent to `occupant_to_chemical_index[b][occupant_index]`
+  std::vector<int> flat_occupant_to_chemical_index;
+
+  /// \brief Orientation index, by flat occupant index
+  ///
+  /// Equivalent to `occupant_to_orientation_index[b][occupant_index]`
+  std::vector<int> flat_occupant_to_orientation_index;
+
+  /// \brief 1 if the occupant is a vacancy, by flat occupant index
+  std::vector<char> flat_occupant_is_vacancy;
+
+  /// \brief 1 if the occupant is indivisible, by flat occupant index
+  std::vector<char> flat_occupant_is_indivisible;
+
+  /// \brief Offsets of occupants in `flat_atom_position_to_name_index`
+  ///
+  /// Usage:
+  /// - atom_position_offset[flat_occupant_index] + atom_position_index ->
+  ///   flat atom position index
+  /// - The number of atoms in the occupant is
+  ///   `atom_position_offset[flat_occupant_index + 1] -
+  ///   atom_position_offset[flat_occupant_index]`
+  std::vector<Index> atom_position_offset;
+
+  /// \brief Atom name index, by flat atom position index
+  ///
+  /// Equivalent to
+  /// `atom_position_to_name_index[b][occupant_index][atom_position_index]`
+  std::vector<int> flat_atom_position_to_name_index;
+
+  /// \brief Return the flat occupant index of an occupant on a sublattice
+  Index flat_occupant_index(Index b, Index occupant_index) const {
+    return occupant_offset[b] + occupant_index;
+  }
+
   // --- OccPosition factory functions ---
 
   OccPosition make_molecule_position(
@@ -210,32 +257,55 @@ struct OccSystem {
     if (p.is_in_resevoir) {
       return p.occupant_index;
     }
-    return occupant_to_chemical_index[get_sublattice_index(p)]
-                                     [p.occupant_index];
+    return flat_occupant_to_chemical_index[flat_occupant_index(
+        get_sublattice_index(p), p.occupant_index)];
   }
 
   /// Valid if p.is_in_resevoir==false
   Index get_orientation_index(OccPosition const &p) const {
-    return occupant_to_orientation_index[get_sublattice_index(p)]
-                                        [p.occupant_index];
+    return flat_occupant_to_orientation_index[flat_occupant_index(
+        get_sublattice_index(p), p.occupant_index)];
   }
 
   /// Valid if p.is_atom==true
   Index get_atom_name_index(OccPosition const &p) const {
-    return atom_position_to_name_index[get_sublattice_index(p)]
-                                      [p.occupant_index][p.atom_position_index];
+    return flat_atom_position_to_name_index
+        [atom_position_offset[flat_occupant_index(get_sublattice_index(p),
+                                                  p.occupant_index)] +
+         p.atom_position_index];
   }
 
   /// Valid if p.is_in_resevoir==false
   Eigen::Vector3d get_cartesian_coordinate(OccPosition const &p) const;
 
+  /// \brief Cartesian coordinates of positions, as columns
+  Eigen::Matrix3Xd get_cartesian_coordinates(
+      std::vector<OccPosition> const &positions) const;
+
+  /// \brief Cartesian coordinates of all non-resevoir positions in an
+  ///     event, as columns
+  Eigen::Matrix3Xd get_cartesian_coordinates(OccEvent const &event) const;
+
+  /// \brief Cartesian coordinates of all non-resevoir positions in many
+  ///     events, as columns
+  Eigen::Matrix3Xd get_cartesian_coordinates(
+      std::vector<OccEvent> const &events, Eigen::VectorXl &offsets) const;
+
   /// Return true if molecule is indivisible
   bool is_indivisible(OccPosition const &p) const {
-    return is_indivisible_chemical_list[get_chemical_index(p)];
+    if (p.is_in_resevoir) {
+      return is_indivisible_chemical_list[p.occupant_index];
+    }
+    return flat_occupant_is_indivisible[flat_occupant_index(
+        get_sublattice_index(p), p.occupant_index)];
   }
 
   bool is_vacancy(OccPosition const &p) const {
-    return is_vacancy_list[get_chemical_index(p)];
+    if (p.is_in_resevoir) {
+      return is_vacancy_list[p.occupant_index];
+    }
+    return flat_occupant_is_vacancy[flat_occupant_index(
+        get_sublattice_index(p), p.occupant_index)];
   }
 
   /// \brief Return reference to molecule occupant
@@ -0,0 +1,90 @@
+#ifndef CASM_occ_events_OccEvent_binary_io
+#define CASM_occ_events_OccEvent_binary_io
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "casm/configuration/occ_events/definitions.hh"
+
+namespace CASM {
+
+namespace occ_events {
+class OccEventCounter;
+}
+
+/// \brief Write OccEvent in a streaming binary format, one event at a time
+///
+/// Binary format (integers are little-endian):
+/// - Header: magic "CASMOEVT", version (unsigned 64-bit)
+/// - Records: one per event, the number of values (unsigned 64-bit)
+///   followed by the CompactOccEvent packed values (signed 32-bit)
+///
+/// Each event is written as it is given, so memory use does not depend on
+/// the number of events written. Reading does not require an OccSystem.
+///
+/// To resume an interrupted write, open the stream in append mode,
+/// construct the writer with `write_header=false`, and write the remaining
+/// events, for example using `write(counter, OccEventBinaryReader::count(in))`.
+///
+/// Notes:
+/// - The stream must remain valid for the lifetime of the writer
+class OccEventBinaryWriter {
+ public:
+  /// \brief Constructor
+  OccEventBinaryWriter(std::ostream &out, bool write_header = true);
+
+  /// \brief Write one event
+  void write(occ_events::OccEvent const &occ_event);
+
+  /// \brief Write events as they are produced by an OccEventCounter
+  Index write(occ_events::OccEventCounter &counter, Index offset = 0);
+
+  /// \brief Number of events written by this writer
+  Index n_written() const { return m_n_written; }
+
+ private:
+  std::ostream &m_out;
+
+  Index m_n_written;
+
+  /// \brief Buffer for one record
+  std::vector<std::uint8_t> m_buffer;
+};
+
+/// \brief Read OccEvent in the streaming binary format, one event at a time
+///
+/// Notes:
+/// - Events before `offset` are skipped without being decoded
+/// - An incomplete record at the end of the stream, as left by an
+///   interrupted write, is treated as the end of the stream
+/// - The stream must remain valid for the lifetime of the reader
+class OccEventBinaryReader {
+ public:
+  /// \brief Constructor
+  OccEventBinaryReader(std::istream &in, Index offset = 0);
+
+  /// \brief Read the next event, return false if there are no more events
+  bool read(occ_events::OccEvent &occ_event);
+
+  /// \brief Index of the next event to be read
+  Index index() const { return m_index; }
+
+  /// \brief Count the complete events in a stream
+  static Index count(std::istream &in);
+
+ private:
+  /// \brief Read the next record into m_values, return false if none
+  bool _next_record(bool decode);
+
+  std::istream &m_in;
+
+  Index m_index;
+
+  /// \brief Packed values of the last record read
+  std::vector<std::int32_t> m_values;
+};
+
+}  // namespace CASM
+
+#endif
@@ -4,6 +4,7 @@
 namespace CASM {
 namespace occ_events {
 struct OccEventCounterParameters;
+struct OccEventCounterState;
 struct OccEventCounterStateInfo;
 struct OccSystem;
 }  // namespace occ_events
@@ -20,6 +21,11 @@ jsonParser &to_json(occ_events::OccEventCounterParameters const &params,
 
 void parse(InputParser<occ_events::OccEventCounterParameters> &parser);
 
+jsonParser &to_json(occ_events::OccEventCounterState const &state,
+                    jsonParser &json);
+
+void parse(InputParser<occ_events::OccEventCounterState> &parser);
+
 }  // namespace CASM
 
 #endif
@@ -0,0 +1,97 @@
+#ifndef CASM_occ_events_OccEvent_jsonl_io
+#define CASM_occ_events_OccEvent_jsonl_io
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "casm/configuration/occ_events/definitions.hh"
+#include "casm/configuration/occ_events/io/json/OccEvent_json_io.hh"
+
+namespace CASM {
+
+namespace occ_events {
+class OccEventCounter;
+}
+
+/// \brief Write OccEvent in JSON Lines format, one event at a time
+///
+/// Each event is written as `to_json(event, json, system, options)` on a
+/// single line, as it is given, so memory use does not depend on the
+/// number of events written. The default options write only the
+/// trajectories.
+///
+/// To resume an interrupted write, open the stream in append mode and
+/// write the remaining events, for example using
+/// `write(counter, OccEventJsonLinesReader::count(in))`.
+///
+/// Notes:
+/// - The stream must remain valid for the lifetime of the writer
+class OccEventJsonLinesWriter {
+ public:
+  /// \brief Constructor
+  OccEventJsonLinesWriter(std::ostream &out,
+                          std::shared_ptr<occ_events::OccSystem const> system,
+                          occ_events::OccEventOutputOptions options =
+                              default_options());
+
+  /// \brief Options which write only event trajectories
+  static occ_events::OccEventOutputOptions default_options();
+
+  /// \brief Write one event
+  void write(occ_events::OccEvent const &occ_event);
+
+  /// \brief Write events as they are produced by an OccEventCounter
+  Index write(occ_events::OccEventCounter &counter, Index offset = 0);
+
+  /// \brief Number of events written by this writer
+  Index n_written() const { return m_n_written; }
+
+ private:
+  std::ostream &m_out;
+
+  std::shared_ptr<occ_events::OccSystem const> m_system;
+
+  occ_events::OccEventOutputOptions m_options;
+
+  Index m_n_written;
+};
+
+/// \brief Read OccEvent in JSON Lines format, one event at a time
+///
+/// Notes:
+/// - Events before `offset` are skipped without being parsed
+/// - Empty lines are skipped
+/// - The stream must remain valid for the lifetime of the reader
+class OccEventJsonLinesReader {
+ public:
+  /// \brief Constructor
+  OccEventJsonLinesReader(std::istream &in,
+                          std::shared_ptr<occ_events::OccSystem const> system,
+                          Index offset = 0);
+
+  /// \brief Read the next event, return false if there are no more events
+  bool read(occ_events::OccEvent &occ_event);
+
+  /// \brief Index of the next event to be read
+  Index index() const { return m_index; }
+
+  /// \brief Count the events remaining in a stream
+  static Index count(std::istream &in);
+
+ private:
+  /// \brief Read the next non-empty line, return false if none
+  bool _next_line();
+
+  std::istream &m_in;
+
+  std::shared_ptr<occ_events::OccSystem const> m_system;
+
+  Index m_index;
+
+  std::string m_line;
+};
+
+}  // namespace CASM
+
+#endif
@@ -1,6 +1,12 @@
 #ifndef CASM_MultiStepMethod
 #define CASM_MultiStepMethod
 
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
 namespace CASM {
 
 /// \brief Abstract base class for implementing the logic
@@ -31,6 +37,26 @@ class SingleStepBase {
   /// \brief Re-initialize based on shared data
   virtual void initialize() const = 0;
 
+  /// \brief Copy this step, in its current state, with access to other
+  ///     shared data
+  ///
+  /// Required by `MultiStepMethod::clone` and `MultiStepMethod::split`. The
+  /// copy must not share any state with this step, other than `_data`,
+  /// which is a copy of `data()`. Typical implementation:
+  /// \code
+  /// std::unique_ptr<SingleStepBase<SharedDataType>> clone(
+  ///     std::shared_ptr<SharedDataType> _data) const override {
+  ///   auto step = std::make_unique<DerivedStep>(*this);
+  ///   step->data() = _data;
+  ///   return step;
+  /// }
+  /// \endcode
+  virtual std::unique_ptr<SingleStepBase<SharedDataType>> clone(
+      std::shared_ptr<SharedDataType> _data) const {
+    throw std::runtime_error(
+        "Error in SingleStepBase::clone: step does not support clone");
+  }
+
  private:
   std::shared_ptr<SharedDataType> m_data;
 };
@@ -40,6 +66,34 @@ class SingleStepBase {
 ///
 /// See `SingleStepBase` for the methods that each individual step must
 /// implement.
+///
+/// Splitting:
+/// - The nested loops form a tree, with one level per step. `split(level)`
+///   hands the unexplored part of the tree after the current subtree at
+///   `level`, which is the siblings of the current state of step `level`
+///   and everything after them in the more-outer steps, to a new
+///   MultiStepMethod, and this one finishes once the current subtree is
+///   done. So the states of the two together are the states this would
+///   have visited, in the same order.
+/// - Either part may be split again, so that workers which run out of
+///   work can take work from others (work stealing). Splitting at the
+///   outer-most allowed level hands off the most work.
+/// - The new MultiStepMethod has its own copy of the shared data and
+///   steps, made with `SharedDataType`'s copy constructor and
+///   `SingleStepBase::clone`, so it may be advanced by another thread.
+/// - Splitting requires that `advance`, `is_finished`, and `is_allowed` of
+///   each step depend only on the state of that step and the more-outer
+///   steps, because the new MultiStepMethod advances step `level` while the
+///   more-inner steps are part way through their loops.
+///
+/// Example:
+/// \code
+/// std::unique_ptr<MultiStepMethod<Data>> other =
+///     method.split(method.end_level() - 1);
+/// if (!other->is_finished()) {
+///   ... give `other` to an idle worker ...
+/// }
+/// \endcode
 template <typename SharedDataType>
 class MultiStepMethod {
  public:
@@ -65,7 +119,10 @@ class MultiStepMethod {
   ///   the first allowed state.
   MultiStepMethod(std::shared_ptr<SharedDataType> _data,
                   std::vector<StepPtr> &&_steps)
-      : m_data(_data), m_steps(std::move(_steps)) {
+      : m_data(_data),
+        m_steps(std::move(_steps)),
+        m_end_level(m_steps.size()),
+        m_is_stopped(false) {
     if (!steps().size()) {
       return;
     }
@@ -131,8 +188,84 @@ class MultiStepMethod {
   /// - This will attempt to advance the inner-most step, and in
   ///   turn the outer-most steps necessary to reach an "allowed"
   ///   state.
-  bool advance() {
-    if (!steps().size() || (*steps().rbegin())->is_finished()) {
+  bool advance() { return _advance_from(0); }
+
+  /// \brief Return true if the multi-step method is in a
+  ///     invalid / finished state
+  bool is_finished() const {
+    if (!steps().size() || m_is_stopped) {
+      return true;
+    }
+    bool result = (*steps().rbegin())->is_finished();
+    return result;
+  }
+
+  /// \brief Steps with index less than this may be split at
+  ///
+  /// This is `steps().size()`, unless this was split, in which case it is
+  /// the level that this was last split at.
+  Index end_level() const { return m_end_level; }
+
+  /// \brief Copy this multi-step method, in its current state
+  ///
+  /// The copy has its own copy of the shared data and steps.
+  std::unique_ptr<MultiStepMethod> clone() const {
+    auto _data = std::make_shared<SharedDataType>(*m_data);
+    StepVector _steps;
+    for (auto const &step : steps()) {
+      _steps.emplace_back(step->clone(_data));
+    }
+    std::unique_ptr<MultiStepMethod> result(
+        new MultiStepMethod(_data, std::move(_steps), m_end_level));
+    result->m_is_stopped = m_is_stopped;
+    return result;
+  }
+
+  /// \brief Split off the unexplored states after the current subtree at
+  ///     step `level`
+  ///
+  /// \param level Index into `steps()` of the step whose remaining states
+  ///     are handed off. Must be less than `end_level()`.
+  ///
+  /// \returns A multi-step method which visits the states after the
+  ///     current subtree at `level`, beginning at the next allowed state.
+  ///     It may already be finished, if there were none. After this
+  ///     returns, this finishes once the states in the current subtree at
+  ///     `level` are visited.
+  std::unique_ptr<MultiStepMethod> split(Index level) {
+    if (is_finished()) {
+      throw std::runtime_error(
+          "Error in MultiStepMethod::split: method is finished");
+    }
+    if (level < 0 || level >= m_end_level) {
+      throw std::runtime_error(
+          "Error in MultiStepMethod::split: invalid level");
+    }
+    std::unique_ptr<MultiStepMethod> result = clone();
+    m_end_level = level;
+    result->_advance_from(level);
+    return result;
+  }
+
+ private:
+  /// \brief Construct a copy, without initializing the steps
+  MultiStepMethod(std::shared_ptr<SharedDataType> _data,
+                  std::vector<StepPtr> &&_steps, Index _end_level)
+      : m_data(_data),
+        m_steps(std::move(_steps)),
+        m_end_level(_end_level),
+        m_is_stopped(false) {}
+
+  /// \brief Advance state, beginning at step `level`, return true if
+  ///     post-state is not finished
+  ///
+  /// With `level == 0` this advances to the next allowed state. With
+  /// `level > 0` this skips the remaining states of the more-inner steps
+  /// and advances to the first allowed state after the current state of
+  /// step `level`. If a step at or beyond `end_level()` would be advanced,
+  /// this stops instead.
+  bool _advance_from(Index level) {
+    if (is_finished()) {
       return false;
     }
     bool is_finished;
@@ -140,9 +273,15 @@ class MultiStepMethod {
     auto begin = steps().begin();
     auto end = steps().end();
 
-    // begin at the inner-most step
-    auto ptr = begin;
+    // begin at step `level`
+    auto ptr = begin + level;
     do {
+      // steps at or beyond `m_end_level` belong to another split
+      if (ptr - begin >= m_end_level) {
+        m_is_stopped = true;
+        return false;
+      }
+
       // advance until finished or allowed
       do {
         (*ptr)->advance();
@@ -184,19 +323,15 @@ class MultiStepMethod {
     return false;
   }
 
-  /// \brief Return true if the multi-step method is in a
-  ///     invalid / finished state
-  bool is_finished() const {
-    if (!steps().size()) {
-      return true;
-    }
-    bool result = (*steps().rbegin())->is_finished();
-    return result;
-  }
-
- private:
   std::shared_ptr<SharedDataType> m_data;
   std::vector<std::unique_ptr<SingleStepBase<SharedDataType>>> m_steps;
+
+  /// Steps with index >= m_end_level are not advanced, see `split`
+  Index m_end_level;
+
+  /// True if finished because a step with index >= m_end_level would be
+  /// advanced
+  bool m_is_stopped;
 };
 
 }  // namespace CASM
@@ -2,8 +2,10 @@
 #define CASM_occ_events_orbits
 
 #include <set>
+#include <unordered_map>
 #include <vector>
 
+#include "casm/configuration/occ_events/OccEvent.hh"
 #include "casm/configuration/occ_events/definitions.hh"
 #include "casm/global/eigen.hh"
 
@@ -20,6 +22,46 @@ std::set<OccEvent> make_prim_periodic_orbit(
     OccEvent const &orbit_element,
     std::vector<OccEventRep> const &occevent_symgroup_rep);
 
+/// \brief Find canonical forms and orbits of OccEvent, with periodic
+///     symmetry of a prim, caching every orbit generated
+///
+/// The first time an OccEvent in an orbit is seen, its orbit is generated
+/// and every element is stored in a hash table. Canonical forms of other
+/// elements of the same orbit are then found by lookup, instead of by
+/// applying every symmetry operation again.
+///
+/// The canonical form is the same as that given by
+/// `group::make_canonical_element` using `prim_periodic_occevent_copy_apply`,
+/// which is the greatest element of the orbit.
+class PrimPeriodicOccEventOrbitCache {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param occevent_symgroup_rep Symmetry group representation (as
+  ///     OccEventRep). Must remain valid for the lifetime of the cache.
+  PrimPeriodicOccEventOrbitCache(
+      std::vector<OccEventRep> const &occevent_symgroup_rep);
+
+  /// \brief Return the index of the orbit containing `occ_event`,
+  ///     generating the orbit if it has not been seen before
+  Index orbit_index(OccEvent const &occ_event);
+
+  /// \brief Return the canonical form of `occ_event`
+  OccEvent const &canonical_form(OccEvent const &occ_event);
+
+  /// \brief Orbits generated so far, in the order first seen
+  std::vector<std::set<OccEvent>> const &orbits() const { return m_orbits; }
+
+ private:
+  std::vector<OccEventRep> const *m_occevent_symgroup_rep;
+
+  std::vector<std::set<OccEvent>> m_orbits;
+
+  /// \brief Orbit index of each OccEvent seen, translated to the origin
+  ///     unit cell and standardized
+  std::unordered_map<OccEvent, Index, OccEventHash> m_orbit_index;
+};
+
 /// \brief Generate equivalent OccEvent, translated to origin unit cell,
 ///     in a given order
 std::vector<OccEvent> make_prim_periodic_equivalents(
@@ -53,7 +95,7 @@ std::vector<OccEvent> make_prim_periodic_occevent_prototypes(
     std::vector<clust::IntegralCluster> const &clusters,
     std::vector<OccEventRep> const &occevent_symgroup_rep,
     OccEventCounterParameters const &params,
-    std::vector<OccEvent> const &custom_events = {});
+    std::vector<OccEvent> const &custom_events = {}, Index n_threads = 1);
 
 /// \brief Make orbits of OccEvent, with periodic symmetry of a prim
 std::vector<std::set<OccEvent>> make_prim_periodic_occevent_orbits(
@@ -61,7 +103,7 @@ std::vector<std::set<OccEvent>> make_prim_periodic_occevent_orbits(
     std::vector<clust::IntegralCluster> const &clusters,
     std::vector<OccEventRep> const &occevent_symgroup_rep,
     OccEventCounterParameters const &params,
-    std::vector<OccEvent> const &custom_events = {});
+    std::vector<OccEvent> const &custom_events = {}, Index n_threads = 1);
 
 }  // namespace occ_events
 }  // namespace CASM
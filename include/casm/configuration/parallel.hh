@@ -0,0 +1,96 @@
+#ifndef CASM_config_parallel
+#define CASM_config_parallel
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Return the default number of threads used by parallel functions
+Index default_n_threads();
+
+/// \brief Set the default number of threads used by parallel functions
+void set_default_n_threads(Index n_threads);
+
+/// \brief Return the number of threads to use
+Index resolve_n_threads(Index n_threads);
+
+/// \brief Run `task(i)` for each `i` in `[0, n_tasks)` on the process-wide
+///     thread pool, and wait for all to finish
+void run_on_thread_pool(Index n_tasks, std::function<void(Index)> const &task);
+
+/// \brief Split [0, n) into contiguous chunks and process them in parallel
+template <typename F>
+void parallel_for_chunks(Index n, Index n_threads, F f);
+
+// --- Inline definitions ---
+
+/// \brief Return the number of threads to use
+///
+/// \param n_threads Requested number of threads. If `n_threads` > 0, it is
+///     returned. Otherwise, returns `default_n_threads()`.
+inline Index resolve_n_threads(Index n_threads) {
+  if (n_threads > 0) {
+    return n_threads;
+  }
+  return default_n_threads();
+}
+
+/// \brief Split [0, n) into contiguous chunks and process them in parallel
+///
+/// \param n Number of items
+/// \param n_threads Number of chunks to split the items into. If <= 0, uses
+///     `resolve_n_threads(n_threads)`.
+/// \param f Function with signature `void f(Index chunk_index, Index begin,
+///     Index end)`, which processes items `[begin, end)`. Chunks are
+///     contiguous, in order of `chunk_index`, and there are at most
+///     `n_threads` of them. It must be safe to call `f` concurrently.
+///
+/// Notes:
+/// - Chunks are run by `run_on_thread_pool`, so the number of threads
+///   actually running chunks is limited by the size of the process-wide
+///   thread pool, including when called from inside another chunk, but the
+///   chunks themselves do not depend on the pool size.
+/// - If only one chunk is needed, `f` is called on the calling thread.
+/// - If any call to `f` throws, all chunks are finished and then the
+///   exception from the lowest `chunk_index` is rethrown.
+template <typename F>
+void parallel_for_chunks(Index n, Index n_threads, F f) {
+  if (n <= 0) {
+    return;
+  }
+  Index n_chunks = std::min(resolve_n_threads(n_threads), n);
+  if (n_chunks == 1) {
+    f(0, 0, n);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(n_chunks);
+  Index chunk_size = n / n_chunks;
+  Index remainder = n % n_chunks;
+  run_on_thread_pool(n_chunks, [&](Index c) {
+    Index begin = c * chunk_size + std::min(c, remainder);
+    Index end = begin + chunk_size + (c < remainder ? 1 : 0);
+    try {
+      f(c, begin, end);
+    } catch (...) {
+      errors[c] = std::current_exception();
+    }
+  });
+  for (auto const &e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
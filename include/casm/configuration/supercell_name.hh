@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include "casm/global/eigen.hh"
+
 namespace CASM {
 namespace xtal {
 class Lattice;
@@ -11,6 +13,10 @@ struct SymOp;
 }  // namespace xtal
 namespace config {
 
+/// \brief Make the supercell name from a transformation matrix
+std::string make_supercell_name(
+    Eigen::Matrix3l const &transformation_matrix_to_super);
+
 /// \brief Make the supercell name of a superlattice
 std::string make_supercell_name(xtal::Lattice const &prim_lattice,
                                 xtal::Lattice const &superlattice);
@@ -19,6 +25,10 @@ std::string make_supercell_name(xtal::Lattice const &prim_lattice,
 xtal::Lattice make_superlattice_from_supercell_name(
     xtal::Lattice const &prim_lattice, std::string supercell_name);
 
+/// \brief Make the transformation matrix, in hermite normal form, from the
+///     supercell name
+Eigen::Matrix3l make_hermite_normal_form(std::string hermite_normal_form_name);
+
 }  // namespace config
 }  // namespace CASM
 
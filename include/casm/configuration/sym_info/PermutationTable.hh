@@ -0,0 +1,245 @@
+#ifndef CASM_config_sym_info_PermutationTable
+#define CASM_config_sym_info_PermutationTable
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/configuration/sym_info/definitions.hh"
+
+namespace CASM {
+namespace config {
+namespace sym_info {
+
+/// \brief Contiguous storage of equal size permutations, with compact
+///     integer entries
+///
+/// Entries are site indices in `[0, n_sites)`, stored as `std::uint16_t` if
+/// `n_sites <= 65536` and as `std::uint32_t` otherwise, rather than as
+/// `Index`. This uses 1/4 or 1/2 of the memory of
+/// `std::vector<Permutation>`, and reduces the cache bandwidth used by
+/// permutation lookups.
+///
+/// Accessors return `Index`. Loops over many entries should use `visit` to
+/// obtain a pointer of the stored integer type, so that the width is checked
+/// once, not for each entry:
+///
+/// \code
+/// table.visit(k, [&](auto const *perm) {
+///   for (Index i = 0; i < table.permutation_size(); ++i) {
+///     after[i] = before[perm[i]];
+///   }
+/// });
+/// \endcode
+///
+/// Entries of a row need not be a complete permutation, which allows storing
+/// permutations restricted to a subset of sites, such as in
+/// CombinedPermutationTable.
+class PermutationTable {
+ public:
+  /// \brief A view of one permutation in a PermutationTable
+  ///
+  /// Not valid after the PermutationTable is modified or destroyed.
+  class Row {
+   public:
+    Row(std::uint16_t const *_narrow, std::uint32_t const *_wide,
+        Index _size)
+        : m_narrow(_narrow), m_wide(_wide), m_size(_size) {}
+
+    /// \brief Returns entry `i`
+    Index operator[](Index i) const {
+      return m_narrow ? Index(m_narrow[i]) : Index(m_wide[i]);
+    }
+
+    /// \brief Number of entries
+    Index size() const { return m_size; }
+
+    /// \brief Copy as a Permutation
+    operator Permutation() const {
+      Permutation perm(m_size);
+      for (Index i = 0; i < m_size; ++i) {
+        perm[i] = (*this)[i];
+      }
+      return perm;
+    }
+
+   private:
+    std::uint16_t const *m_narrow;
+    std::uint32_t const *m_wide;
+    Index m_size;
+  };
+
+  /// \brief Default constructor, no permutations
+  PermutationTable() : PermutationTable(0, 0, 0) {}
+
+  /// \brief Constructor, with all entries zero
+  ///
+  /// \param _size The number of permutations
+  /// \param _permutation_size The number of entries in each permutation
+  /// \param _n_sites All entries are in `[0, _n_sites)`, which determines
+  ///     the stored integer type
+  PermutationTable(Index _size, Index _permutation_size, Index _n_sites)
+      : m_size(_size),
+        m_permutation_size(_permutation_size),
+        m_n_sites(_n_sites),
+        m_is_wide(entry_bytes(_n_sites) == sizeof(std::uint32_t)) {
+    if (_n_sites > Index(std::numeric_limits<std::uint32_t>::max()) + 1) {
+      throw std::runtime_error(
+          "Error constructing PermutationTable: too many sites");
+    }
+    if (m_is_wide) {
+      m_wide.resize(m_size * m_permutation_size, 0);
+    } else {
+      m_narrow.resize(m_size * m_permutation_size, 0);
+    }
+  }
+
+  /// \brief Constructor, from permutations of equal size
+  explicit PermutationTable(std::vector<Permutation> const &permutations)
+      : PermutationTable(permutations.size(),
+                         permutations.empty() ? 0 : permutations[0].size(),
+                         permutations.empty() ? 0 : permutations[0].size()) {
+    for (Index k = 0; k < m_size; ++k) {
+      if (Index(permutations[k].size()) != m_permutation_size) {
+        throw std::runtime_error(
+            "Error constructing PermutationTable: permutation size mismatch");
+      }
+      for (Index i = 0; i < m_permutation_size; ++i) {
+        set(k, i, permutations[k][i]);
+      }
+    }
+  }
+
+  /// \brief Size, in bytes, of the integer type used to store entries in
+  ///     `[0, n_sites)`
+  static Index entry_bytes(Index n_sites) {
+    if (n_sites > Index(std::numeric_limits<std::uint16_t>::max()) + 1) {
+      return sizeof(std::uint32_t);
+    }
+    return sizeof(std::uint16_t);
+  }
+
+  /// \brief Number of permutations
+  Index size() const { return m_size; }
+
+  /// \brief True if there are no permutations
+  bool empty() const { return m_size == 0; }
+
+  /// \brief Number of entries in each permutation
+  Index permutation_size() const { return m_permutation_size; }
+
+  /// \brief Entries are in `[0, n_sites())`
+  Index n_sites() const { return m_n_sites; }
+
+  /// \brief True if entries are stored as `std::uint32_t`, false if stored
+  ///     as `std::uint16_t`
+  bool is_wide() const { return m_is_wide; }
+
+  /// \brief Returns entry `i` of permutation `k`
+  Index operator()(Index k, Index i) const {
+    Index n = k * m_permutation_size + i;
+    return m_is_wide ? Index(m_wide[n]) : Index(m_narrow[n]);
+  }
+
+  /// \brief Returns a view of permutation `k`
+  Row operator[](Index k) const {
+    Index n = k * m_permutation_size;
+    if (m_is_wide) {
+      return Row(nullptr, m_wide.data() + n, m_permutation_size);
+    }
+    return Row(m_narrow.data() + n, nullptr, m_permutation_size);
+  }
+
+  /// \brief Set entry `i` of permutation `k`
+  void set(Index k, Index i, Index value) {
+    Index n = k * m_permutation_size + i;
+    if (m_is_wide) {
+      m_wide[n] = value;
+    } else {
+      m_narrow[n] = value;
+    }
+  }
+
+  /// \brief Call `f(perm)`, where `perm` is a pointer of the stored integer
+  ///     type to the entries of permutation `k`
+  template <typename F>
+  void visit(Index k, F &&f) const {
+    Index n = k * m_permutation_size;
+    if (m_is_wide) {
+      f(m_wide.data() + n);
+    } else {
+      f(m_narrow.data() + n);
+    }
+  }
+
+  /// \brief Call `f(perm)`, where `perm` is a mutable pointer of the stored
+  ///     integer type to the entries of permutation `k`
+  template <typename F>
+  void visit_mutable(Index k, F &&f) {
+    Index n = k * m_permutation_size;
+    if (m_is_wide) {
+      f(m_wide.data() + n);
+    } else {
+      f(m_narrow.data() + n);
+    }
+  }
+
+  /// \brief Copy permutation `k` into `perm`, re-using its capacity
+  void copy_permutation(Index k, Permutation &perm) const {
+    perm.resize(m_permutation_size);
+    visit(k, [&](auto const *entries) {
+      for (Index i = 0; i < m_permutation_size; ++i) {
+        perm[i] = entries[i];
+      }
+    });
+  }
+
+  /// \brief Copy all permutations
+  std::vector<Permutation> permutations() const {
+    std::vector<Permutation> result(m_size);
+    for (Index k = 0; k < m_size; ++k) {
+      copy_permutation(k, result[k]);
+    }
+    return result;
+  }
+
+  /// \brief Memory used by the entries, in bytes
+  Index memory_bytes() const {
+    return m_narrow.size() * sizeof(std::uint16_t) +
+           m_wide.size() * sizeof(std::uint32_t);
+  }
+
+  /// \brief True if all entries are equal
+  bool operator==(PermutationTable const &other) const {
+    return m_size == other.m_size &&
+           m_permutation_size == other.m_permutation_size &&
+           m_n_sites == other.m_n_sites && m_narrow == other.m_narrow &&
+           m_wide == other.m_wide;
+  }
+
+  bool operator!=(PermutationTable const &other) const {
+    return !(*this == other);
+  }
+
+ private:
+  Index m_size;
+
+  Index m_permutation_size;
+
+  Index m_n_sites;
+
+  bool m_is_wide;
+
+  /// Entries, by `k * permutation_size + i`, if not m_is_wide
+  std::vector<std::uint16_t> m_narrow;
+
+  /// Entries, by `k * permutation_size + i`, if m_is_wide
+  std::vector<std::uint32_t> m_wide;
+};
+
+}  // namespace sym_info
+}  // namespace config
+}  // namespace CASM
+
+#endif
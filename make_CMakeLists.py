@@ -183,5 +183,9 @@ files = unit_test_source_files("unit/occ_events", additional)
 cmake_file_strings = as_cmake_file_strings(files)
 cmakelists = cmakelists.replace("@casm_unit_occ_events_source_files@", cmake_file_strings)
 
+files = sorted(unit_test_source_files("bench", []))
+cmake_file_strings = as_cmake_file_strings(files)
+cmakelists = cmakelists.replace("@casm_configuration_bench_source_files@", cmake_file_strings)
+
 with open("CMakeLists.txt", "w") as f:
     f.write(cmakelists)
@@ -0,0 +1,91 @@
+import pytest
+from conftest import make_binary_prim, prim_volume_params
+
+import libcasm.configuration as casmconfig
+import libcasm.enumerate as casmenum
+
+#: Volume sweeps for the configurations analyzed or converted
+ANALYSIS_VOLUMES = {
+    "FCC": [2, 4, 6],
+    "BCC": [2, 4, 6],
+    "HCP": [1, 2, 3],
+}
+
+
+def make_enumerated_configurations(prim_name: str, max_volume: int):
+    """Return the prim and all distinct binary configurations up to
+    `max_volume`, as a dict by configuration name"""
+    prim = make_binary_prim(prim_name)
+    supercell_set = casmconfig.SupercellSet(prim=prim)
+    config_enum = casmenum.ConfigEnumAllOccupations(
+        prim=prim,
+        supercell_set=supercell_set,
+    )
+    configurations = {}
+    for i, configuration in enumerate(
+        config_enum.by_supercell(supercells={"max": max_volume})
+    ):
+        configurations[f"config.{i}"] = configuration
+    return prim, configurations
+
+
+@pytest.mark.parametrize("prim_name,max_volume", prim_volume_params(ANALYSIS_VOLUMES))
+@pytest.mark.parametrize("store_equivalents", [True, False])
+def test_config_space_analysis(benchmark, prim_name, max_volume, store_equivalents):
+    prim, configurations = make_enumerated_configurations(prim_name, max_volume)
+
+    def run():
+        return casmconfig.config_space_analysis(
+            configurations=configurations,
+            dofs=["occ"],
+            store_equivalents=store_equivalents,
+        )
+
+    results = benchmark(run)
+    benchmark.extra_info["n_configurations"] = len(configurations)
+    benchmark.extra_info["dim"] = results["occ"].projector.shape[0]
+
+
+@pytest.mark.parametrize("prim_name,max_volume", prim_volume_params(ANALYSIS_VOLUMES))
+def test_ConfigSpaceAnalysisAccumulator_insert(benchmark, prim_name, max_volume):
+    """Insert configurations one at a time, as when streaming from a
+    database"""
+    prim, configurations = make_enumerated_configurations(prim_name, max_volume)
+
+    def run():
+        accumulator = casmconfig.ConfigSpaceAnalysisAccumulator(prim, "occ")
+        for name, configuration in configurations.items():
+            accumulator.insert({name: configuration})
+        return accumulator.n_prototypes()
+
+    benchmark.extra_info["n_prototypes"] = benchmark(run)
+
+
+@pytest.mark.parametrize("prim_name,max_volume", prim_volume_params(ANALYSIS_VOLUMES))
+def test_make_canonical_configuration(benchmark, prim_name, max_volume):
+    """Call make_canonical_configuration once per configuration"""
+    prim, configurations = make_enumerated_configurations(prim_name, max_volume)
+
+    def run():
+        for configuration in configurations.values():
+            casmconfig.make_canonical_configuration(configuration)
+
+    benchmark(run)
+    benchmark.extra_info["n_configurations"] = len(configurations)
+
+
+@pytest.mark.parametrize("prim_name,max_volume", prim_volume_params(ANALYSIS_VOLUMES))
+def test_ConfigurationSet_dict_round_trip(benchmark, prim_name, max_volume):
+    """Convert a ConfigurationSet to a Python dict and back"""
+    prim, configurations = make_enumerated_configurations(prim_name, max_volume)
+    configuration_set = casmconfig.ConfigurationSet()
+    for configuration in configurations.values():
+        configuration_set.add(configuration)
+
+    def run():
+        supercell_set = casmconfig.SupercellSet(prim=prim)
+        data = configuration_set.to_dict()
+        return casmconfig.ConfigurationSet.from_dict(data, supercell_set)
+
+    benchmark(run)
+    benchmark.extra_info["n_configurations"] = len(configuration_set)
@@ -0,0 +1,63 @@
+"""Python benchmarks of libcasm.enumerate and libcasm.configuration
+
+These measure the Python layer (argument and object conversion, Python
+iteration and callbacks) in addition to the C++ methods benchmarked by
+casm_configuration_bench. They are not run with the tests. Requires
+pytest-benchmark (see `bench_requirements.txt`):
+
+.. code-block:: bash
+
+    pip install -r bench_requirements.txt
+    pytest python/bench --benchmark-autosave
+    # ... make changes, reinstall ...
+    pytest python/bench --benchmark-compare
+
+Use ``-k`` to select benchmarks, for example ``-k "FCC and not HCP"``.
+"""
+
+import numpy as np
+import pytest
+
+import libcasm.configuration as casmconfig
+import libcasm.xtal as xtal
+import libcasm.xtal.prims as xtal_prims
+
+#: Prim factories, by name, with binary occupation DoF
+BINARY_PRIMS = {
+    "FCC": lambda **kwargs: xtal_prims.FCC(r=1.0, occ_dof=["A", "B"], **kwargs),
+    "BCC": lambda **kwargs: xtal_prims.BCC(r=1.0, occ_dof=["A", "B"], **kwargs),
+    "HCP": lambda **kwargs: xtal_prims.HCP(r=1.0, occ_dof=["A", "B"], **kwargs),
+}
+
+#: Maximum supercell volume sweeps, by prim name, chosen so that the largest
+#: volume takes on the order of a second
+MAX_VOLUMES = {
+    "FCC": [4, 6, 8],
+    "BCC": [4, 6, 8],
+    "HCP": [2, 3, 4],
+}
+
+
+def prim_volume_params(max_volumes=MAX_VOLUMES):
+    """Return `pytest.param` values ``(prim_name, max_volume)``, for all
+    prim and volume sweeps"""
+    return [
+        pytest.param(name, volume, id=f"{name}-vol{volume}")
+        for name, volumes in max_volumes.items()
+        for volume in volumes
+    ]
+
+
+def make_binary_prim(name: str, **kwargs) -> casmconfig.Prim:
+    """Make a binary FCC, BCC, or HCP :class:`~libcasm.configuration.Prim`"""
+    return casmconfig.Prim(BINARY_PRIMS[name](**kwargs))
+
+
+def make_binary_Hstrain_prim(name: str) -> casmconfig.Prim:
+    """Make a binary FCC, BCC, or HCP prim, with Hencky strain DoF"""
+    return make_binary_prim(name, global_dof=[xtal.DoFSetBasis("Hstrain")])
+
+
+def make_diagonal_supercell(prim: casmconfig.Prim, n: int) -> casmconfig.Supercell:
+    """Make the supercell with transformation matrix ``n * I``"""
+    return casmconfig.Supercell(prim, np.eye(3, dtype=int) * n)
@@ -0,0 +1,155 @@
+import numpy as np
+import pytest
+from conftest import (
+    make_binary_Hstrain_prim,
+    make_binary_prim,
+    make_diagonal_supercell,
+    prim_volume_params,
+)
+
+import libcasm.clexulator as casmclex
+import libcasm.configuration as casmconfig
+import libcasm.enumerate as casmenum
+import libcasm.occ_events as occ_events
+import libcasm.xtal as xtal
+
+
+@pytest.mark.parametrize("prim_name,max_volume", prim_volume_params())
+def test_ScelEnum_by_volume(benchmark, prim_name, max_volume):
+    prim = make_binary_prim(prim_name)
+
+    def run():
+        supercell_set = casmconfig.SupercellSet(prim=prim)
+        scel_enum = casmenum.ScelEnum(prim=prim, supercell_set=supercell_set)
+        return sum(1 for _ in scel_enum.by_volume(max=max_volume))
+
+    benchmark.extra_info["n_supercells"] = benchmark(run)
+
+
+@pytest.mark.parametrize("prim_name,max_volume", prim_volume_params())
+def test_ConfigEnumAllOccupations_by_supercell(benchmark, prim_name, max_volume):
+    prim = make_binary_prim(prim_name)
+
+    def run():
+        supercell_set = casmconfig.SupercellSet(prim=prim)
+        config_enum = casmenum.ConfigEnumAllOccupations(
+            prim=prim,
+            supercell_set=supercell_set,
+        )
+        return sum(1 for _ in config_enum.by_supercell(supercells={"max": max_volume}))
+
+    benchmark.extra_info["n_configurations"] = benchmark(run)
+
+
+@pytest.mark.parametrize(
+    "prim_name,max_volume",
+    prim_volume_params({"FCC": [6], "BCC": [6], "HCP": [3]}),
+)
+def test_ConfigEnumAllOccupations_to_ConfigurationSet(
+    benchmark, prim_name, max_volume
+):
+    """Enumerate, collect in a ConfigurationSet, and filter with a Python
+    function called once per configuration"""
+    prim = make_binary_prim(prim_name)
+
+    def is_dilute(configuration):
+        return np.count_nonzero(configuration.occupation) <= 2
+
+    def run():
+        supercell_set = casmconfig.SupercellSet(prim=prim)
+        configuration_set = casmconfig.ConfigurationSet()
+        config_enum = casmenum.ConfigEnumAllOccupations(
+            prim=prim,
+            supercell_set=supercell_set,
+        )
+        for configuration in config_enum.by_supercell(supercells={"max": max_volume}):
+            if is_dilute(configuration):
+                configuration_set.add(configuration)
+        return len(configuration_set)
+
+    benchmark.extra_info["n_configurations"] = benchmark(run)
+
+
+@pytest.mark.parametrize("prim_name", ["FCC", "BCC", "HCP"])
+@pytest.mark.parametrize("num", [3, 4, 5])
+@pytest.mark.parametrize("skip_equivalents", [False, True])
+def test_ConfigEnumMeshGrid_by_range_Hstrain(
+    benchmark, prim_name, num, skip_equivalents
+):
+    prim = make_binary_Hstrain_prim(prim_name)
+    dof_space = casmclex.DoFSpace(dof_key="Hstrain", xtal_prim=prim.xtal_prim)
+    supercell_set = casmconfig.SupercellSet(prim=prim)
+    background = casmconfig.Configuration(make_diagonal_supercell(prim, 1))
+
+    def run():
+        config_enum = casmenum.ConfigEnumMeshGrid(
+            prim=prim,
+            supercell_set=supercell_set,
+        )
+        return sum(
+            1
+            for _ in config_enum.by_range(
+                background=background,
+                dof_space=dof_space,
+                start=-0.1,
+                stop=0.1,
+                num=num,
+                skip_equivalents=skip_equivalents,
+            )
+        )
+
+    benchmark.extra_info["n_configurations"] = benchmark(run)
+
+
+def make_nn_exchange_event(xtal_prim: xtal.Prim) -> occ_events.OccEvent:
+    """Make an A-B exchange between a site and one of its nearest
+    neighbors"""
+    if xtal_prim.coordinate_frac().shape[1] == 1:
+        site1 = xtal.IntegralSiteCoordinate(sublattice=0, unitcell=[0, 0, 0])
+        site2 = xtal.IntegralSiteCoordinate(sublattice=0, unitcell=[1, 0, 0])
+    else:
+        # HCP: sublattice 0 and 1 sites in the same unit cell are
+        # nearest neighbors
+        site1 = xtal.IntegralSiteCoordinate(sublattice=0, unitcell=[0, 0, 0])
+        site2 = xtal.IntegralSiteCoordinate(sublattice=1, unitcell=[0, 0, 0])
+    A, B = 0, 1
+    return occ_events.OccEvent(
+        [
+            [
+                occ_events.OccPosition.molecule(site1, A),
+                occ_events.OccPosition.molecule(site2, A),
+            ],
+            [
+                occ_events.OccPosition.molecule(site2, B),
+                occ_events.OccPosition.molecule(site1, B),
+            ],
+        ]
+    )
+
+
+@pytest.mark.parametrize("prim_name", ["FCC", "BCC", "HCP"])
+@pytest.mark.parametrize("n", [3, 4])
+@pytest.mark.parametrize("n_threads", [1, 4])
+def test_make_all_distinct_local_perturbations(benchmark, prim_name, n, n_threads):
+    """Perturb the point clusters within the nearest neighbor distance of
+    the event sites, in the ``n * I`` supercell"""
+    prim = make_binary_prim(prim_name)
+    occ_event = make_nn_exchange_event(prim.xtal_prim)
+    cluster_specs = occ_events.make_occevent_cluster_specs(
+        xtal_prim=prim.xtal_prim,
+        phenomenal_occ_event=occ_event,
+        max_length=[0.0, 0.0],
+        cutoff_radius=[0.0, 2.01],
+    )
+    local_clusters = [orbit[0] for orbit in cluster_specs.make_orbits()]
+    motif = casmconfig.Configuration(make_diagonal_supercell(prim, 1))
+    supercell = make_diagonal_supercell(prim, n)
+
+    def run():
+        return len(
+            casmenum.make_all_distinct_local_perturbations(
+                supercell, occ_event, motif, local_clusters, n_threads=n_threads
+            )
+        )
+
+    benchmark.extra_info["n_configurations"] = benchmark(run)
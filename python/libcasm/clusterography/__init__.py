@@ -27,6 +27,9 @@ from ._clusterography import (
     Cluster,
     ClusterOrbitGenerator,
     ClusterSpecs,
+    OrbitIndexTable,
+    OrbitTable,
+    clear_orbit_cache,
     equivalents_info_from_dict,
     make_cluster_group,
     make_integral_site_coordinate_symgroup_rep,
@@ -36,6 +39,9 @@ from ._clusterography import (
     make_periodic_equivalence_map,
     make_periodic_equivalence_map_indices,
     make_periodic_orbit,
+    read_equivalents_info_binary,
+    set_orbit_cache_dir,
+    write_equivalents_info_binary,
 )
 from ._methods import (
     make_local_cluster_specs,
@@ -1,29 +1,51 @@
 """Supercells and configurations"""
 from ._configuration import (
+    AtomicStructures,
+    ConfigSpaceAnalysisAccumulator,
     ConfigSpaceAnalysisResults,
     Configuration,
+    ConfigurationBatch,
     ConfigurationRecord,
     ConfigurationSet,
     ConfigurationWithProperties,
     DoFSpaceAnalysisResults,
+    OperationCancelled,
     Prim,
+    ProgressMonitor,
     Supercell,
     SupercellRecord,
     SupercellSet,
     SupercellSymOp,
     apply,
+    clear_dof_space_analysis_cache,
+    clear_matrix_rep_cache,
+    clear_prim_sym_info_cache,
     config_space_analysis,
+    configurations_to_dicts,
     copy_apply,
     copy_configuration,
     copy_transformed_configuration,
+    default_n_threads,
     dof_space_analysis,
+    enforce_memory_budget,
+    find_non_canonical_witness,
     from_canonical_configuration,
+    instrumentation_is_compiled,
+    instrumentation_is_enabled,
+    instrumentation_results,
     is_canonical_configuration,
+    is_canonical_configurations,
+    is_canonical_occupations,
     is_canonical_supercell,
     is_primitive_configuration,
+    is_primitive_configurations,
     make_all_super_configurations,
     make_all_super_configurations_by_subsets,
+    make_atomic_structures,
     make_canonical_configuration,
+    make_canonical_configurations,
+    make_canonical_occupations,
+    make_canonical_super_configurations,
     make_canonical_supercell,
     make_distinct_super_configurations,
     make_dof_space_rep,
@@ -32,7 +54,20 @@ from ._configuration import (
     make_global_dof_matrix_rep,
     make_invariant_subgroup,
     make_local_dof_matrix_rep,
+    make_order_parameters,
     make_primitive_configuration,
+    memory_budget,
+    memory_usage,
+    numa_node_count,
+    numa_replication_is_enabled,
+    reset_instrumentation,
+    set_default_n_threads,
+    set_dof_space_analysis_cache_dir,
+    set_matrix_rep_cache_max_bytes,
+    set_memory_budget,
+    set_numa_replication_enabled,
+    set_prim_sym_info_cache_dir,
+    set_instrumentation_enabled,
     to_canonical_configuration,
 )
 from ._misc import (
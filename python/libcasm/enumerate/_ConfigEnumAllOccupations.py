@@ -8,8 +8,12 @@ import libcasm.xtal as xtal
 
 from ._enumerate import (
     ConfigEnumAllOccupationsBase,
+    ConfigEnumCanonicalOccupationsBase,
+    estimate_occupations_parallel,
     make_distinct_cluster_sites,
+    make_occupations_parallel,
 )
+from ._methods import _iter_batches
 from ._ScelEnum import ScelEnum
 
 
@@ -30,6 +34,7 @@ class ConfigEnumAllOccupations:
         self,
         prim: casmconfig.Prim,
         supercell_set: Optional[casmconfig.SupercellSet] = None,
+        prefetch_batches: int = 0,
     ):
         """
         .. rubric:: Constructor
@@ -41,14 +46,25 @@ class ConfigEnumAllOccupations:
         supercell_set: Optional[casmconfig.SupercellSet] = None
             If not None, generated :class:`~casmconfig.Supercell` are constructed by
             adding in the :class:`~casmconfig.SupercellSet`.
+        prefetch_batches: int = 0
+            If > 0, configurations are enumerated in C++ on a background
+            thread, which does not hold the GIL, up to `prefetch_batches`
+            batches of 1000 configurations ahead of those yielded, so that
+            work done in Python on yielded configurations overlaps with
+            enumeration. If 0, configurations are enumerated only while the
+            next configuration is requested.
         """
         self._prim = prim
         self._supercell_set = supercell_set
+        self._prefetch_batches = prefetch_batches
 
         # Set and updated during an enumeration
         self._background = None
         self._sites = None
         self._enum_index = None
+        self._supercell_index = None
+        self._background_index = None
+        self._last = None
 
     @property
     def prim(self) -> casmconfig.Prim:
@@ -61,6 +77,12 @@ class ConfigEnumAllOccupations:
         adding in the :class:`~casmconfig.SupercellSet`."""
         return self._supercell_set
 
+    @property
+    def prefetch_batches(self) -> int:
+        """The number of batches enumerated ahead on a background thread, or 0
+        if not prefetching."""
+        return self._prefetch_batches
+
     @property
     def background(self) -> Optional[casmconfig.Configuration]:
         """During enumeration, `background` is set to the current background
@@ -80,11 +102,55 @@ class ConfigEnumAllOccupations:
         performed, starting from 0."""
         return self._enum_index
 
+    def checkpoint(self) -> Optional[dict]:
+        """Return the state needed to resume a `by_supercell` or
+        `by_supercell_list` enumeration after the most recently yielded
+        configuration
+
+        The checkpoint can be saved, for instance as JSON, and passed as the
+        `resume` argument of the same method, with the same arguments, to
+        continue the enumeration in another process. The resumed enumeration
+        then yields the configurations that would have been yielded after the
+        checkpoint, in the same order, and `enum_index` continues with the
+        same values.
+
+        Returns
+        -------
+        checkpoint: Optional[dict]
+            None if no `by_supercell` or `by_supercell_list` enumeration has
+            begun, otherwise a dict with keys:
+
+            - ``"supercell_index"``: int, index of the current supercell in the
+              sequence of supercells
+            - ``"background_index"``: int, index of the current background
+              configuration in the supercell
+            - ``"enum_index"``: int, the current `enum_index`
+            - ``"occupation"``: Optional[list[int]], the occupation, on the
+              enumerated sites, of the most recently yielded configuration, or
+              None if none has been yielded in the current background
+              configuration
+        """
+        if self._supercell_index is None:
+            return None
+        occupation = None
+        if self._last is not None:
+            occ = self._last.occupation
+            occupation = [int(occ[i]) for i in sorted(self._sites)]
+        return {
+            "supercell_index": self._supercell_index,
+            "background_index": self._background_index,
+            "enum_index": self._enum_index,
+            "occupation": occupation,
+        }
+
     def _begin(self):
         """Initialize values"""
         self._background = None
         self._sites = None
         self._enum_index = None
+        self._supercell_index = None
+        self._background_index = None
+        self._last = None
 
     def _set_motif(self, motif: Optional[casmconfig.Configuration] = None):
         """Check motif and use volume 1 default configuration if not provided"""
@@ -129,6 +195,7 @@ class ConfigEnumAllOccupations:
         sites: set[int],
         skip_non_primitive: bool,
         skip_non_canonical: bool,
+        resume_occupation: Optional[list[int]] = None,
     ):
         """Run the inner loop of enumerating occupations on sites in a background
 
@@ -149,6 +216,9 @@ class ConfigEnumAllOccupations:
             If True, enumeration skips non-canonical configurations with respect
             to the subgroup that leaves the background configuration invariant
             and does not mix the given sites and other sites.
+        resume_occupation: Optional[list[int]] = None
+            If not None, the occupation on `sites` of a previously yielded
+            configuration. Enumeration resumes after it.
 
         Yields
         ------
@@ -157,33 +227,84 @@ class ConfigEnumAllOccupations:
         """
         self._background = background
         self._sites = sites
+        self._last = None
         if self._enum_index is None:
             self._enum_index = 0
         else:
             self._enum_index += 1
-        config_enum = ConfigEnumAllOccupationsBase(
-            background=background,
-            sites=sites,
-        )
+        # filtering is done in C++, and configurations are returned in batches
         if skip_non_canonical:
             background_fg = casmconfig.make_invariant_subgroup(
                 configuration=background,
                 site_indices=sites,
             )
-        while config_enum.is_valid():
-            if skip_non_primitive and not casmconfig.is_primitive_configuration(
-                configuration=config_enum.value()
-            ):
-                config_enum.advance()
-                continue
-            if skip_non_canonical and not casmconfig.is_canonical_configuration(
-                configuration=config_enum.value(),
-                subgroup=background_fg,
-            ):
-                config_enum.advance()
-                continue
-            yield config_enum.value()
+            config_enum = ConfigEnumCanonicalOccupationsBase(
+                background=background,
+                sites=sites,
+                group=background_fg,
+                skip_non_primitive=skip_non_primitive,
+            )
+        else:
+            config_enum = ConfigEnumAllOccupationsBase(
+                background=background,
+                sites=sites,
+                skip_non_primitive=skip_non_primitive,
+                canonical_subgroup=None,
+            )
+        if resume_occupation is not None:
+            config_enum.resume(resume_occupation)
             config_enum.advance()
+        for batch in _iter_batches(
+            config_enum, batch_size=1000, prefetch_batches=self.prefetch_batches
+        ):
+            for config in batch:
+                self._last = config
+                yield config
+
+    def _by_supercell_iterable(
+        self,
+        supercells,
+        motif: casmconfig.Configuration,
+        skip_non_primitive: bool,
+        skip_non_canonical: bool,
+        resume: Optional[dict],
+    ):
+        """Enumerate all occupations in each supercell, optionally resuming
+        from a checkpoint"""
+        resume_occupation = None
+        for supercell_index, supercell in enumerate(supercells):
+            if resume is not None:
+                if supercell_index < resume["supercell_index"]:
+                    continue
+                if resume["background_index"] is None:
+                    # checkpoint was before any background in this supercell
+                    self._enum_index = resume["enum_index"]
+                    resume = None
+            self._supercell_index = supercell_index
+            self._background_index = None
+            sites = set(range(supercell.n_sites))
+            super_configurations = casmconfig.make_distinct_super_configurations(
+                motif=motif, supercell=supercell
+            )
+            for background_index, background in enumerate(super_configurations):
+                if resume is not None:
+                    if background_index < resume["background_index"]:
+                        continue
+                    # continue from the checkpoint's background, sites, and
+                    # enum_index
+                    resume_occupation = resume["occupation"]
+                    self._enum_index = resume["enum_index"] - 1
+                    resume = None
+                self._background_index = background_index
+                for config in self._by_site(
+                    background=background,
+                    sites=sites,
+                    skip_non_primitive=skip_non_primitive,
+                    skip_non_canonical=skip_non_canonical,
+                    resume_occupation=resume_occupation,
+                ):
+                    yield config
+                resume_occupation = None
 
     def by_supercell(
         self,
@@ -191,6 +312,7 @@ class ConfigEnumAllOccupations:
         motif: Optional[casmconfig.Configuration] = None,
         skip_non_primitive: bool = True,
         skip_non_canonical: bool = True,
+        resume: Optional[dict] = None,
     ):
         """Enumerate all occupations in a series of enumerated supercells
 
@@ -199,6 +321,8 @@ class ConfigEnumAllOccupations:
         supercells: dict
             Parameters to forward to :class:`~libcasm.configuration.ScelEnum`, to
             specify the supercells that the motif configruation will be filled into.
+            Include `shard_index` and `n_shards` to enumerate in one shard of the
+            supercells (see :func:`~libcasm.enumerate.ScelEnum.by_volume`).
         motif: Optional[casmconfig.Configuration] = None
             The background configuration on which enumeration takes place. The motif is
             filled into each supercell using
@@ -213,6 +337,10 @@ class ConfigEnumAllOccupations:
         skip_non_canonical: bool = True
             If True, enumeration skips non-canonical configurations with respect
             to the subgroup that leaves the background configuration invariant.
+        resume: Optional[dict] = None
+            If not None, a value returned by :func:`checkpoint` during an
+            enumeration with the same arguments. The enumeration resumes after
+            the last configuration yielded before the checkpoint.
 
         Yields
         ------
@@ -225,19 +353,14 @@ class ConfigEnumAllOccupations:
             prim=self.prim,
             supercell_set=self.supercell_set,
         )
-        for supercell in scel_enum.by_volume(**supercells):
-            sites = set(range(supercell.n_sites))
-            super_configurations = casmconfig.make_distinct_super_configurations(
-                motif=motif, supercell=supercell
-            )
-            for background in super_configurations:
-                for config in self._by_site(
-                    background=background,
-                    sites=sites,
-                    skip_non_primitive=skip_non_primitive,
-                    skip_non_canonical=skip_non_canonical,
-                ):
-                    yield config
+        for config in self._by_supercell_iterable(
+            supercells=scel_enum.by_volume(**supercells),
+            motif=motif,
+            skip_non_primitive=skip_non_primitive,
+            skip_non_canonical=skip_non_canonical,
+            resume=resume,
+        ):
+            yield config
 
     def by_supercell_list(
         self,
@@ -245,6 +368,10 @@ class ConfigEnumAllOccupations:
         motif: Optional[casmconfig.Configuration] = None,
         skip_non_primitive: bool = True,
         skip_non_canonical: bool = True,
+        n_threads: Optional[int] = None,
+        resume: Optional[dict] = None,
+        shard_index: int = 0,
+        n_shards: int = 1,
     ):
         """Enumerate all occupations in a list of supercells explicitly provided
 
@@ -266,27 +393,214 @@ class ConfigEnumAllOccupations:
         skip_non_canonical: bool = True
             If True, enumeration skips non-canonical configurations with respect
             to the subgroup that leaves the background configuration invariant.
+        n_threads: Optional[int] = None
+            If not None, enumerate in parallel in C++ using `n_threads`
+            threads (or the number of hardware threads, if <= 0). All
+            configurations are enumerated before the first is yielded, and
+            `background`, `sites`, and `enum_index` are not updated.
+        resume: Optional[dict] = None
+            If not None, a value returned by :func:`checkpoint` during an
+            enumeration with the same arguments. The enumeration resumes after
+            the last configuration yielded before the checkpoint. Not
+            supported if `n_threads` is not None.
+        shard_index: int = 0
+            If `n_shards` > 1, only enumerate in supercells in shard
+            `shard_index`, in the range `[0, n_shards)`.
+        n_shards: int = 1
+            Split the supercells into `n_shards` shards, so that enumeration
+            may be split across processes. The `i`-th supercell belongs to
+            shard `i % n_shards`. Configurations generated by each shard can be
+            combined with :func:`libcasm.configuration.ConfigurationSet.merge`,
+            in order of shard index, to reproduce the configuration IDs of a
+            serial enumeration. A `resume` checkpoint applies to the shard it
+            was made in.
 
         Yields
         ------
         config: casmconfig.Configuration
             A :class:`~casmconfig.Configuration`.
         """
+        if n_shards < 1 or shard_index < 0 or shard_index >= n_shards:
+            raise ValueError(
+                "Error in ConfigEnumAllOccupations.by_supercell_list: "
+                "invalid shard_index or n_shards"
+            )
+        supercells = [
+            supercell
+            for i, supercell in enumerate(supercells)
+            if i % n_shards == shard_index
+        ]
         self._begin()
         motif = self._set_motif(motif)
+        if n_threads is not None:
+            if resume is not None:
+                raise ValueError(
+                    "Error in ConfigEnumAllOccupations.by_supercell_list: "
+                    "resume is not supported with n_threads"
+                )
+            backgrounds = []
+            for supercell in supercells:
+                backgrounds += casmconfig.make_distinct_super_configurations(
+                    motif=motif, supercell=supercell
+                )
+            for config in make_occupations_parallel(
+                backgrounds=backgrounds,
+                skip_non_primitive=skip_non_primitive,
+                skip_non_canonical=skip_non_canonical,
+                n_threads=n_threads,
+            ):
+                yield config
+            return
+        for config in self._by_supercell_iterable(
+            supercells=supercells,
+            motif=motif,
+            skip_non_primitive=skip_non_primitive,
+            skip_non_canonical=skip_non_canonical,
+            resume=resume,
+        ):
+            yield config
+
+    def estimate_by_supercell(
+        self,
+        supercells: dict,
+        motif: Optional[casmconfig.Configuration] = None,
+        skip_non_primitive: bool = True,
+        skip_non_canonical: bool = True,
+        max_sampled_tasks: int = 16,
+        max_task_candidates: float = 65536.0,
+        n_threads: int = 0,
+    ):
+        """Estimate the cost of :func:`by_supercell`, without enumerating all
+        occupations
+
+        Parameters are as for :func:`by_supercell` and
+        :func:`estimate_by_supercell_list`.
+
+        Returns
+        -------
+        estimate: dict
+            The estimate, as returned by :func:`estimate_by_supercell_list`.
+        """
+        scel_enum = ScelEnum(
+            prim=self.prim,
+            supercell_set=self.supercell_set,
+        )
+        return self.estimate_by_supercell_list(
+            supercells=[x for x in scel_enum.by_volume(**supercells)],
+            motif=motif,
+            skip_non_primitive=skip_non_primitive,
+            skip_non_canonical=skip_non_canonical,
+            max_sampled_tasks=max_sampled_tasks,
+            max_task_candidates=max_task_candidates,
+            n_threads=n_threads,
+        )
+
+    def estimate_by_supercell_list(
+        self,
+        supercells: list[casmconfig.Supercell],
+        motif: Optional[casmconfig.Configuration] = None,
+        skip_non_primitive: bool = True,
+        skip_non_canonical: bool = True,
+        max_sampled_tasks: int = 16,
+        max_task_candidates: float = 65536.0,
+        n_threads: int = 0,
+    ):
+        """Estimate the cost of :func:`by_supercell_list`, without enumerating
+        all occupations
+
+        The estimate is made by
+        :func:`~libcasm.enumerate.estimate_occupations_parallel`, which
+        enumerates and times a random sample of the enumeration split into
+        tasks, and extrapolates.
+
+        Parameters
+        ----------
+        supercells: list[casmconfig.Supercell]
+            An explicit list of supercells in which enumeration would be
+            performed.
+        motif: Optional[casmconfig.Configuration] = None
+            The background configuration, as for :func:`by_supercell_list`.
+        skip_non_primitive: bool = True
+            If True, enumeration skips non-primitive configurations.
+        skip_non_canonical: bool = True
+            If True, enumeration skips non-canonical configurations with respect
+            to the subgroup that leaves the background configuration invariant.
+        max_sampled_tasks: int = 16
+            Maximum number of tasks enumerated for each background.
+        max_task_candidates: float = 65536.0
+            Maximum number of candidate occupations in each task.
+        n_threads: int = 0
+            The number of threads used to sample backgrounds concurrently. If
+            <= 0, the number of hardware threads is used.
+
+        Returns
+        -------
+        estimate: dict
+            With keys:
+
+            - "n_backgrounds": int, the number of background configurations
+            - "n_candidates": float, the total number of candidate
+              occupations
+            - "n_configurations": float, the estimated number of enumerated
+              configurations
+            - "n_configurations_is_exact": bool, True if "n_configurations"
+              is exact
+            - "seconds": float, the estimated serial enumeration time, in
+              seconds
+            - "bytes": float, the estimated memory used to hold all
+              enumerated configurations, in bytes
+            - "backgrounds": list[dict], for each background configuration,
+              the supercell "n_unitcells", "max_group_size" (number of
+              supercell operations) and the attributes of
+              :class:`~libcasm.enumerate.OccupationEnumerationEstimate`
+        """
+        motif = self._set_motif(motif)
+        backgrounds = []
         for supercell in supercells:
-            sites = set(range(supercell.n_sites))
-            super_configurations = casmconfig.make_distinct_super_configurations(
+            backgrounds += casmconfig.make_distinct_super_configurations(
                 motif=motif, supercell=supercell
             )
-            for background in super_configurations:
-                for config in self._by_site(
-                    background=background,
-                    sites=sites,
-                    skip_non_primitive=skip_non_primitive,
-                    skip_non_canonical=skip_non_canonical,
-                ):
-                    yield config
+        estimates = estimate_occupations_parallel(
+            backgrounds=backgrounds,
+            skip_non_primitive=skip_non_primitive,
+            skip_non_canonical=skip_non_canonical,
+            max_sampled_tasks=max_sampled_tasks,
+            max_task_candidates=max_task_candidates,
+            n_threads=n_threads,
+        )
+        attrs = [
+            "n_variable_sites",
+            "n_candidates",
+            "group_size",
+            "n_tasks",
+            "n_sampled_tasks",
+            "n_configurations",
+            "n_configurations_is_exact",
+            "seconds",
+            "bytes",
+        ]
+        per_background = []
+        for background, estimate in zip(backgrounds, estimates):
+            supercell = background.supercell
+            data = {
+                "n_unitcells": supercell.n_unitcells,
+                "max_group_size": len(supercell.factor_group.elements)
+                * supercell.n_unitcells,
+            }
+            for attr in attrs:
+                data[attr] = getattr(estimate, attr)
+            per_background.append(data)
+        return {
+            "n_backgrounds": len(backgrounds),
+            "n_candidates": sum(x.n_candidates for x in estimates),
+            "n_configurations": sum(x.n_configurations for x in estimates),
+            "n_configurations_is_exact": all(
+                x.n_configurations_is_exact for x in estimates
+            ),
+            "seconds": sum(x.seconds for x in estimates),
+            "bytes": sum(x.bytes for x in estimates),
+            "backgrounds": per_background,
+        }
 
     def by_linear_site_indices(
         self,
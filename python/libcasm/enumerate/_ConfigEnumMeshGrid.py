@@ -1,4 +1,3 @@
-import copy
 from typing import Optional, Union
 
 import numpy as np
@@ -16,6 +15,12 @@ from libcasm.irreps import (
     SubWedge,
 )
 
+from ._enumerate import (
+    ConfigEnumMeshGridBase,
+    ConfigEnumSubWedgeSamplingBase,
+)
+from ._methods import _iter_batches
+
 
 def _is_corner_point(
     x: np.ndarray,
@@ -48,7 +53,7 @@ def _subwedge_counter(
 
                 # keep point at 0.0 * axis
                 num[subwedge_axis_index] = 2 * num[subwedge_axis_index] - 1
-        subwedge_axis_index += 1
+            subwedge_axis_index += 1
 
     xi = [
         np.linspace(_start, _stop, num=_num)
@@ -243,6 +248,7 @@ class ConfigEnumMeshGrid:
         self,
         prim: casmconfig.Prim,
         supercell_set: Optional[casmconfig.SupercellSet] = None,
+        prefetch_batches: int = 0,
     ):
         """
         .. rubric:: Constructor
@@ -254,9 +260,17 @@ class ConfigEnumMeshGrid:
         supercell_set: Optional[casmconfig.SupercellSet] = None
             If not None, generated :class:`~casmconfig.Supercell` are constructed by
             adding in the :class:`~casmconfig.SupercellSet`.
+        prefetch_batches: int = 0
+            If > 0, configurations are enumerated in C++ on a background
+            thread, which does not hold the GIL, up to `prefetch_batches`
+            batches of 1000 configurations ahead of those yielded, so that
+            work done in Python on yielded configurations overlaps with
+            enumeration. If 0, configurations are enumerated only while the
+            next configuration is requested.
         """
         self._prim = prim
         self._supercell_set = supercell_set
+        self._prefetch_batches = prefetch_batches
 
         # Set and updated during an enumeration
         self._background = None
@@ -276,6 +290,12 @@ class ConfigEnumMeshGrid:
         adding in the :class:`~casmconfig.SupercellSet`."""
         return self._supercell_set
 
+    @property
+    def prefetch_batches(self) -> int:
+        """The number of batches enumerated ahead on a background thread, or 0
+        if not prefetching."""
+        return self._prefetch_batches
+
     @property
     def background(self) -> Optional[casmconfig.Configuration]:
         """During enumeration, `background` is set to the current background
@@ -374,29 +394,29 @@ class ConfigEnumMeshGrid:
             else:
                 canonical_configs = []
 
-        for eta in meshgrid_points(
+        # Points and configurations are generated in C++, in batches
+        config_enum = ConfigEnumMeshGridBase(
             background=background,
             dof_space=dof_space,
-            xi=xi,
-            skip_equivalents=False,  # see note above
-            abs_tol=abs_tol,
+            xi=[np.array(x, dtype=float) for x in xi],
+        )
+        for configs, eta_list, _ in _iter_batches(
+            config_enum, batch_size=1000, prefetch_batches=self.prefetch_batches
         ):
-            config = copy.copy(self.background)
-            config.set_order_parameters(
-                dof_space=dof_space,
-                order_parameters=eta,
-            )
-            if skip_equivalents:
-                canonical_config = casmconfig.make_canonical_configuration(config)
-                if canonical_config in canonical_configs:
-                    continue
-                else:
-                    if is_canonical_background_supercell:
-                        canonical_configs.add(canonical_config)
+            for config, eta in zip(configs, eta_list):
+                if skip_equivalents:
+                    canonical_config = casmconfig.make_canonical_configuration(
+                        config
+                    )
+                    if canonical_config in canonical_configs:
+                        continue
                     else:
-                        canonical_configs.append(canonical_config)
-            self._order_parameters = eta
-            yield config
+                        if is_canonical_background_supercell:
+                            canonical_configs.add(canonical_config)
+                        else:
+                            canonical_configs.append(canonical_config)
+                self._order_parameters = eta
+                yield config
 
     def by_grid_coordinates(
         self,
@@ -618,6 +638,32 @@ class ConfigEnumMeshGrid:
                 'Invalid dof_space, dof_space.dof_key == "occ" is not supported'
             )
 
+        # Points and configurations are generated in C++, in batches
+        config_enum = ConfigEnumMeshGridBase(
+            background=background,
+            dof_space=dof_space,
+            irreducible_wedge=irreducible_wedge,
+            stop=stop,
+            num=num,
+            trim_corners=trim_corners,
+            abs_tol=abs_tol,
+        )
+        for config in self._by_subwedge_enumerator(
+            config_enum=config_enum,
+            background=background,
+            skip_equivalents=skip_equivalents,
+        ):
+            yield config
+
+    def _by_subwedge_enumerator(
+        self,
+        config_enum: Union[ConfigEnumMeshGridBase, ConfigEnumSubWedgeSamplingBase],
+        background: casmconfig.Configuration,
+        skip_equivalents: bool = False,
+    ):
+        """Yield configurations from a C++ enumerator of points in SubWedges, \
+        setting `order_parameters` and `subwedge_index`"""
+
         # Note: Do skip_equivalents work here, using
         # casmconfig.make_canonical_configuration, instead of generating points without
         # equivalents using meshgrid_points(..., skip_equivalents=True) because:
@@ -634,30 +680,236 @@ class ConfigEnumMeshGrid:
             else:
                 canonical_configs = []
 
-        for subwedge_index, eta in irreducible_wedge_points(
+        for configs, eta_list, subwedge_indices in _iter_batches(
+            config_enum, batch_size=1000, prefetch_batches=self.prefetch_batches
+        ):
+            for config, eta, subwedge_index in zip(
+                configs, eta_list, subwedge_indices
+            ):
+                if skip_equivalents:
+                    canonical_config = casmconfig.make_canonical_configuration(
+                        config
+                    )
+                    if canonical_config in canonical_configs:
+                        continue
+                    else:
+                        if is_canonical_background_supercell:
+                            canonical_configs.add(canonical_config)
+                        else:
+                            canonical_configs.append(canonical_config)
+                self._subwedge_index = subwedge_index
+                self._order_parameters = eta
+                yield config
+
+    def _begin_subwedge_enumeration(
+        self,
+        background: casmconfig.Configuration,
+        dof_space: casmclex.DoFSpace,
+        method_name: str,
+    ):
+        self._background = background
+        self._dof_space = dof_space
+        self._enum_index = 0
+
+        if self.supercell_set is not None:
+            self.supercell_set.add_supercell(self.background.supercell)
+
+        if dof_space.dof_key == "occ":
+            raise Exception(
+                f"Error in ConfigEnumMeshGrid.{method_name}: "
+                'Invalid dof_space, dof_space.dof_key == "occ" is not supported'
+            )
+
+    def by_irreducible_wedge_sampling(
+        self,
+        background: casmconfig.Configuration,
+        dof_space: casmclex.DoFSpace,
+        irreducible_wedge: list[SubWedge],
+        stop: float,
+        n_points: int,
+        method: str = "sobol",
+        trim_corners: bool = True,
+        seed: int = 0,
+        skip_equivalents: bool = False,
+        abs_tol: float = libcasm.casmglobal.TOL,
+    ):
+        """Enumerate on points sampled in each subwedge of the irreducible wedge \
+        of a DoFSpace
+
+        Instead of every point of a meshgrid, whose size grows exponentially with
+        the SubWedge dimension, a fixed number of points is sampled in each
+        SubWedge, using a low-discrepancy sequence or a Latin hypercube design so
+        that the points cover the SubWedge evenly.
+
+        Parameters
+        ----------
+        background: casmconfig.Configuration
+            The background configuration on which enumeration takes place.
+        dof_space: casmclex.DoFSpace
+            Specifies the DoF being enumerated. For local DoF, the dof_space
+            supercell must tile the background supercell. Not supported for
+            ``dof_space.dof_key == "occ"``, which raises.
+        irreducible_wedge: list[SubWedge]
+            The irreducible wedge, from a :class:`VectorSpaceSymReport` calculated
+            using :func:`casmconfig.dof_space_analysis` of `background`.
+        stop: float
+            The maximum coordinate along each wedge edge vector. Must be positive.
+
+            The minimum is 0.0, unless the corresponding vector has a symmetric
+            multiplicity of 1, in which case the minimum is ``-stop``, as for
+            :func:`~ConfigEnumMeshGrid.by_irreducible_wedge`.
+        n_points: int
+            The number of points to sample in each SubWedge.
+        method: str = "sobol"
+            The sampling method, one of:
+
+            - "sobol": A Sobol low-discrepancy sequence. Supports SubWedge
+              dimension up to 21.
+            - "latin_hypercube": A Latin hypercube design, with one point in each
+              of `n_points` equal intervals along each axis.
+            - "uniform": Independent uniform random points.
+
+        trim_corners: bool = True
+            If True, reject points that lie outside the ellipsoid inscribed within
+            the extrema of the coordinate ranges. For "sobol" and "uniform", other
+            points are drawn instead, but for "latin_hypercube" rejected points
+            are not replaced.
+        seed: int = 0
+            Seed for the random number engine used by "latin_hypercube" and
+            "uniform". The "sobol" sequence is deterministic.
+        skip_equivalents: bool = False
+            If True, skip symmetrically equivalent configurations.
+        abs_tol: float = :data:`~libcasm.casmglobal.TOL`
+            The absolute tolerance used to trim corners.
+
+        Yields
+        ------
+        config: casmconfig.Configuration
+            A :class:`~casmconfig.Configuration` on a point in the irreducible wedge.
+        """
+        self._begin_subwedge_enumeration(
+            background, dof_space, "by_irreducible_wedge_sampling"
+        )
+
+        # Points and configurations are generated in C++, in batches
+        config_enum = ConfigEnumSubWedgeSamplingBase(
             background=background,
             dof_space=dof_space,
             irreducible_wedge=irreducible_wedge,
             stop=stop,
-            num=num,
+            n_points=n_points,
+            method=method,
             trim_corners=trim_corners,
-            skip_equivalents=False,  # see note above
+            seed=seed,
             abs_tol=abs_tol,
+        )
+        for config in self._by_subwedge_enumerator(
+            config_enum=config_enum,
+            background=background,
+            skip_equivalents=skip_equivalents,
+        ):
+            yield config
+
+    def by_refinement_sampling(
+        self,
+        background: casmconfig.Configuration,
+        dof_space: casmclex.DoFSpace,
+        irreducible_wedge: list[SubWedge],
+        stop: float,
+        centers: npt.ArrayLike,
+        subwedge_indices: list[int],
+        half_width: float,
+        n_points: Union[int, list[int]],
+        method: str = "sobol",
+        trim_corners: bool = True,
+        seed: int = 0,
+        skip_equivalents: bool = False,
+        abs_tol: float = libcasm.casmglobal.TOL,
+    ):
+        """Enumerate on points sampled around previously sampled points in the \
+        irreducible wedge of a DoFSpace, for adaptive refinement
+
+        Points are sampled in the box of SubWedge coordinates within `half_width`
+        of each center, clipped to the SubWedge coordinate ranges. Importance
+        sampling is done by choosing the centers, for example points with large
+        fitting error or low energy from a previous sampling, and by choosing the
+        number of points around each center, for example in proportion to an
+        importance weight.
+
+        Parameters
+        ----------
+        background: casmconfig.Configuration
+            The background configuration on which enumeration takes place.
+        dof_space: casmclex.DoFSpace
+            Specifies the DoF being enumerated. Not supported for
+            ``dof_space.dof_key == "occ"``, which raises.
+        irreducible_wedge: list[SubWedge]
+            The irreducible wedge.
+        stop: float
+            The maximum coordinate along each wedge edge vector, as for
+            :func:`~ConfigEnumMeshGrid.by_irreducible_wedge_sampling`.
+        centers: npt.ArrayLike
+            The order parameters (coordinates with respect to `dof_space.basis`)
+            of the centers, as rows, for example values of
+            :py:attr:`~ConfigEnumMeshGrid.order_parameters` collected during a
+            previous enumeration.
+        subwedge_indices: list[int]
+            The SubWedge index of each center, for example values of
+            :py:attr:`~ConfigEnumMeshGrid.subwedge_index` collected during a
+            previous enumeration.
+        half_width: float
+            Half the width, along each SubWedge axis, of the box sampled around
+            each center. Must be positive.
+        n_points: Union[int, list[int]]
+            The number of points to sample around each center. If scalar-valued,
+            the same number is used for each center.
+        method: str = "sobol"
+            The sampling method, one of "sobol", "latin_hypercube", or "uniform".
+        trim_corners: bool = True
+            If True, reject points that lie outside the ellipsoid inscribed within
+            the extrema of the SubWedge coordinate ranges.
+        seed: int = 0
+            Seed for the random number engine used by "latin_hypercube" and
+            "uniform".
+        skip_equivalents: bool = False
+            If True, skip symmetrically equivalent configurations.
+        abs_tol: float = :data:`~libcasm.casmglobal.TOL`
+            The absolute tolerance used to trim corners.
+
+        Yields
+        ------
+        config: casmconfig.Configuration
+            A :class:`~casmconfig.Configuration` on a point near one of the
+            centers.
+        """
+        self._begin_subwedge_enumeration(
+            background, dof_space, "by_refinement_sampling"
+        )
+
+        centers = np.array(centers, dtype=float)
+        if centers.ndim == 1:
+            centers = centers.reshape((1, -1))
+        if isinstance(n_points, int):
+            n_points = [n_points] * centers.shape[0]
+
+        # Points and configurations are generated in C++, in batches
+        config_enum = ConfigEnumSubWedgeSamplingBase(
+            background=background,
+            dof_space=dof_space,
+            irreducible_wedge=irreducible_wedge,
+            stop=stop,
+            centers=centers,
+            center_subwedge_indices=list(subwedge_indices),
+            half_width=half_width,
+            n_points=list(n_points),
+            method=method,
+            trim_corners=trim_corners,
+            seed=seed,
+            abs_tol=abs_tol,
+        )
+        for config in self._by_subwedge_enumerator(
+            config_enum=config_enum,
+            background=background,
+            skip_equivalents=skip_equivalents,
         ):
-            config = copy.copy(self.background)
-            config.set_order_parameters(
-                dof_space=dof_space,
-                order_parameters=eta,
-            )
-            if skip_equivalents:
-                canonical_config = casmconfig.make_canonical_configuration(config)
-                if canonical_config in canonical_configs:
-                    continue
-                else:
-                    if is_canonical_background_supercell:
-                        canonical_configs.add(canonical_config)
-                    else:
-                        canonical_configs.append(canonical_config)
-            self._subwedge_index = subwedge_index
-            self._order_parameters = eta
             yield config
@@ -3,7 +3,10 @@ from typing import Optional
 import numpy as np
 
 import libcasm.configuration as casmconfig
-import libcasm.xtal as xtal
+
+from ._enumerate import (
+    ScelEnumBase,
+)
 
 
 class ScelEnum:
@@ -163,6 +166,8 @@ class ScelEnum:
         dirs: str = "abc",
         diagonal_only: bool = False,
         fixed_shape: bool = False,
+        shard_index: int = 0,
+        n_shards: int = 1,
     ):
         """Yields symmetrically distinct supercells for a range of volumes
 
@@ -188,6 +193,14 @@ class ScelEnum:
             If true, restrict :math:`T` to diagonal matrices with diagonal coefficients
             :math:`[m, 1, 1]` (1d), :math:`[m, m, 1]` (2d), or :math:`[m, m, m]` (3d),
             where the dimension is determined from `len(dirs)`.
+        shard_index: int = 0
+            If `n_shards` > 1, only supercells in shard `shard_index` are
+            yielded, in the range `[0, n_shards)`.
+        n_shards: int = 1
+            Split the supercells into `n_shards` shards, so that work may be
+            split across processes. The `i`-th supercell belongs to shard
+            `i % n_shards`, so that shards have a similar distribution of
+            supercell volumes.
 
         Yields
         ------
@@ -195,28 +208,31 @@ class ScelEnum:
             A :class:`~casmconfig.Supercell`, guaranteed to be in canonical
             form.
         """
-        prim_lattice = self.prim.xtal_prim.lattice()
-        for superlattice in xtal.enumerate_superlattices(
-            unit_lattice=prim_lattice,
-            point_group=self.prim.crystal_point_group.elements,
+        if n_shards < 1 or shard_index < 0 or shard_index >= n_shards:
+            raise ValueError(
+                "Error in ScelEnum.by_volume: invalid shard_index or n_shards"
+            )
+        if unit_cell is not None:
+            unit_cell = np.array(unit_cell, dtype="int64")
+        scel_enum = ScelEnumBase(
+            prim=self.prim,
             max_volume=max,
             min_volume=min,
             dirs=dirs,
             unit_cell=unit_cell,
             diagonal_only=diagonal_only,
             fixed_shape=fixed_shape,
-        ):
-            T = xtal.make_transformation_matrix_to_super(
-                superlattice=superlattice,
-                unit_lattice=prim_lattice,
-            )
+            shard_index=shard_index,
+            n_shards=n_shards,
+        )
+        while scel_enum.is_valid():
             if self.supercell_set is None:
-                yield casmconfig.Supercell(
-                    self.prim,
-                    transformation_matrix_to_super=T,
-                )
+                yield scel_enum.value()
             else:
                 record = self.supercell_set.add_by_transformation_matrix_to_super(
-                    transformation_matrix_to_super=T,
+                    transformation_matrix_to_super=(
+                        scel_enum.transformation_matrix_to_super()
+                    ),
                 )
                 yield record.supercell
+            scel_enum.advance()
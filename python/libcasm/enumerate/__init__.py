@@ -11,12 +11,33 @@ from ._ConfigEnumMeshGrid import (
     meshgrid_points,
 )
 from ._enumerate import (
+    BinaryConfigurationSink,
+    ClusterCountFilter,
+    ConfigEnumRandomOccupations,
+    ConfigurationFilter,
+    ConfigurationSetSink,
+    ConfigurationSink,
+    JsonLinesConfigurationSink,
+    OccEventImages,
+    OccupantCountConstraint,
+    OccupantCountFilter,
+    OccupationEnumerationEstimate,
+    SiteComposition,
+    SublatticeCompositionFilter,
+    SupercellVolumeFilter,
+    count_distinct_occupations,
+    estimate_occupations_parallel,
     get_occevent_coordinate,
     make_distinct_cluster_sites,
+    make_occevent_images,
     make_occevent_simple_structures,
     make_phenomenal_occevent,
+    make_prim_occevent_symgroup_rep,
+    make_sublattice_composition,
+    run_occupation_pipeline,
 )
 from ._methods import (
+    for_each_distinct_periodic_perturbation,
     make_all_distinct_local_perturbations,
     make_all_distinct_periodic_perturbations,
     make_occevent_suborbits,
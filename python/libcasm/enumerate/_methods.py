@@ -1,9 +1,27 @@
+from typing import Callable, Optional
+
 import libcasm.clusterography
 import libcasm.configuration
 import libcasm.enumerate._enumerate as _enumerate
 import libcasm.occ_events
 
 
+def _iter_batches(config_enum, batch_size: int, prefetch_batches: int):
+    """Yield the batches returned by `config_enum.next_batch`
+
+    If `prefetch_batches` > 0, batches are enumerated by a C++ background
+    thread, using `config_enum.prefetch`, up to `prefetch_batches` ahead of
+    the consumer.
+    """
+    if prefetch_batches > 0:
+        yield from config_enum.prefetch(
+            batch_size=batch_size, n_batches_ahead=prefetch_batches
+        )
+    else:
+        while config_enum.is_valid():
+            yield config_enum.next_batch(max_size=batch_size)
+
+
 def make_all_distinct_periodic_perturbations(
     supercell: libcasm.configuration.Supercell,
     motif: libcasm.configuration.Configuration,
@@ -64,6 +82,64 @@ def make_all_distinct_periodic_perturbations(
     )
 
 
+def for_each_distinct_periodic_perturbation(
+    supercell: libcasm.configuration.Supercell,
+    motif: libcasm.configuration.Configuration,
+    clusters: list[libcasm.clusterography.Cluster],
+    f: Callable[[libcasm.configuration.Configuration], None],
+    spill_dir: Optional[str] = None,
+    max_size_in_memory: int = 1000000,
+) -> int:
+    r"""
+    Call a function with each distinct periodic perturbation of a configuration
+
+    This method finds the same perturbations as
+    :func:`~libcasm.enumerate.make_all_distinct_periodic_perturbations`, but calls
+    `f` with each distinct perturbation as soon as it is found, instead of
+    returning all of them at once. Perturbations are not accumulated, so it can be
+    used when the number of perturbations is too large to hold in memory.
+
+    To skip duplicates, compact keys of the perturbations already found are
+    stored. If `spill_dir` is given, then when `max_size_in_memory` keys are held
+    in memory, they are sorted and written to a file in `spill_dir`, so memory use
+    is bounded. The files are removed when enumeration is complete.
+
+    Parameters
+    ----------
+    supercell : ~libcasm.configuration.Supercell
+        The supercell in which perturbation configurations will be generated.
+
+    motif: ~libcasm.configuration.Configuration
+        The motif configuration is tiled into the supercell to generate
+        background configurations that are perturbed. Only perfect tilings into the
+        supercell are kept.
+
+    clusters: list[~libcasm.clusterography.Cluster]
+        Clusters, on which the occupation variables will be enumerated in order
+        to generate perturbation configurations.
+
+    f: Callable[[~libcasm.configuration.Configuration], None]
+        Called once with each distinct perturbation, in canonical form, in the
+        order found.
+
+    spill_dir: Optional[str] = None
+        If given, an existing directory in which to write sorted runs of keys of
+        perturbations already found. If None, all keys are held in memory.
+
+    max_size_in_memory: int = 1000000
+        The number of keys held in memory before writing a run file, if
+        `spill_dir` is given.
+
+    Returns
+    -------
+    n: int
+        The number of distinct perturbations.
+    """
+    return _enumerate.for_each_distinct_periodic_perturbation(
+        supercell, motif, clusters, f, spill_dir, max_size_in_memory
+    )
+
+
 def make_occevent_suborbits(
     supercell: libcasm.configuration.Supercell, occ_event: libcasm.occ_events.OccEvent
 ) -> list[list[libcasm.occ_events.OccEvent]]:
@@ -90,10 +166,7 @@ def make_occevent_suborbits(
         :class:`~libcasm.occ_events.OccEvent` in the i-th sub-orbit.
     """
     prim = supercell.prim
-    prim_factor_group = prim.factor_group
-    prim_rep = libcasm.occ_events.make_occevent_symgroup_rep(
-        prim_factor_group.elements, prim.xtal_prim
-    )
+    prim_rep = _enumerate.make_prim_occevent_symgroup_rep(prim)
     orbit = libcasm.occ_events.make_prim_periodic_orbit(occ_event, prim_rep)
 
     def in_any_suborbit(x, suborbits):
@@ -121,6 +194,7 @@ def make_all_distinct_local_perturbations(
     occ_event: libcasm.occ_events.OccEvent,
     motif: libcasm.configuration.Configuration,
     local_clusters: list[libcasm.clusterography.Cluster],
+    n_threads: int = 1,
 ) -> list[libcasm.configuration.Configuration]:
     r"""
     Construct distinct local perturbations of a configuration
@@ -182,6 +256,11 @@ def make_all_distinct_local_perturbations(
         taking the background configuration and supercell into account are
         perturbed with each possible occupation.
 
+    n_threads: int = 1
+        Number of threads used to generate perturbations. If <= 0, uses the
+        number of hardware threads. The result does not depend on the number
+        of threads.
+
     Returns
     -------
     configurations : list[~libcasm.configuration.Configuration]
@@ -192,5 +271,5 @@ def make_all_distinct_local_perturbations(
 
     """
     return _enumerate.make_all_distinct_local_perturbations(
-        supercell, occ_event, motif, local_clusters
+        supercell, occ_event, motif, local_clusters, n_threads
     )
@@ -159,6 +159,7 @@ def make_canonical_prim_periodic_occevents(
     cluster_specs: clust.ClusterSpecs,
     occevent_counter_params: dict = {},
     custom_events: list[_occ_events.OccEvent] = [],
+    n_threads: int = 1,
 ) -> list[_occ_events.OccEvent]:
     """Enumerate symmetrically distinct OccEvent
 
@@ -229,15 +230,32 @@ def make_canonical_prim_periodic_occevents(
         - "print_state_info": Optional[bool] = False, Print information about the
           step-by-step state of the algorithm.
 
+        Split generation across processes:
+
+        - "n_shards": Optional[int] = 1, Number of shards the prototype
+          clusters are split into. Cluster `i` belongs to shard
+          `i % n_shards`.
+        - "shard_index": Optional[int] = 0, Only OccEvent on clusters in this
+          shard are generated. Events on clusters in different shards are
+          never equivalent, so the results of all shards together are the
+          result with `n_shards=1`. `custom_events` are included by every
+          shard.
+
     custom_events: list[~libcasm.clusterography.ClusterOrbitGenerator]=[]
           Specifies OccEvent that should be included in the results
           regardless of the other options.
 
+    n_threads: int = 1
+        Number of threads used to generate OccEvent. Prototype clusters are
+        distributed to threads. If <= 0, uses the number of hardware threads.
+        The result does not depend on the number of threads. If
+        "print_state_info" is true, a single thread is used.
+
     Returns
     -------
     canonical_prim_periodic_occevents: list[~libcasm.clusterography.OccEvent]
         The resulting OccEvent
     """
     return _occ_events.make_canonical_prim_periodic_occevents(
-        system, cluster_specs, occevent_counter_params, custom_events
+        system, cluster_specs, occevent_counter_params, custom_events, n_threads
     )
@@ -1,3 +1,5 @@
+#include <fstream>
+
 #include <pybind11/eigen.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
@@ -10,6 +12,9 @@
 #include "casm/casm_io/json/jsonParser.hh"
 #include "casm/configuration/clusterography/ClusterSpecs.hh"
 #include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/clusterography/OrbitCache.hh"
+#include "casm/configuration/clusterography/OrbitTable.hh"
+#include "casm/configuration/clusterography/io/binary/Cluster_binary_io.hh"
 #include "casm/configuration/clusterography/io/json/ClusterSpecs_json_io.hh"
 #include "casm/configuration/clusterography/io/json/EquivalentsInfo_json_io.hh"
 #include "casm/configuration/clusterography/io/json/IntegralClusterOrbitGenerator_json_io.hh"
@@ -551,48 +556,130 @@ PYBIND11_MODULE(_clusterography, m) {
           "Return the `cutoff_radius` list")
       .def(
           "make_orbits",
-          [](clust::ClusterSpecs const &cluster_specs) {
+          [](clust::ClusterSpecs const &cluster_specs, Index n_threads,
+             bool use_cache) {
             // construct
-            std::vector<std::set<clust::IntegralCluster>> _orbits;
-            if (cluster_specs.phenomenal.has_value()) {
-              // local clusters
-              auto symgroup_rep = sym_info::make_unitcellcoord_symgroup_rep(
-                  cluster_specs.generating_group->element, *cluster_specs.prim);
-              _orbits = make_local_orbits(
-                  cluster_specs.prim, symgroup_rep, cluster_specs.site_filter,
-                  cluster_specs.max_length, cluster_specs.custom_generators,
-                  cluster_specs.phenomenal.value(), cluster_specs.cutoff_radius,
-                  cluster_specs.include_phenomenal_sites);
+            std::shared_ptr<std::vector<std::set<clust::IntegralCluster>> const>
+                _orbits;
+            if (use_cache) {
+              _orbits = clust::default_orbit_cache().make_orbits(cluster_specs,
+                                                                 n_threads);
             } else {
-              // prim periodic clusters
-              auto generating_group_unitcellcoord_symgroup_rep =
-                  sym_info::make_unitcellcoord_symgroup_rep(
-                      cluster_specs.generating_group->element,
-                      *cluster_specs.prim);
-              _orbits = make_prim_periodic_orbits(
-                  cluster_specs.prim,
-                  generating_group_unitcellcoord_symgroup_rep,
-                  cluster_specs.site_filter, cluster_specs.max_length,
-                  cluster_specs.custom_generators);
+              _orbits = std::make_shared<
+                  std::vector<std::set<clust::IntegralCluster>> const>(
+                  clust::make_orbits(cluster_specs, n_threads));
             }
 
             // copy
             std::vector<std::vector<clust::IntegralCluster>> orbits;
-            for (Index i = 0; i < _orbits.size(); ++i) {
-              orbits.emplace_back(_orbits[i].begin(), _orbits[i].end());
+            for (auto const &orbit : *_orbits) {
+              orbits.emplace_back(orbit.begin(), orbit.end());
             }
             return orbits;
           },
           R"pbdoc(
           Construct cluster orbits
 
+          Parameters
+          ----------
+          n_threads: int = 1
+              Number of threads used to generate periodic cluster orbits. If
+              <= 0, uses the number of hardware threads. The result does not
+              depend on the number of threads. Not used for local-cluster
+              orbits.
+
+          use_cache: bool = False
+              If True, orbits are generated once for each distinct
+              ClusterSpecs and then returned from a process-wide cache. Use
+              :func:`set_orbit_cache_dir` to also store orbits on disk. Not
+              used if `site_filter_method` is not one of "dof_sites",
+              "alloy_sites", or "all_sites".
+
           Returns
           -------
           orbits: list[list[Cluster]]
               A list of cluster orbits, `orbits[i]` is the i-th orbit. If a
               phenomenal cluster is included in the ClusterSpecs, the resulting
               orbits are local-cluster orbits, otherwise they are periodic.
-         )pbdoc")
+         )pbdoc",
+          py::call_guard<py::gil_scoped_release>(),
+          py::arg("n_threads") = 1, py::arg("use_cache") = false)
+      .def(
+          "extend_orbits",
+          [](clust::ClusterSpecs const &cluster_specs,
+             std::vector<std::vector<clust::IntegralCluster>> const
+                 &prev_orbits,
+             std::vector<double> const &prev_max_length) {
+            std::vector<std::set<clust::IntegralCluster>> _prev_orbits;
+            for (auto const &orbit : prev_orbits) {
+              _prev_orbits.emplace_back(orbit.begin(), orbit.end());
+            }
+            std::vector<std::vector<clust::IntegralCluster>> orbits;
+            for (auto const &orbit : clust::extend_orbits(
+                     _prev_orbits, prev_max_length, cluster_specs)) {
+              orbits.emplace_back(orbit.begin(), orbit.end());
+            }
+            return orbits;
+          },
+          R"pbdoc(
+          Construct periodic cluster orbits by extending orbits generated
+          with a smaller `max_length`
+
+          Only the orbits of clusters that were not previously generated are
+          constructed, so increasing `max_length` is faster than generating
+          all orbits again.
+
+          Parameters
+          ----------
+          prev_orbits: list[list[Cluster]]
+              Orbits generated using these ClusterSpecs, except with
+              `max_length` equal to `prev_max_length`.
+
+          prev_max_length: list[float]
+              The `max_length` used to generate `prev_orbits`. Must not be
+              greater than `max_length` for any branch in both.
+
+          Returns
+          -------
+          orbits: list[list[Cluster]]
+              A list of cluster orbits, equal to the result of
+              :func:`ClusterSpecs.make_orbits`. Raises if a phenomenal
+              cluster is included in the ClusterSpecs.
+          )pbdoc",
+          py::call_guard<py::gil_scoped_release>(),
+          py::arg("prev_orbits"), py::arg("prev_max_length"))
+      .def(
+          "make_orbit_table",
+          [](clust::ClusterSpecs const &cluster_specs, Index n_threads,
+             bool use_cache) {
+            if (use_cache) {
+              return clust::make_orbit_table(
+                  *clust::default_orbit_cache().make_orbits(cluster_specs,
+                                                            n_threads));
+            }
+            return clust::make_orbit_table(
+                clust::make_orbits(cluster_specs, n_threads));
+          },
+          R"pbdoc(
+          Construct cluster orbits, as an :class:`OrbitTable`
+
+          Parameters
+          ----------
+          n_threads: int = 1
+              Number of threads, as for :func:`ClusterSpecs.make_orbits`.
+
+          use_cache: bool = False
+              Use the process-wide orbit cache, as for
+              :func:`ClusterSpecs.make_orbits`.
+
+          Returns
+          -------
+          orbit_table: OrbitTable
+              The cluster orbits, in the same order as
+              :func:`ClusterSpecs.make_orbits`.
+          )pbdoc",
+          py::call_guard<py::gil_scoped_release>(),
+          py::arg("n_threads") = 1, py::arg("use_cache") = false)
       .def_static(
           "from_dict",
           [](const nlohmann::json &data,
@@ -652,6 +739,175 @@ PYBIND11_MODULE(_clusterography, m) {
               The ClusterSpecs as a Python dict
           )pbdoc");
 
+  py::class_<clust::OrbitTable>(m, "OrbitTable", R"pbdoc(
+      Cluster orbits in compressed sparse row (CSR) form
+
+      All cluster sites are held in one contiguous array, in order of orbit
+      and then cluster:
+
+      - Sites of cluster `c` are rows
+        ``sites[cluster_offsets[c]:cluster_offsets[c+1]]``
+      - Clusters of orbit `o` are
+        ``range(orbit_offsets[o], orbit_offsets[o+1])``
+
+      The `sites`, `cluster_offsets`, and `orbit_offsets` properties are
+      read-only NumPy views of the table data, without copying. They are
+      valid as long as the OrbitTable is.
+      )pbdoc")
+      .def(py::init([](std::vector<std::vector<clust::IntegralCluster>> const
+                           &orbits) {
+             std::vector<std::set<clust::IntegralCluster>> _orbits;
+             for (auto const &orbit : orbits) {
+               _orbits.emplace_back(orbit.begin(), orbit.end());
+             }
+             return clust::make_orbit_table(_orbits);
+           }),
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          orbits: list[list[Cluster]]
+              A list of cluster orbits, as from
+              :func:`ClusterSpecs.make_orbits`.
+          )pbdoc",
+           py::arg("orbits"))
+      .def_property_readonly(
+          "sites",
+          [](clust::OrbitTable const &table)
+              -> clust::OrbitTable::site_matrix_type const & {
+            return table.sites;
+          },
+          py::return_value_policy::reference_internal,
+          "Cluster sites, as rows of (b, i, j, k). Read-only view, shape="
+          "(n_sites, 4).")
+      .def_property_readonly(
+          "cluster_offsets",
+          [](clust::OrbitTable const &table) -> Eigen::VectorXl const & {
+            return table.cluster_offsets;
+          },
+          py::return_value_policy::reference_internal,
+          "Offset of the first site of each cluster. Read-only view, shape="
+          "(n_clusters + 1,).")
+      .def_property_readonly(
+          "orbit_offsets",
+          [](clust::OrbitTable const &table) -> Eigen::VectorXl const & {
+            return table.orbit_offsets;
+          },
+          py::return_value_policy::reference_internal,
+          "Offset of the first cluster of each orbit. Read-only view, shape="
+          "(n_orbits + 1,).")
+      .def("n_orbits", &clust::OrbitTable::n_orbits, "Number of orbits")
+      .def("n_clusters", &clust::OrbitTable::n_clusters,
+           "Total number of clusters, in all orbits")
+      .def("cluster", &clust::OrbitTable::cluster,
+           "Return the `c`-th cluster as a :class:`Cluster`", py::arg("c"))
+      .def(
+          "to_orbits",
+          [](clust::OrbitTable const &table) {
+            std::vector<std::vector<clust::IntegralCluster>> orbits;
+            for (auto const &orbit : clust::make_orbits(table)) {
+              orbits.emplace_back(orbit.begin(), orbit.end());
+            }
+            return orbits;
+          },
+          R"pbdoc(
+          Convert to a list of cluster orbits
+
+          Returns
+          -------
+          orbits: list[list[Cluster]]
+              A list of cluster orbits, `orbits[i]` is the i-th orbit.
+          )pbdoc")
+      .def(
+          "to_index_table",
+          [](clust::OrbitTable const &table,
+             xtal::UnitCellCoordIndexConverter const &converter) {
+            return clust::make_orbit_index_table(table, converter);
+          },
+          R"pbdoc(
+          Convert to an :class:`OrbitIndexTable` of linear site indices
+
+          Parameters
+          ----------
+          site_index_converter: libcasm.xtal.SiteIndexConverter
+              Converts sites to linear site indices in a supercell.
+
+          Returns
+          -------
+          orbit_index_table: OrbitIndexTable
+              Orbits of clusters of linear site indices. Clusters of each
+              orbit are sorted sets of site indices, in sorted order.
+          )pbdoc",
+          py::arg("site_index_converter"));
+
+  py::class_<clust::OrbitIndexTable>(m, "OrbitIndexTable", R"pbdoc(
+      Orbits of clusters of linear supercell site indices, in compressed
+      sparse row (CSR) form
+
+      Same layout as :class:`OrbitTable`, with `sites[s]` the linear site
+      index of site `s`. The `sites`, `cluster_offsets`, and `orbit_offsets`
+      properties are read-only NumPy views of the table data, without
+      copying.
+      )pbdoc")
+      .def_property_readonly(
+          "sites",
+          [](clust::OrbitIndexTable const &table) -> Eigen::VectorXl const & {
+            return table.sites;
+          },
+          py::return_value_policy::reference_internal,
+          "Cluster linear site indices. Read-only view, shape=(n_sites,).")
+      .def_property_readonly(
+          "cluster_offsets",
+          [](clust::OrbitIndexTable const &table) -> Eigen::VectorXl const & {
+            return table.cluster_offsets;
+          },
+          py::return_value_policy::reference_internal,
+          "Offset of the first site of each cluster. Read-only view, shape="
+          "(n_clusters + 1,).")
+      .def_property_readonly(
+          "orbit_offsets",
+          [](clust::OrbitIndexTable const &table) -> Eigen::VectorXl const & {
+            return table.orbit_offsets;
+          },
+          py::return_value_policy::reference_internal,
+          "Offset of the first cluster of each orbit. Read-only view, shape="
+          "(n_orbits + 1,).")
+      .def("n_orbits", &clust::OrbitIndexTable::n_orbits, "Number of orbits")
+      .def("n_clusters", &clust::OrbitIndexTable::n_clusters,
+           "Total number of clusters, in all orbits");
+
+  m.def(
+      "set_orbit_cache_dir",
+      [](std::optional<std::string> cache_dir) {
+        if (cache_dir.has_value()) {
+          clust::default_orbit_cache().set_cache_dir(fs::path(*cache_dir));
+        } else {
+          clust::default_orbit_cache().set_cache_dir(std::nullopt);
+        }
+      },
+      R"pbdoc(
+      Set the directory where ClusterSpecs.make_orbits(use_cache=True)
+      stores orbits
+
+      Parameters
+      ----------
+      cache_dir: Optional[str] = None
+          Directory where orbits are written as JSON files named by a hash of
+          the ClusterSpecs, and read back by later processes. If None, orbits
+          are only cached in memory.
+      )pbdoc",
+      py::arg("cache_dir") = std::nullopt);
+
+  m.def(
+      "clear_orbit_cache",
+      []() { clust::default_orbit_cache().clear(); },
+      R"pbdoc(
+      Clear orbits cached in memory by ClusterSpecs.make_orbits(use_cache=True)
+
+      Orbit files in the cache directory, if any, are not removed.
+      )pbdoc");
+
   m.def(
       "make_integral_site_coordinate_symgroup_rep",
       [](std::vector<xtal::SymOp> const &group_elements,
@@ -989,6 +1245,80 @@ PYBIND11_MODULE(_clusterography, m) {
     )pbdoc",
       py::arg("data"), py::arg("prim"));
 
+  m.def(
+      "write_equivalents_info_binary",
+      [](std::string const &path,
+         std::vector<clust::IntegralCluster> const &phenomenal_clusters,
+         std::vector<Index> const &equivalent_generating_op_indices,
+         std::string const &key) {
+        clust::EquivalentsInfo equivalents_info;
+        equivalents_info.phenomenal_clusters = phenomenal_clusters;
+        equivalents_info.equivalent_generating_op_indices =
+            equivalent_generating_op_indices;
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        write_equivalents_info_binary(equivalents_info, out, key);
+      },
+      R"pbdoc(
+    Write equivalents info in a compact binary format
+
+    The binary file holds the same information as an "equivalents_info.json"
+    file, and can be read much faster with
+    :func:`read_equivalents_info_binary`.
+
+    Parameters
+    ----------
+    path : str
+        The file path.
+
+    phenomenal_clusters : list[Cluster]
+        The phenomenal clusters of the local basis sets
+
+    equivalent_generating_op_indices : list[int]
+        Indices of the factor group operations that generate the phenomenal
+        clusters from the prototype.
+
+    key : str = ""
+        A string identifying the contents, which is stored in the file.
+    )pbdoc",
+      py::arg("path"), py::arg("phenomenal_clusters"),
+      py::arg("equivalent_generating_op_indices"), py::arg("key") = "");
+
+  m.def(
+      "read_equivalents_info_binary",
+      [](std::string const &path) -> py::tuple {
+        ClusterBinaryReader reader{fs::path(path)};
+        clust::EquivalentsInfo equivalents_info = reader.equivalents_info();
+        return py::make_tuple(
+            equivalents_info.phenomenal_clusters,
+            equivalents_info.equivalent_generating_op_indices, reader.key());
+      },
+      R"pbdoc(
+    Read equivalents info written by :func:`write_equivalents_info_binary`
+
+    The file is memory-mapped while it is read.
+
+    Parameters
+    ----------
+    path : str
+        The file path.
+
+    Returns
+    -------
+    phenomenal_clusters, equivalent_generating_op_indices, key :
+
+        phenomenal_clusters : list[Cluster]
+            The phenomenal clusters of the local basis sets
+
+        equivalent_generating_op_indices : list[int]
+            Indices of the factor group operations that
+            generate the phenomenal clusters from the
+            prototype.
+
+        key : str
+            The key stored in the file.
+    )pbdoc",
+      py::arg("path"));
+
 #ifdef VERSION_INFO
   m.attr("__version__") = MACRO_STRINGIFY(VERSION_INFO);
 #else
@@ -1,4 +1,5 @@
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -10,9 +11,15 @@
 #include "casm/casm_io/json/jsonParser.hh"
 #include "casm/clexulator/ConfigDoFValuesTools_impl.hh"
 #include "casm/configuration/ConfigCompare.hh"
+#include "casm/configuration/ConfigurationBatch.hh"
 #include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/DoFSpaceAnalysisCache.hh"
+#include "casm/configuration/DoFSpace_functions.hh"
 #include "casm/configuration/FromStructure.hh"
+#include "casm/configuration/MatrixRepCache.hh"
 #include "casm/configuration/Prim.hh"
+#include "casm/configuration/PrimSymInfoCache.hh"
+#include "casm/configuration/ProgressMonitor.hh"
 #include "casm/configuration/Supercell.hh"
 #include "casm/configuration/SupercellSet.hh"
 #include "casm/configuration/SupercellSymInfo.hh"
@@ -21,10 +28,15 @@
 #include "casm/configuration/config_space_analysis.hh"
 #include "casm/configuration/copy_configuration.hh"
 #include "casm/configuration/dof_space_analysis.hh"
+#include "casm/configuration/instrumentation.hh"
+#include "casm/configuration/io/binary/ConfigurationSet_binary_io.hh"
 #include "casm/configuration/io/json/Configuration_json_io.hh"
 #include "casm/configuration/io/json/Supercell_json_io.hh"
 #include "casm/configuration/irreps/VectorSpaceSymReport.hh"
 #include "casm/configuration/make_simple_structure.hh"
+#include "casm/configuration/memory_usage.hh"
+#include "casm/configuration/numa.hh"
+#include "casm/configuration/parallel.hh"
 #include "casm/crystallography/SimpleStructure.hh"
 #include "casm/crystallography/UnitCellCoord.hh"
 #include "casm/crystallography/io/BasicStructureIO.hh"
@@ -62,13 +74,16 @@ using namespace CASM;
 // Prim
 
 std::shared_ptr<config::Prim> make_prim(
-    std::shared_ptr<xtal::BasicStructure const> const &xtal_prim) {
-  std::shared_ptr<xtal::BasicStructure const> basicstructure(xtal_prim);
-  std::map<DoFKey, xtal::DoFSet> global_dof_info(
-      clexulator::make_global_dof_info(*basicstructure));
-  std::map<DoFKey, std::vector<xtal::SiteDoFSet>> local_dof_info(
-      clexulator::make_local_dof_info(*basicstructure));
-  config::PrimSymInfo sym_info(*basicstructure);
+    std::shared_ptr<xtal::BasicStructure const> const &xtal_prim,
+    bool use_cache) {
+  if (use_cache) {
+    if (xtal_prim == nullptr) {
+      throw std::runtime_error("Error in Prim constructor: xtal_prim is None");
+    }
+    return std::make_shared<config::Prim>(
+        *config::default_prim_sym_info_cache().prim_sym_info(*xtal_prim),
+        xtal_prim);
+  }
   return std::make_shared<config::Prim>(xtal_prim);
 }
 
@@ -101,6 +116,56 @@ std::string prim_to_json(std::shared_ptr<config::Prim const> const &prim) {
   return ss.str();
 }
 
+/// \brief Prim, by pickle state, that have been pickled or unpickled
+///
+/// Used so that Prim unpickled in a process where a Prim with the same
+/// state has already been pickled or unpickled is the same shared Prim, and
+/// objects that were pickled separately (i.e. results returned by
+/// multiprocessing workers) can be compared. Only accessed with the GIL
+/// held.
+std::map<std::string, std::weak_ptr<config::Prim>> &pickled_prim() {
+  static std::map<std::string, std::weak_ptr<config::Prim>> *_pickled_prim =
+      new std::map<std::string, std::weak_ptr<config::Prim>>();
+  return *_pickled_prim;
+}
+
+/// \brief Make the pickle state of a Prim, the Prim as a JSON string
+std::string prim_pickle_state(std::shared_ptr<config::Prim> const &prim) {
+  jsonParser json;
+  write_prim(*prim->basicstructure, json, FRAC, true);
+  std::string state = static_cast<nlohmann::json>(json).dump();
+  auto &registry = pickled_prim();
+  auto it = registry.find(state);
+  if (it == registry.end() || it->second.expired()) {
+    registry[state] = prim;
+  }
+  return state;
+}
+
+/// \brief Construct a Prim from its pickle state, or return the Prim with
+///     the same state that was already pickled or unpickled
+std::shared_ptr<config::Prim> prim_from_pickle_state(
+    std::string const &state) {
+  auto &registry = pickled_prim();
+  auto it = registry.find(state);
+  if (it != registry.end()) {
+    if (auto prim = it->second.lock()) {
+      return prim;
+    }
+  }
+  jsonParser json{nlohmann::json::parse(state)};
+  ParsingDictionary<AnisoValTraits> const *aniso_val_dict = nullptr;
+  // use PrimSymInfo files, if any, so that unpickling in new processes (i.e.
+  // multiprocessing workers) does not repeat symmetry analysis
+  bool use_cache =
+      config::default_prim_sym_info_cache().cache_dir().has_value();
+  auto prim = make_prim(std::make_shared<xtal::BasicStructure>(
+                            read_prim(json, TOL, aniso_val_dict)),
+                        use_cache);
+  registry[state] = prim;
+  return prim;
+}
+
 // Supercell
 std::shared_ptr<config::Supercell> make_supercell(
     std::shared_ptr<config::Prim const> const &prim,
@@ -155,6 +220,38 @@ config::ConfigSpaceAnalysisResults make_ConfigSpaceAnalysisResults(
       _projector, _eigenvalues, _symmetry_adapted_dof_space);
 }
 
+/// \brief Construct config::ProgressMonitor with a Python callback
+///
+/// The callback is called holding the GIL. Pending signals, such as
+/// KeyboardInterrupt, are checked at each report and request cancellation.
+std::shared_ptr<config::ProgressMonitor> make_progress_monitor(
+    std::optional<py::function> callback, double min_interval) {
+  // the Python callback must be released holding the GIL
+  std::shared_ptr<py::function> f;
+  if (callback.has_value()) {
+    f = std::shared_ptr<py::function>(new py::function(*callback),
+                                      [](py::function *ptr) {
+                                        py::gil_scoped_acquire acquire;
+                                        delete ptr;
+                                      });
+  }
+  auto cancel_flag = std::make_shared<std::atomic<bool>>(false);
+  auto _callback = [=](std::string const &stage, Index n_done,
+                       Index n_total) {
+    py::gil_scoped_acquire acquire;
+    if (PyErr_CheckSignals() != 0) {
+      PyErr_Clear();
+      cancel_flag->store(true);
+      return;
+    }
+    if (f) {
+      (*f)(stage, n_done, n_total);
+    }
+  };
+  return std::make_shared<config::ProgressMonitor>(_callback, cancel_flag,
+                                                   min_interval);
+}
+
 }  // namespace CASMpy
 
 PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>);
@@ -187,6 +284,7 @@ PYBIND11_MODULE(_configuration, m) {
 
       )pbdoc")
       .def(py::init(&make_prim), py::arg("xtal_prim"),
+           py::arg("use_cache") = false,
            R"pbdoc(
 
       .. rubric:: Constructor
@@ -195,6 +293,12 @@ PYBIND11_MODULE(_configuration, m) {
       ----------
       xtal_prim : libcasm.xtal.Prim
           A :class:`libcasm.xtal.Prim`
+      use_cache : bool = False
+          If True, the factor group and symmetry representations are found
+          once for each distinct prim and then copied from a process-wide
+          cache. Use :func:`set_prim_sym_info_cache_dir` to also store them on
+          disk, so that later processes constructing the same prim skip
+          symmetry analysis.
       )pbdoc")
       .def_property_readonly(
           "xtal_prim",
@@ -214,6 +318,15 @@ PYBIND11_MODULE(_configuration, m) {
             return prim->sym_info.point_group;
           },
           "The crystal point group.")
+      .def(
+          "memory_bytes",
+          [](std::shared_ptr<config::Prim const> const &prim) {
+            return prim->sym_info.memory_bytes();
+          },
+          R"pbdoc(
+          Returns the approximate memory, in bytes, used by the factor group
+          and symmetry representations.
+          )pbdoc")
       .def_property_readonly(
           "has_occupation_dofs",
           [](std::shared_ptr<config::Prim const> const &prim) {
@@ -500,7 +613,17 @@ PYBIND11_MODULE(_configuration, m) {
           The
           `Prim reference <https://prisms-center.github.io/CASMcode_docs/formats/casm/crystallography/BasicStructure/>`_
           documents the expected format.
-          )pbdoc");
+          )pbdoc")
+      .def(py::pickle(
+          [](std::shared_ptr<config::Prim> const &prim) {
+            return py::make_tuple(prim_pickle_state(prim));
+          },
+          [](py::tuple state) {
+            if (state.size() != 1) {
+              throw std::runtime_error("Error unpickling Prim: invalid state");
+            }
+            return prim_from_pickle_state(state[0].cast<std::string>());
+          }));
 
   // SupercellSet -- declare class
   py::class_<config::SupercellSet, std::shared_ptr<config::SupercellSet>>
@@ -831,7 +954,7 @@ PYBIND11_MODULE(_configuration, m) {
       .def_property_readonly(
           "factor_group",
           [](std::shared_ptr<config::Supercell const> const &supercell) {
-            return supercell->sym_info.factor_group;
+            return supercell->sym_info().factor_group;
           },
           "The supercell factor group, which is the subgroup of the "
           "prim factor group that leaves the supercell lattice vectors "
@@ -839,7 +962,8 @@ PYBIND11_MODULE(_configuration, m) {
       .def_property_readonly(
           "factor_group_permutations",
           [](std::shared_ptr<config::Supercell const> const &supercell) {
-            return supercell->sym_info.factor_group_permutations;
+            return supercell->sym_info().factor_group_permutations
+                .permutations();
           },
           "The factor group permutations, where "
           "`factor_group_permutations()[i]` describes how "
@@ -852,7 +976,12 @@ PYBIND11_MODULE(_configuration, m) {
       .def_property_readonly(
           "translation_permutations",
           [](std::shared_ptr<config::Supercell const> const &supercell) {
-            return supercell->sym_info.translation_permutations;
+            auto const &table = supercell->sym_info().translation_permutations;
+            std::optional<std::vector<config::sym_info::Permutation>> result;
+            if (table.has_value()) {
+              result = table->permutations();
+            }
+            return result;
           },
           "Returns the translation permutations, where "
           "`translations_permutations()[i]` describes how the translation "
@@ -860,7 +989,20 @@ PYBIND11_MODULE(_configuration, m) {
           "unitcell specified by linear index `l`, permutes supercell site DoF "
           "values. When permuting site occupants, the following convention is "
           "used, `after[l] = before[permutation[l]]`. Returns None for large "
-          "supercells (n_unitcells > max_n_translation_permutations).")
+          "supercells (n_unitcells > max_n_translation_permutations), or if "
+          "storing them would have exceeded the memory budget when the "
+          "symmetry info was constructed (see "
+          ":func:`~libcasm.configuration.set_memory_budget`).")
+      .def(
+          "memory_bytes",
+          [](std::shared_ptr<config::Supercell const> const &supercell) {
+            return supercell->memory_bytes();
+          },
+          R"pbdoc(
+          Returns the approximate memory, in bytes, used by the supercell,
+          including its symmetry tables if they have been constructed, but
+          not the shared prim.
+          )pbdoc")
       .def_property_readonly(
           "n_sites",
           [](std::shared_ptr<config::Supercell const> const &supercell) {
@@ -1074,7 +1216,23 @@ PYBIND11_MODULE(_configuration, m) {
           "reference "
           "<https://prisms-center.github.io/CASMcode_docs/formats/casm/clex/"
           "Configuration/>`_ documents the expected format for Configurations "
-          "and Supercells.");
+          "and Supercells.")
+      .def(py::pickle(
+          [](config::Supercell const &supercell) {
+            return py::make_tuple(
+                supercell.prim,
+                supercell.superlattice.transformation_matrix_to_super(),
+                supercell.max_n_translation_permutations());
+          },
+          [](py::tuple state) {
+            if (state.size() != 3) {
+              throw std::runtime_error(
+                  "Error unpickling Supercell: invalid state");
+            }
+            return make_supercell(
+                state[0].cast<std::shared_ptr<config::Prim const>>(),
+                state[1].cast<Eigen::Matrix3l>(), state[2].cast<Index>());
+          }));
 
   m.def(
       "is_canonical_supercell",
@@ -1157,6 +1315,33 @@ PYBIND11_MODULE(_configuration, m) {
       .def_readonly("configuration_name",
                     &config::ConfigurationRecord::configuration_name,
                     "The configuration name.")
+      .def("to_canonical", &config::ConfigurationRecord::to_canonical,
+           R"pbdoc(
+          Return the SupercellSymOp that makes the configuration canonical
+
+          The result is the same as
+          :func:`~libcasm.configuration.to_canonical_configuration`, using all
+          supercell operations. It is found on first use and shared by copies
+          of the record.
+          )pbdoc")
+      .def("from_canonical", &config::ConfigurationRecord::from_canonical,
+           R"pbdoc(
+          Return the SupercellSymOp that makes the configuration from the
+          canonical configuration
+
+          The result is the same as
+          :func:`~libcasm.configuration.from_canonical_configuration`, using
+          all supercell operations. It is found on first use and shared by
+          copies of the record.
+          )pbdoc")
+      .def("invariant_subgroup_size",
+           &config::ConfigurationRecord::invariant_subgroup_size,
+           R"pbdoc(
+          Return the number of supercell operations that leave the
+          configuration invariant
+
+          It is found on first use and shared by copies of the record.
+          )pbdoc")
       .def(py::self < py::self, "Sorts ConfigurationRecord.")
       .def(py::self <= py::self, "Sorts ConfigurationRecord.")
       .def(py::self > py::self, "Sorts ConfigurationRecord.")
@@ -1675,6 +1860,11 @@ PYBIND11_MODULE(_configuration, m) {
       .def("__len__", &config::ConfigurationSet::size)
       // clear
       .def("clear", &config::ConfigurationSet::clear, "Clear ConfigurationSet")
+      .def("memory_bytes", &config::ConfigurationSet::memory_bytes,
+           R"pbdoc(
+          Returns the approximate memory, in bytes, used by the records and
+          indexes, not including the shared supercells.
+          )pbdoc")
       // add
       .def(
           "add_configuration",
@@ -1766,6 +1956,102 @@ PYBIND11_MODULE(_configuration, m) {
           :func:`~libcasm.configuration.ConfigurationSet.add_record`)
           )pbdoc",
           py::arg("record"))
+      .def(
+          "add_many",
+          [](config::ConfigurationSet &m,
+             std::vector<config::Configuration> configurations,
+             Index n_threads) -> Index {
+            Index n_added = 0;
+            for (auto const &res :
+                 m.insert_many(std::move(configurations), n_threads)) {
+              if (res.second) {
+                ++n_added;
+              }
+            }
+            return n_added;
+          },
+          R"pbdoc(
+          Add the canonical forms of many configurations to the set
+
+          Canonical forms are made in parallel, then the configurations are
+          added in order, so configuration_id are the same as if the canonical
+          forms were added one at a time.
+
+          Parameters
+          ----------
+          configurations : list[libcasm.configuration.Configuration]
+              The configurations to add. The configurations must be in the
+              canonical supercell, though this is not checked.
+          n_threads : int = 0
+              The number of threads used to make canonical forms. If <= 0,
+              the number of hardware threads is used.
+
+          Returns
+          -------
+          n_added : int
+              The number of configurations that were added.
+          )pbdoc",
+          py::arg("configurations"), py::arg("n_threads") = 0)
+      .def("merge", &config::ConfigurationSet::merge, R"pbdoc(
+          Add the configurations of one shard of a sharded enumeration
+
+          Configurations in `shard` are added in the order they were added to
+          `shard`, and configuration_id are set as if they were added to this
+          set directly. Configurations already in this set are skipped.
+
+          If an enumeration is split into shards that each enumerate part of
+          the enumeration order in each supercell, in order, such as with the
+          `shard_index` and `n_shards` options of
+          :func:`libcasm.enumerate.ScelEnum.by_volume` and
+          :func:`libcasm.enumerate.ConfigEnumAllOccupations.by_supercell_list`,
+          then merging the shards into an empty ConfigurationSet, in order of
+          shard index, reproduces the configuration_id of a serial
+          enumeration.
+
+          Configurations with configuration_id that were not set automatically
+          (not non-negative integers) are added last, keeping their
+          configuration_id.
+
+          Parameters
+          ----------
+          shard : libcasm.configuration.ConfigurationSet
+              Configurations generated by one shard of an enumeration.
+          )pbdoc",
+           py::arg("shard"))
+      .def_static(
+          "merged",
+          [](std::vector<std::shared_ptr<config::ConfigurationSet>> const &sets,
+             Index n_threads) {
+            std::vector<config::ConfigurationSet const *> ptrs;
+            for (auto const &set : sets) {
+              ptrs.push_back(set.get());
+            }
+            return std::make_shared<config::ConfigurationSet>(
+                config::make_merged_configuration_set(ptrs, n_threads));
+          },
+          py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+          Merge ConfigurationSet, such as from parallel or sharded runs
+
+          The result is the same as copying the first set and then calling
+          :func:`~libcasm.configuration.ConfigurationSet.merge` with each later
+          set, in order, including configuration_id and next configuration id.
+          The sorted sets are merged with a k-way merge, which is faster than
+          adding configurations one at a time.
+
+          Parameters
+          ----------
+          sets : list[libcasm.configuration.ConfigurationSet]
+              The sets to merge.
+          n_threads : int = 1
+              Number of threads used, splitting the work by supercell. If <= 0,
+              uses the number of hardware threads.
+
+          Returns
+          -------
+          merged : libcasm.configuration.ConfigurationSet
+              The merged set.
+          )pbdoc",
+          py::arg("sets"), py::arg("n_threads") = 1)
       // get
       .def(
           "get_configuration",
@@ -1802,6 +2088,28 @@ PYBIND11_MODULE(_configuration, m) {
           :func:`~libcasm.configuration.ConfigurationSet.get_configuration`).
           )pbdoc",
           py::arg("configuration"))
+      .def(
+          "get_within_tol",
+          [](config::ConfigurationSet &m,
+             config::Configuration const &configuration) -> py::object {
+            auto it = m.find_within_tol(configuration);
+            if (it == m.end()) {
+              return py::none();
+            }
+            return py::object(
+                py::cast<config::ConfigurationRecord const &>(*it));
+          },
+          py::return_value_policy::reference_internal,
+          R"pbdoc(
+          Find a ConfigurationRecord, in the same supercell, whose continuous \
+          DoF values are all within tolerance of those of `configuration`, \
+          and return a const reference, else return None.
+
+          Unlike :func:`~libcasm.configuration.ConfigurationSet.get`, which \
+          searches the ordered records, this finds a matching record if any \
+          exists. Uses an index of continuous DoF values, built on first use.
+          )pbdoc",
+          py::arg("configuration"))
       .def(
           "get_by_name",
           [](config::ConfigurationSet &m,
@@ -1837,6 +2145,135 @@ PYBIND11_MODULE(_configuration, m) {
           :func:`~libcasm.configuration.ConfigurationSet.get_by_name`).
           )pbdoc",
           py::arg("configuration_name"))
+      .def(
+          "get_by_primitive",
+          [](py::object self, config::Configuration const &configuration) {
+            auto const &m = self.cast<config::ConfigurationSet const &>();
+            py::list result;
+            for (auto it : m.find_by_primitive(configuration)) {
+              result.append(py::cast(
+                  *it, py::return_value_policy::reference_internal, self));
+            }
+            return result;
+          },
+          R"pbdoc(
+          Find all ConfigurationRecord, in any supercell, that are equivalent \
+          to a configuration as infinite crystals, and return a list of const \
+          references.
+
+          Configurations are compared by the canonical primitive \
+          configuration, using an index that is built on first use and then \
+          updated on insert and remove.
+          )pbdoc",
+          py::arg("configuration"))
+      .def(
+          "get_by_supercell_name",
+          [](py::object self, std::string supercell_name) {
+            auto const &m = self.cast<config::ConfigurationSet const &>();
+            py::list result;
+            for (auto it : m.find_by_supercell_name(supercell_name)) {
+              result.append(py::cast(
+                  *it, py::return_value_policy::reference_internal, self));
+            }
+            return result;
+          },
+          R"pbdoc(
+          Find all ConfigurationRecord in a supercell, and return a list of \
+          const references.
+
+          Uses an index by supercell name, volume, and occupant count that is \
+          built on first use of \
+          :func:`~libcasm.configuration.ConfigurationSet.get_by_supercell_name`, \
+          :func:`~libcasm.configuration.ConfigurationSet.get_by_volume`, or \
+          :func:`~libcasm.configuration.ConfigurationSet.get_by_occupant_count`, \
+          and then updated on insert and remove.
+
+          Parameters
+          ----------
+          supercell_name : str
+              The supercell name.
+
+          Returns
+          -------
+          records : list[libcasm.configuration.ConfigurationRecord]
+              The records in the supercell, in no particular order.
+          )pbdoc",
+          py::arg("supercell_name"))
+      .def(
+          "get_by_volume",
+          [](py::object self, Index min_volume, Index max_volume) {
+            auto const &m = self.cast<config::ConfigurationSet const &>();
+            py::list result;
+            for (auto it : m.find_by_volume(min_volume, max_volume)) {
+              result.append(py::cast(
+                  *it, py::return_value_policy::reference_internal, self));
+            }
+            return result;
+          },
+          R"pbdoc(
+          Find all ConfigurationRecord with supercell volume in a range, and \
+          return a list of const references.
+
+          Uses the same index as \
+          :func:`~libcasm.configuration.ConfigurationSet.get_by_supercell_name`.
+
+          Parameters
+          ----------
+          min_volume : int
+              The minimum supercell volume, as a number of unit cells.
+          max_volume : int
+              The maximum supercell volume, as a number of unit cells.
+
+          Returns
+          -------
+          records : list[libcasm.configuration.ConfigurationRecord]
+              The records with `min_volume <= volume <= max_volume`, by
+              increasing volume.
+          )pbdoc",
+          py::arg("min_volume"), py::arg("max_volume"))
+      .def(
+          "get_by_occupant_count",
+          [](py::object self, Index sublattice_index, std::string occupant_name,
+             Index min_count, Index max_count) {
+            auto const &m = self.cast<config::ConfigurationSet const &>();
+            py::list result;
+            for (auto it : m.find_by_occupant_count(
+                     sublattice_index, occupant_name, min_count, max_count)) {
+              result.append(py::cast(
+                  *it, py::return_value_policy::reference_internal, self));
+            }
+            return result;
+          },
+          R"pbdoc(
+          Find all ConfigurationRecord with the number of sites of one \
+          sublattice occupied by one occupant in a range, and return a list \
+          of const references.
+
+          Uses the same index as \
+          :func:`~libcasm.configuration.ConfigurationSet.get_by_supercell_name`.
+          For a fixed sublattice composition use `min_count == max_count`,
+          and intersect the results for each occupant.
+
+          Parameters
+          ----------
+          sublattice_index : int
+              The sublattice.
+          occupant_name : str
+              The name of the occupant being counted.
+          min_count : int
+              The minimum number of sites.
+          max_count : int
+              The maximum number of sites.
+
+          Returns
+          -------
+          records : list[libcasm.configuration.ConfigurationRecord]
+              The records with the occupant count in the range, by
+              increasing count. Records of configurations whose sublattice
+              does not allow `occupant_name` are never included.
+          )pbdoc",
+          py::arg("sublattice_index"), py::arg("occupant_name"),
+          py::arg("min_count"), py::arg("max_count"))
       // remove
       .def(
           "remove_configuration",
@@ -2053,7 +2490,35 @@ PYBIND11_MODULE(_configuration, m) {
           data : json
               The `Prim reference <https://prisms-center.github.io/CASMcode_docs/formats/casm/crystallography/BasicStructure/>`_ documents the expected format.
           )pbdoc",
-          py::arg("write_prim_basis") = false);
+          py::arg("write_prim_basis") = false)
+      .def(py::pickle(
+          [](config::ConfigurationSet const &configurations) {
+            py::object prim = py::none();
+            if (!configurations.empty()) {
+              prim = py::cast(
+                  configurations.begin()->configuration.supercell->prim);
+            }
+            std::stringstream ss;
+            write_binary(configurations, ss, false);
+            return py::make_tuple(prim, py::bytes(ss.str()),
+                                  configurations.next_config_id());
+          },
+          [](py::tuple state) {
+            if (state.size() != 3) {
+              throw std::runtime_error(
+                  "Error unpickling ConfigurationSet: invalid state");
+            }
+            auto configurations = std::make_shared<config::ConfigurationSet>();
+            if (!state[0].is_none()) {
+              config::SupercellSet supercells(
+                  state[0].cast<std::shared_ptr<config::Prim const>>());
+              std::stringstream ss(state[1].cast<std::string>());
+              read_binary(supercells, *configurations, ss);
+            }
+            configurations->set_next_config_id(
+                state[2].cast<std::map<std::string, Index>>());
+            return configurations;
+          }));
 
   // SupercellSymOp -- declare class
   py::class_<config::SupercellSymOp> pySupercellSymOp(m, "SupercellSymOp",
@@ -2303,6 +2768,20 @@ PYBIND11_MODULE(_configuration, m) {
           py::return_value_policy::reference_internal,
           "Returns the site occupation values, as indices into the allowed "
           "occupants on the corresponding basis site, as a const reference.")
+      .def(
+          "occupation_view",
+          [](config::Configuration &configuration) -> Eigen::VectorXi & {
+            return configuration.dof_values.occupation;
+          },
+          py::return_value_policy::reference_internal,
+          R"pbdoc(
+          Returns the site occupation values as a writable array that shares
+          memory with the configuration.
+
+          Changing values of the array changes the configuration, without
+          copying. The array keeps the configuration alive. Values are not
+          checked for validity.
+          )pbdoc")
       .def(
           "set_occupation",
           [](config::Configuration &configuration,
@@ -2344,6 +2823,15 @@ PYBIND11_MODULE(_configuration, m) {
           py::return_value_policy::reference_internal, py::arg("key"),
           "Returns global DoF values of type `key`, in the prim basis, as a "
           "const reference.")
+      .def(
+          "global_dof_values_view",
+          [](config::Configuration &configuration,
+             std::string key) -> Eigen::VectorXd & {
+            return configuration.dof_values.global_dof_values.at(key);
+          },
+          py::return_value_policy::reference_internal, py::arg("key"),
+          "Returns global DoF values of type `key`, in the prim basis, as a "
+          "writable array that shares memory with the configuration.")
       .def(
           "global_standard_dof_values",
           [](config::Configuration const &configuration,
@@ -2393,6 +2881,22 @@ PYBIND11_MODULE(_configuration, m) {
           py::return_value_policy::reference_internal, py::arg("key"),
           "Returns local DoF values of type `key`, in the prim basis, as a "
           "const reference.")
+      .def(
+          "local_dof_values_view",
+          [](config::Configuration &configuration,
+             std::string key) -> Eigen::MatrixXd & {
+            return configuration.dof_values.local_dof_values.at(key);
+          },
+          py::return_value_policy::reference_internal, py::arg("key"),
+          R"pbdoc(
+          Returns local DoF values of type `key`, in the prim basis, as a
+          writable array that shares memory with the configuration.
+
+          The array has shape ``(dim, n_sites)``, as for
+          :func:`~libcasm.configuration.Configuration.local_dof_values`.
+          Changing values of the array changes the configuration, without
+          copying. The array keeps the configuration alive.
+          )pbdoc")
       .def(
           "local_standard_dof_values",
           [](config::Configuration const &configuration,
@@ -2846,6 +3350,34 @@ PYBIND11_MODULE(_configuration, m) {
               The `Configuration reference <https://prisms-center.github.io/CASMcode_docs/formats/casm/clex/Configuration/>`_ documents the expected format for Configurations."
           )pbdoc",
           py::arg("write_prim_basis") = false)
+      .def(py::pickle(
+          [](config::Configuration const &configuration) {
+            auto const &dof_values = configuration.dof_values;
+            return py::make_tuple(
+                configuration.supercell, dof_values.occupation,
+                dof_values.global_dof_values, dof_values.local_dof_values);
+          },
+          [](py::tuple state) {
+            if (state.size() != 4) {
+              throw std::runtime_error(
+                  "Error unpickling Configuration: invalid state");
+            }
+            auto supercell =
+                state[0].cast<std::shared_ptr<config::Supercell const>>();
+            clexulator::ConfigDoFValues dof_values;
+            dof_values.occupation = state[1].cast<Eigen::VectorXi>();
+            dof_values.global_dof_values =
+                state[2].cast<std::map<std::string, Eigen::VectorXd>>();
+            dof_values.local_dof_values =
+                state[3].cast<std::map<std::string, Eigen::MatrixXd>>();
+            if (dof_values.occupation.size() !=
+                supercell->unitcellcoord_index_converter.total_sites()) {
+              throw std::runtime_error(
+                  "Error unpickling Configuration: occupation size is "
+                  "inconsistent with the supercell");
+            }
+            return config::Configuration(supercell, dof_values);
+          }))
       .def_static(
           "from_structure",
           [](std::shared_ptr<config::Prim const> prim,
@@ -3193,6 +3725,67 @@ PYBIND11_MODULE(_configuration, m) {
           py::arg("prim"), py::arg("structure"),
           py::arg("converter") = std::string("isotropic_atomic"),
           py::arg("supercells") = std::nullopt, py::arg("magspin_tol") = 1.0)
+      .def_static(
+          "from_structures",
+          [](std::shared_ptr<config::Prim const> prim,
+             std::vector<xtal::SimpleStructure> const &structures,
+             std::string converter,
+             std::optional<std::shared_ptr<config::SupercellSet>>
+                 opt_supercells,
+             double magspin_tol, Index n_threads) {
+            std::shared_ptr<config::SupercellSet> supercells;
+            if (opt_supercells.has_value() &&
+                opt_supercells.value() != nullptr) {
+              supercells = opt_supercells.value();
+            }
+            std::vector<std::string> error_messages;
+            auto results = config::make_configurations_from_structures(
+                prim, structures, error_messages, converter, supercells,
+                magspin_tol, n_threads);
+            return std::make_pair(results, error_messages);
+          },
+          R"pbdoc(
+          Construct ConfigurationWithProperties from many Structure, in
+          parallel
+
+          Equivalent to calling :func:`ConfigurationWithProperties.from_structure`
+          for each structure, but structures are converted in parallel, and a
+          structure that cannot be converted does not stop the batch.
+
+          Parameters
+          ----------
+          prim : :class:`~libcasm.configuration.Prim`
+              The :class:`libcasm.configuration.Prim`.
+          structures : list[:class:`~libcasm.xtal.Structure`]
+              Structures which have been mapped to supercells of `prim`.
+          converter : str = "isotropic_atomic"
+              The converter to use, as for
+              :func:`ConfigurationWithProperties.from_structure`.
+          supercells : Optional[:class:`~libcasm.configuration.SupercellSet`] = None
+              An optional :class:`~libcasm.configuration.SupercellSet`, in which
+              to hold the shared supercells of the generated configurations in
+              order to avoid duplicates.
+          magspin_tol : float = 1.0
+              Used with ``converter=="discrete_magnetic_atomic"``, as for
+              :func:`ConfigurationWithProperties.from_structure`.
+          n_threads : int = 1
+              The number of threads to use. If <= 0, the number of hardware
+              threads is used.
+
+          Returns
+          -------
+          results : list[Optional[:class:`ConfigurationWithProperties`]]
+              The :class:`ConfigurationWithProperties` constructed from each
+              structure, in the same order as `structures`, or None if the
+              structure could not be converted.
+          error_messages : list[str]
+              The error message for each structure that could not be
+              converted, or an empty string.
+          )pbdoc",
+          py::arg("prim"), py::arg("structures"),
+          py::arg("converter") = std::string("isotropic_atomic"),
+          py::arg("supercells") = std::nullopt, py::arg("magspin_tol") = 1.0,
+          py::arg("n_threads") = 1)
       .def(
           "to_structure",
           [](config::ConfigurationWithProperties const &self,
@@ -3357,10 +3950,55 @@ PYBIND11_MODULE(_configuration, m) {
           return is_canonical(configuration, begin, end);
         }
       },
+      py::call_guard<py::gil_scoped_release>(),
       py::arg("configuration"), py::arg("subgroup") = std::nullopt,
       "Return true if configuration is in canonical form, given the provided "
       "SupercellSymOp (default is the supercell factor group).");
 
+  m.def(
+      "find_non_canonical_witness",
+      [](config::Configuration const &configuration,
+         std::optional<std::vector<config::SupercellSymOp>> subgroup)
+          -> std::optional<config::SupercellSymOp> {
+        if (subgroup.has_value()) {
+          auto it = find_non_canonical_witness(configuration, subgroup->begin(),
+                                               subgroup->end());
+          if (it == subgroup->end()) {
+            return std::nullopt;
+          }
+          return *it;
+        } else {
+          auto const &supercell = configuration.supercell;
+          auto begin = config::SupercellSymOp::begin(supercell);
+          auto end = config::SupercellSymOp::end(supercell);
+          auto it = find_non_canonical_witness(configuration, begin, end);
+          if (it == end) {
+            return std::nullopt;
+          }
+          return *it;
+        }
+      },
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("configuration"), py::arg("subgroup") = std::nullopt,
+      R"pbdoc(
+      Return the operation showing that a configuration is not in canonical
+      form
+
+      Parameters
+      ----------
+      configuration: Configuration
+          The configuration.
+      subgroup: Optional[list[SupercellSymOp]] = None
+          The operations checked. Default is the supercell factor group.
+
+      Returns
+      -------
+      witness: Optional[SupercellSymOp]
+          The first operation, `op`, in `subgroup` such that ``op *
+          configuration`` compares greater than `configuration`, or None if
+          `configuration` is in canonical form.
+      )pbdoc");
+
   m.def(
       "make_canonical_configuration",
       [](config::Configuration const &configuration,
@@ -3385,6 +4023,7 @@ PYBIND11_MODULE(_configuration, m) {
           return make_canonical_form(configuration, begin, end);
         }
       },
+      py::call_guard<py::gil_scoped_release>(),
       py::arg("configuration"), py::arg("in_canonical_supercell") = false,
       py::arg("subgroup") = std::nullopt,
       R"pbdoc(
@@ -3413,6 +4052,61 @@ PYBIND11_MODULE(_configuration, m) {
           `in_canonical_supercell == True`.
       )pbdoc");
 
+  m.def(
+      "make_canonical_configurations",
+      [](std::vector<config::Configuration> const &configurations,
+         Index n_threads, bool in_canonical_supercell,
+         std::shared_ptr<config::SupercellSet> supercells) {
+        if (configurations.empty()) {
+          return std::vector<config::Configuration>();
+        }
+        if (in_canonical_supercell) {
+          if (supercells == nullptr) {
+            supercells = std::make_shared<config::SupercellSet>(
+                configurations[0].supercell->prim);
+          }
+          return make_in_canonical_supercell(configurations, *supercells);
+        }
+        return make_canonical_forms(configurations,
+                                    configurations[0].supercell, n_threads);
+      },
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("configurations"), py::arg("n_threads") = 1,
+      py::arg("in_canonical_supercell") = false,
+      py::arg("supercells") = nullptr,
+      R"pbdoc(
+      Return the canonical forms of many configurations
+
+      Equivalent to calling :func:`make_canonical_configuration` for each
+      configuration, but faster when there are many configurations, because
+      symmetry operation data is shared between configurations.
+
+      Parameters
+      ----------
+      configurations : List[libcasm.configuration.Configuration]
+          The initial configurations. All must be in the same supercell,
+          unless `in_canonical_supercell` is True.
+      n_threads : int = 1
+          The number of threads to use. If <= 0, the number of hardware
+          threads is used. Not used if `in_canonical_supercell` is True.
+      in_canonical_supercell : bool, default=False
+          If True, the canonical configurations are found in the canonical
+          supercells, and `configurations` may be in different supercells.
+          The canonical supercell, and the prim factor group operation that
+          transforms to it, is found once per distinct supercell. Otherwise
+          the supercell is not changed.
+      supercells : Optional[libcasm.configuration.SupercellSet] = None
+          If provided with `in_canonical_supercell` True, canonical
+          supercells are found in or added to `supercells`, which remembers
+          the canonical supercell of each supercell for later calls.
+
+      Returns
+      -------
+      canonical_configurations : List[libcasm.configuration.Configuration]
+          The canonical configurations, in the same order as
+          `configurations`.
+      )pbdoc");
+
   m.def(
       "to_canonical_configuration",
       [](config::Configuration const &configuration,
@@ -3463,10 +4157,7 @@ PYBIND11_MODULE(_configuration, m) {
             return make_invariant_subgroup(configuration, group->begin(),
                                            group->end());
           } else {
-            auto const &supercell = configuration.supercell;
-            auto begin = config::SupercellSymOp::begin(supercell);
-            auto end = config::SupercellSymOp::end(supercell);
-            return make_invariant_subgroup(configuration, begin, end);
+            return config::make_invariant_subgroup(configuration);
           }
         } else {
           if (group.has_value()) {
@@ -3481,6 +4172,7 @@ PYBIND11_MODULE(_configuration, m) {
           }
         }
       },
+      py::call_guard<py::gil_scoped_release>(),
       py::arg("configuration"), py::arg("site_indices") = std::nullopt,
       py::arg("group") = std::nullopt,
       "Return the subgroup (as a List[libcasm.configuration.SupercellSymOp]) "
@@ -3507,6 +4199,7 @@ PYBIND11_MODULE(_configuration, m) {
           return make_invariant_subgroup(site_indices, begin, end);
         }
       },
+      py::call_guard<py::gil_scoped_release>(),
       py::arg("site_indices"), py::arg("group") = std::nullopt,
       "Return the subgroup (as a List[libcasm.configuration.SupercellSymOp]) "
       "that does not mix the given sites (a set of linear index of sites in "
@@ -3529,6 +4222,7 @@ PYBIND11_MODULE(_configuration, m) {
           return make_equivalents(configuration, begin, end);
         }
       },
+      py::call_guard<py::gil_scoped_release>(),
       py::arg("configuration"), py::arg("subgroup") = std::nullopt,
       "Return the distinct symmetrically equivalent configurations, with "
       "respect to the supercell factor group (default) or a subgroup of the "
@@ -3599,10 +4293,13 @@ PYBIND11_MODULE(_configuration, m) {
   m.def(
       "make_all_super_configurations",
       [](config::Configuration const &motif,
-         std::shared_ptr<config::Supercell const> const &supercell) {
-        return config::make_all_super_configurations(motif, supercell);
+         std::shared_ptr<config::Supercell const> const &supercell,
+         Index n_threads) {
+        return config::make_all_super_configurations(motif, supercell,
+                                                     n_threads);
       },
-      py::arg("motif"), py::arg("supercell"),
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("motif"), py::arg("supercell"), py::arg("n_threads") = 1,
       R"pbdoc(
       Make all equivalent configurations with respect to the prim factor group
       that fill a supercell
@@ -3613,6 +4310,10 @@ PYBIND11_MODULE(_configuration, m) {
           The initial configuration, with DoF values to be filled into the supercell.
       supercell : libcasm.configuration.Supercell
           The supercell to be filled by the motif configuration.
+      n_threads : int = 1
+          Number of threads used to make the configurations. If <= 0, uses
+          the number of hardware threads. The result does not depend on
+          `n_threads`.
 
       Returns
       -------
@@ -3624,11 +4325,13 @@ PYBIND11_MODULE(_configuration, m) {
   m.def(
       "make_all_super_configurations_by_subsets",
       [](config::Configuration const &motif,
-         std::shared_ptr<config::Supercell const> const &supercell) {
-        return config::make_all_super_configurations_by_subsets(motif,
-                                                                supercell);
+         std::shared_ptr<config::Supercell const> const &supercell,
+         Index n_threads) {
+        return config::make_all_super_configurations_by_subsets(
+            motif, supercell, n_threads);
       },
-      py::arg("motif"), py::arg("supercell"),
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("motif"), py::arg("supercell"), py::arg("n_threads") = 1,
       R"pbdoc(
         Make all equivalent configurations with respect to the prim factor group that
         fill a supercell, sorted by subsets of equivalents generated by SupercellSymOp
@@ -3639,6 +4342,10 @@ PYBIND11_MODULE(_configuration, m) {
             The initial configuration, with DoF values to be filled into the supercell.
         supercell : libcasm.configuration.Supercell
             The supercell to be filled by the motif configuration.
+        n_threads : int = 1
+            Number of threads used to make the subsets. If <= 0, uses the number
+            of hardware threads. Subsets are in the same order for any
+            `n_threads`.
 
         Returns
         -------
@@ -3655,6 +4362,7 @@ PYBIND11_MODULE(_configuration, m) {
          std::shared_ptr<config::Supercell const> const &supercell) {
         return config::make_distinct_super_configurations(motif, supercell);
       },
+      py::call_guard<py::gil_scoped_release>(),
       py::arg("motif"), py::arg("supercell"),
       R"pbdoc(
         Make configurations that fill a supercell and are equivalent with respect to
@@ -3674,27 +4382,290 @@ PYBIND11_MODULE(_configuration, m) {
             with `motif`, but may not be generated from each other using SupercellSymOp.
         )pbdoc");
 
-  m.def("is_primitive_configuration", &config::is_primitive,
-        py::arg("configuration"),
-        "Return true if no translations within the supercell result in the "
-        "same configuration");
-
   m.def(
-      "make_primitive_configuration",
-      [](config::Configuration const &configuration) {
-        return config::make_primitive(configuration);
+      "make_canonical_super_configurations",
+      [](config::Configuration const &motif,
+         std::shared_ptr<config::Supercell const> const &supercell) {
+        return config::make_canonical_super_configurations(motif, supercell);
       },
-      py::arg("configuration"),
-      "Return the primitive configuration. Does not apply any symmetry "
-      "operations. Use `make_canonical_configuration` with "
-      "`in_canonical_supercell=True` aftwards to obtain the "
-      "primitive canonical configuration in the canonical supercell.");
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("motif"), py::arg("supercell"),
+      R"pbdoc(
+        Make the distinct configurations, in canonical form, that fill a supercell
+        and are equivalent with respect to the prim factor group
+
+        Each filling of `supercell` by a unique orientation of `motif` is put in
+        canonical form as it is generated, and only the distinct canonical
+        configurations are kept, without generating all equivalents.
+
+        Parameters
+        ----------
+        motif : libcasm.configuration.Configuration
+            The initial configuration, with DoF values to be filled into the supercell.
+        supercell : libcasm.configuration.Supercell
+            The supercell to be filled by the motif configuration.
+
+        Returns
+        -------
+        canonical : list[libcasm.configuration.Configuration]
+            The distinct configurations, in canonical form with respect to the
+            supercell factor group, generated by filling `supercell` with `motif`,
+            sorted in ascending order.
+        )pbdoc");
+
+  m.def("is_primitive_configuration", &config::is_primitive,
+        py::call_guard<py::gil_scoped_release>(), py::arg("configuration"),
+        "Return true if no translations within the supercell result in the "
+        "same configuration");
+
+  m.def(
+      "make_primitive_configuration",
+      [](config::Configuration const &configuration) {
+        return config::make_primitive(configuration);
+      },
+      py::call_guard<py::gil_scoped_release>(), py::arg("configuration"),
+      "Return the primitive configuration. Does not apply any symmetry "
+      "operations. Use `make_canonical_configuration` with "
+      "`in_canonical_supercell=True` aftwards to obtain the "
+      "primitive canonical configuration in the canonical supercell.");
+
+  m.def(
+      "is_canonical_configurations",
+      [](std::vector<config::Configuration> const &configurations,
+         std::optional<std::vector<config::SupercellSymOp>> subgroup,
+         Index n_threads) {
+        Eigen::Matrix<bool, Eigen::Dynamic, 1> result(configurations.size());
+        config::parallel_for_chunks(
+            configurations.size(), n_threads,
+            [&](Index chunk_index, Index begin, Index end) {
+              for (Index i = begin; i < end; ++i) {
+                auto const &configuration = configurations[i];
+                if (subgroup.has_value()) {
+                  result(i) = is_canonical(configuration, subgroup->begin(),
+                                           subgroup->end());
+                } else {
+                  auto const &supercell = configuration.supercell;
+                  result(i) = is_canonical(
+                      configuration, config::SupercellSymOp::begin(supercell),
+                      config::SupercellSymOp::end(supercell));
+                }
+              }
+            });
+        return result;
+      },
+      py::call_guard<py::gil_scoped_release>(), py::arg("configurations"),
+      py::arg("subgroup") = std::nullopt, py::arg("n_threads") = 1,
+      R"pbdoc(
+      Check if many configurations are in canonical form
+
+      Equivalent to calling :func:`is_canonical_configuration` for each
+      configuration, but the loop runs in C++, in parallel, without the GIL.
+
+      Parameters
+      ----------
+      configurations : List[libcasm.configuration.Configuration]
+          The configurations. If `subgroup` is provided, all must be in the
+          supercell of `subgroup`.
+      subgroup : Optional[List[libcasm.configuration.SupercellSymOp]] = None
+          If provided, check if canonical with respect to this subgroup of the
+          supercell factor group. By default, each configuration is checked
+          with respect to the factor group of its own supercell.
+      n_threads : int = 1
+          The number of threads to use. If <= 0, uses
+          :func:`default_n_threads`.
+
+      Returns
+      -------
+      is_canonical : numpy.ndarray[bool]
+          ``is_canonical[i]`` is True if ``configurations[i]`` is canonical.
+      )pbdoc");
+
+  m.def(
+      "is_primitive_configurations",
+      [](std::vector<config::Configuration> const &configurations,
+         Index n_threads) {
+        Eigen::Matrix<bool, Eigen::Dynamic, 1> result(configurations.size());
+        config::parallel_for_chunks(
+            configurations.size(), n_threads,
+            [&](Index chunk_index, Index begin, Index end) {
+              for (Index i = begin; i < end; ++i) {
+                result(i) = config::is_primitive(configurations[i]);
+              }
+            });
+        return result;
+      },
+      py::call_guard<py::gil_scoped_release>(), py::arg("configurations"),
+      py::arg("n_threads") = 1,
+      R"pbdoc(
+      Check if many configurations are primitive
+
+      Equivalent to calling :func:`is_primitive_configuration` for each
+      configuration, but the loop runs in C++, in parallel, without the GIL.
+
+      Parameters
+      ----------
+      configurations : List[libcasm.configuration.Configuration]
+          The configurations.
+      n_threads : int = 1
+          The number of threads to use. If <= 0, uses
+          :func:`default_n_threads`.
+
+      Returns
+      -------
+      is_primitive : numpy.ndarray[bool]
+          ``is_primitive[i]`` is True if ``configurations[i]`` is primitive.
+      )pbdoc");
+
+  // occupations of many configurations, one per row
+  typedef Eigen::Matrix<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      occupation_array_type;
+
+  m.def(
+      "is_canonical_occupations",
+      [](std::shared_ptr<config::Supercell const> const &supercell,
+         occupation_array_type const &occupations,
+         Index n_threads) {
+        Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+        if (occupations.cols() != n_sites) {
+          throw std::runtime_error(
+              "Error in is_canonical_occupations: number of columns does not "
+              "match the number of sites in the supercell");
+        }
+        Eigen::Matrix<bool, Eigen::Dynamic, 1> result(occupations.rows());
+        auto begin = config::SupercellSymOp::begin(supercell);
+        auto end = config::SupercellSymOp::end(supercell);
+        config::parallel_for_chunks(
+            occupations.rows(), n_threads,
+            [&](Index chunk_index, Index chunk_begin, Index chunk_end) {
+              config::Configuration configuration(supercell);
+              for (Index i = chunk_begin; i < chunk_end; ++i) {
+                configuration.dof_values.occupation =
+                    occupations.row(i).transpose();
+                result(i) = is_canonical(configuration, begin, end);
+              }
+            });
+        return result;
+      },
+      py::call_guard<py::gil_scoped_release>(), py::arg("supercell"),
+      py::arg("occupations"), py::arg("n_threads") = 1,
+      R"pbdoc(
+      Check if many occupations, in one supercell, are in canonical form
+
+      Parameters
+      ----------
+      supercell : libcasm.configuration.Supercell
+          The supercell.
+      occupations : numpy.ndarray[int], shape=(n_configurations, n_sites)
+          Each row is the occupation of one configuration. Other DoF, if any,
+          have default (zero) values.
+      n_threads : int = 1
+          The number of threads to use. If <= 0, uses
+          :func:`default_n_threads`.
+
+      Returns
+      -------
+      is_canonical : numpy.ndarray[bool]
+          ``is_canonical[i]`` is True if ``occupations[i,:]`` is canonical
+          with respect to the supercell factor group.
+      )pbdoc");
+
+  m.def(
+      "make_canonical_occupations",
+      [](std::shared_ptr<config::Supercell const> const &supercell,
+         occupation_array_type const &occupations,
+         Index n_threads) {
+        Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+        if (occupations.cols() != n_sites) {
+          throw std::runtime_error(
+              "Error in make_canonical_occupations: number of columns does "
+              "not match the number of sites in the supercell");
+        }
+        std::vector<config::Configuration> configurations(
+            occupations.rows(), config::Configuration(supercell));
+        for (Index i = 0; i < occupations.rows(); ++i) {
+          configurations[i].dof_values.occupation =
+              occupations.row(i).transpose();
+        }
+        std::vector<config::Configuration> canonical =
+            make_canonical_forms(configurations, supercell, n_threads);
+        occupation_array_type result(occupations.rows(), n_sites);
+        for (Index i = 0; i < occupations.rows(); ++i) {
+          result.row(i) = canonical[i].dof_values.occupation.transpose();
+        }
+        return result;
+      },
+      py::call_guard<py::gil_scoped_release>(), py::arg("supercell"),
+      py::arg("occupations"), py::arg("n_threads") = 1,
+      R"pbdoc(
+      Make the canonical forms of many occupations in one supercell
+
+      Parameters
+      ----------
+      supercell : libcasm.configuration.Supercell
+          The supercell.
+      occupations : numpy.ndarray[int], shape=(n_configurations, n_sites)
+          Each row is the occupation of one configuration. Other DoF, if any,
+          have default (zero) values.
+      n_threads : int = 1
+          The number of threads to use. If <= 0, uses
+          :func:`default_n_threads`.
+
+      Returns
+      -------
+      canonical_occupations : numpy.ndarray[int], shape=(n_configurations, n_sites)
+          ``canonical_occupations[i,:]`` is the occupation of the canonical
+          form of ``occupations[i,:]``, with respect to the supercell factor
+          group.
+      )pbdoc");
+
+  m.def(
+      "configurations_to_dicts",
+      [](std::vector<config::Configuration> const &configurations,
+         bool write_prim_basis, Index n_threads) {
+        std::vector<nlohmann::json> result(configurations.size());
+        config::parallel_for_chunks(
+            configurations.size(), n_threads,
+            [&](Index chunk_index, Index begin, Index end) {
+              for (Index i = begin; i < end; ++i) {
+                jsonParser json;
+                to_json(configurations[i], json, write_prim_basis);
+                result[i] = static_cast<nlohmann::json>(json);
+              }
+            });
+        return result;
+      },
+      py::call_guard<py::gil_scoped_release>(), py::arg("configurations"),
+      py::arg("write_prim_basis") = false, py::arg("n_threads") = 1,
+      R"pbdoc(
+      Represent many configurations as Python dicts
+
+      Equivalent to calling :func:`Configuration.to_dict` for each
+      configuration, but the JSON is written in C++, in parallel, without the
+      GIL. Only the conversion of the results to Python dicts holds the GIL.
+
+      Parameters
+      ----------
+      configurations : List[libcasm.configuration.Configuration]
+          The configurations.
+      write_prim_basis : bool, default=False
+          If True, write DoF values using the prim basis. Default (False)
+          is to write DoF values in the standard basis.
+      n_threads : int = 1
+          The number of threads to use. If <= 0, uses
+          :func:`default_n_threads`.
+
+      Returns
+      -------
+      data : list[dict]
+          ``data[i]`` is the result of ``configurations[i].to_dict()``.
+      )pbdoc");
 
   m.def(
       "make_global_dof_matrix_rep",
       [](std::vector<config::SupercellSymOp> const &group, config::DoFKey key) {
         std::shared_ptr<config::SymGroup const> symgroup;
-        return config::make_global_dof_matrix_rep(group, key, symgroup);
+        return config::default_matrix_rep_cache().make_matrix_rep(
+            group, key, std::nullopt, symgroup);
       },
       py::arg("group"), py::arg("key"),
       "Make the matrix representation of `group` that describes the "
@@ -3705,8 +4676,8 @@ PYBIND11_MODULE(_configuration, m) {
       [](std::vector<config::SupercellSymOp> const &group, config::DoFKey key,
          std::set<Index> const &site_indices) {
         std::shared_ptr<config::SymGroup const> symgroup;
-        return config::make_local_dof_matrix_rep(group, key, site_indices,
-                                                 symgroup);
+        return config::default_matrix_rep_cache().make_matrix_rep(
+            group, key, site_indices, symgroup);
       },
       py::arg("group"), py::arg("key"), py::arg("site_indices"),
       "Make the matrix representation of `group` that describes the "
@@ -3738,6 +4709,443 @@ PYBIND11_MODULE(_configuration, m) {
       )pbdoc",
         py::arg("group"), py::arg("dof_space"));
 
+  m.def("make_order_parameters", &config::make_normal_coordinates, R"pbdoc(
+      Make order parameters for many configurations at once
+
+      The DoF values of all configurations are gathered into one matrix and
+      projected onto the DoFSpace basis with a single matrix product, which
+      is much faster than calling
+      :func:`Configuration.order_parameters <libcasm.configuration.Configuration.order_parameters>`
+      for each configuration.
+
+      Parameters
+      ----------
+      configurations: list[:class:`~libcasm.configuration.Configuration`]
+          The configurations. For local DoF, all must be in the
+          `dof_space` supercell.
+      dof_space: :class:`~libcasm.clexulator.DoFSpace`
+          A DoFSpace with basis defining the order parameters.
+
+      Returns
+      -------
+      order_parameters: numpy.ndarray[numpy.float64[n_configurations, dof_space_dim]]
+          Order parameters, where row `i` is equal to
+          ``configurations[i].order_parameters(dof_space)``.
+      )pbdoc",
+        py::arg("configurations"), py::arg("dof_space"));
+
+  py::class_<config::AtomicStructures>(m, "AtomicStructures", R"pbdoc(
+      Atomic structures of many configurations, in one set of arrays
+
+      Structures have the atom types, coordinates, and lattice vectors that
+      :func:`Configuration.to_structure` gives for each configuration, without
+      properties.
+
+      Example usage:
+
+      .. code-block:: Python
+
+          # lattice vectors, as columns, of structure `i`
+          L = structures.lat_column_mat[:, 3 * i : 3 * i + 3]
+
+          # Cartesian coordinates, as columns, of the atoms of structure `i`
+          begin = structures.atom_offsets[i]
+          end = structures.atom_offsets[i + 1]
+          coords = structures.coords[:, begin:end]
+
+          # names of the atoms of structure `i`
+          names = [structures.atom_type_names[t] for t in structures.atom_type[begin:end]]
+
+      )pbdoc")
+      .def_readonly("lat_column_mat", &config::AtomicStructures::lat_column_mat,
+                    "np.ndarray[np.float64[3, 3 * n_structures]]: Lattice "
+                    "vectors, as columns, including strain. The lattice vectors "
+                    "of structure `i` are columns `3*i` to `3*i + 2`.")
+      .def_readonly("atom_offsets", &config::AtomicStructures::atom_offsets,
+                    "np.ndarray[np.int64[n_structures + 1]]: Offset of the "
+                    "first atom of each structure in `atom_type` and "
+                    "`coords`.")
+      .def_readonly("atom_type", &config::AtomicStructures::atom_type,
+                    "np.ndarray[np.int32[n_atoms_total]]: Type of each atom, "
+                    "as an index into `atom_type_names`, for all structures.")
+      .def_readonly("atom_type_names",
+                    &config::AtomicStructures::atom_type_names,
+                    "list[str]: Atom type names.")
+      .def_readonly("coords", &config::AtomicStructures::coords,
+                    "np.ndarray[np.float64[3, n_atoms_total]]: Cartesian "
+                    "coordinates, as columns, of all atoms of all structures, "
+                    "including displacement and strain.")
+      .def("n_structures", &config::AtomicStructures::n_structures,
+           "Return the number of structures.")
+      .def("n_atoms", &config::AtomicStructures::n_atoms,
+           "Return the number of atoms in structure `i`.", py::arg("i"));
+
+  m.def(
+      "make_atomic_structures",
+      [](std::vector<config::Configuration> const &configurations,
+         std::string atom_type_naming_method,
+         std::vector<std::string> const &excluded_species) {
+        return config::make_atomic_structures(
+            configurations, atom_type_naming_method,
+            std::set<std::string>(excluded_species.begin(),
+                                  excluded_species.end()));
+      },
+      R"pbdoc(
+      Construct the atomic structures of many configurations, in one set of
+      arrays
+
+      This gives the same atom types, coordinates, and lattice vectors as
+      :func:`Configuration.to_structure`, for all configurations at once,
+      without constructing a :class:`~libcasm.xtal.Structure` for each
+      configuration. Ideal site coordinates are found once per supercell.
+
+      Parameters
+      ----------
+      configurations : list[libcasm.configuration.Configuration]
+          The configurations. All must have the same prim, with only atomic
+          occupants.
+      atom_type_naming_method : str = "chemical_name"
+          Specifies how to set atom type names, as for
+          :func:`Configuration.to_structure`.
+      excluded_species : list[str] = ["Va", "VA", "va"]
+          The names of any molecular or atomic species that should not be
+          included in the output.
+
+      Returns
+      -------
+      structures : AtomicStructures
+          The structures, as arrays.
+      )pbdoc",
+      py::arg("configurations"),
+      py::arg("atom_type_naming_method") = std::string("chemical_name"),
+      py::arg("excluded_species") =
+          std::vector<std::string>({"Va", "VA", "va"}));
+
+  py::class_<config::ConfigurationBatch>(m, "ConfigurationBatch", R"pbdoc(
+      Many configurations in one supercell, with DoF values stored as stacked
+      arrays
+
+      A ConfigurationBatch holds the DoF values of many configurations in one
+      shared supercell, without constructing a
+      :class:`~libcasm.configuration.Configuration` for each. Values are
+      accessed as NumPy arrays that share memory with the batch:
+
+      - ``occupation``: shape ``(n_configurations, n_sites)``, dtype ``int8``
+      - ``global_dof_values(key)``: shape ``(n_configurations, dim)``
+      - ``local_dof_values(key)``: shape ``(n_configurations, dim, n_sites)``
+
+      All values are in the prim basis. Continuous DoF values are optional, a
+      DoF that is not stored has value zero in all configurations.
+
+      Example usage:
+
+      .. code-block:: Python
+
+          batch = ConfigurationBatch(supercell, n_configurations=1000)
+          batch.occupation[:, 0] = 1
+          canonical = batch.make_canonical_forms(n_threads=4)
+          n_added = configuration_set.add_batch(canonical)
+
+      )pbdoc")
+      .def(py::init<std::shared_ptr<config::Supercell const> const &, Index,
+                    bool>(),
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          supercell : libcasm.configuration.Supercell
+              The shared supercell of all configurations.
+          n_configurations : int = 0
+              The initial number of configurations, with all DoF values zero.
+          include_continuous_dof : bool = True
+              If True, store all global and local continuous DoF of the prim.
+              If False, only store occupation.
+          )pbdoc",
+           py::arg("supercell"), py::arg("n_configurations") = 0,
+           py::arg("include_continuous_dof") = true)
+      .def_readonly("supercell", &config::ConfigurationBatch::supercell,
+                    "libcasm.configuration.Supercell: The shared supercell of "
+                    "all configurations.")
+      .def("size", &config::ConfigurationBatch::size,
+           "Return the number of configurations.")
+      .def("__len__", &config::ConfigurationBatch::size)
+      .def("n_sites", &config::ConfigurationBatch::n_sites,
+           "Return the number of sites in the supercell.")
+      .def_property_readonly(
+          "occupation",
+          [](config::ConfigurationBatch &self)
+              -> config::ConfigurationBatch::OccupationArray & {
+            return self.occupation;
+          },
+          py::return_value_policy::reference_internal,
+          "np.ndarray[np.int8[n_configurations, n_sites]]: Occupation, as a "
+          "writable array that shares memory with the batch.")
+      .def(
+          "global_dof_keys",
+          [](config::ConfigurationBatch const &self) {
+            std::vector<std::string> keys;
+            for (auto const &pair : self.global_dof_values) {
+              keys.push_back(pair.first);
+            }
+            return keys;
+          },
+          "Return the keys of the global DoF stored in the batch.")
+      .def(
+          "local_dof_keys",
+          [](config::ConfigurationBatch const &self) {
+            std::vector<std::string> keys;
+            for (auto const &pair : self.local_dof_values) {
+              keys.push_back(pair.first);
+            }
+            return keys;
+          },
+          "Return the keys of the local DoF stored in the batch.")
+      .def(
+          "global_dof_values",
+          [](config::ConfigurationBatch &self, std::string key)
+              -> config::ConfigurationBatch::ValuesArray & {
+            return self.global_dof_values.at(key);
+          },
+          py::return_value_policy::reference_internal, py::arg("key"),
+          "Returns global DoF values of type `key`, in the prim basis, with "
+          "shape `(n_configurations, dim)`, as a writable array that shares "
+          "memory with the batch.")
+      .def(
+          "local_dof_values",
+          [](py::object self_obj, std::string key) {
+            auto &self = self_obj.cast<config::ConfigurationBatch &>();
+            auto &values = self.local_dof_values.at(key);
+            py::ssize_t n = values.rows();
+            py::ssize_t n_sites = self.n_sites();
+            py::ssize_t dim = n_sites ? values.cols() / n_sites : 0;
+            py::ssize_t size = sizeof(double);
+            return py::array(
+                py::dtype::of<double>(), {n, dim, n_sites},
+                {dim * n_sites * size, size, dim * size}, values.data(),
+                self_obj);
+          },
+          py::arg("key"),
+          "Returns local DoF values of type `key`, in the prim basis, with "
+          "shape `(n_configurations, dim, n_sites)`, as a writable array that "
+          "shares memory with the batch.")
+      .def("resize", &config::ConfigurationBatch::resize,
+           "Change the number of configurations, keeping existing values and "
+           "setting new values to zero. Invalidates existing arrays.",
+           py::arg("n_configurations"))
+      .def("configuration", &config::ConfigurationBatch::configuration,
+           "Return configuration `i`, as a copy.", py::arg("i"))
+      .def("set", &config::ConfigurationBatch::set,
+           "Set the values of configuration `i`. The configuration must be in "
+           "the batch supercell.",
+           py::arg("i"), py::arg("configuration"))
+      .def("append", &config::ConfigurationBatch::push_back,
+           "Append a configuration. This reallocates all arrays and "
+           "invalidates existing arrays, so to add many configurations use "
+           "`resize` and then `set`.",
+           py::arg("configuration"))
+      .def(
+          "make_canonical_forms",
+          [](config::ConfigurationBatch const &self, Index n_threads) {
+            return config::make_canonical_forms(self, n_threads);
+          },
+          py::call_guard<py::gil_scoped_release>(), py::arg("n_threads") = 1,
+          R"pbdoc(
+          Make the canonical forms of all configurations
+
+          Equivalent to :func:`make_canonical_configurations`, with respect to
+          the supercell factor group, for the configurations of the batch.
+
+          Parameters
+          ----------
+          n_threads : int = 1
+              The number of threads to use. If <= 0, uses
+              :func:`default_n_threads`.
+
+          Returns
+          -------
+          canonical : ConfigurationBatch
+              A batch, storing the same DoF, of the canonical forms.
+          )pbdoc")
+      .def(
+          "is_primitive",
+          [](config::ConfigurationBatch const &self, Index n_threads) {
+            return config::is_primitive(self, n_threads);
+          },
+          py::call_guard<py::gil_scoped_release>(), py::arg("n_threads") = 1,
+          R"pbdoc(
+          Check if each configuration is primitive
+
+          Parameters
+          ----------
+          n_threads : int = 1
+              The number of threads to use. If <= 0, uses
+              :func:`default_n_threads`.
+
+          Returns
+          -------
+          is_primitive : np.ndarray[np.bool_[n_configurations]]
+              Element `i` is True if configuration `i` is primitive.
+          )pbdoc")
+      .def(
+          "n_equivalents",
+          [](config::ConfigurationBatch const &self, Index n_threads) {
+            return config::make_n_equivalents(self, n_threads);
+          },
+          py::call_guard<py::gil_scoped_release>(), py::arg("n_threads") = 1,
+          R"pbdoc(
+          Count the distinct equivalents of each configuration
+
+          The number of distinct configurations obtained by applying the
+          supercell symmetry operations (supercell factor group and
+          translations), equal to the number of operations divided by the
+          size of the invariant subgroup.
+
+          Parameters
+          ----------
+          n_threads : int = 1
+              The number of threads to use. If <= 0, uses
+              :func:`default_n_threads`.
+
+          Returns
+          -------
+          n_equivalents : np.ndarray[np.int64[n_configurations]]
+              Element `i` is the number of equivalents of configuration `i`.
+          )pbdoc")
+      .def(
+          "to_structures",
+          [](config::ConfigurationBatch const &self,
+             std::string atom_type_naming_method,
+             std::vector<std::string> const &excluded_species) {
+            return config::make_atomic_structures(
+                self, atom_type_naming_method,
+                std::set<std::string>(excluded_species.begin(),
+                                      excluded_species.end()));
+          },
+          py::call_guard<py::gil_scoped_release>(),
+          R"pbdoc(
+          Construct the atomic structures of all configurations
+
+          Equivalent to :func:`make_atomic_structures` for the configurations
+          of the batch.
+
+          Parameters
+          ----------
+          atom_type_naming_method : str = "chemical_name"
+              Specifies how to set atom type names, as for
+              :func:`Configuration.to_structure`.
+          excluded_species : list[str] = ["Va", "VA", "va"]
+              The names of any molecular or atomic species that should not be
+              included in the output.
+
+          Returns
+          -------
+          structures : AtomicStructures
+              The structures, as arrays.
+          )pbdoc",
+          py::arg("atom_type_naming_method") = std::string("chemical_name"),
+          py::arg("excluded_species") =
+              std::vector<std::string>({"Va", "VA", "va"}));
+
+  pyConfigurationSet
+      .def("add_batch", &config::insert_batch, R"pbdoc(
+          Add all configurations in a batch to the set
+
+          Configurations are added as they are, in order, setting
+          configuration_id automatically. To add canonical forms, use
+          :func:`ConfigurationBatch.make_canonical_forms` first. The batch
+          supercell must be the canonical supercell, though this is not
+          checked.
+
+          Parameters
+          ----------
+          batch : libcasm.configuration.ConfigurationBatch
+              The configurations to add.
+
+          Returns
+          -------
+          n_added : int
+              The number of configurations that were added.
+          )pbdoc",
+           py::arg("batch"))
+      .def(
+          "extract_batch",
+          [](config::ConfigurationSet const &self,
+             std::shared_ptr<config::Supercell const> const &supercell) {
+            std::vector<std::string> configuration_ids;
+            config::ConfigurationBatch batch = config::make_configuration_batch(
+                self, supercell, &configuration_ids);
+            return std::make_pair(std::move(batch),
+                                  std::move(configuration_ids));
+          },
+          R"pbdoc(
+          Make a batch of the configurations in one supercell
+
+          Parameters
+          ----------
+          supercell : libcasm.configuration.Supercell
+              The supercell. Configurations with supercell name equal to the
+              name of `supercell` are included, in the order of the set.
+
+          Returns
+          -------
+          batch : libcasm.configuration.ConfigurationBatch
+              The configurations, storing all continuous DoF.
+          configuration_ids : list[str]
+              The configuration_id of each configuration in the batch.
+          )pbdoc",
+          py::arg("supercell"));
+
+  py::register_exception<config::OperationCancelled>(
+      m, "OperationCancelled", PyExc_KeyboardInterrupt);
+
+  py::class_<config::ProgressMonitor, std::shared_ptr<config::ProgressMonitor>>(
+      m, "ProgressMonitor", R"pbdoc(
+      Progress reporting and cancellation for long-running functions
+
+      Functions that accept a `progress` argument report their progress to
+      the ProgressMonitor and stop, raising
+      :class:`~libcasm.configuration.OperationCancelled`, if cancellation is
+      requested. :class:`~libcasm.configuration.OperationCancelled` is a
+      subclass of `KeyboardInterrupt`.
+
+      Cancellation is requested by :func:`ProgressMonitor.cancel`, by the
+      callback, or by a pending signal such as Ctrl-C, which is checked each
+      time progress is reported.
+
+      The callback is only called on the thread that constructed the
+      ProgressMonitor. Work done by worker threads is included in `n_done`
+      at the next report.
+
+      )pbdoc")
+      .def(py::init(&make_progress_monitor),
+           R"pbdoc(
+      .. rubric:: Constructor
+
+      Parameters
+      ----------
+      callback: Optional[Callable[[str, int, int], None]] = None
+          If provided, called as ``callback(stage, n_done, n_total)`` to
+          report progress. `n_total` is -1 if the total is not known.
+          Exceptions raised by the callback propagate out of the
+          long-running function.
+      min_interval: float = 0.1
+          Minimum time, in seconds, between progress reports within a stage.
+          Progress is always reported at the beginning of each stage.
+      )pbdoc",
+           py::arg("callback") = std::nullopt, py::arg("min_interval") = 0.1)
+      .def("cancel", &config::ProgressMonitor::cancel,
+           "Request cancellation. May be called from any thread.")
+      .def("is_cancelled", &config::ProgressMonitor::is_cancelled,
+           "Return True if cancellation has been requested.")
+      .def("stage", &config::ProgressMonitor::stage,
+           "Return the current stage.")
+      .def("n_done", &config::ProgressMonitor::n_done,
+           "Return the number of work items completed in the current stage.")
+      .def("n_total", &config::ProgressMonitor::n_total,
+           "Return the number of work items in the current stage, or -1 if "
+           "unknown.");
+
   //
   py::class_<config::ConfigSpaceAnalysisResults>(m,
                                                  "ConfigSpaceAnalysisResults",
@@ -3785,8 +5193,34 @@ PYBIND11_MODULE(_configuration, m) {
           ":class:`~libcasm.clexulator.DoFSpace`: Symmetry-adapted config "
           "space, with basis formed by eigenvectors of P.");
 
-  m.def("config_space_analysis", &config::config_space_analysis,
-        R"pbdoc(
+  m.def(
+      "config_space_analysis",
+      [](std::map<std::string, config::Configuration> const &configurations,
+         std::optional<std::vector<DoFKey>> dofs,
+         std::optional<bool> exclude_homogeneous_modes,
+         bool include_default_occ_modes,
+         std::optional<std::map<int, int>> sublattice_index_to_default_occ,
+         std::optional<std::map<Index, int>> site_index_to_default_occ,
+         double tol, bool store_equivalents, Index batch_size,
+         Index n_threads, bool use_cache,
+         std::shared_ptr<config::ProgressMonitor> progress)
+          -> std::map<DoFKey, config::ConfigSpaceAnalysisResults> {
+        if (use_cache) {
+          return *config::default_dof_space_analysis_cache()
+                      .config_space_analysis(
+                          configurations, dofs, exclude_homogeneous_modes,
+                          include_default_occ_modes,
+                          sublattice_index_to_default_occ,
+                          site_index_to_default_occ, tol, store_equivalents,
+                          batch_size, n_threads, progress);
+        }
+        return config::config_space_analysis(
+            configurations, dofs, exclude_homogeneous_modes,
+            include_default_occ_modes, sublattice_index_to_default_occ,
+            site_index_to_default_occ, tol, store_equivalents, batch_size,
+            n_threads, progress);
+      },
+      R"pbdoc(
       Construct symmetry adapted bases in the DoF space spanned by the set of
       configurations symmetrically equivalent to the input configurations
 
@@ -3831,6 +5265,28 @@ PYBIND11_MODULE(_configuration, m) {
           supercell site index (the key).
       tol : float = libcasm.TOL
           Tolerance used for identifying zero-valued eigenvalues.
+      store_equivalents : bool = True
+          If True, store all equivalent configurations and their DoF values in
+          the results. If False, the equivalents are generated one operation at
+          a time and not stored, so memory use does not depend on the number of
+          equivalents, and `equivalent_dof_values` and
+          `equivalent_configurations` are empty.
+      batch_size : int = 256
+          Number of DoF vectors accumulated into the projector per rank-k
+          update. Only used if `store_equivalents` is False.
+      n_threads : int = 1
+          Number of threads used to accumulate the projector for each input
+          configuration. If <= 0, uses the number of hardware threads. Only used
+          if `store_equivalents` is False.
+      use_cache : bool = False
+          If True, the analysis is done once for each distinct set of inputs
+          and the results are then returned from a process-wide cache. Use
+          :func:`set_dof_space_analysis_cache_dir` to also store results on
+          disk.
+      progress : Optional[:class:`~libcasm.configuration.ProgressMonitor`] = None
+          If provided, report progress, with one stage per DoF type, and allow
+          cancellation. If cancelled, raises
+          :class:`~libcasm.configuration.OperationCancelled`.
 
       Returns
       -------
@@ -3839,12 +5295,107 @@ PYBIND11_MODULE(_configuration, m) {
           matrix, eigenvalues, and symmetry adapted configuration space, for each
           requested DoF type.
       )pbdoc",
+        py::call_guard<py::gil_scoped_release>(),
         py::arg("configurations"), py::arg("dofs") = std::nullopt,
         py::arg("exclude_homogeneous_modes") = std::nullopt,
         py::arg("include_default_occ_modes") = false,
         py::arg("sublattice_index_to_default_occ") = std::nullopt,
         py::arg("site_index_to_default_occ") = std::nullopt,
-        py::arg("tol") = CASM::TOL);
+        py::arg("tol") = CASM::TOL, py::arg("store_equivalents") = true,
+        py::arg("batch_size") = 256, py::arg("n_threads") = 1,
+        py::arg("use_cache") = false, py::arg("progress") = nullptr);
+
+  py::class_<config::ConfigSpaceAnalysisAccumulator>(
+      m, "ConfigSpaceAnalysisAccumulator", R"pbdoc(
+      Accumulate the :func:`~libcasm.configuration.config_space_analysis`
+      projector as configurations are added
+
+      The projector is updated by rank-k updates as configurations are added,
+      and the eigendecomposition is only done when
+      :func:`~libcasm.configuration.ConfigSpaceAnalysisAccumulator.results` is
+      called. The results are the same as from
+      :func:`~libcasm.configuration.config_space_analysis` with all added
+      configurations, for one DoF type.
+
+      If an added configuration is not commensurate with the current fully
+      commensurate supercell, the supercell grows and the projector is rebuilt
+      from all added configurations. This is not allowed if
+      `site_index_to_default_occ` is given, except for the first
+      configurations added.
+      )pbdoc")
+      .def(py::init<std::shared_ptr<config::Prim const> const &,
+                    DoFKey const &, std::optional<bool>, bool,
+                    std::optional<std::map<int, int>>,
+                    std::optional<std::map<Index, int>>, double, bool, Index,
+                    Index>(),
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          prim : :class:`~libcasm.configuration.Prim`
+              The prim
+          dof : str
+              The DoF type analysed.
+
+          Other parameters are as for
+          :func:`~libcasm.configuration.config_space_analysis`.
+          )pbdoc",
+           py::arg("prim"), py::arg("dof"),
+           py::arg("exclude_homogeneous_modes") = std::nullopt,
+           py::arg("include_default_occ_modes") = false,
+           py::arg("sublattice_index_to_default_occ") = std::nullopt,
+           py::arg("site_index_to_default_occ") = std::nullopt,
+           py::arg("tol") = CASM::TOL, py::arg("store_equivalents") = true,
+           py::arg("batch_size") = 256, py::arg("n_threads") = 1)
+      .def_static(
+          "from_results",
+          [](config::ConfigSpaceAnalysisResults const &results,
+             std::optional<bool> exclude_homogeneous_modes,
+             bool include_default_occ_modes,
+             std::optional<std::map<int, int>> sublattice_index_to_default_occ,
+             std::optional<std::map<Index, int>> site_index_to_default_occ,
+             double tol, bool store_equivalents, Index batch_size,
+             Index n_threads) {
+            return config::ConfigSpaceAnalysisAccumulator(
+                results, exclude_homogeneous_modes, include_default_occ_modes,
+                sublattice_index_to_default_occ, site_index_to_default_occ,
+                tol, store_equivalents, batch_size, n_threads);
+          },
+          R"pbdoc(
+          Continue from :func:`~libcasm.configuration.config_space_analysis`
+          results
+
+          The projector is rebuilt from the stored `equivalent_dof_values`,
+          so the results must have been generated with
+          `store_equivalents=True`. Other parameters must be the same as were
+          used to generate the results.
+          )pbdoc",
+          py::arg("results"),
+          py::arg("exclude_homogeneous_modes") = std::nullopt,
+          py::arg("include_default_occ_modes") = false,
+          py::arg("sublattice_index_to_default_occ") = std::nullopt,
+          py::arg("site_index_to_default_occ") = std::nullopt,
+          py::arg("tol") = CASM::TOL, py::arg("store_equivalents") = true,
+          py::arg("batch_size") = 256, py::arg("n_threads") = 1)
+      .def("insert", &config::ConfigSpaceAnalysisAccumulator::insert,
+           py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+          Add configurations, by identifier, and return the number that were
+          not equivalent to a configuration already added
+          )pbdoc",
+           py::arg("configurations"))
+      .def("supercell", &config::ConfigSpaceAnalysisAccumulator::supercell,
+           "The fully commensurate supercell of the added configurations.")
+      .def("dim", &config::ConfigSpaceAnalysisAccumulator::dim,
+           "Dimension of the standard DoF space.")
+      .def("n_prototypes",
+           &config::ConfigSpaceAnalysisAccumulator::n_prototypes,
+           "Number of distinct primitive configurations added.")
+      .def("results", &config::ConfigSpaceAnalysisAccumulator::results,
+           py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+          Make :class:`~libcasm.configuration.ConfigSpaceAnalysisResults`, by
+          eigendecomposition of the current projector
+          )pbdoc");
 
   //
   py::class_<config::DoFSpaceAnalysisResults>(m, "DoFSpaceAnalysisResults",
@@ -3876,13 +5427,26 @@ PYBIND11_MODULE(_configuration, m) {
          bool include_default_occ_modes,
          std::optional<std::map<int, int>> sublattice_index_to_default_occ,
          std::optional<std::map<Index, int>> site_index_to_default_occ,
-         bool calc_wedges) -> config::DoFSpaceAnalysisResults {
+         bool calc_wedges,
+         bool use_character_projection, bool use_kstar_blocks,
+         Index n_threads, bool use_cache) -> config::DoFSpaceAnalysisResults {
         std::optional<Log> log = std::nullopt;
         // std::optional<Log> log = Log(std::cout, Log::debug, true);
+        if (use_cache) {
+          return *config::default_dof_space_analysis_cache()
+                      .dof_space_analysis(
+                          dof_space, prim, configuration,
+                          exclude_homogeneous_modes, include_default_occ_modes,
+                          sublattice_index_to_default_occ,
+                          site_index_to_default_occ, calc_wedges, log,
+                          use_character_projection, use_kstar_blocks,
+                          n_threads);
+        }
         return config::dof_space_analysis(
             dof_space, prim, configuration, exclude_homogeneous_modes,
             include_default_occ_modes, sublattice_index_to_default_occ,
-            site_index_to_default_occ, calc_wedges, log);
+            site_index_to_default_occ, calc_wedges, log,
+            use_character_projection, use_kstar_blocks, n_threads);
       },
       R"pbdoc(
       Construct symmetry adapted bases in a DoFSpace
@@ -3934,6 +5498,27 @@ PYBIND11_MODULE(_configuration, m) {
           If True, calculate the irreducible wedges for the vector space.
           This may take a long time, but provides the symmetrically unique
           portions of the vector space, which is useful for enumeration.
+      use_character_projection : bool = False
+          If True, find irreps using character projection operators, with the
+          character table of the symmetry group constructed from its conjugacy
+          classes. This is much faster for large DoF spaces. If False, use the
+          commuter method.
+      use_kstar_blocks : bool = False
+          If True, for local DoF, first decompose the DoF space into
+          components for each star of k-points commensurate with the
+          superlattice, and then find irreps separately in each component.
+          This is much faster for large supercells. Has no effect for global
+          DoF, or if the DoF space is not invariant under supercell
+          translations.
+      n_threads : int = 1
+          Number of threads used to calculate the irreducible wedges. If
+          less than 1, use the number of hardware threads. The result does
+          not depend on the number of threads.
+      use_cache : bool = False
+          If True, the analysis is done once for each distinct set of inputs
+          and the results are then returned from a process-wide cache. Use
+          :func:`set_dof_space_analysis_cache_dir` to also store results on
+          disk.
 
 
       Returns
@@ -3944,13 +5529,302 @@ PYBIND11_MODULE(_configuration, m) {
           holding the irreducible space decomposition used to construct the
           symmetry adapted basis.
       )pbdoc",
+      py::call_guard<py::gil_scoped_release>(),
       py::arg("dof_space"), py::arg("prim"),
       py::arg("configuration") = std::nullopt,
       py::arg("exclude_homogeneous_modes") = std::nullopt,
       py::arg("include_default_occ_modes") = false,
       py::arg("sublattice_index_to_default_occ") = std::nullopt,
       py::arg("site_index_to_default_occ") = std::nullopt,
-      py::arg("calc_wedges") = false);
+      py::arg("calc_wedges") = false,
+      py::arg("use_character_projection") = false,
+      py::arg("use_kstar_blocks") = false, py::arg("n_threads") = 1,
+      py::arg("use_cache") = false);
+
+  m.def(
+      "set_dof_space_analysis_cache_dir",
+      [](std::optional<std::string> cache_dir) {
+        if (cache_dir.has_value()) {
+          config::default_dof_space_analysis_cache().set_cache_dir(
+              fs::path(*cache_dir));
+        } else {
+          config::default_dof_space_analysis_cache().set_cache_dir(
+              std::nullopt);
+        }
+      },
+      R"pbdoc(
+      Set the directory where dof_space_analysis(use_cache=True) and
+      config_space_analysis(use_cache=True) store results
+
+      Parameters
+      ----------
+      cache_dir: Optional[str] = None
+          Directory where results are written as JSON files named by a hash
+          of the inputs, and read back by later processes. If None, results
+          are only cached in memory.
+      )pbdoc",
+      py::arg("cache_dir") = std::nullopt);
+
+  m.def(
+      "clear_dof_space_analysis_cache",
+      []() { config::default_dof_space_analysis_cache().clear(); },
+      R"pbdoc(
+      Clear results cached in memory by dof_space_analysis(use_cache=True)
+      and config_space_analysis(use_cache=True)
+
+      Results files in the cache directory, if any, are not removed.
+      )pbdoc");
+
+  m.def(
+      "clear_matrix_rep_cache",
+      []() { config::default_matrix_rep_cache().clear(); },
+      R"pbdoc(
+      Clear the matrix representations cached by dof_space_analysis,
+      make_dof_space_rep, make_global_dof_matrix_rep, and
+      make_local_dof_matrix_rep
+      )pbdoc");
+
+  m.def(
+      "set_matrix_rep_cache_max_bytes",
+      [](Index max_total_bytes) {
+        config::default_matrix_rep_cache().set_max_total_bytes(
+            max_total_bytes);
+      },
+      R"pbdoc(
+      Set the maximum memory used by cached matrix representations
+
+      If the total memory used by cached matrix representations is larger
+      than this, least recently used matrix representations are evicted.
+
+      Parameters
+      ----------
+      max_total_bytes: int = 268435456
+          The maximum memory, in bytes.
+      )pbdoc",
+      py::arg("max_total_bytes") = Index(1) << 28);
+
+  m.def(
+      "memory_usage",
+      []() {
+        config::MemoryUsage usage = config::memory_usage();
+        std::map<std::string, Index> result;
+        result["supercell_sym_info"] = usage.supercell_sym_info_bytes;
+        result["combined_permutation_tables"] =
+            usage.combined_permutation_table_bytes;
+        result["matrix_rep_cache"] = usage.matrix_rep_cache_bytes;
+        result["canonical_primitive_cache"] =
+            usage.canonical_primitive_cache_bytes;
+        result["orbit_cache"] = usage.orbit_cache_bytes;
+        result["prim_sym_info_cache"] = usage.prim_sym_info_cache_bytes;
+        result["total"] = usage.total_bytes();
+        return result;
+      },
+      R"pbdoc(
+      Return the approximate memory used by process-wide symmetry tables and
+      caches
+
+      Returns
+      -------
+      usage: dict[str, int]
+          Memory, in bytes, used by the symmetry tables of all existing
+          supercells ("supercell_sym_info"), cached combined permutation
+          tables ("combined_permutation_tables"), and the matrix
+          representation, canonical primitive configuration, orbit, and prim
+          symmetry info caches ("matrix_rep_cache",
+          "canonical_primitive_cache", "orbit_cache",
+          "prim_sym_info_cache"), and the total ("total").
+      )pbdoc");
+
+  m.def("set_memory_budget", &config::set_memory_budget,
+        R"pbdoc(
+      Set the process-wide memory budget for symmetry tables and caches
+
+      While a budget is set, cached combined permutation tables, matrix
+      representations, canonical primitive configurations, and orbits are
+      evicted, in that order, whenever the total from :func:`memory_usage`
+      exceeds the budget, and new supercells do not store translation
+      permutations if that would exceed the budget, evaluating them as
+      needed instead. Symmetry tables of existing supercells and prims are
+      never released.
+
+      Parameters
+      ----------
+      max_bytes: Optional[int] = None
+          The maximum memory, in bytes, or None for no budget.
+      )pbdoc",
+        py::arg("max_bytes") = std::nullopt);
+
+  m.def("memory_budget", &config::memory_budget,
+        R"pbdoc(
+      Return the process-wide memory budget, in bytes, or None if there is
+      no budget
+      )pbdoc");
+
+  m.def(
+      "enforce_memory_budget", []() { return config::enforce_memory_budget(); },
+      R"pbdoc(
+      Evict cached values until memory usage is within the memory budget
+
+      Returns
+      -------
+      n_bytes: int
+          The approximate memory, in bytes, used by the evicted values.
+      )pbdoc");
+
+  m.def("numa_node_count", &config::numa_node_count,
+        R"pbdoc(
+      Return the number of NUMA nodes, or 1 if not known
+      )pbdoc");
+
+  m.def("numa_replication_is_enabled", &config::numa_replication_is_enabled,
+        R"pbdoc(
+      Return True if supercell symmetry tables are replicated per NUMA node
+      )pbdoc");
+
+  m.def("set_numa_replication_enabled", &config::set_numa_replication_enabled,
+        R"pbdoc(
+      Start or stop replicating supercell symmetry tables per NUMA node
+
+      On multi-socket machines, threads reading symmetry tables allocated on
+      another socket's memory are limited by cross-socket latency. While
+      enabled, :func:`make_canonical_configurations`, and the
+      :class:`ConfigurationBatch` canonical form methods, have each thread
+      read the factor group permutations, translation permutations, and
+      combined permutation table from a copy made on its own NUMA node.
+      Replicas are kept for the lifetime of the supercell, and are counted
+      by :func:`memory_usage` and limited by the memory budget.
+
+      Replication is off by default, and has no effect if there is only one
+      NUMA node.
+
+      Parameters
+      ----------
+      enabled: bool = True
+          If True, start replicating. If False, stop using replicas.
+          Existing replicas are kept.
+      )pbdoc",
+        py::arg("enabled") = true);
+
+  m.def(
+      "set_prim_sym_info_cache_dir",
+      [](std::optional<std::string> cache_dir) {
+        if (cache_dir.has_value()) {
+          config::default_prim_sym_info_cache().set_cache_dir(
+              fs::path(*cache_dir));
+        } else {
+          config::default_prim_sym_info_cache().set_cache_dir(std::nullopt);
+        }
+      },
+      R"pbdoc(
+      Set the directory where Prim(use_cache=True) stores symmetry
+      representations
+
+      When a directory is set, unpickled Prim also use the cache.
+
+      Parameters
+      ----------
+      cache_dir: Optional[str] = None
+          Directory where the factor group and symmetry representations are
+          written as JSON files named by a hash of the prim, and read back by
+          later processes. If None, they are only cached in memory.
+      )pbdoc",
+      py::arg("cache_dir") = std::nullopt);
+
+  m.def(
+      "clear_prim_sym_info_cache",
+      []() { config::default_prim_sym_info_cache().clear(); },
+      R"pbdoc(
+      Clear symmetry representations cached in memory by
+      Prim(use_cache=True)
+
+      Files in the cache directory, if any, are not removed.
+      )pbdoc");
+
+  m.def("default_n_threads", &config::default_n_threads, R"pbdoc(
+      Return the default number of threads used by parallel functions
+
+      This is the number of threads used when a function is called with
+      ``n_threads <= 0``, and the size of the process-wide thread pool that
+      runs all parallel work in libcasm, so that nested parallel calls do not
+      use more threads. By default it is the number of hardware threads.
+      )pbdoc");
+
+  m.def("set_default_n_threads", &config::set_default_n_threads, R"pbdoc(
+      Set the default number of threads used by parallel functions
+
+      Parameters
+      ----------
+      n_threads: int
+          Number of threads, including the calling thread, that run parallel
+          work in libcasm. If ``n_threads <= 0``, resets to the number of
+          hardware threads. If 1, all parallel functions run on the calling
+          thread, regardless of their `n_threads` argument. Worker threads
+          never call into Python.
+      )pbdoc",
+        py::arg("n_threads"));
+
+  m.def("instrumentation_is_compiled",
+        &config::instrumentation::is_compiled, R"pbdoc(
+      Return True if libcasm-configuration was built with instrumentation
+
+      If False, :func:`set_instrumentation_enabled` has no effect and all
+      instrumentation results are zero.
+      )pbdoc");
+
+  m.def("instrumentation_is_enabled", &config::instrumentation::is_enabled,
+        R"pbdoc(
+      Return True if instrumentation counters and timers are recording
+      )pbdoc");
+
+  m.def("set_instrumentation_enabled",
+        &config::instrumentation::set_enabled, R"pbdoc(
+      Start or stop recording instrumentation counters and timers
+
+      Instrumentation is off by default. While on, libcasm counts symmetry
+      operation applications, configuration comparisons, translation
+      permutations built, supercells constructed, and canonical forms made,
+      and times SupercellSymInfo construction, translation permutation
+      construction, canonical form generation, and configuration JSON IO.
+      Values are accumulated per thread and summed by
+      :func:`instrumentation_results`.
+
+      Parameters
+      ----------
+      enabled: bool
+          If True, start recording. If False, stop recording. Recorded
+          values are kept until :func:`reset_instrumentation`.
+      )pbdoc",
+        py::arg("enabled"));
+
+  m.def("reset_instrumentation", &config::instrumentation::reset, R"pbdoc(
+      Set all instrumentation counts and times, on all threads, to zero
+      )pbdoc");
+
+  m.def(
+      "instrumentation_results",
+      []() {
+        config::instrumentation::Results results =
+            config::instrumentation::results();
+        nlohmann::json data;
+        data["counts"] = results.counts;
+        data["seconds"] = results.seconds;
+        data["calls"] = results.calls;
+        return data;
+      },
+      R"pbdoc(
+      Return instrumentation results, summed over all threads
+
+      Returns
+      -------
+      results: dict
+          A dict with keys:
+
+          - ``"counts"``: dict[str, int], count by counter name
+          - ``"seconds"``: dict[str, float], total time in seconds by timer
+            name
+          - ``"calls"``: dict[str, int], number of timed scopes by timer
+            name. Nested scopes of the same timer are timed once.
+      )pbdoc");
 
 #ifdef VERSION_INFO
   m.attr("__version__") = MACRO_STRINGIFY(VERSION_INFO);
@@ -1,4 +1,5 @@
 #include <pybind11/eigen.h>
+#include <pybind11/functional.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -12,12 +13,27 @@
 #include "casm/casm_io/json/InputParser_impl.hh"
 #include "casm/casm_io/json/jsonParser.hh"
 #include "casm/configuration/Configuration.hh"
+#include "casm/configuration/ConfigurationSet.hh"
 #include "casm/configuration/clusterography/IntegralCluster.hh"
 #include "casm/configuration/clusterography/orbits.hh"
 #include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/enumeration/BatchPrefetcher.hh"
 #include "casm/configuration/enumeration/ConfigEnumAllOccupations.hh"
+#include "casm/configuration/enumeration/ConfigEnumCanonicalOccupations.hh"
+#include "casm/configuration/enumeration/ConfigEnumMeshGrid.hh"
+#include "casm/configuration/enumeration/ConfigEnumOccupationsGrayCode.hh"
+#include "casm/configuration/enumeration/ConfigEnumRandomOccupations.hh"
+#include "casm/configuration/enumeration/ConfigEnumSubWedgeSampling.hh"
+#include "casm/configuration/enumeration/ConfigurationFilter.hh"
+#include "casm/configuration/enumeration/ConfigurationSink.hh"
+#include "casm/configuration/enumeration/EnumerationPipeline.hh"
+#include "casm/configuration/enumeration/ExternalConfigurationSet.hh"
 #include "casm/configuration/enumeration/MakeOccEventStructures.hh"
 #include "casm/configuration/enumeration/OccEventInfo.hh"
+#include "casm/configuration/enumeration/ScelEnum.hh"
+#include "casm/configuration/enumeration/SupercellOrbitSiteTable.hh"
+#include "casm/configuration/enumeration/count_occupations.hh"
+#include "casm/configuration/enumeration/parallel_enumeration.hh"
 #include "casm/configuration/enumeration/perturbations.hh"
 #include "casm/configuration/occ_events/OccSystem.hh"
 #include "casm/configuration/occ_events/orbits.hh"
@@ -43,8 +59,7 @@ std::vector<config::Configuration> make_all_distinct_periodic_perturbations(
     orbits.emplace_back(make_prim_periodic_orbit(
         cluster, prim->sym_info.unitcellcoord_symgroup_rep));
   }
-  auto orbits_as_indices = clust::make_orbits_as_indices(
-      orbits, supercell->unitcellcoord_index_converter);
+  config::SupercellOrbitSiteTable orbit_site_table(supercell, orbits);
 
   std::vector<std::vector<config::Configuration>> super_configurations =
       config::make_all_super_configurations_by_subsets(motif, supercell);
@@ -53,7 +68,7 @@ std::vector<config::Configuration> make_all_distinct_periodic_perturbations(
   for (auto const &equiv_configurations : super_configurations) {
     auto const &configuration = equiv_configurations[0];
     auto distinct_cluster_sites =
-        config::make_distinct_cluster_sites(configuration, orbits_as_indices);
+        config::make_distinct_cluster_sites(configuration, orbit_site_table);
     std::set<config::Configuration> perturbations =
         config::make_distinct_perturbations(configuration,
                                             distinct_cluster_sites);
@@ -63,10 +78,35 @@ std::vector<config::Configuration> make_all_distinct_periodic_perturbations(
   return std::vector<config::Configuration>(all.begin(), all.end());
 }
 
+Index for_each_distinct_periodic_perturbation(
+    std::shared_ptr<config::Supercell const> const &supercell,
+    config::Configuration const &motif,
+    std::vector<clust::IntegralCluster> const &clusters,
+    std::function<void(config::Configuration const &)> f,
+    std::optional<std::string> spill_dir, Index max_size_in_memory) {
+  auto const &prim = supercell->prim;
+  std::vector<std::set<clust::IntegralCluster>> orbits;
+  for (auto const &cluster : clusters) {
+    orbits.emplace_back(make_prim_periodic_orbit(
+        cluster, prim->sym_info.unitcellcoord_symgroup_rep));
+  }
+  config::SupercellOrbitSiteTable orbit_site_table(supercell, orbits);
+
+  std::optional<fs::path> _spill_dir;
+  if (spill_dir.has_value()) {
+    _spill_dir = fs::path(*spill_dir);
+  }
+  config::ExternalConfigurationSet distinct(supercell, _spill_dir,
+                                            max_size_in_memory);
+  return config::for_each_distinct_periodic_perturbation(
+      motif, orbit_site_table, f, distinct);
+}
+
 std::vector<config::Configuration> make_all_distinct_local_perturbations(
     std::shared_ptr<config::Supercell const> const &supercell,
     occ_events::OccEvent const &occ_event, config::Configuration const &motif,
-    std::vector<clust::IntegralCluster> const &local_clusters) {
+    std::vector<clust::IntegralCluster> const &local_clusters,
+    Index n_threads) {
   std::set<clust::IntegralCluster> _local_clusters(local_clusters.begin(),
                                                    local_clusters.end());
 
@@ -74,7 +114,8 @@ std::vector<config::Configuration> make_all_distinct_local_perturbations(
       supercell->prim, occ_event);
   config::OccEventSupercellInfo f(event_prim_info, supercell);
   std::set<config::Configuration> all =
-      f.make_all_distinct_local_perturbations(motif, _local_clusters);
+      f.make_all_distinct_local_perturbations(motif, _local_clusters,
+                                              n_threads);
   return std::vector<config::Configuration>(all.begin(), all.end());
 }
 
@@ -130,7 +171,7 @@ std::vector<occ_events::OccEvent> make_phenomenal_occevent(
     occ_events::OccEvent prototype,
     std::vector<clust::IntegralCluster> const &phenomenal_clusters,
     std::vector<Index> const &equivalent_generating_op_indices,
-    config::Prim const &prim) {
+    std::shared_ptr<config::Prim const> const &prim) {
   clust::IntegralCluster prototype_cluster = make_cluster(prototype);
   prototype_cluster.sort();
 
@@ -150,10 +191,9 @@ std::vector<occ_events::OccEvent> make_phenomenal_occevent(
 
   // get symmetry reps - from config::Prim
   auto const &unitcellcoord_symgroup_rep =
-      prim.sym_info.unitcellcoord_symgroup_rep;
-  auto occevent_symgroup_rep = occ_events::make_occevent_symgroup_rep(
-      unitcellcoord_symgroup_rep, prim.sym_info.occ_symgroup_rep,
-      prim.sym_info.atom_position_symgroup_rep);
+      prim->sym_info.unitcellcoord_symgroup_rep;
+  auto const &occevent_symgroup_rep =
+      *config::make_shared_occevent_symgroup_rep(prim);
 
   // this will throw if there is an inconsistency between prototype,
   // equivalent_generating_op_indices, and phenomenal_clusters,
@@ -185,6 +225,108 @@ std::vector<occ_events::OccEvent> make_phenomenal_occevent(
   return phenomenal_occevent;
 }
 
+typedef config::BatchPrefetcher<std::vector<config::Configuration>>
+    ConfigurationBatchPrefetcher;
+
+/// ConfigEnumMeshGrid batch: (configurations, order parameters as rows,
+/// subwedge indices)
+typedef std::tuple<std::vector<config::Configuration>, Eigen::MatrixXd,
+                   std::vector<Index>>
+    MeshGridBatch;
+
+typedef config::BatchPrefetcher<MeshGridBatch> MeshGridBatchPrefetcher;
+
+/// \brief Make a prefetcher that calls `enumerator.next_batch` on a
+///     background thread
+template <typename EnumeratorType>
+std::unique_ptr<ConfigurationBatchPrefetcher>
+make_configuration_batch_prefetcher(EnumeratorType &enumerator,
+                                    Index batch_size, Index n_batches_ahead) {
+  return std::make_unique<ConfigurationBatchPrefetcher>(
+      [&enumerator, batch_size](std::vector<config::Configuration> &batch) {
+        if (!enumerator.is_valid()) {
+          return false;
+        }
+        batch = enumerator.next_batch(batch_size);
+        return true;
+      },
+      n_batches_ahead);
+}
+
+/// \brief Make a prefetcher that calls `enumerator.next_batch`, with
+///     DoFSpace coordinates and SubWedge indices, on a background thread
+template <typename EnumeratorType>
+std::unique_ptr<MeshGridBatchPrefetcher> make_meshgrid_batch_prefetcher(
+    EnumeratorType &enumerator, Index batch_size, Index n_batches_ahead) {
+  return std::make_unique<MeshGridBatchPrefetcher>(
+      [&enumerator, batch_size](MeshGridBatch &batch) {
+        if (!enumerator.is_valid()) {
+          return false;
+        }
+        Eigen::MatrixXd order_parameters;
+        std::vector<Index> subwedge_indices;
+        std::get<0>(batch) = enumerator.next_batch(
+            batch_size, order_parameters, subwedge_indices);
+        std::get<1>(batch) = order_parameters.transpose();
+        std::get<2>(batch) = std::move(subwedge_indices);
+        return true;
+      },
+      n_batches_ahead);
+}
+
+/// \brief Convert a sampling method name to SubWedgeSamplingMethod
+config::SubWedgeSamplingMethod make_subwedge_sampling_method(
+    std::string method) {
+  if (method == "sobol") {
+    return config::SubWedgeSamplingMethod::sobol;
+  } else if (method == "latin_hypercube") {
+    return config::SubWedgeSamplingMethod::latin_hypercube;
+  } else if (method == "uniform") {
+    return config::SubWedgeSamplingMethod::uniform;
+  }
+  throw std::runtime_error(
+      "Error in libcasm.enumerate: invalid sampling method \"" + method +
+      "\", expected one of \"sobol\", \"latin_hypercube\", or \"uniform\"");
+}
+
+/// \brief Bind a BatchPrefetcher as a Python iterator over batches
+///
+/// The GIL is released while waiting for a batch, and the background
+/// thread never acquires it.
+template <typename BatchType>
+void bind_batch_prefetcher(py::module &m, char const *name,
+                           char const *doc) {
+  typedef config::BatchPrefetcher<BatchType> PrefetcherType;
+  py::class_<PrefetcherType>(m, name, doc)
+      .def(
+          "__iter__",
+          [](PrefetcherType &self) -> PrefetcherType & { return self; },
+          py::return_value_policy::reference)
+      .def("__next__",
+           [](PrefetcherType &self) {
+             BatchType batch;
+             bool has_next;
+             {
+               py::gil_scoped_release release;
+               has_next = self.next(batch);
+             }
+             if (!has_next) {
+               throw py::stop_iteration();
+             }
+             return batch;
+           })
+      .def("n_batches_ahead", &PrefetcherType::n_batches_ahead,
+           "Return the maximum number of batches enumerated ahead.")
+      .def("stop", &PrefetcherType::stop,
+           py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+          Stop the background thread and discard batches not yet taken
+
+          Blocks until the batch in progress, if any, is complete. The
+          enumerator may be used again after `stop`, continuing after the
+          last batch enumerated, which may not have been taken.
+          )pbdoc");
+}
+
 }  // namespace CASMpy
 
 PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>);
@@ -203,11 +345,66 @@ PYBIND11_MODULE(_enumerate, m) {
     )pbdoc";
   py::module::import("libcasm.xtal");
   py::module::import("libcasm.configuration");
+  py::module::import("libcasm.irreps");
+
+  bind_batch_prefetcher<std::vector<config::Configuration>>(
+      m, "ConfigurationBatchPrefetcher", R"pbdoc(
+      Iterator over batches of configurations enumerated on a background
+      thread
+
+      Construct with the `prefetch` method of an enumerator. Each batch is a
+      list of configurations.
+      )pbdoc");
+
+  bind_batch_prefetcher<MeshGridBatch>(m, "MeshGridBatchPrefetcher", R"pbdoc(
+      Iterator over batches of mesh grid configurations enumerated on a
+      background thread
+
+      Construct with :func:`ConfigEnumMeshGridBase.prefetch`. Each batch is
+      a tuple of configurations, order parameters as rows, and SubWedge
+      indices.
+      )pbdoc");
 
   py::class_<config::ConfigEnumAllOccupations>(m,
                                                "ConfigEnumAllOccupationsBase")
       .def(py::init<config::Configuration const &, std::set<Index> const &>(),
            py::arg("background"), py::arg("sites"))
+      .def(py::init([](config::Configuration const &background,
+                       std::set<Index> const &sites, bool skip_non_primitive,
+                       std::optional<std::vector<config::SupercellSymOp>>
+                           canonical_subgroup,
+                       Index shard_index, Index n_shards) {
+             return std::make_unique<config::ConfigEnumAllOccupations>(
+                 background, sites, skip_non_primitive,
+                 std::move(canonical_subgroup), nullptr, shard_index,
+                 n_shards);
+           }),
+           py::arg("background"), py::arg("sites"),
+           py::arg("skip_non_primitive"), py::arg("canonical_subgroup"),
+           py::arg("shard_index") = 0, py::arg("n_shards") = 1,
+           R"pbdoc(
+          Construct an enumerator that skips filtered configurations
+
+          Parameters
+          ----------
+          background: libcasm.configuration.Configuration
+              The background configuration.
+          sites: set[int]
+              The linear site indices on which occupations are enumerated.
+          skip_non_primitive: bool
+              If True, skip non-primitive configurations.
+          canonical_subgroup: Optional[list[libcasm.configuration.SupercellSymOp]]
+              If not None, skip configurations that are not canonical with
+              respect to this group.
+          shard_index: int = 0
+              If `n_shards` > 1, only enumerate values in shard `shard_index`,
+              in the range `[0, n_shards)`.
+          n_shards: int = 1
+              Split the occupation counter range into `n_shards` contiguous
+              ranges, so that enumeration may be split across processes.
+              Taken in order of `shard_index`, the shards enumerate the same
+              configurations, in the same order, as a single enumerator.
+          )pbdoc")
       .def("value", &config::ConfigEnumAllOccupations::value, R"pbdoc(
           Get the current Configuration
 
@@ -227,13 +424,1384 @@ PYBIND11_MODULE(_enumerate, m) {
           -------
           is_valid: bool
               True if `value` is valid, False if no more valid values
+          )pbdoc")
+      .def(
+          "prefetch",
+          [](config::ConfigEnumAllOccupations &self, Index batch_size,
+             Index n_batches_ahead) {
+            return make_configuration_batch_prefetcher(self, batch_size,
+                                                       n_batches_ahead);
+          },
+          py::arg("batch_size") = 1000, py::arg("n_batches_ahead") = 2,
+          py::keep_alive<0, 1>(), R"pbdoc(
+          Enumerate batches on a background thread, ahead of the consumer
+
+          A C++ thread, which never holds the GIL, calls
+          :func:`next_batch` and stays up to `n_batches_ahead` batches
+          ahead, so that Python work on one batch overlaps with enumerating
+          the following batches. The enumerator must not be used directly
+          until the prefetcher is complete or stopped.
+
+          Parameters
+          ----------
+          batch_size: int = 1000
+              The maximum number of configurations per batch.
+          n_batches_ahead: int = 2
+              The maximum number of batches enumerated but not yet taken.
+
+          Returns
+          -------
+          prefetcher: ConfigurationBatchPrefetcher
+              An iterator over the batches, in enumeration order, each as
+              returned by :func:`next_batch`.
+          )pbdoc")
+      .def("next_batch", &config::ConfigEnumAllOccupations::next_batch,
+           py::arg("max_size"), R"pbdoc(
+          Return up to `max_size` configurations and advance past them
+
+          Parameters
+          ----------
+          max_size: int
+              The maximum number of configurations to return. Fewer are
+              returned only if the enumeration is complete.
+
+          Returns
+          -------
+          configurations: list[libcasm.configuration.Configuration]
+              Copies of the configurations, starting with the current value.
+          )pbdoc")
+      .def("state", &config::ConfigEnumAllOccupations::state, R"pbdoc(
+          Return the occupation on `sites` of the current value
+
+          The state may be saved and passed to :func:`resume` of an
+          enumerator constructed with the same arguments, to resume the
+          enumeration. Only valid if :func:`is_valid` is True.
+
+          Returns
+          -------
+          state: list[int]
+              The occupation indices on `sites`, in increasing site index
+              order.
+          )pbdoc")
+      .def("resume", &config::ConfigEnumAllOccupations::resume,
+           py::arg("state"), R"pbdoc(
+          Set the current value to a previously saved state
+
+          Parameters
+          ----------
+          state: list[int]
+              A value returned by :func:`state` of an enumerator constructed
+              with the same arguments. It must not precede the current value.
+              Raises if `state` is not a value of the enumeration.
+          )pbdoc");
+
+  py::class_<config::ConfigurationSink,
+             std::shared_ptr<config::ConfigurationSink>>(m, "ConfigurationSink",
+                                                         R"pbdoc(
+      Receives enumerated configurations, to store or write them, without
+      constructing Python objects
+
+      Use with :func:`run_occupation_pipeline`.
+      )pbdoc")
+      .def("size", &config::ConfigurationSink::size, R"pbdoc(
+          Return the number of configurations stored or written
+          )pbdoc")
+      .def("finish", &config::ConfigurationSink::finish, R"pbdoc(
+          Complete storing or writing configurations
+
+          Called by :func:`run_occupation_pipeline` after the last
+          configuration.
+          )pbdoc");
+
+  py::class_<config::ConfigurationSetSink, config::ConfigurationSink,
+             std::shared_ptr<config::ConfigurationSetSink>>(
+      m, "ConfigurationSetSink", R"pbdoc(
+      Insert configurations into a ConfigurationSet
+
+      Configurations already in the set are skipped, and
+      `configuration_id` is set automatically.
+      )pbdoc")
+      .def(py::init<config::ConfigurationSet &>(), py::arg("configurations"),
+           py::keep_alive<1, 2>(), R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          configurations: libcasm.configuration.ConfigurationSet
+              The set configurations are inserted into.
+          )pbdoc");
+
+  py::class_<config::JsonLinesConfigurationSink, config::ConfigurationSink,
+             std::shared_ptr<config::JsonLinesConfigurationSink>>(
+      m, "JsonLinesConfigurationSink", R"pbdoc(
+      Write configurations to a file in JSON Lines format
+
+      Each line is ``{"supercell_name": ..., "configuration_id": ...,
+      "dof": ...}``. `configuration_id` is set automatically, counting up for
+      each supercell, and configurations are not checked for duplicates, so
+      the enumeration should give distinct configurations.
+      )pbdoc")
+      .def(py::init([](std::string path, bool write_prim_basis,
+                       std::map<std::string, Index> next_config_id) {
+             return std::make_shared<config::JsonLinesConfigurationSink>(
+                 path, write_prim_basis, next_config_id);
+           }),
+           py::arg("path"), py::arg("write_prim_basis") = false,
+           py::arg("next_config_id") = std::map<std::string, Index>(),
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          path: str
+              The file to write. Existing contents are replaced.
+          write_prim_basis: bool = False
+              If True, write DoF values using the prim basis. Default
+              (False) is to write DoF values in the standard basis.
+          next_config_id: dict[str, int] = {}
+              The `configuration_id` of the first configuration written in
+              each supercell. Supercells not included start at 0.
+          )pbdoc")
+      .def("next_config_id",
+           &config::JsonLinesConfigurationSink::next_config_id, R"pbdoc(
+          Return the `configuration_id` of the next configuration written,
+          by supercell name
+          )pbdoc");
+
+  py::class_<config::BinaryConfigurationSink, config::ConfigurationSink,
+             std::shared_ptr<config::BinaryConfigurationSink>>(
+      m, "BinaryConfigurationSink", R"pbdoc(
+      Write configurations to a file in binary columnar format
+
+      The file is completed when the enumeration finishes. `configuration_id`
+      is set automatically, as for :class:`JsonLinesConfigurationSink`.
+      )pbdoc")
+      .def(py::init([](std::string path, bool compress, Index chunk_size,
+                       std::map<std::string, Index> next_config_id) {
+             return std::make_shared<config::BinaryConfigurationSink>(
+                 path, compress, chunk_size, next_config_id);
+           }),
+           py::arg("path"), py::arg("compress") = true,
+           py::arg("chunk_size") = 1024,
+           py::arg("next_config_id") = std::map<std::string, Index>(),
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          path: str
+              The file to write.
+          compress: bool = True
+              If True, compress each block with zlib.
+          chunk_size: int = 1024
+              Number of configurations per chunk block.
+          next_config_id: dict[str, int] = {}
+              The `configuration_id` of the first configuration written in
+              each supercell. Supercells not included start at 0.
+          )pbdoc")
+      .def("next_config_id", &config::BinaryConfigurationSink::next_config_id,
+           R"pbdoc(
+          Return the `configuration_id` of the next configuration written,
+          by supercell name
+          )pbdoc");
+
+  py::class_<config::ConfigurationFilter,
+             std::shared_ptr<config::ConfigurationFilter>>(
+      m, "ConfigurationFilter", R"pbdoc(
+      Base class for configuration filters evaluated in C++
+
+      Use with :func:`run_occupation_pipeline` to filter configurations
+      without calling Python for each configuration.
+      )pbdoc")
+      .def(
+          "__call__",
+          [](config::ConfigurationFilter const &f,
+             config::Configuration const &configuration) {
+            return f(configuration);
+          },
+          py::arg("configuration"),
+          "Return True if the configuration is accepted, False otherwise.");
+
+  py::class_<config::SupercellVolumeFilter, config::ConfigurationFilter,
+             std::shared_ptr<config::SupercellVolumeFilter>>(
+      m, "SupercellVolumeFilter", R"pbdoc(
+      Accepts configurations with a supercell volume, as a number of unit
+      cells, in a range
+      )pbdoc")
+      .def(py::init([](Index min_volume, std::optional<Index> max_volume) {
+             auto f = std::make_shared<config::SupercellVolumeFilter>();
+             f->min_volume = min_volume;
+             if (max_volume.has_value()) {
+               f->max_volume = *max_volume;
+             }
+             return f;
+           }),
+           py::arg("min_volume") = 1, py::arg("max_volume") = std::nullopt,
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          min_volume: int = 1
+              The minimum allowed volume.
+          max_volume: Optional[int] = None
+              The maximum allowed volume. If None, there is no maximum.
+          )pbdoc")
+      .def_readwrite("min_volume", &config::SupercellVolumeFilter::min_volume,
+                     "int: The minimum allowed volume.")
+      .def_readwrite("max_volume", &config::SupercellVolumeFilter::max_volume,
+                     "int: The maximum allowed volume.");
+
+  py::class_<config::SublatticeCompositionFilter, config::ConfigurationFilter,
+             std::shared_ptr<config::SublatticeCompositionFilter>>(
+      m, "SublatticeCompositionFilter", R"pbdoc(
+      Accepts configurations with the fraction of sites on a group of
+      sublattices occupied by one occupant in a range
+
+      The fraction is the number of sites, on the selected sublattices,
+      occupied by `occupant_name`, divided by the number of sites on those
+      sublattices. Bounds are inclusive.
+      )pbdoc")
+      .def(py::init([](std::string occupant_name,
+                       std::set<Index> sublattice_indices, double min_fraction,
+                       double max_fraction) {
+             auto f = std::make_shared<config::SublatticeCompositionFilter>();
+             f->occupant_name = occupant_name;
+             f->sublattice_indices = sublattice_indices;
+             f->min_fraction = min_fraction;
+             f->max_fraction = max_fraction;
+             return f;
+           }),
+           py::arg("occupant_name"),
+           py::arg("sublattice_indices") = std::set<Index>(),
+           py::arg("min_fraction") = 0.0, py::arg("max_fraction") = 1.0,
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          occupant_name: str
+              The name of the occupant being counted.
+          sublattice_indices: set[int] = set()
+              The sublattices on which the occupant is counted. If empty,
+              all sublattices are used.
+          min_fraction: float = 0.0
+              The minimum allowed fraction.
+          max_fraction: float = 1.0
+              The maximum allowed fraction.
+          )pbdoc")
+      .def_readwrite("occupant_name",
+                     &config::SublatticeCompositionFilter::occupant_name,
+                     "str: The name of the occupant being counted.")
+      .def_readwrite("sublattice_indices",
+                     &config::SublatticeCompositionFilter::sublattice_indices,
+                     "set[int]: The sublattices on which the occupant is "
+                     "counted.")
+      .def_readwrite("min_fraction",
+                     &config::SublatticeCompositionFilter::min_fraction,
+                     "float: The minimum allowed fraction.")
+      .def_readwrite("max_fraction",
+                     &config::SublatticeCompositionFilter::max_fraction,
+                     "float: The maximum allowed fraction.");
+
+  py::class_<config::OccupantCountFilter, config::ConfigurationFilter,
+             std::shared_ptr<config::OccupantCountFilter>>(
+      m, "OccupantCountFilter", R"pbdoc(
+      Accepts configurations, in one supercell, satisfying occupant count
+      constraints
+      )pbdoc")
+      .def(py::init<std::shared_ptr<config::Supercell const> const &,
+                    std::vector<config::OccupantCountConstraint> const &>(),
+           py::arg("supercell"), py::arg("constraints"), R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          supercell: libcasm.configuration.Supercell
+              The supercell of the constraint site indices. An exception is
+              raised if the filter is called with a configuration in another
+              supercell.
+          constraints: list[OccupantCountConstraint]
+              The constraints, all of which must be satisfied.
+          )pbdoc")
+      .def("constraints", &config::OccupantCountFilter::constraints,
+           "Return the constraints.");
+
+  py::class_<config::ClusterCountFilter, config::ConfigurationFilter,
+             std::shared_ptr<config::ClusterCountFilter>>(
+      m, "ClusterCountFilter", R"pbdoc(
+      Accepts configurations with the number of clusters of an orbit, per
+      unit cell, fully occupied by one occupant in a range
+
+      Clusters are counted as sets of supercell sites, so in small
+      supercells periodic images that map onto the same sites are counted
+      once. The cluster sites are found once per supercell.
+      )pbdoc")
+      .def(py::init([](std::vector<clust::IntegralCluster> const &orbit,
+                       std::string occupant_name, double min_per_unitcell,
+                       std::optional<double> max_per_unitcell) {
+             return std::make_shared<config::ClusterCountFilter>(
+                 std::set<clust::IntegralCluster>(orbit.begin(), orbit.end()),
+                 occupant_name, min_per_unitcell,
+                 max_per_unitcell.value_or(
+                     std::numeric_limits<double>::max()));
+           }),
+           py::arg("orbit"), py::arg("occupant_name"),
+           py::arg("min_per_unitcell") = 0.0,
+           py::arg("max_per_unitcell") = std::nullopt, R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          orbit: list[libcasm.clusterography.Cluster]
+              A prim periodic orbit of clusters.
+          occupant_name: str
+              The name of the occupant that must occupy every site of a
+              cluster for it to count.
+          min_per_unitcell: float = 0.0
+              The minimum allowed number of clusters per unit cell.
+          max_per_unitcell: Optional[float] = None
+              The maximum allowed number of clusters per unit cell. If None,
+              there is no maximum.
+          )pbdoc")
+      .def("occupant_name", &config::ClusterCountFilter::occupant_name,
+           "Return the name of the occupant.")
+      .def("min_per_unitcell", &config::ClusterCountFilter::min_per_unitcell,
+           "Return the minimum allowed number of clusters per unit cell.")
+      .def("max_per_unitcell", &config::ClusterCountFilter::max_per_unitcell,
+           "Return the maximum allowed number of clusters per unit cell.");
+
+  m.def(
+      "run_occupation_pipeline",
+      [](config::ConfigEnumAllOccupations &enumerator,
+         config::ConfigurationSink &sink, std::optional<py::function> filter,
+         bool canonicalize, bool skip_non_primitive, bool skip_non_canonical,
+         std::vector<config::OccupantCountConstraint> const
+             &occupant_count_constraints,
+         std::vector<std::shared_ptr<config::ConfigurationFilter>> const
+             &filters,
+         Index batch_size, Index queue_capacity, Index n_transform_threads,
+         Index n_filter_threads) {
+        // C++ predicates first, so the Python filter is called only for
+        // configurations they accept
+        std::vector<config::ConfigurationPredicate> predicates;
+        if (!occupant_count_constraints.empty()) {
+          predicates.push_back(config::make_occupant_count_predicate(
+              enumerator.value().supercell, occupant_count_constraints));
+        }
+        if (skip_non_primitive) {
+          predicates.push_back(config::make_is_primitive_predicate());
+        }
+        if (skip_non_canonical) {
+          predicates.push_back(config::make_is_canonical_predicate());
+        }
+        for (auto const &f : filters) {
+          predicates.push_back(config::make_filter_predicate(f));
+        }
+        if (filter.has_value()) {
+          // the Python function must be called and released holding the GIL
+          std::shared_ptr<py::function> f(new py::function(*filter),
+                                          [](py::function *ptr) {
+                                            py::gil_scoped_acquire acquire;
+                                            delete ptr;
+                                          });
+          predicates.push_back(
+              [=](config::Configuration const &configuration) {
+                py::gil_scoped_acquire acquire;
+                return (*f)(configuration).cast<bool>();
+              });
+        }
+        config::ConfigurationPredicate _filter;
+        if (!predicates.empty()) {
+          _filter = config::make_all_of_predicate(predicates);
+        }
+        config::ConfigurationTransform transform;
+        if (canonicalize) {
+          transform = config::make_canonical_form_transform();
+        }
+        config::EnumerationPipelineOptions options;
+        options.batch_size = batch_size;
+        options.queue_capacity = queue_capacity;
+        options.n_transform_threads = n_transform_threads;
+        options.n_filter_threads = n_filter_threads;
+
+        config::EnumerationPipelineStats stats;
+        {
+          py::gil_scoped_release release;
+          stats = config::run_enumeration_pipeline(
+              config::make_enumeration_source(enumerator), transform,
+              _filter, sink, options);
+        }
+        py::dict result;
+        result["n_enumerated"] = stats.n_enumerated;
+        result["n_accepted"] = stats.n_accepted;
+        result["n_batches"] = stats.n_batches;
+        return result;
+      },
+      py::arg("enumerator"), py::arg("sink"),
+      py::arg("filter") = std::nullopt, py::arg("canonicalize") = true,
+      py::arg("skip_non_primitive") = false,
+      py::arg("skip_non_canonical") = false,
+      py::arg("occupant_count_constraints") =
+          std::vector<config::OccupantCountConstraint>(),
+      py::arg("filters") =
+          std::vector<std::shared_ptr<config::ConfigurationFilter>>(),
+      py::arg("batch_size") = 1000, py::arg("queue_capacity") = 4,
+      py::arg("n_transform_threads") = 0, py::arg("n_filter_threads") = 1,
+      R"pbdoc(
+      Enumerate occupations, make canonical forms, filter, and store or write
+      the accepted configurations, with the stages running concurrently
+
+      Batches of configurations are passed between the enumerate,
+      canonicalize, filter, and sink stages through bounded queues, so
+      making canonical forms, filtering, and storing or writing overlap. No
+      Python objects are constructed for configurations unless `filter` is
+      given. The GIL is released while running, and acquired only to call
+      `filter`, so a Python filter runs one call at a time while the other
+      stages continue. Configurations reach `sink` in enumeration order, so
+      `configuration_id` are the same as inserting them one at a time,
+      independent of the number of threads.
+
+      Parameters
+      ----------
+      enumerator: ConfigEnumAllOccupationsBase
+          The enumerator. Enumeration starts at the current value and
+          continues until complete.
+      sink: ConfigurationSink
+          Receives the accepted configurations, for example a
+          :class:`ConfigurationSetSink`, :class:`JsonLinesConfigurationSink`, or
+          :class:`BinaryConfigurationSink`. Its `finish` method is called
+          when the enumeration is complete.
+      filter: Optional[Callable[[libcasm.configuration.Configuration], bool]] = None
+          If not None, only configurations for which `filter` returns True
+          are accepted. It is called with the canonical form if
+          `canonicalize` is True, and only for configurations accepted by
+          the other filters.
+      canonicalize: bool = True
+          If True, pass the canonical form of each configuration in its
+          supercell to the filters and sink.
+      skip_non_primitive: bool = False
+          If True, skip non-primitive configurations, checked in C++.
+      skip_non_canonical: bool = False
+          If True, skip configurations that are not canonical in their
+          supercell, checked in C++. Has no effect if `canonicalize` is
+          True.
+      occupant_count_constraints: list[OccupantCountConstraint] = []
+          If not empty, skip configurations that do not satisfy all
+          constraints, checked in C++. Site indices are in the supercell of
+          `enumerator`.
+      filters: list[ConfigurationFilter] = []
+          If not empty, skip configurations not accepted by all filters,
+          checked in C++ in order, after the other C++ checks and before
+          `filter`. Filters must be safe to call from multiple threads,
+          which is true for the filters provided by this module.
+      batch_size: int = 1000
+          Number of configurations passed between stages at once.
+      queue_capacity: int = 4
+          Maximum number of batches waiting between stages.
+      n_transform_threads: int = 0
+          Number of threads making canonical forms. If <= 0, the default
+          number of threads is used.
+      n_filter_threads: int = 1
+          Number of threads filtering. If <= 0, the default number of
+          threads is used.
+
+      Returns
+      -------
+      stats: dict
+          The number of configurations enumerated, `"n_enumerated"`, and
+          accepted by the filters, `"n_accepted"`, and the number of
+          batches, `"n_batches"`.
+      )pbdoc");
+
+  py::class_<config::ScelEnum>(m, "ScelEnumBase", R"pbdoc(
+      Enumerate symmetrically distinct supercells, by volume
+
+      Hermite normal form transformation matrices are enumerated for each
+      volume and rejected using only the prim point group action on the
+      matrix, so :class:`~libcasm.configuration.Supercell` are only
+      constructed for distinct supercells, when :func:`value` is called.
+      )pbdoc")
+      .def(py::init([](std::shared_ptr<config::Prim const> const &prim,
+                       Index max_volume, Index min_volume, std::string dirs,
+                       std::optional<Eigen::Matrix3l> unit_cell,
+                       bool diagonal_only, bool fixed_shape, Index shard_index,
+                       Index n_shards) {
+             return std::make_unique<config::ScelEnum>(
+                 prim, min_volume, max_volume, dirs, unit_cell, diagonal_only,
+                 fixed_shape, shard_index, n_shards);
+           }),
+           py::arg("prim"), py::arg("max_volume"), py::arg("min_volume") = 1,
+           py::arg("dirs") = "abc", py::arg("unit_cell") = std::nullopt,
+           py::arg("diagonal_only") = false, py::arg("fixed_shape") = false,
+           py::arg("shard_index") = 0, py::arg("n_shards") = 1,
+           R"pbdoc(
+          Constructor
+
+          Parameters are as for :func:`libcasm.enumerate.ScelEnum.by_volume`.
+          )pbdoc")
+      .def("value", &config::ScelEnum::value, R"pbdoc(
+          Get the current canonical Supercell, constructed on first call
+
+          Returns
+          -------
+          supercell: libcasm.configuration.Supercell
+              The current supercell, in canonical form
+          )pbdoc")
+      .def("transformation_matrix_to_super",
+           &config::ScelEnum::transformation_matrix_to_super, R"pbdoc(
+          Get the transformation matrix from the prim lattice to the current
+          canonical supercell lattice
+
+          Returns
+          -------
+          T: numpy.ndarray[numpy.int64[3, 3]]
+              The transformation matrix
+          )pbdoc")
+      .def("volume", &config::ScelEnum::volume, R"pbdoc(
+          Get the current volume, relative to the unit cell
+          )pbdoc")
+      .def("advance", &config::ScelEnum::advance, R"pbdoc(
+          Generate the next distinct supercell
+          )pbdoc",
+           py::call_guard<py::gil_scoped_release>())
+      .def("is_valid", &config::ScelEnum::is_valid, R"pbdoc(
+          Return True if `value` is valid, False if no more valid values
+          )pbdoc");
+
+  py::class_<config::ConfigEnumOccupationsGrayCode>(
+      m, "ConfigEnumOccupationsGrayCodeBase", R"pbdoc(
+      Enumerate all occupations on sites in Gray code order, changing the
+      occupant on exactly one site per step
+      )pbdoc")
+      .def(py::init<config::Configuration const &, std::set<Index> const &>(),
+           py::arg("background"), py::arg("sites"))
+      .def("value", &config::ConfigEnumOccupationsGrayCode::value, R"pbdoc(
+          Get the current Configuration
+
+          Returns
+          -------
+          config: libcasm.configuration.Configuration
+              A const reference to the current Configuration
+          )pbdoc",
+           py::return_value_policy::reference_internal)
+      .def("advance", &config::ConfigEnumOccupationsGrayCode::advance,
+           R"pbdoc(
+          Generate the next Configuration, by changing one site
+          )pbdoc")
+      .def("is_valid", &config::ConfigEnumOccupationsGrayCode::is_valid,
+           R"pbdoc(
+          Return True if `value` is valid, False if no more valid values
+          )pbdoc")
+      .def(
+          "last_change",
+          [](config::ConfigEnumOccupationsGrayCode const &self) {
+            config::OccupationDelta const &delta = self.last_change();
+            return std::make_tuple(delta.site_index, delta.old_value,
+                                   delta.new_value);
+          },
+          R"pbdoc(
+          The change made by the last `advance`
+
+          Returns
+          -------
+          change: tuple[int, int, int]
+              The linear site index, old occupant index, and new occupant
+              index. The site index is -1 before the first `advance` and
+              after the enumeration is complete.
+          )pbdoc");
+
+  py::class_<config::OccupantCountConstraint>(m, "OccupantCountConstraint",
+                                              R"pbdoc(
+      Bounds on the number of sites, amongst a set of sites, with a
+      particular occupant
+      )pbdoc")
+      .def(py::init([](std::string occupant_name, std::set<Index> site_indices,
+                       std::optional<Index> min_count,
+                       std::optional<Index> max_count) {
+             config::OccupantCountConstraint constraint;
+             constraint.occupant_name = occupant_name;
+             constraint.site_indices = site_indices;
+             if (min_count.has_value()) {
+               constraint.min_count = *min_count;
+             }
+             if (max_count.has_value()) {
+               constraint.max_count = *max_count;
+             }
+             return constraint;
+           }),
+           py::arg("occupant_name"), py::arg("site_indices"),
+           py::arg("min_count") = std::nullopt,
+           py::arg("max_count") = std::nullopt, R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          occupant_name: str
+              The name of the occupant being counted.
+          site_indices: set[int]
+              The linear site indices on which the occupant is counted.
+          min_count: Optional[int] = None
+              The minimum allowed count. If None, there is no minimum.
+          max_count: Optional[int] = None
+              The maximum allowed count. If None, there is no maximum.
+          )pbdoc")
+      .def_readwrite("occupant_name",
+                     &config::OccupantCountConstraint::occupant_name,
+                     "str: The name of the occupant being counted.")
+      .def_readwrite("site_indices",
+                     &config::OccupantCountConstraint::site_indices,
+                     "set[int]: The linear site indices on which the "
+                     "occupant is counted.")
+      .def_readwrite("min_count", &config::OccupantCountConstraint::min_count,
+                     "int: The minimum allowed count.")
+      .def_readwrite("max_count", &config::OccupantCountConstraint::max_count,
+                     "int: The maximum allowed count.");
+
+  py::class_<config::ConfigEnumCanonicalOccupations>(
+      m, "ConfigEnumCanonicalOccupationsBase", R"pbdoc(
+      Enumerate occupations on sites which are canonical with respect to a
+      group, pruning partial occupations that cannot be canonical
+      )pbdoc")
+      .def(py::init<config::Configuration const &, std::set<Index> const &,
+                    std::vector<config::SupercellSymOp> const &, bool,
+                    std::vector<config::OccupantCountConstraint> const &>(),
+           py::arg("background"), py::arg("sites"), py::arg("group"),
+           py::arg("skip_non_primitive") = false,
+           py::arg("occupant_count_constraints") =
+               std::vector<config::OccupantCountConstraint>(),
+           R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          background: libcasm.configuration.Configuration
+              The background configuration.
+          sites: set[int]
+              The linear site indices on which occupations are enumerated.
+          group: list[libcasm.configuration.SupercellSymOp]
+              Only configurations which are canonical with respect to this
+              group are enumerated.
+          skip_non_primitive: bool = False
+              If True, skip non-primitive configurations.
+          occupant_count_constraints: list[OccupantCountConstraint] = []
+              If not empty, only occupations satisfying all constraints are
+              enumerated. If `group` is empty, all occupations satisfying
+              the constraints are enumerated.
+          )pbdoc")
+      .def("value", &config::ConfigEnumCanonicalOccupations::value, R"pbdoc(
+          Get the current Configuration
+
+          Returns
+          -------
+          config: libcasm.configuration.Configuration
+              A const reference to the current Configuration
+          )pbdoc",
+           py::return_value_policy::reference_internal)
+      .def("advance", &config::ConfigEnumCanonicalOccupations::advance,
+           R"pbdoc(
+          Generate the next Configuration
+          )pbdoc")
+      .def("is_valid", &config::ConfigEnumCanonicalOccupations::is_valid,
+           R"pbdoc(
+          Return True if `value` is valid, False if no more valid values
+
+          Returns
+          -------
+          is_valid: bool
+              True if `value` is valid, False if no more valid values
+          )pbdoc")
+      .def(
+          "prefetch",
+          [](config::ConfigEnumCanonicalOccupations &self, Index batch_size,
+             Index n_batches_ahead) {
+            return make_configuration_batch_prefetcher(self, batch_size,
+                                                       n_batches_ahead);
+          },
+          py::arg("batch_size") = 1000, py::arg("n_batches_ahead") = 2,
+          py::keep_alive<0, 1>(), R"pbdoc(
+          Enumerate batches on a background thread, ahead of the consumer
+
+          A C++ thread, which never holds the GIL, calls
+          :func:`next_batch` and stays up to `n_batches_ahead` batches
+          ahead, so that Python work on one batch overlaps with enumerating
+          the following batches. The enumerator must not be used directly
+          until the prefetcher is complete or stopped.
+
+          Parameters
+          ----------
+          batch_size: int = 1000
+              The maximum number of configurations per batch.
+          n_batches_ahead: int = 2
+              The maximum number of batches enumerated but not yet taken.
+
+          Returns
+          -------
+          prefetcher: ConfigurationBatchPrefetcher
+              An iterator over the batches, in enumeration order, each as
+              returned by :func:`next_batch`.
+          )pbdoc")
+      .def("next_batch", &config::ConfigEnumCanonicalOccupations::next_batch,
+           py::arg("max_size"), R"pbdoc(
+          Return up to `max_size` configurations and advance past them
+
+          Parameters
+          ----------
+          max_size: int
+              The maximum number of configurations to return. Fewer are
+              returned only if the enumeration is complete.
+
+          Returns
+          -------
+          configurations: list[libcasm.configuration.Configuration]
+              Copies of the configurations, starting with the current value.
+          )pbdoc")
+      .def("state", &config::ConfigEnumCanonicalOccupations::state, R"pbdoc(
+          Return the occupation on `sites` of the current value
+
+          The state may be saved and passed to :func:`resume` of an
+          enumerator constructed with the same arguments, to resume the
+          enumeration. Only valid if :func:`is_valid` is True.
+
+          Returns
+          -------
+          state: list[int]
+              The occupation indices on `sites`, in increasing site index
+              order.
+          )pbdoc")
+      .def("resume", &config::ConfigEnumCanonicalOccupations::resume,
+           py::arg("state"), R"pbdoc(
+          Set the current value to a previously saved state
+
+          Parameters
+          ----------
+          state: list[int]
+              A value returned by :func:`state` of an enumerator constructed
+              with the same arguments. Raises if `state` is not a
+              value of the enumeration.
+          )pbdoc");
+
+  py::class_<config::ConfigEnumMeshGrid>(m, "ConfigEnumMeshGridBase")
+      .def(py::init<config::Configuration const &,
+                    clexulator::DoFSpace const &,
+                    std::vector<Eigen::VectorXd> const &>(),
+           py::arg("background"), py::arg("dof_space"), py::arg("xi"),
+           R"pbdoc(
+          Construct an enumerator on a mesh grid of DoFSpace coordinates
+
+          Parameters
+          ----------
+          background: libcasm.configuration.Configuration
+              The background configuration.
+          dof_space: libcasm.clexulator.DoFSpace
+              The DoFSpace. Not supported for ``dof_space.dof_key == "occ"``.
+          xi: list[numpy.ndarray]
+              The grid coordinates along each `dof_space` basis vector.
+          )pbdoc")
+      .def(py::init<config::Configuration const &,
+                    clexulator::DoFSpace const &,
+                    std::vector<irreps::SubWedge> const &, double, Index,
+                    bool, double>(),
+           py::arg("background"), py::arg("dof_space"),
+           py::arg("irreducible_wedge"), py::arg("stop"), py::arg("num"),
+           py::arg("trim_corners") = true, py::arg("abs_tol") = CASM::TOL,
+           R"pbdoc(
+          Construct an enumerator on a mesh grid in each SubWedge of an
+          irreducible wedge
+
+          Parameters
+          ----------
+          background: libcasm.configuration.Configuration
+              The background configuration.
+          dof_space: libcasm.clexulator.DoFSpace
+              The DoFSpace. Not supported for ``dof_space.dof_key == "occ"``.
+          irreducible_wedge: list[libcasm.irreps.SubWedge]
+              The irreducible wedge.
+          stop: float
+              The ending value of the sequence of grid points along each
+              SubWedge axis. Must be positive.
+          num: int
+              Number of grid points along each SubWedge axis. Must be
+              positive.
+          trim_corners: bool = True
+              If True, skip grid points that lie outside the ellipsoid
+              inscribed within the extrema of the grid.
+          abs_tol: float = :data:`~libcasm.casmglobal.TOL`
+              The absolute tolerance used to trim corners.
+          )pbdoc")
+      .def("value", &config::ConfigEnumMeshGrid::value, R"pbdoc(
+          Get the current Configuration
+
+          Returns
+          -------
+          config: libcasm.configuration.Configuration
+              A const reference to the current Configuration
+          )pbdoc",
+           py::return_value_policy::reference_internal)
+      .def("order_parameters", &config::ConfigEnumMeshGrid::order_parameters,
+           R"pbdoc(
+          Get the DoFSpace coordinates of the current Configuration
+          )pbdoc")
+      .def("subwedge_index", &config::ConfigEnumMeshGrid::subwedge_index,
+           R"pbdoc(
+          Get the index of the SubWedge of the current Configuration
+          )pbdoc")
+      .def("advance", &config::ConfigEnumMeshGrid::advance, R"pbdoc(
+          Generate the next Configuration
+          )pbdoc")
+      .def("is_valid", &config::ConfigEnumMeshGrid::is_valid, R"pbdoc(
+          Return True if `value` is valid, False if no more valid values
+
+          Returns
+          -------
+          is_valid: bool
+              True if `value` is valid, False if no more valid values
+          )pbdoc")
+      .def(
+          "next_batch",
+          [](config::ConfigEnumMeshGrid &self, Index max_size) {
+            Eigen::MatrixXd order_parameters;
+            std::vector<Index> subwedge_indices;
+            std::vector<config::Configuration> configurations =
+                self.next_batch(max_size, order_parameters, subwedge_indices);
+            Eigen::MatrixXd order_parameters_rows =
+                order_parameters.transpose();
+            return std::make_tuple(configurations, order_parameters_rows,
+                                   subwedge_indices);
+          },
+          py::arg("max_size"), R"pbdoc(
+          Return up to `max_size` configurations and advance past them
+
+          Parameters
+          ----------
+          max_size: int
+              The maximum number of configurations to return. Fewer are
+              returned only if the enumeration is complete.
+
+          Returns
+          -------
+          configurations: list[libcasm.configuration.Configuration]
+              Copies of the configurations, starting with the current value.
+          order_parameters: numpy.ndarray
+              The DoFSpace coordinates of the configurations, as rows.
+          subwedge_indices: list[int]
+              The SubWedge index of the configurations.
+          )pbdoc")
+      .def("prefetch",
+           &make_meshgrid_batch_prefetcher<config::ConfigEnumMeshGrid>,
+           py::arg("batch_size") = 1000, py::arg("n_batches_ahead") = 2,
+           py::keep_alive<0, 1>(), R"pbdoc(
+          Enumerate batches on a background thread, ahead of the consumer
+
+          A C++ thread, which never holds the GIL, calls
+          :func:`next_batch` and stays up to `n_batches_ahead` batches
+          ahead, so that Python work on one batch overlaps with enumerating
+          the following batches. The enumerator must not be used directly
+          until the prefetcher is complete or stopped.
+
+          Parameters
+          ----------
+          batch_size: int = 1000
+              The maximum number of configurations per batch.
+          n_batches_ahead: int = 2
+              The maximum number of batches enumerated but not yet taken.
+
+          Returns
+          -------
+          prefetcher: MeshGridBatchPrefetcher
+              An iterator over the batches, in enumeration order, each a
+              tuple as returned by :func:`next_batch`.
           )pbdoc");
 
+  py::class_<config::ConfigEnumSubWedgeSampling>(
+      m, "ConfigEnumSubWedgeSamplingBase", R"pbdoc(
+      Enumerate configurations with continuous DoF values on points sampled
+      in each SubWedge of an irreducible wedge
+
+      Samples a fixed number of points per SubWedge, or around previously
+      sampled points for adaptive refinement, instead of every point of a
+      mesh grid, so the number of configurations does not grow
+      exponentially with the DoFSpace dimension.
+      )pbdoc")
+      .def(py::init([](config::Configuration const &background,
+                       clexulator::DoFSpace const &dof_space,
+                       std::vector<irreps::SubWedge> const &irreducible_wedge,
+                       double stop, Index n_points, std::string method,
+                       bool trim_corners, std::uint64_t seed,
+                       double abs_tol) {
+             return std::make_unique<config::ConfigEnumSubWedgeSampling>(
+                 background, dof_space, irreducible_wedge, stop, n_points,
+                 make_subwedge_sampling_method(method), trim_corners, seed,
+                 abs_tol);
+           }),
+           py::arg("background"), py::arg("dof_space"),
+           py::arg("irreducible_wedge"), py::arg("stop"), py::arg("n_points"),
+           py::arg("method") = "sobol", py::arg("trim_corners") = true,
+           py::arg("seed") = 0, py::arg("abs_tol") = CASM::TOL,
+           R"pbdoc(
+          Construct an enumerator of points sampled in each SubWedge of an
+          irreducible wedge
+
+          Parameters
+          ----------
+          background: libcasm.configuration.Configuration
+              The background configuration.
+          dof_space: libcasm.clexulator.DoFSpace
+              The DoFSpace. Not supported for ``dof_space.dof_key == "occ"``.
+          irreducible_wedge: list[libcasm.irreps.SubWedge]
+              The irreducible wedge.
+          stop: float
+              The maximum coordinate along each SubWedge axis. The minimum
+              is 0.0, unless the axis has symmetric multiplicity of 1, in
+              which case it is ``-stop``. Must be positive.
+          n_points: int
+              The number of points to sample in each SubWedge.
+          method: str = "sobol"
+              The sampling method, one of "sobol" (a Sobol low-discrepancy
+              sequence, for SubWedge dimension up to 21),
+              "latin_hypercube", or "uniform".
+          trim_corners: bool = True
+              If True, reject points that lie outside the ellipsoid
+              inscribed within the extrema of the coordinate ranges. For
+              "sobol" and "uniform", other points are drawn instead, but
+              for "latin_hypercube" rejected points are not replaced.
+          seed: int = 0
+              Seed for the random number engine used by "latin_hypercube"
+              and "uniform".
+          abs_tol: float = :data:`~libcasm.casmglobal.TOL`
+              The absolute tolerance used to trim corners.
+          )pbdoc")
+      .def(py::init([](config::Configuration const &background,
+                       clexulator::DoFSpace const &dof_space,
+                       std::vector<irreps::SubWedge> const &irreducible_wedge,
+                       double stop, Eigen::MatrixXd const &centers,
+                       std::vector<Index> const &center_subwedge_indices,
+                       double half_width, std::vector<Index> const &n_points,
+                       std::string method, bool trim_corners,
+                       std::uint64_t seed, double abs_tol) {
+             Eigen::MatrixXd centers_columns = centers.transpose();
+             return std::make_unique<config::ConfigEnumSubWedgeSampling>(
+                 background, dof_space, irreducible_wedge, stop,
+                 centers_columns, center_subwedge_indices, half_width,
+                 n_points, make_subwedge_sampling_method(method),
+                 trim_corners, seed, abs_tol);
+           }),
+           py::arg("background"), py::arg("dof_space"),
+           py::arg("irreducible_wedge"), py::arg("stop"), py::arg("centers"),
+           py::arg("center_subwedge_indices"), py::arg("half_width"),
+           py::arg("n_points"), py::arg("method") = "sobol",
+           py::arg("trim_corners") = true, py::arg("seed") = 0,
+           py::arg("abs_tol") = CASM::TOL,
+           R"pbdoc(
+          Construct an enumerator of points sampled around previously
+          sampled points, for adaptive refinement
+
+          Points are sampled in the box of SubWedge coordinates within
+          `half_width` of each center, clipped to the SubWedge coordinate
+          ranges, so they stay in the center's SubWedge.
+
+          Parameters
+          ----------
+          background, dof_space, irreducible_wedge, stop:
+              As for the other constructor.
+          centers: numpy.ndarray
+              The DoFSpace coordinates of the centers, as rows, for example
+              order parameters of previously sampled configurations.
+          center_subwedge_indices: list[int]
+              The SubWedge index of each center.
+          half_width: float
+              Half the width, along each SubWedge axis, of the box sampled
+              around each center. Must be positive.
+          n_points: list[int]
+              The number of points to sample around each center, for
+              example in proportion to an importance weight.
+          method, trim_corners, seed, abs_tol:
+              As for the other constructor.
+          )pbdoc")
+      .def("value", &config::ConfigEnumSubWedgeSampling::value, R"pbdoc(
+          Get the current Configuration
+          )pbdoc",
+           py::return_value_policy::reference_internal)
+      .def("order_parameters",
+           &config::ConfigEnumSubWedgeSampling::order_parameters, R"pbdoc(
+          Get the DoFSpace coordinates of the current Configuration
+          )pbdoc")
+      .def("subwedge_index",
+           &config::ConfigEnumSubWedgeSampling::subwedge_index, R"pbdoc(
+          Get the index of the SubWedge of the current Configuration
+          )pbdoc")
+      .def("advance", &config::ConfigEnumSubWedgeSampling::advance, R"pbdoc(
+          Generate the next Configuration
+          )pbdoc")
+      .def("is_valid", &config::ConfigEnumSubWedgeSampling::is_valid,
+           R"pbdoc(
+          Return True if `value` is valid, False if no more valid values
+          )pbdoc")
+      .def(
+          "next_batch",
+          [](config::ConfigEnumSubWedgeSampling &self, Index max_size) {
+            Eigen::MatrixXd order_parameters;
+            std::vector<Index> subwedge_indices;
+            std::vector<config::Configuration> configurations =
+                self.next_batch(max_size, order_parameters, subwedge_indices);
+            Eigen::MatrixXd order_parameters_rows =
+                order_parameters.transpose();
+            return std::make_tuple(configurations, order_parameters_rows,
+                                   subwedge_indices);
+          },
+          py::arg("max_size"), R"pbdoc(
+          Return up to `max_size` configurations and advance past them
+
+          Returns
+          -------
+          configurations: list[libcasm.configuration.Configuration]
+              Copies of the configurations, starting with the current value.
+          order_parameters: numpy.ndarray
+              The DoFSpace coordinates of the configurations, as rows.
+          subwedge_indices: list[int]
+              The SubWedge index of the configurations.
+          )pbdoc")
+      .def("prefetch",
+           &make_meshgrid_batch_prefetcher<config::ConfigEnumSubWedgeSampling>,
+           py::arg("batch_size") = 1000, py::arg("n_batches_ahead") = 2,
+           py::keep_alive<0, 1>(), R"pbdoc(
+          Enumerate batches on a background thread, ahead of the consumer
+
+          A C++ thread, which never holds the GIL, calls
+          :func:`next_batch` and stays up to `n_batches_ahead` batches
+          ahead, so that Python work on one batch overlaps with enumerating
+          the following batches. The enumerator must not be used directly
+          until the prefetcher is complete or stopped.
+
+          Parameters
+          ----------
+          batch_size: int = 1000
+              The maximum number of configurations per batch.
+          n_batches_ahead: int = 2
+              The maximum number of batches enumerated but not yet taken.
+
+          Returns
+          -------
+          prefetcher: MeshGridBatchPrefetcher
+              An iterator over the batches, in enumeration order, each a
+              tuple as returned by :func:`next_batch`.
+                    )pbdoc");
+
+  m.def("make_occupations_parallel", &config::make_occupations_parallel,
+        R"pbdoc(
+      Enumerate occupations in many background configurations, in parallel
+
+      Parameters
+      ----------
+      backgrounds: list[libcasm.configuration.Configuration]
+          The background configurations. Occupations are enumerated on all
+          sites of each, with other DoF fixed.
+      skip_non_primitive: bool
+          If True, skip non-primitive configurations.
+      skip_non_canonical: bool
+          If True, skip configurations that are not canonical with respect
+          to the subgroup that leaves the background configuration
+          invariant.
+      n_threads: int = 0
+          The number of threads to use. If <= 0, the number of hardware
+          threads is used.
+
+      Returns
+      -------
+      configurations: list[libcasm.configuration.Configuration]
+          The enumerated configurations, for each background in order. The
+          result does not depend on `n_threads`.
+      )pbdoc",
+        py::call_guard<py::gil_scoped_release>(),
+        py::arg("backgrounds"), py::arg("skip_non_primitive"),
+        py::arg("skip_non_canonical"), py::arg("n_threads") = 0);
+
+  py::class_<config::SiteComposition>(m, "SiteComposition", R"pbdoc(
+      Exact number of each occupant on a set of sites
+      )pbdoc")
+      .def(py::init([](std::set<Index> site_indices,
+                       std::map<std::string, Index> occupant_counts) {
+             config::SiteComposition composition;
+             composition.site_indices = site_indices;
+             composition.occupant_counts = occupant_counts;
+             return composition;
+           }),
+           py::arg("site_indices"), py::arg("occupant_counts"), R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          site_indices: set[int]
+              The linear site indices.
+          occupant_counts: dict[str, int]
+              The number of sites with each occupant, by occupant name. Counts
+              must sum to the number of sites.
+          )pbdoc")
+      .def_readwrite("site_indices", &config::SiteComposition::site_indices,
+                     "set[int]: The linear site indices.")
+      .def_readwrite("occupant_counts",
+                     &config::SiteComposition::occupant_counts,
+                     "dict[str, int]: The number of sites with each occupant, "
+                     "by occupant name.");
+
+  m.def(
+      "make_sublattice_composition",
+      [](std::shared_ptr<config::Supercell const> const &supercell,
+         std::set<Index> const &sublattice_indices,
+         std::map<std::string, double> const &occupant_fractions) {
+        return config::make_sublattice_composition(
+            *supercell, sublattice_indices, occupant_fractions);
+      },
+      R"pbdoc(
+      Make the SiteComposition of the sites on some sublattices, from \
+      occupant fractions
+
+      Counts are rounded down from ``fraction * n_sites``, and the remaining
+      sites are given, one each, to the occupants with the largest
+      remainders, so counts sum to the number of sites.
+
+      Parameters
+      ----------
+      supercell: libcasm.configuration.Supercell
+          The supercell.
+      sublattice_indices: set[int]
+          The sublattices whose sites are included.
+      occupant_fractions: dict[str, float]
+          The fraction of the sites with each occupant, by occupant name.
+          Must be non-negative and sum to 1.
+
+      Returns
+      -------
+      composition: SiteComposition
+          The composition of the sites on the sublattices.
+      )pbdoc",
+      py::arg("supercell"), py::arg("sublattice_indices"),
+      py::arg("occupant_fractions"));
+
+  py::class_<config::ConfigEnumRandomOccupations>(
+      m, "ConfigEnumRandomOccupations", R"pbdoc(
+      Generate random, symmetrically distinct occupations at fixed
+      composition
+
+      Each candidate occupation is a uniformly random arrangement of the
+      occupants of each :class:`SiteComposition` on its sites, with other
+      sites fixed to the background values. Candidates are drawn and put in
+      canonical form in parallel, in C++, and kept only if not equivalent to
+      a configuration already generated.
+
+      Candidate `i` uses a random number engine seeded by ``(seed, i)``, so
+      the generated configurations depend on `seed` but not on the number of
+      threads.
+      )pbdoc")
+      .def(py::init<config::Configuration const &,
+                    std::vector<config::SiteComposition> const &,
+                    std::uint64_t, bool, Index>(),
+           py::arg("background"), py::arg("compositions"),
+           py::arg("seed") = 0, py::arg("skip_non_primitive") = false,
+           py::arg("n_threads") = 0, R"pbdoc(
+          .. rubric:: Constructor
+
+          Parameters
+          ----------
+          background: libcasm.configuration.Configuration
+              The background configuration. Sites not in any of
+              `compositions` keep the background occupation.
+          compositions: list[SiteComposition]
+              The exact composition of sets of sites, for example from
+              :func:`make_sublattice_composition`. Sets of sites must not
+              overlap.
+          seed: int = 0
+              Seed for the random number engines.
+          skip_non_primitive: bool = False
+              If True, reject non-primitive configurations.
+          n_threads: int = 0
+              The number of threads used to draw and canonicalize
+              candidates. If <= 0, the default number of threads is used.
+          )pbdoc")
+      .def("next_batch", &config::ConfigEnumRandomOccupations::next_batch,
+           py::call_guard<py::gil_scoped_release>(), py::arg("max_size"),
+           py::arg("max_attempts"), R"pbdoc(
+          Return up to `max_size` new distinct configurations
+
+          Parameters
+          ----------
+          max_size: int
+              The maximum number of configurations to return.
+          max_attempts: int
+              The maximum number of candidates to draw. Fewer than `max_size`
+              configurations are returned only if `max_attempts` candidates
+              were drawn.
+
+          Returns
+          -------
+          configurations: list[libcasm.configuration.Configuration]
+              New distinct configurations, in canonical form, in the
+              background supercell.
+          )pbdoc")
+      .def("make_candidate",
+           &config::ConfigEnumRandomOccupations::make_candidate, py::arg("i"),
+           R"pbdoc(
+          Make the candidate occupation with index `i`, before
+          canonicalization
+          )pbdoc")
+      .def("insert", &config::ConfigEnumRandomOccupations::insert,
+           py::arg("configuration"), R"pbdoc(
+          Mark a configuration, in the background supercell, as already
+          generated, and return True if it was not already
+          )pbdoc")
+      .def("n_attempts", &config::ConfigEnumRandomOccupations::n_attempts,
+           "Return the number of candidates drawn.")
+      .def("set_n_attempts",
+           &config::ConfigEnumRandomOccupations::set_n_attempts,
+           py::arg("n_attempts"), "Set the index of the next candidate drawn.")
+      .def("n_duplicates", &config::ConfigEnumRandomOccupations::n_duplicates,
+           "Return the number of candidates rejected as duplicates.")
+      .def("n_non_primitive",
+           &config::ConfigEnumRandomOccupations::n_non_primitive,
+           "Return the number of candidates rejected as non-primitive.")
+      .def("n_unique", &config::ConfigEnumRandomOccupations::n_unique,
+           "Return the number of distinct configurations generated or "
+           "inserted.");
+
+  py::class_<config::OccupationEnumerationEstimate>(
+      m, "OccupationEnumerationEstimate", R"pbdoc(
+      Estimated cost of enumerating occupations in one background \
+      configuration, as returned by \
+      :func:`~libcasm.enumerate.estimate_occupations_parallel`
+      )pbdoc")
+      .def_readonly("n_variable_sites",
+                    &config::OccupationEnumerationEstimate::n_variable_sites,
+                    "int: Number of sites with more than one allowed "
+                    "occupant.")
+      .def_readonly("n_candidates",
+                    &config::OccupationEnumerationEstimate::n_candidates,
+                    "float: Number of candidate occupations (the occupation "
+                    "counter size).")
+      .def_readonly("group_size",
+                    &config::OccupationEnumerationEstimate::group_size,
+                    "int: Size of the group used to check for canonical "
+                    "occupations, or 0 if not skipping non-canonical "
+                    "configurations.")
+      .def_readonly("n_tasks", &config::OccupationEnumerationEstimate::n_tasks,
+                    "float: Number of tasks the candidates are split into "
+                    "for sampling.")
+      .def_readonly("n_sampled_tasks",
+                    &config::OccupationEnumerationEstimate::n_sampled_tasks,
+                    "int: Number of tasks enumerated to estimate the cost.")
+      .def_readonly("n_configurations",
+                    &config::OccupationEnumerationEstimate::n_configurations,
+                    "float: Estimated number of enumerated configurations.")
+      .def_readonly(
+          "n_configurations_is_exact",
+          &config::OccupationEnumerationEstimate::n_configurations_is_exact,
+          "bool: True if `n_configurations` is exact.")
+      .def_readonly("seconds", &config::OccupationEnumerationEstimate::seconds,
+                    "float: Estimated serial enumeration time, in seconds.")
+      .def_readonly("bytes", &config::OccupationEnumerationEstimate::bytes,
+                    "float: Estimated memory used to hold the enumerated "
+                    "configurations, in bytes (approximate).");
+
+  m.def("estimate_occupations_parallel",
+        &config::estimate_occupations_parallel,
+        R"pbdoc(
+      Estimate the cost of \
+      :func:`~libcasm.enumerate.make_occupations_parallel`, by sampling, \
+      without enumerating all occupations
+
+      Candidate occupations of each background are split into tasks, by
+      fixing the occupants of the fewest leading sites such that each task
+      has at most `max_task_candidates` candidates. If there are at most
+      `max_sampled_tasks` tasks, all are enumerated and the number of
+      configurations is exact. Otherwise, `max_sampled_tasks` tasks are
+      chosen at random (with a fixed seed), enumerated, and timed, and the
+      totals are extrapolated.
+
+      Parameters
+      ----------
+      backgrounds: list[libcasm.configuration.Configuration]
+          The background configurations.
+      skip_non_primitive: bool
+          If True, skip non-primitive configurations.
+      skip_non_canonical: bool
+          If True, skip configurations that are not canonical with respect
+          to the subgroup that leaves the background configuration
+          invariant.
+      max_sampled_tasks: int = 16
+          Maximum number of tasks enumerated for each background.
+      max_task_candidates: float = 65536.0
+          Maximum number of candidate occupations in each task.
+      n_threads: int = 0
+          The number of threads used to sample backgrounds concurrently. If
+          <= 0, the number of hardware threads is used.
+
+      Returns
+      -------
+      estimates: list[OccupationEnumerationEstimate]
+          Estimates, for each background in order.
+      )pbdoc",
+        py::call_guard<py::gil_scoped_release>(), py::arg("backgrounds"),
+        py::arg("skip_non_primitive"), py::arg("skip_non_canonical"),
+        py::arg("max_sampled_tasks") = 16,
+        py::arg("max_task_candidates") = 65536.0, py::arg("n_threads") = 0);
+
+  m.def(
+      "count_distinct_occupations",
+      [](std::shared_ptr<config::Supercell const> const &supercell,
+         std::map<std::string, Index> const &occupant_counts,
+         Index n_threads) {
+        std::string count;
+        {
+          py::gil_scoped_release release;
+          count = config::count_distinct_occupations(
+              supercell, occupant_counts, n_threads);
+        }
+        return py::int_(py::str(count));
+      },
+      R"pbdoc(
+      Count symmetrically distinct occupations in a supercell, without \
+      enumerating them
+
+      Counts are exact, using Burnside's lemma with the cycle structure of \
+      the combined permutation of each supercell operation. The result is \
+      the number of configurations that would be enumerated by \
+      :class:`~libcasm.enumerate.ConfigEnumAllOccupations` on all sites of \
+      the supercell, keeping only canonical configurations with the given \
+      occupant counts. Continuous DoF are not considered.
+
+      Parameters
+      ----------
+      supercell: libcasm.configuration.Supercell
+          The supercell.
+      occupant_counts: dict[str, int] = {}
+          If not empty, only count occupations with exactly
+          `occupant_counts[name]` sites occupied by each listed occupant.
+          The number of unlisted occupants is not constrained.
+      n_threads: int = 0
+          The number of threads to use. If <= 0, the number of hardware
+          threads is used.
+
+      Returns
+      -------
+      count: int
+          The number of symmetrically distinct occupations.
+      )pbdoc",
+      py::arg("supercell"),
+      py::arg("occupant_counts") = std::map<std::string, Index>(),
+      py::arg("n_threads") = 0);
+
   m.def("make_all_distinct_periodic_perturbations",
         &make_all_distinct_periodic_perturbations,
-        "Documented in libcasm.enumerate._methods.py", py::arg("supercell"),
+        "Documented in libcasm.enumerate._methods.py",
+        py::call_guard<py::gil_scoped_release>(), py::arg("supercell"),
         py::arg("motif"), py::arg("clusters"));
 
+  m.def("for_each_distinct_periodic_perturbation",
+        &for_each_distinct_periodic_perturbation,
+        "Documented in libcasm.enumerate._methods.py", py::arg("supercell"),
+        py::arg("motif"), py::arg("clusters"), py::arg("f"),
+        py::arg("spill_dir") = std::nullopt,
+        py::arg("max_size_in_memory") = 1000000);
+
   m.def(
       "make_distinct_cluster_sites",
       [](config::Configuration const &background,
@@ -244,16 +1812,14 @@ PYBIND11_MODULE(_enumerate, m) {
           orbits.emplace_back(_orbit.begin(), _orbit.end());
         }
 
-        // convert orbit of IntegralCluster to orbit of linear site indices
-        auto supercell = background.supercell;
-        xtal::UnitCellCoordIndexConverter const &converter =
-            supercell->unitcellcoord_index_converter;
-        auto orbits_as_indices =
-            clust::make_orbits_as_indices(orbits, converter);
+        // convert orbit of IntegralCluster to linear site indices, including
+        // all supercell translations
+        config::SupercellOrbitSiteTable orbit_site_table(background.supercell,
+                                                         orbits);
 
         // find distinct cluster sites in the background configuration
         std::set<std::set<Index>> _distinct_cluster_sites =
-            config::make_distinct_cluster_sites(background, orbits_as_indices);
+            config::make_distinct_cluster_sites(background, orbit_site_table);
 
         // copy set<set<Index>> -> vector<set<Index>>
         std::vector<std::set<Index>> distinct_cluster_sites;
@@ -281,12 +1847,15 @@ PYBIND11_MODULE(_enumerate, m) {
           where ``distinct_cluster_sites[i]`` is the `i`-th distinct cluster,
           represented as a set of linear site indices in the supercell.
       )pbdoc",
+      py::call_guard<py::gil_scoped_release>(),
       py::arg("configuration"), py::arg("orbits"));
 
   m.def("make_all_distinct_local_perturbations",
         &make_all_distinct_local_perturbations,
-        "Documented in libcasm.enumerate._methods.py", py::arg("supercell"),
-        py::arg("occ_event"), py::arg("motif"), py::arg("local_clusters"));
+        "Documented in libcasm.enumerate._methods.py",
+        py::call_guard<py::gil_scoped_release>(), py::arg("supercell"),
+        py::arg("occ_event"), py::arg("motif"), py::arg("local_clusters"),
+        py::arg("n_threads") = 1);
 
   m.def("make_occevent_simple_structures", &make_occevent_simple_structures,
         R"pbdoc(
@@ -334,6 +1903,127 @@ PYBIND11_MODULE(_enumerate, m) {
         py::arg("interpolation_factors"), py::arg("system"),
         py::arg("skip_event_occupants"));
 
+  py::class_<config::OccEventImages>(m, "OccEventImages", R"pbdoc(
+      Coordinates of interpolated images of many OccEvent, in one array
+
+      For each event ``e``, images have ``n_atoms(e)`` atoms and are listed
+      in order of interpolation factor. The atoms of an image are in the
+      same order as in the structures constructed by
+      :func:`~libcasm.enumerate.make_occevent_simple_structures`.
+
+      Example usage:
+
+      .. code-block:: Python
+
+          # Cartesian coordinates, as columns, of image `k` of event `e`
+          begin = images.image_begin(e, k)
+          image_coords = images.coords[:, begin:begin + images.n_atoms(e)]
+
+          # chemical type of atom `a` of event `e`, as an index into
+          # system.chemical_name_list()
+          chemical_index = images.atom_type[images.atom_offsets[e] + a]
+
+      )pbdoc")
+      .def_readonly("lat_column_mat", &config::OccEventImages::lat_column_mat,
+                    "np.ndarray[np.float64[3, 3]]: Lattice vectors of all "
+                    "images, as columns, including strain.")
+      .def_readonly("n_images", &config::OccEventImages::n_images,
+                    "int: Number of images of each event.")
+      .def_readonly("atom_offsets", &config::OccEventImages::atom_offsets,
+                    "np.ndarray[np.int64[n_events + 1]]: Offset of the first "
+                    "atom of each event in `atom_type`.")
+      .def_readonly("atom_type", &config::OccEventImages::atom_type,
+                    "np.ndarray[np.int32[n_atoms_total]]: Chemical type of "
+                    "each atom, as an index into "
+                    ":func:`OccSystem.chemical_name_list "
+                    "<libcasm.occ_events.OccSystem.chemical_name_list>`, for "
+                    "all events.")
+      .def_readonly("coords", &config::OccEventImages::coords,
+                    "np.ndarray[np.float64[3, n_images * n_atoms_total]]: "
+                    "Cartesian coordinates, as columns, of all atoms of all "
+                    "images of all events, including strain.")
+      .def("n_events", &config::OccEventImages::n_events,
+           "Return the number of events.")
+      .def("n_atoms", &config::OccEventImages::n_atoms,
+           "Return the number of atoms in each image of event `e`.",
+           py::arg("e"))
+      .def("image_begin", &config::OccEventImages::image_begin,
+           "Return the column in `coords` of the first atom of image `k` of "
+           "event `e`.",
+           py::arg("e"), py::arg("k"));
+
+  m.def(
+      "make_occevent_images",
+      [](config::Configuration const &configuration,
+         std::vector<occ_events::OccEvent> const &occ_events,
+         std::vector<double> const &interpolation_factors,
+         std::shared_ptr<occ_events::OccSystem const> const &system,
+         bool skip_event_occupants) {
+        config::MakeOccEventImages make_images(configuration, system,
+                                               skip_event_occupants);
+        return make_images(occ_events, interpolation_factors);
+      },
+      R"pbdoc(
+      Construct the coordinates of images along many OccEvent paths in a
+      background configuration
+
+      This gives the same atom types and coordinates as
+      :func:`~libcasm.enumerate.make_occevent_simple_structures`, for all
+      events at once and in one array, without constructing a structure
+      for each image. The same restrictions apply.
+
+      Parameters
+      ----------
+      configuration : libcasm.configuration.Configuration
+          The background configuration, which sets the occupation on
+          all sites not involved in the event.
+      occ_events: list[libcasm.occ_events.OccEvent]
+          The occupation events.
+      interpolation_factors: list[double]
+          Interpolation factors, ranging for 0.0 (initial event
+          occupation) to 1.0 (final event occupation), specifying
+          which images along the event pathways should be generated.
+      system: libcasm.occ_events.OccSystem
+          The OccSystem is used to determine output atom type order and
+          help with index conversions.
+      skip_event_occupants: bool = False
+          If True, the occupants involved in the events are not included in
+          the output.
+
+      Returns
+      -------
+      images : OccEventImages
+          The image coordinates.
+      )pbdoc",
+      py::arg("configuration"), py::arg("occ_events"),
+      py::arg("interpolation_factors"), py::arg("system"),
+      py::arg("skip_event_occupants") = false);
+
+  m.def(
+      "make_prim_occevent_symgroup_rep",
+      [](std::shared_ptr<config::Prim const> const &prim) {
+        return *config::make_shared_occevent_symgroup_rep(prim);
+      },
+      R"pbdoc(
+      Make the group representation of the prim factor group for
+      transforming OccEvent
+
+      The representation is constructed once per prim and reused by later
+      calls with the same prim.
+
+      Parameters
+      ----------
+      prim : libcasm.configuration.Prim
+          The Prim
+
+      Returns
+      -------
+      occevent_symgroup_rep: list[libcasm.occ_events.OccEventRep]
+          Group representation of `prim.factor_group` for transforming
+          OccEvent
+      )pbdoc",
+      py::arg("prim"));
+
   m.def("make_phenomenal_occevent", &make_phenomenal_occevent,
         R"pbdoc(
       Construct the phenomenal OccEvent for the equivalent local basis sets
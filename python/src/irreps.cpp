@@ -441,6 +441,21 @@ PYBIND11_MODULE(_irreps, m) {
                     R"pbdoc(
           list[numpy.ndarray[numpy.float64[vector_dim, vector_dim]]]: The symmetry "
           group representation matrices
+
+          May be empty, if the report was made with
+          ``include_matrix_rep=False``.
+          )pbdoc")
+      .def_readonly("irrep_matrix_rep",
+                    &irreps::VectorSpaceSymReport::irrep_symgroup_rep,
+                    R"pbdoc(
+          list[list[numpy.ndarray[numpy.float64[irrep_dim, irrep_dim]]]]: The
+          symmetry group representation matrices in each irreducible subspace
+
+          The matrix ``irrep_matrix_rep[i][o]`` is the real part of
+          ``irreps[i].trans_mat @ M_o @ irreps[i].trans_mat.T``, where `M_o` is
+          the full space matrix representation of the `o`-th group element.
+          These are the blocks of the block-diagonal matrix representation in
+          the symmetry adapted basis.
           )pbdoc")
       .def_readonly("irreps", &irreps::VectorSpaceSymReport::irreps, R"pbdoc(
           list[IrrepInfo]: The irreducible subspaces
@@ -558,8 +573,8 @@ PYBIND11_MODULE(_irreps, m) {
       .def(
           "make_symmetry_report",
           [](irreps::IrrepDecomposition const &self, bool calc_wedges,
-             std::optional<std::vector<std::string>> glossary)
-              -> irreps::VectorSpaceSymReport {
+             std::optional<std::vector<std::string>> glossary,
+             bool include_matrix_rep) -> irreps::VectorSpaceSymReport {
             if (!glossary.has_value()) {
               Index dim = self.fullspace_rep[0].rows();
               std::vector<std::string> _glossary;
@@ -569,8 +584,9 @@ PYBIND11_MODULE(_irreps, m) {
               glossary = _glossary;
             }
 
-            return irreps::vector_space_sym_report(self, calc_wedges,
-                                                   *glossary);
+            Index n_threads = 1;
+            return irreps::vector_space_sym_report(
+                self, calc_wedges, *glossary, n_threads, include_matrix_rep);
           },
           R"pbdoc(
           Construct a VectorSpaceSymReport
@@ -583,8 +599,17 @@ PYBIND11_MODULE(_irreps, m) {
               portions of the vector space, which is useful for enumeration.
           glossary: Optional[list[str]] = None
               If provided, a description of each dimension of the vector space.
+          include_matrix_rep: bool = True
+              If True, include the full space matrix representation,
+              :py:attr:`VectorSpaceSymReport.matrix_rep`. If False, it is
+              empty, which avoids constructing a dense full space matrix for
+              each group element. The irreducible subspace matrices,
+              :py:attr:`VectorSpaceSymReport.irrep_matrix_rep`, are always
+              included.
           )pbdoc",
-          py::arg("calc_wedges") = false, py::arg("glossary") = std::nullopt);
+          py::call_guard<py::gil_scoped_release>(),
+          py::arg("calc_wedges") = false, py::arg("glossary") = std::nullopt,
+          py::arg("include_matrix_rep") = true);
 
 #ifdef VERSION_INFO
   m.attr("__version__") = MACRO_STRINGIFY(VERSION_INFO);
@@ -14,6 +14,7 @@
 #include "casm/configuration/clusterography/ClusterSpecs.hh"
 #include "casm/configuration/clusterography/IntegralCluster.hh"
 #include "casm/configuration/clusterography/orbits.hh"
+#include "casm/configuration/enumeration/OccEventInfo.hh"
 #include "casm/configuration/group/Group.hh"
 #include "casm/configuration/occ_events/OccEvent.hh"
 #include "casm/configuration/occ_events/OccEventCounter.hh"
@@ -252,6 +253,16 @@ PYBIND11_MODULE(_occ_events, m) {
            &occ_events::OccSystem::get_cartesian_coordinate,
            "Get the Cartesian coordinate of an occupant position",
            py::arg("pos"))
+      .def(
+          "get_cartesian_coordinates",
+          [](occ_events::OccSystem const &self,
+             occ_events::OccEvent const &occ_event) -> Eigen::MatrixXd {
+            return self.get_cartesian_coordinates(occ_event);
+          },
+          "Get the Cartesian coordinates, as columns, of all occupant "
+          "positions in an OccEvent that are not in the resevoir, in order of "
+          "trajectory and then position along the trajectory",
+          py::arg("occ_event"))
       .def("is_indivisible", &occ_events::OccSystem::is_indivisible,
            "Return True if occupant is indivisible, False otherwise",
            py::arg("pos"))
@@ -780,8 +791,8 @@ PYBIND11_MODULE(_occ_events, m) {
       [](std::shared_ptr<occ_events::OccSystem const> const &system,
          clust::ClusterSpecs const &cluster_specs,
          const nlohmann::json &occevent_counter_params,
-         std::vector<occ_events::OccEvent> const &custom_occevents)
-          -> std::vector<occ_events::OccEvent> {
+         std::vector<occ_events::OccEvent> const &custom_occevents,
+         Index n_threads) -> std::vector<occ_events::OccEvent> {
         // get canonical clusters
         auto generating_group_unitcellcoord_symgroup_rep =
             sym_info::make_unitcellcoord_symgroup_rep(
@@ -795,9 +806,19 @@ PYBIND11_MODULE(_occ_events, m) {
           clusters.push_back(*orbit.rbegin());
         }
 
-        // get occevent_symgroup_rep
-        auto occevent_symgroup_rep = occ_events::make_occevent_symgroup_rep(
-            cluster_specs.generating_group->element, *cluster_specs.prim);
+        // get occevent_symgroup_rep; the prim factor group rep is shared
+        std::shared_ptr<std::vector<occ_events::OccEventRep> const>
+            occevent_symgroup_rep;
+        if (cluster_specs.generating_group->head_group == nullptr) {
+          occevent_symgroup_rep = config::make_shared_occevent_symgroup_rep(
+              cluster_specs.generating_group, cluster_specs.prim);
+        } else {
+          occevent_symgroup_rep =
+              std::make_shared<std::vector<occ_events::OccEventRep> const>(
+                  occ_events::make_occevent_symgroup_rep(
+                      cluster_specs.generating_group->element,
+                      *cluster_specs.prim));
+        }
 
         // get OccEventCounterParameters
         jsonParser json{occevent_counter_params};
@@ -816,11 +837,13 @@ PYBIND11_MODULE(_occ_events, m) {
         }
 
         return make_prim_periodic_occevent_prototypes(
-            system, clusters, occevent_symgroup_rep, params, custom_occevents);
+            system, clusters, *occevent_symgroup_rep, params,
+            custom_occevents, n_threads);
       },
-      "Documented in libcasm.occ_events._methods.py", py::arg("system"),
+      "Documented in libcasm.occ_events._methods.py",
+      py::call_guard<py::gil_scoped_release>(), py::arg("system"),
       py::arg("cluster_specs"), py::arg("occevent_counter_params"),
-      py::arg("custom_occevents"));
+      py::arg("custom_occevents"), py::arg("n_threads") = 1);
 
   m.def("get_occevent_coordinate", &get_occevent_coordinate,
         R"pbdoc(
@@ -196,3 +196,98 @@ def test_make_local_cluster_specs():
     assert len(orbits[2]) == 4
     assert len(orbits[3]) == 8
     assert len(orbits[4]) == 2
+
+
+def test_cluster_specs_make_orbits_use_cache(tmp_path):
+    xtal_prim = xtal_prims.FCC(r=1.0, occ_dof=["A", "B", "Va"])
+    prim_factor_group = sym_info.make_factor_group(xtal_prim)
+    cluster_specs = clust.ClusterSpecs(
+        xtal_prim=xtal_prim,
+        generating_group=prim_factor_group,
+        max_length=[0.0, 0.0, 2.01, 2.01],
+    )
+    orbits = cluster_specs.make_orbits()
+
+    clust.set_orbit_cache_dir(str(tmp_path))
+    try:
+        cached_orbits = cluster_specs.make_orbits(use_cache=True)
+        assert len(list(tmp_path.glob("*.orbits"))) == 1
+        assert cached_orbits == orbits
+
+        # read from memory, then from disk after clearing memory
+        assert cluster_specs.make_orbits(use_cache=True) == orbits
+        clust.clear_orbit_cache()
+        assert cluster_specs.make_orbits(use_cache=True) == orbits
+    finally:
+        clust.set_orbit_cache_dir(None)
+        clust.clear_orbit_cache()
+
+
+def test_equivalents_info_binary(tmp_path):
+    xtal_prim = xtal_prims.FCC(r=1.0, occ_dof=["A", "B", "Va"])
+    prim_factor_group = sym_info.make_factor_group(xtal_prim)
+    cluster_specs = clust.ClusterSpecs(
+        xtal_prim=xtal_prim,
+        generating_group=prim_factor_group,
+        max_length=[0.0, 0.0, 2.01],
+    )
+    phenomenal_clusters = cluster_specs.make_orbits()[2]
+    op_indices = list(range(len(phenomenal_clusters)))
+
+    path = tmp_path / "equivalents_info.bin"
+    clust.write_equivalents_info_binary(
+        str(path), phenomenal_clusters, op_indices, key="test"
+    )
+    clusters, indices, key = clust.read_equivalents_info_binary(str(path))
+    assert clusters == phenomenal_clusters
+    assert indices == op_indices
+    assert key == "test"
+
+
+def test_cluster_specs_extend_orbits():
+    xtal_prim = xtal_prims.FCC(r=1.0, occ_dof=["A", "B", "Va"])
+    prim_factor_group = sym_info.make_factor_group(xtal_prim)
+    prev_max_length = [0.0, 0.0, 2.01, 2.01]
+    prev_cluster_specs = clust.ClusterSpecs(
+        xtal_prim=xtal_prim,
+        generating_group=prim_factor_group,
+        max_length=prev_max_length,
+    )
+    prev_orbits = prev_cluster_specs.make_orbits()
+
+    cluster_specs = clust.ClusterSpecs(
+        xtal_prim=xtal_prim,
+        generating_group=prim_factor_group,
+        max_length=[0.0, 0.0, 3.01, 3.01, 2.01],
+    )
+    orbits = cluster_specs.extend_orbits(
+        prev_orbits=prev_orbits,
+        prev_max_length=prev_max_length,
+    )
+    assert len(orbits) > len(prev_orbits)
+    assert orbits == cluster_specs.make_orbits()
+
+
+def test_cluster_specs_make_orbit_table():
+    xtal_prim = xtal_prims.FCC(r=1.0, occ_dof=["A", "B", "Va"])
+    prim_factor_group = sym_info.make_factor_group(xtal_prim)
+    cluster_specs = clust.ClusterSpecs(
+        xtal_prim=xtal_prim,
+        generating_group=prim_factor_group,
+        max_length=[0.0, 0.0, 2.01, 2.01],
+    )
+    orbits = cluster_specs.make_orbits()
+    table = cluster_specs.make_orbit_table()
+    assert isinstance(table, clust.OrbitTable)
+    assert table.n_orbits() == len(orbits)
+    assert table.n_clusters() == sum(len(orbit) for orbit in orbits)
+    assert table.to_orbits() == orbits
+
+    sites = table.sites
+    assert sites.shape == (table.cluster_offsets[-1], 4)
+    assert not sites.flags.writeable
+    assert table.orbit_offsets[-1] == table.n_clusters()
+
+    c = table.orbit_offsets[3]
+    begin, end = table.cluster_offsets[c], table.cluster_offsets[c + 1]
+    assert sites[begin:end].tolist() == orbits[3][0].to_list()
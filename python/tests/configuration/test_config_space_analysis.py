@@ -290,3 +290,29 @@ def test_config_space_analysis_4(FCC_binary_prim):
     ).transpose()
 
     expect_same_basis_vectors(symmetry_adapted_dof_space.basis, expected)
+
+
+def test_config_space_analysis_accumulator(FCC_binary_prim):
+    prim = FCC_binary_prim
+    configurations = build_configurations_1(prim)
+    expected = casmconfig.config_space_analysis(configurations=configurations)
+
+    accumulator = casmconfig.ConfigSpaceAnalysisAccumulator(prim, "occ")
+    assert accumulator.insert({"A1": configurations["A1"]}) == 1
+    assert accumulator.insert(configurations) == 3
+    assert accumulator.insert({"A1_again": configurations["A1"]}) == 0
+    assert accumulator.n_prototypes() == 4
+    results = accumulator.results()
+    assert np.allclose(results.projector, expected["occ"].projector)
+    expect_same_basis_vectors(
+        results.symmetry_adapted_dof_space.basis,
+        expected["occ"].symmetry_adapted_dof_space.basis,
+    )
+
+    partial = {k: v for k, v in configurations.items() if k != "B1"}
+    partial_results = casmconfig.config_space_analysis(configurations=partial)
+    continued = casmconfig.ConfigSpaceAnalysisAccumulator.from_results(
+        partial_results["occ"]
+    )
+    assert continued.insert({"B1": configurations["B1"]}) == 1
+    assert np.allclose(continued.results().projector, expected["occ"].projector)
@@ -91,6 +91,58 @@ def test_canonical_configuration_occupation(simple_cubic_binary_prim):
     assert config.is_canonical_configuration(canon_config) is True
     assert (canon_config.occupation == np.array([1] + [0] * 63)).all()
 
+    assert config.find_non_canonical_witness(canon_config) is None
+    witness = config.find_non_canonical_witness(configuration)
+    assert witness is not None
+    assert witness * configuration > configuration
+
+
+def test_batch_configuration_functions(simple_cubic_binary_prim):
+    prim = config.Prim(simple_cubic_binary_prim)
+    T = np.array(
+        [
+            [4, 0, 0],
+            [0, 4, 0],
+            [0, 0, 4],
+        ]
+    )
+    supercell = config.make_canonical_supercell(config.Supercell(prim, T))
+    configurations = []
+    for site in [0, 10, None]:
+        configuration = config.Configuration(supercell)
+        if site is not None:
+            configuration.set_occ(site, 1)
+        configurations.append(configuration)
+
+    for n_threads in [1, 2]:
+        is_canonical = config.is_canonical_configurations(
+            configurations, n_threads=n_threads
+        )
+        assert is_canonical.dtype == bool
+        assert (is_canonical == np.array([True, False, True])).all()
+
+        is_primitive = config.is_primitive_configurations(
+            configurations, n_threads=n_threads
+        )
+        assert (is_primitive == np.array([True, True, False])).all()
+
+        occupations = np.array([c.occupation for c in configurations])
+        is_canonical = config.is_canonical_occupations(
+            supercell, occupations, n_threads=n_threads
+        )
+        assert (is_canonical == np.array([True, False, True])).all()
+
+        canonical_occupations = config.make_canonical_occupations(
+            supercell, occupations, n_threads=n_threads
+        )
+        assert canonical_occupations.shape == (3, 64)
+        assert (canonical_occupations[0] == occupations[0]).all()
+        assert (canonical_occupations[1] == occupations[0]).all()
+        assert (canonical_occupations[2] == occupations[2]).all()
+
+        data = config.configurations_to_dicts(configurations, n_threads=n_threads)
+        assert data == [c.to_dict() for c in configurations]
+
 
 def test_configuration_invariant_subgroup(simple_cubic_binary_prim):
     prim = config.Prim(simple_cubic_binary_prim)
@@ -161,3 +213,78 @@ def test_copy_configuration(simple_cubic_binary_prim):
     assert isinstance(configuration3, config.Configuration)
     assert configuration2 is not configuration1
     assert configuration3 is not configuration1
+
+
+def test_configuration_views(FCC_binary_GLstrain_disp_prim):
+    prim = config.Prim(FCC_binary_GLstrain_disp_prim)
+    T = np.array(
+        [
+            [2, 0, 0],
+            [0, 1, 0],
+            [0, 0, 1],
+        ]
+    )
+    supercell = config.Supercell(prim, T)
+    configuration = config.Configuration(supercell)
+
+    occupation = configuration.occupation_view()
+    occupation[1] = 1
+    assert configuration.occ(1) == 1
+
+    disp = configuration.local_dof_values_view("disp")
+    assert disp.shape == (3, 2)
+    disp[:, 0] = [0.1, 0.2, 0.3]
+    disp_0 = configuration.local_dof_site_value("disp", 0)
+    assert np.allclose(disp_0, [0.1, 0.2, 0.3])
+
+    strain = configuration.global_dof_values_view("GLstrain")
+    strain[0] = 0.01
+    assert np.isclose(configuration.global_dof_values("GLstrain")[0], 0.01)
+
+    # the view keeps the configuration alive
+    del configuration
+    occupation[0] = 1
+    assert (occupation == [1, 1]).all()
+
+
+def test_configuration_pickle(FCC_binary_GLstrain_disp_prim):
+    import pickle
+
+    prim = config.Prim(FCC_binary_GLstrain_disp_prim)
+    T = np.array(
+        [
+            [2, 0, 0],
+            [0, 1, 0],
+            [0, 0, 1],
+        ]
+    )
+    supercell = config.Supercell(prim, T)
+    configurations = []
+    for i in range(3):
+        configuration = config.Configuration(supercell)
+        configuration.set_occ(0, i % 2)
+        configuration.set_local_dof_values("disp", np.full((3, 2), 0.01 * i))
+        configuration.set_global_dof_values("GLstrain", np.full(6, -0.01 * i))
+        configurations.append(configuration)
+
+    # prim is shared with the original, after pickling in this process
+    assert pickle.loads(pickle.dumps(prim)) is prim
+
+    supercell_in = pickle.loads(pickle.dumps(supercell))
+    assert supercell_in == supercell
+    assert supercell_in.prim is prim
+
+    configurations_in = pickle.loads(pickle.dumps(configurations))
+    assert len(configurations_in) == 3
+    assert configurations_in[0].supercell is configurations_in[2].supercell
+    for configuration_in, configuration in zip(configurations_in, configurations):
+        assert configuration_in == configuration
+        assert (configuration_in.occupation == configuration.occupation).all()
+        assert np.allclose(
+            configuration_in.local_dof_values("disp"),
+            configuration.local_dof_values("disp"),
+        )
+        assert np.allclose(
+            configuration_in.global_dof_values("GLstrain"),
+            configuration.global_dof_values("GLstrain"),
+        )
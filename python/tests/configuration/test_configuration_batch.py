@@ -0,0 +1,103 @@
+import numpy as np
+
+import libcasm.configuration as config
+
+
+def make_test_batch(prim):
+    T = np.array(
+        [
+            [2, 0, 0],
+            [0, 2, 0],
+            [0, 0, 1],
+        ]
+    )
+    supercell = config.make_canonical_supercell(config.Supercell(prim, T))
+    batch = config.ConfigurationBatch(supercell, n_configurations=6)
+    for i in range(batch.size()):
+        for l in range(batch.n_sites()):
+            batch.occupation[i, l] = 1 if (l + i) % 3 == 0 else 0
+        if i % 2:
+            batch.global_dof_values("GLstrain")[i, 0] = 0.01 * i
+            batch.local_dof_values("disp")[i, 2, i % batch.n_sites()] = 0.1
+    return batch
+
+
+def test_ConfigurationBatch_views(FCC_binary_GLstrain_disp_prim):
+    prim = config.Prim(FCC_binary_GLstrain_disp_prim)
+    batch = make_test_batch(prim)
+
+    assert len(batch) == 6
+    assert batch.occupation.shape == (6, 4)
+    assert batch.occupation.dtype == np.int8
+    assert batch.global_dof_keys() == ["GLstrain"]
+    assert batch.local_dof_keys() == ["disp"]
+    assert batch.global_dof_values("GLstrain").shape == (6, 6)
+    assert batch.local_dof_values("disp").shape == (6, 3, 4)
+
+    for i in range(batch.size()):
+        configuration = batch.configuration(i)
+        assert np.array_equal(configuration.occupation, batch.occupation[i, :])
+        assert np.allclose(
+            configuration.global_dof_values("GLstrain"),
+            batch.global_dof_values("GLstrain")[i, :],
+        )
+        assert np.allclose(
+            configuration.local_dof_values("disp"),
+            batch.local_dof_values("disp")[i, :, :],
+        )
+
+    # set and append
+    configuration = batch.configuration(1)
+    batch.set(0, configuration)
+    assert batch.configuration(0) == configuration
+    batch.append(configuration)
+    assert len(batch) == 7
+    assert batch.configuration(6) == configuration
+
+    # occupation only
+    occ_batch = config.ConfigurationBatch(
+        batch.supercell, n_configurations=1, include_continuous_dof=False
+    )
+    assert occ_batch.global_dof_keys() == []
+    occ_batch.set(0, configuration)
+    assert np.array_equal(
+        occ_batch.configuration(0).occupation, configuration.occupation
+    )
+
+
+def test_ConfigurationBatch_operations(FCC_binary_GLstrain_disp_prim):
+    prim = config.Prim(FCC_binary_GLstrain_disp_prim)
+    batch = make_test_batch(prim)
+    configurations = [batch.configuration(i) for i in range(batch.size())]
+
+    canonical = batch.make_canonical_forms(n_threads=2)
+    is_primitive = batch.is_primitive(n_threads=2)
+    n_equivalents = batch.n_equivalents(n_threads=2)
+    expected = config.make_canonical_configurations(configurations)
+    for i, configuration in enumerate(configurations):
+        assert canonical.configuration(i) == expected[i]
+        assert is_primitive[i] == config.is_primitive_configuration(configuration)
+        assert n_equivalents[i] == len(
+            config.make_equivalent_configurations(configuration)
+        )
+
+    structures = batch.to_structures()
+    expected_structures = config.make_atomic_structures(configurations)
+    assert structures.n_structures() == 6
+    assert np.allclose(structures.coords, expected_structures.coords)
+
+
+def test_ConfigurationSet_add_extract_batch(FCC_binary_GLstrain_disp_prim):
+    prim = config.Prim(FCC_binary_GLstrain_disp_prim)
+    batch = make_test_batch(prim)
+
+    configuration_set = config.ConfigurationSet()
+    assert configuration_set.add_batch(batch) == 6
+    assert configuration_set.add_batch(batch) == 0
+    assert len(configuration_set) == 6
+
+    extracted, configuration_ids = configuration_set.extract_batch(batch.supercell)
+    assert len(extracted) == 6
+    for i, record in enumerate(configuration_set):
+        assert configuration_ids[i] == record.configuration_id
+        assert extracted.configuration(i) == record.configuration
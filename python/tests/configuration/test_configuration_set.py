@@ -144,3 +144,120 @@ def test_ConfigurationSet_to_dict_2(FCC_binary_Hstrain_noshear_prim):
         x.set_occ(i, 1)
         configurations.add(config.make_canonical_configuration(x))
     assert len(configurations) == 1
+
+
+def test_ConfigurationSet_pickle(simple_cubic_binary_prim):
+    import pickle
+
+    prim = config.Prim(simple_cubic_binary_prim)
+    configurations = config.ConfigurationSet()
+    assert pickle.loads(pickle.dumps(configurations)).empty()
+
+    T = np.array(
+        [
+            [2, 1, 0],
+            [0, 1, 0],
+            [0, 0, 1],
+        ]
+    )
+    supercell = config.make_canonical_supercell(config.Supercell(prim, T))
+    for i in range(2):
+        configuration = config.Configuration(supercell)
+        configuration.set_occ(0, i)
+        configurations.add(configuration)
+
+    configurations_in = pickle.loads(pickle.dumps(configurations))
+    assert len(configurations_in) == 2
+    for record in configurations:
+        record_in = configurations_in.get(record.configuration_name)
+        assert record_in is not None
+        assert record_in.configuration == record.configuration
+    assert configurations_in.to_dict() == configurations.to_dict()
+
+
+def test_ConfigurationSet_get_by_primitive(simple_cubic_binary_prim):
+    prim = config.Prim(simple_cubic_binary_prim)
+    configurations = config.ConfigurationSet()
+
+    supercell_1 = config.make_canonical_supercell(
+        config.Supercell(prim, np.eye(3, dtype=int) * 2)
+    )
+    supercell_2 = config.make_canonical_supercell(
+        config.Supercell(prim, np.eye(3, dtype=int))
+    )
+    configuration_1 = config.Configuration(supercell_1)
+    configuration_2 = config.Configuration(supercell_2)
+
+    configurations.add(configuration_1)
+    records = configurations.get_by_primitive(configuration_2)
+    assert len(records) == 1
+    assert records[0].configuration == configuration_1
+
+    configurations.add(configuration_2)
+    assert len(configurations.get_by_primitive(configuration_1)) == 2
+
+
+def test_ConfigurationSet_secondary_indexes(simple_cubic_binary_prim):
+    prim = config.Prim(simple_cubic_binary_prim)
+    configurations = config.ConfigurationSet()
+
+    supercell_1 = config.make_canonical_supercell(
+        config.Supercell(prim, np.eye(3, dtype=int))
+    )
+    supercell_2 = config.make_canonical_supercell(
+        config.Supercell(prim, np.array([[2, 0, 0], [0, 1, 0], [0, 0, 1]]))
+    )
+    configuration_A = config.Configuration(supercell_1)
+    configuration_B = config.Configuration(supercell_1)
+    configuration_B.set_occupation([1])
+    configurations.add(configuration_A)
+    configurations.add(configuration_B)
+
+    assert len(configurations.get_by_supercell_name(supercell_1.name)) == 2
+    assert len(configurations.get_by_supercell_name(supercell_2.name)) == 0
+    assert len(configurations.get_by_volume(1, 1)) == 2
+    assert len(configurations.get_by_volume(2, 8)) == 0
+    records = configurations.get_by_occupant_count(0, "B", 1, 1)
+    assert len(records) == 1
+    assert records[0].configuration == configuration_B
+
+    # the index is updated on add and remove
+    configuration_BB = config.Configuration(supercell_2)
+    configuration_BB.set_occupation([1, 1])
+    configurations.add(configuration_BB)
+    records = configurations.get_by_volume(2, 8)
+    assert len(records) == 1
+    assert records[0].configuration == configuration_BB
+    assert len(configurations.get_by_occupant_count(0, "B", 1, 2)) == 2
+
+    configurations.remove(configuration_B)
+    assert len(configurations.get_by_occupant_count(0, "B", 1, 2)) == 1
+    assert len(configurations.get_by_supercell_name(supercell_1.name)) == 1
+
+
+def test_ConfigurationRecord_canonical_ops(simple_cubic_binary_prim):
+    prim = config.Prim(simple_cubic_binary_prim)
+    T = np.array(
+        [
+            [2, 0, 0],
+            [0, 2, 0],
+            [0, 0, 1],
+        ]
+    )
+    supercell = config.make_canonical_supercell(config.Supercell(prim, T))
+    configuration = config.Configuration(supercell)
+    configuration.set_occ(1, 1)
+    configurations = config.ConfigurationSet()
+    record = configurations.add(configuration)
+
+    to_canonical = record.to_canonical()
+    assert to_canonical == config.to_canonical_configuration(configuration)
+    assert record.from_canonical() == config.from_canonical_configuration(
+        configuration
+    )
+    assert to_canonical * configuration == config.make_canonical_configuration(
+        configuration
+    )
+    assert record.invariant_subgroup_size() == len(
+        config.make_invariant_subgroup(configuration)
+    )
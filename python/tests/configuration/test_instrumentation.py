@@ -0,0 +1,38 @@
+import numpy as np
+
+import libcasm.configuration as config
+
+
+def test_instrumentation(FCC_binary_prim):
+    prim = config.Prim(FCC_binary_prim)
+    T = np.array(
+        [
+            [-1, 1, 1],
+            [1, -1, 1],
+            [1, 1, -1],
+        ]
+    )
+
+    config.reset_instrumentation()
+    config.set_instrumentation_enabled(True)
+    assert config.instrumentation_is_enabled()
+    supercell = config.Supercell(prim, T)
+    configuration = config.Configuration(supercell)
+    configuration.set_occ(0, 1)
+    config.make_canonical_configuration(configuration)
+    config.set_instrumentation_enabled(False)
+    assert config.instrumentation_is_enabled() is False
+
+    results = config.instrumentation_results()
+    assert set(results.keys()) == set(["counts", "seconds", "calls"])
+    assert "op_applications" in results["counts"]
+    assert "supercell_sym_info" in results["seconds"]
+    if config.instrumentation_is_compiled():
+        assert results["counts"]["supercells_constructed"] >= 1
+        assert results["counts"]["canonical_forms"] == 1
+        assert results["counts"]["comparisons"] > 0
+        assert results["calls"]["canonical_form"] == 1
+
+    config.reset_instrumentation()
+    results = config.instrumentation_results()
+    assert all(value == 0 for value in results["counts"].values())
@@ -1,5 +1,7 @@
 import json
 
+import numpy as np
+
 import libcasm.configuration as config
 import libcasm.xtal as xtal
 
@@ -86,3 +88,39 @@ def test_from_dict():
     prim = config.Prim.from_dict(prim_data)
     assert prim.xtal_prim.coordinate_frac().shape == (3, 1)
     assert len(prim.factor_group.elements) == 48
+
+
+def test_prim_sym_info_cache(tmp_path, FCC_binary_GLstrain_disp_prim):
+    xtal_prim = FCC_binary_GLstrain_disp_prim
+    prim = config.Prim(xtal_prim)
+
+    config.set_prim_sym_info_cache_dir(str(tmp_path))
+    try:
+        cached_prim = config.Prim(xtal_prim, use_cache=True)
+        assert len(list(tmp_path.iterdir())) == 1
+
+        # read from the cache directory, not memory
+        config.clear_prim_sym_info_cache()
+        read_prim = config.Prim(xtal_prim, use_cache=True)
+    finally:
+        config.set_prim_sym_info_cache_dir(None)
+        config.clear_prim_sym_info_cache()
+
+    for other in [cached_prim, read_prim]:
+        assert len(other.factor_group.elements) == len(prim.factor_group.elements)
+        for op, other_op in zip(
+            prim.factor_group.elements, other.factor_group.elements
+        ):
+            assert np.allclose(op.matrix(), other_op.matrix())
+            assert np.allclose(op.translation(), other_op.translation())
+        assert other.occ_symgroup_rep == prim.occ_symgroup_rep
+        for key in ["disp", "occ"]:
+            for M, other_M in zip(
+                prim.local_dof_matrix_rep(key), other.local_dof_matrix_rep(key)
+            ):
+                assert np.allclose(M, other_M)
+        for M, other_M in zip(
+            prim.global_dof_matrix_rep("GLstrain"),
+            other.global_dof_matrix_rep("GLstrain"),
+        ):
+            assert np.allclose(M, other_M)
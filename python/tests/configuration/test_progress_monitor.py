@@ -0,0 +1,60 @@
+import numpy as np
+import pytest
+
+import libcasm.configuration as casmconfig
+
+
+def make_configurations(prim: casmconfig.Prim):
+    T = np.array(
+        [
+            [-1, 1, 1],
+            [1, -1, 1],
+            [1, 1, -1],
+        ],
+        dtype=int,
+    )
+    supercell = casmconfig.make_canonical_supercell(casmconfig.Supercell(prim, T))
+    configurations = {}
+    for name, occupation in [("A3B1", [1, 0, 0, 0]), ("A1B3", [1, 1, 1, 0])]:
+        configuration = casmconfig.Configuration(supercell)
+        configuration.set_occupation(occupation)
+        configurations[name] = configuration
+    return configurations
+
+
+def test_progress_monitor_1(FCC_binary_prim):
+    prim = casmconfig.Prim(FCC_binary_prim)
+    configurations = make_configurations(prim)
+
+    reports = []
+
+    def callback(stage, n_done, n_total):
+        reports.append((stage, n_done, n_total))
+
+    progress = casmconfig.ProgressMonitor(callback=callback, min_interval=0.0)
+    results = casmconfig.config_space_analysis(
+        configurations=configurations,
+        dofs=["occ"],
+        progress=progress,
+    )
+    assert "occ" in results
+    assert len(reports) > 0
+    assert reports[0] == ("config_space_analysis: occ", 0, 2)
+    assert reports[-1][1] == 2
+    assert progress.is_cancelled() is False
+
+
+def test_progress_monitor_2(FCC_binary_prim):
+    prim = casmconfig.Prim(FCC_binary_prim)
+    configurations = make_configurations(prim)
+
+    progress = casmconfig.ProgressMonitor()
+    progress.cancel()
+    assert progress.is_cancelled()
+    with pytest.raises(casmconfig.OperationCancelled):
+        casmconfig.config_space_analysis(
+            configurations=configurations,
+            dofs=["occ"],
+            progress=progress,
+        )
+    assert issubclass(casmconfig.OperationCancelled, KeyboardInterrupt)
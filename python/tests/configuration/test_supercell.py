@@ -140,3 +140,54 @@ def test_simple_cubic_binary_supercell_compare(simple_cubic_binary_prim):
     for scel in equivalent_supercells:
         print(scel.superlattice.column_vector_matrix())
     assert len(equivalent_supercells) == 3
+
+
+def test_supercell_memory_usage(FCC_binary_prim):
+    prim = config.Prim(FCC_binary_prim)
+    supercell = config.Supercell(prim, np.eye(3, dtype=int) * 2)
+    before = supercell.memory_bytes()
+    assert before > 0
+    assert len(supercell.translation_permutations) == 8
+    assert supercell.memory_bytes() > before
+    assert prim.memory_bytes() > 0
+
+    usage = config.memory_usage()
+    assert usage["supercell_sym_info"] > 0
+    assert usage["total"] >= usage["supercell_sym_info"]
+
+    assert config.memory_budget() is None
+    try:
+        config.set_memory_budget(0)
+        assert config.memory_budget() == 0
+        assert config.memory_usage()["combined_permutation_tables"] == 0
+        assert config.memory_usage()["matrix_rep_cache"] == 0
+
+        # translation permutations are not stored, when over budget
+        small = config.Supercell(prim, np.eye(3, dtype=int) * 3)
+        assert small.translation_permutations is None
+    finally:
+        config.set_memory_budget(None)
+    assert config.memory_budget() is None
+    assert config.enforce_memory_budget() == 0
+
+
+def test_numa_replication(FCC_binary_prim):
+    prim = config.Prim(FCC_binary_prim)
+    supercell = config.Supercell(prim, np.eye(3, dtype=int) * 2)
+    configurations = []
+    for i in range(supercell.n_sites):
+        configuration = config.Configuration(supercell)
+        configuration.set_occ(i, 1)
+        configurations.append(configuration)
+    expected = config.make_canonical_configurations(configurations)
+
+    assert config.numa_node_count() >= 1
+    assert config.numa_replication_is_enabled() is False
+    try:
+        config.set_numa_replication_enabled()
+        assert config.numa_replication_is_enabled() is True
+        canonical = config.make_canonical_configurations(configurations, n_threads=4)
+        assert canonical == expected
+    finally:
+        config.set_numa_replication_enabled(False)
+    assert config.numa_replication_is_enabled() is False
@@ -1,9 +1,11 @@
 import numpy as np
+import pytest
 
 import libcasm.configuration as casmconfig
 import libcasm.enumerate as casmenum
 import libcasm.xtal as xtal
 import libcasm.xtal.prims as xtal_prims
+from libcasm.enumerate._enumerate import ConfigEnumAllOccupationsBase
 
 
 def test_ConfigEnumAllOccupations_by_supercell_FCC_1():
@@ -228,3 +230,233 @@ def test_ConfigEnumAllOccupations_by_cluster_FCC_1():
     info.finish()
 
     assert len(configuration_set)
+
+
+def test_ConfigEnumAllOccupations_by_supercell_resume():
+    import json
+
+    xtal_prim = xtal_prims.FCC(
+        r=0.5,
+        occ_dof=["A", "B", "C"],
+    )
+    prim = casmconfig.Prim(xtal_prim)
+
+    for skip_non_canonical in [True, False]:
+        kwargs = dict(
+            supercells={"max": 3},
+            skip_non_canonical=skip_non_canonical,
+        )
+        config_enum = casmenum.ConfigEnumAllOccupations(prim=prim)
+        serial = [
+            (config_enum.enum_index, configuration)
+            for configuration in config_enum.by_supercell(**kwargs)
+        ]
+        assert config_enum.checkpoint() is not None
+
+        for n_before in [1, 5, len(serial) // 2, len(serial) - 1, len(serial)]:
+            # stop after `n_before` configurations, and checkpoint
+            config_enum = casmenum.ConfigEnumAllOccupations(prim=prim)
+            assert config_enum.checkpoint() is None
+            before = []
+            for configuration in config_enum.by_supercell(**kwargs):
+                before.append((config_enum.enum_index, configuration))
+                if len(before) == n_before:
+                    break
+            checkpoint = json.loads(json.dumps(config_enum.checkpoint()))
+
+            # resume in a new enumerator
+            config_enum = casmenum.ConfigEnumAllOccupations(prim=prim)
+            after = [
+                (config_enum.enum_index, configuration)
+                for configuration in config_enum.by_supercell(
+                    resume=checkpoint, **kwargs
+                )
+            ]
+            assert len(before) + len(after) == len(serial)
+            for x, y in zip(before + after, serial):
+                assert x[0] == y[0]
+                assert x[1] == y[1]
+
+
+def test_ConfigEnumAllOccupations_by_supercell_shards():
+    xtal_prim = xtal_prims.FCC(
+        r=0.5,
+        occ_dof=["A", "B", "C"],
+    )
+    prim = casmconfig.Prim(xtal_prim)
+
+    config_enum = casmenum.ConfigEnumAllOccupations(prim=prim)
+    expected = casmconfig.ConfigurationSet()
+    for configuration in config_enum.by_supercell(supercells={"max": 3}):
+        expected.add(configuration)
+    expected_names = [record.configuration_name for record in expected]
+
+    scel_enum = casmenum.ScelEnum(prim=prim)
+    supercells = list(scel_enum.by_volume(max=3))
+
+    for n_shards in [1, 2, 3, 20]:
+        # shard by ScelEnum
+        merged = casmconfig.ConfigurationSet()
+        for shard_index in range(n_shards):
+            shard = casmconfig.ConfigurationSet()
+            config_enum = casmenum.ConfigEnumAllOccupations(prim=prim)
+            for configuration in config_enum.by_supercell(
+                supercells={
+                    "max": 3,
+                    "shard_index": shard_index,
+                    "n_shards": n_shards,
+                },
+            ):
+                shard.add(configuration)
+            merged.merge(shard)
+        assert [record.configuration_name for record in merged] == expected_names
+
+        # shard a supercell list
+        merged = casmconfig.ConfigurationSet()
+        shards = []
+        for shard_index in range(n_shards):
+            shard = casmconfig.ConfigurationSet()
+            config_enum = casmenum.ConfigEnumAllOccupations(prim=prim)
+            for configuration in config_enum.by_supercell_list(
+                supercells=supercells,
+                shard_index=shard_index,
+                n_shards=n_shards,
+            ):
+                shard.add(configuration)
+            merged.merge(shard)
+            shards.append(shard)
+        assert [record.configuration_name for record in merged] == expected_names
+
+        # k-way merge of all shards
+        merged = casmconfig.ConfigurationSet.merged(shards, n_threads=2)
+        assert [record.configuration_name for record in merged] == expected_names
+
+    with pytest.raises(ValueError):
+        list(scel_enum.by_volume(max=3, shard_index=2, n_shards=2))
+
+
+def test_ConfigEnumAllOccupations_by_supercell_prefetch():
+    xtal_prim = xtal_prims.FCC(
+        r=0.5,
+        occ_dof=["A", "B", "C"],
+    )
+    prim = casmconfig.Prim(xtal_prim)
+
+    def enumerate_occupations(prefetch_batches, skip_non_canonical):
+        config_enum = casmenum.ConfigEnumAllOccupations(
+            prim=prim,
+            prefetch_batches=prefetch_batches,
+        )
+        assert config_enum.prefetch_batches == prefetch_batches
+        occupations = []
+        for configuration in config_enum.by_supercell(
+            supercells={"max": 4},
+            skip_non_canonical=skip_non_canonical,
+        ):
+            T = configuration.supercell.transformation_matrix_to_prim
+            occupations.append((T.tolist(), configuration.occupation.tolist()))
+        return occupations
+
+    # same configurations, in the same order
+    for skip_non_canonical in [True, False]:
+        expected = enumerate_occupations(0, skip_non_canonical)
+        assert enumerate_occupations(2, skip_non_canonical) == expected
+
+    # stopping early
+    config_enum = casmenum.ConfigEnumAllOccupations(prim=prim, prefetch_batches=4)
+    for i, configuration in enumerate(
+        config_enum.by_supercell(
+            supercells={"max": 4},
+            skip_non_canonical=False,
+        )
+    ):
+        if i == 10:
+            break
+
+    # the prefetcher iterates over next_batch results
+    supercell = casmconfig.Supercell(prim, np.eye(3, dtype=int) * 2)
+    background = casmconfig.Configuration(supercell)
+    sites = set(range(supercell.n_sites))
+    expected = ConfigEnumAllOccupationsBase(background, sites).next_batch(
+        max_size=10000
+    )
+    config_enum_base = ConfigEnumAllOccupationsBase(background, sites)
+    prefetcher = config_enum_base.prefetch(batch_size=100, n_batches_ahead=3)
+    assert prefetcher.n_batches_ahead() == 3
+    batches = list(prefetcher)
+    assert len(batches) == 66
+    assert [c.occupation.tolist() for batch in batches for c in batch] == [
+        c.occupation.tolist() for c in expected
+    ]
+
+
+def test_count_distinct_occupations_FCC():
+    xtal_prim = xtal_prims.FCC(
+        r=0.5,
+        occ_dof=["A", "B", "C"],
+    )
+    prim = casmconfig.Prim(xtal_prim)
+    supercell_set = casmconfig.SupercellSet(prim=prim)
+    scel_enum = casmenum.ScelEnum(
+        prim=prim,
+        supercell_set=supercell_set,
+    )
+    config_enum = casmenum.ConfigEnumAllOccupations(
+        prim=prim,
+        supercell_set=supercell_set,
+    )
+    for supercell in scel_enum.by_volume(max=4):
+        configurations = [
+            x
+            for x in config_enum.by_supercell_list(
+                supercells=[supercell],
+                skip_non_primitive=False,
+            )
+        ]
+        assert casmenum.count_distinct_occupations(supercell) == len(
+            configurations
+        )
+        n_A = sum(
+            1
+            for x in configurations
+            if list(x.occupation).count(0) == supercell.n_sites // 2
+        )
+        assert (
+            casmenum.count_distinct_occupations(
+                supercell, occupant_counts={"A": supercell.n_sites // 2}
+            )
+            == n_A
+        )
+
+    # exact, for counts larger than 64-bit integers
+    supercell = casmconfig.Supercell(prim, np.eye(3, dtype=int) * 6)
+    assert casmenum.count_distinct_occupations(supercell) > 2**64
+
+
+def test_ConfigEnumAllOccupations_estimate_by_supercell():
+    xtal_prim = xtal_prims.FCC(
+        r=0.5,
+        occ_dof=["A", "B"],
+    )
+    prim = casmconfig.Prim(xtal_prim)
+    config_enum = casmenum.ConfigEnumAllOccupations(prim=prim)
+
+    # few candidates: all tasks are enumerated, so counts are exact
+    estimate = config_enum.estimate_by_supercell(supercells={"max": 4})
+    assert estimate["n_configurations_is_exact"]
+    assert estimate["n_configurations"] == 29
+    assert estimate["seconds"] >= 0.0
+    assert estimate["bytes"] > 0.0
+    assert len(estimate["backgrounds"]) == estimate["n_backgrounds"]
+
+    # sampled
+    estimate = config_enum.estimate_by_supercell(
+        supercells={"min": 8, "max": 8},
+        max_sampled_tasks=2,
+        max_task_candidates=16.0,
+    )
+    assert not estimate["n_configurations_is_exact"]
+    assert estimate["n_candidates"] == 256 * estimate["n_backgrounds"]
+    for data in estimate["backgrounds"]:
+        assert data["n_sampled_tasks"] == 2
+        assert data["n_tasks"] == 16.0
@@ -830,3 +830,134 @@ def test_ConfigEnumMeshGrid_by_irreducible_wedge_FCC_disp_2():
     assert total == 34992  # 3**6 * len(symmetry_report.irreducible_wedge)
     assert len(configs_as_enumerated) == 19575
     assert len(canonical_configs) == 11413
+
+
+def test_ConfigEnumMeshGrid_by_range_prefetch():
+    """Test ConfigEnumMeshGrid.by_range, with prefetch_batches > 0
+
+    Using:
+    - FCC,
+    - prim unit cell, default background,
+    - full basis, skip_equivalents=False
+    """
+    xtal_prim = xtal_prims.FCC(
+        r=0.5,
+        occ_dof=["A", "B"],
+        global_dof=[xtal.DoFSetBasis("Hstrain")],
+    )
+    prim = casmconfig.Prim(xtal_prim)
+    dof_space = casmclex.DoFSpace(
+        dof_key="Hstrain",
+        xtal_prim=xtal_prim,
+    )
+    supercell = casmconfig.Supercell(prim, np.eye(3, dtype=int))
+    background = casmconfig.Configuration(supercell)
+
+    def enumerate_order_parameters(prefetch_batches):
+        config_enum = casmenum.ConfigEnumMeshGrid(
+            prim=prim,
+            prefetch_batches=prefetch_batches,
+        )
+        points = []
+        for configuration in config_enum.by_range(
+            background=background,
+            dof_space=dof_space,
+            start=-0.1,
+            stop=0.1,
+            num=5,
+        ):
+            points.append(config_enum.order_parameters.tolist())
+        return points
+
+    expected = enumerate_order_parameters(0)
+    assert len(expected) == 5**6
+    assert enumerate_order_parameters(3) == expected
+
+
+def test_ConfigEnumMeshGrid_by_irreducible_wedge_sampling_FCC_1():
+    """Test ConfigEnumMeshGrid.by_irreducible_wedge_sampling and
+    ConfigEnumMeshGrid.by_refinement_sampling
+
+    Using:
+    - FCC,
+    - prim unit cell, default background,
+    - full basis,
+    - stop=0.1, n_points=100
+    """
+    xtal_prim = xtal_prims.FCC(
+        r=0.5,
+        occ_dof=["A", "B"],
+        global_dof=[xtal.DoFSetBasis("Hstrain")],
+    )
+    prim = casmconfig.Prim(xtal_prim)
+    dof_space = casmclex.DoFSpace(
+        dof_key="Hstrain",
+        xtal_prim=xtal_prim,
+    )
+    dof_space_analysis_results = casmconfig.dof_space_analysis(
+        dof_space=dof_space,
+        prim=prim,
+        calc_wedges=True,
+    )
+    irreducible_wedge = dof_space_analysis_results.symmetry_report.irreducible_wedge
+    supercell = casmconfig.Supercell(prim, np.eye(3, dtype=int))
+    background = casmconfig.Configuration(supercell)
+    config_enum = casmenum.ConfigEnumMeshGrid(prim=prim)
+
+    for method in ["sobol", "latin_hypercube", "uniform"]:
+        points = []
+        subwedge_indices = []
+        for configuration in config_enum.by_irreducible_wedge_sampling(
+            background=background,
+            dof_space=dof_space,
+            irreducible_wedge=irreducible_wedge,
+            stop=0.1,
+            n_points=100,
+            method=method,
+        ):
+            assert isinstance(configuration, casmconfig.Configuration)
+            points.append(config_enum.order_parameters)
+            subwedge_indices.append(config_enum.subwedge_index)
+        if method == "latin_hypercube":
+            # trimmed points are not replaced
+            assert 0 < len(points) <= 100 * len(irreducible_wedge)
+        else:
+            assert len(points) == 100 * len(irreducible_wedge)
+        assert sorted(set(subwedge_indices)) == list(range(len(irreducible_wedge)))
+
+    # refinement around the first 5 sobol points, weighted
+    centers = np.array(points[:5])
+    centers_subwedge_indices = subwedge_indices[:5]
+    n_points = [1, 2, 3, 4, 5]
+    total = 0
+    for configuration in config_enum.by_refinement_sampling(
+        background=background,
+        dof_space=dof_space,
+        irreducible_wedge=irreducible_wedge,
+        stop=0.1,
+        centers=centers,
+        subwedge_indices=centers_subwedge_indices,
+        half_width=0.01,
+        n_points=n_points,
+        method="uniform",
+        trim_corners=False,
+    ):
+        assert config_enum.subwedge_index in centers_subwedge_indices
+        total += 1
+    assert total == sum(n_points)
+
+    # invalid method
+    try:
+        next(
+            config_enum.by_irreducible_wedge_sampling(
+                background=background,
+                dof_space=dof_space,
+                irreducible_wedge=irreducible_wedge,
+                stop=0.1,
+                n_points=10,
+                method="grid",
+            )
+        )
+        assert False
+    except Exception:
+        pass
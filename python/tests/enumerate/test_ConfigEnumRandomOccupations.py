@@ -0,0 +1,43 @@
+import numpy as np
+
+import libcasm.configuration as casmconfig
+import libcasm.enumerate as casmenum
+import libcasm.xtal.prims as xtal_prims
+
+
+def test_ConfigEnumRandomOccupations_FCC():
+    xtal_prim = xtal_prims.FCC(r=0.5, occ_dof=["A", "B"])
+    prim = casmconfig.Prim(xtal_prim)
+    supercell = casmconfig.Supercell(prim, np.eye(3, dtype=int) * 4)
+    background = casmconfig.Configuration(supercell)
+
+    composition = casmenum.make_sublattice_composition(
+        supercell=supercell,
+        sublattice_indices={0},
+        occupant_fractions={"A": 0.75, "B": 0.25},
+    )
+    assert len(composition.site_indices) == 64
+    assert composition.occupant_counts == {"A": 48, "B": 16}
+
+    def generate(n_threads):
+        generator = casmenum.ConfigEnumRandomOccupations(
+            background=background,
+            compositions=[composition],
+            seed=7,
+            n_threads=n_threads,
+        )
+        configurations = generator.next_batch(max_size=20, max_attempts=1000)
+        assert generator.n_unique() == len(configurations)
+        return configurations
+
+    configurations = generate(1)
+    assert len(configurations) == 20
+    distinct = casmconfig.ConfigurationSet()
+    for configuration in configurations:
+        assert configuration.occupation.sum() == 16
+        assert casmconfig.is_canonical_configuration(configuration)
+        distinct.add(configuration)
+    assert len(distinct) == 20
+    assert [x.occupation.tolist() for x in generate(4)] == [
+        x.occupation.tolist() for x in configurations
+    ]
@@ -104,3 +104,25 @@ def test_ScelEnum_lowsym_1(lowsym_occ_prim):
         assert isinstance(supercell, casmconfig.Supercell)
 
     assert len(supercell_set) == 56
+
+
+def test_ScelEnum_FCC_canonical_and_shards():
+    xtal_prim = xtal_prims.FCC(
+        r=0.5,
+        occ_dof=["A", "B"],
+    )
+    prim = casmconfig.Prim(xtal_prim)
+    scel_enum = casmenum.ScelEnum(prim=prim)
+    supercells = list(scel_enum.by_volume(max=6))
+    assert len(supercells) == 28
+    for supercell in supercells:
+        assert casmconfig.is_canonical_supercell(supercell)
+
+    n_shards = 3
+    combined = [None] * len(supercells)
+    for shard_index in range(n_shards):
+        shard = scel_enum.by_volume(max=6, shard_index=shard_index, n_shards=n_shards)
+        for i, supercell in enumerate(shard):
+            combined[i * n_shards + shard_index] = supercell
+    for a, b in zip(combined, supercells):
+        assert a == b
@@ -22,6 +22,11 @@ def test_make_occevent_suborbits(fcc_1NN_A_Va_event):
     orbit = make_occevent_orbit(prim, occ_event)
     assert len(orbit) == 6
 
+    # prim rep, shared by prim
+    prim_rep = enum.make_prim_occevent_symgroup_rep(prim)
+    assert len(prim_rep) == len(prim.factor_group.elements)
+    assert occ_events.make_prim_periodic_orbit(occ_event, prim_rep) == orbit
+
     # conventional 4-site FCC
     T_motif = np.array(
         [
@@ -116,3 +121,30 @@ def test_make_all_distinct_local_perturbations(fcc_1NN_A_Va_event):
         print()
 
     assert len(configurations) == 9
+
+    # batched images match the interpolated structures
+    factors = [0.0, 0.5, 1.0]
+    for c in configurations:
+        images = enum.make_occevent_images(
+            c, [phenomenal_occ_event], factors, system
+        )
+        assert images.n_events() == 1
+        assert images.n_images == len(factors)
+        structures = enum.make_occevent_simple_structures(
+            c, phenomenal_occ_event, factors, system, False
+        )
+        for k, structure in enumerate(structures):
+            begin = images.image_begin(0, k)
+            coords = images.coords[:, begin : begin + images.n_atoms(0)]
+            assert np.allclose(coords, structure.atom_coordinate_cart())
+            names = system.chemical_name_list()
+            types = [names[i] for i in images.atom_type]
+            assert types == structure.atom_type()
+
+    # multi-threaded results are the same
+    configurations_mt = enum.make_all_distinct_local_perturbations(
+        supercell, phenomenal_occ_event, motif, local_clusters, n_threads=4
+    )
+    assert len(configurations_mt) == len(configurations)
+    for c, c_mt in zip(configurations, configurations_mt):
+        assert (c.occupation == c_mt.occupation).all()
@@ -0,0 +1,162 @@
+#include "casm/configuration/CanonicalPrimitiveCache.hh"
+
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/memory_usage.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Constructor
+///
+/// \param _max_size If more than this number of canonical primitive
+///     configurations are held, least recently used entries are evicted
+///     (default=100000)
+CanonicalPrimitiveCache::CanonicalPrimitiveCache(Index _max_size)
+    : m_max_size(_max_size), m_total_bytes(0) {}
+
+/// \brief Return the canonical primitive configuration, in the canonical
+///     supercell
+///
+/// \returns The shared result, equal to
+///     `make_in_canonical_supercell(make_primitive(configuration))`
+std::shared_ptr<Configuration const>
+CanonicalPrimitiveCache::canonical_primitive(
+    Configuration const &configuration) {
+  return canonical_primitive_of_primitive(make_primitive(configuration));
+}
+
+/// \brief Return the canonical primitive configuration, in the canonical
+///     supercell, of a primitive configuration
+///
+/// \param primitive A primitive configuration, as from `make_primitive`
+///
+/// \returns The shared result, equal to
+///     `make_in_canonical_supercell(primitive)`
+std::shared_ptr<Configuration const>
+CanonicalPrimitiveCache::canonical_primitive_of_primitive(
+    Configuration const &primitive) {
+  key_type key(primitive.supercell->prim.get(), primitive);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+      m_lru.splice(m_lru.begin(), m_lru, it->second);
+      return it->second->value;
+    }
+  }
+
+  // construct without holding the lock
+  auto value = std::make_shared<Configuration const>(
+      make_in_canonical_supercell(primitive));
+
+  // key and value configurations, and list and map nodes
+  Index bytes = key.second.memory_bytes() + value->memory_bytes() +
+                sizeof(Entry) + sizeof(key_type) + 8 * sizeof(void *);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+      m_lru.splice(m_lru.begin(), m_lru, it->second);
+      return it->second->value;
+    }
+    m_lru.push_front(Entry{key, value, bytes});
+    m_index.emplace(std::move(key), m_lru.begin());
+    m_total_bytes += bytes;
+    _evict();
+  }
+  enforce_memory_budget();
+  return value;
+}
+
+/// \brief Return the canonical form of a configuration in its supercell,
+///     and its canonical primitive configuration
+///
+/// \returns A pair of the canonical form of `configuration` with respect to
+///     all operations of its supercell, as by
+///     `make_canonical_form_via_primitive`, and the shared canonical
+///     primitive configuration, as by `canonical_primitive`. The
+///     primitive configuration is only made once.
+std::pair<Configuration, std::shared_ptr<Configuration const>>
+CanonicalPrimitiveCache::make_canonical_form(
+    Configuration const &configuration) {
+  Configuration primitive = make_primitive(configuration);
+  return std::make_pair(
+      make_canonical_form_via_primitive(configuration, primitive),
+      canonical_primitive_of_primitive(primitive));
+}
+
+/// \brief Maximum number of entries
+Index CanonicalPrimitiveCache::max_size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_max_size;
+}
+
+/// \brief Set the maximum number of entries
+///
+/// Least recently used entries are evicted immediately if more than
+/// `_max_size` are held.
+void CanonicalPrimitiveCache::set_max_size(Index _max_size) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_max_size = _max_size;
+  _evict();
+}
+
+/// \brief Number of cached canonical primitive configurations
+Index CanonicalPrimitiveCache::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_lru.size();
+}
+
+/// \brief Memory used by cached entries, in bytes (approximate)
+///
+/// Counts the key and value configurations, not including their shared
+/// supercells, and a fixed size for each entry.
+Index CanonicalPrimitiveCache::total_bytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_total_bytes;
+}
+
+/// \brief Evict least recently used entries until the memory used by
+///     cached entries is at most `max_total_bytes`
+///
+/// The maximum number of entries, `max_size()`, is not changed.
+///
+/// \returns The memory used by the evicted entries, in bytes
+Index CanonicalPrimitiveCache::evict_to(Index max_total_bytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Index initial_total_bytes = m_total_bytes;
+  while (m_total_bytes > max_total_bytes && !m_lru.empty()) {
+    m_total_bytes -= m_lru.back().bytes;
+    m_index.erase(m_lru.back().key);
+    m_lru.pop_back();
+  }
+  return initial_total_bytes - m_total_bytes;
+}
+
+/// \brief Clear all cached canonical primitive configurations
+void CanonicalPrimitiveCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_lru.clear();
+  m_index.clear();
+  m_total_bytes = 0;
+}
+
+/// \brief Evict least recently used entries, requires holding m_mutex
+void CanonicalPrimitiveCache::_evict() {
+  while (Index(m_lru.size()) > m_max_size && !m_lru.empty()) {
+    m_total_bytes -= m_lru.back().bytes;
+    m_index.erase(m_lru.back().key);
+    m_lru.pop_back();
+  }
+}
+
+/// \brief Process-wide CanonicalPrimitiveCache
+CanonicalPrimitiveCache &default_canonical_primitive_cache() {
+  static CanonicalPrimitiveCache cache;
+  return cache;
+}
+
+}  // namespace config
+}  // namespace CASM
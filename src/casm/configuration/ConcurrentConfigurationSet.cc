@@ -0,0 +1,177 @@
+#include "casm/configuration/ConcurrentConfigurationSet.hh"
+
+#include <functional>
+
+#include "casm/configuration/supercell_name.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Constructor
+///
+/// \param _next_config_id Initial IDs, by supercell_name, used to
+///     automatically ID new configurations
+/// \param n_shards Number of independently locked shards. Must be >= 1.
+ConcurrentConfigurationSet::ConcurrentConfigurationSet(
+    std::map<std::string, Index> _next_config_id, Index n_shards) {
+  if (n_shards < 1) {
+    throw std::runtime_error(
+        "Error in ConcurrentConfigurationSet: n_shards must be >= 1");
+  }
+  for (Index i = 0; i < n_shards; ++i) {
+    m_shards.emplace_back(std::make_unique<Shard>());
+  }
+  std::vector<std::map<std::string, Index>> shard_next_config_id(n_shards);
+  for (auto const &name_id : _next_config_id) {
+    Index i = std::hash<std::string>()(name_id.first) % n_shards;
+    shard_next_config_id[i].insert(name_id);
+  }
+  for (Index i = 0; i < n_shards; ++i) {
+    m_shards[i]->configurations.set_next_config_id(shard_next_config_id[i]);
+  }
+}
+
+/// \brief Insert Configuration, setting supercell_name and
+///     configuration_id automatically
+///
+/// \returns The configuration_name of the inserted or existing
+///     configuration, and true if the configuration was inserted.
+std::pair<std::string, bool> ConcurrentConfigurationSet::insert(
+    Configuration const &configuration) {
+  std::string const &supercell_name = configuration.supercell->name;
+  return this->insert(supercell_name, configuration);
+}
+
+/// \brief Insert Configuration with known supercell_name, setting
+///     configuration_id automatically
+///
+/// \returns The configuration_name of the inserted or existing
+///     configuration, and true if the configuration was inserted.
+std::pair<std::string, bool> ConcurrentConfigurationSet::insert(
+    std::string const &supercell_name, Configuration const &configuration) {
+  Shard &shard = _shard(supercell_name);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto result = shard.configurations.insert(supercell_name, configuration);
+  return std::make_pair(result.first->configuration_name, result.second);
+}
+
+/// \brief Insert ConfigurationRecord, allowing custom configuration_id
+bool ConcurrentConfigurationSet::insert(ConfigurationRecord const &record) {
+  Shard &shard = _shard(record.supercell_name);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  return shard.configurations.insert(record).second;
+}
+
+ConcurrentConfigurationSet::size_type ConcurrentConfigurationSet::count(
+    Configuration const &configuration) const {
+  std::string const &supercell_name = configuration.supercell->name;
+  Shard &shard = _shard(supercell_name);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  return shard.configurations.count(configuration);
+}
+
+ConcurrentConfigurationSet::size_type ConcurrentConfigurationSet::size()
+    const {
+  size_type n = 0;
+  for (auto const &shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    n += shard->configurations.size();
+  }
+  return n;
+}
+
+/// \brief Copy all configurations and next configuration ids into a
+///     ConfigurationSet
+ConfigurationSet ConcurrentConfigurationSet::to_configuration_set() const {
+  ConfigurationSet result;
+  std::map<std::string, Index> next_config_id;
+  for (auto const &shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    for (auto const &record : shard->configurations) {
+      result.insert(record);
+    }
+    for (auto const &name_id : shard->configurations.next_config_id()) {
+      next_config_id.insert(name_id);
+    }
+  }
+  result.set_next_config_id(next_config_id);
+  return result;
+}
+
+ConcurrentConfigurationSet::Shard &ConcurrentConfigurationSet::_shard(
+    std::string const &supercell_name) const {
+  return *m_shards[std::hash<std::string>()(supercell_name) % m_shards.size()];
+}
+
+ConcurrentSupercellSet::ConcurrentSupercellSet(
+    std::shared_ptr<Prim const> const &_prim)
+    : m_supercells(_prim) {}
+
+std::shared_ptr<Prim const> ConcurrentSupercellSet::prim() const {
+  return m_supercells.prim();
+}
+
+std::pair<SupercellRecord const *, bool> ConcurrentSupercellSet::insert(
+    std::shared_ptr<Supercell const> supercell) {
+  // constructing a record makes supercell names, so do it before locking
+  SupercellRecord record(supercell);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto result = m_supercells.insert(record);
+  return std::make_pair(&*result.first, result.second);
+}
+
+std::pair<SupercellRecord const *, bool> ConcurrentSupercellSet::insert(
+    Eigen::Matrix3l const &transformation_matrix_to_super) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_supercells.find(transformation_matrix_to_super);
+    if (it != m_supercells.end()) {
+      return std::make_pair(&*it, false);
+    }
+  }
+  return this->insert(
+      make_shared_supercell(prim(), transformation_matrix_to_super));
+}
+
+/// \brief Insert a canonical supercell by name
+///
+/// \param supercell_name The name of a canonical supercell
+///
+/// Throws if `supercell_name` is not the name of a canonical supercell.
+std::pair<SupercellRecord const *, bool>
+ConcurrentSupercellSet::insert_canonical(std::string supercell_name) {
+  if (SupercellRecord const *record = find_canonical_by_name(supercell_name)) {
+    return std::make_pair(record, false);
+  }
+  // construct and validate the supercell without holding the lock
+  SupercellSet tmp(prim());
+  SupercellRecord record = *tmp.insert_canonical(supercell_name).first;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto result = m_supercells.insert(record);
+  return std::make_pair(&*result.first, result.second);
+}
+
+/// \brief Find a canonical supercell by name, or return nullptr
+SupercellRecord const *ConcurrentSupercellSet::find_canonical_by_name(
+    std::string name) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_supercells.find_canonical_by_name(name);
+  if (it == m_supercells.end()) {
+    return nullptr;
+  }
+  return &*it;
+}
+
+ConcurrentSupercellSet::size_type ConcurrentSupercellSet::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_supercells.size();
+}
+
+/// \brief Access the underlying SupercellSet; not safe during concurrent
+///     insertion
+SupercellSet const &ConcurrentSupercellSet::data() const {
+  return m_supercells;
+}
+
+}  // namespace config
+}  // namespace CASM
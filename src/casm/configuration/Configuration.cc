@@ -31,6 +31,22 @@ bool Configuration::operator<(Configuration const &rhs) const {
   return compare(rhs);
 }
 
+/// \brief Memory used by the configuration, in bytes, not including the
+///     shared supercell
+///
+/// Counts the DoF value entries and the DoF keys.
+Index Configuration::memory_bytes() const {
+  Index bytes = sizeof(Configuration) +
+                dof_values.occupation.size() * sizeof(int);
+  for (auto const &pair : dof_values.local_dof_values) {
+    bytes += pair.first.capacity() + pair.second.size() * sizeof(double);
+  }
+  for (auto const &pair : dof_values.global_dof_values) {
+    bytes += pair.first.capacity() + pair.second.size() * sizeof(double);
+  }
+  return bytes;
+}
+
 /// \brief Equality comparison of Configuration
 ///
 /// - Must have the same Prim
@@ -0,0 +1,311 @@
+#include "casm/configuration/ConfigurationBatch.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/SupercellSymInfo.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/make_simple_structure.hh"
+#include "casm/configuration/parallel.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// Number of configurations converted to Configuration at a time, per
+/// thread, by make_canonical_forms
+Index const batch_block_size = 256;
+
+/// \brief Copy the values of configuration `i` of a batch into a
+///     configuration in the batch supercell
+///
+/// DoF that are not stored in the batch are set to zero.
+void load(ConfigurationBatch const &batch, Index i,
+          Configuration &configuration) {
+  auto &dof_values = configuration.dof_values;
+  dof_values.occupation = batch.occupation.row(i).transpose().cast<int>();
+  for (auto &pair : dof_values.global_dof_values) {
+    auto it = batch.global_dof_values.find(pair.first);
+    if (it == batch.global_dof_values.end()) {
+      pair.second.setZero();
+    } else {
+      pair.second = it->second.row(i).transpose();
+    }
+  }
+  for (auto &pair : dof_values.local_dof_values) {
+    auto it = batch.local_dof_values.find(pair.first);
+    if (it == batch.local_dof_values.end()) {
+      pair.second.setZero();
+    } else {
+      pair.second = Eigen::Map<Eigen::MatrixXd const>(
+          it->second.row(i).data(), pair.second.rows(), pair.second.cols());
+    }
+  }
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _supercell The shared supercell of all configurations
+/// \param n_configurations The initial number of configurations, with all
+///     DoF values zero
+/// \param include_continuous_dof If true, include arrays for all global and
+///     local continuous DoF of the prim. If false, only store occupation.
+ConfigurationBatch::ConfigurationBatch(
+    std::shared_ptr<Supercell const> const &_supercell,
+    Index n_configurations, bool include_continuous_dof)
+    : supercell(_supercell) {
+  if (supercell == nullptr) {
+    throw std::runtime_error(
+        "Error constructing ConfigurationBatch: supercell == nullptr");
+  }
+  occupation = OccupationArray::Zero(n_configurations, n_sites());
+  if (include_continuous_dof) {
+    Configuration default_configuration(supercell);
+    auto const &dof_values = default_configuration.dof_values;
+    for (auto const &pair : dof_values.global_dof_values) {
+      global_dof_values.emplace(
+          pair.first, ValuesArray::Zero(n_configurations, pair.second.size()));
+    }
+    for (auto const &pair : dof_values.local_dof_values) {
+      local_dof_values.emplace(
+          pair.first, ValuesArray::Zero(n_configurations, pair.second.size()));
+    }
+  }
+}
+
+/// \brief Number of configurations
+Index ConfigurationBatch::size() const { return occupation.rows(); }
+
+/// \brief Number of sites in the supercell
+Index ConfigurationBatch::n_sites() const {
+  return supercell->unitcellcoord_index_converter.total_sites();
+}
+
+/// \brief Change the number of configurations, keeping existing values and
+///     setting new values to zero
+void ConfigurationBatch::resize(Index n_configurations) {
+  Index n_before = size();
+  auto _resize = [&](auto &array) {
+    array.conservativeResize(n_configurations, Eigen::NoChange);
+    if (n_configurations > n_before) {
+      array.bottomRows(n_configurations - n_before).setZero();
+    }
+  };
+  _resize(occupation);
+  for (auto &pair : global_dof_values) {
+    _resize(pair.second);
+  }
+  for (auto &pair : local_dof_values) {
+    _resize(pair.second);
+  }
+}
+
+/// \brief Make configuration `i`
+Configuration ConfigurationBatch::configuration(Index i) const {
+  Configuration _configuration(supercell);
+  load(*this, i, _configuration);
+  return _configuration;
+}
+
+/// \brief Set the values of configuration `i`
+///
+/// The configuration must be in the batch supercell. Values of DoF that are
+/// not stored in the batch are ignored.
+void ConfigurationBatch::set(Index i, Configuration const &configuration) {
+  if (configuration.supercell != supercell &&
+      *configuration.supercell != *supercell) {
+    throw std::runtime_error(
+        "Error in ConfigurationBatch::set: configuration is not in the batch "
+        "supercell");
+  }
+  auto const &dof_values = configuration.dof_values;
+  occupation.row(i) = dof_values.occupation.transpose().cast<std::int8_t>();
+  for (auto &pair : global_dof_values) {
+    auto it = dof_values.global_dof_values.find(pair.first);
+    if (it == dof_values.global_dof_values.end()) {
+      throw std::runtime_error("Error in ConfigurationBatch::set: missing " +
+                               pair.first + " values");
+    }
+    pair.second.row(i) = it->second.transpose();
+  }
+  for (auto &pair : local_dof_values) {
+    auto it = dof_values.local_dof_values.find(pair.first);
+    if (it == dof_values.local_dof_values.end()) {
+      throw std::runtime_error("Error in ConfigurationBatch::set: missing " +
+                               pair.first + " values");
+    }
+    pair.second.row(i) = Eigen::Map<Eigen::RowVectorXd const>(
+        it->second.data(), it->second.size());
+  }
+}
+
+/// \brief Append a configuration
+///
+/// This reallocates all arrays, so to add many configurations use `resize`
+/// and then `set`.
+void ConfigurationBatch::push_back(Configuration const &configuration) {
+  resize(size() + 1);
+  set(size() - 1, configuration);
+}
+
+/// \brief Make the canonical forms of all configurations in a batch
+///
+/// Equivalent to `make_canonical_forms` for the configurations of the batch,
+/// converting at most a block of configurations per thread at a time.
+///
+/// \param batch The configurations
+/// \param n_threads The number of threads to use. If <= 0, uses
+///     `default_n_threads()`.
+/// \return A batch, with the same DoF arrays as `batch`, of the canonical
+///     forms, with respect to the supercell factor group
+ConfigurationBatch make_canonical_forms(ConfigurationBatch const &batch,
+                                        Index n_threads) {
+  ConfigurationBatch result(batch);
+  parallel_for_chunks(
+      batch.size(), n_threads, [&](Index chunk_index, Index begin, Index end) {
+        std::vector<Configuration> configurations;
+        for (Index block_begin = begin; block_begin < end;
+             block_begin += batch_block_size) {
+          Index block_end = std::min(end, block_begin + batch_block_size);
+          configurations.clear();
+          for (Index i = block_begin; i < block_end; ++i) {
+            configurations.push_back(batch.configuration(i));
+          }
+          std::vector<Configuration> canonical =
+              make_canonical_forms(configurations, batch.supercell, 1);
+          for (Index i = block_begin; i < block_end; ++i) {
+            result.set(i, canonical[i - block_begin]);
+          }
+        }
+      });
+  return result;
+}
+
+/// \brief Check if each configuration in a batch is primitive
+///
+/// \param batch The configurations
+/// \param n_threads The number of threads to use. If <= 0, uses
+///     `default_n_threads()`.
+/// \return `result(i)` is true if configuration `i` is primitive
+Eigen::Matrix<bool, Eigen::Dynamic, 1> is_primitive(
+    ConfigurationBatch const &batch, Index n_threads) {
+  Eigen::Matrix<bool, Eigen::Dynamic, 1> result(batch.size());
+  parallel_for_chunks(
+      batch.size(), n_threads, [&](Index chunk_index, Index begin, Index end) {
+        Configuration configuration(batch.supercell);
+        for (Index i = begin; i < end; ++i) {
+          load(batch, i, configuration);
+          result(i) = is_primitive(configuration);
+        }
+      });
+  return result;
+}
+
+/// \brief Count the distinct equivalents of each configuration in a batch
+///
+/// The number of distinct configurations obtained by applying the
+/// supercell symmetry operations (supercell factor group and translations)
+/// to each configuration, equal to the number of operations divided by the
+/// size of the invariant subgroup.
+///
+/// \param batch The configurations
+/// \param n_threads The number of threads to use. If <= 0, uses
+///     `default_n_threads()`.
+/// \return `result(i)` is the number of equivalents of configuration `i`
+Eigen::VectorXl make_n_equivalents(ConfigurationBatch const &batch,
+                                   Index n_threads) {
+  auto const &supercell = batch.supercell;
+  Index n_ops = supercell->sym_info().factor_group->element.size() *
+                supercell->unitcell_index_converter.total_sites();
+  Eigen::VectorXl result(batch.size());
+  parallel_for_chunks(
+      batch.size(), n_threads, [&](Index chunk_index, Index begin, Index end) {
+        Configuration configuration(supercell);
+        for (Index i = begin; i < end; ++i) {
+          load(batch, i, configuration);
+          Index n_invariant = make_invariant_subgroup(configuration).size();
+          result(i) = n_ops / n_invariant;
+        }
+      });
+  return result;
+}
+
+/// \brief Construct the atomic structures of all configurations in a batch
+///
+/// Equivalent to `make_atomic_structures` for the configurations of the
+/// batch.
+AtomicStructures make_atomic_structures(
+    ConfigurationBatch const &batch, std::string atom_type_naming_method,
+    std::set<std::string> excluded_species) {
+  std::vector<Configuration> configurations;
+  configurations.reserve(batch.size());
+  for (Index i = 0; i < batch.size(); ++i) {
+    configurations.push_back(batch.configuration(i));
+  }
+  return make_atomic_structures(configurations, atom_type_naming_method,
+                                excluded_species);
+}
+
+/// \brief Insert all configurations in a batch into a ConfigurationSet
+///
+/// Configurations are inserted as they are, setting configuration_id
+/// automatically, so as for `ConfigurationSet::insert` they must be in the
+/// canonical supercell.
+///
+/// \return The number of configurations that were not already in
+///     `configurations`
+Index insert_batch(ConfigurationSet &configurations,
+                   ConfigurationBatch const &batch) {
+  Index n_inserted = 0;
+  Configuration configuration(batch.supercell);
+  for (Index i = 0; i < batch.size(); ++i) {
+    load(batch, i, configuration);
+    if (configurations.insert(configuration).second) {
+      ++n_inserted;
+    }
+  }
+  return n_inserted;
+}
+
+/// \brief Make a batch of the configurations in a ConfigurationSet that are
+///     in one supercell
+///
+/// \param configurations The ConfigurationSet
+/// \param supercell The supercell. Configurations with supercell_name equal
+///     to `supercell->name` are included.
+/// \param configuration_ids If not nullptr, set to the configuration_id of
+///     each configuration in the batch
+/// \return A batch, including all continuous DoF, in the order of
+///     `configurations`
+ConfigurationBatch make_configuration_batch(
+    ConfigurationSet const &configurations,
+    std::shared_ptr<Supercell const> const &supercell,
+    std::vector<std::string> *configuration_ids) {
+  std::vector<ConfigurationRecord const *> records;
+  for (auto const &record : configurations) {
+    if (record.supercell_name == supercell->name) {
+      records.push_back(&record);
+    }
+  }
+  ConfigurationBatch batch(supercell, records.size());
+  if (configuration_ids) {
+    configuration_ids->clear();
+  }
+  for (Index i = 0; i < records.size(); ++i) {
+    batch.set(i, records[i]->configuration);
+    if (configuration_ids) {
+      configuration_ids->push_back(records[i]->configuration_id);
+    }
+  }
+  return batch;
+}
+
+}  // namespace config
+}  // namespace CASM
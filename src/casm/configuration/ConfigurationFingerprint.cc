@@ -0,0 +1,212 @@
+#include "casm/configuration/ConfigurationFingerprint.hh"
+
+#include <numeric>
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/clusterography/ClusterSpecs.hh"
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/crystallography/UnitCellCoordRep.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+Index find_root(std::vector<Index> &parent, Index i) {
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+}  // namespace
+
+bool ConfigurationFingerprint::operator<(
+    ConfigurationFingerprint const &rhs) const {
+  if (occupant_class_counts != rhs.occupant_class_counts) {
+    return occupant_class_counts < rhs.occupant_class_counts;
+  }
+  return pair_class_counts < rhs.pair_class_counts;
+}
+
+bool ConfigurationFingerprint::eq_impl(
+    ConfigurationFingerprint const &rhs) const {
+  return occupant_class_counts == rhs.occupant_class_counts &&
+         pair_class_counts == rhs.pair_class_counts;
+}
+
+/// \brief Constructor
+///
+/// \param _prim The prim
+/// \param max_pair_length Maximum site-to-site distance for pair clusters
+///     included in the fingerprint. If <= 0.0, only occupant class counts
+///     are included.
+ConfigurationFingerprintCalculator::ConfigurationFingerprintCalculator(
+    std::shared_ptr<Prim const> const &_prim, double max_pair_length)
+    : m_prim(_prim) {
+  auto const &basis = m_prim->basicstructure->basis();
+  auto const &sym_info = m_prim->sym_info;
+
+  // node for (b, occ) is first_node[b] + occ
+  std::vector<Index> first_node;
+  Index n_nodes = 0;
+  for (auto const &site : basis) {
+    first_node.push_back(n_nodes);
+    n_nodes += site.occupant_dof().size();
+  }
+
+  // join occupants that transform into each other
+  std::vector<Index> parent(n_nodes);
+  std::iota(parent.begin(), parent.end(), 0);
+  for (Index fg = 0; fg < sym_info.unitcellcoord_symgroup_rep.size(); ++fg) {
+    auto const &rep = sym_info.unitcellcoord_symgroup_rep[fg];
+    for (Index b = 0; b < basis.size(); ++b) {
+      xtal::UnitCellCoord ucc_after =
+          copy_apply(rep, xtal::UnitCellCoord(b, 0, 0, 0));
+      Index b_after = ucc_after.sublattice();
+      for (Index occ = 0; occ < basis[b].occupant_dof().size(); ++occ) {
+        Index occ_after = occ;
+        if (sym_info.has_aniso_occs) {
+          occ_after = sym_info.occ_symgroup_rep[fg][b][occ];
+        }
+        Index i = find_root(parent, first_node[b] + occ);
+        Index j = find_root(parent, first_node[b_after] + occ_after);
+        if (i != j) {
+          parent[std::max(i, j)] = std::min(i, j);
+        }
+      }
+    }
+  }
+
+  // number classes in order of first appearance
+  std::vector<Index> root_class(n_nodes, -1);
+  m_n_occupant_classes = 0;
+  m_occupant_class.resize(basis.size());
+  for (Index b = 0; b < basis.size(); ++b) {
+    for (Index occ = 0; occ < basis[b].occupant_dof().size(); ++occ) {
+      Index root = find_root(parent, first_node[b] + occ);
+      if (root_class[root] == -1) {
+        root_class[root] = m_n_occupant_classes++;
+      }
+      m_occupant_class[b].push_back(root_class[root]);
+    }
+  }
+
+  if (max_pair_length > 0.0) {
+    std::vector<double> max_length = {0.0, 0.0, max_pair_length};
+    auto orbits = clust::make_prim_periodic_orbits(
+        m_prim->basicstructure, sym_info.unitcellcoord_symgroup_rep,
+        clust::alloy_sites_filter, max_length, {});
+    for (auto const &orbit : orbits) {
+      if (orbit.begin()->size() == 2) {
+        m_pair_orbits.push_back(orbit);
+      }
+    }
+  }
+}
+
+/// \brief The prim
+std::shared_ptr<Prim const> const &ConfigurationFingerprintCalculator::prim()
+    const {
+  return m_prim;
+}
+
+/// \brief Number of occupant classes
+Index ConfigurationFingerprintCalculator::n_occupant_classes() const {
+  return m_n_occupant_classes;
+}
+
+/// \brief Occupant class, `occupant_class()[b][occ]`, for occupant `occ`
+///     on sublattice `b`
+std::vector<std::vector<Index>> const &
+ConfigurationFingerprintCalculator::occupant_class() const {
+  return m_occupant_class;
+}
+
+/// \brief Orbits of pair clusters included in the fingerprint
+std::vector<std::set<clust::IntegralCluster>> const &
+ConfigurationFingerprintCalculator::pair_orbits() const {
+  return m_pair_orbits;
+}
+
+/// \brief Make the fingerprint of a configuration
+///
+/// Pair clusters are counted once for each orbit element and each
+/// translation within the supercell, so periodic images are counted
+/// consistently for all equivalent configurations.
+ConfigurationFingerprint ConfigurationFingerprintCalculator::operator()(
+    Configuration const &configuration) const {
+  if (configuration.supercell->prim != m_prim) {
+    throw std::runtime_error(
+        "Error in ConfigurationFingerprintCalculator: configuration has a "
+        "different prim");
+  }
+  Supercell const &supercell = *configuration.supercell;
+  auto const &converter = supercell.unitcellcoord_index_converter;
+  auto const &unitcell_converter = supercell.unitcell_index_converter;
+  Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+  Index n_sites = converter.total_sites();
+  Index n_classes = m_n_occupant_classes;
+
+  std::vector<Index> site_class(n_sites);
+  for (Index l = 0; l < n_sites; ++l) {
+    site_class[l] = m_occupant_class[converter(l).sublattice()][occupation[l]];
+  }
+
+  ConfigurationFingerprint fingerprint;
+  fingerprint.occupant_class_counts.resize(n_classes, 0);
+  for (Index l = 0; l < n_sites; ++l) {
+    fingerprint.occupant_class_counts[site_class[l]] += 1;
+  }
+
+  std::vector<Index> &pair_counts = fingerprint.pair_class_counts;
+  pair_counts.resize(m_pair_orbits.size() * n_classes * n_classes, 0);
+  Index n_unitcells = unitcell_converter.total_sites();
+  for (Index o = 0; o < m_pair_orbits.size(); ++o) {
+    for (auto const &cluster : m_pair_orbits[o]) {
+      for (Index t = 0; t < n_unitcells; ++t) {
+        xtal::UnitCell translation = unitcell_converter(t);
+        Index c1 = site_class[converter(cluster[0] + translation)];
+        Index c2 = site_class[converter(cluster[1] + translation)];
+        if (c1 > c2) {
+          std::swap(c1, c2);
+        }
+        pair_counts[(o * n_classes + c1) * n_classes + c2] += 1;
+      }
+    }
+  }
+  return fingerprint;
+}
+
+/// \brief Return true if two configurations are equivalent by supercell
+///     symmetry, using fingerprints to skip symmetry checks when possible
+///
+/// Notes:
+/// - Configurations must be in the same supercell
+/// - Fingerprints must be made by the same
+///   ConfigurationFingerprintCalculator
+/// - If the fingerprints differ, returns false without applying any
+///   symmetry operations; otherwise, compares canonical forms
+bool is_equivalent(Configuration const &A,
+                   ConfigurationFingerprint const &A_fingerprint,
+                   Configuration const &B,
+                   ConfigurationFingerprint const &B_fingerprint) {
+  if (*A.supercell != *B.supercell) {
+    throw std::runtime_error(
+        "Error in is_equivalent: configurations must be in the same "
+        "supercell");
+  }
+  if (A_fingerprint != B_fingerprint) {
+    return false;
+  }
+  auto begin = SupercellSymOp::begin(A.supercell);
+  auto end = SupercellSymOp::end(A.supercell);
+  return make_canonical_form(A, begin, end) ==
+         make_canonical_form(B, begin, end);
+}
+
+}  // namespace config
+}  // namespace CASM
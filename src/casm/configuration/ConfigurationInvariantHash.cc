@@ -0,0 +1,288 @@
+#include "casm/configuration/ConfigurationInvariantHash.hh"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "casm/configuration/ConfigurationFingerprint.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/clusterography/ClusterSpecs.hh"
+#include "casm/configuration/clusterography/orbits.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// \brief Combine a value into an FNV-1a hash
+void hash_combine(std::uint64_t &hash, std::uint64_t value) {
+  std::uint64_t const fnv_prime = 1099511628211ULL;
+  for (int i = 0; i < 8; ++i) {
+    hash ^= (value >> (8 * i)) & 0xff;
+    hash *= fnv_prime;
+  }
+}
+
+/// \brief Make the orbits of sites with occupation DoF
+std::vector<std::set<clust::IntegralCluster>> make_alloy_orbits(
+    std::shared_ptr<Prim const> const &prim,
+    std::vector<double> const &max_length) {
+  return clust::make_prim_periodic_orbits(
+      prim->basicstructure, prim->sym_info.unitcellcoord_symgroup_rep,
+      clust::alloy_sites_filter, max_length, {});
+}
+
+}  // namespace
+
+/// \brief Constructor, using given orbits
+///
+/// \param _prim The prim
+/// \param _orbits Prim periodic orbits of clusters, as generated by
+///     `clust::make_prim_periodic_orbits`. Empty orbits and the null cluster
+///     orbit are skipped.
+///
+/// The number of counts for an orbit of clusters of size k is
+/// `n_occupant_classes()^k`, which is required to be less than 2^24.
+InvariantConfigurationHasher::InvariantConfigurationHasher(
+    std::shared_ptr<Prim const> const &_prim,
+    std::vector<std::set<clust::IntegralCluster>> const &_orbits)
+    : m_prim(_prim) {
+  ConfigurationFingerprintCalculator classes(m_prim, 0.0);
+  m_n_occupant_classes = classes.n_occupant_classes();
+  m_occupant_class = classes.occupant_class();
+
+  m_count_offsets.push_back(0);
+  for (auto const &orbit : _orbits) {
+    if (orbit.empty() || orbit.begin()->size() == 0) {
+      continue;
+    }
+    Index n_counts = 1;
+    for (Index i = 0; i < orbit.begin()->size(); ++i) {
+      n_counts *= m_n_occupant_classes;
+      if (n_counts >= (Index(1) << 24)) {
+        throw std::runtime_error(
+            "Error constructing InvariantConfigurationHasher: too many "
+            "occupant class combinations");
+      }
+    }
+    m_orbits.push_back(orbit);
+    m_count_offsets.push_back(m_count_offsets.back() + n_counts);
+  }
+}
+
+/// \brief Constructor, generating orbits of sites with occupation DoF
+///
+/// \param _prim The prim
+/// \param max_length Maximum site-to-site distance, by cluster size, as for
+///     `clust::make_prim_periodic_orbits`, with `clust::alloy_sites_filter`.
+InvariantConfigurationHasher::InvariantConfigurationHasher(
+    std::shared_ptr<Prim const> const &_prim,
+    std::vector<double> const &max_length)
+    : InvariantConfigurationHasher(_prim,
+                                   make_alloy_orbits(_prim, max_length)) {}
+
+/// \brief The prim
+std::shared_ptr<Prim const> const &InvariantConfigurationHasher::prim() const {
+  return m_prim;
+}
+
+/// \brief Number of occupant classes
+Index InvariantConfigurationHasher::n_occupant_classes() const {
+  return m_n_occupant_classes;
+}
+
+/// \brief Orbits of clusters included in the hash
+std::vector<std::set<clust::IntegralCluster>> const &
+InvariantConfigurationHasher::orbits() const {
+  return m_orbits;
+}
+
+/// \brief Make the cluster occupant class counts of a configuration
+///
+/// Usage:
+/// \code
+/// // classes on the cluster sites, sorted c_0 <= c_1 <= ... <= c_{k-1}
+/// Index code = c_0 + n_classes * (c_1 + n_classes * (c_2 + ...));
+/// Index count = counts[orbit_count_offset + code];
+/// \endcode
+/// where `orbit_count_offset` is the sum of `n_classes^k` of earlier orbits.
+std::vector<Index> InvariantConfigurationHasher::make_counts(
+    Configuration const &configuration) const {
+  if (configuration.supercell->prim != m_prim) {
+    throw std::runtime_error(
+        "Error in InvariantConfigurationHasher: configuration has a "
+        "different prim");
+  }
+  Supercell const &supercell = *configuration.supercell;
+  auto const &converter = supercell.unitcellcoord_index_converter;
+  auto const &unitcell_converter = supercell.unitcell_index_converter;
+  Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+  Index n_sites = converter.total_sites();
+
+  std::vector<Index> site_class(n_sites);
+  for (Index l = 0; l < n_sites; ++l) {
+    site_class[l] = m_occupant_class[converter(l).sublattice()][occupation[l]];
+  }
+
+  std::vector<Index> counts(m_count_offsets.back(), 0);
+  std::vector<Index> cluster_classes;
+  Index n_unitcells = unitcell_converter.total_sites();
+  for (Index t = 0; t < n_unitcells; ++t) {
+    xtal::UnitCell translation = unitcell_converter(t);
+    for (Index o = 0; o < m_orbits.size(); ++o) {
+      for (auto const &cluster : m_orbits[o]) {
+        cluster_classes.clear();
+        for (auto const &site : cluster) {
+          cluster_classes.push_back(site_class[converter(site + translation)]);
+        }
+        std::sort(cluster_classes.begin(), cluster_classes.end());
+        Index code = 0;
+        for (auto it = cluster_classes.rbegin(); it != cluster_classes.rend();
+             ++it) {
+          code = code * m_n_occupant_classes + *it;
+        }
+        counts[m_count_offsets[o] + code] += 1;
+      }
+    }
+  }
+  return counts;
+}
+
+/// \brief Make the hash of a configuration
+std::uint64_t InvariantConfigurationHasher::operator()(
+    Configuration const &configuration) const {
+  std::uint64_t hash = 14695981039346656037ULL;
+  Eigen::Matrix3l const &T =
+      configuration.supercell->superlattice.transformation_matrix_to_super();
+  for (Index i = 0; i < 3; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      hash_combine(hash, static_cast<std::uint64_t>(T(i, j)));
+    }
+  }
+  for (Index count : make_counts(configuration)) {
+    hash_combine(hash, static_cast<std::uint64_t>(count));
+  }
+  return hash;
+}
+
+/// \brief Constructor
+///
+/// \param _hasher Makes the hashes used to identify duplicates
+/// \param _verify_exact If true, configurations with equal hashes are only
+///     duplicates if they are in the same supercell and have equal
+///     canonical forms.
+InvariantHashConfigurationSet::InvariantHashConfigurationSet(
+    std::shared_ptr<InvariantConfigurationHasher const> const &_hasher,
+    bool _verify_exact)
+    : m_hasher(_hasher), m_verify_exact(_verify_exact) {
+  if (!m_hasher) {
+    throw std::runtime_error(
+        "Error constructing InvariantHashConfigurationSet: hasher is null");
+  }
+}
+
+/// \brief The hasher
+std::shared_ptr<InvariantConfigurationHasher const> const &
+InvariantHashConfigurationSet::hasher() const {
+  return m_hasher;
+}
+
+/// \brief If true, duplicates are verified by comparing canonical forms
+bool InvariantHashConfigurationSet::verify_exact() const {
+  return m_verify_exact;
+}
+
+bool InvariantHashConfigurationSet::empty() const { return m_data.empty(); }
+
+InvariantHashConfigurationSet::size_type InvariantHashConfigurationSet::size()
+    const {
+  return m_data.size();
+}
+
+void InvariantHashConfigurationSet::clear() {
+  m_data.clear();
+  m_index.clear();
+}
+
+InvariantHashConfigurationSet::const_iterator
+InvariantHashConfigurationSet::begin() const {
+  return m_data.begin();
+}
+
+InvariantHashConfigurationSet::const_iterator
+InvariantHashConfigurationSet::end() const {
+  return m_data.end();
+}
+
+/// \brief Insert a configuration, if no duplicate is present
+///
+/// \returns An iterator to the inserted configuration, or to the duplicate
+///     already present, and true if inserted.
+std::pair<InvariantHashConfigurationSet::const_iterator, bool>
+InvariantHashConfigurationSet::insert(Configuration const &configuration) {
+  std::uint64_t hash = (*m_hasher)(configuration);
+  std::shared_ptr<Configuration const> canonical_form;
+  auto it = _find(configuration, hash, canonical_form);
+  if (it != m_data.end()) {
+    return std::make_pair(it, false);
+  }
+  m_data.emplace_back(configuration, hash);
+  it = std::prev(m_data.end());
+  it->canonical_form = canonical_form;
+  m_index.emplace(hash, it);
+  return std::make_pair(it, true);
+}
+
+/// \brief Find a duplicate of a configuration
+InvariantHashConfigurationSet::const_iterator
+InvariantHashConfigurationSet::find(Configuration const &configuration) const {
+  std::shared_ptr<Configuration const> canonical_form;
+  return _find(configuration, (*m_hasher)(configuration), canonical_form);
+}
+
+/// \brief Count duplicates of a configuration (0 or 1)
+InvariantHashConfigurationSet::size_type InvariantHashConfigurationSet::count(
+    Configuration const &configuration) const {
+  return find(configuration) == m_data.end() ? 0 : 1;
+}
+
+/// \brief Find a duplicate of a configuration with the given hash
+///
+/// If `m_verify_exact` and there is an entry with an equal hash, the
+/// canonical form of `configuration` is made and returned in
+/// `canonical_form`.
+InvariantHashConfigurationSet::const_iterator
+InvariantHashConfigurationSet::_find(
+    Configuration const &configuration, std::uint64_t hash,
+    std::shared_ptr<Configuration const> &canonical_form) const {
+  auto range = m_index.equal_range(hash);
+  if (!m_verify_exact) {
+    return range.first == range.second ? m_data.end() : range.first->second;
+  }
+  auto make_canonical = [](Configuration const &c) {
+    return std::make_shared<Configuration const>(
+        make_canonical_form(c, SupercellSymOp::begin(c.supercell),
+                            SupercellSymOp::end(c.supercell)));
+  };
+  for (auto it = range.first; it != range.second; ++it) {
+    Entry const &entry = *it->second;
+    if (*entry.configuration.supercell != *configuration.supercell) {
+      continue;
+    }
+    if (!canonical_form) {
+      canonical_form = make_canonical(configuration);
+    }
+    if (!entry.canonical_form) {
+      entry.canonical_form = make_canonical(entry.configuration);
+    }
+    if (*entry.canonical_form == *canonical_form) {
+      return it->second;
+    }
+  }
+  return m_data.end();
+}
+
+}  // namespace config
+}  // namespace CASM
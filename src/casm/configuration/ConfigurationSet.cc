@@ -1,20 +1,415 @@
 #include "casm/configuration/ConfigurationSet.hh"
 
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <tuple>
+
+#include "casm/configuration/CanonicalPrimitiveCache.hh"
+#include "casm/configuration/ConfigCompare.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/parallel.hh"
 #include "casm/configuration/supercell_name.hh"
+#include "casm/crystallography/BasicStructure.hh"
 
 namespace CASM {
 namespace config {
 
+namespace {  // anonymous
+
+/// \brief Make canonical forms, in place, and return supercell names, in
+///     parallel
+std::vector<std::string> make_canonical_forms_and_names(
+    std::vector<Configuration> &configurations, Index n_threads) {
+  std::vector<std::string> supercell_names(configurations.size());
+  parallel_for_chunks(
+      configurations.size(), n_threads,
+      [&](Index chunk_index, Index begin, Index end) {
+        for (Index i = begin; i < end; ++i) {
+          Configuration &configuration = configurations[i];
+          auto const &supercell = configuration.supercell;
+          configuration = make_canonical_form(
+              configuration, SupercellSymOp::begin(supercell),
+              SupercellSymOp::end(supercell));
+          supercell_names[i] = supercell->name;
+        }
+      });
+  return supercell_names;
+}
+
+/// \brief Return the configuration_id as a number, if it is a
+///     non-negative integer as assigned automatically, else -1
+Index automatic_configuration_id(std::string const &configuration_id) {
+  if (configuration_id.empty() || configuration_id.size() > 18 ||
+      (configuration_id.size() > 1 && configuration_id[0] == '0')) {
+    return -1;
+  }
+  Index value = 0;
+  for (char c : configuration_id) {
+    if (c < '0' || c > '9') {
+      return -1;
+    }
+    value = value * 10 + (c - '0');
+  }
+  return value;
+}
+
+/// \brief Return the number of sites of each sublattice occupied by each
+///     allowed occupant, by (sublattice index, occupant name)
+std::map<std::pair<Index, std::string>, Index> make_occupant_counts(
+    Configuration const &configuration) {
+  auto const &supercell = *configuration.supercell;
+  auto const &basis = supercell.prim->basicstructure->basis();
+  std::map<std::pair<Index, std::string>, Index> counts;
+  for (Index b = 0; b < basis.size(); ++b) {
+    for (auto const &mol : basis[b].occupant_dof()) {
+      counts.emplace(std::make_pair(b, mol.name()), 0);
+    }
+  }
+  auto const &converter = supercell.unitcellcoord_index_converter;
+  Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+  for (Index l = 0; l < occupation.size(); ++l) {
+    Index b = converter(l).sublattice();
+    counts[std::make_pair(b, basis[b].occupant_dof()[occupation(l)].name())] +=
+        1;
+  }
+  return counts;
+}
+
+/// \brief Return the continuous DoF values of a configuration as one
+///     vector: global DoF values, then local DoF values, by DoF key
+Eigen::VectorXd make_continuous_dof_vector(Configuration const &configuration) {
+  clexulator::ConfigDoFValues const &dof_values = configuration.dof_values;
+  Index size = 0;
+  for (auto const &dof : dof_values.global_dof_values) {
+    size += dof.second.size();
+  }
+  for (auto const &dof : dof_values.local_dof_values) {
+    size += dof.second.size();
+  }
+  Eigen::VectorXd result(size);
+  Index begin = 0;
+  for (auto const &dof : dof_values.global_dof_values) {
+    result.segment(begin, dof.second.size()) = dof.second;
+    begin += dof.second.size();
+  }
+  for (auto const &dof : dof_values.local_dof_values) {
+    result.segment(begin, dof.second.size()) =
+        Eigen::Map<Eigen::VectorXd const>(dof.second.data(), dof.second.size());
+    begin += dof.second.size();
+  }
+  return result;
+}
+
+/// \brief Erase the entry `(key, it)` from a multimap index
+template <typename MultimapType, typename KeyType, typename IteratorType>
+void erase_index_entry(MultimapType &index, KeyType const &key,
+                       IteratorType it) {
+  auto range = index.equal_range(key);
+  for (auto index_it = range.first; index_it != range.second; ++index_it) {
+    if (index_it->second == it) {
+      index.erase(index_it);
+      return;
+    }
+  }
+}
+
+/// \brief Records of one supercell in one ConfigurationSet, as a range of
+///     the set
+struct SupercellRun {
+  Index set_index;
+  ConfigurationSet::const_iterator begin;
+  ConfigurationSet::const_iterator end;
+};
+
+/// \brief Less than comparison of supercells, by value
+struct SupercellPtrLess {
+  bool operator()(Supercell const *lhs, Supercell const *rhs) const {
+    return *lhs < *rhs;
+  }
+};
+
+/// \brief Merged records of one supercell
+struct MergedSupercellRecords {
+  std::vector<ConfigurationRecord> records;
+
+  /// Next configuration_id, if any records from sets after the first
+  /// were given a configuration_id automatically
+  std::optional<std::pair<std::string, Index>> next_config_id;
+};
+
+/// \brief Merge the records of one supercell, from runs in order of set
+///     index, as by `make_merged_configuration_set`
+MergedSupercellRecords merge_supercell_runs(
+    std::vector<SupercellRun> const &runs,
+    std::map<std::string, Index> const &first_next_config_id) {
+  typedef std::pair<ConfigurationSet::const_iterator, Index> head_type;
+
+  // the head with the least record, and of those the least set index, on top
+  auto greater = [&](head_type const &lhs, head_type const &rhs) {
+    if (lhs.first->configuration < rhs.first->configuration) {
+      return false;
+    }
+    if (rhs.first->configuration < lhs.first->configuration) {
+      return true;
+    }
+    return lhs.second > rhs.second;
+  };
+  std::priority_queue<head_type, std::vector<head_type>, decltype(greater)>
+      heads(greater);
+  for (Index i = 0; i < runs.size(); ++i) {
+    if (runs[i].begin != runs[i].end) {
+      heads.emplace(runs[i].begin, i);
+    }
+  }
+
+  // k-way merge: each distinct record is taken from the first set it is in
+  std::vector<ConfigurationRecord const *> unique;
+  std::vector<Index> unique_run;
+  while (!heads.empty()) {
+    head_type head = heads.top();
+    heads.pop();
+    if (unique.empty() ||
+        unique.back()->configuration < head.first->configuration) {
+      unique.push_back(&*head.first);
+      unique_run.push_back(head.second);
+    }
+    if (++head.first != runs[head.second].end) {
+      heads.push(head);
+    }
+  }
+
+  MergedSupercellRecords merged;
+  merged.records.reserve(unique.size());
+  for (ConfigurationRecord const *record : unique) {
+    merged.records.push_back(*record);
+  }
+  if (unique.empty()) {
+    return merged;
+  }
+
+  // records only in later sets are given configuration_id as if inserted by
+  // `ConfigurationSet::merge`, set by set, in order of configuration_id
+  std::string const &supercell_name = unique.front()->supercell_name;
+  typedef std::tuple<Index, Index, Index> key_type;
+  std::vector<key_type> automatic;
+  for (Index i = 0; i < unique.size(); ++i) {
+    SupercellRun const &run = runs[unique_run[i]];
+    if (run.set_index == 0) {
+      continue;
+    }
+    Index id = automatic_configuration_id(unique[i]->configuration_id);
+    if (id >= 0) {
+      automatic.emplace_back(run.set_index, id, i);
+    }
+  }
+  bool has_automatic = false;
+  for (auto const &run : runs) {
+    if (run.set_index == 0) {
+      continue;
+    }
+    for (auto it = run.begin; it != run.end && !has_automatic; ++it) {
+      has_automatic = automatic_configuration_id(it->configuration_id) >= 0;
+    }
+  }
+  if (!has_automatic) {
+    return merged;
+  }
+  std::sort(automatic.begin(), automatic.end());
+  auto it = first_next_config_id.find(supercell_name);
+  Index next_id = (it == first_next_config_id.end()) ? 0 : it->second;
+  for (auto const &key : automatic) {
+    ConfigurationRecord const &record = *unique[std::get<2>(key)];
+    merged.records[std::get<2>(key)] = ConfigurationRecord(
+        record.configuration, supercell_name, std::to_string(next_id));
+    ++next_id;
+  }
+  merged.next_config_id = std::make_pair(supercell_name, next_id);
+  return merged;
+}
+
+}  // namespace
+
 ConfigurationRecord::ConfigurationRecord(Configuration const &_configuration,
                                          std::string _supercell_name,
                                          std::string _configuration_id)
     : configuration(_configuration),
-      supercell_name(_supercell_name),
-      configuration_id(_configuration_id),
+      supercell_name(std::move(_supercell_name)),
+      configuration_id(std::move(_configuration_id)),
+      configuration_name(supercell_name + "/" + configuration_id) {}
+
+ConfigurationRecord::ConfigurationRecord(Configuration &&_configuration,
+                                         std::string _supercell_name,
+                                         std::string _configuration_id)
+    : configuration(std::move(_configuration)),
+      supercell_name(std::move(_supercell_name)),
+      configuration_id(std::move(_configuration_id)),
       configuration_name(supercell_name + "/" + configuration_id) {}
 
+/// \brief Make the supercell-independent canonical key of a configuration
+///
+/// The canonical primitive configuration is found using
+/// `default_canonical_primitive_cache()`.
+PrimitiveCanonicalKey make_primitive_canonical_key(
+    Configuration const &configuration) {
+  PrimitiveCanonicalKey key;
+  key.canonical_primitive =
+      default_canonical_primitive_cache().canonical_primitive(configuration);
+  key.supercell_name = key.canonical_primitive->supercell->name;
+  Eigen::VectorXi const &occupation =
+      key.canonical_primitive->dof_values.occupation;
+  key.occupation_bytes.resize(occupation.size());
+  for (Index l = 0; l < occupation.size(); ++l) {
+    key.occupation_bytes[l] = static_cast<char>(occupation[l]);
+  }
+  key.hash = make_configuration_hash(*key.canonical_primitive);
+  return key;
+}
+
+/// \brief True if keys are equal, including continuous DoF values of the
+///     canonical primitive configurations
+bool PrimitiveCanonicalKey::operator==(PrimitiveCanonicalKey const &rhs) const {
+  if (hash != rhs.hash || supercell_name != rhs.supercell_name ||
+      occupation_bytes != rhs.occupation_bytes) {
+    return false;
+  }
+  if (canonical_primitive == rhs.canonical_primitive) {
+    return true;
+  }
+  if (!canonical_primitive || !rhs.canonical_primitive) {
+    return false;
+  }
+  return *canonical_primitive == *rhs.canonical_primitive;
+}
+
+/// \brief Supercell-independent canonical key, made on first use
+///
+/// Not thread-safe for concurrent first use of the same record.
+PrimitiveCanonicalKey const &ConfigurationRecord::primitive_canonical_key()
+    const {
+  if (!m_primitive_canonical_key) {
+    m_primitive_canonical_key = std::make_shared<PrimitiveCanonicalKey const>(
+        make_primitive_canonical_key(configuration));
+  }
+  return *m_primitive_canonical_key;
+}
+
+/// \brief Make the operations that make a configuration canonical in its
+///     supercell
+///
+/// The results are the same as `to_canonical`, `from_canonical`, and
+/// `make_invariant_subgroup(...).size()` using all supercell operations, but
+/// are found in a single pass over the supercell operations: operations
+/// that give the canonical form are a coset of the invariant subgroup, so
+/// they are counted while finding the canonical form, and the count is kept
+/// only for the final canonical form.
+CanonicalOpInfo make_canonical_op_info(Configuration const &configuration) {
+  auto const &supercell = configuration.supercell;
+  auto begin = SupercellSymOp::begin(supercell);
+  auto end = SupercellSymOp::end(supercell);
+
+  ConfigCompare compare_f(configuration);
+  auto _to_canonical = begin;
+  auto _from_canonical = _to_canonical->inverse();
+  Index coset_size = 0;
+  for (auto it = begin; it < end; ++it) {
+    if (compare_f(*_to_canonical, *it)) {
+      _to_canonical = it;
+      _from_canonical = _to_canonical->inverse();
+      coset_size = 1;
+    } else if (!compare_f(*it, *_to_canonical)) {
+      auto it_inv = it->inverse();
+      if (it_inv < _from_canonical) {
+        _from_canonical = it_inv;
+      }
+      ++coset_size;
+    }
+  }
+
+  CanonicalOpInfo info;
+  info.to_canonical_factor_group_index =
+      _to_canonical->supercell_factor_group_index();
+  info.to_canonical_translation_index = _to_canonical->translation_index();
+  info.from_canonical_factor_group_index =
+      _from_canonical.supercell_factor_group_index();
+  info.from_canonical_translation_index = _from_canonical.translation_index();
+  info.invariant_subgroup_size = coset_size;
+  return info;
+}
+
+/// \brief Operations that make the configuration canonical, made on first
+///     use
+///
+/// As for `primitive_canonical_key`, the result is shared by copies of this
+/// record, so records looked up in a ConfigurationSet answer
+/// `to_canonical`, `from_canonical`, and `invariant_subgroup_size` in O(1)
+/// after the first use.
+CanonicalOpInfo const &ConfigurationRecord::canonical_op_info() const {
+  if (!m_canonical_op_info) {
+    m_canonical_op_info = std::make_shared<CanonicalOpInfo const>(
+        make_canonical_op_info(configuration));
+  }
+  return *m_canonical_op_info;
+}
+
+/// \brief Return rep that makes the configuration canonical
+///
+/// Equal to `to_canonical(configuration, begin, end)`, using all supercell
+/// operations.
+SupercellSymOp ConfigurationRecord::to_canonical() const {
+  CanonicalOpInfo const &info = canonical_op_info();
+  return SupercellSymOp(configuration.supercell,
+                        info.to_canonical_factor_group_index,
+                        info.to_canonical_translation_index);
+}
+
+/// \brief Return rep that makes the configuration from the canonical
+///     configuration
+///
+/// Equal to `from_canonical(configuration, begin, end)`, using all supercell
+/// operations.
+SupercellSymOp ConfigurationRecord::from_canonical() const {
+  CanonicalOpInfo const &info = canonical_op_info();
+  return SupercellSymOp(configuration.supercell,
+                        info.from_canonical_factor_group_index,
+                        info.from_canonical_translation_index);
+}
+
+/// \brief Number of supercell operations that leave the configuration
+///     invariant
+Index ConfigurationRecord::invariant_subgroup_size() const {
+  return canonical_op_info().invariant_subgroup_size;
+}
+
 ConfigurationSet::ConfigurationSet(std::map<std::string, Index> _next_config_id)
-    : m_next_config_id(_next_config_id) {}
+    : m_primitive_key_index_is_valid(false),
+      m_name_index_is_valid(false),
+      m_name_index_has_duplicates(false),
+      m_secondary_indexes_are_valid(false),
+      m_dof_values_index_is_valid(false),
+      m_next_config_id(_next_config_id) {}
+
+/// \brief Copy constructor, indexes are rebuilt on first use
+ConfigurationSet::ConfigurationSet(ConfigurationSet const &other)
+    : m_data(other.m_data),
+      m_primitive_key_index_is_valid(false),
+      m_name_index_is_valid(false),
+      m_name_index_has_duplicates(false),
+      m_secondary_indexes_are_valid(false),
+      m_dof_values_index_is_valid(false),
+      m_next_config_id(other.m_next_config_id) {}
+
+/// \brief Copy assignment, indexes are rebuilt on first use
+ConfigurationSet &ConfigurationSet::operator=(ConfigurationSet const &other) {
+  if (this != &other) {
+    m_data = other.m_data;
+    _invalidate_indexes();
+    m_next_config_id = other.m_next_config_id;
+  }
+  return *this;
+}
 
 bool ConfigurationSet::empty() const { return m_data.empty(); }
 
@@ -22,7 +417,52 @@ ConfigurationSet::size_type ConfigurationSet::size() const {
   return m_data.size();
 }
 
-void ConfigurationSet::clear() { return m_data.clear(); }
+void ConfigurationSet::clear() {
+  _invalidate_indexes();
+  m_data.clear();
+}
+
+/// \brief Memory used by the records and indexes, in bytes
+///     (approximate), not including the shared supercells
+///
+/// Counts the configurations and names of each record, and a fixed size for
+/// each container node and index entry. Indexes are only counted once
+/// built. Primitive canonical keys and canonical operations made on first
+/// use by a record are not counted.
+Index ConfigurationSet::memory_bytes() const {
+  Index const node_bytes = 4 * sizeof(void *);
+  Index const entry_bytes = node_bytes + sizeof(const_iterator);
+  Index bytes = sizeof(ConfigurationSet);
+  for (auto const &record : m_data) {
+    bytes += node_bytes + sizeof(ConfigurationRecord) -
+             sizeof(Configuration) + record.configuration.memory_bytes() +
+             record.supercell_name.capacity() +
+             record.configuration_id.capacity() +
+             record.configuration_name.capacity();
+  }
+  Index n_index_entries = 0;
+  if (m_primitive_key_index_is_valid) {
+    n_index_entries += m_index_by_primitive_key.size();
+  }
+  if (m_name_index_is_valid) {
+    n_index_entries += m_data.size();
+  }
+  if (m_secondary_indexes_are_valid) {
+    n_index_entries +=
+        m_index_by_supercell_name.size() + m_index_by_volume.size();
+    for (auto const &pair : m_index_by_occupant_count) {
+      n_index_entries += pair.second.size();
+    }
+  }
+  if (m_dof_values_index_is_valid) {
+    n_index_entries += m_data.size();
+  }
+  bytes += n_index_entries * entry_bytes;
+  for (auto const &pair : m_next_config_id) {
+    bytes += node_bytes + sizeof(pair) + pair.first.capacity();
+  }
+  return bytes;
+}
 
 ConfigurationSet::const_iterator ConfigurationSet::begin() const {
   return m_data.begin();
@@ -36,9 +476,7 @@ ConfigurationSet::const_iterator ConfigurationSet::end() const {
 ///     configuration_id automatically
 std::pair<ConfigurationSet::iterator, bool> ConfigurationSet::insert(
     Configuration const &configuration) {
-  auto const &superlattice = configuration.supercell->superlattice;
-  std::string supercell_name = make_supercell_name(superlattice.prim_lattice(),
-                                                   superlattice.superlattice());
+  std::string const &supercell_name = configuration.supercell->name;
   return this->insert(supercell_name, configuration);
 }
 
@@ -52,8 +490,8 @@ std::pair<ConfigurationSet::iterator, bool> ConfigurationSet::insert(
   }
   Index &configuration_id = it->second;
 
-  auto res = m_data.insert(ConfigurationRecord(
-      configuration, supercell_name, std::to_string(configuration_id)));
+  auto res = _insert_and_index(m_data.insert(ConfigurationRecord(
+      configuration, supercell_name, std::to_string(configuration_id))));
   if (res.second) {
     ++configuration_id;
   }
@@ -63,7 +501,223 @@ std::pair<ConfigurationSet::iterator, bool> ConfigurationSet::insert(
 /// \brief Insert ConfigurationRecord, allowing custom configuration_id
 std::pair<ConfigurationSet::iterator, bool> ConfigurationSet::insert(
     ConfigurationRecord const &record) {
-  return m_data.insert(record);
+  return _insert_and_index(m_data.insert(record));
+}
+
+/// \brief Insert Configuration, moving its DoF values into the set if
+///     inserted, setting supercell_name and configuration_id
+///     automatically
+///
+/// If not inserted, `configuration` is left unchanged.
+std::pair<ConfigurationSet::iterator, bool> ConfigurationSet::insert(
+    Configuration &&configuration) {
+  std::string const &supercell_name = configuration.supercell->name;
+  return this->insert(supercell_name, std::move(configuration));
+}
+
+/// \brief Insert Configuration with known supercell_name, moving its DoF
+///     values into the set if inserted, setting configuration_id
+///     automatically
+///
+/// The position is found once and used as the hint for insertion. If not
+/// inserted, `configuration` is left unchanged.
+std::pair<ConfigurationSet::iterator, bool> ConfigurationSet::insert(
+    std::string const &supercell_name, Configuration &&configuration) {
+  auto it = m_next_config_id.find(supercell_name);
+  if (it == m_next_config_id.end()) {
+    it = m_next_config_id.emplace(supercell_name, 0).first;
+  }
+  Index &configuration_id = it->second;
+
+  ConfigurationRecord record(std::move(configuration), supercell_name,
+                             std::to_string(configuration_id));
+  auto position = m_data.lower_bound(record);
+  if (position != m_data.end() && !(record < *position)) {
+    configuration = std::move(record.configuration);
+    return std::make_pair(position, false);
+  }
+  ++configuration_id;
+  return _insert_and_index(
+      std::make_pair(m_data.emplace_hint(position, std::move(record)), true));
+}
+
+/// \brief Insert ConfigurationRecord, moved from, allowing custom
+///     configuration_id
+std::pair<ConfigurationSet::iterator, bool> ConfigurationSet::insert(
+    ConfigurationRecord &&record) {
+  return _insert_and_index(m_data.insert(std::move(record)));
+}
+
+/// \brief Make canonical forms of many Configuration, in parallel, and
+///     insert them, setting supercell_name and configuration_id
+///     automatically
+///
+/// \param configurations Configurations to insert. Supercells must be
+///     canonical. The values are made canonical in place and then moved
+///     into the set.
+/// \param n_threads Number of threads used to make canonical forms. If
+///     <= 0, the number of hardware threads is used.
+///
+/// \returns The results of `insert`, for each configuration in order.
+///
+/// Canonical forms and supercell names are made in parallel, then all
+/// configurations are inserted in one pass, in order, on the calling
+/// thread. So configuration_id are assigned exactly as by inserting the
+/// canonical forms one at a time with `insert`, independent of
+/// `n_threads`.
+std::vector<std::pair<ConfigurationSet::iterator, bool>>
+ConfigurationSet::insert_many(std::vector<Configuration> &&configurations,
+                              Index n_threads) {
+  std::vector<std::string> supercell_names =
+      make_canonical_forms_and_names(configurations, n_threads);
+  std::vector<std::pair<iterator, bool>> result;
+  result.reserve(configurations.size());
+  for (Index i = 0; i < Index(configurations.size()); ++i) {
+    result.push_back(
+        this->insert(supercell_names[i], std::move(configurations[i])));
+  }
+  configurations.clear();
+  return result;
+}
+
+/// \brief Insert the configurations of a shard of an enumeration, in the
+///     order they were inserted in the shard, setting configuration_id
+///     automatically
+///
+/// \param shard Configurations generated by one shard of an enumeration,
+///     with configuration_id set automatically by `insert`.
+///
+/// Automatically set configuration_id count up from 0 in insertion order,
+/// for each supercell, so the configurations of `shard` are inserted in
+/// order of supercell_name and configuration_id. This assigns
+/// configuration_id as if the configurations inserted into `shard` were
+/// inserted into this set directly. Configurations already in this set are
+/// skipped, as by `insert`.
+///
+/// So, if an enumeration is split into shards that each enumerate a
+/// contiguous part of the enumeration order in each supercell, as with
+/// ConfigEnumAllOccupations `shard_index` and `n_shards`, or that enumerate
+/// different supercells, then merging the shards into an empty set, in
+/// order of shard index, reproduces the configuration_id of a serial
+/// enumeration.
+///
+/// Records with configuration_id that were not set automatically (not
+/// non-negative integers) are inserted last, keeping their configuration_id.
+void ConfigurationSet::merge(ConfigurationSet const &shard) {
+  typedef std::tuple<std::string const *, Index, ConfigurationRecord const *>
+      key_type;
+  std::vector<key_type> automatic;
+  std::vector<ConfigurationRecord const *> custom;
+  for (auto const &record : shard) {
+    Index id = automatic_configuration_id(record.configuration_id);
+    if (id < 0) {
+      custom.push_back(&record);
+    } else {
+      automatic.emplace_back(&record.supercell_name, id, &record);
+    }
+  }
+  std::sort(automatic.begin(), automatic.end(),
+            [](key_type const &lhs, key_type const &rhs) {
+              int cmp = std::get<0>(lhs)->compare(*std::get<0>(rhs));
+              if (cmp != 0) {
+                return cmp < 0;
+              }
+              return std::get<1>(lhs) < std::get<1>(rhs);
+            });
+  for (auto const &key : automatic) {
+    ConfigurationRecord const &record = *std::get<2>(key);
+    this->insert(record.supercell_name, record.configuration);
+  }
+  for (ConfigurationRecord const *record : custom) {
+    this->insert(*record);
+  }
+}
+
+/// \brief Merge ConfigurationSet, by a k-way merge of their sorted
+///     records
+///
+/// \param sets The sets to merge, which must not be null. Configurations
+///     must share the same prim.
+/// \param n_threads Number of threads used to merge records, split by
+///     supercell. If <= 0, uses `resolve_n_threads(n_threads)`.
+///
+/// \returns A set equal, including configuration_id and `next_config_id`,
+///     to a copy of `*sets[0]` into which each later set is merged with
+///     `ConfigurationSet::merge`, in order. So, configurations in the first
+///     set keep their configuration_id, each distinct configuration is
+///     taken from the first set it is in, and automatically set
+///     configuration_id of configurations only in later sets count up from
+///     `sets[0]->next_config_id()`, set by set, in order of their
+///     configuration_id in the set they are taken from. The result does not
+///     depend on `n_threads`.
+///
+/// Method:
+/// - Records are sorted by supercell and then DoF values, so each set is
+///   split into one run of records per supercell in a single pass
+/// - Runs of the same supercell are merged with a k-way merge, finding
+///   duplicates by comparison with the previous merged record, so each
+///   record is compared O(log k) times, instead of O(log n) times as when
+///   inserting records one at a time
+/// - Supercells are merged in parallel, and then the merged records are
+///   appended to the result, in order, with the end as the insertion hint
+/// - Only configuration_id of records that are only in later sets are
+///   sorted
+ConfigurationSet make_merged_configuration_set(
+    std::vector<ConfigurationSet const *> const &sets, Index n_threads) {
+  if (sets.empty()) {
+    return ConfigurationSet();
+  }
+
+  // supercell -> runs, in order of set index
+  std::map<Supercell const *, std::vector<SupercellRun>, SupercellPtrLess>
+      runs_by_supercell;
+  for (Index k = 0; k < sets.size(); ++k) {
+    ConfigurationSet const &set = *sets[k];
+    auto begin = set.begin();
+    while (begin != set.end()) {
+      Supercell const &supercell = *begin->configuration.supercell;
+      auto end = std::next(begin);
+      while (end != set.end() && *end->configuration.supercell == supercell) {
+        ++end;
+      }
+      SupercellRun run;
+      run.set_index = k;
+      run.begin = begin;
+      run.end = end;
+      runs_by_supercell[&supercell].push_back(run);
+      begin = end;
+    }
+  }
+
+  std::vector<std::vector<SupercellRun> const *> runs;
+  for (auto const &pair : runs_by_supercell) {
+    runs.push_back(&pair.second);
+  }
+  std::map<std::string, Index> const &first_next_config_id =
+      sets[0]->next_config_id();
+  std::vector<MergedSupercellRecords> merged(runs.size());
+  parallel_for_chunks(runs.size(), n_threads,
+                      [&](Index chunk_index, Index begin, Index end) {
+                        for (Index i = begin; i < end; ++i) {
+                          merged[i] = merge_supercell_runs(
+                              *runs[i], first_next_config_id);
+                        }
+                      });
+
+  ConfigurationSet result;
+  std::map<std::string, Index> next_config_id = first_next_config_id;
+  std::set<ConfigurationRecord> &data = result.data();
+  for (auto &supercell_records : merged) {
+    for (auto &record : supercell_records.records) {
+      data.emplace_hint(data.end(), std::move(record));
+    }
+    if (supercell_records.next_config_id.has_value()) {
+      next_config_id[supercell_records.next_config_id->first] =
+          supercell_records.next_config_id->second;
+    }
+  }
+  result.set_next_config_id(next_config_id);
+  return result;
 }
 
 ConfigurationSet::const_iterator ConfigurationSet::find(
@@ -72,16 +726,20 @@ ConfigurationSet::const_iterator ConfigurationSet::find(
   return m_data.find(record);
 }
 
+/// \brief Find a configuration by name
+///
+/// Uses an index by configuration name, which is built on first use and
+/// then updated on insert and erase. Supercell names are interned, so the
+/// index stores one copy of each supercell name and a configuration id per
+/// record. If names are not unique, the first record in order is found.
 ConfigurationSet::const_iterator ConfigurationSet::find_by_name(
     std::string configuration_name) const {
-  auto it = this->begin();
-  auto end = this->end();
-  for (; it != end; ++it) {
-    if (it->configuration_name == configuration_name) {
-      return it;
-    }
+  _validate_name_index();
+  auto found = m_index_by_name.find(configuration_name);
+  if (found == nullptr) {
+    return this->end();
   }
-  return end;
+  return *found;
 }
 
 ConfigurationSet::size_type ConfigurationSet::count(
@@ -100,7 +758,185 @@ ConfigurationSet::size_type ConfigurationSet::count_by_name(
   return 0;
 }
 
+/// \brief Find configurations, in any supercell, that are equivalent to
+///     `configuration` as infinite crystals
+///
+/// Uses an index by primitive canonical key, which is built on first use,
+/// so that after the first query each query requires making one primitive
+/// canonical key and takes O(1) expected time otherwise. The
+/// configurations need not be canonical.
+///
+/// \returns Iterators to all records with primitive canonical key equal to
+///     that of `configuration`, in no particular order.
+std::vector<ConfigurationSet::const_iterator>
+ConfigurationSet::find_by_primitive(Configuration const &configuration) const {
+  _validate_primitive_key_index();
+  PrimitiveCanonicalKey key = make_primitive_canonical_key(configuration);
+  std::vector<const_iterator> result;
+  auto range = m_index_by_primitive_key.equal_range(key.hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second->primitive_canonical_key() == key) {
+      result.push_back(it->second);
+    }
+  }
+  return result;
+}
+
+/// \brief Find a configuration in the same supercell whose DoF values are
+///     all within tolerance of those of `configuration`
+///
+/// Finds a record `r` with `r.configuration == configuration`, comparing
+/// continuous DoF values with the prim lattice tolerance. Unlike `find`,
+/// which searches the ordered records with tolerance-based comparisons
+/// that are not transitive, this finds a match if any exists.
+///
+/// Uses an index of the continuous DoF values of the records in each
+/// supercell (see ContinuousDoFIndex), which is built on first use and then
+/// updated on insert and erase, to check only the records whose values are
+/// all within tolerance. To find a configuration that is equivalent by
+/// symmetry, use its canonical form.
+///
+/// \returns An iterator to a matching record, or `end()` if none.
+ConfigurationSet::const_iterator ConfigurationSet::find_within_tol(
+    Configuration const &configuration) const {
+  _validate_dof_values_index();
+  auto index_it = m_index_by_dof_values.find(configuration.supercell->name);
+  if (index_it == m_index_by_dof_values.end()) {
+    return end();
+  }
+  Eigen::VectorXd x = make_continuous_dof_vector(configuration);
+  if (x.size() != index_it->second.dim()) {
+    return end();
+  }
+  const_iterator result = end();
+  index_it->second.find_if(x, [&](const_iterator it) {
+    if (it->configuration == configuration) {
+      result = it;
+      return true;
+    }
+    return false;
+  });
+  return result;
+}
+
+/// \brief Count configurations, in any supercell, that are equivalent to
+///     `configuration` as infinite crystals
+ConfigurationSet::size_type ConfigurationSet::count_by_primitive(
+    Configuration const &configuration) const {
+  return find_by_primitive(configuration).size();
+}
+
+/// \brief Find configurations in the supercell with name `supercell_name`
+///
+/// Uses an index by supercell name, which is built on first use of any of
+/// `find_by_supercell_name`, `find_by_volume`, or `find_by_occupant_count`,
+/// and then updated on insert and erase.
+///
+/// \returns Iterators to all records with `supercell_name`, in no
+///     particular order.
+std::vector<ConfigurationSet::const_iterator>
+ConfigurationSet::find_by_supercell_name(
+    std::string const &supercell_name) const {
+  _validate_secondary_indexes();
+  std::vector<const_iterator> result;
+  auto range = m_index_by_supercell_name.equal_range(supercell_name);
+  for (auto it = range.first; it != range.second; ++it) {
+    result.push_back(it->second);
+  }
+  return result;
+}
+
+/// \brief Find configurations with supercell volume in a range
+///
+/// \param min_volume,max_volume Inclusive bounds on the supercell volume,
+///     as the number of unit cells
+///
+/// Uses an index by supercell volume, see `find_by_supercell_name`.
+///
+/// \returns Iterators to all records with supercell volume in the range, by
+///     increasing volume and then in no particular order.
+std::vector<ConfigurationSet::const_iterator> ConfigurationSet::find_by_volume(
+    Index min_volume, Index max_volume) const {
+  _validate_secondary_indexes();
+  std::vector<const_iterator> result;
+  if (min_volume > max_volume) {
+    return result;
+  }
+  auto begin = m_index_by_volume.lower_bound(min_volume);
+  auto end = m_index_by_volume.upper_bound(max_volume);
+  for (auto it = begin; it != end; ++it) {
+    result.push_back(it->second);
+  }
+  return result;
+}
+
+/// \brief Find configurations with the number of sites of one sublattice
+///     occupied by one occupant in a range
+///
+/// \param sublattice_index The sublattice
+/// \param occupant_name Name of the occupant being counted, as given by
+///     `xtal::Molecule::name()`
+/// \param min_count,max_count Inclusive bounds on the number of sites
+///
+/// Uses an index by occupant count, see `find_by_supercell_name`. Counts,
+/// including zero counts, are indexed for every occupant allowed on each
+/// sublattice, so configurations on whose sublattice `occupant_name` is
+/// not allowed are never found. For a fixed sublattice composition use
+/// `min_count == max_count`, and intersect the results for each occupant.
+///
+/// \returns Iterators to all records with the occupant count in the range,
+///     by increasing count and then in no particular order.
+std::vector<ConfigurationSet::const_iterator>
+ConfigurationSet::find_by_occupant_count(Index sublattice_index,
+                                         std::string const &occupant_name,
+                                         Index min_count,
+                                         Index max_count) const {
+  _validate_secondary_indexes();
+  std::vector<const_iterator> result;
+  auto index_it = m_index_by_occupant_count.find(
+      std::make_pair(sublattice_index, occupant_name));
+  if (index_it == m_index_by_occupant_count.end() || min_count > max_count) {
+    return result;
+  }
+  auto const &index = index_it->second;
+  auto begin = index.lower_bound(min_count);
+  auto end = index.upper_bound(max_count);
+  for (auto it = begin; it != end; ++it) {
+    result.push_back(it->second);
+  }
+  return result;
+}
+
 ConfigurationSet::const_iterator ConfigurationSet::erase(const_iterator it) {
+  if (m_primitive_key_index_is_valid) {
+    auto range = m_index_by_primitive_key.equal_range(
+        it->primitive_canonical_key().hash);
+    for (auto index_it = range.first; index_it != range.second; ++index_it) {
+      if (index_it->second == it) {
+        m_index_by_primitive_key.erase(index_it);
+        break;
+      }
+    }
+  }
+  if (m_name_index_is_valid) {
+    if (m_name_index_has_duplicates) {
+      m_index_by_name.clear();
+      m_name_index_is_valid = false;
+    } else {
+      m_index_by_name.erase(it->configuration_name);
+    }
+  }
+  if (m_secondary_indexes_are_valid) {
+    _remove_from_secondary_indexes(it);
+  }
+  if (m_dof_values_index_is_valid) {
+    auto index_it =
+        m_index_by_dof_values.find(it->configuration.supercell->name);
+    if (index_it != m_index_by_dof_values.end()) {
+      index_it->second.erase(make_continuous_dof_vector(it->configuration),
+                             it);
+    }
+  }
   return m_data.erase(it);
 }
 
@@ -110,7 +946,7 @@ ConfigurationSet::size_type ConfigurationSet::erase(
   if (it == end()) {
     return 0;
   }
-  m_data.erase(it);
+  this->erase(it);
   return 1;
 }
 
@@ -120,7 +956,7 @@ ConfigurationSet::size_type ConfigurationSet::erase_by_name(
   if (it == end()) {
     return 0;
   }
-  m_data.erase(it);
+  this->erase(it);
   return 1;
 }
 
@@ -136,12 +972,156 @@ std::map<std::string, Index> const &ConfigurationSet::next_config_id() const {
   return m_next_config_id;
 }
 
-std::set<ConfigurationRecord> &ConfigurationSet::data() { return m_data; }
+/// \brief Access the records directly
+///
+/// The primitive canonical key index is rebuilt on next use, because
+/// records may be inserted or erased through the returned reference.
+std::set<ConfigurationRecord> &ConfigurationSet::data() {
+  _invalidate_indexes();
+  return m_data;
+}
 
 std::set<ConfigurationRecord> const &ConfigurationSet::data() const {
   return m_data;
 }
 
+/// \brief Add a newly inserted record to the indexes that are in use
+std::pair<ConfigurationSet::iterator, bool> ConfigurationSet::_insert_and_index(
+    std::pair<iterator, bool> result) {
+  if (result.second && m_primitive_key_index_is_valid) {
+    m_index_by_primitive_key.emplace(
+        result.first->primitive_canonical_key().hash, result.first);
+  }
+  if (result.second && m_name_index_is_valid &&
+      !m_index_by_name.insert(result.first->configuration_name,
+                              result.first)) {
+    // the new record may be before the indexed one in order
+    m_index_by_name.clear();
+    m_name_index_is_valid = false;
+  }
+  if (result.second && m_secondary_indexes_are_valid) {
+    _add_to_secondary_indexes(result.first);
+  }
+  if (result.second && m_dof_values_index_is_valid) {
+    _add_to_dof_values_index(result.first);
+  }
+  return result;
+}
+
+/// \brief Clear all indexes, so they are rebuilt on next use
+void ConfigurationSet::_invalidate_indexes() {
+  m_index_by_primitive_key.clear();
+  m_primitive_key_index_is_valid = false;
+  m_index_by_name.clear();
+  m_name_index_is_valid = false;
+  m_index_by_supercell_name.clear();
+  m_index_by_volume.clear();
+  m_index_by_occupant_count.clear();
+  m_secondary_indexes_are_valid = false;
+  m_index_by_dof_values.clear();
+  m_dof_values_index_is_valid = false;
+}
+
+/// \brief Build the primitive canonical key index, if not valid
+void ConfigurationSet::_validate_primitive_key_index() const {
+  if (m_primitive_key_index_is_valid) {
+    return;
+  }
+  m_index_by_primitive_key.clear();
+  m_index_by_primitive_key.reserve(m_data.size());
+  for (auto it = m_data.begin(); it != m_data.end(); ++it) {
+    m_index_by_primitive_key.emplace(it->primitive_canonical_key().hash, it);
+  }
+  m_primitive_key_index_is_valid = true;
+}
+
+/// \brief Build the configuration name index, if not valid
+void ConfigurationSet::_validate_name_index() const {
+  if (m_name_index_is_valid) {
+    return;
+  }
+  m_index_by_name.clear();
+  m_name_index_has_duplicates = false;
+  for (auto it = m_data.begin(); it != m_data.end(); ++it) {
+    if (!m_index_by_name.insert(it->configuration_name, it)) {
+      m_name_index_has_duplicates = true;
+    }
+  }
+  m_name_index_is_valid = true;
+}
+
+/// \brief Build the supercell name, volume, and occupant count indexes,
+///     if not valid
+void ConfigurationSet::_validate_secondary_indexes() const {
+  if (m_secondary_indexes_are_valid) {
+    return;
+  }
+  m_index_by_supercell_name.clear();
+  m_index_by_volume.clear();
+  m_index_by_occupant_count.clear();
+  for (auto it = m_data.begin(); it != m_data.end(); ++it) {
+    _add_to_secondary_indexes(it);
+  }
+  m_secondary_indexes_are_valid = true;
+}
+
+/// \brief Add a record to the supercell name, volume, and occupant count
+///     indexes
+void ConfigurationSet::_add_to_secondary_indexes(const_iterator it) const {
+  Configuration const &configuration = it->configuration;
+  m_index_by_supercell_name.emplace(it->supercell_name, it);
+  m_index_by_volume.emplace(
+      configuration.supercell->unitcell_index_converter.total_sites(), it);
+  for (auto const &key_count : make_occupant_counts(configuration)) {
+    m_index_by_occupant_count[key_count.first].emplace(key_count.second, it);
+  }
+}
+
+/// \brief Remove a record from the supercell name, volume, and occupant
+///     count indexes
+void ConfigurationSet::_remove_from_secondary_indexes(const_iterator it) {
+  erase_index_entry(m_index_by_supercell_name, it->supercell_name, it);
+  erase_index_entry(
+      m_index_by_volume,
+      it->configuration.supercell->unitcell_index_converter.total_sites(), it);
+  for (auto const &key_count : make_occupant_counts(it->configuration)) {
+    auto index_it = m_index_by_occupant_count.find(key_count.first);
+    if (index_it != m_index_by_occupant_count.end()) {
+      erase_index_entry(index_it->second, key_count.second, it);
+    }
+  }
+}
+
+/// \brief Build the continuous DoF values index, if not valid
+void ConfigurationSet::_validate_dof_values_index() const {
+  if (m_dof_values_index_is_valid) {
+    return;
+  }
+  m_index_by_dof_values.clear();
+  for (auto it = m_data.begin(); it != m_data.end(); ++it) {
+    _add_to_dof_values_index(it);
+  }
+  m_dof_values_index_is_valid = true;
+}
+
+/// \brief Add a record to the continuous DoF values index
+///
+/// Queries use the prim lattice tolerance as the half width for every
+/// value, the same tolerance used by `Configuration::operator==`.
+void ConfigurationSet::_add_to_dof_values_index(const_iterator it) const {
+  Configuration const &configuration = it->configuration;
+  Eigen::VectorXd x = make_continuous_dof_vector(configuration);
+  auto index_it = m_index_by_dof_values.find(configuration.supercell->name);
+  if (index_it == m_index_by_dof_values.end()) {
+    double tol = configuration.supercell->prim->basicstructure->lattice().tol();
+    index_it = m_index_by_dof_values
+                   .emplace(configuration.supercell->name,
+                            ContinuousDoFIndex<const_iterator>(x.size(), tol))
+                   .first;
+  }
+  index_it->second.insert(x, it);
+}
+
 /// \brief Make a map for finding ConfigurationRecord by configuration_name
 std::map<std::string, ConfigurationRecord const *>
 make_index_by_configuration_name(
@@ -153,5 +1133,331 @@ make_index_by_configuration_name(
   return result;
 }
 
+namespace {
+
+/// \brief Combine a value into an FNV-1a hash
+void hash_combine(std::uint64_t &hash, std::uint64_t value) {
+  std::uint64_t const fnv_prime = 1099511628211ULL;
+  for (int i = 0; i < 8; ++i) {
+    hash ^= (value >> (8 * i)) & 0xff;
+    hash *= fnv_prime;
+  }
+}
+
+}  // namespace
+
+/// \brief Make a hash value for a Configuration, consistent with
+///     Configuration::operator==
+///
+/// The hash includes the supercell transformation matrix and the occupation.
+/// Continuous DoF values are not included, because Configuration::operator==
+/// compares them within a tolerance, and any tolerance-based rounding of
+/// values into the hash would give different hash values for some equal
+/// configurations. Configurations that differ only in continuous DoF values
+/// are distinguished by Configuration::operator== when searching a bucket.
+///
+/// If `quantum` is given, continuous DoF values are also included, as
+/// `llround(value / quantum)`. This is only consistent with
+/// Configuration::operator== for configurations with all continuous DoF
+/// values set exactly to multiples of `quantum`, such as quantized
+/// canonical forms made by `QuantizedCanonicalizer`.
+std::uint64_t make_configuration_hash(Configuration const &configuration,
+                                      std::optional<double> quantum) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  Eigen::Matrix3l const &T =
+      configuration.supercell->superlattice.transformation_matrix_to_super();
+  for (Index i = 0; i < 3; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      hash_combine(hash, static_cast<std::uint64_t>(T(i, j)));
+    }
+  }
+  Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+  hash_combine(hash, occupation.size());
+  for (Index l = 0; l < occupation.size(); ++l) {
+    hash_combine(hash, static_cast<std::uint64_t>(occupation[l]));
+  }
+  if (quantum.has_value()) {
+    auto const &dof_values = configuration.dof_values;
+    for (auto const &dof : dof_values.global_dof_values) {
+      for (Index i = 0; i < dof.second.size(); ++i) {
+        hash_combine(hash, static_cast<std::uint64_t>(
+                               std::llround(dof.second(i) / *quantum)));
+      }
+    }
+    for (auto const &dof : dof_values.local_dof_values) {
+      for (Index i = 0; i < dof.second.size(); ++i) {
+        hash_combine(hash, static_cast<std::uint64_t>(
+                               std::llround(dof.second(i) / *quantum)));
+      }
+    }
+  }
+  return hash;
+}
+
+UnorderedConfigurationSet::UnorderedConfigurationSet(
+    std::map<std::string, Index> _next_config_id,
+    std::optional<double> _quantum)
+    : m_next_config_id(_next_config_id), m_quantum(_quantum) {}
+
+bool UnorderedConfigurationSet::empty() const { return m_data.empty(); }
+
+UnorderedConfigurationSet::size_type UnorderedConfigurationSet::size() const {
+  return m_data.size();
+}
+
+void UnorderedConfigurationSet::clear() {
+  m_index_by_hash.clear();
+  m_index_by_name.clear();
+  m_data.clear();
+}
+
+UnorderedConfigurationSet::const_iterator UnorderedConfigurationSet::begin()
+    const {
+  return m_data.begin();
+}
+
+UnorderedConfigurationSet::const_iterator UnorderedConfigurationSet::end()
+    const {
+  return m_data.end();
+}
+
+/// \brief Insert Configuration, setting supercell_name and
+///     configuration_id automatically
+std::pair<UnorderedConfigurationSet::iterator, bool>
+UnorderedConfigurationSet::insert(Configuration const &configuration) {
+  std::string const &supercell_name = configuration.supercell->name;
+  return this->insert(supercell_name, configuration);
+}
+
+/// \brief Insert Configuration with known supercell_name, setting
+///     configuration_id automatically
+///
+/// The configuration is copied only if it is inserted.
+std::pair<UnorderedConfigurationSet::iterator, bool>
+UnorderedConfigurationSet::insert(std::string const &supercell_name,
+                                  Configuration const &configuration) {
+  std::uint64_t hash = make_configuration_hash(configuration, m_quantum);
+  auto found = _find(configuration, hash);
+  if (found != m_data.end()) {
+    // erasing an empty range converts const_iterator to iterator
+    return std::make_pair(m_data.erase(found, found), false);
+  }
+  return std::make_pair(
+      _insert_new(supercell_name, Configuration(configuration), hash), true);
+}
+
+/// \brief Insert ConfigurationRecord, allowing custom configuration_id
+std::pair<UnorderedConfigurationSet::iterator, bool>
+UnorderedConfigurationSet::insert(ConfigurationRecord const &record) {
+  std::uint64_t hash =
+      make_configuration_hash(record.configuration, m_quantum);
+  auto found = _find(record.configuration, hash);
+  if (found != m_data.end()) {
+    // erasing an empty range converts const_iterator to iterator
+    return std::make_pair(m_data.erase(found, found), false);
+  }
+  return std::make_pair(_insert_new(ConfigurationRecord(record), hash), true);
+}
+
+/// \brief Insert Configuration, moving its DoF values into the set if
+///     inserted, setting supercell_name and configuration_id
+///     automatically
+///
+/// If not inserted, `configuration` is left unchanged.
+std::pair<UnorderedConfigurationSet::iterator, bool>
+UnorderedConfigurationSet::insert(Configuration &&configuration) {
+  std::string const &supercell_name = configuration.supercell->name;
+  return this->insert(supercell_name, std::move(configuration));
+}
+
+/// \brief Insert Configuration with known supercell_name, moving its DoF
+///     values into the set if inserted, setting configuration_id
+///     automatically
+///
+/// If not inserted, `configuration` is left unchanged.
+std::pair<UnorderedConfigurationSet::iterator, bool>
+UnorderedConfigurationSet::insert(std::string const &supercell_name,
+                                  Configuration &&configuration) {
+  std::uint64_t hash = make_configuration_hash(configuration, m_quantum);
+  auto found = _find(configuration, hash);
+  if (found != m_data.end()) {
+    // erasing an empty range converts const_iterator to iterator
+    return std::make_pair(m_data.erase(found, found), false);
+  }
+  return std::make_pair(
+      _insert_new(supercell_name, std::move(configuration), hash), true);
+}
+
+/// \brief Insert ConfigurationRecord, moved from, allowing custom
+///     configuration_id
+std::pair<UnorderedConfigurationSet::iterator, bool>
+UnorderedConfigurationSet::insert(ConfigurationRecord &&record) {
+  std::uint64_t hash =
+      make_configuration_hash(record.configuration, m_quantum);
+  auto found = _find(record.configuration, hash);
+  if (found != m_data.end()) {
+    // erasing an empty range converts const_iterator to iterator
+    return std::make_pair(m_data.erase(found, found), false);
+  }
+  return std::make_pair(_insert_new(std::move(record), hash), true);
+}
+
+/// \brief Make canonical forms of many Configuration, in parallel, and
+///     insert them, setting supercell_name and configuration_id
+///     automatically
+///
+/// \param configurations Configurations to insert. Supercells must be
+///     canonical. The values are made canonical in place and then moved
+///     into the set.
+/// \param n_threads Number of threads used to make canonical forms. If
+///     <= 0, the number of hardware threads is used.
+///
+/// \returns The results of `insert`, for each configuration in order.
+///
+/// Canonical forms and supercell names are made in parallel, then all
+/// configurations are inserted in one pass, in order, on the calling
+/// thread. So configuration_id are assigned exactly as by inserting the
+/// canonical forms one at a time with `insert`, independent of
+/// `n_threads`.
+std::vector<std::pair<UnorderedConfigurationSet::iterator, bool>>
+UnorderedConfigurationSet::insert_many(
+    std::vector<Configuration> &&configurations, Index n_threads) {
+  std::vector<std::string> supercell_names =
+      make_canonical_forms_and_names(configurations, n_threads);
+  std::vector<std::pair<iterator, bool>> result;
+  result.reserve(configurations.size());
+  for (Index i = 0; i < Index(configurations.size()); ++i) {
+    result.push_back(
+        this->insert(supercell_names[i], std::move(configurations[i])));
+  }
+  configurations.clear();
+  return result;
+}
+
+UnorderedConfigurationSet::const_iterator UnorderedConfigurationSet::find(
+    Configuration const &configuration) const {
+  return _find(configuration,
+               make_configuration_hash(configuration, m_quantum));
+}
+
+UnorderedConfigurationSet::const_iterator
+UnorderedConfigurationSet::find_by_name(std::string configuration_name) const {
+  auto found = m_index_by_name.find(configuration_name);
+  if (found == nullptr) {
+    return this->end();
+  }
+  return *found;
+}
+
+UnorderedConfigurationSet::size_type UnorderedConfigurationSet::count(
+    Configuration const &configuration) const {
+  if (find(configuration) != end()) {
+    return 1;
+  }
+  return 0;
+}
+
+UnorderedConfigurationSet::size_type UnorderedConfigurationSet::count_by_name(
+    std::string configuration_name) const {
+  return m_index_by_name.find(configuration_name) != nullptr ? 1 : 0;
+}
+
+UnorderedConfigurationSet::const_iterator UnorderedConfigurationSet::erase(
+    const_iterator it) {
+  std::uint64_t hash = make_configuration_hash(it->configuration, m_quantum);
+  auto range = m_index_by_hash.equal_range(hash);
+  for (auto hash_it = range.first; hash_it != range.second; ++hash_it) {
+    if (hash_it->second == it) {
+      m_index_by_hash.erase(hash_it);
+      break;
+    }
+  }
+  m_index_by_name.erase(it->configuration_name);
+  return m_data.erase(it);
+}
+
+UnorderedConfigurationSet::size_type UnorderedConfigurationSet::erase(
+    Configuration const &configuration) {
+  auto it = find(configuration);
+  if (it == end()) {
+    return 0;
+  }
+  this->erase(it);
+  return 1;
+}
+
+UnorderedConfigurationSet::size_type UnorderedConfigurationSet::erase_by_name(
+    std::string configuration_name) {
+  auto it = find_by_name(configuration_name);
+  if (it == end()) {
+    return 0;
+  }
+  this->erase(it);
+  return 1;
+}
+
+/// \brief Set IDs, by supercell_name, used to automatically ID new
+/// configurations
+void UnorderedConfigurationSet::set_next_config_id(
+    std::map<std::string, Index> const &next_config_id) {
+  m_next_config_id = next_config_id;
+}
+
+/// \brief IDs, by supercell_name, used to automatically ID new configurations
+std::map<std::string, Index> const &UnorderedConfigurationSet::next_config_id()
+    const {
+  return m_next_config_id;
+}
+
+/// \brief Grid spacing of continuous DoF values included in the hash, if
+///     any
+std::optional<double> UnorderedConfigurationSet::quantum() const {
+  return m_quantum;
+}
+
+/// \brief Insert a configuration that is not in the set, setting
+///     configuration_id automatically
+UnorderedConfigurationSet::iterator UnorderedConfigurationSet::_insert_new(
+    std::string const &supercell_name, Configuration &&configuration,
+    std::uint64_t hash) {
+  auto it = m_next_config_id.find(supercell_name);
+  if (it == m_next_config_id.end()) {
+    it = m_next_config_id.emplace(supercell_name, 0).first;
+  }
+  Index &configuration_id = it->second;
+  auto result = _insert_new(
+      ConfigurationRecord(std::move(configuration), supercell_name,
+                          std::to_string(configuration_id)),
+      hash);
+  ++configuration_id;
+  return result;
+}
+
+/// \brief Insert a record whose configuration is not in the set
+UnorderedConfigurationSet::iterator UnorderedConfigurationSet::_insert_new(
+    ConfigurationRecord &&record, std::uint64_t hash) {
+  if (m_index_by_name.find(record.configuration_name) != nullptr) {
+    throw std::runtime_error(
+        "Error in UnorderedConfigurationSet::insert: a different "
+        "configuration named '" +
+        record.configuration_name + "' already exists");
+  }
+  auto it = m_data.insert(m_data.end(), std::move(record));
+  m_index_by_hash.emplace(hash, it);
+  m_index_by_name.insert(it->configuration_name, it);
+  return it;
+}
+
+UnorderedConfigurationSet::const_iterator UnorderedConfigurationSet::_find(
+    Configuration const &configuration, std::uint64_t hash) const {
+  auto range = m_index_by_hash.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second->configuration == configuration) {
+      return it->second;
+    }
+  }
+  return m_data.end();
+}
+
 }  // namespace config
 }  // namespace CASM
@@ -0,0 +1,577 @@
+#include "casm/configuration/DoFSpaceAnalysisCache.hh"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/configuration/io/json/Configuration_json_io.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/io/BasicStructureIO.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {  // (anonymous)
+
+/// \brief Make a hexadecimal hash of a cache key
+///
+/// Uses 64-bit FNV-1a, which is stable across platforms and runs, so it can
+/// be used to name results files.
+std::string make_cache_hash(std::string const &key) {
+  std::uint64_t const fnv_prime = 1099511628211ULL;
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : key) {
+    hash ^= c;
+    hash *= fnv_prime;
+  }
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return ss.str();
+}
+
+/// \brief Write a map as an array of [key, value] pairs, or null
+template <typename MapType>
+void map_to_json(std::optional<MapType> const &map, jsonParser &json) {
+  if (!map.has_value()) {
+    json.put_null();
+    return;
+  }
+  json.put_array();
+  for (auto const &pair : *map) {
+    jsonParser pair_json;
+    pair_json.put_array();
+    pair_json.push_back(pair.first);
+    pair_json.push_back(pair.second);
+    json.push_back(pair_json);
+  }
+}
+
+/// \brief Write the options shared by dof_space_analysis and
+///     config_space_analysis to a cache key
+void options_to_json(
+    std::optional<bool> exclude_homogeneous_modes,
+    bool include_default_occ_modes,
+    std::optional<std::map<int, int>> const &sublattice_index_to_default_occ,
+    std::optional<std::map<Index, int>> const &site_index_to_default_occ,
+    jsonParser &json) {
+  if (exclude_homogeneous_modes.has_value()) {
+    json["exclude_homogeneous_modes"] = *exclude_homogeneous_modes;
+  } else {
+    json["exclude_homogeneous_modes"].put_null();
+  }
+  json["include_default_occ_modes"] = include_default_occ_modes;
+  map_to_json(sublattice_index_to_default_occ,
+              json["sublattice_index_to_default_occ"]);
+  map_to_json(site_index_to_default_occ, json["site_index_to_default_occ"]);
+}
+
+/// \brief Write a DoFSpace, without the prim
+void dof_space_to_json(clexulator::DoFSpace const &dof_space,
+                       jsonParser &json) {
+  json["dof_key"] = dof_space.dof_key;
+  if (dof_space.transformation_matrix_to_super.has_value()) {
+    json["transformation_matrix_to_super"] =
+        *dof_space.transformation_matrix_to_super;
+  }
+  if (dof_space.sites.has_value()) {
+    to_json(*dof_space.sites, json["sites"]);
+  }
+  json["basis"] = dof_space.basis;
+}
+
+/// \brief Read a DoFSpace written by `dof_space_to_json`
+clexulator::DoFSpace dof_space_from_json(jsonParser const &json,
+                                         Prim const &prim) {
+  std::optional<Eigen::Matrix3l> T;
+  if (json.contains("transformation_matrix_to_super")) {
+    T = Eigen::Matrix3l();
+    from_json(*T, json["transformation_matrix_to_super"]);
+  }
+  std::optional<std::set<Index>> sites;
+  if (json.contains("sites")) {
+    sites = std::set<Index>();
+    from_json(*sites, json["sites"]);
+  }
+  Eigen::MatrixXd basis;
+  from_json(basis, json["basis"]);
+  return clexulator::make_dof_space(json["dof_key"].get<std::string>(),
+                                    prim.basicstructure, T, sites, basis);
+}
+
+/// \brief Write a complex matrix as its real and imaginary parts
+void complex_to_json(Eigen::MatrixXcd const &value, jsonParser &json) {
+  json["real"] = Eigen::MatrixXd(value.real());
+  json["imag"] = Eigen::MatrixXd(value.imag());
+}
+
+/// \brief Read a complex matrix written by `complex_to_json`
+Eigen::MatrixXcd complex_from_json(jsonParser const &json) {
+  Eigen::MatrixXd real;
+  Eigen::MatrixXd imag;
+  from_json(real, json["real"]);
+  from_json(imag, json["imag"]);
+  Eigen::MatrixXcd value(real.rows(), real.cols());
+  value.real() = real;
+  value.imag() = imag;
+  return value;
+}
+
+/// \brief Write all IrrepInfo data
+void irrep_info_to_json(irreps::IrrepInfo const &irrep, jsonParser &json) {
+  complex_to_json(irrep.trans_mat, json["trans_mat"]);
+  complex_to_json(irrep.characters, json["characters"]);
+  json["complex"] = irrep.complex;
+  json["pseudo_irrep"] = irrep.pseudo_irrep;
+  json["index"] = irrep.index;
+  jsonParser &directions_json = json["directions"].put_array();
+  for (auto const &orbit : irrep.directions) {
+    jsonParser orbit_json;
+    orbit_json.put_array();
+    for (auto const &direction : orbit) {
+      jsonParser direction_json;
+      to_json_array(direction, direction_json);
+      orbit_json.push_back(direction_json);
+    }
+    directions_json.push_back(orbit_json);
+  }
+}
+
+/// \brief Read IrrepInfo written by `irrep_info_to_json`
+irreps::IrrepInfo irrep_info_from_json(jsonParser const &json) {
+  Eigen::MatrixXcd characters = complex_from_json(json["characters"]);
+  irreps::IrrepInfo irrep(complex_from_json(json["trans_mat"]),
+                          characters.col(0));
+  irrep.complex = json["complex"].get<bool>();
+  irrep.pseudo_irrep = json["pseudo_irrep"].get<bool>();
+  irrep.index = json["index"].get<Index>();
+  for (auto const &orbit_json : json["directions"]) {
+    std::vector<Eigen::VectorXd> orbit;
+    for (auto const &direction_json : orbit_json) {
+      Eigen::VectorXd direction;
+      from_json(direction, direction_json);
+      orbit.push_back(direction);
+    }
+    irrep.directions.push_back(orbit);
+  }
+  return irrep;
+}
+
+/// \brief Write all VectorSpaceSymReport data needed to reconstruct it
+void report_to_json(irreps::VectorSpaceSymReport const &report,
+                    jsonParser &json) {
+  jsonParser &rep_json = json["symgroup_rep"].put_array();
+  for (auto const &M : report.symgroup_rep) {
+    jsonParser M_json;
+    M_json = M;
+    rep_json.push_back(M_json);
+  }
+  jsonParser &irrep_rep_json = json["irrep_symgroup_rep"].put_array();
+  for (auto const &irrep_rep : report.irrep_symgroup_rep) {
+    jsonParser irrep_json;
+    irrep_json.put_array();
+    for (auto const &M : irrep_rep) {
+      jsonParser M_json;
+      M_json = M;
+      irrep_json.push_back(M_json);
+    }
+    irrep_rep_json.push_back(irrep_json);
+  }
+  jsonParser &irreps_json = json["irreps"].put_array();
+  for (auto const &irrep : report.irreps) {
+    jsonParser irrep_json;
+    irrep_info_to_json(irrep, irrep_json);
+    irreps_json.push_back(irrep_json);
+  }
+  jsonParser &wedge_json = json["irreducible_wedge"].put_array();
+  for (auto const &subwedge : report.irreducible_wedge) {
+    jsonParser subwedge_json;
+    subwedge_json.put_array();
+    for (auto const &irrep_wedge : subwedge.irrep_wedges) {
+      jsonParser irrep_wedge_json;
+      irrep_info_to_json(irrep_wedge.irrep_info,
+                         irrep_wedge_json["irrep_info"]);
+      irrep_wedge_json["axes"] = irrep_wedge.axes;
+      to_json(irrep_wedge.mult, irrep_wedge_json["mult"]);
+      subwedge_json.push_back(irrep_wedge_json);
+    }
+    wedge_json.push_back(subwedge_json);
+  }
+  json["symmetry_adapted_subspace"] = report.symmetry_adapted_subspace;
+  to_json(report.axis_glossary, json["axis_glossary"]);
+}
+
+/// \brief Read VectorSpaceSymReport written by `report_to_json`
+irreps::VectorSpaceSymReport report_from_json(jsonParser const &json) {
+  std::vector<Eigen::MatrixXd> symgroup_rep;
+  for (auto const &M_json : json["symgroup_rep"]) {
+    Eigen::MatrixXd M;
+    from_json(M, M_json);
+    symgroup_rep.push_back(M);
+  }
+  std::vector<std::vector<Eigen::MatrixXd>> irrep_symgroup_rep;
+  if (json.contains("irrep_symgroup_rep")) {
+    for (auto const &irrep_json : json["irrep_symgroup_rep"]) {
+      std::vector<Eigen::MatrixXd> irrep_rep;
+      for (auto const &M_json : irrep_json) {
+        Eigen::MatrixXd M;
+        from_json(M, M_json);
+        irrep_rep.push_back(M);
+      }
+      irrep_symgroup_rep.push_back(irrep_rep);
+    }
+  }
+  std::vector<irreps::IrrepInfo> irreps;
+  for (auto const &irrep_json : json["irreps"]) {
+    irreps.push_back(irrep_info_from_json(irrep_json));
+  }
+  std::vector<irreps::SubWedge> irreducible_wedge;
+  for (auto const &subwedge_json : json["irreducible_wedge"]) {
+    std::vector<irreps::IrrepWedge> irrep_wedges;
+    for (auto const &irrep_wedge_json : subwedge_json) {
+      Eigen::MatrixXd axes;
+      from_json(axes, irrep_wedge_json["axes"]);
+      irreps::IrrepWedge irrep_wedge(
+          irrep_info_from_json(irrep_wedge_json["irrep_info"]), axes);
+      from_json(irrep_wedge.mult, irrep_wedge_json["mult"]);
+      irrep_wedges.push_back(irrep_wedge);
+    }
+    irreducible_wedge.emplace_back(irrep_wedges);
+  }
+  Eigen::MatrixXd symmetry_adapted_subspace;
+  from_json(symmetry_adapted_subspace, json["symmetry_adapted_subspace"]);
+  std::vector<std::string> axis_glossary;
+  from_json(axis_glossary, json["axis_glossary"]);
+  return irreps::VectorSpaceSymReport(
+      std::move(symgroup_rep), std::move(irreps),
+      std::move(irreducible_wedge), symmetry_adapted_subspace,
+      std::move(axis_glossary), std::move(irrep_symgroup_rep));
+}
+
+/// \brief Read the results JSON from `<cache_dir>/<hash>.json`, or return
+///     std::nullopt if the file does not exist, is not readable, or has a
+///     different key
+std::optional<jsonParser> read_results_json(fs::path const &cache_dir,
+                                            std::string const &key) {
+  fs::path path = cache_dir / (make_cache_hash(key) + ".json");
+  if (!fs::exists(path)) {
+    return std::nullopt;
+  }
+  try {
+    jsonParser json(path);
+    if (!json.contains("key") || json["key"].get<std::string>() != key ||
+        !json.contains("results")) {
+      return std::nullopt;
+    }
+    return json["results"];
+  } catch (std::exception const &e) {
+    return std::nullopt;
+  }
+}
+
+/// \brief Write the results JSON to `<cache_dir>/<hash>.json`
+///
+/// The file is written to a temporary path and then renamed, so readers
+/// never see a partial file. Failure to write is not an error, because the
+/// results are still held in memory.
+void write_results_json(fs::path const &cache_dir, std::string const &key,
+                        jsonParser const &results_json) {
+  jsonParser json;
+  json["key"] = key;
+  json["results"] = results_json;
+
+  std::string hash = make_cache_hash(key);
+  std::stringstream tmp_name;
+  tmp_name << hash << ".json.tmp."
+           << std::hash<std::thread::id>()(std::this_thread::get_id()) << "."
+           << std::chrono::steady_clock::now().time_since_epoch().count();
+  try {
+    fs::create_directories(cache_dir);
+    fs::path tmp_path = cache_dir / tmp_name.str();
+    json.write(tmp_path);
+    fs::rename(tmp_path, cache_dir / (hash + ".json"));
+  } catch (std::exception const &e) {
+    return;
+  }
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _cache_dir If not std::nullopt, directory for results files.
+///     Created when the first results file is written.
+DoFSpaceAnalysisCache::DoFSpaceAnalysisCache(
+    std::optional<fs::path> _cache_dir)
+    : m_cache_dir(_cache_dir) {}
+
+/// \brief Return `dof_space_analysis` results
+///
+/// Parameters are the same as for `config::dof_space_analysis`.
+///
+/// \returns Shared results, equal to those of `config::dof_space_analysis`.
+///     Errors, such as `dof_space_analysis_error`, are thrown as by
+///     `config::dof_space_analysis` and are not cached.
+std::shared_ptr<DoFSpaceAnalysisResults const>
+DoFSpaceAnalysisCache::dof_space_analysis(
+    clexulator::DoFSpace const &dof_space, std::shared_ptr<Prim const> prim,
+    std::optional<Configuration> configuration,
+    std::optional<bool> exclude_homogeneous_modes,
+    bool include_default_occ_modes,
+    std::optional<std::map<int, int>> sublattice_index_to_default_occ,
+    std::optional<std::map<Index, int>> site_index_to_default_occ,
+    bool calc_wedges, std::optional<Log> log, bool use_character_projection,
+    bool use_kstar_blocks, Index n_threads) {
+  jsonParser key_json;
+  key_json["method"] = "dof_space_analysis";
+  write_prim(*prim->basicstructure, key_json["prim"], FRAC);
+  dof_space_to_json(dof_space, key_json["dof_space"]);
+  if (configuration.has_value()) {
+    to_json(*configuration, key_json["configuration"]);
+  }
+  options_to_json(exclude_homogeneous_modes, include_default_occ_modes,
+                  sublattice_index_to_default_occ, site_index_to_default_occ,
+                  key_json);
+  key_json["calc_wedges"] = calc_wedges;
+  key_json["use_character_projection"] = use_character_projection;
+  key_json["use_kstar_blocks"] = use_kstar_blocks;
+  std::stringstream ss;
+  ss << key_json;
+  std::string key = ss.str();
+
+  std::optional<fs::path> cache_dir;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_dof_space_results.find(key);
+    if (it != m_dof_space_results.end()) {
+      return it->second;
+    }
+    cache_dir = m_cache_dir;
+  }
+
+  std::shared_ptr<DoFSpaceAnalysisResults const> results;
+  if (cache_dir.has_value()) {
+    std::optional<jsonParser> json = read_results_json(*cache_dir, key);
+    if (json.has_value()) {
+      try {
+        results = std::make_shared<DoFSpaceAnalysisResults const>(
+            dof_space_from_json((*json)["symmetry_adapted_dof_space"], *prim),
+            report_from_json((*json)["symmetry_report"]));
+      } catch (std::exception const &e) {
+        results = nullptr;
+      }
+    }
+  }
+  if (!results) {
+    results = std::make_shared<DoFSpaceAnalysisResults const>(
+        config::dof_space_analysis(
+            dof_space, prim, configuration, exclude_homogeneous_modes,
+            include_default_occ_modes, sublattice_index_to_default_occ,
+            site_index_to_default_occ, calc_wedges, log,
+            use_character_projection, use_kstar_blocks, n_threads));
+    if (cache_dir.has_value()) {
+      jsonParser json;
+      dof_space_to_json(results->symmetry_adapted_dof_space,
+                        json["symmetry_adapted_dof_space"]);
+      report_to_json(results->symmetry_report, json["symmetry_report"]);
+      write_results_json(*cache_dir, key, json);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_dof_space_results.emplace(key, results).first->second;
+}
+
+/// \brief Return `config_space_analysis` results
+///
+/// Parameters are the same as for `config::config_space_analysis`.
+/// Progress is only reported if the analysis is not found in the cache.
+///
+/// \returns Shared results, equal to those of
+///     `config::config_space_analysis`. If `configurations` is empty, the
+///     results are not cached.
+std::shared_ptr<DoFSpaceAnalysisCache::config_space_results_type const>
+DoFSpaceAnalysisCache::config_space_analysis(
+    std::map<std::string, Configuration> const &configurations,
+    std::optional<std::vector<DoFKey>> dofs,
+    std::optional<bool> exclude_homogeneous_modes,
+    bool include_default_occ_modes,
+    std::optional<std::map<int, int>> sublattice_index_to_default_occ,
+    std::optional<std::map<Index, int>> site_index_to_default_occ, double tol,
+    bool store_equivalents, Index batch_size, Index n_threads,
+    std::shared_ptr<ProgressMonitor> progress) {
+  auto _analyze = [&]() {
+    return std::make_shared<config_space_results_type const>(
+        config::config_space_analysis(
+            configurations, dofs, exclude_homogeneous_modes,
+            include_default_occ_modes, sublattice_index_to_default_occ,
+            site_index_to_default_occ, tol, store_equivalents, batch_size,
+            n_threads, progress));
+  };
+  if (configurations.empty()) {
+    return _analyze();
+  }
+  std::shared_ptr<Prim const> prim =
+      configurations.begin()->second.supercell->prim;
+
+  // batch_size only affects how the projector is accumulated, so it is not
+  // part of the key
+  jsonParser key_json;
+  key_json["method"] = "config_space_analysis";
+  write_prim(*prim->basicstructure, key_json["prim"], FRAC);
+  jsonParser &configurations_json = key_json["configurations"].put_obj();
+  for (auto const &pair : configurations) {
+    to_json(pair.second, configurations_json[pair.first]);
+  }
+  if (dofs.has_value()) {
+    to_json(*dofs, key_json["dofs"]);
+  }
+  options_to_json(exclude_homogeneous_modes, include_default_occ_modes,
+                  sublattice_index_to_default_occ, site_index_to_default_occ,
+                  key_json);
+  key_json["tol"] = tol;
+  key_json["store_equivalents"] = store_equivalents;
+  std::stringstream ss;
+  ss << key_json;
+  std::string key = ss.str();
+
+  std::optional<fs::path> cache_dir;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_config_space_results.find(key);
+    if (it != m_config_space_results.end()) {
+      return it->second;
+    }
+    cache_dir = m_cache_dir;
+  }
+
+  std::shared_ptr<config_space_results_type const> results;
+  if (cache_dir.has_value()) {
+    std::optional<jsonParser> json = read_results_json(*cache_dir, key);
+    if (json.has_value()) {
+      try {
+        auto _results = std::make_shared<config_space_results_type>();
+        for (auto it = json->begin(); it != json->end(); ++it) {
+          jsonParser const &r = *it;
+          std::map<std::string, std::vector<Eigen::VectorXd>>
+              equivalent_dof_values;
+          for (auto jt = r["equivalent_dof_values"].begin();
+               jt != r["equivalent_dof_values"].end(); ++jt) {
+            auto &values = equivalent_dof_values[jt.name()];
+            for (auto const &x_json : *jt) {
+              Eigen::VectorXd x;
+              from_json(x, x_json);
+              values.push_back(x);
+            }
+          }
+          std::map<std::string, std::vector<Configuration>>
+              equivalent_configurations;
+          for (auto jt = r["equivalent_configurations"].begin();
+               jt != r["equivalent_configurations"].end(); ++jt) {
+            auto &equivalents = equivalent_configurations[jt.name()];
+            for (auto const &config_json : *jt) {
+              equivalents.push_back(
+                  jsonConstructor<Configuration>::from_json(config_json,
+                                                            prim));
+            }
+          }
+          Eigen::MatrixXd projector;
+          from_json(projector, r["projector"]);
+          Eigen::VectorXd eigenvalues;
+          from_json(eigenvalues, r["eigenvalues"]);
+          _results->emplace(
+              std::piecewise_construct, std::forward_as_tuple(it.name()),
+              std::forward_as_tuple(
+                  dof_space_from_json(r["standard_dof_space"], *prim),
+                  std::move(equivalent_dof_values),
+                  std::move(equivalent_configurations), projector,
+                  eigenvalues,
+                  dof_space_from_json(r["symmetry_adapted_dof_space"],
+                                      *prim)));
+        }
+        results = _results;
+      } catch (std::exception const &e) {
+        results = nullptr;
+      }
+    }
+  }
+  if (!results) {
+    results = _analyze();
+    if (cache_dir.has_value()) {
+      jsonParser json;
+      json.put_obj();
+      for (auto const &pair : *results) {
+        ConfigSpaceAnalysisResults const &value = pair.second;
+        jsonParser &r = json[pair.first];
+        dof_space_to_json(value.standard_dof_space, r["standard_dof_space"]);
+        jsonParser &values_json = r["equivalent_dof_values"].put_obj();
+        for (auto const &values : value.equivalent_dof_values) {
+          jsonParser &x_json = values_json[values.first].put_array();
+          for (auto const &x : values.second) {
+            jsonParser tjson;
+            to_json_array(x, tjson);
+            x_json.push_back(tjson);
+          }
+        }
+        jsonParser &configs_json = r["equivalent_configurations"].put_obj();
+        for (auto const &equivalents : value.equivalent_configurations) {
+          jsonParser &c_json = configs_json[equivalents.first].put_array();
+          for (auto const &equivalent : equivalents.second) {
+            jsonParser tjson;
+            to_json(equivalent, tjson);
+            c_json.push_back(tjson);
+          }
+        }
+        r["projector"] = value.projector;
+        to_json_array(value.eigenvalues, r["eigenvalues"]);
+        dof_space_to_json(value.symmetry_adapted_dof_space,
+                          r["symmetry_adapted_dof_space"]);
+      }
+      write_results_json(*cache_dir, key, json);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_config_space_results.emplace(key, results).first->second;
+}
+
+/// \brief Directory for results files, or std::nullopt for memory only
+std::optional<fs::path> DoFSpaceAnalysisCache::cache_dir() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cache_dir;
+}
+
+/// \brief Set the directory for results files, or std::nullopt for memory
+///     only
+void DoFSpaceAnalysisCache::set_cache_dir(
+    std::optional<fs::path> _cache_dir) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cache_dir = _cache_dir;
+}
+
+/// \brief Number of results held in memory
+Index DoFSpaceAnalysisCache::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_dof_space_results.size() + m_config_space_results.size();
+}
+
+/// \brief Clear results held in memory, leaving any results files
+void DoFSpaceAnalysisCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_dof_space_results.clear();
+  m_config_space_results.clear();
+}
+
+/// \brief Process-wide DoFSpaceAnalysisCache, memory only unless a cache
+///     directory is set
+DoFSpaceAnalysisCache &default_dof_space_analysis_cache() {
+  static DoFSpaceAnalysisCache cache;
+  return cache;
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -1,8 +1,262 @@
 #include "casm/configuration/DoFSpace_functions.hh"
 
+#include <cmath>
+#include <numeric>
+
+#include "casm/crystallography/AnisoValTraits.hh"
+
 namespace CASM {
 namespace config {
 
+namespace {  // (anonymous)
+
+/// \brief Throw if `sublattice_index_to_default_occ` has an invalid
+///     sublattice or occupant index
+void validate_sublattice_index_to_default_occ(
+    xtal::BasicStructure const &prim,
+    std::map<int, int> const &sublattice_index_to_default_occ,
+    std::string const &function_name) {
+  for (auto const &pair : sublattice_index_to_default_occ) {
+    int b = pair.first;
+    int default_occ = pair.second;
+    if (b < 0 || b >= prim.basis().size()) {
+      std::stringstream ss;
+      ss << "Error in " << function_name << ": sublattice=" << b
+         << " is out of range" << std::endl;
+      throw std::runtime_error(ss.str());
+    }
+    auto const &site = prim.basis()[b];
+    if (default_occ < 0 || default_occ >= site.occupant_dof().size()) {
+      std::stringstream ss;
+      ss << "Error in " << function_name << ": default_occ=" << default_occ
+         << " is out of range for sublattice=" << b << std::endl;
+      throw std::runtime_error(ss.str());
+    }
+  }
+}
+
+/// \brief Throw if `site_index_to_default_occ` has an invalid site or
+///     occupant index
+void validate_site_index_to_default_occ(
+    xtal::BasicStructure const &prim,
+    xtal::UnitCellCoordIndexConverter const &l_to_bijk,
+    std::map<Index, int> const &site_index_to_default_occ,
+    std::string const &function_name) {
+  for (auto const &pair : site_index_to_default_occ) {
+    Index l = pair.first;
+    if (l < 0 || l >= l_to_bijk.total_sites()) {
+      std::stringstream ss;
+      ss << "Error in " << function_name << ": site=" << l
+         << " is out of range" << std::endl;
+      throw std::runtime_error(ss.str());
+    }
+    int b = l_to_bijk(l).sublattice();
+    int default_occ = pair.second;
+    auto const &site = prim.basis()[b];
+    if (default_occ < 0 || default_occ >= site.occupant_dof().size()) {
+      std::stringstream ss;
+      ss << "Error in " << function_name << ": default_occ=" << default_occ
+         << " is out of range for site=" << l << " (sublattice=" << b << ")"
+         << std::endl;
+      throw std::runtime_error(ss.str());
+    }
+  }
+}
+
+/// \brief Gather the DoF values vector of `dof_values`, for the axes
+///     (`site_index[i]`, `dof_component[i]`) of a local DoF space
+///
+/// For occupation DoF, this is the indicator variables.
+void gather_dof_vector_value(Eigen::Ref<Eigen::VectorXd> x,
+                             ConfigDoFValues const &dof_values,
+                             DoFKey const &dof_key,
+                             std::vector<Index> const &site_index,
+                             std::vector<Index> const &dof_component) {
+  if (dof_key == "occ") {
+    Eigen::VectorXi const &occupation = dof_values.occupation;
+    for (Index j = 0; j < x.size(); ++j) {
+      x(j) = (occupation(site_index[j]) == dof_component[j]) ? 1.0 : 0.0;
+    }
+  } else {
+    Eigen::MatrixXd const &values = dof_values.local_dof_values.at(dof_key);
+    for (Index j = 0; j < x.size(); ++j) {
+      x(j) = values(dof_component[j], site_index[j]);
+    }
+  }
+}
+
+/// \brief Throw if `configuration` is not in the supercell with
+///     transformation matrix `T`
+void check_in_supercell(Configuration const &configuration,
+                        Eigen::Matrix3l const &T,
+                        std::string const &function_name) {
+  if (configuration.supercell->superlattice.transformation_matrix_to_super() !=
+      T) {
+    throw std::runtime_error("Error in " + function_name +
+                             ": configuration is not in the DoFSpace "
+                             "supercell");
+  }
+}
+
+/// \brief Return true if the columns of `basis` are orthonormal
+bool is_orthonormal(Eigen::SparseMatrix<double> const &basis, double tol) {
+  Eigen::SparseMatrix<double> I(basis.cols(), basis.cols());
+  I.setIdentity();
+  Eigen::SparseMatrix<double> R = basis.transpose() * basis - I;
+  for (Index k = 0; k < R.outerSize(); ++k) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(R, k); it; ++it) {
+      if (std::abs(it.value()) > tol) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// \brief Return true if `basis` is the identity matrix
+bool is_identity(Eigen::SparseMatrix<double> const &basis, double tol) {
+  if (basis.rows() != basis.cols()) {
+    return false;
+  }
+  Index n_diagonal = 0;
+  for (Index k = 0; k < basis.outerSize(); ++k) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(basis, k); it; ++it) {
+      if (it.row() != it.col()) {
+        if (std::abs(it.value()) > tol) {
+          return false;
+        }
+      } else if (std::abs(it.value() - 1.0) > tol) {
+        return false;
+      } else {
+        ++n_diagonal;
+      }
+    }
+  }
+  return n_diagonal == basis.rows();
+}
+
+/// \brief Return the pseudo-inverse of a sparse basis
+///
+/// If the columns are orthonormal, as for selections of standard axes, this
+/// is the transpose. Otherwise, the dense pseudo-inverse is calculated.
+Eigen::SparseMatrix<double> make_sparse_basis_inv(
+    Eigen::SparseMatrix<double> const &basis, double tol = TOL) {
+  if (is_orthonormal(basis, tol)) {
+    return basis.transpose();
+  }
+  Eigen::MatrixXd dense_basis(basis);
+  Eigen::MatrixXd dense_inv =
+      dense_basis.completeOrthogonalDecomposition().pseudoInverse();
+  return dense_inv.sparseView(1.0, tol);
+}
+
+/// \brief Make a SparseDoFSpace with the axes of `dof_space` and a new
+///     basis
+SparseDoFSpace make_sparse_dof_space_with_basis(
+    SparseDoFSpace const &dof_space, Eigen::SparseMatrix<double> basis) {
+  SparseDoFSpace result = dof_space;
+  result.basis_inv = make_sparse_basis_inv(basis);
+  result.basis = std::move(basis);
+  return result;
+}
+
+/// \brief Set the rows `is_excluded_row[i] == true` of a sparse basis to
+///     zero, and then remove the columns that are entirely zero
+Eigen::SparseMatrix<double> exclude_rows(
+    Eigen::SparseMatrix<double> const &basis,
+    std::vector<bool> const &is_excluded_row) {
+  std::vector<Eigen::Triplet<double>> triplets;
+  Index n_cols = 0;
+  for (Index k = 0; k < basis.outerSize(); ++k) {
+    double max_abs = 0.0;
+    Index begin = triplets.size();
+    for (Eigen::SparseMatrix<double>::InnerIterator it(basis, k); it; ++it) {
+      if (is_excluded_row[it.row()]) {
+        continue;
+      }
+      triplets.emplace_back(it.row(), n_cols, it.value());
+      max_abs = std::max(max_abs, std::abs(it.value()));
+    }
+    if (max_abs <= TOL) {
+      triplets.resize(begin);
+    } else {
+      ++n_cols;
+    }
+  }
+  Eigen::SparseMatrix<double> result(basis.rows(), n_cols);
+  result.setFromTriplets(triplets.begin(), triplets.end());
+  return result;
+}
+
+/// \brief Throw if a SparseDoFSpace is not a local occupation DoF space
+void check_sparse_occ_dof_space(SparseDoFSpace const &dof_space,
+                                std::string const &function_name) {
+  if (dof_space.dof_key != "occ") {
+    throw std::runtime_error("Error in " + function_name +
+                             ": Not occupation DoF");
+  }
+  if (!dof_space.transformation_matrix_to_super.has_value()) {
+    throw std::runtime_error("Error in " + function_name +
+                             ": no transformation_matrix_to_super");
+  }
+}
+
+/// \brief Add an orthonormal basis, as columns starting at `col`, of the
+///     vectors on `rows[begin, end)` that are orthogonal to the uniform
+///     vector
+///
+/// The basis is Haar-like: the range is split at its midpoint, and the
+/// column is +1/a on the `a` rows of the first part and -1/b on the `b`
+/// rows of the second part, normalized, and then each part is split
+/// recursively. This gives `end - begin - 1` columns with
+/// O((end - begin) * log(end - begin)) non-zero values.
+void add_uniform_complement(std::vector<Index> const &rows, Index begin,
+                            Index end, Index &col,
+                            std::vector<Eigen::Triplet<double>> &triplets) {
+  if (end - begin < 2) {
+    return;
+  }
+  Index mid = begin + (end - begin) / 2;
+  double a = mid - begin;
+  double b = end - mid;
+  double norm = std::sqrt(1.0 / a + 1.0 / b);
+  for (Index i = begin; i < mid; ++i) {
+    triplets.emplace_back(rows[i], col, 1.0 / a / norm);
+  }
+  for (Index i = mid; i < end; ++i) {
+    triplets.emplace_back(rows[i], col, -1.0 / b / norm);
+  }
+  ++col;
+  add_uniform_complement(rows, begin, mid, col, triplets);
+  add_uniform_complement(rows, mid, end, col, triplets);
+}
+
+/// \brief Return true if the homogeneous modes of `dof_space` are uniform
+///     vectors, one for each DoF component
+///
+/// This is the case if the basis is the identity and every prim site with
+/// the DoF uses the full standard DoF basis.
+bool has_uniform_homogeneous_modes(SparseDoFSpace const &dof_space) {
+  if (dof_space.is_global || dof_space.dof_key == "occ" ||
+      !is_identity(dof_space.basis, TOL)) {
+    return false;
+  }
+  for (auto const &site : dof_space.prim->basis()) {
+    if (!site.has_dof(dof_space.dof_key)) {
+      continue;
+    }
+    Eigen::MatrixXd const &site_basis = site.dof(dof_space.dof_key).basis();
+    if (site_basis.rows() != site_basis.cols() ||
+        !almost_equal(site_basis, Eigen::MatrixXd::Identity(
+                                      site_basis.rows(), site_basis.cols()))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 /// Removes specified occupation modes from the DoFSpace basis, by sublattice
 ///
 /// \param dof_space Initial DoF space
@@ -37,24 +291,9 @@ clexulator::DoFSpace exclude_default_occ_modes_by_sublattice(
   auto const &T = *dof_space.transformation_matrix_to_super;
   xtal::UnitCellCoordIndexConverter l_to_bijk(T, prim.basis().size());
 
-  // validate sublattice_index_to_default_occ
-  for (auto const &pair : sublattice_index_to_default_occ) {
-    int b = pair.first;
-    int default_occ = pair.second;
-    if (b < 0 || b >= prim.basis().size()) {
-      std::stringstream ss;
-      ss << "Error in exclude_default_occ_modes_by_sublattice: sublattice=" << b
-         << " is out of range" << std::endl;
-      throw std::runtime_error(ss.str());
-    }
-    auto const &site = prim.basis()[b];
-    if (default_occ < 0 || default_occ >= site.occupant_dof().size()) {
-      std::stringstream ss;
-      ss << "Error in exclude_default_occ_modes_by_sublattice: default_occ="
-         << default_occ << " is out of range for sublattice=" << b << std::endl;
-      throw std::runtime_error(ss.str());
-    }
-  }
+  validate_sublattice_index_to_default_occ(
+      prim, sublattice_index_to_default_occ,
+      "exclude_default_occ_modes_by_sublattice");
 
   // Copy current basis
   Eigen::MatrixXd basis = dof_space.basis;
@@ -128,26 +367,9 @@ clexulator::DoFSpace exclude_default_occ_modes_by_site(
   auto const &T = *dof_space.transformation_matrix_to_super;
   xtal::UnitCellCoordIndexConverter l_to_bijk(T, prim.basis().size());
 
-  // validate site_index_to_default_occ
-  for (auto const &pair : site_index_to_default_occ) {
-    Index l = pair.first;
-    if (l < 0 || l >= l_to_bijk.total_sites()) {
-      std::stringstream ss;
-      ss << "Error in exclude_default_occ_modes_by_site: site=" << l
-         << " is out of range" << std::endl;
-      throw std::runtime_error(ss.str());
-    }
-    int b = l_to_bijk(l).sublattice();
-    int default_occ = pair.second;
-    auto const &site = prim.basis()[b];
-    if (default_occ < 0 || default_occ >= site.occupant_dof().size()) {
-      std::stringstream ss;
-      ss << "Error in exclude_default_occ_modes_by_site: default_occ="
-         << default_occ << " is out of range for site=" << l
-         << " (sublattice=" << b << ")" << std::endl;
-      throw std::runtime_error(ss.str());
-    }
-  }
+  validate_site_index_to_default_occ(prim, l_to_bijk,
+                                     site_index_to_default_occ,
+                                     "exclude_default_occ_modes_by_site");
 
   // Copy current basis
   Eigen::MatrixXd basis = dof_space.basis;
@@ -249,5 +471,397 @@ clexulator::DoFSpace exclude_homogeneous_mode_space(
   }
 }
 
+/// \brief Return DoF values vectors of many configurations, as columns
+///
+/// The DoF values of all configurations are gathered into one matrix, so
+/// they can be projected onto the DoFSpace basis by one matrix-matrix
+/// product.
+///
+/// \param configurations The configurations. For local DoF, all must be in
+///     the DoFSpace supercell.
+/// \param dof_space The DoFSpace
+///
+/// \returns A matrix, X, with `dof_space.basis.rows()` rows and one column
+///     per configuration, where `X.col(i)` is the DoF values vector of
+///     `configurations[i]`, as from `clexulator::get_dof_vector_value`. For
+///     occupation DoF, this is the indicator variables.
+Eigen::MatrixXd make_dof_vector_values(
+    std::vector<Configuration> const &configurations,
+    clexulator::DoFSpace const &dof_space) {
+  Index dim = dof_space.basis.rows();
+  Eigen::MatrixXd X(dim, configurations.size());
+  if (dof_space.is_global) {
+    for (Index i = 0; i < configurations.size(); ++i) {
+      X.col(i) = configurations[i].dof_values.global_dof_values.at(
+          dof_space.dof_key);
+    }
+    return X;
+  }
+
+  if (!dof_space.transformation_matrix_to_super.has_value() ||
+      !dof_space.axis_info.site_index.has_value() ||
+      !dof_space.axis_info.dof_component.has_value()) {
+    throw std::runtime_error(
+        "Error in make_dof_vector_values: DoFSpace has no supercell");
+  }
+  Eigen::Matrix3l const &T = *dof_space.transformation_matrix_to_super;
+  std::vector<Index> const &site_index = *dof_space.axis_info.site_index;
+  std::vector<Index> const &dof_component = *dof_space.axis_info.dof_component;
+  for (Index i = 0; i < configurations.size(); ++i) {
+    check_in_supercell(configurations[i], T, "make_dof_vector_values");
+    gather_dof_vector_value(X.col(i), configurations[i].dof_values,
+                            dof_space.dof_key, site_index, dof_component);
+  }
+  return X;
+}
+
+/// \brief Return normal coordinates of many configurations, as rows
+///
+/// \param configurations The configurations. For local DoF, all must be in
+///     the DoFSpace supercell.
+/// \param dof_space The DoFSpace
+///
+/// \returns A matrix, with one row per configuration and
+///     `dof_space.basis.cols()` columns, where `row(i)` is the normal
+///     coordinate of `configurations[i]`, as from
+///     `clexulator::get_normal_coordinate`. The DoF values are gathered with
+///     `make_dof_vector_values` and projected by one matrix-matrix product.
+Eigen::MatrixXd make_normal_coordinates(
+    std::vector<Configuration> const &configurations,
+    clexulator::DoFSpace const &dof_space) {
+  return (dof_space.basis_inv *
+          make_dof_vector_values(configurations, dof_space))
+      .transpose();
+}
+
+/// \brief Make the standard SparseDoFSpace, with identity basis
+///
+/// \param dof_key The DoF type
+/// \param prim The prim
+/// \param transformation_matrix_to_super Supercell transformation matrix,
+///     for local DoF. Default is the identity matrix.
+/// \param sites Supercell sites included, for local DoF. Default is all
+///     sites.
+///
+/// \returns A SparseDoFSpace with the same axes as
+///     `clexulator::make_dof_space(dof_key, prim,
+///     transformation_matrix_to_super, sites)`, and identity basis. For
+///     local DoF, the axes are constructed from the prim DoF space, by
+///     supercell site, without constructing the dense supercell basis.
+SparseDoFSpace make_sparse_dof_space(
+    DoFKey const &dof_key,
+    std::shared_ptr<xtal::BasicStructure const> const &prim,
+    std::optional<Eigen::Matrix3l> transformation_matrix_to_super,
+    std::optional<std::set<Index>> sites) {
+  if (!transformation_matrix_to_super.has_value()) {
+    transformation_matrix_to_super = Eigen::Matrix3l::Identity();
+  }
+  clexulator::DoFSpace prim_dof_space =
+      clexulator::make_dof_space(dof_key, prim, Eigen::Matrix3l::Identity());
+  if (prim_dof_space.is_global) {
+    return make_sparse_dof_space(clexulator::make_dof_space(
+        dof_key, prim, transformation_matrix_to_super, sites));
+  }
+
+  // prim axes, by sublattice
+  std::vector<Index> const &prim_site_index =
+      *prim_dof_space.axis_info.site_index;
+  std::vector<Index> const &prim_dof_component =
+      *prim_dof_space.axis_info.dof_component;
+  std::vector<std::vector<Index>> dof_component_by_sublattice(
+      prim->basis().size());
+  for (Index i = 0; i < prim_site_index.size(); ++i) {
+    dof_component_by_sublattice[prim_site_index[i]].push_back(
+        prim_dof_component[i]);
+  }
+
+  SparseDoFSpace dof_space;
+  dof_space.prim = prim;
+  dof_space.dof_key = dof_key;
+  dof_space.is_global = false;
+  dof_space.transformation_matrix_to_super = transformation_matrix_to_super;
+  dof_space.sites = sites;
+
+  xtal::UnitCellCoordIndexConverter l_to_bijk(*transformation_matrix_to_super,
+                                              prim->basis().size());
+  auto add_site = [&](Index l) {
+    for (Index component : dof_component_by_sublattice[l_to_bijk(l)
+                                                           .sublattice()]) {
+      dof_space.axis_site_index.push_back(l);
+      dof_space.axis_dof_component.push_back(component);
+    }
+  };
+  if (sites.has_value()) {
+    for (Index l : *sites) {
+      add_site(l);
+    }
+  } else {
+    for (Index l = 0; l < l_to_bijk.total_sites(); ++l) {
+      add_site(l);
+    }
+  }
+
+  Index dim = dof_space.axis_site_index.size();
+  dof_space.basis.resize(dim, dim);
+  dof_space.basis.setIdentity();
+  dof_space.basis_inv = dof_space.basis;
+  return dof_space;
+}
+
+/// \brief Make a SparseDoFSpace from a DoFSpace
+///
+/// \param dof_space A DoFSpace
+/// \param tol Basis and pseudo-inverse values with magnitude less than or
+///     equal to `tol` are not stored
+///
+/// \returns A SparseDoFSpace, with the same axes and basis as `dof_space`
+SparseDoFSpace make_sparse_dof_space(clexulator::DoFSpace const &dof_space,
+                                     double tol) {
+  SparseDoFSpace result;
+  result.prim = dof_space.prim;
+  result.dof_key = dof_space.dof_key;
+  result.is_global = dof_space.is_global;
+  result.transformation_matrix_to_super =
+      dof_space.transformation_matrix_to_super;
+  result.sites = dof_space.sites;
+  if (dof_space.axis_info.site_index.has_value()) {
+    result.axis_site_index = *dof_space.axis_info.site_index;
+  }
+  if (dof_space.axis_info.dof_component.has_value()) {
+    result.axis_dof_component = *dof_space.axis_info.dof_component;
+  } else {
+    result.axis_dof_component.resize(dof_space.basis.rows());
+    std::iota(result.axis_dof_component.begin(),
+              result.axis_dof_component.end(), 0);
+  }
+  result.basis = dof_space.basis.sparseView(1.0, tol);
+  result.basis_inv = dof_space.basis_inv.sparseView(1.0, tol);
+  return result;
+}
+
+/// \brief Make the DoFSpace equivalent to a SparseDoFSpace
+///
+/// This constructs the dense basis, and should be used for results, not for
+/// the intermediate spaces of large supercells.
+clexulator::DoFSpace make_dense_dof_space(SparseDoFSpace const &dof_space) {
+  return clexulator::make_dof_space(
+      dof_space.dof_key, dof_space.prim,
+      dof_space.transformation_matrix_to_super, dof_space.sites,
+      Eigen::MatrixXd(dof_space.basis));
+}
+
+/// Removes specified occupation modes from the SparseDoFSpace basis, by
+/// sublattice
+///
+/// \param dof_space Initial DoF space
+/// \param sublattice_index_to_default_occ Table of prim sublattice index to
+///     occupation index to treat as the default occupant and remove
+/// \return SparseDoFSpace with the same result as the DoFSpace overload:
+///     rows corresponding to the default occupant are set to zero, and then
+///     columns that are entirely zero are removed.
+SparseDoFSpace exclude_default_occ_modes_by_sublattice(
+    SparseDoFSpace const &dof_space,
+    std::map<int, int> sublattice_index_to_default_occ) {
+  check_sparse_occ_dof_space(dof_space,
+                             "exclude_default_occ_modes_by_sublattice");
+  xtal::BasicStructure const &prim = *dof_space.prim;
+  xtal::UnitCellCoordIndexConverter l_to_bijk(
+      *dof_space.transformation_matrix_to_super, prim.basis().size());
+  validate_sublattice_index_to_default_occ(
+      prim, sublattice_index_to_default_occ,
+      "exclude_default_occ_modes_by_sublattice");
+
+  std::vector<bool> is_excluded_row(dof_space.dim(), false);
+  for (Index i = 0; i < dof_space.dim(); ++i) {
+    int b = l_to_bijk(dof_space.axis_site_index[i]).sublattice();
+    auto it = sublattice_index_to_default_occ.find(b);
+    if (it != sublattice_index_to_default_occ.end() &&
+        dof_space.axis_dof_component[i] == it->second) {
+      is_excluded_row[i] = true;
+    }
+  }
+  return make_sparse_dof_space_with_basis(
+      dof_space, exclude_rows(dof_space.basis, is_excluded_row));
+}
+
+/// Removes specified occupation modes from the SparseDoFSpace basis, by
+/// supercell site index
+///
+/// \param dof_space Initial DoF space
+/// \param site_index_to_default_occ Table of supercell site index to
+///     occupation index to treat as the default occupant and remove
+/// \return SparseDoFSpace with the same result as the DoFSpace overload:
+///     rows corresponding to the default occupant are set to zero, and then
+///     columns that are entirely zero are removed.
+SparseDoFSpace exclude_default_occ_modes_by_site(
+    SparseDoFSpace const &dof_space,
+    std::map<Index, int> site_index_to_default_occ) {
+  check_sparse_occ_dof_space(dof_space, "exclude_default_occ_modes_by_site");
+  xtal::BasicStructure const &prim = *dof_space.prim;
+  xtal::UnitCellCoordIndexConverter l_to_bijk(
+      *dof_space.transformation_matrix_to_super, prim.basis().size());
+  validate_site_index_to_default_occ(prim, l_to_bijk,
+                                     site_index_to_default_occ,
+                                     "exclude_default_occ_modes_by_site");
+
+  std::vector<bool> is_excluded_row(dof_space.dim(), false);
+  for (Index i = 0; i < dof_space.dim(); ++i) {
+    auto it = site_index_to_default_occ.find(dof_space.axis_site_index[i]);
+    if (it != site_index_to_default_occ.end() &&
+        dof_space.axis_dof_component[i] == it->second) {
+      is_excluded_row[i] = true;
+    }
+  }
+  return make_sparse_dof_space_with_basis(
+      dof_space, exclude_rows(dof_space.basis, is_excluded_row));
+}
+
+/// Removes specified occupation modes from the SparseDoFSpace basis
+///
+/// Parameters are the same as for the DoFSpace overload. If neither
+/// `site_index_to_default_occ` nor `sublattice_index_to_default_occ` is
+/// provided, occupation index 0 is the default occupant on every
+/// sublattice.
+SparseDoFSpace exclude_default_occ_modes(
+    SparseDoFSpace const &dof_space_in, bool include_default_occ_modes,
+    std::optional<std::map<int, int>> sublattice_index_to_default_occ,
+    std::optional<std::map<Index, int>> site_index_to_default_occ) {
+  if (dof_space_in.dof_key == "occ" && !include_default_occ_modes) {
+    if (site_index_to_default_occ.has_value()) {
+      return exclude_default_occ_modes_by_site(dof_space_in,
+                                               *site_index_to_default_occ);
+    } else if (sublattice_index_to_default_occ.has_value()) {
+      return exclude_default_occ_modes_by_sublattice(
+          dof_space_in, *sublattice_index_to_default_occ);
+    } else {
+      std::map<int, int> default_occ;
+      for (int b = 0; b < dof_space_in.prim->basis().size(); ++b) {
+        default_occ[b] = 0;
+      }
+      return exclude_default_occ_modes_by_sublattice(dof_space_in,
+                                                     default_occ);
+    }
+  }
+  return dof_space_in;
+}
+
+/// Removes homogeneous modes from the SparseDoFSpace basis
+///
+/// \param dof_space_in The SparseDoFSpace
+/// \param exclude_homogeneous_modes Exclude homogeneous modes if this
+///     is true, or include if this is false. If this is null (default),
+///     exclude homogeneous modes for dof==\"disp\" only.
+///
+/// If `dof_space_in` has an identity basis, and every site with the DoF
+/// uses the standard DoF basis, the homogeneous modes are the uniform
+/// vectors over the axes of each DoF component, and the orthogonal
+/// complement is constructed directly as a sparse Haar-like basis.
+/// Otherwise, the dense DoFSpace is constructed and passed to
+/// `clexulator::exclude_homogeneous_mode_space`.
+SparseDoFSpace exclude_homogeneous_mode_space(
+    SparseDoFSpace const &dof_space_in,
+    std::optional<bool> exclude_homogeneous_modes) {
+  if (!exclude_homogeneous_modes.has_value()) {
+    exclude_homogeneous_modes = (dof_space_in.dof_key == "disp");
+  }
+  if (!*exclude_homogeneous_modes) {
+    return dof_space_in;
+  }
+  if (!has_uniform_homogeneous_modes(dof_space_in)) {
+    return make_sparse_dof_space(clexulator::exclude_homogeneous_mode_space(
+        make_dense_dof_space(dof_space_in)));
+  }
+
+  std::map<Index, std::vector<Index>> rows_by_dof_component;
+  for (Index i = 0; i < dof_space_in.dim(); ++i) {
+    rows_by_dof_component[dof_space_in.axis_dof_component[i]].push_back(i);
+  }
+  std::vector<Eigen::Triplet<double>> triplets;
+  Index n_cols = 0;
+  for (auto const &pair : rows_by_dof_component) {
+    add_uniform_complement(pair.second, 0, pair.second.size(), n_cols,
+                           triplets);
+  }
+  Eigen::SparseMatrix<double> basis(dof_space_in.dim(), n_cols);
+  basis.setFromTriplets(triplets.begin(), triplets.end());
+
+  SparseDoFSpace result = dof_space_in;
+  result.basis_inv = basis.transpose();
+  result.basis = std::move(basis);
+  return result;
+}
+
+/// \brief Return DoF values vectors of many configurations, as columns
+///
+/// \param configurations The configurations. For local DoF, all must be in
+///     the SparseDoFSpace supercell.
+/// \param dof_space The SparseDoFSpace
+///
+/// \returns A matrix, X, with `dof_space.dim()` rows and one column per
+///     configuration, as for the DoFSpace overload.
+Eigen::MatrixXd make_dof_vector_values(
+    std::vector<Configuration> const &configurations,
+    SparseDoFSpace const &dof_space) {
+  Eigen::MatrixXd X(dof_space.dim(), configurations.size());
+  if (dof_space.is_global) {
+    for (Index i = 0; i < configurations.size(); ++i) {
+      X.col(i) = configurations[i].dof_values.global_dof_values.at(
+          dof_space.dof_key);
+    }
+    return X;
+  }
+  if (!dof_space.transformation_matrix_to_super.has_value()) {
+    throw std::runtime_error(
+        "Error in make_dof_vector_values: DoFSpace has no supercell");
+  }
+  Eigen::Matrix3l const &T = *dof_space.transformation_matrix_to_super;
+  for (Index i = 0; i < configurations.size(); ++i) {
+    check_in_supercell(configurations[i], T, "make_dof_vector_values");
+    gather_dof_vector_value(X.col(i), configurations[i].dof_values,
+                            dof_space.dof_key, dof_space.axis_site_index,
+                            dof_space.axis_dof_component);
+  }
+  return X;
+}
+
+/// \brief Return normal coordinates of many configurations, as rows
+///
+/// \param configurations The configurations. For local DoF, all must be in
+///     the SparseDoFSpace supercell.
+/// \param dof_space The SparseDoFSpace
+///
+/// \returns A matrix, with one row per configuration and
+///     `dof_space.basis.cols()` columns, where `row(i)` is the normal
+///     coordinate of `configurations[i]`. The projection costs
+///     O(nnz(basis_inv)) per configuration.
+Eigen::MatrixXd make_normal_coordinates(
+    std::vector<Configuration> const &configurations,
+    SparseDoFSpace const &dof_space) {
+  return (dof_space.basis_inv *
+          make_dof_vector_values(configurations, dof_space))
+      .transpose();
+}
+
+/// \brief Return the normal coordinate of DoF values in a SparseDoFSpace
+///
+/// \param dof_values The DoF values. For local DoF, must be DoF values of a
+///     configuration in the SparseDoFSpace supercell.
+/// \param dof_space The SparseDoFSpace
+///
+/// \returns The normal coordinate, `dof_space.basis_inv * x`, where `x` is
+///     the DoF values vector
+Eigen::VectorXd get_normal_coordinate(ConfigDoFValues const &dof_values,
+                                      SparseDoFSpace const &dof_space) {
+  Eigen::VectorXd x(dof_space.dim());
+  if (dof_space.is_global) {
+    x = dof_values.global_dof_values.at(dof_space.dof_key);
+  } else {
+    gather_dof_vector_value(x, dof_values, dof_space.dof_key,
+                            dof_space.axis_site_index,
+                            dof_space.axis_dof_component);
+  }
+  return dof_space.basis_inv * x;
+}
+
 }  // namespace config
 }  // namespace CASM
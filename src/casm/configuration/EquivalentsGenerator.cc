@@ -0,0 +1,62 @@
+#include "casm/configuration/EquivalentsGenerator.hh"
+
+#include "casm/configuration/ConfigIsEquivalent.hh"
+#include "casm/configuration/Supercell.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Generate the next distinct equivalent configuration
+void EquivalentsGenerator::advance() {
+  if (!is_valid()) {
+    return;
+  }
+  ++m_position;
+  _set_current();
+}
+
+void EquivalentsGenerator::_init(std::vector<SupercellSymOpHandle> const &ops) {
+  auto const &supercell = m_configuration.supercell;
+
+  // the invariant subgroup of all supercell operations, so that cosets
+  // cover every operation in [begin, end) whether or not it is a group
+  ConfigIsEquivalent equal_to_f(m_configuration);
+  auto end = SupercellSymOp::end(supercell);
+  for (auto it = SupercellSymOp::begin(supercell); it != end; ++it) {
+    if (equal_to_f(*it)) {
+      m_invariant_subgroup.emplace_back(*it);
+    }
+  }
+
+  // mark the left coset of each representative as covered
+  Index n_ops = supercell->sym_info().factor_group_permutations.size() *
+                supercell->superlattice.size();
+  std::vector<bool> covered(n_ops, false);
+  for (SupercellSymOpHandle const &op : ops) {
+    if (op.supercell() != supercell.get()) {
+      throw std::runtime_error(
+          "Error in EquivalentsGenerator: operation is not for the "
+          "configuration's supercell");
+    }
+    if (covered[op.op_index()]) {
+      continue;
+    }
+    m_representatives.push_back(op);
+    for (SupercellSymOpHandle const &h : m_invariant_subgroup) {
+      covered[(op * h).op_index()] = true;
+    }
+  }
+  _set_current();
+}
+
+void EquivalentsGenerator::_set_current() {
+  if (!is_valid()) {
+    return;
+  }
+  SupercellSymOpHandle const &rep = m_representatives[m_position];
+  m_op.reset(rep.supercell_factor_group_index(), rep.translation_index());
+  copy_apply(m_op, m_configuration.dof_values, m_current.dof_values);
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -1,5 +1,9 @@
 #include "casm/configuration/FromStructure.hh"
 
+#include <algorithm>
+#include <functional>
+#include <map>
+
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/clexulator/ConfigDoFValues.hh"
 #include "casm/clexulator/ConfigDoFValuesTools_impl.hh"
@@ -8,6 +12,7 @@
 #include "casm/configuration/SupercellSet.hh"
 #include "casm/configuration/definitions.hh"
 #include "casm/configuration/misc.hh"
+#include "casm/configuration/parallel.hh"
 #include "casm/crystallography/SimpleStructure.hh"
 #include "casm/crystallography/StrainConverter.hh"
 #include "casm/misc/Comparisons.hh"
@@ -135,10 +140,19 @@ void FromStructure::validate_atom_coords_or_throw(
   auto const &converter = supercell->unitcellcoord_index_converter;
   auto const &xtal_prim = supercell->prim->basicstructure;
   Index n_sites = converter.total_sites();
+
+  // site coordinates from the prim basis and unit cell translations, without
+  // constructing a Coordinate for each site
+  Eigen::Matrix3d const &L = xtal_prim->lattice().lat_column_mat();
+  std::vector<Eigen::Vector3d> basis_cart;
+  for (auto const &site : xtal_prim->basis()) {
+    basis_cart.push_back(site.const_cart());
+  }
   Eigen::MatrixXd R(3, n_sites);
   for (Index l = 0; l < n_sites; ++l) {
     xtal::UnitCellCoord bijk = converter(l);
-    R.col(l) = bijk.coordinate(*xtal_prim).const_cart();
+    R.col(l) = basis_cart[bijk.sublattice()] +
+               L * bijk.unitcell().cast<double>();
   }
 
   Eigen::MatrixXd disp;
@@ -689,5 +703,160 @@ FromDiscreteMagneticAtomicStructure::make_global_properties(
   return default_make_global_properties(mapped_structure);
 }
 
+/// \brief Find the supercell site at each of a set of Cartesian
+///     coordinates
+///
+/// \param cart_coords Cartesian coordinates, as columns of a 3 x n matrix.
+///     Coordinates may be in any order and may be outside the supercell.
+/// \param supercell The supercell
+/// \param tol Maximum distance between a coordinate and a site
+///
+/// \returns site_indices, where `site_indices[i]` is the linear index of the
+///     supercell site within `tol` of `cart_coords.col(i)`, or -1 if there
+///     is none. Sites are found periodically, so coordinates that differ by
+///     a supercell lattice translation find the same site.
+///
+/// Notes:
+/// - Instead of comparing each coordinate to each site, each coordinate is
+///   converted to fractional coordinates of the prim lattice and, for each
+///   sublattice, rounded to the nearest unit cell, which is wrapped into the
+///   supercell by the UnitCellCoordIndexConverter. This is
+///   O(n_coords * n_sublattice) instead of O(n_coords * n_sites).
+/// - Requires `tol` to be less than half of the minimum distance between
+///   sites, so that at most one site is within `tol`.
+std::vector<Index> make_site_indices_by_coordinate(
+    Eigen::MatrixXd const &cart_coords, Supercell const &supercell,
+    double tol) {
+  auto const &converter = supercell.unitcellcoord_index_converter;
+  auto const &xtal_prim = supercell.prim->basicstructure;
+  Eigen::Matrix3d const &L = xtal_prim->lattice().lat_column_mat();
+  Eigen::Matrix3d const &L_inv = xtal_prim->lattice().inv_lat_column_mat();
+  std::vector<Eigen::Vector3d> basis_frac;
+  for (auto const &site : xtal_prim->basis()) {
+    basis_frac.push_back(site.const_frac());
+  }
+
+  std::vector<Index> site_indices(cart_coords.cols(), -1);
+  for (Index i = 0; i < cart_coords.cols(); ++i) {
+    Eigen::Vector3d frac = L_inv * cart_coords.col(i);
+    for (Index b = 0; b < basis_frac.size(); ++b) {
+      Eigen::Vector3d d = frac - basis_frac[b];
+      Eigen::Vector3d ijk = d.array().round().matrix();
+      if ((L * (d - ijk)).norm() <= tol) {
+        site_indices[i] = converter(
+            xtal::UnitCellCoord(b, long(ijk(0)), long(ijk(1)), long(ijk(2))));
+        break;
+      }
+    }
+  }
+  return site_indices;
+}
+
+/// \brief Construct configurations with properties from many mapped
+///     structures, in parallel
+///
+/// \param prim The prim
+/// \param mapped_structures The mapped structures, as expected by
+///     FromIsotropicAtomicStructure or FromDiscreteMagneticAtomicStructure
+/// \param error_messages Set to have the same size as `mapped_structures`.
+///     If a structure cannot be converted, the corresponding value is set to
+///     the exception message, otherwise it is set to an empty string.
+/// \param converter The converter to use, one of "isotropic_atomic"
+///     (FromIsotropicAtomicStructure) or "discrete_magnetic_atomic"
+///     (FromDiscreteMagneticAtomicStructure).
+/// \param supercells Shared pointer to a SupercellSet. The supercells of the
+///     results are inserted and the results share the Supercell in
+///     `supercells`. An empty SupercellSet is constructed by default.
+/// \param magspin_tol Maximum allowed difference when mapping magspin, for
+///     the "discrete_magnetic_atomic" converter.
+/// \param n_threads Number of threads to use. If <= 0, the number of
+///     hardware threads is used.
+///
+/// \returns The configurations with properties, in the same order as
+///     `mapped_structures`, or std::nullopt for structures that could not be
+///     converted.
+///
+/// Notes:
+/// - A failure to convert one structure does not stop the batch; the error
+///   is reported in `error_messages`. An invalid `converter` or prim throws.
+/// - Structures are converted in contiguous chunks, each with its own
+///   converter and SupercellSet, so no locking is needed while converting.
+///   Afterwards, the supercell records of each chunk are inserted into
+///   `supercells` in order, without being reconstructed, and results are
+///   updated to share the Supercell in `supercells`.
+std::vector<std::optional<ConfigurationWithProperties>>
+make_configurations_from_structures(
+    std::shared_ptr<Prim const> const &prim,
+    std::vector<xtal::SimpleStructure> const &mapped_structures,
+    std::vector<std::string> &error_messages, std::string converter,
+    std::shared_ptr<SupercellSet> supercells, double magspin_tol,
+    Index n_threads) {
+  if (supercells == nullptr) {
+    supercells = std::make_shared<SupercellSet>(prim);
+  }
+
+  // construct a converter with its own SupercellSet
+  typedef std::function<ConfigurationWithProperties(
+      xtal::SimpleStructure const &)>
+      f_type;
+  auto make_f = [&](std::shared_ptr<SupercellSet> const &local_supercells) {
+    if (converter == "isotropic_atomic") {
+      return f_type(FromIsotropicAtomicStructure(prim, local_supercells));
+    } else if (converter == "discrete_magnetic_atomic") {
+      return f_type(FromDiscreteMagneticAtomicStructure(prim, local_supercells,
+                                                        magspin_tol));
+    }
+    throw std::runtime_error(
+        "Error in make_configurations_from_structures: Unknown converter: \"" +
+        converter + "\"");
+  };
+  // check converter and prim before starting
+  make_f(std::make_shared<SupercellSet>(prim));
+
+  Index n = mapped_structures.size();
+  std::vector<std::optional<ConfigurationWithProperties>> results(n);
+  error_messages.assign(n, std::string());
+  Index n_chunks =
+      std::max(Index(1), std::min(resolve_n_threads(n_threads), n));
+  std::vector<std::shared_ptr<SupercellSet>> chunk_supercells(n_chunks);
+
+  parallel_for_chunks(n, n_chunks, [&](Index c, Index begin, Index end) {
+    chunk_supercells[c] = std::make_shared<SupercellSet>(prim);
+    f_type f = make_f(chunk_supercells[c]);
+    for (Index i = begin; i < end; ++i) {
+      try {
+        results[i] = f(mapped_structures[i]);
+      } catch (std::exception const &e) {
+        error_messages[i] = e.what();
+      }
+    }
+  });
+
+  // share supercells
+  std::map<Supercell const *, std::shared_ptr<Supercell const>> shared;
+  for (auto const &local_supercells : chunk_supercells) {
+    if (local_supercells == nullptr) {
+      continue;
+    }
+    for (SupercellRecord const &record : *local_supercells) {
+      shared.emplace(record.supercell.get(),
+                     supercells->insert(record).first->supercell);
+    }
+  }
+  for (auto &result : results) {
+    if (!result.has_value()) {
+      continue;
+    }
+    std::shared_ptr<Supercell const> const &supercell =
+        shared.at(result->configuration.supercell.get());
+    if (supercell != result->configuration.supercell) {
+      result = ConfigurationWithProperties(
+          Configuration(supercell, result->configuration.dof_values),
+          result->local_properties, result->global_properties);
+    }
+  }
+  return results;
+}
+
 }  // namespace config
 }  // namespace CASM
@@ -0,0 +1,191 @@
+#include "casm/configuration/MatrixRepCache.hh"
+
+#include <stdexcept>
+
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/memory_usage.hh"
+#include "casm/crystallography/AnisoValTraits.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Memory used by the matrices, in bytes (approximate)
+Index MatrixRep::memory_bytes() const {
+  Index bytes = 0;
+  for (auto const &M : sparse_matrix_rep) {
+    bytes += M.nonZeros() * (sizeof(double) + sizeof(int)) +
+             (M.outerSize() + 1) * sizeof(int);
+  }
+  return bytes;
+}
+
+/// \brief Constructor
+///
+/// \param _max_total_bytes If the total memory used by cached matrices is
+///     larger than this, in bytes, least recently used entries are evicted
+///     (default=2^28, 256 MiB)
+MatrixRepCache::MatrixRepCache(Index _max_total_bytes)
+    : m_max_total_bytes(_max_total_bytes), m_total_bytes(0) {}
+
+/// \brief Return the sparse matrix representation of `group` that
+///     describes the transformation of the specified DoF
+///
+/// Parameters are the same as for `make_sparse_matrix_rep`.
+///
+/// \returns The shared matrix representation and SymGroup, equal to those
+///     constructed by `make_sparse_matrix_rep`. Errors are thrown as by
+///     `make_sparse_matrix_rep` and are not cached.
+std::shared_ptr<MatrixRep const> MatrixRepCache::matrix_rep(
+    std::vector<SupercellSymOp> const &group, DoFKey key,
+    std::optional<std::set<Index>> site_indices) {
+  if (group.size() == 0) {
+    throw std::runtime_error(
+        "Error in MatrixRepCache::matrix_rep: group has size==0.");
+  }
+  auto const &supercell = group[0].supercell();
+  Eigen::Matrix3l const &T =
+      supercell->superlattice.transformation_matrix_to_super();
+  std::vector<long> T_key(T.data(), T.data() + T.size());
+  std::vector<std::pair<Index, Index>> op_key;
+  op_key.reserve(group.size());
+  for (auto const &op : group) {
+    if (op.supercell() != supercell && *op.supercell() != *supercell) {
+      throw std::runtime_error(
+          "Error in MatrixRepCache::matrix_rep: operations are not all in "
+          "the same supercell");
+    }
+    op_key.emplace_back(op.supercell_factor_group_index(),
+                        op.translation_index());
+  }
+  if (AnisoValTraits(key).global()) {
+    // sites do not affect global DoF matrix reps
+    site_indices = std::nullopt;
+  }
+  key_type cache_key(supercell->prim.get(), std::move(T_key),
+                     std::move(op_key), key, site_indices);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(cache_key);
+    if (it != m_index.end()) {
+      m_lru.splice(m_lru.begin(), m_lru, it->second);
+      return it->second->value;
+    }
+  }
+
+  // construct without holding the lock
+  auto value = std::make_shared<MatrixRep>();
+  value->sparse_matrix_rep =
+      make_sparse_matrix_rep(group, key, site_indices, value->symgroup);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(cache_key);
+    if (it != m_index.end()) {
+      m_lru.splice(m_lru.begin(), m_lru, it->second);
+      return it->second->value;
+    }
+    m_lru.push_front(Entry{cache_key, supercell->prim, value});
+    m_index.emplace(cache_key, m_lru.begin());
+    m_total_bytes += value->memory_bytes();
+    _evict();
+  }
+  enforce_memory_budget();
+  return value;
+}
+
+/// \brief Return the dense matrix representation of `group` that
+///     describes the transformation of the specified DoF
+///
+/// Parameters and results are the same as for `make_matrix_rep`, but the
+/// matrix representation is converted from the cached sparse matrix
+/// representation.
+std::vector<Eigen::MatrixXd> MatrixRepCache::make_matrix_rep(
+    std::vector<SupercellSymOp> const &group, DoFKey key,
+    std::optional<std::set<Index>> site_indices,
+    std::shared_ptr<SymGroup const> &symgroup) {
+  std::shared_ptr<MatrixRep const> rep =
+      matrix_rep(group, key, site_indices);
+  symgroup = rep->symgroup;
+  std::vector<Eigen::MatrixXd> result;
+  result.reserve(rep->sparse_matrix_rep.size());
+  for (auto const &M : rep->sparse_matrix_rep) {
+    result.emplace_back(M);
+  }
+  return result;
+}
+
+/// \brief Maximum total memory used by cached matrices, in bytes
+Index MatrixRepCache::max_total_bytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_max_total_bytes;
+}
+
+/// \brief Set the maximum total memory used by cached matrices, in bytes
+///
+/// Least recently used entries are evicted immediately if the total is
+/// larger than `_max_total_bytes`.
+void MatrixRepCache::set_max_total_bytes(Index _max_total_bytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_max_total_bytes = _max_total_bytes;
+  _evict();
+}
+
+/// \brief Total memory used by cached matrices, in bytes
+Index MatrixRepCache::total_bytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_total_bytes;
+}
+
+/// \brief Evict least recently used entries until the total memory used
+///     by cached matrices is at most `max_total_bytes`
+///
+/// The maximum, `max_total_bytes()`, is not changed.
+///
+/// \returns The memory used by the evicted matrices, in bytes
+Index MatrixRepCache::evict_to(Index max_total_bytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Index initial_total_bytes = m_total_bytes;
+  while (m_total_bytes > max_total_bytes && !m_lru.empty()) {
+    Entry const &entry = m_lru.back();
+    m_total_bytes -= entry.value->memory_bytes();
+    m_index.erase(entry.key);
+    m_lru.pop_back();
+  }
+  return initial_total_bytes - m_total_bytes;
+}
+
+/// \brief Number of cached matrix representations
+Index MatrixRepCache::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_lru.size();
+}
+
+/// \brief Clear all cached matrix representations
+void MatrixRepCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_lru.clear();
+  m_index.clear();
+  m_total_bytes = 0;
+}
+
+/// \brief Evict least recently used entries, requires holding m_mutex
+void MatrixRepCache::_evict() {
+  while (m_total_bytes > m_max_total_bytes && !m_lru.empty()) {
+    Entry const &entry = m_lru.back();
+    m_total_bytes -= entry.value->memory_bytes();
+    m_index.erase(entry.key);
+    m_lru.pop_back();
+  }
+}
+
+/// \brief Process-wide MatrixRepCache, used by `dof_space_analysis` and
+///     `make_dof_space_rep`
+MatrixRepCache &default_matrix_rep_cache() {
+  static MatrixRepCache cache;
+  return cache;
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,45 @@
+#include "casm/configuration/NamePool.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Return the id of `name`, adding it if not already present
+Index NamePool::intern(std::string const &name) {
+  auto result = m_ids.emplace(name, m_names.size());
+  if (result.second) {
+    m_names.push_back(name);
+  }
+  return result.first->second;
+}
+
+/// \brief Return the id of `name`, or -1 if not present
+Index NamePool::find(std::string const &name) const {
+  auto it = m_ids.find(name);
+  if (it == m_ids.end()) {
+    return -1;
+  }
+  return it->second;
+}
+
+void NamePool::clear() {
+  m_names.clear();
+  m_ids.clear();
+}
+
+/// \brief Split a configuration name, "<supercell_name>/<configuration_id>",
+///     at the last '/'
+///
+/// If there is no '/', the whole name is returned as the supercell name,
+/// with an empty configuration id.
+std::pair<std::string, std::string> split_configuration_name(
+    std::string const &configuration_name) {
+  auto pos = configuration_name.rfind('/');
+  if (pos == std::string::npos) {
+    return std::make_pair(configuration_name, std::string());
+  }
+  return std::make_pair(configuration_name.substr(0, pos),
+                        configuration_name.substr(pos + 1));
+}
+
+}  // namespace config
+}  // namespace CASM
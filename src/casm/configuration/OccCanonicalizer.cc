@@ -0,0 +1,373 @@
+#include "casm/configuration/OccCanonicalizer.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/Supercell.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// Number of sites gathered and compared per block in
+/// OccCanonicalizer::_compare_to_best
+Index const occ_compare_block_size = 64;
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _supercell The supercell. The prim must satisfy
+///     `OccCanonicalizer::is_supported`.
+OccCanonicalizer::OccCanonicalizer(
+    std::shared_ptr<Supercell const> const &_supercell)
+    : m_supercell(_supercell),
+      m_n_sites(_supercell->unitcellcoord_index_converter.total_sites()),
+      m_has_aniso_occs(_supercell->prim->sym_info.has_aniso_occs),
+      m_site_sublattice(m_n_sites),
+      m_occ(m_n_sites),
+      m_occ_fg(m_n_sites),
+      m_fg_index(-1),
+      m_best(m_n_sites),
+      m_candidate(m_n_sites),
+      m_site_ranges(make_occupation_site_ranges(
+          _supercell->prim->sym_info, _supercell->superlattice.size())) {
+  if (!is_supported(*m_supercell->prim)) {
+    throw std::runtime_error(
+        "Error constructing OccCanonicalizer: prim has continuous DoF");
+  }
+  for (Index l = 0; l < m_n_sites; ++l) {
+    m_site_sublattice[l] =
+        m_supercell->unitcellcoord_index_converter(l).sublattice();
+  }
+}
+
+/// \brief Return true if prim has occupation DoF only
+bool OccCanonicalizer::is_supported(Prim const &prim) {
+  return prim.global_dof_info.empty() && prim.local_dof_info.empty();
+}
+
+/// \brief The supercell
+std::shared_ptr<Supercell const> const &OccCanonicalizer::supercell() const {
+  return m_supercell;
+}
+
+/// \brief Return true if configuration is in canonical form, using all
+///     supercell operations
+bool OccCanonicalizer::is_canonical(Configuration const &configuration) {
+  return this->is_canonical(configuration.dof_values.occupation,
+                            SupercellSymOp::begin(m_supercell),
+                            SupercellSymOp::end(m_supercell));
+}
+
+/// \brief Return rep that makes a configuration canonical, using all
+///     supercell operations
+SupercellSymOp OccCanonicalizer::to_canonical(
+    Configuration const &configuration) {
+  return this->to_canonical(configuration.dof_values.occupation,
+                            SupercellSymOp::begin(m_supercell),
+                            SupercellSymOp::end(m_supercell));
+}
+
+/// \brief Return the canonical configuration, using all supercell
+///     operations
+Configuration OccCanonicalizer::make_canonical_form(
+    Configuration const &configuration) {
+  Configuration canonical_config{configuration};
+  canonical_config.dof_values.occupation =
+      this->make_canonical_occupation(configuration.dof_values.occupation,
+                                      SupercellSymOp::begin(m_supercell),
+                                      SupercellSymOp::end(m_supercell));
+  return canonical_config;
+}
+
+/// \brief Return rep that makes a configuration canonical, using all
+///     supercell operations and translation pruning
+///
+/// The result is identical to `to_canonical(configuration)`.
+SupercellSymOp OccCanonicalizer::to_canonical_pruned(
+    Configuration const &configuration) {
+  _set_occupation(configuration.dof_values.occupation);
+  return _to_canonical_pruned();
+}
+
+/// \brief Return the canonical configuration, using all supercell
+///     operations and translation pruning
+///
+/// The result is identical to `make_canonical_form(configuration)`.
+Configuration OccCanonicalizer::make_canonical_form_pruned(
+    Configuration const &configuration) {
+  _set_occupation(configuration.dof_values.occupation);
+  _to_canonical_pruned();
+  Configuration canonical_config{configuration};
+  Eigen::VectorXi &occupation = canonical_config.dof_values.occupation;
+  for (Index i = 0; i < m_n_sites; ++i) {
+    occupation[i] = m_best[i];
+  }
+  return canonical_config;
+}
+
+/// \brief Return true if configuration is in canonical form, using all
+///     supercell operations
+bool OccCanonicalizer::is_canonical(OccConfiguration const &configuration) {
+  return this->is_canonical(configuration.occupation,
+                            SupercellSymOp::begin(m_supercell),
+                            SupercellSymOp::end(m_supercell));
+}
+
+/// \brief Return the canonical configuration, using all supercell
+///     operations
+///
+/// The result is identical to `make_canonical_form` of the corresponding
+/// Configuration.
+OccConfiguration OccCanonicalizer::make_canonical_form(
+    OccConfiguration const &configuration) {
+  _set_occupation(configuration.occupation);
+  _to_canonical(SupercellSymOp::begin(m_supercell),
+                SupercellSymOp::end(m_supercell));
+  return OccConfiguration(configuration.supercell, PackedOccupation(m_best));
+}
+
+/// \brief Return the canonical configuration, using all supercell
+///     operations and translation pruning
+///
+/// The result is identical to `make_canonical_form(configuration)`.
+OccConfiguration OccCanonicalizer::make_canonical_form_pruned(
+    OccConfiguration const &configuration) {
+  _set_occupation(configuration.occupation);
+  _to_canonical_pruned();
+  return OccConfiguration(configuration.supercell, PackedOccupation(m_best));
+}
+
+/// \brief Copy occupation into m_occ, and invalidate m_fg_index
+void OccCanonicalizer::_set_occupation(Eigen::VectorXi const &occupation) {
+  if (occupation.size() != m_n_sites) {
+    throw std::runtime_error(
+        "Error in OccCanonicalizer: occupation size does not match "
+        "supercell");
+  }
+  for (Index l = 0; l < m_n_sites; ++l) {
+    int value = occupation[l];
+    if (value < 0 || value > 255) {
+      throw std::runtime_error(
+          "Error in OccCanonicalizer: occupant index out of range");
+    }
+    m_occ[l] = static_cast<std::uint8_t>(value);
+  }
+  m_fg_index = -1;
+}
+
+/// \brief Copy packed occupation into m_occ, and invalidate m_fg_index
+void OccCanonicalizer::_set_occupation(PackedOccupation const &occupation) {
+  if (occupation.size() != m_n_sites) {
+    throw std::runtime_error(
+        "Error in OccCanonicalizer: occupation size does not match "
+        "supercell");
+  }
+  for (Index l = 0; l < m_n_sites; ++l) {
+    m_occ[l] = static_cast<std::uint8_t>(occupation[l]);
+  }
+  m_fg_index = -1;
+}
+
+/// \brief Update m_occ_fg if op has a different factor group operation
+///
+/// After this, `m_occ_fg[trans_perm[i]]` is the value of the transformed
+/// occupation on site `i`. Only sites in m_site_ranges are updated; the
+/// others are always 0.
+void OccCanonicalizer::_update_fg(SupercellSymOp const &op) {
+  Index fg_index = op.supercell_factor_group_index();
+  if (fg_index == m_fg_index) {
+    return;
+  }
+  auto const &fg_perms = m_supercell->sym_info().factor_group_permutations;
+  if (m_has_aniso_occs) {
+    PrimSymInfo const &prim_sym_info = m_supercell->prim->sym_info;
+    std::int32_t const *remap =
+        prim_sym_info.occ_remap(op.prim_factor_group_index(), 0);
+    Index row_size = prim_sym_info.max_n_occupants;
+    // use m_candidate as scratch space
+    for (auto const &range : m_site_ranges) {
+      for (Index l = range.first; l < range.second; ++l) {
+        m_candidate[l] = remap[m_site_sublattice[l] * row_size + m_occ[l]];
+      }
+    }
+    fg_perms.visit(fg_index, [&](auto const *fg_perm) {
+      for (auto const &range : m_site_ranges) {
+        for (Index l = range.first; l < range.second; ++l) {
+          m_occ_fg[l] = m_candidate[fg_perm[l]];
+        }
+      }
+    });
+  } else {
+    fg_perms.visit(fg_index, [&](auto const *fg_perm) {
+      for (auto const &range : m_site_ranges) {
+        for (Index l = range.first; l < range.second; ++l) {
+          m_occ_fg[l] = m_occ[fg_perm[l]];
+        }
+      }
+    });
+  }
+  m_fg_index = fg_index;
+}
+
+/// \brief Gather copy_apply(op, occupation) into m_candidate
+///
+/// Sets m_candidate[i], for i in [begin, end). Requires `_update_fg(op)`.
+void OccCanonicalizer::_gather(SupercellSymOp const &op, Index begin,
+                               Index end) {
+  SupercellSymInfo const &sym_info = m_supercell->sym_info();
+  Index t = op.translation_index();
+  if (sym_info.translation_permutations.has_value()) {
+    sym_info.translation_permutations->visit(t, [&](auto const *trans_perm) {
+      for (Index i = begin; i < end; ++i) {
+        m_candidate[i] = m_occ_fg[trans_perm[i]];
+      }
+    });
+  } else {
+    auto const &table = sym_info.translation_table;
+    for (Index i = begin; i < end; ++i) {
+      m_candidate[i] = m_occ_fg[table.permute_index(t, i)];
+    }
+  }
+}
+
+/// \brief Index of the site permuted onto site i by translation t
+Index OccCanonicalizer::_translation_permute_index(Index t, Index i) const {
+  SupercellSymInfo const &sym_info = m_supercell->sym_info();
+  if (sym_info.translation_permutations.has_value()) {
+    return (*sym_info.translation_permutations)(t, i);
+  }
+  return sym_info.translation_table.permute_index(t, i);
+}
+
+/// \brief Find the canonical occupation, with translation pruning
+///
+/// For each supercell factor group operation, in order:
+/// - All translations begin as candidates
+/// - For each site, in order, the greatest value of the transformed
+///   occupation amongst candidates is found and compared to m_best. If less,
+///   the factor group operation cannot give the canonical occupation and is
+///   skipped; otherwise, candidates not giving the greatest value are
+///   removed.
+/// - Once one candidate remains, the rest of its transformed occupation is
+///   compared to m_best directly
+///
+/// Candidates are kept in order, and m_best is only replaced by a strictly
+/// greater occupation, so the result is the first operation in the
+/// standard SupercellSymOp order giving the canonical occupation.
+///
+/// On return, m_best holds the canonical occupation.
+SupercellSymOp OccCanonicalizer::_to_canonical_pruned() {
+  auto const &sublattice_has_occupation_dofs =
+      m_supercell->prim->sym_info.sublattice_has_occupation_dofs;
+  Index n_fg = m_supercell->sym_info().factor_group_permutations.size();
+  Index n_trans = m_supercell->unitcell_index_converter.total_sites();
+  Index best_fg_index = -1;
+  Index best_translation_index = -1;
+
+  for (Index fg_index = 0; fg_index < n_fg; ++fg_index) {
+    _update_fg(SupercellSymOp(m_supercell, fg_index, 0));
+
+    m_candidate_translations.resize(n_trans);
+    m_candidate_values.resize(n_trans);
+    for (Index t = 0; t < n_trans; ++t) {
+      m_candidate_translations[t] = t;
+    }
+
+    // true when the prefix of candidates is already greater than m_best
+    bool is_greater = (best_fg_index == -1);
+    bool is_less = false;
+    Index i = 0;
+    for (; i < m_n_sites && m_candidate_translations.size() > 1; ++i) {
+      if (!sublattice_has_occupation_dofs[m_site_sublattice[i]]) {
+        // always 0, for all candidates
+        continue;
+      }
+      std::uint8_t max_value = 0;
+      Index n_candidates = m_candidate_translations.size();
+      for (Index c = 0; c < n_candidates; ++c) {
+        std::uint8_t value = m_occ_fg[_translation_permute_index(
+            m_candidate_translations[c], i)];
+        m_candidate_values[c] = value;
+        max_value = std::max(max_value, value);
+      }
+      if (!is_greater) {
+        if (max_value < m_best[i]) {
+          is_less = true;
+          break;
+        }
+        is_greater = (max_value > m_best[i]);
+      }
+      Index n_kept = 0;
+      for (Index c = 0; c < n_candidates; ++c) {
+        if (m_candidate_values[c] == max_value) {
+          m_candidate_translations[n_kept++] = m_candidate_translations[c];
+        }
+      }
+      m_candidate_translations.resize(n_kept);
+    }
+    if (is_less) {
+      continue;
+    }
+
+    // the first remaining candidate is the first greatest for this fg_index
+    SupercellSymOp op(m_supercell, fg_index, m_candidate_translations[0]);
+    if (!is_greater) {
+      _gather(op, i, m_n_sites);
+      if (std::memcmp(m_candidate.data() + i, m_best.data() + i,
+                      m_n_sites - i) <= 0) {
+        continue;
+      }
+      _gather(op, 0, i);
+    } else {
+      _gather(op, 0, m_n_sites);
+    }
+    std::swap(m_best, m_candidate);
+    best_fg_index = fg_index;
+    best_translation_index = m_candidate_translations[0];
+  }
+  return SupercellSymOp(m_supercell, best_fg_index, best_translation_index);
+}
+
+/// \brief Compare copy_apply(op, occupation) to m_best
+///
+/// Values are gathered into m_candidate one block at a time and compared
+/// to m_best with `std::memcmp`, so that operations producing a lesser
+/// occupation usually exit after gathering only the first block.
+/// Blocks are taken sublattice by sublattice from m_site_ranges, so sites
+/// on sublattices with a single allowed occupant are never gathered or
+/// compared.
+int OccCanonicalizer::_compare_to_best(SupercellSymOp const &op,
+                                       bool complete_if_greater) {
+  _update_fg(op);
+  Index n_ranges = m_site_ranges.size();
+  for (Index r = 0; r < n_ranges; ++r) {
+    Index range_end = m_site_ranges[r].second;
+    for (Index begin = m_site_ranges[r].first; begin < range_end;
+         begin += occ_compare_block_size) {
+      Index end = std::min(begin + occ_compare_block_size, range_end);
+      _gather(op, begin, end);
+      int cmp = std::memcmp(m_candidate.data() + begin, m_best.data() + begin,
+                            end - begin);
+      if (cmp < 0) {
+        return -1;
+      }
+      if (cmp > 0) {
+        if (complete_if_greater) {
+          _gather(op, end, range_end);
+          for (Index s = r + 1; s < n_ranges; ++s) {
+            _gather(op, m_site_ranges[s].first, m_site_ranges[s].second);
+          }
+        }
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+}  // namespace config
+}  // namespace CASM
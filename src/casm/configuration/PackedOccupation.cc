@@ -0,0 +1,207 @@
+#include "casm/configuration/PackedOccupation.hh"
+
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/Supercell.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {  // anonymous
+
+/// \brief Pack occupation values, which must be in range [0, 256)
+template <typename OccupationType>
+void _pack(OccupationType const &occupation, Index size, int &bits_per_site,
+           std::vector<std::uint8_t> &data) {
+  bits_per_site = 4;
+  for (Index i = 0; i < size; ++i) {
+    if (occupation[i] > 15) {
+      bits_per_site = 8;
+      break;
+    }
+  }
+  if (bits_per_site == 8) {
+    data.resize(size);
+    for (Index i = 0; i < size; ++i) {
+      data[i] = static_cast<std::uint8_t>(occupation[i]);
+    }
+  } else {
+    data.resize((size + 1) / 2, 0);
+    for (Index i = 0; i < size; ++i) {
+      std::uint8_t value = static_cast<std::uint8_t>(occupation[i]);
+      data[i >> 1] |= (i & 1) ? value : (value << 4);
+    }
+  }
+}
+
+}  // namespace
+
+/// \brief Construct empty PackedOccupation
+PackedOccupation::PackedOccupation() : m_size(0), m_bits_per_site(4) {}
+
+/// \brief Construct from occupation values
+PackedOccupation::PackedOccupation(Eigen::VectorXi const &occupation)
+    : m_size(occupation.size()), m_bits_per_site(4) {
+  for (Index i = 0; i < m_size; ++i) {
+    if (occupation[i] < 0 || occupation[i] > 255) {
+      throw std::runtime_error(
+          "Error constructing PackedOccupation: occupant index out of range");
+    }
+  }
+  _pack(occupation, m_size, m_bits_per_site, m_data);
+}
+
+/// \brief Construct from occupation values
+PackedOccupation::PackedOccupation(std::vector<std::uint8_t> const &occupation)
+    : m_size(occupation.size()), m_bits_per_site(4) {
+  _pack(occupation, m_size, m_bits_per_site, m_data);
+}
+
+/// \brief Return occupation values as Eigen::VectorXi
+Eigen::VectorXi PackedOccupation::unpack() const {
+  Eigen::VectorXi occupation(m_size);
+  for (Index i = 0; i < m_size; ++i) {
+    occupation[i] = (*this)[i];
+  }
+  return occupation;
+}
+
+/// \brief Lexicographical less than comparison of occupant indices
+///
+/// Gives the same result as comparing unpacked occupation values site by
+/// site. If the packing is the same, the packed bytes are compared directly.
+bool PackedOccupation::operator<(PackedOccupation const &rhs) const {
+  if (m_size != rhs.m_size) {
+    return m_size < rhs.m_size;
+  }
+  if (m_bits_per_site == rhs.m_bits_per_site) {
+    return m_data < rhs.m_data;
+  }
+  for (Index i = 0; i < m_size; ++i) {
+    int a = (*this)[i];
+    int b = rhs[i];
+    if (a != b) {
+      return a < b;
+    }
+  }
+  return false;
+}
+
+bool PackedOccupation::eq_impl(PackedOccupation const &rhs) const {
+  return m_size == rhs.m_size && m_bits_per_site == rhs.m_bits_per_site &&
+         m_data == rhs.m_data;
+}
+
+/// \brief Construct from a Configuration
+PackedConfiguration::PackedConfiguration(Configuration const &configuration)
+    : supercell(configuration.supercell),
+      occupation(configuration.dof_values.occupation) {
+  continuous_dof_values.global_dof_values =
+      configuration.dof_values.global_dof_values;
+  continuous_dof_values.local_dof_values =
+      configuration.dof_values.local_dof_values;
+}
+
+/// \brief True if there are any continuous DoF values
+bool PackedConfiguration::has_continuous_dof() const {
+  return !continuous_dof_values.global_dof_values.empty() ||
+         !continuous_dof_values.local_dof_values.empty();
+}
+
+/// \brief Construct the Configuration
+Configuration PackedConfiguration::unpack() const {
+  Configuration configuration(supercell, continuous_dof_values);
+  configuration.dof_values.occupation = occupation.unpack();
+  return configuration;
+}
+
+/// \brief Less than comparison, equivalent to Configuration::operator<
+///
+/// Supercells are compared first, then occupation. If there are continuous
+/// DoF, the configurations are unpacked and compared as Configuration.
+bool PackedConfiguration::operator<(PackedConfiguration const &rhs) const {
+  if (has_continuous_dof() || rhs.has_continuous_dof()) {
+    return unpack() < rhs.unpack();
+  }
+  if (*supercell != *rhs.supercell) {
+    return *supercell < *rhs.supercell;
+  }
+  return occupation < rhs.occupation;
+}
+
+bool PackedConfiguration::eq_impl(PackedConfiguration const &rhs) const {
+  if (has_continuous_dof() || rhs.has_continuous_dof()) {
+    return unpack() == rhs.unpack();
+  }
+  return *supercell == *rhs.supercell && occupation == rhs.occupation;
+}
+
+/// \brief Constructor
+OccConfiguration::OccConfiguration(
+    std::shared_ptr<Supercell const> const &_supercell,
+    PackedOccupation const &_occupation)
+    : supercell(_supercell), occupation(_occupation) {}
+
+/// \brief Construct from a Configuration, which must not have continuous
+///     DoF
+///
+/// Throws if `configuration` has continuous DoF values.
+OccConfiguration::OccConfiguration(Configuration const &configuration)
+    : supercell(configuration.supercell),
+      occupation(configuration.dof_values.occupation) {
+  if (!configuration.dof_values.global_dof_values.empty() ||
+      !configuration.dof_values.local_dof_values.empty()) {
+    throw std::runtime_error(
+        "Error constructing OccConfiguration: configuration has continuous "
+        "DoF");
+  }
+}
+
+/// \brief Construct the Configuration
+Configuration OccConfiguration::to_configuration() const {
+  Configuration configuration(supercell);
+  configuration.dof_values.occupation = occupation.unpack();
+  return configuration;
+}
+
+/// \brief Less than comparison, equivalent to Configuration::operator<
+///
+/// Supercells are compared first, then occupation.
+bool OccConfiguration::operator<(OccConfiguration const &rhs) const {
+  if (supercell != rhs.supercell && *supercell != *rhs.supercell) {
+    return *supercell < *rhs.supercell;
+  }
+  return occupation < rhs.occupation;
+}
+
+bool OccConfiguration::eq_impl(OccConfiguration const &rhs) const {
+  return (supercell == rhs.supercell || *supercell == *rhs.supercell) &&
+         occupation == rhs.occupation;
+}
+
+/// \brief Convert OccConfiguration to Configuration
+///
+/// The order of OccConfiguration and Configuration is the same, so each
+/// configuration is inserted with a hint, at the end of the result.
+std::set<Configuration> to_configurations(
+    std::set<OccConfiguration> const &occ_configurations) {
+  std::set<Configuration> configurations;
+  for (auto const &occ_configuration : occ_configurations) {
+    configurations.emplace_hint(configurations.end(),
+                                occ_configuration.to_configuration());
+  }
+  return configurations;
+}
+
+PackedOccupationIsEquivalent::PackedOccupationIsEquivalent(
+    PackedOccupation const &_occupation, Supercell const &_supercell)
+    : m_occupation_ptr(&_occupation),
+      m_n_vol(_supercell.unitcell_index_converter.total_sites()),
+      m_occ_symgroup_rep(nullptr) {
+  PrimSymInfo const &prim_sym_info = _supercell.prim->sym_info;
+  if (prim_sym_info.has_aniso_occs) {
+    m_occ_symgroup_rep = &prim_sym_info.occ_symgroup_rep;
+  }
+}
+
+}  // namespace config
+}  // namespace CASM
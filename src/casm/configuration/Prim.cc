@@ -74,5 +74,24 @@ Prim::Prim(std::vector<xtal::SymOp> const &factor_group_elements,
   _validate_unique_names(*basicstructure);
 }
 
+/// \brief Construct using existing symmetry representations
+///
+/// Notes:
+/// - `_sym_info` is copied and must have been generated for a prim equal to
+///   `*_basicstructure`, for example by `PrimSymInfoCache`. This is not
+///   checked.
+Prim::Prim(PrimSymInfo const &_sym_info,
+           std::shared_ptr<BasicStructure const> const &_basicstructure)
+    : basicstructure(throw_if_equal_to_nullptr(
+          _basicstructure,
+          "Error in Prim constructor: _basicstructure == nullptr")),
+      global_dof_info(clexulator::make_global_dof_info(*basicstructure)),
+      local_dof_info(clexulator::make_local_dof_info(*basicstructure)),
+      is_atomic(_is_atomic(*basicstructure)),
+      sym_info(_sym_info),
+      magspin_info(*basicstructure) {
+  _validate_unique_names(*basicstructure);
+}
+
 }  // namespace config
 }  // namespace CASM
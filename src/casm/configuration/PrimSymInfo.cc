@@ -1,5 +1,9 @@
 #include "casm/configuration/PrimSymInfo.hh"
 
+#include <algorithm>
+#include <stdexcept>
+
+#include "casm/configuration/memory_usage.hh"
 #include "casm/configuration/sym_info/factor_group.hh"
 #include "casm/configuration/sym_info/global_dof_sym_info.hh"
 #include "casm/configuration/sym_info/local_dof_sym_info.hh"
@@ -25,6 +29,94 @@ PrimSymInfo::PrimSymInfo(std::vector<xtal::SymOp> const &factor_group_elements,
     : PrimSymInfo(sym_info::use_factor_group(factor_group_elements, prim),
                   prim) {}
 
+namespace {
+
+/// \brief Set the occupation members of PrimSymInfo that are determined by
+///     `prim` and `occ_symgroup_rep`, and add the "occ" local DoF symrep
+void _set_occupation_info(PrimSymInfo &prim_sym_info,
+                          BasicStructure const &prim) {
+  prim_sym_info.has_occupation_dofs = false;
+  prim_sym_info.sublattice_has_occupation_dofs.clear();
+  prim_sym_info.max_n_occupants = 0;
+  for (auto const &site : prim.basis()) {
+    Index n_occupants = site.occupant_dof().size();
+    prim_sym_info.sublattice_has_occupation_dofs.push_back(n_occupants > 1);
+    if (n_occupants > 1) {
+      prim_sym_info.has_occupation_dofs = true;
+    }
+    prim_sym_info.max_n_occupants =
+        std::max(prim_sym_info.max_n_occupants, n_occupants);
+  }
+
+  prim_sym_info.has_aniso_occs = false;
+  Index n_sublat = prim.basis().size();
+  Index max_n_occupants = prim_sym_info.max_n_occupants;
+  auto const &occ_symgroup_rep = prim_sym_info.occ_symgroup_rep;
+  prim_sym_info.occ_remap_table.assign(
+      occ_symgroup_rep.size() * n_sublat * max_n_occupants, 0);
+  for (Index g = 0; g < occ_symgroup_rep.size(); ++g) {
+    for (Index b = 0; b < n_sublat; ++b) {
+      sym_info::Permutation const &perm = occ_symgroup_rep[g][b];
+      std::int32_t *row = prim_sym_info.occ_remap_table.data() +
+                          (g * n_sublat + b) * max_n_occupants;
+      for (Index occ = 0; occ < perm.size(); ++occ) {
+        row[occ] = perm[occ];
+        if (perm[occ] != occ) {
+          prim_sym_info.has_aniso_occs = true;
+        }
+      }
+    }
+  }
+
+  if (prim_sym_info.has_occupation_dofs) {
+    auto &occ_rep = prim_sym_info.local_dof_symgroup_rep["occ"];
+    occ_rep.clear();
+    for (sym_info::OccSymOpRep const &occ_symop_rep : occ_symgroup_rep) {
+      std::vector<Eigen::MatrixXd> occ_matrix_rep;
+      for (sym_info::Permutation const &perm : occ_symop_rep) {
+        occ_matrix_rep.push_back(sym_info::as_matrix(sym_info::inverse(perm)));
+      }
+      occ_rep.push_back(occ_matrix_rep);
+    }
+  }
+}
+
+/// \brief Set the packed local DoF members of PrimSymInfo, from
+///     `local_dof_symgroup_rep`
+void _set_packed_local_dof_info(PrimSymInfo &prim_sym_info) {
+  Index n_fg = prim_sym_info.factor_group->element.size();
+  Index n_sublat = prim_sym_info.sublattice_has_occupation_dofs.size();
+  prim_sym_info.local_dof_keys.clear();
+  prim_sym_info.local_dof_dim_table.clear();
+  prim_sym_info.local_dof_rep_offset.clear();
+  prim_sym_info.local_dof_rep_table.clear();
+  for (auto const &dof : prim_sym_info.local_dof_symgroup_rep) {
+    sym_info::LocalDoFSymGroupRep const &rep = dof.second;
+    if (rep.size() != n_fg) {
+      throw std::runtime_error(
+          "Error in PrimSymInfo constructor: local DoF symmetry "
+          "representation size does not match factor group size");
+    }
+    prim_sym_info.local_dof_keys.push_back(dof.first);
+    for (Index b = 0; b < n_sublat; ++b) {
+      prim_sym_info.local_dof_dim_table.push_back(n_fg ? rep[0][b].cols()
+                                                       : 0);
+    }
+    for (Index g = 0; g < n_fg; ++g) {
+      for (Index b = 0; b < n_sublat; ++b) {
+        Eigen::MatrixXd const &M = rep[g][b];
+        prim_sym_info.local_dof_rep_offset.push_back(
+            prim_sym_info.local_dof_rep_table.size());
+        prim_sym_info.local_dof_rep_table.insert(
+            prim_sym_info.local_dof_rep_table.end(), M.data(),
+            M.data() + M.size());
+      }
+    }
+  }
+}
+
+}  // namespace
+
 /// \brief Construct using given factor group
 PrimSymInfo::PrimSymInfo(std::shared_ptr<SymGroup const> const &_factor_group,
                          BasicStructure const &prim)
@@ -37,27 +129,193 @@ PrimSymInfo::PrimSymInfo(std::shared_ptr<SymGroup const> const &_factor_group,
       make_unitcellcoord_symgroup_rep(this->factor_group->element, prim);
 
   OccSymInfo occ_sym_info(this->factor_group->element, prim);
-  this->has_occupation_dofs = occ_sym_info.has_occupation_dofs;
-  this->has_aniso_occs = occ_sym_info.has_aniso_occs;
   this->occ_symgroup_rep = occ_sym_info.occ_symgroup_rep;
   this->atom_position_symgroup_rep = occ_sym_info.atom_position_symgroup_rep;
 
   this->local_dof_symgroup_rep =
       make_local_dof_symgroup_rep(this->factor_group->element, prim);
+  _set_occupation_info(*this, prim);
+  _set_packed_local_dof_info(*this);
 
-  if (this->has_occupation_dofs) {
-    local_dof_symgroup_rep["occ"] = sym_info::LocalDoFSymGroupRep();
-    for (sym_info::OccSymOpRep const &occ_symop_rep : this->occ_symgroup_rep) {
-      std::vector<Eigen::MatrixXd> occ_matrix_rep;
-      for (sym_info::Permutation const &perm : occ_symop_rep) {
-        occ_matrix_rep.push_back(sym_info::as_matrix(sym_info::inverse(perm)));
+  this->global_dof_symgroup_rep =
+      make_global_dof_symgroup_rep(this->factor_group->element, prim);
+}
+
+/// \brief Construct using given factor group and symmetry representations
+///
+/// This skips generating symmetry representations, so that PrimSymInfo
+/// read by `from_json` or from a PrimSymInfoCache is constructed quickly.
+/// The point group and the occupation members which are determined by
+/// `prim` and `_occ_symgroup_rep` are generated, including the "occ" local
+/// DoF symrep, so `_local_dof_symgroup_rep` should not include "occ".
+///
+/// The representations are not checked for consistency with `prim`.
+PrimSymInfo::PrimSymInfo(
+    std::shared_ptr<SymGroup const> const &_factor_group,
+    sym_info::UnitCellCoordSymGroupRep _unitcellcoord_symgroup_rep,
+    sym_info::OccSymGroupRep _occ_symgroup_rep,
+    sym_info::AtomPositionSymGroupRep _atom_position_symgroup_rep,
+    std::map<DoFKey, sym_info::LocalDoFSymGroupRep> _local_dof_symgroup_rep,
+    std::map<DoFKey, sym_info::GlobalDoFSymGroupRep> _global_dof_symgroup_rep,
+    BasicStructure const &prim)
+    : factor_group(_factor_group),
+      point_group(sym_info::make_point_group(prim, _factor_group)),
+      unitcellcoord_symgroup_rep(std::move(_unitcellcoord_symgroup_rep)),
+      occ_symgroup_rep(std::move(_occ_symgroup_rep)),
+      atom_position_symgroup_rep(std::move(_atom_position_symgroup_rep)),
+      local_dof_symgroup_rep(std::move(_local_dof_symgroup_rep)),
+      global_dof_symgroup_rep(std::move(_global_dof_symgroup_rep)) {
+  if (unitcellcoord_symgroup_rep.size() != factor_group->element.size() ||
+      occ_symgroup_rep.size() != factor_group->element.size() ||
+      atom_position_symgroup_rep.size() != factor_group->element.size()) {
+    throw std::runtime_error(
+        "Error in PrimSymInfo constructor: symmetry representation size does "
+        "not match factor group size");
+  }
+  _set_occupation_info(*this, prim);
+  _set_packed_local_dof_info(*this);
+}
+
+namespace {
+
+/// \brief Memory used by the entries of matrices, in bytes
+Index matrices_memory_bytes(std::vector<Eigen::MatrixXd> const &matrices) {
+  Index bytes = matrices.size() * sizeof(Eigen::MatrixXd);
+  for (auto const &M : matrices) {
+    bytes += M.size() * sizeof(double);
+  }
+  return bytes;
+}
+
+}  // namespace
+
+/// \brief Memory used by the symmetry representations, in bytes
+///     (approximate)
+///
+/// Includes the factor group, the point group, and all symmetry
+/// representations, counting the entries of nested vectors and matrices.
+Index PrimSymInfo::memory_bytes() const {
+  Index n_sublat = sublattice_has_occupation_dofs.size();
+  Index bytes = sizeof(PrimSymInfo) + config::memory_bytes(*factor_group) +
+                config::memory_bytes(*point_group);
+  bytes += unitcellcoord_symgroup_rep.size() *
+           (sizeof(xtal::UnitCellCoordRep) +
+            n_sublat * (sizeof(xtal::UnitCell) + sizeof(Index)));
+  for (auto const &op_rep : occ_symgroup_rep) {
+    for (auto const &perm : op_rep) {
+      bytes += sizeof(perm) + perm.size() * sizeof(Index);
+    }
+  }
+  for (auto const &op_rep : atom_position_symgroup_rep) {
+    for (auto const &sublat_rep : op_rep) {
+      for (auto const &perm : sublat_rep) {
+        bytes += sizeof(perm) + perm.size() * sizeof(Index);
       }
-      local_dof_symgroup_rep.at("occ").push_back(occ_matrix_rep);
     }
   }
+  bytes += occ_remap_table.size() * sizeof(std::int32_t);
+  for (auto const &pair : local_dof_symgroup_rep) {
+    for (auto const &op_rep : pair.second) {
+      bytes += matrices_memory_bytes(op_rep);
+    }
+  }
+  bytes += (local_dof_dim_table.size() + local_dof_rep_offset.size()) *
+               sizeof(Index) +
+           local_dof_rep_table.size() * sizeof(double);
+  for (auto const &pair : global_dof_symgroup_rep) {
+    bytes += matrices_memory_bytes(pair.second);
+  }
+  return bytes;
+}
 
-  this->global_dof_symgroup_rep =
-      make_global_dof_symgroup_rep(this->factor_group->element, prim);
+namespace {
+
+/// \brief Return merged ranges of linear site indices, `[begin, end)`, on
+///     the sublattices `b` for which `include[b]` is true
+std::vector<std::pair<Index, Index>> make_sublattice_site_ranges(
+    std::vector<bool> const &include, Index n_vol) {
+  std::vector<std::pair<Index, Index>> ranges;
+  for (Index b = 0; b < include.size(); ++b) {
+    if (!include[b]) {
+      continue;
+    }
+    Index begin = b * n_vol;
+    Index end = begin + n_vol;
+    if (!ranges.empty() && ranges.back().second == begin) {
+      ranges.back().second = end;
+    } else {
+      ranges.emplace_back(begin, end);
+    }
+  }
+  return ranges;
+}
+
+/// \brief Return true for sublattices with local continuous DoF of type
+///     `key`, by sublattice index
+std::vector<bool> make_sublattice_has_local_dofs(
+    PrimSymInfo const &prim_sym_info, DoFKey const &key) {
+  Index n_sublat = prim_sym_info.sublattice_has_occupation_dofs.size();
+  std::vector<bool> result(n_sublat, false);
+  auto it = prim_sym_info.local_dof_symgroup_rep.find(key);
+  if (it == prim_sym_info.local_dof_symgroup_rep.end() || it->second.empty()) {
+    return result;
+  }
+  for (Index b = 0; b < n_sublat; ++b) {
+    result[b] = (it->second[0][b].cols() > 0);
+  }
+  return result;
+}
+
+}  // namespace
+
+/// \brief Return the ranges of linear site indices, `[begin, end)`, on
+///     sublattices that allow more than one occupant
+///
+/// Sites are in sublattice-major order, `l = b * n_vol + n`, so the sites
+/// of each sublattice are contiguous. Adjacent ranges are merged. Sites
+/// outside the ranges have a single allowed occupant, so their occupation
+/// is always 0 and never differs between configurations or under symmetry,
+/// which maps sublattices only to symmetrically equivalent sublattices.
+///
+/// \param prim_sym_info The prim symmetry info
+/// \param n_vol The supercell volume, as a multiple of the prim volume
+std::vector<std::pair<Index, Index>> make_occupation_site_ranges(
+    PrimSymInfo const &prim_sym_info, Index n_vol) {
+  return make_sublattice_site_ranges(
+      prim_sym_info.sublattice_has_occupation_dofs, n_vol);
+}
+
+/// \brief Return the ranges of linear site indices, `[begin, end)`, on
+///     sublattices with local continuous DoF of type `key`
+///
+/// Sites outside the ranges have no values of this DoF type, so their
+/// values are always 0. See `make_occupation_site_ranges` for the layout.
+std::vector<std::pair<Index, Index>> make_local_dof_site_ranges(
+    PrimSymInfo const &prim_sym_info, DoFKey const &key, Index n_vol) {
+  return make_sublattice_site_ranges(
+      make_sublattice_has_local_dofs(prim_sym_info, key), n_vol);
+}
+
+/// \brief Return the ranges of linear site indices, `[begin, end)`, of
+///     active sites
+///
+/// Active sites are on sublattices that allow more than one occupant or
+/// that have any local continuous DoF. See `make_occupation_site_ranges`
+/// for the layout.
+std::vector<std::pair<Index, Index>> make_active_site_ranges(
+    PrimSymInfo const &prim_sym_info, Index n_vol) {
+  std::vector<bool> is_active = prim_sym_info.sublattice_has_occupation_dofs;
+  for (auto const &dof : prim_sym_info.local_dof_symgroup_rep) {
+    if (dof.first == "occ") {
+      continue;
+    }
+    std::vector<bool> has_dofs =
+        make_sublattice_has_local_dofs(prim_sym_info, dof.first);
+    for (Index b = 0; b < is_active.size(); ++b) {
+      is_active[b] = is_active[b] || has_dofs[b];
+    }
+  }
+  return make_sublattice_site_ranges(is_active, n_vol);
 }
 
 }  // namespace config
@@ -0,0 +1,204 @@
+#include "casm/configuration/PrimSymInfoCache.hh"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/io/json/PrimSymInfo_json_io.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/io/BasicStructureIO.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {  // (anonymous)
+
+/// \brief Read PrimSymInfo from `<cache_dir>/<hash>.json`, or return nullptr
+///     if the file does not exist, is not readable, or has a different key
+std::shared_ptr<PrimSymInfo const> read_prim_sym_info(
+    fs::path const &cache_dir, std::string const &key,
+    BasicStructure const &prim) {
+  fs::path path = cache_dir / (make_prim_sym_info_cache_hash(key) + ".json");
+  if (!fs::exists(path)) {
+    return nullptr;
+  }
+  try {
+    jsonParser json(path);
+    if (!json.contains("key") || json["key"].get<std::string>() != key) {
+      return nullptr;
+    }
+    return std::make_shared<PrimSymInfo const>(
+        jsonConstructor<PrimSymInfo>::from_json(json["prim_sym_info"], prim));
+  } catch (std::exception const &e) {
+    return nullptr;
+  }
+}
+
+/// \brief Write PrimSymInfo to `<cache_dir>/<hash>.json`
+///
+/// The file is written to a temporary path and then renamed, so readers
+/// never see a partial file. Failure to write is not an error, because the
+/// PrimSymInfo is still held in memory.
+void write_prim_sym_info(fs::path const &cache_dir, std::string const &key,
+                         PrimSymInfo const &prim_sym_info) {
+  jsonParser json;
+  json["key"] = key;
+  to_json(prim_sym_info, json["prim_sym_info"]);
+
+  std::string hash = make_prim_sym_info_cache_hash(key);
+  std::stringstream tmp_name;
+  tmp_name << hash << ".json.tmp."
+           << std::hash<std::thread::id>()(std::this_thread::get_id()) << "."
+           << std::chrono::steady_clock::now().time_since_epoch().count();
+  try {
+    fs::create_directories(cache_dir);
+    fs::path tmp_path = cache_dir / tmp_name.str();
+    json.write(tmp_path);
+    fs::rename(tmp_path, cache_dir / (hash + ".json"));
+  } catch (std::exception const &e) {
+    return;
+  }
+}
+
+}  // namespace
+
+/// \brief Make a string that uniquely specifies the PrimSymInfo generated
+///     for a prim
+///
+/// The key is a JSON string containing the prim, as written by `write_prim`
+/// with fractional coordinates, and the lattice tolerance used to find the
+/// factor group.
+std::string make_prim_sym_info_cache_key(BasicStructure const &prim) {
+  jsonParser json;
+  write_prim(prim, json["prim"], FRAC, true);
+  json["tol"] = prim.lattice().tol();
+  std::stringstream ss;
+  ss << json;
+  return ss.str();
+}
+
+/// \brief Make a hexadecimal hash of a PrimSymInfo cache key
+///
+/// Uses 64-bit FNV-1a, which is stable across platforms and runs, so it can
+/// be used to name PrimSymInfo files.
+std::string make_prim_sym_info_cache_hash(std::string const &key) {
+  std::uint64_t const fnv_prime = 1099511628211ULL;
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : key) {
+    hash ^= c;
+    hash *= fnv_prime;
+  }
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return ss.str();
+}
+
+/// \brief Constructor
+///
+/// \param _cache_dir If not std::nullopt, directory for PrimSymInfo files.
+///     Created when the first file is written.
+PrimSymInfoCache::PrimSymInfoCache(std::optional<fs::path> _cache_dir)
+    : m_cache_dir(_cache_dir) {}
+
+/// \brief Return PrimSymInfo, equal to `PrimSymInfo(prim)`
+///
+/// \param prim The prim structure
+///
+/// \returns Shared PrimSymInfo, with factor group elements in the same order
+///     as `PrimSymInfo(prim)`.
+std::shared_ptr<PrimSymInfo const> PrimSymInfoCache::prim_sym_info(
+    BasicStructure const &prim) {
+  std::string key = make_prim_sym_info_cache_key(prim);
+
+  std::optional<fs::path> cache_dir;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_prim_sym_info.find(key);
+    if (it != m_prim_sym_info.end()) {
+      return it->second;
+    }
+    cache_dir = m_cache_dir;
+  }
+
+  std::shared_ptr<PrimSymInfo const> result;
+  if (cache_dir.has_value()) {
+    result = read_prim_sym_info(*cache_dir, key, prim);
+  }
+  if (!result) {
+    result = std::make_shared<PrimSymInfo const>(prim);
+    if (cache_dir.has_value()) {
+      write_prim_sym_info(*cache_dir, key, *result);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_prim_sym_info.emplace(key, result).first->second;
+}
+
+/// \brief Return Prim, with PrimSymInfo from the cache
+///
+/// Equivalent to `make_shared_prim(basicstructure)`, but uses
+/// `prim_sym_info(*basicstructure)` instead of generating PrimSymInfo.
+std::shared_ptr<Prim const> PrimSymInfoCache::make_prim(
+    std::shared_ptr<BasicStructure const> const &basicstructure) {
+  if (basicstructure == nullptr) {
+    throw std::runtime_error(
+        "Error in PrimSymInfoCache::make_prim: basicstructure == nullptr");
+  }
+  return std::make_shared<Prim const>(*prim_sym_info(*basicstructure),
+                                      basicstructure);
+}
+
+/// \brief Directory for PrimSymInfo files, or std::nullopt for memory only
+std::optional<fs::path> PrimSymInfoCache::cache_dir() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cache_dir;
+}
+
+/// \brief Set the directory for PrimSymInfo files, or std::nullopt for
+///     memory only
+void PrimSymInfoCache::set_cache_dir(std::optional<fs::path> _cache_dir) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cache_dir = _cache_dir;
+}
+
+/// \brief Number of PrimSymInfo held in memory
+Index PrimSymInfoCache::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_prim_sym_info.size();
+}
+
+/// \brief Memory used by PrimSymInfo held in memory, in bytes
+///     (approximate)
+///
+/// The total of `PrimSymInfo::memory_bytes()` and the key sizes.
+Index PrimSymInfoCache::total_bytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Index bytes = 0;
+  for (auto const &pair : m_prim_sym_info) {
+    bytes += pair.first.capacity() + pair.second->memory_bytes();
+  }
+  return bytes;
+}
+
+/// \brief Clear PrimSymInfo held in memory, leaving any files
+void PrimSymInfoCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_prim_sym_info.clear();
+}
+
+/// \brief Process-wide PrimSymInfoCache, memory only unless a cache
+///     directory is set
+PrimSymInfoCache &default_prim_sym_info_cache() {
+  static PrimSymInfoCache cache;
+  return cache;
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,97 @@
+#include "casm/configuration/ProgressMonitor.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Constructor
+///
+/// \param _callback Called with `(stage, n_done, n_total)` to report
+///     progress, only on the constructing thread. May be empty.
+/// \param _cancel_flag Cancellation is requested when this is set to true.
+///     If nullptr, a new flag is created.
+/// \param _min_interval Minimum time, in seconds, between reports by
+///     `advance` and `check`
+ProgressMonitor::ProgressMonitor(
+    CallbackFunction _callback,
+    std::shared_ptr<std::atomic<bool>> _cancel_flag, double _min_interval)
+    : m_callback(std::move(_callback)),
+      m_cancel_flag(_cancel_flag ? _cancel_flag
+                                 : std::make_shared<std::atomic<bool>>(false)),
+      m_min_interval(std::chrono::duration_cast<
+                     std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(_min_interval))),
+      m_owner(std::this_thread::get_id()),
+      m_n_done(0),
+      m_n_total(-1),
+      m_last_report(std::chrono::steady_clock::now()) {}
+
+/// \brief Start a stage of work, and report it
+///
+/// Must be called on the thread that constructed the ProgressMonitor, while
+/// no other thread is using it. Throws OperationCancelled if cancelled.
+void ProgressMonitor::begin(std::string const &stage, Index n_total) {
+  m_stage = stage;
+  m_n_total = n_total;
+  m_n_done.store(0, std::memory_order_relaxed);
+  _report(true);
+  if (is_cancelled()) {
+    throw OperationCancelled();
+  }
+}
+
+/// \brief Record completed work items, report if due, and throw if
+///     cancelled
+void ProgressMonitor::advance(Index n) {
+  m_n_done.fetch_add(n, std::memory_order_relaxed);
+  check();
+}
+
+/// \brief Report if due, and throw if cancelled
+void ProgressMonitor::check() {
+  _report(false);
+  if (is_cancelled()) {
+    throw OperationCancelled();
+  }
+}
+
+/// \brief Request cancellation
+void ProgressMonitor::cancel() {
+  m_cancel_flag->store(true, std::memory_order_relaxed);
+}
+
+/// \brief Return true if cancellation has been requested
+bool ProgressMonitor::is_cancelled() const {
+  return m_cancel_flag->load(std::memory_order_relaxed);
+}
+
+/// \brief The shared cancel flag
+std::shared_ptr<std::atomic<bool>> const &ProgressMonitor::cancel_flag()
+    const {
+  return m_cancel_flag;
+}
+
+/// \brief Current stage
+std::string const &ProgressMonitor::stage() const { return m_stage; }
+
+/// \brief Number of work items completed in the current stage
+Index ProgressMonitor::n_done() const {
+  return m_n_done.load(std::memory_order_relaxed);
+}
+
+/// \brief Number of work items in the current stage, or -1 if unknown
+Index ProgressMonitor::n_total() const { return m_n_total; }
+
+void ProgressMonitor::_report(bool force) {
+  if (!m_callback || std::this_thread::get_id() != m_owner) {
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  if (!force && now - m_last_report < m_min_interval) {
+    return;
+  }
+  m_last_report = now;
+  m_callback(m_stage, n_done(), m_n_total);
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,381 @@
+#include "casm/configuration/QuantizedCanonicalizer.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/Supercell.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// Number of sites gathered and compared per block in
+/// QuantizedCanonicalizer::_compare_to_best
+Index const quantized_compare_block_size = 64;
+
+/// \brief Return true if all elements of M are integers, within TOL
+bool is_integral(Eigen::MatrixXd const &M) {
+  for (Index i = 0; i < M.size(); ++i) {
+    if (std::abs(M(i) - std::round(M(i))) > TOL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Return the elements of an integer-valued matrix, in row-major
+///     order
+std::vector<std::int64_t> make_integer_matrix(Eigen::MatrixXd const &M) {
+  std::vector<std::int64_t> result;
+  result.reserve(M.size());
+  for (Index i = 0; i < M.rows(); ++i) {
+    for (Index j = 0; j < M.cols(); ++j) {
+      result.push_back(std::llround(M(i, j)));
+    }
+  }
+  return result;
+}
+
+/// \brief Set `out[i] = sum_j M(i, j) * in[j]`, for row-major dim x dim M
+void integer_transform(std::vector<std::int64_t> const &M, Index dim,
+                       std::int64_t const *in, std::int64_t *out) {
+  std::int64_t const *row = M.data();
+  for (Index i = 0; i < dim; ++i, row += dim) {
+    std::int64_t sum = 0;
+    for (Index j = 0; j < dim; ++j) {
+      sum += row[j] * in[j];
+    }
+    out[i] = sum;
+  }
+}
+
+}  // namespace
+
+/// \brief Hash of the quantized values
+std::size_t QuantizedDoFValuesHash::operator()(
+    QuantizedDoFValues const &values) const {
+  std::size_t seed = values.size();
+  for (std::int64_t value : values) {
+    seed ^= std::hash<std::int64_t>()(value) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+  }
+  return seed;
+}
+
+/// \brief Constructor
+///
+/// \param _supercell The supercell. The prim must satisfy
+///     `QuantizedCanonicalizer::is_supported`.
+/// \param _quantum The grid spacing of continuous DoF values, in the prim
+///     DoF basis. Must be greater than the prim lattice tolerance.
+QuantizedCanonicalizer::QuantizedCanonicalizer(
+    std::shared_ptr<Supercell const> const &_supercell, double _quantum)
+    : m_supercell(_supercell),
+      m_quantum(_quantum),
+      m_tol(_supercell->prim->basicstructure->lattice().tol()),
+      m_n_vol(_supercell->superlattice.size()),
+      m_n_sites(_supercell->unitcellcoord_index_converter.total_sites()) {
+  Prim const &prim = *m_supercell->prim;
+  if (!is_supported(prim)) {
+    throw std::runtime_error(
+        "Error constructing QuantizedCanonicalizer: prim has non-integer "
+        "continuous DoF symmetry representation matrices");
+  }
+  if (!(m_quantum > m_tol)) {
+    throw std::runtime_error(
+        "Error constructing QuantizedCanonicalizer: quantum <= tol");
+  }
+  PrimSymInfo const &prim_sym_info = prim.sym_info;
+  Index n_sublat = prim.basicstructure->basis().size();
+
+  Index offset = 0;
+  for (auto const &dof : prim_sym_info.global_dof_symgroup_rep) {
+    GlobalRep rep;
+    rep.key = dof.first;
+    rep.dim = dof.second.empty() ? 0 : dof.second[0].cols();
+    rep.offset = offset;
+    for (Eigen::MatrixXd const &M : dof.second) {
+      rep.matrices.push_back(make_integer_matrix(M));
+    }
+    offset += rep.dim;
+    m_global.push_back(std::move(rep));
+  }
+
+  m_occ_offset = offset;
+  offset += m_n_sites;
+
+  for (auto const &dof : prim_sym_info.local_dof_symgroup_rep) {
+    LocalRep rep;
+    rep.key = dof.first;
+    rep.rows = 0;
+    rep.offset = offset;
+    rep.dim.resize(n_sublat, 0);
+    for (auto const &local_dof_symop_rep : dof.second) {
+      std::vector<std::vector<std::int64_t>> matrices;
+      for (Index b = 0; b < n_sublat; ++b) {
+        Eigen::MatrixXd const &M = local_dof_symop_rep[b];
+        rep.dim[b] = M.cols();
+        rep.rows = std::max(rep.rows, Index(M.cols()));
+        matrices.push_back(make_integer_matrix(M));
+      }
+      rep.matrices.push_back(std::move(matrices));
+    }
+    offset += rep.rows * m_n_sites;
+    m_local.push_back(std::move(rep));
+  }
+
+  m_size = offset;
+  m_values.resize(m_size);
+  m_best.resize(m_size);
+  m_candidate.resize(m_size);
+}
+
+/// \brief Return true if all prim continuous DoF symmetry representation
+///     matrices are integer-valued
+bool QuantizedCanonicalizer::is_supported(Prim const &prim) {
+  PrimSymInfo const &prim_sym_info = prim.sym_info;
+  for (auto const &dof : prim_sym_info.global_dof_symgroup_rep) {
+    for (Eigen::MatrixXd const &M : dof.second) {
+      if (!is_integral(M)) {
+        return false;
+      }
+    }
+  }
+  for (auto const &dof : prim_sym_info.local_dof_symgroup_rep) {
+    for (auto const &local_dof_symop_rep : dof.second) {
+      for (Eigen::MatrixXd const &M : local_dof_symop_rep) {
+        if (!is_integral(M)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/// \brief The supercell
+std::shared_ptr<Supercell const> const &QuantizedCanonicalizer::supercell()
+    const {
+  return m_supercell;
+}
+
+/// \brief The grid spacing of continuous DoF values
+double QuantizedCanonicalizer::quantum() const { return m_quantum; }
+
+/// \brief Convert DoF values to quantized values
+///
+/// Throws if any continuous DoF value is not within the prim lattice
+/// tolerance of an integer multiple of `quantum()`.
+QuantizedDoFValues QuantizedCanonicalizer::quantize(
+    ConfigDoFValues const &dof_values) const {
+  QuantizedDoFValues result(m_size);
+  auto _quantize = [&](double value) {
+    std::int64_t q = std::llround(value / m_quantum);
+    if (std::abs(value - q * m_quantum) > m_tol) {
+      throw std::runtime_error(
+          "Error in QuantizedCanonicalizer::quantize: continuous DoF value "
+          "is not on the grid");
+    }
+    return q;
+  };
+
+  for (GlobalRep const &rep : m_global) {
+    Eigen::VectorXd const &values = dof_values.global_dof_values.at(rep.key);
+    if (values.size() != rep.dim) {
+      throw std::runtime_error(
+          "Error in QuantizedCanonicalizer::quantize: global DoF dimension "
+          "mismatch");
+    }
+    for (Index i = 0; i < rep.dim; ++i) {
+      result[rep.offset + i] = _quantize(values(i));
+    }
+  }
+
+  if (dof_values.occupation.size() != m_n_sites) {
+    throw std::runtime_error(
+        "Error in QuantizedCanonicalizer::quantize: occupation size mismatch");
+  }
+  for (Index l = 0; l < m_n_sites; ++l) {
+    result[m_occ_offset + l] = dof_values.occupation(l);
+  }
+
+  for (LocalRep const &rep : m_local) {
+    Eigen::MatrixXd const &values = dof_values.local_dof_values.at(rep.key);
+    if (values.rows() != rep.rows || values.cols() != m_n_sites) {
+      throw std::runtime_error(
+          "Error in QuantizedCanonicalizer::quantize: local DoF shape "
+          "mismatch");
+    }
+    std::int64_t *out = result.data() + rep.offset;
+    for (Index l = 0; l < m_n_sites; ++l) {
+      for (Index i = 0; i < rep.rows; ++i) {
+        *out++ = _quantize(values(i, l));
+      }
+    }
+  }
+  return result;
+}
+
+/// \brief Convert quantized values to a configuration
+///
+/// Continuous DoF values are set to `q * quantum()` exactly.
+Configuration QuantizedCanonicalizer::dequantize(
+    QuantizedDoFValues const &quantized) const {
+  if (quantized.size() != m_size) {
+    throw std::runtime_error(
+        "Error in QuantizedCanonicalizer::dequantize: size mismatch");
+  }
+  Configuration configuration(m_supercell);
+  ConfigDoFValues &dof_values = configuration.dof_values;
+  for (GlobalRep const &rep : m_global) {
+    Eigen::VectorXd &values = dof_values.global_dof_values.at(rep.key);
+    values.resize(rep.dim);
+    for (Index i = 0; i < rep.dim; ++i) {
+      values(i) = quantized[rep.offset + i] * m_quantum;
+    }
+  }
+  dof_values.occupation.resize(m_n_sites);
+  for (Index l = 0; l < m_n_sites; ++l) {
+    dof_values.occupation(l) = quantized[m_occ_offset + l];
+  }
+  for (LocalRep const &rep : m_local) {
+    Eigen::MatrixXd &values = dof_values.local_dof_values.at(rep.key);
+    values.resize(rep.rows, m_n_sites);
+    std::int64_t const *in = quantized.data() + rep.offset;
+    for (Index l = 0; l < m_n_sites; ++l) {
+      for (Index i = 0; i < rep.rows; ++i) {
+        values(i, l) = *in++ * m_quantum;
+      }
+    }
+  }
+  return configuration;
+}
+
+/// \brief Return true if configuration is in canonical form, using all
+///     supercell operations
+bool QuantizedCanonicalizer::is_canonical(Configuration const &configuration) {
+  return this->is_canonical(configuration, SupercellSymOp::begin(m_supercell),
+                            SupercellSymOp::end(m_supercell));
+}
+
+/// \brief Return rep that makes a configuration canonical, using all
+///     supercell operations
+SupercellSymOp QuantizedCanonicalizer::to_canonical(
+    Configuration const &configuration) {
+  return this->to_canonical(configuration, SupercellSymOp::begin(m_supercell),
+                            SupercellSymOp::end(m_supercell));
+}
+
+/// \brief Return the quantized canonical form, using all supercell
+///     operations
+QuantizedDoFValues QuantizedCanonicalizer::make_canonical_quantized(
+    Configuration const &configuration) {
+  return this->make_canonical_quantized(configuration,
+                                        SupercellSymOp::begin(m_supercell),
+                                        SupercellSymOp::end(m_supercell));
+}
+
+/// \brief Return the canonical configuration, with continuous DoF values
+///     set exactly to the grid, using all supercell operations
+Configuration QuantizedCanonicalizer::make_canonical_form(
+    Configuration const &configuration) {
+  return dequantize(this->make_canonical_quantized(configuration));
+}
+
+/// \brief Quantize configuration into m_values
+void QuantizedCanonicalizer::_set_configuration(
+    Configuration const &configuration) {
+  if (configuration.supercell != m_supercell &&
+      *configuration.supercell != *m_supercell) {
+    throw std::runtime_error(
+        "Error in QuantizedCanonicalizer: supercell mismatch");
+  }
+  m_values = quantize(configuration.dof_values);
+}
+
+/// \brief Compare copy_apply(op, m_values) to m_best
+///
+/// Values are transformed and compared in the same order as by
+/// ConfigIsEquivalent: global DoF, then occupation, then local DoF site by
+/// site.
+int QuantizedCanonicalizer::_compare_to_best(SupercellSymOp const &op,
+                                             bool complete_if_greater) {
+  Index prim_fg_index = op.prim_factor_group_index();
+  std::int64_t const *value = m_values.data();
+  std::int64_t const *best = m_best.data();
+  std::int64_t *candidate = m_candidate.data();
+
+  // compare candidate[begin, end) to best, if equal so far; return true if
+  // the comparison is finished
+  int cmp = 0;
+  auto compare = [&](Index begin, Index end) {
+    if (cmp == 0) {
+      for (Index i = begin; i < end; ++i) {
+        if (candidate[i] != best[i]) {
+          cmp = (candidate[i] < best[i]) ? -1 : 1;
+          break;
+        }
+      }
+    }
+    return cmp < 0 || (cmp > 0 && !complete_if_greater);
+  };
+
+  for (GlobalRep const &rep : m_global) {
+    integer_transform(rep.matrices[prim_fg_index], rep.dim, value + rep.offset,
+                      candidate + rep.offset);
+    if (compare(rep.offset, rep.offset + rep.dim)) {
+      return cmp;
+    }
+  }
+
+  // value on site l is gathered from site combined_permute[l]
+  sym_info::Permutation const &combined_permute =
+      SupercellSymOpHandle(op).combined_permute();
+
+  PrimSymInfo const &prim_sym_info = m_supercell->prim->sym_info;
+  std::int64_t const *occ = value + m_occ_offset;
+  std::int64_t *occ_candidate = candidate + m_occ_offset;
+  for (Index begin = 0; begin < m_n_sites;
+       begin += quantized_compare_block_size) {
+    Index end = std::min(begin + quantized_compare_block_size, m_n_sites);
+    if (prim_sym_info.has_aniso_occs) {
+      auto const &occ_perms = prim_sym_info.occ_symgroup_rep[prim_fg_index];
+      for (Index l = begin; l < end; ++l) {
+        Index l_from = combined_permute[l];
+        occ_candidate[l] = occ_perms[l_from / m_n_vol][occ[l_from]];
+      }
+    } else {
+      for (Index l = begin; l < end; ++l) {
+        occ_candidate[l] = occ[combined_permute[l]];
+      }
+    }
+    if (compare(m_occ_offset + begin, m_occ_offset + end)) {
+      return cmp;
+    }
+  }
+
+  for (LocalRep const &rep : m_local) {
+    auto const &matrices = rep.matrices[prim_fg_index];
+    for (Index l = 0; l < m_n_sites; ++l) {
+      Index l_from = combined_permute[l];
+      Index b_from = l_from / m_n_vol;
+      Index dim = rep.dim[b_from];
+      std::int64_t const *in = value + rep.offset + l_from * rep.rows;
+      Index begin = rep.offset + l * rep.rows;
+      std::int64_t *out = candidate + begin;
+      integer_transform(matrices[b_from], dim, in, out);
+      for (Index i = dim; i < rep.rows; ++i) {
+        out[i] = in[i];
+      }
+      if (compare(begin, begin + rep.rows)) {
+        return cmp;
+      }
+    }
+  }
+  return cmp;
+}
+
+}  // namespace config
+}  // namespace CASM
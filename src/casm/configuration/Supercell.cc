@@ -1,6 +1,18 @@
 #include "casm/configuration/Supercell.hh"
 
+#include <array>
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include "casm/configuration/SupercellSymInfo.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/instrumentation.hh"
+#include "casm/configuration/memory_usage.hh"
+#include "casm/configuration/numa.hh"
+#include "casm/configuration/supercell_name.hh"
+#include "casm/crystallography/CanonicalForm.hh"
+#include "casm/crystallography/Lattice.hh"
 
 namespace CASM {
 namespace config {
@@ -17,12 +29,15 @@ Supercell::Supercell(std::shared_ptr<Prim const> const &_prim,
                      Index max_n_translation_permutations)
     : prim(_prim),
       superlattice(_superlattice),
+      name(make_supercell_name(superlattice.transformation_matrix_to_super())),
       unitcell_index_converter(superlattice.transformation_matrix_to_super()),
       unitcellcoord_index_converter(
           superlattice.transformation_matrix_to_super(),
           prim->basicstructure->basis().size()),
-      sym_info(prim, superlattice, unitcell_index_converter,
-               unitcellcoord_index_converter, max_n_translation_permutations) {}
+      m_max_n_translation_permutations(max_n_translation_permutations),
+      m_equivalent_prim_factor_group_index(-1) {
+  CASM_CONFIG_COUNT(supercells_constructed);
+}
 
 Supercell::Supercell(std::shared_ptr<Prim const> const &_prim,
                      Eigen::Matrix3l const &_superlattice_matrix,
@@ -32,6 +47,183 @@ Supercell::Supercell(std::shared_ptr<Prim const> const &_prim,
           Superlattice(_prim->basicstructure->lattice(), _superlattice_matrix),
           max_n_translation_permutations) {}
 
+/// \brief Constructor, sharing symmetry info with an equivalent supercell
+///
+/// \param _prim The prim
+/// \param _superlattice_matrix The supercell transformation matrix
+/// \param max_n_translation_permutations Passed to the SupercellSymInfo
+///     constructor
+/// \param _equivalent_supercell If not nullptr, a supercell with the same
+///     prim and a symmetrically equivalent lattice. Then `sym_info()` is
+///     constructed by conjugating `_equivalent_supercell->sym_info()`,
+///     which is constructed if it does not already exist. Throws if the
+///     supercells are not equivalent.
+Supercell::Supercell(
+    std::shared_ptr<Prim const> const &_prim,
+    Eigen::Matrix3l const &_superlattice_matrix,
+    Index max_n_translation_permutations,
+    std::shared_ptr<Supercell const> const &_equivalent_supercell)
+    : Supercell(_prim, _superlattice_matrix, max_n_translation_permutations) {
+  if (_equivalent_supercell == nullptr) {
+    return;
+  }
+  if (_equivalent_supercell->prim != prim) {
+    throw std::runtime_error(
+        "Error constructing Supercell: equivalent supercell prim mismatch");
+  }
+  Lattice const &lattice = superlattice.superlattice();
+  auto const &prim_fg = *prim->sym_info.factor_group;
+  auto begin = prim_fg.element.begin();
+  auto end = prim_fg.element.end();
+  auto res = xtal::is_equivalent_superlattice(
+      lattice, _equivalent_supercell->superlattice.superlattice(), begin, end,
+      lattice.tol());
+  if (res.first == end) {
+    throw std::runtime_error(
+        "Error constructing Supercell: supercells are not equivalent");
+  }
+  m_equivalent_supercell = _equivalent_supercell;
+  m_equivalent_prim_factor_group_index = std::distance(begin, res.first);
+}
+
+/// \brief Holds symmetry representations used for all configurations with
+/// the same supercell
+///
+/// Constructed on first access. Thread safe.
+///
+/// The tables are constructed without holding `m_sym_info_flag`, and only
+/// published under it: for large supercells they are made with
+/// `parallel_for_chunks`, and while waiting for those chunks this thread may
+/// run other queued tasks that call `sym_info()` on this supercell. If
+/// several calls race, each constructs a SupercellSymInfo and the first one
+/// finished is kept.
+SupercellSymInfo const &Supercell::sym_info() const {
+  if (m_has_sym_info) {
+    return *m_sym_info;
+  }
+
+  // construct without holding the once_flag
+  std::unique_ptr<SupercellSymInfo const> _sym_info;
+  {
+    CASM_CONFIG_SCOPED_TIMER(supercell_sym_info);
+    auto equivalent_supercell = std::atomic_load(&m_equivalent_supercell);
+    if (equivalent_supercell != nullptr) {
+      _sym_info = std::make_unique<SupercellSymInfo const>(
+          prim, superlattice, unitcell_index_converter,
+          unitcellcoord_index_converter, m_max_n_translation_permutations,
+          equivalent_supercell->sym_info(),
+          equivalent_supercell->unitcellcoord_index_converter,
+          m_equivalent_prim_factor_group_index);
+    } else {
+      _sym_info = std::make_unique<SupercellSymInfo const>(
+          prim, superlattice, unitcell_index_converter,
+          unitcellcoord_index_converter, m_max_n_translation_permutations);
+    }
+  }
+
+  std::call_once(m_sym_info_flag, [&]() {
+    m_sym_info = std::move(_sym_info);
+    m_sym_info_numa_node = current_numa_node();
+    std::atomic_store(&m_equivalent_supercell,
+                      std::shared_ptr<Supercell const>());
+    m_has_sym_info = true;
+  });
+  return *m_sym_info;
+}
+
+/// \brief The name of the canonical equivalent supercell
+///
+/// Constructed on first access, without constructing the canonical
+/// Supercell. Thread safe.
+std::string const &Supercell::canonical_name() const {
+  std::call_once(m_canonical_name_flag, [&]() {
+    if (is_canonical(*this)) {
+      m_canonical_name = name;
+      return;
+    }
+    Lattice const &prim_lattice = superlattice.prim_lattice();
+    Lattice lattice = superlattice.superlattice();
+    lattice.make_right_handed();
+    Lattice canonical_lattice = xtal::canonical::equivalent(
+        lattice, prim->sym_info.point_group->element, lattice.tol());
+    m_canonical_name =
+        make_supercell_name(xtal::make_transformation_matrix_to_super(
+            prim_lattice, canonical_lattice, prim_lattice.tol()));
+  });
+  return m_canonical_name;
+}
+
+/// \brief The maximum number of translation permutations stored by
+///     sym_info()
+Index Supercell::max_n_translation_permutations() const {
+  return m_max_n_translation_permutations;
+}
+
+/// \brief Memory used by the supercell, in bytes (approximate)
+///
+/// Includes the index converters, the name, and, if it has been
+/// constructed, `sym_info()` and its NUMA replicas. Does not include the
+/// prim, which is shared, or an equivalent supercell held until
+/// `sym_info()` is constructed.
+Index Supercell::memory_bytes() const {
+  Index n_unitcells = unitcell_index_converter.total_sites();
+  Index n_sites = unitcellcoord_index_converter.total_sites();
+  Index bytes = sizeof(Supercell) + name.capacity();
+  bytes += n_unitcells * (sizeof(xtal::UnitCell) + sizeof(Index));
+  bytes += n_sites * (sizeof(xtal::UnitCellCoord) + sizeof(Index));
+  if (has_sym_info()) {
+    bytes += m_sym_info->memory_bytes();
+  }
+  std::lock_guard<std::mutex> lock(m_numa_replicas_mutex);
+  for (auto const &replica : m_numa_replicas) {
+    if (replica) {
+      bytes += replica->memory_bytes();
+    }
+  }
+  return bytes;
+}
+
+/// \brief Return an equal supercell, with a copy of sym_info() made on
+///     NUMA node `node`
+///
+/// The replica is constructed on first use for each node, by copying
+/// `sym_info()` on the calling thread, so that with first-touch page
+/// placement its tables are allocated on the calling thread's node. Its
+/// combined permutation table is cached separately, and made by the first
+/// thread that uses it. The factor group is shared with this supercell.
+/// Thread safe.
+///
+/// \param node A NUMA node index, as returned by `current_numa_node()`
+///
+/// \returns The replica for `node`, or nullptr if `node` is the node on
+///     which `sym_info()` was constructed, or if the memory budget does not
+///     allow another copy (see `set_memory_budget`).
+std::shared_ptr<Supercell const> Supercell::numa_replica(Index node) const {
+  SupercellSymInfo const &home = sym_info();
+  if (node < 0 || node == m_sym_info_numa_node) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(m_numa_replicas_mutex);
+  if (node < m_numa_replicas.size() && m_numa_replicas[node]) {
+    return m_numa_replicas[node];
+  }
+  if (!memory_budget_allows(home.memory_bytes())) {
+    return nullptr;
+  }
+  auto replica = std::make_shared<Supercell>(prim, superlattice,
+                                             m_max_n_translation_permutations);
+  std::call_once(replica->m_sym_info_flag, [&]() {
+    replica->m_sym_info = std::make_unique<SupercellSymInfo const>(home);
+    replica->m_sym_info_numa_node = node;
+    replica->m_has_sym_info = true;
+  });
+  if (node >= m_numa_replicas.size()) {
+    m_numa_replicas.resize(node + 1);
+  }
+  m_numa_replicas[node] = replica;
+  return replica;
+}
+
 /// \brief Less than comparison of Supercell
 bool Supercell::operator<(Supercell const &B) const {
   if (prim != B.prim) {
@@ -59,5 +251,107 @@ bool Supercell::eq_impl(Supercell const &B) const {
          B.superlattice.transformation_matrix_to_super();
 }
 
+namespace {
+
+/// Key for the shared supercell cache: (prim address, transformation
+/// matrix to super, max_n_translation_permutations)
+typedef std::tuple<Prim const *, std::array<long, 9>, Index>
+    SupercellCacheKey;
+
+/// \brief Cache of Supercell, used by make_shared_supercell
+///
+/// Holds weak_ptr, so that supercells are destroyed when no longer used
+/// elsewhere. A live Supercell holds a shared_ptr to its prim, so a prim
+/// address in the key cannot be reused by a different Prim while the
+/// corresponding entry is not expired.
+struct SupercellCache {
+  std::mutex mutex;
+  std::map<SupercellCacheKey, std::weak_ptr<Supercell const>> data;
+
+  /// Size after the last removal of expired entries
+  std::size_t size_after_cleanup = 0;
+
+  /// \brief Remove expired entries, if the cache has doubled in size
+  void cleanup_if_necessary() {
+    if (data.size() < 2 * size_after_cleanup + 64) {
+      return;
+    }
+    for (auto it = data.begin(); it != data.end();) {
+      if (it->second.expired()) {
+        it = data.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    size_after_cleanup = data.size();
+  }
+};
+
+SupercellCache &supercell_cache() {
+  static SupercellCache cache;
+  return cache;
+}
+
+}  // namespace
+
+/// \brief Return a shared Supercell, re-using an existing one if possible
+///
+/// \param prim The prim
+/// \param transformation_matrix_to_super The supercell transformation
+///     matrix
+/// \param max_n_translation_permutations Passed to the Supercell
+///     constructor
+/// \param equivalent_supercell Passed to the Supercell constructor, if a new
+///     Supercell is constructed, to share symmetry info with an equivalent
+///     supercell
+///
+/// \returns If a Supercell with the same prim, transformation matrix, and
+///     max_n_translation_permutations was previously returned by this
+///     function and is still in use, it is returned. Otherwise, a new
+///     Supercell is constructed and returned.
+///
+/// Notes:
+/// - This is thread safe
+/// - Supercell construction, which includes generating SupercellSymInfo,
+///   is done without holding the cache lock. If two threads construct the
+///   same supercell at the same time, both get the one inserted first.
+std::shared_ptr<Supercell const> make_shared_supercell(
+    std::shared_ptr<Prim const> const &prim,
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    Index max_n_translation_permutations,
+    std::shared_ptr<Supercell const> const &equivalent_supercell) {
+  std::array<long, 9> T;
+  for (Index i = 0; i < 3; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      T[3 * i + j] = transformation_matrix_to_super(i, j);
+    }
+  }
+  SupercellCacheKey key(prim.get(), T, max_n_translation_permutations);
+  SupercellCache &cache = supercell_cache();
+
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.data.find(key);
+    if (it != cache.data.end()) {
+      if (auto existing = it->second.lock()) {
+        return existing;
+      }
+    }
+  }
+
+  auto supercell = std::make_shared<Supercell const>(
+      prim, transformation_matrix_to_super, max_n_translation_permutations,
+      equivalent_supercell);
+
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  std::weak_ptr<Supercell const> &value = cache.data[key];
+  if (auto existing = value.lock()) {
+    return existing;
+  }
+  value = supercell;
+  cache.cleanup_if_necessary();
+  return supercell;
+}
+
 }  // namespace config
 }  // namespace CASM
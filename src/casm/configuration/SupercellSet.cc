@@ -1,44 +1,102 @@
 #include "casm/configuration/SupercellSet.hh"
 
+#include <algorithm>
 #include <map>
 #include <set>
 
 #include "casm/configuration/Supercell.hh"
 #include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/copy_configuration.hh"
 #include "casm/configuration/definitions.hh"
 #include "casm/configuration/supercell_name.hh"
+#include "casm/crystallography/CanonicalForm.hh"
+#include "casm/crystallography/Lattice.hh"
 
 namespace CASM {
 namespace config {
 
+namespace {
+
+/// \brief Make the transformation matrix of the canonical supercell
+///     equivalent to a superlattice
+Eigen::Matrix3l make_canonical_transformation_matrix_to_super(
+    Lattice superlattice, std::shared_ptr<Prim const> const &prim) {
+  Lattice const &prim_lattice = prim->basicstructure->lattice();
+  superlattice.make_right_handed();
+  Lattice canonical_superlattice = xtal::canonical::equivalent(
+      superlattice, prim->sym_info.point_group->element, superlattice.tol());
+  return xtal::make_transformation_matrix_to_super(
+      prim_lattice, canonical_superlattice, prim_lattice.tol());
+}
+
+/// \brief Make the shared canonical supercell equivalent to the supercell
+///     with the given name
+///
+/// This avoids constructing the non-canonical Supercell, and uses
+/// make_shared_supercell to re-use an existing canonical Supercell if
+/// possible.
+std::shared_ptr<Supercell const> make_shared_canonical_supercell_by_name(
+    std::string const &supercell_name,
+    std::shared_ptr<Prim const> const &prim) {
+  Lattice const &prim_lattice = prim->basicstructure->lattice();
+  return make_shared_supercell(
+      prim, make_canonical_transformation_matrix_to_super(
+                make_superlattice_from_supercell_name(prim_lattice,
+                                                      supercell_name),
+                prim));
+}
+
+}  // namespace
+
 SupercellRecord::SupercellRecord(
     std::shared_ptr<Supercell const> const &_supercell)
     : supercell(throw_if_equal_to_nullptr(
           _supercell,
           "Error in SupercellRecord constructor: value == nullptr")),
-      supercell_name(
-          make_supercell_name(supercell->superlattice.prim_lattice(),
-                              supercell->superlattice.superlattice())),
-      is_canonical(config::is_canonical(*supercell)) {
-  if (this->is_canonical) {
-    this->canonical_supercell_name = this->supercell_name;
-  } else {
-    auto canonical_supercell = make_canonical_form(*this->supercell);
-    this->canonical_supercell_name =
-        make_supercell_name(canonical_supercell->superlattice.prim_lattice(),
-                            canonical_supercell->superlattice.superlattice());
-  }
-}
+      supercell_name(supercell->name),
+      canonical_supercell_name(supercell->canonical_name()),
+      is_canonical(config::is_canonical(*supercell)) {}
 
 bool SupercellRecord::operator<(SupercellRecord const &rhs) const {
   return *this->supercell < *rhs.supercell;
 }
 
 SupercellSet::SupercellSet(std::shared_ptr<Prim const> const &_prim)
-    : m_prim(_prim), m_data() {
+    : m_prim(_prim), m_data(), m_index_is_valid(true) {
   if (m_prim == nullptr) {
     throw std::runtime_error("Error constructing SupercellSet: prim is empty");
   }
+  Lattice const &prim_lattice = m_prim->basicstructure->lattice();
+  m_frac_point_group = make_frac_point_matrices(
+      prim_lattice, m_prim->sym_info.point_group->element);
+  m_frac_factor_group = make_frac_point_matrices(
+      prim_lattice, m_prim->sym_info.factor_group->element);
+}
+
+/// \brief Copy constructor, the lookup indexes are rebuilt on first use
+SupercellSet::SupercellSet(SupercellSet const &other)
+    : m_prim(other.m_prim),
+      m_data(other.m_data),
+      m_index_is_valid(false),
+      m_canonical_supercell(other.m_canonical_supercell),
+      m_frac_point_group(other.m_frac_point_group),
+      m_frac_factor_group(other.m_frac_factor_group),
+      m_canonical_matrix_by_hnf(other.m_canonical_matrix_by_hnf) {}
+
+/// \brief Copy assignment, the lookup indexes are rebuilt on first use
+SupercellSet &SupercellSet::operator=(SupercellSet const &other) {
+  if (this != &other) {
+    m_prim = other.m_prim;
+    m_data = other.m_data;
+    m_index_by_matrix.clear();
+    m_index_by_canonical_name.clear();
+    m_index_is_valid = false;
+    m_canonical_supercell = other.m_canonical_supercell;
+    m_frac_point_group = other.m_frac_point_group;
+    m_frac_factor_group = other.m_frac_factor_group;
+    m_canonical_matrix_by_hnf = other.m_canonical_matrix_by_hnf;
+  }
+  return *this;
 }
 
 std::shared_ptr<Prim const> SupercellSet::prim() const { return m_prim; }
@@ -47,7 +105,13 @@ bool SupercellSet::empty() const { return m_data.empty(); }
 
 SupercellSet::size_type SupercellSet::size() const { return m_data.size(); }
 
-void SupercellSet::clear() { m_data.clear(); }
+void SupercellSet::clear() {
+  m_data.clear();
+  m_canonical_supercell.clear();
+  m_index_by_matrix.clear();
+  m_index_by_canonical_name.clear();
+  m_index_is_valid = true;
+}
 
 SupercellSet::const_iterator SupercellSet::begin() const {
   return m_data.begin();
@@ -57,24 +121,52 @@ SupercellSet::const_iterator SupercellSet::end() const { return m_data.end(); }
 
 std::pair<SupercellSet::iterator, bool> SupercellSet::insert(
     std::shared_ptr<Supercell const> supercell) {
-  return m_data.emplace(supercell);
+  if (supercell != nullptr && supercell->prim == m_prim) {
+    auto it = find(supercell->superlattice.transformation_matrix_to_super());
+    if (it != end()) {
+      return std::make_pair(it, false);
+    }
+  }
+  return _insert_and_index(m_data.emplace(supercell));
 }
 
 std::pair<SupercellSet::iterator, bool> SupercellSet::insert(
     SupercellRecord const &record) {
-  return m_data.insert(record);
+  return _insert_and_index(m_data.insert(record));
 }
 
+/// \brief Insert a supercell by transformation matrix
+///
+/// \param transformation_matrix_to_super The supercell transformation matrix
+///
+/// \returns Returns a pair consisting of an iterator to the inserted element
+///     (or to the element that prevented the insertion) and a bool value set to
+///     true if and only if the insertion took place.
+///
+/// Notes:
+/// - If the supercell is not canonical and its canonical equivalent
+///   supercell is already in this set, the new supercell is constructed
+///   with the canonical supercell as equivalent supercell, so that its
+///   symmetry info is constructed by conjugating the canonical supercell's
+///   symmetry info (see `Supercell`).
 std::pair<SupercellSet::iterator, bool> SupercellSet::insert(
     Eigen::Matrix3l const &transformation_matrix_to_super) {
   auto it = find(transformation_matrix_to_super);
-  if (it == end()) {
-    auto supercell = std::make_shared<Supercell const>(
-        m_prim, transformation_matrix_to_super);
-    return m_data.emplace(supercell);
-  } else {
+  if (it != end()) {
     return std::make_pair(it, false);
   }
+  std::shared_ptr<Supercell const> equivalent_supercell;
+  Eigen::Matrix3l canonical_transformation_matrix_to_super =
+      _canonical_transformation_matrix_to_super(transformation_matrix_to_super);
+  if (canonical_transformation_matrix_to_super !=
+      transformation_matrix_to_super) {
+    auto canonical_it = find(canonical_transformation_matrix_to_super);
+    if (canonical_it != end()) {
+      equivalent_supercell = canonical_it->supercell;
+    }
+  }
+  return _insert_and_index(m_data.emplace(make_shared_supercell(
+      m_prim, transformation_matrix_to_super, 100, equivalent_supercell)));
 }
 
 /// \brief Insert a canonical supercell by name
@@ -93,11 +185,9 @@ std::pair<SupercellSet::iterator, bool> SupercellSet::insert_canonical(
     std::string supercell_name) {
   auto it = find_canonical_by_name(supercell_name);
   if (it == end()) {
-    auto supercell = std::make_shared<Supercell const>(
-        m_prim, make_superlattice_from_supercell_name(
-                    m_prim->basicstructure->lattice(), supercell_name));
-    auto canonical_supercell = make_canonical_form(*supercell);
-    auto result = m_data.emplace(canonical_supercell);
+    auto canonical_supercell =
+        make_shared_canonical_supercell_by_name(supercell_name, m_prim);
+    auto result = insert(canonical_supercell);
     if (result.first->canonical_supercell_name != supercell_name) {
       throw std::runtime_error(
           "Error in SupercellSet::insert_canonical: supercell_name is not the "
@@ -111,6 +201,9 @@ std::pair<SupercellSet::iterator, bool> SupercellSet::insert_canonical(
 
 SupercellSet::const_iterator SupercellSet::find(
     std::shared_ptr<Supercell const> supercell) const {
+  if (supercell != nullptr && supercell->prim == m_prim) {
+    return find(supercell->superlattice.transformation_matrix_to_super());
+  }
   return m_data.find(SupercellRecord(supercell));
 }
 
@@ -121,32 +214,30 @@ SupercellSet::const_iterator SupercellSet::find(
 
 SupercellSet::const_iterator SupercellSet::find(
     Eigen::Matrix3l const &transformation_matrix_to_super) const {
-  auto it = this->begin();
-  auto end = this->end();
-  for (; it != end; ++it) {
-    if (it->supercell->superlattice.transformation_matrix_to_super() ==
-        transformation_matrix_to_super) {
-      return it;
-    }
+  _validate_index();
+  auto it = m_index_by_matrix.find(_matrix_key(transformation_matrix_to_super));
+  if (it == m_index_by_matrix.end()) {
+    return end();
   }
-  return end;
+  return it->second;
 }
 
 SupercellSet::const_iterator SupercellSet::find_canonical_by_name(
     std::string name) const {
-  auto it = this->begin();
-  auto end = this->end();
-  for (; it != end; ++it) {
-    if (it->is_canonical && it->supercell_name == name) {
-      return it;
-    }
+  _validate_index();
+  auto it = m_index_by_canonical_name.find(name);
+  if (it == m_index_by_canonical_name.end()) {
+    return end();
   }
-  return end;
+  return it->second;
 }
 
 SupercellSet::size_type SupercellSet::count(
     std::shared_ptr<Supercell const> supercell) const {
-  return m_data.count(SupercellRecord(supercell));
+  if (find(supercell) != end()) {
+    return 1;
+  }
+  return 0;
 }
 
 SupercellSet::size_type SupercellSet::count(
@@ -164,28 +255,40 @@ SupercellSet::size_type SupercellSet::count(
 
 SupercellSet::size_type SupercellSet::count_canonical_by_name(
     std::string name) const {
-  SupercellSet::size_type n = 0;
-  auto it = this->begin();
-  auto end = this->end();
-  for (; it != end; ++it) {
-    if (it->is_canonical && it->supercell_name == name) {
-      ++n;
-    }
+  if (find_canonical_by_name(name) != end()) {
+    return 1;
   }
-  return n;
+  return 0;
 }
 
 SupercellSet::const_iterator SupercellSet::erase(const_iterator it) {
+  m_canonical_supercell.clear();
+  _validate_index();
+  m_index_by_matrix.erase(_matrix_key(
+      it->supercell->superlattice.transformation_matrix_to_super()));
+  if (it->is_canonical) {
+    m_index_by_canonical_name.erase(it->supercell_name);
+  }
   return m_data.erase(it);
 }
 
 SupercellSet::size_type SupercellSet::erase(
     std::shared_ptr<Supercell const> supercell) {
-  return m_data.erase(SupercellRecord(supercell));
+  auto it = find(supercell);
+  if (it == end()) {
+    return 0;
+  }
+  erase(it);
+  return 1;
 }
 
 SupercellSet::size_type SupercellSet::erase(SupercellRecord const &record) {
-  return m_data.erase(record);
+  auto it = find(record);
+  if (it == end()) {
+    return 0;
+  }
+  erase(it);
+  return 1;
 }
 
 SupercellSet::size_type SupercellSet::erase(
@@ -194,7 +297,7 @@ SupercellSet::size_type SupercellSet::erase(
   if (it == end()) {
     return 0;
   }
-  m_data.erase(it);
+  erase(it);
   return 1;
 }
 
@@ -204,14 +307,140 @@ SupercellSet::size_type SupercellSet::erase_canonical_by_name(
   if (it == end()) {
     return 0;
   }
-  m_data.erase(it);
+  erase(it);
   return 1;
 }
 
-std::set<SupercellRecord> &SupercellSet::data() { return m_data; }
+/// \brief Return the canonical equivalent supercell, inserted in this set,
+///     and the index of a prim factor group operation that transforms
+///     `supercell` to it
+///
+/// \param supercell A supercell with the same prim as this set
+///
+/// \returns (canonical_supercell, prim_factor_group_index), where
+///     `canonical_supercell` is the shared supercell in this set, and
+///     `prim_factor_group_index` is a prim factor group operation that
+///     transforms `supercell` to `canonical_supercell`, as by
+///     `prim_factor_group_index_to_supercell`.
+///
+/// Results are remembered by supercell transformation matrix, so that
+/// converting many configurations in the same few supercells, for example
+/// with `make_in_canonical_supercell`, only finds the canonical supercell
+/// once per distinct supercell. The canonical supercell is also remembered
+/// by canonical HNF (see `make_canonical_hnf`), so lattice comparisons are
+/// only made once per class of equivalent supercells, and the operation is
+/// found with integer matrices.
+///
+std::pair<std::shared_ptr<Supercell const>, Index>
+SupercellSet::canonical_supercell(
+    std::shared_ptr<Supercell const> const &supercell) {
+  if (supercell->prim != m_prim) {
+    throw std::runtime_error(
+        "Error in SupercellSet::canonical_supercell: prim mismatch");
+  }
+  matrix_key_type key =
+      _matrix_key(supercell->superlattice.transformation_matrix_to_super());
+  auto it = m_canonical_supercell.find(key);
+  if (it != m_canonical_supercell.end()) {
+    return it->second;
+  }
+
+  Eigen::Matrix3l const &T =
+      supercell->superlattice.transformation_matrix_to_super();
+  Eigen::Matrix3l canonical_T = _canonical_transformation_matrix_to_super(T);
+  Index prim_factor_group_index =
+      find_frac_op_index_to_supercell(T, canonical_T, m_frac_factor_group);
+  if (prim_factor_group_index == -1) {
+    throw std::runtime_error(
+        "Error in SupercellSet::canonical_supercell: no operation to the "
+        "canonical supercell");
+  }
+  std::shared_ptr<Supercell const> canonical_supercell =
+      (canonical_T == T ? insert(supercell) : insert(canonical_T))
+          .first->supercell;
+  return m_canonical_supercell
+      .emplace(key,
+               std::make_pair(canonical_supercell, prim_factor_group_index))
+      .first->second;
+}
+
+/// \brief Access the records directly
+///
+/// The lookup indexes are rebuilt on the next lookup, because records may
+/// be inserted or erased through the returned reference. Records should not
+/// be erased through the reference after later lookups, unless the same
+/// number of records are also inserted.
+std::set<SupercellRecord> &SupercellSet::data() {
+  m_index_is_valid = false;
+  m_canonical_supercell.clear();
+  return m_data;
+}
 
 std::set<SupercellRecord> const &SupercellSet::data() const { return m_data; }
 
+SupercellSet::matrix_key_type SupercellSet::_matrix_key(
+    Eigen::Matrix3l const &transformation_matrix_to_super) {
+  matrix_key_type key;
+  Eigen::Matrix3l const &T = transformation_matrix_to_super;
+  std::copy(T.data(), T.data() + key.size(), key.begin());
+  return key;
+}
+
+/// \brief Return the transformation matrix of the canonical equivalent
+///     supercell, remembered by canonical HNF
+///
+/// The canonical supercell is chosen by lattice comparison, as by
+/// `make_canonical_form`, so that canonical supercell names do not depend on
+/// the memo. The lattice comparison is only made for the first supercell of
+/// each class of equivalent supercells.
+Eigen::Matrix3l const &SupercellSet::_canonical_transformation_matrix_to_super(
+    Eigen::Matrix3l const &transformation_matrix_to_super) {
+  matrix_key_type key = _matrix_key(
+      make_canonical_hnf(transformation_matrix_to_super, m_frac_point_group));
+  auto it = m_canonical_matrix_by_hnf.find(key);
+  if (it == m_canonical_matrix_by_hnf.end()) {
+    Lattice superlattice = make_superlattice(m_prim->basicstructure->lattice(),
+                                             transformation_matrix_to_super);
+    it = m_canonical_matrix_by_hnf
+             .emplace(key, make_canonical_transformation_matrix_to_super(
+                               superlattice, m_prim))
+             .first;
+  }
+  return it->second;
+}
+
+/// \brief Add a newly inserted record to the lookup indexes
+std::pair<SupercellSet::iterator, bool> SupercellSet::_insert_and_index(
+    std::pair<iterator, bool> result) {
+  if (result.second && m_index_is_valid) {
+    _add_to_index(result.first);
+  }
+  return result;
+}
+
+void SupercellSet::_add_to_index(const_iterator it) const {
+  m_index_by_matrix.emplace(
+      _matrix_key(it->supercell->superlattice.transformation_matrix_to_super()),
+      it);
+  if (it->is_canonical) {
+    m_index_by_canonical_name.emplace(it->supercell_name, it);
+  }
+}
+
+/// \brief Rebuild the lookup indexes, if `data()` was accessed directly or
+///     the number of records no longer matches
+void SupercellSet::_validate_index() const {
+  if (m_index_is_valid && m_index_by_matrix.size() == m_data.size()) {
+    return;
+  }
+  m_index_by_matrix.clear();
+  m_index_by_canonical_name.clear();
+  for (auto it = m_data.begin(); it != m_data.end(); ++it) {
+    _add_to_index(it);
+  }
+  m_index_is_valid = true;
+}
+
 std::map<std::string, SupercellRecord const *>
 make_index_by_canonical_supercell_name(
     std::set<SupercellRecord> const &supercells) {
@@ -232,10 +461,8 @@ SupercellRecord const *find_or_add_canonical_supercell_by_name(
   SupercellRecord const *s = nullptr;
   auto it = index_by_supercell_name.find(supercell_name);
   if (it == index_by_supercell_name.end()) {
-    auto supercell = std::make_shared<Supercell const>(
-        prim, make_superlattice_from_supercell_name(
-                  prim->basicstructure->lattice(), supercell_name));
-    auto canonical_supercell = make_canonical_form(*supercell);
+    auto canonical_supercell =
+        make_shared_canonical_supercell_by_name(supercell_name, prim);
     s = &*supercells.insert(canonical_supercell).first;
     if (supercell_name != s->supercell_name) {
       throw std::runtime_error(
@@ -1,13 +1,256 @@
 #include "casm/configuration/SupercellSymInfo.hh"
 
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+
 #include "casm/configuration/Prim.hh"
+#include "casm/configuration/instrumentation.hh"
+#include "casm/configuration/memory_usage.hh"
+#include "casm/configuration/parallel.hh"
 #include "casm/crystallography/LinearIndexConverter.hh"
 #include "casm/crystallography/Superlattice.hh"
+#include "casm/crystallography/SymType.hh"
 #include "casm/crystallography/UnitCellCoordRep.hh"
 
 namespace CASM {
 namespace config {
 
+namespace {
+
+/// \brief Return an upper triangular matrix, with positive diagonal, whose
+///     columns generate the same lattice as the columns of T
+Eigen::Matrix3l make_upper_triangular_column_basis(Eigen::Matrix3l T) {
+  // uses only unimodular column operations (Euclid on each row)
+  for (int r = 2; r >= 0; --r) {
+    for (int c = 0; c < r; ++c) {
+      while (T(r, c) != 0) {
+        long q = T(r, r) / T(r, c);
+        T.col(r) -= q * T.col(c);
+        T.col(r).swap(T.col(c));
+      }
+    }
+    if (T(r, r) < 0) {
+      T.col(r) *= -1;
+    }
+  }
+  if (T(0, 0) == 0 || T(1, 1) == 0 || T(2, 2) == 0) {
+    throw std::runtime_error(
+        "Error in SupercellTranslationTable: singular transformation matrix");
+  }
+  return T;
+}
+
+/// \brief Process-wide cache of CombinedPermutationTable, by SupercellSymInfo
+struct CombinedPermutationTableCache {
+  typedef std::pair<SupercellSymInfo const *,
+                    std::shared_ptr<CombinedPermutationTable const>>
+      value_type;
+
+  std::mutex mutex;
+
+  /// Tables larger than this are not constructed
+  Index max_table_bytes = Index(1) << 24;
+
+  /// Least recently used tables are evicted if the total is larger than this
+  Index max_total_bytes = Index(1) << 28;
+
+  Index total_bytes = 0;
+
+  /// Most recently used first
+  std::list<value_type> lru;
+
+  std::unordered_map<SupercellSymInfo const *, std::list<value_type>::iterator>
+      index;
+
+  /// \brief Evict least recently used tables, other than the most recently
+  ///     used, until total_bytes <= max_total_bytes; requires lock
+  void evict() {
+    while (total_bytes > max_total_bytes && lru.size() > 1) {
+      total_bytes -= lru.back().second->memory_bytes();
+      index.erase(lru.back().first);
+      lru.pop_back();
+    }
+  }
+};
+
+/// \brief Return the process-wide cache
+///
+/// Never destroyed, so that SupercellSymInfo may be destroyed during static
+/// destruction.
+CombinedPermutationTableCache &combined_permutation_table_cache() {
+  static CombinedPermutationTableCache *cache =
+      new CombinedPermutationTableCache();
+  return *cache;
+}
+
+/// \brief Total of `memory_bytes()` for all existing SupercellSymInfo
+///
+/// Never destroyed, so that SupercellSymInfo may be destroyed during static
+/// destruction.
+std::atomic<Index> &sym_info_total_bytes() {
+  static std::atomic<Index> *total = new std::atomic<Index>(0);
+  return *total;
+}
+
+/// \brief Return true if translation permutations should be stored, which
+///     requires that the supercell is small enough and that the memory
+///     budget allows it
+bool store_translation_permutations(Index n_unitcells, Index n_sites,
+                                    Index max_n_translation_permutations) {
+  if (n_unitcells > max_n_translation_permutations) {
+    return false;
+  }
+  Index bytes = n_unitcells * n_sites *
+                sym_info::PermutationTable::entry_bytes(n_sites);
+  return memory_budget_allows(bytes);
+}
+
+/// \brief Number of threads used to construct the permutation tables of a
+///     supercell with `n_sites` sites
+///
+/// Small supercells, which are constructed in large numbers during
+/// enumeration, are constructed on the calling thread to avoid thread pool
+/// overhead.
+Index permutation_n_threads(Index n_sites) {
+  return n_sites >= 4096 ? 0 : 1;
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param transformation_matrix_to_super Integer transformation matrix, T,
+///     such that S = L * T, where S and L are the supercell and prim lattice
+///     vectors, as columns of a matrix
+/// \param unitcell_index_converter UnitCell and linear unit cell index
+///     conversions in this supercell.
+/// \param unitcellcoord_index_converter UnitCellCoord and linear site index
+///     conversions in this supercell.
+SupercellTranslationTable::SupercellTranslationTable(
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    xtal::UnitCellIndexConverter const &unitcell_index_converter,
+    xtal::UnitCellCoordIndexConverter const &unitcellcoord_index_converter)
+    : m_n_unitcells(unitcell_index_converter.total_sites()) {
+  Eigen::Matrix3l H =
+      make_upper_triangular_column_basis(transformation_matrix_to_super);
+  m_hnf[0] = H(0, 0);
+  m_hnf[1] = H(0, 1);
+  m_hnf[2] = H(0, 2);
+  m_hnf[3] = H(1, 1);
+  m_hnf[4] = H(1, 2);
+  m_hnf[5] = H(2, 2);
+
+  if (H(0, 0) * H(1, 1) * H(2, 2) != m_n_unitcells) {
+    throw std::runtime_error(
+        "Error in SupercellTranslationTable: volume mismatch");
+  }
+
+  m_unitcell_box.resize(3 * m_n_unitcells);
+  m_box_to_unitcell.assign(m_n_unitcells, -1);
+  for (Index n = 0; n < m_n_unitcells; ++n) {
+    UnitCell uc = unitcell_index_converter(n);
+    std::int32_t key = _box_key(uc(0), uc(1), uc(2));
+    if (m_box_to_unitcell[key] != -1) {
+      throw std::runtime_error(
+          "Error in SupercellTranslationTable: unit cell reduction failed");
+    }
+    m_box_to_unitcell[key] = n;
+    // stored coordinates are the reduced coordinates
+    std::int32_t i = key % m_hnf[0];
+    std::int32_t j = (key / m_hnf[0]) % m_hnf[3];
+    std::int32_t k = key / (m_hnf[0] * m_hnf[3]);
+    m_unitcell_box[3 * n] = i;
+    m_unitcell_box[3 * n + 1] = j;
+    m_unitcell_box[3 * n + 2] = k;
+  }
+
+  Index n_sites = unitcellcoord_index_converter.total_sites();
+  m_site_unitcell.resize(n_sites);
+  m_site_sublattice.resize(n_sites);
+  m_sublattice_site_index.resize(n_sites);
+  for (Index l = 0; l < n_sites; ++l) {
+    UnitCellCoord const &ucc = unitcellcoord_index_converter(l);
+    Index n = unitcell_index_converter(ucc.unitcell());
+    m_site_unitcell[l] = n;
+    m_site_sublattice[l] = ucc.sublattice();
+    m_sublattice_site_index[ucc.sublattice() * m_n_unitcells + n] = l;
+  }
+}
+
+/// \brief Constructor
+///
+/// \param _ranges Active sites, as ranges of linear site index,
+///     `[begin, end)`, sorted and non-overlapping, such as from
+///     `make_active_site_ranges`
+/// \param _n_sites The number of sites in the supercell
+SupercellActiveSites::SupercellActiveSites(
+    std::vector<std::pair<Index, Index>> const &_ranges, Index _n_sites)
+    : n_sites(_n_sites),
+      n_active_sites(0),
+      ranges(_ranges),
+      active_index(_n_sites, -1) {
+  for (auto const &range : ranges) {
+    for (Index i = range.first; i < range.second; ++i) {
+      active_index[i] = n_active_sites++;
+    }
+  }
+  all_active = (n_active_sites == n_sites);
+}
+
+/// \brief Constructor
+///
+/// \param factor_group The supercell factor group
+/// \param prim_lattice The prim lattice
+SupercellFactorGroupAction::SupercellFactorGroupAction(
+    SymGroup const &factor_group, Lattice const &prim_lattice) {
+  Eigen::Matrix3d const &L = prim_lattice.lat_column_mat();
+  Eigen::Matrix3d L_inv = L.inverse();
+  auto to_frac = [&](Eigen::Vector3d const &cart) -> Eigen::Vector3l {
+    return (L_inv * cart).array().round().cast<long>();
+  };
+
+  Index n_fg = factor_group.element.size();
+  for (Index f = 0; f < n_fg; ++f) {
+    Eigen::Matrix3d const &R = factor_group.element[f].matrix;
+    frac_matrix.push_back((L_inv * R * L).array().round().cast<long>());
+  }
+
+  product_translation.resize(n_fg);
+  for (Index f1 = 0; f1 < n_fg; ++f1) {
+    SymOp const &op1 = factor_group.element[f1];
+    for (Index f2 = 0; f2 < n_fg; ++f2) {
+      SymOp const &op2 = factor_group.element[f2];
+      SymOp const &op3 =
+          factor_group.element[factor_group.multiplication_table[f1][f2]];
+      product_translation[f1].push_back(to_frac(
+          op1.matrix * op2.translation + op1.translation - op3.translation));
+    }
+  }
+
+  for (Index f = 0; f < n_fg; ++f) {
+    SymOp const &op = factor_group.element[f];
+    SymOp const &inverse_op =
+        factor_group.element[factor_group.inverse_index[f]];
+    inverse_translation.push_back(to_frac(
+        -(op.matrix.transpose() * op.translation) - inverse_op.translation));
+  }
+}
+
+/// \brief Write translation permutation into `perm`, re-using its capacity
+void SupercellTranslationTable::make_permutation(
+    Index translation_index, sym_info::Permutation &perm) const {
+  CASM_CONFIG_COUNT(permutations_built);
+  CASM_CONFIG_SCOPED_TIMER(translation_permute);
+  Index n_sites = m_site_unitcell.size();
+  perm.resize(n_sites);
+  for (Index i = 0; i < n_sites; ++i) {
+    perm[i] = permute_index(translation_index, i);
+  }
+}
+
 /// \brief Constructor
 ///
 /// \brief prim Prim associated with this supercell
@@ -18,7 +261,10 @@ namespace config {
 ///     in this supercell.
 /// \brief max_n_translation_permutations If superlattice.size() is greater than
 ///     max_n_translation_permutations, do not populate
-///     SupercellSymInfo::translation_permutations (default=100).
+///     SupercellSymInfo::translation_permutations (default=100). In that
+///     case, SupercellSymInfo::translation_table is used to evaluate
+///     translation permutations. They are also not populated if storing
+///     them would exceed the memory budget (see `memory_budget_allows`).
 SupercellSymInfo::SupercellSymInfo(
     std::shared_ptr<Prim const> const &prim, Superlattice const &superlattice,
     xtal::UnitCellIndexConverter const &unitcell_index_converter,
@@ -26,16 +272,273 @@ SupercellSymInfo::SupercellSymInfo(
     Index max_n_translation_permutations)
     : factor_group(std::make_shared<SymGroup const>(
           make_factor_group(prim, superlattice))),
+      translation_table(superlattice.transformation_matrix_to_super(),
+                        unitcell_index_converter,
+                        unitcellcoord_index_converter),
       factor_group_permutations(make_factor_group_permutations(
           factor_group->head_group_index,
+          prim->sym_info.unitcellcoord_symgroup_rep, translation_table,
+          permutation_n_threads(unitcellcoord_index_converter.total_sites()))),
+      active_sites(make_active_site_ranges(prim->sym_info, superlattice.size()),
+                   unitcellcoord_index_converter.total_sites()),
+      factor_group_action(*factor_group, prim->basicstructure->lattice()) {
+  if (store_translation_permutations(
+          superlattice.size(), unitcellcoord_index_converter.total_sites(),
+          max_n_translation_permutations)) {
+    translation_permutations.emplace(make_translation_permutations(
+        translation_table,
+        permutation_n_threads(unitcellcoord_index_converter.total_sites())));
+  }
+  sym_info_total_bytes() += memory_bytes();
+}
+
+/// \brief Constructor, conjugating the factor group permutations of an
+///     equivalent supercell
+///
+/// Equivalent to the other constructor, but factor group permutations are
+/// made from those of `equivalent_sym_info` by relabeling sites (see
+/// `make_equivalent_factor_group_permutations`), which avoids transforming
+/// and re-indexing every site for every factor group operation. This is
+/// used to share the work of constructing symmetry info between equivalent
+/// supercells.
+///
+/// \param prim, superlattice, unitcell_index_converter,
+///     unitcellcoord_index_converter, max_n_translation_permutations Same as
+///     for the other constructor
+/// \param equivalent_sym_info Symmetry info of an equivalent supercell
+/// \param equivalent_unitcellcoord_index_converter UnitCellCoord and linear
+///     site index conversions in the equivalent supercell
+/// \param prim_factor_group_index Index of a prim factor group operation
+///     that transforms the equivalent supercell lattice to `superlattice`
+SupercellSymInfo::SupercellSymInfo(
+    std::shared_ptr<Prim const> const &prim, Superlattice const &superlattice,
+    xtal::UnitCellIndexConverter const &unitcell_index_converter,
+    xtal::UnitCellCoordIndexConverter const &unitcellcoord_index_converter,
+    Index max_n_translation_permutations,
+    SupercellSymInfo const &equivalent_sym_info,
+    xtal::UnitCellCoordIndexConverter const
+        &equivalent_unitcellcoord_index_converter,
+    Index prim_factor_group_index)
+    : factor_group(std::make_shared<SymGroup const>(
+          make_factor_group(prim, superlattice))),
+      translation_table(superlattice.transformation_matrix_to_super(),
+                        unitcell_index_converter,
+                        unitcellcoord_index_converter),
+      factor_group_permutations(make_equivalent_factor_group_permutations(
+          factor_group->head_group_index, prim_factor_group_index,
+          equivalent_sym_info.factor_group->head_group_index,
+          equivalent_sym_info.factor_group_permutations,
+          *prim->sym_info.factor_group,
           prim->sym_info.unitcellcoord_symgroup_rep,
-          unitcellcoord_index_converter)) {
-  if (superlattice.size() <= max_n_translation_permutations) {
-    translation_permutations = make_translation_permutations(
-        unitcell_index_converter, unitcellcoord_index_converter);
+          equivalent_unitcellcoord_index_converter, unitcell_index_converter,
+          unitcellcoord_index_converter, translation_table,
+          permutation_n_threads(unitcellcoord_index_converter.total_sites()))),
+      active_sites(make_active_site_ranges(prim->sym_info, superlattice.size()),
+                   unitcellcoord_index_converter.total_sites()),
+      factor_group_action(*factor_group, prim->basicstructure->lattice()) {
+  if (store_translation_permutations(
+          superlattice.size(), unitcellcoord_index_converter.total_sites(),
+          max_n_translation_permutations)) {
+    translation_permutations.emplace(make_translation_permutations(
+        translation_table,
+        permutation_n_threads(unitcellcoord_index_converter.total_sites())));
+  }
+  sym_info_total_bytes() += memory_bytes();
+}
+
+/// \brief Copy constructor, copying all tables
+///
+/// The factor group is shared. All permutation tables are copied, on the
+/// calling thread, and the combined permutation table is not (see
+/// `Supercell::numa_replica`).
+SupercellSymInfo::SupercellSymInfo(SupercellSymInfo const &other)
+    : factor_group(other.factor_group),
+      translation_permutations(other.translation_permutations),
+      translation_table(other.translation_table),
+      factor_group_permutations(other.factor_group_permutations),
+      active_sites(other.active_sites),
+      factor_group_action(other.factor_group_action) {
+  sym_info_total_bytes() += memory_bytes();
+}
+
+SupercellSymInfo::~SupercellSymInfo() {
+  sym_info_total_bytes() -= memory_bytes();
+  CombinedPermutationTableCache &cache = combined_permutation_table_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto it = cache.index.find(this);
+  if (it != cache.index.end()) {
+    cache.total_bytes -= it->second->second->memory_bytes();
+    cache.lru.erase(it->second);
+    cache.index.erase(it);
+  }
+}
+
+/// \brief Return the combined permutation table for all supercell
+///     operations, or nullptr if it is larger than allowed
+///
+/// The table is constructed on first use and shared through a process-wide
+/// least recently used cache (see CombinedPermutationTable). Returns
+/// nullptr if the table would be larger than
+/// `combined_permutation_table_max_bytes()`. Thread safe.
+///
+/// Callers should hold the result for the duration of a loop over
+/// operations, rather than calling this for each operation.
+std::shared_ptr<CombinedPermutationTable const>
+SupercellSymInfo::combined_permutation_table() const {
+  CombinedPermutationTableCache &cache = combined_permutation_table_cache();
+  Index n_ops =
+      factor_group_permutations.size() * translation_table.n_translations();
+  Index bytes = n_ops * active_sites.n_active_sites *
+                sym_info::PermutationTable::entry_bytes(
+                    translation_table.n_sites());
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (bytes > cache.max_table_bytes) {
+      return nullptr;
+    }
+    auto it = cache.index.find(this);
+    if (it != cache.index.end()) {
+      cache.lru.splice(cache.lru.begin(), cache.lru, it->second);
+      return it->second->second;
+    }
+  }
+
+  // construct without holding the lock
+  auto table = std::make_shared<CombinedPermutationTable const>(*this);
+
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.index.find(this);
+    if (it != cache.index.end()) {
+      cache.lru.splice(cache.lru.begin(), cache.lru, it->second);
+      return it->second->second;
+    }
+    cache.lru.emplace_front(this, table);
+    cache.index.emplace(this, cache.lru.begin());
+    cache.total_bytes += table->memory_bytes();
+    cache.evict();
+  }
+  enforce_memory_budget();
+  return table;
+}
+
+/// \brief Memory used by the symmetry tables, in bytes (approximate)
+///
+/// Includes the factor group, the factor group and translation
+/// permutations, the translation table, the active sites, and the factor
+/// group action. Does not include the combined permutation table, which is
+/// counted by `combined_permutation_table_total_bytes()`.
+Index SupercellSymInfo::memory_bytes() const {
+  Index n_fg = factor_group->element.size();
+  Index bytes = sizeof(SupercellSymInfo) + config::memory_bytes(*factor_group);
+  if (translation_permutations.has_value()) {
+    bytes += translation_permutations->memory_bytes();
+  }
+  bytes += translation_table.memory_bytes();
+  bytes += factor_group_permutations.memory_bytes();
+  bytes += active_sites.ranges.size() * sizeof(std::pair<Index, Index>) +
+           active_sites.active_index.size() * sizeof(std::int32_t);
+  bytes += n_fg * (sizeof(Eigen::Matrix3l) + sizeof(Eigen::Vector3l) +
+                   sizeof(std::vector<Eigen::Vector3l>) +
+                   n_fg * sizeof(Eigen::Vector3l));
+  return bytes;
+}
+
+/// \brief Constructor
+CombinedPermutationTable::CombinedPermutationTable(
+    SupercellSymInfo const &sym_info)
+    : m_n_ops(sym_info.factor_group_permutations.size() *
+              sym_info.translation_table.n_translations()),
+      m_n_translations(sym_info.translation_table.n_translations()),
+      m_n_sites(sym_info.translation_table.n_sites()),
+      m_n_active_sites(sym_info.active_sites.n_active_sites),
+      m_active_index(sym_info.active_sites.active_index),
+      m_data(m_n_ops, m_n_active_sites, m_n_sites) {
+  auto const &ranges = sym_info.active_sites.ranges;
+  Index n_fg = sym_info.factor_group_permutations.size();
+  sym_info::Permutation trans_perm;
+  for (Index t = 0; t < m_n_translations; ++t) {
+    if (sym_info.translation_permutations.has_value()) {
+      sym_info.translation_permutations->copy_permutation(t, trans_perm);
+    } else {
+      sym_info.translation_table.make_permutation(t, trans_perm);
+    }
+    for (Index f = 0; f < n_fg; ++f) {
+      sym_info.factor_group_permutations.visit(f, [&](auto const *fg_perm) {
+        m_data.visit_mutable(f * m_n_translations + t, [&](auto *row) {
+          for (auto const &range : ranges) {
+            for (Index i = range.first; i < range.second; ++i) {
+              *row++ = fg_perm[trans_perm[i]];
+            }
+          }
+        });
+      });
+    }
+  }
+}
+
+/// \brief Set size limits for cached combined permutation tables
+///
+/// \param max_table_bytes Combined permutation tables larger than this, in
+///     bytes, are not constructed (default=2^24, 16 MiB)
+/// \param max_total_bytes If the total size of cached tables is larger than
+///     this, in bytes, least recently used tables are evicted from the cache
+///     (default=2^28, 256 MiB)
+void set_combined_permutation_table_limits(Index max_table_bytes,
+                                           Index max_total_bytes) {
+  CombinedPermutationTableCache &cache = combined_permutation_table_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.max_table_bytes = max_table_bytes;
+  cache.max_total_bytes = max_total_bytes;
+  cache.evict();
+}
+
+/// \brief Maximum size of a single combined permutation table, in bytes
+Index combined_permutation_table_max_bytes() {
+  CombinedPermutationTableCache &cache = combined_permutation_table_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  return cache.max_table_bytes;
+}
+
+/// \brief Maximum total size of cached combined permutation tables, in bytes
+Index combined_permutation_table_max_total_bytes() {
+  CombinedPermutationTableCache &cache = combined_permutation_table_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  return cache.max_total_bytes;
+}
+
+/// \brief Total size of cached combined permutation tables, in bytes
+Index combined_permutation_table_total_bytes() {
+  CombinedPermutationTableCache &cache = combined_permutation_table_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  return cache.total_bytes;
+}
+
+/// \brief Evict least recently used combined permutation tables until
+///     their total size is at most `max_total_bytes`
+///
+/// Limits are not changed. Evicted tables stay valid for as long as a
+/// `std::shared_ptr` to them is held.
+///
+/// \returns The total size of the evicted tables, in bytes
+Index evict_combined_permutation_tables(Index max_total_bytes) {
+  CombinedPermutationTableCache &cache = combined_permutation_table_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  Index initial_total_bytes = cache.total_bytes;
+  while (cache.total_bytes > max_total_bytes && !cache.lru.empty()) {
+    cache.total_bytes -= cache.lru.back().second->memory_bytes();
+    cache.index.erase(cache.lru.back().first);
+    cache.lru.pop_back();
   }
+  return initial_total_bytes - cache.total_bytes;
 }
 
+/// \brief Total memory used by all existing SupercellSymInfo, in bytes
+///
+/// The total of `SupercellSymInfo::memory_bytes()`, updated on construction
+/// and destruction.
+Index supercell_sym_info_total_bytes() { return sym_info_total_bytes(); }
+
 /// \brief Construct supercell factor group
 SymGroup make_factor_group(std::shared_ptr<Prim const> const &prim,
                            Superlattice const &superlattice) {
@@ -97,12 +600,46 @@ std::vector<sym_info::Permutation> make_translation_permutations(
   // Loops over lattice points
   for (Index translation_ix = 0;
        translation_ix < ijk_index_converter.total_sites(); ++translation_ix) {
+    CASM_CONFIG_COUNT(permutations_built);
     translation_permutations.push_back(make_translation_permutation(
         translation_ix, ijk_index_converter, bijk_index_converter));
   }
   return translation_permutations;
 }
 
+/// \brief Construct supercell translation permutations, from a
+///     SupercellTranslationTable, using multiple threads
+///
+/// Equal to `make_translation_permutations(ijk_index_converter,
+/// bijk_index_converter)`, but evaluated with
+/// `SupercellTranslationTable::permute_index`, which uses integer arithmetic
+/// on HNF box coordinates instead of UnitCellCoord conversions, and stored
+/// directly in a PermutationTable.
+///
+/// \param translation_table Translation table for this supercell
+/// \param n_threads Number of threads. Translations are split between
+///     threads. If <= 0, uses `resolve_n_threads(n_threads)`.
+sym_info::PermutationTable make_translation_permutations(
+    SupercellTranslationTable const &translation_table, Index n_threads) {
+  Index n_translations = translation_table.n_translations();
+  Index n_sites = translation_table.n_sites();
+  sym_info::PermutationTable translation_permutations(n_translations, n_sites,
+                                                      n_sites);
+  parallel_for_chunks(
+      n_translations, n_threads, [&](Index c, Index begin, Index end) {
+        for (Index t = begin; t < end; ++t) {
+          CASM_CONFIG_COUNT(permutations_built);
+          translation_permutations.visit_mutable(t, [&](auto *perm) {
+            using Entry = std::remove_pointer_t<decltype(perm)>;
+            for (Index i = 0; i < n_sites; ++i) {
+              perm[i] = Entry(translation_table.permute_index(t, i));
+            }
+          });
+        }
+      });
+  return translation_permutations;
+}
+
 /// \brief Construct supercell factor group permutations
 ///
 /// These permutations describe how the prim factor group operations that are
@@ -136,5 +673,190 @@ std::vector<sym_info::Permutation> make_factor_group_permutations(
   return factor_group_permutations;
 }
 
+/// \brief Construct supercell factor group permutations, using integer
+///     arithmetic on HNF box coordinates and multiple threads
+///
+/// Equal to `make_factor_group_permutations(head_group_index,
+/// unitcellcoord_symgroup_rep, bijk_index_converter)`, but avoids converting
+/// between linear site indices and UnitCellCoord for every operation and
+/// site:
+/// - Unit cell coordinates are taken from the translation table, reduced
+///   into the HNF box of the superlattice
+/// - For each operation, the point matrix is applied once per unit cell, in
+///   a single pass over contiguous coordinates, and the result is shared by
+///   all sublattices, which only differ by a constant translation
+/// - Transformed coordinates are reduced into the HNF box and looked up with
+///   `SupercellTranslationTable::site_index`. Supercell factor group
+///   operations map superlattice vectors to superlattice vectors, so using
+///   reduced coordinates gives the same sites.
+///
+/// \param head_group_index Indices in prim factor group of the supercell
+///     factor group operations
+/// \param unitcellcoord_symgroup_rep Symmetry representation used to
+///     transform integral site coordinates for this prim.
+/// \param translation_table Translation table for this supercell
+/// \param n_threads Number of threads. Operations are split between
+///     threads. If <= 0, uses `resolve_n_threads(n_threads)`.
+sym_info::PermutationTable make_factor_group_permutations(
+    std::vector<Index> const &head_group_index,
+    sym_info::UnitCellCoordSymGroupRep const &unitcellcoord_symgroup_rep,
+    SupercellTranslationTable const &translation_table, Index n_threads) {
+  Index n_unitcells = translation_table.n_translations();
+  Index n_sites = translation_table.n_sites();
+  Index n_sublat = n_sites / n_unitcells;
+  sym_info::PermutationTable factor_group_permutations(
+      head_group_index.size(), n_sites, n_sites);
+
+  parallel_for_chunks(
+      head_group_index.size(), n_threads,
+      [&](Index c, Index begin, Index end) {
+        std::vector<std::int32_t> point_image(3 * n_unitcells);
+        for (Index f = begin; f < end; ++f) {
+          auto const &rep = unitcellcoord_symgroup_rep[head_group_index[f]];
+          std::int32_t R[9];
+          for (Index i = 0; i < 3; ++i) {
+            for (Index j = 0; j < 3; ++j) {
+              R[3 * i + j] = rep.point_matrix(i, j);
+            }
+          }
+          for (Index n = 0; n < n_unitcells; ++n) {
+            std::int32_t const *u = translation_table.unitcell_coordinates(n);
+            std::int32_t *v = &point_image[3 * n];
+            v[0] = R[0] * u[0] + R[1] * u[1] + R[2] * u[2];
+            v[1] = R[3] * u[0] + R[4] * u[1] + R[5] * u[2];
+            v[2] = R[6] * u[0] + R[7] * u[1] + R[8] * u[2];
+          }
+
+          factor_group_permutations.visit_mutable(f, [&](auto *perm) {
+            using Entry = std::remove_pointer_t<decltype(perm)>;
+            for (Index b = 0; b < n_sublat; ++b) {
+              Index new_b = rep.sublattice_index[b];
+              UnitCell const &tau = rep.unitcell_indices[b];
+              std::int32_t t0 = tau(0), t1 = tau(1), t2 = tau(2);
+              for (Index n = 0; n < n_unitcells; ++n) {
+                std::int32_t const *v = &point_image[3 * n];
+                Index new_l = translation_table.site_index(
+                    new_b, v[0] + t0, v[1] + t1, v[2] + t2);
+                perm[new_l] =
+                    Entry(translation_table.sublattice_site_index(b, n));
+              }
+            }
+          });
+        }
+      });
+  return factor_group_permutations;
+}
+
+/// \brief Construct supercell factor group permutations by conjugating the
+///     factor group permutations of an equivalent supercell
+///
+/// If prim factor group operation `g` transforms the equivalent supercell
+/// lattice to this supercell lattice, then `g` maps equivalent supercell
+/// sites one-to-one onto this supercell's sites. For each operation `k` of
+/// this supercell's factor group, `h = g^-1 * k * g` is in the equivalent
+/// supercell's factor group, and `k * g == t * g * h` for some lattice
+/// translation `t`, which is the same for all sites. So, if
+/// `site_map[l]` is the site that `g` maps equivalent supercell site `l`
+/// onto:
+///
+/// \code
+/// permutation_k[site_map[l] + t] == site_map[permutation_h[l]]
+/// \endcode
+///
+/// This only requires transforming sites by `g`, rather than by every
+/// factor group operation. The result is equal to
+/// `make_factor_group_permutations(head_group_index, ...)`.
+///
+/// \param head_group_index Indices in prim factor group of this supercell's
+///     factor group operations
+/// \param prim_factor_group_index Index of a prim factor group operation
+///     that transforms the equivalent supercell lattice to this supercell
+///     lattice
+/// \param equivalent_head_group_index Indices in prim factor group of the
+///     equivalent supercell's factor group operations
+/// \param equivalent_factor_group_permutations The equivalent supercell's
+///     factor group permutations
+/// \param prim_factor_group The prim factor group
+/// \param unitcellcoord_symgroup_rep Symmetry representation used to
+///     transform integral site coordinates for this prim.
+/// \param equivalent_bijk_index_converter UnitCellCoord and linear site
+///     index conversions in the equivalent supercell
+/// \param ijk_index_converter UnitCell and linear unit cell index
+///     conversions in this supercell
+/// \param bijk_index_converter UnitCellCoord and linear site index
+///     conversions in this supercell
+/// \param translation_table Translation permutations in this supercell
+/// \param n_threads Number of threads. Operations are split between
+///     threads. If <= 0, uses `resolve_n_threads(n_threads)`.
+sym_info::PermutationTable make_equivalent_factor_group_permutations(
+    std::vector<Index> const &head_group_index, Index prim_factor_group_index,
+    std::vector<Index> const &equivalent_head_group_index,
+    sym_info::PermutationTable const &equivalent_factor_group_permutations,
+    SymGroup const &prim_factor_group,
+    sym_info::UnitCellCoordSymGroupRep const &unitcellcoord_symgroup_rep,
+    xtal::UnitCellCoordIndexConverter const &equivalent_bijk_index_converter,
+    xtal::UnitCellIndexConverter const &ijk_index_converter,
+    xtal::UnitCellCoordIndexConverter const &bijk_index_converter,
+    SupercellTranslationTable const &translation_table, Index n_threads) {
+  long total_sites = bijk_index_converter.total_sites();
+  if (equivalent_bijk_index_converter.total_sites() != total_sites ||
+      equivalent_head_group_index.size() != head_group_index.size()) {
+    throw std::runtime_error(
+        "Error in make_equivalent_factor_group_permutations: supercells are "
+        "not equivalent");
+  }
+
+  Index g = prim_factor_group_index;
+  auto const &g_rep = unitcellcoord_symgroup_rep[g];
+  std::vector<Index> site_map(total_sites);
+  for (Index l = 0; l < total_sites; ++l) {
+    site_map[l] = bijk_index_converter(
+        copy_apply(g_rep, equivalent_bijk_index_converter(l)));
+  }
+
+  std::vector<Index> equivalent_factor_group_index(
+      prim_factor_group.element.size(), -1);
+  for (Index i = 0; i < equivalent_head_group_index.size(); ++i) {
+    equivalent_factor_group_index[equivalent_head_group_index[i]] = i;
+  }
+
+  UnitCellCoord const &ucc = equivalent_bijk_index_converter(0);
+  UnitCellCoord g_ucc = copy_apply(g_rep, ucc);
+  Index g_inv = prim_factor_group.inv(g);
+
+  sym_info::PermutationTable factor_group_permutations(
+      head_group_index.size(), total_sites, total_sites);
+  parallel_for_chunks(
+      head_group_index.size(), n_threads,
+      [&](Index c, Index begin, Index end) {
+        for (Index f = begin; f < end; ++f) {
+          Index k = head_group_index[f];
+          Index h = prim_factor_group.mult(g_inv, prim_factor_group.mult(k, g));
+          Index equivalent_index = equivalent_factor_group_index[h];
+          if (equivalent_index == -1) {
+            throw std::runtime_error(
+                "Error in make_equivalent_factor_group_permutations: "
+                "supercells are not related by prim_factor_group_index");
+          }
+          sym_info::PermutationTable::Row equivalent_permutation =
+              equivalent_factor_group_permutations[equivalent_index];
+
+          // translation_table.permute_index(minus_t_index, l) is site l + t
+          UnitCell minus_t =
+              copy_apply(g_rep, copy_apply(unitcellcoord_symgroup_rep[h], ucc))
+                  .unitcell() -
+              copy_apply(unitcellcoord_symgroup_rep[k], g_ucc).unitcell();
+          Index minus_t_index = ijk_index_converter(minus_t);
+
+          for (Index l = 0; l < total_sites; ++l) {
+            factor_group_permutations.set(
+                f, translation_table.permute_index(minus_t_index, site_map[l]),
+                site_map[equivalent_permutation[l]]);
+          }
+        }
+      });
+  return factor_group_permutations;
+}
+
 }  // namespace config
 }  // namespace CASM
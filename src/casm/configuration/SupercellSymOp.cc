@@ -1,11 +1,15 @@
 #include "casm/configuration/SupercellSymOp.hh"
 
+#include <algorithm>
+
 #include "casm/clexulator/ConfigDoFValues.hh"
 #include "casm/clexulator/ConfigDoFValuesTools_impl.hh"
 #include "casm/clexulator/DoFSpace.hh"
+#include "casm/configuration/MatrixRepCache.hh"
 #include "casm/configuration/PrimSymInfo.hh"
 #include "casm/configuration/Supercell.hh"
 #include "casm/configuration/SupercellSymInfo.hh"
+#include "casm/configuration/instrumentation.hh"
 #include "casm/configuration/sym_info/definitions.hh"
 #include "casm/crystallography/SymType.hh"
 #include "casm/crystallography/SymTypeComparator.hh"
@@ -18,8 +22,7 @@ namespace config {
 /// Default invalid SupercellSymOp, not equal to end iterator
 SupercellSymOp::SupercellSymOp()
     : m_supercell_factor_group_index(),
-      m_translation_index(),
-      m_tmp_translation_index(-1) {}
+      m_translation_index() {}
 
 /// Construct SupercellSymOp
 ///
@@ -34,8 +37,7 @@ SupercellSymOp::SupercellSymOp(
     : m_supercell(_supercell),
       m_supercell_factor_group_index(_supercell_factor_group_index),
       m_translation_index(_translation_index),
-      m_N_translation(m_supercell->superlattice.size()),
-      m_tmp_translation_index(-1) {}
+      m_N_translation(m_supercell->superlattice.size()) {}
 
 /// Construct SupercellSymOp
 ///
@@ -63,6 +65,23 @@ SupercellSymOp::SupercellSymOp(
           UnitCell::from_cartesian(_translation_cart,
                                    _supercell->superlattice.prim_lattice())) {}
 
+/// Construct SupercellSymOp from a SupercellSymOpHandle
+///
+/// \param _supercell Supercell, must be the supercell referred to by
+///     `_handle`
+/// \param _handle Specifies the operation
+SupercellSymOp::SupercellSymOp(
+    std::shared_ptr<Supercell const> const &_supercell,
+    SupercellSymOpHandle const &_handle)
+    : SupercellSymOp(_supercell, _handle.supercell_factor_group_index(),
+                     _handle.translation_index()) {
+  if (_handle.supercell() != _supercell.get()) {
+    throw std::runtime_error(
+        "Error constructing SupercellSymOp from SupercellSymOpHandle: "
+        "supercell mismatch");
+  }
+}
+
 /// \brief Make supercell symop begin iterator
 SupercellSymOp SupercellSymOp::begin(
     std::shared_ptr<Supercell const> const &_supercell) {
@@ -73,7 +92,7 @@ SupercellSymOp SupercellSymOp::begin(
 SupercellSymOp SupercellSymOp::end(
     std::shared_ptr<Supercell const> const &_supercell) {
   return SupercellSymOp(
-      _supercell, _supercell->sym_info.factor_group_permutations.size(), 0);
+      _supercell, _supercell->sym_info().factor_group_permutations.size(), 0);
 }
 
 /// \brief Make translations supercell symop begin iterator
@@ -95,8 +114,8 @@ std::shared_ptr<Supercell const> const &SupercellSymOp::supercell() const {
 /// \brief Supercell factor group index
 ///
 /// This is an index into:
-/// - supercell()->sym_info.factor_group->element
-/// - supercell()->sym_info.factor_group_permutations
+/// - supercell()->sym_info().factor_group->element
+/// - supercell()->sym_info().factor_group_permutations
 Index SupercellSymOp::supercell_factor_group_index() const {
   return m_supercell_factor_group_index;
 }
@@ -106,7 +125,7 @@ Index SupercellSymOp::supercell_factor_group_index() const {
 /// This is an index into:
 /// - supercell()->prim->sym_info.factor_group->element
 Index SupercellSymOp::prim_factor_group_index() const {
-  return m_supercell->sym_info.factor_group
+  return m_supercell->sym_info().factor_group
       ->head_group_index[m_supercell_factor_group_index];
 }
 
@@ -124,12 +143,33 @@ xtal::UnitCell SupercellSymOp::translation_frac() const {
 ///
 /// Permutation of configuration site dof values occurs according to:
 ///     after[i] = before[permute_index(i)]
+///
+/// If translation permutations are not stored (large supercells), this uses
+/// `SupercellSymInfo::translation_table`, which is O(1) and does not
+/// allocate.
 Index SupercellSymOp::permute_index(Index i) const {
-  SupercellSymInfo const &sym_info = m_supercell->sym_info;
-  auto const &fg_perm =
-      sym_info.factor_group_permutations[m_supercell_factor_group_index];
-  auto const &trans_perm = this->translation_permute();
-  return fg_perm[trans_perm[i]];
+  SupercellSymInfo const &sym_info = m_supercell->sym_info();
+  auto const &fg_perm = sym_info.factor_group_permutations;
+  if (sym_info.translation_permutations.has_value()) {
+    return fg_perm(m_supercell_factor_group_index,
+                   (*sym_info.translation_permutations)(m_translation_index,
+                                                        i));
+  }
+  return fg_perm(
+      m_supercell_factor_group_index,
+      sym_info.translation_table.permute_index(m_translation_index, i));
+}
+
+/// \brief Change to another operation in the same supercell, without
+///     allocating
+///
+/// Allows one SupercellSymOp to be used as a cursor over stored
+/// SupercellSymOpHandle, keeping the temporary translation permutation
+/// buffer, if any, for re-use.
+void SupercellSymOp::reset(Index _supercell_factor_group_index,
+                           Index _translation_index) {
+  m_supercell_factor_group_index = _supercell_factor_group_index;
+  m_translation_index = _translation_index;
 }
 
 /// Returns a reference to this -- allows SupercellSymOp to be treated as an
@@ -184,117 +224,58 @@ SupercellSymOp SupercellSymOp::operator--(int) {
 /// factor group operation, FOLLOWED BY application of the translation
 /// operation;
 SymOp SupercellSymOp::to_symop() const {
-  UnitCell translation_frac =
-      this->m_supercell->unitcell_index_converter(this->m_translation_index);
-
-  Eigen::Matrix3d const &prim_lat_column_mat =
-      this->m_supercell->superlattice.prim_lattice().lat_column_mat();
-
-  Eigen::Vector3d translation_cart =
-      prim_lat_column_mat * translation_frac.cast<double>();
-
-  SymOp const &fg_op = this->m_supercell->sym_info.factor_group
-                           ->element[m_supercell_factor_group_index];
+  return SupercellSymOpHandle(*this).to_symop();
+}
 
-  return SymOp{fg_op.matrix, translation_cart + fg_op.translation,
-               fg_op.is_time_reversal_active};
+/// Returns the translation permutation
+sym_info::Permutation SupercellSymOp::translation_permute() const {
+  sym_info::Permutation permute;
+  translation_permute(permute);
+  return permute;
 }
 
-/// Returns the translation permutation. Reference not valid after increment.
-sym_info::Permutation const &SupercellSymOp::translation_permute() const {
-  if (m_supercell->sym_info.translation_permutations.has_value()) {
-    return (
-        *m_supercell->sym_info.translation_permutations)[m_translation_index];
-  }
-  if (m_tmp_translation_index != m_translation_index) {
-    m_tmp_translation_index = m_translation_index;
-    m_tmp_translation_permute = make_translation_permutation(
-        m_tmp_translation_index, this->m_supercell->unitcell_index_converter,
-        this->m_supercell->unitcellcoord_index_converter);
+/// Set `permute` to the translation permutation, re-using its storage
+///
+/// The permutation is copied from the compact storage in SupercellSymInfo,
+/// or generated from `SupercellSymInfo::translation_table`. The storage is
+/// owned by the caller, so this may be called concurrently on a shared
+/// SupercellSymOp.
+void SupercellSymOp::translation_permute(
+    sym_info::Permutation &permute) const {
+  SupercellSymInfo const &sym_info = m_supercell->sym_info();
+  if (sym_info.translation_permutations.has_value()) {
+    sym_info.translation_permutations->copy_permutation(m_translation_index,
+                                                        permute);
+  } else {
+    sym_info.translation_table.make_permutation(m_translation_index, permute);
   }
-  return m_tmp_translation_permute;
 }
 
 /// Returns the combination of factor group operation permutation and
 /// translation permutation
 sym_info::Permutation SupercellSymOp::combined_permute() const {
-  SupercellSymInfo const &sym_info = m_supercell->sym_info;
-  auto const &fg_permute =
-      sym_info.factor_group_permutations[m_supercell_factor_group_index];
-  auto const &trans_permute = translation_permute();
-  return CASM::sym_info::combined_permute(fg_permute,      // first
-                                          trans_permute);  // second
+  sym_info::Permutation perm;
+  SupercellSymOpHandle(*this).combined_permute(perm);
+  return perm;
 }
 
 /// \brief Returns the inverse supercell operation
 SupercellSymOp SupercellSymOp::inverse() const {
-  // Copy *this, then update m_supercell_factor_group_index and
-  // m_translation_index
   SupercellSymOp inverse_op(*this);
-
-  // Finding the inverse factor_group operation is straightforward
-  SymGroup const &supercell_factor_group =
-      *this->m_supercell->sym_info.factor_group;
-  Index inverse_fg_index =
-      supercell_factor_group
-          .inverse_index[this->m_supercell_factor_group_index];
-  inverse_op.m_supercell_factor_group_index = inverse_fg_index;
-
-  // New translation can be found comparing the translation for the inverse of
-  // the "total sym_op" of *this to the inverse of the untranslated sym_op
-
-  // Find the translation (cartesian coordinates)
-  SymOp const &inverse_sym_op = CASM::config::inverse(this->to_symop());
-  SymOp const &inverse_fg_op = supercell_factor_group.element[inverse_fg_index];
-  Eigen::Vector3d translation_cart =
-      (inverse_sym_op.translation - inverse_fg_op.translation);
-
-  // convert to fractional coordinates
-  Superlattice const &superlattice = this->m_supercell->superlattice;
-  UnitCell translation_uc =
-      UnitCell::from_cartesian(translation_cart, superlattice.prim_lattice());
-
-  // convert to linear index
-  inverse_op.m_translation_index =
-      m_supercell->unitcell_index_converter(translation_uc);
-
+  SupercellSymOpHandle inverse_handle = SupercellSymOpHandle(*this).inverse();
+  inverse_op.reset(inverse_handle.supercell_factor_group_index(),
+                   inverse_handle.translation_index());
   return inverse_op;
 }
 
 /// \brief Returns the supercell operation equivalent to applying first RHS
 /// and then *this
 SupercellSymOp SupercellSymOp::operator*(SupercellSymOp const &RHS) const {
-  // Copy *this, then update m_supercell_factor_group_index and
-  // m_translation_index
   SupercellSymOp product_op(*this);
-
-  // Finding the factor_group product is straightforward
-  SymGroup const &supercell_factor_group =
-      *this->m_supercell->sym_info.factor_group;
-  product_op.m_supercell_factor_group_index =
-      supercell_factor_group
-          .multiplication_table[this->m_supercell_factor_group_index]
-                               [RHS.m_supercell_factor_group_index];
-
-  // New translation can be found comparing the translation for the product of
-  // the "total sym_op" to the just the product factor group op translation
-
-  // Find the translation (cartesian coordinates)
-  SymOp total_product_op = this->to_symop() * RHS.to_symop();
-  SymOp const &product_fg_op =
-      supercell_factor_group.element[product_op.m_supercell_factor_group_index];
-  Eigen::Vector3d translation_cart =
-      total_product_op.translation - product_fg_op.translation;
-
-  // convert to fractional coordinates
-  Superlattice const &superlattice = this->m_supercell->superlattice;
-  UnitCell translation_uc =
-      UnitCell::from_cartesian(translation_cart, superlattice.prim_lattice());
-
-  // convert to linear index
-  product_op.m_translation_index =
-      m_supercell->unitcell_index_converter(translation_uc);
-
+  SupercellSymOpHandle product_handle =
+      SupercellSymOpHandle(*this) * SupercellSymOpHandle(RHS);
+  product_op.reset(product_handle.supercell_factor_group_index(),
+                   product_handle.translation_index());
   return product_op;
 }
 
@@ -319,6 +300,191 @@ bool SupercellSymOp::eq_impl(SupercellSymOp const &RHS) const {
   return false;
 }
 
+/// \brief Prim factor group index
+///
+/// This is an index into:
+/// - supercell()->prim->sym_info.factor_group->element
+Index SupercellSymOpHandle::prim_factor_group_index() const {
+  return m_supercell->sym_info().factor_group
+      ->head_group_index[m_supercell_factor_group_index];
+}
+
+/// \brief Position in the order of iterating over all operations
+///
+/// Equal to `supercell_factor_group_index() * n_translations +
+/// translation_index()`, where `n_translations` is the supercell volume.
+Index SupercellSymOpHandle::op_index() const {
+  return m_supercell_factor_group_index * m_supercell->superlattice.size() +
+         m_translation_index;
+}
+
+/// \brief Returns the index of the site containing the site DoF values that
+///     will be permuted onto site i
+///
+/// Permutation of configuration site dof values occurs according to:
+///     after[i] = before[permute_index(i)]
+Index SupercellSymOpHandle::permute_index(Index i) const {
+  SupercellSymInfo const &sym_info = m_supercell->sym_info();
+  auto const &fg_perm = sym_info.factor_group_permutations;
+  if (sym_info.translation_permutations.has_value()) {
+    return fg_perm(m_supercell_factor_group_index,
+                   (*sym_info.translation_permutations)(m_translation_index,
+                                                        i));
+  }
+  return fg_perm(
+      m_supercell_factor_group_index,
+      sym_info.translation_table.permute_index(m_translation_index, i));
+}
+
+/// \brief Write the combined permutation into `perm`, re-using its capacity
+///
+/// After calling, `perm[i] == permute_index(i)` for all sites. Does not
+/// allocate if `perm` already has sufficient capacity.
+void SupercellSymOpHandle::combined_permute(sym_info::Permutation &perm) const {
+  SupercellSymInfo const &sym_info = m_supercell->sym_info();
+  Index n_sites = sym_info.factor_group_permutations.permutation_size();
+  perm.resize(n_sites);
+  sym_info.factor_group_permutations.visit(
+      m_supercell_factor_group_index, [&](auto const *fg_perm) {
+        if (sym_info.translation_permutations.has_value()) {
+          sym_info.translation_permutations->visit(
+              m_translation_index, [&](auto const *trans_perm) {
+                for (Index i = 0; i < n_sites; ++i) {
+                  perm[i] = fg_perm[trans_perm[i]];
+                }
+              });
+          return;
+        }
+        auto const &table = sym_info.translation_table;
+        for (Index i = 0; i < n_sites; ++i) {
+          perm[i] = fg_perm[table.permute_index(m_translation_index, i)];
+        }
+      });
+}
+
+/// \brief Returns the combined permutation, in a thread-local buffer
+///
+/// The reference is valid until the next call to this function on the same
+/// thread. The buffer is re-used, so after the first call for a supercell
+/// size this does not allocate.
+sym_info::Permutation const &SupercellSymOpHandle::combined_permute() const {
+  static thread_local sym_info::Permutation perm;
+  combined_permute(perm);
+  return perm;
+}
+
+/// \brief Write the combined permutation on active sites into `perm`,
+///     re-using its capacity
+///
+/// After calling, `perm[i] == permute_index(i)` for all active sites (see
+/// `SupercellActiveSites`). Values for other sites are unspecified. If all
+/// sites are active, this is equivalent to `combined_permute(perm)`.
+void SupercellSymOpHandle::active_combined_permute(
+    sym_info::Permutation &perm) const {
+  SupercellSymInfo const &sym_info = m_supercell->sym_info();
+  if (sym_info.active_sites.all_active) {
+    combined_permute(perm);
+    return;
+  }
+  perm.resize(sym_info.factor_group_permutations.permutation_size());
+  sym_info.factor_group_permutations.visit(
+      m_supercell_factor_group_index, [&](auto const *fg_perm) {
+        auto const &table = sym_info.translation_table;
+        for (auto const &range : sym_info.active_sites.ranges) {
+          for (Index i = range.first; i < range.second; ++i) {
+            perm[i] = fg_perm[table.permute_index(m_translation_index, i)];
+          }
+        }
+      });
+}
+
+/// \brief Returns the combined permutation on active sites, in a
+///     thread-local buffer
+///
+/// The reference is valid until the next call to this function on the same
+/// thread. See `active_combined_permute(perm)`.
+sym_info::Permutation const &SupercellSymOpHandle::active_combined_permute()
+    const {
+  static thread_local sym_info::Permutation perm;
+  active_combined_permute(perm);
+  return perm;
+}
+
+/// \brief Return the SymOp for the current operation
+///
+/// Defined by:
+///
+///   translation_op * factor_group_op
+SymOp SupercellSymOpHandle::to_symop() const {
+  UnitCell translation_frac =
+      this->m_supercell->unitcell_index_converter(this->m_translation_index);
+
+  Eigen::Matrix3d const &prim_lat_column_mat =
+      this->m_supercell->superlattice.prim_lattice().lat_column_mat();
+
+  Eigen::Vector3d translation_cart =
+      prim_lat_column_mat * translation_frac.cast<double>();
+
+  SymOp const &fg_op = this->m_supercell->sym_info().factor_group
+                           ->element[m_supercell_factor_group_index];
+
+  return SymOp{fg_op.matrix, translation_cart + fg_op.translation,
+               fg_op.is_time_reversal_active};
+}
+
+/// \brief Returns the inverse supercell operation
+///
+/// Evaluated with integer arithmetic, using
+/// `SupercellSymInfo::factor_group_action`.
+SupercellSymOpHandle SupercellSymOpHandle::inverse() const {
+  SupercellSymInfo const &sym_info = m_supercell->sym_info();
+  SupercellFactorGroupAction const &action = sym_info.factor_group_action;
+  Index inverse_fg_index =
+      sym_info.factor_group->inverse_index[m_supercell_factor_group_index];
+
+  UnitCell const &translation_frac =
+      m_supercell->unitcell_index_converter(m_translation_index);
+  UnitCell translation_uc(
+      action.inverse_translation[m_supercell_factor_group_index] -
+      action.frac_matrix[inverse_fg_index] * translation_frac);
+
+  // convert to linear index
+  return SupercellSymOpHandle(
+      m_supercell, inverse_fg_index,
+      m_supercell->unitcell_index_converter(translation_uc));
+}
+
+/// \brief Returns the supercell operation equivalent to applying first RHS
+/// and then *this
+///
+/// Evaluated with integer arithmetic, using
+/// `SupercellSymInfo::factor_group_action`.
+SupercellSymOpHandle SupercellSymOpHandle::operator*(
+    SupercellSymOpHandle const &RHS) const {
+  SupercellSymInfo const &sym_info = m_supercell->sym_info();
+  SupercellFactorGroupAction const &action = sym_info.factor_group_action;
+  Index product_fg_index =
+      sym_info.factor_group
+          ->multiplication_table[m_supercell_factor_group_index]
+                                [RHS.m_supercell_factor_group_index];
+
+  UnitCell const &lhs_translation_frac =
+      m_supercell->unitcell_index_converter(m_translation_index);
+  UnitCell const &rhs_translation_frac =
+      m_supercell->unitcell_index_converter(RHS.m_translation_index);
+  UnitCell translation_uc(
+      lhs_translation_frac +
+      action.frac_matrix[m_supercell_factor_group_index] *
+          rhs_translation_frac +
+      action.product_translation[m_supercell_factor_group_index]
+                                [RHS.m_supercell_factor_group_index]);
+
+  // convert to linear index
+  return SupercellSymOpHandle(
+      m_supercell, product_fg_index,
+      m_supercell->unitcell_index_converter(translation_uc));
+}
+
 /// \brief Return inverse SymOp
 SymOp inverse(SymOp const &op) {
   // x' = R * x + T
@@ -331,78 +497,331 @@ SymOp inverse(SymOp const &op) {
                op.is_time_reversal_active};
 }
 
+namespace {  // anonymous
+
+/// \brief Return true if `a` and `b` have the same keys
+template <typename MapType>
+bool have_same_keys(MapType const &a, MapType const &b) {
+  return a.size() == b.size() &&
+         std::equal(a.begin(), a.end(), b.begin(),
+                    [](auto const &x, auto const &y) {
+                      return x.first == y.first;
+                    });
+}
+
+/// \brief Make `dest` have the same DoF types and shapes as `source`,
+///     re-using its storage if it already does
+void match_shape(ConfigDoFValues const &source, ConfigDoFValues &dest) {
+  dest.occupation.resize(source.occupation.size());
+  if (!have_same_keys(source.global_dof_values, dest.global_dof_values)) {
+    dest.global_dof_values.clear();
+  }
+  for (auto const &dof : source.global_dof_values) {
+    dest.global_dof_values[dof.first].resize(dof.second.size());
+  }
+  if (!have_same_keys(source.local_dof_values, dest.local_dof_values)) {
+    dest.local_dof_values.clear();
+  }
+  for (auto const &dof : source.local_dof_values) {
+    dest.local_dof_values[dof.first].resize(dof.second.rows(),
+                                            dof.second.cols());
+  }
+}
+
+/// \brief Set `dest(l)` to the occupation `source(perm[l])`, with occupant
+///     indices permuted for anisotropic occupants, for the active sites `l`
+///
+/// Occupation on sites that are not active is copied unchanged.
+void gather_occupation(PrimSymInfo const &prim_sym_info, Index prim_fg_index,
+                       sym_info::Permutation const &perm, Index n_vol,
+                       SupercellActiveSites const &active_sites,
+                       Eigen::VectorXi const &source, Eigen::VectorXi &dest) {
+  if (!active_sites.all_active) {
+    dest = source;
+  }
+  for (auto const &range : active_sites.ranges) {
+    if (prim_sym_info.has_aniso_occs) {
+      // permute occupant indices, by sublattice of the source site
+      std::int32_t const *remap = prim_sym_info.occ_remap(prim_fg_index, 0);
+      Index row_size = prim_sym_info.max_n_occupants;
+      for (Index l = range.first; l < range.second; ++l) {
+        Index l_from = perm[l];
+        dest[l] = remap[(l_from / n_vol) * row_size + source[l_from]];
+      }
+    } else {
+      for (Index l = range.first; l < range.second; ++l) {
+        dest[l] = source[perm[l]];
+      }
+    }
+  }
+}
+
+}  // namespace
+
 /// \brief Apply a symmetry operation specified by a SupercellSymOp to
 /// ConfigDoFValues
+///
+/// Allocates temporary storage on each call. To apply many operations, use
+/// `apply(op, dof_values, workspace)` or `copy_apply(op, source, dest)`.
 ConfigDoFValues &apply(SupercellSymOp const &op, ConfigDoFValues &dof_values) {
+  ConfigDoFValues workspace;
+  return apply(op, dof_values, workspace);
+}
+
+/// \brief Apply a symmetry operation specified by a SupercellSymOp to
+///     ConfigDoFValues, using caller-owned scratch storage
+///
+/// \param op The symmetry operation
+/// \param dof_values The DoF values to transform, in place
+/// \param workspace Scratch storage, which is overwritten. If it is re-used
+///     for DoF values with the same DoF types and shapes, no memory is
+///     allocated.
+///
+/// The transformed values are written into `workspace` by
+/// `copy_apply(op, dof_values, workspace)`, and then the storage of
+/// `dof_values` and `workspace` is swapped.
+ConfigDoFValues &apply(SupercellSymOp const &op, ConfigDoFValues &dof_values,
+                       ConfigDoFValues &workspace) {
+  copy_apply(op, dof_values, workspace);
+  dof_values.occupation.swap(workspace.occupation);
+  dof_values.global_dof_values.swap(workspace.global_dof_values);
+  dof_values.local_dof_values.swap(workspace.local_dof_values);
+  return dof_values;
+}
+
+/// \brief Apply a symmetry operation specified by a SupercellSymOp to
+/// ConfigDoFValues
+ConfigDoFValues copy_apply(SupercellSymOp const &op,
+                           ConfigDoFValues const &dof_values) {
+  ConfigDoFValues result;
+  copy_apply(op, dof_values, result);
+  return result;
+}
+
+/// \brief Write the result of applying a symmetry operation specified by a
+///     SupercellSymOp to ConfigDoFValues into existing ConfigDoFValues
+///
+/// \param op The symmetry operation
+/// \param source The DoF values to transform
+/// \param dest Set to the transformed values. Must not be `source`. If it
+///     already has the same DoF types and shapes as `source`, no memory is
+///     allocated.
+///
+/// \returns A reference to `dest`
+///
+/// Each value in `dest` is gathered from its source site and transformed in
+/// a single pass, without intermediate copies of `source`.
+ConfigDoFValues &copy_apply(SupercellSymOp const &op,
+                            ConfigDoFValues const &source,
+                            ConfigDoFValues &dest) {
+  if (&source == &dest) {
+    throw std::runtime_error(
+        "Error in copy_apply(SupercellSymOp const &, ConfigDoFValues const &, "
+        "ConfigDoFValues &): source and dest are the same");
+  }
+  CASM_CONFIG_COUNT(op_applications);
   Supercell const &supercell = *op.supercell();
   Prim const &prim = *op.supercell()->prim;
   PrimSymInfo const &prim_sym_info = prim.sym_info;
   Index n_vol = supercell.superlattice.size();
-  Index n_sublat = prim.basicstructure->basis().size();
-  Index n_sites = n_vol * n_sublat;
 
   Index prim_fg_index = op.prim_factor_group_index();
 
-  for (auto &dof : dof_values.global_dof_values) {
+  match_shape(source, dest);
+
+  auto dest_global_it = dest.global_dof_values.begin();
+  for (auto const &dof : source.global_dof_values) {
     Eigen::MatrixXd const &M =
         prim_sym_info.global_dof_symgroup_rep.at(dof.first)[prim_fg_index];
-    dof.second = M * dof.second;
+    dest_global_it->second.noalias() = M * dof.second;
+    ++dest_global_it;
   }
 
-  sym_info::Permutation combined_permute{op.combined_permute()};
+  // value on active site l is gathered from site combined_permute[l]; values
+  // on other sites are fixed and copied unchanged
+  SupercellActiveSites const &active_sites = supercell.sym_info().active_sites;
+  sym_info::Permutation const &combined_permute =
+      SupercellSymOpHandle(op).active_combined_permute();
 
-  if (dof_values.occupation.size()) {
-    // permute occupant indices (if anisotropic)
-    Eigen::VectorXi tmp{dof_values.occupation};
-    if (prim_sym_info.has_aniso_occs) {
-      Index l = 0;
-      for (Index b = 0; b < n_sublat; ++b) {
-        for (Index n = 0; n < n_vol; ++n, ++l) {
-          sym_info::Permutation const &occ_perm =
-              prim_sym_info.occ_symgroup_rep[prim_fg_index][b];
-          tmp[l] = occ_perm[tmp[l]];
+  if (source.occupation.size()) {
+    gather_occupation(prim_sym_info, prim_fg_index, combined_permute, n_vol,
+                      active_sites, source.occupation, dest.occupation);
+  }
+
+  auto dest_local_it = dest.local_dof_values.begin();
+  for (auto const &dof : source.local_dof_values) {
+    Index dof_id = prim_sym_info.local_dof_id(dof.first);
+    if (dof_id == -1) {
+      throw std::runtime_error(
+          "Error in copy_apply(SupercellSymOp const &, ConfigDoFValues const "
+          "&, ConfigDoFValues &): no symmetry representation for local DoF "
+          "\"" +
+          dof.first + "\"");
+    }
+    Eigen::MatrixXd const &init_value = dof.second;
+    Eigen::MatrixXd &final_value = dest_local_it->second;
+    if (!active_sites.all_active) {
+      final_value = init_value;
+    }
+    for (auto const &range : active_sites.ranges) {
+      for (Index l = range.first; l < range.second; ++l) {
+        Index l_from = combined_permute[l];
+        Index b_from = l_from / n_vol;
+        Index dim = prim_sym_info.local_dof_dim(dof_id, b_from);
+        if (dim < init_value.rows()) {
+          final_value.col(l) = init_value.col(l_from);
         }
+        if (dim == 0) continue;
+        Eigen::Map<Eigen::MatrixXd const> M =
+            prim_sym_info.local_dof_rep(dof_id, prim_fg_index, b_from);
+        final_value.col(l).head(dim).noalias() =
+            M * init_value.col(l_from).head(dim);
       }
     }
+    ++dest_local_it;
+  }
 
-    // permute values amongst sites
-    for (Index l = 0; l < n_sites; ++l) {
-      dof_values.occupation[l] = tmp[combined_permute[l]];
-    }
+  return dest;
+}
+
+/// \brief Constructor, for the given prim factor group operations
+///
+/// \param _source The DoF values to transform. Must outlive the
+///     BatchedDoFTransform.
+/// \param supercell The supercell of `_source`
+/// \param prim_fg_indices The prim factor group indices of the operations
+///     that will be applied
+BatchedDoFTransform::BatchedDoFTransform(
+    ConfigDoFValues const &_source, Supercell const &supercell,
+    std::set<Index> const &prim_fg_indices)
+    : m_source(&_source), m_n_vol(0) {
+  _init(supercell, prim_fg_indices);
+}
+
+void BatchedDoFTransform::_init(Supercell const &supercell,
+                                std::set<Index> const &prim_fg_indices) {
+  Prim const &prim = *supercell.prim;
+  PrimSymInfo const &prim_sym_info = prim.sym_info;
+  ConfigDoFValues const &source = *m_source;
+  m_n_vol = supercell.superlattice.size();
+  Index n_sublat = prim.basicstructure->basis().size();
+  Index n_ops = prim_fg_indices.size();
+
+  m_position.assign(prim_sym_info.factor_group->element.size(), -1);
+  Index position = 0;
+  for (Index prim_fg_index : prim_fg_indices) {
+    m_position.at(prim_fg_index) = position++;
   }
 
-  using clexulator::sublattice_block;
-  for (auto &dof : dof_values.local_dof_values) {
-    // vector of matrix, one per sublattice
-    sym_info::LocalDoFSymOpRep const &local_dof_symop_rep =
-        prim_sym_info.local_dof_symgroup_rep.at(dof.first)[prim_fg_index];
+  for (auto const &dof : source.global_dof_values) {
+    auto const &rep = prim_sym_info.global_dof_symgroup_rep.at(dof.first);
+    std::vector<Eigen::VectorXd> &transformed = m_global[dof.first];
+    transformed.reserve(n_ops);
+    for (Index prim_fg_index : prim_fg_indices) {
+      transformed.emplace_back(rep[prim_fg_index] * dof.second);
+    }
+  }
 
-    // transform values on initial sites
-    Eigen::MatrixXd const &init_value = dof.second;
-    Eigen::MatrixXd tmp{init_value};
+  for (auto const &dof : source.local_dof_values) {
+    auto const &rep = prim_sym_info.local_dof_symgroup_rep.at(dof.first);
+    std::vector<Eigen::MatrixXd> &transformed = m_local[dof.first];
+    std::vector<Index> &dims = m_local_dim[dof.first];
+    transformed.resize(n_sublat);
+    dims.resize(n_sublat);
     for (Index b = 0; b < n_sublat; ++b) {
-      Eigen::MatrixXd const &M = local_dof_symop_rep[b];
-      Index dim = M.cols();
-      if (dim == 0) continue;
-      sublattice_block(tmp, b, n_vol).topRows(dim) =
-          M * sublattice_block(init_value, b, n_vol).topRows(dim);
-    }
+      Index dim = n_ops ? rep[*prim_fg_indices.begin()][b].cols() : 0;
+      dims[b] = dim;
+      if (dim == 0) {
+        continue;
+      }
 
-    // permute values amongst sites
-    for (Index l = 0; l < n_sites; ++l) {
-      dof.second.col(l) = tmp.col(combined_permute[l]);
+      // stack point group matrices, then transform the block in one product
+      Eigen::MatrixXd M_stack(n_ops * dim, dim);
+      Index i = 0;
+      for (Index prim_fg_index : prim_fg_indices) {
+        M_stack.middleRows(i * dim, dim) = rep[prim_fg_index][b];
+        ++i;
+      }
+      transformed[b].noalias() =
+          M_stack * dof.second.block(0, b * m_n_vol, dim, m_n_vol);
     }
   }
-
-  return dof_values;
 }
 
-/// \brief Apply a symmetry operation specified by a SupercellSymOp to
-/// ConfigDoFValues
-ConfigDoFValues copy_apply(SupercellSymOp const &op,
-                           ConfigDoFValues dof_values) {
-  apply(op, dof_values);
-  return dof_values;
+/// \brief Write `copy_apply(op, source())` into existing ConfigDoFValues
+///
+/// \param op The symmetry operation. Its prim factor group operation must be
+///     one of those the values were transformed by.
+/// \param dest Set to the transformed values. Must not be `source()`. If it
+///     already has the same DoF types and shapes as `source()`, no memory is
+///     allocated.
+///
+/// \returns A reference to `dest`
+ConfigDoFValues &BatchedDoFTransform::copy_apply(SupercellSymOp const &op,
+                                                 ConfigDoFValues &dest) const {
+  ConfigDoFValues const &source = *m_source;
+  Index prim_fg_index = op.prim_factor_group_index();
+  if (!contains(prim_fg_index)) {
+    throw std::runtime_error(
+        "Error in BatchedDoFTransform::copy_apply: values were not "
+        "transformed by the operation's prim factor group operation");
+  }
+  if (&source == &dest) {
+    throw std::runtime_error(
+        "Error in BatchedDoFTransform::copy_apply: source and dest are the "
+        "same");
+  }
+  CASM_CONFIG_COUNT(op_applications);
+  Index position = m_position[prim_fg_index];
+
+  match_shape(source, dest);
+
+  auto dest_global_it = dest.global_dof_values.begin();
+  for (auto const &dof : m_global) {
+    dest_global_it->second = dof.second[position];
+    ++dest_global_it;
+  }
+
+  // value on active site l is gathered from site combined_permute[l]; values
+  // on other sites are fixed and copied unchanged
+  SupercellActiveSites const &active_sites =
+      op.supercell()->sym_info().active_sites;
+  sym_info::Permutation const &combined_permute =
+      SupercellSymOpHandle(op).active_combined_permute();
+
+  if (source.occupation.size()) {
+    gather_occupation(op.supercell()->prim->sym_info, prim_fg_index,
+                      combined_permute, m_n_vol, active_sites,
+                      source.occupation, dest.occupation);
+  }
+
+  auto source_local_it = source.local_dof_values.begin();
+  auto dest_local_it = dest.local_dof_values.begin();
+  for (auto const &dof : m_local) {
+    std::vector<Index> const &dims = m_local_dim.at(dof.first);
+    Eigen::MatrixXd const &init_value = source_local_it->second;
+    Eigen::MatrixXd &final_value = dest_local_it->second;
+    if (!active_sites.all_active) {
+      final_value = init_value;
+    }
+    for (auto const &range : active_sites.ranges) {
+      for (Index l = range.first; l < range.second; ++l) {
+        Index l_from = combined_permute[l];
+        Index b_from = l_from / m_n_vol;
+        Index dim = dims[b_from];
+        if (dim < init_value.rows()) {
+          final_value.col(l) = init_value.col(l_from);
+        }
+        if (dim == 0) continue;
+        final_value.col(l).head(dim) = dof.second[b_from].block(
+            position * dim, l_from - b_from * m_n_vol, dim, 1);
+      }
+    }
+    ++source_local_it;
+    ++dest_local_it;
+  }
+
+  return dest;
 }
 
 /// \brief Apply a symmetry operation specified by a SupercellSymOp to
@@ -447,7 +866,7 @@ std::vector<SupercellSymOp> make_local_supercell_symgroup_rep(
   std::vector<SupercellSymOp> result;
 
   if (local_prim_subgroup->head_group !=
-      supercell->sym_info.factor_group->head_group) {
+      supercell->sym_info().factor_group->head_group) {
     throw std::runtime_error(
         "Error in make_local_supercell_symgroup_rep: do not share the same "
         "prim factor group");
@@ -455,7 +874,7 @@ std::vector<SupercellSymOp> make_local_supercell_symgroup_rep(
 
   SymGroup const &local_group = *local_prim_subgroup;
   SymGroup const &prim_factor_group = *local_group.head_group;
-  SymGroup const &supercell_factor_group = *supercell->sym_info.factor_group;
+  SymGroup const &supercell_factor_group = *supercell->sym_info().factor_group;
 
   std::map<Index, Index> prim_to_supercell_fg_index;
   Index supercell_fg_index = 0;
@@ -492,7 +911,7 @@ std::shared_ptr<SymGroup const> make_local_symgroup(
   std::shared_ptr<SymGroup const> prim_factor_group =
       supercell->prim->sym_info.factor_group;
   std::shared_ptr<SymGroup const> supercell_factor_group =
-      supercell->sym_info.factor_group;
+      supercell->sym_info().factor_group;
 
   std::map<Index, xtal::SymOp> index_and_element;
   for (auto const &supercell_symop : local_supercell_symgroup_rep) {
@@ -519,6 +938,130 @@ std::shared_ptr<SymGroup const> make_local_symgroup(
                                           head_group_index);
 }
 
+/// \brief Make the group of all operations of a supercell, with products
+///     and inverses as precomputed tables
+///
+/// \param supercell The supercell
+/// \param max_table_bytes If the multiplication table, of `n_ops * n_ops`
+///     indices, would be larger than this, in bytes, return nullptr
+///     (default=2^24, 16 MiB)
+///
+/// \returns The group of all supercell operations, with element `i` the
+///     operation with `op_index() == i`, or nullptr
+///
+/// Products and inverses are then lookups, so the generic group::Group
+/// methods, such as `group::make_conjugacy_classes`, and subgroup
+/// construction can be used without repeated SymOp arithmetic. The table is
+/// built with integer translation arithmetic (see
+/// SupercellFactorGroupAction), using a table of translation sums. Construct
+/// once per supercell and re-use.
+std::shared_ptr<SupercellSymGroup const> make_supercell_symgroup(
+    std::shared_ptr<Supercell const> const &supercell,
+    Index max_table_bytes) {
+  SupercellSymInfo const &sym_info = supercell->sym_info();
+  SymGroup const &factor_group = *sym_info.factor_group;
+  SupercellFactorGroupAction const &action = sym_info.factor_group_action;
+  Index n_fg = factor_group.element.size();
+  Index n_vol = supercell->superlattice.size();
+  Index n_ops = n_fg * n_vol;
+  if (n_ops * n_ops * Index(sizeof(Index)) > max_table_bytes) {
+    return nullptr;
+  }
+  auto const &converter = supercell->unitcell_index_converter;
+
+  std::vector<SupercellSymOpHandle> element;
+  element.reserve(n_ops);
+  for (Index f = 0; f < n_fg; ++f) {
+    for (Index t = 0; t < n_vol; ++t) {
+      element.emplace_back(supercell.get(), f, t);
+    }
+  }
+
+  // translation index of the sum of translations, by `[t1 * n_vol + t2]`
+  std::vector<Index> translation_sum(n_vol * n_vol);
+  for (Index t1 = 0; t1 < n_vol; ++t1) {
+    UnitCell const &uc1 = converter(t1);
+    for (Index t2 = 0; t2 < n_vol; ++t2) {
+      translation_sum[t1 * n_vol + t2] =
+          converter(UnitCell(uc1 + converter(t2)));
+    }
+  }
+
+  // translation index of frac_matrix[f] * t, by `[f * n_vol + t]`
+  std::vector<Index> rotated_translation(n_fg * n_vol);
+  for (Index f = 0; f < n_fg; ++f) {
+    for (Index t = 0; t < n_vol; ++t) {
+      rotated_translation[f * n_vol + t] =
+          converter(UnitCell(action.frac_matrix[f] * converter(t)));
+    }
+  }
+
+  // translation index of product_translation[f1][f2]
+  std::vector<Index> product_translation(n_fg * n_fg);
+  for (Index f1 = 0; f1 < n_fg; ++f1) {
+    for (Index f2 = 0; f2 < n_fg; ++f2) {
+      product_translation[f1 * n_fg + f2] =
+          converter(UnitCell(action.product_translation[f1][f2]));
+    }
+  }
+
+  // (f1, t1) * (f2, t2) = (f1 * f2, t1 + frac_matrix[f1] * t2 +
+  //                        product_translation[f1][f2])
+  group::MultiplicationTable multiplication_table(n_ops);
+  for (Index f1 = 0; f1 < n_fg; ++f1) {
+    for (Index t1 = 0; t1 < n_vol; ++t1) {
+      std::vector<Index> &row = multiplication_table[f1 * n_vol + t1];
+      row.resize(n_ops);
+      for (Index f2 = 0; f2 < n_fg; ++f2) {
+        Index f3 = factor_group.multiplication_table[f1][f2];
+        Index shift = translation_sum[t1 * n_vol +
+                                      product_translation[f1 * n_fg + f2]];
+        for (Index t2 = 0; t2 < n_vol; ++t2) {
+          Index t3 = translation_sum[shift * n_vol +
+                                     rotated_translation[f1 * n_vol + t2]];
+          row[f2 * n_vol + t2] = f3 * n_vol + t3;
+        }
+      }
+    }
+  }
+
+  return std::make_shared<SupercellSymGroup const>(element,
+                                                   multiplication_table);
+}
+
+/// \brief Make the subgroup of a supercell group for local property
+///     symmetry
+///
+/// \param local_prim_subgroup A subgroup of prim->sym_info->factor_group.
+///     Must be a local property group, in which each prim factor group
+///     operation only appears once.
+/// \param supercell The supercell
+/// \param supercell_symgroup The group of all operations of `supercell`,
+///     from `make_supercell_symgroup`.
+///
+/// \returns The subgroup of `supercell_symgroup` with the same operations
+///     as `make_local_supercell_symgroup_rep`.
+std::shared_ptr<SupercellSymGroup const> make_local_supercell_subgroup(
+    std::shared_ptr<SymGroup const> const &local_prim_subgroup,
+    std::shared_ptr<Supercell const> const &supercell,
+    std::shared_ptr<SupercellSymGroup const> const &supercell_symgroup) {
+  if (supercell_symgroup->head_group != nullptr ||
+      supercell_symgroup->element.empty() ||
+      supercell_symgroup->element[0].supercell() != supercell.get()) {
+    throw std::runtime_error(
+        "Error in make_local_supercell_subgroup: supercell_symgroup is not "
+        "the group of all supercell operations");
+  }
+
+  std::set<Index> head_group_index;
+  for (SupercellSymOp const &op :
+       make_local_supercell_symgroup_rep(local_prim_subgroup, supercell)) {
+    head_group_index.insert(SupercellSymOpHandle(op).op_index());
+  }
+  return std::make_shared<SupercellSymGroup const>(supercell_symgroup,
+                                                   head_group_index);
+}
+
 /// \brief Make the matrix representation of `group` that describes the
 ///     transformation of the specified DoF
 ///
@@ -646,6 +1189,10 @@ std::vector<Eigen::MatrixXd> make_global_dof_matrix_rep(
 /// \returns matrix_rep The matrix representation of `group` which transforms
 ///     the specified occupation or local DoF.
 ///
+/// Notes:
+/// - The matrices are dense copies of the result of
+///   `make_local_dof_sparse_matrix_rep`, which should be preferred for
+///   large supercells.
 std::vector<Eigen::MatrixXd> make_local_dof_matrix_rep(
     std::vector<SupercellSymOp> const &group, DoFKey key,
     std::set<Index> const &site_indices,
@@ -654,6 +1201,70 @@ std::vector<Eigen::MatrixXd> make_local_dof_matrix_rep(
     throw std::runtime_error(
         "Error in make_local_dof_matrix_rep: group has size==0.");
   }
+  std::vector<Eigen::MatrixXd> result;
+  for (auto const &M :
+       make_local_dof_sparse_matrix_rep(group, key, site_indices, symgroup)) {
+    result.push_back(Eigen::MatrixXd(M));
+  }
+  return result;
+}
+
+/// \brief Make the sparse matrix representation of `group` that describes
+///     the transformation of the specified DoF
+///
+/// Same as `make_matrix_rep`, but the matrices are sparse. For global DoF,
+/// the matrices are sparse copies of the result of
+/// `make_global_dof_matrix_rep`.
+std::vector<Eigen::SparseMatrix<double>> make_sparse_matrix_rep(
+    std::vector<SupercellSymOp> const &group, DoFKey key,
+    std::optional<std::set<Index>> site_indices,
+    std::shared_ptr<SymGroup const> &symgroup) {
+  if (group.size() == 0) {
+    throw std::runtime_error(
+        "Error in make_sparse_matrix_rep: group has size==0.");
+  }
+  if (AnisoValTraits(key).global()) {
+    std::vector<Eigen::SparseMatrix<double>> result;
+    for (auto const &M : make_global_dof_matrix_rep(group, key, symgroup)) {
+      result.push_back(M.sparseView());
+    }
+    return result;
+  } else {
+    if (!site_indices.has_value()) {
+      throw std::runtime_error(
+          "Error in make_sparse_matrix_rep: site_indices has no value for "
+          "occupation or local DoF");
+    }
+    return make_local_dof_sparse_matrix_rep(group, key, *site_indices,
+                                            symgroup);
+  }
+}
+
+/// \brief Make the sparse matrix representation of `group` that describes
+///     the transformation of occupation DoF or a particular local DoF of
+///     amongst a subset of supercell sites
+///
+/// \param group The group that is to be represented (this may be larger than a
+///     crystallographic factor group)
+/// \param key The type of local DoF to be transformed. May be a local
+///     continuous DoF or "occ".
+/// \param site_indices Set of site indices that define the subset of sites
+///     where DoF will be transformed
+/// \param symgroup The resulting group as a SymGroup.
+///
+/// \returns matrix_rep The matrix representation of `group` which transforms
+///     the specified occupation or local DoF. Each matrix is a
+///     block-permutation matrix, with one site DoF symrep block per site,
+///     so it has at most (site DoF dimension) non-zero elements per row.
+///
+std::vector<Eigen::SparseMatrix<double>> make_local_dof_sparse_matrix_rep(
+    std::vector<SupercellSymOp> const &group, DoFKey key,
+    std::set<Index> const &site_indices,
+    std::shared_ptr<SymGroup const> &symgroup) {
+  if (group.size() == 0) {
+    throw std::runtime_error(
+        "Error in make_local_dof_sparse_matrix_rep: group has size==0.");
+  }
   Supercell const &supercell = *group.begin()->supercell();
   Prim const &prim = *supercell.prim;
   xtal::Lattice const &prim_lattice = prim.basicstructure->lattice();
@@ -679,24 +1290,27 @@ std::vector<Eigen::MatrixXd> make_local_dof_matrix_rep(
         "size==0.");
   }
 
-  std::vector<Eigen::MatrixXd> result;
+  std::vector<Eigen::SparseMatrix<double>> result;
 
   // make map of site_index -> beginning row in basis for that site
   // (number of rows per site == dof dimension on that site)
   std::map<Index, Index> site_index_to_basis_index;
   Index total_dim = 0;
+  Index n_nonzero_max = 0;
   for (Index site_index : site_indices) {
     Index b = supercell.unitcellcoord_index_converter(site_index).sublattice();
     Index site_dof_dim = local_dof_symgroup_rep.at(0).at(b).cols();
     site_index_to_basis_index[site_index] = total_dim;
     total_dim += site_dof_dim;
+    n_nonzero_max += site_dof_dim * site_dof_dim;
   }
 
   // make matrix rep, by filling in blocks with site dof symreps
-  Eigen::MatrixXd trep(total_dim, total_dim);
+  std::vector<Eigen::Triplet<double>> triplets;
+  triplets.reserve(n_nonzero_max);
   std::vector<xtal::SymOp> element;
   for (SupercellSymOp const &supercell_symop : group) {
-    trep.setZero();
+    triplets.clear();
     for (Index site_index : site_indices) {
       // "to_site" (after applying symmetry) determines row of block
       // can't fail, because it was built from [begin, end)
@@ -720,13 +1334,21 @@ std::vector<Eigen::MatrixXd> make_local_dof_matrix_rep(
       Index from_site_b =
           supercell.unitcellcoord_index_converter(from_site_index).sublattice();
       Index prim_factor_group_index = supercell_symop.prim_factor_group_index();
-      Eigen::MatrixXd U =
+      Eigen::MatrixXd const &U =
           local_dof_symgroup_rep.at(prim_factor_group_index).at(from_site_b);
 
       // insert matrix as block in collective dof symrep
-      trep.block(row, col, U.rows(), U.cols()) = U;
+      for (Index j = 0; j < U.cols(); ++j) {
+        for (Index i = 0; i < U.rows(); ++i) {
+          if (U(i, j) != 0.0) {
+            triplets.emplace_back(row + i, col + j, U(i, j));
+          }
+        }
+      }
     }
-    result.push_back(trep);
+    Eigen::SparseMatrix<double> trep(total_dim, total_dim);
+    trep.setFromTriplets(triplets.begin(), triplets.end());
+    result.push_back(std::move(trep));
 
     element.push_back(supercell_symop.to_symop());
   }
@@ -750,25 +1372,23 @@ std::vector<Eigen::MatrixXd> make_local_dof_matrix_rep(
 /// \returns matrix_rep The matrix representation of `group` which transforms
 ///     values in the basis of `dof_space`.
 ///
+/// The fullspace matrix representation is obtained from
+/// `default_matrix_rep_cache()`.
+///
 std::vector<Eigen::MatrixXd> make_dof_space_rep(
     std::vector<config::SupercellSymOp> const &group,
     clexulator::DoFSpace const &dof_space) {
-  std::shared_ptr<config::SymGroup const> symgroup;
-  std::vector<Eigen::MatrixXd> fullspace_rep;
-  std::vector<Eigen::MatrixXd> dof_space_rep;
-  if (dof_space.is_global) {
-    fullspace_rep =
-        config::make_global_dof_matrix_rep(group, dof_space.dof_key, symgroup);
-  } else {
-    if (!dof_space.sites.has_value()) {
-      throw std::runtime_error(
-          "Error in make_dof_space_rep with local DoF: no DoFSpace sites");
-    }
-    fullspace_rep = config::make_local_dof_matrix_rep(
-        group, dof_space.dof_key, *dof_space.sites, symgroup);
+  if (!dof_space.is_global && !dof_space.sites.has_value()) {
+    throw std::runtime_error(
+        "Error in make_dof_space_rep with local DoF: no DoFSpace sites");
   }
-  for (auto const &M : fullspace_rep) {
-    dof_space_rep.push_back(dof_space.basis_inv * M * dof_space.basis);
+  // the fullspace matrices are cached, and the sparse fullspace matrices are
+  // only multiplied with the basis
+  std::shared_ptr<MatrixRep const> rep = default_matrix_rep_cache().matrix_rep(
+      group, dof_space.dof_key, dof_space.sites);
+  std::vector<Eigen::MatrixXd> dof_space_rep;
+  for (auto const &M : rep->sparse_matrix_rep) {
+    dof_space_rep.push_back(dof_space.basis_inv * (M * dof_space.basis));
   }
   return dof_space_rep;
 }
@@ -0,0 +1,287 @@
+#include "casm/configuration/SupercellSymOpGenerators.hh"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "casm/configuration/Supercell.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// \brief Number of operations in the supercell group
+Index n_supercell_ops(Supercell const &supercell) {
+  return supercell.sym_info().factor_group->element.size() *
+         supercell.superlattice.size();
+}
+
+/// \brief Return handles, checking that all operations are in `supercell`
+std::vector<SupercellSymOpHandle> make_handles(
+    std::vector<SupercellSymOp> const &group,
+    std::shared_ptr<Supercell const> const &supercell,
+    std::string const &function_name) {
+  std::vector<SupercellSymOpHandle> handles;
+  handles.reserve(group.size());
+  for (auto const &op : group) {
+    if (op.supercell() != supercell) {
+      throw std::runtime_error("Error in " + function_name +
+                               ": operations are not all in the same "
+                               "supercell");
+    }
+    handles.emplace_back(op);
+  }
+  return handles;
+}
+
+/// \brief Return the op_index of the operations generated by `generators`
+group::IndexBitset make_closure(
+    std::vector<SupercellSymOpHandle> const &generators, Index n_ops) {
+  group::IndexBitset closure(n_ops);
+  std::vector<SupercellSymOpHandle> members;
+  for (auto const &op : generators) {
+    if (closure.insert(op.op_index())) {
+      members.push_back(op);
+    }
+  }
+  // the group is finite, so products of generators include the identity
+  // and inverses
+  for (Index l = 0; l < members.size(); ++l) {
+    for (auto const &op : generators) {
+      SupercellSymOpHandle product = members[l] * op;
+      if (closure.insert(product.op_index())) {
+        members.push_back(product);
+      }
+    }
+  }
+  return closure;
+}
+
+/// \brief Greedily add operations of `group` to `generators` until they
+///     generate `group`, and return the closure
+///
+/// The identity is never added, and an operation is only added if it is
+/// not generated by the generators already chosen, so each added operation
+/// at least doubles the size of the generated group.
+group::IndexBitset extend_generators(
+    std::vector<SupercellSymOpHandle> const &group,
+    std::vector<SupercellSymOpHandle> &generators, Index n_ops) {
+  group::IndexBitset closure = make_closure(generators, n_ops);
+  for (auto const &op : group) {
+    if (closure.contains(op.op_index()) || op * op == op) {
+      continue;
+    }
+    generators.push_back(op);
+    closure = make_closure(generators, n_ops);
+  }
+  return closure;
+}
+
+/// \brief Throw if the generated operations are not all in the group
+void check_closed(std::vector<SupercellSymOpHandle> const &group,
+                  group::IndexBitset const &closure, Index n_ops,
+                  std::string const &function_name) {
+  group::IndexBitset group_bits(n_ops);
+  for (auto const &op : group) {
+    group_bits.insert(op.op_index());
+  }
+  if (!closure.is_subset_of(group_bits)) {
+    throw std::runtime_error("Error in " + function_name +
+                             ": operations are not a group");
+  }
+}
+
+std::vector<SupercellSymOp> to_ops(
+    std::vector<SupercellSymOpHandle> const &handles,
+    std::shared_ptr<Supercell const> const &supercell) {
+  std::vector<SupercellSymOp> ops;
+  ops.reserve(handles.size());
+  for (auto const &handle : handles) {
+    ops.emplace_back(supercell, handle);
+  }
+  return ops;
+}
+
+}  // namespace
+
+/// \brief Return a small set of operations that generates a group of
+///     SupercellSymOp
+///
+/// Operations are visited in the order of `group`, and an operation is
+/// added as a generator only if it is not in the group generated by the
+/// generators already chosen. Each added generator at least doubles the
+/// size of the generated group, so there are at most log2(group size)
+/// generators.
+///
+/// \param group The operations of a group, all in the same supercell
+///
+/// \returns The generators, a subset of `group`. Empty if `group` is empty
+///     or only has the identity.
+///
+/// \throws If the operations are not all in the same supercell, or are not
+///     closed under multiplication.
+std::vector<SupercellSymOp> make_generators(
+    std::vector<SupercellSymOp> const &group) {
+  if (group.empty()) {
+    return std::vector<SupercellSymOp>();
+  }
+  auto const &supercell = group[0].supercell();
+  Index n_ops = n_supercell_ops(*supercell);
+  std::vector<SupercellSymOpHandle> handles =
+      make_handles(group, supercell, "make_generators");
+  std::vector<SupercellSymOpHandle> generators;
+  group::IndexBitset closure = extend_generators(handles, generators, n_ops);
+  check_closed(handles, closure, n_ops, "make_generators");
+  return to_ops(generators, supercell);
+}
+
+/// \brief Constructor
+///
+/// \param group The operations of a group, all in the same supercell. Must
+///     include the identity.
+///
+/// Cost is O(group size * (base size + n_strong_generators^2)) operation
+/// products and site permutation lookups.
+SupercellSymOpStabilizerChain::SupercellSymOpStabilizerChain(
+    std::vector<SupercellSymOp> const &group) {
+  if (group.empty()) {
+    throw std::runtime_error(
+        "Error constructing SupercellSymOpStabilizerChain: group is empty");
+  }
+  m_supercell = group[0].supercell();
+  Index n_ops = n_supercell_ops(*m_supercell);
+  Index n_sites = m_supercell->unitcellcoord_index_converter.total_sites();
+
+  // distinct operations
+  std::vector<SupercellSymOpHandle> current;
+  {
+    group::IndexBitset found(n_ops);
+    for (auto const &op : make_handles(group, m_supercell,
+                                       "SupercellSymOpStabilizerChain")) {
+      if (found.insert(op.op_index())) {
+        current.push_back(op);
+      }
+    }
+  }
+  m_group_size = current.size();
+
+  // stabilizer chain: all sites < start are invariant under `current`
+  std::vector<std::vector<SupercellSymOpHandle>> level_ops({current});
+  Index start = 0;
+  while (true) {
+    Index b = n_sites;
+    for (auto const &op : current) {
+      for (Index l = start; l < b; ++l) {
+        if (op.permute_index(l) != l) {
+          b = l;
+          break;
+        }
+      }
+    }
+    if (b == n_sites) {
+      break;
+    }
+
+    Level level;
+    level.base_point = b;
+    level.transversal_index.assign(n_sites, -1);
+    std::vector<SupercellSymOpHandle> next;
+    for (auto const &op : current) {
+      Index p = op.permute_index(b);
+      if (p == b) {
+        next.push_back(op);
+      }
+      if (level.transversal_index[p] == -1) {
+        level.transversal_index[p] = level.transversal_inverse.size();
+        level.transversal_inverse.push_back(op.inverse());
+        level.orbit.push_back(p);
+      }
+    }
+    std::sort(level.orbit.begin(), level.orbit.end());
+
+    m_base.push_back(b);
+    m_levels.push_back(std::move(level));
+    current = std::move(next);
+    level_ops.push_back(current);
+    start = b + 1;
+  }
+
+  // kernel
+  m_kernel = to_ops(current, m_supercell);
+  m_kernel_bits = group::IndexBitset(n_ops);
+  for (auto const &op : current) {
+    m_kernel_bits.insert(op.op_index());
+  }
+
+  // strong generating set, from the bottom of the chain up
+  std::vector<SupercellSymOpHandle> generators;
+  group::IndexBitset closure(n_ops);
+  for (auto it = level_ops.rbegin(); it != level_ops.rend(); ++it) {
+    closure = extend_generators(*it, generators, n_ops);
+  }
+  check_closed(level_ops[0], closure, n_ops, "SupercellSymOpStabilizerChain");
+  m_strong_generators = to_ops(generators, m_supercell);
+}
+
+/// \brief The supercell
+std::shared_ptr<Supercell const> const &
+SupercellSymOpStabilizerChain::supercell() const {
+  return m_supercell;
+}
+
+/// \brief The number of operations in the group
+Index SupercellSymOpStabilizerChain::group_size() const {
+  return m_group_size;
+}
+
+/// \brief The base points, as linear site indices
+std::vector<Index> const &SupercellSymOpStabilizerChain::base() const {
+  return m_base;
+}
+
+/// \brief The strong generating set
+std::vector<SupercellSymOp> const &
+SupercellSymOpStabilizerChain::strong_generators() const {
+  return m_strong_generators;
+}
+
+/// \brief The orbit of `base()[i]` under the stabilizer of
+///     `base()[0], ..., base()[i-1]`, as linear site indices
+///
+/// Sites are in ascending order. The group size is the product of the
+/// basic orbit sizes and the kernel size.
+std::vector<Index> const &SupercellSymOpStabilizerChain::basic_orbit(
+    Index i) const {
+  return m_levels[i].orbit;
+}
+
+/// \brief The operations that leave every site invariant
+std::vector<SupercellSymOp> const &SupercellSymOpStabilizerChain::kernel()
+    const {
+  return m_kernel;
+}
+
+/// \brief Return true if an operation is in the group
+///
+/// Operations in a different supercell are not in the group.
+bool SupercellSymOpStabilizerChain::contains(SupercellSymOp const &op) const {
+  if (*op.supercell() != *m_supercell) {
+    return false;
+  }
+  SupercellSymOpHandle g(m_supercell.get(), op.supercell_factor_group_index(),
+                         op.translation_index());
+  for (auto const &level : m_levels) {
+    // g and the transversal operation u both permute site p onto the base
+    // point, so g * u^-1 leaves the base point invariant
+    Index t = level.transversal_index[g.permute_index(level.base_point)];
+    if (t == -1) {
+      return false;
+    }
+    g = g * level.transversal_inverse[t];
+  }
+  return m_kernel_bits.contains(g.op_index());
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,304 @@
+#include "casm/configuration/TimeReversalCanonicalizer.hh"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymInfo.hh"
+#include "casm/configuration/instrumentation.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// \brief Return the prim factor group index of pure time reversal, or -1
+Index find_time_reversal(Prim const &prim) {
+  double tol = prim.basicstructure->lattice().tol();
+  auto const &element = prim.sym_info.factor_group->element;
+  for (Index i = 0; i < element.size(); ++i) {
+    SymOp const &op = element[i];
+    if (op.is_time_reversal_active && op.matrix.isIdentity(tol) &&
+        op.translation.norm() < tol) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/// \brief Return true if M is diagonal, with entries +1 or -1
+bool is_sign_flip(Eigen::MatrixXd const &M) {
+  if (M.rows() != M.cols()) {
+    return false;
+  }
+  for (Index i = 0; i < M.rows(); ++i) {
+    for (Index j = 0; j < M.cols(); ++j) {
+      double expected = 0.0;
+      if (i == j) {
+        expected = M(i, j) > 0.0 ? 1.0 : -1.0;
+      }
+      if (std::abs(M(i, j) - expected) > TOL) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _supercell The supercell. The prim must satisfy
+///     `TimeReversalCanonicalizer::is_supported`.
+TimeReversalCanonicalizer::TimeReversalCanonicalizer(
+    std::shared_ptr<Supercell const> const &_supercell)
+    : m_supercell(_supercell),
+      m_n_vol(_supercell->superlattice.size()),
+      m_transformed(_supercell),
+      m_flipped(_supercell),
+      m_best(_supercell),
+      m_best_eq(m_best) {
+  Prim const &prim = *m_supercell->prim;
+  if (!is_supported(prim)) {
+    throw std::runtime_error(
+        "Error constructing TimeReversalCanonicalizer: prim factor group "
+        "does not contain time reversal represented by sign flips and "
+        "occupant permutations");
+  }
+  PrimSymInfo const &prim_sym_info = prim.sym_info;
+  Index prim_theta = find_time_reversal(prim);
+  Index n_sublat = prim.basicstructure->basis().size();
+
+  // supercell factor group cosets
+  auto const &factor_group = *m_supercell->sym_info().factor_group;
+  Index theta = -1;
+  for (Index i = 0; i < factor_group.element.size(); ++i) {
+    if (factor_group.head_group_index[i] == prim_theta) {
+      theta = i;
+    }
+  }
+  if (theta == -1) {
+    throw std::runtime_error(
+        "Error constructing TimeReversalCanonicalizer: time reversal is not "
+        "in the supercell factor group");
+  }
+  m_time_reversal_partner.resize(factor_group.element.size());
+  for (Index i = 0; i < factor_group.element.size(); ++i) {
+    m_time_reversal_partner[i] = factor_group.mult(theta, i);
+    if (!factor_group.element[i].is_time_reversal_active) {
+      m_spatial_factor_group_indices.push_back(i);
+    }
+  }
+
+  // time reversal representation
+  bool occ_is_flipped = false;
+  std::vector<std::vector<int>> occ_flip(n_sublat);
+  for (Index b = 0; b < n_sublat; ++b) {
+    auto const &perm = prim_sym_info.occ_symgroup_rep[prim_theta][b];
+    for (Index occ = 0; occ < perm.size(); ++occ) {
+      occ_flip[b].push_back(perm[occ]);
+      if (perm[occ] != occ) {
+        occ_is_flipped = true;
+      }
+    }
+  }
+  if (occ_is_flipped) {
+    m_occ_flip = std::move(occ_flip);
+  }
+
+  ConfigDoFValues const &dof_values = m_best.dof_values;
+  for (auto const &pair : dof_values.global_dof_values) {
+    Eigen::MatrixXd const &M =
+        prim_sym_info.global_dof_symgroup_rep.at(pair.first)[prim_theta];
+    Eigen::VectorXd sign = M.diagonal();
+    if ((sign.array() > 0.0).all()) {
+      continue;
+    }
+    m_global_flip.push_back(GlobalFlip{pair.first, sign});
+  }
+  for (auto const &pair : dof_values.local_dof_values) {
+    auto const &local_dof_symop_rep =
+        prim_sym_info.local_dof_symgroup_rep.at(pair.first)[prim_theta];
+    Eigen::MatrixXd sign =
+        Eigen::MatrixXd::Ones(pair.second.rows(), n_sublat);
+    for (Index b = 0; b < n_sublat; ++b) {
+      Eigen::MatrixXd const &M = local_dof_symop_rep[b];
+      sign.block(0, b, M.rows(), 1) = M.diagonal();
+    }
+    if ((sign.array() > 0.0).all()) {
+      continue;
+    }
+    m_local_flip.push_back(LocalFlip{pair.first, sign});
+  }
+}
+
+/// \brief Return true if the prim factor group contains pure time
+///     reversal represented by sign flips and occupant permutations
+///
+/// Requires that the prim factor group contains an operation with identity
+/// matrix, zero translation, and time reversal active, and that its global
+/// and local continuous DoF representation matrices are diagonal with
+/// entries +1 or -1.
+bool TimeReversalCanonicalizer::is_supported(Prim const &prim) {
+  Index theta = find_time_reversal(prim);
+  if (theta == -1) {
+    return false;
+  }
+  PrimSymInfo const &prim_sym_info = prim.sym_info;
+  for (auto const &dof : prim_sym_info.global_dof_symgroup_rep) {
+    if (!is_sign_flip(dof.second[theta])) {
+      return false;
+    }
+  }
+  for (auto const &dof : prim_sym_info.local_dof_symgroup_rep) {
+    for (Eigen::MatrixXd const &M : dof.second[theta]) {
+      if (!is_sign_flip(M)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// \brief The supercell
+std::shared_ptr<Supercell const> const &TimeReversalCanonicalizer::supercell()
+    const {
+  return m_supercell;
+}
+
+/// \brief Supercell factor group indices of operations without time
+///     reversal
+///
+/// These are representatives of the cosets of the subgroup generated by
+/// pure time reversal.
+std::vector<Index> const &
+TimeReversalCanonicalizer::spatial_factor_group_indices() const {
+  return m_spatial_factor_group_indices;
+}
+
+/// \brief Supercell factor group index of `theta * element[i]`, by
+///     supercell factor group index `i`
+std::vector<Index> const &TimeReversalCanonicalizer::time_reversal_partner()
+    const {
+  return m_time_reversal_partner;
+}
+
+/// \brief Return true if configuration is in canonical form, using all
+///     supercell operations
+///
+/// If true, then `configuration` satisfies, for all supercell operations
+/// `rep`:
+///     configuration >= copy_apply(rep, configuration)
+bool TimeReversalCanonicalizer::is_canonical(
+    Configuration const &configuration) {
+  m_best.dof_values = configuration.dof_values;
+  m_best_eq.rebind(m_best);
+  auto is_greater = [&](Configuration const &candidate) {
+    return !m_best_eq(candidate) && m_best_eq.is_less();
+  };
+  for (Index fg : m_spatial_factor_group_indices) {
+    for (Index t = 0; t < m_n_vol; ++t) {
+      SupercellSymOp op(m_supercell, fg, t);
+      copy_apply(op, m_best.dof_values, m_transformed.dof_values);
+      if (is_greater(m_transformed)) {
+        return false;
+      }
+      _flip(m_transformed.dof_values, m_flipped.dof_values);
+      if (is_greater(m_flipped)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// \brief Return rep that makes a configuration canonical, using all
+///     supercell operations
+///
+/// The result, `rep`, is the first supercell operation, in the order of
+/// iterating from `SupercellSymOp::begin`, that satisfies:
+///     canonical_configuration == copy_apply(rep, configuration)
+SupercellSymOp TimeReversalCanonicalizer::to_canonical(
+    Configuration const &configuration) {
+  CASM_CONFIG_SCOPED_TIMER(canonical_form);
+  m_best.dof_values = configuration.dof_values;
+  m_best_eq.rebind(m_best);
+  m_best_op = SupercellSymOpHandle(m_supercell.get(), 0, 0);
+  for (Index fg : m_spatial_factor_group_indices) {
+    Index partner = m_time_reversal_partner[fg];
+    for (Index t = 0; t < m_n_vol; ++t) {
+      SupercellSymOp op(m_supercell, fg, t);
+      copy_apply(op, configuration.dof_values, m_transformed.dof_values);
+      _flip(m_transformed.dof_values, m_flipped.dof_values);
+      _update(m_transformed, SupercellSymOpHandle(m_supercell.get(), fg, t));
+      _update(m_flipped,
+              SupercellSymOpHandle(m_supercell.get(), partner, t));
+    }
+  }
+  return SupercellSymOp(m_supercell, m_best_op);
+}
+
+/// \brief Return the canonical configuration, using all supercell
+///     operations
+///
+/// The result, `canonical_configuration` satisfies for all supercell
+/// operations `rep`:
+///     canonical_configuration >= copy_apply(rep, configuration)
+Configuration TimeReversalCanonicalizer::make_canonical_form(
+    Configuration const &configuration) {
+  CASM_CONFIG_COUNT(canonical_forms);
+  return copy_apply(to_canonical(configuration), configuration);
+}
+
+/// \brief Write the time reversal of `source` into `dest`
+///
+/// `dest` must have the same DoF and shape as `source`.
+void TimeReversalCanonicalizer::_flip(ConfigDoFValues const &source,
+                                      ConfigDoFValues &dest) const {
+  if (m_occ_flip.empty()) {
+    dest.occupation = source.occupation;
+  } else {
+    Index n_sites = source.occupation.size();
+    for (Index l = 0; l < n_sites; ++l) {
+      dest.occupation(l) = m_occ_flip[l / m_n_vol][source.occupation(l)];
+    }
+  }
+
+  dest.global_dof_values = source.global_dof_values;
+  for (GlobalFlip const &flip : m_global_flip) {
+    dest.global_dof_values.at(flip.key).array() *= flip.sign.array();
+  }
+
+  dest.local_dof_values = source.local_dof_values;
+  for (LocalFlip const &flip : m_local_flip) {
+    Eigen::MatrixXd &values = dest.local_dof_values.at(flip.key);
+    for (Index l = 0; l < values.cols(); ++l) {
+      values.col(l).array() *= flip.sign.col(l / m_n_vol).array();
+    }
+  }
+}
+
+/// \brief If `candidate` is greater than m_best, or equal and `op` is
+///     before m_best_op, swap it into m_best and set m_best_op
+///
+/// This gives the same result as iterating over all operations in order
+/// and keeping the first greatest.
+void TimeReversalCanonicalizer::_update(Configuration &candidate,
+                                        SupercellSymOpHandle const &op) {
+  if (m_best_eq(candidate)) {
+    if (op < m_best_op) {
+      m_best_op = op;
+    }
+    return;
+  }
+  if (m_best_eq.is_less()) {
+    std::swap(m_best.dof_values, candidate.dof_values);
+    m_best_eq.rebind(m_best);
+    m_best_op = op;
+  }
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -1,11 +1,133 @@
 #include "casm/configuration/canonical_form.hh"
 
+#include <algorithm>
+#include <array>
+#include <tuple>
+
+#include "casm/configuration/ConfigIsEquivalent.hh"
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/OccCanonicalizer.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/numa.hh"
+#include "casm/configuration/parallel.hh"
 #include "casm/crystallography/CanonicalForm.hh"
+#include "casm/crystallography/Lattice.hh"
 #include "casm/crystallography/Niggli.hh"
+#include "casm/crystallography/SymType.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
 
 namespace CASM {
 namespace config {
 
+namespace {  // anonymous
+
+/// Number of configurations searched together by make_canonical_forms. Each
+/// operation's permutation is used on all configurations in a block before
+/// moving on to the next operation.
+Index const canonical_forms_block_size = 64;
+
+/// \brief Set canonical[i] and op_index[i] for configurations[i], i in
+///     [begin, end)
+///
+/// Occupation-only prims use OccCanonicalizer. Otherwise, the operations
+/// are the outer loop and the configurations in a block are the inner loop,
+/// comparing each transformed configuration to the greatest found so far.
+///
+/// `supercell` may be a replica of the configurations' supercell (see
+/// `local_supercell`), whose tables are used for the search; the results
+/// keep the configurations' supercell.
+void find_canonical_forms(std::vector<Configuration> const &configurations,
+                          std::shared_ptr<Supercell const> const &supercell,
+                          Index begin, Index end,
+                          std::vector<Configuration> &canonical,
+                          std::vector<Index> &op_index) {
+  Index n_translations = supercell->unitcell_index_converter.total_sites();
+  if (OccCanonicalizer::is_supported(*supercell->prim)) {
+    OccCanonicalizer canonicalizer(supercell);
+    for (Index i = begin; i < end; ++i) {
+      SupercellSymOp op = canonicalizer.to_canonical(configurations[i]);
+      op_index[i] = op.supercell_factor_group_index() * n_translations +
+                    op.translation_index();
+      canonical[i] = copy_apply(op, configurations[i]);
+    }
+    return;
+  }
+
+  SupercellSymOp op_end = SupercellSymOp::end(supercell);
+
+  // `equal_to[i - block_begin]` compares to canonical[i], and is rebound
+  // whenever canonical[i] changes; constructed once and re-used by all blocks
+  std::vector<ConfigIsEquivalent> equal_to;
+  equal_to.reserve(std::min(end - begin, canonical_forms_block_size));
+  for (Index block_begin = begin; block_begin < end;
+       block_begin += canonical_forms_block_size) {
+    Index block_end = std::min(end, block_begin + canonical_forms_block_size);
+
+    SupercellSymOp op = SupercellSymOp::begin(supercell);
+    for (Index i = block_begin; i < block_end; ++i) {
+      canonical[i] = configurations[i];
+      canonical[i].supercell = supercell;
+      op_index[i] = 0;
+      Index j = i - block_begin;
+      if (j < Index(equal_to.size())) {
+        equal_to[j].rebind(canonical[i]);
+      } else {
+        equal_to.emplace_back(canonical[i]);
+      }
+    }
+    ++op;
+    for (Index k = 1; op != op_end; ++op, ++k) {
+      for (Index i = block_begin; i < block_end; ++i) {
+        ConfigIsEquivalent &f = equal_to[i - block_begin];
+        if (!f(op, configurations[i]) && f.is_less()) {
+          canonical[i] = copy_apply(op, configurations[i]);
+          canonical[i].supercell = supercell;
+          op_index[i] = k;
+          f.rebind(canonical[i]);
+        }
+      }
+    }
+  }
+  for (Index i = begin; i < end; ++i) {
+    canonical[i].supercell = configurations[i].supercell;
+  }
+}
+
+/// \brief Return (g, x, y) such that `x * a + y * b == g == gcd(a, b)`,
+///     with g >= 0
+std::tuple<Index, Index, Index> extended_gcd(Index a, Index b) {
+  Index x0 = 1, y0 = 0, x1 = 0, y1 = 1;
+  while (b != 0) {
+    Index q = a / b;
+    std::tie(a, b) = std::make_tuple(b, a - q * b);
+    std::tie(x0, x1) = std::make_tuple(x1, x0 - q * x1);
+    std::tie(y0, y1) = std::make_tuple(y1, y0 - q * y1);
+  }
+  if (a < 0) {
+    return std::make_tuple(-a, -x0, -y0);
+  }
+  return std::make_tuple(a, x0, y0);
+}
+
+/// \brief Return `floor(a / b)`, for b > 0
+Index floor_div(Index a, Index b) {
+  Index q = a / b;
+  if (a % b != 0 && a < 0) {
+    --q;
+  }
+  return q;
+}
+
+/// \brief The order of Hermite normal forms: diagonal, then off-diagonal,
+///     lexicographically
+std::array<Index, 6> hnf_order_key(Eigen::Matrix3l const &H) {
+  return {H(0, 0), H(1, 1), H(2, 2), H(0, 1), H(0, 2), H(1, 2)};
+}
+
+}  // namespace
+
 /// \brief Return true if supercell lattice is right-handed lattice in
 ///     canonical form
 bool is_canonical(Supercell const &supercell) {
@@ -75,6 +197,220 @@ std::vector<std::shared_ptr<Supercell const>> make_equivalents(
   return result;
 }
 
+/// \brief Return symmetry operations as integer matrices that transform
+///     supercell transformation matrices
+///
+/// For each operation the result is `R = L^-1 * op.matrix * L`, where `L`
+/// is the prim lattice column matrix, so that the superlattice `L * T` is
+/// transformed to `L * (R * T)`. Operations of the prim point group, or the
+/// point operations of the prim factor group, give integer `R`.
+///
+/// The result only needs to be made once per prim and can then be used with
+/// `make_canonical_hnf`, `make_equivalent_hnfs`, and
+/// `find_frac_op_index_to_supercell` without floating point comparisons.
+std::vector<Eigen::Matrix3l> make_frac_point_matrices(
+    Lattice const &prim_lattice, std::vector<SymOp> const &ops) {
+  std::vector<Eigen::Matrix3l> result;
+  result.reserve(ops.size());
+  for (auto const &op : ops) {
+    result.push_back(lround(prim_lattice.inv_lat_column_mat() * op.matrix *
+                            prim_lattice.lat_column_mat()));
+  }
+  return result;
+}
+
+/// \brief Return the Hermite normal form of a supercell transformation
+///     matrix
+///
+/// The result, `H = T * V`, where `V` is unimodular, is upper triangular,
+/// with `H(i, i) > 0` and `0 <= H(i, j) < H(i, i)` for `j > i`. Because only
+/// column operations are used, `H` is the same for all `T` that generate
+/// the same superlattice points, regardless of the choice or handedness of
+/// the superlattice vectors. `T` must be non-singular.
+Eigen::Matrix3l make_hnf(Eigen::Matrix3l transformation_matrix_to_super) {
+  Eigen::Matrix3l &M = transformation_matrix_to_super;
+
+  // zero the entries left of the diagonal, from the last row up, so that
+  // column operations for a row do not change rows below it
+  for (Index r = 2; r >= 0; --r) {
+    for (Index c = 0; c < r; ++c) {
+      if (M(r, c) == 0) {
+        continue;
+      }
+      Index g, x, y;
+      std::tie(g, x, y) = extended_gcd(M(r, r), M(r, c));
+      Index p = M(r, r) / g;
+      Index q = M(r, c) / g;
+      Eigen::Vector3l col_r = M.col(r);
+      Eigen::Vector3l col_c = M.col(c);
+      M.col(r) = x * col_r + y * col_c;
+      M.col(c) = p * col_c - q * col_r;
+    }
+    if (M(r, r) < 0) {
+      M.col(r) *= -1;
+    }
+  }
+
+  // reduce the entries right of the diagonal, from the last row up, so that
+  // reducing a row does not change the rows above it that are reduced later
+  for (Index r = 1; r >= 0; --r) {
+    for (Index c = r + 1; c < 3; ++c) {
+      M.col(c) -= floor_div(M(r, c), M(r, r)) * M.col(r);
+    }
+  }
+  return M;
+}
+
+/// \brief Return the least Hermite normal form of the symmetrically
+///     equivalent supercell transformation matrices
+///
+/// \param transformation_matrix_to_super A non-singular supercell
+///     transformation matrix, `T`
+/// \param frac_point_group The prim point group operations, as by
+///     `make_frac_point_matrices`
+///
+/// \returns The least `make_hnf(R * T)`, for `R` in `frac_point_group`,
+///     ordering by the diagonal and then the off-diagonal elements,
+///     lexicographically. This is the supercell `ScelEnum` visits for the
+///     same volume with `dirs="abc"` and no `unit_cell`.
+///
+/// Notes:
+/// - Two supercells are equivalent if and only if they have the same
+///   canonical HNF, so it can be used as an exact, integer key for the
+///   equivalence class. It is not in general the transformation matrix of
+///   `make_canonical_form(supercell)`, which chooses the canonical lattice
+///   by comparing lattice vectors.
+/// - No memory is allocated.
+Eigen::Matrix3l make_canonical_hnf(
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    std::vector<Eigen::Matrix3l> const &frac_point_group) {
+  Eigen::Matrix3l canonical = make_hnf(transformation_matrix_to_super);
+  auto canonical_key = hnf_order_key(canonical);
+  for (auto const &R : frac_point_group) {
+    Eigen::Matrix3l H = make_hnf(R * transformation_matrix_to_super);
+    auto key = hnf_order_key(H);
+    if (key < canonical_key) {
+      canonical = H;
+      canonical_key = key;
+    }
+  }
+  return canonical;
+}
+
+/// \brief Return the distinct Hermite normal forms of the symmetrically
+///     equivalent supercell transformation matrices
+///
+/// \param transformation_matrix_to_super A non-singular supercell
+///     transformation matrix, `T`
+/// \param frac_point_group The prim point group operations, as by
+///     `make_frac_point_matrices`
+///
+/// \returns The distinct `make_hnf(R * T)`, for `R` in `frac_point_group`,
+///     in the order of `make_canonical_hnf`, so the first is the canonical
+///     HNF. There is one for each distinct superlattice, the same number as
+///     `make_equivalents(supercell)`.
+std::vector<Eigen::Matrix3l> make_equivalent_hnfs(
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    std::vector<Eigen::Matrix3l> const &frac_point_group) {
+  std::vector<std::array<Index, 6>> keys;
+  keys.reserve(frac_point_group.size());
+  for (auto const &R : frac_point_group) {
+    keys.push_back(
+        hnf_order_key(make_hnf(R * transformation_matrix_to_super)));
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  std::vector<Eigen::Matrix3l> result;
+  result.reserve(keys.size());
+  for (auto const &key : keys) {
+    Eigen::Matrix3l H;
+    H << key[0], key[3], key[4], 0, key[1], key[5], 0, 0, key[2];
+    result.push_back(H);
+  }
+  return result;
+}
+
+/// \brief Return the index of the first operation that transforms a
+///     supercell to an equivalent supercell, or -1
+///
+/// \param current_transformation_matrix_to_super The non-singular
+///     transformation matrix of the supercell to transform
+/// \param new_transformation_matrix_to_super The non-singular
+///     transformation matrix of the equivalent supercell
+/// \param frac_ops Operations, as by `make_frac_point_matrices`, for
+///     example the point operations of the prim factor group
+///
+/// \returns The least index `i` for which `frac_ops[i] * current` and
+///     `new` generate the same superlattice, or -1 if there is none. With
+///     the prim factor group this is the exact, integer equivalent of
+///     `prim_factor_group_index_to_supercell`.
+Index find_frac_op_index_to_supercell(
+    Eigen::Matrix3l const &current_transformation_matrix_to_super,
+    Eigen::Matrix3l const &new_transformation_matrix_to_super,
+    std::vector<Eigen::Matrix3l> const &frac_ops) {
+  Eigen::Matrix3l H = make_hnf(new_transformation_matrix_to_super);
+  for (Index i = 0; i < frac_ops.size(); ++i) {
+    if (make_hnf(frac_ops[i] * current_transformation_matrix_to_super) == H) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/// \brief Return the canonical forms of many configurations in the same
+///     supercell
+///
+/// Equivalent to calling `make_canonical_form(configuration,
+/// SupercellSymOp::begin(supercell), SupercellSymOp::end(supercell))` for
+/// each configuration, but faster for many configurations:
+/// - For occupation-only prims, one OccCanonicalizer per thread is used for
+///   all configurations
+/// - Otherwise, configurations are processed in blocks, with operations in
+///   the outer loop, so that each operation's translation permutation is
+///   made once per block and re-used while in cache
+/// - If NUMA replication is enabled, each chunk uses the symmetry tables
+///   local to its thread's node (see `set_numa_replication_enabled`)
+///
+/// \param configurations Configurations to make canonical. All must have a
+///     supercell equal to `supercell`.
+/// \param supercell The shared supercell
+/// \param n_threads Number of threads to use. If <= 0, uses
+///     `std::thread::hardware_concurrency()`.
+/// \param to_canonical_op_indices If not nullptr, set to the index of the
+///     first operation that makes each configuration canonical, in the order
+///     of iterating from `SupercellSymOp::begin(supercell)`. An index `k`
+///     corresponds to `SupercellSymOp(supercell, k / n_translations, k %
+///     n_translations)`, where `n_translations ==
+///     supercell->unitcell_index_converter.total_sites()`.
+///
+/// \returns The canonical configurations, in the same order as
+///     `configurations`
+std::vector<Configuration> make_canonical_forms(
+    std::vector<Configuration> const &configurations,
+    std::shared_ptr<Supercell const> const &supercell, Index n_threads,
+    std::vector<Index> *to_canonical_op_indices) {
+  for (auto const &configuration : configurations) {
+    if (*configuration.supercell != *supercell) {
+      throw std::runtime_error(
+          "Error in make_canonical_forms: configuration supercell does not "
+          "match");
+    }
+  }
+  std::vector<Configuration> canonical(configurations);
+  std::vector<Index> op_index(configurations.size(), 0);
+  parallel_for_chunks(configurations.size(), n_threads,
+                      [&](Index chunk_index, Index begin, Index end) {
+                        find_canonical_forms(configurations,
+                                             local_supercell(supercell), begin,
+                                             end, canonical, op_index);
+                      });
+  if (to_canonical_op_indices) {
+    *to_canonical_op_indices = std::move(op_index);
+  }
+  return canonical;
+}
+
 /// \brief Return true if the operation does not mix given sites and other sites
 bool site_indices_are_invariant(SupercellSymOp const &op,
                                 std::set<Index> const &site_indices) {
@@ -88,5 +424,116 @@ bool site_indices_are_invariant(SupercellSymOp const &op,
   });
 }
 
+/// \brief Return true if the operation does not mix given sites and other
+/// sites
+///
+/// Same as `site_indices_are_invariant(SupercellSymOp const &,
+/// std::set<Index> const &)`, with set membership checked using a bit set.
+/// Sites with index `>= site_indices.size()` are not in the set.
+bool site_indices_are_invariant(SupercellSymOp const &op,
+                                group::IndexBitset const &site_indices) {
+  for (Index s = site_indices.find_first(); s != group::IndexBitset::npos;
+       s = site_indices.find_next(s)) {
+    Index permuted = op.permute_index(s);
+    if (permuted >= site_indices.size() || !site_indices.contains(permuted)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Return the supercell operations that leave configuration
+///     invariant, finding the invariant translations first
+///
+/// Equivalent to `make_invariant_subgroup(configuration, begin, end)` with
+/// all supercell operations, including the order of the result:
+/// - The invariant translations, H, are found first, as by `is_primitive`
+/// - For each supercell factor group operation, the translations that
+///   together with it leave the configuration invariant are either none
+///   or a coset `t + H`, so only one translation per coset of H is
+///   compared, and the first invariant one determines the rest
+///
+/// This makes `n_fg * n_translations / |H|` comparisons, rather than
+/// `n_fg * n_translations`.
+std::vector<SupercellSymOp> make_invariant_subgroup(
+    Configuration const &configuration) {
+  auto const &supercell = configuration.supercell;
+  auto const &converter = supercell->unitcell_index_converter;
+  Index n_translations = converter.total_sites();
+  std::vector<Index> invariant_translations =
+      make_invariant_translations(configuration);
+
+  // translation coset representatives, and the cosets
+  std::vector<bool> visited(n_translations, false);
+  std::vector<std::vector<Index>> cosets;
+  for (Index t = 0; t < n_translations; ++t) {
+    if (visited[t]) {
+      continue;
+    }
+    std::vector<Index> coset;
+    UnitCell translation = converter(t);
+    for (Index h : invariant_translations) {
+      Index k = converter(UnitCell(translation + converter(h)));
+      visited[k] = true;
+      coset.push_back(k);
+    }
+    std::sort(coset.begin(), coset.end());
+    cosets.push_back(std::move(coset));
+  }
+
+  std::vector<SupercellSymOp> subgroup;
+  Index n_fg = supercell->sym_info().factor_group->element.size();
+  ConfigIsEquivalent equal_to_f(configuration);
+  equal_to_f.visit([&](auto const &f) {
+    SupercellSymOp op = SupercellSymOp::begin(supercell);
+    for (Index fg = 0; fg < n_fg; ++fg) {
+      for (auto const &coset : cosets) {
+        op.reset(fg, coset[0]);
+        CASM_CONFIG_COUNT(comparisons);
+        if (!f(op)) {
+          continue;
+        }
+        for (Index t : coset) {
+          subgroup.emplace_back(supercell, fg, t);
+        }
+        break;
+      }
+    }
+  });
+  return subgroup;
+}
+
+/// \brief Return the subgroup of a supercell group that leaves
+///     configuration invariant
+///
+/// \param configuration The configuration
+/// \param supercell_symgroup A group of operations of the configuration's
+///     supercell, such as from `make_supercell_symgroup`, or a subgroup
+///
+/// \returns The subgroup of `supercell_symgroup`, with its multiplication
+///     table, whose elements satisfy
+///     `configuration == copy_apply(op, configuration)`
+std::shared_ptr<SupercellSymGroup const> make_invariant_subgroup(
+    Configuration const &configuration,
+    std::shared_ptr<SupercellSymGroup const> const &supercell_symgroup) {
+  ConfigIsEquivalent equal_to_f(configuration);
+  SupercellSymOp op = SupercellSymOp::begin(configuration.supercell);
+  std::set<Index> head_group_index;
+  for (Index i = 0; i < supercell_symgroup->element.size(); ++i) {
+    SupercellSymOpHandle const &handle = supercell_symgroup->element[i];
+    if (handle.supercell() != configuration.supercell.get()) {
+      throw std::runtime_error(
+          "Error in make_invariant_subgroup: supercell mismatch");
+    }
+    op.reset(handle.supercell_factor_group_index(),
+             handle.translation_index());
+    if (equal_to_f(op)) {
+      head_group_index.insert(i);
+    }
+  }
+  return std::make_shared<SupercellSymGroup const>(supercell_symgroup,
+                                                   head_group_index);
+}
+
 }  // namespace config
 }  // namespace CASM
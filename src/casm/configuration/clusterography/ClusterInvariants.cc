@@ -3,59 +3,78 @@
 #include "casm/configuration/clusterography/IntegralCluster.hh"
 #include "casm/crystallography/BasicStructure.hh"
 #include "casm/crystallography/Coordinate.hh"
+#include "casm/crystallography/Lattice.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
 #include "casm/misc/CASM_math.hh"
 
 namespace CASM {
 namespace clust {
 
-/// \brief Construct and calculate cluster invariants
-ClusterInvariants::ClusterInvariants(
-    IntegralCluster const &cluster,
-    xtal::BasicStructure const &basicstructure) {
-  // save size of cluster
-  m_size = cluster.size();
-
-  // calculate distances between points
-  for (int i = 0; i < m_size; i++) {
-    for (int j = i + 1; j < m_size; j++) {
-      m_distances.push_back((cluster[i].coordinate(basicstructure) -
-                             cluster[j].coordinate(basicstructure))
-                                .const_cart()
-                                .norm());
+namespace {  // anonymous
+
+/// \brief Append sorted distances between columns of `cart`
+void append_distances(std::vector<double> &distances,
+                      Eigen::Ref<Eigen::Matrix3Xd const> const &cart) {
+  Index n = cart.cols();
+  distances.reserve(distances.size() + n * (n - 1) / 2);
+  for (Index i = 0; i < n; i++) {
+    for (Index j = i + 1; j < n; j++) {
+      distances.push_back((cart.col(i) - cart.col(j)).norm());
     }
   }
-  std::sort(m_distances.begin(), m_distances.end());
+  std::sort(distances.begin(), distances.end());
 }
 
+/// \brief Append sorted distances between columns of `A` and columns of `B`
+void append_distances(std::vector<double> &distances,
+                      Eigen::Ref<Eigen::Matrix3Xd const> const &A,
+                      Eigen::Ref<Eigen::Matrix3Xd const> const &B) {
+  distances.reserve(distances.size() + A.cols() * B.cols());
+  for (Index i = 0; i < A.cols(); i++) {
+    for (Index j = 0; j < B.cols(); j++) {
+      distances.push_back((A.col(i) - B.col(j)).norm());
+    }
+  }
+  std::sort(distances.begin(), distances.end());
+}
+
+}  // namespace
+
+/// \brief Construct and calculate cluster invariants
+ClusterInvariants::ClusterInvariants(
+    IntegralCluster const &cluster, xtal::BasicStructure const &basicstructure)
+    : ClusterInvariants(ClusterInvariantsCalculator(basicstructure)(cluster)) {}
+
 /// \brief Construct and calculate cluster invariants,
 ///     including phenomenal cluster sites
 ClusterInvariants::ClusterInvariants(
     IntegralCluster const &cluster, IntegralCluster const &phenomenal,
-    xtal::BasicStructure const &basicstructure) {
-  // save size of cluster
-  m_size = cluster.size();
-
-  // calculate distances between points
-  for (int i = 0; i < m_size; i++) {
-    for (int j = i + 1; j < m_size; j++) {
-      m_distances.push_back((cluster[i].coordinate(basicstructure) -
-                             cluster[j].coordinate(basicstructure))
-                                .const_cart()
-                                .norm());
-    }
-  }
-  std::sort(m_distances.begin(), m_distances.end());
-
-  // calculate distances between points and phenom sites
-  for (int i = 0; i < cluster.size(); i++) {
-    for (int j = 0; j < phenomenal.size(); j++) {
-      m_phenom_distances.push_back((cluster[i].coordinate(basicstructure) -
-                                    phenomenal[j].coordinate(basicstructure))
-                                       .const_cart()
-                                       .norm());
-    }
-  }
-  std::sort(m_phenom_distances.begin(), m_phenom_distances.end());
+    xtal::BasicStructure const &basicstructure)
+    : ClusterInvariants(
+          ClusterInvariantsCalculator(basicstructure)(cluster, phenomenal)) {}
+
+/// \brief Construct and calculate cluster invariants from the Cartesian
+///     coordinates of the cluster sites
+///
+/// \param cart Cartesian coordinates of the cluster sites, as columns
+ClusterInvariants::ClusterInvariants(
+    Eigen::Ref<Eigen::Matrix3Xd const> const &cart)
+    : m_size(cart.cols()) {
+  append_distances(m_distances, cart);
+}
+
+/// \brief Construct and calculate cluster invariants from the Cartesian
+///     coordinates of the cluster sites and phenomenal cluster sites
+///
+/// \param cart Cartesian coordinates of the cluster sites, as columns
+/// \param phenomenal_cart Cartesian coordinates of the phenomenal cluster
+///     sites, as columns
+ClusterInvariants::ClusterInvariants(
+    Eigen::Ref<Eigen::Matrix3Xd const> const &cart,
+    Eigen::Ref<Eigen::Matrix3Xd const> const &phenomenal_cart)
+    : m_size(cart.cols()) {
+  append_distances(m_distances, cart);
+  append_distances(m_phenom_distances, cart, phenomenal_cart);
 }
 
 /// \brief Number of elements in the cluster
@@ -138,6 +157,50 @@ bool compare(ClusterInvariants const &A, ClusterInvariants const &B,
   return false;
 }
 
+ClusterInvariantsCalculator::ClusterInvariantsCalculator(
+    xtal::BasicStructure const &basicstructure)
+    : m_lat_column_mat(basicstructure.lattice().lat_column_mat()),
+      m_basis_cart(3, basicstructure.basis().size()) {
+  for (Index b = 0; b < basicstructure.basis().size(); ++b) {
+    m_basis_cart.col(b) = basicstructure.basis()[b].const_cart();
+  }
+}
+
+/// \brief Cartesian coordinate of a site
+Eigen::Vector3d ClusterInvariantsCalculator::cart(
+    xtal::UnitCellCoord const &site) const {
+  return m_basis_cart.col(site.sublattice()) +
+         m_lat_column_mat * site.unitcell().cast<double>();
+}
+
+/// \brief Cartesian coordinates of sites, as columns
+Eigen::Matrix3Xd ClusterInvariantsCalculator::cart(
+    std::vector<xtal::UnitCellCoord> const &sites) const {
+  Eigen::Matrix3Xd result(3, sites.size());
+  for (Index i = 0; i < sites.size(); ++i) {
+    result.col(i) = cart(sites[i]);
+  }
+  return result;
+}
+
+/// \brief Cartesian coordinates of cluster sites, as columns
+Eigen::Matrix3Xd ClusterInvariantsCalculator::cart(
+    IntegralCluster const &cluster) const {
+  return cart(cluster.elements());
+}
+
+/// \brief Calculate cluster invariants
+ClusterInvariants ClusterInvariantsCalculator::operator()(
+    IntegralCluster const &cluster) const {
+  return ClusterInvariants(cart(cluster));
+}
+
+/// \brief Calculate cluster invariants, including phenomenal cluster sites
+ClusterInvariants ClusterInvariantsCalculator::operator()(
+    IntegralCluster const &cluster, IntegralCluster const &phenomenal) const {
+  return ClusterInvariants(cart(cluster), cart(phenomenal));
+}
+
 bool CompareCluster_f::operator()(pair_type const &A,
                                   pair_type const &B) const {
   if (compare(A.first, B.first, xtal_tol)) {
@@ -2,6 +2,9 @@
 
 #include "casm/configuration/clusterography/ClusterInvariants.hh"
 #include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/clusterography/SiteNeighborList.hh"
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/configuration/group/Group.hh"
 #include "casm/configuration/sym_info/unitcellcoord_sym_info.hh"
 #include "casm/container/Counter.hh"
 #include "casm/crystallography/BasicStructure.hh"
@@ -11,51 +14,6 @@ namespace clust {
 
 namespace {
 
-/// \brief Output the neighborhood of UnitCellCoord within max_radius of any
-/// site in unit cell
-///
-/// \param unit The unit cell xtal::BasicStructure
-/// \param max_radius The neighborhood distance cutoff
-/// \param site_filter A filter function that returns true for CoordType that
-///        should be considered for the neighborhood
-/// \param result Output iterator for container of UnitCellCoord
-/// \param xtal_tol Crystallography tolerance used to contstruct UnitCellCoord
-/// from CoordType
-///
-/// \returns Output iterator after generating the neighborhood
-///
-/// \ingroup IntegralCluster
-///
-template <typename OutputIterator>
-OutputIterator neighborhood(xtal::BasicStructure const &unit, double max_radius,
-                            SiteFilterFunction site_filter,
-                            OutputIterator result, double xtal_tol) {
-  auto dim = unit.lattice().enclose_sphere(max_radius);
-  EigenCounter<Eigen::Vector3i> grid_count(-dim, dim,
-                                           Eigen::Vector3i::Constant(1));
-  xtal::Coordinate lat_point(unit.lattice());
-  const auto &basis = unit.basis();
-
-  do {
-    lat_point.frac() = grid_count().cast<double>();
-
-    for (auto it = basis.begin(); it != basis.end(); ++it) {
-      if (!site_filter(*it)) {
-        continue;
-      }
-
-      xtal::Coordinate test(*it + lat_point);
-      auto within_radius = [&](const xtal::Coordinate &coord) {
-        return test.dist(coord) < max_radius;
-      };
-      if (std::any_of(basis.begin(), basis.end(), within_radius)) {
-        *result++ = xtal::UnitCellCoord::from_coordinate(unit, test, xtal_tol);
-      }
-    }
-  } while (++grid_count);
-  return result;
-}
-
 /// \brief Output the neighborhood of sites within cutoff_radius of any sites in
 /// the phenomenal
 ///
@@ -231,11 +189,8 @@ class MaxLengthNeighborhood {
 
   std::vector<xtal::UnitCellCoord> operator()(xtal::BasicStructure const &prim,
                                               SiteFilterFunction site_filter) {
-    std::vector<xtal::UnitCellCoord> result;
-    double xtal_tol = prim.lattice().tol();
-    neighborhood(prim, max_length, site_filter, std::back_inserter(result),
-                 xtal_tol);
-    return result;
+    return SiteNeighborList(prim, max_length, site_filter)
+        .origin_neighborhood(max_length);
   }
 
  private:
@@ -322,5 +277,63 @@ CandidateSitesFunction cutoff_radius_neighborhood(
                                                      include_phenomenal_sites};
 }
 
+/// \brief Make cluster orbits, as specified by ClusterSpecs
+///
+/// \param cluster_specs Specifies the prim, generating group, site filter,
+///     and branch specs. If `cluster_specs.phenomenal` has a value,
+///     local-cluster orbits are generated, otherwise prim periodic orbits
+///     are generated.
+/// \param n_threads Number of threads used to generate prim periodic
+///     orbits. Not used for local-cluster orbits.
+///
+/// \returns orbits, where `orbits[i]` is the i-th orbit
+std::vector<std::set<IntegralCluster>> make_orbits(
+    ClusterSpecs const &cluster_specs, Index n_threads) {
+  auto unitcellcoord_symgroup_rep = sym_info::make_unitcellcoord_symgroup_rep(
+      cluster_specs.generating_group->element, *cluster_specs.prim);
+  if (cluster_specs.phenomenal.has_value()) {
+    return make_local_orbits(
+        cluster_specs.prim, unitcellcoord_symgroup_rep,
+        cluster_specs.site_filter, cluster_specs.max_length,
+        cluster_specs.custom_generators, cluster_specs.phenomenal.value(),
+        cluster_specs.cutoff_radius, cluster_specs.include_phenomenal_sites);
+  } else {
+    return make_prim_periodic_orbits(
+        cluster_specs.prim, unitcellcoord_symgroup_rep,
+        cluster_specs.site_filter, cluster_specs.max_length,
+        cluster_specs.custom_generators, n_threads);
+  }
+}
+
+/// \brief Extend prim periodic cluster orbits to the max_length specified
+///     by ClusterSpecs
+///
+/// \param prev_orbits Orbits generated with `cluster_specs`, except using
+///     `prev_max_length`.
+/// \param prev_max_length The `max_length` used to generate `prev_orbits`.
+///     Must satisfy `prev_max_length[branch] <= cluster_specs.max_length[
+///     branch]` for all branches in both.
+/// \param cluster_specs Specifies the prim, generating group, site filter,
+///     and branch specs. Local-cluster orbits are not supported, so throws
+///     if `cluster_specs.phenomenal` has a value.
+///
+/// \returns orbits, equal to `make_orbits(cluster_specs)`, generated by
+///     `extend_prim_periodic_orbits`
+std::vector<std::set<IntegralCluster>> extend_orbits(
+    std::vector<std::set<IntegralCluster>> const &prev_orbits,
+    std::vector<double> const &prev_max_length,
+    ClusterSpecs const &cluster_specs) {
+  if (cluster_specs.phenomenal.has_value()) {
+    throw std::runtime_error(
+        "Error in extend_orbits: local-cluster orbits are not supported");
+  }
+  auto unitcellcoord_symgroup_rep = sym_info::make_unitcellcoord_symgroup_rep(
+      cluster_specs.generating_group->element, *cluster_specs.prim);
+  return extend_prim_periodic_orbits(
+      prev_orbits, prev_max_length, cluster_specs.prim,
+      unitcellcoord_symgroup_rep, cluster_specs.site_filter,
+      cluster_specs.max_length, cluster_specs.custom_generators);
+}
+
 }  // namespace clust
 }  // namespace CASM
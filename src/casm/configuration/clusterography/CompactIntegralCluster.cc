@@ -0,0 +1,182 @@
+#include "casm/configuration/clusterography/CompactIntegralCluster.hh"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+
+namespace CASM {
+namespace clust {
+
+namespace {  // anonymous
+
+/// \brief Convert to int32, throwing if the value does not fit
+std::int32_t to_int32(long value) {
+  if (value < std::numeric_limits<std::int32_t>::min() ||
+      value > std::numeric_limits<std::int32_t>::max()) {
+    throw std::runtime_error(
+        "Error in CompactIntegralCluster: index value does not fit in int32");
+  }
+  return static_cast<std::int32_t>(value);
+}
+
+/// \brief Combine a value into an FNV-1a hash
+void hash_combine(std::uint64_t &hash, std::uint64_t value) {
+  std::uint64_t const fnv_prime = 1099511628211ULL;
+  for (int i = 0; i < 8; ++i) {
+    hash ^= (value >> (8 * i)) & 0xff;
+    hash *= fnv_prime;
+  }
+}
+
+}  // namespace
+
+/// \brief Construct an empty cluster
+CompactIntegralCluster::CompactIntegralCluster() : m_size(0), m_data{} {}
+
+/// \brief Construct from an IntegralCluster
+///
+/// Throws if `cluster.size() > max_size`, or if a unit cell or sublattice
+/// index does not fit in int32.
+CompactIntegralCluster::CompactIntegralCluster(IntegralCluster const &cluster)
+    : m_size(0), m_data{} {
+  if (cluster.size() > max_size) {
+    throw std::runtime_error(
+        "Error in CompactIntegralCluster: cluster size > max_size");
+  }
+  m_size = cluster.size();
+  std::int32_t *value = m_data.data();
+  for (auto const &site : cluster.elements()) {
+    *value++ = to_int32(site.unitcell()(0));
+    *value++ = to_int32(site.unitcell()(1));
+    *value++ = to_int32(site.unitcell()(2));
+    *value++ = to_int32(site.sublattice());
+  }
+}
+
+/// \brief Return the i-th site
+xtal::UnitCellCoord CompactIntegralCluster::element(Index i) const {
+  std::int32_t const *value = m_data.data() + 4 * i;
+  return xtal::UnitCellCoord(value[3], value[0], value[1], value[2]);
+}
+
+/// \brief Convert to IntegralCluster
+IntegralCluster CompactIntegralCluster::to_integral_cluster() const {
+  std::vector<xtal::UnitCellCoord> elements;
+  elements.reserve(m_size);
+  for (Index i = 0; i < m_size; ++i) {
+    elements.push_back(element(i));
+  }
+  return IntegralCluster(std::move(elements));
+}
+
+/// \brief Sort sites, as IntegralCluster::sort
+CompactIntegralCluster &CompactIntegralCluster::sort() {
+  // insertion sort of packed sites, which is fast for small clusters
+  std::int32_t *value = m_data.data();
+  for (Index i = 1; i < m_size; ++i) {
+    for (Index j = i; j > 0; --j) {
+      std::int32_t *curr = value + 4 * j;
+      std::int32_t *prev = curr - 4;
+      if (!std::lexicographical_compare(curr, curr + 4, prev, prev + 4)) {
+        break;
+      }
+      std::swap_ranges(curr, curr + 4, prev);
+    }
+  }
+  return *this;
+}
+
+/// \brief Translate the cluster by a UnitCell translation
+CompactIntegralCluster &CompactIntegralCluster::operator+=(
+    xtal::UnitCell const &trans) {
+  for (Index i = 0; i < m_size; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      m_data[4 * i + j] = to_int32(m_data[4 * i + j] + trans(j));
+    }
+  }
+  return *this;
+}
+
+/// \brief Translate the cluster by a UnitCell translation
+CompactIntegralCluster &CompactIntegralCluster::operator-=(
+    xtal::UnitCell const &trans) {
+  for (Index i = 0; i < m_size; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      m_data[4 * i + j] = to_int32(m_data[4 * i + j] - trans(j));
+    }
+  }
+  return *this;
+}
+
+/// \brief Compare as IntegralCluster: by size, then lexicographically
+///     by site
+///
+/// Sites compare as xtal::UnitCellCoord, by unit cell and then sublattice,
+/// which is lexicographic order of the packed (i, j, k, b) values.
+bool CompactIntegralCluster::operator<(CompactIntegralCluster const &B) const {
+  if (m_size != B.m_size) {
+    return m_size < B.m_size;
+  }
+  return std::lexicographical_compare(m_data.begin(),
+                                      m_data.begin() + 4 * m_size,
+                                      B.m_data.begin(),
+                                      B.m_data.begin() + 4 * B.m_size);
+}
+
+bool CompactIntegralCluster::eq_impl(CompactIntegralCluster const &B) const {
+  return m_size == B.m_size && m_data == B.m_data;
+}
+
+std::size_t CompactIntegralClusterHash::operator()(
+    CompactIntegralCluster const &cluster) const {
+  std::uint64_t hash = 14695981039346656037ULL;
+  std::int32_t const *value = cluster.data();
+  for (Index i = 0; i < 4 * cluster.size(); ++i) {
+    hash_combine(hash, static_cast<std::uint32_t>(value[i]));
+  }
+  return hash;
+}
+
+/// \brief Convert an orbit of IntegralCluster to a sorted vector of
+///     CompactIntegralCluster
+///
+/// The order of `orbit` is preserved, so the result is sorted and can be
+/// searched with `std::lower_bound` or `std::binary_search`.
+std::vector<CompactIntegralCluster> make_compact_orbit(
+    std::set<IntegralCluster> const &orbit) {
+  std::vector<CompactIntegralCluster> compact_orbit;
+  compact_orbit.reserve(orbit.size());
+  for (auto const &cluster : orbit) {
+    compact_orbit.emplace_back(cluster);
+  }
+  return compact_orbit;
+}
+
+/// \brief Convert orbits of IntegralCluster to sorted vectors of
+///     CompactIntegralCluster
+std::vector<std::vector<CompactIntegralCluster>> make_compact_orbits(
+    std::vector<std::set<IntegralCluster>> const &orbits) {
+  std::vector<std::vector<CompactIntegralCluster>> compact_orbits;
+  compact_orbits.reserve(orbits.size());
+  for (auto const &orbit : orbits) {
+    compact_orbits.push_back(make_compact_orbit(orbit));
+  }
+  return compact_orbits;
+}
+
+/// \brief Convert a vector of CompactIntegralCluster to an orbit of
+///     IntegralCluster
+std::set<IntegralCluster> make_integral_cluster_orbit(
+    std::vector<CompactIntegralCluster> const &compact_orbit) {
+  std::set<IntegralCluster> orbit;
+  for (auto const &cluster : compact_orbit) {
+    orbit.insert(orbit.end(), cluster.to_integral_cluster());
+  }
+  return orbit;
+}
+
+}  // namespace clust
+}  // namespace CASM
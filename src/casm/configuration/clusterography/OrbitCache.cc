@@ -0,0 +1,243 @@
+#include "casm/configuration/clusterography/OrbitCache.hh"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/configuration/clusterography/ClusterSpecs.hh"
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/clusterography/io/json/ClusterSpecs_json_io.hh"
+#include "casm/configuration/clusterography/io/binary/Cluster_binary_io.hh"
+#include "casm/configuration/group/Group.hh"
+#include "casm/configuration/memory_usage.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/SymType.hh"
+#include "casm/crystallography/io/BasicStructureIO.hh"
+
+namespace CASM {
+namespace clust {
+
+namespace {
+
+/// \brief Memory used by cached orbits, in bytes (approximate)
+Index orbits_memory_bytes(std::string const &key,
+                          OrbitCache::orbits_type const &orbits) {
+  Index const node_bytes = 4 * sizeof(void *);
+  Index bytes = node_bytes + key.capacity() + sizeof(orbits);
+  for (auto const &orbit : orbits) {
+    bytes += sizeof(orbit);
+    for (auto const &cluster : orbit) {
+      bytes += node_bytes + sizeof(IntegralCluster) +
+               cluster.size() * sizeof(xtal::UnitCellCoord);
+    }
+  }
+  return bytes;
+}
+
+}  // namespace
+
+/// \brief Make a string that uniquely specifies the orbits generated
+///     by ClusterSpecs, or std::nullopt if the site filter is custom
+///
+/// The key is a JSON string containing the prim, the ClusterSpecs as
+/// written by `to_json`, and the generating group elements. Orbits do not
+/// depend on the number of threads used to generate them, so it is not part
+/// of the key.
+std::optional<std::string> make_orbit_cache_key(
+    ClusterSpecs const &cluster_specs) {
+  std::string const &method = cluster_specs.site_filter_method;
+  if (method != "dof_sites" && method != "alloy_sites" &&
+      method != "all_sites") {
+    return std::nullopt;
+  }
+
+  jsonParser json;
+  write_prim(*cluster_specs.prim, json["prim"], FRAC);
+  to_json(cluster_specs, json["cluster_specs"]);
+  jsonParser &elements_json = json["generating_group_elements"].put_array();
+  for (auto const &op : cluster_specs.generating_group->element) {
+    jsonParser op_json;
+    op_json["matrix"] = op.matrix;
+    to_json_array(op.translation, op_json["translation"]);
+    op_json["time_reversal"] = op.is_time_reversal_active;
+    elements_json.push_back(op_json);
+  }
+  std::stringstream ss;
+  ss << json;
+  return ss.str();
+}
+
+/// \brief Make a hexadecimal hash of an orbit cache key
+///
+/// Uses 64-bit FNV-1a, which is stable across platforms and runs, so it can
+/// be used to name orbit files.
+std::string make_orbit_cache_hash(std::string const &key) {
+  std::uint64_t const fnv_prime = 1099511628211ULL;
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : key) {
+    hash ^= c;
+    hash *= fnv_prime;
+  }
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return ss.str();
+}
+
+/// \brief Constructor
+///
+/// \param _cache_dir If not std::nullopt, directory for orbit files. Created
+///     when the first orbit file is written.
+OrbitCache::OrbitCache(std::optional<fs::path> _cache_dir)
+    : m_cache_dir(_cache_dir), m_total_bytes(0) {}
+
+/// \brief Return cluster orbits, as specified by ClusterSpecs
+///
+/// \param cluster_specs Specifies the orbits, as for `clust::make_orbits`
+/// \param n_threads Number of threads used if prim periodic orbits must be
+///     generated
+///
+/// \returns Shared orbits, where `(*orbits)[i]` is the i-th orbit. Equal to
+///     `clust::make_orbits(cluster_specs, n_threads)`.
+std::shared_ptr<OrbitCache::orbits_type const> OrbitCache::make_orbits(
+    ClusterSpecs const &cluster_specs, Index n_threads) {
+  std::optional<std::string> key = make_orbit_cache_key(cluster_specs);
+  if (!key.has_value()) {
+    return std::make_shared<orbits_type const>(
+        clust::make_orbits(cluster_specs, n_threads));
+  }
+
+  std::optional<fs::path> cache_dir;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_orbits.find(*key);
+    if (it != m_orbits.end()) {
+      return it->second;
+    }
+    cache_dir = m_cache_dir;
+  }
+
+  std::shared_ptr<orbits_type const> orbits;
+  if (cache_dir.has_value()) {
+    orbits = _read(*cache_dir, *key, cluster_specs);
+  }
+  if (!orbits) {
+    orbits = std::make_shared<orbits_type const>(
+        clust::make_orbits(cluster_specs, n_threads));
+    if (cache_dir.has_value()) {
+      _write(*cache_dir, *key, cluster_specs, *orbits);
+    }
+  }
+
+  Index bytes = orbits_memory_bytes(*key, *orbits);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto result = m_orbits.emplace(*key, orbits);
+    if (!result.second) {
+      return result.first->second;
+    }
+    m_total_bytes += bytes;
+  }
+  config::enforce_memory_budget();
+  return orbits;
+}
+
+/// \brief Directory for orbit files, or std::nullopt for memory only
+std::optional<fs::path> OrbitCache::cache_dir() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cache_dir;
+}
+
+/// \brief Set the directory for orbit files, or std::nullopt for memory
+///     only
+void OrbitCache::set_cache_dir(std::optional<fs::path> _cache_dir) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cache_dir = _cache_dir;
+}
+
+/// \brief Number of orbit vectors held in memory
+Index OrbitCache::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_orbits.size();
+}
+
+/// \brief Memory used by orbits held in memory, in bytes (approximate)
+///
+/// Counts the sites of each cluster, and a fixed size for each cluster and
+/// container node.
+Index OrbitCache::total_bytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_total_bytes;
+}
+
+/// \brief Clear orbits held in memory, leaving any orbit files
+void OrbitCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_orbits.clear();
+  m_total_bytes = 0;
+}
+
+/// \brief Read orbits from `<cache_dir>/<hash>.orbits`, or return nullptr
+///     if the file does not exist, is not readable, or has a different key
+///
+/// The file is memory-mapped, so processes reading the same orbit file
+/// share it in the page cache.
+std::shared_ptr<OrbitCache::orbits_type const> OrbitCache::_read(
+    fs::path const &cache_dir, std::string const &key,
+    ClusterSpecs const &cluster_specs) const {
+  fs::path path = cache_dir / (make_orbit_cache_hash(key) + ".orbits");
+  if (!fs::exists(path)) {
+    return nullptr;
+  }
+  try {
+    ClusterBinaryReader reader(path);
+    if (reader.key() != key || reader.is_equivalents_info()) {
+      return nullptr;
+    }
+    return std::make_shared<orbits_type const>(reader.orbits());
+  } catch (std::exception const &e) {
+    return nullptr;
+  }
+}
+
+/// \brief Write orbits to `<cache_dir>/<hash>.orbits`, in the compact
+///     cluster binary format
+///
+/// The file is written to a temporary path and then renamed, so readers
+/// never see a partial file. Failure to write is not an error, because the
+/// orbits are still held in memory.
+void OrbitCache::_write(fs::path const &cache_dir, std::string const &key,
+                        ClusterSpecs const &cluster_specs,
+                        orbits_type const &orbits) const {
+  std::string hash = make_orbit_cache_hash(key);
+  std::stringstream tmp_name;
+  tmp_name << hash << ".orbits.tmp."
+           << std::hash<std::thread::id>()(std::this_thread::get_id()) << "."
+           << std::chrono::steady_clock::now().time_since_epoch().count();
+  try {
+    fs::create_directories(cache_dir);
+    fs::path tmp_path = cache_dir / tmp_name.str();
+    {
+      std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+      write_orbits_binary(orbits, out, key);
+    }
+    fs::rename(tmp_path, cache_dir / (hash + ".orbits"));
+  } catch (std::exception const &e) {
+    return;
+  }
+}
+
+/// \brief Process-wide OrbitCache, memory only unless a cache directory
+///     is set
+OrbitCache &default_orbit_cache() {
+  static OrbitCache cache;
+  return cache;
+}
+
+}  // namespace clust
+}  // namespace CASM
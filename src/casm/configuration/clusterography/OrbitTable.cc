@@ -0,0 +1,159 @@
+#include "casm/configuration/clusterography/OrbitTable.hh"
+
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+
+namespace CASM {
+namespace clust {
+
+OrbitTable::OrbitTable()
+    : sites(0, 4),
+      cluster_offsets(Eigen::VectorXl::Zero(1)),
+      orbit_offsets(Eigen::VectorXl::Zero(1)) {}
+
+/// \brief Return cluster `c` as IntegralCluster
+IntegralCluster OrbitTable::cluster(Index c) const {
+  std::vector<xtal::UnitCellCoord> elements;
+  elements.reserve(cluster_size(c));
+  for (Index s = cluster_offsets(c); s < cluster_offsets(c + 1); ++s) {
+    elements.emplace_back(sites(s, 0), sites(s, 1), sites(s, 2), sites(s, 3));
+  }
+  return IntegralCluster(std::move(elements));
+}
+
+/// \brief Make an OrbitTable from orbits of IntegralCluster
+OrbitTable make_orbit_table(
+    std::vector<std::set<IntegralCluster>> const &orbits) {
+  Index n_clusters = 0;
+  Index n_sites = 0;
+  for (auto const &orbit : orbits) {
+    n_clusters += orbit.size();
+    for (auto const &cluster : orbit) {
+      n_sites += cluster.size();
+    }
+  }
+
+  OrbitTable table;
+  table.sites.resize(n_sites, 4);
+  table.cluster_offsets.resize(n_clusters + 1);
+  table.orbit_offsets.resize(orbits.size() + 1);
+  Index s = 0;
+  Index c = 0;
+  Index o = 0;
+  for (auto const &orbit : orbits) {
+    table.orbit_offsets(o++) = c;
+    for (auto const &cluster : orbit) {
+      table.cluster_offsets(c++) = s;
+      for (auto const &site : cluster) {
+        table.sites(s, 0) = site.sublattice();
+        table.sites(s, 1) = site.unitcell()(0);
+        table.sites(s, 2) = site.unitcell()(1);
+        table.sites(s, 3) = site.unitcell()(2);
+        ++s;
+      }
+    }
+  }
+  table.cluster_offsets(c) = s;
+  table.orbit_offsets(o) = c;
+  return table;
+}
+
+/// \brief Convert an OrbitTable to orbits of IntegralCluster
+std::vector<std::set<IntegralCluster>> make_orbits(
+    OrbitTable const &orbit_table) {
+  std::vector<std::set<IntegralCluster>> orbits(orbit_table.n_orbits());
+  for (Index o = 0; o < orbit_table.n_orbits(); ++o) {
+    for (Index c = orbit_table.orbit_offsets(o);
+         c < orbit_table.orbit_offsets(o + 1); ++c) {
+      orbits[o].insert(orbits[o].end(), orbit_table.cluster(c));
+    }
+  }
+  return orbits;
+}
+
+OrbitIndexTable::OrbitIndexTable()
+    : sites(0),
+      cluster_offsets(Eigen::VectorXl::Zero(1)),
+      orbit_offsets(Eigen::VectorXl::Zero(1)) {}
+
+/// \brief Make an OrbitIndexTable from orbits of linear site indices
+OrbitIndexTable make_orbit_index_table(
+    std::vector<std::set<std::set<Index>>> const &orbits_as_indices) {
+  Index n_clusters = 0;
+  Index n_sites = 0;
+  for (auto const &orbit : orbits_as_indices) {
+    n_clusters += orbit.size();
+    for (auto const &cluster : orbit) {
+      n_sites += cluster.size();
+    }
+  }
+
+  OrbitIndexTable table;
+  table.sites.resize(n_sites);
+  table.cluster_offsets.resize(n_clusters + 1);
+  table.orbit_offsets.resize(orbits_as_indices.size() + 1);
+  Index s = 0;
+  Index c = 0;
+  Index o = 0;
+  for (auto const &orbit : orbits_as_indices) {
+    table.orbit_offsets(o++) = c;
+    for (auto const &cluster : orbit) {
+      table.cluster_offsets(c++) = s;
+      for (Index site_index : cluster) {
+        table.sites(s++) = site_index;
+      }
+    }
+  }
+  table.cluster_offsets(c) = s;
+  table.orbit_offsets(o) = c;
+  return table;
+}
+
+/// \brief Make an OrbitIndexTable from an OrbitTable
+///
+/// Equivalent to `make_orbit_index_table(make_orbits_as_indices(orbits,
+/// converter))`.
+OrbitIndexTable make_orbit_index_table(
+    OrbitTable const &orbit_table,
+    xtal::UnitCellCoordIndexConverter const &converter) {
+  std::vector<std::set<std::set<Index>>> orbits_as_indices(
+      orbit_table.n_orbits());
+  for (Index o = 0; o < orbit_table.n_orbits(); ++o) {
+    for (Index c = orbit_table.orbit_offsets(o);
+         c < orbit_table.orbit_offsets(o + 1); ++c) {
+      std::set<Index> cluster_as_indices;
+      for (Index s = orbit_table.cluster_offsets(c);
+           s < orbit_table.cluster_offsets(c + 1); ++s) {
+        auto const &site = orbit_table.sites.row(s);
+        cluster_as_indices.insert(converter(
+            xtal::UnitCellCoord(site(0), site(1), site(2), site(3))));
+      }
+      orbits_as_indices[o].insert(std::move(cluster_as_indices));
+    }
+  }
+  return make_orbit_index_table(orbits_as_indices);
+}
+
+/// \brief Convert an OrbitIndexTable to orbits of linear site indices
+std::vector<std::set<std::set<Index>>> make_orbits_as_indices(
+    OrbitIndexTable const &orbit_index_table) {
+  std::vector<std::set<std::set<Index>>> orbits_as_indices(
+      orbit_index_table.n_orbits());
+  for (Index o = 0; o < orbit_index_table.n_orbits(); ++o) {
+    for (Index c = orbit_index_table.orbit_offsets(o);
+         c < orbit_index_table.orbit_offsets(o + 1); ++c) {
+      std::set<Index> cluster_as_indices;
+      for (Index s = orbit_index_table.cluster_offsets(c);
+           s < orbit_index_table.cluster_offsets(c + 1); ++s) {
+        cluster_as_indices.insert(orbit_index_table.sites(s));
+      }
+      orbits_as_indices[o].insert(orbits_as_indices[o].end(),
+                                  std::move(cluster_as_indices));
+    }
+  }
+  return orbits_as_indices;
+}
+
+}  // namespace clust
+}  // namespace CASM
@@ -0,0 +1,191 @@
+#include "casm/configuration/clusterography/SiteNeighborList.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "casm/container/Counter.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/Coordinate.hh"
+
+namespace CASM {
+namespace clust {
+
+namespace {  // anonymous
+
+/// \brief Combine a value into an FNV-1a hash
+void hash_combine(std::uint64_t &hash, std::uint64_t value) {
+  std::uint64_t const fnv_prime = 1099511628211ULL;
+  for (int i = 0; i < 8; ++i) {
+    hash ^= (value >> (8 * i)) & 0xff;
+    hash *= fnv_prime;
+  }
+}
+
+}  // namespace
+
+std::size_t SiteNeighborList::UnitCellCoordHash::operator()(
+    xtal::UnitCellCoord const &site) const {
+  std::uint64_t hash = 14695981039346656037ULL;
+  hash_combine(hash, site.sublattice());
+  for (Index i = 0; i < 3; ++i) {
+    hash_combine(hash, site.unitcell()(i));
+  }
+  return hash;
+}
+
+/// \brief Constructor
+///
+/// \param prim The prim
+/// \param max_radius Neighbors are sites with distance strictly less than
+///     `max_radius` to a site in the origin unit cell
+/// \param site_filter Function that returns true if a xtal::Site should be
+///     included as a neighbor
+///
+/// Sites are generated by iterating over the lattice points of
+/// `prim.lattice().enclose_sphere(max_radius)`, as for
+/// `max_length_neighborhood`.
+SiteNeighborList::SiteNeighborList(xtal::BasicStructure const &prim,
+                                   double max_radius,
+                                   SiteFilterFunction site_filter)
+    : m_tol(prim.lattice().tol()),
+      m_max_radius(max_radius),
+      m_lattice(prim.lattice()) {
+  auto const &basis = prim.basis();
+  Index n_sublat = basis.size();
+  for (Index b = 0; b < n_sublat; ++b) {
+    m_is_included.push_back(site_filter(basis[b]));
+  }
+  m_neighbors.resize(n_sublat);
+  m_distance.resize(n_sublat);
+
+  auto dim = m_lattice.enclose_sphere(m_max_radius);
+  EigenCounter<Eigen::Vector3i> grid_count(-dim, dim,
+                                           Eigen::Vector3i::Constant(1));
+  xtal::Coordinate lat_point(m_lattice);
+  std::vector<double> distances;
+  do {
+    lat_point.frac() = grid_count().cast<double>();
+    for (Index b = 0; b < n_sublat; ++b) {
+      if (!m_is_included[b]) {
+        continue;
+      }
+      xtal::Coordinate test(basis[b] + lat_point);
+      xtal::UnitCellCoord site =
+          xtal::UnitCellCoord::from_coordinate(prim, test, m_tol);
+      double min_distance = std::numeric_limits<double>::infinity();
+      for (Index b_origin = 0; b_origin < n_sublat; ++b_origin) {
+        double d = test.dist(basis[b_origin]);
+        min_distance = std::min(min_distance, d);
+        if (d < m_max_radius) {
+          m_neighbors[b_origin].push_back(Neighbor{site, d, 0});
+          m_distance[b_origin].emplace(site, d);
+          distances.push_back(d);
+        }
+      }
+      if (min_distance < m_max_radius) {
+        m_neighborhood.push_back(
+            NeighborhoodSite{site, grid_count(), min_distance});
+      }
+    }
+  } while (++grid_count);
+
+  // distinct distances, grouping distances within m_tol of the first in
+  // each shell
+  std::sort(distances.begin(), distances.end());
+  for (double d : distances) {
+    if (m_shells.empty() || d - m_shells.back() > m_tol) {
+      m_shells.push_back(d);
+    }
+  }
+  for (auto &neighbors : m_neighbors) {
+    for (auto &neighbor : neighbors) {
+      auto it = std::upper_bound(m_shells.begin(), m_shells.end(),
+                                 neighbor.distance);
+      neighbor.shell = std::distance(m_shells.begin(), it) - 1;
+    }
+    std::sort(neighbors.begin(), neighbors.end(),
+              [](Neighbor const &lhs, Neighbor const &rhs) {
+                if (lhs.distance != rhs.distance) {
+                  return lhs.distance < rhs.distance;
+                }
+                return lhs.site < rhs.site;
+              });
+  }
+}
+
+/// \brief Maximum distance (exclusive) of stored neighbors
+double SiteNeighborList::max_radius() const { return m_max_radius; }
+
+/// \brief True if sites on sublattice `b` pass the site filter
+bool SiteNeighborList::is_included(Index b) const { return m_is_included[b]; }
+
+/// \brief Distinct neighbor distances, in ascending order, within the
+///     lattice tolerance
+///
+/// Distances within the lattice tolerance of the smallest distance in a
+/// shell are in the same shell, and the shell value is that smallest
+/// distance.
+std::vector<double> const &SiteNeighborList::shells() const {
+  return m_shells;
+}
+
+/// \brief Neighbors of site {b, 0, 0, 0}, sorted by distance
+///
+/// Includes the site itself, with distance 0, if it is included.
+std::vector<SiteNeighborList::Neighbor> const &SiteNeighborList::neighbors(
+    Index b) const {
+  return m_neighbors[b];
+}
+
+/// \brief Included sites within `radius` of any site in the origin unit
+///     cell
+///
+/// The result is the same, in the same order, as
+/// `max_length_neighborhood(radius)(prim, site_filter)`. Throws if
+/// `radius > max_radius()`.
+std::vector<xtal::UnitCellCoord> SiteNeighborList::origin_neighborhood(
+    double radius) const {
+  if (radius > m_max_radius) {
+    throw std::runtime_error(
+        "Error in SiteNeighborList::origin_neighborhood: radius > "
+        "max_radius");
+  }
+  auto dim = m_lattice.enclose_sphere(radius);
+  std::vector<xtal::UnitCellCoord> result;
+  for (auto const &entry : m_neighborhood) {
+    if (entry.min_distance < radius &&
+        (entry.lattice_point.array().abs() <= dim.array()).all()) {
+      result.push_back(entry.site);
+    }
+  }
+  return result;
+}
+
+/// \brief Distance between two sites, or infinity if >= max_radius()
+///
+/// At least one of the sites must be included. Throws if neither is
+/// included.
+double SiteNeighborList::distance(xtal::UnitCellCoord const &site_a,
+                                  xtal::UnitCellCoord const &site_b) const {
+  xtal::UnitCellCoord const *origin = &site_a;
+  xtal::UnitCellCoord const *neighbor = &site_b;
+  if (!m_is_included[neighbor->sublattice()]) {
+    std::swap(origin, neighbor);
+    if (!m_is_included[neighbor->sublattice()]) {
+      throw std::runtime_error(
+          "Error in SiteNeighborList::distance: neither site is included");
+    }
+  }
+  xtal::UnitCellCoord key(neighbor->sublattice(),
+                          neighbor->unitcell() - origin->unitcell());
+  auto const &distance_by_site = m_distance[origin->sublattice()];
+  auto it = distance_by_site.find(key);
+  if (it == distance_by_site.end()) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return it->second;
+}
+
+}  // namespace clust
+}  // namespace CASM
@@ -1,11 +1,36 @@
 #include "casm/configuration/clusterography/impact_neighborhood.hh"
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
 #include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
 #include "casm/crystallography/UnitCellCoord.hh"
 
 namespace CASM {
 namespace clust {
 
+namespace {
+
+/// \brief Sort and remove duplicates
+template <typename T>
+void sort_unique(std::vector<T> &values) {
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+/// \brief Throw if linear site indices do not fit in std::int32_t
+void check_int32_site_indices(
+    xtal::UnitCellCoordIndexConverter const &converter) {
+  if (converter.total_sites() > std::numeric_limits<std::int32_t>::max()) {
+    throw std::runtime_error(
+        "Error in make_supercell_neighborhood_table: too many sites");
+  }
+}
+
+}  // namespace
+
 /// \brief Using prim periodic translation symmetry, add all sites
 ///     that share a cluster with phenomenal sites to neighborhood
 void add_to_flower_neighborhood(IntegralCluster const &phenomenal,
@@ -84,5 +109,187 @@ void add_to_local_neighborhood(
   }
 }
 
+/// \brief Using prim periodic translation symmetry, make the sorted sites
+///     that share a cluster with phenomenal sites
+///
+/// Gives the same sites as `add_to_flower_neighborhood`, starting from an
+/// empty neighborhood, but collects them in a vector that is sorted once.
+std::vector<xtal::UnitCellCoord> make_flower_neighborhood(
+    IntegralCluster const &phenomenal,
+    std::vector<std::set<IntegralCluster>> const &orbits) {
+  std::vector<xtal::UnitCellCoord> neighborhood;
+  for (auto const &orbit : orbits) {
+    for (auto const &cluster : orbit) {
+      for (auto const &site : cluster) {
+        for (auto const &phenom_site : phenomenal) {
+          if (site.sublattice() == phenom_site.sublattice()) {
+            xtal::UnitCell trans = phenom_site.unitcell() - site.unitcell();
+            for (auto const &tsite : cluster) {
+              neighborhood.push_back(tsite + trans);
+            }
+          }
+        }
+      }
+    }
+  }
+  sort_unique(neighborhood);
+  return neighborhood;
+}
+
+/// \brief Make the sorted sites of all clusters in all orbits
+///
+/// Gives the same sites as `add_to_local_neighborhood`, starting from an
+/// empty neighborhood, but collects them in a vector that is sorted once.
+std::vector<xtal::UnitCellCoord> make_local_neighborhood(
+    std::vector<std::set<IntegralCluster>> const &orbits) {
+  std::vector<xtal::UnitCellCoord> neighborhood;
+  for (auto const &orbit : orbits) {
+    for (auto const &cluster : orbit) {
+      for (auto const &site : cluster) {
+        neighborhood.push_back(site);
+      }
+    }
+  }
+  sort_unique(neighborhood);
+  return neighborhood;
+}
+
+NeighborhoodTable::NeighborhoodTable()
+    : sites(0, 4), offsets(Eigen::VectorXl::Zero(1)) {}
+
+/// \brief Make the flower neighborhoods of each site in the origin unit cell
+///
+/// The neighborhoods of all sublattices are found in one pass over the
+/// clusters: for each site on sublattice `b` of each cluster, the cluster,
+/// translated so that site is in the origin unit cell, is added to the
+/// neighborhood of `b`.
+///
+/// \param n_sublattice The number of prim sublattices
+/// \param orbits The prim periodic orbits, typically those associated with
+///     non-zero eci
+///
+/// \returns The neighborhood table, with row `b` equal to
+///     `make_flower_neighborhood(IntegralCluster({{b, 0, 0, 0}}), orbits)`
+NeighborhoodTable make_flower_neighborhood_table(
+    Index n_sublattice, std::vector<std::set<IntegralCluster>> const &orbits) {
+  std::vector<std::vector<xtal::UnitCellCoord>> neighborhoods(n_sublattice);
+  for (auto const &orbit : orbits) {
+    for (auto const &cluster : orbit) {
+      for (auto const &site : cluster) {
+        if (site.sublattice() < 0 || site.sublattice() >= n_sublattice) {
+          throw std::runtime_error(
+              "Error in make_flower_neighborhood_table: invalid sublattice");
+        }
+        auto &neighborhood = neighborhoods[site.sublattice()];
+        xtal::UnitCell trans = -site.unitcell();
+        for (auto const &tsite : cluster) {
+          neighborhood.push_back(tsite + trans);
+        }
+      }
+    }
+  }
+
+  NeighborhoodTable table;
+  table.offsets.resize(n_sublattice + 1);
+  table.offsets(0) = 0;
+  for (Index b = 0; b < n_sublattice; ++b) {
+    sort_unique(neighborhoods[b]);
+    table.offsets(b + 1) = table.offsets(b) + neighborhoods[b].size();
+  }
+  table.sites.resize(table.offsets(n_sublattice), 4);
+  Index s = 0;
+  for (auto const &neighborhood : neighborhoods) {
+    for (auto const &site : neighborhood) {
+      table.sites.row(s) << site.sublattice(), site.unitcell()(0),
+          site.unitcell()(1), site.unitcell()(2);
+      ++s;
+    }
+  }
+  return table;
+}
+
+SupercellNeighborhoodTable::SupercellNeighborhoodTable()
+    : offsets(Eigen::VectorXl::Zero(1)) {}
+
+/// \brief Make the neighborhood of each site in a supercell
+///
+/// Neighborhood `l` is the sorted, distinct linear site indices of the
+/// neighborhood of supercell site `l`, using periodic boundary conditions,
+/// so that the sites affected by a change on site `l` can be looked up
+/// without allocation.
+///
+/// \param neighborhood_table The neighborhood of each site in the origin
+///     unit cell
+/// \param converter The supercell UnitCellCoordIndexConverter
+SupercellNeighborhoodTable make_supercell_neighborhood_table(
+    NeighborhoodTable const &neighborhood_table,
+    xtal::UnitCellCoordIndexConverter const &converter) {
+  check_int32_site_indices(converter);
+  Index n_sites = converter.total_sites();
+  auto const &sites = neighborhood_table.sites;
+
+  // size for the neighborhoods before removing periodic images
+  Index max_size = 0;
+  for (Index l = 0; l < n_sites; ++l) {
+    max_size +=
+        neighborhood_table.neighborhood_size(converter(l).sublattice());
+  }
+
+  SupercellNeighborhoodTable table;
+  table.neighbors.resize(max_size);
+  table.offsets.resize(n_sites + 1);
+  table.offsets(0) = 0;
+  for (Index l = 0; l < n_sites; ++l) {
+    xtal::UnitCellCoord bijk = converter(l);
+    xtal::UnitCell const &unitcell = bijk.unitcell();
+    Index b = bijk.sublattice();
+    std::int32_t *begin = table.neighbors.data() + table.offsets(l);
+    std::int32_t *it = begin;
+    for (Index s = neighborhood_table.offsets(b);
+         s < neighborhood_table.offsets(b + 1); ++s) {
+      xtal::UnitCell trans(sites(s, 1), sites(s, 2), sites(s, 3));
+      *it++ = converter(xtal::UnitCellCoord(sites(s, 0), unitcell + trans));
+    }
+    std::sort(begin, it);
+    table.offsets(l + 1) = table.offsets(l) + (std::unique(begin, it) - begin);
+  }
+  table.neighbors.conservativeResize(table.offsets(n_sites));
+  return table;
+}
+
+/// \brief Make the neighborhoods of sites in a supercell
+///
+/// Neighborhood `r` is the sorted, distinct linear site indices of
+/// `neighborhoods[r]`, using periodic boundary conditions. This can be used
+/// for the local neighborhoods of the phenomenal clusters of local events.
+///
+/// \param neighborhoods The neighborhoods, as sites
+/// \param converter The supercell UnitCellCoordIndexConverter
+SupercellNeighborhoodTable make_supercell_neighborhood_table(
+    std::vector<std::vector<xtal::UnitCellCoord>> const &neighborhoods,
+    xtal::UnitCellCoordIndexConverter const &converter) {
+  check_int32_site_indices(converter);
+  Index max_size = 0;
+  for (auto const &neighborhood : neighborhoods) {
+    max_size += neighborhood.size();
+  }
+
+  SupercellNeighborhoodTable table;
+  table.neighbors.resize(max_size);
+  table.offsets.resize(neighborhoods.size() + 1);
+  table.offsets(0) = 0;
+  for (Index r = 0; r < neighborhoods.size(); ++r) {
+    std::int32_t *begin = table.neighbors.data() + table.offsets(r);
+    std::int32_t *it = begin;
+    for (auto const &site : neighborhoods[r]) {
+      *it++ = converter(site);
+    }
+    std::sort(begin, it);
+    table.offsets(r + 1) = table.offsets(r) + (std::unique(begin, it) - begin);
+  }
+  table.neighbors.conservativeResize(table.offsets(neighborhoods.size()));
+  return table;
+}
+
 }  // namespace clust
 }  // namespace CASM
@@ -0,0 +1,407 @@
+#include "casm/configuration/clusterography/io/binary/Cluster_binary_io.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+
+namespace CASM {
+
+namespace {  // (anonymous)
+
+char const binary_magic[8] = {'C', 'A', 'S', 'M', 'C', 'L', 'S', 'T'};
+std::uint64_t const binary_version = 1;
+std::uint64_t const orbits_kind = 0;
+std::uint64_t const equivalents_info_kind = 1;
+
+/// Size of the header before the key
+Index const header_size = 32;
+
+/// Size of one site in the site table
+Index const site_size = 16;
+
+void put_u64(std::vector<std::uint8_t> &data, std::uint64_t value) {
+  for (int k = 0; k < 8; ++k) {
+    data.push_back(static_cast<std::uint8_t>(value >> (8 * k)));
+  }
+}
+
+void put_i32(std::vector<std::uint8_t> &data, std::int32_t value) {
+  std::uint32_t bits = static_cast<std::uint32_t>(value);
+  for (int k = 0; k < 4; ++k) {
+    data.push_back(static_cast<std::uint8_t>(bits >> (8 * k)));
+  }
+}
+
+std::uint64_t get_u64(std::uint8_t const *data) {
+  std::uint64_t value = 0;
+  for (int k = 0; k < 8; ++k) {
+    value |= static_cast<std::uint64_t>(data[k]) << (8 * k);
+  }
+  return value;
+}
+
+std::int32_t get_i32(std::uint8_t const *data) {
+  std::uint32_t bits = 0;
+  for (int k = 0; k < 4; ++k) {
+    bits |= static_cast<std::uint32_t>(data[k]) << (8 * k);
+  }
+  return static_cast<std::int32_t>(bits);
+}
+
+std::int32_t to_int32(Index value) {
+  if (value < std::numeric_limits<std::int32_t>::min() ||
+      value > std::numeric_limits<std::int32_t>::max()) {
+    throw std::runtime_error(
+        "Error writing cluster binary data: index does not fit in int32");
+  }
+  return static_cast<std::int32_t>(value);
+}
+
+[[noreturn]] void throw_invalid_format() {
+  throw std::runtime_error(
+      "Error reading cluster binary data: invalid format");
+}
+
+/// \brief Write the format, for clusters grouped into orbits
+///
+/// \param op_indices If not null, the generating operation index of each
+///     cluster
+template <typename OrbitIterator>
+void write_cluster_binary(OrbitIterator begin, OrbitIterator end,
+                          std::uint64_t kind,
+                          std::vector<Index> const *op_indices,
+                          std::ostream &out, std::string const &key) {
+  std::vector<std::uint8_t> data;
+  data.insert(data.end(), binary_magic, binary_magic + 8);
+  put_u64(data, binary_version);
+  put_u64(data, kind);
+  put_u64(data, key.size());
+  data.insert(data.end(), key.begin(), key.end());
+
+  Index n_orbits = 0;
+  Index n_clusters = 0;
+  Index n_sites = 0;
+  for (auto it = begin; it != end; ++it) {
+    ++n_orbits;
+    for (auto const &cluster : *it) {
+      ++n_clusters;
+      n_sites += cluster.size();
+    }
+  }
+  put_u64(data, n_orbits);
+  put_u64(data, n_clusters);
+  put_u64(data, n_sites);
+
+  Index c = 0;
+  for (auto it = begin; it != end; ++it) {
+    put_u64(data, c);
+    c += it->size();
+  }
+  put_u64(data, c);
+
+  Index s = 0;
+  for (auto it = begin; it != end; ++it) {
+    for (auto const &cluster : *it) {
+      put_u64(data, s);
+      s += cluster.size();
+    }
+  }
+  put_u64(data, s);
+
+  data.reserve(data.size() + site_size * n_sites + 8 * n_clusters);
+  for (auto it = begin; it != end; ++it) {
+    for (auto const &cluster : *it) {
+      for (auto const &site : cluster.elements()) {
+        put_i32(data, to_int32(site.sublattice()));
+        put_i32(data, to_int32(site.unitcell()(0)));
+        put_i32(data, to_int32(site.unitcell()(1)));
+        put_i32(data, to_int32(site.unitcell()(2)));
+      }
+    }
+  }
+
+  if (op_indices) {
+    for (Index op_index : *op_indices) {
+      put_u64(data, static_cast<std::uint64_t>(op_index));
+    }
+  }
+
+  out.write(reinterpret_cast<char const *>(data.data()), data.size());
+  if (!out) {
+    throw std::runtime_error(
+        "Error writing cluster binary data: write failed");
+  }
+}
+
+}  // namespace
+
+/// \brief Write cluster orbits in the compact cluster binary format
+///
+/// \param orbits The orbits, where `orbits[i]` is the i-th orbit
+/// \param out The output stream
+/// \param key A string identifying the orbits, such as from
+///     `make_orbit_cache_key`, see ClusterBinaryReader
+void write_orbits_binary(
+    std::vector<std::set<clust::IntegralCluster>> const &orbits,
+    std::ostream &out, std::string const &key) {
+  write_cluster_binary(orbits.begin(), orbits.end(), orbits_kind, nullptr,
+                       out, key);
+}
+
+/// \brief Write equivalents info in the compact cluster binary format
+///
+/// \param equivalents_info The equivalents info. The number of phenomenal
+///     clusters and generating operation indices must be equal.
+/// \param out The output stream
+/// \param key A string identifying the equivalents info, see
+///     ClusterBinaryReader
+void write_equivalents_info_binary(
+    clust::EquivalentsInfo const &equivalents_info, std::ostream &out,
+    std::string const &key) {
+  auto const &clusters = equivalents_info.phenomenal_clusters;
+  auto const &op_indices = equivalents_info.equivalent_generating_op_indices;
+  if (clusters.size() != op_indices.size()) {
+    throw std::runtime_error(
+        "Error writing cluster binary data: equivalents info size mismatch");
+  }
+  write_cluster_binary(&clusters, &clusters + 1, equivalents_info_kind,
+                       &op_indices, out, key);
+}
+
+/// \brief Read cluster orbits from the compact cluster binary format
+///
+/// Throws if the format is invalid or the contents are not orbits.
+std::vector<std::set<clust::IntegralCluster>> read_orbits_binary(
+    std::istream &in) {
+  return ClusterBinaryReader(in).orbits();
+}
+
+/// \brief Read equivalents info from the compact cluster binary format
+///
+/// Throws if the format is invalid or the contents are not equivalents
+/// info.
+clust::EquivalentsInfo read_equivalents_info_binary(std::istream &in) {
+  return ClusterBinaryReader(in).equivalents_info();
+}
+
+/// \brief Constructor, reading a stream to its end
+///
+/// Throws if the format is invalid.
+ClusterBinaryReader::ClusterBinaryReader(std::istream &in)
+    : m_buffer(std::istreambuf_iterator<char>(in),
+               std::istreambuf_iterator<char>()),
+      m_mapped(nullptr),
+      m_data(m_buffer.data()),
+      m_size(m_buffer.size()) {
+  _parse();
+}
+
+/// \brief Constructor, mapping a file
+///
+/// Maps the file read-only and shared. Throws if the file cannot be mapped
+/// or the format is invalid.
+ClusterBinaryReader::ClusterBinaryReader(fs::path const &path)
+    : m_mapped(nullptr), m_data(nullptr), m_size(0) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(
+        "Error in ClusterBinaryReader: could not open '" + path.string() +
+        "'");
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size < header_size) {
+    ::close(fd);
+    throw_invalid_format();
+  }
+  void *addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    throw std::runtime_error(
+        "Error in ClusterBinaryReader: could not map '" + path.string() +
+        "'");
+  }
+  m_mapped = addr;
+  m_data = static_cast<std::uint8_t const *>(addr);
+  m_size = st.st_size;
+  try {
+    _parse();
+  } catch (...) {
+    ::munmap(m_mapped, m_size);
+    throw;
+  }
+}
+
+/// \brief Unmaps the file, if mapped
+ClusterBinaryReader::~ClusterBinaryReader() {
+  if (m_mapped) {
+    ::munmap(m_mapped, m_size);
+  }
+}
+
+/// \brief Number of clusters in orbit i
+Index ClusterBinaryReader::orbit_size(Index i) const {
+  if (i < 0 || i >= m_n_orbits) {
+    throw std::out_of_range("Error in ClusterBinaryReader: invalid orbit");
+  }
+  return _orbit_offset(i + 1) - _orbit_offset(i);
+}
+
+/// \brief Read cluster c, counting clusters in all orbits in order
+clust::IntegralCluster ClusterBinaryReader::cluster(Index c) const {
+  if (c < 0 || c >= m_n_clusters) {
+    throw std::out_of_range("Error in ClusterBinaryReader: invalid cluster");
+  }
+  Index begin = _cluster_offset(c);
+  Index end = _cluster_offset(c + 1);
+  std::vector<xtal::UnitCellCoord> elements;
+  elements.reserve(end - begin);
+  for (Index s = begin; s < end; ++s) {
+    std::uint8_t const *site = m_data + m_site_table + site_size * s;
+    elements.emplace_back(get_i32(site), get_i32(site + 4),
+                          get_i32(site + 8), get_i32(site + 12));
+  }
+  return clust::IntegralCluster(std::move(elements));
+}
+
+/// \brief Read orbit i
+std::set<clust::IntegralCluster> ClusterBinaryReader::orbit(Index i) const {
+  Index n = orbit_size(i);
+  Index begin = _orbit_offset(i);
+  Index end = begin + n;
+  std::set<clust::IntegralCluster> result;
+  for (Index c = begin; c < end; ++c) {
+    result.emplace_hint(result.end(), cluster(c));
+  }
+  return result;
+}
+
+/// \brief Read all orbits
+///
+/// Throws if the contents are equivalents info.
+std::vector<std::set<clust::IntegralCluster>> ClusterBinaryReader::orbits()
+    const {
+  if (m_is_equivalents_info) {
+    throw std::runtime_error(
+        "Error in ClusterBinaryReader::orbits: contents are equivalents "
+        "info");
+  }
+  std::vector<std::set<clust::IntegralCluster>> result;
+  result.reserve(m_n_orbits);
+  for (Index i = 0; i < m_n_orbits; ++i) {
+    result.push_back(orbit(i));
+  }
+  return result;
+}
+
+/// \brief Read equivalents info
+///
+/// Throws if the contents are orbits.
+clust::EquivalentsInfo ClusterBinaryReader::equivalents_info() const {
+  if (!m_is_equivalents_info) {
+    throw std::runtime_error(
+        "Error in ClusterBinaryReader::equivalents_info: contents are "
+        "orbits");
+  }
+  clust::EquivalentsInfo result;
+  result.phenomenal_clusters.reserve(m_n_clusters);
+  result.equivalent_generating_op_indices.reserve(m_n_clusters);
+  for (Index c = 0; c < m_n_clusters; ++c) {
+    result.phenomenal_clusters.push_back(cluster(c));
+    result.equivalent_generating_op_indices.push_back(static_cast<Index>(
+        get_u64(m_data + m_op_table + 8 * c)));
+  }
+  return result;
+}
+
+/// \brief Read the header and counts, and check the tables
+///
+/// Checks that the tables fit in the data and that offsets are
+/// non-decreasing and consistent with the counts, so that reading clusters
+/// does not need to check bounds again.
+void ClusterBinaryReader::_parse() {
+  if (m_size < header_size ||
+      !std::equal(binary_magic, binary_magic + 8, m_data)) {
+    throw_invalid_format();
+  }
+  if (get_u64(m_data + 8) != binary_version) {
+    throw std::runtime_error(
+        "Error reading cluster binary data: unsupported version");
+  }
+  std::uint64_t kind = get_u64(m_data + 16);
+  if (kind != orbits_kind && kind != equivalents_info_kind) {
+    throw_invalid_format();
+  }
+  m_is_equivalents_info = (kind == equivalents_info_kind);
+
+  std::uint64_t key_size = get_u64(m_data + 24);
+  Index remaining = m_size - header_size;
+  if (key_size > std::uint64_t(remaining) ||
+      remaining - Index(key_size) < 24) {
+    throw_invalid_format();
+  }
+  m_key.assign(reinterpret_cast<char const *>(m_data + header_size),
+               key_size);
+
+  Index pos = header_size + key_size;
+  std::uint64_t counts[3] = {get_u64(m_data + pos), get_u64(m_data + pos + 8),
+                             get_u64(m_data + pos + 16)};
+  pos += 24;
+
+  // each table entry is at least 8 bytes, so counts that fit are small
+  // enough not to overflow below
+  for (std::uint64_t count : counts) {
+    if (count >= std::uint64_t(m_size)) {
+      throw_invalid_format();
+    }
+  }
+  m_n_orbits = counts[0];
+  m_n_clusters = counts[1];
+  m_n_sites = counts[2];
+
+  m_orbit_table = pos;
+  m_cluster_table = m_orbit_table + 8 * (m_n_orbits + 1);
+  m_site_table = m_cluster_table + 8 * (m_n_clusters + 1);
+  m_op_table = m_site_table + site_size * m_n_sites;
+  Index expected_size =
+      m_op_table + (m_is_equivalents_info ? 8 * m_n_clusters : 0);
+  if (expected_size != m_size ||
+      (m_is_equivalents_info && m_n_orbits != 1)) {
+    throw_invalid_format();
+  }
+
+  auto check_table = [&](Index table, Index n, Index total) {
+    Index prev = 0;
+    for (Index i = 0; i <= n; ++i) {
+      std::uint64_t value = get_u64(m_data + table + 8 * i);
+      if (value < std::uint64_t(prev) || value > std::uint64_t(total) ||
+          (i == 0 && value != 0) || (i == n && Index(value) != total)) {
+        throw_invalid_format();
+      }
+      prev = value;
+    }
+  };
+  check_table(m_orbit_table, m_n_orbits, m_n_clusters);
+  check_table(m_cluster_table, m_n_clusters, m_n_sites);
+}
+
+/// \brief Entry i of the orbit table
+Index ClusterBinaryReader::_orbit_offset(Index i) const {
+  return get_u64(m_data + m_orbit_table + 8 * i);
+}
+
+/// \brief Entry c of the cluster table
+Index ClusterBinaryReader::_cluster_offset(Index c) const {
+  return get_u64(m_data + m_cluster_table + 8 * c);
+}
+
+}  // namespace CASM
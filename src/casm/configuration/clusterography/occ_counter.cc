@@ -1,11 +1,60 @@
 #include "casm/configuration/clusterography/occ_counter.hh"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/configuration/group/Group.hh"
 #include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/SymType.hh"
+#include "casm/crystallography/UnitCellCoordRep.hh"
 
 namespace CASM {
 namespace clust {
 
+namespace {
+
+/// \brief Append the canonical completions of `occ` on sites `[k, n)`
+///
+/// \param prefix_rep Operations, for each `k`, which map sites `[0, k)`
+///     onto themselves
+void append_canonical_occs(
+    std::vector<std::vector<int>> &values, std::vector<int> &occ, Index k,
+    std::vector<int> const &max_occupant_index,
+    std::vector<std::vector<ClusterOccSymOpRep const *>> const &prefix_rep) {
+  // every operation maps all sites onto themselves, so a complete
+  // occupation that was not pruned is canonical
+  if (k == occ.size()) {
+    values.push_back(occ);
+    return;
+  }
+  for (int value = 0; value <= max_occupant_index[k]; ++value) {
+    occ[k] = value;
+
+    // compare partial occupations on sites [0, k]
+    bool is_pruned = false;
+    for (auto const *op : prefix_rep[k + 1]) {
+      std::vector<int> image(k + 1);
+      for (Index i = 0; i <= k; ++i) {
+        image[op->site_rep[i]] = op->occupant_rep[i][occ[i]];
+      }
+      if (std::lexicographical_compare(occ.begin(), occ.begin() + k + 1,
+                                       image.begin(), image.end())) {
+        is_pruned = true;
+        break;
+      }
+    }
+    if (!is_pruned) {
+      append_canonical_occs(values, occ, k + 1, max_occupant_index,
+                            prefix_rep);
+    }
+  }
+  occ[k] = 0;
+}
+
+}  // namespace
+
 /// \brief Counter over cluster occupations
 Counter<std::vector<int>> make_occ_counter(IntegralCluster const &cluster,
                                            xtal::BasicStructure const &prim) {
@@ -19,5 +68,119 @@ Counter<std::vector<int>> make_occ_counter(IntegralCluster const &cluster,
                                    std::vector<int>(cluster.size(), 1));
 }
 
+/// \brief Make the representation of a cluster group that transforms
+///     cluster occupations
+///
+/// \param cluster The cluster
+/// \param cluster_group The group that leaves `cluster` invariant, up to a
+///     translation and permutation, as from `make_cluster_group` or
+///     `make_cluster_groups`
+/// \param unitcellcoord_symgroup_rep Representation of the
+///     `cluster_group.head_group` (usually the prim factor group) that
+///     transforms sites
+/// \param occ_symgroup_rep Representation of `cluster_group.head_group`
+///     that transforms occupant indices, by sublattice
+///
+/// \returns One ClusterOccSymOpRep for each element of `cluster_group`
+///
+/// Throws if any operation does not leave `cluster` invariant.
+std::vector<ClusterOccSymOpRep> make_cluster_occ_symgroup_rep(
+    IntegralCluster const &cluster, SymGroup const &cluster_group,
+    std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep,
+    sym_info::OccSymGroupRep const &occ_symgroup_rep) {
+  std::vector<ClusterOccSymOpRep> cluster_occ_symgroup_rep;
+  for (Index j : cluster_group.head_group_index) {
+    xtal::UnitCellCoordRep const &unitcellcoord_rep =
+        unitcellcoord_symgroup_rep[j];
+    IntegralCluster image = copy_apply(unitcellcoord_rep, cluster);
+    image += prim_periodic_integral_cluster_frac_translation(unitcellcoord_rep,
+                                                             cluster);
+
+    ClusterOccSymOpRep op;
+    for (Index i = 0; i < cluster.size(); ++i) {
+      auto it = std::find(cluster.begin(), cluster.end(), image[i]);
+      if (it == cluster.end()) {
+        throw std::runtime_error(
+            "Error in make_cluster_occ_symgroup_rep: cluster is not invariant "
+            "under the cluster group");
+      }
+      op.site_rep.push_back(std::distance(cluster.begin(), it));
+      op.occupant_rep.push_back(occ_symgroup_rep[j][cluster[i].sublattice()]);
+    }
+    cluster_occ_symgroup_rep.push_back(std::move(op));
+  }
+  return cluster_occ_symgroup_rep;
+}
+
+/// \brief Apply a cluster group operation to a cluster occupation
+std::vector<int> copy_apply(ClusterOccSymOpRep const &op,
+                            std::vector<int> const &occ) {
+  std::vector<int> result(occ.size());
+  for (Index i = 0; i < occ.size(); ++i) {
+    result[op.site_rep[i]] = op.occupant_rep[i][occ[i]];
+  }
+  return result;
+}
+
+/// \brief Return true if a cluster occupation is the canonical element of
+///     its orbit under a cluster group
+///
+/// The canonical element is the greatest, comparing occupations as
+/// `std::vector<int>`, consistent with `group::make_canonical_element`
+/// using `std::less`.
+bool is_canonical_occ(
+    std::vector<int> const &occ,
+    std::vector<ClusterOccSymOpRep> const &cluster_occ_symgroup_rep) {
+  for (auto const &op : cluster_occ_symgroup_rep) {
+    if (occ < copy_apply(op, occ)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Constructor
+///
+/// \param cluster The cluster
+/// \param prim The prim, which determines the allowed occupants
+/// \param cluster_occ_symgroup_rep The cluster group, as from
+///     `make_cluster_occ_symgroup_rep`
+CanonicalOccCounter::CanonicalOccCounter(
+    IntegralCluster const &cluster, xtal::BasicStructure const &prim,
+    std::vector<ClusterOccSymOpRep> const &cluster_occ_symgroup_rep)
+    : m_index(0) {
+  std::vector<int> max_occupant_index;
+  for (auto const &site : cluster) {
+    Index b = site.sublattice();
+    max_occupant_index.push_back(prim.basis()[b].occupant_dof().size() - 1);
+  }
+
+  // operations which map sites [0, k) onto themselves, for each k
+  Index n_sites = cluster.size();
+  std::vector<std::vector<ClusterOccSymOpRep const *>> prefix_rep(n_sites +
+                                                                  1);
+  for (auto const &op : cluster_occ_symgroup_rep) {
+    for (Index k = 1; k <= n_sites; ++k) {
+      Index i = 0;
+      while (i < k && op.site_rep[i] < k) {
+        ++i;
+      }
+      if (i == k) {
+        prefix_rep[k].push_back(&op);
+      }
+    }
+  }
+
+  std::vector<int> occ(n_sites, 0);
+  append_canonical_occs(m_values, occ, 0, max_occupant_index, prefix_rep);
+
+  // sort in Counter order, with the first site varying fastest
+  std::sort(m_values.begin(), m_values.end(),
+            [](std::vector<int> const &A, std::vector<int> const &B) {
+              return std::lexicographical_compare(A.rbegin(), A.rend(),
+                                                  B.rbegin(), B.rend());
+            });
+}
+
 }  // namespace clust
 }  // namespace CASM
@@ -1,12 +1,20 @@
 #include "casm/configuration/clusterography/orbits.hh"
 
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <unordered_set>
+
 #include "casm/configuration/clusterography/ClusterInvariants.hh"
 #include "casm/configuration/clusterography/ClusterSpecs.hh"
+#include "casm/configuration/clusterography/CompactIntegralCluster.hh"
 #include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/clusterography/SiteNeighborList.hh"
 #include "casm/configuration/clusterography/SubClusterCounter.hh"
 #include "casm/configuration/group/Group.hh"
 #include "casm/configuration/group/orbits.hh"
 #include "casm/configuration/group/subgroups.hh"
+#include "casm/configuration/parallel.hh"
 #include "casm/configuration/sym_info/unitcellcoord_sym_info.hh"
 #include "casm/crystallography/BasicStructure.hh"
 #include "casm/crystallography/LinearIndexConverter.hh"
@@ -18,6 +26,184 @@
 namespace CASM {
 namespace clust {
 
+namespace {  // anonymous
+
+/// \brief Hash for IntegralCluster, consistent with IntegralCluster::operator==
+struct IntegralClusterHash {
+  std::size_t operator()(IntegralCluster const &cluster) const {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (auto const &site : cluster.elements()) {
+      _combine(hash, site.sublattice());
+      for (Index i = 0; i < 3; ++i) {
+        _combine(hash, site.unitcell()(i));
+      }
+    }
+    return hash;
+  }
+
+ private:
+  /// \brief Combine a value into an FNV-1a hash
+  static void _combine(std::uint64_t &hash, std::uint64_t value) {
+    std::uint64_t const fnv_prime = 1099511628211ULL;
+    for (int i = 0; i < 8; ++i) {
+      hash ^= (value >> (8 * i)) & 0xff;
+      hash *= fnv_prime;
+    }
+  }
+};
+
+/// \brief Return cluster, sorted and translated to the origin unit cell
+///
+/// This is the form of the elements of orbits generated by
+/// `make_prim_periodic_orbit`.
+IntegralCluster make_translation_normalized(IntegralCluster cluster) {
+  if (!cluster.size()) {
+    return cluster;
+  }
+  cluster.sort();
+  cluster -= cluster[0].unitcell();
+  return cluster;
+}
+
+/// \brief Hash index of translation-normalized clusters
+///
+/// Clusters of up to CompactIntegralCluster::max_size sites are held as
+/// CompactIntegralCluster, so checking a candidate cluster does not
+/// allocate.
+class TranslationNormalizedClusterIndex {
+ public:
+  /// \brief Insert a translation-normalized cluster
+  void insert(IntegralCluster const &cluster) {
+    if (cluster.size() <= CompactIntegralCluster::max_size) {
+      m_compact.emplace(cluster);
+    } else {
+      m_large.insert(cluster);
+    }
+  }
+
+  /// \brief True if the translation-normalized form of `cluster` has been
+  ///     inserted
+  bool contains_normalized(IntegralCluster const &cluster) const {
+    if (cluster.size() <= CompactIntegralCluster::max_size) {
+      CompactIntegralCluster compact(cluster);
+      compact.sort();
+      if (compact.size()) {
+        compact -= compact.element(0).unitcell();
+      }
+      return m_compact.count(compact);
+    }
+    return m_large.count(make_translation_normalized(cluster));
+  }
+
+ private:
+  std::unordered_set<CompactIntegralCluster, CompactIntegralClusterHash>
+      m_compact;
+  std::unordered_set<IntegralCluster, IntegralClusterHash> m_large;
+};
+
+/// \brief Make a SiteNeighborList large enough to check all site-to-site
+///     distances for the max_length cluster filters, if any are used
+std::optional<SiteNeighborList> make_max_length_neighbor_list(
+    xtal::BasicStructure const &prim, SiteFilterFunction site_filter,
+    std::vector<double> const &max_length) {
+  if (max_length.size() <= 2) {
+    return std::nullopt;
+  }
+  double max_radius = *std::max_element(max_length.begin() + 2,
+                                        max_length.end()) +
+                      2.0 * prim.lattice().tol();
+  return SiteNeighborList(prim, max_radius, site_filter);
+}
+
+/// \brief Return false if `site` is certainly not within `max_length` of
+///     all sites in `cluster`
+///
+/// Distances within the lattice tolerance of `max_length` are not rejected,
+/// so candidates are only rejected here if the max_length cluster filter
+/// would also reject them.
+bool may_be_within_max_length(SiteNeighborList const &neighbor_list,
+                              IntegralCluster const &cluster,
+                              xtal::UnitCellCoord const &site,
+                              double max_length, double tol) {
+  for (auto const &cluster_site : cluster.elements()) {
+    if (neighbor_list.distance(cluster_site, site) >= max_length + tol) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Return true if `site` is within `max_length` (exclusive) of all
+///     sites in `cluster`
+bool is_within_max_length(SiteNeighborList const &neighbor_list,
+                          IntegralCluster const &cluster,
+                          xtal::UnitCellCoord const &site, double max_length) {
+  for (auto const &cluster_site : cluster.elements()) {
+    if (!(neighbor_list.distance(cluster_site, site) < max_length)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Included sites within `cutoff_radius` of any site in `phenomenal`
+///
+/// Uses a SiteNeighborList with `max_radius() >= cutoff_radius`, so one
+/// list can be shared for many phenomenal clusters. Gives the same sites as
+/// `cutoff_radius_neighborhood`, sorted.
+std::vector<xtal::UnitCellCoord> make_cutoff_radius_neighborhood(
+    SiteNeighborList const &neighbor_list, IntegralCluster const &phenomenal,
+    double cutoff_radius, bool include_phenomenal_sites) {
+  std::set<xtal::UnitCellCoord> sites;
+  for (auto const &phenomenal_site : phenomenal.elements()) {
+    for (auto const &neighbor :
+         neighbor_list.neighbors(phenomenal_site.sublattice())) {
+      if (neighbor.distance >= cutoff_radius) {
+        break;
+      }
+      sites.emplace(neighbor.site.sublattice(),
+                    neighbor.site.unitcell() + phenomenal_site.unitcell());
+    }
+  }
+  if (!include_phenomenal_sites) {
+    for (auto const &phenomenal_site : phenomenal.elements()) {
+      sites.erase(phenomenal_site);
+    }
+  }
+  return std::vector<xtal::UnitCellCoord>(sites.begin(), sites.end());
+}
+
+/// \brief Make the site permutations of the operations which leave a
+///     cluster invariant, optionally up to a translation
+std::vector<std::vector<Index>> make_cluster_site_reps(
+    IntegralCluster const &cluster,
+    std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep,
+    bool allow_translation) {
+  IntegralCluster sorted_cluster = cluster;
+  sorted_cluster.sort();
+  std::vector<std::vector<Index>> site_reps;
+  for (auto const &op : unitcellcoord_symgroup_rep) {
+    IntegralCluster image = copy_apply(op, cluster);
+    if (allow_translation && cluster.size()) {
+      image += prim_periodic_integral_cluster_frac_translation(op, cluster);
+    }
+    IntegralCluster sorted_image = image;
+    sorted_image.sort();
+    if (!(sorted_image == sorted_cluster)) {
+      continue;
+    }
+    std::vector<Index> site_rep;
+    for (Index i = 0; i < cluster.size(); ++i) {
+      auto it = std::find(cluster.begin(), cluster.end(), image[i]);
+      site_rep.push_back(std::distance(cluster.begin(), it));
+    }
+    site_reps.push_back(std::move(site_rep));
+  }
+  return site_reps;
+}
+
+}  // namespace
+
 /// \brief Copy cluster and apply symmetry operation transformation
 ///
 /// \param op, Symmetry operation representation to be applied
@@ -36,6 +222,26 @@ IntegralCluster prim_periodic_integral_cluster_copy_apply(
   return clust;
 }
 
+/// \brief Write the result of applying a symmetry operation to a cluster,
+///     translation-normalized, into existing storage
+///
+/// \param op, Symmetry operation representation to be applied
+/// \param clust, Cluster to transform
+/// \param dest, Set to `prim_periodic_integral_cluster_copy_apply(op,
+///     clust)`. Its storage is reused, so this does not allocate if `dest`
+///     already has capacity for the sites of `clust`.
+void prim_periodic_integral_cluster_apply_to(xtal::UnitCellCoordRep const &op,
+                                            IntegralCluster const &clust,
+                                            IntegralCluster &dest) {
+  dest.elements().assign(clust.elements().begin(), clust.elements().end());
+  if (!dest.size()) {
+    return;
+  }
+  apply(op, dest);
+  dest.sort();
+  dest -= dest[0].unitcell();
+}
+
 /// \brief Find translation that leave cluster sites invariant after
 ///     transformation, up to a permutation
 ///
@@ -67,10 +273,10 @@ xtal::UnitCell prim_periodic_integral_cluster_frac_translation(
 std::set<IntegralCluster> make_prim_periodic_orbit(
     IntegralCluster const &orbit_element,
     std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep) {
-  return group::make_orbit(orbit_element, unitcellcoord_symgroup_rep.begin(),
-                           unitcellcoord_symgroup_rep.end(),
-                           std::less<IntegralCluster>(),
-                           prim_periodic_integral_cluster_copy_apply);
+  return group::make_orbit_with_scratch(
+      orbit_element, unitcellcoord_symgroup_rep.begin(),
+      unitcellcoord_symgroup_rep.end(), std::less<IntegralCluster>(),
+      prim_periodic_integral_cluster_apply_to);
 }
 
 /// \brief Make equivalence map of factor group indices for an orbit of
@@ -326,6 +532,23 @@ std::shared_ptr<SymGroup const> make_cluster_group(
   return std::make_shared<SymGroup>(factor_group, elements, indices);
 }
 
+/// \brief Make the site permutations of the operations which leave a
+///     cluster invariant, with periodic symmetry of a prim
+///
+/// \param cluster The cluster
+/// \param unitcellcoord_symgroup_rep Symmetry group representation (as
+///     xtal::UnitCellCoordRep)
+///
+/// \returns For each operation which leaves `cluster` invariant, up to a
+///     translation and permutation, the permutation `site_rep`, where
+///     site `i` of `cluster` is transformed to site `site_rep[i]`.
+///     Operations are in the order of `unitcellcoord_symgroup_rep`.
+std::vector<std::vector<Index>> make_prim_periodic_cluster_site_reps(
+    IntegralCluster const &cluster,
+    std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep) {
+  return make_cluster_site_reps(cluster, unitcellcoord_symgroup_rep, true);
+}
+
 /// \brief Make orbits of clusters, with periodic symmetry of a prim
 ///
 /// \param prim The prim
@@ -341,6 +564,12 @@ std::shared_ptr<SymGroup const> make_cluster_group(
 /// \param custom_generators A vector of custom clusters to be
 ///     included regardless of site_filter and max_length. Includes
 ///     an option to specify that subclusters should also be included.
+/// \param n_threads Number of threads used to extend the clusters of each
+///     branch. If <= 0, uses `std::thread::hardware_concurrency()`. The
+///     result does not depend on the number of threads.
+/// \param progress Optional progress reporting and cancellation. Each
+///     branch is a stage, with one work item per cluster of the previous
+///     branch. Throws OperationCancelled if cancelled.
 ///
 /// To generate `unitcellcoord_symgroup_rep`:
 /// \code
@@ -350,11 +579,26 @@ std::shared_ptr<SymGroup const> make_cluster_group(
 ///         prim_factor_group->element, *prim);
 /// \endcode
 ///
+/// Method, for each branch:
+/// - The clusters of the previous branch are partitioned into contiguous
+///   ranges, in order. Each range is extended by all candidate sites, and the
+///   canonical extended clusters are collected in a thread-local set.
+/// - Each range also keeps a hash index of the translation-normalized
+///   elements of the orbits found so far. Candidate clusters that are
+///   already in the index are equivalent to a cluster that has been found,
+///   and are skipped without computing invariants or canonicalizing. Each
+///   distinct orbit is generated once per range, instead of canonicalizing
+///   every candidate.
+/// - The thread-local sets are merged in range order. As with serial
+///   insertion, the first occurrence of each cluster is kept, so the orbits
+///   and their order are the same for any number of threads.
+///
 std::vector<std::set<IntegralCluster>> make_prim_periodic_orbits(
     std::shared_ptr<xtal::BasicStructure const> const &prim,
     std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep,
     SiteFilterFunction site_filter, std::vector<double> const &max_length,
-    std::vector<IntegralClusterOrbitGenerator> const &custom_generators) {
+    std::vector<IntegralClusterOrbitGenerator> const &custom_generators,
+    Index n_threads, std::shared_ptr<config::ProgressMonitor> progress) {
   // collect unique orbit elements, orbit branch by orbit branch
   typedef std::pair<ClusterInvariants, IntegralCluster> pair_type;
   CompareCluster_f compare_f(prim->lattice().tol());
@@ -368,22 +612,28 @@ std::vector<std::set<IntegralCluster>> make_prim_periodic_orbits(
 
   // function to make a cluster canonical
   auto _make_canonical = [&](IntegralCluster const &cluster) {
-    return group::make_canonical_element(
+    return group::make_canonical_element_with_scratch(
         cluster, unitcellcoord_symgroup_rep.begin(),
         unitcellcoord_symgroup_rep.end(), std::less<IntegralCluster>(),
-        prim_periodic_integral_cluster_copy_apply);
+        prim_periodic_integral_cluster_apply_to);
   };
 
+  // neighbor list used to generate candidate sites and to reject candidate
+  // sites that are too far from the cluster sites
+  double tol = prim->lattice().tol();
+  std::optional<SiteNeighborList> neighbor_list =
+      make_max_length_neighbor_list(*prim, site_filter, max_length);
+  ClusterInvariantsCalculator invariants_calculator(*prim);
+
   for (int branch = 1; branch < max_length.size(); ++branch) {
     // generate candidate sites to be added to clusters of the previous branch
+    // (same as `max_length_neighborhood(max_length[branch])` for branch > 1)
     std::vector<xtal::UnitCellCoord> candidate_sites;
-    CandidateSitesFunction f;
     if (branch == 1) {
-      f = origin_neighborhood();
+      candidate_sites = origin_neighborhood()(*prim, site_filter);
     } else {
-      f = max_length_neighborhood(max_length[branch]);
+      candidate_sites = neighbor_list->origin_neighborhood(max_length[branch]);
     }
-    candidate_sites = f(*prim, site_filter);
 
     // a filter function selects which clusters are allowed
     ClusterFilterFunction cluster_filter;
@@ -393,23 +643,76 @@ std::vector<std::set<IntegralCluster>> make_prim_periodic_orbits(
       cluster_filter = max_length_cluster_filter(max_length[branch]);
     }
 
+    // Cartesian coordinates of candidate sites, calculated once per branch
+    Eigen::Matrix3Xd candidate_cart =
+        invariants_calculator.cart(candidate_sites);
+
     // loop over clusters from the previous branch and add one site
     // keep the cluster if it passes the cluster filter and is unique
-    std::set<pair_type, CompareCluster_f> curr_branch(compare_f);
+    std::vector<pair_type const *> prev_clusters;
     for (auto const &pair : prev_branch) {
-      for (auto const &integral_site : candidate_sites) {
-        IntegralCluster test_cluster = pair.second;
-        if (CASM::contains(test_cluster.elements(), integral_site)) {
-          continue;
-        }
-        test_cluster.elements().push_back(integral_site);
-        ClusterInvariants invariants(test_cluster, *prim);
-        if (!cluster_filter(invariants, test_cluster)) {
-          continue;
-        }
-        test_cluster = _make_canonical(test_cluster);
-        curr_branch.emplace(std::move(invariants), std::move(test_cluster));
-      }
+      prev_clusters.push_back(&pair);
+    }
+    config::begin_progress(
+        progress, "make_prim_periodic_orbits: branch " + std::to_string(branch),
+        prev_clusters.size());
+    std::vector<std::set<pair_type, CompareCluster_f>> chunk_branch(
+        config::resolve_n_threads(n_threads),
+        std::set<pair_type, CompareCluster_f>(compare_f));
+    config::parallel_for_chunks(
+        prev_clusters.size(), n_threads,
+        [&](Index chunk_index, Index chunk_begin, Index chunk_end) {
+          std::set<pair_type, CompareCluster_f> &curr =
+              chunk_branch[chunk_index];
+          // translation-normalized elements of the orbits in `curr`
+          TranslationNormalizedClusterIndex found;
+          for (Index i = chunk_begin; i < chunk_end; ++i) {
+            // Cartesian coordinates of the test cluster sites; the last
+            // column is set for each candidate site
+            IntegralCluster const &prev_cluster = prev_clusters[i]->second;
+            Eigen::Matrix3Xd test_cart(3, prev_cluster.size() + 1);
+            test_cart.leftCols(prev_cluster.size()) =
+                invariants_calculator.cart(prev_cluster);
+            // reused for each candidate, until moved into `curr`
+            IntegralCluster test_cluster;
+            for (Index k = 0; k < candidate_sites.size(); ++k) {
+              auto const &integral_site = candidate_sites[k];
+              test_cluster.elements().assign(prev_cluster.elements().begin(),
+                                             prev_cluster.elements().end());
+              if (CASM::contains(test_cluster.elements(), integral_site)) {
+                continue;
+              }
+              if (branch > 1 &&
+                  !may_be_within_max_length(*neighbor_list, test_cluster,
+                                            integral_site, max_length[branch],
+                                            tol)) {
+                continue;
+              }
+              test_cluster.elements().push_back(integral_site);
+              if (found.contains_normalized(test_cluster)) {
+                continue;
+              }
+              test_cart.col(prev_cluster.size()) = candidate_cart.col(k);
+              ClusterInvariants invariants(test_cart);
+              if (!cluster_filter(invariants, test_cluster)) {
+                continue;
+              }
+              test_cluster = _make_canonical(test_cluster);
+              auto result =
+                  curr.emplace(std::move(invariants), std::move(test_cluster));
+              if (result.second) {
+                for (auto const &element : make_prim_periodic_orbit(
+                         result.first->second, unitcellcoord_symgroup_rep)) {
+                  found.insert(element);
+                }
+              }
+            }
+            config::advance_progress(progress);
+          }
+        });
+    std::set<pair_type, CompareCluster_f> curr_branch(compare_f);
+    for (auto const &curr : chunk_branch) {
+      curr_branch.insert(curr.begin(), curr.end());
     }
 
     // save the previous branch
@@ -431,7 +734,11 @@ std::vector<std::set<IntegralCluster>> make_prim_periodic_orbits(
                   std::move(test_cluster));
 
     if (custom_generator.include_subclusters) {
-      SubClusterCounter counter(prototype);
+      // only subclusters distinct under the cluster group need to be
+      // canonicalized
+      DistinctSubClusterCounter counter(
+          prototype, make_prim_periodic_cluster_site_reps(
+                         prototype, unitcellcoord_symgroup_rep));
       while (counter.valid()) {
         IntegralCluster test_cluster = _make_canonical(counter.value());
         final.emplace(ClusterInvariants(test_cluster, *prim),
@@ -451,6 +758,264 @@ std::vector<std::set<IntegralCluster>> make_prim_periodic_orbits(
   return orbits;
 }
 
+/// \brief Extend orbits of clusters, with periodic symmetry of a prim, to
+///     a larger max_length
+///
+/// \param prev_orbits Orbits generated by `make_prim_periodic_orbits` with
+///     the same `prim`, `unitcellcoord_symgroup_rep`, and `site_filter`,
+///     and with `prev_max_length`. Orbits generated by custom generators may
+///     be included. They are only included in the result if they would be
+///     generated using `max_length` and `custom_generators`.
+/// \param prev_max_length The `max_length` used to generate `prev_orbits`.
+///     Must satisfy `prev_max_length[branch] <= max_length[branch]` for all
+///     branches in both, otherwise throws.
+/// \param prim The prim
+/// \param unitcellcoord_symgroup_rep Symmetry group representation
+/// \param site_filter Function that returns true if a xtal::Site
+///     should be included in the generated clusters
+/// \param max_length The value `max_length[branch]` is the
+///     maximum site-to-site distance for clusters of size == branch.
+///     May have more or fewer branches than `prev_max_length`.
+/// \param custom_generators A vector of custom clusters to be
+///     included regardless of site_filter and max_length.
+///
+/// \returns orbits, equal to the result of `make_prim_periodic_orbits(prim,
+///     unitcellcoord_symgroup_rep, site_filter, max_length,
+///     custom_generators)`.
+///
+/// Method:
+/// - The clusters of each branch that were generated using
+///   `prev_max_length` are identified in `prev_orbits`. Because cutoffs
+///   do not decrease, they are also generated using `max_length`.
+/// - New clusters of each branch are generated by extending the new
+///   clusters of the previous branch, and by extending the previously
+///   generated clusters of the previous branch with sites that result in a
+///   max pair distance >= `prev_max_length[branch]`. The latter candidates
+///   are checked by site-to-site distances before computing invariants.
+/// - Orbits of previously generated clusters are copied from `prev_orbits`,
+///   so only orbits of new clusters are generated.
+///
+std::vector<std::set<IntegralCluster>> extend_prim_periodic_orbits(
+    std::vector<std::set<IntegralCluster>> const &prev_orbits,
+    std::vector<double> const &prev_max_length,
+    std::shared_ptr<xtal::BasicStructure const> const &prim,
+    std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep,
+    SiteFilterFunction site_filter, std::vector<double> const &max_length,
+    std::vector<IntegralClusterOrbitGenerator> const &custom_generators) {
+  Index n_common = std::min(prev_max_length.size(), max_length.size());
+  for (Index branch = 2; branch < n_common; ++branch) {
+    if (max_length[branch] < prev_max_length[branch]) {
+      throw std::runtime_error(
+          "Error in extend_prim_periodic_orbits: max_length[branch] < "
+          "prev_max_length[branch]");
+    }
+  }
+
+  typedef std::pair<ClusterInvariants, IntegralCluster> pair_type;
+  CompareCluster_f compare_f(prim->lattice().tol());
+  double tol = prim->lattice().tol();
+
+  // function to make a cluster canonical
+  auto _make_canonical = [&](IntegralCluster const &cluster) {
+    return group::make_canonical_element_with_scratch(
+        cluster, unitcellcoord_symgroup_rep.begin(),
+        unitcellcoord_symgroup_rep.end(), std::less<IntegralCluster>(),
+        prim_periodic_integral_cluster_apply_to);
+  };
+
+  // true if a cluster of size == branch passes the previous cluster filter
+  auto _passes_prev_filter = [&](Index branch,
+                                 ClusterInvariants const &invariants) {
+    if (branch >= prev_max_length.size()) {
+      return false;
+    }
+    if (branch <= 1) {
+      return true;
+    }
+    return invariants.distances().back() < prev_max_length[branch];
+  };
+
+  // collect canonical previous clusters, by size, and their orbits
+  Index n_branches = std::max(max_length.size(), std::size_t(1));
+  std::map<IntegralCluster, std::set<IntegralCluster> const *>
+      prev_orbit_by_canonical;
+  std::vector<std::vector<pair_type>> prev_by_size(n_branches);
+  for (auto const &orbit : prev_orbits) {
+    if (orbit.empty() || orbit.begin()->size() >= n_branches) {
+      continue;
+    }
+    IntegralCluster canonical = _make_canonical(*orbit.begin());
+    prev_orbit_by_canonical.emplace(canonical, &orbit);
+    ClusterInvariants invariants(canonical, *prim);
+    Index branch = canonical.size();
+    if (branch > 0 && _passes_prev_filter(branch, invariants)) {
+      prev_by_size[branch].emplace_back(std::move(invariants),
+                                        std::move(canonical));
+    }
+  }
+
+  // previously generated clusters, by branch: those passing the previous
+  // filter with a subcluster generated in the previous branch
+  IntegralCluster null_cluster;
+  std::vector<std::set<pair_type, CompareCluster_f>> prev_generated(
+      n_branches, std::set<pair_type, CompareCluster_f>(compare_f));
+  prev_generated[0].emplace(ClusterInvariants(null_cluster, *prim),
+                            null_cluster);
+  std::set<IntegralCluster> prev_subclusters;
+  for (Index branch = 1; branch < n_branches; ++branch) {
+    std::set<IntegralCluster> curr_subclusters;
+    for (auto const &pair : prev_by_size[branch]) {
+      IntegralCluster const &cluster = pair.second;
+      bool is_generated = false;
+      if (branch == 1) {
+        is_generated = site_filter(prim->basis()[cluster[0].sublattice()]);
+      } else {
+        for (Index i = 0; i < cluster.size(); ++i) {
+          IntegralCluster subcluster = cluster;
+          subcluster.elements().erase(subcluster.elements().begin() + i);
+          if (prev_subclusters.count(_make_canonical(subcluster))) {
+            is_generated = true;
+            break;
+          }
+        }
+      }
+      if (is_generated) {
+        prev_generated[branch].insert(pair);
+        curr_subclusters.insert(cluster);
+      }
+    }
+    prev_subclusters = std::move(curr_subclusters);
+  }
+
+  // neighbor list used to generate candidate sites and to check
+  // site-to-site distances
+  std::optional<SiteNeighborList> neighbor_list =
+      make_max_length_neighbor_list(*prim, site_filter, max_length);
+  ClusterInvariantsCalculator invariants_calculator(*prim);
+
+  std::set<pair_type, CompareCluster_f> final(prev_generated[0]);
+  std::set<pair_type, CompareCluster_f> new_prev_branch(compare_f);
+  for (int branch = 1; branch < max_length.size(); ++branch) {
+    // generate candidate sites to be added to clusters of the previous branch
+    std::vector<xtal::UnitCellCoord> candidate_sites;
+    if (branch == 1) {
+      candidate_sites = origin_neighborhood()(*prim, site_filter);
+    } else {
+      candidate_sites = neighbor_list->origin_neighborhood(max_length[branch]);
+    }
+
+    // a filter function selects which clusters are allowed
+    ClusterFilterFunction cluster_filter;
+    if (branch == 1) {
+      cluster_filter = all_clusters_filter();
+    } else {
+      cluster_filter = max_length_cluster_filter(max_length[branch]);
+    }
+
+    // Cartesian coordinates of candidate sites, calculated once per branch
+    Eigen::Matrix3Xd candidate_cart =
+        invariants_calculator.cart(candidate_sites);
+
+    // extend a cluster of the previous branch; for previously generated
+    // clusters, only keep extensions that were not previously generated
+    std::set<pair_type, CompareCluster_f> curr_branch(compare_f);
+    auto _extend = [&](pair_type const &pair, bool is_prev_generated) {
+      bool check_prev = is_prev_generated && branch < prev_max_length.size();
+      if (check_prev && branch == 1) {
+        // all point clusters were generated previously
+        return;
+      }
+      double cluster_max_length =
+          pair.first.distances().empty() ? 0.0 : pair.first.distances().back();
+      Eigen::Matrix3Xd test_cart(3, pair.second.size() + 1);
+      test_cart.leftCols(pair.second.size()) =
+          invariants_calculator.cart(pair.second);
+      for (Index k = 0; k < candidate_sites.size(); ++k) {
+        auto const &integral_site = candidate_sites[k];
+        IntegralCluster test_cluster = pair.second;
+        if (CASM::contains(test_cluster.elements(), integral_site)) {
+          continue;
+        }
+        if (branch > 1 &&
+            !may_be_within_max_length(*neighbor_list, test_cluster,
+                                      integral_site, max_length[branch],
+                                      tol)) {
+          continue;
+        }
+        if (check_prev && cluster_max_length < prev_max_length[branch] - tol &&
+            is_within_max_length(*neighbor_list, test_cluster, integral_site,
+                                 prev_max_length[branch] - tol)) {
+          continue;
+        }
+        test_cluster.elements().push_back(integral_site);
+        test_cart.col(pair.second.size()) = candidate_cart.col(k);
+        ClusterInvariants invariants(test_cart);
+        if (!cluster_filter(invariants, test_cluster)) {
+          continue;
+        }
+        if (check_prev && _passes_prev_filter(branch, invariants)) {
+          continue;
+        }
+        test_cluster = _make_canonical(test_cluster);
+        curr_branch.emplace(std::move(invariants), std::move(test_cluster));
+      }
+    };
+    for (auto const &pair : prev_generated[branch - 1]) {
+      _extend(pair, true);
+    }
+    for (auto const &pair : new_prev_branch) {
+      _extend(pair, false);
+    }
+
+    // separate the new clusters from the previously generated clusters
+    std::set<pair_type, CompareCluster_f> new_curr_branch(compare_f);
+    for (auto const &pair : curr_branch) {
+      if (!prev_generated[branch].count(pair)) {
+        new_curr_branch.insert(pair);
+      }
+    }
+    final.insert(prev_generated[branch].begin(), prev_generated[branch].end());
+    final.insert(new_curr_branch.begin(), new_curr_branch.end());
+    new_prev_branch = std::move(new_curr_branch);
+  }
+
+  // add custom generators -- filters do not apply
+  for (auto const &custom_generator : custom_generators) {
+    auto const &prototype = custom_generator.prototype;
+
+    IntegralCluster test_cluster = _make_canonical(prototype);
+    final.emplace(ClusterInvariants(test_cluster, *prim),
+                  std::move(test_cluster));
+
+    if (custom_generator.include_subclusters) {
+      // only subclusters distinct under the cluster group need to be
+      // canonicalized
+      DistinctSubClusterCounter counter(
+          prototype, make_prim_periodic_cluster_site_reps(
+                         prototype, unitcellcoord_symgroup_rep));
+      while (counter.valid()) {
+        IntegralCluster test_cluster = _make_canonical(counter.value());
+        final.emplace(ClusterInvariants(test_cluster, *prim),
+                      std::move(test_cluster));
+        counter.next();
+      }
+    }
+  }
+
+  // copy previous orbits, generate new orbits
+  std::vector<std::set<IntegralCluster>> orbits;
+  for (auto const &pair : final) {
+    auto it = prev_orbit_by_canonical.find(pair.second);
+    if (it != prev_orbit_by_canonical.end()) {
+      orbits.push_back(*it->second);
+    } else {
+      orbits.emplace_back(
+          make_prim_periodic_orbit(pair.second, unitcellcoord_symgroup_rep));
+    }
+  }
+  return orbits;
+}
+
 /// \brief Convert orbits of IntegralCluster to orbits of linear site
 ///     indices in a supercell
 ///
@@ -510,6 +1075,25 @@ IntegralCluster local_integral_cluster_copy_apply(
   return clust;
 }
 
+/// \brief Write the result of applying a symmetry operation to a cluster,
+///     sorted, into existing storage
+///
+/// \param op, Symmetry operation representation to be applied
+/// \param clust, Cluster to transform
+/// \param dest, Set to `local_integral_cluster_copy_apply(op, clust)`. Its
+///     storage is reused, so this does not allocate if `dest` already has
+///     capacity for the sites of `clust`.
+void local_integral_cluster_apply_to(xtal::UnitCellCoordRep const &op,
+                                     IntegralCluster const &clust,
+                                     IntegralCluster &dest) {
+  dest.elements().assign(clust.elements().begin(), clust.elements().end());
+  if (!dest.size()) {
+    return;
+  }
+  apply(op, dest);
+  dest.sort();
+}
+
 /// \brief Make an orbit of local clusters
 ///
 /// \param orbit_element One cluster in the orbit
@@ -519,10 +1103,10 @@ IntegralCluster local_integral_cluster_copy_apply(
 std::set<IntegralCluster> make_local_orbit(
     IntegralCluster const &orbit_element,
     std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep) {
-  return group::make_orbit(orbit_element, unitcellcoord_symgroup_rep.begin(),
-                           unitcellcoord_symgroup_rep.end(),
-                           std::less<IntegralCluster>(),
-                           local_integral_cluster_copy_apply);
+  return group::make_orbit_with_scratch(
+      orbit_element, unitcellcoord_symgroup_rep.begin(),
+      unitcellcoord_symgroup_rep.end(), std::less<IntegralCluster>(),
+      local_integral_cluster_apply_to);
 }
 
 /// \brief Make equivalence map of phenomenal group indices for an orbit of
@@ -632,6 +1216,160 @@ std::vector<std::shared_ptr<SymGroup const>> make_local_cluster_groups(
   return cluster_groups;
 }
 
+/// \brief Make the site permutations of the operations which leave a
+///     local cluster invariant
+///
+/// \param cluster The local cluster
+/// \param unitcellcoord_symgroup_rep Symmetry group representation (as
+///     xtal::UnitCellCoordRep) of the phenomenal group
+///
+/// \returns For each operation which leaves `cluster` invariant, up to a
+///     permutation, the permutation `site_rep`, where site `i` of
+///     `cluster` is transformed to site `site_rep[i]`. Operations are in
+///     the order of `unitcellcoord_symgroup_rep`.
+std::vector<std::vector<Index>> make_local_cluster_site_reps(
+    IntegralCluster const &cluster,
+    std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep) {
+  return make_cluster_site_reps(cluster, unitcellcoord_symgroup_rep, false);
+}
+
+namespace {  // anonymous
+
+/// \brief Make local-cluster orbits, given the candidate sites for each
+///     branch
+///
+/// \param candidate_sites_by_branch The value
+///     `candidate_sites_by_branch[branch]` is the sites that are added to
+///     clusters from the previous branch to generate clusters of size ==
+///     branch.
+/// \param max_length_neighbor_list A SiteNeighborList made by
+///     `make_max_length_neighbor_list`. Only used if
+///     `max_length.size() > 2`.
+///
+/// Other parameters are as for `make_local_orbits`.
+std::vector<std::set<IntegralCluster>> make_local_orbits_impl(
+    std::shared_ptr<xtal::BasicStructure const> const &prim,
+    std::vector<xtal::UnitCellCoordRep> const &unitcellcoord_symgroup_rep,
+    std::vector<double> const &max_length,
+    std::vector<IntegralClusterOrbitGenerator> const &custom_generators,
+    IntegralCluster const &phenomenal,
+    std::vector<std::vector<xtal::UnitCellCoord>> const
+        &candidate_sites_by_branch,
+    SiteNeighborList const *max_length_neighbor_list) {
+  // collect unique orbit elements, orbit branch by orbit branch
+  typedef std::pair<ClusterInvariants, IntegralCluster> pair_type;
+  CompareCluster_f compare_f(prim->lattice().tol());
+  std::set<pair_type, CompareCluster_f> final(compare_f);
+  std::set<pair_type, CompareCluster_f> prev_branch(compare_f);
+
+  // include null cluster (it has been the convention in CASM)
+  IntegralCluster null_cluster;
+  final.emplace(ClusterInvariants(null_cluster, phenomenal, *prim),
+                null_cluster);
+  prev_branch.emplace(ClusterInvariants(null_cluster, phenomenal, *prim),
+                      null_cluster);
+
+  // function to make a cluster canonical
+  auto _make_canonical = [&](IntegralCluster const &cluster) {
+    return group::make_canonical_element_with_scratch(
+        cluster, unitcellcoord_symgroup_rep.begin(),
+        unitcellcoord_symgroup_rep.end(), std::less<IntegralCluster>(),
+        local_integral_cluster_apply_to);
+  };
+
+  double tol = prim->lattice().tol();
+  ClusterInvariantsCalculator invariants_calculator(*prim);
+  Eigen::Matrix3Xd phenomenal_cart = invariants_calculator.cart(phenomenal);
+  for (int branch = 1; branch < max_length.size(); ++branch) {
+    // candidate sites to be added to clusters of the previous branch
+    std::vector<xtal::UnitCellCoord> const &candidate_sites =
+        candidate_sites_by_branch[branch];
+    Eigen::Matrix3Xd candidate_cart =
+        invariants_calculator.cart(candidate_sites);
+
+    // a filter function selects which clusters are allowed
+    ClusterFilterFunction cluster_filter;
+    if (branch == 1) {
+      cluster_filter = all_clusters_filter();
+    } else {
+      cluster_filter = max_length_cluster_filter(max_length[branch]);
+    }
+
+    // loop over clusters from the previous branch and add one site
+    // keep the cluster if it passes the cluster filter and is unique
+    std::set<pair_type, CompareCluster_f> curr_branch(compare_f);
+    for (auto const &pair : prev_branch) {
+      Eigen::Matrix3Xd test_cart(3, pair.second.size() + 1);
+      test_cart.leftCols(pair.second.size()) =
+          invariants_calculator.cart(pair.second);
+      for (Index k = 0; k < candidate_sites.size(); ++k) {
+        auto const &integral_site = candidate_sites[k];
+        IntegralCluster test_cluster = pair.second;
+        if (CASM::contains(test_cluster.elements(), integral_site)) {
+          continue;
+        }
+        if (branch > 1 &&
+            !may_be_within_max_length(*max_length_neighbor_list, test_cluster,
+                                      integral_site, max_length[branch],
+                                      tol)) {
+          continue;
+        }
+        test_cluster.elements().push_back(integral_site);
+        test_cart.col(pair.second.size()) = candidate_cart.col(k);
+        ClusterInvariants invariants(test_cart, phenomenal_cart);
+        if (!cluster_filter(invariants, test_cluster)) {
+          continue;
+        }
+        test_cluster = _make_canonical(test_cluster);
+        curr_branch.emplace(std::move(invariants), std::move(test_cluster));
+      }
+    }
+
+    // save the previous branch
+    final.insert(prev_branch.begin(), prev_branch.end());
+
+    // the current branch becomes the previous branch
+    prev_branch = std::move(curr_branch);
+  }
+
+  // save the last branch
+  final.insert(prev_branch.begin(), prev_branch.end());
+
+  // add custom generators -- filters do not apply
+  for (auto const &custom_generator : custom_generators) {
+    auto const &prototype = custom_generator.prototype;
+
+    IntegralCluster test_cluster = _make_canonical(prototype);
+    final.emplace(ClusterInvariants(test_cluster, phenomenal, *prim),
+                  std::move(test_cluster));
+
+    if (custom_generator.include_subclusters) {
+      // only subclusters distinct under the cluster group need to be
+      // canonicalized
+      DistinctSubClusterCounter counter(
+          prototype, make_local_cluster_site_reps(
+                         prototype, unitcellcoord_symgroup_rep));
+      while (counter.valid()) {
+        IntegralCluster test_cluster = _make_canonical(counter.value());
+        final.emplace(ClusterInvariants(test_cluster, phenomenal, *prim),
+                      std::move(test_cluster));
+        counter.next();
+      }
+    }
+  }
+
+  // generate orbits from the unique clusters
+  std::vector<std::set<IntegralCluster>> orbits;
+  for (auto const &pair : final) {
+    orbits.emplace_back(
+        make_local_orbit(pair.second, unitcellcoord_symgroup_rep));
+  }
+
+  return orbits;
+}
+
+}  // namespace
+
 /// \brief Make local-cluster orbits
 ///
 /// \param prim The prim
@@ -711,96 +1449,119 @@ std::vector<std::set<IntegralCluster>> make_local_orbits(
     std::vector<IntegralClusterOrbitGenerator> const &custom_generators,
     IntegralCluster const &phenomenal, std::vector<double> const &cutoff_radius,
     bool include_phenomenal_sites) {
-  // collect unique orbit elements, orbit branch by orbit branch
-  typedef std::pair<ClusterInvariants, IntegralCluster> pair_type;
-  CompareCluster_f compare_f(prim->lattice().tol());
-  std::set<pair_type, CompareCluster_f> final(compare_f);
-  std::set<pair_type, CompareCluster_f> prev_branch(compare_f);
-
-  // include null cluster (it has been the convention in CASM)
-  IntegralCluster null_cluster;
-  final.emplace(ClusterInvariants(null_cluster, phenomenal, *prim),
-                null_cluster);
-  prev_branch.emplace(ClusterInvariants(null_cluster, phenomenal, *prim),
-                      null_cluster);
-
-  // function to make a cluster canonical
-  auto _make_canonical = [&](IntegralCluster const &cluster) {
-    return group::make_canonical_element(
-        cluster, unitcellcoord_symgroup_rep.begin(),
-        unitcellcoord_symgroup_rep.end(), std::less<IntegralCluster>(),
-        local_integral_cluster_copy_apply);
-  };
-
+  std::vector<std::vector<xtal::UnitCellCoord>> candidate_sites_by_branch(
+      max_length.size());
   for (int branch = 1; branch < max_length.size(); ++branch) {
-    // generate candidate sites to be added to clusters of the previous branch
     CandidateSitesFunction f = cutoff_radius_neighborhood(
         phenomenal, cutoff_radius[branch], include_phenomenal_sites);
-    std::vector<xtal::UnitCellCoord> candidate_sites = f(*prim, site_filter);
-
-    // a filter function selects which clusters are allowed
-    ClusterFilterFunction cluster_filter;
-    if (branch == 1) {
-      cluster_filter = all_clusters_filter();
-    } else {
-      cluster_filter = max_length_cluster_filter(max_length[branch]);
-    }
-
-    // loop over clusters from the previous branch and add one site
-    // keep the cluster if it passes the cluster filter and is unique
-    std::set<pair_type, CompareCluster_f> curr_branch(compare_f);
-    for (auto const &pair : prev_branch) {
-      for (auto const &integral_site : candidate_sites) {
-        IntegralCluster test_cluster = pair.second;
-        if (CASM::contains(test_cluster.elements(), integral_site)) {
-          continue;
-        }
-        test_cluster.elements().push_back(integral_site);
-        ClusterInvariants invariants(test_cluster, phenomenal, *prim);
-        if (!cluster_filter(invariants, test_cluster)) {
-          continue;
-        }
-        test_cluster = _make_canonical(test_cluster);
-        curr_branch.emplace(std::move(invariants), std::move(test_cluster));
-      }
-    }
-
-    // save the previous branch
-    final.insert(prev_branch.begin(), prev_branch.end());
-
-    // the current branch becomes the previous branch
-    prev_branch = std::move(curr_branch);
+    candidate_sites_by_branch[branch] = f(*prim, site_filter);
   }
 
-  // save the last branch
-  final.insert(prev_branch.begin(), prev_branch.end());
+  // neighbor list used to reject candidate sites that are too far from the
+  // cluster sites
+  std::optional<SiteNeighborList> neighbor_list =
+      make_max_length_neighbor_list(*prim, site_filter, max_length);
 
-  // add custom generators -- filters do not apply
-  for (auto const &custom_generator : custom_generators) {
-    auto const &prototype = custom_generator.prototype;
-
-    IntegralCluster test_cluster = _make_canonical(prototype);
-    final.emplace(ClusterInvariants(test_cluster, phenomenal, *prim),
-                  std::move(test_cluster));
+  return make_local_orbits_impl(
+      prim, unitcellcoord_symgroup_rep, max_length, custom_generators,
+      phenomenal, candidate_sites_by_branch,
+      neighbor_list.has_value() ? &neighbor_list.value() : nullptr);
+}
 
-    if (custom_generator.include_subclusters) {
-      SubClusterCounter counter(prototype);
-      while (counter.valid()) {
-        IntegralCluster test_cluster = _make_canonical(counter.value());
-        final.emplace(ClusterInvariants(test_cluster, phenomenal, *prim),
-                      std::move(test_cluster));
-        counter.next();
-      }
-    }
+/// \brief Make local-cluster orbits for many phenomenal clusters
+///
+/// \param prim The prim
+/// \param cluster_groups The value `cluster_groups[i]` is the group used to
+///     generate local-cluster orbits around `phenomenal_clusters[i]`. This
+///     should agree with the phenomenal cluster, being the cluster group or
+///     a subgroup (currently no validation is performed).
+/// \param site_filter Function that returns true if a xtal::Site
+///     should be included in the generated clusters
+/// \param max_length The value `max_length[branch]` is the
+///     maximum site-to-site distance for clusters of size == branch.
+///     The values for `branch==0` and `branch==1` are ignored. The
+///     size of max_length sets the maximum number of sites
+///     in a cluster.
+/// \param custom_generators If not empty, the value `custom_generators[i]`
+///     is custom clusters to be included for `phenomenal_clusters[i]`, as
+///     for `make_local_orbits`.
+/// \param phenomenal_clusters The clusters around which local clusters are
+///     generated.
+/// \param cutoff_radius The value `cutoff_radius[branch]` is the
+///     maximum phenomenal-site-to-cluster-site distance for clusters
+///     of size == branch. The value for `branch==0` is ignored.
+/// \param include_phenomenal_sites If true, include the phenomenal
+///     cluster sites in the local clusters (default=false).
+/// \param n_threads Number of threads used to generate orbits. If <= 0,
+///     uses the number of hardware threads.
+///
+/// \returns orbits, where `orbits[i]` is equal to the result of
+///     `make_local_orbits` for `phenomenal_clusters[i]`. The result does not
+///     depend on the number of threads.
+///
+/// The site neighborhoods used to generate candidate sites and to check
+/// site-to-site distances are calculated once, using the prim, and shared
+/// by all phenomenal clusters. Orbits for different phenomenal clusters are
+/// generated in parallel. `site_filter` is only called on the calling
+/// thread.
+std::vector<std::vector<std::set<IntegralCluster>>> make_local_orbits(
+    std::shared_ptr<xtal::BasicStructure const> const &prim,
+    std::vector<std::shared_ptr<SymGroup const>> const &cluster_groups,
+    SiteFilterFunction site_filter, std::vector<double> const &max_length,
+    std::vector<std::vector<IntegralClusterOrbitGenerator>> const
+        &custom_generators,
+    std::vector<IntegralCluster> const &phenomenal_clusters,
+    std::vector<double> const &cutoff_radius, bool include_phenomenal_sites,
+    Index n_threads) {
+  Index n = phenomenal_clusters.size();
+  if (cluster_groups.size() != n) {
+    throw std::runtime_error(
+        "Error in make_local_orbits: cluster_groups.size() != "
+        "phenomenal_clusters.size()");
+  }
+  if (custom_generators.size() && custom_generators.size() != n) {
+    throw std::runtime_error(
+        "Error in make_local_orbits: custom_generators.size() != "
+        "phenomenal_clusters.size()");
   }
 
-  // generate orbits from the unique clusters
-  std::vector<std::set<IntegralCluster>> orbits;
-  for (auto const &pair : final) {
-    orbits.emplace_back(
-        make_local_orbit(pair.second, unitcellcoord_symgroup_rep));
+  // shared neighbor lists
+  double max_cutoff_radius = 0.0;
+  for (int branch = 1; branch < max_length.size(); ++branch) {
+    max_cutoff_radius = std::max(max_cutoff_radius, cutoff_radius[branch]);
   }
+  SiteNeighborList cutoff_radius_neighbor_list(*prim, max_cutoff_radius,
+                                               site_filter);
+  std::optional<SiteNeighborList> max_length_neighbor_list =
+      make_max_length_neighbor_list(*prim, site_filter, max_length);
 
+  std::vector<IntegralClusterOrbitGenerator> const no_custom_generators;
+  std::vector<std::vector<std::set<IntegralCluster>>> orbits(n);
+  config::parallel_for_chunks(
+      n, n_threads, [&](Index chunk_index, Index begin, Index end) {
+        for (Index i = begin; i < end; ++i) {
+          IntegralCluster const &phenomenal = phenomenal_clusters[i];
+          auto unitcellcoord_symgroup_rep =
+              sym_info::make_unitcellcoord_symgroup_rep(
+                  cluster_groups[i]->element, *prim);
+          std::vector<std::vector<xtal::UnitCellCoord>>
+              candidate_sites_by_branch(max_length.size());
+          for (int branch = 1; branch < max_length.size(); ++branch) {
+            candidate_sites_by_branch[branch] =
+                make_cutoff_radius_neighborhood(
+                    cutoff_radius_neighbor_list, phenomenal,
+                    cutoff_radius[branch], include_phenomenal_sites);
+          }
+          orbits[i] = make_local_orbits_impl(
+              prim, unitcellcoord_symgroup_rep, max_length,
+              custom_generators.size() ? custom_generators[i]
+                                       : no_custom_generators,
+              phenomenal, candidate_sites_by_branch,
+              max_length_neighbor_list.has_value()
+                  ? &max_length_neighbor_list.value()
+                  : nullptr);
+        }
+      });
   return orbits;
 }
 
@@ -1,14 +1,366 @@
 #include "casm/configuration/config_space_analysis.hh"
 
+#include <cmath>
+#include <complex>
+#include <numeric>
+
+#include "casm/configuration/ConfigIsEquivalent.hh"
 #include "casm/configuration/DoFSpace_functions.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSet.hh"
 #include "casm/configuration/SupercellSymOp.hh"
 #include "casm/configuration/canonical_form.hh"
 #include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/parallel.hh"
 #include "casm/crystallography/CanonicalForm.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
 
 namespace CASM {
 namespace config {
 
+namespace {  // (anonymous)
+
+/// \brief Return the normal coordinate of `dof_values` in `dof_space`, with
+///     near-zero values set to zero
+Eigen::VectorXd make_clean_normal_coordinate(ConfigDoFValues const &dof_values,
+                                             SparseDoFSpace const &dof_space,
+                                             double tol) {
+  Eigen::VectorXd x = get_normal_coordinate(dof_values, dof_space);
+  for (int i = 0; i < x.size(); ++i) {
+    if (almost_zero(x(i), tol)) {
+      x(i) = 0.0;
+    }
+  }
+  return x;
+}
+
+/// \brief Return the lower triangle of the sum of x*x^T over the distinct
+///     equivalents of `prototype`, without storing the equivalents
+///
+/// The sum over all supercell operations is accumulated with rank-k
+/// updates on batches of `batch_size` columns, in up to `n_threads`
+/// parallel chunks of operations. Each distinct equivalent is generated by
+/// as many operations as leave `prototype` invariant, so the sum is
+/// divided by that number.
+Eigen::MatrixXd make_streaming_projector_lower(
+    Configuration const &prototype, SparseDoFSpace const &dof_space,
+    double tol, Index batch_size, Index n_threads) {
+  auto const &supercell = prototype.supercell;
+  Index n_translations = supercell->superlattice.size();
+  Index n_ops =
+      supercell->sym_info().factor_group_permutations.size() * n_translations;
+  Index dim = dof_space.basis.cols();
+  double xtal_tol = supercell->prim->basicstructure->lattice().tol();
+  batch_size = std::max(batch_size, Index(1));
+
+  // one partial sum per chunk, as chunked by parallel_for_chunks
+  Index n_chunks = std::min(resolve_n_threads(n_threads), n_ops);
+  std::vector<Eigen::MatrixXd> chunk_P(n_chunks,
+                                       Eigen::MatrixXd::Zero(dim, dim));
+  std::vector<Index> chunk_n_invariant(n_chunks, 0);
+
+  parallel_for_chunks(n_ops, n_threads, [&](Index c, Index begin, Index end) {
+    ConfigIsEquivalent equal_to(prototype, xtal_tol);
+    SupercellSymOp op(supercell, 0, 0);
+    ConfigDoFValues transformed = prototype.dof_values;
+    Eigen::MatrixXd X(dim, std::min(batch_size, end - begin));
+    Index n_cols = 0;
+    for (Index i = begin; i < end; ++i) {
+      op.reset(i / n_translations, i % n_translations);
+      if (equal_to(op)) {
+        ++chunk_n_invariant[c];
+      }
+      copy_apply(op, prototype.dof_values, transformed);
+      X.col(n_cols) =
+          make_clean_normal_coordinate(transformed, dof_space, tol);
+      ++n_cols;
+      if (n_cols == X.cols() || i + 1 == end) {
+        chunk_P[c].selfadjointView<Eigen::Lower>().rankUpdate(
+            X.leftCols(n_cols));
+        n_cols = 0;
+      }
+    }
+  });
+
+  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(dim, dim);
+  Index n_invariant = 0;
+  for (Index c = 0; c < n_chunks; ++c) {
+    P += chunk_P[c];
+    n_invariant += chunk_n_invariant[c];
+  }
+  return P / static_cast<double>(n_invariant);
+}
+
+/// \brief Exact k-point, as (numerator(0), numerator(1), numerator(2),
+///     denominator), with the fraction in lowest terms
+typedef std::array<Index, 4> KPointKey;
+
+/// \brief Return the KPointKey for `numerator / denominator`, for
+///     denominator > 0
+KPointKey make_kpoint_key(Eigen::Vector3l numerator, Index denominator) {
+  Index g = denominator;
+  for (Index i = 0; i < 3; ++i) {
+    numerator(i) = ((numerator(i) % denominator) + denominator) % denominator;
+    g = std::gcd(g, numerator(i));
+  }
+  return {numerator(0) / g, numerator(1) / g, numerator(2) / g,
+          denominator / g};
+}
+
+/// \brief Return the rows of a prim unit cell DoFSpace, by sublattice
+std::vector<std::vector<Index>> make_rows_by_sublattice(
+    clexulator::DoFSpace const &prim_dof_space, Index n_sublattice) {
+  std::vector<std::vector<Index>> rows(n_sublattice);
+  std::vector<Index> const &site_index = *prim_dof_space.axis_info.site_index;
+  for (Index j = 0; j < site_index.size(); ++j) {
+    rows[site_index[j]].push_back(j);
+  }
+  return rows;
+}
+
+/// \brief Add `c * c^H`, for the coordinates `c` of the Fourier
+///     components of a configuration, to the projector at each k-point
+///
+/// For local DoF, the Fourier component at each k-point commensurate with
+/// the configuration's supercell is
+///
+///     u(k)_j = (1/N) * sum_R u(R)_j * exp(-2*pi*i * k.R),
+///
+/// where `N` is the supercell volume, `R` are the unit cells of the
+/// supercell, and `j` are the rows of `prim_dof_space`. It is projected
+/// onto `dof_space`, or `dof_space_k0` for k = 0, with `basis_inv`. For
+/// global DoF, the only k-point is k = 0.
+void add_kpoint_projectors(Configuration const &configuration,
+                           clexulator::DoFSpace const &prim_dof_space,
+                           std::vector<std::vector<Index>> const &rows,
+                           clexulator::DoFSpace const &dof_space,
+                           clexulator::DoFSpace const &dof_space_k0,
+                           std::map<KPointKey, Eigen::MatrixXcd> &P) {
+  auto add = [&](KPointKey const &key, Eigen::VectorXcd const &u) {
+    clexulator::DoFSpace const &space =
+        (key[3] == 1) ? dof_space_k0 : dof_space;
+    Eigen::VectorXcd c = space.basis_inv.cast<std::complex<double>>() * u;
+    auto it = P.find(key);
+    if (it == P.end()) {
+      it = P.emplace(key, Eigen::MatrixXcd::Zero(c.size(), c.size())).first;
+    }
+    it->second += c * c.adjoint();
+  };
+
+  if (prim_dof_space.is_global) {
+    add(KPointKey({0, 0, 0, 1}),
+        configuration.dof_values.global_dof_values.at(prim_dof_space.dof_key)
+            .cast<std::complex<double>>());
+    return;
+  }
+
+  // k = adj(T^T) * m / det(T), for m in Z^3 / (T^T * Z^3)
+  Supercell const &supercell = *configuration.supercell;
+  Eigen::Matrix3l const &T =
+      supercell.superlattice.transformation_matrix_to_super();
+  Index det = T.determinant();
+  Eigen::Matrix3d T_inv_transpose = T.cast<double>().inverse().transpose();
+  Eigen::Matrix3l adj = lround(det * T_inv_transpose);
+  if (det < 0) {
+    det = -det;
+    adj = -adj;
+  }
+  xtal::UnitCellIndexConverter kpoint_index_converter(T.transpose());
+  Index n_kpoints = kpoint_index_converter.total_sites();
+  std::vector<Eigen::Vector3l> numerator(n_kpoints);
+  for (Index q = 0; q < n_kpoints; ++q) {
+    numerator[q] = adj * kpoint_index_converter(q);
+  }
+
+  // exp(-2*pi*i * k.R) only depends on (numerator.R) mod det
+  std::vector<std::complex<double>> phase(det);
+  for (Index r = 0; r < det; ++r) {
+    phase[r] = std::polar(1.0, -2.0 * M_PI * r / det);
+  }
+
+  Index n_sites = supercell.unitcellcoord_index_converter.total_sites();
+  Eigen::VectorXi const *occupation = nullptr;
+  Eigen::MatrixXd const *values = nullptr;
+  if (prim_dof_space.dof_key == "occ") {
+    occupation = &configuration.dof_values.occupation;
+  } else {
+    values = &configuration.dof_values.local_dof_values.at(
+        prim_dof_space.dof_key);
+  }
+  std::vector<Index> const &dof_component =
+      *prim_dof_space.axis_info.dof_component;
+  Eigen::MatrixXcd U =
+      Eigen::MatrixXcd::Zero(prim_dof_space.basis.rows(), n_kpoints);
+  for (Index l = 0; l < n_sites; ++l) {
+    xtal::UnitCellCoord bijk = supercell.unitcellcoord_index_converter(l);
+    for (Index j : rows[bijk.sublattice()]) {
+      double value = occupation ? ((*occupation)(l) == dof_component[j])
+                                : (*values)(dof_component[j], l);
+      if (value == 0.0) {
+        continue;
+      }
+      for (Index q = 0; q < n_kpoints; ++q) {
+        Index r = numerator[q].dot(bijk.unitcell()) % det;
+        U(j, q) += value * phase[r < 0 ? r + det : r];
+      }
+    }
+  }
+  U /= static_cast<double>(supercell.superlattice.size());
+  for (Index q = 0; q < n_kpoints; ++q) {
+    add(make_kpoint_key(numerator[q], det), U.col(q));
+  }
+}
+
+/// \brief Return the fully commensurate supercell of a set of
+///     superlattices, with canonical lattice
+std::shared_ptr<Supercell const> make_fully_commensurate_supercell(
+    std::shared_ptr<Prim const> const &prim,
+    std::set<xtal::Lattice> const &lattices) {
+  auto const &fg = prim->sym_info.factor_group->element;
+  xtal::Lattice super_lat = xtal::make_fully_commensurate_superduperlattice(
+      lattices.begin(), lattices.end(), fg.begin(), fg.end());
+  auto const &pg = prim->sym_info.point_group->element;
+  super_lat = xtal::canonical::equivalent(super_lat, pg);
+  return std::make_shared<Supercell const>(prim, super_lat);
+}
+
+/// \brief Return the standard DoF space used by config_space_analysis
+///
+/// This is sparse, so the dense basis of the fully commensurate supercell
+/// is only constructed once, for the results.
+SparseDoFSpace make_config_space_standard_dof_space(
+    DoFKey const &dof_key, Supercell const &supercell,
+    std::optional<bool> exclude_homogeneous_modes,
+    bool include_default_occ_modes,
+    std::optional<std::map<int, int>> const &sublattice_index_to_default_occ,
+    std::optional<std::map<Index, int>> const &site_index_to_default_occ) {
+  SparseDoFSpace dof_space_pre2 = make_sparse_dof_space(
+      dof_key, supercell.prim->basicstructure,
+      supercell.superlattice.transformation_matrix_to_super());
+
+  SparseDoFSpace dof_space_pre1 = exclude_homogeneous_mode_space(
+      dof_space_pre2, exclude_homogeneous_modes);
+
+  return exclude_default_occ_modes(dof_space_pre1, include_default_occ_modes,
+                                   sublattice_index_to_default_occ,
+                                   site_index_to_default_occ);
+}
+
+/// \brief Add x*x^T, for the DoF values x of the distinct equivalents of
+///     `prototype`, to the lower triangle of the projector
+///
+/// If `equivalent_dof_values` and `equivalent_configurations` are not
+/// null, the equivalents are generated and stored, else they are
+/// generated one operation at a time by `make_streaming_projector_lower`.
+void add_equivalents_to_projector(
+    Configuration const &prototype, SparseDoFSpace const &dof_space,
+    double tol, Index batch_size, Index n_threads, Eigen::MatrixXd &P_lower,
+    std::vector<Eigen::VectorXd> *equivalent_dof_values,
+    std::vector<Configuration> *equivalent_configurations) {
+  if (!equivalent_dof_values || !equivalent_configurations) {
+    P_lower += make_streaming_projector_lower(prototype, dof_space, tol,
+                                              batch_size, n_threads);
+    return;
+  }
+  auto const &supercell = prototype.supercell;
+  std::vector<Configuration> equivalents =
+      make_equivalents(prototype, SupercellSymOp::begin(supercell),
+                       SupercellSymOp::end(supercell));
+
+  // normal coordinates of all equivalents, by one matrix product
+  Eigen::MatrixXd X =
+      make_normal_coordinates(equivalents, dof_space).transpose();
+  std::vector<Eigen::VectorXd> equiv_x;
+  for (Index j = 0; j < X.cols(); ++j) {
+    for (Index i = 0; i < X.rows(); ++i) {
+      if (almost_zero(X(i, j), tol)) {
+        X(i, j) = 0.0;
+      }
+    }
+    equiv_x.push_back(X.col(j));
+  }
+  P_lower.selfadjointView<Eigen::Lower>().rankUpdate(X);
+  *equivalent_dof_values = std::move(equiv_x);
+  *equivalent_configurations = std::move(equivalents);
+}
+
+/// \brief Make config space analysis results from the lower triangle of
+///     the projector, by eigendecomposition
+ConfigSpaceAnalysisResults make_config_space_analysis_results(
+    SparseDoFSpace const &sparse_standard_dof_space,
+    Eigen::MatrixXd const &P_lower, double tol,
+    std::map<std::string, std::vector<Eigen::VectorXd>> equivalent_dof_values,
+    std::map<std::string, std::vector<Configuration>>
+        equivalent_configurations,
+    std::string const &method_name) {
+  Eigen::MatrixXd P = P_lower.selfadjointView<Eigen::Lower>();
+
+  // clean up P?
+  for (int i = 0; i < P.rows(); ++i) {
+    for (int j = 0; j < P.cols(); ++j) {
+      if (almost_zero(P(i, j), tol)) {
+        P(i, j) = 0.0;
+      }
+    }
+  }
+
+  // --- Eigendecomposition of P ---
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(P);
+  Eigen::VectorXd D = solver.eigenvalues();
+  Eigen::MatrixXd V = solver.eigenvectors();
+
+  // std::cout << "eigenvalues:\n" << D << std::endl;
+  // std::cout << "eigenvectors:\n" << V << std::endl;
+  // std::cout << "check:\n" << V * D.asDiagonal() * V.transpose() <<
+  // std::endl;
+
+  // --- Identify non-zero eigenvalues and corresponding eigenvectors ---
+  Eigen::VectorXd D_nonzero(D.size());
+  Eigen::MatrixXd V_nonzero(P.rows(), P.cols());
+
+  int i_nonzero = 0;
+  for (int i = 0; i < D.size(); ++i) {
+    if (!almost_zero(D(i), tol)) {
+      D_nonzero(i_nonzero) = D(i);
+      V_nonzero.col(i_nonzero) = V.col(i);
+      ++i_nonzero;
+    }
+  }
+
+  // std::cout << "non-zero eigenvalues:\n"
+  //           << D_nonzero.head(i_nonzero) << std::endl;
+  // std::cout << "non-zero eigenvectors:\n"
+  //           << V_nonzero.leftCols(i_nonzero) << std::endl;
+  // std::cout << "B * non-zero eigenvectors:\n"
+  //           << standard_dof_space.basis() * V_nonzero.leftCols(i_nonzero)
+  //           << std::endl;
+
+  if (i_nonzero == 0) {
+    throw std::runtime_error("Error in " + method_name +
+                             ": symmetry adapted config space is null");
+  }
+
+  // --- Store results ---
+  Eigen::VectorXd eigenvalues = D_nonzero.head(i_nonzero);
+
+  clexulator::DoFSpace standard_dof_space =
+      make_dense_dof_space(sparse_standard_dof_space);
+
+  clexulator::DoFSpace symmetry_adapted_dof_space =
+      clexulator::make_dof_space(
+          standard_dof_space.dof_key, standard_dof_space.prim,
+          standard_dof_space.transformation_matrix_to_super,
+          standard_dof_space.sites,
+          sparse_standard_dof_space.basis * V_nonzero.leftCols(i_nonzero));
+
+  return ConfigSpaceAnalysisResults(
+      standard_dof_space, std::move(equivalent_dof_values),
+      std::move(equivalent_configurations), P, eigenvalues,
+      symmetry_adapted_dof_space);
+}
+
+}  // namespace
+
 ConfigSpaceAnalysisResults::ConfigSpaceAnalysisResults(
     clexulator::DoFSpace const &_standard_dof_space,
     std::map<std::string, std::vector<Eigen::VectorXd>> _equivalent_dof_values,
@@ -60,6 +412,20 @@ ConfigSpaceAnalysisResults::ConfigSpaceAnalysisResults(
 /// \param site_index_to_default_occ Optional values of default
 ///     occupation index (value), specified by supercell site index (key).
 /// \param tol Tolerance used for identifying zero-valued eigenvalues.
+/// \param store_equivalents If true (default), store all equivalent
+///     configurations and their DoF values in the results. If false, the
+///     equivalents are generated one operation at a time and not stored,
+///     so memory use does not depend on the number of equivalents, and
+///     `equivalent_dof_values` and `equivalent_configurations` are empty.
+/// \param batch_size Number of DoF vectors accumulated into the projector
+///     per rank-k update. Only used if `store_equivalents` is false.
+/// \param n_threads Number of threads used to accumulate the projector
+///     for each input configuration. If <= 0, uses
+///     `resolve_n_threads(n_threads)`. Only used if `store_equivalents` is
+///     false.
+/// \param progress If provided, report progress with one stage per DoF
+///     type, and one work item per distinct primitive configuration, and
+///     check for cancellation.
 ///
 /// \returns Results, including project, eigenvalues, and symmetry
 ///     adapted basis, for each requested DoF type.
@@ -69,7 +435,9 @@ std::map<DoFKey, ConfigSpaceAnalysisResults> config_space_analysis(
     std::optional<bool> exclude_homogeneous_modes,
     bool include_default_occ_modes,
     std::optional<std::map<int, int>> sublattice_index_to_default_occ,
-    std::optional<std::map<Index, int>> site_index_to_default_occ, double tol) {
+    std::optional<std::map<Index, int>> site_index_to_default_occ, double tol,
+    bool store_equivalents, Index batch_size, Index n_threads,
+    std::shared_ptr<ProgressMonitor> progress) {
   std::map<DoFKey, ConfigSpaceAnalysisResults> results;
 
   if (configurations.size() == 0) {
@@ -94,129 +462,582 @@ std::map<DoFKey, ConfigSpaceAnalysisResults> config_space_analysis(
   for (auto const &pair : prim_configs) {
     lattices.insert(pair.first.supercell->superlattice.superlattice());
   }
-  auto const &fg = prim->sym_info.factor_group->element;
-  xtal::Lattice super_lat = xtal::make_fully_commensurate_superduperlattice(
-      lattices.begin(), lattices.end(), fg.begin(), fg.end());
-  auto const &pg = prim->sym_info.point_group->element;
-  super_lat = xtal::canonical::equivalent(super_lat, pg);
-  auto shared_supercell = std::make_shared<Supercell const>(prim, super_lat);
+  auto shared_supercell = make_fully_commensurate_supercell(prim, lattices);
 
   // --- Generate symmetry adapted config spaces ---
   for (auto const &dof_key : *dofs) {
     // --- Construct the standard DoF space ---
-    clexulator::DoFSpace dof_space_pre2 = clexulator::make_dof_space(
-        dof_key, prim->basicstructure,
-        shared_supercell->superlattice.transformation_matrix_to_super());
-
-    clexulator::DoFSpace dof_space_pre1 = exclude_homogeneous_mode_space(
-        dof_space_pre2, exclude_homogeneous_modes);
-
-    clexulator::DoFSpace standard_dof_space = exclude_default_occ_modes(
-        dof_space_pre1, include_default_occ_modes,
-        sublattice_index_to_default_occ, site_index_to_default_occ);
+    SparseDoFSpace sparse_standard_dof_space =
+        make_config_space_standard_dof_space(
+            dof_key, *shared_supercell, exclude_homogeneous_modes,
+            include_default_occ_modes, sublattice_index_to_default_occ,
+            site_index_to_default_occ);
 
     // --- Begin projector construction ---
     std::map<std::string, std::vector<Eigen::VectorXd>> equivalent_dof_values;
     std::map<std::string, std::vector<Configuration>> equivalent_configurations;
-    Eigen::MatrixXd P = Eigen::MatrixXd::Zero(standard_dof_space.basis.cols(),
-                                              standard_dof_space.basis.cols());
+    Index dim = sparse_standard_dof_space.basis.cols();
 
-    // std::cout << "P:\n" << P << std::endl;
+    // only the lower triangle is accumulated
+    Eigen::MatrixXd P_lower = Eigen::MatrixXd::Zero(dim, dim);
+    begin_progress(progress, "config_space_analysis: " + dof_key,
+                   prim_configs.size());
     for (auto const &prim_config : prim_configs) {
       Configuration prototype =
           copy_configuration(prim_config.first, shared_supercell);
-      std::vector<Configuration> equivalents =
-          make_equivalents(prototype, SupercellSymOp::begin(shared_supercell),
-                           SupercellSymOp::end(shared_supercell));
-
-      std::vector<Eigen::VectorXd> equiv_x;
-      for (auto const &config : equivalents) {
-        Eigen::VectorXd x = get_normal_coordinate(
-            config.dof_values,
-            shared_supercell->superlattice.transformation_matrix_to_super(),
-            standard_dof_space);
-
-        // clean up x?
-        for (int i = 0; i < x.size(); ++i) {
-          if (almost_zero(x(i), tol)) {
-            x(i) = 0.0;
-          }
-        }
-
-        P += x * x.transpose();
-        equiv_x.push_back(x);
-        // std::cout << "P:\n" << P << std::endl;
+      if (!store_equivalents) {
+        add_equivalents_to_projector(prototype, sparse_standard_dof_space, tol,
+                                     batch_size, n_threads, P_lower, nullptr,
+                                     nullptr);
+      } else {
+        add_equivalents_to_projector(
+            prototype, sparse_standard_dof_space, tol, batch_size, n_threads,
+            P_lower, &equivalent_dof_values[prim_config.second],
+            &equivalent_configurations[prim_config.second]);
       }
-      equivalent_dof_values[prim_config.second] = equiv_x;
-      equivalent_configurations[prim_config.second] = equivalents;
+      advance_progress(progress);
     }
-    // std::cout << "P:\n" << P << std::endl;
 
-    // clean up P?
-    for (int i = 0; i < P.rows(); ++i) {
-      for (int j = 0; j < P.cols(); ++j) {
-        if (almost_zero(P(i, j), tol)) {
-          P(i, j) = 0.0;
-        }
-      }
+    results.emplace(dof_key,
+                    make_config_space_analysis_results(
+                        sparse_standard_dof_space, P_lower, tol,
+                        std::move(equivalent_dof_values),
+                        std::move(equivalent_configurations),
+                        "config_space_analysis"));
+  }
+
+  return results;
+}
+
+/// \brief Constructor, with no configurations
+///
+/// \param prim The prim
+/// \param dof_key The DoF type analysed
+///
+/// Other parameters are as for `config_space_analysis`. The supercell is
+/// the prim unit cell until configurations are added.
+ConfigSpaceAnalysisAccumulator::ConfigSpaceAnalysisAccumulator(
+    std::shared_ptr<Prim const> const &prim, DoFKey const &dof_key,
+    std::optional<bool> exclude_homogeneous_modes,
+    bool include_default_occ_modes,
+    std::optional<std::map<int, int>> sublattice_index_to_default_occ,
+    std::optional<std::map<Index, int>> site_index_to_default_occ, double tol,
+    bool store_equivalents, Index batch_size, Index n_threads)
+    : m_prim(prim),
+      m_dof_key(dof_key),
+      m_exclude_homogeneous_modes(exclude_homogeneous_modes),
+      m_include_default_occ_modes(include_default_occ_modes),
+      m_sublattice_index_to_default_occ(sublattice_index_to_default_occ),
+      m_site_index_to_default_occ(site_index_to_default_occ),
+      m_tol(tol),
+      m_store_equivalents(store_equivalents),
+      m_batch_size(batch_size),
+      m_n_threads(n_threads) {
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity();
+  _rebuild(std::make_shared<Supercell const>(m_prim, T));
+}
+
+/// \brief Constructor, continuing from config_space_analysis results
+///
+/// \param results Results of `config_space_analysis`, with stored
+///     equivalents. The projector is rebuilt from
+///     `results.equivalent_dof_values`, without generating equivalents,
+///     and the prototypes are the primitive canonical forms of the first
+///     of `results.equivalent_configurations` for each ID.
+///
+/// Other parameters are as for `config_space_analysis`, and must be the
+/// same as were used to generate `results`.
+ConfigSpaceAnalysisAccumulator::ConfigSpaceAnalysisAccumulator(
+    ConfigSpaceAnalysisResults const &results,
+    std::optional<bool> exclude_homogeneous_modes,
+    bool include_default_occ_modes,
+    std::optional<std::map<int, int>> sublattice_index_to_default_occ,
+    std::optional<std::map<Index, int>> site_index_to_default_occ, double tol,
+    bool store_equivalents, Index batch_size, Index n_threads)
+    : m_dof_key(results.standard_dof_space.dof_key),
+      m_exclude_homogeneous_modes(exclude_homogeneous_modes),
+      m_include_default_occ_modes(include_default_occ_modes),
+      m_sublattice_index_to_default_occ(sublattice_index_to_default_occ),
+      m_site_index_to_default_occ(site_index_to_default_occ),
+      m_tol(tol),
+      m_store_equivalents(store_equivalents),
+      m_batch_size(batch_size),
+      m_n_threads(n_threads) {
+  std::string msg = "Error in ConfigSpaceAnalysisAccumulator: ";
+  if (results.equivalent_configurations.empty() ||
+      results.equivalent_configurations.size() !=
+          results.equivalent_dof_values.size()) {
+    throw std::runtime_error(msg + "results do not include equivalents");
+  }
+  auto const &first = results.equivalent_configurations.begin()->second;
+  if (first.empty()) {
+    throw std::runtime_error(msg + "results do not include equivalents");
+  }
+  m_prim = first.front().supercell->prim;
+  m_supercell = first.front().supercell;
+  m_dof_space = make_config_space_standard_dof_space(
+      m_dof_key, *m_supercell, m_exclude_homogeneous_modes,
+      m_include_default_occ_modes, m_sublattice_index_to_default_occ,
+      m_site_index_to_default_occ);
+  Eigen::MatrixXd const &basis = results.standard_dof_space.basis;
+  if (basis.cols() != m_dof_space.basis.cols() ||
+      !almost_equal(Eigen::MatrixXd(m_dof_space.basis), basis, m_tol)) {
+    throw std::runtime_error(
+        msg + "standard DoF space does not match the method options");
+  }
+
+  Index dim = m_dof_space.basis.cols();
+  m_P_lower = Eigen::MatrixXd::Zero(dim, dim);
+  for (auto const &pair : results.equivalent_configurations) {
+    auto it = results.equivalent_dof_values.find(pair.first);
+    if (pair.second.empty() || it == results.equivalent_dof_values.end()) {
+      throw std::runtime_error(msg + "results do not include equivalents");
+    }
+    Configuration prim_config =
+        make_in_canonical_supercell(make_primitive(pair.second.front()));
+    m_lattices.insert(prim_config.supercell->superlattice.superlattice());
+    m_prim_configs.emplace(prim_config, pair.first);
+    m_ids.insert(pair.first);
+
+    std::vector<Eigen::VectorXd> const &equiv_x = it->second;
+    Eigen::MatrixXd X(dim, equiv_x.size());
+    for (Index j = 0; j < X.cols(); ++j) {
+      X.col(j) = equiv_x[j];
+    }
+    m_P_lower.selfadjointView<Eigen::Lower>().rankUpdate(X);
+    if (m_store_equivalents) {
+      m_equivalent_dof_values.emplace(pair.first, equiv_x);
+      m_equivalent_configurations.emplace(pair.first, pair.second);
     }
+  }
+}
 
-    // --- Eigendecomposition of P ---
-    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(P);
-    Eigen::VectorXd D = solver.eigenvalues();
-    Eigen::MatrixXd V = solver.eigenvectors();
+/// \brief Add configurations, return the number that were not equivalent
+///     to a configuration already added
+///
+/// \param configurations Configurations, with key == configuration
+///     identifier. Configurations equivalent to one already added are
+///     skipped, and the others must not use an identifier already used.
+///     If this throws, no configurations are added.
+///
+/// If all new configurations are commensurate with the current supercell,
+/// the equivalents of each are added to the projector by rank-k updates.
+/// Otherwise, the supercell grows, and the projector is rebuilt from all
+/// added configurations.
+Index ConfigSpaceAnalysisAccumulator::insert(
+    std::map<std::string, Configuration> const &configurations) {
+  std::string msg = "Error in ConfigSpaceAnalysisAccumulator::insert: ";
+  std::map<Configuration, std::string> new_prim_configs;
+  for (auto const &pair : configurations) {
+    Configuration prim_config =
+        make_in_canonical_supercell(make_primitive(pair.second));
+    if (m_prim_configs.count(prim_config)) {
+      continue;
+    }
+    if (m_ids.count(pair.first)) {
+      throw std::runtime_error(msg + "duplicate configuration identifier \"" +
+                               pair.first + "\"");
+    }
+    new_prim_configs.emplace(prim_config, pair.first);
+  }
+  if (new_prim_configs.empty()) {
+    return 0;
+  }
 
-    // std::cout << "eigenvalues:\n" << D << std::endl;
-    // std::cout << "eigenvectors:\n" << V << std::endl;
-    // std::cout << "check:\n" << V * D.asDiagonal() * V.transpose() <<
-    // std::endl;
+  bool was_empty = m_prim_configs.empty();
+  std::set<xtal::Lattice> lattices = m_lattices;
+  for (auto const &pair : new_prim_configs) {
+    lattices.insert(pair.first.supercell->superlattice.superlattice());
+  }
+  auto supercell = make_fully_commensurate_supercell(m_prim, lattices);
+  bool is_changed =
+      supercell->superlattice.transformation_matrix_to_super() !=
+      m_supercell->superlattice.transformation_matrix_to_super();
+  bool has_site_default_occ = m_site_index_to_default_occ.has_value();
+  if (is_changed && has_site_default_occ && !was_empty) {
+    throw std::runtime_error(
+        msg + "supercell changed and site_index_to_default_occ was given");
+  }
 
-    // --- Identify non-zero eigenvalues and corresponding eigenvectors ---
-    Eigen::VectorXd D_nonzero(D.size());
-    Eigen::MatrixXd V_nonzero(P.rows(), P.cols());
+  std::vector<std::map<Configuration, std::string>::const_iterator> added;
+  for (auto const &pair : new_prim_configs) {
+    added.push_back(m_prim_configs.emplace(pair.first, pair.second).first);
+    m_ids.insert(pair.second);
+  }
+  m_lattices = std::move(lattices);
 
-    int i_nonzero = 0;
-    for (int i = 0; i < D.size(); ++i) {
-      if (!almost_zero(D(i), tol)) {
-        D_nonzero(i_nonzero) = D(i);
-        V_nonzero.col(i_nonzero) = V.col(i);
-        ++i_nonzero;
-      }
+  if (is_changed || (was_empty && has_site_default_occ)) {
+    _rebuild(supercell);
+  } else {
+    for (auto const &it : added) {
+      _add(it->first, it->second);
     }
+  }
+  return added.size();
+}
 
-    // std::cout << "non-zero eigenvalues:\n"
-    //           << D_nonzero.head(i_nonzero) << std::endl;
-    // std::cout << "non-zero eigenvectors:\n"
-    //           << V_nonzero.leftCols(i_nonzero) << std::endl;
-    // std::cout << "B * non-zero eigenvectors:\n"
-    //           << standard_dof_space.basis() * V_nonzero.leftCols(i_nonzero)
-    //           << std::endl;
+/// \brief The fully commensurate supercell of the added configurations
+std::shared_ptr<Supercell const> const &
+ConfigSpaceAnalysisAccumulator::supercell() const {
+  return m_supercell;
+}
 
-    if (i_nonzero == 0) {
-      throw std::runtime_error(
-          "Error in config_space_analysis: symmetry adapted config space is "
-          "null");
+/// \brief Dimension of the standard DoF space
+Index ConfigSpaceAnalysisAccumulator::dim() const {
+  return m_dof_space.basis.cols();
+}
+
+/// \brief Number of distinct primitive configurations added
+Index ConfigSpaceAnalysisAccumulator::n_prototypes() const {
+  return m_prim_configs.size();
+}
+
+/// \brief Make results, by eigendecomposition of the current projector
+///
+/// Throws if the symmetry adapted config space is null, including if no
+/// configurations were added.
+ConfigSpaceAnalysisResults ConfigSpaceAnalysisAccumulator::results() const {
+  return make_config_space_analysis_results(
+      m_dof_space, m_P_lower, m_tol, m_equivalent_dof_values,
+      m_equivalent_configurations, "ConfigSpaceAnalysisAccumulator::results");
+}
+
+/// \brief Set the supercell and standard DoF space, and rebuild the
+///     projector from all prototypes
+void ConfigSpaceAnalysisAccumulator::_rebuild(
+    std::shared_ptr<Supercell const> const &supercell) {
+  m_supercell = supercell;
+  // site indices are for the supercell of the first configurations added
+  m_dof_space = make_config_space_standard_dof_space(
+      m_dof_key, *m_supercell, m_exclude_homogeneous_modes,
+      m_include_default_occ_modes, m_sublattice_index_to_default_occ,
+      m_prim_configs.empty() ? std::nullopt : m_site_index_to_default_occ);
+  Index dim = m_dof_space.basis.cols();
+  m_P_lower = Eigen::MatrixXd::Zero(dim, dim);
+  m_equivalent_dof_values.clear();
+  m_equivalent_configurations.clear();
+  for (auto const &pair : m_prim_configs) {
+    _add(pair.first, pair.second);
+  }
+}
+
+/// \brief Add the equivalents of one prototype to the projector
+void ConfigSpaceAnalysisAccumulator::_add(Configuration const &prim_config,
+                                          std::string const &id) {
+  Configuration prototype = copy_configuration(prim_config, m_supercell);
+  if (!m_store_equivalents) {
+    add_equivalents_to_projector(prototype, m_dof_space, m_tol, m_batch_size,
+                                 m_n_threads, m_P_lower, nullptr, nullptr);
+  } else {
+    add_equivalents_to_projector(prototype, m_dof_space, m_tol, m_batch_size,
+                                 m_n_threads, m_P_lower,
+                                 &m_equivalent_dof_values[id],
+                                 &m_equivalent_configurations[id]);
+  }
+}
+
+ConfigSpaceKPointAnalysisResults::ConfigSpaceKPointAnalysisResults(
+    clexulator::DoFSpace const &_standard_dof_space,
+    clexulator::DoFSpace const &_standard_dof_space_k0,
+    std::vector<ConfigSpaceKPoint> _kpoints)
+    : standard_dof_space(_standard_dof_space),
+      standard_dof_space_k0(_standard_dof_space_k0),
+      kpoints(std::move(_kpoints)) {}
+
+/// \brief Dimension of the symmetry adapted config space
+///
+/// This is the sum, over k-points, of the number of non-zero eigenvalues,
+/// and equals the dimension of the real symmetry adapted config space in
+/// any supercell commensurate with all k-points.
+Index ConfigSpaceKPointAnalysisResults::dim() const {
+  Index n = 0;
+  for (auto const &kpoint : kpoints) {
+    n += kpoint.eigenvalues.size();
+  }
+  return n;
+}
+
+/// \brief Construct symmetry adapted bases, by k-point, in the DoF space
+///    spanned by the set of configurations symmetrically equivalent to the
+///    input configurations
+///
+/// This method finds the same symmetry adapted config space as
+/// `config_space_analysis`, but without constructing the fully commensurate
+/// supercell of all input configurations:
+///
+/// 1. Each primitive configuration is transformed by each prim factor
+///    group operation and copied into its own transformed supercell, `R *
+///    T`, so the equivalents of a configuration of volume `N` are never
+///    larger than `N`.
+/// 2. Translations act on Fourier components by a phase only, so the span
+///    of all equivalents, including all translations, is the direct sum over
+///    k-points of the span of their Fourier components. For each
+///    k-point, a projector, `P(k) = sum c(k) * c(k)^H`, is accumulated in the
+///    basis of the prim unit cell DoF space, which has dimension independent
+///    of the supercell.
+/// 3. The eigenvectors of each `P(k)` with non-zero eigenvalues are the
+///    symmetry adapted axes at that k-point.
+///
+/// Cost is O(n_factor_group * sum(N^2) * prim_dim) to find the Fourier
+/// components by direct summation, plus an eigendecomposition of a
+/// prim_dim x prim_dim matrix per k-point, instead of eigendecomposition
+/// in the fully commensurate supercell, whose volume may be the least
+/// common multiple of all input volumes. Use
+/// `make_kpoint_symmetry_adapted_dof_space` to express the results in a
+/// particular supercell.
+///
+/// Notes:
+/// - Each operation contributes with equal weight, so eigenvalues are
+///   normalized differently than by `config_space_analysis`; only the
+///   eigenvectors and the dimension of the space are comparable.
+/// - Homogeneous modes are only excluded at k = 0. Because the DoF space is
+///   that of the prim unit cell, default occupations can only be specified
+///   by sublattice.
+///
+/// \param configurations Map of identifier string -> Configuration
+/// \param dofs Names of degree of freedoms for which the analysis
+///     is run. The default includes all DoF types in the prim.
+/// \param exclude_homogeneous_modes Exclude homogeneous modes if this
+///     is true, or include if this is false. If this is null (default),
+///     exclude homogeneous modes for dof==\"disp\" only.
+/// \param include_default_occ_modes Include the dof component for the
+///     default occupation value on each site with occupation DoF. The
+///     default is to exclude these modes because they are not
+///     independent. This parameter is only checked dof==\"occ\". If
+///     false, the default occupation is determined using
+///     `sublattice_index_to_default_occ` if that is provided, else using
+///     occupation index 0.
+/// \param sublattice_index_to_default_occ Optional values of default
+///     occupation index (value), specified by sublattice index (key).
+/// \param tol Tolerance used for identifying zero-valued eigenvalues.
+/// \param progress If provided, report progress with one stage per DoF
+///     type, and one work item per distinct primitive configuration, and
+///     check for cancellation.
+///
+/// \returns Results, including the projector, eigenvalues, and symmetry
+///     adapted axes at each k-point, for each requested DoF type.
+std::map<DoFKey, ConfigSpaceKPointAnalysisResults> config_space_kpoint_analysis(
+    std::map<std::string, Configuration> const &configurations,
+    std::optional<std::vector<DoFKey>> dofs,
+    std::optional<bool> exclude_homogeneous_modes,
+    bool include_default_occ_modes,
+    std::optional<std::map<int, int>> sublattice_index_to_default_occ,
+    double tol, std::shared_ptr<ProgressMonitor> progress) {
+  std::map<DoFKey, ConfigSpaceKPointAnalysisResults> results;
+
+  if (configurations.size() == 0) {
+    return results;
+  }
+  std::shared_ptr<Prim const> prim =
+      configurations.begin()->second.supercell->prim;
+  if (!dofs.has_value()) {
+    dofs = all_dof_types(*prim->basicstructure);
+  }
+
+  // --- Generate primitive configurations ---
+  std::map<Configuration, std::string> prim_configs;
+  for (auto const &pair : configurations) {
+    prim_configs.emplace(
+        make_in_canonical_supercell(make_primitive(pair.second)), pair.first);
+  }
+
+  // transformed supercells are shared by Hermite normal form
+  SupercellSet supercells(prim);
+  auto const &fg = prim->sym_info.factor_group->element;
+  std::vector<Eigen::Matrix3l> frac_factor_group =
+      make_frac_point_matrices(prim->basicstructure->lattice(), fg);
+  Index n_sublattice = prim->basicstructure->basis().size();
+
+  for (auto const &dof_key : *dofs) {
+    // --- Construct the prim unit cell DoF spaces ---
+    clexulator::DoFSpace prim_dof_space = clexulator::make_dof_space(
+        dof_key, prim->basicstructure, Eigen::Matrix3l::Identity());
+
+    clexulator::DoFSpace standard_dof_space =
+        exclude_default_occ_modes(prim_dof_space, include_default_occ_modes,
+                                  sublattice_index_to_default_occ);
+
+    clexulator::DoFSpace standard_dof_space_k0 = exclude_homogeneous_mode_space(
+        standard_dof_space, exclude_homogeneous_modes);
+
+    std::vector<std::vector<Index>> rows;
+    if (!prim_dof_space.is_global) {
+      rows = make_rows_by_sublattice(prim_dof_space, n_sublattice);
     }
 
-    // --- Store results ---
-    Eigen::VectorXd eigenvalues = D_nonzero.head(i_nonzero);
+    // --- Accumulate projectors by k-point ---
+    std::map<KPointKey, Eigen::MatrixXcd> P_by_kpoint;
+    begin_progress(progress, "config_space_kpoint_analysis: " + dof_key,
+                   prim_configs.size());
+    for (auto const &prim_config : prim_configs) {
+      Configuration const &prototype = prim_config.first;
+      Eigen::Matrix3l const &T =
+          prototype.supercell->superlattice.transformation_matrix_to_super();
+      for (Index g = 0; g < fg.size(); ++g) {
+        auto const &supercell =
+            supercells.insert(make_hnf(frac_factor_group[g] * T))
+                .first->supercell;
+        add_kpoint_projectors(
+            copy_configuration(g, UnitCell(0, 0, 0), prototype, supercell),
+            prim_dof_space, rows, standard_dof_space, standard_dof_space_k0,
+            P_by_kpoint);
+      }
+      advance_progress(progress);
+    }
 
-    clexulator::DoFSpace symmetry_adapted_dof_space =
-        clexulator::make_dof_space(
-            standard_dof_space.dof_key, standard_dof_space.prim,
-            standard_dof_space.transformation_matrix_to_super,
-            standard_dof_space.sites,
-            standard_dof_space.basis * V_nonzero.leftCols(i_nonzero));
+    // --- Eigendecomposition of each P(k) ---
+    std::vector<ConfigSpaceKPoint> kpoints;
+    for (auto const &pair : P_by_kpoint) {
+      Eigen::MatrixXcd P = pair.second / static_cast<double>(fg.size());
+      for (Index i = 0; i < P.rows(); ++i) {
+        for (Index j = 0; j < P.cols(); ++j) {
+          if (almost_zero(std::abs(P(i, j)), tol)) {
+            P(i, j) = 0.0;
+          }
+        }
+      }
+
+      Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver(P);
+      Eigen::VectorXd const &D = solver.eigenvalues();
+      std::vector<Index> nonzero;
+      for (Index i = 0; i < D.size(); ++i) {
+        if (!almost_zero(D(i), tol)) {
+          nonzero.push_back(i);
+        }
+      }
+      if (nonzero.empty()) {
+        continue;
+      }
+
+      ConfigSpaceKPoint kpoint;
+      KPointKey const &key = pair.first;
+      kpoint.numerator << key[0], key[1], key[2];
+      kpoint.denominator = key[3];
+      kpoint.projector = P;
+      kpoint.eigenvalues.resize(nonzero.size());
+      kpoint.eigenvectors.resize(P.rows(), nonzero.size());
+      for (Index i = 0; i < nonzero.size(); ++i) {
+        kpoint.eigenvalues(i) = D(nonzero[i]);
+        kpoint.eigenvectors.col(i) = solver.eigenvectors().col(nonzero[i]);
+      }
+      kpoints.push_back(std::move(kpoint));
+    }
+
+    if (kpoints.empty()) {
+      throw std::runtime_error(
+          "Error in config_space_kpoint_analysis: symmetry adapted config "
+          "space is null");
+    }
 
     results.emplace(std::piecewise_construct, std::forward_as_tuple(dof_key),
-                    std::forward_as_tuple(
-                        standard_dof_space, std::move(equivalent_dof_values),
-                        std::move(equivalent_configurations), P, eigenvalues,
-                        symmetry_adapted_dof_space));
+                    std::forward_as_tuple(standard_dof_space,
+                                          standard_dof_space_k0,
+                                          std::move(kpoints)));
   }
 
   return results;
 }
 
+/// \brief Return the symmetry adapted config space of k-point analysis
+///     results in a supercell
+///
+/// \param results Results of `config_space_kpoint_analysis` for one DoF
+///     type
+/// \param supercell A supercell commensurate with all k-points of
+///     `results`, for example the fully commensurate supercell constructed
+///     by `config_space_analysis`
+/// \param tol Tolerance used for identifying zero-valued singular values
+///
+/// \returns A DoFSpace in `supercell`, with an orthonormal basis spanning
+///     the real and imaginary parts of the plane waves
+///     `exp(2*pi*i * k.R) * B(k) * v`, for the eigenvectors `v` at each
+///     k-point, where `B(k)` is the basis of the standard DoF space for the
+///     k-point. Its dimension is `results.dim()`.
+///
+/// Throws if a k-point is not commensurate with the supercell.
+clexulator::DoFSpace make_kpoint_symmetry_adapted_dof_space(
+    ConfigSpaceKPointAnalysisResults const &results,
+    std::shared_ptr<Supercell const> const &supercell, double tol) {
+  clexulator::DoFSpace const &prim_dof_space = results.standard_dof_space;
+  Eigen::Matrix3l const &T =
+      supercell->superlattice.transformation_matrix_to_super();
+  clexulator::DoFSpace supercell_dof_space = clexulator::make_dof_space(
+      prim_dof_space.dof_key, prim_dof_space.prim, T);
+  Index dim = supercell_dof_space.basis.rows();
+
+  // prim DoF space row, by (sublattice, dof_component)
+  std::map<std::pair<Index, Index>, Index> prim_row;
+  if (!prim_dof_space.is_global) {
+    std::vector<Index> const &site_index =
+        *prim_dof_space.axis_info.site_index;
+    std::vector<Index> const &dof_component =
+        *prim_dof_space.axis_info.dof_component;
+    for (Index p = 0; p < site_index.size(); ++p) {
+      prim_row.emplace(std::make_pair(site_index[p], dof_component[p]), p);
+    }
+  }
+
+  std::vector<Eigen::MatrixXcd> waves;
+  Index n_waves = 0;
+  for (auto const &kpoint : results.kpoints) {
+    clexulator::DoFSpace const &space = kpoint.is_zero()
+                                            ? results.standard_dof_space_k0
+                                            : results.standard_dof_space;
+    Eigen::MatrixXcd Y =
+        space.basis.cast<std::complex<double>>() * kpoint.eigenvectors;
+    if (prim_dof_space.is_global) {
+      waves.push_back(Y);
+      n_waves += Y.cols();
+      continue;
+    }
+
+    Index d = kpoint.denominator;
+    Eigen::Vector3l m = T.transpose() * kpoint.numerator;
+    for (Index i = 0; i < 3; ++i) {
+      if (m(i) % d != 0) {
+        throw std::runtime_error(
+            "Error in make_kpoint_symmetry_adapted_dof_space: k-point is not "
+            "commensurate with the supercell");
+      }
+    }
+    std::vector<Index> const &site_index =
+        *supercell_dof_space.axis_info.site_index;
+    std::vector<Index> const &dof_component =
+        *supercell_dof_space.axis_info.dof_component;
+    Eigen::MatrixXcd W(dim, Y.cols());
+    for (Index j = 0; j < dim; ++j) {
+      xtal::UnitCellCoord bijk =
+          supercell->unitcellcoord_index_converter(site_index[j]);
+      Index r = kpoint.numerator.dot(bijk.unitcell()) % d;
+      std::complex<double> phase =
+          std::polar(1.0, 2.0 * M_PI * (r < 0 ? r + d : r) / d);
+      Index p =
+          prim_row.at(std::make_pair(bijk.sublattice(), dof_component[j]));
+      W.row(j) = phase * Y.row(p);
+    }
+    waves.push_back(W);
+    n_waves += W.cols();
+  }
+
+  // orthonormal basis for the real and imaginary parts of all waves
+  Eigen::MatrixXd M(dim, 2 * n_waves);
+  Index col = 0;
+  for (auto const &W : waves) {
+    M.middleCols(col, W.cols()) = W.real();
+    M.middleCols(n_waves + col, W.cols()) = W.imag();
+    col += W.cols();
+  }
+  Eigen::BDCSVD<Eigen::MatrixXd> svd(M, Eigen::ComputeThinU);
+  Eigen::VectorXd const &s = svd.singularValues();
+  Index rank = 0;
+  while (rank < s.size() && s(rank) > tol) {
+    ++rank;
+  }
+  return clexulator::make_dof_space(
+      supercell_dof_space.dof_key, supercell_dof_space.prim,
+      supercell_dof_space.transformation_matrix_to_super,
+      supercell_dof_space.sites, svd.matrixU().leftCols(rank));
+}
+
 }  // namespace config
 }  // namespace CASM
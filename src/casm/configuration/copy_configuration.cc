@@ -1,90 +1,558 @@
 #include "casm/configuration/copy_configuration.hh"
 
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
 #include "casm/configuration/ConfigIsEquivalent.hh"
 #include "casm/configuration/Configuration.hh"
+#include "casm/configuration/PackedOccupation.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/SupercellSymInfo.hh"
 #include "casm/configuration/SupercellSymOp.hh"
 #include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/parallel.hh"
 
 namespace CASM {
 namespace config {
 
 namespace {
 
-SupercellSymOp find_translation(Configuration const &configuration) {
-  auto begin = SupercellSymOp::translation_begin(configuration.supercell);
-  auto end = SupercellSymOp::translation_end(configuration.supercell);
-  if (++begin == end) {
-    return end;
+/// \brief Find the translations that leave a configuration invariant
+///
+/// The translations of a supercell form a finite abelian group, G, so if a
+/// subgroup, H, of invariant translations is not all of them, there is an
+/// invariant translation t not in H with p*t in H, for some prime p that
+/// divides |G|/|H|. Only those translations are checked, and when one is
+/// found H is extended by the multiples of t, until no more are found.
+/// Candidates are first checked by comparing occupation along the
+/// translation, and then by `ConfigIsEquivalent` if there are local
+/// continuous DoF.
+///
+/// Global DoF values are not changed by translations, so they do not need
+/// to be checked. For an OccConfiguration, only the packed occupation is
+/// checked.
+class InvariantTranslationFinder {
+ public:
+  InvariantTranslationFinder(Configuration const &configuration)
+      : InvariantTranslationFinder(*configuration.supercell) {
+    m_configuration = &configuration;
+  }
+
+  InvariantTranslationFinder(OccConfiguration const &configuration)
+      : InvariantTranslationFinder(*configuration.supercell) {
+    m_occ_configuration = &configuration;
+  }
+
+  /// \brief Find a translation that leaves the configuration invariant,
+  ///     and is not in the current subgroup, and extend the subgroup with
+  ///     it; return false if there is none
+  bool extend() {
+    auto const &converter = m_supercell.unitcell_index_converter;
+    Index quotient_size = m_n_unitcells / m_subgroup_size;
+    for (Index p : m_primes) {
+      if (quotient_size % p != 0) {
+        continue;
+      }
+      for (Index t = 1; t < m_n_unitcells; ++t) {
+        if (m_subgroup[t]) {
+          continue;
+        }
+        UnitCell translation = converter(t);
+        if (!m_subgroup[converter(UnitCell(p * translation))] ||
+            !_is_invariant(t)) {
+          continue;
+        }
+        std::vector<Index> subgroup = invariant_translations();
+        for (Index h : subgroup) {
+          UnitCell uc = converter(h);
+          for (Index k = 1; k < p; ++k) {
+            m_subgroup[converter(UnitCell(uc + k * translation))] = true;
+          }
+        }
+        m_subgroup_size *= p;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// \brief Unit cell indices of the translations in the current subgroup
+  std::vector<Index> invariant_translations() const {
+    std::vector<Index> translations;
+    for (Index t = 0; t < m_n_unitcells; ++t) {
+      if (m_subgroup[t]) {
+        translations.push_back(t);
+      }
+    }
+    return translations;
+  }
+
+  /// \brief Number of translations in the current subgroup
+  Index subgroup_size() const { return m_subgroup_size; }
+
+ private:
+  explicit InvariantTranslationFinder(Supercell const &supercell)
+      : m_configuration(nullptr),
+        m_occ_configuration(nullptr),
+        m_supercell(supercell),
+        m_n_unitcells(m_supercell.unitcell_index_converter.total_sites()),
+        m_translation_table(
+            m_supercell.superlattice.transformation_matrix_to_super(),
+            m_supercell.unitcell_index_converter,
+            m_supercell.unitcellcoord_index_converter),
+        m_subgroup(m_n_unitcells, false),
+        m_subgroup_size(1) {
+    m_subgroup[0] = true;
+    Index n = m_n_unitcells;
+    for (Index p = 2; p * p <= n; ++p) {
+      if (n % p == 0) {
+        m_primes.push_back(p);
+        while (n % p == 0) {
+          n /= p;
+        }
+      }
+    }
+    if (n > 1) {
+      m_primes.push_back(n);
+    }
+  }
+
+  bool _is_invariant(Index t) const {
+    if (m_occ_configuration) {
+      PackedOccupation const &occupation = m_occ_configuration->occupation;
+      for (Index i = 0; i < occupation.size(); ++i) {
+        if (occupation[m_translation_table.permute_index(t, i)] !=
+            occupation[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+    Configuration const &configuration = *m_configuration;
+    Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+    for (Index i = 0; i < occupation.size(); ++i) {
+      if (occupation(m_translation_table.permute_index(t, i)) !=
+          occupation(i)) {
+        return false;
+      }
+    }
+    if (configuration.dof_values.local_dof_values.empty()) {
+      return true;
+    }
+    if (!m_is_equivalent.has_value()) {
+      m_is_equivalent.emplace(configuration);
+    }
+    return (*m_is_equivalent)(SupercellSymOp(configuration.supercell, 0, t));
+  }
+
+  /// Configuration checked, or null if m_occ_configuration is checked
+  Configuration const *m_configuration;
+
+  /// OccConfiguration checked, or null if m_configuration is checked
+  OccConfiguration const *m_occ_configuration;
+
+  Supercell const &m_supercell;
+
+  Index m_n_unitcells;
+
+  /// Translation permutations, constructed without the supercell symmetry
+  /// info
+  SupercellTranslationTable m_translation_table;
+
+  /// Constructed on first use, because it requires the supercell symmetry
+  /// info
+  mutable std::optional<ConfigIsEquivalent> m_is_equivalent;
+
+  /// Prime factors of m_n_unitcells
+  std::vector<Index> m_primes;
+
+  /// m_subgroup[t] is true if translation t is in the current subgroup
+  std::vector<bool> m_subgroup;
+
+  Index m_subgroup_size;
+};
+
+/// \brief Return a basis, as columns, for the integer lattice generated by
+///     `generators`
+///
+/// Uses integer column operations, so the result is lower triangular.
+Eigen::Matrix3l make_integer_lattice_basis(
+    std::vector<Eigen::Vector3l> generators) {
+  Index m = generators.size();
+  for (Index r = 0; r < 3; ++r) {
+    while (true) {
+      Index pivot = -1;
+      for (Index c = r; c < m; ++c) {
+        if (generators[c](r) != 0 &&
+            (pivot == -1 ||
+             std::abs(generators[c](r)) < std::abs(generators[pivot](r)))) {
+          pivot = c;
+        }
+      }
+      if (pivot == -1) {
+        throw std::runtime_error(
+            "Error in make_integer_lattice_basis: generators do not span a "
+            "3d lattice");
+      }
+      std::swap(generators[r], generators[pivot]);
+      bool reduced = true;
+      for (Index c = r + 1; c < m; ++c) {
+        generators[c] -= (generators[c](r) / generators[r](r)) * generators[r];
+        if (generators[c](r) != 0) {
+          reduced = false;
+        }
+      }
+      if (reduced) {
+        break;
+      }
+    }
+  }
+  Eigen::Matrix3l basis;
+  for (Index c = 0; c < 3; ++c) {
+    basis.col(c) = generators[c];
+  }
+  return basis;
+}
+
+}  // namespace
+
+namespace {
+
+/// \brief Process-wide cache of ConfigurationCopyMap
+struct ConfigurationCopyMapCache {
+  /// (motif supercell, supercell, prim factor group index or -1,
+  ///  translation, origin)
+  typedef std::tuple<Supercell const *, Supercell const *, Index, long, long,
+                     long, long, long, long>
+      key_type;
+
+  struct value_type {
+    key_type key;
+    std::shared_ptr<ConfigurationCopyMap const> copy_map;
+  };
+
+  std::mutex mutex;
+
+  /// Least recently used maps are evicted if there are more than this
+  Index max_size = 256;
+
+  /// Most recently used first
+  std::list<value_type> lru;
+
+  std::map<key_type, std::list<value_type>::iterator> index;
+
+  /// \brief Return a map from the cache, or construct and insert it
+  std::shared_ptr<ConfigurationCopyMap const> get(
+      key_type const &key,
+      std::shared_ptr<Supercell const> const &motif_supercell,
+      std::shared_ptr<Supercell const> const &supercell,
+      std::function<ConfigurationCopyMap()> make) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = _find(key, motif_supercell, supercell);
+      if (it != index.end()) {
+        return it->second->copy_map;
+      }
+    }
+
+    // construct without holding the lock
+    auto copy_map = std::make_shared<ConfigurationCopyMap const>(make());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = _find(key, motif_supercell, supercell);
+    if (it != index.end()) {
+      return it->second->copy_map;
+    }
+    lru.push_front(value_type{key, copy_map});
+    index.emplace(key, lru.begin());
+    while (Index(lru.size()) > max_size) {
+      index.erase(lru.back().key);
+      lru.pop_back();
+    }
+    return copy_map;
+  }
+
+ private:
+  /// \brief Find a valid entry and make it most recently used, or erase an
+  ///     entry for supercells that no longer exist; requires lock
+  std::map<key_type, std::list<value_type>::iterator>::iterator _find(
+      key_type const &key,
+      std::shared_ptr<Supercell const> const &motif_supercell,
+      std::shared_ptr<Supercell const> const &supercell) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+      return it;
+    }
+    ConfigurationCopyMap const &copy_map = *it->second->copy_map;
+    if (copy_map.motif_supercell() != motif_supercell ||
+        copy_map.supercell() != supercell) {
+      lru.erase(it->second);
+      index.erase(it);
+      return index.end();
+    }
+    lru.splice(lru.begin(), lru, it->second);
+    return it;
   }
-  ConfigIsEquivalent f(configuration);
-  return std::find_if(begin, end, f);
+};
+
+ConfigurationCopyMapCache &configuration_copy_map_cache() {
+  static ConfigurationCopyMapCache *cache = new ConfigurationCopyMapCache();
+  return *cache;
+}
+
+ConfigurationCopyMapCache::key_type make_copy_map_key(
+    std::shared_ptr<Supercell const> const &motif_supercell,
+    std::shared_ptr<Supercell const> const &supercell,
+    Index prim_factor_group_index, UnitCell const &translation,
+    UnitCell const &origin) {
+  return std::make_tuple(motif_supercell.get(), supercell.get(),
+                         prim_factor_group_index, translation(0),
+                         translation(1), translation(2), origin(0), origin(1),
+                         origin(2));
 }
 
 }  // namespace
 
-/// \brief Copy configuration DoF values into a supercell
+/// \brief Constructor, for copying without transformation
 ///
-/// \param motif The initial configuration
-/// \param supercell The Supercell of the new configuration
+/// \param _motif_supercell The Supercell of the initial configurations
+/// \param _supercell The Supercell of the new configurations
 /// \param origin The UnitCell indicating which unit cell in the
 ///        initial configuration is the origin in new configuration
+ConfigurationCopyMap::ConfigurationCopyMap(
+    std::shared_ptr<Supercell const> const &_motif_supercell,
+    std::shared_ptr<Supercell const> const &_supercell, UnitCell const &origin)
+    : m_prim(_supercell->prim),
+      m_motif_supercell(_motif_supercell),
+      m_supercell(_supercell) {
+  if (_supercell->prim != _motif_supercell->prim) {
+    throw std::runtime_error(
+        "Error in CASM::config::copy_configuration: prim mismatch.");
+  }
+  auto const &converter = _supercell->unitcellcoord_index_converter;
+  auto const &motif_converter = _motif_supercell->unitcellcoord_index_converter;
+  Index total_sites = converter.total_sites();
+  m_motif_site_index.resize(total_sites);
+  m_motif_sublattice.resize(total_sites);
+  for (Index i = 0; i < total_sites; i++) {
+    // equivalent site in motif
+    UnitCellCoord unitcellcoord = converter(i);
+    m_motif_site_index[i] = motif_converter(unitcellcoord + origin);
+    m_motif_sublattice[i] = unitcellcoord.sublattice();
+  }
+}
+
+/// \brief Constructor, for copying with a prim factor group operation and
+///     translation
+///
+/// \param _prim_factor_group_index Index of prim factor group operation
+///     which transforms the initial configuration
+/// \param translation Lattice translation applied after the prim factor
+///     group operation
+/// \param _motif_supercell The Supercell of the initial configurations
+/// \param _supercell The Supercell of the new configurations
+/// \param origin The UnitCell indicating which unit cell in the
+///        transformed configuration is the origin in new configuration
+///
+/// Sites map according to:
+///     new_config_unitcellcoord + origin = fg * motif_unitcellcoord + trans
+ConfigurationCopyMap::ConfigurationCopyMap(
+    Index _prim_factor_group_index, UnitCell translation,
+    std::shared_ptr<Supercell const> const &_motif_supercell,
+    std::shared_ptr<Supercell const> const &_supercell, UnitCell const &origin)
+    : m_prim(_supercell->prim),
+      m_motif_supercell(_motif_supercell),
+      m_supercell(_supercell),
+      m_prim_factor_group_index(_prim_factor_group_index) {
+  if (_supercell->prim != _motif_supercell->prim) {
+    throw std::runtime_error(
+        "Error in CASM::config::copy_configuration (and transform): prim "
+        "mismatch.");
+  }
+  auto const &unitcellcoord_rep = m_prim->sym_info.unitcellcoord_symgroup_rep;
+  Index inverse_prim_factor_group_index =
+      m_prim->sym_info.factor_group->inverse_index[_prim_factor_group_index];
+
+  auto const &converter = _supercell->unitcellcoord_index_converter;
+  auto const &motif_converter = _motif_supercell->unitcellcoord_index_converter;
+  Index total_sites = converter.total_sites();
+  m_motif_site_index.resize(total_sites);
+  m_motif_sublattice.resize(total_sites);
+  for (Index i = 0; i < total_sites; i++) {
+    // motif_unitcellcoord, the site which transforms to site i in new_config
+    // motif_unitcellcoord = fg_inverse * (unitcellcoord  + origin - trans)
+    UnitCellCoord motif_unitcellcoord =
+        copy_apply(unitcellcoord_rep[inverse_prim_factor_group_index],
+                   (converter(i) + origin - translation));
+    m_motif_site_index[i] = motif_converter(motif_unitcellcoord);
+    m_motif_sublattice[i] = motif_unitcellcoord.sublattice();
+  }
+}
+
+/// \brief Copy DoF values of a configuration in the motif supercell
 ///
 /// Notes:
 /// - This method assumes the motif forms an infinite crystal and copies site
 ///   DoF values that lie inside `supercell` directory into a new configuration.
-///
-Configuration copy_configuration(
-    Configuration const &motif,
-    std::shared_ptr<Supercell const> const &supercell, UnitCell const &origin) {
-  if (supercell->prim != motif.supercell->prim) {
+Configuration ConfigurationCopyMap::copy(Configuration const &motif) const {
+  if (motif.supercell != m_motif_supercell.lock()) {
     throw std::runtime_error(
-        "Error in CASM::config::copy_configuration: prim mismatch.");
+        "Error in ConfigurationCopyMap::copy: motif supercell mismatch.");
+  }
+  std::shared_ptr<Supercell const> supercell = m_supercell.lock();
+  if (supercell == nullptr) {
+    throw std::runtime_error(
+        "Error in ConfigurationCopyMap::copy: supercell no longer exists.");
   }
-
-  Index supercell_total_sites =
-      supercell->unitcellcoord_index_converter.total_sites();
-
-  // construct new_config
   Configuration new_config{supercell};
+  Index total_sites = m_motif_site_index.size();
 
   // copy global DoF values
-  new_config.dof_values.global_dof_values = motif.dof_values.global_dof_values;
+  new_config.dof_values.global_dof_values =
+      copy_global_properties(motif.dof_values.global_dof_values);
 
   // copy occupation values
-  for (Index i = 0; i < supercell_total_sites; i++) {
-    // unitcellcoord of site i in new_config
-    UnitCellCoord unitcellcoord =
-        new_config.supercell->unitcellcoord_index_converter(i);
-
-    // equivalent site in configuration
-    Index motif_site_index =
-        motif.supercell->unitcellcoord_index_converter(unitcellcoord + origin);
-
-    // copy occupation value
-    new_config.dof_values.occupation(i) =
-        motif.dof_values.occupation(motif_site_index);
+  Eigen::VectorXi const &occ_motif = motif.dof_values.occupation;
+  Eigen::VectorXi &occ_new = new_config.dof_values.occupation;
+  if (!m_prim_factor_group_index.has_value()) {
+    for (Index i = 0; i < total_sites; i++) {
+      occ_new(i) = occ_motif(m_motif_site_index[i]);
+    }
+  } else {
+    // occupation value transformation (accounts for aniostropic occupants)
+    auto const &occ_rep =
+        m_prim->sym_info.occ_symgroup_rep[*m_prim_factor_group_index];
+    for (Index i = 0; i < total_sites; i++) {
+      occ_new(i) =
+          occ_rep[m_motif_sublattice[i]][occ_motif(m_motif_site_index[i])];
+    }
   }
 
   // copy local DoF values
   for (auto const &pair : motif.dof_values.local_dof_values) {
-    std::string name = pair.first;
-    Eigen::MatrixXd const &M_motif = pair.second;
-    Eigen::MatrixXd &M_super = new_config.dof_values.local_dof_values.at(name);
-    for (Index i = 0; i < supercell_total_sites; i++) {
-      // unitcellcoord of site i in new_config
-      UnitCellCoord unitcellcoord =
-          new_config.supercell->unitcellcoord_index_converter(i);
-
-      // equivalent site in motif
-      Index motif_site_index = motif.supercell->unitcellcoord_index_converter(
-          unitcellcoord + origin);
-
-      // copy dof from superconfig to this:
-      M_super.col(i) = M_motif.col(motif_site_index);
+    new_config.dof_values.local_dof_values.at(pair.first) =
+        _copy_local(pair.first, pair.second);
+  }
+  return new_config;
+}
+
+/// \brief Copy local property values, as for local DoF values
+///
+/// If there is a prim factor group operation, property values are
+/// transformed using the local DoF representation with the same name.
+std::map<std::string, Eigen::MatrixXd>
+ConfigurationCopyMap::copy_local_properties(
+    std::map<std::string, Eigen::MatrixXd> const &local_properties) const {
+  std::map<std::string, Eigen::MatrixXd> new_local_properties;
+  for (auto const &pair : local_properties) {
+    new_local_properties.emplace(pair.first,
+                                 _copy_local(pair.first, pair.second));
+  }
+  return new_local_properties;
+}
+
+/// \brief Copy and transform global values, with the representation
+///     used for global DoF values
+///
+/// If there is a prim factor group operation, values are transformed using
+/// the global DoF representation with the same name.
+std::map<std::string, Eigen::VectorXd>
+ConfigurationCopyMap::copy_global_properties(
+    std::map<std::string, Eigen::VectorXd> const &global_properties) const {
+  if (!m_prim_factor_group_index.has_value()) {
+    return global_properties;
+  }
+  auto const &prim_sym_info = m_prim->sym_info;
+  std::map<std::string, Eigen::VectorXd> new_global_properties;
+  for (auto const &pair : global_properties) {
+    auto const &global_rep =
+        prim_sym_info.global_dof_symgroup_rep.at(pair.first);
+    new_global_properties.emplace(
+        pair.first, global_rep[*m_prim_factor_group_index] * pair.second);
+  }
+  return new_global_properties;
+}
+
+/// \brief Copy local values, transformed using the local DoF
+///     representation for `name` if there is a prim factor group operation
+Eigen::MatrixXd ConfigurationCopyMap::_copy_local(
+    std::string const &name, Eigen::MatrixXd const &M_motif) const {
+  Index total_sites = m_motif_site_index.size();
+  Eigen::MatrixXd M_new(M_motif.rows(), total_sites);
+  if (!m_prim_factor_group_index.has_value()) {
+    for (Index i = 0; i < total_sites; i++) {
+      M_new.col(i) = M_motif.col(m_motif_site_index[i]);
     }
+    return M_new;
+  }
+  auto const &local_rep =
+      m_prim->sym_info.local_dof_symgroup_rep.at(name);
+  auto const &op_rep = local_rep[*m_prim_factor_group_index];
+  for (Index i = 0; i < total_sites; i++) {
+    M_new.col(i).noalias() =
+        op_rep[m_motif_sublattice[i]] * M_motif.col(m_motif_site_index[i]);
   }
+  return M_new;
+}
 
-  return new_config;
+/// \brief Return a ConfigurationCopyMap, from a process-wide cache of
+///     recently used maps
+///
+/// Maps are cached by supercell address and are not reused for a different
+/// Supercell at the same address. Thread safe.
+std::shared_ptr<ConfigurationCopyMap const> make_configuration_copy_map(
+    std::shared_ptr<Supercell const> const &motif_supercell,
+    std::shared_ptr<Supercell const> const &supercell, UnitCell const &origin) {
+  return configuration_copy_map_cache().get(
+      make_copy_map_key(motif_supercell, supercell, -1, UnitCell(0, 0, 0),
+                        origin),
+      motif_supercell, supercell, [&]() {
+        return ConfigurationCopyMap(motif_supercell, supercell, origin);
+      });
+}
+
+/// \brief Return a ConfigurationCopyMap, for copying with a prim factor
+///     group operation and translation, from a process-wide cache of
+///     recently used maps
+///
+/// Maps are cached by supercell address and are not reused for a different
+/// Supercell at the same address. Thread safe.
+std::shared_ptr<ConfigurationCopyMap const> make_configuration_copy_map(
+    Index prim_factor_group_index, UnitCell translation,
+    std::shared_ptr<Supercell const> const &motif_supercell,
+    std::shared_ptr<Supercell const> const &supercell, UnitCell const &origin) {
+  return configuration_copy_map_cache().get(
+      make_copy_map_key(motif_supercell, supercell, prim_factor_group_index,
+                        translation, origin),
+      motif_supercell, supercell, [&]() {
+        return ConfigurationCopyMap(prim_factor_group_index, translation,
+                                    motif_supercell, supercell, origin);
+      });
+}
+
+/// \brief Copy configuration DoF values into a supercell
+///
+/// \param motif The initial configuration
+/// \param supercell The Supercell of the new configuration
+/// \param origin The UnitCell indicating which unit cell in the
+///        initial configuration is the origin in new configuration
+///
+/// Notes:
+/// - This method assumes the motif forms an infinite crystal and copies site
+///   DoF values that lie inside `supercell` directory into a new configuration.
+/// - Uses a cached ConfigurationCopyMap, see `make_configuration_copy_map`.
+///
+Configuration copy_configuration(
+    Configuration const &motif,
+    std::shared_ptr<Supercell const> const &supercell, UnitCell const &origin) {
+  return make_configuration_copy_map(motif.supercell, supercell, origin)
+      ->copy(motif);
 }
 
 /// \brief Copy transformed configuration DoF values into a supercell
@@ -104,97 +572,15 @@ Configuration copy_configuration(
 /// map according to:
 ///     new_config_unitcellcoord + origin = fg * motif_unitcellcoord + trans
 ///
+/// Uses a cached ConfigurationCopyMap, see `make_configuration_copy_map`.
+///
 Configuration copy_configuration(
     Index prim_factor_group_index, UnitCell translation,
     Configuration const &motif,
     std::shared_ptr<Supercell const> const &supercell, UnitCell const &origin) {
-  if (supercell->prim != motif.supercell->prim) {
-    throw std::runtime_error(
-        "Error in CASM::config::copy_configuration (and transform): prim "
-        "mismatch.");
-  }
-
-  auto const &prim = supercell->prim;
-  PrimSymInfo const &prim_sym_info = prim->sym_info;
-  auto const &unitcellcoord_rep = prim_sym_info.unitcellcoord_symgroup_rep;
-  Index inverse_prim_factor_group_index =
-      prim->sym_info.factor_group->inverse_index[prim_factor_group_index];
-
-  Index supercell_total_sites =
-      supercell->unitcellcoord_index_converter.total_sites();
-
-  // construct new_config
-  Configuration new_config{supercell};
-
-  // copy transformed global DoF values
-  for (auto const &pair : motif.dof_values.global_dof_values) {
-    std::string name = pair.first;
-    Eigen::VectorXd const &V_motif = pair.second;
-    Eigen::VectorXd &V_new = new_config.dof_values.global_dof_values.at(name);
-    auto const &global_rep = prim_sym_info.global_dof_symgroup_rep.at(name);
-
-    Eigen::MatrixXd const &matrix_rep = global_rep[prim_factor_group_index];
-    V_new = matrix_rep * V_motif;
-  }
-
-  // unitcellcoord + origin = fg * motif_unitcellcoord + trans
-  // motif_unitcellcoord = fg_inverse * (unitcellcoord  + origin - trans)
-
-  // copy transformed occupation values
-  for (Index i = 0; i < supercell_total_sites; i++) {
-    // unitcellcoord of site i in new_config
-    UnitCellCoord unitcellcoord =
-        new_config.supercell->unitcellcoord_index_converter(i);
-
-    // motif_unitcellcoord, the site which transforms to site i in new_config
-    UnitCellCoord motif_unitcellcoord =
-        copy_apply(unitcellcoord_rep[inverse_prim_factor_group_index],
-                   (unitcellcoord + origin - translation));
-
-    // equivalent site in configuration
-    Index motif_site_index =
-        motif.supercell->unitcellcoord_index_converter(motif_unitcellcoord);
-
-    // occupation value transformation (accounts for aniostropic occupants)
-    Index b = motif_unitcellcoord.sublattice();
-    sym_info::Permutation const &perm_rep =
-        prim_sym_info.occ_symgroup_rep[prim_factor_group_index][b];
-
-    // copy transformed occupation value
-    new_config.dof_values.occupation(i) =
-        perm_rep[motif.dof_values.occupation(motif_site_index)];
-  }
-
-  // copy local DoF values
-  for (auto const &pair : motif.dof_values.local_dof_values) {
-    std::string name = pair.first;
-    Eigen::MatrixXd const &M_motif = pair.second;
-    Eigen::MatrixXd &M_new = new_config.dof_values.local_dof_values.at(name);
-    auto const &local_rep = prim_sym_info.local_dof_symgroup_rep.at(name);
-    for (Index i = 0; i < supercell_total_sites; i++) {
-      // unitcellcoord of site i in new_config
-      UnitCellCoord unitcellcoord =
-          new_config.supercell->unitcellcoord_index_converter(i);
-
-      // motif_unitcellcoord, the site which transforms to site i in new_config
-      UnitCellCoord motif_unitcellcoord =
-          copy_apply(unitcellcoord_rep[inverse_prim_factor_group_index],
-                     (unitcellcoord + origin - translation));
-
-      // equivalent site in configuration
-      Index motif_site_index =
-          motif.supercell->unitcellcoord_index_converter(motif_unitcellcoord);
-
-      // local DoF value transformation
-      Index b = motif_unitcellcoord.sublattice();
-      Eigen::MatrixXd const &matrix_rep = local_rep[prim_factor_group_index][b];
-
-      // copy dof from superconfig to this:
-      M_new.col(i) = matrix_rep * M_motif.col(motif_site_index);
-    }
-  }
-
-  return new_config;
+  return make_configuration_copy_map(prim_factor_group_index, translation,
+                                     motif.supercell, supercell, origin)
+      ->copy(motif);
 }
 
 /// \brief Copy configuration DoF values and properties into a supercell
@@ -212,48 +598,12 @@ ConfigurationWithProperties copy_configuration_with_properties(
     ConfigurationWithProperties const &motif_with_properties,
     std::shared_ptr<Supercell const> const &supercell, UnitCell const &origin) {
   Configuration const &motif = motif_with_properties.configuration;
-  auto const &local_properties = motif_with_properties.local_properties;
-  auto const &global_properties = motif_with_properties.global_properties;
-
-  if (supercell->prim != motif.supercell->prim) {
-    throw std::runtime_error(
-        "Error in CASM::config::copy_configuration: prim mismatch.");
-  }
-
-  Index supercell_total_sites =
-      supercell->unitcellcoord_index_converter.total_sites();
-
-  // copy configuration
-  Configuration new_config = copy_configuration(motif, supercell, origin);
-
-  // copy global properties
-  std::map<std::string, Eigen::VectorXd> new_global_properties =
-      global_properties;
-
-  // copy local property values
-  std::map<std::string, Eigen::MatrixXd> new_local_properties;
-  for (auto const &pair : local_properties) {
-    std::string name = pair.first;
-    Eigen::MatrixXd const &M_motif = pair.second;
-    Eigen::MatrixXd M_new(M_motif.rows(), supercell_total_sites);
-    M_new.setZero();
-    for (Index i = 0; i < supercell_total_sites; i++) {
-      // unitcellcoord of site i in new_config
-      UnitCellCoord unitcellcoord =
-          new_config.supercell->unitcellcoord_index_converter(i);
-
-      // equivalent site in motif
-      Index motif_site_index = motif.supercell->unitcellcoord_index_converter(
-          unitcellcoord + origin);
-
-      // copy dof from superconfig to this:
-      M_new.col(i) = M_motif.col(motif_site_index);
-    }
-    new_local_properties.emplace(name, M_new);
-  }
-
-  return ConfigurationWithProperties(new_config, new_local_properties,
-                                     new_global_properties);
+  auto copy_map =
+      make_configuration_copy_map(motif.supercell, supercell, origin);
+  return ConfigurationWithProperties(
+      copy_map->copy(motif),
+      copy_map->copy_local_properties(motif_with_properties.local_properties),
+      motif_with_properties.global_properties);
 }
 
 /// \brief Copy transformed configuration DoF values and properties into a
@@ -275,79 +625,21 @@ ConfigurationWithProperties copy_configuration_with_properties(
 ///
 ///     new_config_unitcellcoord + origin = fg * motif_unitcellcoord + trans
 ///
+/// Global and local properties are transformed using the global and local
+/// DoF representations with the same name.
+///
 ConfigurationWithProperties copy_configuration_with_properties(
     Index prim_factor_group_index, UnitCell translation,
     ConfigurationWithProperties const &motif_with_properties,
     std::shared_ptr<Supercell const> const &supercell, UnitCell const &origin) {
   Configuration const &motif = motif_with_properties.configuration;
-  auto const &local_properties = motif_with_properties.local_properties;
-  auto const &global_properties = motif_with_properties.global_properties;
-
-  if (supercell->prim != motif.supercell->prim) {
-    throw std::runtime_error(
-        "Error in CASM::config::copy_configuration: prim mismatch.");
-  }
-
-  auto const &prim = supercell->prim;
-  PrimSymInfo const &prim_sym_info = prim->sym_info;
-  auto const &unitcellcoord_rep = prim_sym_info.unitcellcoord_symgroup_rep;
-  Index inverse_prim_factor_group_index =
-      prim->sym_info.factor_group->inverse_index[prim_factor_group_index];
-
-  Index supercell_total_sites =
-      supercell->unitcellcoord_index_converter.total_sites();
-
-  // copy & transform configuration
-  Configuration new_config = copy_configuration(
-      prim_factor_group_index, translation, motif, supercell, origin);
-
-  // copy global properties
-  std::map<std::string, Eigen::VectorXd> new_global_properties =
-      global_properties;
-
-  // copy transformed global properties
-  for (auto const &pair : global_properties) {
-    std::string name = pair.first;
-    Eigen::VectorXd const &V_motif = pair.second;
-    auto const &global_rep = prim_sym_info.global_dof_symgroup_rep.at(name);
-    Eigen::MatrixXd const &matrix_rep = global_rep[prim_factor_group_index];
-    new_global_properties.emplace(name, matrix_rep * V_motif);
-  }
-
-  // copy transformed local property values
-  std::map<std::string, Eigen::MatrixXd> new_local_properties;
-  for (auto const &pair : local_properties) {
-    std::string name = pair.first;
-    Eigen::MatrixXd const &M_motif = pair.second;
-    Eigen::MatrixXd M_new(M_motif.rows(), supercell_total_sites);
-    M_new.setZero();
-    auto const &local_rep = prim_sym_info.local_dof_symgroup_rep.at(name);
-    for (Index i = 0; i < supercell_total_sites; i++) {
-      // unitcellcoord of site i in new_config
-      UnitCellCoord unitcellcoord =
-          new_config.supercell->unitcellcoord_index_converter(i);
-
-      // motif_unitcellcoord, the site which transforms to site i in new_config
-      UnitCellCoord motif_unitcellcoord =
-          copy_apply(unitcellcoord_rep[inverse_prim_factor_group_index],
-                     (unitcellcoord + origin - translation));
-
-      // equivalent site in configuration
-      Index motif_site_index =
-          motif.supercell->unitcellcoord_index_converter(motif_unitcellcoord);
-
-      // local DoF value transformation
-      Index b = motif_unitcellcoord.sublattice();
-      Eigen::MatrixXd const &matrix_rep = local_rep[prim_factor_group_index][b];
-
-      // copy dof from superconfig to this:
-      M_new.col(i) = matrix_rep * M_motif.col(motif_site_index);
-    }
-    new_local_properties.emplace(name, M_new);
-  }
-
-  return ConfigurationWithProperties(new_config, new_local_properties,
-                                     new_global_properties);
+  auto copy_map = make_configuration_copy_map(
+      prim_factor_group_index, translation, motif.supercell, supercell, origin);
+  return ConfigurationWithProperties(
+      copy_map->copy(motif),
+      copy_map->copy_local_properties(motif_with_properties.local_properties),
+      copy_map->copy_global_properties(
+          motif_with_properties.global_properties));
 }
 
 /// \brief Return prim factor group indices that create tilings of motif
@@ -375,9 +667,9 @@ std::set<Index> unique_generating_prim_factor_group_indices(
   xtal::Lattice supercell_lattice = supercell->superlattice.superlattice();
   Prim const &prim = *motif.supercell->prim;
   SymGroup const &prim_fg = *prim.sym_info.factor_group;
-  SymGroup const &supercell_fg = *supercell->sym_info.factor_group;
+  SymGroup const &supercell_fg = *supercell->sym_info().factor_group;
   SymGroup const &prim_motif_supercell_fg =
-      *prim_motif.supercell->sym_info.factor_group;
+      *prim_motif.supercell->sym_info().factor_group;
   double xtal_tol = prim.basicstructure->lattice().tol();
 
   // - Want to find the unique ways to fill supercell with prim_motif.
@@ -426,14 +718,16 @@ std::set<Index> unique_generating_prim_factor_group_indices(
 ///
 /// \param motif The motif configuration
 /// \param supercell The supercell to fill
+/// \param n_threads Number of threads used to make subsets (see
+///     `for_each_super_configuration_subset`)
 ///
 /// \returns All configurations equivalent with respect to the prim factor
 ///     group which fit in the given supercell.
 std::vector<Configuration> make_all_super_configurations(
     Configuration const &motif,
-    std::shared_ptr<Supercell const> const &supercell) {
+    std::shared_ptr<Supercell const> const &supercell, Index n_threads) {
   std::vector<std::vector<Configuration>> by_subsets =
-      make_all_super_configurations_by_subsets(motif, supercell);
+      make_all_super_configurations_by_subsets(motif, supercell, n_threads);
   std::vector<Configuration> all;
   for (auto const &subset : by_subsets) {
     all.insert(std::end(all), std::begin(subset), std::end(subset));
@@ -447,25 +741,83 @@ std::vector<Configuration> make_all_super_configurations(
 ///
 /// \param motif The motif configuration
 /// \param supercell The supercell to fill
+/// \param n_threads Number of threads used to make subsets (see
+///     `for_each_super_configuration_subset`)
 ///
 /// \returns subsets, The configurations in subsets[i] are all equivalent
 ///     configurations which may generated from each other using SupercellSymOp.
 ///     Combining all subsets gives all configurations equivalent with respect
 ///     to the prim factor group which fit in the given supercell.
+///
+/// Subsets are in order of increasing generating prim factor group index, so
+/// the result does not depend on `n_threads`.
 std::vector<std::vector<Configuration>>
 make_all_super_configurations_by_subsets(
     Configuration const &motif,
-    std::shared_ptr<Supercell const> const &supercell) {
+    std::shared_ptr<Supercell const> const &supercell, Index n_threads) {
   std::vector<std::vector<Configuration>> by_subsets;
-  SupercellSymOp begin = SupercellSymOp::begin(supercell);
-  SupercellSymOp end = SupercellSymOp::end(supercell);
+  for_each_super_configuration_subset(
+      motif, supercell,
+      [&](Index subset_index, std::vector<Configuration> &subset) {
+        by_subsets.push_back(std::move(subset));
+      },
+      n_threads);
+  return by_subsets;
+}
 
-  std::vector<Configuration> distinct =
-      make_distinct_super_configurations(motif, supercell);
-  for (auto const &config : distinct) {
-    by_subsets.push_back(make_equivalents(config, begin, end));
+/// \brief Call `f(subset_index, subset)` for each subset of
+///     `make_all_super_configurations_by_subsets`, in order, making subsets
+///     in parallel
+///
+/// \param motif The motif configuration
+/// \param supercell The supercell to fill
+/// \param f Function called with each subset, in order, on the calling
+///     thread. It may move from `subset`.
+/// \param n_threads Number of threads used to make subsets. If <= 0, uses
+///     `resolve_n_threads(n_threads)`.
+///
+/// \returns The number of subsets
+///
+/// Subset `i` is generated by filling `supercell` with the `i`-th unique
+/// generating prim factor group operation (in increasing order) applied to
+/// `motif`, and then applying all SupercellSymOp. Subsets are made in
+/// parallel rounds of up to `resolve_n_threads(n_threads)` subsets, one per
+/// thread, and passed to `f` after each round. This gives the same subsets,
+/// in the same order, for any `n_threads`, while holding at most one round of
+/// subsets in memory, so the Configurations may be canonicalized or reduced
+/// by `f` as they are generated.
+Index for_each_super_configuration_subset(
+    Configuration const &motif,
+    std::shared_ptr<Supercell const> const &supercell,
+    std::function<void(Index, std::vector<Configuration> &)> f,
+    Index n_threads) {
+  Configuration prim_motif = make_primitive(motif);
+  std::set<Index> op_set =
+      unique_generating_prim_factor_group_indices(prim_motif, motif, supercell);
+  std::vector<Index> ops(op_set.begin(), op_set.end());
+  Index n_subsets = ops.size();
+  Index round_size = resolve_n_threads(n_threads);
+
+  std::vector<std::vector<Configuration>> round;
+  for (Index first = 0; first < n_subsets; first += round_size) {
+    round.clear();
+    round.resize(std::min(round_size, n_subsets - first));
+    parallel_for_chunks(
+        round.size(), n_threads, [&](Index c, Index begin, Index end) {
+          SupercellSymOp op_begin = SupercellSymOp::begin(supercell);
+          SupercellSymOp op_end = SupercellSymOp::end(supercell);
+          for (Index i = begin; i < end; ++i) {
+            Configuration filled =
+                copy_configuration(ops[first + i], UnitCell(0, 0, 0),
+                                   prim_motif, supercell, UnitCell(0, 0, 0));
+            round[i] = make_equivalents(filled, op_begin, op_end);
+          }
+        });
+    for (Index i = 0; i < Index(round.size()); ++i) {
+      f(first + i, round[i]);
+    }
   }
-  return by_subsets;
+  return n_subsets;
 }
 
 /// \brief Make configurations that fill a supercell and are equivalent with
@@ -499,6 +851,49 @@ std::vector<Configuration> make_distinct_super_configurations(
   return distinct;
 }
 
+/// \brief Make the distinct configurations, in canonical form, that fill a
+/// supercell and are equivalent with respect to the prim factor group
+///
+/// \param motif The motif configuration
+/// \param supercell The supercell to fill
+///
+/// \returns canonical, The distinct configurations, in canonical form with
+///     respect to the supercell factor group, generated by filling
+///     `supercell` with `motif`, sorted in ascending order.
+///
+/// Notes:
+/// - Only the orientations from
+///   `unique_generating_prim_factor_group_indices` are generated. Each
+///   filling is put in canonical form as it is generated and only distinct
+///   canonical configurations are kept, so the equivalents of each filling
+///   are never all held in memory as they are by
+///   `make_all_super_configurations`, and unlike
+///   `make_distinct_super_configurations` the results are guaranteed to be
+///   distinct.
+std::vector<Configuration> make_canonical_super_configurations(
+    Configuration const &motif,
+    std::shared_ptr<Supercell const> const &supercell) {
+  Configuration prim_motif = make_primitive(motif);
+
+  std::set<Index> unique_generating_prim_fg_op =
+      unique_generating_prim_factor_group_indices(prim_motif, motif, supercell);
+
+  std::set<Configuration> canonical;
+  UnitCell trans(0, 0, 0);
+  UnitCell origin(0, 0, 0);
+  SupercellSymOp begin = SupercellSymOp::begin(supercell);
+  SupercellSymOp end = SupercellSymOp::end(supercell);
+
+  // Loop over unique generating ops
+  for (Index prim_fg_op : unique_generating_prim_fg_op) {
+    // Apply op to fill supercell, then keep only the canonical form
+    canonical.insert(make_canonical_form(
+        copy_configuration(prim_fg_op, trans, prim_motif, supercell, origin),
+        begin, end));
+  }
+  return std::vector<Configuration>(canonical.begin(), canonical.end());
+}
+
 /// \brief Make all equivalent configurations with respect to the prim factor
 /// group that fill a supercell
 ///
@@ -621,8 +1016,10 @@ std::set<Configuration> make_all_super_configurations_check(
     Configuration tmp =
         copy_configuration(prim_fg_op, trans, prim_motif, supercell, origin);
     if (!all.count(tmp)) {
+      Configuration equivalent = tmp;
       for (auto it = begin; it != end; ++it) {
-        all.emplace(copy_apply(*it, tmp));
+        copy_apply(*it, tmp.dof_values, equivalent.dof_values);
+        all.insert(equivalent);
       }
     }
   }
@@ -631,44 +1028,81 @@ std::set<Configuration> make_all_super_configurations_check(
 
 /// \brief Return true if no translations within the supercell result in the
 ///     same configuration
+///
+/// Only translations with prime order are checked, because the supercell
+/// translations form a finite abelian group, so any non-trivial subgroup of
+/// invariant translations contains a translation with prime order.
 bool is_primitive(Configuration const &configuration) {
-  auto end = SupercellSymOp::translation_end(configuration.supercell);
-  return find_translation(configuration) == end;
+  return !InvariantTranslationFinder(configuration).extend();
+}
+
+/// \brief Return true if no translations within the supercell result in the
+///     same occupation
+///
+/// Same as `is_primitive(configuration.to_configuration())`, checking the
+/// packed occupation directly.
+bool is_primitive(OccConfiguration const &configuration) {
+  return !InvariantTranslationFinder(configuration).extend();
+}
+
+/// \brief Return the unit cell indices of the translations within the
+///     supercell that leave a configuration invariant
+///
+/// Uses the same search as `is_primitive`, extending the subgroup of
+/// invariant translations until it is complete.
+///
+/// \returns Translation (unit cell) indices, sorted, always including 0
+std::vector<Index> make_invariant_translations(
+    Configuration const &configuration) {
+  InvariantTranslationFinder finder(configuration);
+  while (finder.extend()) {
+  }
+  return finder.invariant_translations();
 }
 
 /// \brief Return the primitive configuration
 ///
+/// The subgroup of translations that leave the configuration invariant is
+/// found, and the primitive lattice, generated by the superlattice vectors
+/// and those translations, is constructed directly, so only one new
+/// Supercell is constructed.
+///
 /// Notes:
 /// - Does not apply any symmetry operations
 /// - Use `make_in_canonical_supercell` aftwards to obtain the primitive
 ///   canonical configuration in the canonical supercell.
 Configuration make_primitive(Configuration const &configuration) {
-  Configuration tconfig{configuration};
-  auto prim = tconfig.supercell->prim;
-  double xtal_tol = prim->basicstructure->lattice().tol();
-
-  // check if config is primitive, and if not, obtain a translation that maps
-  // the config on itself
-  while (true) {
-    SupercellSymOp result = find_translation(tconfig);
+  InvariantTranslationFinder finder(configuration);
+  while (finder.extend()) {
+  }
+  if (finder.subgroup_size() == 1) {
+    return configuration;
+  }
 
-    if (result == SupercellSymOp::translation_end(tconfig.supercell)) {
-      break;
+  // generators of the primitive lattice, in prim lattice coordinates
+  auto const &superlattice = configuration.supercell->superlattice;
+  Eigen::Matrix3l const &T = superlattice.transformation_matrix_to_super();
+  std::vector<Eigen::Vector3l> generators;
+  for (Index c = 0; c < 3; ++c) {
+    generators.push_back(T.col(c));
+  }
+  auto const &converter = configuration.supercell->unitcell_index_converter;
+  for (Index t : finder.invariant_translations()) {
+    if (t != 0) {
+      generators.push_back(converter(t));
     }
-
-    // replace one of the lattice vectors with the translation
-    Lattice new_lat =
-        xtal::replace_vector(tconfig.supercell->superlattice.superlattice(),
-                             result.to_symop().translation, xtal_tol)
-            .make_right_handed()
-            .reduced_cell();
-
-    // create a sub configuration in the new supercell
-    tconfig =
-        copy_configuration(tconfig, std::make_shared<Supercell>(prim, new_lat));
   }
-
-  return tconfig;
+  Eigen::Matrix3l T_prim = make_integer_lattice_basis(generators);
+
+  auto prim = configuration.supercell->prim;
+  Lattice const &prim_lattice = superlattice.prim_lattice();
+  Lattice new_lat =
+      Lattice(prim_lattice.lat_column_mat() * T_prim.cast<double>(),
+              prim_lattice.tol())
+          .make_right_handed()
+          .reduced_cell();
+  return copy_configuration(configuration,
+                            std::make_shared<Supercell>(prim, new_lat));
 }
 
 /// \brief Transform a configuration with properties so it has the primitive
@@ -680,6 +1114,95 @@ ConfigurationWithProperties make_primitive(
       make_primitive(configuration_with_properties.configuration).supercell);
 }
 
+/// \brief Return the canonical form of a configuration, found by filling
+///     its supercell with its primitive configuration
+///
+/// \param configuration The configuration
+/// \param primitive The primitive configuration of `configuration`, as
+///     from `make_primitive(configuration)`, so that `configuration` is
+///     equal to `copy_configuration(primitive, configuration.supercell)`
+///
+/// \returns The canonical form of `configuration` with respect to all
+///     supercell operations, equal to the result of `make_canonical_form`.
+///
+/// Method:
+/// - The equivalents of `configuration`, `op * configuration` for all
+///   supercell operations, are the same as the fillings of the supercell
+///   with `primitive`, translated by each of its unit cells, and then
+///   transformed by each supercell factor group operation. This is because
+///   `primitive` is periodic, so translations only need to be considered
+///   within its unit cells.
+/// - So `n_fg * n_primitive_unitcells` fillings are compared, instead of
+///   `n_fg * n_supercell_unitcells` equivalents, which is much fewer for
+///   non-primitive configurations in large supercells. Fillings are made
+///   with cached ConfigurationCopyMap.
+/// - If `configuration` is primitive, this is `make_canonical_form`.
+Configuration make_canonical_form_via_primitive(
+    Configuration const &configuration, Configuration const &primitive) {
+  std::shared_ptr<Supercell const> const &supercell = configuration.supercell;
+  std::shared_ptr<Supercell const> const &primitive_supercell =
+      primitive.supercell;
+  if (primitive_supercell->prim != supercell->prim) {
+    throw std::runtime_error(
+        "Error in make_canonical_form_via_primitive: prim mismatch");
+  }
+  Index n_unitcells = supercell->unitcell_index_converter.total_sites();
+  Index n_primitive_unitcells =
+      primitive_supercell->unitcell_index_converter.total_sites();
+  if (n_primitive_unitcells == n_unitcells) {
+    return make_canonical_form(configuration,
+                               SupercellSymOp::begin(supercell),
+                               SupercellSymOp::end(supercell));
+  }
+  if (n_unitcells % n_primitive_unitcells != 0) {
+    throw std::runtime_error(
+        "Error in make_canonical_form_via_primitive: primitive does not tile "
+        "the supercell");
+  }
+
+  // primitive, translated by each of its unit cells
+  std::vector<Configuration> translated;
+  translated.reserve(n_primitive_unitcells);
+  auto const &converter = primitive_supercell->unitcell_index_converter;
+  for (Index t = 0; t < n_primitive_unitcells; ++t) {
+    translated.push_back(
+        copy_configuration(primitive, primitive_supercell, converter(t)));
+  }
+
+  auto const &head_group_index =
+      supercell->sym_info().factor_group->head_group_index;
+  std::optional<Configuration> best;
+  std::optional<ConfigIsEquivalent> equal_to_best;
+  for (Index prim_fg_index : head_group_index) {
+    std::shared_ptr<ConfigurationCopyMap const> copy_map =
+        make_configuration_copy_map(prim_fg_index, UnitCell(0, 0, 0),
+                                    primitive_supercell, supercell);
+    for (Configuration const &motif : translated) {
+      Configuration candidate = copy_map->copy(motif);
+      if (!best.has_value()) {
+        best.emplace(std::move(candidate));
+        equal_to_best.emplace(*best);
+      } else if (!(*equal_to_best)(candidate) && equal_to_best->is_less()) {
+        *best = std::move(candidate);
+        equal_to_best->rebind(*best);
+      }
+    }
+  }
+  return *best;
+}
+
+/// \brief Return the canonical form of a configuration, found by filling
+///     its supercell with its primitive configuration
+///
+/// Equivalent to
+/// `make_canonical_form_via_primitive(configuration, make_primitive(
+/// configuration))`. See that overload for details.
+Configuration make_canonical_form_via_primitive(
+    Configuration const &configuration) {
+  return make_canonical_form_via_primitive(configuration,
+                                           make_primitive(configuration));
+}
+
 /// \brief Return a prim factor group index that transforms a supercell to an
 ///     a particular equivalent supercell
 ///
@@ -770,5 +1293,99 @@ ConfigurationWithProperties make_in_canonical_supercell(
       config_in_canonical_supercell);
 }
 
+/// \brief Return the canonical configuration in the canonical supercell,
+///     using and updating a SupercellSet
+///
+/// \param configuration The initial configuration
+/// \param supercells A SupercellSet with the same prim. The canonical
+///     supercell is inserted if not already present, and the result uses the
+///     shared supercell in `supercells`.
+///
+/// Equivalent to `make_in_canonical_supercell(configuration)`, but the
+/// canonical supercell and the prim factor group operation that transforms
+/// to it are found once per distinct supercell by
+/// `SupercellSet::canonical_supercell`, so converting many configurations
+/// in the same supercells only requires DoF copies and finding the
+/// canonical configuration.
+Configuration make_in_canonical_supercell(Configuration const &configuration,
+                                          SupercellSet &supercells) {
+  std::pair<std::shared_ptr<Supercell const>, Index> canonical =
+      supercells.canonical_supercell(configuration.supercell);
+  std::shared_ptr<Supercell const> const &canonical_supercell =
+      canonical.first;
+  Index prim_factor_group_index = canonical.second;
+
+  Configuration config_in_canonical_supercell =
+      (canonical_supercell == configuration.supercell)
+          ? configuration
+          : copy_configuration(prim_factor_group_index, {0, 0, 0},
+                               configuration, canonical_supercell);
+
+  return make_canonical_form(config_in_canonical_supercell,
+                             SupercellSymOp::begin(canonical_supercell),
+                             SupercellSymOp::end(canonical_supercell));
+}
+
+/// \brief Transform a configuration with properties so that it has the
+///     canonical configuration in the canonical supercell, using and updating
+///     a SupercellSet
+///
+/// \param configuration_with_properties The initial configuration and
+///     properties
+/// \param supercells A SupercellSet with the same prim. The canonical
+///     supercell is inserted if not already present, and the result uses the
+///     shared supercell in `supercells`.
+///
+/// Equivalent to `make_in_canonical_supercell(configuration_with_properties)`,
+/// but the canonical supercell and the prim factor group operation that
+/// transforms to it are found once per distinct supercell by
+/// `SupercellSet::canonical_supercell`.
+ConfigurationWithProperties make_in_canonical_supercell(
+    ConfigurationWithProperties const &configuration_with_properties,
+    SupercellSet &supercells) {
+  Configuration const &configuration =
+      configuration_with_properties.configuration;
+  std::pair<std::shared_ptr<Supercell const>, Index> canonical =
+      supercells.canonical_supercell(configuration.supercell);
+  std::shared_ptr<Supercell const> const &canonical_supercell =
+      canonical.first;
+  Index prim_factor_group_index = canonical.second;
+
+  ConfigurationWithProperties config_in_canonical_supercell =
+      (canonical_supercell == configuration.supercell)
+          ? configuration_with_properties
+          : copy_configuration_with_properties(
+                prim_factor_group_index, {0, 0, 0},
+                configuration_with_properties, canonical_supercell);
+
+  return copy_apply(
+      to_canonical(config_in_canonical_supercell.configuration,
+                   SupercellSymOp::begin(canonical_supercell),
+                   SupercellSymOp::end(canonical_supercell)),
+      config_in_canonical_supercell);
+}
+
+/// \brief Return the canonical configurations in the canonical supercells,
+///     using and updating a SupercellSet
+///
+/// \param configurations The initial configurations, which may be in
+///     different supercells
+/// \param supercells A SupercellSet with the same prim. Canonical supercells
+///     are inserted if not already present, and the results use the shared
+///     supercells in `supercells`.
+///
+/// \returns The canonical configurations in the canonical supercells, in the
+///     same order as `configurations`
+std::vector<Configuration> make_in_canonical_supercell(
+    std::vector<Configuration> const &configurations,
+    SupercellSet &supercells) {
+  std::vector<Configuration> result;
+  result.reserve(configurations.size());
+  for (Configuration const &configuration : configurations) {
+    result.push_back(make_in_canonical_supercell(configuration, supercells));
+  }
+  return result;
+}
+
 }  // namespace config
 }  // namespace CASM
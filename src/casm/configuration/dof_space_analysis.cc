@@ -1,11 +1,17 @@
 #include "casm/configuration/dof_space_analysis.hh"
 
+#include <cmath>
+
 #include "casm/casm_io/Log.hh"
 #include "casm/configuration/DoFSpace_functions.hh"
+#include "casm/configuration/MatrixRepCache.hh"
 #include "casm/configuration/Supercell.hh"
 #include "casm/configuration/SupercellSymOp.hh"
 #include "casm/configuration/canonical_form.hh"
 #include "casm/configuration/group/subgroups.hh"
+#include "casm/configuration/irreps/CharacterTable.hh"
+#include "casm/crystallography/AnisoValTraits.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
 
 namespace CASM {
 namespace config {
@@ -16,86 +22,53 @@ DoFSpaceAnalysisResults::DoFSpaceAnalysisResults(
     : symmetry_adapted_dof_space(std::move(_symmetry_adapted_dof_space)),
       symmetry_report(std::move(_symmetry_report)){};
 
-/// \param dof_space_in The DoFSpace for which a symmetry adapted basis is
-/// constructed. \param prim The prim \param configuration If null, use the full
-/// symmetry of the DoFSpace. If has_value,
-///     use the symmetry of the configuration.
-/// \param exclude_homogeneous_modes Exclude homogeneous modes if this
-///     is true, or include if this is false. If this is null (default),
-///     exclude homogeneous modes for dof==\"disp\" only.
-/// \param include_default_occ_modes Include the dof component for the
-///     default occupation value on each site with occupation DoF. The
-///     default is to exclude these modes because they are not
-///     independent. This parameter is only checked dof==\"occ\". If
-///     false, the default occupation is determined using
-///     `site_index_to_default_occ` if that is provided, else using
-///     `sublattice_index_to_default_occ` if that is provided, else using
-///     occupation index 0.
-/// \param sublattice_index_to_default_occ Optional values of default
-///     occupation index (value), specified by sublattice index (key).
-/// \param site_index_to_default_occ Optional values of default
-///     occupation index (value), specified by supercell site index (key).
-/// \param calc_wedges If true, calculate the irreducible wedges for the vector
-///     space. This may take a long time.
-/// \param log Optional logger. If has value and `log->verbosity() >=
-/// Log::verbose`,
-///     prints step-by-step results to log.
-DoFSpaceAnalysisResults dof_space_analysis(
-    clexulator::DoFSpace const &dof_space_in, std::shared_ptr<Prim const> prim,
-    std::optional<Configuration> configuration,
-    std::optional<bool> exclude_homogeneous_modes,
-    bool include_default_occ_modes,
-    std::optional<std::map<int, int>> sublattice_index_to_default_occ,
-    std::optional<std::map<Index, int>> site_index_to_default_occ,
-    bool calc_wedges, std::optional<Log> log) {
-  if (dof_space_in.basis.cols() == 0) {
-    std::stringstream msg;
-    msg << "Error in dof_space_analysis: "
-        << "Initial DoF space: basis.cols() == 0";
-    throw dof_space_analysis_error(msg.str());
-  }
+namespace {  // (anonymous)
 
-  std::shared_ptr<Supercell const> supercell;
+/// \brief Return the supercell of the analysis: the configuration
+///     supercell, if provided, else the DoFSpace supercell, else the prim
+std::shared_ptr<Supercell const> make_analysis_supercell(
+    std::shared_ptr<Prim const> const &prim,
+    std::optional<Configuration> const &configuration,
+    std::optional<Eigen::Matrix3l> const &transformation_matrix_to_super) {
   if (configuration.has_value()) {
-    supercell = configuration->supercell;
-  } else if (dof_space_in.transformation_matrix_to_super.has_value()) {
-    supercell = std::make_shared<Supercell const>(
-        prim, *dof_space_in.transformation_matrix_to_super);
+    return configuration->supercell;
+  } else if (transformation_matrix_to_super.has_value()) {
+    return std::make_shared<Supercell const>(prim,
+                                             *transformation_matrix_to_super);
   } else {
-    supercell =
-        std::make_shared<Supercell const>(prim, Eigen::Matrix3l::Identity());
-  }
-
-  // --- Construct the standard DoF space ---
-  clexulator::DoFSpace dof_space_pre1 =
-      exclude_homogeneous_mode_space(dof_space_in, exclude_homogeneous_modes);
-  if (dof_space_pre1.basis.cols() == 0) {
-    std::stringstream msg;
-    msg << "Error in dof_space_analysis: "
-        << "After excluding homogeneous mode space: basis.cols() == 0";
-    throw dof_space_analysis_error(msg.str());
+    return std::make_shared<Supercell const>(prim,
+                                             Eigen::Matrix3l::Identity());
   }
+}
 
-  clexulator::DoFSpace dof_space = exclude_default_occ_modes(
-      dof_space_pre1, include_default_occ_modes,
-      sublattice_index_to_default_occ, site_index_to_default_occ);
-  if (dof_space.basis.cols() == 0) {
+/// \brief Throw if a basis has no columns
+void check_basis_cols(Index basis_cols, std::string const &step) {
+  if (basis_cols == 0) {
     std::stringstream msg;
-    msg << "Error in dof_space_analysis: "
-        << "After excluding default occ modes: basis.cols() == 0";
+    msg << "Error in dof_space_analysis: " << step << ": basis.cols() == 0";
     throw dof_space_analysis_error(msg.str());
   }
+}
 
+/// \brief Symmetry analysis of the standard DoF space, after excluding
+///     homogeneous and default occupation modes
+DoFSpaceAnalysisResults dof_space_analysis_impl(
+    clexulator::DoFSpace const &dof_space,
+    std::shared_ptr<Supercell const> const &supercell,
+    std::optional<Configuration> const &configuration, bool calc_wedges,
+    std::optional<Log> log, bool use_character_projection,
+    bool use_kstar_blocks, Index n_threads) {
   // construct symmetry group based on invariance of dof_space and configuration
-  std::vector<SupercellSymOp> group(SupercellSymOp::begin(supercell),
-                                    SupercellSymOp::end(supercell));
-
+  std::vector<SupercellSymOp> group;
   if (configuration.has_value()) {
-    group = make_invariant_subgroup(*configuration, group.begin(), group.end());
+    group = make_invariant_subgroup(*configuration);
     if (group.size() == 0) {
       throw std::runtime_error(
           "Error in dof_space_analysis: config factor group has size==0.");
     }
+  } else {
+    group.assign(SupercellSymOp::begin(supercell),
+                 SupercellSymOp::end(supercell));
   }
   if (dof_space.sites.has_value()) {
     group =
@@ -109,9 +82,13 @@ DoFSpaceAnalysisResults dof_space_analysis(
 
   // get matrix rep and associated SymGroup
   // (for global DoF, this makes the point group, removing duplicates)
-  std::shared_ptr<SymGroup const> symgroup;
-  std::vector<Eigen::MatrixXd> matrix_rep =
-      make_matrix_rep(group, dof_space.dof_key, dof_space.sites, symgroup);
+  // (for local DoF, the matrices are sparse block-permutation matrices)
+  // (reps are cached, because the same group recurs for many analyses)
+  std::shared_ptr<MatrixRep const> cached_rep =
+      default_matrix_rep_cache().matrix_rep(group, dof_space.dof_key,
+                                            dof_space.sites);
+  std::shared_ptr<SymGroup const> symgroup = cached_rep->symgroup;
+  irreps::SparseMatrixRep const &matrix_rep = cached_rep->sparse_matrix_rep;
 
   // use the entire group for irrep decomposition
   std::set<Index> group_indices;
@@ -120,21 +97,43 @@ DoFSpaceAnalysisResults dof_space_analysis(
   }
 
   // functions to construct sub groups, used to find high symmetry directions
+  // (subgroups are cached, because the same group recurs for many analyses)
   std::function<irreps::GroupIndicesOrbitSet()> make_cyclic_subgroups_f =
-      [=]() { return group::make_cyclic_subgroups(*symgroup); };
+      [=]() {
+        return *group::default_subgroup_cache().make_cyclic_subgroups(
+            symgroup->multiplication_table);
+      };
   std::function<irreps::GroupIndicesOrbitSet()> make_all_subgroups_f = [=]() {
-    return group::make_all_subgroups(*symgroup);
+    return *group::default_subgroup_cache().make_all_subgroups(
+        symgroup->multiplication_table);
   };
 
   bool allow_complex = true;
 
+  std::shared_ptr<irreps::CharacterTable const> character_table;
+  if (use_character_projection) {
+    character_table = std::make_shared<irreps::CharacterTable const>(
+        irreps::make_character_table(symgroup->multiplication_table,
+                                     symgroup->conjugacy_classes()));
+  }
+
+  std::vector<Eigen::MatrixXd> invariant_blocks;
+  if (use_kstar_blocks) {
+    invariant_blocks = make_kstar_subspaces(dof_space, *supercell, group);
+    if (invariant_blocks.size() == 1) {
+      invariant_blocks.clear();
+    }
+  }
+
   irreps::IrrepDecomposition irrep_decomposition(
       matrix_rep, group_indices, dof_space.basis, make_cyclic_subgroups_f,
-      make_all_subgroups_f, allow_complex, log);
+      make_all_subgroups_f, allow_complex, log, character_table,
+      invariant_blocks, nullptr, n_threads);
 
   // Generate report, based on constructed inputs
-  irreps::VectorSpaceSymReport symmetry_report = vector_space_sym_report(
-      irrep_decomposition, calc_wedges, dof_space.axis_info.glossary);
+  irreps::VectorSpaceSymReport symmetry_report =
+      vector_space_sym_report(irrep_decomposition, calc_wedges,
+                              dof_space.axis_info.glossary, n_threads);
 
   // check for error occuring for "disp"
   if (symmetry_report.symmetry_adapted_subspace.cols() <
@@ -154,5 +153,296 @@ DoFSpaceAnalysisResults dof_space_analysis(
                                  std::move(symmetry_report));
 }
 
+}  // namespace
+
+/// \param dof_space_in The DoFSpace for which a symmetry adapted basis is
+/// constructed. \param prim The prim \param configuration If null, use the full
+/// symmetry of the DoFSpace. If has_value,
+///     use the symmetry of the configuration.
+/// \param exclude_homogeneous_modes Exclude homogeneous modes if this
+///     is true, or include if this is false. If this is null (default),
+///     exclude homogeneous modes for dof==\"disp\" only.
+/// \param include_default_occ_modes Include the dof component for the
+///     default occupation value on each site with occupation DoF. The
+///     default is to exclude these modes because they are not
+///     independent. This parameter is only checked dof==\"occ\". If
+///     false, the default occupation is determined using
+///     `site_index_to_default_occ` if that is provided, else using
+///     `sublattice_index_to_default_occ` if that is provided, else using
+///     occupation index 0.
+/// \param sublattice_index_to_default_occ Optional values of default
+///     occupation index (value), specified by sublattice index (key).
+/// \param site_index_to_default_occ Optional values of default
+///     occupation index (value), specified by supercell site index (key).
+/// \param calc_wedges If true, calculate the irreducible wedges for the vector
+///     space. This may take a long time.
+/// \param log Optional logger. If has value and `log->verbosity() >=
+/// Log::verbose`,
+///     prints step-by-step results to log.
+/// \param use_character_projection If true, find irreps using character
+///     projection operators, with the character table of the symmetry group
+///     constructed from its conjugacy classes. This is much faster for large
+///     DoF spaces. If false (default), use the commuter method.
+/// \param use_kstar_blocks If true, for local DoF, first decompose the DoF
+///     space into components for each star of k-points commensurate with the
+///     superlattice, using `make_kstar_subspaces`, and then find irreps
+///     separately in each component. This is much faster for large
+///     supercells. If the DoF space is not invariant under supercell
+///     translations, or for global DoF, this option has no effect.
+/// \param n_threads Number of threads used to find high symmetry
+///     directions and calculate the irreducible wedges. If <= 0, uses
+///     `std::thread::hardware_concurrency()`. The result does not depend on
+///     the number of threads.
+DoFSpaceAnalysisResults dof_space_analysis(
+    clexulator::DoFSpace const &dof_space_in, std::shared_ptr<Prim const> prim,
+    std::optional<Configuration> configuration,
+    std::optional<bool> exclude_homogeneous_modes,
+    bool include_default_occ_modes,
+    std::optional<std::map<int, int>> sublattice_index_to_default_occ,
+    std::optional<std::map<Index, int>> site_index_to_default_occ,
+    bool calc_wedges, std::optional<Log> log, bool use_character_projection,
+    bool use_kstar_blocks, Index n_threads) {
+  check_basis_cols(dof_space_in.basis.cols(), "Initial DoF space");
+  std::shared_ptr<Supercell const> supercell = make_analysis_supercell(
+      prim, configuration, dof_space_in.transformation_matrix_to_super);
+
+  // --- Construct the standard DoF space ---
+  clexulator::DoFSpace dof_space_pre1 =
+      exclude_homogeneous_mode_space(dof_space_in, exclude_homogeneous_modes);
+  check_basis_cols(dof_space_pre1.basis.cols(),
+                   "After excluding homogeneous mode space");
+
+  clexulator::DoFSpace dof_space = exclude_default_occ_modes(
+      dof_space_pre1, include_default_occ_modes,
+      sublattice_index_to_default_occ, site_index_to_default_occ);
+  check_basis_cols(dof_space.basis.cols(), "After excluding default occ modes");
+
+  return dof_space_analysis_impl(dof_space, supercell, configuration,
+                                 calc_wedges, log, use_character_projection,
+                                 use_kstar_blocks, n_threads);
+}
+
+/// \brief Symmetry analysis of a SparseDoFSpace
+///
+/// Parameters are the same as for the DoFSpace overload. Homogeneous and
+/// default occupation modes are excluded from the sparse basis, so the
+/// dense basis is only constructed once, for the standard DoF space of the
+/// symmetry analysis.
+DoFSpaceAnalysisResults dof_space_analysis(
+    SparseDoFSpace const &dof_space_in, std::shared_ptr<Prim const> prim,
+    std::optional<Configuration> configuration,
+    std::optional<bool> exclude_homogeneous_modes,
+    bool include_default_occ_modes,
+    std::optional<std::map<int, int>> sublattice_index_to_default_occ,
+    std::optional<std::map<Index, int>> site_index_to_default_occ,
+    bool calc_wedges, std::optional<Log> log, bool use_character_projection,
+    bool use_kstar_blocks, Index n_threads) {
+  check_basis_cols(dof_space_in.basis.cols(), "Initial DoF space");
+  std::shared_ptr<Supercell const> supercell = make_analysis_supercell(
+      prim, configuration, dof_space_in.transformation_matrix_to_super);
+
+  // --- Construct the standard DoF space ---
+  SparseDoFSpace dof_space_pre1 =
+      exclude_homogeneous_mode_space(dof_space_in, exclude_homogeneous_modes);
+  check_basis_cols(dof_space_pre1.basis.cols(),
+                   "After excluding homogeneous mode space");
+
+  SparseDoFSpace dof_space = exclude_default_occ_modes(
+      dof_space_pre1, include_default_occ_modes,
+      sublattice_index_to_default_occ, site_index_to_default_occ);
+  check_basis_cols(dof_space.basis.cols(), "After excluding default occ modes");
+
+  return dof_space_analysis_impl(make_dense_dof_space(dof_space), supercell,
+                                 configuration, calc_wedges, log,
+                                 use_character_projection, use_kstar_blocks,
+                                 n_threads);
+}
+
+/// \brief Decompose a local DoF space into components for each star of
+///     k-points commensurate with the superlattice
+///
+/// For local DoF, Fourier transforming site DoF values over the supercell
+/// unit cells separates the DoF space into components for each k-point
+/// commensurate with the superlattice. The components for a star of
+/// k-points, the orbit of a k-point under the point operations of `group`
+/// together with the negated k-points, form a real subspace that is
+/// invariant under `group`. So, the matrix representation of `group` is
+/// block diagonal in the basis formed by the k-star components, and irreps
+/// may be found separately in each block.
+///
+/// \param dof_space The DoFSpace. The column space of `dof_space.basis`
+///     should be invariant under `group`.
+/// \param supercell The supercell
+/// \param group The group, which must be a subgroup of the supercell
+///     factor group
+///
+/// \returns Orthonormal bases (rows == dof_space.basis.rows()) for the
+///     k-star components of the column space of `dof_space.basis`, one per
+///     k-star with a non-zero component. Returns an empty vector for global
+///     DoF, or if the column space of `dof_space.basis` is not invariant
+///     under the supercell translations.
+std::vector<Eigen::MatrixXd> make_kstar_subspaces(
+    clexulator::DoFSpace const &dof_space, Supercell const &supercell,
+    std::vector<SupercellSymOp> const &group) {
+  std::vector<Eigen::MatrixXd> result;
+  if (AnisoValTraits(dof_space.dof_key).global() ||
+      !dof_space.axis_info.site_index.has_value() ||
+      !dof_space.axis_info.dof_component.has_value()) {
+    return result;
+  }
+  std::vector<Index> const &site_index = *dof_space.axis_info.site_index;
+  std::vector<Index> const &dof_component = *dof_space.axis_info.dof_component;
+  Index dim = dof_space.basis.rows();
+  Index n_unitcells = supercell.unitcell_index_converter.total_sites();
+
+  // Rows are grouped by (sublattice, dof_component), there must be one row
+  // per unit cell in each group for the space to be invariant under
+  // translations. Also store the position of each row's unit cell,
+  // fractional with respect to the superlattice vectors.
+  Eigen::Matrix3l const &T =
+      supercell.superlattice.transformation_matrix_to_super();
+  Eigen::Matrix3d T_inv = T.cast<double>().inverse();
+  std::map<std::pair<Index, Index>, Index> row_group_index;
+  std::vector<Index> row_group_size;
+  std::vector<Index> row_group(dim);
+  std::vector<Eigen::Vector3d> row_position(dim);
+  for (Index j = 0; j < dim; ++j) {
+    xtal::UnitCellCoord bijk =
+        supercell.unitcellcoord_index_converter(site_index[j]);
+    auto it = row_group_index
+                  .emplace(std::make_pair(bijk.sublattice(), dof_component[j]),
+                           row_group_size.size())
+                  .first;
+    if (it->second == row_group_size.size()) {
+      row_group_size.push_back(0);
+    }
+    row_group[j] = it->second;
+    row_group_size[it->second] += 1;
+    row_position[j] = T_inv * bijk.unitcell().cast<double>();
+  }
+  for (Index size : row_group_size) {
+    if (size != n_unitcells) {
+      return result;
+    }
+  }
+  Index n_row_groups = row_group_size.size();
+
+  // Commensurate k-points are k = T^-T * m, fractional with respect to the
+  // prim reciprocal lattice, for m in Z^3 / (T^T * Z^3). Point operations
+  // act on m via (T^T * M^T * T^-T), for M the fractional point matrix.
+  xtal::UnitCellIndexConverter kpoint_index_converter(T.transpose());
+  std::set<Index> prim_factor_group_indices;
+  for (SupercellSymOp const &op : group) {
+    prim_factor_group_indices.insert(op.prim_factor_group_index());
+  }
+  std::vector<Eigen::Matrix3d> kpoint_rep;
+  auto const &unitcellcoord_symgroup_rep =
+      supercell.prim->sym_info.unitcellcoord_symgroup_rep;
+  for (Index fg_index : prim_factor_group_indices) {
+    Eigen::Matrix3d M =
+        unitcellcoord_symgroup_rep[fg_index].point_matrix.cast<double>();
+    kpoint_rep.push_back(T.transpose().cast<double>() * M.transpose() *
+                         T_inv.transpose());
+  }
+  auto kpoint_index = [&](Eigen::Vector3d const &m) {
+    xtal::UnitCell m_int(std::lround(m(0)), std::lround(m(1)),
+                         std::lround(m(2)));
+    if (!almost_equal(m, m_int.cast<double>())) {
+      throw std::runtime_error(
+          "Error in make_kstar_subspaces: k-point is not commensurate with "
+          "the superlattice");
+    }
+    return kpoint_index_converter(m_int);
+  };
+
+  // Orthonormal basis for the column space of dof_space.basis
+  Index n = dof_space.basis.cols();
+  Eigen::MatrixXd Q = Eigen::HouseholderQR<Eigen::MatrixXd>(dof_space.basis)
+                          .householderQ() *
+                      Eigen::MatrixXd::Identity(dim, n);
+
+  std::vector<bool> found(n_unitcells, false);
+  Index total_rank = 0;
+  for (Index i = 0; i < n_unitcells; ++i) {
+    if (found[i]) {
+      continue;
+    }
+
+    // Generate the k-star, including -k
+    std::vector<Index> kstar;
+    Eigen::Vector3d m = kpoint_index_converter(i).cast<double>();
+    for (Eigen::Matrix3d const &A : kpoint_rep) {
+      for (Index k : {kpoint_index(A * m), kpoint_index(-(A * m))}) {
+        if (!found[k]) {
+          found[k] = true;
+          kstar.push_back(k);
+        }
+      }
+    }
+
+    // Construct real plane waves for the k-star: cos(2*pi*k.r) and
+    // sin(2*pi*k.r), for each pair (k, -k) and each row group
+    // (cos(2*pi*k.r) has norm sqrt(N) if k == -k, else sqrt(N/2), and
+    // sin(2*pi*k.r) is zero if k == -k)
+    std::vector<Eigen::Vector3d> waves_m;
+    std::vector<bool> waves_is_sin;
+    std::vector<double> waves_norm;
+    std::set<Index> used;
+    for (Index k : kstar) {
+      if (used.count(k)) {
+        continue;
+      }
+      Eigen::Vector3d m_k = kpoint_index_converter(k).cast<double>();
+      Index k_neg = kpoint_index(-m_k);
+      used.insert(k);
+      used.insert(k_neg);
+      double norm = std::sqrt((k_neg == k ? 1.0 : 2.0) / n_unitcells);
+      waves_m.push_back(m_k);
+      waves_is_sin.push_back(false);
+      waves_norm.push_back(norm);
+      if (k_neg != k) {
+        waves_m.push_back(m_k);
+        waves_is_sin.push_back(true);
+        waves_norm.push_back(norm);
+      }
+    }
+    Index n_waves = waves_m.size();
+    Eigen::MatrixXd W = Eigen::MatrixXd::Zero(dim, n_waves * n_row_groups);
+    for (Index w = 0; w < n_waves; ++w) {
+      for (Index j = 0; j < dim; ++j) {
+        double phase = 2.0 * M_PI * waves_m[w].dot(row_position[j]);
+        W(j, w * n_row_groups + row_group[j]) =
+            waves_norm[w] *
+            (waves_is_sin[w] ? std::sin(phase) : std::cos(phase));
+      }
+    }
+
+    // Find the component of the DoF space in the k-star subspace, the
+    // singular values are all 0 or 1 if the DoF space is invariant under
+    // translations
+    Eigen::MatrixXd C = W.transpose() * Q;
+    Eigen::BDCSVD<Eigen::MatrixXd> svd(C, Eigen::ComputeThinU);
+    Eigen::VectorXd const &s = svd.singularValues();
+    Index rank = 0;
+    for (Index l = 0; l < s.size(); ++l) {
+      if (s(l) > TOL) {
+        if (!almost_equal(s(l), 1.0)) {
+          return std::vector<Eigen::MatrixXd>();
+        }
+        ++rank;
+      }
+    }
+    if (rank > 0) {
+      result.push_back(W * svd.matrixU().leftCols(rank));
+      total_rank += rank;
+    }
+  }
+
+  if (total_rank != n) {
+    return std::vector<Eigen::MatrixXd>();
+  }
+  return result;
+}
+
 }  // namespace config
 }  // namespace CASM
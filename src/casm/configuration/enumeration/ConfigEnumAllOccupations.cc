@@ -1,5 +1,13 @@
 #include "casm/configuration/enumeration/ConfigEnumAllOccupations.hh"
 
+#include <algorithm>
+
+#include "casm/configuration/OccCanonicalizer.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/enumeration/ConfigurationFilter.hh"
+#include "casm/configuration/enumeration/OccupationStabilizerChain.hh"
+
 namespace CASM {
 namespace config {
 
@@ -30,6 +38,13 @@ void _set_occupation(Configuration &configuration, std::set<Index> const &sites,
   }
 }
 
+/// \brief Return true if `lhs` precedes `rhs` in Counter order, in which
+///     the first element increments fastest
+bool _precedes(std::vector<int> const &lhs, std::vector<int> const &rhs) {
+  return std::lexicographical_compare(lhs.rbegin(), lhs.rend(), rhs.rbegin(),
+                                      rhs.rend());
+}
+
 }  // namespace
 
 ConfigEnumAllOccupations::ConfigEnumAllOccupations(
@@ -38,10 +53,59 @@ ConfigEnumAllOccupations::ConfigEnumAllOccupations(
       m_sites(sites),
       m_counter(std::vector<int>(m_sites.size(), 0),
                 _make_max_site_occupation(*m_current.supercell, m_sites),
-                std::vector<int>(m_sites.size(), 1)) {
+                std::vector<int>(m_sites.size(), 1)),
+      m_skip_non_primitive(false),
+      m_shard_end(1),
+      m_shard_finished(false) {
   _set_occupation(m_current, m_sites, m_counter);
 }
 
+/// \brief Constructor, skipping filtered configurations
+///
+/// \param background Specifies the background configuration.
+/// \param sites A set of site indices where occupant values are enumerated.
+///     All other sites in the background configuration maintain the
+///     original value.
+/// \param skip_non_primitive If true, skip non-primitive configurations.
+/// \param canonical_subgroup If has value, skip configurations that are not
+///     canonical with respect to this group. Typically this is the subgroup
+///     that leaves the background invariant and does not mix `sites` and
+///     other sites (see `make_invariant_subgroup`).
+/// \param filter If not null, skip configurations for which
+///     `(*filter)(configuration)` is false. It is applied after the
+///     primitive and canonical checks.
+/// \param shard_index, n_shards If `n_shards > 1`, the occupation counter
+///     range is split into `n_shards` contiguous ranges and only values in
+///     range `shard_index` are enumerated. Ranges are split according to
+///     the occupation on the last sites, which vary slowest, using enough
+///     sites for at least 64 distinct values per shard when possible, so
+///     ranges are approximately equal in size before filtering. Shards may
+///     be empty if there are fewer values than shards.
+///
+/// Filtered configurations are skipped by the constructor and by
+/// `advance`, so `value` is always a configuration that passes all filters.
+///
+/// The constructor increments the occupation counter to the beginning of
+/// the shard without checking filters, so the cost is small compared to
+/// enumerating the shard.
+ConfigEnumAllOccupations::ConfigEnumAllOccupations(
+    Configuration const &background, std::set<Index> const &sites,
+    bool skip_non_primitive,
+    std::optional<std::vector<SupercellSymOp>> canonical_subgroup,
+    std::shared_ptr<ConfigurationFilter const> filter, Index shard_index,
+    Index n_shards)
+    : ConfigEnumAllOccupations(background, sites) {
+  m_skip_non_primitive = skip_non_primitive;
+  m_canonical_subgroup = std::move(canonical_subgroup);
+  m_filter = std::move(filter);
+  if (m_canonical_subgroup.has_value() &&
+      OccCanonicalizer::is_supported(*m_current.supercell->prim)) {
+    m_canonicalizer = std::make_shared<OccCanonicalizer>(m_current.supercell);
+  }
+  _begin_shard(shard_index, n_shards);
+  _skip_not_allowed();
+}
+
 /// \brief Get the current Configuration
 Configuration const &ConfigEnumAllOccupations::value() const {
   return m_current;
@@ -49,13 +113,224 @@ Configuration const &ConfigEnumAllOccupations::value() const {
 
 /// \brief Generate the next Configuration
 void ConfigEnumAllOccupations::advance() {
-  if (++m_counter) {
+  if (_increment()) {
     _set_occupation(m_current, m_sites, m_counter);
+    _skip_not_allowed();
   }
 }
 
 /// \brief Return true if `value` is valid, false if no more values
-bool ConfigEnumAllOccupations::is_valid() const { return m_counter.valid(); }
+bool ConfigEnumAllOccupations::is_valid() const {
+  return m_counter.valid() && !m_shard_finished;
+}
+
+/// \brief Return up to `max_size` Configuration, starting with the current
+///     value, and advance past them
+///
+/// Returns fewer than `max_size` Configuration only if the enumeration is
+/// complete. This allows callers to visit configurations in batches, for
+/// instance to reduce overhead when iterating from Python.
+std::vector<Configuration> ConfigEnumAllOccupations::next_batch(
+    Index max_size) {
+  std::vector<Configuration> batch;
+  while (is_valid() && Index(batch.size()) < max_size) {
+    batch.push_back(m_current);
+    advance();
+  }
+  return batch;
+}
+
+/// \brief Return the occupation on `sites` of the current value, which
+///     may be used to resume the enumeration
+///
+/// Occupation indices are ordered by increasing site index. Together with
+/// the constructor arguments, this is sufficient to resume the enumeration
+/// with `resume`. Only valid if `is_valid()`.
+std::vector<int> const &ConfigEnumAllOccupations::state() const {
+  return m_counter;
+}
+
+/// \brief Set the current value to a state previously returned by
+///     `state`
+///
+/// \param state The occupation on `sites` of a value of an enumerator
+///     constructed with the same arguments, as returned by `state()`. It
+///     must not precede the current value.
+///
+/// The occupation counter is incremented to `state` without checking
+/// filters, so the cost is small compared to enumerating the skipped
+/// values. Throws if `state` is not a value of the enumeration, including
+/// if it is not in the enumerator's shard.
+void ConfigEnumAllOccupations::resume(std::vector<int> const &state) {
+  std::vector<int> max_site_occupation =
+      _make_max_site_occupation(*m_current.supercell, m_sites);
+  if (state.size() != m_sites.size()) {
+    throw std::runtime_error(
+        "Error in ConfigEnumAllOccupations::resume: state size does not match "
+        "the number of sites");
+  }
+  for (Index i = 0; i < Index(state.size()); ++i) {
+    if (state[i] < 0 || state[i] > max_site_occupation[i]) {
+      throw std::runtime_error(
+          "Error in ConfigEnumAllOccupations::resume: state occupation index "
+          "out of range");
+    }
+  }
+  if (!is_valid() || _precedes(state, this->state())) {
+    throw std::runtime_error(
+        "Error in ConfigEnumAllOccupations::resume: state precedes the "
+        "current value");
+  }
+  while (this->state() != state) {
+    ++m_counter;
+  }
+  _set_occupation(m_current, m_sites, m_counter);
+  if (_prefix_index() >= m_shard_end || !_is_allowed()) {
+    throw std::runtime_error(
+        "Error in ConfigEnumAllOccupations::resume: state is not a value of "
+        "the enumeration");
+  }
+}
+
+/// \brief Return the operations that leave the current value invariant
+///
+/// The operations are those of the canonical subgroup, if given, else all
+/// supercell operations, that leave the current value invariant and do not
+/// mix `sites` and other sites, in the same order. Equal to
+/// `make_invariant_subgroup(value(), sites, begin, end)` over those
+/// operations. Only valid if `is_valid()`.
+///
+/// The first call constructs an OccupationStabilizerChain, which refines
+/// the group site by site and re-uses the subgroups for the unchanged
+/// slowest varying sites on later calls.
+std::vector<SupercellSymOp> ConfigEnumAllOccupations::invariant_subgroup() {
+  invariant_subgroup_size();
+  return m_stabilizer_chain->make_invariant_subgroup();
+}
+
+/// \brief Return the number of operations that leave the current value
+///     invariant
+///
+/// Same as `invariant_subgroup().size()`, without copying the operations.
+Index ConfigEnumAllOccupations::invariant_subgroup_size() {
+  if (!m_stabilizer_chain) {
+    if (m_canonical_subgroup.has_value()) {
+      m_stabilizer_chain = std::make_shared<OccupationStabilizerChain>(
+          m_current, m_sites, *m_canonical_subgroup);
+    } else {
+      std::vector<SupercellSymOp> group(
+          SupercellSymOp::begin(m_current.supercell),
+          SupercellSymOp::end(m_current.supercell));
+      m_stabilizer_chain = std::make_shared<OccupationStabilizerChain>(
+          m_current, m_sites, group);
+    }
+  }
+  return m_stabilizer_chain->update(m_counter).size();
+}
+
+/// \brief Recent witnesses of non-canonical values, by index into the
+///     canonical subgroup
+///
+/// Its `n_hits()` and `n_scans()` count the canonical checks that were
+/// decided by a recent witness, and those that scanned the subgroup.
+CanonicalWitnessList const &ConfigEnumAllOccupations::recent_witnesses()
+    const {
+  return m_recent_witnesses;
+}
+
+/// \brief Return true if m_current passes all filters
+bool ConfigEnumAllOccupations::_is_allowed() {
+  if (m_skip_non_primitive && !is_primitive(m_current)) {
+    return false;
+  }
+  if (m_canonical_subgroup.has_value()) {
+    auto begin = m_canonical_subgroup->begin();
+    auto end = m_canonical_subgroup->end();
+    if (m_canonicalizer) {
+      if (m_canonicalizer->find_witness(m_current.dof_values.occupation, begin,
+                                        end, m_recent_witnesses) != end) {
+        return false;
+      }
+    } else if (find_non_canonical_witness(m_current, begin, end,
+                                          m_recent_witnesses) != end) {
+      return false;
+    }
+  }
+  if (m_filter && !(*m_filter)(m_current)) {
+    return false;
+  }
+  return true;
+}
+
+/// \brief Advance m_counter until m_current passes all filters, or the
+///     enumeration is complete
+void ConfigEnumAllOccupations::_skip_not_allowed() {
+  while (is_valid() && !_is_allowed()) {
+    if (_increment()) {
+      _set_occupation(m_current, m_sites, m_counter);
+    }
+  }
+}
+
+/// \brief Restrict the enumeration to a shard of the counter range, and
+///     advance m_counter to the beginning of the shard
+///
+/// The shard is determined by the occupation on the last sites in m_sites,
+/// the "prefix", which varies slowest in m_counter. Enough sites are
+/// included in the prefix for at least `n_shards * 64` prefix values, when
+/// possible, and shard `shard_index` includes the prefix index range
+/// `[shard_index * n_prefix / n_shards, (shard_index + 1) * n_prefix /
+/// n_shards)`.
+void ConfigEnumAllOccupations::_begin_shard(Index shard_index,
+                                            Index n_shards) {
+  if (n_shards < 1 || shard_index < 0 || shard_index >= n_shards) {
+    throw std::runtime_error(
+        "Error in ConfigEnumAllOccupations: invalid shard_index or n_shards");
+  }
+  if (n_shards == 1) {
+    return;
+  }
+  std::vector<int> max_site_occupation =
+      _make_max_site_occupation(*m_current.supercell, m_sites);
+  Index n_prefix = 1;
+  for (auto it = max_site_occupation.rbegin();
+       it != max_site_occupation.rend() && n_prefix < n_shards * 64; ++it) {
+    m_prefix_size.push_back(*it + 1);
+    n_prefix *= *it + 1;
+  }
+  Index shard_begin = shard_index * n_prefix / n_shards;
+  m_shard_end = (shard_index + 1) * n_prefix / n_shards;
+  if (shard_begin >= m_shard_end) {
+    m_shard_finished = true;
+    return;
+  }
+  while (_prefix_index() < shard_begin) {
+    ++m_counter;
+  }
+  _set_occupation(m_current, m_sites, m_counter);
+}
+
+/// \brief Index of the current value of the shard prefix
+///
+/// Returns 0 if not sharded.
+Index ConfigEnumAllOccupations::_prefix_index() const {
+  std::vector<int> const &value = m_counter;
+  Index index = 0;
+  Index site = value.size() - 1;
+  for (Index size : m_prefix_size) {
+    index = index * size + value[site--];
+  }
+  return index;
+}
+
+/// \brief Increment m_counter, and return true if the result is valid
+///     and in the shard
+bool ConfigEnumAllOccupations::_increment() {
+  if (++m_counter && _prefix_index() >= m_shard_end) {
+    m_shard_finished = true;
+  }
+  return is_valid();
+}
 
 }  // namespace config
 }  // namespace CASM
@@ -0,0 +1,371 @@
+#include "casm/configuration/enumeration/ConfigEnumCanonicalOccupations.hh"
+
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {  // anonymous
+
+/// \brief Return true if op leaves the global DoF values of configuration
+///     invariant
+bool global_dof_are_invariant(SupercellSymOp const &op,
+                              Configuration const &configuration) {
+  auto const &global_dof_values = configuration.dof_values.global_dof_values;
+  if (global_dof_values.empty()) {
+    return true;
+  }
+  double tol = configuration.supercell->prim->basicstructure->lattice().tol();
+  clexulator::ConfigDoFValues transformed =
+      copy_apply(op, configuration.dof_values);
+  for (auto const &name_value : global_dof_values) {
+    if (!almost_equal(transformed.global_dof_values.at(name_value.first),
+                      name_value.second, tol)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param background Specifies the background configuration.
+/// \param sites A set of site indices where occupant values are enumerated.
+///     All other sites in the background configuration maintain the
+///     original value.
+/// \param group Only occupations which are canonical with respect to this
+///     group are enumerated.
+/// \param skip_non_primitive If true, also skip non-primitive
+///     configurations.
+/// \param occupant_count_constraints If not empty, only occupations
+///     satisfying all constraints are enumerated. Sites not in `sites`
+///     count towards constraints with their background occupant.
+ConfigEnumCanonicalOccupations::ConfigEnumCanonicalOccupations(
+    Configuration const &background, std::set<Index> const &sites,
+    std::vector<SupercellSymOp> const &group, bool skip_non_primitive,
+    std::vector<OccupantCountConstraint> const &occupant_count_constraints)
+    : m_current(background),
+      m_sites(sites.begin(), sites.end()),
+      m_value(m_sites.size(), -1),
+      m_group(group),
+      m_undecided(m_sites.size() + 1),
+      m_constraints(occupant_count_constraints),
+      m_count(m_constraints.size(), 0),
+      m_n_possible(m_constraints.size(), 0),
+      m_site_constraints(m_sites.size()),
+      m_check_leaf_canonical(false),
+      m_skip_non_primitive(skip_non_primitive),
+      m_is_valid(false) {
+  Supercell const &supercell = *m_current.supercell;
+  auto const &converter = supercell.unitcellcoord_index_converter;
+  auto const &basis = supercell.prim->basicstructure->basis();
+  Index n_sites = converter.total_sites();
+
+  m_sublattice.resize(n_sites);
+  for (Index l = 0; l < n_sites; ++l) {
+    m_sublattice[l] = converter(l).sublattice();
+  }
+  for (Index site_index : m_sites) {
+    m_max_occupation.push_back(
+        basis[m_sublattice[site_index]].occupant_dof().size() - 1);
+  }
+  m_is_known.resize(n_sites, 1);
+  for (Index site_index : m_sites) {
+    m_is_known[site_index] = 0;
+  }
+
+  // initial counts, from background occupants on fixed sites
+  std::map<Index, Index> k_by_site_index;
+  for (Index k = 0; k < Index(m_sites.size()); ++k) {
+    k_by_site_index[m_sites[k]] = k;
+  }
+  for (Index c = 0; c < Index(m_constraints.size()); ++c) {
+    OccupantCountConstraint const &constraint = m_constraints[c];
+    for (Index site_index : constraint.site_indices) {
+      if (site_index < 0 || site_index >= n_sites) {
+        throw std::runtime_error(
+            "Error in ConfigEnumCanonicalOccupations: constraint site index "
+            "out of range");
+      }
+      auto const &occupants = basis[m_sublattice[site_index]].occupant_dof();
+      int occupant_index = -1;
+      for (Index i = 0; i < Index(occupants.size()); ++i) {
+        if (occupants[i].name() == constraint.occupant_name) {
+          occupant_index = i;
+        }
+      }
+      if (occupant_index == -1) {
+        continue;
+      }
+      auto it = k_by_site_index.find(site_index);
+      if (it == k_by_site_index.end()) {
+        if (m_current.dof_values.occupation(site_index) == occupant_index) {
+          ++m_count[c];
+        }
+      } else {
+        m_site_constraints[it->second].emplace_back(c, occupant_index);
+        ++m_n_possible[c];
+      }
+    }
+    if (m_count[c] > constraint.max_count ||
+        m_count[c] + m_n_possible[c] < constraint.min_count) {
+      return;
+    }
+  }
+
+  for (auto const &op : m_group) {
+    if (global_dof_are_invariant(op, background)) {
+      m_permute.push_back(op.combined_permute());
+      m_prim_factor_group_index.push_back(op.prim_factor_group_index());
+    } else {
+      m_check_leaf_canonical = true;
+    }
+  }
+  if (!supercell.prim->local_dof_info.empty()) {
+    m_check_leaf_canonical = true;
+  }
+
+  // check the background alone, then search
+  std::vector<OpStatus> &root = m_undecided[0];
+  for (Index g = 0; g < Index(m_permute.size()); ++g) {
+    OpStatus status(g, 0);
+    int cmp = _compare(status);
+    if (cmp > 0) {
+      return;
+    }
+    if (cmp == 0) {
+      root.push_back(status);
+    }
+  }
+  if (m_sites.empty()) {
+    m_is_valid = _is_allowed_leaf();
+  } else {
+    m_is_valid = _search(0);
+  }
+}
+
+/// \brief Get the current Configuration
+Configuration const &ConfigEnumCanonicalOccupations::value() const {
+  return m_current;
+}
+
+/// \brief Generate the next Configuration
+void ConfigEnumCanonicalOccupations::advance() {
+  if (!m_is_valid) {
+    return;
+  }
+  m_is_valid = !m_sites.empty() && _search(m_sites.size() - 1);
+}
+
+/// \brief Return true if `value` is valid, false if no more values
+bool ConfigEnumCanonicalOccupations::is_valid() const { return m_is_valid; }
+
+/// \brief Return up to `max_size` Configuration, starting with the current
+///     value, and advance past them
+std::vector<Configuration> ConfigEnumCanonicalOccupations::next_batch(
+    Index max_size) {
+  std::vector<Configuration> batch;
+  while (is_valid() && Index(batch.size()) < max_size) {
+    batch.push_back(m_current);
+    advance();
+  }
+  return batch;
+}
+
+/// \brief Return the occupation on `sites` of the current value, which
+///     may be used to resume the enumeration
+///
+/// Occupation indices are ordered by increasing site index. Together with
+/// the constructor arguments, this is sufficient to resume the enumeration
+/// with `resume`. Only valid if `is_valid()`.
+std::vector<int> const &ConfigEnumCanonicalOccupations::state() const {
+  return m_value;
+}
+
+/// \brief Set the current value to a state previously returned by
+///     `state`
+///
+/// \param state The occupation on `sites` of a value of an enumerator
+///     constructed with the same arguments, as returned by `state()`
+///
+/// The search state is rebuilt by assigning `state` one site at a time, so
+/// the cost is independent of the position of `state` in the enumeration.
+/// Throws if `state` is not a value of the enumeration, in which case
+/// `is_valid()` is false afterwards.
+void ConfigEnumCanonicalOccupations::resume(std::vector<int> const &state) {
+  Index n = m_sites.size();
+  if (Index(state.size()) != n) {
+    throw std::runtime_error(
+        "Error in ConfigEnumCanonicalOccupations::resume: state size does not "
+        "match the number of sites");
+  }
+  for (Index k = 0; k < n; ++k) {
+    if (state[k] < 0 || state[k] > m_max_occupation[k]) {
+      throw std::runtime_error(
+          "Error in ConfigEnumCanonicalOccupations::resume: state occupation "
+          "index out of range");
+    }
+  }
+  if (!m_is_valid) {
+    throw std::runtime_error(
+        "Error in ConfigEnumCanonicalOccupations::resume: enumeration is "
+        "complete");
+  }
+
+  // undo the current assignment, then assign `state` as `_search` does
+  Eigen::VectorXi &occupation = m_current.dof_values.occupation;
+  for (Index k = n - 1; k >= 0; --k) {
+    _count_assign(k, -1);
+    m_value[k] = -1;
+    m_is_known[m_sites[k]] = 0;
+  }
+  for (Index k = 0; k < n; ++k) {
+    m_value[k] = state[k];
+    occupation(m_sites[k]) = state[k];
+    m_is_known[m_sites[k]] = 1;
+    _count_assign(k, 1);
+    if (!_is_feasible(k) || !_update(k)) {
+      m_is_valid = false;
+      break;
+    }
+  }
+  if (m_is_valid) {
+    m_is_valid = _is_allowed_leaf();
+  }
+  if (!m_is_valid) {
+    throw std::runtime_error(
+        "Error in ConfigEnumCanonicalOccupations::resume: state is not a value "
+        "of the enumeration");
+  }
+}
+
+/// \brief Find the next complete occupation, starting by incrementing the
+///     occupant on m_sites[k]
+///
+/// Requires that sites m_sites[i], for i < k, are assigned, that the
+/// partial occupation was not pruned, and that sites m_sites[i], for i > k,
+/// are not assigned. Returns false if there are no more complete
+/// occupations.
+bool ConfigEnumCanonicalOccupations::_search(Index k) {
+  Index n = m_sites.size();
+  Eigen::VectorXi &occupation = m_current.dof_values.occupation;
+  while (k >= 0) {
+    if (k == n) {
+      if (_is_allowed_leaf()) {
+        return true;
+      }
+      --k;
+      continue;
+    }
+    Index site_index = m_sites[k];
+    if (m_value[k] >= 0) {
+      _count_assign(k, -1);
+    }
+    int value = ++m_value[k];
+    if (value > m_max_occupation[k]) {
+      m_value[k] = -1;
+      m_is_known[site_index] = 0;
+      --k;
+      continue;
+    }
+    occupation(site_index) = value;
+    m_is_known[site_index] = 1;
+    _count_assign(k, 1);
+    if (_is_feasible(k) && _update(k)) {
+      ++k;
+    }
+  }
+  return false;
+}
+
+/// \brief Update constraint counts to assign m_value[k] to m_sites[k]
+///
+/// Use `sign` = 1 to assign, and `sign` = -1 to undo the assignment.
+void ConfigEnumCanonicalOccupations::_count_assign(Index k, int sign) {
+  for (auto const &c_occupant : m_site_constraints[k]) {
+    m_n_possible[c_occupant.first] -= sign;
+    if (m_value[k] == c_occupant.second) {
+      m_count[c_occupant.first] += sign;
+    }
+  }
+}
+
+/// \brief Return true if constraints on m_sites[k] may still be satisfied
+bool ConfigEnumCanonicalOccupations::_is_feasible(Index k) const {
+  for (auto const &c_occupant : m_site_constraints[k]) {
+    Index c = c_occupant.first;
+    if (m_count[c] > m_constraints[c].max_count ||
+        m_count[c] + m_n_possible[c] < m_constraints[c].min_count) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Make m_undecided[k + 1] from m_undecided[k]; return false if
+///     the current partial occupation cannot be canonical
+bool ConfigEnumCanonicalOccupations::_update(Index k) {
+  std::vector<OpStatus> &next = m_undecided[k + 1];
+  next.clear();
+  for (OpStatus status : m_undecided[k]) {
+    int cmp = _compare(status);
+    if (cmp > 0) {
+      return false;
+    }
+    if (cmp == 0) {
+      next.push_back(status);
+    }
+  }
+  return true;
+}
+
+/// \brief Compare transformed and current occupation on known sites
+///
+/// Starting at `status.second`, compares the transformed occupation to the
+/// current occupation site by site, while both are known. Returns 1 if the
+/// transformed occupation is found to be greater, -1 if found to be lesser
+/// or equal on all sites (the operation need not be checked further), and 0
+/// if undecided. On return, `status.second` is the first site not found
+/// equal.
+int ConfigEnumCanonicalOccupations::_compare(OpStatus &status) const {
+  Eigen::VectorXi const &occupation = m_current.dof_values.occupation;
+  auto const &prim_sym_info = m_current.supercell->prim->sym_info;
+  sym_info::Permutation const &permute = m_permute[status.first];
+  auto const &occ_rep =
+      prim_sym_info.occ_symgroup_rep[m_prim_factor_group_index[status.first]];
+  bool has_aniso_occs = prim_sym_info.has_aniso_occs;
+  Index n_sites = permute.size();
+  Index &i = status.second;
+  for (; i < n_sites; ++i) {
+    Index j = permute[i];
+    if (!m_is_known[i] || !m_is_known[j]) {
+      return 0;
+    }
+    int transformed = has_aniso_occs ? occ_rep[m_sublattice[j]][occupation(j)]
+                                     : occupation(j);
+    if (transformed != occupation(i)) {
+      return transformed > occupation(i) ? 1 : -1;
+    }
+  }
+  return -1;
+}
+
+/// \brief Final checks on a complete occupation
+bool ConfigEnumCanonicalOccupations::_is_allowed_leaf() const {
+  if (m_check_leaf_canonical &&
+      !is_canonical(m_current, m_group.begin(), m_group.end())) {
+    return false;
+  }
+  if (m_skip_non_primitive && !is_primitive(m_current)) {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace config
+}  // namespace CASM
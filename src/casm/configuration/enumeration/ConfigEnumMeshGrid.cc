@@ -0,0 +1,309 @@
+#include "casm/configuration/enumeration/ConfigEnumMeshGrid.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace CASM {
+namespace config {
+
+namespace {  // anonymous
+
+/// \brief Return the DoF values for `dof_key`, flattened
+Eigen::Map<Eigen::VectorXd> _flat_dof_values(Configuration &configuration,
+                                             std::string const &dof_key,
+                                             bool is_global) {
+  if (is_global) {
+    Eigen::VectorXd &x = configuration.dof_values.global_dof_values.at(dof_key);
+    return Eigen::Map<Eigen::VectorXd>(x.data(), x.size());
+  }
+  Eigen::MatrixXd &x = configuration.dof_values.local_dof_values.at(dof_key);
+  return Eigen::Map<Eigen::VectorXd>(x.data(), x.size());
+}
+
+/// \brief Return `num` evenly spaced values over [start, stop], as
+///     `numpy.linspace`
+std::vector<double> _linspace(double start, double stop, Index num) {
+  if (num == 1) {
+    return {start};
+  }
+  std::vector<double> x;
+  for (Index k = 0; k < num; ++k) {
+    x.push_back(k == num - 1 ? stop : start + k * (stop - start) / (num - 1));
+  }
+  return x;
+}
+
+}  // namespace
+
+/// \brief Constructor, enumerate on a mesh grid of DoFSpace coordinates
+///
+/// \param background The background configuration on which enumeration
+///     takes place.
+/// \param dof_space Specifies the DoF being enumerated. The basis of the
+///     DoFSpace are the axes on which the mesh grid is constructed. For
+///     local DoF, the dof_space supercell must tile the background supercell.
+/// \param xi The grid coordinates, `[x1, x2, ...]`, along each `dof_space`
+///     basis vector, as if used by `numpy.meshgrid`. There must be one vector
+///     per `dof_space` basis vector.
+ConfigEnumMeshGrid::ConfigEnumMeshGrid(Configuration const &background,
+                                       clexulator::DoFSpace const &dof_space,
+                                       std::vector<Eigen::VectorXd> const &xi)
+    : m_current(background),
+      m_trim_corners(false),
+      m_stop(0.0),
+      m_abs_tol(TOL),
+      m_grid_index(0),
+      m_counter(std::vector<int>(1, 0), std::vector<int>(1, 0),
+                std::vector<int>(1, 1)),
+      m_is_valid(false) {
+  if (xi.size() != dof_space.basis.cols()) {
+    throw std::runtime_error(
+        "Error in ConfigEnumMeshGrid: xi.size() != dof_space dimension");
+  }
+  Grid grid;
+  for (auto const &x : xi) {
+    grid.xi.emplace_back(x.data(), x.data() + x.size());
+  }
+  grid.trans_mat = Eigen::MatrixXd::Identity(xi.size(), xi.size());
+  m_grids.push_back(std::move(grid));
+  _init(dof_space);
+}
+
+/// \brief Constructor, enumerate on a mesh grid in each SubWedge of an
+///     irreducible wedge
+///
+/// \param background The background configuration on which enumeration
+///     takes place.
+/// \param dof_space Specifies the DoF being enumerated. For local DoF, the
+///     dof_space supercell must tile the background supercell.
+/// \param irreducible_wedge The irreducible wedge, from a
+///     VectorSpaceSymReport calculated using `dof_space_analysis` of
+///     `background`.
+/// \param stop The ending value of the sequence of grid points along each
+///     SubWedge axis. The start value is 0.0, unless the axis has symmetric
+///     multiplicity of 1, in which case the start value is `-stop`. Must be
+///     positive.
+/// \param num Number of grid points along each SubWedge axis, including 0.0
+///     and `stop`. If the axis has symmetric multiplicity of 1, then
+///     `2*num-1` is used to keep the same spacing. Must be positive.
+/// \param trim_corners If true, skip grid points that lie outside the
+///     ellipsoid inscribed within the extrema of the grid.
+/// \param abs_tol Tolerance used to trim corners
+ConfigEnumMeshGrid::ConfigEnumMeshGrid(
+    Configuration const &background, clexulator::DoFSpace const &dof_space,
+    std::vector<irreps::SubWedge> const &irreducible_wedge, double stop,
+    Index num, bool trim_corners, double abs_tol)
+    : m_current(background),
+      m_trim_corners(trim_corners),
+      m_stop(stop),
+      m_abs_tol(abs_tol),
+      m_grid_index(0),
+      m_counter(std::vector<int>(1, 0), std::vector<int>(1, 0),
+                std::vector<int>(1, 1)),
+      m_is_valid(false) {
+  if (stop <= 0.0 || num < 1) {
+    throw std::runtime_error(
+        "Error in ConfigEnumMeshGrid: stop and num must be positive");
+  }
+  for (auto const &subwedge : irreducible_wedge) {
+    if (subwedge.trans_mat.rows() != dof_space.basis.rows()) {
+      throw std::runtime_error(
+          "Error in ConfigEnumMeshGrid: SubWedge and dof_space dimensions "
+          "do not match");
+    }
+    Grid grid;
+    for (auto const &irrep_wedge : subwedge.irrep_wedges) {
+      for (Index m : irrep_wedge.mult) {
+        // For axes with multiplicity==1, include both positive and negative
+        // coordinates; otherwise, only include positive
+        if (m == 1) {
+          grid.xi.push_back(_linspace(-stop, stop, 2 * num - 1));
+        } else {
+          grid.xi.push_back(_linspace(0.0, stop, num));
+        }
+      }
+    }
+    grid.trans_mat = dof_space.basis_inv * subwedge.trans_mat;
+    m_grids.push_back(std::move(grid));
+  }
+  _init(dof_space);
+}
+
+/// \brief Get the current Configuration
+Configuration const &ConfigEnumMeshGrid::value() const { return m_current; }
+
+/// \brief Get the DoFSpace coordinates of the current Configuration
+Eigen::VectorXd const &ConfigEnumMeshGrid::order_parameters() const {
+  return m_order_parameters;
+}
+
+/// \brief Get the index of the SubWedge of the current Configuration
+///
+/// For enumeration on a mesh grid of DoFSpace coordinates, this is 0.
+Index ConfigEnumMeshGrid::subwedge_index() const { return m_grid_index; }
+
+/// \brief Generate the next Configuration
+void ConfigEnumMeshGrid::advance() {
+  _advance_point();
+  if (m_is_valid) {
+    _set_dof_values(m_current, m_order_parameters);
+  }
+}
+
+/// \brief Return true if `value` is valid, false if no more valid values
+bool ConfigEnumMeshGrid::is_valid() const { return m_is_valid; }
+
+/// \brief Return up to `max_size` Configuration, starting with the current
+///     value, and advance past them
+///
+/// \param max_size The maximum number of configurations to return. Fewer
+///     are returned only if the enumeration is complete.
+///
+/// \returns Copies of the configurations
+std::vector<Configuration> ConfigEnumMeshGrid::next_batch(Index max_size) {
+  Eigen::MatrixXd order_parameters;
+  std::vector<Index> subwedge_indices;
+  return next_batch(max_size, order_parameters, subwedge_indices);
+}
+
+/// \brief Return up to `max_size` Configuration, starting with the current
+///     value, and advance past them, with their DoFSpace coordinates and
+///     SubWedge indices
+///
+/// The DoF values of all configurations in the batch are found with one
+/// matrix-matrix product.
+///
+/// \param max_size The maximum number of configurations to return. Fewer
+///     are returned only if the enumeration is complete.
+/// \param order_parameters Set to the DoFSpace coordinates of the
+///     configurations, as columns
+/// \param subwedge_indices Set to the SubWedge index of the configurations
+///
+/// \returns Copies of the configurations
+std::vector<Configuration> ConfigEnumMeshGrid::next_batch(
+    Index max_size, Eigen::MatrixXd &order_parameters,
+    std::vector<Index> &subwedge_indices) {
+  std::vector<Eigen::VectorXd> points;
+  subwedge_indices.clear();
+  while (m_is_valid && points.size() < max_size) {
+    points.push_back(m_order_parameters);
+    subwedge_indices.push_back(m_grid_index);
+    _advance_point();
+  }
+
+  order_parameters.resize(m_linear.cols(), points.size());
+  for (Index i = 0; i < points.size(); ++i) {
+    order_parameters.col(i) = points[i];
+  }
+  Eigen::MatrixXd values = m_linear * order_parameters;
+  values.colwise() += m_offset;
+
+  std::vector<Configuration> batch(points.size(), m_current);
+  for (Index i = 0; i < batch.size(); ++i) {
+    _flat_dof_values(batch[i], m_dof_key, m_is_global) = values.col(i);
+  }
+  if (m_is_valid) {
+    _set_dof_values(m_current, m_order_parameters);
+  }
+  return batch;
+}
+
+/// \brief Shared constructor implementation
+///
+/// Finds the affine map from DoFSpace coordinates to DoF values, using
+/// `set_dof_space_values` once per DoFSpace basis vector, and begins the
+/// first grid.
+void ConfigEnumMeshGrid::_init(clexulator::DoFSpace const &dof_space) {
+  if (dof_space.dof_key == "occ") {
+    throw std::runtime_error(
+        "Error in ConfigEnumMeshGrid: dof_space.dof_key == \"occ\" is not "
+        "supported");
+  }
+  m_dof_key = dof_space.dof_key;
+  m_is_global = dof_space.is_global;
+
+  Index dim = dof_space.basis.cols();
+  Configuration tmp = m_current;
+  set_dof_space_values(tmp, dof_space, Eigen::VectorXd::Zero(dim));
+  m_offset = _flat_dof_values(tmp, m_dof_key, m_is_global);
+  m_linear.resize(m_offset.size(), dim);
+  for (Index i = 0; i < dim; ++i) {
+    tmp = m_current;
+    set_dof_space_values(tmp, dof_space, Eigen::VectorXd::Unit(dim, i));
+    m_linear.col(i) = _flat_dof_values(tmp, m_dof_key, m_is_global) - m_offset;
+  }
+
+  m_grid_index = 0;
+  _begin_grid();
+  if (m_is_valid) {
+    _set_dof_values(m_current, m_order_parameters);
+  }
+}
+
+/// \brief Begin the grid `m_grid_index`, or later grids if it is empty
+///
+/// Sets m_is_valid, and if valid m_counter and m_order_parameters, for the
+/// first allowed point.
+void ConfigEnumMeshGrid::_begin_grid() {
+  for (; m_grid_index < m_grids.size(); ++m_grid_index) {
+    auto const &xi = m_grids[m_grid_index].xi;
+    std::vector<int> final;
+    for (auto const &x : xi) {
+      final.push_back(int(x.size()) - 1);
+    }
+    if (xi.empty() || *std::min_element(final.begin(), final.end()) < 0) {
+      continue;
+    }
+    m_counter = Counter<std::vector<int>>(std::vector<int>(xi.size(), 0), final,
+                                          std::vector<int>(xi.size(), 1));
+    for (; m_counter.valid(); ++m_counter) {
+      if (_set_point()) {
+        m_is_valid = true;
+        return;
+      }
+    }
+  }
+  m_is_valid = false;
+}
+
+/// \brief Advance to the next point that is not trimmed, or the end
+void ConfigEnumMeshGrid::_advance_point() {
+  if (!m_is_valid) {
+    return;
+  }
+  ++m_counter;
+  for (; m_counter.valid(); ++m_counter) {
+    if (_set_point()) {
+      return;
+    }
+  }
+  ++m_grid_index;
+  _begin_grid();
+}
+
+/// \brief Set m_order_parameters for the current point of m_counter,
+///     return false if the point is trimmed
+bool ConfigEnumMeshGrid::_set_point() {
+  auto const &grid = m_grids[m_grid_index];
+  Eigen::VectorXd x(grid.xi.size());
+  for (Index i = 0; i < x.size(); ++i) {
+    x(i) = grid.xi[i][m_counter[i]];
+  }
+  if (m_trim_corners &&
+      x.squaredNorm() / (m_stop * m_stop) > 1.0 + m_abs_tol) {
+    return false;
+  }
+  m_order_parameters = grid.trans_mat * x;
+  return true;
+}
+
+/// \brief Set the DoF values of `configuration` from DoFSpace coordinates
+void ConfigEnumMeshGrid::_set_dof_values(
+    Configuration &configuration,
+    Eigen::VectorXd const &order_parameters) const {
+  _flat_dof_values(configuration, m_dof_key, m_is_global) =
+      m_offset + m_linear * order_parameters;
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,73 @@
+#include "casm/configuration/enumeration/ConfigEnumOccupationsGrayCode.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Constructor
+///
+/// \param background Specifies the background configuration.
+/// \param sites A set of site indices where occupant values are enumerated.
+///     All other sites in the background configuration maintain the
+///     original value.
+///
+/// The first occupation has occupant index 0 on all `sites`.
+ConfigEnumOccupationsGrayCode::ConfigEnumOccupationsGrayCode(
+    Configuration const &background, std::set<Index> const &sites)
+    : m_current(background),
+      m_sites(sites.begin(), sites.end()),
+      m_direction(m_sites.size(), 1),
+      m_is_valid(true) {
+  auto const &converter = m_current.supercell->unitcellcoord_index_converter;
+  auto const &basis = m_current.supercell->prim->basicstructure->basis();
+  for (Index site_index : m_sites) {
+    m_max_occupation.push_back(
+        basis[converter(site_index).sublattice()].occupant_dof().size() - 1);
+    m_current.dof_values.occupation(site_index) = 0;
+  }
+}
+
+/// \brief Get the current Configuration
+Configuration const &ConfigEnumOccupationsGrayCode::value() const {
+  return m_current;
+}
+
+/// \brief Generate the next Configuration, by changing one site
+///
+/// The lowest position in `sites` that can step in its current direction is
+/// changed by one occupant index. Positions below it, which cannot step,
+/// reverse direction. If no position can step, the enumeration is complete.
+void ConfigEnumOccupationsGrayCode::advance() {
+  if (!m_is_valid) {
+    return;
+  }
+  Eigen::VectorXi &occupation = m_current.dof_values.occupation;
+  for (Index k = 0; k < Index(m_sites.size()); ++k) {
+    Index site_index = m_sites[k];
+    int old_value = occupation(site_index);
+    int new_value = old_value + m_direction[k];
+    if (new_value >= 0 && new_value <= m_max_occupation[k]) {
+      occupation(site_index) = new_value;
+      m_last_change.site_index = site_index;
+      m_last_change.old_value = old_value;
+      m_last_change.new_value = new_value;
+      return;
+    }
+    m_direction[k] = -m_direction[k];
+  }
+  m_is_valid = false;
+  m_last_change = OccupationDelta();
+}
+
+/// \brief Return true if `value` is valid, false if no more values
+bool ConfigEnumOccupationsGrayCode::is_valid() const { return m_is_valid; }
+
+/// \brief The change made by the last `advance`
+///
+/// Before the first `advance`, and after the enumeration is complete,
+/// `last_change().site_index` is -1.
+OccupationDelta const &ConfigEnumOccupationsGrayCode::last_change() const {
+  return m_last_change;
+}
+
+}  // namespace config
+}  // namespace CASM
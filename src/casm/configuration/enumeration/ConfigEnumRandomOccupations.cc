@@ -0,0 +1,309 @@
+#include "casm/configuration/enumeration/ConfigEnumRandomOccupations.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include "casm/configuration/OccCanonicalizer.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/parallel.hh"
+#include "casm/crystallography/BasicStructure.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// \brief Return a random number engine for candidate `i`
+std::mt19937_64 make_candidate_engine(std::uint64_t seed, Index i) {
+  std::uint64_t u = i;
+  std::seed_seq seq{std::uint32_t(seed), std::uint32_t(seed >> 32),
+                    std::uint32_t(u), std::uint32_t(u >> 32)};
+  return std::mt19937_64(seq);
+}
+
+}  // namespace
+
+/// \brief Make the SiteComposition of the sites on some sublattices, from
+///     occupant fractions
+///
+/// \param supercell The supercell
+/// \param sublattice_indices The sublattices whose sites are included
+/// \param occupant_fractions Fraction of the sites with each occupant, by
+///     occupant name. Must be non-negative and sum to 1.
+///
+/// Counts are rounded down from `fraction * n_sites`, and the remaining
+/// sites are given, one each, to the occupants with the largest remainders
+/// (ties broken by occupant name), so counts sum to the number of sites.
+SiteComposition make_sublattice_composition(
+    Supercell const &supercell, std::set<Index> const &sublattice_indices,
+    std::map<std::string, double> const &occupant_fractions) {
+  SiteComposition composition;
+  auto const &converter = supercell.unitcellcoord_index_converter;
+  for (Index l = 0; l < converter.total_sites(); ++l) {
+    if (sublattice_indices.count(converter(l).sublattice())) {
+      composition.site_indices.insert(l);
+    }
+  }
+
+  double sum = 0.0;
+  for (auto const &name_fraction : occupant_fractions) {
+    if (name_fraction.second < -TOL) {
+      throw std::runtime_error(
+          "Error in make_sublattice_composition: negative fraction");
+    }
+    sum += name_fraction.second;
+  }
+  if (std::abs(sum - 1.0) > TOL) {
+    throw std::runtime_error(
+        "Error in make_sublattice_composition: fractions do not sum to 1");
+  }
+
+  Index n_sites = composition.site_indices.size();
+  Index n_assigned = 0;
+  std::vector<std::pair<double, std::string>> remainders;
+  for (auto const &name_fraction : occupant_fractions) {
+    double x = std::max(name_fraction.second, 0.0) * n_sites;
+    Index count = Index(std::floor(x));
+    composition.occupant_counts[name_fraction.first] = count;
+    n_assigned += count;
+    remainders.emplace_back(x - count, name_fraction.first);
+  }
+  std::stable_sort(remainders.begin(), remainders.end(),
+                   [](std::pair<double, std::string> const &lhs,
+                      std::pair<double, std::string> const &rhs) {
+                     return lhs.first > rhs.first;
+                   });
+  for (Index i = 0; n_assigned < n_sites; ++i, ++n_assigned) {
+    composition.occupant_counts[remainders[i].second] += 1;
+  }
+  return composition;
+}
+
+/// \brief Constructor
+///
+/// \param background Specifies the background configuration. Sites not in
+///     any of `compositions` keep the background occupation.
+/// \param compositions The exact composition of sets of sites. Sets of
+///     sites must not overlap, and each occupant with a non-zero count must
+///     be allowed on every site of its set.
+/// \param seed Seed for the random number engines
+/// \param skip_non_primitive If true, reject non-primitive configurations
+/// \param n_threads Number of threads used to draw and canonicalize
+///     candidates. If <= 0, uses `resolve_n_threads(n_threads)`.
+ConfigEnumRandomOccupations::ConfigEnumRandomOccupations(
+    Configuration const &background,
+    std::vector<SiteComposition> const &compositions, std::uint64_t seed,
+    bool skip_non_primitive, Index n_threads)
+    : m_background(background),
+      m_seed(seed),
+      m_skip_non_primitive(skip_non_primitive),
+      m_n_threads(resolve_n_threads(n_threads)),
+      m_n_attempts(0),
+      m_n_duplicates(0),
+      m_n_non_primitive(0) {
+  auto const &supercell = *m_background.supercell;
+  auto const &basis = supercell.prim->basicstructure->basis();
+  auto const &converter = supercell.unitcellcoord_index_converter;
+  Index n_sites = converter.total_sites();
+  std::vector<char> is_included(n_sites, 0);
+
+  for (auto const &composition : compositions) {
+    std::vector<Index> sites(composition.site_indices.begin(),
+                             composition.site_indices.end());
+    std::vector<int> labels;
+    std::vector<std::string> names;
+    for (auto const &name_count : composition.occupant_counts) {
+      if (name_count.second < 0) {
+        throw std::runtime_error(
+            "Error in ConfigEnumRandomOccupations: negative occupant count");
+      }
+      if (name_count.second == 0) {
+        continue;
+      }
+      labels.insert(labels.end(), name_count.second, names.size());
+      names.push_back(name_count.first);
+    }
+    if (labels.size() != sites.size()) {
+      throw std::runtime_error(
+          "Error in ConfigEnumRandomOccupations: occupant counts do not sum "
+          "to the number of sites");
+    }
+
+    std::vector<std::vector<int>> occupant_index;
+    for (Index l : sites) {
+      if (l < 0 || l >= n_sites) {
+        throw std::runtime_error(
+            "Error in ConfigEnumRandomOccupations: invalid site index");
+      }
+      if (is_included[l]) {
+        throw std::runtime_error(
+            "Error in ConfigEnumRandomOccupations: site compositions "
+            "overlap");
+      }
+      is_included[l] = 1;
+
+      auto const &occupants = basis[converter(l).sublattice()].occupant_dof();
+      std::vector<int> site_occupant_index;
+      for (auto const &name : names) {
+        auto it = std::find_if(
+            occupants.begin(), occupants.end(),
+            [&](xtal::Molecule const &mol) { return mol.name() == name; });
+        if (it == occupants.end()) {
+          throw std::runtime_error(
+              "Error in ConfigEnumRandomOccupations: occupant \"" + name +
+              "\" is not allowed on site " + std::to_string(l));
+        }
+        site_occupant_index.push_back(it - occupants.begin());
+      }
+      occupant_index.push_back(std::move(site_occupant_index));
+    }
+
+    m_sites.push_back(std::move(sites));
+    m_labels.push_back(std::move(labels));
+    m_occupant_index.push_back(std::move(occupant_index));
+  }
+
+  if (OccCanonicalizer::is_supported(*supercell.prim)) {
+    m_canonicalizers.resize(m_n_threads);
+  }
+}
+
+ConfigEnumRandomOccupations::~ConfigEnumRandomOccupations() = default;
+
+/// \brief Return up to `max_size` new distinct configurations, in
+///     canonical form, drawing at most `max_attempts` candidates
+///
+/// Candidates are drawn and canonicalized in parallel rounds, of at least
+/// `min_round_size` candidates or the number of configurations still
+/// needed, and then checked in order. Once `max_size` configurations are
+/// found, the remaining candidates of the round are discarded and not
+/// counted as attempts, so the result does not depend on the round size.
+/// Fewer than `max_size` configurations are returned only if
+/// `max_attempts` candidates were drawn.
+std::vector<Configuration> ConfigEnumRandomOccupations::next_batch(
+    Index max_size, Index max_attempts) {
+  Index const min_round_size = 64;
+  std::vector<Configuration> batch;
+  Index end_attempt = m_n_attempts + max_attempts;
+  std::string const &supercell_name = m_background.supercell->name;
+  while (Index(batch.size()) < max_size && m_n_attempts < end_attempt) {
+    Index n =
+        std::min(std::max(max_size - Index(batch.size()), min_round_size),
+                 end_attempt - m_n_attempts);
+    Index first = m_n_attempts;
+    std::vector<Configuration> candidates(n, m_background);
+    std::vector<char> is_primitive_candidate(n, 1);
+    parallel_for_chunks(
+        n, m_n_threads, [&](Index c, Index begin, Index end) {
+          for (Index i = begin; i < end; ++i) {
+            candidates[i] = _make_canonical(make_candidate(first + i), c);
+            if (m_skip_non_primitive) {
+              is_primitive_candidate[i] = is_primitive(candidates[i]);
+            }
+          }
+        });
+
+    for (Index i = 0; i < n && Index(batch.size()) < max_size; ++i) {
+      ++m_n_attempts;
+      if (!is_primitive_candidate[i]) {
+        ++m_n_non_primitive;
+      } else if (!m_unique.insert(supercell_name, candidates[i]).second) {
+        ++m_n_duplicates;
+      } else {
+        batch.push_back(std::move(candidates[i]));
+      }
+    }
+  }
+  return batch;
+}
+
+/// \brief Make the candidate occupation with index `i`, before
+///     canonicalization
+Configuration ConfigEnumRandomOccupations::make_candidate(Index i) const {
+  std::mt19937_64 engine = make_candidate_engine(m_seed, i);
+  Configuration candidate = m_background;
+  Eigen::VectorXi &occupation = candidate.dof_values.occupation;
+  for (Index k = 0; k < m_sites.size(); ++k) {
+    std::vector<int> labels = m_labels[k];
+    // Fisher-Yates shuffle
+    for (Index j = Index(labels.size()) - 1; j > 0; --j) {
+      std::uniform_int_distribution<Index> dist(0, j);
+      std::swap(labels[j], labels[dist(engine)]);
+    }
+    for (Index j = 0; j < labels.size(); ++j) {
+      occupation(m_sites[k][j]) = m_occupant_index[k][j][labels[j]];
+    }
+  }
+  return candidate;
+}
+
+/// \brief Mark a configuration as already generated, return true if it
+///     was not already
+///
+/// \param configuration A configuration in the background supercell, in
+///     any form. The canonical form is inserted.
+bool ConfigEnumRandomOccupations::insert(Configuration const &configuration) {
+  if (*configuration.supercell != *m_background.supercell) {
+    throw std::runtime_error(
+        "Error in ConfigEnumRandomOccupations::insert: configuration is not "
+        "in the background supercell");
+  }
+  return m_unique
+      .insert(m_background.supercell->name, _make_canonical(configuration, 0))
+      .second;
+}
+
+/// \brief The number of candidates drawn
+Index ConfigEnumRandomOccupations::n_attempts() const { return m_n_attempts; }
+
+/// \brief Set the index of the next candidate drawn
+void ConfigEnumRandomOccupations::set_n_attempts(Index n_attempts) {
+  m_n_attempts = n_attempts;
+}
+
+/// \brief The number of candidates rejected because they were equivalent
+///     to a configuration already generated
+Index ConfigEnumRandomOccupations::n_duplicates() const {
+  return m_n_duplicates;
+}
+
+/// \brief The number of candidates rejected because they were not
+///     primitive
+Index ConfigEnumRandomOccupations::n_non_primitive() const {
+  return m_n_non_primitive;
+}
+
+/// \brief The number of distinct configurations generated or inserted
+Index ConfigEnumRandomOccupations::n_unique() const { return m_unique.size(); }
+
+/// \brief The distinct configurations generated or inserted, in canonical
+///     form
+UnorderedConfigurationSet const &
+ConfigEnumRandomOccupations::unique_configurations() const {
+  return m_unique;
+}
+
+/// \brief Make the canonical form of a candidate, using canonicalizer `c`
+Configuration ConfigEnumRandomOccupations::_make_canonical(
+    Configuration const &candidate, Index c) {
+  if (m_canonicalizers.empty()) {
+    auto const &supercell = candidate.supercell;
+    return make_canonical_form(candidate, SupercellSymOp::begin(supercell),
+                               SupercellSymOp::end(supercell));
+  }
+  if (!m_canonicalizers[c]) {
+    m_canonicalizers[c] =
+        std::make_unique<OccCanonicalizer>(m_background.supercell);
+  }
+  return m_canonicalizers[c]->make_canonical_form(candidate);
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,496 @@
+#include "casm/configuration/enumeration/ConfigEnumSubWedgeSampling.hh"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace CASM {
+namespace config {
+
+namespace {  // anonymous
+
+/// Primitive polynomial and initial direction numbers, for one dimension
+struct SobolParameters {
+  /// Degree of the primitive polynomial
+  int s;
+
+  /// Coefficients of the primitive polynomial, excluding the leading and
+  /// constant terms, as bits
+  std::uint32_t a;
+
+  /// Initial direction numbers, `m[k]` odd and less than `2^(k+1)`
+  std::vector<std::uint32_t> m;
+};
+
+/// Parameters for dimensions 2, 3, ..., following Joe and Kuo
+std::vector<SobolParameters> const &sobol_parameters() {
+  static std::vector<SobolParameters> const parameters = {
+      {1, 0, {1}},
+      {2, 1, {1, 3}},
+      {3, 1, {1, 3, 1}},
+      {3, 2, {1, 1, 1}},
+      {4, 1, {1, 1, 3, 3}},
+      {4, 4, {1, 3, 5, 13}},
+      {5, 2, {1, 1, 5, 5, 17}},
+      {5, 4, {1, 1, 5, 5, 5}},
+      {5, 7, {1, 1, 7, 11, 19}},
+      {5, 11, {1, 1, 5, 1, 1}},
+      {5, 13, {1, 1, 1, 3, 11}},
+      {5, 14, {1, 3, 5, 5, 31}},
+      {6, 1, {1, 3, 3, 9, 7, 49}},
+      {6, 13, {1, 1, 1, 15, 21, 21}},
+      {6, 16, {1, 3, 1, 13, 27, 49}},
+      {6, 19, {1, 1, 1, 15, 7, 5}},
+      {6, 22, {1, 3, 1, 15, 13, 25}},
+      {6, 25, {1, 1, 5, 5, 19, 61}},
+      {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+      {7, 4, {1, 3, 7, 13, 13, 15, 69}}};
+  return parameters;
+}
+
+/// \brief Return the DoF values for `dof_key`, flattened
+Eigen::Map<Eigen::VectorXd> _flat_dof_values(Configuration &configuration,
+                                             std::string const &dof_key,
+                                             bool is_global) {
+  if (is_global) {
+    Eigen::VectorXd &x = configuration.dof_values.global_dof_values.at(dof_key);
+    return Eigen::Map<Eigen::VectorXd>(x.data(), x.size());
+  }
+  Eigen::MatrixXd &x = configuration.dof_values.local_dof_values.at(dof_key);
+  return Eigen::Map<Eigen::VectorXd>(x.data(), x.size());
+}
+
+/// Maximum number of points drawn per point requested, when points may be
+/// rejected
+Index const max_draws_per_point = 1000;
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _dim Dimension, in the range [0, max_dim()]
+SobolSequence::SobolSequence(Index _dim)
+    : m_directions(_dim, std::vector<std::uint32_t>(32)),
+      m_x(_dim, 0),
+      m_index(0) {
+  if (_dim < 0 || _dim > max_dim()) {
+    throw std::runtime_error(
+        "Error in SobolSequence: dimension must be in the range [0, " +
+        std::to_string(max_dim()) + "]");
+  }
+  for (Index j = 0; j < _dim; ++j) {
+    auto &v = m_directions[j];
+    if (j == 0) {
+      for (int k = 0; k < 32; ++k) {
+        v[k] = std::uint32_t(1) << (31 - k);
+      }
+      continue;
+    }
+    auto const &p = sobol_parameters()[j - 1];
+    for (int k = 0; k < 32; ++k) {
+      if (k < p.s) {
+        v[k] = p.m[k] << (31 - k);
+        continue;
+      }
+      v[k] = v[k - p.s] ^ (v[k - p.s] >> p.s);
+      for (int i = 1; i < p.s; ++i) {
+        if ((p.a >> (p.s - 1 - i)) & 1) {
+          v[k] ^= v[k - i];
+        }
+      }
+    }
+  }
+}
+
+/// \brief Maximum supported dimension
+Index SobolSequence::max_dim() { return sobol_parameters().size() + 1; }
+
+/// \brief Return the next point
+///
+/// Coordinates are in [0, 1). Points are generated in Gray code order, so
+/// each costs one XOR per dimension. At most 2^32 - 1 points can be
+/// generated.
+Eigen::VectorXd SobolSequence::next() {
+  // index of the lowest zero bit of m_index
+  int c = 0;
+  for (std::uint64_t i = m_index; i & 1; i >>= 1) {
+    ++c;
+  }
+  if (c >= 32) {
+    throw std::runtime_error(
+        "Error in SobolSequence::next: maximum number of points exceeded");
+  }
+  ++m_index;
+  Eigen::VectorXd u(m_x.size());
+  for (Index j = 0; j < m_x.size(); ++j) {
+    m_x[j] ^= m_directions[j][c];
+    u(j) = m_x[j] / 4294967296.0;
+  }
+  return u;
+}
+
+/// \brief Constructor, sample points in each SubWedge of an irreducible
+///     wedge
+///
+/// \param background The background configuration on which enumeration
+///     takes place.
+/// \param dof_space Specifies the DoF being enumerated. For local DoF, the
+///     dof_space supercell must tile the background supercell.
+/// \param irreducible_wedge The irreducible wedge, from a
+///     VectorSpaceSymReport calculated using `dof_space_analysis` of
+///     `background`.
+/// \param stop The maximum SubWedge coordinate along each SubWedge axis.
+///     The minimum is 0.0, unless the axis has symmetric multiplicity of 1,
+///     in which case it is `-stop`. Must be positive.
+/// \param n_points Number of points to sample in each SubWedge. Must be
+///     positive.
+/// \param method Sampling method
+/// \param trim_corners If true, reject points that lie outside the
+///     ellipsoid inscribed within the extrema of the coordinate ranges.
+/// \param seed Seed for the random number engine, used by the
+///     `latin_hypercube` and `uniform` methods
+/// \param abs_tol Tolerance used to trim corners
+ConfigEnumSubWedgeSampling::ConfigEnumSubWedgeSampling(
+    Configuration const &background, clexulator::DoFSpace const &dof_space,
+    std::vector<irreps::SubWedge> const &irreducible_wedge, double stop,
+    Index n_points, SubWedgeSamplingMethod method, bool trim_corners,
+    std::uint64_t seed, double abs_tol)
+    : m_current(background),
+      m_method(method),
+      m_trim_corners(trim_corners),
+      m_stop(stop),
+      m_abs_tol(abs_tol),
+      m_engine(seed),
+      m_region_index(0),
+      m_sobol(0),
+      m_n_drawn(0),
+      m_n_accepted(0),
+      m_is_valid(false) {
+  if (n_points < 1) {
+    throw std::runtime_error(
+        "Error in ConfigEnumSubWedgeSampling: n_points must be positive");
+  }
+  _init(dof_space, irreducible_wedge, stop);
+  for (Index i = 0; i < irreducible_wedge.size(); ++i) {
+    m_regions.push_back({i, m_lower[i], m_upper[i], n_points});
+  }
+  _begin_region();
+  if (m_is_valid) {
+    _set_dof_values(m_current, m_order_parameters);
+  }
+}
+
+/// \brief Constructor, sample points around previously sampled points
+///
+/// For adaptive refinement: each center is converted to SubWedge
+/// coordinates, and points are sampled in the box of SubWedge coordinates
+/// within `half_width` of the center, clipped to the coordinate ranges of
+/// the SubWedge. Choosing the centers (for example, points with large model
+/// uncertainty) and the number of points for each (for example,
+/// proportional to an importance weight) is left to the caller.
+///
+/// \param background, dof_space, irreducible_wedge, stop, method,
+///     trim_corners, seed, abs_tol As for the other constructor
+/// \param centers DoFSpace coordinates of the centers, as columns, for
+///     example the `order_parameters` of previously sampled points
+/// \param center_subwedge_indices The SubWedge index of each center, for
+///     example the `subwedge_index` of previously sampled points
+/// \param half_width Half the width, along each SubWedge axis, of the box
+///     sampled around each center. Must be positive.
+/// \param n_points Number of points to sample around each center
+ConfigEnumSubWedgeSampling::ConfigEnumSubWedgeSampling(
+    Configuration const &background, clexulator::DoFSpace const &dof_space,
+    std::vector<irreps::SubWedge> const &irreducible_wedge, double stop,
+    Eigen::MatrixXd const &centers,
+    std::vector<Index> const &center_subwedge_indices, double half_width,
+    std::vector<Index> const &n_points, SubWedgeSamplingMethod method,
+    bool trim_corners, std::uint64_t seed, double abs_tol)
+    : m_current(background),
+      m_method(method),
+      m_trim_corners(trim_corners),
+      m_stop(stop),
+      m_abs_tol(abs_tol),
+      m_engine(seed),
+      m_region_index(0),
+      m_sobol(0),
+      m_n_drawn(0),
+      m_n_accepted(0),
+      m_is_valid(false) {
+  if (half_width <= 0.0) {
+    throw std::runtime_error(
+        "Error in ConfigEnumSubWedgeSampling: half_width must be positive");
+  }
+  if (center_subwedge_indices.size() != centers.cols() ||
+      n_points.size() != centers.cols()) {
+    throw std::runtime_error(
+        "Error in ConfigEnumSubWedgeSampling: centers, "
+        "center_subwedge_indices, and n_points sizes do not match");
+  }
+  _init(dof_space, irreducible_wedge, stop);
+  if (centers.cols() && centers.rows() != m_linear.cols()) {
+    throw std::runtime_error(
+        "Error in ConfigEnumSubWedgeSampling: centers and dof_space "
+        "dimensions do not match");
+  }
+  for (Index c = 0; c < centers.cols(); ++c) {
+    Index i = center_subwedge_indices[c];
+    if (i < 0 || i >= irreducible_wedge.size()) {
+      throw std::runtime_error(
+          "Error in ConfigEnumSubWedgeSampling: center SubWedge index out of "
+          "range");
+    }
+    if (n_points[c] < 1) {
+      continue;
+    }
+    Eigen::VectorXd x =
+        m_trans_mat[i].completeOrthogonalDecomposition().solve(centers.col(c));
+    Eigen::VectorXd half = Eigen::VectorXd::Constant(x.size(), half_width);
+    m_regions.push_back({i, (x - half).cwiseMax(m_lower[i]),
+                         (x + half).cwiseMin(m_upper[i]), n_points[c]});
+  }
+  _begin_region();
+  if (m_is_valid) {
+    _set_dof_values(m_current, m_order_parameters);
+  }
+}
+
+/// \brief Get the current Configuration
+Configuration const &ConfigEnumSubWedgeSampling::value() const {
+  return m_current;
+}
+
+/// \brief Get the DoFSpace coordinates of the current Configuration
+Eigen::VectorXd const &ConfigEnumSubWedgeSampling::order_parameters() const {
+  return m_order_parameters;
+}
+
+/// \brief Get the index of the SubWedge of the current Configuration
+///
+/// Returns -1 if `is_valid()` is false.
+Index ConfigEnumSubWedgeSampling::subwedge_index() const {
+  if (!m_is_valid) {
+    return -1;
+  }
+  return m_regions[m_region_index].subwedge_index;
+}
+
+/// \brief Generate the next Configuration
+void ConfigEnumSubWedgeSampling::advance() {
+  _advance_point();
+  if (m_is_valid) {
+    _set_dof_values(m_current, m_order_parameters);
+  }
+}
+
+/// \brief Return true if `value` is valid, false if no more valid values
+bool ConfigEnumSubWedgeSampling::is_valid() const { return m_is_valid; }
+
+/// \brief Return up to `max_size` Configuration, starting with the current
+///     value, and advance past them
+///
+/// \param max_size The maximum number of configurations to return. Fewer
+///     are returned only if the enumeration is complete.
+///
+/// \returns Copies of the configurations
+std::vector<Configuration> ConfigEnumSubWedgeSampling::next_batch(
+    Index max_size) {
+  Eigen::MatrixXd order_parameters;
+  std::vector<Index> subwedge_indices;
+  return next_batch(max_size, order_parameters, subwedge_indices);
+}
+
+/// \brief Return up to `max_size` Configuration, starting with the current
+///     value, and advance past them, with their DoFSpace coordinates and
+///     SubWedge indices
+///
+/// The DoF values of all configurations in the batch are found with one
+/// matrix-matrix product.
+///
+/// \param max_size The maximum number of configurations to return. Fewer
+///     are returned only if the enumeration is complete.
+/// \param order_parameters Set to the DoFSpace coordinates of the
+///     configurations, as columns
+/// \param subwedge_indices Set to the SubWedge index of the configurations
+///
+/// \returns Copies of the configurations
+std::vector<Configuration> ConfigEnumSubWedgeSampling::next_batch(
+    Index max_size, Eigen::MatrixXd &order_parameters,
+    std::vector<Index> &subwedge_indices) {
+  std::vector<Eigen::VectorXd> points;
+  subwedge_indices.clear();
+  while (m_is_valid && points.size() < max_size) {
+    points.push_back(m_order_parameters);
+    subwedge_indices.push_back(subwedge_index());
+    _advance_point();
+  }
+
+  order_parameters.resize(m_linear.cols(), points.size());
+  for (Index i = 0; i < points.size(); ++i) {
+    order_parameters.col(i) = points[i];
+  }
+  Eigen::MatrixXd values = m_linear * order_parameters;
+  values.colwise() += m_offset;
+
+  std::vector<Configuration> batch(points.size(), m_current);
+  for (Index i = 0; i < batch.size(); ++i) {
+    _flat_dof_values(batch[i], m_dof_key, m_is_global) = values.col(i);
+  }
+  if (m_is_valid) {
+    _set_dof_values(m_current, m_order_parameters);
+  }
+  return batch;
+}
+
+/// \brief The regions sampled, in order
+std::vector<SubWedgeSamplingRegion> const &
+ConfigEnumSubWedgeSampling::regions() const {
+  return m_regions;
+}
+
+/// \brief Shared constructor implementation
+///
+/// Finds the affine map from DoFSpace coordinates to DoF values, as
+/// ConfigEnumMeshGrid does, and the SubWedge coordinate ranges.
+void ConfigEnumSubWedgeSampling::_init(
+    clexulator::DoFSpace const &dof_space,
+    std::vector<irreps::SubWedge> const &irreducible_wedge, double stop) {
+  if (dof_space.dof_key == "occ") {
+    throw std::runtime_error(
+        "Error in ConfigEnumSubWedgeSampling: dof_space.dof_key == \"occ\" is "
+        "not supported");
+  }
+  if (stop <= 0.0) {
+    throw std::runtime_error(
+        "Error in ConfigEnumSubWedgeSampling: stop must be positive");
+  }
+  m_dof_key = dof_space.dof_key;
+  m_is_global = dof_space.is_global;
+
+  Index dim = dof_space.basis.cols();
+  Configuration tmp = m_current;
+  set_dof_space_values(tmp, dof_space, Eigen::VectorXd::Zero(dim));
+  m_offset = _flat_dof_values(tmp, m_dof_key, m_is_global);
+  m_linear.resize(m_offset.size(), dim);
+  for (Index i = 0; i < dim; ++i) {
+    tmp = m_current;
+    set_dof_space_values(tmp, dof_space, Eigen::VectorXd::Unit(dim, i));
+    m_linear.col(i) = _flat_dof_values(tmp, m_dof_key, m_is_global) - m_offset;
+  }
+
+  for (auto const &subwedge : irreducible_wedge) {
+    if (subwedge.trans_mat.rows() != dof_space.basis.rows()) {
+      throw std::runtime_error(
+          "Error in ConfigEnumSubWedgeSampling: SubWedge and dof_space "
+          "dimensions do not match");
+    }
+    std::vector<double> lower;
+    std::vector<double> upper;
+    for (auto const &irrep_wedge : subwedge.irrep_wedges) {
+      for (Index m : irrep_wedge.mult) {
+        // For axes with multiplicity==1, include both positive and negative
+        // coordinates; otherwise, only include positive
+        lower.push_back(m == 1 ? -stop : 0.0);
+        upper.push_back(stop);
+      }
+    }
+    if (m_method == SubWedgeSamplingMethod::sobol &&
+        lower.size() > SobolSequence::max_dim()) {
+      throw std::runtime_error(
+          "Error in ConfigEnumSubWedgeSampling: SubWedge dimension exceeds "
+          "the maximum supported by the sobol method (" +
+          std::to_string(SobolSequence::max_dim()) +
+          "); use latin_hypercube or uniform");
+    }
+    m_lower.push_back(Eigen::Map<Eigen::VectorXd>(lower.data(), lower.size()));
+    m_upper.push_back(Eigen::Map<Eigen::VectorXd>(upper.data(), upper.size()));
+    m_trans_mat.push_back(dof_space.basis_inv * subwedge.trans_mat);
+  }
+}
+
+/// \brief Begin the region `m_region_index`, or later regions if no point
+///     is accepted
+///
+/// Sets m_is_valid, and if valid m_order_parameters, for the first
+/// accepted point.
+void ConfigEnumSubWedgeSampling::_begin_region() {
+  for (; m_region_index < m_regions.size(); ++m_region_index) {
+    auto const &region = m_regions[m_region_index];
+    Index dim = region.lower.size();
+    m_n_drawn = 0;
+    m_n_accepted = 0;
+    if (m_method == SubWedgeSamplingMethod::sobol) {
+      m_sobol = SobolSequence(dim);
+    } else if (m_method == SubWedgeSamplingMethod::latin_hypercube) {
+      m_strata.assign(dim, std::vector<Index>(region.n_points));
+      for (auto &strata : m_strata) {
+        std::iota(strata.begin(), strata.end(), 0);
+        std::shuffle(strata.begin(), strata.end(), m_engine);
+      }
+    }
+    if (_next_point_in_region()) {
+      m_is_valid = true;
+      return;
+    }
+  }
+  m_is_valid = false;
+}
+
+/// \brief Advance to the next accepted point, or the end
+void ConfigEnumSubWedgeSampling::_advance_point() {
+  if (!m_is_valid) {
+    return;
+  }
+  if (_next_point_in_region()) {
+    return;
+  }
+  ++m_region_index;
+  _begin_region();
+}
+
+/// \brief Draw points in the current region until one is accepted, and set
+///     m_order_parameters, or return false if the region is done
+bool ConfigEnumSubWedgeSampling::_next_point_in_region() {
+  auto const &region = m_regions[m_region_index];
+  Index dim = region.lower.size();
+  Index max_draws = m_method == SubWedgeSamplingMethod::latin_hypercube
+                        ? region.n_points
+                        : max_draws_per_point * region.n_points;
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  while (m_n_accepted < region.n_points && m_n_drawn < max_draws) {
+    Eigen::VectorXd u(dim);
+    if (m_method == SubWedgeSamplingMethod::sobol) {
+      u = m_sobol.next();
+    } else if (m_method == SubWedgeSamplingMethod::latin_hypercube) {
+      for (Index j = 0; j < dim; ++j) {
+        u(j) = (m_strata[j][m_n_drawn] + uniform(m_engine)) / region.n_points;
+      }
+    } else {
+      for (Index j = 0; j < dim; ++j) {
+        u(j) = uniform(m_engine);
+      }
+    }
+    ++m_n_drawn;
+
+    Eigen::VectorXd x =
+        region.lower + (region.upper - region.lower).cwiseProduct(u);
+    if (m_trim_corners &&
+        x.squaredNorm() / (m_stop * m_stop) > 1.0 + m_abs_tol) {
+      continue;
+    }
+    ++m_n_accepted;
+    m_order_parameters = m_trans_mat[region.subwedge_index] * x;
+    return true;
+  }
+  return false;
+}
+
+/// \brief Set the DoF values of `configuration` from DoFSpace coordinates
+void ConfigEnumSubWedgeSampling::_set_dof_values(
+    Configuration &configuration,
+    Eigen::VectorXd const &order_parameters) const {
+  _flat_dof_values(configuration, m_dof_key, m_is_global) =
+      m_offset + m_linear * order_parameters;
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -1,12 +1,41 @@
 #include "casm/configuration/enumeration/ConfigurationFilter.hh"
 
+#include <stdexcept>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
 #include "casm/configuration/SupercellSymOp.hh"
 #include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/clusterography/orbits.hh"
 #include "casm/configuration/copy_configuration.hh"
+#include "casm/crystallography/BasicStructure.hh"
 
 namespace CASM {
 namespace config {
 
+namespace {
+
+/// \brief Return the index of an occupant on each sublattice, or -1 if
+///     the sublattice does not allow the occupant
+std::vector<int> make_occupant_index(Supercell const &supercell,
+                                     std::string const &occupant_name) {
+  auto const &basis = supercell.prim->basicstructure->basis();
+  std::vector<int> occupant_index(basis.size(), -1);
+  for (Index b = 0; b < basis.size(); ++b) {
+    auto const &occupants = basis[b].occupant_dof();
+    for (Index i = 0; i < occupants.size(); ++i) {
+      if (occupants[i].name() == occupant_name) {
+        occupant_index[b] = i;
+        break;
+      }
+    }
+  }
+  return occupant_index;
+}
+
+}  // namespace
+
 bool UniqueConfigurationFilter::operator()(
     Configuration const &configuration) const {
   if (!is_primitive(configuration)) {
@@ -33,5 +62,221 @@ bool GenericConfigurationFilter::operator()(
   return f(configuration);
 }
 
+bool SupercellVolumeFilter::operator()(
+    Configuration const &configuration) const {
+  Index volume =
+      configuration.supercell->unitcell_index_converter.total_sites();
+  return volume >= min_volume && volume <= max_volume;
+}
+
+bool SublatticeCompositionFilter::operator()(
+    Configuration const &configuration) const {
+  auto const &supercell = *configuration.supercell;
+  auto const &converter = supercell.unitcellcoord_index_converter;
+  std::vector<int> occupant_index =
+      make_occupant_index(supercell, occupant_name);
+  Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+
+  Index n_sites = 0;
+  Index count = 0;
+  for (Index l = 0; l < occupation.size(); ++l) {
+    Index b = converter(l).sublattice();
+    if (!sublattice_indices.empty() && !sublattice_indices.count(b)) {
+      continue;
+    }
+    ++n_sites;
+    if (occupation(l) == occupant_index[b]) {
+      ++count;
+    }
+  }
+  if (n_sites == 0) {
+    throw std::runtime_error(
+        "Error in SublatticeCompositionFilter: no sites on the selected "
+        "sublattices");
+  }
+  double fraction = static_cast<double>(count) / n_sites;
+  return fraction >= min_fraction - TOL && fraction <= max_fraction + TOL;
+}
+
+/// \brief Constructor
+///
+/// \param _supercell The supercell of the site indices of `_constraints`
+/// \param _constraints Bounds on the number of sites with a particular
+///     occupant, as used by ConfigEnumCanonicalOccupations
+///
+/// \throws If a constraint site index is out of range
+OccupantCountFilter::OccupantCountFilter(
+    std::shared_ptr<Supercell const> const &_supercell,
+    std::vector<OccupantCountConstraint> const &_constraints)
+    : m_supercell(_supercell),
+      m_constraints(_constraints),
+      m_counted(_constraints.size()) {
+  auto const &converter = m_supercell->unitcellcoord_index_converter;
+  std::vector<std::vector<int>> occupant_index;
+  for (auto const &constraint : m_constraints) {
+    occupant_index.push_back(
+        make_occupant_index(*m_supercell, constraint.occupant_name));
+  }
+  Index n_sites = converter.total_sites();
+  for (Index c = 0; c < m_constraints.size(); ++c) {
+    for (Index site_index : m_constraints[c].site_indices) {
+      if (site_index < 0 || site_index >= n_sites) {
+        throw std::runtime_error(
+            "Error constructing OccupantCountFilter: constraint site index "
+            "out of range");
+      }
+      int i = occupant_index[c][converter(site_index).sublattice()];
+      if (i != -1) {
+        m_counted[c].emplace_back(site_index, i);
+      }
+    }
+  }
+}
+
+bool OccupantCountFilter::operator()(
+    Configuration const &configuration) const {
+  if (*configuration.supercell != *m_supercell) {
+    throw std::runtime_error(
+        "Error in OccupantCountFilter: configuration is not in the "
+        "constraint supercell");
+  }
+  Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+  for (Index c = 0; c < m_constraints.size(); ++c) {
+    Index count = 0;
+    for (auto const &site_occupant : m_counted[c]) {
+      if (occupation(site_occupant.first) == site_occupant.second) {
+        ++count;
+      }
+    }
+    if (count < m_constraints[c].min_count ||
+        count > m_constraints[c].max_count) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief The supercell of the constraint site indices
+std::shared_ptr<Supercell const> const &OccupantCountFilter::supercell()
+    const {
+  return m_supercell;
+}
+
+/// \brief The constraints
+std::vector<OccupantCountConstraint> const &
+OccupantCountFilter::constraints() const {
+  return m_constraints;
+}
+
+/// \brief Constructor
+///
+/// \param _orbit A prim periodic orbit of clusters, as generated by
+///     `make_prim_periodic_orbit`
+/// \param _occupant_name Name of the occupant, as given by
+///     `xtal::Molecule::name()`, that must occupy every site of a cluster
+///     for it to count
+/// \param _min_per_unitcell Minimum allowed number of clusters per unit
+///     cell
+/// \param _max_per_unitcell Maximum allowed number of clusters per unit
+///     cell
+ClusterCountFilter::ClusterCountFilter(
+    std::set<clust::IntegralCluster> const &_orbit,
+    std::string const &_occupant_name, double _min_per_unitcell,
+    double _max_per_unitcell)
+    : m_orbit(_orbit),
+      m_occupant_name(_occupant_name),
+      m_min_per_unitcell(_min_per_unitcell),
+      m_max_per_unitcell(_max_per_unitcell),
+      m_cache(std::make_shared<Cache>()) {}
+
+bool ClusterCountFilter::operator()(
+    Configuration const &configuration) const {
+  auto const &supercell = configuration.supercell;
+  std::shared_ptr<ClusterSites const> cluster_sites =
+      _cluster_sites(supercell);
+  Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+  Index count = 0;
+  for (auto const &cluster : *cluster_sites) {
+    bool all_occupied = true;
+    for (auto const &site_occupant : cluster) {
+      if (occupation(site_occupant.first) != site_occupant.second) {
+        all_occupied = false;
+        break;
+      }
+    }
+    if (all_occupied) {
+      ++count;
+    }
+  }
+  double per_unitcell = static_cast<double>(count) /
+                        supercell->unitcell_index_converter.total_sites();
+  return per_unitcell >= m_min_per_unitcell - TOL &&
+         per_unitcell <= m_max_per_unitcell + TOL;
+}
+
+/// \brief The prim periodic orbit of clusters counted
+std::set<clust::IntegralCluster> const &ClusterCountFilter::orbit() const {
+  return m_orbit;
+}
+
+/// \brief Name of the occupant
+std::string const &ClusterCountFilter::occupant_name() const {
+  return m_occupant_name;
+}
+
+/// \brief Minimum allowed number of clusters per unit cell
+double ClusterCountFilter::min_per_unitcell() const {
+  return m_min_per_unitcell;
+}
+
+/// \brief Maximum allowed number of clusters per unit cell
+double ClusterCountFilter::max_per_unitcell() const {
+  return m_max_per_unitcell;
+}
+
+/// \brief Return the clusters that can count in a supercell, constructing
+///     them if necessary
+std::shared_ptr<ClusterCountFilter::ClusterSites const>
+ClusterCountFilter::_cluster_sites(
+    std::shared_ptr<Supercell const> const &supercell) const {
+  std::lock_guard<std::mutex> lock(m_cache->mutex);
+  auto it = m_cache->cluster_sites.find(supercell);
+  if (it != m_cache->cluster_sites.end()) {
+    return it->second;
+  }
+
+  // all translations of the orbit within the supercell
+  auto const &unitcell_index_converter = supercell->unitcell_index_converter;
+  std::vector<std::set<clust::IntegralCluster>> translated_orbit(1);
+  for (Index n = 0; n < unitcell_index_converter.total_sites(); ++n) {
+    xtal::UnitCell translation = unitcell_index_converter(n);
+    for (auto cluster : m_orbit) {
+      cluster += translation;
+      translated_orbit[0].insert(cluster);
+    }
+  }
+
+  auto const &converter = supercell->unitcellcoord_index_converter;
+  std::vector<int> occupant_index =
+      make_occupant_index(*supercell, m_occupant_name);
+  auto cluster_sites = std::make_shared<ClusterSites>();
+  for (auto const &sites :
+       clust::make_orbits_as_indices(translated_orbit, converter)[0]) {
+    std::vector<std::pair<Index, int>> cluster;
+    for (Index l : sites) {
+      int i = occupant_index[converter(l).sublattice()];
+      if (i == -1) {
+        break;
+      }
+      cluster.emplace_back(l, i);
+    }
+    if (cluster.size() == sites.size()) {
+      cluster_sites->push_back(std::move(cluster));
+    }
+  }
+  m_cache->cluster_sites.emplace(supercell, cluster_sites);
+  return cluster_sites;
+}
+
 }  // namespace config
 }  // namespace CASM
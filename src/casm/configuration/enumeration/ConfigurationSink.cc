@@ -0,0 +1,135 @@
+#include "casm/configuration/enumeration/ConfigurationSink.hh"
+
+#include <stdexcept>
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/io/binary/ConfigurationSet_binary_io.hh"
+#include "casm/configuration/io/json/ConfigurationSet_jsonl_io.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {  // anonymous
+
+/// \brief Return the next automatic configuration_id for a supercell, and
+///     increment it
+std::string next_configuration_id(
+    std::map<std::string, Index> &next_config_id,
+    std::string const &supercell_name) {
+  Index &id = next_config_id.emplace(supercell_name, 0).first->second;
+  return std::to_string(id++);
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _configurations The ConfigurationSet configurations are inserted
+///     into
+ConfigurationSetSink::ConfigurationSetSink(ConfigurationSet &_configurations)
+    : m_configurations(_configurations), m_n_inserted(0) {}
+
+void ConfigurationSetSink::insert(std::vector<Configuration> &configurations) {
+  for (auto const &configuration : configurations) {
+    if (m_configurations.insert(configuration).second) {
+      ++m_n_inserted;
+    }
+  }
+}
+
+/// \brief Constructor
+///
+/// \param path The file to write. Existing contents are replaced.
+/// \param write_prim_basis If true, write DoF values using the prim basis.
+///     Default (false) is to write DoF values in the standard basis.
+/// \param _next_config_id IDs, by supercell_name, of the first configuration
+///     written in each supercell. Supercells not included start at 0.
+JsonLinesConfigurationSink::JsonLinesConfigurationSink(
+    fs::path const &path, bool write_prim_basis,
+    std::map<std::string, Index> _next_config_id)
+    : m_out(path), m_next_config_id(std::move(_next_config_id)) {
+  if (!m_out) {
+    throw std::runtime_error(
+        "Error in JsonLinesConfigurationSink: could not open '" +
+        path.string() + "'");
+  }
+  m_writer =
+      std::make_unique<ConfigurationJsonLinesWriter>(m_out, write_prim_basis);
+}
+
+JsonLinesConfigurationSink::~JsonLinesConfigurationSink() {}
+
+void JsonLinesConfigurationSink::insert(
+    std::vector<Configuration> &configurations) {
+  for (auto const &configuration : configurations) {
+    std::string const &supercell_name = configuration.supercell->name;
+    m_writer->write(supercell_name,
+                    next_configuration_id(m_next_config_id, supercell_name),
+                    configuration);
+  }
+}
+
+void JsonLinesConfigurationSink::finish() {
+  m_out.close();
+  if (!m_out) {
+    throw std::runtime_error(
+        "Error in JsonLinesConfigurationSink::finish: write failed");
+  }
+}
+
+Index JsonLinesConfigurationSink::size() const {
+  return m_writer->n_written();
+}
+
+/// \brief Constructor
+///
+/// \param path The file to write. It is written by `finish`.
+/// \param compress If true, compress each block with zlib
+/// \param chunk_size Number of configurations per chunk block
+/// \param _next_config_id IDs, by supercell_name, of the first configuration
+///     written in each supercell. Supercells not included start at 0.
+BinaryConfigurationSink::BinaryConfigurationSink(
+    fs::path const &path, bool compress, Index chunk_size,
+    std::map<std::string, Index> _next_config_id)
+    : m_writer(std::make_unique<ConfigurationSetBinaryWriter>(path, compress,
+                                                              chunk_size)),
+      m_next_config_id(std::move(_next_config_id)) {}
+
+BinaryConfigurationSink::~BinaryConfigurationSink() {}
+
+void BinaryConfigurationSink::insert(
+    std::vector<Configuration> &configurations) {
+  for (auto const &configuration : configurations) {
+    std::string const &supercell_name = configuration.supercell->name;
+    m_writer->write(supercell_name,
+                    next_configuration_id(m_next_config_id, supercell_name),
+                    configuration);
+  }
+}
+
+void BinaryConfigurationSink::finish() { m_writer->finish(m_next_config_id); }
+
+Index BinaryConfigurationSink::size() const { return m_writer->size(); }
+
+/// \brief Run an enumeration pipeline, passing accepted configurations to a
+///     ConfigurationSink, and finish the sink
+///
+/// Equivalent to `run_enumeration_pipeline(source, transform, filter,
+/// batch_sink, options)`, with `batch_sink` calling `sink.insert`, followed
+/// by `sink.finish()`. The sink is only called from the calling thread.
+EnumerationPipelineStats run_enumeration_pipeline(
+    EnumerationSource const &source, ConfigurationTransform const &transform,
+    ConfigurationPredicate const &filter, ConfigurationSink &sink,
+    EnumerationPipelineOptions const &options) {
+  EnumerationPipelineStats stats = run_enumeration_pipeline(
+      source, transform, filter,
+      [&](std::vector<Configuration> &configurations) {
+        sink.insert(configurations);
+      },
+      options);
+  sink.finish();
+  return stats;
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,379 @@
+#include "casm/configuration/enumeration/EnumerationPipeline.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/enumeration/BoundedQueue.hh"
+#include "casm/configuration/enumeration/ConfigEnumAllOccupations.hh"
+#include "casm/configuration/enumeration/ConfigEnumCanonicalOccupations.hh"
+#include "casm/configuration/enumeration/ConfigurationFilter.hh"
+#include "casm/configuration/parallel.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {  // anonymous
+
+/// \brief Configurations passed between stages, numbered in enumeration
+///     order
+struct PipelineBatch {
+  Index index = 0;
+  std::vector<Configuration> configurations;
+};
+
+typedef BoundedQueue<PipelineBatch> PipelineQueue;
+
+/// \brief A stage between the source and the sink
+struct PipelineStage {
+  /// Process one batch, in place
+  std::function<void(std::vector<Configuration> &)> f;
+
+  Index n_threads;
+};
+
+/// \brief State shared by the threads of one pipeline
+struct PipelineState {
+  /// queues[i] is the input of stage i, queues.back() is the sink input
+  std::vector<std::unique_ptr<PipelineQueue>> queues;
+
+  std::mutex mutex;
+
+  /// First exception thrown by any stage
+  std::exception_ptr error;
+
+  /// Notified when batches are passed to the sink, or on error
+  std::condition_variable progress;
+
+  /// Number of batches passed to the sink
+  Index n_sunk = 0;
+
+  bool stopped = false;
+
+  /// \brief Save the first error and stop all stages
+  void fail(std::exception_ptr e) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!error) {
+        error = e;
+      }
+      stopped = true;
+    }
+    progress.notify_all();
+    for (auto &queue : queues) {
+      queue->close();
+      queue->clear();
+    }
+  }
+};
+
+}  // namespace
+
+/// \brief Run enumerate -> transform -> filter -> sink stages concurrently,
+///     with bounded queues between stages
+///
+/// \param source Returns batches of configurations, in enumeration order,
+///     and an empty batch when complete. Called on one dedicated thread.
+/// \param transform If not empty, applied to every configuration (for
+///     example, `make_canonical_form_transform()`). Called concurrently by
+///     `options.n_transform_threads` dedicated threads.
+/// \param filter If not empty, configurations for which it returns false
+///     are not passed to the sink. Called concurrently by
+///     `options.n_filter_threads` dedicated threads, after `transform`.
+/// \param sink If not empty, receives the accepted configurations of each
+///     batch. Always called on the calling thread, one batch at a time, in
+///     enumeration order.
+/// \param options Batch size, queue capacity, and number of threads for each
+///     stage.
+///
+/// \returns Counts of configurations enumerated and accepted
+///
+/// Each stage runs on its own threads and passes batches to the next through
+/// a BoundedQueue with capacity `options.queue_capacity`, so the sink (for
+/// example, inserting into a ConfigurationSet and writing) runs at the same
+/// time as the transform and filter stages (for example, making canonical
+/// forms), and the source stops enumerating while the later stages are
+/// behind. Batches may finish a parallel stage out of order; they are
+/// reordered before the sink, so the sink receives the same configurations
+/// in the same order as running the stages one after another on a single
+/// thread, independent of the number of threads. The number of batches in
+/// the pipeline, including those waiting to be reordered, is limited to
+/// what the queues and stage threads can hold.
+///
+/// Notes:
+/// - Stages block on queues, so they run on dedicated threads rather than
+///   the process-wide thread pool. `transform` and `filter` may themselves
+///   use `parallel_for_chunks`.
+/// - To use a Python function in the filter stage, release the GIL while
+///   calling `run_enumeration_pipeline` and acquire it inside `filter`.
+///   Python filters then run one at a time, while the other stages
+///   continue without the GIL.
+/// - If any stage throws, all stages are stopped and the first exception is
+///   rethrown after all threads are joined.
+EnumerationPipelineStats run_enumeration_pipeline(
+    EnumerationSource const &source, ConfigurationTransform const &transform,
+    ConfigurationPredicate const &filter, ConfigurationBatchSink const &sink,
+    EnumerationPipelineOptions const &options) {
+  if (!source) {
+    throw std::runtime_error(
+        "Error in run_enumeration_pipeline: source is empty");
+  }
+  Index batch_size = std::max(options.batch_size, Index(1));
+  Index queue_capacity = std::max(options.queue_capacity, Index(1));
+
+  std::vector<PipelineStage> stages;
+  if (transform) {
+    stages.push_back(
+        {[&](std::vector<Configuration> &configurations) {
+           for (auto &configuration : configurations) {
+             transform(configuration);
+           }
+         },
+         resolve_n_threads(options.n_transform_threads)});
+  }
+  if (filter) {
+    stages.push_back(
+        {[&](std::vector<Configuration> &configurations) {
+           configurations.erase(
+               std::remove_if(configurations.begin(), configurations.end(),
+                              [&](Configuration const &configuration) {
+                                return !filter(configuration);
+                              }),
+               configurations.end());
+         },
+         resolve_n_threads(options.n_filter_threads)});
+  }
+
+  PipelineState state;
+  Index max_in_flight = queue_capacity;
+  for (auto const &stage : stages) {
+    state.queues.emplace_back(std::make_unique<PipelineQueue>(queue_capacity));
+    max_in_flight += queue_capacity + stage.n_threads;
+  }
+  state.queues.emplace_back(std::make_unique<PipelineQueue>(queue_capacity));
+
+  std::atomic<Index> n_enumerated(0);
+  std::atomic<Index> n_batches(0);
+  std::vector<std::thread> threads;
+
+  // source: stop enumerating while too many batches are in the pipeline,
+  // so that batches waiting to be reordered do not grow without limit
+  threads.emplace_back([&]() {
+    try {
+      for (Index index = 0;; ++index) {
+        {
+          std::unique_lock<std::mutex> lock(state.mutex);
+          state.progress.wait(lock, [&] {
+            return state.stopped || index - state.n_sunk < max_in_flight;
+          });
+          if (state.stopped) {
+            break;
+          }
+        }
+        PipelineBatch batch;
+        batch.index = index;
+        batch.configurations = source(batch_size);
+        if (batch.configurations.empty()) {
+          break;
+        }
+        n_enumerated += batch.configurations.size();
+        ++n_batches;
+        if (!state.queues[0]->push(std::move(batch))) {
+          break;
+        }
+      }
+    } catch (...) {
+      state.fail(std::current_exception());
+    }
+    state.queues[0]->close();
+  });
+
+  // transform and filter: the last thread of a stage to finish closes the
+  // next queue
+  std::vector<std::unique_ptr<std::atomic<Index>>> n_running;
+  for (Index s = 0; s < stages.size(); ++s) {
+    n_running.emplace_back(
+        std::make_unique<std::atomic<Index>>(stages[s].n_threads));
+    for (Index t = 0; t < stages[s].n_threads; ++t) {
+      threads.emplace_back([&, s]() {
+        PipelineQueue &input = *state.queues[s];
+        PipelineQueue &output = *state.queues[s + 1];
+        try {
+          PipelineBatch batch;
+          while (input.pop(batch)) {
+            stages[s].f(batch.configurations);
+            if (!output.push(std::move(batch))) {
+              break;
+            }
+          }
+        } catch (...) {
+          state.fail(std::current_exception());
+        }
+        if (--(*n_running[s]) == 0) {
+          output.close();
+        }
+      });
+    }
+  }
+
+  // sink: reorder batches, on the calling thread
+  Index n_accepted = 0;
+  try {
+    std::map<Index, PipelineBatch> pending;
+    Index next_index = 0;
+    PipelineBatch batch;
+    while (state.queues.back()->pop(batch)) {
+      pending.emplace(batch.index, std::move(batch));
+      auto it = pending.find(next_index);
+      while (it != pending.end()) {
+        n_accepted += it->second.configurations.size();
+        if (sink) {
+          sink(it->second.configurations);
+        }
+        pending.erase(it);
+        ++next_index;
+        {
+          std::lock_guard<std::mutex> lock(state.mutex);
+          state.n_sunk = next_index;
+        }
+        state.progress.notify_all();
+        it = pending.find(next_index);
+      }
+    }
+  } catch (...) {
+    state.fail(std::current_exception());
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (state.error) {
+    std::rethrow_exception(state.error);
+  }
+
+  EnumerationPipelineStats stats;
+  stats.n_enumerated = n_enumerated;
+  stats.n_accepted = n_accepted;
+  stats.n_batches = n_batches;
+  return stats;
+}
+
+/// \brief Return an EnumerationSource that takes batches from a
+///     ConfigEnumAllOccupations
+///
+/// \param enumerator The enumerator, which must remain valid while the
+///     source is used. Batches start with the current value, as by
+///     `enumerator.next_batch`.
+EnumerationSource make_enumeration_source(
+    ConfigEnumAllOccupations &enumerator) {
+  return [&enumerator](Index max_size) {
+    if (!enumerator.is_valid()) {
+      return std::vector<Configuration>();
+    }
+    return enumerator.next_batch(max_size);
+  };
+}
+
+/// \brief Return a ConfigurationTransform that makes a configuration the
+///     canonical form in its supercell
+///
+/// Uses all operations that leave the supercell lattice invariant, as by
+/// `ConfigurationSet::insert_many`.
+ConfigurationTransform make_canonical_form_transform() {
+  return [](Configuration &configuration) {
+    auto const &supercell = configuration.supercell;
+    configuration =
+        make_canonical_form(configuration, SupercellSymOp::begin(supercell),
+                            SupercellSymOp::end(supercell));
+  };
+}
+
+/// \brief Return a ConfigurationPredicate that accepts primitive
+///     configurations
+ConfigurationPredicate make_is_primitive_predicate() {
+  return [](Configuration const &configuration) {
+    return is_primitive(configuration);
+  };
+}
+
+/// \brief Return a ConfigurationPredicate that accepts configurations in
+///     canonical form in their supercell
+///
+/// Uses all operations that leave the supercell lattice invariant.
+ConfigurationPredicate make_is_canonical_predicate() {
+  return [](Configuration const &configuration) {
+    auto const &supercell = configuration.supercell;
+    return is_canonical(configuration, SupercellSymOp::begin(supercell),
+                        SupercellSymOp::end(supercell));
+  };
+}
+
+/// \brief Return a ConfigurationPredicate that accepts configurations
+///     satisfying occupant count constraints
+///
+/// \param supercell The supercell of the site indices of `constraints`.
+///     The predicate throws if given a configuration in another supercell.
+/// \param constraints Bounds on the number of sites with a particular
+///     occupant, as used by ConfigEnumCanonicalOccupations
+///
+/// Sites that do not allow a constraint's occupant do not count towards
+/// it. Equivalent to `make_filter_predicate` with an OccupantCountFilter.
+ConfigurationPredicate make_occupant_count_predicate(
+    std::shared_ptr<Supercell const> const &supercell,
+    std::vector<OccupantCountConstraint> const &constraints) {
+  return make_filter_predicate(
+      std::make_shared<OccupantCountFilter const>(supercell, constraints));
+}
+
+/// \brief Return a ConfigurationPredicate that accepts configurations
+///     accepted by a ConfigurationFilter
+///
+/// The filter is shared by copies of the predicate, so it must be safe to
+/// call concurrently. The filter's primitive and canonical guarantees are
+/// not used.
+ConfigurationPredicate make_filter_predicate(
+    std::shared_ptr<ConfigurationFilter const> const &filter) {
+  if (!filter) {
+    throw std::runtime_error("Error in make_filter_predicate: filter is empty");
+  }
+  return [=](Configuration const &configuration) {
+    return (*filter)(configuration);
+  };
+}
+
+/// \brief Return a ConfigurationPredicate that accepts configurations
+///     accepted by all of `predicates`
+///
+/// Predicates are checked in order, stopping at the first that rejects a
+/// configuration, so the cheapest should be first. Empty predicates are
+/// ignored.
+ConfigurationPredicate make_all_of_predicate(
+    std::vector<ConfigurationPredicate> const &predicates) {
+  std::vector<ConfigurationPredicate> _predicates;
+  for (auto const &predicate : predicates) {
+    if (predicate) {
+      _predicates.push_back(predicate);
+    }
+  }
+  return [=](Configuration const &configuration) {
+    for (auto const &predicate : _predicates) {
+      if (!predicate(configuration)) {
+        return false;
+      }
+    }
+    return true;
+  };
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,176 @@
+#include "casm/configuration/enumeration/ExternalConfigurationSet.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Supercell.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+void append_rounded(std::string &key, double value, double tol) {
+  std::int64_t rounded = std::llround(value / tol);
+  char bytes[sizeof(rounded)];
+  std::memcpy(bytes, &rounded, sizeof(rounded));
+  key.append(bytes, sizeof(rounded));
+}
+
+/// \brief Return a prefix for run file names, unique to each set
+std::string make_run_prefix() {
+  static std::atomic<std::uint64_t> counter{0};
+  std::random_device rd;
+  return "runs_" + std::to_string(rd()) + "_" + std::to_string(counter++);
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _supercell The supercell of all configurations
+/// \param _spill_dir If provided, the directory where run files are
+///     written. Must exist. If not provided, all keys are held in memory.
+/// \param _max_size_in_memory The number of keys held in memory before
+///     writing a run file. Ignored if `_spill_dir` is not provided.
+ExternalConfigurationSet::ExternalConfigurationSet(
+    std::shared_ptr<Supercell const> const &_supercell,
+    std::optional<fs::path> _spill_dir, Index _max_size_in_memory)
+    : m_supercell(_supercell),
+      m_spill_dir(_spill_dir),
+      m_max_size_in_memory(_max_size_in_memory),
+      m_tol(_supercell->prim->basicstructure->lattice().tol()),
+      m_run_prefix(make_run_prefix()),
+      m_size(0) {
+  if (m_spill_dir.has_value() && m_max_size_in_memory < 1) {
+    throw std::runtime_error(
+        "Error constructing ExternalConfigurationSet: max_size_in_memory < 1");
+  }
+}
+
+ExternalConfigurationSet::~ExternalConfigurationSet() {
+  for (auto &run : m_runs) {
+    run.in.reset();
+    try {
+      fs::remove(run.path);
+    } catch (std::exception const &e) {
+      // leave the file
+    }
+  }
+}
+
+/// \brief Insert a configuration, return true if it was not already
+///     in the set
+bool ExternalConfigurationSet::insert(Configuration const &configuration) {
+  std::string key = _make_key(configuration);
+  if (_contains(key)) {
+    return false;
+  }
+  m_memory.insert(std::move(key));
+  ++m_size;
+  if (m_spill_dir.has_value() && m_memory.size() >= m_max_size_in_memory) {
+    _spill();
+  }
+  return true;
+}
+
+/// \brief Return true if the configuration is in the set
+bool ExternalConfigurationSet::contains(
+    Configuration const &configuration) const {
+  return _contains(_make_key(configuration));
+}
+
+std::string ExternalConfigurationSet::_make_key(
+    Configuration const &configuration) const {
+  if (configuration.supercell != m_supercell &&
+      *configuration.supercell != *m_supercell) {
+    throw std::runtime_error(
+        "Error in ExternalConfigurationSet: supercell mismatch");
+  }
+  auto const &dof_values = configuration.dof_values;
+  std::string key;
+  key.reserve(dof_values.occupation.size());
+  for (Index l = 0; l < dof_values.occupation.size(); ++l) {
+    int occ = dof_values.occupation(l);
+    if (occ < 0 || occ > 255) {
+      throw std::runtime_error(
+          "Error in ExternalConfigurationSet: occupant index out of range");
+    }
+    key.push_back(static_cast<char>(occ));
+  }
+  for (auto const &dof : dof_values.global_dof_values) {
+    for (Index i = 0; i < dof.second.size(); ++i) {
+      append_rounded(key, dof.second(i), m_tol);
+    }
+  }
+  for (auto const &dof : dof_values.local_dof_values) {
+    for (Index i = 0; i < dof.second.size(); ++i) {
+      append_rounded(key, dof.second(i), m_tol);
+    }
+  }
+  return key;
+}
+
+bool ExternalConfigurationSet::_contains(std::string const &key) const {
+  if (m_memory.count(key)) {
+    return true;
+  }
+  m_buffer.resize(key.size());
+  for (auto const &run : m_runs) {
+    Index begin = 0;
+    Index end = run.size;
+    while (begin < end) {
+      Index mid = begin + (end - begin) / 2;
+      run.in->seekg(mid * key.size());
+      run.in->read(m_buffer.data(), key.size());
+      if (!*run.in) {
+        throw std::runtime_error(
+            "Error in ExternalConfigurationSet: failed reading run file " +
+            run.path.string());
+      }
+      int cmp = m_buffer.compare(key);
+      if (cmp == 0) {
+        return true;
+      } else if (cmp < 0) {
+        begin = mid + 1;
+      } else {
+        end = mid;
+      }
+    }
+  }
+  return false;
+}
+
+void ExternalConfigurationSet::_spill() {
+  std::vector<std::string> keys(m_memory.begin(), m_memory.end());
+  std::sort(keys.begin(), keys.end());
+
+  fs::path path = *m_spill_dir / (m_run_prefix + "_" +
+                                  std::to_string(m_runs.size()) + ".bin");
+  {
+    std::ofstream out(path.string(), std::ios::binary);
+    for (auto const &key : keys) {
+      out.write(key.data(), key.size());
+    }
+    if (!out) {
+      throw std::runtime_error(
+          "Error in ExternalConfigurationSet: failed writing run file " +
+          path.string());
+    }
+  }
+
+  Run run;
+  run.path = path;
+  run.size = keys.size();
+  run.in = std::make_unique<std::ifstream>(path.string(), std::ios::binary);
+  m_runs.push_back(std::move(run));
+  m_memory.clear();
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,281 @@
+#include "casm/configuration/enumeration/LocalCanonicalKey.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/OccCanonicalizer.hh"
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/enumeration/background_configuration.hh"
+#include "casm/crystallography/BasicStructure.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {  // anonymous
+
+/// \brief Minimum image distance between Cartesian coordinates, in a
+///     periodic supercell
+double _min_image_distance(Eigen::Vector3d const &a, Eigen::Vector3d const &b,
+                           Eigen::Matrix3d const &S,
+                           Eigen::Matrix3d const &S_inv) {
+  Eigen::Vector3d frac = S_inv * (a - b);
+  frac = frac - frac.array().round().matrix();
+  // check neighboring images, for skewed supercells
+  double min_distance = std::numeric_limits<double>::infinity();
+  for (int i = -1; i <= 1; ++i) {
+    for (int j = -1; j <= 1; ++j) {
+      for (int k = -1; k <= 1; ++k) {
+        Eigen::Vector3d d = S * (frac + Eigen::Vector3d(i, j, k));
+        min_distance = std::min(min_distance, d.norm());
+      }
+    }
+  }
+  return min_distance;
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _supercell The supercell
+/// \param _event_sites Linear sites indices of the cluster of sites that
+///     change during the event
+/// \param _occ_init Initial occupation on event sites
+/// \param _occ_final Final occupation on event sites
+/// \param _event_group The SupercellSymOp consistent with both the
+///     supercell and a local subgroup of the prim factor group (for example
+///     a cluster group). Must not be empty.
+/// \param _neighborhood_sites Linear site indices of sites compared first,
+///     and the only sites compared by `neighborhood_key`. If empty, all
+///     sites are in the neighborhood.
+/// \param tol Tolerance for grouping site distances in shells
+LocalCanonicalKey::LocalCanonicalKey(
+    std::shared_ptr<Supercell const> const &_supercell,
+    std::vector<Index> const &_event_sites, std::vector<int> const &_occ_init,
+    std::vector<int> const &_occ_final,
+    std::vector<SupercellSymOp> const &_event_group,
+    std::set<Index> const &_neighborhood_sites, double tol)
+    : m_supercell(_supercell),
+      m_event_sites(_event_sites),
+      m_occ_init(_occ_init),
+      m_occ_final(_occ_final),
+      m_event_group(_event_group),
+      m_is_complete(OccCanonicalizer::is_supported(*_supercell->prim)),
+      m_max_n_occupants(_supercell->prim->sym_info.max_n_occupants) {
+  if (m_event_sites.empty() || m_occ_init.size() != m_event_sites.size() ||
+      m_occ_final.size() != m_event_sites.size()) {
+    throw std::runtime_error(
+        "Error constructing LocalCanonicalKey: event_sites, occ_init, and "
+        "occ_final must be non-empty and have the same size");
+  }
+  if (m_event_group.empty()) {
+    throw std::runtime_error(
+        "Error constructing LocalCanonicalKey: event_group is empty");
+  }
+
+  auto const &converter = m_supercell->unitcellcoord_index_converter;
+  auto const &basicstructure = *m_supercell->prim->basicstructure;
+  Index n_sites = converter.total_sites();
+  Eigen::Matrix3d const &S =
+      m_supercell->superlattice.superlattice().lat_column_mat();
+  Eigen::Matrix3d S_inv = S.inverse();
+
+  std::vector<Eigen::Vector3d> coords(n_sites);
+  m_site_sublattice.resize(n_sites);
+  for (Index l = 0; l < n_sites; ++l) {
+    xtal::UnitCellCoord const &bijk = converter(l);
+    coords[l] = bijk.coordinate(basicstructure).const_cart();
+    m_site_sublattice[l] = bijk.sublattice();
+  }
+
+  // (is_not_in_neighborhood, distance, l), for sites with occupation DoF
+  auto const &basis = basicstructure.basis();
+  std::vector<std::tuple<bool, double, Index>> sites;
+  for (Index l = 0; l < n_sites; ++l) {
+    if (basis[m_site_sublattice[l]].occupant_dof().size() < 2) {
+      continue;
+    }
+    double distance = std::numeric_limits<double>::infinity();
+    for (Index e : m_event_sites) {
+      distance = std::min(distance, _min_image_distance(coords[l], coords[e],
+                                                        S, S_inv));
+    }
+    bool is_not_in_neighborhood =
+        !_neighborhood_sites.empty() && !_neighborhood_sites.count(l);
+    sites.emplace_back(is_not_in_neighborhood, distance, l);
+  }
+
+  // group distances within tol of the first in each shell
+  std::vector<double> distances;
+  for (auto const &site : sites) {
+    distances.push_back(std::get<1>(site));
+  }
+  std::sort(distances.begin(), distances.end());
+  std::vector<double> shells;
+  for (double d : distances) {
+    if (shells.empty() || d - shells.back() > tol) {
+      shells.push_back(d);
+    }
+  }
+  auto shell_index = [&](double d) {
+    return std::upper_bound(shells.begin(), shells.end(), d) -
+           shells.begin();
+  };
+  std::sort(sites.begin(), sites.end(), [&](auto const &A, auto const &B) {
+    if (std::get<0>(A) != std::get<0>(B)) {
+      return std::get<0>(B);
+    }
+    auto shell_A = shell_index(std::get<1>(A));
+    auto shell_B = shell_index(std::get<1>(B));
+    if (shell_A != shell_B) {
+      return shell_A < shell_B;
+    }
+    return std::get<2>(A) < std::get<2>(B);
+  });
+
+  m_n_neighborhood_sites = 0;
+  for (auto const &site : sites) {
+    if (!std::get<0>(site)) {
+      ++m_n_neighborhood_sites;
+    }
+    m_ordered_distances.push_back(std::get<1>(site));
+    m_ordered_sites.push_back(std::get<2>(site));
+  }
+
+  Index n_ordered = m_ordered_sites.size();
+  PrimSymInfo const &prim_sym_info = m_supercell->prim->sym_info;
+  m_perm.resize(m_event_group.size() * n_ordered);
+  for (Index k = 0; k < m_event_group.size(); ++k) {
+    SupercellSymOp const &op = m_event_group[k];
+    for (Index i = 0; i < n_ordered; ++i) {
+      m_perm[k * n_ordered + i] = op.permute_index(m_ordered_sites[i]);
+    }
+    m_remap.push_back(prim_sym_info.occ_remap(op.prim_factor_group_index(), 0));
+  }
+}
+
+/// \brief The supercell
+std::shared_ptr<Supercell const> const &LocalCanonicalKey::supercell() const {
+  return m_supercell;
+}
+
+/// \brief Linear site indices, in key order
+std::vector<Index> const &LocalCanonicalKey::ordered_sites() const {
+  return m_ordered_sites;
+}
+
+/// \brief Minimum image distance from the nearest event site, for each
+///     site in `ordered_sites()`
+std::vector<double> const &LocalCanonicalKey::ordered_distances() const {
+  return m_ordered_distances;
+}
+
+/// \brief Number of leading `ordered_sites()` in the neighborhood
+Index LocalCanonicalKey::n_neighborhood_sites() const {
+  return m_n_neighborhood_sites;
+}
+
+/// \brief True if equal full keys imply equivalence, which is the case
+///     for prim with occupation DoF only
+bool LocalCanonicalKey::is_complete() const { return m_is_complete; }
+
+/// \brief Return the key, comparing neighborhood sites only
+///
+/// The result is valid until the next call to a non-const method.
+std::vector<int> const &LocalCanonicalKey::neighborhood_key(
+    Configuration const &configuration) {
+  _set_occupation(configuration);
+  _search(m_n_neighborhood_sites);
+  return m_key;
+}
+
+/// \brief Return the key, comparing all sites
+///
+/// The result is valid until the next call to a non-const method.
+std::vector<int> const &LocalCanonicalKey::key(
+    Configuration const &configuration) {
+  _set_occupation(configuration);
+  _search(m_ordered_sites.size());
+  return m_key;
+}
+
+/// \brief Return true if configurations are equivalent in the context of
+///     the event
+///
+/// Equivalent to comparing `make_canonical_form(A, event_sites, occ_init,
+/// occ_final, event_group)` and the same for B, but neighborhood keys are
+/// compared first, then full keys, if complete, and canonical forms are only
+/// made for prim with continuous DoF whose neighborhood keys are equal.
+bool LocalCanonicalKey::is_equivalent(Configuration const &A,
+                                      Configuration const &B) {
+  m_other_key = neighborhood_key(A);
+  if (neighborhood_key(B) != m_other_key) {
+    return false;
+  }
+  if (m_is_complete) {
+    if (m_n_neighborhood_sites == m_ordered_sites.size()) {
+      return true;
+    }
+    m_other_key = key(A);
+    return key(B) == m_other_key;
+  }
+  return make_canonical_form(A, m_event_sites, m_occ_init, m_occ_final,
+                             m_event_group) ==
+         make_canonical_form(B, m_event_sites, m_occ_init, m_occ_final,
+                             m_event_group);
+}
+
+/// \brief Set m_occ from configuration and the event occupations
+void LocalCanonicalKey::_set_occupation(Configuration const &configuration) {
+  if (configuration.supercell != m_supercell &&
+      *configuration.supercell != *m_supercell) {
+    throw std::runtime_error(
+        "Error in LocalCanonicalKey: configuration is not in the supercell");
+  }
+  Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+  std::vector<int> const *event_occ[2] = {&m_occ_init, &m_occ_final};
+  for (Index v = 0; v < 2; ++v) {
+    m_occ[v].assign(occupation.data(), occupation.data() + occupation.size());
+    for (Index i = 0; i < m_event_sites.size(); ++i) {
+      m_occ[v][m_event_sites[i]] = (*event_occ[v])[i];
+    }
+  }
+}
+
+/// \brief Set m_key to the greatest of the first n ordered values
+///
+/// Each candidate is compared to the greatest found so far in key order,
+/// exiting at the first differing site, and only completed if greater.
+void LocalCanonicalKey::_search(Index n) {
+  m_key.resize(n);
+  bool has_best = false;
+  for (Index k = 0; k < m_event_group.size(); ++k) {
+    for (Index v = 0; v < 2; ++v) {
+      Index i = 0;
+      if (has_best) {
+        for (; i < n; ++i) {
+          int value = _value(k, v, i);
+          if (value != m_key[i]) {
+            break;
+          }
+        }
+        if (i == n || _value(k, v, i) < m_key[i]) {
+          continue;
+        }
+      }
+      for (; i < n; ++i) {
+        m_key[i] = _value(k, v, i);
+      }
+      has_best = true;
+    }
+  }
+}
+
+}  // namespace config
+}  // namespace CASM
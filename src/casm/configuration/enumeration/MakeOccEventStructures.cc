@@ -1,5 +1,7 @@
 #include "casm/configuration/enumeration/MakeOccEventStructures.hh"
 
+#include <set>
+
 #include "casm/configuration/Configuration.hh"
 #include "casm/configuration/clusterography/IntegralCluster.hh"
 #include "casm/configuration/occ_events/OccEvent.hh"
@@ -16,29 +18,10 @@
 namespace CASM {
 namespace config {
 
-/// \brief MakeOccEventStructures constructor
-///
-/// \param configuration Configuration specifying the occupation
-///     on all non-event sites
-/// \param occ_event The event
-/// \param system System used to specify order and indices
-/// \param skip_event_occupants If true, do not include occupants
-///     involved in the event in the output. Default=false.
-///
-MakeOccEventStructures::MakeOccEventStructures(
-    Configuration const &configuration, occ_events::OccEvent const &occ_event,
-    std::shared_ptr<occ_events::OccSystem const> const &system,
-    bool skip_event_occupants) {
-  // references
-  auto const &supercell = *configuration.supercell;
-  auto const &prim = *supercell.prim;
-  auto const &converter = supercell.unitcellcoord_index_converter;
-  auto const &dof_values = configuration.dof_values;
-  auto const &occupation = dof_values.occupation;
-  auto const &local_dof_values = dof_values.local_dof_values;
-  auto const &global_dof_values = dof_values.global_dof_values;
+namespace {  // anonymous
 
-  // validate no multi-atom molecules
+/// \brief Throw if the prim allows multi-atom molecules
+void _validate_molecules(Prim const &prim) {
   std::vector<xtal::Molecule> molecule_list =
       xtal::struc_molecule(*prim.basicstructure);
   for (auto const &mol : molecule_list) {
@@ -48,8 +31,10 @@ MakeOccEventStructures::MakeOccEventStructures(
           "allowed");
     }
   }
+}
 
-  // validate no intermediate event states
+/// \brief Throw if any trajectory has intermediate event states
+void _validate_trajectories(occ_events::OccEvent const &occ_event) {
   for (auto const &traj : occ_event) {
     if (traj.position.size() != 2) {
       throw std::runtime_error(
@@ -57,12 +42,22 @@ MakeOccEventStructures::MakeOccEventStructures(
           "positions");
     }
   }
+}
 
-  // set m_ideal_lat_column_mat
-  m_ideal_lat_column_mat =
-      supercell.superlattice.superlattice().lat_column_mat();
+/// \brief Return the configuration deformation gradient, throwing if the
+///     configuration has DoF other than occupation and strain
+Eigen::Matrix3d _make_F(Configuration const &configuration) {
+  auto const &prim = *configuration.supercell->prim;
+  auto const &dof_values = configuration.dof_values;
+  auto const &global_dof_values = dof_values.global_dof_values;
+
+  // validate no local DoF
+  if (dof_values.local_dof_values.size() > 0) {
+    throw std::runtime_error(
+        "Error in MakeOccEventStructures: only occupation strain DoF are "
+        "supported");
+  }
 
-  // set m_F
   if (has_strain_dof(*prim.basicstructure)) {
     if (global_dof_values.size() > 1) {
       throw std::runtime_error(
@@ -72,22 +67,48 @@ MakeOccEventStructures::MakeOccEventStructures(
     DoFKey dof_key = get_strain_dof_key(*prim.basicstructure);
     xtal::StrainConverter DoFstrain_converter(
         dof_key, prim.global_dof_info.at(dof_key).basis());
-    m_F = DoFstrain_converter.to_F(global_dof_values.at(dof_key));
-  } else {
-    if (global_dof_values.size() > 0) {
-      throw std::runtime_error(
-          "Error in MakeOccEventStructures: only occupation strain DoF are "
-          "supported");
-    }
-    m_F = Eigen::Matrix3d::Identity();
+    return DoFstrain_converter.to_F(global_dof_values.at(dof_key));
   }
-
-  // validate no local DoF
-  if (local_dof_values.size() > 0) {
+  if (global_dof_values.size() > 0) {
     throw std::runtime_error(
         "Error in MakeOccEventStructures: only occupation strain DoF are "
         "supported");
   }
+  return Eigen::Matrix3d::Identity();
+}
+
+}  // namespace
+
+/// \brief MakeOccEventStructures constructor
+///
+/// \param configuration Configuration specifying the occupation
+///     on all non-event sites
+/// \param occ_event The event
+/// \param system System used to specify order and indices
+/// \param skip_event_occupants If true, do not include occupants
+///     involved in the event in the output. Default=false.
+///
+MakeOccEventStructures::MakeOccEventStructures(
+    Configuration const &configuration, occ_events::OccEvent const &occ_event,
+    std::shared_ptr<occ_events::OccSystem const> const &system,
+    bool skip_event_occupants) {
+  // references
+  auto const &supercell = *configuration.supercell;
+  auto const &prim = *supercell.prim;
+  auto const &converter = supercell.unitcellcoord_index_converter;
+  auto const &dof_values = configuration.dof_values;
+  auto const &occupation = dof_values.occupation;
+
+  // validate no multi-atom molecules or intermediate event states
+  _validate_molecules(prim);
+  _validate_trajectories(occ_event);
+
+  // set m_ideal_lat_column_mat
+  m_ideal_lat_column_mat =
+      supercell.superlattice.superlattice().lat_column_mat();
+
+  // set m_F, and validate only occupation and strain DoF
+  m_F = _make_F(configuration);
 
   // here we set m_atom_names, m_coords, and m_disp:
   auto cluster_occupation = make_cluster_occupation(occ_event);
@@ -158,5 +179,163 @@ xtal::SimpleStructure MakeOccEventStructures::operator()(
   return structure;
 }
 
+/// \brief MakeOccEventImages constructor
+///
+/// \param configuration Configuration specifying the occupation
+///     on all non-event sites
+/// \param system System used to specify order and indices
+/// \param skip_event_occupants If true, do not include occupants
+///     involved in the event in the output. Default=false.
+///
+MakeOccEventImages::MakeOccEventImages(
+    Configuration const &configuration,
+    std::shared_ptr<occ_events::OccSystem const> const &system,
+    bool skip_event_occupants)
+    : m_supercell(configuration.supercell),
+      m_system(system),
+      m_skip_event_occupants(skip_event_occupants) {
+  auto const &prim = *m_supercell->prim;
+  auto const &converter = m_supercell->unitcellcoord_index_converter;
+  auto const &occupation = configuration.dof_values.occupation;
+
+  _validate_molecules(prim);
+  m_F = _make_F(configuration);
+  m_lat_column_mat =
+      m_F * m_supercell->superlattice.superlattice().lat_column_mat();
+
+  // background coordinates and chemical type of every site
+  Index n_sites = converter.total_sites();
+  std::vector<occ_events::OccPosition> positions;
+  positions.reserve(n_sites);
+  m_site_chemical_index.resize(n_sites);
+  m_sites_by_chemical_index.resize(m_system->chemical_name_list.size());
+  for (Index l = 0; l < n_sites; ++l) {
+    positions.push_back(
+        m_system->make_molecule_position(converter(l), occupation(l)));
+    Index chemical_index = m_system->get_chemical_index(positions.back());
+    m_site_chemical_index[l] = chemical_index;
+    if (!m_system->is_vacancy_list[chemical_index]) {
+      m_sites_by_chemical_index[chemical_index].push_back(l);
+    }
+  }
+  m_site_coords = m_F * m_system->get_cartesian_coordinates(positions);
+}
+
+/// \brief Construct interpolated image coordinates of many events
+///
+/// \param occ_events The events
+/// \param interpolation_factors Interpolation factors, where 0.0 results
+///     in the initial configuration and 1.0 results in the final
+///     configuration. Other values linearly interpolate the
+///     displacements of the atoms involved in the event.
+///
+/// \return images The coordinates of image `k` of event `e` are those of
+///     `MakeOccEventStructures(configuration, occ_events[e], system,
+///     skip_event_occupants)(interpolation_factors[k])`
+///
+OccEventImages MakeOccEventImages::operator()(
+    std::vector<occ_events::OccEvent> const &occ_events,
+    std::vector<double> const &interpolation_factors) const {
+  auto const &converter = m_supercell->unitcellcoord_index_converter;
+  Index n_chemical = m_system->chemical_name_list.size();
+
+  // event sites, and the number of atoms of each event
+  std::vector<std::set<Index>> event_sites;
+  event_sites.reserve(occ_events.size());
+  OccEventImages images;
+  images.lat_column_mat = m_lat_column_mat;
+  images.n_images = interpolation_factors.size();
+  images.atom_offsets.resize(occ_events.size() + 1);
+  Index n_atoms = 0;
+  for (Index e = 0; e < occ_events.size(); ++e) {
+    auto const &occ_event = occ_events[e];
+    _validate_trajectories(occ_event);
+    event_sites.push_back(to_index_set(make_cluster(occ_event), converter));
+    images.atom_offsets(e) = n_atoms;
+    for (Index l : event_sites.back()) {
+      if (!m_system->is_vacancy_list[m_site_chemical_index[l]]) {
+        --n_atoms;
+      }
+    }
+    for (Index c = 0; c < n_chemical; ++c) {
+      n_atoms += m_sites_by_chemical_index[c].size();
+    }
+    if (!m_skip_event_occupants) {
+      for (auto const &traj : occ_event) {
+        if (!m_system->is_vacancy(traj.position[0])) {
+          ++n_atoms;
+        }
+      }
+    }
+  }
+  images.atom_offsets(occ_events.size()) = n_atoms;
+
+  // fill atom types and coordinates
+  images.atom_type.resize(n_atoms);
+  images.coords.resize(3, images.n_images * n_atoms);
+  std::vector<Eigen::Vector3d> event_coords_init;
+  std::vector<Eigen::Vector3d> event_disp;
+  for (Index e = 0; e < occ_events.size(); ++e) {
+    auto const &occ_event = occ_events[e];
+    Index n = images.n_atoms(e);
+    Index a = 0;
+    event_coords_init.clear();
+    event_disp.clear();
+    for (Index c = 0; c < n_chemical; ++c) {
+      if (m_system->is_vacancy_list[c]) {
+        continue;
+      }
+
+      // event occupants: atom types, and coordinates for interpolation
+      Index a_event_begin = a;
+      if (!m_skip_event_occupants) {
+        for (auto const &traj : occ_event) {
+          auto const &pos_init = traj.position[0];
+          if (m_system->get_chemical_index(pos_init) == c) {
+            Eigen::Vector3d coord_init =
+                m_F * m_system->get_cartesian_coordinate(pos_init);
+            Eigen::Vector3d coord_final =
+                m_F * m_system->get_cartesian_coordinate(traj.position[1]);
+            images.atom_type(images.atom_offsets(e) + a) = c;
+            event_coords_init.push_back(coord_init);
+            event_disp.push_back(coord_final - coord_init);
+            ++a;
+          }
+        }
+      }
+      Index a_event_end = a;
+
+      // configuration occupants, the same in all images
+      for (Index l : m_sites_by_chemical_index[c]) {
+        if (event_sites[e].count(l)) {
+          continue;
+        }
+        images.atom_type(images.atom_offsets(e) + a) = c;
+        for (Index k = 0; k < images.n_images; ++k) {
+          images.coords.col(images.image_begin(e, k) + a) =
+              m_site_coords.col(l);
+        }
+        ++a;
+      }
+
+      // interpolate event occupants
+      for (Index k = 0; k < images.n_images; ++k) {
+        double f = interpolation_factors[k];
+        Index begin = images.image_begin(e, k);
+        for (Index i = a_event_begin; i < a_event_end; ++i) {
+          Index j = event_coords_init.size() - (a_event_end - i);
+          images.coords.col(begin + i) =
+              event_coords_init[j] + f * event_disp[j];
+        }
+      }
+    }
+    if (a != n) {
+      throw std::runtime_error(
+          "Error in MakeOccEventImages: inconsistent number of atoms");
+    }
+  }
+  return images;
+}
+
 }  // namespace config
 }  // namespace CASM
@@ -1,6 +1,9 @@
 
 #include "casm/configuration/enumeration/OccEventInfo.hh"
 
+#include <algorithm>
+#include <optional>
+
 #include "casm/configuration/Configuration.hh"
 #include "casm/configuration/SupercellSymOp.hh"
 #include "casm/configuration/clusterography/ClusterSpecs.hh"
@@ -10,6 +13,7 @@
 #include "casm/configuration/enumeration/perturbations.hh"
 #include "casm/configuration/group/orbits.hh"
 #include "casm/configuration/occ_events/orbits.hh"
+#include "casm/configuration/parallel.hh"
 #include "casm/configuration/sym_info/unitcellcoord_sym_info.hh"
 
 // debug:
@@ -20,16 +24,191 @@
 namespace CASM {
 namespace config {
 
+namespace {  // anonymous
+
+/// \brief Make `f(i)` for each `i` in `[0, n)`, in parallel, and merge the
+///     resulting sets of configurations
+///
+/// Work units are assigned to threads in a strided order, because their
+/// cost may vary systematically, and each thread collects results into its
+/// own set. The sets are merged after all threads finish, so the result
+/// does not depend on the number of threads.
+template <typename F>
+std::set<Configuration> make_merged_in_parallel(Index n, Index n_threads,
+                                                F f) {
+  Index n_workers =
+      std::min<Index>(resolve_n_threads(n_threads), std::max<Index>(n, 1));
+  std::vector<std::set<Configuration>> worker_results(n_workers);
+  parallel_for_chunks(
+      n_workers, n_workers,
+      [&](Index chunk_index, Index chunk_begin, Index chunk_end) {
+        for (Index w = chunk_begin; w < chunk_end; ++w) {
+          for (Index i = w; i < n; i += n_workers) {
+            std::set<Configuration> tmp = f(i);
+            worker_results[w].insert(tmp.begin(), tmp.end());
+          }
+        }
+      });
+  std::set<Configuration> all;
+  for (auto const &results : worker_results) {
+    all.insert(results.begin(), results.end());
+  }
+  return all;
+}
+
+/// \brief Holds OccEventRep symgroup reps, by prim and factor group
+///
+/// Entries hold a std::weak_ptr to their prim and factor group, so an entry is
+/// only reused while both exist; expired entries are erased when a rep is
+/// added.
+struct OccEventSymGroupRepRegistry {
+  struct Entry {
+    std::weak_ptr<xtal::BasicStructure const> prim;
+    std::weak_ptr<SymGroup const> factor_group;
+    std::shared_ptr<std::vector<occ_events::OccEventRep> const> rep;
+
+    bool matches(std::shared_ptr<xtal::BasicStructure const> const &_prim,
+                 std::shared_ptr<SymGroup const> const &_factor_group) const {
+      return prim.lock() == _prim && factor_group.lock() == _factor_group;
+    }
+
+    bool expired() const { return prim.expired() || factor_group.expired(); }
+  };
+
+  std::mutex mutex;
+  std::map<std::pair<xtal::BasicStructure const *, SymGroup const *>, Entry>
+      entries;
+};
+
+OccEventSymGroupRepRegistry &occevent_symgroup_rep_registry() {
+  static OccEventSymGroupRepRegistry registry;
+  return registry;
+}
+
+/// \brief Return the registry rep for `prim` and `factor_group`, adding the
+///     rep constructed by `f()` if there is none
+template <typename F>
+std::shared_ptr<std::vector<occ_events::OccEventRep> const>
+find_or_add_occevent_symgroup_rep(
+    std::shared_ptr<xtal::BasicStructure const> const &prim,
+    std::shared_ptr<SymGroup const> const &factor_group, F f) {
+  auto &registry = occevent_symgroup_rep_registry();
+  auto key = std::make_pair(prim.get(), factor_group.get());
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.entries.find(key);
+    if (it != registry.entries.end() &&
+        it->second.matches(prim, factor_group)) {
+      return it->second.rep;
+    }
+  }
+  auto rep = std::make_shared<std::vector<occ_events::OccEventRep> const>(f());
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto it = registry.entries.begin();
+  while (it != registry.entries.end()) {
+    if (it->second.expired()) {
+      it = registry.entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto &entry = registry.entries[key];
+  if (!entry.matches(prim, factor_group)) {
+    entry.prim = prim;
+    entry.factor_group = factor_group;
+    entry.rep = rep;
+  }
+  return entry.rep;
+}
+
+/// \brief Return the lattice translation, `frac`, such that
+///     `copy_apply(rep, prototype) + frac == event`, after standardization
+///
+/// \param rep The OccEventRep of a prim factor group operation
+/// \param prototype A standardized OccEvent
+/// \param event A standardized OccEvent
+std::optional<xtal::UnitCell> find_translation(
+    occ_events::OccEventRep const &rep, occ_events::OccEvent const &prototype,
+    occ_events::OccEvent const &event) {
+  if (prototype.size() != event.size()) {
+    return std::nullopt;
+  }
+  if (!event.size()) {
+    return xtal::UnitCell(0, 0, 0);
+  }
+  occ_events::OccEvent image = copy_apply(rep, prototype);
+  standardize(image);
+  xtal::UnitCell frac = make_cluster(event)[0].unitcell() -
+                        make_cluster(image)[0].unitcell();
+  image += frac;
+  standardize(image);
+  if (image == event) {
+    return frac;
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+/// \brief Make the OccEventRep symgroup rep of a prim's factor group,
+///     shared with later calls using the same prim
+///
+/// The rep is constructed from the prim's existing `sym_info` reps the first
+/// time it is requested for a prim, and then held in a prim-scoped registry
+/// so that repeated analyses of events with the same prim reuse it.
+/// Thread-safe.
+std::shared_ptr<std::vector<occ_events::OccEventRep> const>
+make_shared_occevent_symgroup_rep(std::shared_ptr<Prim const> const &prim) {
+  if (prim == nullptr) {
+    throw std::runtime_error(
+        "Error in make_shared_occevent_symgroup_rep: prim == nullptr");
+  }
+  return find_or_add_occevent_symgroup_rep(
+      prim->basicstructure, prim->sym_info.factor_group, [&]() {
+        return occ_events::make_occevent_symgroup_rep(
+            prim->sym_info.unitcellcoord_symgroup_rep,
+            prim->sym_info.occ_symgroup_rep,
+            prim->sym_info.atom_position_symgroup_rep);
+      });
+}
+
+/// \brief Make the OccEventRep symgroup rep of a prim factor group, shared
+///     with later calls using the same prim and factor group
+///
+/// Shares the registry used by `make_shared_occevent_symgroup_rep(Prim)`, so
+/// a `Prim` and its `basicstructure` and `sym_info.factor_group` obtain the
+/// same rep. Thread-safe.
+///
+/// \param factor_group The prim factor group. Must be a head group.
+/// \param prim The prim
+std::shared_ptr<std::vector<occ_events::OccEventRep> const>
+make_shared_occevent_symgroup_rep(
+    std::shared_ptr<SymGroup const> const &factor_group,
+    std::shared_ptr<xtal::BasicStructure const> const &prim) {
+  if (factor_group == nullptr || prim == nullptr) {
+    throw std::runtime_error(
+        "Error in make_shared_occevent_symgroup_rep: factor_group == nullptr "
+        "|| prim == nullptr");
+  }
+  if (factor_group->head_group != nullptr) {
+    throw std::runtime_error(
+        "Error in make_shared_occevent_symgroup_rep: factor_group is not a "
+        "head group");
+  }
+  return find_or_add_occevent_symgroup_rep(prim, factor_group, [&]() {
+    return occ_events::make_occevent_symgroup_rep(factor_group->element, *prim);
+  });
+}
+
 OccEventPrimInfo::OccEventPrimInfo(std::shared_ptr<Prim const> const &_prim,
                                    occ_events::OccEvent const &_event)
     : prim(_prim),
       event(_event),
-      occevent_symgroup_rep(occ_events::make_occevent_symgroup_rep(
-          prim->sym_info.factor_group->element, *prim->basicstructure)),
+      occevent_symgroup_rep(make_shared_occevent_symgroup_rep(prim)),
       invariant_group(occ_events::make_occevent_group(
           event, prim->sym_info.factor_group,
           prim->basicstructure->lattice().lat_column_mat(),
-          occevent_symgroup_rep)),
+          *occevent_symgroup_rep)),
       invariant_group_unitcellcoord_rep(
           sym_info::make_unitcellcoord_symgroup_rep(invariant_group->element,
                                                     *prim->basicstructure)) {}
@@ -38,6 +217,25 @@ OccEventPrimInfo::OccEventPrimInfo(std::shared_ptr<Prim const> const &_prim,
 std::vector<std::set<clust::IntegralCluster>>
 OccEventPrimInfo::make_local_orbits(
     std::set<clust::IntegralCluster> const &local_clusters) const {
+  return *make_shared_local_orbits(local_clusters);
+}
+
+/// \brief Make local-cluster orbits from clusters, shared with later
+///     calls using the same clusters
+///
+/// Orbits are generated once for each distinct set of local clusters and
+/// held by this OccEventPrimInfo, so enumerating local perturbations for
+/// many supercells or motifs does not re-generate them. Thread-safe.
+std::shared_ptr<std::vector<std::set<clust::IntegralCluster>> const>
+OccEventPrimInfo::make_shared_local_orbits(
+    std::set<clust::IntegralCluster> const &local_clusters) const {
+  {
+    std::lock_guard<std::mutex> lock(m_local_orbits_mutex);
+    auto it = m_local_orbits.find(local_clusters);
+    if (it != m_local_orbits.end()) {
+      return it->second;
+    }
+  }
   std::set<clust::IntegralCluster> canonical_elements;
   auto const &rep = invariant_group_unitcellcoord_rep;
   for (auto const &cluster : local_clusters) {
@@ -45,10 +243,48 @@ OccEventPrimInfo::make_local_orbits(
         cluster, rep.begin(), rep.end(), std::less<clust::IntegralCluster>(),
         clust::local_integral_cluster_copy_apply));
   }
-  std::vector<std::set<clust::IntegralCluster>> local_orbits;
+  auto local_orbits =
+      std::make_shared<std::vector<std::set<clust::IntegralCluster>>>();
   for (auto const &cluster : canonical_elements) {
-    local_orbits.push_back(make_local_orbit(cluster, rep));
+    local_orbits->push_back(make_local_orbit(cluster, rep));
   }
+  std::lock_guard<std::mutex> lock(m_local_orbits_mutex);
+  return m_local_orbits.emplace(local_clusters, local_orbits).first->second;
+}
+
+/// \brief Make local-cluster orbits for many events, in parallel
+///
+/// \param event_prim_info The events
+/// \param local_clusters The value `local_clusters[i]` is the clusters used
+///     to generate local-cluster orbits for `event_prim_info[i]`
+/// \param n_threads Number of threads used. If <= 0, uses the number of
+///     hardware threads.
+///
+/// \returns local_orbits, where `local_orbits[i]` is
+///     `event_prim_info[i]->make_shared_local_orbits(local_clusters[i])`
+std::vector<
+    std::shared_ptr<std::vector<std::set<clust::IntegralCluster>> const>>
+make_shared_local_orbits(
+    std::vector<std::shared_ptr<OccEventPrimInfo const>> const
+        &event_prim_info,
+    std::vector<std::set<clust::IntegralCluster>> const &local_clusters,
+    Index n_threads) {
+  if (event_prim_info.size() != local_clusters.size()) {
+    throw std::runtime_error(
+        "Error in make_shared_local_orbits: event_prim_info.size() != "
+        "local_clusters.size()");
+  }
+  std::vector<
+      std::shared_ptr<std::vector<std::set<clust::IntegralCluster>> const>>
+      local_orbits(event_prim_info.size());
+  parallel_for_chunks(event_prim_info.size(), n_threads,
+                      [&](Index chunk_index, Index begin, Index end) {
+                        for (Index i = begin; i < end; ++i) {
+                          local_orbits[i] =
+                              event_prim_info[i]->make_shared_local_orbits(
+                                  local_clusters[i]);
+                        }
+                      });
   return local_orbits;
 }
 
@@ -66,6 +302,28 @@ OccEventSupercellInfo::OccEventSupercellInfo(
   occ_final = cluster_occupation.second[1];
 }
 
+/// \brief Constructor, using a precomputed event group
+///
+/// \param _event_prim_info The event
+/// \param _supercell The supercell
+/// \param _supercellsymop_symgroup_rep The SupercellSymOp rep of
+///     `_event_prim_info->invariant_group`, as would be made by
+///     `make_local_supercell_symgroup_rep`, for example by conjugating the
+///     group of an equivalent event (see OccEventSupercellInfoCache)
+OccEventSupercellInfo::OccEventSupercellInfo(
+    std::shared_ptr<OccEventPrimInfo const> const &_event_prim_info,
+    std::shared_ptr<Supercell const> const &_supercell,
+    std::vector<SupercellSymOp> const &_supercellsymop_symgroup_rep)
+    : event_prim_info(_event_prim_info),
+      supercell(_supercell),
+      supercellsymop_symgroup_rep(_supercellsymop_symgroup_rep) {
+  auto cluster_occupation = make_cluster_occupation(event_prim_info->event);
+  sites = to_index_vector(cluster_occupation.first,
+                          supercell->unitcellcoord_index_converter);
+  occ_init = cluster_occupation.second[0];
+  occ_final = cluster_occupation.second[1];
+}
+
 /// \brief Make canonical local environment configuration
 Configuration OccEventSupercellInfo::make_canonical_form(
     Configuration const &configuration) const {
@@ -76,12 +334,16 @@ Configuration OccEventSupercellInfo::make_canonical_form(
 /// \brief Make all configurations, equivalent as infinite crystals under prim
 ///     factor group operations, that fit into the same supercell, but are
 ///     inequivalent under the action of a local group.
+///
+/// \param motif The motif for the background configurations
+/// \param n_threads Number of threads used to make canonical forms. If <= 0,
+///     uses the number of hardware threads.
 std::set<Configuration>
 OccEventSupercellInfo::make_distinct_background_configurations(
-    Configuration const &motif) const {
+    Configuration const &motif, Index n_threads) const {
   return CASM::config::make_distinct_background_configurations(
       motif, supercell, sites, occ_init, occ_final,
-      supercellsymop_symgroup_rep);
+      supercellsymop_symgroup_rep, n_threads);
 }
 
 /// \brief Make configurations that are distinct perturbations of local clusters
@@ -100,11 +362,30 @@ OccEventSupercellInfo::make_distinct_local_perturbations(
         "Error in OccEventSupercellInfo::make_distinct_local_perturbations: "
         "background supercell does not match this supercell");
   }
-  auto local_orbits_as_indices = make_orbits_as_indices(
-      local_orbits, supercell->unitcellcoord_index_converter);
+  return this->make_distinct_local_perturbations(
+      background, SupercellOrbitSiteTable(supercell, local_orbits, false));
+}
+
+/// \brief Make configurations that are distinct perturbations of local
+/// clusters, using local orbits as supercell site indices
+///
+/// \param background The background configuration
+/// \param local_orbit_site_table Local-cluster orbits, as supercell site
+///     indices, constructed for this supercell with
+///     `include_translations=false`. The same table can be used for every
+///     background configuration in this supercell.
+std::set<Configuration>
+OccEventSupercellInfo::make_distinct_local_perturbations(
+    Configuration const &background,
+    SupercellOrbitSiteTable const &local_orbit_site_table) const {
+  if (background.supercell != supercell) {
+    throw std::runtime_error(
+        "Error in OccEventSupercellInfo::make_distinct_local_perturbations: "
+        "background supercell does not match this supercell");
+  }
   auto distinct_local_cluster_sites = make_distinct_local_cluster_sites(
       background, sites, occ_init, occ_final, supercellsymop_symgroup_rep,
-      local_orbits_as_indices);
+      local_orbit_site_table);
   return CASM::config::make_distinct_local_perturbations(
       background, sites, occ_init, occ_final, supercellsymop_symgroup_rep,
       distinct_local_cluster_sites);
@@ -128,7 +409,7 @@ OccEventSupercellInfo::make_distinct_local_perturbations(
         "background supercell does not match this supercell");
   }
   return this->make_distinct_local_perturbations(
-      background, event_prim_info->make_local_orbits(local_clusters));
+      background, *event_prim_info->make_shared_local_orbits(local_clusters));
 }
 
 /// \brief Make configurations that are distinct perturbations of local
@@ -139,21 +420,58 @@ OccEventSupercellInfo::make_distinct_local_perturbations(
 ///     of the background configuration. These orbits are broken based on the
 ///     background configuration symmetry to find all the distinct local
 ///     environment perturbations.
+/// \param n_threads Number of threads used to make perturbations of
+///     distinct background configurations. If <= 0, uses the number of
+///     hardware threads. The result does not depend on the number of
+///     threads.
+///
+/// Notes:
+/// - The local orbits are converted to supercell site indices once, and
+///   they and the event group are shared, read-only, by all threads.
+/// - The distinct local clusters of each background are found in parallel
+///   over backgrounds, and then perturbations are made in parallel over
+///   (background, distinct local cluster) work units, so that there is
+///   work for many threads even if there are few distinct backgrounds.
 std::set<Configuration>
 OccEventSupercellInfo::make_all_distinct_local_perturbations(
     Configuration const &motif,
-    std::vector<std::set<clust::IntegralCluster>> const &local_orbits) const {
+    std::vector<std::set<clust::IntegralCluster>> const &local_orbits,
+    Index n_threads) const {
   auto distinct_backgrounds =
-      this->make_distinct_background_configurations(motif);
-  std::set<Configuration> all;
+      this->make_distinct_background_configurations(motif, n_threads);
+  SupercellOrbitSiteTable local_orbit_site_table(supercell, local_orbits,
+                                                 false);
+
+  // distinct local clusters, by background
+  std::vector<Configuration const *> backgrounds;
   for (auto const &background : distinct_backgrounds) {
-    auto tmp =
-        this->make_distinct_local_perturbations(background, local_orbits);
-    for (auto const &c : tmp) {
-      all.insert(c);
+    backgrounds.push_back(&background);
+  }
+  std::vector<std::set<std::set<Index>>> distinct_local_cluster_sites(
+      backgrounds.size());
+  parallel_for_chunks(
+      backgrounds.size(), n_threads,
+      [&](Index chunk_index, Index begin, Index end) {
+        for (Index i = begin; i < end; ++i) {
+          distinct_local_cluster_sites[i] = make_distinct_local_cluster_sites(
+              *backgrounds[i], sites, occ_init, occ_final,
+              supercellsymop_symgroup_rep, local_orbit_site_table);
+        }
+      });
+
+  // perturbations, by (background, distinct local cluster)
+  std::vector<std::pair<Index, std::set<Index> const *>> units;
+  for (Index i = 0; i < backgrounds.size(); ++i) {
+    for (auto const &local_cluster_sites : distinct_local_cluster_sites[i]) {
+      units.emplace_back(i, &local_cluster_sites);
     }
   }
-  return all;
+  return make_merged_in_parallel(units.size(), n_threads, [&](Index u) {
+    return CASM::config::make_distinct_local_perturbations(
+        *backgrounds[units[u].first], sites, occ_init, occ_final,
+        supercellsymop_symgroup_rep,
+        std::set<std::set<Index>>({*units[u].second}));
+  });
 }
 
 /// \brief Generate local-cluster orbits and make configurations that are
@@ -165,20 +483,32 @@ OccEventSupercellInfo::make_all_distinct_local_perturbations(
 ///     without consideration of the background configuration. These orbits
 ///     are broken based on the background configuration symmetry to find
 ///     all the distinct local environment perturbations.
+/// \param n_threads Number of threads used to make perturbations of
+///     distinct background configurations. If <= 0, uses the number of
+///     hardware threads.
 std::set<Configuration>
 OccEventSupercellInfo::make_all_distinct_local_perturbations(
     Configuration const &motif,
-    std::set<clust::IntegralCluster> const &local_clusters) const {
+    std::set<clust::IntegralCluster> const &local_clusters,
+    Index n_threads) const {
   return this->make_all_distinct_local_perturbations(
-      motif, event_prim_info->make_local_orbits(local_clusters));
+      motif, *event_prim_info->make_shared_local_orbits(local_clusters),
+      n_threads);
 }
 
 /// \brief Generate local-cluster orbits and make configurations that are
 ///     distinct perturbations of sites within a cutoff radius of sites
 ///     in the event
+///
+/// \param motif Used to generate distinct background configuration
+/// \param cutoff_radius Sites within this distance of event sites are
+///     perturbed
+/// \param n_threads Number of threads used to make perturbations of
+///     distinct background configurations. If <= 0, uses the number of
+///     hardware threads.
 std::set<Configuration>
 OccEventSupercellInfo::make_all_distinct_local_perturbations(
-    Configuration const &motif, double cutoff_radius) const {
+    Configuration const &motif, double cutoff_radius, Index n_threads) const {
   // get sites using cutoff_radius_neighborhood
   clust::CandidateSitesFunction f = clust::cutoff_radius_neighborhood(
       make_cluster(event_prim_info->event), cutoff_radius);
@@ -192,20 +522,269 @@ OccEventSupercellInfo::make_all_distinct_local_perturbations(
 
   // get distinct backgrounds
   auto distinct_backgrounds =
-      this->make_distinct_background_configurations(motif);
+      this->make_distinct_background_configurations(motif, n_threads);
 
   // for each background, enumerate local occupations
-  std::set<Configuration> distinct_local_perturbations;
+  std::vector<Configuration const *> backgrounds;
   for (auto const &background : distinct_backgrounds) {
-    ConfigEnumAllOccupations enumerator(background, site_indices);
+    backgrounds.push_back(&background);
+  }
+  return make_merged_in_parallel(backgrounds.size(), n_threads, [&](Index i) {
+    std::set<Configuration> distinct_local_perturbations;
+    ConfigEnumAllOccupations enumerator(*backgrounds[i], site_indices);
     while (enumerator.is_valid()) {
-      distinct_local_perturbations.emplace(
-          config::make_canonical_form(enumerator.value(), this->sites, occ_init,
-                                      occ_final, supercellsymop_symgroup_rep));
+      distinct_local_perturbations.emplace(config::make_canonical_form(
+          enumerator.value(), this->sites, occ_init, occ_final,
+          supercellsymop_symgroup_rep));
       enumerator.advance();
     }
+    return distinct_local_perturbations;
+  });
+}
+
+/// \brief Constructor
+///
+/// \param _prim The prim of all events and supercells
+OccEventSupercellInfoCache::OccEventSupercellInfoCache(
+    std::shared_ptr<Prim const> const &_prim)
+    : m_prim(_prim),
+      m_occevent_symgroup_rep(make_shared_occevent_symgroup_rep(m_prim)),
+      m_orbit_cache(*m_occevent_symgroup_rep) {}
+
+/// \brief The prim
+std::shared_ptr<Prim const> const &OccEventSupercellInfoCache::prim() const {
+  return m_prim;
+}
+
+/// \brief Return the OccEventSupercellInfo of an event in a supercell
+///
+/// \param event The event. The result `event_prim_info->event` is `event`,
+///     as given.
+/// \param supercell The supercell, with the same prim
+///
+/// \returns The same OccEventSupercellInfo as constructed directly, with
+///     `supercellsymop_symgroup_rep` found by conjugating the orbit
+///     prototype's group if possible.
+std::shared_ptr<OccEventSupercellInfo const>
+OccEventSupercellInfoCache::supercell_info(
+    occ_events::OccEvent const &event,
+    std::shared_ptr<Supercell const> const &supercell) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  EventSupercell key(event, supercell);
+  auto it = m_supercell_info.find(key);
+  if (it != m_supercell_info.end()) {
+    return it->second;
+  }
+
+  EventData data = _event_data(event);
+  auto prim_info = std::make_shared<OccEventPrimInfo const>(m_prim, event);
+  std::shared_ptr<OccEventSupercellInfo const> info;
+  std::optional<SupercellSymOp> op = _prototype_op(data, supercell);
+  if (op.has_value()) {
+    auto const &prototype_group =
+        _prototype_supercell_info(data.orbit_index, supercell)
+            ->supercellsymop_symgroup_rep;
+    SupercellSymOp op_inv = op->inverse();
+    std::vector<SupercellSymOp> event_group;
+    for (auto const &h : prototype_group) {
+      event_group.push_back((*op) * h * op_inv);
+    }
+    // each prim factor group operation appears once, so this is the order
+    // of make_local_supercell_symgroup_rep
+    std::sort(event_group.begin(), event_group.end());
+    info = std::make_shared<OccEventSupercellInfo const>(prim_info, supercell,
+                                                         event_group);
+  } else {
+    info = std::make_shared<OccEventSupercellInfo const>(prim_info, supercell);
+  }
+  return m_supercell_info.emplace(key, info).first->second;
+}
+
+/// \brief Return the local-cluster orbits of an event, as supercell site
+///     indices, from local clusters of the event orbit prototype
+///
+/// \param event The event
+/// \param supercell The supercell, with the same prim
+/// \param prototype_local_clusters Local clusters of the orbit prototype,
+///     `prototype_prim_info(event)->event`, used to generate its
+///     local-cluster orbits
+///
+/// \returns The local-cluster orbits of `event`, which are the images of
+///     the prototype local-cluster orbits, as supercell site indices, as
+///     for a SupercellOrbitSiteTable constructed with
+///     `include_translations=false`
+std::shared_ptr<SupercellOrbitSiteTable const>
+OccEventSupercellInfoCache::local_orbit_site_table(
+    occ_events::OccEvent const &event,
+    std::shared_ptr<Supercell const> const &supercell,
+    std::set<clust::IntegralCluster> const &prototype_local_clusters) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  EventData data = _event_data(event);
+  auto key = std::make_pair(EventSupercell(data.event, supercell),
+                            prototype_local_clusters);
+  auto it = m_tables.find(key);
+  if (it != m_tables.end()) {
+    return it->second;
+  }
+
+  std::shared_ptr<SupercellOrbitSiteTable const> table;
+  std::optional<SupercellSymOp> op = _prototype_op(data, supercell);
+  if (op.has_value()) {
+    auto prototype_key = std::make_pair(
+        OrbitSupercell(data.orbit_index, supercell), prototype_local_clusters);
+    auto prototype_it = m_prototype_tables.find(prototype_key);
+    if (prototype_it == m_prototype_tables.end()) {
+      auto prototype_table = std::make_shared<SupercellOrbitSiteTable const>(
+          supercell,
+          *_prototype_prim_info(data.orbit_index)
+               ->make_shared_local_orbits(prototype_local_clusters),
+          false);
+      prototype_it =
+          m_prototype_tables.emplace(prototype_key, prototype_table).first;
+    }
+    table = std::make_shared<SupercellOrbitSiteTable const>(
+        copy_apply(*op, *prototype_it->second));
+  } else {
+    table = std::make_shared<SupercellOrbitSiteTable const>(
+        supercell, _prim_local_orbits(data, prototype_local_clusters), false);
+  }
+  return m_tables.emplace(key, table).first->second;
+}
+
+/// \brief Return the supercell operation, g, that derives data for an
+///     event from the orbit prototype, if one exists
+///
+/// \returns The first operation, in order of supercell factor group index,
+///     such that `event == g * prototype`, where `prototype` is
+///     `prototype_prim_info(event)->event`; or std::nullopt if no supercell
+///     operation transforms the prototype into the event.
+std::optional<SupercellSymOp> OccEventSupercellInfoCache::prototype_op(
+    occ_events::OccEvent const &event,
+    std::shared_ptr<Supercell const> const &supercell) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return _prototype_op(_event_data(event), supercell);
+}
+
+/// \brief Return the OccEventPrimInfo of the prototype of the orbit
+///     containing an event
+std::shared_ptr<OccEventPrimInfo const>
+OccEventSupercellInfoCache::prototype_prim_info(
+    occ_events::OccEvent const &event) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return _prototype_prim_info(_event_data(event).orbit_index);
+}
+
+/// \brief Clear all cached data
+void OccEventSupercellInfoCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_orbit_cache = occ_events::PrimPeriodicOccEventOrbitCache(
+      *m_occevent_symgroup_rep);
+  m_prototype_info.clear();
+  m_prototype_supercell_info.clear();
+  m_supercell_info.clear();
+  m_prototype_tables.clear();
+  m_tables.clear();
+}
+
+/// \brief Standardize an event and find its orbit (requires lock)
+OccEventSupercellInfoCache::EventData OccEventSupercellInfoCache::_event_data(
+    occ_events::OccEvent const &event) {
+  EventData data;
+  data.event = event;
+  standardize(data.event);
+  data.orbit_index = m_orbit_cache.orbit_index(data.event);
+  return data;
+}
+
+/// \brief Prototype OccEventPrimInfo for an orbit (requires lock)
+std::shared_ptr<OccEventPrimInfo const> const &
+OccEventSupercellInfoCache::_prototype_prim_info(Index orbit_index) {
+  auto it = m_prototype_info.find(orbit_index);
+  if (it == m_prototype_info.end()) {
+    occ_events::OccEvent const &prototype =
+        *m_orbit_cache.orbits()[orbit_index].rbegin();
+    it = m_prototype_info
+             .emplace(orbit_index,
+                      std::make_shared<OccEventPrimInfo const>(m_prim,
+                                                               prototype))
+             .first;
+  }
+  return it->second;
+}
+
+/// \brief Prototype OccEventSupercellInfo for an orbit (requires lock)
+std::shared_ptr<OccEventSupercellInfo const> const &
+OccEventSupercellInfoCache::_prototype_supercell_info(
+    Index orbit_index, std::shared_ptr<Supercell const> const &supercell) {
+  OrbitSupercell key(orbit_index, supercell);
+  auto it = m_prototype_supercell_info.find(key);
+  if (it == m_prototype_supercell_info.end()) {
+    auto info = std::make_shared<OccEventSupercellInfo const>(
+        _prototype_prim_info(orbit_index), supercell);
+    it = m_prototype_supercell_info.emplace(key, info).first;
+  }
+  return it->second;
+}
+
+/// \brief Supercell operation transforming the orbit prototype into
+///     `data.event` (requires lock)
+std::optional<SupercellSymOp> OccEventSupercellInfoCache::_prototype_op(
+    EventData const &data, std::shared_ptr<Supercell const> const &supercell) {
+  if (supercell->prim != m_prim) {
+    throw std::runtime_error(
+        "Error in OccEventSupercellInfoCache: supercell has a different prim");
+  }
+  occ_events::OccEvent const &prototype =
+      *m_orbit_cache.orbits()[data.orbit_index].rbegin();
+  Eigen::Matrix3d const &L = m_prim->basicstructure->lattice().lat_column_mat();
+  SymGroup const &supercell_factor_group = *supercell->sym_info().factor_group;
+  for (Index i = 0; i < supercell_factor_group.element.size(); ++i) {
+    Index prim_fg_index = supercell_factor_group.head_group_index[i];
+    std::optional<xtal::UnitCell> frac = find_translation(
+        (*m_occevent_symgroup_rep)[prim_fg_index], prototype, data.event);
+    if (frac.has_value()) {
+      Eigen::Vector3d translation_cart = L * frac->cast<double>();
+      return SupercellSymOp(supercell, i, translation_cart);
+    }
+  }
+  return std::nullopt;
+}
+
+/// \brief Local-cluster orbits of `data.event`, as images of the orbit
+///     prototype local-cluster orbits under a prim factor group operation
+///     and lattice translation (requires lock)
+std::vector<std::set<clust::IntegralCluster>>
+OccEventSupercellInfoCache::_prim_local_orbits(
+    EventData const &data,
+    std::set<clust::IntegralCluster> const &prototype_local_clusters) {
+  occ_events::OccEvent const &prototype =
+      *m_orbit_cache.orbits()[data.orbit_index].rbegin();
+  auto const &prototype_orbits =
+      *_prototype_prim_info(data.orbit_index)
+           ->make_shared_local_orbits(prototype_local_clusters);
+  auto const &unitcellcoord_rep = m_prim->sym_info.unitcellcoord_symgroup_rep;
+  for (Index k = 0; k < m_occevent_symgroup_rep->size(); ++k) {
+    std::optional<xtal::UnitCell> frac = find_translation(
+        (*m_occevent_symgroup_rep)[k], prototype, data.event);
+    if (!frac.has_value()) {
+      continue;
+    }
+    std::vector<std::set<clust::IntegralCluster>> orbits;
+    for (auto const &prototype_orbit : prototype_orbits) {
+      std::set<clust::IntegralCluster> orbit;
+      for (auto const &cluster : prototype_orbit) {
+        clust::IntegralCluster image =
+            copy_apply(unitcellcoord_rep[k], cluster);
+        image += *frac;
+        orbit.insert(image);
+      }
+      orbits.push_back(orbit);
+    }
+    return orbits;
   }
-  return distinct_local_perturbations;
+  throw std::runtime_error(
+      "Error in OccEventSupercellInfoCache: event is not equivalent to its "
+      "orbit prototype");
 }
 
 }  // namespace config
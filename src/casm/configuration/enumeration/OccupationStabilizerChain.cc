@@ -0,0 +1,178 @@
+#include "casm/configuration/enumeration/OccupationStabilizerChain.hh"
+
+#include <stdexcept>
+
+#include "casm/configuration/ConfigIsEquivalent.hh"
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/canonical_form.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Constructor
+///
+/// \param background The background configuration. Occupation on `sites`
+///     is ignored.
+/// \param sites The sites where occupation is enumerated
+/// \param group Supercell operations, such as all supercell operations or
+///     the canonical subgroup of an enumeration. Only operations that leave
+///     the background continuous DoF values and occupation on sites not in
+///     `sites` invariant, and do not mix `sites` and other sites, are kept.
+OccupationStabilizerChain::OccupationStabilizerChain(
+    Configuration const &background, std::set<Index> const &sites,
+    std::vector<SupercellSymOp> const &group)
+    : m_sites(sites.begin(), sites.end()) {
+  auto const &supercell = background.supercell;
+  auto const &converter = supercell->unitcellcoord_index_converter;
+  PrimSymInfo const &prim_sym_info = supercell->prim->sym_info;
+  Index n_sites = converter.total_sites();
+  m_occ_remap_table = &prim_sym_info.occ_remap_table;
+  m_n_sublat = supercell->prim->basicstructure->basis().size();
+  m_max_n_occupants = prim_sym_info.max_n_occupants;
+
+  m_position.resize(n_sites, -1);
+  for (Index p = 0; p < Index(m_sites.size()); ++p) {
+    m_position[m_sites[p]] = p;
+  }
+  m_sublattice.resize(n_sites);
+  for (Index l = 0; l < n_sites; ++l) {
+    m_sublattice[l] = converter(l).sublattice();
+  }
+
+  // continuous DoF of the background are compared as a whole
+  std::set<std::string> continuous_dofs;
+  for (auto const &pair : background.dof_values.global_dof_values) {
+    continuous_dofs.insert(pair.first);
+  }
+  for (auto const &pair : background.dof_values.local_dof_values) {
+    continuous_dofs.insert(pair.first);
+  }
+  ConfigIsEquivalent continuous_dofs_are_equal(background, continuous_dofs);
+
+  Eigen::VectorXi const &occupation = background.dof_values.occupation;
+  sym_info::Permutation perm;
+  for (SupercellSymOp const &op : group) {
+    if (op.supercell() != supercell && *op.supercell() != *supercell) {
+      throw std::runtime_error(
+          "Error constructing OccupationStabilizerChain: supercell mismatch");
+    }
+    if (!site_indices_are_invariant(op, sites)) {
+      continue;
+    }
+    SupercellSymOpHandle handle(op);
+    handle.combined_permute(perm);
+    Index fg = handle.prim_factor_group_index();
+    bool is_invariant = true;
+    for (Index l = 0; l < n_sites && is_invariant; ++l) {
+      if (m_position[l] != -1) {
+        continue;
+      }
+      Index from = perm[l];
+      is_invariant = prim_sym_info.occ_remap(fg, m_sublattice[from])
+                         [occupation(from)] == occupation(l);
+    }
+    if (!is_invariant ||
+        (!continuous_dofs.empty() && !continuous_dofs_are_equal(op))) {
+      continue;
+    }
+    m_group.push_back(op);
+    sym_info::Permutation inverse(perm.size());
+    for (Index l = 0; l < Index(perm.size()); ++l) {
+      inverse[perm[l]] = l;
+    }
+    m_permute.push_back(perm);
+    m_inverse_permute.push_back(std::move(inverse));
+    m_prim_factor_group_index.push_back(fg);
+  }
+
+  m_chain.resize(m_sites.size() + 1);
+  for (Index k = 0; k < Index(m_group.size()); ++k) {
+    m_chain.back().push_back(k);
+  }
+}
+
+/// \brief The operations that leave the background invariant on sites not
+///     in `sites`, and do not mix `sites` and other sites
+std::vector<SupercellSymOp> const &OccupationStabilizerChain::group() const {
+  return m_group;
+}
+
+/// \brief Refine for new occupation values on `sites`, and return the
+///     indices in `group()` of the operations that leave the configuration
+///     invariant
+///
+/// \param values Occupation on `sites`, in order of increasing site index,
+///     as by `ConfigEnumAllOccupations::state()`
+///
+/// Levels above the highest position where `values` differs from the
+/// previous values are re-used.
+std::vector<Index> const &OccupationStabilizerChain::update(
+    std::vector<int> const &values) {
+  Index n = m_sites.size();
+  if (Index(values.size()) != n) {
+    throw std::runtime_error(
+        "Error in OccupationStabilizerChain::update: values size does not "
+        "match the number of sites");
+  }
+  Index top = n - 1;
+  if (Index(m_values.size()) == n) {
+    while (top >= 0 && values[top] == m_values[top]) {
+      --top;
+    }
+  }
+  m_values = values;
+  for (Index p = top; p >= 0; --p) {
+    std::vector<Index> &level = m_chain[p];
+    level.clear();
+    for (Index k : m_chain[p + 1]) {
+      if (_is_consistent(k, p)) {
+        level.push_back(k);
+      }
+    }
+  }
+  return m_chain[0];
+}
+
+/// \brief Make the invariant subgroup of the last values passed to `update`
+std::vector<SupercellSymOp> OccupationStabilizerChain::make_invariant_subgroup()
+    const {
+  std::vector<SupercellSymOp> subgroup;
+  for (Index k : m_chain[0]) {
+    subgroup.push_back(m_group[k]);
+  }
+  return subgroup;
+}
+
+/// \brief Return true if group operation `k` is consistent with the value
+///     at position `p`, given values at positions `> p`
+///
+/// Checks the pairs `(i, perm[i])` in which site `m_sites[p]` is the later
+/// assigned of the two sites, which are all pairs not checked at higher
+/// levels.
+bool OccupationStabilizerChain::_is_consistent(Index k, Index p) const {
+  Index s = m_sites[p];
+  Index fg = m_prim_factor_group_index[k];
+  auto value_after = [&](Index from) {
+    std::int32_t const *remap =
+        m_occ_remap_table->data() +
+        (fg * m_n_sublat + m_sublattice[from]) * m_max_n_occupants;
+    return remap[m_values[m_position[from]]];
+  };
+
+  // site s receives the value of site `from`
+  Index from = m_permute[k][s];
+  if (m_position[from] >= p && value_after(from) != m_values[p]) {
+    return false;
+  }
+  // the value of site s is permuted onto site `to`
+  Index to = m_inverse_permute[k][s];
+  if (to != s && m_position[to] > p &&
+      m_values[m_position[to]] != value_after(s)) {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace config
+}  // namespace CASM
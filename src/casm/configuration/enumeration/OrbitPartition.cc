@@ -0,0 +1,202 @@
+#include "casm/configuration/enumeration/OrbitPartition.hh"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Constructor, with each element in its own set
+DisjointSets::DisjointSets(Index _n_elements)
+    : m_parent(_n_elements), m_size(_n_elements, 1), m_n_sets(_n_elements) {
+  std::iota(m_parent.begin(), m_parent.end(), 0);
+}
+
+/// \brief Return the root element of the set containing element i
+Index DisjointSets::find(Index i) {
+  while (m_parent[i] != i) {
+    m_parent[i] = m_parent[m_parent[i]];
+    i = m_parent[i];
+  }
+  return i;
+}
+
+/// \brief Join the sets containing elements i and j, return true if they
+///     were different sets
+bool DisjointSets::join(Index i, Index j) {
+  i = find(i);
+  j = find(j);
+  if (i == j) {
+    return false;
+  }
+  if (m_size[i] < m_size[j]) {
+    std::swap(i, j);
+  }
+  m_parent[j] = i;
+  m_size[i] += m_size[j];
+  --m_n_sets;
+  return true;
+}
+
+/// \brief Partition site indices into orbits, applying only the generators
+///     of a group
+///
+/// \param n_sites Number of sites
+/// \param generators_indices_rep Permutations that transform linear site
+///     indices (site `l` is transformed to site `perm[l]`), for the
+///     generators of a group. Any generating set can be used, including all
+///     elements of the group.
+///
+/// \returns The orbits, each with site indices in ascending order, sorted by
+///     their first site index
+///
+/// Cost is O(n_sites * n_generators * alpha(n_sites)), instead of
+/// O(n_sites * group_size) to apply every group element to every site.
+std::vector<std::vector<Index>> make_site_orbits(
+    Index n_sites,
+    std::vector<sym_info::Permutation> const &generators_indices_rep) {
+  DisjointSets sets(n_sites);
+  for (auto const &perm : generators_indices_rep) {
+    if (perm.size() != n_sites) {
+      throw std::runtime_error(
+          "Error in make_site_orbits: permutation size does not match "
+          "n_sites");
+    }
+    for (Index l = 0; l < n_sites; ++l) {
+      sets.join(l, perm[l]);
+    }
+  }
+
+  std::vector<std::vector<Index>> orbits;
+  std::vector<Index> orbit_index(n_sites, -1);
+  for (Index l = 0; l < n_sites; ++l) {
+    Index root = sets.find(l);
+    if (orbit_index[root] == -1) {
+      orbit_index[root] = orbits.size();
+      orbits.emplace_back();
+    }
+    orbits[orbit_index[root]].push_back(l);
+  }
+  return orbits;
+}
+
+/// \brief Partition supercell site indices into orbits, applying only the
+///     generators of a group
+///
+/// \param generators The generators of a group of SupercellSymOp, all in
+///     the same supercell. Must not be empty.
+///
+/// \returns The orbits, as by `make_site_orbits(n_sites,
+///     make_indices_group_rep(generators))`
+std::vector<std::vector<Index>> make_site_orbits(
+    std::vector<SupercellSymOp> const &generators) {
+  if (generators.empty()) {
+    throw std::runtime_error("Error in make_site_orbits: generators is empty");
+  }
+  Index n_sites =
+      generators[0].supercell()->unitcellcoord_index_converter.total_sites();
+  return make_site_orbits(n_sites, make_indices_group_rep(generators));
+}
+
+/// \brief Partition clusters of sites into orbits, applying only the
+///     generators of a group, and return the canonical element of each
+///
+/// \param clusters Clusters of sites. Must be closed under the group: the
+///     image of every cluster under every generator must be one of the
+///     clusters. Duplicates are ignored.
+/// \param generators_indices_rep Permutations that transform linear site
+///     indices (site `l` is transformed to site `perm[l]`), for the
+///     generators of a group. Any generating set can be used, including all
+///     elements of the group.
+///
+/// \returns The canonical element of each orbit, in ascending order. The
+///     canonical element is the greatest, the same as
+///     `group::make_canonical_element` with `std::less` using all group
+///     elements.
+///
+/// Cost is O(n_clusters * n_generators * (cluster_size * log(n_clusters) +
+/// alpha(n_clusters))), instead of applying every group element.
+std::vector<SiteSet> make_cluster_orbit_generators(
+    std::vector<SiteSet> clusters,
+    std::vector<sym_info::Permutation> const &generators_indices_rep) {
+  std::sort(clusters.begin(), clusters.end());
+  clusters.erase(std::unique(clusters.begin(), clusters.end()),
+                 clusters.end());
+
+  DisjointSets sets(clusters.size());
+  SiteSet image;
+  for (auto const &perm : generators_indices_rep) {
+    for (Index i = 0; i < clusters.size(); ++i) {
+      image.assign_permuted(perm, clusters[i]);
+      auto it = std::lower_bound(clusters.begin(), clusters.end(), image);
+      if (it == clusters.end() || *it != image) {
+        throw std::runtime_error(
+            "Error in make_cluster_orbit_generators: clusters are not closed "
+            "under the group");
+      }
+      sets.join(i, it - clusters.begin());
+    }
+  }
+
+  // clusters are sorted, so the last element of each set is the greatest
+  std::vector<Index> greatest(clusters.size(), -1);
+  for (Index i = 0; i < clusters.size(); ++i) {
+    greatest[sets.find(i)] = i;
+  }
+  std::vector<SiteSet> generators;
+  generators.reserve(sets.n_sets());
+  for (Index i = 0; i < clusters.size(); ++i) {
+    if (greatest[i] != -1) {
+      generators.push_back(clusters[greatest[i]]);
+    }
+  }
+  std::sort(generators.begin(), generators.end());
+  return generators;
+}
+
+/// \brief Partition clusters of sites into orbits, applying only the
+///     generators of a group, and return the canonical element of each
+///
+/// \param clusters Clusters of sites, closed under the group
+/// \param generators The generators of a group of SupercellSymOp, in the
+///     supercell of the site indices
+///
+/// \returns The same result as `group::make_orbit_generators` with
+///     `std::less`, using all group elements
+std::set<std::set<Index>> make_cluster_orbit_generators(
+    std::set<std::set<Index>> const &clusters,
+    std::vector<SupercellSymOp> const &generators) {
+  std::vector<SiteSet> site_sets;
+  site_sets.reserve(clusters.size());
+  for (auto const &cluster : clusters) {
+    site_sets.emplace_back(cluster);
+  }
+  std::set<std::set<Index>> result;
+  for (auto const &sites : make_cluster_orbit_generators(
+           std::move(site_sets), make_indices_group_rep(generators))) {
+    result.insert(sites.to_set());
+  }
+  return result;
+}
+
+/// \brief Make the permutations that transform linear site indices, for
+///     each operation
+///
+/// The result for `op` is `sym_info::inverse(op.combined_permute())`: site
+/// `l` is transformed to site `perm[l]`.
+std::vector<sym_info::Permutation> make_indices_group_rep(
+    std::vector<SupercellSymOp> const &group) {
+  std::vector<sym_info::Permutation> indices_group_rep;
+  indices_group_rep.reserve(group.size());
+  for (auto const &op : group) {
+    indices_group_rep.push_back(sym_info::inverse(op.combined_permute()));
+  }
+  return indices_group_rep;
+}
+
+}  // namespace config
+}  // namespace CASM
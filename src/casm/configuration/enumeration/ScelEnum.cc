@@ -0,0 +1,333 @@
+#include "casm/configuration/enumeration/ScelEnum.hh"
+
+#include <stdexcept>
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/CanonicalForm.hh"
+#include "casm/crystallography/Lattice.hh"
+#include "casm/crystallography/SymType.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// \brief Return the adjugate, `det(U) * U^-1`, of an integer matrix
+Eigen::Matrix3l make_adjugate(Eigen::Matrix3l const &U) {
+  Eigen::Matrix3l adj;
+  for (Index i = 0; i < 3; ++i) {
+    for (Index j = 0; j < 3; ++j) {
+      Index i1 = (j + 1) % 3, i2 = (j + 2) % 3;
+      Index j1 = (i + 1) % 3, j2 = (i + 2) % 3;
+      adj(i, j) = U(i1, j1) * U(i2, j2) - U(i1, j2) * U(i2, j1);
+    }
+  }
+  return adj;
+}
+
+/// \brief The enumeration order of H values: diagonal, then off-diagonal,
+///     lexicographically
+std::array<Index, 6> order_key(Eigen::Matrix3l const &H) {
+  return {H(0, 0), H(1, 1), H(2, 2), H(0, 1), H(0, 2), H(1, 2)};
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param prim The prim
+/// \param min_volume, max_volume The range of supercell volumes, `det(H)`,
+///     relative to the unit cell, to enumerate. Must satisfy
+///     `1 <= min_volume`.
+/// \param dirs A string indicating which unit cell lattice vectors to
+///     enumerate over. Some combination of 'a', 'b', and 'c', where 'a'
+///     indicates the first lattice vector of the unit cell, 'b' the second,
+///     and 'c' the third. Rows and columns of H for other vectors are the
+///     identity.
+/// \param unit_cell An integer transformation matrix, `U`, from the prim
+///     lattice to the unit cell from which supercells are generated. If
+///     std::nullopt, the identity matrix.
+/// \param diagonal_only If true, restrict H to diagonal matrices.
+/// \param fixed_shape If true, restrict H to diagonal matrices with
+///     equal diagonal coefficients for the vectors in `dirs`.
+/// \param shard_index, n_shards If `n_shards` > 1, only the distinct
+///     supercells with index `i` satisfying `i % n_shards == shard_index`
+///     are visited.
+ScelEnum::ScelEnum(std::shared_ptr<Prim const> const &prim, Index min_volume,
+                   Index max_volume, std::string dirs,
+                   std::optional<Eigen::Matrix3l> unit_cell,
+                   bool diagonal_only, bool fixed_shape, Index shard_index,
+                   Index n_shards)
+    : m_prim(throw_if_equal_to_nullptr(
+          prim, "Error in ScelEnum constructor: prim == nullptr")),
+      m_max_volume(max_volume),
+      m_unit_cell(unit_cell.value_or(Eigen::Matrix3l::Identity())),
+      m_unit_cell_det(m_unit_cell.determinant()),
+      m_enumerate({false, false, false}),
+      m_diagonal_only(diagonal_only || fixed_shape),
+      m_fixed_shape(fixed_shape),
+      m_shard_index(shard_index),
+      m_n_shards(n_shards),
+      m_n_canonical(0),
+      m_volume(min_volume - 1),
+      m_diagonal_index(0),
+      m_off_diagonal({0, 0, 0}),
+      m_is_valid(false) {
+  if (min_volume < 1) {
+    throw std::runtime_error("Error in ScelEnum: min_volume < 1");
+  }
+  if (n_shards < 1 || shard_index < 0 || shard_index >= n_shards) {
+    throw std::runtime_error(
+        "Error in ScelEnum: invalid shard_index or n_shards");
+  }
+  if (m_unit_cell_det == 0) {
+    throw std::runtime_error("Error in ScelEnum: unit_cell is singular");
+  }
+  if (dirs.empty()) {
+    throw std::runtime_error("Error in ScelEnum: dirs is empty");
+  }
+  for (char c : dirs) {
+    if (c < 'a' || c > 'c') {
+      throw std::runtime_error("Error in ScelEnum: invalid dirs \"" + dirs +
+                               "\"");
+    }
+    m_enumerate[c - 'a'] = true;
+  }
+
+  Eigen::Matrix3l adj = make_adjugate(m_unit_cell);
+  for (auto const &R :
+       make_frac_point_matrices(m_prim->basicstructure->lattice(),
+                                m_prim->sym_info.point_group->element)) {
+    m_ops.push_back(adj * R * m_unit_cell);
+  }
+
+  m_is_valid = _next_diagonal();
+  if (m_is_valid) {
+    _set_current();
+  }
+  _skip_not_allowed();
+}
+
+/// \brief The current canonical Supercell, constructed on first access
+std::shared_ptr<Supercell const> const &ScelEnum::value() const {
+  if (!m_value) {
+    m_value = make_shared_supercell(m_prim, m_transformation_matrix_to_super);
+  }
+  return m_value;
+}
+
+/// \brief The transformation matrix from the prim lattice to the current
+///     canonical Supercell lattice
+Eigen::Matrix3l const &ScelEnum::transformation_matrix_to_super() const {
+  return m_transformation_matrix_to_super;
+}
+
+/// \brief The current Hermite normal form matrix, `H`, such that the
+///     current superlattice is equivalent to `L * U * H`
+Eigen::Matrix3l const &ScelEnum::hermite_normal_form() const {
+  return m_current;
+}
+
+/// \brief The current volume, `det(H)`, relative to the unit cell
+Index ScelEnum::volume() const { return m_volume; }
+
+/// \brief Generate the next distinct supercell
+void ScelEnum::advance() {
+  m_is_valid = _increment();
+  _skip_not_allowed();
+}
+
+/// \brief Return true if `value` is valid, false if no more valid values
+bool ScelEnum::is_valid() const { return m_is_valid; }
+
+/// \brief Set m_diagonals to the allowed diagonals of H for m_volume
+void ScelEnum::_make_diagonals() {
+  m_diagonals.clear();
+  Index n = m_volume;
+  for (Index a = 1; a <= n; ++a) {
+    if (n % a != 0 || (a > 1 && !m_enumerate[0])) {
+      continue;
+    }
+    for (Index c = 1; c <= n / a; ++c) {
+      if ((n / a) % c != 0 || (c > 1 && !m_enumerate[1])) {
+        continue;
+      }
+      Index f = n / a / c;
+      if (f > 1 && !m_enumerate[2]) {
+        continue;
+      }
+      std::array<Index, 3> diagonal = {a, c, f};
+      if (m_fixed_shape) {
+        bool equal = true;
+        Index m = 0;
+        for (Index i = 0; i < 3; ++i) {
+          if (!m_enumerate[i]) {
+            continue;
+          }
+          if (m == 0) {
+            m = diagonal[i];
+          }
+          equal = equal && diagonal[i] == m;
+        }
+        if (!equal) {
+          continue;
+        }
+      }
+      m_diagonals.push_back(diagonal);
+    }
+  }
+}
+
+/// \brief Advance to the next allowed diagonal, starting the next volume
+///     if necessary, and return false if past the maximum volume
+bool ScelEnum::_next_diagonal() {
+  ++m_diagonal_index;
+  while (m_diagonal_index >= m_diagonals.size()) {
+    ++m_volume;
+    if (m_volume > m_max_volume) {
+      return false;
+    }
+    _make_diagonals();
+    m_diagonal_index = 0;
+  }
+  m_off_diagonal = {0, 0, 0};
+  return true;
+}
+
+/// \brief Set m_current from the counter state
+void ScelEnum::_set_current() {
+  auto const &diagonal = m_diagonals[m_diagonal_index];
+  m_current.setZero();
+  for (Index i = 0; i < 3; ++i) {
+    m_current(i, i) = diagonal[i];
+  }
+  m_current(0, 1) = m_off_diagonal[0];
+  m_current(0, 2) = m_off_diagonal[1];
+  m_current(1, 2) = m_off_diagonal[2];
+}
+
+/// \brief Increment the counter over H, and return true if the result is
+///     valid
+///
+/// The off-diagonal value `H(i, j)` is in `[0, H(i, i))` if both `i` and `j`
+/// are enumerated and not `m_diagonal_only`, and otherwise is 0. `H(1, 2)`
+/// varies fastest, then `H(0, 2)`, then `H(0, 1)`, then the diagonal.
+bool ScelEnum::_increment() {
+  auto const &diagonal = m_diagonals[m_diagonal_index];
+  auto bound = [&](Index i, Index j) -> Index {
+    if (m_diagonal_only || !m_enumerate[i] || !m_enumerate[j]) {
+      return 1;
+    }
+    return diagonal[i];
+  };
+  std::array<Index, 3> bounds = {bound(0, 1), bound(0, 2), bound(1, 2)};
+  for (Index k = 2; k >= 0; --k) {
+    if (++m_off_diagonal[k] < bounds[k]) {
+      _set_current();
+      return true;
+    }
+    m_off_diagonal[k] = 0;
+  }
+  if (!_next_diagonal()) {
+    return false;
+  }
+  _set_current();
+  return true;
+}
+
+/// \brief Return true if H is a value of the enumeration
+///
+/// H must already be in Hermite normal form.
+bool ScelEnum::_is_enumerated(Eigen::Matrix3l const &H) const {
+  Index m = 0;
+  for (Index i = 0; i < 3; ++i) {
+    if (!m_enumerate[i]) {
+      if (H(i, i) != 1) {
+        return false;
+      }
+      continue;
+    }
+    if (m_fixed_shape) {
+      if (m == 0) {
+        m = H(i, i);
+      } else if (H(i, i) != m) {
+        return false;
+      }
+    }
+  }
+  for (Index i = 0; i < 3; ++i) {
+    for (Index j = i + 1; j < 3; ++j) {
+      if (H(i, j) != 0 &&
+          (m_diagonal_only || !m_enumerate[i] || !m_enumerate[j])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// \brief Return true if no symmetrically equivalent value of the
+///     enumeration precedes m_current
+///
+/// For each point group operation, `R`, the lattice `L * U * H` is
+/// transformed to `L * U * (U^-1 * R * U * H)`. If `U^-1 * R * U * H` is an
+/// integer matrix, its Hermite normal form generates the same superlattice
+/// as the transformed lattice.
+bool ScelEnum::_is_canonical() const {
+  auto key = order_key(m_current);
+  for (auto const &op : m_ops) {
+    Eigen::Matrix3l M = op * m_current;
+    if (m_unit_cell_det != 1) {
+      bool is_integer = true;
+      for (Index i = 0; i < 9 && is_integer; ++i) {
+        is_integer = M(i) % m_unit_cell_det == 0;
+      }
+      if (!is_integer) {
+        continue;
+      }
+      M /= m_unit_cell_det;
+    }
+    Eigen::Matrix3l H = make_hnf(M);
+    if (order_key(H) < key && _is_enumerated(H)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Advance the counter until m_current is canonical and in the
+///     shard, or the enumeration is complete
+void ScelEnum::_skip_not_allowed() {
+  while (m_is_valid) {
+    if (_is_canonical()) {
+      ++m_n_canonical;
+      if ((m_n_canonical - 1) % m_n_shards == m_shard_index) {
+        _set_transformation_matrix_to_super();
+        m_value.reset();
+        return;
+      }
+    }
+    m_is_valid = _increment();
+  }
+}
+
+/// \brief Set the transformation matrix to the canonical supercell
+void ScelEnum::_set_transformation_matrix_to_super() {
+  xtal::Lattice const &prim_lattice = m_prim->basicstructure->lattice();
+  Eigen::Matrix3d S = prim_lattice.lat_column_mat() *
+                      (m_unit_cell * m_current).cast<double>();
+  xtal::Lattice superlattice(S, prim_lattice.tol());
+  superlattice.make_right_handed();
+  xtal::Lattice canonical_superlattice = xtal::canonical::equivalent(
+      superlattice, m_prim->sym_info.point_group->element,
+      superlattice.tol());
+  m_transformation_matrix_to_super = xtal::make_transformation_matrix_to_super(
+      prim_lattice, canonical_superlattice, prim_lattice.tol());
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,119 @@
+#include "casm/configuration/enumeration/SupercellOccEventTable.hh"
+
+#include <algorithm>
+
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/occ_events/OccEvent.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {  // anonymous
+
+/// \brief Copy orbits into vectors, keeping the order of each set
+std::vector<std::vector<occ_events::OccEvent>> to_vector_orbits(
+    std::vector<std::set<occ_events::OccEvent>> const &event_orbits) {
+  std::vector<std::vector<occ_events::OccEvent>> result;
+  for (auto const &orbit : event_orbits) {
+    result.emplace_back(orbit.begin(), orbit.end());
+  }
+  return result;
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _supercell The supercell
+/// \param event_orbits Prim periodic OccEvent orbits, with equivalents in
+///     the order they should be indexed, as from
+///     `occ_events::make_prim_periodic_equivalents`
+///
+/// Every trajectory of every event must have 2 positions.
+SupercellOccEventTable::SupercellOccEventTable(
+    std::shared_ptr<Supercell const> const &_supercell,
+    std::vector<std::vector<occ_events::OccEvent>> const &event_orbits)
+    : supercell(_supercell),
+      n_translations(supercell->unitcell_index_converter.total_sites()) {
+  auto const &unitcell_index_converter = supercell->unitcell_index_converter;
+  auto const &converter = supercell->unitcellcoord_index_converter;
+  Index n_sites = converter.total_sites();
+
+  std::vector<xtal::UnitCell> translations;
+  for (Index t = 0; t < n_translations; ++t) {
+    translations.push_back(unitcell_index_converter(t));
+  }
+
+  // event instances
+  event_offsets.push_back(0);
+  orbit_offsets.push_back(0);
+  for (auto const &orbit : event_orbits) {
+    for (auto const &event : orbit) {
+      auto cluster_occupation = occ_events::make_cluster_occupation(event);
+      clust::IntegralCluster const &cluster = cluster_occupation.first;
+      std::vector<int> const &event_occ_init = cluster_occupation.second[0];
+      std::vector<int> const &event_occ_final = cluster_occupation.second[1];
+      for (auto const &translation : translations) {
+        for (auto const &site : cluster) {
+          sites.push_back(converter(site + translation));
+        }
+        occ_init.insert(occ_init.end(), event_occ_init.begin(),
+                        event_occ_init.end());
+        occ_final.insert(occ_final.end(), event_occ_final.begin(),
+                         event_occ_final.end());
+        event_offsets.push_back(sites.size());
+      }
+    }
+    orbit_offsets.push_back(event_offsets.size() - 1);
+  }
+
+  // events involving each site, counting each aliased site once per event
+  std::vector<Index> unique_sites;
+  std::vector<Index> site_event_count(n_sites, 0);
+  for (Index r = 0; r < n_events(); ++r) {
+    unique_sites.assign(sites_begin(r), sites_end(r));
+    std::sort(unique_sites.begin(), unique_sites.end());
+    auto end = std::unique(unique_sites.begin(), unique_sites.end());
+    for (auto it = unique_sites.begin(); it != end; ++it) {
+      ++site_event_count[*it];
+    }
+  }
+  site_event_offsets.resize(n_sites + 1);
+  site_event_offsets[0] = 0;
+  for (Index l = 0; l < n_sites; ++l) {
+    site_event_offsets[l + 1] = site_event_offsets[l] + site_event_count[l];
+  }
+  site_events.resize(site_event_offsets[n_sites]);
+  std::vector<Index> next(site_event_offsets.begin(),
+                          site_event_offsets.end() - 1);
+  for (Index r = 0; r < n_events(); ++r) {
+    unique_sites.assign(sites_begin(r), sites_end(r));
+    std::sort(unique_sites.begin(), unique_sites.end());
+    auto end = std::unique(unique_sites.begin(), unique_sites.end());
+    for (auto it = unique_sites.begin(); it != end; ++it) {
+      site_events[next[*it]++] = r;
+    }
+  }
+}
+
+/// \brief Constructor
+///
+/// \param _supercell The supercell
+/// \param event_orbits Prim periodic OccEvent orbits, as from
+///     `occ_events::make_prim_periodic_occevent_orbits`. Equivalents are
+///     indexed in the order of each set.
+SupercellOccEventTable::SupercellOccEventTable(
+    std::shared_ptr<Supercell const> const &_supercell,
+    std::vector<std::set<occ_events::OccEvent>> const &event_orbits)
+    : SupercellOccEventTable(_supercell, to_vector_orbits(event_orbits)) {}
+
+/// \brief Orbit index of event `r`
+Index SupercellOccEventTable::orbit_index(Index r) const {
+  auto it = std::upper_bound(orbit_offsets.begin(), orbit_offsets.end(), r);
+  return std::distance(orbit_offsets.begin(), it) - 1;
+}
+
+}  // namespace config
+}  // namespace CASM
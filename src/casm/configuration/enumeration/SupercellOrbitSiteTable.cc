@@ -0,0 +1,98 @@
+#include "casm/configuration/enumeration/SupercellOrbitSiteTable.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Constructor
+///
+/// \param _supercell The supercell
+/// \param orbits Cluster orbits in the infinite crystal
+/// \param include_translations If true, include all supercell translations
+///     of each equivalent cluster, as for prim periodic orbits. If false,
+///     only the equivalent clusters are included, as for local-cluster
+///     orbits.
+SupercellOrbitSiteTable::SupercellOrbitSiteTable(
+    std::shared_ptr<Supercell const> const &_supercell,
+    std::vector<std::set<clust::IntegralCluster>> const &orbits,
+    bool include_translations)
+    : supercell(_supercell),
+      n_translations(include_translations
+                         ? supercell->unitcell_index_converter.total_sites()
+                         : 1) {
+  auto const &unitcell_index_converter = supercell->unitcell_index_converter;
+  auto const &converter = supercell->unitcellcoord_index_converter;
+
+  std::vector<xtal::UnitCell> translations;
+  if (include_translations) {
+    for (Index t = 0; t < n_translations; ++t) {
+      translations.push_back(unitcell_index_converter(t));
+    }
+  } else {
+    translations.push_back(xtal::UnitCell(0, 0, 0));
+  }
+
+  cluster_offsets.push_back(0);
+  orbit_offsets.push_back(0);
+  for (auto const &orbit : orbits) {
+    for (auto const &cluster : orbit) {
+      for (auto const &translation : translations) {
+        Index begin = sites.size();
+        for (auto const &site : cluster) {
+          sites.push_back(converter(site + translation));
+        }
+        std::sort(sites.begin() + begin, sites.end());
+        cluster_offsets.push_back(sites.size());
+      }
+    }
+    orbit_offsets.push_back(cluster_offsets.size() - 1);
+  }
+}
+
+/// \brief Apply a symmetry operation to the clusters of a
+///     SupercellOrbitSiteTable
+///
+/// Each cluster is replaced by its image under `op`, with site indices
+/// sorted again. Offsets are unchanged, so cluster `row(o, e, t)` of the
+/// result is the image of cluster `row(o, e, t)` of the input, and each
+/// orbit of the result is the image of the same orbit of the input. This
+/// gives the local-cluster orbits of an equivalent event from those of a
+/// prototype event, without converting clusters to site indices again.
+///
+/// \param op A symmetry operation of `table.supercell`
+/// \param table The table to transform
+SupercellOrbitSiteTable &apply(SupercellSymOp const &op,
+                               SupercellOrbitSiteTable &table) {
+  if (*op.supercell() != *table.supercell) {
+    throw std::runtime_error(
+        "Error in apply(SupercellSymOp const &, SupercellOrbitSiteTable &): "
+        "supercells do not match");
+  }
+  sym_info::Permutation perm = sym_info::inverse(op.combined_permute());
+  for (Index &l : table.sites) {
+    l = perm[l];
+  }
+  for (Index r = 0; r < table.n_clusters(); ++r) {
+    std::sort(table.sites.begin() + table.cluster_offsets[r],
+              table.sites.begin() + table.cluster_offsets[r + 1]);
+  }
+  return table;
+}
+
+/// \brief Copy a SupercellOrbitSiteTable and apply a symmetry operation to
+///     its clusters
+SupercellOrbitSiteTable copy_apply(SupercellSymOp const &op,
+                                   SupercellOrbitSiteTable table) {
+  apply(op, table);
+  return table;
+}
+
+}  // namespace config
+}  // namespace CASM
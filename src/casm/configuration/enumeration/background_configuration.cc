@@ -1,9 +1,13 @@
 #include "casm/configuration/enumeration/background_configuration.hh"
 
+#include "casm/configuration/ConfigIsEquivalent.hh"
 #include "casm/configuration/Configuration.hh"
+#include "casm/configuration/OccCanonicalizer.hh"
+#include "casm/configuration/PackedOccupation.hh"
 #include "casm/configuration/SupercellSymOp.hh"
 #include "casm/configuration/canonical_form.hh"
 #include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/parallel.hh"
 
 // debug:
 #include "casm/casm_io/container/json_io.hh"
@@ -32,6 +36,145 @@ Configuration copy_apply_occ(Configuration configuration,
   return configuration;
 }
 
+namespace {  // anonymous
+
+/// \brief Makes canonical forms of configurations in the context of an
+///     occupation event, re-using comparison objects
+///
+/// The initial and final variants of each configuration are copied into
+/// storage held by the canonicalizer, and the ConfigIsEquivalent comparison
+/// objects for them, which hold the supercell's CombinedPermutationTable
+/// if available, are constructed once and rebound. Not thread safe; use
+/// one per thread.
+class EventCanonicalizer {
+ public:
+  EventCanonicalizer(Configuration const &configuration,
+                     std::vector<Index> const &_event_sites,
+                     std::vector<int> const &_occ_init,
+                     std::vector<int> const &_occ_final,
+                     std::vector<SupercellSymOp> const &_event_group)
+      : m_event_sites(_event_sites),
+        m_occ_init(_occ_init),
+        m_occ_final(_occ_final),
+        m_event_group(_event_group),
+        m_config_init(copy_apply_occ(configuration, _event_sites, _occ_init)),
+        m_config_final(
+            copy_apply_occ(configuration, _event_sites, _occ_final)),
+        m_is_init(m_config_init),
+        m_is_final(m_config_final) {}
+
+  EventCanonicalizer(EventCanonicalizer const &) = delete;
+  EventCanonicalizer &operator=(EventCanonicalizer const &) = delete;
+
+  /// \brief Make the canonical form, which must be in the same supercell
+  ///     as the configuration used to construct this
+  Configuration operator()(Configuration const &configuration) {
+    m_config_init.dof_values = configuration.dof_values;
+    apply_occ(m_config_init, m_event_sites, m_occ_init);
+    m_is_init.rebind(m_config_init);
+    m_config_final.dof_values = configuration.dof_values;
+    apply_occ(m_config_final, m_event_sites, m_occ_final);
+    m_is_final.rebind(m_config_final);
+    return _make_canonical_form();
+  }
+
+  /// \brief Make the canonical form of the configuration used to
+  ///     construct this
+  Configuration operator()() { return _make_canonical_form(); }
+
+ private:
+  // Single pass over event_group, comparing op*init and op*final to the
+  // greatest found so far in place, without constructing either
+  Configuration _make_canonical_form() const {
+    Configuration const *variants[2] = {&m_config_init, &m_config_final};
+    ConfigIsEquivalent const *is_equivalent[2] = {&m_is_init, &m_is_final};
+    auto best_op = m_event_group.begin();
+    Index best_variant = 0;
+    for (auto op = m_event_group.begin(); op != m_event_group.end(); ++op) {
+      for (Index v = 0; v < 2; ++v) {
+        // check if op*variant == best_op*best, store op*variant < best
+        ConfigIsEquivalent const &f = *is_equivalent[v];
+        if (!f(*op, *best_op, *variants[best_variant]) && !f.is_less()) {
+          best_op = op;
+          best_variant = v;
+        }
+      }
+    }
+    return copy_apply(*best_op, *variants[best_variant]);
+  }
+
+  std::vector<Index> const &m_event_sites;
+  std::vector<int> const &m_occ_init;
+  std::vector<int> const &m_occ_final;
+  std::vector<SupercellSymOp> const &m_event_group;
+  Configuration m_config_init;
+  Configuration m_config_final;
+  ConfigIsEquivalent m_is_init;
+  ConfigIsEquivalent m_is_final;
+};
+
+/// \brief Make the distinct canonical forms of configurations in the
+///     context of an occupation event, using multiple threads
+///
+/// Each chunk of `all` is made canonical with its own EventCanonicalizer and
+/// collected into its own `std::set<ValueType>`, and the sets are merged.
+/// ValueType is Configuration or OccConfiguration.
+template <typename ValueType>
+std::set<ValueType> _make_distinct_canonical_forms(
+    std::vector<Configuration> const &all, Index n_chunks,
+    std::vector<Index> const &event_sites, std::vector<int> const &occ_init,
+    std::vector<int> const &occ_final,
+    std::vector<SupercellSymOp> const &event_group) {
+  std::vector<std::set<ValueType>> chunk_results(n_chunks);
+  parallel_for_chunks(
+      all.size(), n_chunks, [&](Index chunk_index, Index begin, Index end) {
+        EventCanonicalizer canonicalizer(all[begin], event_sites, occ_init,
+                                         occ_final, event_group);
+        std::set<ValueType> &distinct = chunk_results[chunk_index];
+        for (Index i = begin; i < end; ++i) {
+          distinct.emplace(canonicalizer(all[i]));
+        }
+      });
+
+  std::set<ValueType> distinct = std::move(chunk_results[0]);
+  for (Index c = 1; c < n_chunks; ++c) {
+    distinct.merge(chunk_results[c]);
+  }
+  return distinct;
+}
+
+/// \brief Make the distinct canonical forms of all super configurations of
+///     `motif`, in the context of an occupation event, using multiple threads
+///
+/// Subsets of super configurations are made in parallel by
+/// `for_each_super_configuration_subset`, and each subset is made canonical
+/// in parallel and merged into the result as soon as it is made, so all
+/// super configurations are never held at once.
+template <typename ValueType>
+std::set<ValueType> _make_distinct_background_forms(
+    Configuration const &motif,
+    std::shared_ptr<Supercell const> const &supercell,
+    std::vector<Index> const &event_sites, std::vector<int> const &occ_init,
+    std::vector<int> const &occ_final,
+    std::vector<SupercellSymOp> const &event_group, Index n_threads) {
+  std::set<ValueType> distinct;
+  for_each_super_configuration_subset(
+      motif, supercell,
+      [&](Index subset_index, std::vector<Configuration> &subset) {
+        Index n_chunks = std::min<Index>(resolve_n_threads(n_threads),
+                                         std::max<Index>(subset.size(), 1));
+        std::set<ValueType> subset_distinct =
+            _make_distinct_canonical_forms<ValueType>(
+                subset, n_chunks, event_sites, occ_init, occ_final,
+                event_group);
+        distinct.merge(subset_distinct);
+      },
+      n_threads);
+  return distinct;
+}
+
+}  // namespace
+
 /// \brief Make the canonical form for a configuration in the context
 ///    of an occupation event
 ///
@@ -50,22 +193,8 @@ Configuration make_canonical_form(
     Configuration const &configuration, std::vector<Index> const &event_sites,
     std::vector<int> const &occ_init, std::vector<int> const &occ_final,
     std::vector<SupercellSymOp> const &event_group) {
-  auto begin = std::begin(event_group);
-  auto end = std::end(event_group);
-  Configuration config_init =
-      copy_apply_occ(configuration, event_sites, occ_init);
-  Configuration canonical_config_init =
-      make_canonical_form(config_init, begin, end);
-
-  Configuration config_final =
-      copy_apply_occ(configuration, event_sites, occ_final);
-  Configuration canonical_config_final =
-      make_canonical_form(config_final, begin, end);
-
-  if (canonical_config_final > canonical_config_init) {
-    return canonical_config_final;
-  }
-  return canonical_config_init;
+  return EventCanonicalizer(configuration, event_sites, occ_init, occ_final,
+                            event_group)();
 }
 
 /// \brief Make all configurations, equivalent as infinite crystals under prim
@@ -83,24 +212,38 @@ Configuration make_canonical_form(
 ///     the supercell of configuration and a local subgroup of the prim factor
 ///     group (for example a cluster group).
 ///
-/// \param The configuration symmetrically equivalent to the background
+/// \param n_threads Number of threads used to make super configurations and
+///     canonical forms. If <= 0, uses the number of hardware threads. The
+///     result does not depend on the number of threads.
+///
+/// \returns The configurations symmetrically equivalent to the background
 ///     configuration which form symmetrically distinct backgrounds for the
 ///     event.
+///
+/// Notes:
+/// - Super configurations are made and canonicalized one subset of
+///   `make_all_super_configurations_by_subsets` at a time, in parallel
+///   rounds, by `for_each_super_configuration_subset`
+/// - Each subset is split into contiguous chunks. Each thread makes
+///   canonical forms with its own EventCanonicalizer and collects them into
+///   its own set, and the sets are merged after all threads finish.
+/// - For prim with occupation DoF only, the sets hold OccConfiguration,
+///   which are much cheaper to compare than Configuration, and are converted
+///   once at the end.
 std::set<Configuration> make_distinct_background_configurations(
     Configuration const &motif,
     std::shared_ptr<Supercell const> const &supercell,
     std::vector<Index> const &event_sites, std::vector<int> const &occ_init,
     std::vector<int> const &occ_final,
-    std::vector<SupercellSymOp> const &event_group) {
-  std::vector<Configuration> all =
-      make_all_super_configurations(motif, supercell);
-
-  std::set<Configuration> distinct;
-  for (Configuration const &configuration : all) {
-    distinct.emplace(make_canonical_form(configuration, event_sites, occ_init,
-                                         occ_final, event_group));
+    std::vector<SupercellSymOp> const &event_group, Index n_threads) {
+  if (OccCanonicalizer::is_supported(*motif.supercell->prim)) {
+    return to_configurations(_make_distinct_background_forms<OccConfiguration>(
+        motif, supercell, event_sites, occ_init, occ_final, event_group,
+        n_threads));
   }
-  return distinct;
+  return _make_distinct_background_forms<Configuration>(
+      motif, supercell, event_sites, occ_init, occ_final, event_group,
+      n_threads);
 }
 
 }  // namespace config
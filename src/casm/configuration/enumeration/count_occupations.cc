@@ -0,0 +1,364 @@
+#include "casm/configuration/enumeration/count_occupations.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymInfo.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/parallel.hh"
+#include "casm/crystallography/BasicStructure.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {  // anonymous
+
+/// \brief Non-negative integer of arbitrary size
+///
+/// Stored as base 2^32 digits, least significant first, with no leading
+/// zero digits. Only the operations needed for counting are implemented.
+class BigCount {
+ public:
+  BigCount(std::uint32_t value = 0) {
+    if (value) {
+      m_digits.push_back(value);
+    }
+  }
+
+  bool is_zero() const { return m_digits.empty(); }
+
+  /// \brief Add `other * factor`
+  void add_product(BigCount const &other, std::uint32_t factor) {
+    if (other.is_zero() || factor == 0) {
+      return;
+    }
+    if (m_digits.size() < other.m_digits.size()) {
+      m_digits.resize(other.m_digits.size(), 0);
+    }
+    std::uint64_t carry = 0;
+    Index i = 0;
+    for (; i < Index(other.m_digits.size()); ++i) {
+      std::uint64_t value = std::uint64_t(other.m_digits[i]) * factor +
+                            m_digits[i] + carry;
+      m_digits[i] = std::uint32_t(value);
+      carry = value >> 32;
+    }
+    for (; carry && i < Index(m_digits.size()); ++i) {
+      std::uint64_t value = std::uint64_t(m_digits[i]) + carry;
+      m_digits[i] = std::uint32_t(value);
+      carry = value >> 32;
+    }
+    if (carry) {
+      m_digits.push_back(std::uint32_t(carry));
+    }
+  }
+
+  /// \brief Multiply by `factor`
+  void multiply(std::uint32_t factor) {
+    if (factor == 0) {
+      m_digits.clear();
+      return;
+    }
+    std::uint64_t carry = 0;
+    for (auto &digit : m_digits) {
+      std::uint64_t value = std::uint64_t(digit) * factor + carry;
+      digit = std::uint32_t(value);
+      carry = value >> 32;
+    }
+    if (carry) {
+      m_digits.push_back(std::uint32_t(carry));
+    }
+  }
+
+  /// \brief Divide by `divisor`, and return the remainder
+  std::uint32_t divide(std::uint32_t divisor) {
+    std::uint64_t remainder = 0;
+    for (Index i = Index(m_digits.size()) - 1; i >= 0; --i) {
+      std::uint64_t value = (remainder << 32) | m_digits[i];
+      m_digits[i] = std::uint32_t(value / divisor);
+      remainder = value % divisor;
+    }
+    while (!m_digits.empty() && m_digits.back() == 0) {
+      m_digits.pop_back();
+    }
+    return std::uint32_t(remainder);
+  }
+
+  /// \brief Decimal representation
+  std::string to_string() const {
+    if (is_zero()) {
+      return "0";
+    }
+    BigCount tmp(*this);
+    std::string result;
+    while (!tmp.is_zero()) {
+      result.push_back('0' + tmp.divide(10));
+    }
+    return std::string(result.rbegin(), result.rend());
+  }
+
+ private:
+  std::vector<std::uint32_t> m_digits;
+};
+
+/// \brief Occupations fixed by one operation, with a given number of each
+///     constrained occupant, as the coefficients of a truncated
+///     composition-generating polynomial
+///
+/// The coefficient of the composition `n` (number of each constrained
+/// occupant) is stored at index `sum_k n[k] * stride[k]`, for `n[k] <=
+/// target[k]`. Compositions exceeding the target are dropped, because
+/// counts never decrease as cycles are included.
+class FixedOccupationCounter {
+ public:
+  FixedOccupationCounter(std::vector<Index> const &_target)
+      : m_target(_target), m_stride(_target.size()) {
+    Index size = 1;
+    for (Index k = 0; k < Index(m_target.size()); ++k) {
+      m_stride[k] = size;
+      size *= m_target[k] + 1;
+    }
+    m_size = size;
+  }
+
+  /// \brief Set to the polynomial `1`
+  void reset() {
+    m_coeff.assign(m_size, BigCount());
+    m_coeff[0] = BigCount(1);
+  }
+
+  /// \brief Multiply by the generating polynomial of one cycle
+  ///
+  /// \param cycle_terms Pairs of (composition index shift, multiplicity),
+  ///     one for each occupant that may start a fixed assignment of the
+  ///     cycle, with compositions exceeding the target already excluded
+  ///     and given as -1.
+  void include_cycle(
+      std::vector<std::pair<Index, std::uint32_t>> const &cycle_terms) {
+    if (cycle_terms.size() == 1 && cycle_terms[0].first == 0) {
+      for (auto &value : m_coeff) {
+        value.multiply(cycle_terms[0].second);
+      }
+      return;
+    }
+    m_next.assign(m_size, BigCount());
+    for (auto const &term : cycle_terms) {
+      if (term.first < 0) {
+        continue;
+      }
+      for (Index i = 0; i < m_size; ++i) {
+        if (m_coeff[i].is_zero() || !_fits(i, term.first)) {
+          continue;
+        }
+        m_next[i + term.first].add_product(m_coeff[i], term.second);
+      }
+    }
+    std::swap(m_coeff, m_next);
+  }
+
+  /// \brief Return the coefficient of the target composition
+  BigCount const &target_coefficient() const { return m_coeff[m_size - 1]; }
+
+  /// \brief Convert a composition to a shift, or -1 if it exceeds the
+  ///     target
+  Index shift(std::vector<Index> const &composition) const {
+    Index result = 0;
+    for (Index k = 0; k < Index(m_target.size()); ++k) {
+      if (composition[k] > m_target[k]) {
+        return -1;
+      }
+      result += composition[k] * m_stride[k];
+    }
+    return result;
+  }
+
+ private:
+  /// \brief True if index `i` shifted by `shift` does not exceed the target
+  bool _fits(Index i, Index shift) const {
+    for (Index k = Index(m_target.size()) - 1; k >= 0; --k) {
+      Index n_i = i / m_stride[k];
+      Index n_shift = shift / m_stride[k];
+      if (n_i + n_shift > m_target[k]) {
+        return false;
+      }
+      i %= m_stride[k];
+      shift %= m_stride[k];
+    }
+    return true;
+  }
+
+  std::vector<Index> m_target;
+  std::vector<Index> m_stride;
+  Index m_size;
+  std::vector<BigCount> m_coeff;
+  std::vector<BigCount> m_next;
+};
+
+}  // namespace
+
+/// \brief Count symmetrically distinct occupations in a supercell, without
+///     enumerating them
+///
+/// \param supercell The supercell. Occupations of all sites are counted, and
+///     two occupations are equivalent if related by any SupercellSymOp.
+/// \param occupant_counts If not empty, only occupations with exactly
+///     `occupant_counts[name]` sites occupied by each listed occupant are
+///     counted. Names are as given by `xtal::Molecule::name()`. The number
+///     of unlisted occupants is not constrained.
+/// \param n_threads Number of threads used to check operations. If <= 0,
+///     the number of hardware threads is used.
+///
+/// \returns The number of distinct occupations, as a decimal string,
+///     because counts are generally too large for fixed size integer
+///     types. This is the number of configurations that would be
+///     enumerated by ConfigEnumAllOccupations, on all sites of a default
+///     background configuration, keeping only those that are canonical and
+///     satisfy `occupant_counts`.
+///
+/// Method (Burnside's lemma):
+/// - The number of orbits is the average, over all supercell operations,
+///   of the number of occupations left invariant by the operation
+/// - An occupation is invariant if along each cycle of the combined
+///   permutation the occupation of each site transforms into the
+///   occupation of the next site, including occupant index transformations
+///   (for example, molecular orientations). So each cycle contributes a
+///   factor equal to the number of occupants of its first site for which
+///   transforming around the cycle returns the same occupant.
+/// - With `occupant_counts`, each cycle instead contributes a polynomial
+///   in the number of each listed occupant, and the coefficient of the
+///   target composition of the product is used
+///
+/// The cost is proportional to (number of operations) * (number of sites),
+/// times the number of compositions not exceeding `occupant_counts` when
+/// given, independent of the number of occupations.
+///
+/// Note:
+/// - Continuous DoF are not considered, only occupations
+std::string count_distinct_occupations(
+    std::shared_ptr<Supercell const> const &supercell,
+    std::map<std::string, Index> const &occupant_counts, Index n_threads) {
+  Prim const &prim = *supercell->prim;
+  auto const &basis = prim.basicstructure->basis();
+  auto const &occ_symgroup_rep = prim.sym_info.occ_symgroup_rep;
+  auto const &converter = supercell->unitcellcoord_index_converter;
+  Index n_sites = converter.total_sites();
+  Index n_fg = supercell->sym_info().factor_group_permutations.size();
+  Index n_translations =
+      supercell->sym_info().translation_table.n_translations();
+  Index n_ops = n_fg * n_translations;
+  if (n_ops > Index(std::numeric_limits<std::uint32_t>::max())) {
+    throw std::runtime_error(
+        "Error in count_distinct_occupations: too many operations");
+  }
+
+  // constrained occupant index, by sublattice and occupant index, or -1
+  std::vector<Index> target;
+  std::map<std::string, Index> constrained_index;
+  for (auto const &pair : occupant_counts) {
+    if (pair.second < 0) {
+      throw std::runtime_error(
+          "Error in count_distinct_occupations: occupant count for '" +
+          pair.first + "' is negative");
+    }
+    constrained_index.emplace(pair.first, target.size());
+    target.push_back(pair.second);
+  }
+  std::vector<std::vector<Index>> constrained(basis.size());
+  for (Index b = 0; b < Index(basis.size()); ++b) {
+    for (auto const &occupant : basis[b].occupant_dof()) {
+      auto it = constrained_index.find(occupant.name());
+      constrained[b].push_back(it == constrained_index.end() ? -1
+                                                             : it->second);
+    }
+  }
+  std::vector<Index> site_sublattice(n_sites);
+  for (Index l = 0; l < n_sites; ++l) {
+    site_sublattice[l] = converter(l).sublattice();
+  }
+
+  Index n_chunks = std::min(resolve_n_threads(n_threads), n_ops);
+  std::vector<BigCount> chunk_sums(n_chunks);
+  parallel_for_chunks(
+      n_ops, n_chunks, [&](Index chunk_index, Index begin, Index end) {
+        FixedOccupationCounter counter(target);
+        sym_info::Permutation perm;
+        std::vector<Index> inverse(n_sites);
+        std::vector<bool> visited(n_sites);
+        std::vector<Index> composition(target.size());
+        std::vector<std::pair<Index, std::uint32_t>> cycle_terms;
+        BigCount &sum = chunk_sums[chunk_index];
+        for (Index op_index = begin; op_index < end; ++op_index) {
+          SupercellSymOpHandle op(supercell.get(), op_index / n_translations,
+                                  op_index % n_translations);
+          auto const &occ_rep = occ_symgroup_rep[op.prim_factor_group_index()];
+          op.combined_permute(perm);
+          for (Index l = 0; l < n_sites; ++l) {
+            inverse[perm[l]] = l;
+          }
+          std::fill(visited.begin(), visited.end(), false);
+          counter.reset();
+          for (Index start = 0; start < n_sites; ++start) {
+            if (visited[start]) {
+              continue;
+            }
+            // A fixed occupation satisfies occ[inverse[j]] =
+            // occ_rep[b_j][occ[j]], so follow `inverse` from `start`
+            Index j = start;
+            do {
+              visited[j] = true;
+              j = inverse[j];
+            } while (j != start);
+            cycle_terms.clear();
+            Index n_start = basis[site_sublattice[start]].occupant_dof().size();
+            for (Index x = 0; x < n_start; ++x) {
+              std::fill(composition.begin(), composition.end(), 0);
+              j = start;
+              Index occ = x;
+              do {
+                Index b = site_sublattice[j];
+                if (occ >= Index(constrained[b].size())) {
+                  occ = -1;
+                  break;
+                }
+                if (constrained[b][occ] >= 0) {
+                  ++composition[constrained[b][occ]];
+                }
+                occ = occ_rep[b][occ];
+                j = inverse[j];
+              } while (j != start);
+              if (occ != x) {
+                continue;
+              }
+              Index shift = counter.shift(composition);
+              if (!cycle_terms.empty() && cycle_terms.back().first == shift) {
+                ++cycle_terms.back().second;
+              } else {
+                cycle_terms.emplace_back(shift, 1);
+              }
+            }
+            counter.include_cycle(cycle_terms);
+          }
+          sum.add_product(counter.target_coefficient(), 1);
+        }
+      });
+
+  BigCount total;
+  for (auto const &sum : chunk_sums) {
+    total.add_product(sum, 1);
+  }
+  if (total.divide(n_ops) != 0) {
+    throw std::runtime_error(
+        "Error in count_distinct_occupations: Burnside sum is not divisible "
+        "by the number of operations");
+  }
+  return total.to_string();
+}
+
+}  // namespace config
+}  // namespace CASM
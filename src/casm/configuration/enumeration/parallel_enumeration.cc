@@ -0,0 +1,346 @@
+#include "casm/configuration/enumeration/parallel_enumeration.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymInfo.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/enumeration/ConfigEnumCanonicalOccupations.hh"
+#include "casm/configuration/enumeration/count_occupations.hh"
+#include "casm/configuration/parallel.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {  // anonymous
+
+/// Number of tasks to aim for, per thread, to balance the load
+Index const tasks_per_thread = 8;
+
+/// \brief Shared data for enumerating in one background configuration
+struct EnumerationBackground {
+  /// Sites with more than one allowed occupant, in increasing order
+  std::vector<Index> sites;
+
+  /// Number of allowed occupants, by index into sites
+  std::vector<int> n_occupants;
+
+  /// Canonical occupations are enumerated with respect to this group (empty
+  /// if not skipping non-canonical configurations)
+  std::vector<SupercellSymOp> group;
+
+  /// Number of leading sites fixed by each task
+  Index n_prefix_sites = 0;
+};
+
+/// \brief Enumerate occupations with a fixed prefix
+struct EnumerationTask {
+  /// Index into backgrounds
+  Index background_index;
+
+  /// Occupant indices of the leading `n_prefix_sites` sites
+  std::vector<int> prefix;
+};
+
+EnumerationBackground make_enumeration_background(
+    Configuration const &background, bool skip_non_canonical) {
+  EnumerationBackground result;
+  auto const &supercell = background.supercell;
+  auto const &converter = supercell->unitcellcoord_index_converter;
+  auto const &basis = supercell->prim->basicstructure->basis();
+  std::set<Index> all_sites;
+  for (Index l = 0; l < converter.total_sites(); ++l) {
+    int n = basis[converter(l).sublattice()].occupant_dof().size();
+    all_sites.insert(l);
+    if (n > 1) {
+      result.sites.push_back(l);
+      result.n_occupants.push_back(n);
+    }
+  }
+  if (skip_non_canonical) {
+    result.group = make_invariant_subgroup(background, all_sites,
+                                           SupercellSymOp::begin(supercell),
+                                           SupercellSymOp::end(supercell));
+  }
+  return result;
+}
+
+}  // namespace
+
+/// \brief Enumerate occupations in many background configurations, in
+///     parallel
+///
+/// \param backgrounds The background configurations. Occupations are
+///     enumerated on all sites of each, with other DoF fixed.
+/// \param skip_non_primitive If true, skip non-primitive configurations.
+/// \param skip_non_canonical If true, skip configurations that are not
+///     canonical with respect to the subgroup that leaves the background
+///     configuration invariant.
+/// \param n_threads Number of threads to use. If <= 0, uses
+///     `resolve_n_threads(n_threads)`.
+/// \returns The enumerated configurations, for each background in order, in
+///     the order visited by a ConfigEnumCanonicalOccupations constructed
+///     with the background, all sites, and the background invariant
+///     subgroup (if `skip_non_canonical`) or an empty group (otherwise).
+///     The result does not depend on `n_threads`.
+///
+/// Method:
+/// - Backgrounds are prepared in parallel
+/// - Each background is split into tasks by fixing the occupants of its
+///   leading sites (a counter prefix), so that large supercells are
+///   divided among threads
+/// - Tasks are taken by threads from a shared queue, and each task's
+///   results are stored separately, then concatenated in task order
+std::vector<Configuration> make_occupations_parallel(
+    std::vector<Configuration> const &backgrounds, bool skip_non_primitive,
+    bool skip_non_canonical, Index n_threads) {
+  n_threads = resolve_n_threads(n_threads);
+  Index n_backgrounds = backgrounds.size();
+
+  std::vector<EnumerationBackground> data(n_backgrounds);
+  parallel_for_chunks(n_backgrounds, n_threads,
+                      [&](Index chunk_index, Index begin, Index end) {
+                        for (Index b = begin; b < end; ++b) {
+                          data[b] = make_enumeration_background(
+                              backgrounds[b], skip_non_canonical);
+                        }
+                      });
+
+  // choose prefix lengths and make tasks, in serial enumeration order
+  std::vector<EnumerationTask> tasks;
+  Index target_per_background = 1;
+  if (n_threads > 1 && n_backgrounds > 0) {
+    target_per_background =
+        (tasks_per_thread * n_threads + n_backgrounds - 1) / n_backgrounds;
+  }
+  for (Index b = 0; b < n_backgrounds; ++b) {
+    EnumerationBackground &d = data[b];
+    Index n_tasks = 1;
+    while (n_tasks < target_per_background &&
+           d.n_prefix_sites < Index(d.sites.size())) {
+      n_tasks *= d.n_occupants[d.n_prefix_sites];
+      ++d.n_prefix_sites;
+    }
+    // prefixes in lexicographic order, with the first site slowest
+    std::vector<int> prefix(d.n_prefix_sites, 0);
+    while (true) {
+      tasks.push_back(EnumerationTask{b, prefix});
+      Index k = d.n_prefix_sites - 1;
+      while (k >= 0 && ++prefix[k] == d.n_occupants[k]) {
+        prefix[k] = 0;
+        --k;
+      }
+      if (k < 0) {
+        break;
+      }
+    }
+  }
+
+  std::vector<std::vector<Configuration>> task_results(tasks.size());
+  std::atomic<Index> next_task(0);
+  parallel_for_chunks(
+      n_threads, n_threads, [&](Index chunk_index, Index begin, Index end) {
+        Index t;
+        while ((t = next_task++) < Index(tasks.size())) {
+          EnumerationTask const &task = tasks[t];
+          EnumerationBackground const &d = data[task.background_index];
+          Configuration background = backgrounds[task.background_index];
+          for (Index k = 0; k < d.n_prefix_sites; ++k) {
+            background.dof_values.occupation(d.sites[k]) = task.prefix[k];
+          }
+          std::set<Index> sites(d.sites.begin() + d.n_prefix_sites,
+                                d.sites.end());
+          ConfigEnumCanonicalOccupations enumerator(background, sites,
+                                                    d.group,
+                                                    skip_non_primitive);
+          while (enumerator.is_valid()) {
+            task_results[t].push_back(enumerator.value());
+            enumerator.advance();
+          }
+        }
+      });
+
+  std::vector<Configuration> result;
+  for (auto &configurations : task_results) {
+    for (auto &configuration : configurations) {
+      result.push_back(std::move(configuration));
+    }
+  }
+  return result;
+}
+
+/// \brief Enumerate occupations in many background configurations, in
+///     parallel, and insert them into a ConfigurationSet
+///
+/// Configurations are enumerated with `make_occupations_parallel`, then
+/// inserted in the order returned, so configuration ids are assigned
+/// deterministically. Supercells of the backgrounds must be canonical.
+void insert_occupations_parallel(ConfigurationSet &configurations,
+                                 std::vector<Configuration> const &backgrounds,
+                                 bool skip_non_primitive,
+                                 bool skip_non_canonical, Index n_threads) {
+  for (auto &configuration :
+       make_occupations_parallel(backgrounds, skip_non_primitive,
+                                 skip_non_canonical, n_threads)) {
+    configurations.insert(std::move(configuration));
+  }
+}
+
+/// \brief Estimate the cost of `make_occupations_parallel`, by sampling,
+///     without enumerating all occupations
+///
+/// \param backgrounds, skip_non_primitive, skip_non_canonical As for
+///     `make_occupations_parallel`.
+/// \param max_sampled_tasks Maximum number of tasks enumerated for each
+///     background.
+/// \param max_task_candidates Candidates of each background are split
+///     into tasks, by fixing the occupants of the fewest leading sites such
+///     that each task has at most this many candidates.
+/// \param n_threads Number of threads used to sample backgrounds. If <= 0,
+///     uses `resolve_n_threads(n_threads)`. Backgrounds are sampled
+///     concurrently, so for timing accuracy the number of threads should not
+///     exceed the number of idle hardware threads.
+///
+/// \returns Estimates, for each background in order.
+///
+/// Method:
+/// - As in `make_occupations_parallel`, canonical occupations are
+///   enumerated with ConfigEnumCanonicalOccupations in tasks that fix the
+///   occupants of leading sites
+/// - If there are at most `max_sampled_tasks` tasks, all are enumerated
+///   and the number of configurations is exact
+/// - Otherwise, up to `max_sampled_tasks` task prefixes are chosen
+///   uniformly at random (with a fixed seed, so that results are
+///   reproducible), enumerated, and timed. The mean number of
+///   configurations and time per sampled task, multiplied by the number of
+///   tasks, are unbiased estimates of the totals. Pruning makes tasks with
+///   large leading occupants cheaper, so the relative error can be large
+///   if few tasks are sampled.
+/// - If the number of configurations is otherwise known exactly, it is
+///   used instead of the sampled estimate: all candidates if not skipping
+///   non-canonical or non-primitive configurations, or, if not skipping
+///   non-primitive configurations and the group is all supercell
+///   operations, `count_distinct_occupations`
+/// - Memory assumes each configuration holds its own occupation and
+///   continuous DoF values, like the background
+std::vector<OccupationEnumerationEstimate> estimate_occupations_parallel(
+    std::vector<Configuration> const &backgrounds, bool skip_non_primitive,
+    bool skip_non_canonical, Index max_sampled_tasks,
+    double max_task_candidates, Index n_threads) {
+  std::vector<OccupationEnumerationEstimate> result(backgrounds.size());
+  parallel_for_chunks(
+      backgrounds.size(), n_threads,
+      [&](Index chunk_index, Index begin, Index end) {
+        for (Index b = begin; b < end; ++b) {
+          Configuration const &background = backgrounds[b];
+          OccupationEnumerationEstimate &estimate = result[b];
+          auto t_begin = std::chrono::steady_clock::now();
+          EnumerationBackground d =
+              make_enumeration_background(background, skip_non_canonical);
+          double setup_seconds =
+              std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                            t_begin)
+                  .count();
+
+          estimate.n_variable_sites = d.sites.size();
+          estimate.group_size = d.group.size();
+          estimate.n_candidates = 1.0;
+          for (int n : d.n_occupants) {
+            estimate.n_candidates *= n;
+          }
+
+          // fix the fewest leading sites so tasks are small enough
+          double task_candidates = estimate.n_candidates;
+          estimate.n_tasks = 1.0;
+          while (task_candidates > max_task_candidates &&
+                 d.n_prefix_sites < Index(d.sites.size())) {
+            task_candidates /= d.n_occupants[d.n_prefix_sites];
+            estimate.n_tasks *= d.n_occupants[d.n_prefix_sites];
+            ++d.n_prefix_sites;
+          }
+          // enumerate all tasks if there are few enough, else sample
+          bool sample_all = (estimate.n_tasks <= max_sampled_tasks);
+          estimate.n_sampled_tasks =
+              sample_all ? Index(estimate.n_tasks)
+                         : std::max(max_sampled_tasks, Index(1));
+
+          std::mt19937_64 engine(b);
+          std::vector<int> prefix(d.n_prefix_sites, 0);
+          double n_sampled_configurations = 0.0;
+          double sampled_seconds = 0.0;
+          for (Index i = 0; i < estimate.n_sampled_tasks; ++i) {
+            if (sample_all) {
+              // prefixes in lexicographic order, with the first site slowest
+              for (Index k = d.n_prefix_sites - 1, j = i; k >= 0; --k) {
+                prefix[k] = j % d.n_occupants[k];
+                j /= d.n_occupants[k];
+              }
+            } else {
+              for (Index k = 0; k < d.n_prefix_sites; ++k) {
+                std::uniform_int_distribution<int> dist(0,
+                                                        d.n_occupants[k] - 1);
+                prefix[k] = dist(engine);
+              }
+            }
+            Configuration task_background = background;
+            for (Index k = 0; k < d.n_prefix_sites; ++k) {
+              task_background.dof_values.occupation(d.sites[k]) = prefix[k];
+            }
+            std::set<Index> sites(d.sites.begin() + d.n_prefix_sites,
+                                  d.sites.end());
+            auto t_task = std::chrono::steady_clock::now();
+            ConfigEnumCanonicalOccupations enumerator(
+                task_background, sites, d.group, skip_non_primitive);
+            while (enumerator.is_valid()) {
+              n_sampled_configurations += 1.0;
+              enumerator.advance();
+            }
+            sampled_seconds += std::chrono::duration<double>(
+                                   std::chrono::steady_clock::now() - t_task)
+                                   .count();
+          }
+          double scale = estimate.n_tasks / estimate.n_sampled_tasks;
+          estimate.n_configurations = n_sampled_configurations * scale;
+          estimate.n_configurations_is_exact = sample_all;
+          estimate.seconds = setup_seconds + sampled_seconds * scale;
+
+          auto const &supercell = background.supercell;
+          auto const &sym_info = supercell->sym_info();
+          Index n_ops = sym_info.factor_group_permutations.size() *
+                        sym_info.translation_table.n_translations();
+          if (!skip_non_primitive && !skip_non_canonical) {
+            estimate.n_configurations = estimate.n_candidates;
+            estimate.n_configurations_is_exact = true;
+          } else if (!skip_non_primitive &&
+                     !estimate.n_configurations_is_exact &&
+                     estimate.group_size == n_ops) {
+            std::string count = count_distinct_occupations(supercell, {}, 1);
+            if (count.size() < 300) {
+              estimate.n_configurations = std::stod(count);
+              estimate.n_configurations_is_exact = true;
+            }
+          }
+
+          double bytes_per_configuration =
+              sizeof(Configuration) +
+              background.dof_values.occupation.size() * sizeof(int);
+          for (auto const &dof : background.dof_values.global_dof_values) {
+            bytes_per_configuration += dof.second.size() * sizeof(double);
+          }
+          for (auto const &dof : background.dof_values.local_dof_values) {
+            bytes_per_configuration += dof.second.size() * sizeof(double);
+          }
+          estimate.bytes = estimate.n_configurations * bytes_per_configuration;
+        }
+      });
+  return result;
+}
+
+}  // namespace config
+}  // namespace CASM
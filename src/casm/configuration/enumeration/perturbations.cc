@@ -1,13 +1,28 @@
 #include "casm/configuration/enumeration/perturbations.hh"
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "casm/configuration/ConfigIsEquivalent.hh"
 #include "casm/configuration/Configuration.hh"
+#include "casm/configuration/OccCanonicalizer.hh"
+#include "casm/configuration/PackedOccupation.hh"
 #include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/SupercellSymOpGenerators.hh"
 #include "casm/configuration/canonical_form.hh"
-#include "casm/configuration/enumeration/ConfigEnumAllOccupations.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/enumeration/ConfigEnumCanonicalOccupations.hh"
+#include "casm/configuration/enumeration/ExternalConfigurationSet.hh"
+#include "casm/configuration/enumeration/OrbitPartition.hh"
+#include "casm/configuration/enumeration/SiteSet.hh"
+#include "casm/configuration/enumeration/SupercellOrbitSiteTable.hh"
 #include "casm/configuration/enumeration/background_configuration.hh"
+#include "casm/configuration/group/IndexBitset.hh"
 #include "casm/configuration/group/orbits.hh"
 #include "casm/configuration/sym_info/definitions.hh"
+#include "casm/crystallography/Lattice.hh"
+#include "casm/crystallography/SymType.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
 
 // debug:
 #include "casm/casm_io/container/json_io.hh"
@@ -16,6 +31,226 @@
 namespace CASM {
 namespace config {
 
+namespace {  // anonymous
+
+/// \brief The background configuration factor group
+std::vector<SupercellSymOp> make_background_group(
+    Configuration const &background) {
+  std::vector<SupercellSymOp> background_group;
+  ConfigIsEquivalent is_background_invariant(background);
+  auto begin = SupercellSymOp::begin(background.supercell);
+  auto end = SupercellSymOp::end(background.supercell);
+  for (auto it = begin; it != end; ++it) {
+    if (is_background_invariant(*it)) {
+      background_group.push_back(*it);
+    }
+  }
+  return background_group;
+}
+
+/// \brief Return the greatest element of each coset, H*g, of a subgroup, H,
+///     of the supercell operations, G
+///
+/// Each coset is found once, by marking the op_index of its members, so
+/// only (number of supercell operations) products are evaluated. Products
+/// are evaluated with integer operations only, as
+///
+///     (t_h, f_h) * (t_g, f_g) = (t_h + R_h * t_g + tau(f_h, f_g), f_h * f_g),
+///
+/// where t are translations, as prim lattice fractional coordinates, f are
+/// supercell factor group operations, R_h is the point operation of f_h in
+/// prim lattice fractional coordinates, and tau(f_h, f_g) is the lattice
+/// translation difference between the product of factor group operations
+/// and the corresponding factor group operation. The point operations and
+/// tau are found once for each subgroup factor group index, instead of
+/// forming a SymOp product and converting from Cartesian coordinates for
+/// every (h, g).
+///
+/// \param supercell The supercell
+/// \param subgroup The subgroup, H, which must include the identity
+///
+/// \returns The greatest element of each coset, in the order the cosets
+///     are first encountered iterating over all supercell operations.
+std::vector<SupercellSymOpHandle> make_greatest_coset_elements(
+    Supercell const &supercell,
+    std::vector<SupercellSymOpHandle> const &subgroup) {
+  SymGroup const &factor_group = *supercell.sym_info().factor_group;
+  Index n_fg = factor_group.element.size();
+  auto const &converter = supercell.unitcell_index_converter;
+  Index n_trans = converter.total_sites();
+  Lattice const &prim_lattice = supercell.superlattice.prim_lattice();
+  Eigen::Matrix3d const &L = prim_lattice.lat_column_mat();
+  Eigen::Matrix3d L_inv = L.inverse();
+
+  std::vector<UnitCell> translation_frac;
+  translation_frac.reserve(n_trans);
+  for (Index t = 0; t < n_trans; ++t) {
+    translation_frac.push_back(converter(t));
+  }
+
+  // point operations and tau, by factor group index, for subgroup elements
+  std::vector<Eigen::Matrix3l> point_op_frac(n_fg);
+  std::vector<std::vector<UnitCell>> tau(n_fg);
+  for (auto const &h : subgroup) {
+    Index f_h = h.supercell_factor_group_index();
+    if (!tau[f_h].empty()) {
+      continue;
+    }
+    SymOp const &op_h = factor_group.element[f_h];
+    point_op_frac[f_h] =
+        (L_inv * op_h.matrix * L).array().round().matrix().cast<long>();
+    tau[f_h].reserve(n_fg);
+    for (Index f_g = 0; f_g < n_fg; ++f_g) {
+      Index f = factor_group.multiplication_table[f_h][f_g];
+      Eigen::Vector3d diff_cart =
+          (op_h * factor_group.element[f_g]).translation -
+          factor_group.element[f].translation;
+      tau[f_h].push_back(UnitCell::from_cartesian(diff_cart, prim_lattice));
+    }
+  }
+
+  std::vector<SupercellSymOpHandle> greatest;
+  group::IndexBitset in_coset(n_fg * n_trans);
+  for (Index g = 0; g < n_fg * n_trans; ++g) {
+    if (in_coset.contains(g)) {
+      continue;
+    }
+    Index f_g = g / n_trans;
+    UnitCell const &t_g = translation_frac[g % n_trans];
+    Index greatest_index = g;
+    for (auto const &h : subgroup) {
+      Index f_h = h.supercell_factor_group_index();
+      UnitCell t = translation_frac[h.translation_index()] +
+                   point_op_frac[f_h] * t_g + tau[f_h][f_g];
+      Index product_index =
+          factor_group.multiplication_table[f_h][f_g] * n_trans + converter(t);
+      in_coset.insert(product_index);
+      if (product_index > greatest_index) {
+        greatest_index = product_index;
+      }
+    }
+    greatest.emplace_back(&supercell, greatest_index / n_trans,
+                          greatest_index % n_trans);
+  }
+  return greatest;
+}
+
+/// \brief The event group operations that keep the background
+///     configuration + event combination invariant
+///
+/// An operation keeps the combination invariant if it maps the initial and
+/// final configurations onto themselves, or onto each other. This is
+/// checked without applying the operation to either configuration, using
+/// ConfigIsEquivalent, which compares permuted values in place and stops at
+/// the first difference.
+std::vector<SupercellSymOp> make_local_group(
+    Configuration const &background, std::vector<Index> const &event_sites,
+    std::vector<int> const &occ_init, std::vector<int> const &occ_final,
+    std::vector<SupercellSymOp> const &event_group) {
+  Configuration config_init = copy_apply_occ(background, event_sites, occ_init);
+  Configuration config_final =
+      copy_apply_occ(background, event_sites, occ_final);
+  ConfigIsEquivalent is_init(config_init);
+  ConfigIsEquivalent is_final(config_final);
+
+  std::vector<SupercellSymOp> local_group;
+  for (auto const &op : event_group) {
+    // init == op*init && final == op*final, or
+    // init == op*final && final == op*init
+    if ((is_init(op) && is_final(op)) ||
+        (is_init(op, config_final) && is_final(op, config_init))) {
+      local_group.push_back(op);
+    }
+  }
+  return local_group;
+}
+
+/// \brief Inverse permutations of the event group operations that keep the
+///     background configuration + event combination invariant, which
+///     transform linear site indices
+std::vector<sym_info::Permutation> make_local_indices_group_rep(
+    Configuration const &background, std::vector<Index> const &event_sites,
+    std::vector<int> const &occ_init, std::vector<int> const &occ_final,
+    std::vector<SupercellSymOp> const &event_group) {
+  return make_indices_group_rep(make_local_group(
+      background, event_sites, occ_init, occ_final, event_group));
+}
+
+/// \brief Insert the canonical element of each sub-orbit, with respect to
+///     `indices_group_rep`, of the clusters of an orbit in a
+///     SupercellOrbitSiteTable
+///
+/// The distinct clusters of the orbit are sorted once. Each cluster that is
+/// not yet in a found sub-orbit generates its sub-orbit, and all elements
+/// of the sub-orbit are marked as found, so each sub-orbit is generated
+/// once instead of once per element. The canonical element is the greatest,
+/// as for `group::make_canonical_element` with `std::less`.
+void insert_orbit_generators(
+    std::unordered_set<SiteSet, SiteSetHash> &generators,
+    SupercellOrbitSiteTable const &orbit_site_table, Index orbit_index,
+    std::vector<sym_info::Permutation> const &indices_group_rep) {
+  std::vector<SiteSet> clusters;
+  for (Index r = orbit_site_table.orbit_offsets[orbit_index];
+       r < orbit_site_table.orbit_offsets[orbit_index + 1]; ++r) {
+    clusters.emplace_back(orbit_site_table.cluster_begin(r),
+                          orbit_site_table.cluster_end(r));
+  }
+  std::sort(clusters.begin(), clusters.end());
+  clusters.erase(std::unique(clusters.begin(), clusters.end()),
+                 clusters.end());
+
+  std::vector<bool> found(clusters.size(), false);
+  SiteSet image;
+  SiteSet canonical;
+  for (Index i = 0; i < clusters.size(); ++i) {
+    if (found[i]) {
+      continue;
+    }
+    canonical = clusters[i];
+    for (auto const &perm : indices_group_rep) {
+      image.assign_permuted(perm, clusters[i]);
+      auto it = std::lower_bound(clusters.begin(), clusters.end(), image);
+      if (it != clusters.end() && *it == image) {
+        found[it - clusters.begin()] = true;
+      }
+      if (canonical < image) {
+        canonical = image;
+      }
+    }
+    generators.insert(canonical);
+  }
+}
+
+/// \brief Return the greatest image of `sites` under `indices_group_rep`
+///
+/// Equivalent to `group::make_canonical_element` with `std::less`, using
+/// `image` as temporary storage.
+SiteSet const &make_canonical_sites(
+    SiteSet const &sites,
+    std::vector<sym_info::Permutation> const &indices_group_rep,
+    SiteSet &image, SiteSet &canonical) {
+  canonical.assign_permuted(indices_group_rep[0], sites);
+  for (Index i = 1; i < indices_group_rep.size(); ++i) {
+    image.assign_permuted(indices_group_rep[i], sites);
+    if (canonical < image) {
+      canonical = image;
+    }
+  }
+  return canonical;
+}
+
+/// \brief Convert SiteSet to std::set<Index>
+std::set<std::set<Index>> to_sets(
+    std::unordered_set<SiteSet, SiteSetHash> const &site_sets) {
+  std::set<std::set<Index>> result;
+  for (auto const &sites : site_sets) {
+    result.emplace(sites.begin(), sites.end());
+  }
+  return result;
+}
+
+}  // namespace
+
 /// \brief Make the distinct clusters of sites, taking into account the
 ///     background configuration symmetry
 ///
@@ -25,27 +260,16 @@ namespace config {
 std::set<std::set<Index>> make_distinct_cluster_sites(
     Configuration const &background,
     std::vector<std::set<std::set<Index>>> const &orbits_as_indices) {
-  /// Inverse permutations can be used to transform
-  /// linear site indices.
-  auto copy_apply_f = [](sym_info::Permutation const &perm,
-                         std::set<Index> const &site_indices) {
-    std::set<Index> new_site_indices;
-    for (Index l : site_indices) {
-      new_site_indices.insert(perm[l]);
-    }
-    return new_site_indices;
-  };
-
   /// Find the background factor group, and store the inverse permutations
-  /// because they are the rep that transforms site indices.
-  std::vector<SupercellSymOp> background_fg_op;
+  /// because they are the rep that transforms linear site indices.
+  std::vector<SupercellSymOpHandle> background_fg_op;
   std::vector<sym_info::Permutation> indices_group_rep;
   ConfigIsEquivalent is_background_invariant(background);
   auto begin = SupercellSymOp::begin(background.supercell);
   auto end = SupercellSymOp::end(background.supercell);
   for (auto it = begin; it != end; ++it) {
     if (is_background_invariant(*it)) {
-      background_fg_op.push_back(it);
+      background_fg_op.emplace_back(*it);
       indices_group_rep.push_back(sym_info::inverse(it->combined_permute()));
     }
   }
@@ -53,21 +277,12 @@ std::set<std::set<Index>> make_distinct_cluster_sites(
   /// Find supercell factor group operations that might create distinct
   /// sub-orbits by finding canonical operations with respect to the background
   /// configuration factor group.
-  /// (An element of each coset of the background factor group).
-  auto is_possible_suborbit_generating_op = [&](SupercellSymOp const &it) {
-    for (auto background_fg_it : background_fg_op) {
-      if (background_fg_it * it > it) {
-        return false;
-      }
-    }
-    return true;
-  };
+  /// (The greatest element of each coset of the background factor group).
   std::vector<sym_info::Permutation> possible_suborbit_generating_indices_rep;
-  for (auto it = begin; it != end; ++it) {
-    if (is_possible_suborbit_generating_op(it)) {
-      possible_suborbit_generating_indices_rep.push_back(
-          sym_info::inverse(it->combined_permute()));
-    }
+  for (auto const &canonical_op :
+       make_greatest_coset_elements(*background.supercell, background_fg_op)) {
+    possible_suborbit_generating_indices_rep.push_back(
+        sym_info::inverse(canonical_op.combined_permute()));
   }
 
   /// Get the actual sub-orbit generators.
@@ -79,40 +294,253 @@ std::set<std::set<Index>> make_distinct_cluster_sites(
   ///
   /// The resulting clusters are the distinct clusters, taking into account
   /// background configuration and supercell periodic boundary conditions
-
-  std::set<std::set<Index>> distinct_cluster_sites;
+  std::unordered_set<SiteSet, SiteSetHash> distinct_cluster_sites;
+  SiteSet cluster;
+  SiteSet suborbit_element;
+  SiteSet image;
+  SiteSet canonical;
   for (auto const &orbit : orbits_as_indices) {
-    for (auto const &cluster : orbit) {
+    for (auto const &cluster_sites : orbit) {
+      cluster = SiteSet(cluster_sites);
       for (auto const &rep : possible_suborbit_generating_indices_rep) {
-        auto suborbit_element = copy_apply_f(rep, cluster);
-        distinct_cluster_sites.emplace(group::make_canonical_element(
-            suborbit_element, indices_group_rep.begin(),
-            indices_group_rep.end(), std::less<std::set<Index>>(),
-            copy_apply_f));
+        suborbit_element.assign_permuted(rep, cluster);
+        distinct_cluster_sites.insert(make_canonical_sites(
+            suborbit_element, indices_group_rep, image, canonical));
       }
     }
   }
+  return to_sets(distinct_cluster_sites);
+}
+
+/// \brief Make the distinct clusters of sites, taking into account the
+///     background configuration symmetry, using a SupercellOrbitSiteTable
+///
+/// \param background, The background
+/// \param orbit_site_table, The orbits in the infinite crystal, with all
+///     equivalents and translations as linear supercell site indices.
+///     Must be constructed for `background.supercell` with
+///     `include_translations=true`.
+///
+/// \returns The same result as `make_distinct_cluster_sites(background,
+///     make_orbits_as_indices(orbits, converter))`. Because
+///     `orbit_site_table` includes all supercell translations of all
+///     equivalent clusters, the sub-orbits are found by applying only
+///     generators of the background configuration factor group (see
+///     `make_generators` and `make_cluster_orbit_generators`), and
+///     `orbit_site_table` can be re-used for every background in the same
+///     supercell.
+std::set<std::set<Index>> make_distinct_cluster_sites(
+    Configuration const &background,
+    SupercellOrbitSiteTable const &orbit_site_table) {
+  if (background.supercell != orbit_site_table.supercell) {
+    throw std::runtime_error(
+        "Error in make_distinct_cluster_sites: background supercell does not "
+        "match orbit_site_table supercell");
+  }
+  if (orbit_site_table.n_translations !=
+      background.supercell->unitcell_index_converter.total_sites()) {
+    throw std::runtime_error(
+        "Error in make_distinct_cluster_sites: orbit_site_table does not "
+        "include translations");
+  }
+  // each orbit includes all translations and is closed under the supercell
+  // group, so it can be partitioned applying only generators
+  std::vector<SupercellSymOp> generators =
+      make_generators(make_background_group(background));
+  std::vector<sym_info::Permutation> generators_indices_rep =
+      make_indices_group_rep(generators);
+
+  std::set<std::set<Index>> distinct_cluster_sites;
+  for (Index o = 0; o < orbit_site_table.n_orbits(); ++o) {
+    std::vector<SiteSet> clusters;
+    for (Index r = orbit_site_table.orbit_offsets[o];
+         r < orbit_site_table.orbit_offsets[o + 1]; ++r) {
+      clusters.emplace_back(orbit_site_table.cluster_begin(r),
+                            orbit_site_table.cluster_end(r));
+    }
+    for (auto const &sites : make_cluster_orbit_generators(
+             std::move(clusters), generators_indices_rep)) {
+      distinct_cluster_sites.insert(sites.to_set());
+    }
+  }
   return distinct_cluster_sites;
 }
 
-/// \brief Make configurations that are distinct occupation perturbations
-std::set<Configuration> make_distinct_perturbations(
+namespace {  // anonymous
+
+/// \brief Call `g` with each occupation perturbation of a background that
+///     is canonical with respect to the background and cluster invariant
+///     group, reporting progress once per cluster
+template <typename G>
+void _for_each_perturbation(
     Configuration const &background,
-    std::set<std::set<Index>> const &distinct_cluster_sites) {
-  std::set<Configuration> distinct_perturbations;
+    std::set<std::set<Index>> const &distinct_cluster_sites,
+    std::shared_ptr<ProgressMonitor> const &progress, G g) {
+  begin_progress(progress, "make_distinct_perturbations",
+                 distinct_cluster_sites.size());
   auto begin = SupercellSymOp::begin(background.supercell);
   auto end = SupercellSymOp::end(background.supercell);
+
+  // perturbations equivalent under the background invariant group have the
+  // same canonical form, so only those canonical with respect to it (for
+  // each cluster) are enumerated and made canonical
+  std::vector<SupercellSymOp> background_group =
+      make_invariant_subgroup(background, begin, end);
   for (auto const &cluster_sites : distinct_cluster_sites) {
-    ConfigEnumAllOccupations enumerator(background, cluster_sites);
+    std::vector<SupercellSymOp> cluster_group = make_invariant_subgroup(
+        cluster_sites, background_group.begin(), background_group.end());
+    ConfigEnumCanonicalOccupations enumerator(background, cluster_sites,
+                                              cluster_group);
     while (enumerator.is_valid()) {
-      distinct_perturbations.emplace(
-          make_canonical_form(enumerator.value(), begin, end));
+      check_progress(progress);
+      g(enumerator.value());
       enumerator.advance();
     }
+    advance_progress(progress);
+  }
+}
+
+}  // namespace
+
+/// \brief Call `f` with the canonical form of occupation perturbations of
+///     a background, including all distinct perturbations
+///
+/// \param background The background
+/// \param distinct_cluster_sites The clusters on which to perturb the
+///     occupation, as from `make_distinct_cluster_sites`
+/// \param f Called with each perturbation, in canonical form with respect
+///     to the supercell factor group
+/// \param progress If provided, report progress with one work item per
+///     cluster, and check for cancellation once per perturbation
+///
+/// Notes:
+/// - Perturbations are in canonical form with respect to the background
+///   invariant group before they are made canonical, but `f` may be called
+///   more than once with the same canonical perturbation, if perturbations
+///   on different clusters are equivalent.
+/// - Nothing is accumulated, so memory use does not depend on the number
+///   of perturbations.
+void for_each_distinct_perturbation(
+    Configuration const &background,
+    std::set<std::set<Index>> const &distinct_cluster_sites,
+    std::function<void(Configuration const &)> f,
+    std::shared_ptr<ProgressMonitor> progress) {
+  // occupation-only prim: use the faster OccCanonicalizer
+  if (OccCanonicalizer::is_supported(*background.supercell->prim)) {
+    OccCanonicalizer canonicalizer(background.supercell);
+    _for_each_perturbation(background, distinct_cluster_sites, progress,
+                           [&](Configuration const &perturbation) {
+                             f(canonicalizer.make_canonical_form_pruned(
+                                 perturbation));
+                           });
+    return;
   }
+
+  auto begin = SupercellSymOp::begin(background.supercell);
+  auto end = SupercellSymOp::end(background.supercell);
+  _for_each_perturbation(background, distinct_cluster_sites, progress,
+                         [&](Configuration const &perturbation) {
+                           f(make_canonical_form(perturbation, begin, end));
+                         });
+}
+
+/// \brief Call `f` with the canonical form of occupation perturbations of
+///     a background, as OccConfiguration, including all distinct
+///     perturbations
+///
+/// Same as `for_each_distinct_perturbation`, but for prim with occupation
+/// DoF only (see `OccCanonicalizer::is_supported`), and `f` is called with
+/// the canonical perturbations as OccConfiguration, which are cheaper to
+/// copy, compare, and store than Configuration. Throws if the prim has
+/// continuous DoF.
+void for_each_distinct_occ_perturbation(
+    Configuration const &background,
+    std::set<std::set<Index>> const &distinct_cluster_sites,
+    std::function<void(OccConfiguration const &)> f,
+    std::shared_ptr<ProgressMonitor> progress) {
+  OccCanonicalizer canonicalizer(background.supercell);
+  _for_each_perturbation(
+      background, distinct_cluster_sites, progress,
+      [&](Configuration const &perturbation) {
+        f(canonicalizer.make_canonical_form_pruned(
+            OccConfiguration(perturbation)));
+      });
+}
+
+/// \brief Make configurations that are distinct occupation perturbations
+///
+/// \param background The background
+/// \param distinct_cluster_sites The clusters on which to perturb the
+///     occupation, as from `make_distinct_cluster_sites`
+/// \param progress If provided, report progress and check for cancellation,
+///     as by `for_each_distinct_perturbation`
+std::set<Configuration> make_distinct_perturbations(
+    Configuration const &background,
+    std::set<std::set<Index>> const &distinct_cluster_sites,
+    std::shared_ptr<ProgressMonitor> progress) {
+  // occupation-only prim: collect as OccConfiguration, which are much
+  // cheaper to compare than Configuration, and convert once
+  if (OccCanonicalizer::is_supported(*background.supercell->prim)) {
+    std::set<OccConfiguration> distinct_perturbations;
+    for_each_distinct_occ_perturbation(
+        background, distinct_cluster_sites,
+        [&](OccConfiguration const &perturbation) {
+          distinct_perturbations.emplace(perturbation);
+        },
+        progress);
+    return to_configurations(distinct_perturbations);
+  }
+
+  std::set<Configuration> distinct_perturbations;
+  for_each_distinct_perturbation(
+      background, distinct_cluster_sites,
+      [&](Configuration const &perturbation) {
+        distinct_perturbations.emplace(perturbation);
+      },
+      progress);
   return distinct_perturbations;
 }
 
+/// \brief Call `f` once with each distinct periodic perturbation of a
+///     motif, as it is found
+///
+/// \param motif The motif, which is tiled into the supercell of
+///     `orbit_site_table` to generate background configurations
+/// \param orbit_site_table The cluster orbits, in the infinite crystal, to
+///     perturb, with `include_translations=true`
+/// \param f Called once with each distinct perturbation, in canonical form
+/// \param distinct Holds the perturbations already found, to skip
+///     duplicates. It may be memory-only or spill to files, for bounded
+///     memory use. Perturbations already in `distinct` are skipped.
+///
+/// \returns The number of perturbations `f` was called with
+///
+/// Finds the same perturbations as `make_distinct_perturbations` for each
+/// distinct background, but does not accumulate them, so memory use is
+/// determined by `distinct`. The order is the order found, not sorted.
+Index for_each_distinct_periodic_perturbation(
+    Configuration const &motif,
+    SupercellOrbitSiteTable const &orbit_site_table,
+    std::function<void(Configuration const &)> f,
+    ExternalConfigurationSet &distinct) {
+  std::vector<std::vector<Configuration>> super_configurations =
+      make_all_super_configurations_by_subsets(motif,
+                                               orbit_site_table.supercell);
+  Index n = 0;
+  for (auto const &equiv_configurations : super_configurations) {
+    auto const &background = equiv_configurations[0];
+    for_each_distinct_perturbation(
+        background, make_distinct_cluster_sites(background, orbit_site_table),
+        [&](Configuration const &perturbation) {
+          if (distinct.insert(perturbation)) {
+            f(perturbation);
+            ++n;
+          }
+        });
+  }
+  return n;
+}
+
 /// \brief Make the distinct clusters of sites, taking into account the
 ///     event group, supercell, and background configuration symmetry
 ///
@@ -135,58 +563,67 @@ std::set<std::set<Index>> make_distinct_local_cluster_sites(
   /// linear site indices.
   /// Keep only event group operations that also keep
   /// background configuration + event combination invariant.
-
-  Configuration config_init = copy_apply_occ(background, event_sites, occ_init);
-  Configuration config_final =
-      copy_apply_occ(background, event_sites, occ_final);
-
-  std::vector<sym_info::Permutation> indices_group_rep;
-  // ConfigIsEquivalent is_background_invariant(background);
-  // ConfigIsEquivalent init_is_equiv(config_init);
-  // ConfigIsEquivalent final_is_equiv(config_final);
-  for (auto const &op : event_group) {
-    // Apply completely, then check:
-    Configuration A = copy_apply(op, config_init);
-    Configuration B = copy_apply(op, config_final);
-    if ((A == config_init && B == config_final) ||
-        (B == config_init && A == config_final)) {
-      indices_group_rep.push_back(sym_info::inverse(op.combined_permute()));
-    }
-
-    // if (is_background_invariant(op)) { TODO: check init and final somehow
-    //   indices_group_rep.push_back(sym_info::inverse(op.combined_permute()));
-    // }
-
-    // // Incremental apply and check:
-    // if ( (init_is_equiv(op) && final_is_equiv(op)) || (final_is_equiv(op,
-    // config_init) && init_is_equiv(op, config_final)) ) {
-    //   indices_group_rep.push_back(sym_info::inverse(op.combined_permute()));
-    // }
-  }
-  auto copy_apply_f = [](sym_info::Permutation const &perm,
-                         std::set<Index> const &site_indices) {
-    std::set<Index> new_site_indices;
-    for (Index l : site_indices) {
-      new_site_indices.insert(perm[l]);
-    }
-    return new_site_indices;
-  };
+  std::vector<sym_info::Permutation> indices_group_rep =
+      make_local_indices_group_rep(background, event_sites, occ_init,
+                                   occ_final, event_group);
 
   /// Generate new orbit generators.
   /// A generator is the canonical element from an orbit.
   /// These will take into account background configuration and
   /// supercell periodic boundary conditions
-  std::set<std::set<Index>> distinct_local_cluster_sites;
+  std::unordered_set<SiteSet, SiteSetHash> distinct_local_cluster_sites;
+  SiteSet cluster;
+  SiteSet image;
+  SiteSet canonical;
   for (auto const &orbit : local_orbits_as_indices) {
-    std::set<std::set<Index>> tmp = group::make_orbit_generators(
-        orbit, indices_group_rep.begin(), indices_group_rep.end(),
-        std::less<std::set<Index>>(), copy_apply_f);
-    for (auto const &local_cluster_sites : tmp) {
-      distinct_local_cluster_sites.insert(local_cluster_sites);
+    for (auto const &cluster_sites : orbit) {
+      cluster = SiteSet(cluster_sites);
+      distinct_local_cluster_sites.insert(
+          make_canonical_sites(cluster, indices_group_rep, image, canonical));
     }
   }
+  return to_sets(distinct_local_cluster_sites);
+}
+
+/// \brief Make the distinct clusters of sites, taking into account the
+///     event group, supercell, and background configuration symmetry, using
+///     a SupercellOrbitSiteTable
+///
+/// \param background, The background
+/// \param event_sites Linear sites indices of the cluster of sites that
+///     change during the event
+/// \param occ_init Initial occupation on sites
+/// \param occ_final Final occupation on sites
+/// \param event_group The SupercellSymOp consistent with
+///     the supercell of the background configuration that leave the
+///     event invariant
+/// \param local_orbit_site_table, The local orbits in the infinite crystal,
+///     as linear supercell site indices. Must be constructed for
+///     `background.supercell`, with `include_translations=false`.
+///
+/// \returns The same result as `make_distinct_local_cluster_sites` with
+///     `local_orbits_as_indices`. The table can be re-used for every
+///     background in the same supercell.
+std::set<std::set<Index>> make_distinct_local_cluster_sites(
+    Configuration const &background, std::vector<Index> const &event_sites,
+    std::vector<int> const &occ_init, std::vector<int> const &occ_final,
+    std::vector<SupercellSymOp> const &event_group,
+    SupercellOrbitSiteTable const &local_orbit_site_table) {
+  if (background.supercell != local_orbit_site_table.supercell) {
+    throw std::runtime_error(
+        "Error in make_distinct_local_cluster_sites: background supercell "
+        "does not match local_orbit_site_table supercell");
+  }
+  std::vector<sym_info::Permutation> indices_group_rep =
+      make_local_indices_group_rep(background, event_sites, occ_init,
+                                   occ_final, event_group);
 
-  return distinct_local_cluster_sites;
+  std::unordered_set<SiteSet, SiteSetHash> distinct_local_cluster_sites;
+  for (Index o = 0; o < local_orbit_site_table.n_orbits(); ++o) {
+    insert_orbit_generators(distinct_local_cluster_sites,
+                            local_orbit_site_table, o, indices_group_rep);
+  }
+  return to_sets(distinct_local_cluster_sites);
 }
 
 /// \brief Make configurations that are distinct local occupation perturbations
@@ -206,9 +643,30 @@ std::set<Configuration> make_distinct_local_perturbations(
     std::vector<int> const &occ_init, std::vector<int> const &occ_final,
     std::vector<SupercellSymOp> const &event_group,
     std::set<std::set<Index>> const &distinct_local_cluster_sites) {
+  // Perturbations equivalent under operations that leave both the initial
+  // and final configurations invariant have the same canonical form, so
+  // only those canonical with respect to the stabilizer of each cluster in
+  // that group are enumerated and made canonical. Occupations are enumerated
+  // on the initial configuration, because the event sites are set to the
+  // initial and final occupations when making the canonical form.
+  Configuration config_init = copy_apply_occ(background, event_sites, occ_init);
+  Configuration config_final =
+      copy_apply_occ(background, event_sites, occ_final);
+  ConfigIsEquivalent is_init(config_init);
+  ConfigIsEquivalent is_final(config_final);
+  std::vector<SupercellSymOp> local_group;
+  for (auto const &op : event_group) {
+    if (is_init(op) && is_final(op)) {
+      local_group.push_back(op);
+    }
+  }
+
   std::set<Configuration> distinct_local_perturbations;
   for (auto const &local_cluster_sites : distinct_local_cluster_sites) {
-    ConfigEnumAllOccupations enumerator(background, local_cluster_sites);
+    std::vector<SupercellSymOp> cluster_group = make_invariant_subgroup(
+        local_cluster_sites, local_group.begin(), local_group.end());
+    ConfigEnumCanonicalOccupations enumerator(config_init, local_cluster_sites,
+                                              cluster_group);
     while (enumerator.is_valid()) {
       distinct_local_perturbations.emplace(make_canonical_form(
           enumerator.value(), event_sites, occ_init, occ_final, event_group));
@@ -0,0 +1,465 @@
+#include "casm/configuration/group/subgroups.hh"
+
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace CASM {
+namespace group {
+
+namespace {  // (anonymous)
+
+/// \brief A subgroup, as generators, members, and membership bits
+struct GeneratedSubgroup {
+  std::vector<Index> generators;
+  std::vector<Index> members;
+  IndexBitset bits;
+};
+
+/// \brief Return the subgroup generated by `subgroup.generators` and
+///     `generator`
+///
+/// Because the group is finite, the closure of a set of generators is
+/// found by right multiplication of members by generators only.
+GeneratedSubgroup _add_generator(
+    MultiplicationTable const &multiplication_table,
+    GeneratedSubgroup const &subgroup, Index generator) {
+  GeneratedSubgroup result = subgroup;
+  result.generators.push_back(generator);
+  for (Index l = 0; l < result.members.size(); ++l) {
+    // members of `subgroup` are already closed with respect to its
+    // generators
+    Index n_generators = (l < subgroup.members.size())
+                             ? Index(1)
+                             : Index(result.generators.size());
+    for (Index g = result.generators.size() - n_generators;
+         g < result.generators.size(); ++g) {
+      Index product_index =
+          multiplication_table[result.members[l]][result.generators[g]];
+      if (result.bits.insert(product_index)) {
+        result.members.push_back(product_index);
+      }
+    }
+  }
+  return result;
+}
+
+/// \brief Return the orbit of subgroups equivalent to `subgroup` by
+///     conjugation
+///
+/// Conjugation by group element X depends only on the left coset X*subgroup,
+/// so one element X per left coset is used.
+///
+/// \param normalizer If not nullptr, set to the normalizer of `subgroup`,
+///     the union of the left cosets X*subgroup with X*subgroup*X^-1 ==
+///     subgroup
+SubgroupOrbit _make_subgroup_orbit(
+    MultiplicationTable const &multiplication_table,
+    std::vector<Index> const &inverse_index, IndexBitset const &subgroup,
+    IndexBitset *normalizer = nullptr) {
+  if (normalizer) {
+    *normalizer = IndexBitset(multiplication_table.size());
+  }
+  std::unordered_set<IndexBitset, IndexBitsetHash> conjugates;
+  for (IndexBitset const &coset :
+       make_left_cosets(multiplication_table, subgroup)) {
+    IndexBitset conjugate = make_conjugate(multiplication_table, inverse_index,
+                                           subgroup, coset.find_first());
+    if (normalizer && conjugate == subgroup) {
+      *normalizer |= coset;
+    }
+    conjugates.insert(std::move(conjugate));
+  }
+  SubgroupOrbit orbit;
+  for (IndexBitset const &conjugate : conjugates) {
+    orbit.insert(conjugate.to_set());
+  }
+  return orbit;
+}
+
+/// \brief Return the cyclic subgroup generated by element `i`
+IndexBitset _make_cyclic_subgroup(
+    MultiplicationTable const &multiplication_table, Index i) {
+  IndexBitset bits(multiplication_table.size());
+  Index product_index = i;
+  bits.insert(product_index);
+  while (product_index != 0) {
+    product_index = multiplication_table[i][product_index];
+    bits.insert(product_index);
+  }
+  return bits;
+}
+
+/// \brief One generator for each distinct cyclic subgroup
+struct CyclicGenerators {
+  /// \brief The smallest element index generating each distinct cyclic
+  ///     subgroup
+  std::vector<Index> generators;
+
+  /// \brief For each element `e`, the index into `generators` of the
+  ///     generator of the cyclic subgroup generated by `e`
+  std::vector<Index> cyclic_subgroup_index;
+};
+
+/// \brief Return one generator for each distinct cyclic subgroup
+CyclicGenerators _make_cyclic_generators(
+    MultiplicationTable const &multiplication_table) {
+  std::unordered_map<IndexBitset, Index, IndexBitsetHash> found;
+  CyclicGenerators result;
+  for (Index i = 0; i < multiplication_table.size(); ++i) {
+    auto res = found.emplace(_make_cyclic_subgroup(multiplication_table, i),
+                             result.generators.size());
+    if (res.second) {
+      result.generators.push_back(i);
+    }
+    result.cyclic_subgroup_index.push_back(res.first->second);
+  }
+  return result;
+}
+
+}  // namespace
+
+/// \brief Return the index of the inverse of each group element
+///
+/// The identity element must have index 0.
+///
+/// \param multiplication_table The group multiplication table
+/// \returns Vector, `inverse_index`, where `inverse_index[i]` is the index
+///     of the inverse of element `i`
+std::vector<Index> make_inverse_index(
+    MultiplicationTable const &multiplication_table) {
+  std::vector<Index> inverse_index(multiplication_table.size(), -1);
+  for (Index i = 0; i < multiplication_table.size(); ++i) {
+    for (Index j = 0; j < multiplication_table[i].size(); ++j) {
+      if (multiplication_table[i][j] == 0) {
+        inverse_index[i] = j;
+        break;
+      }
+    }
+    if (inverse_index[i] == -1) {
+      throw std::runtime_error(
+          "Error in make_inverse_index: element has no inverse");
+    }
+  }
+  return inverse_index;
+}
+
+/// \brief Return the subgroup generated by a set of group elements
+///
+/// Because the group is finite, the closure is found by right
+/// multiplication of members by `elements` only. The identity element must
+/// have index 0.
+///
+/// \param multiplication_table The group multiplication table
+/// \param elements Indices of the generating group elements
+/// \returns Indices of the elements of the generated subgroup
+IndexBitset make_closure(MultiplicationTable const &multiplication_table,
+                         IndexBitset const &elements) {
+  std::vector<Index> generators = elements.to_vector();
+  IndexBitset closure(multiplication_table.size());
+  closure.insert(0);
+  std::vector<Index> members({0});
+  for (Index l = 0; l < members.size(); ++l) {
+    std::vector<Index> const &row = multiplication_table[members[l]];
+    for (Index g : generators) {
+      if (closure.insert(row[g])) {
+        members.push_back(row[g]);
+      }
+    }
+  }
+  return closure;
+}
+
+/// \brief Return a small set of elements that generates a subgroup
+///
+/// Generators are chosen greedily: elements of `subgroup` are visited in
+/// ascending order, and an element is added as a generator only if it is
+/// not in the subgroup generated by the generators already chosen. Each
+/// added generator at least doubles the size of the generated subgroup, so
+/// there are at most log2(subgroup size) generators.
+///
+/// \param multiplication_table The group multiplication table
+/// \param subgroup Indices of the elements of a subgroup
+/// \returns Indices of generating elements, in ascending order
+std::vector<Index> make_generators(
+    MultiplicationTable const &multiplication_table,
+    IndexBitset const &subgroup) {
+  if (!is_closed(multiplication_table, subgroup)) {
+    throw std::runtime_error(
+        "Error in make_generators: elements are not a subgroup");
+  }
+  std::vector<Index> generators;
+  IndexBitset generator_bits(multiplication_table.size());
+  IndexBitset closure(multiplication_table.size());
+  closure.insert(0);
+  for (Index i : subgroup.to_vector()) {
+    if (closure.contains(i)) {
+      continue;
+    }
+    generators.push_back(i);
+    generator_bits.insert(i);
+    closure = make_closure(multiplication_table, generator_bits);
+  }
+  return generators;
+}
+
+/// \brief Return true if a set of group elements is closed under
+///     multiplication
+///
+/// \param multiplication_table The group multiplication table
+/// \param elements Indices of group elements
+/// \returns True if `elements` is not empty and the product of every pair
+///     of elements is in `elements`, meaning `elements` is a subgroup
+bool is_closed(MultiplicationTable const &multiplication_table,
+               IndexBitset const &elements) {
+  std::vector<Index> members = elements.to_vector();
+  if (members.empty()) {
+    return false;
+  }
+  for (Index i : members) {
+    std::vector<Index> const &row = multiplication_table[i];
+    for (Index j : members) {
+      if (!elements.contains(row[j])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// \brief Return the left cosets, X*subgroup, of a subgroup
+///
+/// \param multiplication_table The group multiplication table
+/// \param subgroup Indices of the subgroup elements
+/// \returns The left cosets, ordered by their smallest element index, which
+///     is then the element X used to generate the coset. The first coset is
+///     `subgroup` itself.
+std::vector<IndexBitset> make_left_cosets(
+    MultiplicationTable const &multiplication_table,
+    IndexBitset const &subgroup) {
+  std::vector<Index> members = subgroup.to_vector();
+  std::vector<IndexBitset> cosets;
+  IndexBitset in_coset(multiplication_table.size());
+  for (Index X_index = 0; X_index < multiplication_table.size(); ++X_index) {
+    if (in_coset.contains(X_index)) {
+      continue;
+    }
+    std::vector<Index> const &X_row = multiplication_table[X_index];
+    IndexBitset coset(multiplication_table.size());
+    for (Index A_index : members) {
+      coset.insert(X_row[A_index]);
+    }
+    in_coset |= coset;
+    cosets.push_back(std::move(coset));
+  }
+  return cosets;
+}
+
+/// \brief Return the conjugate subgroup, X*subgroup*X^-1
+///
+/// \param multiplication_table The group multiplication table
+/// \param inverse_index The index of the inverse of each group element,
+///     as from `make_inverse_index`
+/// \param subgroup Indices of the subgroup elements
+/// \param X_index Index of the conjugating element
+/// \returns Indices of the conjugate subgroup elements
+IndexBitset make_conjugate(MultiplicationTable const &multiplication_table,
+                           std::vector<Index> const &inverse_index,
+                           IndexBitset const &subgroup, Index X_index) {
+  std::vector<Index> const &X_row = multiplication_table[X_index];
+  Index X_inv_index = inverse_index[X_index];
+  IndexBitset conjugate(multiplication_table.size());
+  for (Index A_index = subgroup.find_first(); A_index != IndexBitset::npos;
+       A_index = subgroup.find_next(A_index)) {
+    conjugate.insert(X_row[multiplication_table[A_index][X_inv_index]]);
+  }
+  return conjugate;
+}
+
+/// \brief Return the normalizer of a subgroup, the elements X for which
+///     X*subgroup*X^-1 == subgroup
+///
+/// \param multiplication_table The group multiplication table
+/// \param inverse_index The index of the inverse of each group element,
+///     as from `make_inverse_index`
+/// \param subgroup Indices of the subgroup elements
+/// \returns Indices of the elements of the normalizer of `subgroup`
+IndexBitset make_normalizer(MultiplicationTable const &multiplication_table,
+                            std::vector<Index> const &inverse_index,
+                            IndexBitset const &subgroup) {
+  IndexBitset normalizer;
+  _make_subgroup_orbit(multiplication_table, inverse_index, subgroup,
+                       &normalizer);
+  return normalizer;
+}
+
+/// \brief Return all cyclic subgroups, using the multiplication table
+///
+/// Same as `make_cyclic_subgroups(Group<ElementType> const &)`. The identity
+/// element must have index 0.
+///
+/// \param multiplication_table The group multiplication table
+/// \returns A set of orbits of cyclic subgroups
+///
+std::set<SubgroupOrbit> make_cyclic_subgroups(
+    MultiplicationTable const &multiplication_table) {
+  std::vector<Index> inverse_index = make_inverse_index(multiplication_table);
+  std::set<SubgroupOrbit> cyclic_subgroups;
+  for (Index i : _make_cyclic_generators(multiplication_table).generators) {
+    // Make orbit of subgroups equivalent to the cyclic subgroup of element
+    // `i` && Insert orbit
+    cyclic_subgroups.insert(_make_subgroup_orbit(
+        multiplication_table, inverse_index,
+        _make_cyclic_subgroup(multiplication_table, i)));
+  }
+  return cyclic_subgroups;
+}
+
+/// \brief Return all subgroups, using the multiplication table
+///
+/// Method:
+/// - Start with the trivial subgroup.
+/// - For one representative of each orbit of subgroups found, and for one
+///   generator of each distinct cyclic subgroup that is not already a
+///   member, find the subgroup generated by adding the generator, by
+///   closure with the multiplication table.
+/// - If the new subgroup is not yet found, make its orbit of equivalent
+///   subgroups and add it as a representative.
+/// - Repeat until no new subgroups are found.
+///
+/// Every subgroup can be formed by adding generators one at a time to the
+/// trivial subgroup, and adding conjugate generators to conjugate subgroups
+/// gives conjugate subgroups, so the method is complete. Subgroup membership
+/// is checked using bit sets, and found subgroups are looked up by hash.
+///
+/// For a representative H, adding generator g or its conjugate N*g*N^-1,
+/// for N in the normalizer of H, gives conjugate subgroups, so only one
+/// generator of each such class of cyclic subgroups is closed.
+///
+/// The identity element must have index 0.
+///
+/// \param multiplication_table The group multiplication table
+/// \returns A set of orbits of all subgroups
+///
+std::set<SubgroupOrbit> make_all_subgroups(
+    MultiplicationTable const &multiplication_table) {
+  Index n_elements = multiplication_table.size();
+  std::vector<Index> inverse_index = make_inverse_index(multiplication_table);
+  CyclicGenerators cyclic = _make_cyclic_generators(multiplication_table);
+  Index n_cyclic = cyclic.generators.size();
+
+  std::set<SubgroupOrbit> all_subgroups;
+  std::unordered_set<IndexBitset, IndexBitsetHash> found;
+  std::vector<GeneratedSubgroup> representatives;
+  std::vector<IndexBitset> normalizers;
+  auto _add_orbit = [&](GeneratedSubgroup subgroup) {
+    IndexBitset normalizer;
+    SubgroupOrbit orbit = _make_subgroup_orbit(
+        multiplication_table, inverse_index, subgroup.bits, &normalizer);
+    for (auto const &equiv_subgroup : orbit) {
+      found.insert(IndexBitset(n_elements, equiv_subgroup));
+    }
+    all_subgroups.insert(std::move(orbit));
+    representatives.push_back(std::move(subgroup));
+    normalizers.push_back(std::move(normalizer));
+  };
+
+  GeneratedSubgroup trivial_subgroup;
+  trivial_subgroup.members.push_back(0);
+  trivial_subgroup.bits = IndexBitset(n_elements);
+  trivial_subgroup.bits.insert(0);
+  _add_orbit(trivial_subgroup);
+
+  IndexBitset tried(n_cyclic);
+  for (Index r = 0; r < representatives.size(); ++r) {
+    GeneratedSubgroup const subgroup = representatives[r];
+    std::vector<Index> normalizer = normalizers[r].to_vector();
+    tried.clear();
+    for (Index c = 0; c < n_cyclic; ++c) {
+      Index generator = cyclic.generators[c];
+      if (tried.contains(c) || subgroup.bits.contains(generator)) {
+        continue;
+      }
+      // conjugates of the generator by the normalizer give conjugate results
+      for (Index N_index : normalizer) {
+        Index product_index =
+            multiplication_table[generator][inverse_index[N_index]];
+        Index conjugate_index = multiplication_table[N_index][product_index];
+        tried.insert(cyclic.cyclic_subgroup_index[conjugate_index]);
+      }
+      GeneratedSubgroup next =
+          _add_generator(multiplication_table, subgroup, generator);
+      if (found.count(next.bits)) {
+        continue;
+      }
+      _add_orbit(std::move(next));
+    }
+  }
+  return all_subgroups;
+}
+
+/// \brief Return all cyclic subgroups
+///
+/// \param multiplication_table The group multiplication table
+/// \returns A set of orbits of cyclic subgroups, generated by
+///     `make_cyclic_subgroups` the first time a multiplication table is seen
+std::shared_ptr<SubgroupCache::subgroups_type const>
+SubgroupCache::make_cyclic_subgroups(
+    MultiplicationTable const &multiplication_table) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_cyclic_subgroups.find(multiplication_table);
+    if (it != m_cyclic_subgroups.end()) {
+      return it->second;
+    }
+  }
+  auto subgroups = std::make_shared<subgroups_type const>(
+      group::make_cyclic_subgroups(multiplication_table));
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cyclic_subgroups.emplace(multiplication_table, subgroups)
+      .first->second;
+}
+
+/// \brief Return all subgroups
+///
+/// \param multiplication_table The group multiplication table
+/// \returns A set of orbits of all subgroups, generated by
+///     `make_all_subgroups` the first time a multiplication table is seen
+std::shared_ptr<SubgroupCache::subgroups_type const>
+SubgroupCache::make_all_subgroups(
+    MultiplicationTable const &multiplication_table) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_all_subgroups.find(multiplication_table);
+    if (it != m_all_subgroups.end()) {
+      return it->second;
+    }
+  }
+  auto subgroups = std::make_shared<subgroups_type const>(
+      group::make_all_subgroups(multiplication_table));
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_all_subgroups.emplace(multiplication_table, subgroups)
+      .first->second;
+}
+
+/// \brief Number of subgroup sets held in memory
+Index SubgroupCache::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cyclic_subgroups.size() + m_all_subgroups.size();
+}
+
+/// \brief Clear subgroups held in memory
+void SubgroupCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cyclic_subgroups.clear();
+  m_all_subgroups.clear();
+}
+
+/// \brief Process-wide SubgroupCache
+SubgroupCache &default_subgroup_cache() {
+  static SubgroupCache cache;
+  return cache;
+}
+
+}  // namespace group
+}  // namespace CASM
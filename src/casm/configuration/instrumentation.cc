@@ -0,0 +1,170 @@
+#include "casm/configuration/instrumentation.hh"
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace CASM {
+namespace config {
+namespace instrumentation {
+
+namespace {
+
+/// \brief ThreadData for all threads that have recorded values
+///
+/// ThreadData is kept after its thread exits, so that its values are still
+/// included in results.
+struct ThreadDataRegistry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<detail::ThreadData>> threads;
+};
+
+ThreadDataRegistry &registry() {
+  static ThreadDataRegistry *_registry = new ThreadDataRegistry();
+  return *_registry;
+}
+
+std::shared_ptr<detail::ThreadData> make_registered_thread_data() {
+  auto data = std::make_shared<detail::ThreadData>();
+  ThreadDataRegistry &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.threads.push_back(data);
+  return data;
+}
+
+}  // namespace
+
+namespace detail {
+
+std::atomic<bool> enabled(false);
+
+ThreadData::ThreadData() {
+  for (auto &value : counts) {
+    value.store(0, std::memory_order_relaxed);
+  }
+  for (auto &value : nanoseconds) {
+    value.store(0, std::memory_order_relaxed);
+  }
+  for (auto &value : calls) {
+    value.store(0, std::memory_order_relaxed);
+  }
+  depth.fill(0);
+}
+
+/// \brief Return the calling thread's ThreadData
+ThreadData &thread_data() {
+  thread_local std::shared_ptr<ThreadData> data =
+      make_registered_thread_data();
+  return *data;
+}
+
+}  // namespace detail
+
+/// \brief Name of a Counter
+std::string to_string(Counter counter) {
+  switch (counter) {
+    case Counter::op_applications:
+      return "op_applications";
+    case Counter::comparisons:
+      return "comparisons";
+    case Counter::permutations_built:
+      return "permutations_built";
+    case Counter::supercells_constructed:
+      return "supercells_constructed";
+    case Counter::canonical_forms:
+      return "canonical_forms";
+    default:
+      throw std::runtime_error(
+          "Error in instrumentation::to_string: invalid Counter");
+  }
+}
+
+/// \brief Name of a Timer
+std::string to_string(Timer timer) {
+  switch (timer) {
+    case Timer::supercell_sym_info:
+      return "supercell_sym_info";
+    case Timer::translation_permute:
+      return "translation_permute";
+    case Timer::canonical_form:
+      return "canonical_form";
+    case Timer::json_io:
+      return "json_io";
+    default:
+      throw std::runtime_error(
+          "Error in instrumentation::to_string: invalid Timer");
+  }
+}
+
+/// \brief Return true if instrumentation is compiled in
+///
+/// If false, `set_enabled(true)` has no effect on recorded values.
+bool is_compiled() {
+#ifdef CASM_CONFIG_ENABLE_INSTRUMENTATION
+  return true;
+#else
+  return false;
+#endif
+}
+
+/// \brief Start or stop recording
+void set_enabled(bool enabled) {
+  detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/// \brief Set all counts and times, on all threads, to zero
+///
+/// Values recorded concurrently with `reset` may or may not be kept.
+void reset() {
+  ThreadDataRegistry &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  for (auto const &data : r.threads) {
+    for (auto &value : data->counts) {
+      value.store(0, std::memory_order_relaxed);
+    }
+    for (auto &value : data->nanoseconds) {
+      value.store(0, std::memory_order_relaxed);
+    }
+    for (auto &value : data->calls) {
+      value.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+/// \brief Return instrumentation results, summed over all threads
+///
+/// All counters and timers are included, with value zero if not recorded.
+Results results() {
+  std::array<Index, detail::n_counters> counts{};
+  std::array<Index, detail::n_timers> nanoseconds{};
+  std::array<Index, detail::n_timers> calls{};
+  {
+    ThreadDataRegistry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto const &data : r.threads) {
+      for (int i = 0; i < detail::n_counters; ++i) {
+        counts[i] += data->counts[i].load(std::memory_order_relaxed);
+      }
+      for (int i = 0; i < detail::n_timers; ++i) {
+        nanoseconds[i] += data->nanoseconds[i].load(std::memory_order_relaxed);
+        calls[i] += data->calls[i].load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  Results _results;
+  for (int i = 0; i < detail::n_counters; ++i) {
+    _results.counts[to_string(static_cast<Counter>(i))] = counts[i];
+  }
+  for (int i = 0; i < detail::n_timers; ++i) {
+    std::string name = to_string(static_cast<Timer>(i));
+    _results.seconds[name] = nanoseconds[i] * 1e-9;
+    _results.calls[name] = calls[i];
+  }
+  return _results;
+}
+
+}  // namespace instrumentation
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,1605 @@
+#include "casm/configuration/io/binary/ConfigurationSet_binary_io.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+
+#include "casm/clexulator/ConfigDoFValuesTools_impl.hh"
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+
+namespace CASM {
+
+namespace {  // (anonymous)
+
+char const binary_magic[8] = {'C', 'A', 'S', 'M', 'C', 'S', 'E', 'T'};
+std::uint64_t const binary_version = 1;
+std::uint64_t const binary_flag_compressed = 1;
+std::uint64_t const binary_flag_single_precision = 2;
+
+/// Size of the footer: chunk table offset and magic
+std::streamoff const binary_footer_size = 16;
+
+/// \brief Append little-endian values to a byte buffer
+class ByteWriter {
+ public:
+  explicit ByteWriter(std::vector<std::uint8_t> &_data) : m_data(_data) {}
+
+  void put_u64(std::uint64_t value) {
+    for (int k = 0; k < 8; ++k) {
+      m_data.push_back(static_cast<std::uint8_t>(value >> (8 * k)));
+    }
+  }
+
+  void put_double(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    put_u64(bits);
+  }
+
+  void put_float(double value) {
+    float single = static_cast<float>(value);
+    std::uint32_t bits;
+    std::memcpy(&bits, &single, sizeof(bits));
+    for (int k = 0; k < 4; ++k) {
+      m_data.push_back(static_cast<std::uint8_t>(bits >> (8 * k)));
+    }
+  }
+
+  /// \brief Write a continuous DoF value, as float if `single_precision`
+  void put_value(double value, bool single_precision) {
+    if (single_precision) {
+      put_float(value);
+    } else {
+      put_double(value);
+    }
+  }
+
+  void put_string(std::string const &value) {
+    put_u64(value.size());
+    m_data.insert(m_data.end(), value.begin(), value.end());
+  }
+
+ private:
+  std::vector<std::uint8_t> &m_data;
+};
+
+/// \brief Read little-endian values from a byte buffer
+class ByteReader {
+ public:
+  ByteReader(std::uint8_t const *_data, Index _size)
+      : m_data(_data), m_size(_size), m_pos(0) {}
+
+  std::uint64_t get_u64() {
+    _require(8);
+    std::uint64_t value = 0;
+    for (int k = 0; k < 8; ++k) {
+      value |= static_cast<std::uint64_t>(m_data[m_pos + k]) << (8 * k);
+    }
+    m_pos += 8;
+    return value;
+  }
+
+  double get_double() {
+    std::uint64_t bits = get_u64();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  double get_float() {
+    _require(4);
+    std::uint32_t bits = 0;
+    for (int k = 0; k < 4; ++k) {
+      bits |= static_cast<std::uint32_t>(m_data[m_pos + k]) << (8 * k);
+    }
+    m_pos += 4;
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  /// \brief Read a continuous DoF value, stored as float if
+  ///     `single_precision`
+  double get_value(bool single_precision) {
+    return single_precision ? get_float() : get_double();
+  }
+
+  std::string get_string() {
+    Index n = get_u64();
+    _require(n);
+    std::string value(reinterpret_cast<char const *>(m_data + m_pos), n);
+    m_pos += n;
+    return value;
+  }
+
+  std::uint8_t get_u8() {
+    _require(1);
+    return m_data[m_pos++];
+  }
+
+  Index pos() const { return m_pos; }
+
+  void seek(Index pos) { m_pos = pos; }
+
+ private:
+  void _require(Index n) const {
+    if (n < 0 || m_pos + n > m_size) {
+      throw std::runtime_error(
+          "Error reading ConfigurationSet binary data: unexpected end of "
+          "data");
+    }
+  }
+
+  std::uint8_t const *m_data;
+  Index m_size;
+  Index m_pos;
+};
+
+/// \brief Write bytes to a stream and count them
+void write_bytes(std::ostream &out, std::uint8_t const *data, Index size,
+                 std::uint64_t &n_written) {
+  out.write(reinterpret_cast<char const *>(data), size);
+  if (!out) {
+    throw std::runtime_error(
+        "Error writing ConfigurationSet binary data: write failed");
+  }
+  n_written += size;
+}
+
+/// \brief Read bytes from a stream
+void read_bytes(std::istream &in, std::uint8_t *data, Index size) {
+  in.read(reinterpret_cast<char *>(data), size);
+  if (in.gcount() != size) {
+    throw std::runtime_error(
+        "Error reading ConfigurationSet binary data: unexpected end of "
+        "stream");
+  }
+}
+
+/// \brief Write a block: uncompressed size, stored size, data
+void write_block(std::ostream &out, std::vector<std::uint8_t> const &raw,
+                 bool compress, std::uint64_t &n_written) {
+  std::vector<std::uint8_t> compressed;
+  std::vector<std::uint8_t> const *stored = &raw;
+  if (compress) {
+    uLongf stored_size = compressBound(raw.size());
+    compressed.resize(stored_size);
+    if (compress2(compressed.data(), &stored_size, raw.data(), raw.size(),
+                  Z_DEFAULT_COMPRESSION) != Z_OK) {
+      throw std::runtime_error(
+          "Error writing ConfigurationSet binary data: compression failed");
+    }
+    compressed.resize(stored_size);
+    stored = &compressed;
+  }
+  std::vector<std::uint8_t> header;
+  ByteWriter writer(header);
+  writer.put_u64(raw.size());
+  writer.put_u64(stored->size());
+  write_bytes(out, header.data(), header.size(), n_written);
+  write_bytes(out, stored->data(), stored->size(), n_written);
+}
+
+/// \brief Decompress the stored data of a block
+std::vector<std::uint8_t> uncompress_block(std::uint8_t const *stored,
+                                           Index stored_size, Index raw_size) {
+  std::vector<std::uint8_t> raw(raw_size);
+  uLongf dest_size = raw_size;
+  if (uncompress(raw.data(), &dest_size, stored, stored_size) != Z_OK ||
+      Index(dest_size) != raw_size) {
+    throw std::runtime_error(
+        "Error reading ConfigurationSet binary data: decompression failed");
+  }
+  return raw;
+}
+
+/// \brief Read a block written by write_block
+std::vector<std::uint8_t> read_block(std::istream &in, bool compressed) {
+  std::uint8_t header[16];
+  read_bytes(in, header, 16);
+  ByteReader reader(header, 16);
+  Index raw_size = reader.get_u64();
+  Index stored_size = reader.get_u64();
+  std::vector<std::uint8_t> stored(stored_size);
+  read_bytes(in, stored.data(), stored_size);
+  if (!compressed) {
+    if (raw_size != stored_size) {
+      throw std::runtime_error(
+          "Error reading ConfigurationSet binary data: inconsistent block "
+          "size");
+    }
+    return stored;
+  }
+  return uncompress_block(stored.data(), stored_size, raw_size);
+}
+
+/// \brief Prim basis dimension of each global and local DoF
+void make_dof_dims(config::Prim const &prim,
+                   std::vector<std::pair<std::string, Index>> &global_dof_dim,
+                   std::vector<std::pair<std::string, Index>> &local_dof_dim) {
+  global_dof_dim.clear();
+  for (auto const &name_info : prim.global_dof_info) {
+    global_dof_dim.emplace_back(name_info.first,
+                                name_info.second.basis().cols());
+  }
+  local_dof_dim.clear();
+  for (auto const &name_info : prim.local_dof_info) {
+    local_dof_dim.emplace_back(name_info.first,
+                               clexulator::max_dim(name_info.second));
+  }
+}
+
+/// \brief Number of sites in a supercell
+Index n_sites(config::Supercell const &supercell) {
+  return supercell.unitcellcoord_index_converter.total_sites();
+}
+
+/// \brief A block in mapped memory
+struct MappedBlock {
+  /// Stored data, in mapped memory
+  std::uint8_t const *stored;
+
+  /// Size of the stored data
+  Index stored_size;
+
+  /// Size of the uncompressed data
+  Index raw_size;
+};
+
+/// \brief Locate the block written by write_block at `offset` in mapped
+///     memory
+MappedBlock map_block(std::uint8_t const *data, Index size, Index offset,
+                      bool compressed) {
+  if (offset < 0 || offset + 16 > size) {
+    throw std::runtime_error(
+        "Error reading ConfigurationSet binary data: invalid block offset");
+  }
+  ByteReader reader(data + offset, 16);
+  MappedBlock block;
+  block.raw_size = reader.get_u64();
+  block.stored_size = reader.get_u64();
+  block.stored = data + offset + 16;
+  if (block.stored_size < 0 || block.stored_size > size - offset - 16 ||
+      (!compressed && block.raw_size != block.stored_size)) {
+    throw std::runtime_error(
+        "Error reading ConfigurationSet binary data: inconsistent block "
+        "size");
+  }
+  return block;
+}
+
+/// \brief Check the header and read the flags and chunk size
+void read_header(std::uint8_t const *header, bool &compressed,
+                 bool &single_precision, Index &chunk_size) {
+  if (std::memcmp(header, binary_magic, 8) != 0) {
+    throw std::runtime_error(
+        "Error reading ConfigurationSet binary data: invalid format");
+  }
+  ByteReader header_reader(header + 8, 24);
+  std::uint64_t version = header_reader.get_u64();
+  if (version != binary_version) {
+    std::stringstream msg;
+    msg << "Error reading ConfigurationSet binary data: version mismatch: "
+        << "found: " << version << " expected: " << binary_version;
+    throw std::runtime_error(msg.str());
+  }
+  std::uint64_t flags = header_reader.get_u64();
+  compressed = (flags & binary_flag_compressed);
+  single_precision = (flags & binary_flag_single_precision);
+  chunk_size = header_reader.get_u64();
+  if (chunk_size <= 0) {
+    throw std::runtime_error(
+        "Error reading ConfigurationSet binary data: invalid chunk size");
+  }
+}
+
+/// \brief Read the metadata block, finding or adding supercells by name
+void read_metadata(
+    ByteReader &reader, config::SupercellSet &supercells,
+    std::vector<std::shared_ptr<config::Supercell const>> &supercell_list,
+    std::vector<std::string> &supercell_names,
+    std::vector<std::pair<std::string, Index>> &global_dof_dim,
+    std::vector<std::pair<std::string, Index>> &local_dof_dim,
+    std::map<std::string, Index> &next_config_id,
+    std::vector<Index> &supercell_index,
+    std::vector<std::string> &configuration_id) {
+  std::shared_ptr<config::Prim const> prim = supercells.prim();
+  Index n_supercells = reader.get_u64();
+  for (Index s = 0; s < n_supercells; ++s) {
+    std::string name = reader.get_string();
+    config::SupercellRecord const *record =
+        &*supercells.insert_canonical(name).first;
+    supercell_list.push_back(record->supercell);
+    supercell_names.push_back(name);
+  }
+
+  // DoF are checked against the prim only if there are configurations,
+  // because an empty ConfigurationSet is written without DoF keys
+  Index n_global = reader.get_u64();
+  for (Index k = 0; k < n_global; ++k) {
+    std::string key = reader.get_string();
+    Index dim = reader.get_u64();
+    global_dof_dim.emplace_back(key, dim);
+  }
+  Index n_local = reader.get_u64();
+  for (Index k = 0; k < n_local; ++k) {
+    std::string key = reader.get_string();
+    Index dim = reader.get_u64();
+    local_dof_dim.emplace_back(key, dim);
+  }
+
+  Index n_next_config_id = reader.get_u64();
+  for (Index k = 0; k < n_next_config_id; ++k) {
+    std::string name = reader.get_string();
+    next_config_id[name] = reader.get_u64();
+  }
+
+  Index n_configs = reader.get_u64();
+  if (n_configs > 0) {
+    std::vector<std::pair<std::string, Index>> expected_global_dof_dim;
+    std::vector<std::pair<std::string, Index>> expected_local_dof_dim;
+    make_dof_dims(*prim, expected_global_dof_dim, expected_local_dof_dim);
+    if (expected_global_dof_dim != global_dof_dim ||
+        expected_local_dof_dim != local_dof_dim) {
+      throw std::runtime_error(
+          "Error reading ConfigurationSet binary data: DoF are inconsistent "
+          "with the prim");
+    }
+  }
+  supercell_index.resize(n_configs);
+  for (Index i = 0; i < n_configs; ++i) {
+    supercell_index[i] = reader.get_u64();
+    if (supercell_index[i] >= n_supercells) {
+      throw std::runtime_error(
+          "Error reading ConfigurationSet binary data: invalid supercell "
+          "index");
+    }
+  }
+  configuration_id.resize(n_configs);
+  for (Index i = 0; i < n_configs; ++i) {
+    configuration_id[i] = reader.get_string();
+  }
+}
+
+/// \brief Location of one configuration's values in a chunk block
+struct ChunkPosition {
+  /// Index of the configuration in the chunk
+  Index index;
+
+  /// Number of configurations in the chunk
+  Index n_configs;
+
+  /// Number of sites of the configurations preceding it in the chunk
+  Index sites_before;
+
+  /// Number of sites of all configurations in the chunk
+  Index sites_total;
+};
+
+/// \brief Make the ChunkPosition of configuration i
+///
+/// \param n_sites_of Number of sites of each configuration, by
+///     configuration index
+/// \param chunk_size Number of configurations per chunk
+/// \param n_configs Total number of configurations
+/// \param i Configuration index
+template <typename NSitesOf>
+ChunkPosition make_chunk_position(NSitesOf n_sites_of, Index chunk_size,
+                                  Index n_configs, Index i) {
+  Index begin = (i / chunk_size) * chunk_size;
+  Index end = std::min(begin + chunk_size, n_configs);
+  ChunkPosition position{i - begin, end - begin, 0, 0};
+  for (Index j = begin; j < end; ++j) {
+    Index n = n_sites_of(j);
+    if (j < i) {
+      position.sites_before += n;
+    }
+    position.sites_total += n;
+  }
+  return position;
+}
+
+/// \brief Read the DoF values of one configuration from a chunk block
+///
+/// Continuous DoF values stored in single precision are promoted to double.
+void read_dof_values(
+    ByteReader &reader, ChunkPosition const &position,
+    std::vector<std::pair<std::string, Index>> const &global_dof_dim,
+    std::vector<std::pair<std::string, Index>> const &local_dof_dim,
+    bool single_precision, clexulator::ConfigDoFValues &dof_values) {
+  Index w = single_precision ? 4 : 8;
+  Index n = dof_values.occupation.size();
+  reader.seek(position.sites_before);
+  for (Index l = 0; l < n; ++l) {
+    dof_values.occupation[l] = reader.get_u8();
+  }
+  Index column_begin = position.sites_total;
+  for (auto const &key_dim : global_dof_dim) {
+    Index dim = key_dim.second;
+    reader.seek(column_begin + w * dim * position.index);
+    Eigen::VectorXd &values = dof_values.global_dof_values.at(key_dim.first);
+    for (Index k = 0; k < dim; ++k) {
+      values[k] = reader.get_value(single_precision);
+    }
+    column_begin += w * dim * position.n_configs;
+  }
+  for (auto const &key_dim : local_dof_dim) {
+    Index dim = key_dim.second;
+    reader.seek(column_begin + w * dim * position.sites_before);
+    Eigen::MatrixXd &values = dof_values.local_dof_values.at(key_dim.first);
+    for (Index k = 0; k < dim * n; ++k) {
+      values.data()[k] = reader.get_value(single_precision);
+    }
+    column_begin += w * dim * position.sites_total;
+  }
+}
+
+/// \brief Write the header
+void write_header(std::ostream &out, bool compress, bool single_precision,
+                  Index chunk_size, std::uint64_t &n_written) {
+  std::vector<std::uint8_t> data;
+  ByteWriter writer(data);
+  write_bytes(out, reinterpret_cast<std::uint8_t const *>(binary_magic), 8,
+              n_written);
+  writer.put_u64(binary_version);
+  writer.put_u64((compress ? binary_flag_compressed : 0) |
+                 (single_precision ? binary_flag_single_precision : 0));
+  writer.put_u64(chunk_size);
+  write_bytes(out, data.data(), data.size(), n_written);
+}
+
+/// \brief Write the metadata block
+void write_metadata(
+    std::ostream &out, std::vector<std::string> const &supercell_names,
+    std::vector<std::pair<std::string, Index>> const &global_dof_dim,
+    std::vector<std::pair<std::string, Index>> const &local_dof_dim,
+    std::map<std::string, Index> const &next_config_id,
+    std::vector<Index> const &config_supercell_index,
+    std::vector<std::string const *> const &configuration_id, bool compress,
+    std::uint64_t &n_written) {
+  std::vector<std::uint8_t> data;
+  ByteWriter writer(data);
+  writer.put_u64(supercell_names.size());
+  for (auto const &name : supercell_names) {
+    writer.put_string(name);
+  }
+  writer.put_u64(global_dof_dim.size());
+  for (auto const &key_dim : global_dof_dim) {
+    writer.put_string(key_dim.first);
+    writer.put_u64(key_dim.second);
+  }
+  writer.put_u64(local_dof_dim.size());
+  for (auto const &key_dim : local_dof_dim) {
+    writer.put_string(key_dim.first);
+    writer.put_u64(key_dim.second);
+  }
+  writer.put_u64(next_config_id.size());
+  for (auto const &name_id : next_config_id) {
+    writer.put_string(name_id.first);
+    writer.put_u64(name_id.second);
+  }
+  writer.put_u64(config_supercell_index.size());
+  for (Index s : config_supercell_index) {
+    writer.put_u64(s);
+  }
+  for (auto const *id : configuration_id) {
+    writer.put_string(*id);
+  }
+  write_block(out, data, compress, n_written);
+}
+
+/// \brief Write a chunk block, with DoF values in columns
+void write_chunk(
+    std::ostream &out,
+    std::vector<config::Configuration const *> const &configurations,
+    std::vector<std::pair<std::string, Index>> const &global_dof_dim,
+    std::vector<std::pair<std::string, Index>> const &local_dof_dim,
+    bool compress, bool single_precision, std::uint64_t &n_written) {
+  std::vector<std::uint8_t> data;
+  ByteWriter writer(data);
+  for (auto const *configuration : configurations) {
+    Eigen::VectorXi const &occupation = configuration->dof_values.occupation;
+    for (Index l = 0; l < occupation.size(); ++l) {
+      if (occupation[l] < 0 || occupation[l] > 255) {
+        throw std::runtime_error(
+            "Error in write_binary: occupant index out of range");
+      }
+      data.push_back(static_cast<std::uint8_t>(occupation[l]));
+    }
+  }
+  for (auto const &key_dim : global_dof_dim) {
+    for (auto const *configuration : configurations) {
+      Eigen::VectorXd const &values =
+          configuration->dof_values.global_dof_values.at(key_dim.first);
+      if (values.size() != key_dim.second) {
+        throw std::runtime_error("Error in write_binary: global DoF '" +
+                                 key_dim.first + "' is not in the prim basis");
+      }
+      for (Index k = 0; k < values.size(); ++k) {
+        writer.put_value(values[k], single_precision);
+      }
+    }
+  }
+  for (auto const &key_dim : local_dof_dim) {
+    for (auto const *configuration : configurations) {
+      Eigen::MatrixXd const &values =
+          configuration->dof_values.local_dof_values.at(key_dim.first);
+      if (values.rows() != key_dim.second ||
+          values.cols() != n_sites(*configuration->supercell)) {
+        throw std::runtime_error("Error in write_binary: local DoF '" +
+                                 key_dim.first + "' is not in the prim basis");
+      }
+      for (Index k = 0; k < values.size(); ++k) {
+        writer.put_value(values.data()[k], single_precision);
+      }
+    }
+  }
+  write_block(out, data, compress, n_written);
+}
+
+/// \brief Write the chunk table and footer
+void write_chunk_table_and_footer(
+    std::ostream &out, std::vector<std::uint64_t> const &chunk_offset,
+    std::uint64_t &n_written) {
+  std::uint64_t table_offset = n_written;
+  std::vector<std::uint8_t> data;
+  ByteWriter writer(data);
+  writer.put_u64(chunk_offset.size());
+  for (std::uint64_t offset : chunk_offset) {
+    writer.put_u64(offset);
+  }
+  writer.put_u64(table_offset);
+  write_bytes(out, data.data(), data.size(), n_written);
+  write_bytes(out, reinterpret_cast<std::uint8_t const *>(binary_magic), 8,
+              n_written);
+}
+
+}  // namespace
+
+/// \brief Write ConfigurationSet in binary columnar format
+///
+/// \param configurations The ConfigurationSet
+/// \param out The output stream. Need not be seekable.
+/// \param compress If true, compress each block with zlib
+/// \param chunk_size Number of configurations per chunk block. Larger
+///     chunks compress better, smaller chunks make random access faster.
+/// \param single_precision If true, store continuous DoF values as IEEE
+///     754 32-bit floats, halving their size. Values are rounded to float
+///     (about 7 significant digits) and promoted to double when read.
+///
+/// See ConfigurationSetBinaryReader for a description of the format.
+/// Configurations are written in ConfigurationSet order, one chunk at a
+/// time. DoF values are written in the prim basis.
+void write_binary(config::ConfigurationSet const &configurations,
+                  std::ostream &out, bool compress, Index chunk_size,
+                  bool single_precision) {
+  if (chunk_size <= 0) {
+    throw std::runtime_error(
+        "Error in write_binary: chunk_size must be positive");
+  }
+  std::vector<config::ConfigurationRecord const *> records;
+  records.reserve(configurations.size());
+  for (auto const &record : configurations) {
+    records.push_back(&record);
+  }
+
+  std::vector<std::pair<std::string, Index>> global_dof_dim;
+  std::vector<std::pair<std::string, Index>> local_dof_dim;
+  if (!records.empty()) {
+    make_dof_dims(*records.front()->configuration.supercell->prim,
+                  global_dof_dim, local_dof_dim);
+  }
+
+  std::vector<std::string> supercell_names;
+  std::map<std::string, Index> supercell_index;
+  std::vector<Index> config_supercell_index;
+  std::vector<std::string const *> configuration_id;
+  config_supercell_index.reserve(records.size());
+  configuration_id.reserve(records.size());
+  for (auto const *record : records) {
+    auto res =
+        supercell_index.emplace(record->supercell_name, supercell_names.size());
+    if (res.second) {
+      supercell_names.push_back(record->supercell_name);
+    }
+    config_supercell_index.push_back(res.first->second);
+    configuration_id.push_back(&record->configuration_id);
+  }
+
+  std::uint64_t n_written = 0;
+  write_header(out, compress, single_precision, chunk_size, n_written);
+  write_metadata(out, supercell_names, global_dof_dim, local_dof_dim,
+                 configurations.next_config_id(), config_supercell_index,
+                 configuration_id, compress, n_written);
+
+  std::vector<std::uint64_t> chunk_offset;
+  std::vector<config::Configuration const *> chunk;
+  Index n_configs = records.size();
+  for (Index begin = 0; begin < n_configs; begin += chunk_size) {
+    Index end = std::min(begin + chunk_size, n_configs);
+    chunk.clear();
+    for (Index i = begin; i < end; ++i) {
+      chunk.push_back(&records[i]->configuration);
+    }
+    chunk_offset.push_back(n_written);
+    write_chunk(out, chunk, global_dof_dim, local_dof_dim, compress,
+                single_precision, n_written);
+  }
+  write_chunk_table_and_footer(out, chunk_offset, n_written);
+}
+
+/// \brief Constructor
+///
+/// \param _path The file to write. It is written by `finish`.
+/// \param _compress If true, compress each block with zlib
+/// \param _chunk_size Number of configurations per chunk block
+/// \param _single_precision If true, store continuous DoF values as
+///     32-bit floats (see `write_binary`)
+///
+/// Chunk blocks are written to the temporary file `_path` + ".chunks",
+/// which is removed by `finish` or on destruction.
+ConfigurationSetBinaryWriter::ConfigurationSetBinaryWriter(
+    fs::path const &_path, bool _compress, Index _chunk_size,
+    bool _single_precision)
+    : m_path(_path),
+      m_chunk_path(_path.string() + ".chunks"),
+      m_compress(_compress),
+      m_single_precision(_single_precision),
+      m_chunk_size(_chunk_size),
+      m_finished(false),
+      m_n_chunk_bytes(0) {
+  if (m_chunk_size <= 0) {
+    throw std::runtime_error(
+        "Error in ConfigurationSetBinaryWriter: chunk_size must be positive");
+  }
+  m_chunk_out.open(m_chunk_path, std::ios::binary | std::ios::trunc);
+  if (!m_chunk_out) {
+    throw std::runtime_error(
+        "Error in ConfigurationSetBinaryWriter: could not open '" +
+        m_chunk_path.string() + "'");
+  }
+}
+
+/// \brief Removes the temporary file
+ConfigurationSetBinaryWriter::~ConfigurationSetBinaryWriter() {
+  if (m_chunk_out.is_open()) {
+    m_chunk_out.close();
+  }
+  try {
+    fs::remove(m_chunk_path);
+  } catch (std::exception const &e) {
+    // leave the file
+  }
+}
+
+/// \brief Write one configuration
+///
+/// \param supercell_name The canonical supercell name
+/// \param configuration_id The configuration id
+/// \param configuration The configuration, with DoF values in the prim
+///     basis. All configurations must have the same prim.
+void ConfigurationSetBinaryWriter::write(
+    std::string const &supercell_name, std::string const &configuration_id,
+    config::Configuration const &configuration) {
+  if (m_finished) {
+    throw std::runtime_error(
+        "Error in ConfigurationSetBinaryWriter::write: already finished");
+  }
+  if (m_config_supercell_index.empty()) {
+    make_dof_dims(*configuration.supercell->prim, m_global_dof_dim,
+                  m_local_dof_dim);
+  }
+  auto res =
+      m_supercell_index.emplace(supercell_name, m_supercell_names.size());
+  if (res.second) {
+    m_supercell_names.push_back(supercell_name);
+  }
+  m_config_supercell_index.push_back(res.first->second);
+  m_configuration_id.push_back(configuration_id);
+  m_chunk.push_back(configuration);
+  if (Index(m_chunk.size()) == m_chunk_size) {
+    _write_chunk();
+  }
+}
+
+/// \brief Write the file
+///
+/// \param next_config_id IDs, by supercell_name, used to automatically ID
+///     new configurations when the file is read into a ConfigurationSet
+///
+/// Writes the header and metadata block to `path`, copies the chunk blocks
+/// from the temporary file, writes the chunk table and footer, and removes
+/// the temporary file. No more configurations may be written.
+void ConfigurationSetBinaryWriter::finish(
+    std::map<std::string, Index> const &next_config_id) {
+  if (m_finished) {
+    throw std::runtime_error(
+        "Error in ConfigurationSetBinaryWriter::finish: already finished");
+  }
+  if (!m_chunk.empty()) {
+    _write_chunk();
+  }
+  m_chunk_out.close();
+  if (!m_chunk_out) {
+    throw std::runtime_error(
+        "Error in ConfigurationSetBinaryWriter::finish: write failed");
+  }
+  m_finished = true;
+
+  std::ofstream out(m_path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error(
+        "Error in ConfigurationSetBinaryWriter::finish: could not open '" +
+        m_path.string() + "'");
+  }
+  std::vector<std::string const *> configuration_id;
+  configuration_id.reserve(m_configuration_id.size());
+  for (auto const &id : m_configuration_id) {
+    configuration_id.push_back(&id);
+  }
+  std::uint64_t n_written = 0;
+  write_header(out, m_compress, m_single_precision, m_chunk_size, n_written);
+  write_metadata(out, m_supercell_names, m_global_dof_dim, m_local_dof_dim,
+                 next_config_id, m_config_supercell_index, configuration_id,
+                 m_compress, n_written);
+
+  // chunk blocks, copied from the temporary file
+  std::uint64_t chunks_begin = n_written;
+  if (m_n_chunk_bytes) {
+    std::ifstream in(m_chunk_path, std::ios::binary);
+    out << in.rdbuf();
+    if (!out) {
+      throw std::runtime_error(
+          "Error in ConfigurationSetBinaryWriter::finish: write failed");
+    }
+    n_written += m_n_chunk_bytes;
+  }
+  std::vector<std::uint64_t> chunk_offset;
+  chunk_offset.reserve(m_chunk_offset.size());
+  for (std::uint64_t offset : m_chunk_offset) {
+    chunk_offset.push_back(chunks_begin + offset);
+  }
+  write_chunk_table_and_footer(out, chunk_offset, n_written);
+  out.close();
+  if (!out) {
+    throw std::runtime_error(
+        "Error in ConfigurationSetBinaryWriter::finish: write failed");
+  }
+  fs::remove(m_chunk_path);
+}
+
+/// \brief Write the configurations held in m_chunk to the temporary file
+void ConfigurationSetBinaryWriter::_write_chunk() {
+  std::vector<config::Configuration const *> chunk;
+  chunk.reserve(m_chunk.size());
+  for (auto const &configuration : m_chunk) {
+    chunk.push_back(&configuration);
+  }
+  m_chunk_offset.push_back(m_n_chunk_bytes);
+  write_chunk(m_chunk_out, chunk, m_global_dof_dim, m_local_dof_dim,
+              m_compress, m_single_precision, m_n_chunk_bytes);
+  m_chunk.clear();
+}
+
+/// \brief Read ConfigurationSet from binary columnar format
+///
+/// \param supercells The SupercellSet, used to find or add supercells by
+///     name
+/// \param configurations The ConfigurationSet, which is cleared and then
+///     filled with the configurations read
+/// \param in The input stream. Need not be seekable.
+///
+/// Chunks are read sequentially, so at most one decompressed chunk is held
+/// in memory at a time.
+void read_binary(config::SupercellSet &supercells,
+                 config::ConfigurationSet &configurations, std::istream &in) {
+  configurations.clear();
+  ConfigurationSetBinaryReader reader(in, supercells);
+  for (Index i = 0; i < reader.size(); ++i) {
+    configurations.insert(reader.read(i));
+  }
+  configurations.set_next_config_id(reader.next_config_id());
+}
+
+/// \brief Constructor
+///
+/// \param in The input stream, positioned at the start of the binary data.
+///     Must remain valid for the lifetime of the reader.
+/// \param supercells The SupercellSet, used to find or add supercells by
+///     name
+///
+/// Reads the header and metadata block. Throws if the format is invalid or
+/// DoF types and dimensions are inconsistent with the prim.
+ConfigurationSetBinaryReader::ConfigurationSetBinaryReader(
+    std::istream &in, config::SupercellSet &supercells)
+    : m_in(in),
+      m_begin(in.tellg()),
+      m_next_chunk(0),
+      m_chunk_index(-1) {
+  std::uint8_t header[32];
+  read_bytes(m_in, header, 32);
+  read_header(header, m_compressed, m_single_precision, m_chunk_size);
+
+  std::vector<std::uint8_t> meta = read_block(m_in, m_compressed);
+  ByteReader reader(meta.data(), meta.size());
+  read_metadata(reader, supercells, m_supercells, m_supercell_names,
+                m_global_dof_dim, m_local_dof_dim, m_next_config_id,
+                m_supercell_index, m_configuration_id);
+  m_index_by_name.reserve(size());
+  for (Index i = 0; i < size(); ++i) {
+    m_index_by_name.emplace(configuration_name(i), i);
+  }
+}
+
+/// \brief Number of configurations
+Index ConfigurationSetBinaryReader::size() const {
+  return m_configuration_id.size();
+}
+
+/// \brief IDs, by supercell_name, used to automatically ID new
+///     configurations
+std::map<std::string, Index> const &
+ConfigurationSetBinaryReader::next_config_id() const {
+  return m_next_config_id;
+}
+
+/// \brief Name of configuration i (i.e. "SCEL4_2_2_1_0_0_0/2")
+std::string ConfigurationSetBinaryReader::configuration_name(Index i) const {
+  return m_supercell_names[m_supercell_index[i]] + "/" +
+         m_configuration_id[i];
+}
+
+/// \brief Index of configuration by name, or size() if not found
+Index ConfigurationSetBinaryReader::find_by_name(
+    std::string const &configuration_name) const {
+  auto it = m_index_by_name.find(configuration_name);
+  if (it == m_index_by_name.end()) {
+    return size();
+  }
+  return it->second;
+}
+
+/// \brief Read configuration i
+///
+/// Reading configurations in increasing order reads each chunk once.
+config::ConfigurationRecord ConfigurationSetBinaryReader::read(Index i) {
+  if (i < 0 || i >= size()) {
+    throw std::runtime_error(
+        "Error in ConfigurationSetBinaryReader::read: index out of range");
+  }
+  _load_chunk(i / m_chunk_size);
+
+  // offsets of configuration i within each column
+  ChunkPosition position = make_chunk_position(
+      [&](Index j) { return n_sites(*m_supercells[m_supercell_index[j]]); },
+      m_chunk_size, size(), i);
+
+  config::Configuration configuration(m_supercells[m_supercell_index[i]]);
+  ByteReader reader(m_chunk.data(), m_chunk.size());
+  read_dof_values(reader, position, m_global_dof_dim, m_local_dof_dim,
+                  m_single_precision, configuration.dof_values);
+
+  return config::ConfigurationRecord(configuration,
+                                     m_supercell_names[m_supercell_index[i]],
+                                     m_configuration_id[i]);
+}
+
+/// \brief Read chunk c into m_chunk, if not already held
+///
+/// If c is the next chunk in the stream, it is read directly. Otherwise,
+/// the chunk table is read from the footer (once), and the stream is
+/// positioned at chunk c.
+void ConfigurationSetBinaryReader::_load_chunk(Index c) {
+  if (c == m_chunk_index) {
+    return;
+  }
+  if (c != m_next_chunk) {
+    if (m_chunk_offset.empty()) {
+      m_in.clear();
+      m_in.seekg(-binary_footer_size, std::ios::end);
+      std::uint8_t footer[8];
+      read_bytes(m_in, footer, 8);
+      ByteReader footer_reader(footer, 8);
+      std::streamoff table_offset = footer_reader.get_u64();
+
+      m_in.seekg(m_begin + table_offset);
+      std::uint8_t count[8];
+      read_bytes(m_in, count, 8);
+      ByteReader count_reader(count, 8);
+      Index n_chunks = count_reader.get_u64();
+      std::vector<std::uint8_t> table(8 * n_chunks);
+      read_bytes(m_in, table.data(), table.size());
+      ByteReader table_reader(table.data(), table.size());
+      for (Index k = 0; k < n_chunks; ++k) {
+        m_chunk_offset.push_back(table_reader.get_u64());
+      }
+    }
+    if (c >= Index(m_chunk_offset.size())) {
+      throw std::runtime_error(
+          "Error reading ConfigurationSet binary data: invalid chunk index");
+    }
+    m_in.clear();
+    m_in.seekg(m_begin + m_chunk_offset[c]);
+    if (!m_in) {
+      throw std::runtime_error(
+          "Error reading ConfigurationSet binary data: seek failed");
+    }
+  }
+  m_chunk = read_block(m_in, m_compressed);
+  m_chunk_index = c;
+  m_next_chunk = c + 1;
+}
+
+/// \brief Constructor
+///
+/// \param path Path of a file written by `write_binary`
+/// \param supercells The SupercellSet, used to find or add supercells by
+///     name
+///
+/// Maps the file read-only and reads the header and metadata block, then
+/// sorts configuration indices by name. DoF values are read from the
+/// mapped data only when a configuration is read. Throws if the file cannot
+/// be mapped, the format is invalid, or DoF types and dimensions are
+/// inconsistent with the prim.
+ConfigurationSetMappedReader::ConfigurationSetMappedReader(
+    fs::path const &path, config::SupercellSet &supercells)
+    : m_data(nullptr), m_size(0), m_chunk_index(-1) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Error in ConfigurationSetMappedReader: could "
+                             "not open '" +
+                             path.string() + "'");
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size < 32 + binary_footer_size) {
+    ::close(fd);
+    throw std::runtime_error(
+        "Error reading ConfigurationSet binary data: invalid format");
+  }
+  void *addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    throw std::runtime_error("Error in ConfigurationSetMappedReader: could "
+                             "not map '" +
+                             path.string() + "'");
+  }
+  m_data = static_cast<std::uint8_t const *>(addr);
+  m_size = st.st_size;
+
+  try {
+    read_header(m_data, m_compressed, m_single_precision, m_chunk_size);
+    if (std::memcmp(m_data + m_size - 8, binary_magic, 8) != 0) {
+      throw std::runtime_error(
+          "Error reading ConfigurationSet binary data: invalid format");
+    }
+
+    MappedBlock meta = map_block(m_data, m_size, 32, m_compressed);
+    std::vector<std::uint8_t> raw;
+    ByteReader reader(meta.stored, meta.stored_size);
+    if (m_compressed) {
+      raw = uncompress_block(meta.stored, meta.stored_size, meta.raw_size);
+      reader = ByteReader(raw.data(), raw.size());
+    }
+    read_metadata(reader, supercells, m_supercells, m_supercell_names,
+                  m_global_dof_dim, m_local_dof_dim, m_next_config_id,
+                  m_supercell_index, m_configuration_id);
+
+    ByteReader footer_reader(m_data + m_size - binary_footer_size, 8);
+    m_chunk_table_offset = footer_reader.get_u64();
+    Index n_chunks = (size() + m_chunk_size - 1) / m_chunk_size;
+    if (m_chunk_table_offset < 0 ||
+        m_chunk_table_offset + 8 * (n_chunks + 1) >
+            m_size - binary_footer_size) {
+      throw std::runtime_error(
+          "Error reading ConfigurationSet binary data: invalid chunk table");
+    }
+  } catch (...) {
+    ::munmap(const_cast<std::uint8_t *>(m_data), m_size);
+    throw;
+  }
+
+  m_name_index.resize(size());
+  for (Index i = 0; i < size(); ++i) {
+    m_name_index[i] = i;
+  }
+  std::sort(m_name_index.begin(), m_name_index.end(),
+            [&](Index lhs, Index rhs) {
+              return _compare(lhs, supercell_name(rhs),
+                              configuration_id(rhs)) < 0;
+            });
+}
+
+/// \brief Unmaps the file
+ConfigurationSetMappedReader::~ConfigurationSetMappedReader() {
+  ::munmap(const_cast<std::uint8_t *>(m_data), m_size);
+}
+
+/// \brief Number of configurations
+Index ConfigurationSetMappedReader::size() const {
+  return m_configuration_id.size();
+}
+
+/// \brief True if blocks are compressed
+bool ConfigurationSetMappedReader::is_compressed() const {
+  return m_compressed;
+}
+
+/// \brief True if continuous DoF values are stored as 32-bit floats
+bool ConfigurationSetMappedReader::is_single_precision() const {
+  return m_single_precision;
+}
+
+/// \brief IDs, by supercell_name, used to automatically ID new
+///     configurations
+std::map<std::string, Index> const &
+ConfigurationSetMappedReader::next_config_id() const {
+  return m_next_config_id;
+}
+
+/// \brief Supercell name of configuration i
+std::string const &ConfigurationSetMappedReader::supercell_name(
+    Index i) const {
+  return m_supercell_names[m_supercell_index[i]];
+}
+
+/// \brief Configuration id of configuration i
+std::string const &ConfigurationSetMappedReader::configuration_id(
+    Index i) const {
+  return m_configuration_id[i];
+}
+
+/// \brief Name of configuration i (i.e. "SCEL4_2_2_1_0_0_0/2")
+std::string ConfigurationSetMappedReader::configuration_name(Index i) const {
+  return supercell_name(i) + "/" + configuration_id(i);
+}
+
+/// \brief Configuration indices, sorted by supercell_name and then
+///     configuration_id
+std::vector<Index> const &ConfigurationSetMappedReader::name_index() const {
+  return m_name_index;
+}
+
+/// \brief Index of configuration by name, or size() if not found
+///
+/// Uses binary search of `name_index()`.
+Index ConfigurationSetMappedReader::find_by_name(
+    std::string const &configuration_name) const {
+  auto pos = configuration_name.rfind('/');
+  if (pos == std::string::npos) {
+    return size();
+  }
+  std::pair<std::string, std::string> name(configuration_name.substr(0, pos),
+                                           configuration_name.substr(pos + 1));
+  auto it = std::lower_bound(
+      m_name_index.begin(), m_name_index.end(), name,
+      [&](Index lhs, std::pair<std::string, std::string> const &rhs) {
+        return _compare(lhs, rhs.first, rhs.second) < 0;
+      });
+  if (it == m_name_index.end() ||
+      _compare(*it, name.first, name.second) != 0) {
+    return size();
+  }
+  return *it;
+}
+
+/// \brief Range `[begin, end)` of `name_index()` holding the configurations
+///     in a supercell
+///
+/// The range is empty if there are no configurations in the supercell.
+std::pair<Index, Index> ConfigurationSetMappedReader::find_by_supercell(
+    std::string const &_supercell_name) const {
+  auto begin = std::lower_bound(
+      m_name_index.begin(), m_name_index.end(), _supercell_name,
+      [&](Index lhs, std::string const &rhs) {
+        return supercell_name(lhs) < rhs;
+      });
+  auto end = std::upper_bound(
+      begin, m_name_index.end(), _supercell_name,
+      [&](std::string const &lhs, Index rhs) {
+        return lhs < supercell_name(rhs);
+      });
+  return std::make_pair(begin - m_name_index.begin(),
+                        end - m_name_index.begin());
+}
+
+/// \brief Read configuration i
+///
+/// Decodes the DoF values of configuration i only. If the file is not
+/// compressed, values are read directly from the mapped pages and this may
+/// be called concurrently. If compressed, the chunk holding configuration i
+/// is decompressed, and the most recently used chunk is kept for reuse;
+/// concurrent calls are safe but serialized while decompressing.
+config::ConfigurationRecord ConfigurationSetMappedReader::read(
+    Index i) const {
+  if (i < 0 || i >= size()) {
+    throw std::runtime_error(
+        "Error in ConfigurationSetMappedReader::read: index out of range");
+  }
+  Index c = i / m_chunk_size;
+  ByteReader table_reader(m_data + m_chunk_table_offset + 8 * (c + 1), 8);
+  MappedBlock block =
+      map_block(m_data, m_size, table_reader.get_u64(), m_compressed);
+
+  std::shared_ptr<std::vector<std::uint8_t> const> chunk;
+  ByteReader reader(block.stored, block.stored_size);
+  if (m_compressed) {
+    std::lock_guard<std::mutex> lock(m_chunk_mutex);
+    if (m_chunk_index != c) {
+      m_chunk = std::make_shared<std::vector<std::uint8_t>>(uncompress_block(
+          block.stored, block.stored_size, block.raw_size));
+      m_chunk_index = c;
+    }
+    chunk = m_chunk;
+    reader = ByteReader(chunk->data(), chunk->size());
+  }
+
+  ChunkPosition position = make_chunk_position(
+      [&](Index j) { return n_sites(*m_supercells[m_supercell_index[j]]); },
+      m_chunk_size, size(), i);
+  config::Configuration configuration(m_supercells[m_supercell_index[i]]);
+  read_dof_values(reader, position, m_global_dof_dim, m_local_dof_dim,
+                  m_single_precision, configuration.dof_values);
+  return config::ConfigurationRecord(configuration, supercell_name(i),
+                                     configuration_id(i));
+}
+
+/// \brief Compare the name of configuration i to a name
+int ConfigurationSetMappedReader::_compare(
+    Index i, std::string const &other_supercell_name,
+    std::string const &other_configuration_id) const {
+  int cmp = supercell_name(i).compare(other_supercell_name);
+  if (cmp != 0) {
+    return cmp;
+  }
+  return configuration_id(i).compare(other_configuration_id);
+}
+
+namespace {  // (anonymous)
+
+char const log_magic[8] = {'C', 'A', 'S', 'M', 'C', 'L', 'O', 'G'};
+std::uint64_t const log_version = 1;
+
+/// Size of the log header: magic, version, store checksum
+Index const log_header_size = 24;
+
+/// Size of a log frame header: payload size, payload checksum
+Index const log_frame_header_size = 16;
+
+/// \brief CRC-32 of a byte buffer
+std::uint64_t make_crc(std::uint8_t const *data, Index size) {
+  uLong crc = crc32(0L, Z_NULL, 0);
+  return crc32(crc, data, size);
+}
+
+/// \brief Read a whole file into a byte buffer
+std::vector<std::uint8_t> read_file(fs::path const &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("Error in PersistentConfigurationSet: could not "
+                             "open '" +
+                             path.string() + "'");
+  }
+  return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(in),
+                                   std::istreambuf_iterator<char>());
+}
+
+/// \brief Write all bytes to a file descriptor
+void write_all(int fd, std::uint8_t const *data, Index size) {
+  while (size > 0) {
+    ssize_t n = ::write(fd, data, size);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      throw std::runtime_error(
+          "Error in PersistentConfigurationSet: write failed");
+    }
+    data += n;
+    size -= n;
+  }
+}
+
+/// \brief Flush a file descriptor to disk
+void sync_fd(int fd) {
+  if (::fsync(fd) != 0) {
+    throw std::runtime_error(
+        "Error in PersistentConfigurationSet: fsync failed");
+  }
+}
+
+/// \brief Flush a file or directory to disk
+void sync_path(fs::path const &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Error in PersistentConfigurationSet: could not "
+                             "open '" +
+                             path.string() + "'");
+  }
+  int result = ::fsync(fd);
+  ::close(fd);
+  if (result != 0) {
+    throw std::runtime_error(
+        "Error in PersistentConfigurationSet: fsync failed");
+  }
+}
+
+/// \brief Directory holding a file
+fs::path parent_dir(fs::path const &path) {
+  fs::path dir = path.parent_path();
+  return dir.empty() ? fs::path(".") : dir;
+}
+
+/// \brief Write a record's name and DoF values to a log payload
+void write_log_record(
+    ByteWriter &writer, std::vector<std::uint8_t> &data,
+    config::ConfigurationRecord const &record,
+    std::vector<std::pair<std::string, Index>> const &global_dof_dim,
+    std::vector<std::pair<std::string, Index>> const &local_dof_dim) {
+  auto const &dof_values = record.configuration.dof_values;
+  writer.put_string(record.supercell_name);
+  writer.put_string(record.configuration_id);
+  Index n = dof_values.occupation.size();
+  writer.put_u64(n);
+  for (Index l = 0; l < n; ++l) {
+    if (dof_values.occupation[l] < 0 || dof_values.occupation[l] > 255) {
+      throw std::runtime_error(
+          "Error in PersistentConfigurationSet: occupant index out of range");
+    }
+    data.push_back(static_cast<std::uint8_t>(dof_values.occupation[l]));
+  }
+  for (auto const &key_dim : global_dof_dim) {
+    Eigen::VectorXd const &values =
+        dof_values.global_dof_values.at(key_dim.first);
+    if (values.size() != key_dim.second) {
+      throw std::runtime_error("Error in PersistentConfigurationSet: global "
+                               "DoF '" +
+                               key_dim.first + "' is not in the prim basis");
+    }
+    for (Index k = 0; k < values.size(); ++k) {
+      writer.put_double(values[k]);
+    }
+  }
+  for (auto const &key_dim : local_dof_dim) {
+    Eigen::MatrixXd const &values =
+        dof_values.local_dof_values.at(key_dim.first);
+    if (values.rows() != key_dim.second || values.cols() != n) {
+      throw std::runtime_error("Error in PersistentConfigurationSet: local "
+                               "DoF '" +
+                               key_dim.first + "' is not in the prim basis");
+    }
+    for (Index k = 0; k < values.size(); ++k) {
+      writer.put_double(values.data()[k]);
+    }
+  }
+}
+
+}  // namespace
+
+/// \brief Constructor, opens or creates the store and log and recovers
+///
+/// \param _path The store. The log is `_path` + ".log".
+/// \param _supercells The SupercellSet, used to find or add supercells by
+///     name
+/// \param _compress If true, compress the store with zlib
+/// \param _min_compaction_size Minimum number of records in the log before
+///     `commit` compacts
+/// \param _compaction_ratio Minimum ratio of the number of records in the
+///     log to the number in the store before `commit` compacts
+PersistentConfigurationSet::PersistentConfigurationSet(
+    fs::path const &_path, config::SupercellSet &_supercells, bool _compress,
+    Index _min_compaction_size, double _compaction_ratio)
+    : m_path(_path),
+      m_log_path(_path.string() + ".log"),
+      m_supercells(_supercells),
+      m_compress(_compress),
+      m_min_compaction_size(_min_compaction_size),
+      m_compaction_ratio(_compaction_ratio),
+      m_configurations(std::make_unique<config::ConfigurationSet>()),
+      m_replace_next_config_id(false),
+      m_log_fd(-1),
+      m_n_logged(0),
+      m_n_stored(0) {
+  make_dof_dims(*m_supercells.prim(), m_global_dof_dim, m_local_dof_dim);
+
+  // a temporary store is left only by a crash during compaction, before
+  // renaming, so the store and log are still complete
+  fs::remove(m_path.string() + ".tmp");
+
+  std::uint64_t store_crc = 0;
+  if (fs::exists(m_path)) {
+    std::vector<std::uint8_t> store = read_file(m_path);
+    store_crc = make_crc(store.data(), store.size());
+    std::stringstream ss(std::string(store.begin(), store.end()));
+    store.clear();
+    read_binary(m_supercells, *m_configurations, ss);
+    m_n_stored = m_configurations->size();
+  }
+
+  m_log_fd = ::open(m_log_path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+  if (m_log_fd < 0) {
+    throw std::runtime_error("Error in PersistentConfigurationSet: could not "
+                             "open '" +
+                             m_log_path.string() + "'");
+  }
+  try {
+    _recover_log(store_crc);
+  } catch (...) {
+    ::close(m_log_fd);
+    throw;
+  }
+}
+
+/// \brief Closes the log, without committing
+PersistentConfigurationSet::~PersistentConfigurationSet() {
+  if (m_log_fd >= 0) {
+    ::close(m_log_fd);
+  }
+}
+
+/// \brief The configurations, including uncommitted configurations
+config::ConfigurationSet const &PersistentConfigurationSet::data() const {
+  return *m_configurations;
+}
+
+/// \brief Insert Configuration, setting supercell_name and
+///     configuration_id automatically
+///
+/// The configuration is pending until `commit`.
+std::pair<config::ConfigurationRecord const *, bool>
+PersistentConfigurationSet::insert(config::Configuration const &configuration) {
+  auto result = m_configurations->insert(configuration);
+  return _pending({&*result.first, result.second});
+}
+
+/// \brief Insert ConfigurationRecord, allowing custom configuration_id
+///
+/// The record is pending until `commit`.
+std::pair<config::ConfigurationRecord const *, bool>
+PersistentConfigurationSet::insert(config::ConfigurationRecord const &record) {
+  auto result = m_configurations->insert(record);
+  return _pending({&*result.first, result.second});
+}
+
+/// \brief Set IDs, by supercell_name, used to automatically ID new
+///     configurations
+///
+/// The change is pending until `commit`.
+void PersistentConfigurationSet::set_next_config_id(
+    std::map<std::string, Index> const &next_config_id) {
+  m_configurations->set_next_config_id(next_config_id);
+  m_replace_next_config_id = true;
+}
+
+/// \brief Append pending configurations and next_config_id changes to the
+///     log, and compact if the log is large enough
+///
+/// Appends one frame and flushes the log to disk, so cost is proportional
+/// to the number of pending configurations, except when compacting. Does
+/// nothing if nothing is pending.
+void PersistentConfigurationSet::commit() {
+  if (m_pending.empty() && m_changed_next_config_id.empty() &&
+      !m_replace_next_config_id) {
+    return;
+  }
+
+  std::vector<std::uint8_t> payload;
+  ByteWriter writer(payload);
+  writer.put_u64(m_pending.size());
+  for (auto const *record : m_pending) {
+    write_log_record(writer, payload, *record, m_global_dof_dim,
+                     m_local_dof_dim);
+  }
+  auto const &next_config_id = m_configurations->next_config_id();
+  writer.put_u64(m_replace_next_config_id ? 1 : 0);
+  if (m_replace_next_config_id) {
+    writer.put_u64(next_config_id.size());
+    for (auto const &name_id : next_config_id) {
+      writer.put_string(name_id.first);
+      writer.put_u64(name_id.second);
+    }
+  } else {
+    writer.put_u64(m_changed_next_config_id.size());
+    for (auto const &name : m_changed_next_config_id) {
+      auto it = next_config_id.find(name);
+      writer.put_string(name);
+      writer.put_u64(it == next_config_id.end() ? 0 : it->second);
+    }
+  }
+
+  std::vector<std::uint8_t> frame;
+  ByteWriter frame_writer(frame);
+  frame_writer.put_u64(payload.size());
+  frame_writer.put_u64(make_crc(payload.data(), payload.size()));
+  frame.insert(frame.end(), payload.begin(), payload.end());
+  write_all(m_log_fd, frame.data(), frame.size());
+  sync_fd(m_log_fd);
+
+  m_n_logged += m_pending.size();
+  m_pending.clear();
+  m_changed_next_config_id.clear();
+  m_replace_next_config_id = false;
+
+  if (m_n_logged >= m_min_compaction_size &&
+      m_n_logged >= m_compaction_ratio * m_n_stored) {
+    _write_store();
+  }
+}
+
+/// \brief Commit, then write all configurations to the store and truncate
+///     the log
+void PersistentConfigurationSet::compact() { _write_store(); }
+
+/// \brief Replay the log, truncating an incomplete or invalid tail
+///
+/// \param store_crc Checksum of the store that was read, or 0 if none
+void PersistentConfigurationSet::_recover_log(std::uint64_t store_crc) {
+  std::vector<std::uint8_t> log = read_file(m_log_path);
+  Index size = log.size();
+
+  // new log, or a crash while resetting the log after compaction
+  if (size < log_header_size) {
+    _reset_log(store_crc);
+    return;
+  }
+  if (std::memcmp(log.data(), log_magic, 8) != 0) {
+    throw std::runtime_error("Error in PersistentConfigurationSet: '" +
+                             m_log_path.string() + "' is not a log file");
+  }
+  ByteReader header_reader(log.data() + 8, log_header_size - 8);
+  if (header_reader.get_u64() != log_version) {
+    throw std::runtime_error(
+        "Error in PersistentConfigurationSet: log version mismatch");
+  }
+  // a crash during compaction, after renaming: the log is in the store
+  if (header_reader.get_u64() != store_crc) {
+    _reset_log(store_crc);
+    return;
+  }
+
+  Index pos = log_header_size;
+  while (pos + log_frame_header_size <= size) {
+    ByteReader frame_reader(log.data() + pos, log_frame_header_size);
+    std::uint64_t payload_size = frame_reader.get_u64();
+    std::uint64_t crc = frame_reader.get_u64();
+    if (payload_size > std::uint64_t(size - pos - log_frame_header_size)) {
+      break;
+    }
+    std::uint8_t const *payload = log.data() + pos + log_frame_header_size;
+    if (make_crc(payload, payload_size) != crc) {
+      break;
+    }
+    _replay(std::vector<std::uint8_t>(payload, payload + payload_size));
+    pos += log_frame_header_size + payload_size;
+  }
+  if (pos < size) {
+    if (::ftruncate(m_log_fd, pos) != 0) {
+      throw std::runtime_error(
+          "Error in PersistentConfigurationSet: could not truncate log");
+    }
+    sync_fd(m_log_fd);
+  }
+}
+
+/// \brief Replay one frame payload
+void PersistentConfigurationSet::_replay(
+    std::vector<std::uint8_t> const &payload) {
+  ByteReader reader(payload.data(), payload.size());
+  Index n_records = reader.get_u64();
+  for (Index i = 0; i < n_records; ++i) {
+    std::string supercell_name = reader.get_string();
+    std::string configuration_id = reader.get_string();
+    auto supercell =
+        m_supercells.insert_canonical(supercell_name).first->supercell;
+    config::Configuration configuration(supercell);
+    auto &dof_values = configuration.dof_values;
+    Index n = reader.get_u64();
+    if (n != dof_values.occupation.size()) {
+      throw std::runtime_error(
+          "Error in PersistentConfigurationSet: inconsistent log record");
+    }
+    for (Index l = 0; l < n; ++l) {
+      dof_values.occupation[l] = reader.get_u8();
+    }
+    for (auto const &key_dim : m_global_dof_dim) {
+      Eigen::VectorXd &values = dof_values.global_dof_values.at(key_dim.first);
+      for (Index k = 0; k < values.size(); ++k) {
+        values[k] = reader.get_double();
+      }
+    }
+    for (auto const &key_dim : m_local_dof_dim) {
+      Eigen::MatrixXd &values = dof_values.local_dof_values.at(key_dim.first);
+      for (Index k = 0; k < values.size(); ++k) {
+        values.data()[k] = reader.get_double();
+      }
+    }
+    m_configurations->insert(config::ConfigurationRecord(
+        configuration, supercell_name, configuration_id));
+  }
+  m_n_logged += n_records;
+
+  bool replace = reader.get_u64();
+  std::map<std::string, Index> next_config_id;
+  if (!replace) {
+    next_config_id = m_configurations->next_config_id();
+  }
+  Index n_ids = reader.get_u64();
+  for (Index i = 0; i < n_ids; ++i) {
+    std::string name = reader.get_string();
+    next_config_id[name] = reader.get_u64();
+  }
+  m_configurations->set_next_config_id(next_config_id);
+}
+
+/// \brief Truncate the log and write a header for store checksum
+///     `store_crc`
+void PersistentConfigurationSet::_reset_log(std::uint64_t store_crc) {
+  if (::ftruncate(m_log_fd, 0) != 0) {
+    throw std::runtime_error(
+        "Error in PersistentConfigurationSet: could not truncate log");
+  }
+  std::vector<std::uint8_t> header(log_magic, log_magic + 8);
+  ByteWriter writer(header);
+  writer.put_u64(log_version);
+  writer.put_u64(store_crc);
+  write_all(m_log_fd, header.data(), header.size());
+  sync_fd(m_log_fd);
+  sync_path(parent_dir(m_log_path));
+  m_n_logged = 0;
+}
+
+/// \brief Write all configurations to the store and reset the log
+///
+/// Pending configurations are included in the store, so they are
+/// committed.
+void PersistentConfigurationSet::_write_store() {
+  fs::path tmp_path = m_path.string() + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("Error in PersistentConfigurationSet: could "
+                               "not open '" +
+                               tmp_path.string() + "'");
+    }
+    write_binary(*m_configurations, out, m_compress);
+    out.close();
+    if (!out) {
+      throw std::runtime_error(
+          "Error in PersistentConfigurationSet: write failed");
+    }
+  }
+  sync_path(tmp_path);
+  std::vector<std::uint8_t> store = read_file(tmp_path);
+  std::uint64_t store_crc = make_crc(store.data(), store.size());
+  store.clear();
+  fs::rename(tmp_path, m_path);
+  sync_path(parent_dir(m_path));
+
+  _reset_log(store_crc);
+  m_n_stored = m_configurations->size();
+  m_pending.clear();
+  m_changed_next_config_id.clear();
+  m_replace_next_config_id = false;
+}
+
+/// \brief Record a successful insert as pending
+std::pair<config::ConfigurationRecord const *, bool>
+PersistentConfigurationSet::_pending(
+    std::pair<config::ConfigurationRecord const *, bool> result) {
+  if (result.second) {
+    m_pending.push_back(result.first);
+    m_changed_next_config_id.insert(result.first->supercell_name);
+  }
+  return result;
+}
+
+}  // namespace CASM
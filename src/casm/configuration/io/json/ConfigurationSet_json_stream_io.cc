@@ -0,0 +1,341 @@
+#include "casm/configuration/io/json/ConfigurationSet_json_stream_io.hh"
+
+#include <cctype>
+#include <stdexcept>
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/io/json/Configuration_json_io.hh"
+
+namespace CASM {
+
+namespace {  // (anonymous)
+
+int const eof = std::char_traits<char>::eof();
+
+}  // namespace
+
+/// \brief Read ConfigurationSet from JSON, one configuration at a time
+///
+/// Equivalent to reading the document into a jsonParser and using
+/// `from_json(supercells, configurations, json, prim)`, but only the JSON of
+/// one configuration at a time is in memory. See
+/// ConfigurationSetJsonStreamReader.
+///
+/// \param supercells The SupercellSet, which supercells are added to
+/// \param configurations The ConfigurationSet, which is cleared and then has
+///     configurations added to it
+/// \param in The input stream
+void read_json_stream(config::SupercellSet &supercells,
+                      config::ConfigurationSet &configurations,
+                      std::istream &in) {
+  configurations.clear();
+  ConfigurationSetJsonStreamReader reader(in, supercells);
+  while (auto record = reader.read()) {
+    configurations.insert(*record);
+  }
+  configurations.set_next_config_id(reader.next_config_id());
+}
+
+/// \brief Constructor
+///
+/// \param in The input stream, positioned at the start of a ConfigurationSet
+///     JSON document
+/// \param supercells The SupercellSet, which supercells are added to as they
+///     are reached
+ConfigurationSetJsonStreamReader::ConfigurationSetJsonStreamReader(
+    std::istream &in, config::SupercellSet &supercells)
+    : m_in(in),
+      m_supercells(supercells),
+      m_state(State::supercells),
+      m_prescanned(false),
+      m_read_prim_basis(false),
+      m_first_supercell(true),
+      m_first_configuration(true),
+      m_first_member(true),
+      m_supercell_record(nullptr),
+      m_index(0) {
+  _expect('{');
+
+  // if seekable, read the top-level members other than "supercells" first
+  std::streampos begin = m_in.tellg();
+  if (begin != std::streampos(-1)) {
+    bool first = true;
+    while (_next_member(first)) {
+      std::string key = _read_key();
+      if (key == "supercells") {
+        _read_value(nullptr);
+      } else {
+        _read_member(key);
+      }
+    }
+    m_in.clear();
+    m_in.seekg(begin);
+    m_prescanned = true;
+    _check_version();
+  }
+
+  _find_supercells(!m_prescanned);
+}
+
+/// \brief Read the next configuration, return nullptr if there are no more
+///     configurations
+///
+/// Throws if the document or the configuration is not valid.
+std::unique_ptr<config::ConfigurationRecord>
+ConfigurationSetJsonStreamReader::read() {
+  while (m_state != State::finished) {
+    if (m_state == State::supercells) {
+      if (!_next_member(m_first_supercell)) {
+        _finish();
+        break;
+      }
+      m_supercell_name = _read_key();
+      try {
+        m_supercell_record =
+            &*m_supercells.insert_canonical(m_supercell_name).first;
+      } catch (std::exception &e) {
+        throw std::runtime_error(
+            "Error reading configurations: could not find or construct "
+            "supercell '" +
+            m_supercell_name + "' by name: " + e.what());
+      }
+      _expect('{');
+      m_first_configuration = true;
+      m_state = State::configurations;
+      continue;
+    }
+
+    if (!_next_member(m_first_configuration)) {
+      m_state = State::supercells;
+      continue;
+    }
+    std::string configuration_id = _read_key();
+    m_raw.clear();
+    _read_value(&m_raw);
+    jsonParser json = jsonParser::parse(m_raw);
+    auto record = std::make_unique<config::ConfigurationRecord>(
+        make_configuration_record(json, m_supercell_name,
+                                  m_supercell_record->supercell,
+                                  configuration_id, m_read_prim_basis));
+    ++m_index;
+    return record;
+  }
+  return nullptr;
+}
+
+/// \brief Read top-level members until "supercells" is reached
+///
+/// \param handle_members If true, read the values of "version", "basis", and
+///     "config_id". Otherwise, they are skipped.
+void ConfigurationSetJsonStreamReader::_find_supercells(bool handle_members) {
+  while (_next_member(m_first_member)) {
+    std::string key = _read_key();
+    if (key == "supercells") {
+      _expect('{');
+      return;
+    }
+    if (handle_members) {
+      _read_member(key);
+    } else {
+      _read_value(nullptr);
+    }
+  }
+  throw std::runtime_error("Error reading configurations: invalid format");
+}
+
+/// \brief Read the top-level members after "supercells" and check the
+///     document
+void ConfigurationSetJsonStreamReader::_finish() {
+  while (_next_member(m_first_member)) {
+    std::string key = _read_key();
+    if (key == "supercells") {
+      throw std::runtime_error(
+          "Error reading configurations: duplicate \"supercells\"");
+    }
+    if (m_prescanned) {
+      _read_value(nullptr);
+    } else {
+      _read_member(key);
+    }
+  }
+  m_state = State::finished;
+  if (!m_prescanned) {
+    _check_version();
+  }
+}
+
+/// \brief Read the value of a top-level member other than "supercells"
+void ConfigurationSetJsonStreamReader::_read_member(std::string const &key) {
+  if (key == "version") {
+    if (_peek() != '"') {
+      throw std::runtime_error(
+          "Error reading configurations: \"version\" must be a string");
+    }
+    m_version = _read_string();
+  } else if (key == "basis") {
+    std::string basis;
+    if (_peek() == '"') {
+      basis = _read_string();
+    } else {
+      _read_value(nullptr);
+    }
+    if (basis != "prim" && basis != "standard") {
+      throw std::runtime_error(
+          "Error reading ConfigurationSet: If present, \"basis\" value must "
+          "be \"prim\" or \"standard\".");
+    }
+    bool read_prim_basis = (basis == "prim");
+    if (m_index != 0 && read_prim_basis != m_read_prim_basis) {
+      throw std::runtime_error(
+          "Error reading ConfigurationSet: \"basis\" must precede "
+          "\"supercells\" when reading from a stream that is not seekable");
+    }
+    m_read_prim_basis = read_prim_basis;
+  } else if (key == "config_id") {
+    m_raw.clear();
+    _read_value(&m_raw);
+    from_json(m_next_config_id, jsonParser::parse(m_raw));
+  } else {
+    _read_value(nullptr);
+  }
+}
+
+/// \brief Throw if "version" is not "1.0"
+void ConfigurationSetJsonStreamReader::_check_version() const {
+  if (m_version != "1.0") {
+    throw std::runtime_error("Error jsonDB version mismatch: found: " +
+                             m_version + " expected: 1.0");
+  }
+}
+
+/// \brief Return true if there is another member in the current object,
+///     reading the separating ',' if necessary
+///
+/// If there are no more members, the closing '}' is read.
+bool ConfigurationSetJsonStreamReader::_next_member(bool &first) {
+  if (_peek() == '}') {
+    m_in.get();
+    return false;
+  }
+  if (!first) {
+    _expect(',');
+  }
+  first = false;
+  return true;
+}
+
+/// \brief Read an object key and the following ':'
+std::string ConfigurationSetJsonStreamReader::_read_key() {
+  std::string key = _read_string();
+  _expect(':');
+  return key;
+}
+
+/// \brief Read a JSON string
+std::string ConfigurationSetJsonStreamReader::_read_string() {
+  _expect('"');
+  std::string raw = "\"";
+  _read_string_tail(&raw);
+  if (raw.find('\\') == std::string::npos) {
+    return raw.substr(1, raw.size() - 2);
+  }
+  return jsonParser::parse(raw).get<std::string>();
+}
+
+/// \brief Read a JSON value, appending its text to raw if not nullptr
+///
+/// Only the structure of the value is checked. The text is validated when
+/// it is parsed.
+void ConfigurationSetJsonStreamReader::_read_value(std::string *raw) {
+  int c = _peek();
+  if (c == eof) {
+    throw std::runtime_error(
+        "Error reading configurations: unexpected end of input");
+  }
+  m_in.get();
+  if (raw) {
+    raw->push_back(c);
+  }
+
+  if (c == '"') {
+    _read_string_tail(raw);
+  } else if (c == '{' || c == '[') {
+    Index depth = 1;
+    while (depth != 0) {
+      c = m_in.get();
+      if (c == eof) {
+        throw std::runtime_error(
+            "Error reading configurations: unexpected end of input");
+      }
+      if (raw) {
+        raw->push_back(c);
+      }
+      if (c == '"') {
+        _read_string_tail(raw);
+      } else if (c == '{' || c == '[') {
+        ++depth;
+      } else if (c == '}' || c == ']') {
+        --depth;
+      }
+    }
+  } else {
+    // number, true, false, or null
+    while ((c = m_in.peek()) != eof && !std::isspace(c) && c != ',' &&
+           c != '}' && c != ']') {
+      m_in.get();
+      if (raw) {
+        raw->push_back(c);
+      }
+    }
+  }
+}
+
+/// \brief Read the rest of a JSON string, after the opening '"'
+void ConfigurationSetJsonStreamReader::_read_string_tail(std::string *raw) {
+  while (true) {
+    int c = m_in.get();
+    if (c == eof) {
+      throw std::runtime_error(
+          "Error reading configurations: unexpected end of input");
+    }
+    if (raw) {
+      raw->push_back(c);
+    }
+    if (c == '\\') {
+      c = m_in.get();
+      if (c == eof) {
+        throw std::runtime_error(
+            "Error reading configurations: unexpected end of input");
+      }
+      if (raw) {
+        raw->push_back(c);
+      }
+    } else if (c == '"') {
+      return;
+    }
+  }
+}
+
+/// \brief Skip whitespace and return the next character without reading it
+int ConfigurationSetJsonStreamReader::_peek() {
+  int c = m_in.peek();
+  while (c != eof && std::isspace(c)) {
+    m_in.get();
+    c = m_in.peek();
+  }
+  return c;
+}
+
+/// \brief Read the expected character, or throw
+void ConfigurationSetJsonStreamReader::_expect(char c) {
+  if (_peek() != c) {
+    throw std::runtime_error(
+        std::string("Error reading configurations: expected '") + c + "'");
+  }
+  m_in.get();
+}
+
+}  // namespace CASM
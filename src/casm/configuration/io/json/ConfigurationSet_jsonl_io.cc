@@ -0,0 +1,152 @@
+#include "casm/configuration/io/json/ConfigurationSet_jsonl_io.hh"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/clexulator/io/json/ConfigDoFValues_json_io.hh"
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/io/json/Configuration_json_io.hh"
+
+namespace CASM {
+
+namespace {  // anonymous
+
+/// \brief Remove whitespace outside of JSON strings, so the value is
+///     written on one line
+std::string make_compact(std::string const &pretty) {
+  std::string compact;
+  compact.reserve(pretty.size());
+  bool in_string = false;
+  bool escaped = false;
+  for (char c : pretty) {
+    if (in_string) {
+      compact.push_back(c);
+      if (escaped) {
+        escaped = false;
+      } else if (c == '\\') {
+        escaped = true;
+      } else if (c == '"') {
+        in_string = false;
+      }
+    } else if (c == '"') {
+      compact.push_back(c);
+      in_string = true;
+    } else if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+      compact.push_back(c);
+    }
+  }
+  return compact;
+}
+
+/// \brief Return true if `line` is empty or only whitespace
+bool is_blank(std::string const &line) {
+  return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param out The output stream
+/// \param write_prim_basis If true, write DoF values using the prim basis.
+///     Default (false) is to write DoF values in the standard basis.
+ConfigurationJsonLinesWriter::ConfigurationJsonLinesWriter(
+    std::ostream &out, bool write_prim_basis)
+    : m_out(out), m_write_prim_basis(write_prim_basis), m_n_written(0) {}
+
+/// \brief Write one configuration
+///
+/// \param supercell_name The canonical supercell name
+/// \param configuration_id The configuration id
+/// \param configuration The configuration, with DoF values in the prim
+///     basis
+void ConfigurationJsonLinesWriter::write(
+    std::string const &supercell_name, std::string const &configuration_id,
+    config::Configuration const &configuration) {
+  jsonParser json;
+  json["supercell_name"] = supercell_name;
+  json["configuration_id"] = configuration_id;
+  if (m_write_prim_basis) {
+    to_json(configuration.dof_values, json["dof"]);
+  } else {
+    to_json(make_standard_dof_values(configuration), json["dof"]);
+  }
+  std::stringstream ss;
+  ss << json;
+  m_out << make_compact(ss.str()) << '\n';
+  if (!m_out) {
+    throw std::runtime_error(
+        "Error in ConfigurationJsonLinesWriter::write: write failed");
+  }
+  ++m_n_written;
+}
+
+/// \brief Write one configuration
+void ConfigurationJsonLinesWriter::write(
+    config::ConfigurationRecord const &record) {
+  write(record.supercell_name, record.configuration_id, record.configuration);
+}
+
+/// \brief Constructor
+///
+/// \param in The input stream
+/// \param supercells Supercells are found or added by name
+/// \param read_prim_basis If true, DoF values are in the prim basis.
+///     Otherwise, they are in the standard basis.
+ConfigurationJsonLinesReader::ConfigurationJsonLinesReader(
+    std::istream &in, config::SupercellSet &supercells, bool read_prim_basis)
+    : m_in(in),
+      m_supercells(supercells),
+      m_read_prim_basis(read_prim_basis),
+      m_index(0) {}
+
+/// \brief Read the next configuration, return nullptr if there are no more
+///     configurations
+///
+/// Throws if a line is not valid, or its DoF values are not valid for the
+/// supercell.
+std::unique_ptr<config::ConfigurationRecord>
+ConfigurationJsonLinesReader::read() {
+  if (!_next_line()) {
+    return nullptr;
+  }
+  jsonParser json = jsonParser::parse(m_line);
+  if (!json.is_obj() || !json.contains("supercell_name") ||
+      !json.contains("configuration_id")) {
+    throw std::runtime_error(
+        "Error in ConfigurationJsonLinesReader::read: expected "
+        "\"supercell_name\" and \"configuration_id\" on line " +
+        std::to_string(m_index + 1));
+  }
+  std::string supercell_name = json["supercell_name"].get<std::string>();
+  std::string configuration_id = json["configuration_id"].get<std::string>();
+  config::SupercellRecord const *supercell_record;
+  try {
+    supercell_record = &*m_supercells.insert_canonical(supercell_name).first;
+  } catch (std::exception &e) {
+    throw std::runtime_error(
+        "Error reading configurations: could not find or construct "
+        "supercell '" +
+        supercell_name + "' by name: " + e.what());
+  }
+  auto record = std::make_unique<config::ConfigurationRecord>(
+      make_configuration_record(json, supercell_name,
+                                supercell_record->supercell,
+                                configuration_id, m_read_prim_basis));
+  ++m_index;
+  return record;
+}
+
+/// \brief Read the next non-empty line, return false if none
+bool ConfigurationJsonLinesReader::_next_line() {
+  while (std::getline(m_in, m_line)) {
+    if (!is_blank(m_line)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace CASM
@@ -1,5 +1,10 @@
 #include "casm/configuration/io/json/Configuration_json_io.hh"
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <ostream>
+
 #include "casm/casm_io/Log.hh"
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/casm_io/json/InputParser_impl.hh"
@@ -7,6 +12,7 @@
 #include "casm/clexulator/io/json/ConfigDoFValues_json_io.hh"
 #include "casm/configuration/ConfigurationSet.hh"
 #include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/instrumentation.hh"
 #include "casm/configuration/io/json/Supercell_json_io.hh"
 #include "casm/configuration/supercell_name.hh"
 #include "casm/misc/Validator.hh"
@@ -225,6 +231,111 @@ bool get_read_prim_basis(Validator &validator, jsonParser const &json,
   return read_prim_basis;
 }
 
+/// \brief Append a JSON integer
+void append_json_number(std::string &out, long value) {
+  char buffer[24];
+  auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out.append(buffer, result.ptr);
+}
+
+/// \brief Append a JSON number, with the shortest text that reads back as
+///     the same value
+///
+/// Integral values are written with ".0", so they read back as floating
+/// point values. Non-finite values are written as null.
+void append_json_number(std::string &out, double value) {
+  if (!std::isfinite(value)) {
+    out += "null";
+    return;
+  }
+  char buffer[32];
+  auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out.append(buffer, result.ptr);
+  if (std::find_if(buffer, result.ptr, [](char c) {
+        return c == '.' || c == 'e' || c == 'E';
+      }) == result.ptr) {
+    out += ".0";
+  }
+}
+
+/// \brief Append a JSON string
+void append_json_string(std::string &out, std::string const &value) {
+  static char const hex[] = "0123456789abcdef";
+  out += '"';
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out += "\\u00";
+          out += hex[(c >> 4) & 0xf];
+          out += hex[c & 0xf];
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+/// \brief Append a newline and indentation
+void append_json_indent(std::string &out, int level) {
+  out += '\n';
+  out.append(2 * level, ' ');
+}
+
+/// \brief Append an object key, at an indentation level
+void append_json_key(std::string &out, int level, std::string const &key) {
+  append_json_indent(out, level);
+  append_json_string(out, key);
+  out += ": ";
+}
+
+/// \brief Append a vector as a JSON array, on one line
+template <typename ValueType, typename VectorType>
+void append_json_array(std::string &out, VectorType const &vector) {
+  out += '[';
+  for (Index i = 0; i < vector.size(); ++i) {
+    if (i != 0) {
+      out += ", ";
+    }
+    append_json_number(out, static_cast<ValueType>(vector(i)));
+  }
+  out += ']';
+}
+
+/// \brief Append the rows of a matrix as a JSON array, one row per line
+template <typename ValueType, typename MatrixType>
+void append_json_matrix(std::string &out, int level,
+                        MatrixType const &matrix) {
+  out += '[';
+  for (Index i = 0; i < matrix.rows(); ++i) {
+    if (i != 0) {
+      out += ',';
+    }
+    append_json_indent(out, level + 1);
+    append_json_array<ValueType>(out, matrix.row(i));
+  }
+  if (matrix.rows()) {
+    append_json_indent(out, level);
+  }
+  out += ']';
+}
+
 clexulator::ConfigDoFValues read_dof_values(
     Validator &validator, jsonParser const &json,
     std::shared_ptr<config::Supercell const> supercell, bool read_prim_basis) {
@@ -278,16 +389,10 @@ void from_json(config::SupercellSet &supercells,
     report_and_throw_if_invalid(validator, log, error_if_invalid);
   }
 
-  std::map<std::string, config::SupercellRecord const *>
-      index_by_supercell_name =
-          make_index_by_canonical_supercell_name(supercells.data());
-
   // read config list contents
   auto scel_it = json["supercells"].begin();
   auto scel_end = json["supercells"].end();
 
-  clexulator::ConfigDoFValues dof_values;
-
   for (; scel_it != scel_end; ++scel_it) {
     auto config_it = scel_it->begin();
     auto config_end = scel_it->end();
@@ -295,8 +400,7 @@ void from_json(config::SupercellSet &supercells,
     // try to find or add supercell by name
     config::SupercellRecord const *s = nullptr;
     try {
-      s = find_or_add_canonical_supercell_by_name(
-          scel_it.name(), supercells.data(), index_by_supercell_name, prim);
+      s = &*supercells.insert_canonical(scel_it.name()).first;
     } catch (std::exception &e) {
       std::stringstream msg;
       msg << "Error: could not find or construct supercell '" << scel_it.name()
@@ -311,26 +415,9 @@ void from_json(config::SupercellSet &supercells,
 
     // try to construct configurations for supercell
     for (; config_it != config_end; ++config_it) {
-      dof_values = read_dof_values(validator, (*config_it), s->supercell,
-                                   read_prim_basis);
-
-      // jsonParser source;
-      // config_it->get_if(source, "source");
-      //
-      // jsonParser cache;
-      // config_it->get_if(cache, "cache");
-
-      if (!validator.valid()) {
-        log.indent() << "Errors reading configurations:" << std::endl;
-        log.indent() << "Error reading configuration: " << scel_it.name() << "/"
-                     << config_it.name() << std::endl;
-        report_and_throw_if_invalid(validator, log, error_if_invalid);
-      }
-
-      config::ConfigurationRecord record(
-          config::Configuration(s->supercell, dof_values), scel_it.name(),
-          config_it.name());
-      configurations.insert(record);
+      configurations.insert(
+          make_configuration_record(*config_it, scel_it.name(), s->supercell,
+                                    config_it.name(), read_prim_basis));
     }
   }
 
@@ -340,6 +427,48 @@ void from_json(config::SupercellSet &supercells,
   configurations.set_next_config_id(next_config_id);
 }
 
+/// \brief Read one configuration of a ConfigurationSet from JSON
+///
+/// \param json The configuration's JSON value, i.e.
+///     `json["supercells"][supercell_name][configuration_id]` of a
+///     ConfigurationSet
+/// \param supercell_name The canonical supercell name
+/// \param supercell The canonical supercell
+/// \param configuration_id The configuration id
+/// \param read_prim_basis If true, DoF values are in the prim basis.
+///     Otherwise, they are in the standard basis.
+/// \return The ConfigurationRecord, with DoF values in the prim basis
+///
+/// Throws if the DoF values are not valid for the supercell.
+config::ConfigurationRecord make_configuration_record(
+    jsonParser const &json, std::string const &supercell_name,
+    std::shared_ptr<config::Supercell const> const &supercell,
+    std::string const &configuration_id, bool read_prim_basis) {
+  auto &log = CASM::log();
+  Validator validator;
+  std::runtime_error error_if_invalid{"Error reading configurations"};
+
+  clexulator::ConfigDoFValues dof_values =
+      read_dof_values(validator, json, supercell, read_prim_basis);
+
+  // jsonParser source;
+  // json.get_if(source, "source");
+  //
+  // jsonParser cache;
+  // json.get_if(cache, "cache");
+
+  if (!validator.valid()) {
+    log.indent() << "Errors reading configurations:" << std::endl;
+    log.indent() << "Error reading configuration: " << supercell_name << "/"
+                 << configuration_id << std::endl;
+    report_and_throw_if_invalid(validator, log, error_if_invalid);
+  }
+
+  return config::ConfigurationRecord(
+      config::Configuration(supercell, dof_values), supercell_name,
+      configuration_id);
+}
+
 /// \brief Write ConfigurationSet to JSON
 ///
 /// \param configurations The ConfigurationSet
@@ -394,6 +523,7 @@ config::Configuration jsonConstructor<config::Configuration>::from_json(
 std::unique_ptr<config::Configuration>
 jsonMake<config::Configuration>::make_from_json(
     jsonParser const &json, std::shared_ptr<config::Prim const> const &prim) {
+  CASM_CONFIG_SCOPED_TIMER(json_io);
   auto &log = CASM::log();
   ParentInputParser parser{json};
   std::runtime_error error_if_invalid{
@@ -406,6 +536,7 @@ jsonMake<config::Configuration>::make_from_json(
 std::unique_ptr<config::Configuration>
 jsonMake<config::Configuration>::make_from_json(
     jsonParser const &json, config::SupercellSet &supercells) {
+  CASM_CONFIG_SCOPED_TIMER(json_io);
   auto &log = CASM::log();
   ParentInputParser parser{json};
   std::runtime_error error_if_invalid{
@@ -424,14 +555,13 @@ jsonMake<config::Configuration>::make_from_json(
 ///
 jsonParser &to_json(config::Configuration const &configuration,
                     jsonParser &json, bool write_prim_basis) {
+  CASM_CONFIG_SCOPED_TIMER(json_io);
   if (!json.is_obj()) {
     throw std::runtime_error(
         "Error inserting configuration to json: not an object");
   }
   auto const &superlattice = configuration.supercell->superlattice;
-  std::string supercell_name = config::make_supercell_name(
-      superlattice.prim_lattice(), superlattice.superlattice());
-  json["supercell_name"] = supercell_name;
+  json["supercell_name"] = configuration.supercell->name;
   json["transformation_matrix_to_supercell"] =
       superlattice.transformation_matrix_to_super();
   json["dof"] = configuration.dof_values;
@@ -439,18 +569,113 @@ jsonParser &to_json(config::Configuration const &configuration,
   return json;
 }
 
+/// \brief Append Configuration JSON text to a string, without constructing
+///     a jsonParser
+///
+/// The JSON has the same contents as `to_json(configuration, json)`, with
+/// DoF values as they are stored (in the prim basis), so it can be read by
+/// the existing readers. It is indented by 2 spaces, with arrays of numbers
+/// on one line. Numbers are written by `std::to_chars`, with the shortest
+/// text that reads back as the same value, so the digits written may differ
+/// from jsonParser output but the values read do not.
+///
+/// \param configuration A Configuration
+/// \param out A string, that the JSON text is appended to
+void write_json(config::Configuration const &configuration, std::string &out) {
+  CASM_CONFIG_SCOPED_TIMER(json_io);
+  auto const &dof_values = configuration.dof_values;
+  out += '{';
+
+  // "dof"
+  append_json_key(out, 1, "dof");
+  out += '{';
+  bool first = true;
+  if (!dof_values.global_dof_values.empty()) {
+    append_json_key(out, 2, "global_dofs");
+    out += '{';
+    bool first_dof = true;
+    for (auto const &pair : dof_values.global_dof_values) {
+      if (!first_dof) {
+        out += ',';
+      }
+      first_dof = false;
+      append_json_key(out, 3, pair.first);
+      out += '{';
+      append_json_key(out, 4, "values");
+      append_json_array<double>(out, pair.second);
+      append_json_indent(out, 3);
+      out += '}';
+    }
+    append_json_indent(out, 2);
+    out += '}';
+    first = false;
+  }
+  if (!dof_values.local_dof_values.empty()) {
+    if (!first) {
+      out += ',';
+    }
+    append_json_key(out, 2, "local_dofs");
+    out += '{';
+    bool first_dof = true;
+    for (auto const &pair : dof_values.local_dof_values) {
+      if (!first_dof) {
+        out += ',';
+      }
+      first_dof = false;
+      append_json_key(out, 3, pair.first);
+      out += '{';
+      append_json_key(out, 4, "values");
+      append_json_matrix<double>(out, 4, pair.second.transpose());
+      append_json_indent(out, 3);
+      out += '}';
+    }
+    append_json_indent(out, 2);
+    out += '}';
+    first = false;
+  }
+  if (!first) {
+    out += ',';
+  }
+  append_json_key(out, 2, "occ");
+  append_json_array<long>(out, dof_values.occupation);
+  append_json_indent(out, 1);
+  out += "},";
+
+  // "supercell_name"
+  append_json_key(out, 1, "supercell_name");
+  append_json_string(out, configuration.supercell->name);
+  out += ',';
+
+  // "transformation_matrix_to_supercell"
+  append_json_key(out, 1, "transformation_matrix_to_supercell");
+  append_json_matrix<long>(
+      out, 1,
+      configuration.supercell->superlattice.transformation_matrix_to_super());
+  append_json_indent(out, 0);
+  out += '}';
+}
+
+/// \brief Write Configuration JSON text to a stream, without constructing
+///     a jsonParser
+///
+/// See `write_json(config::Configuration const &, std::string &)`.
+void write_json(config::Configuration const &configuration,
+                std::ostream &out) {
+  std::string text;
+  write_json(configuration, text);
+  out << text;
+}
+
 /// Parse Configuration from JSON with error messages
 ///
 /// Notes:
-/// - This version creates a new Supercell for each Configuration.
-///   Comparisons will still work correctly, but if reading many
-///   Configuration, memory usage will be increased and speed will
-///   be decreased.
+/// - This version uses config::make_shared_supercell, so Configuration
+///   read while an equal Supercell is still in use share it.
 void parse(InputParser<config::Configuration> &parser,
            std::shared_ptr<config::Prim const> const &prim) {
   Eigen::Matrix3l T;
   parser.require(T, "transformation_matrix_to_supercell");
-  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto supercell = config::make_shared_supercell(prim, T);
 
   clexulator::ConfigDoFValues dof_values;
   parser.require(dof_values, "dof");
@@ -509,6 +734,7 @@ jsonConstructor<config::ConfigurationWithProperties>::from_json(
 std::unique_ptr<config::ConfigurationWithProperties>
 jsonMake<config::ConfigurationWithProperties>::make_from_json(
     jsonParser const &json, std::shared_ptr<config::Prim const> const &prim) {
+  CASM_CONFIG_SCOPED_TIMER(json_io);
   auto &log = CASM::log();
   ParentInputParser parser{json};
   std::runtime_error error_if_invalid{
@@ -521,6 +747,7 @@ jsonMake<config::ConfigurationWithProperties>::make_from_json(
 std::unique_ptr<config::ConfigurationWithProperties>
 jsonMake<config::ConfigurationWithProperties>::make_from_json(
     jsonParser const &json, config::SupercellSet &supercells) {
+  CASM_CONFIG_SCOPED_TIMER(json_io);
   auto &log = CASM::log();
   ParentInputParser parser{json};
   std::runtime_error error_if_invalid{
@@ -608,6 +835,7 @@ jsonMake<config::ConfigurationWithProperties>::make_from_json(
 jsonParser &to_json(
     config::ConfigurationWithProperties const &configuration_with_properties,
     jsonParser &json, bool write_prim_basis) {
+  CASM_CONFIG_SCOPED_TIMER(json_io);
   auto const &x = configuration_with_properties;
   if (!json.is_obj()) {
     throw std::runtime_error(
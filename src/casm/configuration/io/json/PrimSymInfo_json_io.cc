@@ -0,0 +1,189 @@
+#include "casm/configuration/io/json/PrimSymInfo_json_io.hh"
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/sym_info/factor_group.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/SymType.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+
+namespace CASM {
+
+namespace {
+
+/// \brief Write a matrix with its shape, so that empty matrices are read
+///     with the correct shape
+void matrix_to_json(Eigen::MatrixXd const &M, jsonParser &json) {
+  json["rows"] = M.rows();
+  json["cols"] = M.cols();
+  if (M.size()) {
+    json["matrix"] = M;
+  }
+}
+
+/// \brief Read a matrix written by `matrix_to_json`
+Eigen::MatrixXd matrix_from_json(jsonParser const &json) {
+  Eigen::MatrixXd M(json["rows"].get<Index>(), json["cols"].get<Index>());
+  if (M.size()) {
+    from_json(M, json["matrix"]);
+  }
+  return M;
+}
+
+}  // namespace
+
+/// \brief Write PrimSymInfo to JSON
+///
+/// Writes the factor group elements, in order, and the symmetry
+/// representations that are not determined by the prim and
+/// "occ_symgroup_rep". The "occ" local DoF symrep is not written.
+///
+/// Format:
+/// \code
+/// {
+///   "factor_group": [{"matrix": ..., "translation": ...,
+///                     "time_reversal": ...}, ...],
+///   "unitcellcoord_symgroup_rep": [{"point_matrix": ...,
+///       "sublattice_index": [...], "unitcell_indices": [[i, j, k], ...]},
+///       ...],
+///   "occ_symgroup_rep": [[<permutation>, ...], ...],
+///   "atom_position_symgroup_rep": [[[<permutation>, ...], ...], ...],
+///   "local_dof_symgroup_rep": {<key>: [[<matrix>, ...], ...], ...},
+///   "global_dof_symgroup_rep": {<key>: [<matrix>, ...], ...}
+/// }
+/// \endcode
+///
+/// where matrices are written as `{"rows": ..., "cols": ..., "matrix":
+/// ...}`, with "matrix" omitted if empty.
+jsonParser &to_json(config::PrimSymInfo const &prim_sym_info,
+                    jsonParser &json) {
+  json.put_obj();
+  jsonParser &factor_group_json = json["factor_group"].put_array();
+  for (auto const &op : prim_sym_info.factor_group->element) {
+    jsonParser op_json;
+    op_json["matrix"] = op.matrix;
+    to_json_array(op.translation, op_json["translation"]);
+    op_json["time_reversal"] = op.is_time_reversal_active;
+    factor_group_json.push_back(op_json);
+  }
+
+  jsonParser &unitcellcoord_json =
+      json["unitcellcoord_symgroup_rep"].put_array();
+  for (auto const &rep : prim_sym_info.unitcellcoord_symgroup_rep) {
+    jsonParser rep_json;
+    rep_json["point_matrix"] = rep.point_matrix;
+    to_json(rep.sublattice_index, rep_json["sublattice_index"]);
+    jsonParser &unitcell_json = rep_json["unitcell_indices"].put_array();
+    for (auto const &unitcell : rep.unitcell_indices) {
+      jsonParser tjson;
+      to_json_array(Eigen::Vector3l(unitcell), tjson);
+      unitcell_json.push_back(tjson);
+    }
+    unitcellcoord_json.push_back(rep_json);
+  }
+
+  to_json(prim_sym_info.occ_symgroup_rep, json["occ_symgroup_rep"]);
+  to_json(prim_sym_info.atom_position_symgroup_rep,
+          json["atom_position_symgroup_rep"]);
+
+  jsonParser &local_json = json["local_dof_symgroup_rep"].put_obj();
+  for (auto const &pair : prim_sym_info.local_dof_symgroup_rep) {
+    if (pair.first == "occ") {
+      continue;
+    }
+    jsonParser &key_json = local_json[pair.first].put_array();
+    for (auto const &symop_rep : pair.second) {
+      jsonParser symop_json;
+      symop_json.put_array();
+      for (auto const &M : symop_rep) {
+        jsonParser matrix_json;
+        matrix_to_json(M, matrix_json);
+        symop_json.push_back(matrix_json);
+      }
+      key_json.push_back(symop_json);
+    }
+  }
+
+  jsonParser &global_json = json["global_dof_symgroup_rep"].put_obj();
+  for (auto const &pair : prim_sym_info.global_dof_symgroup_rep) {
+    jsonParser &key_json = global_json[pair.first].put_array();
+    for (auto const &M : pair.second) {
+      jsonParser matrix_json;
+      matrix_to_json(M, matrix_json);
+      key_json.push_back(matrix_json);
+    }
+  }
+  return json;
+}
+
+/// \brief Construct PrimSymInfo from JSON
+///
+/// Reads the format written by `to_json`, using
+/// `sym_info::use_factor_group` to construct the factor group in the
+/// order written. The symmetry representations are not checked for
+/// consistency with `prim`.
+config::PrimSymInfo jsonConstructor<config::PrimSymInfo>::from_json(
+    jsonParser const &json, xtal::BasicStructure const &prim) {
+  std::vector<xtal::SymOp> factor_group_elements;
+  for (auto const &op_json : json["factor_group"]) {
+    Eigen::Matrix3d matrix;
+    Eigen::Vector3d translation;
+    bool time_reversal;
+    CASM::from_json(matrix, op_json["matrix"]);
+    CASM::from_json(translation, op_json["translation"]);
+    CASM::from_json(time_reversal, op_json["time_reversal"]);
+    factor_group_elements.emplace_back(matrix, translation, time_reversal);
+  }
+
+  sym_info::UnitCellCoordSymGroupRep unitcellcoord_symgroup_rep;
+  for (auto const &rep_json : json["unitcellcoord_symgroup_rep"]) {
+    xtal::UnitCellCoordRep rep;
+    CASM::from_json(rep.point_matrix, rep_json["point_matrix"]);
+    CASM::from_json(rep.sublattice_index, rep_json["sublattice_index"]);
+    for (auto const &unitcell_json : rep_json["unitcell_indices"]) {
+      Eigen::Vector3l unitcell;
+      CASM::from_json(unitcell, unitcell_json);
+      rep.unitcell_indices.push_back(xtal::UnitCell(unitcell));
+    }
+    unitcellcoord_symgroup_rep.push_back(rep);
+  }
+
+  sym_info::OccSymGroupRep occ_symgroup_rep;
+  CASM::from_json(occ_symgroup_rep, json["occ_symgroup_rep"]);
+  sym_info::AtomPositionSymGroupRep atom_position_symgroup_rep;
+  CASM::from_json(atom_position_symgroup_rep,
+                  json["atom_position_symgroup_rep"]);
+
+  std::map<DoFKey, sym_info::LocalDoFSymGroupRep> local_dof_symgroup_rep;
+  auto const &local_json = json["local_dof_symgroup_rep"];
+  for (auto it = local_json.begin(); it != local_json.end(); ++it) {
+    sym_info::LocalDoFSymGroupRep &group_rep =
+        local_dof_symgroup_rep[it.name()];
+    for (auto const &symop_json : *it) {
+      sym_info::LocalDoFSymOpRep symop_rep;
+      for (auto const &matrix_json : symop_json) {
+        symop_rep.push_back(matrix_from_json(matrix_json));
+      }
+      group_rep.push_back(symop_rep);
+    }
+  }
+
+  std::map<DoFKey, sym_info::GlobalDoFSymGroupRep> global_dof_symgroup_rep;
+  auto const &global_json = json["global_dof_symgroup_rep"];
+  for (auto it = global_json.begin(); it != global_json.end(); ++it) {
+    sym_info::GlobalDoFSymGroupRep &group_rep =
+        global_dof_symgroup_rep[it.name()];
+    for (auto const &matrix_json : *it) {
+      group_rep.push_back(matrix_from_json(matrix_json));
+    }
+  }
+
+  return config::PrimSymInfo(
+      sym_info::use_factor_group(factor_group_elements, prim),
+      std::move(unitcellcoord_symgroup_rep), std::move(occ_symgroup_rep),
+      std::move(atom_position_symgroup_rep), std::move(local_dof_symgroup_rep),
+      std::move(global_dof_symgroup_rep), prim);
+}
+
+}  // namespace CASM
@@ -19,7 +19,7 @@ void from_json(std::shared_ptr<config::Supercell const> &supercell,
   Eigen::Matrix3l T;
   parser.require(T, "transformation_matrix_to_supercell");
   report_and_throw_if_invalid(parser, log, error_if_invalid);
-  supercell = std::make_shared<config::Supercell const>(prim, T);
+  supercell = config::make_shared_supercell(prim, T);
 }
 
 void from_json(std::shared_ptr<config::Supercell const> &supercell,
@@ -42,9 +42,7 @@ jsonParser &to_json(std::shared_ptr<config::Supercell const> const &supercell,
         "Error inserting supercell to json: not an object");
   }
   auto const &superlattice = supercell->superlattice;
-  std::string supercell_name = config::make_supercell_name(
-      superlattice.prim_lattice(), superlattice.superlattice());
-  json["supercell_name"] = supercell_name;
+  json["supercell_name"] = supercell->name;
   json["transformation_matrix_to_supercell"] =
       superlattice.transformation_matrix_to_super();
   return json;
@@ -75,7 +73,7 @@ void from_json(config::SupercellSet &supercells, jsonParser const &json,
     for (; it != end; ++it) {
       Eigen::Matrix3l mat;
       from_json(mat, *it);
-      supercells.insert(std::make_shared<config::Supercell const>(prim, mat));
+      supercells.insert(config::make_shared_supercell(prim, mat));
     }
   }
   if (json.contains("non_canonical_supercells")) {
@@ -89,7 +87,7 @@ void from_json(config::SupercellSet &supercells, jsonParser const &json,
       }
       Eigen::Matrix3l mat;
       from_json(mat, (*it)["transformation_matrix_to_supercell"]);
-      supercells.insert(std::make_shared<config::Supercell const>(prim, mat));
+      supercells.insert(config::make_shared_supercell(prim, mat));
     }
   }
 }
@@ -0,0 +1,203 @@
+#include "casm/configuration/irreps/CharacterTable.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include "casm/misc/CASM_Eigen_math.hh"
+#include "casm/misc/CASM_math.hh"
+
+namespace CASM {
+namespace irreps {
+
+namespace {
+
+/// \brief Return true if `chi` is the character of the identity irrep
+bool is_identity_character(Eigen::VectorXcd const &chi) {
+  return almost_equal(
+      chi, Eigen::VectorXcd::Constant(chi.size(), std::complex<double>(1., 0.)),
+      TOL);
+}
+
+/// \brief Order irreps: identity first, then by dimension, then by
+///     characters
+bool irrep_less(Eigen::VectorXcd const &A, Index A_dim,
+                Eigen::VectorXcd const &B, Index B_dim) {
+  bool A_is_identity = is_identity_character(A);
+  bool B_is_identity = is_identity_character(B);
+  if (A_is_identity != B_is_identity) {
+    return A_is_identity;
+  }
+  if (A_dim != B_dim) {
+    return A_dim < B_dim;
+  }
+  for (Index c = 0; c < A.size(); ++c) {
+    if (!almost_equal(A(c).real(), B(c).real(), TOL)) {
+      return A(c).real() > B(c).real();
+    }
+    if (!almost_equal(A(c).imag(), B(c).imag(), TOL)) {
+      return A(c).imag() > B(c).imag();
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+/// \brief Make the character table of a finite group
+///
+/// Uses the Burnside-Dixon method: the central characters of the irreps,
+/// omega_i(c) = |c| * chi_i(c) / chi_i(1), are the common eigenvectors of
+/// the class multiplication coefficient matrices, which are found by
+/// diagonalizing a random linear combination of those matrices.
+///
+/// \param multiplication_table Group multiplication table, such that
+///     `element[k] == element[i] * element[j]`, where
+///     `k = multiplication_table[i][j]`.
+/// \param conjugacy_classes Conjugacy classes, as vectors of group element
+///     indices, as from `group::make_conjugacy_classes`
+///
+/// \returns The character table, with irreps ordered by dimension and the
+///     identity irrep first
+CharacterTable make_character_table(
+    std::vector<std::vector<Index>> const &multiplication_table,
+    std::vector<std::vector<Index>> const &conjugacy_classes) {
+  Index n = multiplication_table.size();
+  Index n_classes = conjugacy_classes.size();
+  if (n == 0 || n_classes == 0) {
+    throw std::runtime_error("Error in make_character_table: empty group");
+  }
+
+  CharacterTable table;
+  table.conjugacy_classes = conjugacy_classes;
+  table.class_index.resize(n, -1);
+  Index n_total = 0;
+  for (Index c = 0; c < n_classes; ++c) {
+    for (Index g : conjugacy_classes[c]) {
+      if (g < 0 || g >= n || table.class_index[g] != -1) {
+        throw std::runtime_error(
+            "Error in make_character_table: invalid conjugacy classes");
+      }
+      table.class_index[g] = c;
+      ++n_total;
+    }
+  }
+  if (n_total != n) {
+    throw std::runtime_error(
+        "Error in make_character_table: invalid conjugacy classes");
+  }
+
+  // identity and inverse elements
+  Index e = 0;
+  while (e < n && multiplication_table[e][e] != e) {
+    ++e;
+  }
+  if (e == n) {
+    throw std::runtime_error(
+        "Error in make_character_table: no identity element");
+  }
+  std::vector<Index> inverse(n, -1);
+  for (Index i = 0; i < n; ++i) {
+    for (Index j = 0; j < n; ++j) {
+      if (multiplication_table[i][j] == e) {
+        inverse[i] = j;
+        break;
+      }
+    }
+  }
+  Index e_class = table.class_index[e];
+
+  // class multiplication coefficients:
+  // C_j * C_k = sum_l A[j](k, l) * C_l
+  std::vector<Eigen::MatrixXd> A(n_classes,
+                                 Eigen::MatrixXd::Zero(n_classes, n_classes));
+  for (Index l = 0; l < n_classes; ++l) {
+    Index z = conjugacy_classes[l][0];
+    for (Index x = 0; x < n; ++x) {
+      Index y = multiplication_table[inverse[x]][z];
+      A[table.class_index[x]](table.class_index[y], l) += 1.0;
+    }
+  }
+
+  // central characters are common eigenvectors of all A[j]; use a random
+  // combination (with fixed seed), which has distinct eigenvalues with
+  // probability 1
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> distribution(0.5, 1.5);
+  Eigen::MatrixXcd omega;
+  for (Index attempt = 0; attempt < 10; ++attempt) {
+    Eigen::MatrixXd B = Eigen::MatrixXd::Zero(n_classes, n_classes);
+    for (Index j = 0; j < n_classes; ++j) {
+      B += distribution(generator) * A[j];
+    }
+    Eigen::ComplexEigenSolver<Eigen::MatrixXcd> solver(
+        B.cast<std::complex<double>>());
+    Eigen::VectorXcd const &lambda = solver.eigenvalues();
+    bool distinct = true;
+    for (Index a = 0; a < n_classes && distinct; ++a) {
+      for (Index b = a + 1; b < n_classes && distinct; ++b) {
+        distinct = std::abs(lambda(a) - lambda(b)) > 1e-6;
+      }
+    }
+    if (distinct) {
+      omega = solver.eigenvectors();
+      break;
+    }
+  }
+  if (omega.size() == 0) {
+    throw std::runtime_error(
+        "Error in make_character_table: failed to separate irreps");
+  }
+
+  // characters, from central characters and normalization
+  std::vector<Eigen::VectorXcd> characters;
+  std::vector<Index> irrep_dim;
+  Index sum_squared_dims = 0;
+  for (Index i = 0; i < n_classes; ++i) {
+    Eigen::VectorXcd w = omega.col(i) / omega(e_class, i);
+    double s = 0.0;
+    for (Index c = 0; c < n_classes; ++c) {
+      s += std::norm(w(c)) / conjugacy_classes[c].size();
+    }
+    double d = std::sqrt(double(n) / s);
+    Index d_int = std::lround(d);
+    if (d_int < 1 || !almost_equal(d, double(d_int), 1e-4)) {
+      throw std::runtime_error(
+          "Error in make_character_table: non-integer irrep dimension");
+    }
+    Eigen::VectorXcd chi(n_classes);
+    for (Index c = 0; c < n_classes; ++c) {
+      chi(c) = double(d_int) * w(c) / double(conjugacy_classes[c].size());
+      double re = almost_zero(chi(c).real(), TOL) ? 0.0 : chi(c).real();
+      double im = almost_zero(chi(c).imag(), TOL) ? 0.0 : chi(c).imag();
+      chi(c) = std::complex<double>(re, im);
+    }
+    characters.push_back(chi);
+    irrep_dim.push_back(d_int);
+    sum_squared_dims += d_int * d_int;
+  }
+  if (sum_squared_dims != n) {
+    throw std::runtime_error(
+        "Error in make_character_table: sum of squared irrep dimensions != "
+        "group size");
+  }
+
+  // sort irreps
+  std::vector<Index> order(n_classes);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](Index a, Index b) {
+    return irrep_less(characters[a], irrep_dim[a], characters[b],
+                      irrep_dim[b]);
+  });
+  table.characters.resize(n_classes, n_classes);
+  for (Index i = 0; i < n_classes; ++i) {
+    table.characters.row(i) = characters[order[i]].transpose();
+    table.irrep_dim.push_back(irrep_dim[order[i]]);
+  }
+  return table;
+}
+
+}  // namespace irreps
+}  // namespace CASM
@@ -103,14 +103,79 @@ Eigen::MatrixXd full_trans_mat(std::vector<IrrepInfo> const &irreps) {
 ///     _cyclic_subgroups fails.
 /// \param allow_complex If true, all irreps may be complex-valued, if false,
 ///     complex irreps are combined to form real representations
+/// \param _log If provided, log progress
+/// \param _character_table If not null, the character table of the group
+///     `head_group`, which must include all elements of `_fullspace_rep`.
+///     Then irreps are found using character projection operators, which is
+///     much faster for large representations. Otherwise, irreps are found
+///     using the commuter method.
+/// \param _invariant_blocks If not empty, orthonormal bases for mutually
+///     orthogonal subspaces, each invariant under `head_group`, which
+///     together span the invariant subspace formed from `init_subspace`.
+///     Then irreps are found separately in each block, which is much faster
+///     than finding irreps in the entire invariant subspace when there are
+///     many blocks. Invariance of the blocks is not checked.
+/// \param _progress If provided, report progress as one stage, with one work
+///     item per invariant subspace dimension, and throw OperationCancelled
+///     if cancellation is requested.
+/// \param _n_threads Number of threads used to find high symmetry
+///     directions when symmetrizing irreps. If <= 0, uses
+///     `config::default_n_threads()`. Results do not depend on the number of
+///     threads.
 ///
 IrrepDecomposition::IrrepDecomposition(
     MatrixRep const &_fullspace_rep, GroupIndices const &_head_group,
     Eigen::MatrixXd const &init_subspace,
     std::function<GroupIndicesOrbitSet()> make_cyclic_subgroups_f,
     std::function<GroupIndicesOrbitSet()> make_all_subgroups_f,
-    bool allow_complex, std::optional<Log> _log)
-    : fullspace_rep(_fullspace_rep), head_group(_head_group), log(_log) {
+    bool allow_complex, std::optional<Log> _log,
+    std::shared_ptr<CharacterTable const> _character_table,
+    std::vector<Eigen::MatrixXd> const &_invariant_blocks,
+    std::shared_ptr<config::ProgressMonitor> _progress, Index _n_threads)
+    : fullspace_rep(_fullspace_rep),
+      head_group(_head_group),
+      log(_log),
+      character_table(_character_table),
+      progress(_progress),
+      n_threads(_n_threads) {
+  _decompose(fullspace_rep, init_subspace, _invariant_blocks,
+             make_cyclic_subgroups_f, make_all_subgroups_f, allow_complex);
+}
+
+/// IrrepDecomposition constructor, using a sparse full space matrix rep
+///
+/// Same as the constructor using a dense full space matrix rep, but
+/// products with the full space matrices are sparse, and only
+/// `sparse_fullspace_rep` is stored (`fullspace_rep` is empty). This is
+/// preferred for large local DoF spaces, for which the full space matrices
+/// are block-permutation matrices.
+IrrepDecomposition::IrrepDecomposition(
+    SparseMatrixRep const &_sparse_fullspace_rep,
+    GroupIndices const &_head_group, Eigen::MatrixXd const &init_subspace,
+    std::function<GroupIndicesOrbitSet()> make_cyclic_subgroups_f,
+    std::function<GroupIndicesOrbitSet()> make_all_subgroups_f,
+    bool allow_complex, std::optional<Log> _log,
+    std::shared_ptr<CharacterTable const> _character_table,
+    std::vector<Eigen::MatrixXd> const &_invariant_blocks,
+    std::shared_ptr<config::ProgressMonitor> _progress, Index _n_threads)
+    : sparse_fullspace_rep(_sparse_fullspace_rep),
+      head_group(_head_group),
+      log(_log),
+      character_table(_character_table),
+      progress(_progress),
+      n_threads(_n_threads) {
+  _decompose(sparse_fullspace_rep, init_subspace, _invariant_blocks,
+             make_cyclic_subgroups_f, make_all_subgroups_f, allow_complex);
+}
+
+/// Perform the decomposition, used by the constructors
+template <typename RepType>
+void IrrepDecomposition::_decompose(
+    RepType const &rep, Eigen::MatrixXd const &init_subspace,
+    std::vector<Eigen::MatrixXd> const &invariant_blocks,
+    std::function<GroupIndicesOrbitSet()> make_cyclic_subgroups_f,
+    std::function<GroupIndicesOrbitSet()> make_all_subgroups_f,
+    bool allow_complex) {
   using namespace IrrepDecompositionImpl;
 
   if (log.has_value()) {
@@ -119,31 +184,82 @@ IrrepDecomposition::IrrepDecomposition(
     prettyp<Log::verbose>(*log, "1. Initial vector space", init_subspace);
   }
 
-  Index dim = fullspace_rep[0].rows();
-
   // 1) Expand subspace by application of group, and orthonormalization
-  subspace = make_invariant_space(fullspace_rep, head_group, init_subspace);
+  if (invariant_blocks.empty()) {
+    subspace = make_invariant_space(rep, head_group, init_subspace);
+  } else {
+    Index n_cols = 0;
+    for (auto const &block : invariant_blocks) {
+      n_cols += block.cols();
+    }
+    subspace.resize(rep[0].rows(), n_cols);
+    n_cols = 0;
+    for (auto const &block : invariant_blocks) {
+      subspace.middleCols(n_cols, block.cols()) = block;
+      n_cols += block.cols();
+    }
+  }
   if (log.has_value()) {
     prettyp<Log::verbose>(*log, "2. Initial invariant vector space", subspace);
   }
 
-  // 2) Perform irrep_decomposition
+  // 2) Perform irrep_decomposition, in each invariant block
+  config::begin_progress(progress, "irrep_decomposition", subspace.cols());
+  if (invariant_blocks.empty()) {
+    _decompose_block(rep, subspace, make_cyclic_subgroups_f,
+                     make_all_subgroups_f, allow_complex);
+  } else {
+    for (auto const &block : invariant_blocks) {
+      _decompose_block(rep, block, make_cyclic_subgroups_f,
+                       make_all_subgroups_f, allow_complex);
+    }
+  }
+
+  // 3) Combine to form symmetry adapted subspace
+  symmetry_adapted_subspace = full_trans_mat(irreps).adjoint();
+  if (log.has_value()) {
+    print_irreps<Log::verbose>(*log, "3. Irreps, symmetry adapted", irreps);
+    prettyp<Log::verbose>(*log, "4. Symmetry adapted vector space",
+                          symmetry_adapted_subspace);
+  }
+}
+
+/// Find the irreps in one invariant block, used by `_decompose`
+///
+/// \param rep Full space matrix representation
+/// \param block Orthonormal basis for a subspace that is invariant under
+///     `head_group`
+///
+/// Irreps are appended to `irreps`. The subspace remaining to be decomposed
+/// is tracked in the coordinates of `block`.
+template <typename RepType>
+void IrrepDecomposition::_decompose_block(
+    RepType const &rep, Eigen::MatrixXd const &block,
+    std::function<GroupIndicesOrbitSet()> make_cyclic_subgroups_f,
+    std::function<GroupIndicesOrbitSet()> make_all_subgroups_f,
+    bool allow_complex) {
+  using namespace IrrepDecompositionImpl;
+
   // In some cases the `irrep_decomposition` method does not find all irreps.
   // As long as it finds at least one, this loop will try again in the remaining
   // subspace.
-  Eigen::MatrixXd subspace_i = subspace;
-  Eigen::MatrixXd finished_subspace = make_kernel(subspace);
+  Eigen::MatrixXd subspace_i = block;
+  Eigen::MatrixXd finished_subspace(block.cols(), 0);
   Index i = 1;
-  while (finished_subspace.cols() != dim) {
+  while (finished_subspace.cols() != block.cols()) {
     if (log.has_value() && log->print()) {
       log->indent() << std::endl;
       log->indent() << "-- Begin step " << i << " --" << std::endl;
     }
 
     // Irreps are found in a subspace specified via the subspace matrix rep
-    MatrixRep subspace_rep_i = make_subspace_rep(fullspace_rep, subspace_i);
+    MatrixRep subspace_rep_i = make_subspace_rep(rep, subspace_i);
     std::vector<IrrepInfo> subspace_irreps_i =
-        irrep_decomposition(subspace_rep_i, head_group, allow_complex);
+        character_table
+            ? irrep_decomposition(subspace_rep_i, head_group,
+                                  *character_table, allow_complex, progress)
+            : irrep_decomposition(subspace_rep_i, head_group, allow_complex,
+                                  progress);
     if (log.has_value()) {
       print_irreps<Log::verbose>(*log, "Irreps, as found", subspace_irreps_i);
     }
@@ -159,7 +275,8 @@ IrrepDecomposition::IrrepDecomposition(
     // Symmetrize all the irreps that were found
     std::vector<IrrepInfo> symmetrized_subspace_irreps_i =
         symmetrize_irreps(subspace_rep_i, head_group, subspace_irreps_i,
-                          make_cyclic_subgroups_f, make_all_subgroups_f);
+                          make_cyclic_subgroups_f, make_all_subgroups_f,
+                          n_threads);
     if (log.has_value()) {
       print_irreps<Log::verbose>(*log, "Irreps, symmetrized",
                                  subspace_irreps_i);
@@ -181,7 +298,8 @@ IrrepDecomposition::IrrepDecomposition(
                                  subspace_irreps_i);
     }
 
-    // Combine the irrep spaces and add to finished_subspace
+    // Combine the irrep spaces and add to finished_subspace (in the
+    // coordinates of `block`)
     Eigen::MatrixXd finished_subspace_i =
         full_trans_mat(symmetrized_fullspace_irreps_i).adjoint();
     if (log.has_value()) {
@@ -189,26 +307,50 @@ IrrepDecomposition::IrrepDecomposition(
                             finished_subspace_i);
     }
 
-    finished_subspace = extend(finished_subspace, finished_subspace_i);
+    Index n_finished = finished_subspace.cols();
+    finished_subspace = extend(finished_subspace,
+                               block.transpose() * finished_subspace_i);
+    config::advance_progress(progress, finished_subspace.cols() - n_finished);
     if (log.has_value()) {
       prettyp<Log::verbose>(*log, "Combined vector space, so far",
                             finished_subspace_i);
     }
 
     // If not all irreps have been found, try again in remaining space
-    subspace_i = make_kernel(finished_subspace);
-    if (log.has_value()) {
-      prettyp<Log::verbose>(*log, "Remaining vector space", subspace_i);
+    if (finished_subspace.cols() != block.cols()) {
+      subspace_i = block * make_kernel(finished_subspace);
+      if (log.has_value()) {
+        prettyp<Log::verbose>(*log, "Remaining vector space", subspace_i);
+      }
     }
   }
+}
+
+/// \brief Return the full space matrix representation of one element
+///
+/// Uses `fullspace_rep` or `sparse_fullspace_rep`, whichever the
+/// decomposition was constructed with.
+Eigen::MatrixXd make_fullspace_matrix(
+    IrrepDecomposition const &irrep_decomposition, Index element_index) {
+  if (irrep_decomposition.fullspace_rep.empty()) {
+    return Eigen::MatrixXd(
+        irrep_decomposition.sparse_fullspace_rep[element_index]);
+  }
+  return irrep_decomposition.fullspace_rep[element_index];
+}
 
-  // 3) Combine to form symmetry adapted subspace
-  symmetry_adapted_subspace = full_trans_mat(irreps).adjoint();
-  if (log.has_value()) {
-    print_irreps<Log::verbose>(*log, "3. Irreps, symmetry adapted", irreps);
-    prettyp<Log::verbose>(*log, "4. Symmetry adapted vector space",
-                          symmetry_adapted_subspace);
+/// \brief Apply the full space matrix representation of one element to the
+///     columns of a matrix
+///
+/// Uses `fullspace_rep` or `sparse_fullspace_rep`, whichever the
+/// decomposition was constructed with.
+Eigen::MatrixXd apply_fullspace_rep(
+    IrrepDecomposition const &irrep_decomposition, Index element_index,
+    Eigen::MatrixXd const &M) {
+  if (irrep_decomposition.fullspace_rep.empty()) {
+    return irrep_decomposition.sparse_fullspace_rep[element_index] * M;
   }
+  return irrep_decomposition.fullspace_rep[element_index] * M;
 }
 
 }  // namespace irreps
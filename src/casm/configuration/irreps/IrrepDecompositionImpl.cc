@@ -23,6 +23,19 @@ void CommuterParamsCounter::reset(Eigen::MatrixXcd const &kernel) {
   m_valid = true;
   m_max_cols = kernel.cols();
   m_phase_index = 0;
+  m_n_phases = 2;
+
+  kernel_column_i = 0;
+  kernel_column_j = m_max_cols - 1;
+  phase = std::complex<double>(1., 0.);
+}
+
+/// For a real kernel, only real symmetric commuters (phase=1) are counted
+void CommuterParamsCounter::reset(Eigen::MatrixXd const &kernel) {
+  m_valid = true;
+  m_max_cols = kernel.cols();
+  m_phase_index = 0;
+  m_n_phases = 1;
 
   kernel_column_i = 0;
   kernel_column_j = m_max_cols - 1;
@@ -51,8 +64,8 @@ bool CommuterParamsCounter::increment() {
     kernel_column_i = 0;
     kernel_column_j = m_max_cols - 1;
 
-    // once m_phase_index gets to 2, we've finished all possibilities
-    if (m_phase_index == 2) {
+    // once m_phase_index gets to m_n_phases, we've finished all possibilities
+    if (m_phase_index == m_n_phases) {
       m_valid = false;
       return false;
     } else if (m_phase_index == 1) {
@@ -91,6 +104,32 @@ Eigen::MatrixXcd make_commuter(CommuterParamsCounter const &params,
   return M;
 }
 
+/// Make a real commuter, for phase=1
+///
+/// Each term of the Reynolds operation, R * M_init * R.transpose(), is a
+/// rank-2 update with the transformed kernel columns, so the commuter costs
+/// O(dim^2) per group element instead of a matrix-matrix product.
+Eigen::MatrixXd make_commuter(CommuterParamsCounter const &params,
+                              MatrixRep const &rep,
+                              GroupIndices const &head_group,
+                              Eigen::MatrixXd const &kernel) {
+  Index dim = rep[0].rows();
+  auto const &col_i = kernel.col(params.kernel_column_i);
+  auto const &col_j = kernel.col(params.kernel_column_j);
+  Eigen::MatrixXd M = Eigen::MatrixXd::Zero(dim, dim);
+  Eigen::VectorXd u(dim);
+  Eigen::VectorXd v(dim);
+
+  // Reynolds operation to symmetrize:
+  for (Index element_index : head_group) {
+    u = rep[element_index] * col_i;
+    v = rep[element_index] * col_j;
+    M.noalias() += u * v.transpose();
+    M.noalias() += v * u.transpose();
+  }
+  return M;
+}
+
 Eigen::MatrixXcd make_kernel(Eigen::MatrixXcd const &subspace) {
   Eigen::HouseholderQR<Eigen::MatrixXcd> qr;
   qr.compute(subspace);
@@ -161,6 +200,25 @@ Eigen::MatrixXcd make_irrep_subspace(Eigen::MatrixXcd const &KV_matrix,
   return irrep_subspace;
 }
 
+/// Make an irreducible subspace, for a real (K * V) matrix
+///
+/// The same as the complex overload with allow_complex=true, but in real
+/// arithmetic.
+Eigen::MatrixXd make_irrep_subspace(Eigen::MatrixXd const &KV_matrix,
+                                    Index begin, Index end) {
+  Index dim = KV_matrix.rows();
+  Eigen::MatrixXd X = KV_matrix.block(0, begin, dim, end - begin);
+
+  Eigen::HouseholderQR<Eigen::MatrixXd> qr;
+  Eigen::ColPivHouseholderQR<Eigen::MatrixXd> colqr;
+  colqr.setThreshold(TOL);
+
+  qr.compute(X);
+  colqr.compute(X);
+  Eigen::MatrixXd Q = qr.householderQ();
+  return Q.leftCols(colqr.rank());
+}
+
 /// Calculate character for all matrices in rep
 Eigen::VectorXcd make_characters(std::vector<Eigen::MatrixXcd> const &rep) {
   Eigen::VectorXcd characters(rep.size());
@@ -185,13 +243,13 @@ Eigen::VectorXd make_characters(std::vector<Eigen::MatrixXd> const &rep) {
   return characters;
 }
 
-/// Check if approximately zero outside block along diagonal
-///
-/// Only checks columns and rows in range [begin, end)
-bool make_is_block_diagonal(std::vector<Eigen::MatrixXcd> const &rep,
-                            Index begin, Index end, double tol) {
+namespace {
+
+template <typename MatrixType>
+bool _make_is_block_diagonal(std::vector<MatrixType> const &rep, Index begin,
+                             Index end, double tol) {
   Index element_index = 0;
-  for (Eigen::MatrixXcd const &matrix : rep) {
+  for (MatrixType const &matrix : rep) {
     // left
     if (begin != 0) {
       if (!almost_zero(matrix.block(begin, 0, end - begin, begin), tol)) {
@@ -226,13 +284,13 @@ bool make_is_block_diagonal(std::vector<Eigen::MatrixXcd> const &rep,
   return true;
 }
 
-/// Find characters for block in range [begin, end)
-Eigen::VectorXcd make_irrep_characters(std::vector<Eigen::MatrixXcd> const &rep,
-                                       Index begin, Index end) {
-  Eigen::VectorXcd characters(rep.size());
+template <typename VectorType, typename MatrixType>
+VectorType _make_irrep_characters(std::vector<MatrixType> const &rep,
+                                  Index begin, Index end) {
+  VectorType characters(rep.size());
 
   Index element_index = 0;
-  for (Eigen::MatrixXcd const &matrix : rep) {
+  for (MatrixType const &matrix : rep) {
     characters(element_index) =
         matrix.block(begin, begin, end - begin, end - begin).trace();
     ++element_index;
@@ -240,6 +298,36 @@ Eigen::VectorXcd make_irrep_characters(std::vector<Eigen::MatrixXcd> const &rep,
   return characters;
 }
 
+}  // namespace
+
+/// Check if approximately zero outside block along diagonal
+///
+/// Only checks columns and rows in range [begin, end)
+bool make_is_block_diagonal(std::vector<Eigen::MatrixXcd> const &rep,
+                            Index begin, Index end, double tol) {
+  return _make_is_block_diagonal(rep, begin, end, tol);
+}
+
+/// Check if approximately zero outside block along diagonal
+///
+/// Only checks columns and rows in range [begin, end)
+bool make_is_block_diagonal(std::vector<Eigen::MatrixXd> const &rep,
+                            Index begin, Index end, double tol) {
+  return _make_is_block_diagonal(rep, begin, end, tol);
+}
+
+/// Find characters for block in range [begin, end)
+Eigen::VectorXcd make_irrep_characters(std::vector<Eigen::MatrixXcd> const &rep,
+                                       Index begin, Index end) {
+  return _make_irrep_characters<Eigen::VectorXcd>(rep, begin, end);
+}
+
+/// Find characters for block in range [begin, end)
+Eigen::VectorXd make_irrep_characters(std::vector<Eigen::MatrixXd> const &rep,
+                                      Index begin, Index end) {
+  return _make_irrep_characters<Eigen::VectorXd>(rep, begin, end);
+}
+
 double make_squared_norm(Eigen::VectorXcd const &characters) {
   double squared_norm = 0.0;
   for (Index i = 0; i < characters.size(); ++i) {
@@ -270,6 +358,12 @@ bool is_extended_by(Eigen::MatrixXcd const &space_A,
   return almost_zero((space_B.adjoint() * space_A).norm(), TOL);
 }
 
+/// Return true if space_A is extended by space_B
+bool is_extended_by(Eigen::MatrixXd const &space_A,
+                    Eigen::MatrixXd const &space_B) {
+  return almost_zero((space_B.transpose() * space_A).norm(), TOL);
+}
+
 /// Return matrix combining columns of space_A and space_B
 Eigen::MatrixXcd extend(Eigen::MatrixXcd const &space_A,
                         Eigen::MatrixXcd const &space_B) {
@@ -321,6 +415,32 @@ PossibleIrrep::PossibleIrrep(
   subspace = make_irrep_subspace(KV_matrix, begin, end, allow_complex);
 }
 
+/// \brief Constructor, for a real (K * V) matrix and real transformed rep
+///
+/// The same as the complex constructor with allow_complex=true, but the
+/// block checks, characters, and subspace are calculated in real
+/// arithmetic. The characters and subspace are stored as complex, so that
+/// PossibleIrrep from either constructor compare the same way.
+PossibleIrrep::PossibleIrrep(
+    Eigen::VectorXd const &eigenvalues, Eigen::MatrixXd const &KV_matrix,
+    std::vector<Eigen::MatrixXd> const &transformed_rep,
+    Index _head_group_size, double _tol, Index _begin, Index _end)
+    : head_group_size(_head_group_size),
+      tol(_tol),
+      begin(_begin),
+      end(_end),
+      irrep_dim(end - begin) {
+  is_block_diagonal = make_is_block_diagonal(transformed_rep, begin, end, tol);
+  Eigen::VectorXd real_characters =
+      make_irrep_characters(transformed_rep, begin, end);
+  characters = real_characters.cast<std::complex<double>>();
+  characters_squared_norm = make_squared_norm(real_characters);
+  is_irrep = is_block_diagonal && almost_equal(characters_squared_norm,
+                                               double(head_group_size), tol);
+  subspace = make_irrep_subspace(KV_matrix, begin, end)
+                 .template cast<std::complex<double>>();
+}
+
 /// Check if Irrep is identity
 ///
 /// - First character is 1+0i, sum of characters == characters.size()
@@ -454,6 +574,41 @@ std::vector<PossibleIrrep> make_possible_irreps(
   return possible_irreps;
 }
 
+/// Given real kernel, K, and real commuter matrix, M, perform eigenvalue
+/// decomposition and construct possible irreps
+///
+/// The same as the complex overload, with allow_complex=true, but in real
+/// arithmetic. Only possible irreps of real type are found to be irreps.
+std::vector<PossibleIrrep> make_possible_irreps(
+    Eigen::MatrixXd const &commuter, Eigen::MatrixXd const &kernel,
+    MatrixRep const &rep, GroupIndices const &head_group,
+    double is_irrep_tol) {
+  double dim = kernel.rows();
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> esolve;
+  double scale = dim * sqrt(dim);
+  esolve.compute(scale * kernel.transpose() * commuter * kernel);
+  Eigen::VectorXd eigenvalues = esolve.eigenvalues();
+  Eigen::MatrixXd KV_matrix = kernel * esolve.eigenvectors();
+
+  std::vector<Eigen::MatrixXd> transformed_rep;
+  transformed_rep.reserve(head_group.size());
+  for (auto const &element_index : head_group) {
+    transformed_rep.push_back(KV_matrix.transpose() * rep[element_index] *
+                              KV_matrix);
+  }
+
+  std::vector<PossibleIrrep> possible_irreps;
+  Index begin = 0;
+  do {
+    Index end = find_end_of_equal_eigenvalues(begin, eigenvalues);
+    possible_irreps.emplace_back(eigenvalues, KV_matrix, transformed_rep,
+                                 head_group.size(), is_irrep_tol, begin, end);
+    begin = end;
+  } while (begin != eigenvalues.size());
+
+  return possible_irreps;
+}
+
 /// Make a vector of IrrepInfo from PossibleIrreps
 std::vector<IrrepInfo> make_irrep_info(std::set<PossibleIrrep> const &irreps) {
   std::vector<IrrepInfo> irrep_info;
@@ -530,6 +685,126 @@ bool is_irrep(MatrixRep const &rep, GroupIndices const &head_group) {
   return almost_equal(characters_squared_norm, double(head_group.size()), TOL);
 }
 
+/// \brief Frobenius-Schur indicator of a representation
+///
+/// The Frobenius-Schur indicator of a representation R is
+///
+///     nu(R) = (1/|G|) * sum_g trace(R(g)^2),
+///
+/// which equals sum_i m_i * nu_i, where m_i is the multiplicity and nu_i the
+/// Frobenius-Schur indicator of irrep i: 1 for irreps of real type, 0 for
+/// complex irreps, and -1 for irreps of quaternionic type. Since
+/// trace(A^2) = sum_ij A(i,j) * A(j,i), this costs O(dim^2) per element.
+double make_frobenius_schur_indicator(MatrixRep const &rep,
+                                      GroupIndices const &head_group) {
+  double sum = 0.0;
+  for (Index element_index : head_group) {
+    Eigen::MatrixXd const &R = rep[element_index];
+    sum += (R.array() * R.transpose().array()).sum();
+  }
+  return sum / head_group.size();
+}
+
+/// \brief Return true if the Frobenius-Schur indicator allows all irreps of
+///     a representation to be of real type
+///
+/// If all irreps of R are of real type, with multiplicities m_i, then
+/// nu(R) = sum_i m_i and (chi, chi) = sum_i m_i^2, so that
+/// nu(R)^2 >= (chi, chi). Complex irreps contribute to (chi, chi) but not
+/// to nu(R), and irreps of quaternionic type decrease nu(R). This is a
+/// necessary condition, and sufficient if nu(R) == (chi, chi), when R is
+/// multiplicity-free. In other cases, `real_irrep_decomposition` checks
+/// that the irreps it finds span the space.
+bool allows_real_irreps(MatrixRep const &rep, GroupIndices const &head_group) {
+  if (!rep.size() || !head_group.size()) {
+    return false;
+  }
+  double nu = make_frobenius_schur_indicator(rep, head_group);
+  double chi_squared_norm = 0.0;
+  for (Index element_index : head_group) {
+    double character = rep[element_index].trace();
+    chi_squared_norm += character * character;
+  }
+  chi_squared_norm /= head_group.size();
+  return nu > 0.5 && nu * nu > chi_squared_norm - 1e-4;
+}
+
+/// Finds irreducible subspaces of real type, in real arithmetic
+///
+/// This is the commuter method of `irrep_decomposition`, with a real
+/// kernel and only real symmetric commuters (phase=1), so kernels,
+/// commuters, and eigenvalue problems are real. For a representation with
+/// only irreps of real type this finds the same irreducible spaces as the
+/// complex method, with real basis vectors, using half the memory and about
+/// a quarter of the floating point operations. Possible irreps are only
+/// accepted if they are irreducible over the complex numbers, so complex
+/// irreps and irreps of quaternionic type are never found.
+///
+/// \param rep Matrix representation of head_group
+/// \param head_group Group for which the irreps are to be found
+/// \param progress If provided, checked for cancellation once per commuter
+///     matrix
+///
+/// \result vector of IrrepInfo objects, ordered as by `irrep_decomposition`.
+///     If `rep` has irreps that are not of real type, the irreps found do
+///     not span the space, which may be checked by the sum of
+///     `IrrepInfo::irrep_dim`.
+std::vector<IrrepInfo> real_irrep_decomposition(
+    MatrixRep const &rep, GroupIndices const &head_group,
+    std::shared_ptr<config::ProgressMonitor> progress) {
+  if (!rep.size()) {
+    return std::vector<IrrepInfo>();
+  }
+  Index dim = rep[0].rows();
+
+  Eigen::MatrixXd kernel = Eigen::MatrixXd::Identity(dim, dim);
+  Eigen::MatrixXd adapted_subspace{dim, 0};
+  std::set<PossibleIrrep> irreps;
+  CommuterParamsCounter commuter_params;
+  commuter_params.reset(kernel);
+  double is_irrep_tol = TOL;
+
+  while (adapted_subspace.cols() != dim && commuter_params.valid()) {
+    config::check_progress(progress);
+
+    Eigen::MatrixXd commuter =
+        make_commuter(commuter_params, rep, head_group, kernel);
+    if (almost_equal(commuter.squaredNorm(), 0., TOL)) {
+      commuter_params.increment();
+      continue;
+    }
+
+    std::vector<PossibleIrrep> possible_irreps = make_possible_irreps(
+        commuter, kernel, rep, head_group, is_irrep_tol);
+
+    bool any_new_irreps = false;
+    for (auto const &possible_irrep : possible_irreps) {
+      if (!possible_irrep.is_irrep) {
+        continue;
+      }
+      Eigen::MatrixXd irrep_subspace = possible_irrep.subspace.real();
+      if (is_extended_by(adapted_subspace, irrep_subspace)) {
+        irreps.insert(possible_irrep);
+        adapted_subspace = extend(adapted_subspace, irrep_subspace);
+        any_new_irreps = true;
+      }
+    }
+
+    if (any_new_irreps && adapted_subspace.cols() != dim) {
+      kernel = make_kernel(adapted_subspace);
+      commuter_params.reset(kernel);
+      if (kernel.cols() + adapted_subspace.cols() != adapted_subspace.rows()) {
+        throw std::runtime_error(
+            "Unknown error finding irreps: dimension mismatch");
+      }
+    } else {
+      commuter_params.increment();
+    }
+  }
+
+  return make_irrep_info(irreps);
+}
+
 /// IrrepDecomposition proceeds by constructing "commuters", M_k, which commute
 /// (M_k * R(r) = R(r) * M_k) with all of the matrix representations, R(r), of
 /// the group. The commuters are constructed to reveal irreducible vector
@@ -606,25 +881,45 @@ bool is_irrep(MatrixRep const &rep, GroupIndices const &head_group) {
 /// This method does not align the irrep subspace axes along high symmetry
 /// directions.
 ///
+/// If the Frobenius-Schur indicator of `rep` allows all irreps to be of real
+/// type (see `allows_real_irreps`), the decomposition is first attempted
+/// in real arithmetic with `real_irrep_decomposition`. If that does not span
+/// the space, the complex method is used.
+///
 /// \param rep Matrix representation of head_group, this defines group action
 /// on the underlying vector space
 /// \param head_group Group for which the irreps are to be found
 /// \param allow_complex If true, irreducible space basis vectors may be
 ///     complex-valued. If false, complex irreps are combined to form real
 ///     representations
+/// \param progress If provided, checked for cancellation once per commuter
+///     matrix
 ///
 /// \result vector of IrrepInfo objects. Irreps are ordered by dimension, with
 ///     identity first (if present).  Repeated irreps (with equal character
 ///     vectors) are sequential, and are distinguished by IrrepInfo::index.
 ///
-std::vector<IrrepInfo> irrep_decomposition(MatrixRep const &rep,
-                                           GroupIndices const &head_group,
-                                           bool allow_complex) {
+std::vector<IrrepInfo> irrep_decomposition(
+    MatrixRep const &rep, GroupIndices const &head_group, bool allow_complex,
+    std::shared_ptr<config::ProgressMonitor> progress) {
   if (!rep.size()) {
     return std::vector<IrrepInfo>();
   }
   int dim = rep[0].rows();
 
+  // If all irreps may be of real type, try the real method first
+  if (allows_real_irreps(rep, head_group)) {
+    std::vector<IrrepInfo> real_irreps =
+        real_irrep_decomposition(rep, head_group, progress);
+    Index found_dim = 0;
+    for (auto const &irrep : real_irreps) {
+      found_dim += irrep.irrep_dim;
+    }
+    if (found_dim == dim) {
+      return real_irreps;
+    }
+  }
+
   // This method iteratively finds irreducible spaces, which are used to extend
   // the "adapted_subspace" (combined space of found irreducible spaces). The
   // "adapted_subspace" is not aligned along high symmetry directions by this
@@ -649,6 +944,7 @@ std::vector<IrrepInfo> irrep_decomposition(MatrixRep const &rep,
   double is_irrep_tol = TOL;
 
   do {  // while adapated_subspace.cols() != dim
+    config::check_progress(progress);
 
     if (!commuter_params.valid()) {
       // The commuter construction method does not currently guarantee that
@@ -712,6 +1008,234 @@ std::vector<IrrepInfo> irrep_decomposition(MatrixRep const &rep,
   return irrep_info;
 }
 
+namespace {
+
+/// \brief Return an orthonormal basis for the column space of a projector
+///
+/// \param P A projector, which has eigenvalues 0 and 1
+/// \param rank The expected rank of P
+///
+/// \throws If P does not have `rank` eigenvalues equal to 1
+template <typename MatrixType>
+MatrixType _make_projector_range(MatrixType const &P, Index rank) {
+  Index dim = P.rows();
+  Eigen::SelfAdjointEigenSolver<MatrixType> solver((P + P.adjoint()) / 2.0);
+  auto const &eigenvalues = solver.eigenvalues();
+  if (rank > 0 && (!almost_equal(eigenvalues(dim - rank), 1.0, 1e-4) ||
+                   (rank < dim &&
+                    !almost_equal(eigenvalues(dim - rank - 1), 0.0, 1e-4)))) {
+    throw std::runtime_error(
+        "Error in irrep_decomposition: invalid character projector");
+  }
+  return solver.eigenvectors().rightCols(rank);
+}
+
+/// \brief Return irrep characters, in head_group order
+Eigen::VectorXcd _make_element_characters(
+    CharacterTable const &character_table, GroupIndices const &head_group,
+    Eigen::VectorXcd const &class_characters) {
+  Eigen::VectorXcd characters(head_group.size());
+  Index i = 0;
+  for (Index element_index : head_group) {
+    characters(i) =
+        class_characters(character_table.class_index[element_index]);
+    ++i;
+  }
+  return characters;
+}
+
+}  // namespace
+
+/// Finds irreducible subspaces using character projection operators
+///
+/// This method uses the character table of the group to project onto the
+/// isotypic components of the space represented by `rep`, using the
+/// projection operators
+///
+///     P_i = (d_i / |G|) * sum_g conj(chi_i(g)) * rep[g],
+///
+/// where d_i is the dimension and chi_i the characters of irrep i. An
+/// isotypic component that contains one copy of an irrep is an irreducible
+/// space. Isotypic components with multiplicity > 1 are split using
+/// `irrep_decomposition(MatrixRep const &, GroupIndices const &, bool)` on
+/// the component only, which is much smaller than the whole space.
+///
+/// This method does not align the irrep subspace axes along high symmetry
+/// directions.
+///
+/// \param rep Matrix representation of head_group, this defines group action
+///     on the underlying vector space
+/// \param head_group Group for which the irreps are to be found. Must
+///     include all elements `[0, rep.size())` of the group described by
+///     `character_table`.
+/// \param character_table Character table of the group
+/// \param allow_complex If true, irreducible space basis vectors may be
+///     complex-valued. If false, complex irreps are combined with their
+///     complex conjugate to form real representations
+/// \param progress If provided, checked for cancellation once per irrep
+///
+/// \result vector of IrrepInfo objects. Irreps are ordered as in the
+///     character table, by dimension, with identity first. Repeated irreps
+///     (with equal character vectors) are sequential, and are distinguished
+///     by IrrepInfo::index.
+///
+/// \throws If `head_group` and `character_table` are inconsistent, or if
+///     the irreps found do not span the space
+std::vector<IrrepInfo> irrep_decomposition(
+    MatrixRep const &rep, GroupIndices const &head_group,
+    CharacterTable const &character_table, bool allow_complex,
+    std::shared_ptr<config::ProgressMonitor> progress) {
+  if (!rep.size()) {
+    return std::vector<IrrepInfo>();
+  }
+  Index group_size = character_table.group_size();
+  if (rep.size() != group_size || head_group.size() != group_size ||
+      *head_group.begin() != 0 || *head_group.rbegin() != group_size - 1) {
+    throw std::runtime_error(
+        "Error in irrep_decomposition: head_group is not the group described "
+        "by the character table");
+  }
+  Index dim = rep[0].rows();
+  Index n_classes = character_table.conjugacy_classes.size();
+  double tol = TOL;
+
+  // class sums, sum_{g in class c} rep[g]
+  std::vector<Eigen::MatrixXd> class_sum(n_classes,
+                                         Eigen::MatrixXd::Zero(dim, dim));
+  for (Index element_index : head_group) {
+    class_sum[character_table.class_index[element_index]] += rep[element_index];
+  }
+
+  // make character projection operator
+  auto make_projector = [&](Index irrep_index) {
+    Eigen::MatrixXcd P = complex_Zero(dim, dim);
+    for (Index c = 0; c < n_classes; ++c) {
+      std::complex<double> chi = character_table.characters(irrep_index, c);
+      if (chi != 0.0) {
+        P += std::conj(chi) * class_sum[c].cast<std::complex<double>>();
+      }
+    }
+    P *= double(character_table.irrep_dim[irrep_index]) / group_size;
+    return P;
+  };
+
+  // make real character projection operator, for real class characters
+  // (for a complex irrep paired with its conjugate, use 2 * chi.real())
+  auto make_real_projector = [&](Eigen::VectorXd const &chi, Index d) {
+    Eigen::MatrixXd P = Eigen::MatrixXd::Zero(dim, dim);
+    for (Index c = 0; c < n_classes; ++c) {
+      if (chi(c) != 0.0) {
+        P += chi(c) * class_sum[c];
+      }
+    }
+    P *= double(d) / group_size;
+    return P;
+  };
+
+  std::vector<IrrepInfo> irrep_info;
+  std::vector<bool> is_done(character_table.n_irreps(), false);
+  Index total_dim = 0;
+  for (Index i = 0; i < character_table.n_irreps(); ++i) {
+    config::check_progress(progress);
+    if (is_done[i]) {
+      continue;
+    }
+    is_done[i] = true;
+    Eigen::VectorXcd chi = character_table.characters.row(i).transpose();
+    Index irrep_dim = character_table.irrep_dim[i];
+
+    // multiplicity, from (chi_i, chi_rep)
+    std::complex<double> m_sum = 0.0;
+    for (Index c = 0; c < n_classes; ++c) {
+      m_sum += std::conj(chi(c)) * class_sum[c].trace();
+    }
+    double m = m_sum.real() / group_size;
+    Index multiplicity = std::lround(m);
+    if (!almost_equal(m, double(multiplicity), 1e-4)) {
+      throw std::runtime_error(
+          "Error in irrep_decomposition: non-integer irrep multiplicity");
+    }
+
+    // complex irreps are paired with their complex conjugate if real
+    // irreducible spaces are required, or if multiplicities must be split
+    bool is_complex = !almost_zero(chi.imag(), tol);
+    bool is_paired = is_complex && (!allow_complex || multiplicity > 1);
+    if (is_paired) {
+      Index j = i + 1;
+      for (; j < character_table.n_irreps(); ++j) {
+        if (!is_done[j] &&
+            almost_equal(Eigen::VectorXcd(
+                             character_table.characters.row(j).transpose()),
+                         Eigen::VectorXcd(chi.conjugate()), tol)) {
+          break;
+        }
+      }
+      if (j == character_table.n_irreps()) {
+        throw std::runtime_error(
+            "Error in irrep_decomposition: complex irrep without conjugate");
+      }
+      is_done[j] = true;
+    }
+    if (multiplicity == 0) {
+      continue;
+    }
+    Index block_dim = multiplicity * irrep_dim * (is_paired ? 2 : 1);
+    total_dim += block_dim;
+
+    // a single complex irrep is found in complex arithmetic
+    if (multiplicity == 1 && is_complex && !is_paired) {
+      irrep_info.emplace_back(
+          _make_projector_range(make_projector(i), block_dim).adjoint(),
+          _make_element_characters(character_table, head_group, chi));
+      continue;
+    }
+
+    // otherwise, the projector is real: P_i for real characters, or
+    // P_i + P_conj(i) = (d_i / |G|) * sum_g 2 * chi_i(g).real() * rep[g]
+    // for a complex pair
+    if (is_paired) {
+      chi += chi.conjugate().eval();
+    }
+    Eigen::MatrixXd P_real = make_real_projector(chi.real(), irrep_dim);
+
+    // a single copy of an irrep (or complex pair) is found directly
+    if (multiplicity == 1) {
+      Eigen::MatrixXcd subspace = _make_projector_range(P_real, block_dim)
+                                      .template cast<std::complex<double>>();
+      irrep_info.emplace_back(
+          subspace.adjoint(),
+          _make_element_characters(character_table, head_group, chi));
+      irrep_info.back().pseudo_irrep = is_paired;
+      continue;
+    }
+
+    // multiple copies are split by decomposing the isotypic component only
+    // (in real arithmetic, if the irrep is of real type)
+    Eigen::MatrixXd block_subspace = _make_projector_range(P_real, block_dim);
+    MatrixRep block_rep = make_subspace_rep(rep, block_subspace);
+    std::vector<IrrepInfo> block_irreps =
+        irrep_decomposition(block_rep, head_group, allow_complex, progress);
+    Index found_dim = 0;
+    Index index = 0;
+    for (auto const &irrep : block_irreps) {
+      irrep_info.push_back(subspace_to_full_space(irrep, block_subspace));
+      irrep_info.back().index = index++;
+      found_dim += irrep.irrep_dim;
+    }
+    if (found_dim != block_dim) {
+      throw std::runtime_error(
+          "Error in irrep_decomposition: failed to split isotypic component");
+    }
+  }
+
+  if (total_dim != dim) {
+    throw std::runtime_error(
+        "Error in irrep_decomposition: character projectors do not span the "
+        "space");
+  }
+  return irrep_info;
+}
+
 /// Convert irreps generated for a subspace to full space dimension
 ///
 /// \param subspace_irreps Irreducible spaces in the subspace
@@ -730,10 +1254,13 @@ std::vector<IrrepInfo> make_fullspace_irreps(
   return fullspace_irreps;
 }
 
+namespace {
+
 /// Expand subspace by application of group, and orthogonalize
-Eigen::MatrixXd make_invariant_space(MatrixRep const &rep,
-                                     GroupIndices const &head_group,
-                                     Eigen::MatrixXd const &subspace) {
+template <typename RepType>
+Eigen::MatrixXd _make_invariant_space(RepType const &rep,
+                                      GroupIndices const &head_group,
+                                      Eigen::MatrixXd const &subspace) {
   if (!subspace.isIdentity()) {
     Eigen::MatrixXd symspace(subspace.rows(),
                              subspace.cols() * head_group.size());
@@ -752,6 +1279,33 @@ Eigen::MatrixXd make_invariant_space(MatrixRep const &rep,
   return subspace;
 }
 
+/// \brief Right-hand factor which transforms subspace coordinates to
+///     fullspace coordinates, as a transposed pseudo-inverse
+Eigen::MatrixXd _make_subspace_rightmat(Eigen::MatrixXd const &subspace) {
+  return subspace.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV)
+      .solve(Eigen::MatrixXd::Identity(subspace.rows(), subspace.rows()))
+      .transpose();
+}
+
+}  // namespace
+
+/// Expand subspace by application of group, and orthogonalize
+Eigen::MatrixXd make_invariant_space(MatrixRep const &rep,
+                                     GroupIndices const &head_group,
+                                     Eigen::MatrixXd const &subspace) {
+  return _make_invariant_space(rep, head_group, subspace);
+}
+
+/// Expand subspace by application of group, and orthogonalize
+///
+/// Same as `make_invariant_space(MatrixRep const &, ...)`, but uses sparse
+/// matrix-dense matrix products.
+Eigen::MatrixXd make_invariant_space(SparseMatrixRep const &rep,
+                                     GroupIndices const &head_group,
+                                     Eigen::MatrixXd const &subspace) {
+  return _make_invariant_space(rep, head_group, subspace);
+}
+
 /// \brief Create the subspace rep from the fullspace rep
 ///
 /// Create `subspace_rep`, a transformed copy of `fullspace_rep` that acts
@@ -770,10 +1324,7 @@ Eigen::MatrixXd make_invariant_space(MatrixRep const &rep,
 MatrixRep make_subspace_rep(MatrixRep const &fullspace_rep,
                             Eigen::MatrixXd const &subspace) {
   Eigen::MatrixXd trans_mat = subspace.transpose();
-  Eigen::MatrixXd rightmat =
-      subspace.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV)
-          .solve(Eigen::MatrixXd::Identity(trans_mat.cols(), trans_mat.cols()))
-          .transpose();
+  Eigen::MatrixXd rightmat = _make_subspace_rightmat(subspace);
   MatrixRep subspace_rep;
   for (Index i = 0; i < fullspace_rep.size(); ++i) {
     subspace_rep.push_back(trans_mat * fullspace_rep[i] * rightmat);
@@ -781,23 +1332,49 @@ MatrixRep make_subspace_rep(MatrixRep const &fullspace_rep,
   return subspace_rep;
 }
 
+/// \brief Create the subspace rep from the sparse fullspace rep
+///
+/// Same as `make_subspace_rep(MatrixRep const &, ...)`, but the sparse
+/// fullspace matrices are only multiplied with the dense, narrow
+/// `subspace` factors, so no dense fullspace matrix is constructed.
+MatrixRep make_subspace_rep(SparseMatrixRep const &fullspace_rep,
+                            Eigen::MatrixXd const &subspace) {
+  Eigen::MatrixXd trans_mat = subspace.transpose();
+  Eigen::MatrixXd rightmat = _make_subspace_rightmat(subspace);
+  MatrixRep subspace_rep;
+  for (Index i = 0; i < fullspace_rep.size(); ++i) {
+    subspace_rep.push_back(trans_mat * (fullspace_rep[i] * rightmat));
+  }
+  return subspace_rep;
+}
+
 /// \brief Symmetrize IrrepInfo, by finding high symmetry directions and
 /// aligning the irrep subspace basis with those directions
+///
+/// The subgroup Reynolds operators are constructed once and shared by the
+/// high symmetry direction searches of all irreps.
+///
+/// \param n_threads Number of threads used to search for high symmetry
+///     directions. If <= 0, uses `config::default_n_threads()`. The result
+///     does not depend on the number of threads.
 std::vector<IrrepInfo> symmetrize_irreps(
     MatrixRep const &subspace_rep, GroupIndices const &head_group,
     std::vector<IrrepInfo> const &irreps,
     std::function<GroupIndicesOrbitSet()> make_cyclic_subgroups_f,
-    std::function<GroupIndicesOrbitSet()> make_all_subgroups_f) {
+    std::function<GroupIndicesOrbitSet()> make_all_subgroups_f,
+    Index n_threads) {
   std::vector<IrrepInfo> symmetrized_irreps;
   double vec_compare_tol = TOL;
   bool use_all_subgroups = false;
+  SubgroupProjectors projectors(subspace_rep, make_cyclic_subgroups_f,
+                                make_all_subgroups_f, n_threads);
   for (const auto &irrep : irreps) {
     Eigen::MatrixXcd irrep_subspace = irrep.trans_mat.adjoint();
 
     multivector<Eigen::VectorXcd>::X<2> irrep_special_directions =
-        make_irrep_special_directions(subspace_rep, head_group, irrep_subspace,
-                                      vec_compare_tol, make_cyclic_subgroups_f,
-                                      make_all_subgroups_f, use_all_subgroups);
+        make_irrep_special_directions(projectors, head_group, irrep_subspace,
+                                      vec_compare_tol, use_all_subgroups,
+                                      n_threads);
 
     Eigen::MatrixXcd symmetrizer_matrix = make_irrep_symmetrizer_matrix(
         irrep_special_directions, irrep_subspace, vec_compare_tol);
@@ -2,19 +2,20 @@
 
 #include "casm/configuration/irreps/IrrepDecompositionImpl.hh"
 #include "casm/configuration/irreps/VectorSymCompare_v2.hh"
+#include "casm/configuration/parallel.hh"
 #include "casm/container/Counter.hh"
 #include "casm/misc/CASM_Eigen_math.hh"
-#include "casm/misc/algorithm.hh"
 
 namespace CASM {
 namespace irreps {
 
 namespace IrrepWedgeImpl {
 
-/// \param _rep The dimension of _rep should match the dimension of the irrep
-static IrrepWedge _wedge_from_pseudo_irrep(IrrepInfo const &irrep,
-                                           MatrixRep const &_rep,
-                                           GroupIndices const &head_group) {
+/// \param irrep_decomposition The dimension of the full space rep should
+///     match the dimension of the irrep
+static IrrepWedge _wedge_from_pseudo_irrep(
+    IrrepInfo const &irrep, IrrepDecomposition const &irrep_decomposition,
+    GroupIndices const &head_group) {
   Eigen::MatrixXd t_axes = irrep.trans_mat.transpose().real();
   Eigen::MatrixXd axes = vector_space_prepare(t_axes, TOL);
   Eigen::VectorXd v = axes.col(0);
@@ -27,7 +28,8 @@ static IrrepWedge _wedge_from_pseudo_irrep(IrrepInfo const &irrep,
   for (Index i = 1; i < axes.cols(); ++i) {
     double bestproj = -1;
     for (Index element_index : head_group) {
-      v = _rep[element_index] * axes.col(0);
+      v = apply_fullspace_rep(irrep_decomposition, element_index,
+                              axes.col(0));
       // std::cout << "v: " << v.transpose() << std::endl;
       bool skip_op = false;
       for (Index j = 0; j < i; ++j) {
@@ -50,6 +52,74 @@ static IrrepWedge _wedge_from_pseudo_irrep(IrrepInfo const &irrep,
   return IrrepWedge(irrep, axes);
 }
 
+/// \brief Make the IrrepWedge of one irrep
+static IrrepWedge _make_irrep_wedge(
+    IrrepInfo const &irrep, IrrepDecomposition const &irrep_decomposition) {
+  // 1D irreps directions can have positive and negative directions, but we
+  // only want to include one. only 1D irreps can have singly-degenerate
+  // directions and two singly-degenerate directions indicate the same vector
+  // duplicated in positive and negative direction (because they are not
+  // equivalent by symmetry) If irrep.directions[0] is singly degenerate
+  // (orbits size == 1) then irrepdim is 1 and we only need one direction to
+  // define wedge
+  if (irrep.directions.empty()) {
+    return _wedge_from_pseudo_irrep(irrep, irrep_decomposition,
+                                    irrep_decomposition.head_group);
+  }
+  IrrepWedge wedge(irrep,
+                   Eigen::MatrixXd::Zero(irrep.vector_dim, irrep.irrep_dim));
+
+  wedge.axes.col(0) = irrep.directions[0][0];
+  wedge.mult.push_back(irrep.directions[0].size());
+  for (Index i = 1; i < irrep.irrep_dim; i++) {
+    Index j_best = 0;
+    double best_proj = (wedge.axes.transpose() * irrep.directions[i][0]).sum();
+    for (Index j = 1; j < irrep.directions[i].size(); j++) {
+      double tproj = (wedge.axes.transpose() * irrep.directions[i][j]).sum();
+      if (tproj > best_proj) {
+        best_proj = tproj;
+        j_best = j;
+      }
+    }
+
+    wedge.axes.col(i) = irrep.directions[i][j_best];
+    wedge.mult.push_back(irrep.directions[i].size());
+  }
+  return wedge;
+}
+
+/// \brief Return the index in `orbit` of the wedge with `axes`, or -1
+static Index _find_wedge(std::vector<IrrepWedge> const &orbit,
+                         Eigen::MatrixXd const &axes) {
+  for (Index o = 0; o < orbit.size(); ++o) {
+    if (Eigen::almost_equal(orbit[o].axes, axes)) {
+      return o;
+    }
+  }
+  return -1;
+}
+
+/// \brief Make the orbit of an IrrepWedge, and the subgroup of head_group
+///     elements that leave it invariant
+static void _make_irrep_wedge_orbit(
+    IrrepDecomposition const &irrep_decomposition, IrrepWedge const &wedge,
+    std::vector<IrrepWedge> &orbit, std::vector<Index> &invariant_subgroup) {
+  orbit = {wedge};
+  invariant_subgroup.clear();
+  for (Index element_index : irrep_decomposition.head_group) {
+    IrrepWedge test_wedge{wedge};
+    test_wedge.axes =
+        apply_fullspace_rep(irrep_decomposition, element_index, wedge.axes);
+    Index o = _find_wedge(orbit, test_wedge.axes);
+    if (o == 0) {
+      invariant_subgroup.push_back(element_index);
+    }
+    if (o == -1) {
+      orbit.push_back(test_wedge);
+    }
+  }
+}
+
 }  // namespace IrrepWedgeImpl
 
 IrrepWedge::IrrepWedge(IrrepInfo _irrep_info, Eigen::MatrixXd _axes)
@@ -104,169 +174,169 @@ SubWedge make_dummy_subwedge(Eigen::MatrixXd const &axes) {
 
 /// Make IrrepWedges from an IrrepDecomposition
 ///
+/// \param irrep_decomposition The IrrepDecomposition
+/// \param n_threads Number of threads used to make the IrrepWedge of
+///     different irreps. If <= 0, uses `std::thread::hardware_concurrency()`.
+///
 /// \result A vector of IrrepWedge. The IrrepWedge axes have number of cols ==
 ///     irrep dimension and number of rows equal to the full space dimension.
 std::vector<IrrepWedge> make_irrep_wedges(
-    IrrepDecomposition const &irrep_decomposition) {
+    IrrepDecomposition const &irrep_decomposition, Index n_threads) {
   std::vector<IrrepInfo> const &irreps = irrep_decomposition.irreps;
-  MatrixRep const &fullspace_rep = irrep_decomposition.fullspace_rep;
-  GroupIndices const &head_group = irrep_decomposition.head_group;
 
   std::vector<IrrepWedge> wedges;
   wedges.reserve(irreps.size());
-  double best_proj, tproj;
-
-  // std::cout << "subspace: \n" << _subspace << std::endl;
-  // std::cout << "irrep decomposition size: " << irreps.size() << std::endl;
-
   for (IrrepInfo const &irrep : irreps) {
-    // 1D irreps directions can have positive and negative directions, but we
-    // only want to include one. only 1D irreps can have singly-degenerate
-    // directions and two singly-degenerate directions indicate the same vector
-    // duplicated in positive and negative direction (because they are not
-    // equivalent by symmetry) If irrep.directions[0] is singly degenerate
-    // (orbits size == 1) then irrepdim is 1 and we only need one direction to
-    // define wedge
-    wedges.emplace_back(
-        irrep, Eigen::MatrixXd::Zero(irrep.vector_dim, irrep.irrep_dim));
-    // std::cout << "Irrep characters: \n" << irrep.characters << std::endl;
-    // std::cout << "Irrep directions: " << irrep.directions.size() <<
-    // std::endl;
-    if (irrep.directions.empty()) {
-      wedges.back() = IrrepWedgeImpl::_wedge_from_pseudo_irrep(
-          irrep, fullspace_rep, head_group);
-      continue;
-    }
-
-    // std::cout << "Irrep direction orbit" << 0 << " : " <<
-    // irrep.directions[0].size() << std::endl; std::cout << "Irrep direction: "
-    // << irrep.directions[0][0].transpose() << std::endl;
-    wedges.back().axes.col(0) = irrep.directions[0][0];
-    wedges.back().mult.push_back(irrep.directions[0].size());
-    for (Index i = 1; i < irrep.irrep_dim; i++) {
-      // std::cout << "Irrep direction orbit" << i << " : " <<
-      // irrep.directions[i].size() << std::endl; std::cout << "Irrep direction:
-      // " << irrep.directions[i][0].transpose() << std::endl;
-      Index j_best = 0;
-      best_proj =
-          (wedges.back().axes.transpose() * irrep.directions[i][0]).sum();
-      for (Index j = 1; j < irrep.directions[i].size(); j++) {
-        tproj = (wedges.back().axes.transpose() * irrep.directions[i][j]).sum();
-        if (tproj > best_proj) {
-          best_proj = tproj;
-          j_best = j;
-        }
-      }
-
-      wedges.back().axes.col(i) = irrep.directions[i][j_best];
-      wedges.back().mult.push_back(irrep.directions[i].size());
-    }
-    // std::cout << "New irrep wedge: \n" << wedges.back().axes.transpose() <<
-    // std::endl;
+    wedges.emplace_back(irrep, Eigen::MatrixXd());
   }
+  config::parallel_for_chunks(
+      irreps.size(), n_threads,
+      [&](Index chunk_index, Index begin, Index end) {
+        for (Index i = begin; i < end; ++i) {
+          wedges[i] = IrrepWedgeImpl::_make_irrep_wedge(irreps[i],
+                                                        irrep_decomposition);
+        }
+      });
   return wedges;
 }
 
 /// \brief Find full irreducible wedge of a group-represented vector space, as
 /// a vector of SubWedges, from an IrrepDecomposition
+///
+/// Method:
+/// - Make the IrrepWedge of each irrep, and its orbit of equivalent
+///   IrrepWedge.
+/// - Each combination of one IrrepWedge from each orbit is a candidate
+///   SubWedge. The orbit with the largest number of equivalents is fixed to
+///   its first element, and candidates are equivalent if related by an
+///   element of its invariant subgroup.
+/// - The first candidate, in Counter order, of each set of equivalent
+///   candidates is kept.
+///
+/// Candidates are compared as indices into the IrrepWedge orbits, using a
+/// table of the action of the invariant subgroup on each orbit, so the
+/// cost is linear in the number of candidates. The orbits, the table, and
+/// the candidate checks are distributed over threads, and the result does
+/// not depend on the number of threads.
+///
+/// \param irrep_decomposition The IrrepDecomposition
+/// \param n_threads Number of threads. If <= 0, uses
+///     `std::thread::hardware_concurrency()`.
 std::vector<SubWedge> make_symrep_subwedges(
-    IrrepDecomposition const &irrep_decomposition) {
-  auto irrep_wedge_compare = [](const IrrepWedge &a,
-                                const IrrepWedge &b) -> bool {
-    return Eigen::almost_equal(a.axes, b.axes);
-  };
-
-  auto tot_wedge_compare = [irrep_wedge_compare](
-                               const std::vector<IrrepWedge> &a,
-                               const std::vector<IrrepWedge> &b) -> bool {
-    if (a.size() != b.size()) return false;
-    for (auto ita = a.begin(), itb = b.begin(); ita != a.end(); ++ita, ++itb)
-      if (!irrep_wedge_compare(*ita, *itb)) return false;
-    // std::cout << "Equal: \n" << SubWedge(a).trans_mat << ",\n" <<
-    // SubWedge(b).trans_mat << "\n\n";
-    return true;
-  };
-
-  std::vector<IrrepWedge> init_wedges = make_irrep_wedges(irrep_decomposition);
-  MatrixRep const &fullspace_rep = irrep_decomposition.fullspace_rep;
-  GroupIndices const &head_group = irrep_decomposition.head_group;
-
+    IrrepDecomposition const &irrep_decomposition, Index n_threads) {
+  std::vector<IrrepWedge> init_wedges =
+      make_irrep_wedges(irrep_decomposition, n_threads);
   std::vector<SubWedge> result;
+  if (init_wedges.empty()) {
+    return result;
+  }
+  Index n_wedges = init_wedges.size();
+
+  // irrep_wedge_orbits[w] is orbit of wedges[w], subgroups[w] leaves
+  // wedges[w] invariant
+  std::vector<std::vector<IrrepWedge>> irrep_wedge_orbits(n_wedges);
+  std::vector<std::vector<Index>> subgroups(n_wedges);
+  config::parallel_for_chunks(
+      n_wedges, n_threads, [&](Index chunk_index, Index begin, Index end) {
+        for (Index w = begin; w < end; ++w) {
+          IrrepWedgeImpl::_make_irrep_wedge_orbit(
+              irrep_decomposition, init_wedges[w], irrep_wedge_orbits[w],
+              subgroups[w]);
+        }
+      });
 
-  // irrep_wedge_orbits[w] is orbit of wedges[w]
-  multivector<IrrepWedge>::X<2> irrep_wedge_orbits;
-  irrep_wedge_orbits.reserve(init_wedges.size());
   // max_equiv[w] is irrep_wedge_orbits[w].size()-1
   std::vector<Index> max_equiv;
-  max_equiv.reserve(init_wedges.size());
-  // std::cout << "irreducible wedges for group of order " << head_group.size()
-  // << std::endl;
+  max_equiv.reserve(n_wedges);
   Index imax = 0;
-  multivector<Index>::X<2> subgroups;
-  for (IrrepWedge const &wedge : init_wedges) {
-    // std::cout << "Working wedge with axes: \n" << wedge.axes.transpose() <<
-    // std::endl;
-    irrep_wedge_orbits.push_back({wedge});
+  for (Index w = 0; w < n_wedges; ++w) {
+    max_equiv.push_back(irrep_wedge_orbits[w].size() - 1);
+    if (max_equiv.back() > max_equiv[imax]) imax = w;
+  }
+  max_equiv[imax] = 0;
+  std::vector<Index> const &subgroup = subgroups[imax];
 
-    // Start getting orbit of wedges[w]
-    subgroups.push_back({});
-    for (Index element_index : head_group) {
-      IrrepWedge test_wedge{wedge};
-      test_wedge.axes = fullspace_rep[element_index] * wedge.axes;
-      Index o = 0;
-      for (; o < irrep_wedge_orbits.back().size(); ++o) {
-        if (irrep_wedge_compare(irrep_wedge_orbits.back()[o], test_wedge)) {
-          if (o == 0) {
-            subgroups.back().push_back(element_index);
+  // equiv_index[w][s][o]: index in irrep_wedge_orbits[w] of
+  //     subgroup[s] * irrep_wedge_orbits[w][o]
+  std::vector<std::vector<std::vector<Index>>> equiv_index(
+      n_wedges, std::vector<std::vector<Index>>(subgroup.size()));
+  config::parallel_for_chunks(
+      n_wedges * subgroup.size(), n_threads,
+      [&](Index chunk_index, Index begin, Index end) {
+        for (Index k = begin; k < end; ++k) {
+          Index w = k / subgroup.size();
+          Index s = k % subgroup.size();
+          std::vector<IrrepWedge> const &orbit = irrep_wedge_orbits[w];
+          for (IrrepWedge const &wedge : orbit) {
+            Index o = IrrepWedgeImpl::_find_wedge(
+                orbit, apply_fullspace_rep(irrep_decomposition, subgroup[s],
+                                           wedge.axes));
+            if (o == -1) {
+              throw std::runtime_error(
+                  "Error in make_symrep_subwedges: IrrepWedge orbit is not "
+                  "closed");
+            }
+            equiv_index[w][s].push_back(o);
           }
-          break;
         }
-      }
-      if (o < irrep_wedge_orbits.back().size()) continue;
-      irrep_wedge_orbits.back().push_back(test_wedge);
-    }
-    // std::cout << "wedge mult: " << irrep_wedge_orbits.back().size();
-    // std::cout << "; subgroups[" << subgroups.size() << "]: " <<
-    // subgroups.back() << std::endl; std::cout << "N equiv wedges found: " <<
-    // irrep_wedge_orbits.back().size() << std::endl;
-    max_equiv.push_back(irrep_wedge_orbits.back().size() - 1);
-    if (max_equiv.back() > max_equiv[imax]) imax = max_equiv.size() - 1;
+      });
+
+  // Candidates are labeled by a linear index, with stride[w] for wedge w,
+  // and sequence[linear] is the position in Counter order
+  std::vector<Index> stride(n_wedges, 1);
+  for (Index w = 1; w < n_wedges; ++w) {
+    stride[w] = stride[w - 1] * (max_equiv[w - 1] + 1);
   }
-  max_equiv[imax] = 0;
+  Index n_candidates = stride.back() * (max_equiv.back() + 1);
+  std::vector<Index> sequence(n_candidates);
+  std::vector<Index> candidates;
+  candidates.reserve(n_candidates);
 
   // Counter over combinations of equivalent wedges
-  Counter<std::vector<Index>> wcount(std::vector<Index>(init_wedges.size(), 0),
+  Counter<std::vector<Index>> wcount(std::vector<Index>(n_wedges, 0),
                                      max_equiv,
-                                     std::vector<Index>(init_wedges.size(), 1));
-
-  // std::cout << "max_equiv: " << max_equiv << std::endl;
-  // std::cout << "init wcount: " << wcount() << std::endl;
-  multivector<IrrepWedge>::X<3> tot_wedge_orbits;
-  // std::cout << "Starting slow bit!\n";
+                                     std::vector<Index>(n_wedges, 1));
   for (; wcount; ++wcount) {
-    std::vector<IrrepWedge> twedge = init_wedges;
-    for (Index i = 0; i < init_wedges.size(); i++)
-      twedge[i].axes = irrep_wedge_orbits[i][wcount[i]].axes;
+    Index linear = 0;
+    for (Index w = 0; w < n_wedges; ++w) {
+      linear += wcount[w] * stride[w];
+    }
+    sequence[linear] = candidates.size();
+    candidates.push_back(linear);
+  }
 
-    if (contains_if(
-            tot_wedge_orbits,
-            [tot_wedge_compare, &twedge](
-                const multivector<IrrepWedge>::X<2> &wedge_orbit) -> bool {
-              return contains(wedge_orbit, twedge, tot_wedge_compare);
-            }))
-      continue;
+  // A candidate is kept if no equivalent candidate is earlier
+  std::vector<char> is_first(candidates.size(), 0);
+  config::parallel_for_chunks(
+      candidates.size(), n_threads,
+      [&](Index chunk_index, Index begin, Index end) {
+        for (Index c = begin; c < end; ++c) {
+          is_first[c] = 1;
+          for (Index s = 0; s < subgroup.size(); ++s) {
+            Index equiv_linear = 0;
+            for (Index w = 0; w < n_wedges; ++w) {
+              Index o = (candidates[c] / stride[w]) % (max_equiv[w] + 1);
+              equiv_linear += equiv_index[w][s][o] * stride[w];
+            }
+            if (sequence[equiv_linear] < c) {
+              is_first[c] = 0;
+              break;
+            }
+          }
+        }
+      });
 
-    tot_wedge_orbits.push_back({twedge});
-    result.emplace_back(twedge);
-    for (Index p : subgroups[imax]) {
-      for (Index i = 0; i < twedge.size(); i++)
-        twedge[i].axes = fullspace_rep[p] * result.back().irrep_wedges[i].axes;
-      if (!contains(tot_wedge_orbits.back(), twedge, tot_wedge_compare)) {
-        tot_wedge_orbits.back().push_back(twedge);
-      }
+  for (Index c = 0; c < candidates.size(); ++c) {
+    if (!is_first[c]) {
+      continue;
     }
+    std::vector<IrrepWedge> twedge = init_wedges;
+    for (Index w = 0; w < n_wedges; ++w) {
+      Index o = (candidates[c] / stride[w]) % (max_equiv[w] + 1);
+      twedge[w].axes = irrep_wedge_orbits[w][o].axes;
+    }
+    result.emplace_back(twedge);
   }
-  // std::cout << "Num subwedges: " << result.size() << std::endl;
   return result;
 }
 
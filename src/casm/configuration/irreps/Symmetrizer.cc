@@ -1,7 +1,10 @@
 #include "casm/configuration/irreps/Symmetrizer.hh"
 
+#include <map>
+
 #include "casm/configuration/irreps/SimpleOrbit_impl.hh"
 #include "casm/configuration/irreps/VectorSymCompare_v2.hh"
+#include "casm/configuration/parallel.hh"
 #include "casm/misc/CASM_Eigen_math.hh"
 #include "casm/misc/CASM_math.hh"
 
@@ -9,6 +12,83 @@ namespace CASM {
 
 namespace irreps {
 
+/// \brief Constructor
+///
+/// \param _rep Matrix representation, which defines the group action on the
+///     underlying vector space
+/// \param _make_cyclic_subgroups_f Function that makes the orbits of cyclic
+///     subgroups, called on first use
+/// \param _make_all_subgroups_f Function that makes the orbits of all
+///     subgroups, called on first use
+/// \param _n_threads Number of threads used to construct Reynolds
+///     operators. If <= 0, uses `config::default_n_threads()`.
+SubgroupProjectors::SubgroupProjectors(
+    MatrixRep const &_rep,
+    std::function<GroupIndicesOrbitSet()> _make_cyclic_subgroups_f,
+    std::function<GroupIndicesOrbitSet()> _make_all_subgroups_f,
+    Index _n_threads)
+    : m_rep(_rep),
+      m_make_cyclic_subgroups_f(_make_cyclic_subgroups_f),
+      m_make_all_subgroups_f(_make_all_subgroups_f),
+      m_n_threads(_n_threads) {}
+
+/// \brief Representative subgroups, one per orbit, and their Reynolds
+///     operators, for cyclic subgroups or for all subgroups
+///
+/// The representative of each orbit is its first subgroup, and the order is
+/// the order of the orbits. Constructed on first use.
+SubgroupProjectors::projectors_type const &SubgroupProjectors::projectors(
+    bool use_all_subgroups) {
+  if (!use_all_subgroups) {
+    if (!m_cyclic.has_value()) {
+      m_cyclic = _make_projectors(m_make_cyclic_subgroups_f(), nullptr);
+    }
+    return *m_cyclic;
+  }
+  if (!m_all.has_value()) {
+    m_all = _make_projectors(m_make_all_subgroups_f(),
+                             m_cyclic.has_value() ? &*m_cyclic : nullptr);
+  }
+  return *m_all;
+}
+
+/// \brief Make Reynolds operators of orbit representatives, in parallel,
+///     copying those in `existing` rather than constructing them again
+SubgroupProjectors::projectors_type SubgroupProjectors::_make_projectors(
+    GroupIndicesOrbitSet const &sgroups,
+    projectors_type const *existing) const {
+  std::map<GroupIndices, Eigen::MatrixXd const *> existing_R;
+  if (existing) {
+    for (auto const &pair : *existing) {
+      existing_R.emplace(pair.first, &pair.second);
+    }
+  }
+  projectors_type result;
+  result.reserve(sgroups.size());
+  for (auto const &orbit : sgroups) {
+    result.emplace_back(*orbit.begin(), Eigen::MatrixXd());
+  }
+  Index dim = m_rep[0].rows();
+  config::parallel_for_chunks(
+      result.size(), m_n_threads,
+      [&](Index chunk_index, Index begin, Index end) {
+        for (Index i = begin; i < end; ++i) {
+          GroupIndices const &subgroup = result[i].first;
+          Eigen::MatrixXd &R = result[i].second;
+          auto it = existing_R.find(subgroup);
+          if (it != existing_R.end()) {
+            R = *it->second;
+            continue;
+          }
+          R.setZero(dim, dim);
+          for (Index element_index : subgroup) {
+            R += m_rep[element_index];
+          }
+        }
+      });
+  return result;
+}
+
 /// Find high-symmetry directions in a irreducible space
 ///
 /// \param rep Matrix representation of head_group, this defines group action
@@ -20,10 +100,17 @@ namespace irreps {
 ///     the dimension of the irreducible space.
 /// \param vec_compare_tol Tolerance for elementwise floating-point comparisons
 ///     of vectors
-/// \param all_subgroups Denotes whether all subgroups of head_group should be
-///     used for symmetry analysis (if true), or only cyclic subgroups (if
-///     false). Cyclic subgroups are those found by taking a group element and
-///     multiplying it by itself until a group is generated.
+/// \param make_cyclic_subgroups_f Function that makes the orbits of cyclic
+///     subgroups of head_group
+/// \param make_all_subgroups_f Function that makes the orbits of all
+///     subgroups of head_group
+/// \param use_all_subgroups Denotes whether all subgroups of head_group
+///     should be used for symmetry analysis (if true), or only cyclic
+///     subgroups (if false). Cyclic subgroups are those found by taking a
+///     group element and multiplying it by itself until a group is generated.
+/// \param n_threads Number of threads. If <= 0, uses
+///     `config::default_n_threads()`. The result does not depend on the
+///     number of threads.
 ///
 /// \result Set of directions in the vector space on which 'rep' is defined,
 /// such that each direction is invariant to a unique subgroup of 'head_group'
@@ -41,37 +128,66 @@ multivector<Eigen::VectorXcd>::X<2> make_irrep_special_directions(
     Eigen::MatrixXcd const &irrep_subspace, double vec_compare_tol,
     std::function<GroupIndicesOrbitSet()> make_cyclic_subgroups_f,
     std::function<GroupIndicesOrbitSet()> make_all_subgroups_f,
-    bool use_all_subgroups) {
-  GroupIndicesOrbitSet sgroups =
-      (use_all_subgroups ? make_all_subgroups_f() : make_cyclic_subgroups_f());
+    bool use_all_subgroups, Index n_threads) {
+  SubgroupProjectors projectors(rep, make_cyclic_subgroups_f,
+                                make_all_subgroups_f, n_threads);
+  return make_irrep_special_directions(projectors, head_group, irrep_subspace,
+                                       vec_compare_tol, use_all_subgroups,
+                                       n_threads);
+}
 
-  std::vector<Eigen::VectorXcd> tdirs;
-  Eigen::MatrixXd R;
-  Index dim = rep[0].rows();
+/// Find high-symmetry directions in a irreducible space, using shared
+/// subgroup Reynolds operators
+///
+/// Same as `make_irrep_special_directions` using a matrix rep and subgroup
+/// functions, but the Reynolds operators of the subgroups are obtained from
+/// `projectors`, so that they are constructed once for all irreps of
+/// `projectors.rep()`.
+///
+/// \param n_threads Number of threads used to project `irrep_subspace`
+///     onto the invariant subspaces of subgroups. If <= 0, uses
+///     `config::default_n_threads()`. The result does not depend on the
+///     number of threads.
+multivector<Eigen::VectorXcd>::X<2> make_irrep_special_directions(
+    SubgroupProjectors &projectors, GroupIndices const &head_group,
+    Eigen::MatrixXcd const &irrep_subspace, double vec_compare_tol,
+    bool use_all_subgroups, Index n_threads) {
+  MatrixRep const &rep = projectors.rep();
+  SubgroupProjectors::projectors_type const &sgroup_R =
+      projectors.projectors(use_all_subgroups);
 
   // Loop over small (i.e., cyclic) subgroups and hope that each special
   // direction is invariant to at least one small subgroup
-  for (auto const &orbit : sgroups) {
-    // Reynolds for small subgroup *(orbit.begin()) in irrep_subspace i
-    R.setZero(dim, dim);
+  // (each subgroup is independent, so the directions found for subgroup i
+  // are stored in subgroup_dirs[i] and then collected in order)
+  std::vector<std::vector<Eigen::VectorXcd>> subgroup_dirs(sgroup_R.size());
+  config::parallel_for_chunks(
+      sgroup_R.size(), n_threads,
+      [&](Index chunk_index, Index begin, Index end) {
+        for (Index i = begin; i < end; ++i) {
+          // Reynolds for small subgroup in irrep_subspace
+          Eigen::MatrixXd const &R = sgroup_R[i].second;
+          Eigen::MatrixXcd R_subspace = R * irrep_subspace;
 
-    for (Index element_index : *(orbit.begin())) {
-      R += rep[element_index];
-    }
+          if (R_subspace.norm() < TOL) continue;
 
-    if ((R * irrep_subspace).norm() < TOL) continue;
+          // Find spanning vectors of column space of R*irrep_space, which is
+          // projection of irrep_space into its invariant component
+          auto QR = R_subspace.colPivHouseholderQr();
+          QR.setThreshold(TOL);
+          // If only one spanning vector, it is special direction
+          if (QR.rank() > 1) continue;
+          Eigen::MatrixXcd Q = QR.matrixQ();
 
-    // Find spanning vectors of column space of R*irrep_space, which is
-    // projection of irrep_space into its invariant component
-    auto QR = (R * irrep_subspace).colPivHouseholderQr();
-    QR.setThreshold(TOL);
-    // If only one spanning vector, it is special direction
-    if (QR.rank() > 1) continue;
-    Eigen::MatrixXcd Q = QR.matrixQ();
+          // Convert from irrep_subspace back to total space and push_back
+          subgroup_dirs[i].push_back(Q.col(0));
+          subgroup_dirs[i].push_back(-Q.col(0));
+        }
+      });
 
-    // Convert from irrep_subspace back to total space and push_back
-    tdirs.push_back(Q.col(0));
-    tdirs.push_back(-Q.col(0));
+  std::vector<Eigen::VectorXcd> tdirs;
+  for (auto const &dirs : subgroup_dirs) {
+    tdirs.insert(tdirs.end(), dirs.begin(), dirs.end());
   }
 
   // t_result may contain duplicates, or elements that are equivalent by
@@ -93,9 +209,9 @@ multivector<Eigen::VectorXcd>::X<2> make_irrep_special_directions(
   if (use_all_subgroups || result.size() >= irrep_subspace.cols()) {
     return result;
   } else {
-    return make_irrep_special_directions(
-        rep, head_group, irrep_subspace, vec_compare_tol,
-        make_cyclic_subgroups_f, make_all_subgroups_f, true);
+    return make_irrep_special_directions(projectors, head_group,
+                                         irrep_subspace, vec_compare_tol,
+                                         true, n_threads);
   }
 }
 
@@ -1,21 +1,67 @@
 #include "casm/configuration/irreps/VectorSpaceSymReport.hh"
 
+#include "casm/configuration/parallel.hh"
 #include "casm/misc/CASM_Eigen_math.hh"
 
 namespace CASM {
 namespace irreps {
 
+namespace {  // (anonymous)
+
+/// \brief Make the matrix of one operation in an irreducible subspace
+///
+/// \param irrep The irreducible subspace
+/// \param apply_f Function that returns the product of the full space
+///     matrix of the operation with a matrix, `M_o * A`
+///
+/// \returns The real part of `irrep.trans_mat * M_o *
+///     irrep.trans_mat.transpose()`, without constructing `M_o` if `apply_f`
+///     does not need it.
+template <typename ApplyFunction>
+Eigen::MatrixXd make_irrep_matrix(IrrepInfo const &irrep,
+                                  ApplyFunction apply_f) {
+  Eigen::MatrixXd trans_mat_re = irrep.trans_mat.real();
+  Eigen::MatrixXd result =
+      trans_mat_re * apply_f(Eigen::MatrixXd(trans_mat_re.transpose()));
+  if (!irrep.trans_mat.imag().isZero(0.0)) {
+    Eigen::MatrixXd trans_mat_im = irrep.trans_mat.imag();
+    result -= trans_mat_im * apply_f(Eigen::MatrixXd(trans_mat_im.transpose()));
+  }
+  return result;
+}
+
+}  // namespace
+
 /// \brief Constructor
+///
+/// \param _irrep_symgroup_rep The matrix representation in each irreducible
+///     subspace (see `irrep_symgroup_rep`). If empty, it is constructed from
+///     `_symgroup_rep`.
 VectorSpaceSymReport::VectorSpaceSymReport(
     std::vector<Eigen::MatrixXd> _symgroup_rep, std::vector<IrrepInfo> _irreps,
     std::vector<SubWedge> _irreducible_wedge,
     Eigen::MatrixXd const &_symmetry_adapted_subspace,
-    std::vector<std::string> _axis_glossary)
+    std::vector<std::string> _axis_glossary,
+    std::vector<std::vector<Eigen::MatrixXd>> _irrep_symgroup_rep)
     : symgroup_rep(std::move(_symgroup_rep)),
+      irrep_symgroup_rep(std::move(_irrep_symgroup_rep)),
       irreps(std::move(_irreps)),
       irreducible_wedge(std::move(_irreducible_wedge)),
       symmetry_adapted_subspace(_symmetry_adapted_subspace),
       axis_glossary(std::move(_axis_glossary)) {
+  if (irrep_symgroup_rep.empty() && !symgroup_rep.empty()) {
+    for (auto const &irrep : this->irreps) {
+      std::vector<Eigen::MatrixXd> irrep_rep;
+      for (auto const &op : symgroup_rep) {
+        irrep_rep.push_back(make_irrep_matrix(
+            irrep, [&](Eigen::MatrixXd const &A) -> Eigen::MatrixXd {
+              return op * A;
+            }));
+      }
+      irrep_symgroup_rep.push_back(std::move(irrep_rep));
+    }
+  }
+
   // ~~~ Identify irrep_names, irrep_axes_indices, irrep_wedges  ~~~
   std::vector<Index> mults;
   for (auto const &irrep : this->irreps) {
@@ -65,14 +111,45 @@ VectorSpaceSymReport::VectorSpaceSymReport(
 /// \param axis_glossary If has value, copied to
 /// VectorSpaceSymReport.axis_glossary;
 ///     otherwise, axis_glossary is set to {"x1", "x2", ...}
+/// \param n_threads Number of threads used to construct
+///     'irreducible_wedge' and 'irrep_symgroup_rep'. If <= 0, uses
+///     `std::thread::hardware_concurrency()`.
+/// \param include_symgroup_rep If true, 'symgroup_rep' is constructed. If
+///     false, 'symgroup_rep' is empty, which avoids constructing a dense full
+///     space matrix for each operation when they are not needed.
+///
+/// The matrix representation in each irreducible subspace,
+/// 'irrep_symgroup_rep', is constructed by applying the full space matrix
+/// representation stored in `irrep_decomposition` (which may be sparse) to
+/// the irrep transformation matrices, rather than from 'symgroup_rep'.
 VectorSpaceSymReport vector_space_sym_report(
     IrrepDecomposition const &irrep_decomposition, bool calc_wedges,
-    std::optional<std::vector<std::string>> axis_glossary) {
+    std::optional<std::vector<std::string>> axis_glossary, Index n_threads,
+    bool include_symgroup_rep) {
   std::vector<Eigen::MatrixXd> symgroup_rep;
-  for (Index element_index : irrep_decomposition.head_group) {
-    symgroup_rep.push_back(irrep_decomposition.fullspace_rep[element_index]);
+  if (include_symgroup_rep) {
+    for (Index element_index : irrep_decomposition.head_group) {
+      symgroup_rep.push_back(
+          make_fullspace_matrix(irrep_decomposition, element_index));
+    }
   }
 
+  auto const &irreps = irrep_decomposition.irreps;
+  std::vector<std::vector<Eigen::MatrixXd>> irrep_symgroup_rep(irreps.size());
+  config::parallel_for_chunks(
+      irreps.size(), n_threads,
+      [&](Index chunk_index, Index begin, Index end) {
+        for (Index l = begin; l < end; ++l) {
+          for (Index element_index : irrep_decomposition.head_group) {
+            irrep_symgroup_rep[l].push_back(make_irrep_matrix(
+                irreps[l], [&](Eigen::MatrixXd const &A) {
+                  return apply_fullspace_rep(irrep_decomposition,
+                                             element_index, A);
+                }));
+          }
+        }
+      });
+
   if (!axis_glossary.has_value()) {
     axis_glossary = std::vector<std::string>(
         irrep_decomposition.symmetry_adapted_subspace.rows(), "x");
@@ -84,12 +161,13 @@ VectorSpaceSymReport vector_space_sym_report(
 
   std::vector<SubWedge> irreducible_wedge;
   if (calc_wedges) {
-    irreducible_wedge = make_symrep_subwedges(irrep_decomposition);
+    irreducible_wedge = make_symrep_subwedges(irrep_decomposition, n_threads);
   }
 
   return VectorSpaceSymReport(
-      symgroup_rep, irrep_decomposition.irreps, irreducible_wedge,
-      irrep_decomposition.symmetry_adapted_subspace, axis_glossary.value());
+      std::move(symgroup_rep), irrep_decomposition.irreps, irreducible_wedge,
+      irrep_decomposition.symmetry_adapted_subspace, axis_glossary.value(),
+      std::move(irrep_symgroup_rep));
 }
 
 }  // namespace irreps
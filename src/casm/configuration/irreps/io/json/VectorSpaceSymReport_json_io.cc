@@ -69,15 +69,16 @@ jsonParser &to_json(VectorSpaceSymReport const &obj, jsonParser &json) {
       }
       json["irreducible_representations"]["subspaces"].push_back(subspace_json);
 
-      jsonParser &irrep_matrices =
-          json["irreducible_representations"]["symop_matrices"]
-              [irrep_name];  //.put_array();
-      for (Index o = 0; o < obj.symgroup_rep.size(); ++o) {
-        Eigen::MatrixXd const &op = obj.symgroup_rep[o];
-        std::string op_name =
-            "op_" + to_sequential_string(o + 1, obj.symgroup_rep.size());
-        irrep_matrices[op_name] =
-            (irrep.trans_mat * op * irrep.trans_mat.transpose()).real();
+      if (l < obj.irrep_symgroup_rep.size()) {
+        jsonParser &irrep_matrices =
+            json["irreducible_representations"]["symop_matrices"]
+                [irrep_name];  //.put_array();
+        auto const &irrep_rep = obj.irrep_symgroup_rep[l];
+        for (Index o = 0; o < irrep_rep.size(); ++o) {
+          std::string op_name =
+              "op_" + to_sequential_string(o + 1, irrep_rep.size());
+          irrep_matrices[op_name] = irrep_rep[o];
+        }
       }
 
       {
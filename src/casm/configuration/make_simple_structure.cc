@@ -1,15 +1,120 @@
 #include "casm/configuration/make_simple_structure.hh"
 
+#include <algorithm>
+#include <array>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>  // see https://github.com/prisms-center/CASMcode_clexulator/issues/19
 
 #include "casm/clexulator/ConfigDoFValuesTools_impl.hh"
 #include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Supercell.hh"
 #include "casm/crystallography/SimpleStructure.hh"
 #include "casm/crystallography/StrainConverter.hh"
 
 namespace CASM {
 namespace config {
 
+namespace {
+
+/// \brief Return the Cartesian coordinates, as columns, of the ideal
+///     supercell sites, in order of linear site index
+///
+/// Equivalent to `converter(l).coordinate(*prim.basicstructure).const_cart()`
+/// for each site `l`, without constructing a Coordinate for each site.
+Eigen::MatrixXd make_ideal_site_coordinates(Supercell const &supercell) {
+  auto const &converter = supercell.unitcellcoord_index_converter;
+  auto const &basicstructure = *supercell.prim->basicstructure;
+  Eigen::Matrix3d const &L = basicstructure.lattice().lat_column_mat();
+  std::vector<Eigen::Vector3d> basis_cart;
+  for (auto const &site : basicstructure.basis()) {
+    basis_cart.push_back(site.const_cart());
+  }
+  Index n_sites = converter.total_sites();
+  Eigen::MatrixXd coords(3, n_sites);
+  for (Index l = 0; l < n_sites; ++l) {
+    xtal::UnitCellCoord bijk = converter(l);
+    coords.col(l) =
+        basis_cart[bijk.sublattice()] + L * bijk.unitcell().cast<double>();
+  }
+  return coords;
+}
+
+/// \brief Deformed supercell lattice vectors and ideal site coordinates,
+///     for one supercell and deformation gradient
+struct DeformedSupercell {
+  std::weak_ptr<Supercell const> supercell;
+
+  /// F * L_ideal
+  Eigen::Matrix3d lat_column_mat;
+
+  /// F * R_ideal, for all sites
+  Eigen::MatrixXd coords;
+};
+
+/// \brief Process-wide cache of DeformedSupercell, used by
+///     make_simple_structure
+///
+/// Strain grid and displacement enumerations convert many configurations
+/// with the same supercell and strain, so the deformed lattice and ideal
+/// site coordinates are kept for the most recently used (supercell, F), and
+/// only displacements are applied for each configuration.
+struct DeformedSupercellCache {
+  typedef std::pair<Supercell const *, std::array<double, 9>> key_type;
+
+  std::mutex mutex;
+
+  /// Least recently used entries are evicted if there are more than this
+  Index max_size = 16;
+
+  /// Most recently used first
+  std::list<std::pair<key_type, std::shared_ptr<DeformedSupercell const>>>
+      lru;
+
+  /// \brief Return the deformed supercell, constructing it if not present
+  std::shared_ptr<DeformedSupercell const> get(
+      std::shared_ptr<Supercell const> const &supercell,
+      Eigen::Matrix3d const &F) {
+    key_type key;
+    key.first = supercell.get();
+    std::copy(F.data(), F.data() + 9, key.second.begin());
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (auto it = lru.begin(); it != lru.end(); ++it) {
+        if (it->first == key && it->second->supercell.lock() == supercell) {
+          lru.splice(lru.begin(), lru, it);
+          return it->second;
+        }
+      }
+    }
+
+    // construct without holding the lock
+    auto value = std::make_shared<DeformedSupercell>();
+    value->supercell = supercell;
+    value->lat_column_mat =
+        F * supercell->superlattice.superlattice().lat_column_mat();
+    value->coords = F * make_ideal_site_coordinates(*supercell);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    lru.emplace_front(key, value);
+    while (Index(lru.size()) > max_size) {
+      lru.pop_back();
+    }
+    return value;
+  }
+};
+
+DeformedSupercellCache &deformed_supercell_cache() {
+  static DeformedSupercellCache *cache = new DeformedSupercellCache();
+  return *cache;
+}
+
+}  // namespace
+
 /// \brief (deprecated) Convert a Configuration to a SimpleStructure
 ///
 /// This method is deprecated in favor of ToAtomicStructure.
@@ -50,6 +155,10 @@ namespace config {
 ///     the unique occupant names obtained from
 ///     ``xtal::BasicStructure::unique_names``, `b` is the sublattice index of
 ///     the site, and `s` is the occupation index.
+/// - The deformed lattice vectors and ideal site coordinates are cached for
+///   recently used (supercell, deformation gradient), so that converting
+///   many configurations with the same supercell and strain only applies
+///   the deformation to displacements.
 xtal::SimpleStructure make_simple_structure(
     Configuration const &configuration,
     std::map<std::string, Eigen::MatrixXd> const &local_properties,
@@ -95,10 +204,6 @@ xtal::SimpleStructure make_simple_structure(
     }
   }
 
-  // set m_ideal_lat_column_mat
-  Eigen::Matrix3d ideal_lat_column_mat =
-      supercell.superlattice.superlattice().lat_column_mat();
-
   // get atom type names
   std::vector<std::string> names;
   std::vector<Index> site_index;
@@ -123,13 +228,6 @@ xtal::SimpleStructure make_simple_structure(
     }
   }
 
-  // get ideal site coordinates (all sites)
-  Eigen::MatrixXd coords(3, n_sites);
-  for (Index l = 0; l < n_sites; ++l) {
-    xtal::UnitCellCoord bijk = converter(l);
-    coords.col(l) = bijk.coordinate(*prim.basicstructure).const_cart();
-  }
-
   // get deformation gradient, F
   Eigen::Matrix3d F;
   DoFKey strain_dof_key;
@@ -148,6 +246,11 @@ xtal::SimpleStructure make_simple_structure(
     F = Eigen::Matrix3d::Identity();
   }
 
+  // get deformed lattice and ideal site coordinates (all sites)
+  std::shared_ptr<DeformedSupercell const> deformed =
+      deformed_supercell_cache().get(configuration.supercell, F);
+  Eigen::MatrixXd const &coords = deformed->coords;
+
   // get displacements (all sites)
   Eigen::MatrixXd disp = Eigen::MatrixXd::Zero(3, n_sites);
   if (local_dof_values.count("disp")) {
@@ -161,13 +264,15 @@ xtal::SimpleStructure make_simple_structure(
   // construct SimpleStructure
   xtal::SimpleStructure structure;
 
-  structure.lat_column_mat = ideal_lat_column_mat;
+  // deformation is already applied to lattice and ideal coordinates, apply
+  // it to displacements
+  structure.lat_column_mat = deformed->lat_column_mat;
   structure.atom_info.resize(names.size());
   structure.atom_info.names = names;
   structure.atom_info.coords = Eigen::MatrixXd::Zero(3, site_index.size());
   for (Index i = 0; i < site_index.size(); ++i) {
     Index l = site_index[i];
-    structure.atom_info.coords.col(i) = coords.col(l) + disp.col(l);
+    structure.atom_info.coords.col(i) = coords.col(l) + F * disp.col(l);
   }
 
   // copy local_dof (excluding disp)
@@ -270,7 +375,6 @@ xtal::SimpleStructure make_simple_structure(
     structure.atom_info.properties.emplace(key, structure_values);
   }
 
-  structure.deform_coords(F);
   return structure;
 }
 
@@ -329,5 +433,173 @@ xtal::SimpleStructure ToAtomicStructure::operator()(
                                m_excluded_species);
 }
 
+/// \brief Construct the atomic structures of many configurations, in one
+///     buffer
+///
+/// \param configurations The configurations, which must all have the same
+///     prim, with only atomic occupants
+/// \param atom_type_naming_method Specifies how to set atom type names, as
+///     for ToAtomicStructure.
+/// \param excluded_species Specifies names that should not be
+///     included in the resulting structures.
+///
+/// \returns structures, with the same atom types and order, coordinates,
+///     and lattice vectors, as `ToAtomicStructure` gives for each
+///     configuration. Properties are not included.
+///
+/// Notes:
+/// - Atom type names are listed in order of first occurrence when
+///   iterating over prim sublattices and then over occupants.
+/// - Ideal site coordinates are found once per supercell, and atom counts
+///   are found before filling the output, so that coordinates are written
+///   into preallocated arrays.
+/// - Deformation gradient applied to ideal lattice vectors and coordinates
+///   is obtained from a strain DoF, if present, otherwise it is the identity
+///   matrix.
+AtomicStructures make_atomic_structures(
+    std::vector<Configuration> const &configurations,
+    std::string atom_type_naming_method,
+    std::set<std::string> excluded_species) {
+  AtomicStructures structures;
+  Index n_structures = configurations.size();
+  structures.lat_column_mat = Eigen::MatrixXd::Zero(3, 3 * n_structures);
+  structures.atom_offsets = Eigen::VectorXl::Zero(n_structures + 1);
+  if (n_structures == 0) {
+    return structures;
+  }
+
+  auto const &prim_ptr = configurations[0].supercell->prim;
+  auto const &prim = *prim_ptr;
+  auto const &basis = prim.basicstructure->basis();
+  if (!prim.is_atomic) {
+    throw std::runtime_error(
+        "Error in make_atomic_structures: not an atomic structure");
+  }
+
+  // atom type index by sublattice and occupant index, -1 if excluded
+  std::vector<std::vector<int>> atom_type_index;
+  for (Index b = 0; b < basis.size(); ++b) {
+    atom_type_index.emplace_back();
+    for (Index s = 0; s < basis[b].occupant_dof().size(); ++s) {
+      std::string name;
+      if (atom_type_naming_method == "orientation_name") {
+        name = prim.basicstructure->unique_names()[b][s];
+      } else if (atom_type_naming_method == "chemical_name") {
+        name = basis[b].occupant_dof()[s].name();
+      } else {
+        std::stringstream msg;
+        msg << "Error in make_atomic_structures: invalid "
+               "atom_type_naming_method='"
+            << atom_type_naming_method << "'";
+        throw std::runtime_error(msg.str());
+      }
+      int type = -1;
+      if (!excluded_species.count(name)) {
+        auto &names = structures.atom_type_names;
+        type = std::find(names.begin(), names.end(), name) - names.begin();
+        if (type == names.size()) {
+          names.push_back(name);
+        }
+      }
+      atom_type_index.back().push_back(type);
+    }
+  }
+
+  // count atoms, validating prim and occupation indices
+  for (Index i = 0; i < n_structures; ++i) {
+    auto const &supercell = *configurations[i].supercell;
+    if (supercell.prim != prim_ptr) {
+      throw std::runtime_error(
+          "Error in make_atomic_structures: configurations do not all have "
+          "the same prim");
+    }
+    auto const &converter = supercell.unitcellcoord_index_converter;
+    Eigen::VectorXi const &occupation =
+        configurations[i].dof_values.occupation;
+    Index n_atoms = 0;
+    for (Index l = 0; l < occupation.size(); ++l) {
+      auto const &types = atom_type_index[converter(l).sublattice()];
+      int s = occupation(l);
+      if (s < 0 || s >= types.size()) {
+        std::stringstream msg;
+        msg << "Error in make_atomic_structures: invalid occupation=" << s
+            << " at linear_site_index=" << l << " of configuration " << i
+            << ".";
+        throw std::runtime_error(msg.str());
+      }
+      if (types[s] != -1) {
+        ++n_atoms;
+      }
+    }
+    structures.atom_offsets(i + 1) = structures.atom_offsets(i) + n_atoms;
+  }
+
+  Index n_atoms_total = structures.atom_offsets(n_structures);
+  structures.atom_type.resize(n_atoms_total);
+  structures.coords.resize(3, n_atoms_total);
+
+  bool has_strain = has_strain_dof(*prim.basicstructure);
+  DoFKey strain_dof_key;
+  std::optional<xtal::StrainConverter> strain_converter;
+  if (has_strain) {
+    strain_dof_key = get_strain_dof_key(*prim.basicstructure);
+    strain_converter.emplace(strain_dof_key,
+                             prim.global_dof_info.at(strain_dof_key).basis());
+  }
+  bool has_disp = prim.local_dof_info.count("disp");
+  Index N_sublat = basis.size();
+
+  // ideal site coordinates, by supercell
+  std::map<Supercell const *, Eigen::MatrixXd> ideal_coords;
+
+  for (Index i = 0; i < n_structures; ++i) {
+    Configuration const &configuration = configurations[i];
+    auto const &supercell = *configuration.supercell;
+    auto const &converter = supercell.unitcellcoord_index_converter;
+    auto const &dof_values = configuration.dof_values;
+
+    auto it = ideal_coords.find(&supercell);
+    if (it == ideal_coords.end()) {
+      it = ideal_coords
+               .emplace(&supercell, make_ideal_site_coordinates(supercell))
+               .first;
+    }
+    Eigen::MatrixXd const &R = it->second;
+
+    Eigen::Matrix3d F = Eigen::Matrix3d::Identity();
+    if (has_strain) {
+      F = strain_converter->to_F(
+          dof_values.global_dof_values.at(strain_dof_key));
+    }
+    structures.lat_column_mat.middleCols(3 * i, 3) =
+        F * supercell.superlattice.superlattice().lat_column_mat();
+
+    Eigen::MatrixXd disp;
+    if (has_disp) {
+      Index N_unitcells = supercell.unitcell_index_converter.total_sites();
+      disp = clexulator::local_to_standard_values(
+          dof_values.local_dof_values.at("disp"), N_sublat, N_unitcells,
+          prim.local_dof_info.at("disp"));
+    }
+
+    Index k = structures.atom_offsets(i);
+    Eigen::VectorXi const &occupation = dof_values.occupation;
+    for (Index l = 0; l < occupation.size(); ++l) {
+      int type = atom_type_index[converter(l).sublattice()][occupation(l)];
+      if (type == -1) {
+        continue;
+      }
+      structures.atom_type(k) = type;
+      if (has_disp) {
+        structures.coords.col(k).noalias() = F * (R.col(l) + disp.col(l));
+      } else {
+        structures.coords.col(k).noalias() = F * R.col(l);
+      }
+      ++k;
+    }
+  }
+  return structures;
+}
+
 }  // namespace config
 }  // namespace CASM
@@ -0,0 +1,172 @@
+#include "casm/configuration/memory_usage.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "casm/configuration/CanonicalPrimitiveCache.hh"
+#include "casm/configuration/MatrixRepCache.hh"
+#include "casm/configuration/PrimSymInfoCache.hh"
+#include "casm/configuration/SupercellSymInfo.hh"
+#include "casm/configuration/clusterography/OrbitCache.hh"
+#include "casm/configuration/group/Group.hh"
+#include "casm/crystallography/SymType.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// \brief The memory budget, in bytes, or -1 for no budget
+std::atomic<Index> &memory_budget_bytes() {
+  static std::atomic<Index> budget(-1);
+  return budget;
+}
+
+/// \brief Held while evicting, so that one thread evicts at a time
+std::mutex &enforce_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+}  // namespace
+
+/// \brief Memory used by a symmetry group, in bytes (approximate)
+///
+/// Counts the elements, the multiplication table, and the head group and
+/// inverse indices.
+Index memory_bytes(SymGroup const &group) {
+  Index n = group.element.size();
+  return sizeof(SymGroup) + n * sizeof(SymOp) +
+         n * (sizeof(std::vector<Index>) + n * sizeof(Index)) +
+         group.head_group_index.size() * sizeof(Index) +
+         group.inverse_index.size() * sizeof(Index);
+}
+
+/// \brief Total of all categories
+Index MemoryUsage::total_bytes() const {
+  return supercell_sym_info_bytes + combined_permutation_table_bytes +
+         matrix_rep_cache_bytes + canonical_primitive_cache_bytes +
+         orbit_cache_bytes + prim_sym_info_cache_bytes;
+}
+
+/// \brief Return the memory used by process-wide symmetry tables and
+///     caches
+///
+/// Thread safe. Each category is read under its own lock, so the total is
+/// not an atomic snapshot if other threads are using the caches.
+MemoryUsage memory_usage() {
+  MemoryUsage usage;
+  usage.supercell_sym_info_bytes = supercell_sym_info_total_bytes();
+  usage.combined_permutation_table_bytes =
+      combined_permutation_table_total_bytes();
+  usage.matrix_rep_cache_bytes = default_matrix_rep_cache().total_bytes();
+  usage.canonical_primitive_cache_bytes =
+      default_canonical_primitive_cache().total_bytes();
+  usage.orbit_cache_bytes = clust::default_orbit_cache().total_bytes();
+  usage.prim_sym_info_cache_bytes =
+      default_prim_sym_info_cache().total_bytes();
+  return usage;
+}
+
+/// \brief Set the process-wide memory budget, in bytes, or std::nullopt
+///     for no budget
+///
+/// The budget applies to `memory_usage().total_bytes()`. While it is set:
+/// - After a value is added to the combined permutation table cache,
+///   `default_matrix_rep_cache()`, `default_canonical_primitive_cache()`,
+///   or `clust::default_orbit_cache()`, `enforce_memory_budget()` evicts
+///   cached values.
+/// - A new SupercellSymInfo does not store `translation_permutations`
+///   unless `memory_budget_allows` their size, and uses the compact
+///   `translation_table` instead.
+///
+/// Symmetry tables of existing supercells and PrimSymInfo are in use
+/// without locking, so they are never released by the budget, and usage
+/// may stay above the budget if they alone exceed it. Setting a budget
+/// evicts cached values immediately, as by `enforce_memory_budget()`.
+///
+/// \param max_bytes The maximum memory, in bytes, or std::nullopt for no
+///     budget (default)
+void set_memory_budget(std::optional<Index> max_bytes) {
+  memory_budget_bytes() =
+      max_bytes.has_value() ? std::max(*max_bytes, Index(0)) : Index(-1);
+  enforce_memory_budget();
+}
+
+/// \brief The process-wide memory budget, in bytes, or std::nullopt if
+///     there is no budget
+std::optional<Index> memory_budget() {
+  Index budget = memory_budget_bytes();
+  if (budget < 0) {
+    return std::nullopt;
+  }
+  return budget;
+}
+
+/// \brief Evict cached values until `memory_usage().total_bytes() +
+///     reserve_bytes` is within the memory budget
+///
+/// Cached values are evicted in order of increasing cost to re-create,
+/// until usage is within the budget:
+/// 1. Combined permutation tables, least recently used first
+/// 2. Matrix representations, least recently used first
+/// 3. Canonical primitive configurations, least recently used first
+/// 4. Orbits, all at once, since OrbitCache does not track use
+///
+/// Held values remain valid after eviction. Does nothing if there is no
+/// budget, or if another thread is evicting.
+///
+/// \returns The memory used by evicted values, in bytes
+Index enforce_memory_budget(Index reserve_bytes) {
+  Index budget = memory_budget_bytes();
+  if (budget < 0) {
+    return 0;
+  }
+  std::unique_lock<std::mutex> lock(enforce_mutex(), std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return 0;
+  }
+  MemoryUsage usage = memory_usage();
+  Index excess = usage.total_bytes() + reserve_bytes - budget;
+  Index evicted = 0;
+  auto evict = [&](Index cache_bytes, auto &&evict_to) {
+    if (excess <= 0 || cache_bytes <= 0) {
+      return;
+    }
+    Index n = evict_to(std::max(cache_bytes - excess, Index(0)));
+    excess -= n;
+    evicted += n;
+  };
+  evict(usage.combined_permutation_table_bytes, [](Index max_total_bytes) {
+    return evict_combined_permutation_tables(max_total_bytes);
+  });
+  evict(usage.matrix_rep_cache_bytes, [](Index max_total_bytes) {
+    return default_matrix_rep_cache().evict_to(max_total_bytes);
+  });
+  evict(usage.canonical_primitive_cache_bytes, [](Index max_total_bytes) {
+    return default_canonical_primitive_cache().evict_to(max_total_bytes);
+  });
+  evict(usage.orbit_cache_bytes, [](Index) {
+    Index bytes = clust::default_orbit_cache().total_bytes();
+    clust::default_orbit_cache().clear();
+    return bytes;
+  });
+  return evicted;
+}
+
+/// \brief Return true if `n_bytes` more may be used within the memory
+///     budget, after evicting cached values if necessary
+///
+/// Always true if there is no budget.
+bool memory_budget_allows(Index n_bytes) {
+  Index budget = memory_budget_bytes();
+  if (budget < 0) {
+    return true;
+  }
+  enforce_memory_budget(n_bytes);
+  return memory_usage().total_bytes() + n_bytes <= budget;
+}
+
+}  // namespace config
+}  // namespace CASM
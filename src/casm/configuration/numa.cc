@@ -0,0 +1,174 @@
+#include "casm/configuration/numa.hh"
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "casm/configuration/Supercell.hh"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace CASM {
+namespace config {
+
+namespace {  // anonymous
+
+/// \brief NUMA node of each CPU
+struct NumaTopology {
+  /// Number of NUMA nodes, at least 1
+  Index n_nodes = 1;
+
+  /// Node index, in `[0, n_nodes)`, by CPU index. CPUs not listed are on
+  /// node 0.
+  std::vector<Index> cpu_node;
+};
+
+/// \brief Parse a Linux sysfs index list, such as "0-3,8-11", else return
+///     an empty vector
+std::vector<Index> parse_index_list(std::string const &list) {
+  std::vector<Index> result;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty() || range == "\n") {
+      continue;
+    }
+    std::size_t dash = range.find('-');
+    try {
+      Index first = std::stol(range.substr(0, dash));
+      Index last =
+          dash == std::string::npos ? first : std::stol(range.substr(dash + 1));
+      for (Index i = first; i <= last; ++i) {
+        result.push_back(i);
+      }
+    } catch (std::exception const &) {
+      return {};
+    }
+  }
+  return result;
+}
+
+/// \brief Read the first line of a file, else return an empty string
+std::string read_first_line(std::string const &path) {
+  std::ifstream in(path);
+  std::string line;
+  std::getline(in, line);
+  return line;
+}
+
+/// \brief Read the NUMA topology from sysfs, on Linux
+///
+/// Nodes are numbered in the order listed by
+/// `/sys/devices/system/node/online`, which may differ from the kernel
+/// node numbers if some are offline.
+NumaTopology make_numa_topology() {
+  NumaTopology topology;
+#ifdef __linux__
+  std::string const root = "/sys/devices/system/node/";
+  std::vector<Index> nodes = parse_index_list(read_first_line(root + "online"));
+  if (nodes.size() <= 1) {
+    return topology;
+  }
+  for (Index n = 0; n < nodes.size(); ++n) {
+    std::vector<Index> cpus = parse_index_list(read_first_line(
+        root + "node" + std::to_string(nodes[n]) + "/cpulist"));
+    for (Index cpu : cpus) {
+      if (cpu >= topology.cpu_node.size()) {
+        topology.cpu_node.resize(cpu + 1, 0);
+      }
+      topology.cpu_node[cpu] = n;
+    }
+  }
+  topology.n_nodes = nodes.size();
+#endif
+  return topology;
+}
+
+NumaTopology const &numa_topology() {
+  static NumaTopology const topology = make_numa_topology();
+  return topology;
+}
+
+std::atomic<bool> &numa_replication_enabled() {
+  static std::atomic<bool> enabled{false};
+  return enabled;
+}
+
+}  // namespace
+
+/// \brief Return the number of NUMA nodes
+///
+/// Read once from `/sys/devices/system/node` on Linux. Returns 1 on other
+/// platforms, or if the topology is not available.
+Index numa_node_count() { return numa_topology().n_nodes; }
+
+/// \brief Return the NUMA node of the CPU running the calling thread
+///
+/// \returns A node index in `[0, numa_node_count())`. Threads are not
+///     pinned, so the result may change if the thread is migrated. Returns
+///     0 if there is only one node or the CPU is not known.
+Index current_numa_node() {
+  NumaTopology const &topology = numa_topology();
+  if (topology.n_nodes <= 1) {
+    return 0;
+  }
+#ifdef __linux__
+  int cpu = sched_getcpu();
+  if (cpu >= 0 && cpu < topology.cpu_node.size()) {
+    return topology.cpu_node[cpu];
+  }
+#endif
+  return 0;
+}
+
+/// \brief Set whether supercell symmetry tables are replicated per NUMA
+///     node
+///
+/// On multi-socket machines, threads reading symmetry tables allocated on
+/// another socket's memory are limited by cross-socket latency. While
+/// enabled, the parallel canonical form functions (`make_canonical_forms`,
+/// including for ConfigurationBatch) use `local_supercell` in each chunk,
+/// so each thread reads factor group permutations, translation
+/// permutations, and the combined permutation table from a copy on its own
+/// node.
+///
+/// Replication is off by default. It has no effect if there is only one
+/// NUMA node. Replicas are kept for the lifetime of the supercell and are
+/// counted by `Supercell::memory_bytes()` and `memory_usage()`.
+void set_numa_replication_enabled(bool enabled) {
+  numa_replication_enabled() = enabled;
+}
+
+/// \brief Return true if supercell symmetry tables are replicated per NUMA
+///     node
+bool numa_replication_is_enabled() { return numa_replication_enabled(); }
+
+/// \brief Return the supercell, or a replica with symmetry tables local to
+///     the NUMA node of the calling thread
+///
+/// \param supercell A supercell
+///
+/// \returns `supercell` if replication is disabled, there is only one NUMA
+///     node, the calling thread is on the node where `supercell->sym_info()`
+///     was constructed, or the memory budget does not allow a replica.
+///     Otherwise, returns `supercell->numa_replica(current_numa_node())`.
+///
+/// The result compares equal to `supercell`, and its operations may be
+/// applied to configurations in `supercell`. Call once per chunk of work,
+/// not once per configuration.
+std::shared_ptr<Supercell const> local_supercell(
+    std::shared_ptr<Supercell const> const &supercell) {
+  if (!numa_replication_is_enabled() || numa_node_count() <= 1) {
+    return supercell;
+  }
+  std::shared_ptr<Supercell const> replica =
+      supercell->numa_replica(current_numa_node());
+  return replica ? replica : supercell;
+}
+
+}  // namespace config
+}  // namespace CASM
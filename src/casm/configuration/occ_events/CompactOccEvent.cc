@@ -0,0 +1,227 @@
+#include "casm/configuration/occ_events/CompactOccEvent.hh"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "casm/configuration/occ_events/OccEvent.hh"
+#include "casm/configuration/occ_events/OccPosition.hh"
+#include "casm/configuration/occ_events/OccTrajectory.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+
+namespace CASM {
+namespace occ_events {
+
+namespace {  // anonymous
+
+/// \brief Convert to int32, throwing if the value does not fit
+std::int32_t to_int32(long value) {
+  if (value < std::numeric_limits<std::int32_t>::min() ||
+      value > std::numeric_limits<std::int32_t>::max()) {
+    throw std::runtime_error(
+        "Error in CompactOccEvent: index value does not fit in int32");
+  }
+  return static_cast<std::int32_t>(value);
+}
+
+/// \brief Combine a value into an FNV-1a hash
+void hash_combine(std::uint64_t &hash, std::uint64_t value) {
+  std::uint64_t const fnv_prime = 1099511628211ULL;
+  for (int i = 0; i < 8; ++i) {
+    hash ^= (value >> (8 * i)) & 0xff;
+    hash *= fnv_prime;
+  }
+}
+
+/// \brief Append packed OccPosition values
+void append_position(std::vector<std::int32_t> &data, OccPosition const &pos) {
+  data.push_back(2 * pos.is_in_resevoir + pos.is_atom);
+  if (pos.is_in_resevoir) {
+    data.insert(data.end(), {0, 0, 0, 0});
+  } else {
+    xtal::UnitCellCoord const &site = pos.integral_site_coordinate;
+    data.push_back(to_int32(site.unitcell()(0)));
+    data.push_back(to_int32(site.unitcell()(1)));
+    data.push_back(to_int32(site.unitcell()(2)));
+    data.push_back(to_int32(site.sublattice()));
+  }
+  data.push_back(to_int32(pos.occupant_index));
+  if (pos.is_atom && !pos.is_in_resevoir) {
+    data.push_back(to_int32(pos.atom_position_index));
+  } else {
+    data.push_back(0);
+  }
+}
+
+/// \brief Make OccPosition from packed values
+OccPosition make_position(std::int32_t const *value) {
+  bool is_in_resevoir = value[0] >= 2;
+  bool is_atom = value[0] % 2;
+  if (is_in_resevoir) {
+    if (is_atom) {
+      return OccPosition::atom_in_resevoir(value[5]);
+    }
+    return OccPosition::molecule_in_resevoir(value[5]);
+  }
+  xtal::UnitCellCoord site(value[4], value[1], value[2], value[3]);
+  if (is_atom) {
+    return OccPosition::atom(site, value[5], value[6]);
+  }
+  return OccPosition::molecule(site, value[5]);
+}
+
+/// \brief Translate each position not in the resevoir
+void translate(std::vector<std::int32_t> &data, xtal::UnitCell const &trans,
+               long sign) {
+  Index w = CompactOccEvent::position_width;
+  Index offset = 1;
+  for (Index t = 0; t < data[0]; ++t) {
+    Index n_positions = data[offset++];
+    for (Index p = 0; p < n_positions; ++p) {
+      std::int32_t *value = data.data() + offset;
+      if (value[0] < 2) {
+        for (Index j = 0; j < 3; ++j) {
+          value[1 + j] = to_int32(value[1 + j] + sign * trans(j));
+        }
+      }
+      offset += w;
+    }
+  }
+}
+
+}  // namespace
+
+/// \brief Construct an empty event
+CompactOccEvent::CompactOccEvent() : m_data({0}) {}
+
+/// \brief Construct from an OccEvent
+///
+/// Throws if a unit cell, sublattice, occupant, or atom position index
+/// does not fit in int32.
+CompactOccEvent::CompactOccEvent(OccEvent const &occ_event) {
+  Index n_values = 1;
+  for (auto const &traj : occ_event) {
+    n_values += 1 + position_width * traj.position.size();
+  }
+  m_data.reserve(n_values);
+  m_data.push_back(to_int32(occ_event.size()));
+  for (auto const &traj : occ_event) {
+    m_data.push_back(to_int32(traj.position.size()));
+    for (auto const &pos : traj.position) {
+      append_position(m_data, pos);
+    }
+  }
+}
+
+/// \brief Construct from packed values
+///
+/// Throws if `data` does not have the layout of a CompactOccEvent, as
+/// returned by `data()`.
+CompactOccEvent::CompactOccEvent(std::vector<std::int32_t> data)
+    : m_data(std::move(data)) {
+  auto _invalid = []() {
+    return std::runtime_error(
+        "Error in CompactOccEvent: invalid packed values");
+  };
+  if (m_data.empty() || m_data[0] < 0) {
+    throw _invalid();
+  }
+  Index offset = 1;
+  for (Index t = 0; t < m_data[0]; ++t) {
+    if (offset >= m_data.size() || m_data[offset] < 0) {
+      throw _invalid();
+    }
+    Index n_positions = m_data[offset++];
+    if (m_data.size() - offset < position_width * n_positions) {
+      throw _invalid();
+    }
+    for (Index p = 0; p < n_positions; ++p) {
+      if (m_data[offset] < 0 || m_data[offset] > 3) {
+        throw _invalid();
+      }
+      offset += position_width;
+    }
+  }
+  if (offset != m_data.size()) {
+    throw _invalid();
+  }
+}
+
+/// \brief Convert to OccEvent
+OccEvent CompactOccEvent::to_occevent() const {
+  std::vector<OccTrajectory> trajectories;
+  trajectories.reserve(size());
+  Index offset = 1;
+  for (Index t = 0; t < size(); ++t) {
+    Index n_positions = m_data[offset++];
+    std::vector<OccPosition> position;
+    position.reserve(n_positions);
+    for (Index p = 0; p < n_positions; ++p) {
+      position.push_back(make_position(m_data.data() + offset));
+      offset += position_width;
+    }
+    trajectories.emplace_back(std::move(position));
+  }
+  return OccEvent(std::move(trajectories));
+}
+
+/// \brief Translate the event by a UnitCell translation
+CompactOccEvent &CompactOccEvent::operator+=(xtal::UnitCell const &trans) {
+  translate(m_data, trans, 1);
+  return *this;
+}
+
+/// \brief Translate the event by a UnitCell translation
+CompactOccEvent &CompactOccEvent::operator-=(xtal::UnitCell const &trans) {
+  translate(m_data, trans, -1);
+  return *this;
+}
+
+/// \brief Compare as OccEvent
+///
+/// The number of trajectories and the number of positions in each
+/// trajectory precede the values they count, and the position values are
+/// ordered as compared by OccPosition::operator<, so lexicographical
+/// comparison of the packed values is the same as OccEvent comparison.
+bool CompactOccEvent::operator<(CompactOccEvent const &B) const {
+  return std::lexicographical_compare(m_data.begin(), m_data.end(),
+                                      B.m_data.begin(), B.m_data.end());
+}
+
+bool CompactOccEvent::eq_impl(CompactOccEvent const &B) const {
+  return m_data == B.m_data;
+}
+
+std::size_t CompactOccEventHash::operator()(
+    CompactOccEvent const &occ_event) const {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (std::int32_t value : occ_event.data()) {
+    hash_combine(hash, static_cast<std::uint32_t>(value));
+  }
+  return hash;
+}
+
+/// \brief Convert OccEvent to CompactOccEvent
+std::vector<CompactOccEvent> make_compact_occevents(
+    std::vector<OccEvent> const &occ_events) {
+  std::vector<CompactOccEvent> compact_occ_events;
+  compact_occ_events.reserve(occ_events.size());
+  for (auto const &occ_event : occ_events) {
+    compact_occ_events.emplace_back(occ_event);
+  }
+  return compact_occ_events;
+}
+
+/// \brief Convert CompactOccEvent to OccEvent
+std::vector<OccEvent> make_occevents(
+    std::vector<CompactOccEvent> const &compact_occ_events) {
+  std::vector<OccEvent> occ_events;
+  occ_events.reserve(compact_occ_events.size());
+  for (auto const &compact_occ_event : compact_occ_events) {
+    occ_events.push_back(compact_occ_event.to_occevent());
+  }
+  return occ_events;
+}
+
+}  // namespace occ_events
+}  // namespace CASM
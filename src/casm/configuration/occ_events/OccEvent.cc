@@ -1,5 +1,7 @@
 #include "casm/configuration/occ_events/OccEvent.hh"
 
+#include <cstdint>
+
 #include "casm/configuration/clusterography/IntegralCluster.hh"
 #include "casm/configuration/occ_events/OccEventRep.hh"
 #include "casm/configuration/occ_events/OccPosition.hh"
@@ -10,6 +12,19 @@
 namespace CASM {
 namespace occ_events {
 
+namespace {  // anonymous
+
+/// \brief Combine a value into an FNV-1a hash
+void hash_combine(std::uint64_t &hash, std::uint64_t value) {
+  std::uint64_t const fnv_prime = 1099511628211ULL;
+  for (int i = 0; i < 8; ++i) {
+    hash ^= (value >> (8 * i)) & 0xff;
+    hash *= fnv_prime;
+  }
+}
+
+}  // namespace
+
 OccEvent::OccEvent() {}
 
 OccEvent::OccEvent(std::initializer_list<OccTrajectory> elements)
@@ -221,5 +236,35 @@ OccEvent copy_apply(OccEventRep const &rep, OccEvent occ_event) {
   return occ_event;
 }
 
+/// \brief Hash OccEvent, consistent with OccEvent equality
+///
+/// Only the OccPosition values that are compared by OccPosition::operator<
+/// are included: the site and atom position index are skipped for positions
+/// in the resevoir, and the atom position index is skipped for molecules.
+std::size_t OccEventHash::operator()(OccEvent const &occ_event) const {
+  std::uint64_t hash = 14695981039346656037ULL;
+  hash_combine(hash, occ_event.size());
+  for (auto const &traj : occ_event) {
+    hash_combine(hash, traj.position.size());
+    for (auto const &pos : traj.position) {
+      hash_combine(hash, pos.is_in_resevoir);
+      hash_combine(hash, pos.is_atom);
+      hash_combine(hash, pos.occupant_index);
+      if (pos.is_in_resevoir) {
+        continue;
+      }
+      xtal::UnitCellCoord const &site = pos.integral_site_coordinate;
+      hash_combine(hash, site.sublattice());
+      hash_combine(hash, site.unitcell()(0));
+      hash_combine(hash, site.unitcell()(1));
+      hash_combine(hash, site.unitcell()(2));
+      if (pos.is_atom) {
+        hash_combine(hash, pos.atom_position_index);
+      }
+    }
+  }
+  return hash;
+}
+
 }  // namespace occ_events
 }  // namespace CASM
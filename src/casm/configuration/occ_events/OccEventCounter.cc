@@ -1,5 +1,11 @@
 #include "casm/configuration/occ_events/OccEventCounter.hh"
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <tuple>
+
+#include "casm/configuration/group/Group.hh"
 #include "casm/crystallography/BasicStructure.hh"
 
 namespace CASM {
@@ -7,6 +13,239 @@ namespace occ_events {
 
 namespace {
 
+/// \brief Type of count used to bound cluster occupations
+enum class OccCountType { atom, molecule, orientation };
+
+/// \brief Return `site_count[i][occ]`, the count of type `count_type`
+///     contributed by occupant `occ` on site `i` of `cluster`
+std::vector<std::vector<Eigen::VectorXi>> make_site_counts(
+    OccSystem const &system, clust::IntegralCluster const &cluster,
+    OccCountType count_type) {
+  std::vector<std::vector<Eigen::VectorXi>> site_count;
+  for (auto const &site : cluster) {
+    clust::IntegralCluster site_cluster({site});
+    int n_occupants =
+        system.prim->basis()[site.sublattice()].occupant_dof().size();
+    std::vector<Eigen::VectorXi> occupant_count(n_occupants);
+    for (int occ = 0; occ < n_occupants; ++occ) {
+      std::vector<int> site_occ({occ});
+      if (count_type == OccCountType::atom) {
+        system.atom_count(occupant_count[occ], site_cluster, site_occ);
+      } else if (count_type == OccCountType::molecule) {
+        system.molecule_count(occupant_count[occ], site_cluster, site_occ);
+      } else {
+        system.orientation_count(occupant_count[occ], site_cluster, site_occ);
+      }
+    }
+    site_count.push_back(std::move(occupant_count));
+  }
+  return site_count;
+}
+
+/// \brief Bounds the count of a partially assigned cluster occupation
+///
+/// Cluster occupations are assigned from the last site to the first, so
+/// that the first site varies fastest, as with the occupation Counter.
+/// Given the count on assigned sites `[i, n)`, the count of any complete
+/// occupation lies within `count + lower(i)` and `count + upper(i)`, where
+/// `lower(i)` and `upper(i)` are the minimum and maximum count possible on
+/// unassigned sites `[0, i)`. This allows skipping every completion of a
+/// partial occupation that cannot satisfy the count criteria.
+///
+/// Criteria with a size that does not match the count are ignored here,
+/// and left to be reported by the complete occupation checks.
+class OccCountBounds {
+ public:
+  OccCountBounds(std::vector<std::vector<Eigen::VectorXi>> site_count,
+                 std::optional<Eigen::VectorXi> const &required_count,
+                 std::optional<Eigen::VectorXi> const &min_count,
+                 std::optional<Eigen::VectorXi> const &max_count)
+      : m_site_count(std::move(site_count)), m_is_active(false) {
+    if (m_site_count.empty()) {
+      return;
+    }
+    Index n_types = m_site_count[0][0].size();
+    m_min = Eigen::VectorXi::Constant(n_types,
+                                      std::numeric_limits<int>::min());
+    m_max = Eigen::VectorXi::Constant(n_types,
+                                      std::numeric_limits<int>::max());
+    auto _apply_min = [&](std::optional<Eigen::VectorXi> const &count) {
+      if (count.has_value() && count->size() == n_types) {
+        m_min = m_min.cwiseMax(*count);
+        m_is_active = true;
+      }
+    };
+    auto _apply_max = [&](std::optional<Eigen::VectorXi> const &count) {
+      if (count.has_value() && count->size() == n_types) {
+        m_max = m_max.cwiseMin(*count);
+        m_is_active = true;
+      }
+    };
+    _apply_min(required_count);
+    _apply_max(required_count);
+    _apply_min(min_count);
+    _apply_max(max_count);
+
+    m_lower.push_back(Eigen::VectorXi::Zero(n_types));
+    m_upper.push_back(Eigen::VectorXi::Zero(n_types));
+    for (auto const &occupant_count : m_site_count) {
+      Eigen::VectorXi site_min = occupant_count[0];
+      Eigen::VectorXi site_max = occupant_count[0];
+      for (auto const &count : occupant_count) {
+        site_min = site_min.cwiseMin(count);
+        site_max = site_max.cwiseMax(count);
+      }
+      m_lower.push_back(m_lower.back() + site_min);
+      m_upper.push_back(m_upper.back() + site_max);
+    }
+  }
+
+  /// \brief Return true if there are any criteria to bound
+  bool is_active() const { return m_is_active; }
+
+  /// \brief Number of count types
+  Index n_types() const { return m_min.size(); }
+
+  /// \brief Count contributed by occupant `occ` on site `i`
+  Eigen::VectorXi const &site_count(Index i, int occ) const {
+    return m_site_count[i][occ];
+  }
+
+  /// \brief Return true if no occupation of sites `[0, i)` can complete
+  ///     `count`, the count on sites `[i, n)`, to satisfy the criteria
+  bool cannot_satisfy(Eigen::VectorXi const &count, Index i) const {
+    for (Index t = 0; t < count.size(); ++t) {
+      if (count(t) + m_lower[i](t) > m_max(t) ||
+          count(t) + m_upper[i](t) < m_min(t)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  std::vector<std::vector<Eigen::VectorXi>> m_site_count;
+  bool m_is_active;
+  Eigen::VectorXi m_min;
+  Eigen::VectorXi m_max;
+  std::vector<Eigen::VectorXi> m_lower;
+  std::vector<Eigen::VectorXi> m_upper;
+};
+
+/// \brief Append each completion of `occ` on sites `[0, i)` which may
+///     satisfy all `bounds`, in Counter order
+void append_occ_candidates(std::vector<std::vector<int>> &candidates,
+                           std::vector<int> &occ,
+                           std::vector<Eigen::VectorXi> &count,
+                           std::vector<int> const &max_occupant_index,
+                           std::vector<OccCountBounds> const &bounds,
+                           Index i) {
+  for (Index k = 0; k < bounds.size(); ++k) {
+    if (bounds[k].cannot_satisfy(count[k], i)) {
+      return;
+    }
+  }
+  if (i == 0) {
+    candidates.push_back(occ);
+    return;
+  }
+  for (int value = 0; value <= max_occupant_index[i - 1]; ++value) {
+    occ[i - 1] = value;
+    for (Index k = 0; k < bounds.size(); ++k) {
+      count[k] += bounds[k].site_count(i - 1, value);
+    }
+    append_occ_candidates(candidates, occ, count, max_occupant_index, bounds,
+                          i - 1);
+    for (Index k = 0; k < bounds.size(); ++k) {
+      count[k] -= bounds[k].site_count(i - 1, value);
+    }
+  }
+}
+
+/// \brief Make cluster occupations which may satisfy all `bounds`
+///
+/// Occupations are in the same order as generated by
+/// `make_occ_counter(cluster, prim)`. Inactive bounds are ignored.
+std::vector<std::vector<int>> make_occ_candidates(
+    clust::IntegralCluster const &cluster, xtal::BasicStructure const &prim,
+    std::vector<OccCountBounds> const &bounds) {
+  std::vector<int> max_occupant_index;
+  for (auto const &site : cluster) {
+    Index b = site.sublattice();
+    max_occupant_index.push_back(prim.basis()[b].occupant_dof().size() - 1);
+  }
+  std::vector<OccCountBounds> active_bounds;
+  std::vector<Eigen::VectorXi> count;
+  for (auto const &bound : bounds) {
+    if (bound.is_active()) {
+      active_bounds.push_back(bound);
+      count.push_back(Eigen::VectorXi::Zero(bound.n_types()));
+    }
+  }
+  std::vector<std::vector<int>> candidates;
+  std::vector<int> occ(cluster.size(), 0);
+  append_occ_candidates(candidates, occ, count, max_occupant_index,
+                        active_bounds, cluster.size());
+  return candidates;
+}
+
+/// \brief Make cluster occupations which are canonical under a cluster
+///     group and satisfy all `bounds`
+///
+/// Occupations are in the same order as generated by
+/// `make_occ_counter(cluster, prim)`. Inactive bounds are ignored.
+std::vector<std::vector<int>> make_canonical_occ_candidates(
+    clust::IntegralCluster const &cluster, xtal::BasicStructure const &prim,
+    std::vector<clust::ClusterOccSymOpRep> const &cluster_occ_symgroup_rep,
+    std::vector<OccCountBounds> const &bounds) {
+  clust::CanonicalOccCounter counter(cluster, prim, cluster_occ_symgroup_rep);
+  std::vector<std::vector<int>> candidates;
+  for (auto const &occ : counter.values()) {
+    bool is_candidate = true;
+    for (auto const &bound : bounds) {
+      if (!bound.is_active()) {
+        continue;
+      }
+      Eigen::VectorXi count = Eigen::VectorXi::Zero(bound.n_types());
+      for (Index i = 0; i < occ.size(); ++i) {
+        count += bound.site_count(i, occ[i]);
+      }
+      if (bound.cannot_satisfy(count, 0)) {
+        is_candidate = false;
+        break;
+      }
+    }
+    if (is_candidate) {
+      candidates.push_back(occ);
+    }
+  }
+  return candidates;
+}
+
+/// \brief Return true if the events generated with `params` are
+///     invariant under cluster groups
+///
+/// Atom and molecule counts, and the built-in trajectory checks, are
+/// invariant under symmetry. Required occupations, orientation counts, and
+/// custom filters may not be.
+bool is_cluster_group_invariant(OccEventCounterParameters const &params) {
+  return !params.required_occ_init.has_value() &&
+         !params.required_occ_final.has_value() &&
+         !params.min_init_orientation_count.has_value() &&
+         !params.max_init_orientation_count.has_value() &&
+         !params.required_init_orientation_count.has_value() &&
+         !params.min_final_orientation_count.has_value() &&
+         !params.max_final_orientation_count.has_value() &&
+         !params.required_final_orientation_count.has_value() &&
+         !params.cluster_filter && !params.occ_init_filter &&
+         !params.occ_final_filter && !params.trajectory_filter;
+}
+
+/// \brief Make a Counter with the single value `occ`
+Counter<std::vector<int>> make_single_occ_counter(std::vector<int> const &occ) {
+  return Counter<std::vector<int>>(occ, occ, std::vector<int>(occ.size(), 1));
+}
+
 /// \brief Outer-most step: iterate over cluster prototypes
 class PrototypeClusterCounter : public SingleStepBase<OccEventCounterData> {
  public:
@@ -146,14 +385,24 @@ class PrototypeClusterCounter : public SingleStepBase<OccEventCounterData> {
     return false;
   }
 
-  /// \brief Initialize `prototype_index=0` and set `cluster`
+  /// \brief Initialize `prototype_index=begin_prototype_index` and set
+  ///     `cluster`
   void initialize() const override {
-    data()->prototype_index = 0;
-    if (!data()->prototypes.size()) {
+    data()->prototype_index = data()->begin_prototype_index;
+    if (is_finished()) {
       return;
     }
     data()->cluster = data()->prototypes[data()->prototype_index];
   }
+
+  /// \brief Copy this step, in its current state, with access to other
+  ///     shared data
+  std::unique_ptr<SingleStepBase<OccEventCounterData>> clone(
+      std::shared_ptr<OccEventCounterData> _data) const override {
+    auto step = std::make_unique<PrototypeClusterCounter>(*this);
+    step->data() = _data;
+    return step;
+  }
 };
 
 /// \brief Iterate over initial cluster occupation
@@ -163,11 +412,22 @@ class OccInitCounter : public SingleStepBase<OccEventCounterData> {
       : SingleStepBase<OccEventCounterData>(_data) {}
 
   /// \brief Advance state, return true if post-state is valid / not finished
-  bool advance() override { return ++data()->occ_init_counter; }
+  bool advance() override {
+    if (is_finished()) {
+      return false;
+    }
+    ++m_candidate_index;
+    if (is_finished()) {
+      return false;
+    }
+    data()->occ_init_counter =
+        make_single_occ_counter(m_candidates[m_candidate_index]);
+    return true;
+  }
 
   /// \brief Return true if in invalid / finished state
   bool is_finished() const override {
-    return !data()->occ_init_counter.valid();
+    return m_candidate_index >= m_candidates.size();
   }
 
   /// \brief Return true if in a not-finished && allowed state
@@ -430,15 +690,65 @@ class OccInitCounter : public SingleStepBase<OccEventCounterData> {
   }
 
   /// \brief Initialize `occ_init_counter` for current cluster
+  ///
+  /// Initial occupations which cannot satisfy the atom, molecule, and
+  /// orientation count criteria are skipped without being checked
+  /// individually, unless state info is being printed or saved. If
+  /// `cluster_occ_symgroup_reps` is not empty, only initial occupations
+  /// which are canonical under the cluster group are generated.
   void initialize() const override {
-    data()->occ_init_counter =
-        make_occ_counter(data()->cluster, *data()->system->prim);
+    OccSystem const &system = *data()->system;
+    clust::IntegralCluster const &cluster = data()->cluster;
+    OccEventCounterParameters const &params = data()->params;
+    std::vector<OccCountBounds> bounds;
+    if (!params.print_state_info && !params.save_state_info) {
+      bounds.emplace_back(
+          make_site_counts(system, cluster, OccCountType::atom),
+          params.required_init_atom_count, params.min_init_atom_count,
+          params.max_init_atom_count);
+      bounds.emplace_back(
+          make_site_counts(system, cluster, OccCountType::molecule),
+          params.required_init_molecule_count,
+          params.min_init_molecule_count, params.max_init_molecule_count);
+      bounds.emplace_back(
+          make_site_counts(system, cluster, OccCountType::orientation),
+          params.required_init_orientation_count,
+          params.min_init_orientation_count,
+          params.max_init_orientation_count);
+    }
+    if (data()->cluster_occ_symgroup_reps.empty()) {
+      m_candidates = make_occ_candidates(cluster, *system.prim, bounds);
+    } else {
+      m_candidates = make_canonical_occ_candidates(
+          cluster, *system.prim,
+          data()->cluster_occ_symgroup_reps[data()->prototype_index], bounds);
+    }
+    m_candidate_index = 0;
+    if (!is_finished()) {
+      data()->occ_init_counter =
+          make_single_occ_counter(m_candidates[m_candidate_index]);
+    }
+  }
+
+  /// \brief Copy this step, in its current state, with access to other
+  ///     shared data
+  std::unique_ptr<SingleStepBase<OccEventCounterData>> clone(
+      std::shared_ptr<OccEventCounterData> _data) const override {
+    auto step = std::make_unique<OccInitCounter>(*this);
+    step->data() = _data;
+    return step;
   }
 
  private:
   /// \brief Temporary variable used for checking atom/molecule/orientation
   /// counts
   mutable Eigen::VectorXi m_count;
+
+  /// \brief Initial occupations which may satisfy the count criteria
+  mutable std::vector<std::vector<int>> m_candidates;
+
+  /// \brief Index into m_candidates of the current initial occupation
+  mutable Index m_candidate_index = 0;
 };
 
 /// \brief Iterate over final cluster occupation
@@ -448,11 +758,22 @@ class OccFinalCounter : public SingleStepBase<OccEventCounterData> {
       : SingleStepBase<OccEventCounterData>(_data) {}
 
   /// \brief Advance state, return true if post-state is not finished
-  bool advance() override { return ++data()->occ_final_counter; }
+  bool advance() override {
+    if (is_finished()) {
+      return false;
+    }
+    ++m_candidate_index;
+    if (is_finished()) {
+      return false;
+    }
+    data()->occ_final_counter =
+        make_single_occ_counter(m_candidates[m_candidate_index]);
+    return true;
+  }
 
   /// \brief Return true if in finished state
   bool is_finished() const override {
-    return !data()->occ_final_counter.valid();
+    return m_candidate_index >= m_candidates.size();
   }
 
   /// \brief Return true if in a not-finished && allowed state
@@ -579,11 +900,27 @@ class OccFinalCounter : public SingleStepBase<OccEventCounterData> {
 
   /// \brief Check if occ_final < occ_init to skip generating an event
   ///     and its reverse event (allow_reverse_occ)
+  ///
+  /// If initial occupations are reduced by cluster group, the event is
+  /// allowed if occ_final >= occ_init for any equivalent under the
+  /// cluster group, because the equivalents are not counted over.
   bool fails_allow_reverse_occ() const {
     if (data()->params.allow_reverse_occ == true) {
       return false;
     }
-    return data()->occ_final_counter() < data()->occ_init_counter();
+    std::vector<int> const &occ_init = data()->occ_init_counter();
+    std::vector<int> const &occ_final = data()->occ_final_counter();
+    if (data()->cluster_occ_symgroup_reps.empty()) {
+      return occ_final < occ_init;
+    }
+    for (auto const &op :
+         data()->cluster_occ_symgroup_reps[data()->prototype_index]) {
+      if (!(clust::copy_apply(op, occ_final) <
+            clust::copy_apply(op, occ_init))) {
+        return false;
+      }
+    }
+    return true;
   }
 
   /// \brief Check if initial and final cluster occupation
@@ -777,22 +1114,90 @@ class OccFinalCounter : public SingleStepBase<OccEventCounterData> {
   }
 
   /// \brief Initialize `occ_final_counter` for current cluster
+  ///
+  /// Final occupations which cannot satisfy the atom, molecule, and
+  /// orientation count criteria, including atom and molecule conservation,
+  /// are skipped without being checked individually, unless state info is
+  /// being printed or saved.
   void initialize() const override {
-    data()->occ_final_counter =
-        make_occ_counter(data()->cluster, *data()->system->prim);
+    OccSystem const &system = *data()->system;
+    clust::IntegralCluster const &cluster = data()->cluster;
+    OccEventCounterParameters const &params = data()->params;
+    std::vector<OccCountBounds> bounds;
+    if (!params.print_state_info && !params.save_state_info) {
+      bounds.emplace_back(
+          make_site_counts(system, cluster, OccCountType::atom),
+          params.required_final_atom_count, params.min_final_atom_count,
+          params.max_final_atom_count);
+      bounds.emplace_back(
+          make_site_counts(system, cluster, OccCountType::molecule),
+          params.required_final_molecule_count,
+          params.min_final_molecule_count, params.max_final_molecule_count);
+      bounds.emplace_back(
+          make_site_counts(system, cluster, OccCountType::orientation),
+          params.required_final_orientation_count,
+          params.min_final_orientation_count,
+          params.max_final_orientation_count);
+      if (params.require_atom_conservation) {
+        system.atom_count(m_count, cluster, data()->occ_init_counter());
+        bounds.emplace_back(
+            make_site_counts(system, cluster, OccCountType::atom), m_count,
+            std::nullopt, std::nullopt);
+      }
+      if (params.require_molecule_conservation) {
+        system.molecule_count(m_count, cluster, data()->occ_init_counter());
+        bounds.emplace_back(
+            make_site_counts(system, cluster, OccCountType::molecule),
+            m_count, std::nullopt, std::nullopt);
+      }
+    }
+    m_candidates = make_occ_candidates(cluster, *system.prim, bounds);
+    m_candidate_index = 0;
+    if (!is_finished()) {
+      data()->occ_final_counter =
+          make_single_occ_counter(m_candidates[m_candidate_index]);
+    }
+  }
+
+  /// \brief Copy this step, in its current state, with access to other
+  ///     shared data
+  std::unique_ptr<SingleStepBase<OccEventCounterData>> clone(
+      std::shared_ptr<OccEventCounterData> _data) const override {
+    auto step = std::make_unique<OccFinalCounter>(*this);
+    step->data() = _data;
+    return step;
   }
 
  private:
   /// \brief Temporary variable used for checking atom/molecule conservation
   mutable Eigen::VectorXi m_count;
+
+  /// \brief Final occupations which may satisfy the count criteria
+  mutable std::vector<std::vector<int>> m_candidates;
+
+  /// \brief Index into m_candidates of the current final occupation
+  mutable Index m_candidate_index = 0;
 };
 
 /// \brief Inner-most step: iterate over OccPosition permutations
+///
+/// The trajectory checks only compare positions by site, occupant, and
+/// atom position index, so whether a permutation of positions is allowed
+/// depends only on the cluster sublattices, `occ_init`, and `occ_final`,
+/// and not on the cluster geometry. If
+/// `params.memoize_trajectories` is true, and there is no
+/// `trajectory_filter` and no state info is requested, the allowed
+/// permutations are found once for each sublattice and occupation pattern
+/// and re-used on every cluster with the same pattern. The allowed
+/// trajectories are generated in the same order either way.
 class TrajectoryCounter : public SingleStepBase<OccEventCounterData> {
  public:
   TrajectoryCounter(std::shared_ptr<OccEventCounterData> _data)
       : SingleStepBase<OccEventCounterData>(_data) {
     data()->trajectory_finished = true;
+    auto const &params = data()->params;
+    m_memoize = params.memoize_trajectories && !params.trajectory_filter &&
+                !params.print_state_info && !params.save_state_info;
   }
 
   /// \brief Advance state, return true if post-state is not finished
@@ -800,15 +1205,22 @@ class TrajectoryCounter : public SingleStepBase<OccEventCounterData> {
   /// Notes:
   /// - Permutes `position_final` until no more permutations allowed
   bool advance() override {
+    if (m_memoize) {
+      ++m_trajectory_index;
+      if (m_trajectory_index < m_trajectories.size()) {
+        _set_trajectory();
+      } else {
+        _finish();
+      }
+      return !is_finished();
+    }
     bool valid = std::next_permutation(data()->position_final.begin(),
                                        data()->position_final.end());
     if (valid) {
       data()->occ_event =
           make_occevent(data()->position_init, data()->position_final);
     } else {
-      data()->position_init.clear();
-      data()->position_final.clear();
-      data()->trajectory_finished = true;
+      _finish();
     }
     return !is_finished();
   }
@@ -818,6 +1230,12 @@ class TrajectoryCounter : public SingleStepBase<OccEventCounterData> {
 
   /// \brief Return true if in a not-finished && allowed state
   bool is_allowed() const override {
+    // memoized trajectories were checked when they were memoized
+    return m_memoize || _check_trajectory();
+  }
+
+  /// \brief Check the current trajectory, recording state info
+  bool _check_trajectory() const {
     if (this->fails_require_chemical_type_conserving_trajectories()) {
       _fails("trajectory:require_chemical_type_conserving_trajectories");
       return false;
@@ -964,15 +1382,134 @@ class TrajectoryCounter : public SingleStepBase<OccEventCounterData> {
         data()->occ_final_counter(), data()->occ_init_counter(),
         data()->params.require_atom_conservation);
 
+    if (m_memoize) {
+      _make_trajectories();
+      return;
+    }
+
     std::sort(data()->position_final.begin(), data()->position_final.end());
 
     data()->occ_event =
         make_occevent(data()->position_init, data()->position_final);
   }
 
+  /// \brief Copy this step, in its current state, with access to other
+  ///     shared data
+  std::unique_ptr<SingleStepBase<OccEventCounterData>> clone(
+      std::shared_ptr<OccEventCounterData> _data) const override {
+    auto step = std::make_unique<TrajectoryCounter>(*this);
+    step->data() = _data;
+    return step;
+  }
+
  private:
+  /// \brief Sublattices of the cluster sites, occ_init, and occ_final
+  typedef std::tuple<std::vector<Index>, std::vector<int>, std::vector<int>>
+      MemoKey;
+
+  /// \brief Set `m_trajectories` from the memoized allowed permutations
+  ///     of `position_final`, as made by `make_occ_positions`
+  void _make_trajectories() const {
+    std::vector<Index> sublattices;
+    for (auto const &site : data()->cluster) {
+      sublattices.push_back(site.sublattice());
+    }
+    MemoKey key(std::move(sublattices), data()->occ_init_counter(),
+                data()->occ_final_counter());
+    auto it = m_memo.find(key);
+    if (it == m_memo.end()) {
+      it = m_memo.emplace(std::move(key), _make_allowed_permutations()).first;
+    }
+
+    // positions are sorted by site, so the order of the allowed
+    // permutations depends on the cluster and must be restored
+    std::vector<OccPosition> const &positions = data()->position_final;
+    m_trajectories.clear();
+    for (auto const &perm : it->second) {
+      std::vector<OccPosition> trajectory;
+      trajectory.reserve(perm.size());
+      for (Index j : perm) {
+        trajectory.push_back(positions[j]);
+      }
+      m_trajectories.push_back(std::move(trajectory));
+    }
+    std::sort(m_trajectories.begin(), m_trajectories.end());
+
+    m_trajectory_index = 0;
+    if (m_trajectories.empty()) {
+      _finish();
+    } else {
+      _set_trajectory();
+    }
+  }
+
+  /// \brief Check every permutation of `position_final`, as made by
+  ///     `make_occ_positions`, and return the allowed permutations
+  ///
+  /// Permutation `perm` gives trajectory `position_final[i] ->
+  /// positions[perm[i]]`, where `positions` is the value of
+  /// `position_final` before checking, which is restored afterwards.
+  std::vector<std::vector<Index>> _make_allowed_permutations() const {
+    std::vector<OccPosition> positions = data()->position_final;
+    std::vector<OccPosition> &position_final = data()->position_final;
+    std::sort(position_final.begin(), position_final.end());
+
+    std::vector<std::vector<Index>> allowed;
+    do {
+      data()->occ_event = make_occevent(data()->position_init, position_final);
+      if (!_check_trajectory()) {
+        continue;
+      }
+      std::vector<Index> perm;
+      std::vector<bool> used(positions.size(), false);
+      for (auto const &position : position_final) {
+        for (Index j = 0; j < positions.size(); ++j) {
+          if (!used[j] && !(positions[j] < position) &&
+              !(position < positions[j])) {
+            used[j] = true;
+            perm.push_back(j);
+            break;
+          }
+        }
+      }
+      allowed.push_back(std::move(perm));
+    } while (std::next_permutation(position_final.begin(),
+                                   position_final.end()));
+
+    position_final = std::move(positions);
+    return allowed;
+  }
+
+  /// \brief Set `position_final` and `occ_event` from the current
+  ///     memoized trajectory
+  void _set_trajectory() const {
+    data()->position_final = m_trajectories[m_trajectory_index];
+    data()->occ_event =
+        make_occevent(data()->position_init, data()->position_final);
+  }
+
+  /// \brief Set the finished state
+  void _finish() const {
+    data()->position_init.clear();
+    data()->position_final.clear();
+    data()->trajectory_finished = true;
+  }
+
   /// \brief Temporary variable used for checking atom/molecule conservation
   mutable Eigen::VectorXi m_count;
+
+  /// \brief If true, use memoized allowed permutations
+  bool m_memoize;
+
+  /// \brief Allowed permutations, by sublattice and occupation pattern
+  mutable std::map<MemoKey, std::vector<std::vector<Index>>> m_memo;
+
+  /// \brief Allowed trajectories, as `position_final`, on the current
+  ///     cluster and occupation
+  mutable std::vector<std::vector<OccPosition>> m_trajectories;
+
+  /// \brief Index into `m_trajectories` of the current trajectory
+  mutable Index m_trajectory_index = 0;
 };
 
 }  // namespace
@@ -982,17 +1519,148 @@ class TrajectoryCounter : public SingleStepBase<OccEventCounterData> {
 /// \param system, OccSystem used to define and check OccEvent
 /// \param clusters, Vector of underlying cluster orbit prototypes
 ///     on which OccEvent should be generated.
+/// \param params, Options controlling the events generated. If
+///     `params.n_shards > 1`, only the prototypes in shard
+///     `params.shard_index` are counted over.
+///
+OccEventCounter::OccEventCounter(
+    std::shared_ptr<OccSystem const> const &system,
+    std::vector<clust::IntegralCluster> const &prototypes,
+    OccEventCounterParameters const &params) {
+  _initialize(system, prototypes, params, 0);
+}
+
+/// \brief Constructor, resuming from a saved state
+///
+/// \param system, OccSystem used to define and check OccEvent
+/// \param clusters, Vector of underlying cluster orbit prototypes
+///     on which OccEvent should be generated.
 /// \param params, Options controlling the events generated.
+/// \param state, A state returned by `state()` of an OccEventCounter
+///     constructed with the same system, prototypes, and params.
 ///
+/// Counting begins at the cluster `prototypes[state.prototype_index]`, and
+/// is advanced `state.event_index` times, so only events on one cluster are
+/// generated again. Throws if `state` is not a state of the counter.
 OccEventCounter::OccEventCounter(
     std::shared_ptr<OccSystem const> const &system,
     std::vector<clust::IntegralCluster> const &prototypes,
+    OccEventCounterParameters const &params,
+    OccEventCounterState const &state) {
+  if (state.prototype_index < 0 || state.event_index < 0) {
+    throw std::runtime_error("Error in OccEventCounter: invalid state");
+  }
+  _initialize(system, prototypes, params, state.prototype_index);
+  if (state.prototype_index > Index(m_data->prototypes.size())) {
+    throw std::runtime_error("Error in OccEventCounter: invalid state");
+  }
+  while (!is_finished() && m_event_index < state.event_index &&
+         m_data->prototype_index == state.prototype_index) {
+    advance();
+  }
+  OccEventCounterState _state = this->state();
+  if (_state.prototype_index != state.prototype_index ||
+      _state.event_index != state.event_index) {
+    throw std::runtime_error(
+        "Error in OccEventCounter: state is not a state of the counter");
+  }
+}
+
+/// \brief Constructor, using cluster groups to skip equivalent initial
+///     occupations
+///
+/// \param system, OccSystem used to define and check OccEvent
+/// \param orbits, Cluster orbits on which OccEvent should be generated.
+///     The first element of each orbit is used as the prototype.
+/// \param cluster_groups, The cluster groups of the elements of each
+///     orbit, as from `clust::make_cluster_groups`. Only
+///     `cluster_groups[i][0]`, the cluster group of the prototype of
+///     `orbits[i]`, is used.
+/// \param occevent_symgroup_rep, Representation of the head group of the
+///     cluster groups (the prim factor group)
+/// \param params, Options controlling the events generated. If
+///     `params.n_shards > 1`, only the prototypes in shard
+///     `params.shard_index` are counted over.
+///
+/// Only initial occupations which are the canonical element of their orbit
+/// under the cluster group of the prototype are counted over, so that each
+/// event generated without cluster groups is equivalent, by an operation
+/// of its cluster group, to an event which is generated. This reduces the
+/// number of events by up to the cluster group order, without changing
+/// the distinct events found by canonicalizing the events generated.
+///
+/// The reduction is not used, and all events are generated, if
+/// `required_occ_init`, `required_occ_final`, any orientation count, or any
+/// custom filter is set, because they may not be invariant under the
+/// cluster group.
+OccEventCounter::OccEventCounter(
+    std::shared_ptr<OccSystem const> const &system,
+    std::vector<std::set<clust::IntegralCluster>> const &orbits,
+    std::vector<std::vector<std::shared_ptr<SymGroup const>>> const
+        &cluster_groups,
+    std::vector<OccEventRep> const &occevent_symgroup_rep,
     OccEventCounterParameters const &params) {
+  if (orbits.size() != cluster_groups.size()) {
+    throw std::runtime_error(
+        "Error in OccEventCounter: orbits and cluster_groups size mismatch");
+  }
+  std::vector<xtal::UnitCellCoordRep> unitcellcoord_symgroup_rep;
+  sym_info::OccSymGroupRep occ_symgroup_rep;
+  for (auto const &rep : occevent_symgroup_rep) {
+    unitcellcoord_symgroup_rep.push_back(rep.unitcellcoord_rep);
+    occ_symgroup_rep.push_back(rep.occupant_rep);
+  }
+
+  std::vector<clust::IntegralCluster> prototypes;
+  std::vector<std::vector<clust::ClusterOccSymOpRep>>
+      cluster_occ_symgroup_reps;
+  bool is_invariant = is_cluster_group_invariant(params);
+  for (Index i = 0; i < orbits.size(); ++i) {
+    if (orbits[i].empty() || cluster_groups[i].empty()) {
+      throw std::runtime_error(
+          "Error in OccEventCounter: empty orbit or cluster groups");
+    }
+    prototypes.push_back(*orbits[i].begin());
+    if (is_invariant) {
+      cluster_occ_symgroup_reps.push_back(clust::make_cluster_occ_symgroup_rep(
+          prototypes.back(), *cluster_groups[i][0], unitcellcoord_symgroup_rep,
+          occ_symgroup_rep));
+    }
+  }
+  _initialize(system, prototypes, params, 0, cluster_occ_symgroup_reps);
+}
+
+/// \brief Construct `m_data` and `m_stepper`, beginning at
+///     `begin_prototype_index`
+///
+/// If `cluster_occ_symgroup_reps` is not empty, it has one element for
+/// each of `prototypes`.
+void OccEventCounter::_initialize(
+    std::shared_ptr<OccSystem const> const &system,
+    std::vector<clust::IntegralCluster> const &prototypes,
+    OccEventCounterParameters const &params, Index begin_prototype_index,
+    std::vector<std::vector<clust::ClusterOccSymOpRep>> const
+        &cluster_occ_symgroup_reps) {
+  if (params.n_shards < 1 || params.shard_index < 0 ||
+      params.shard_index >= params.n_shards) {
+    throw std::runtime_error(
+        "Error in OccEventCounter: invalid shard_index or n_shards");
+  }
+
   // make shared data structure
   m_data = std::make_shared<OccEventCounterData>();
   m_data->system = system;
-  m_data->prototypes = prototypes;
+  for (Index i = params.shard_index; i < prototypes.size();
+       i += params.n_shards) {
+    m_data->prototypes.push_back(prototypes[i]);
+    if (!cluster_occ_symgroup_reps.empty()) {
+      m_data->cluster_occ_symgroup_reps.push_back(
+          cluster_occ_symgroup_reps[i]);
+    }
+  }
   m_data->params = params;
+  m_data->begin_prototype_index = begin_prototype_index;
+  m_event_index = 0;
 
   // make individual method steps:
   typedef MultiStepMethod<OccEventCounterData>::StepVector StepVector;
@@ -1014,6 +1682,8 @@ OccEventCounter::OccEventCounter(
   // in a Counter-like fashion, skipping invalid or unallowed events
   m_stepper = std::make_unique<MultiStepMethod<OccEventCounterData>>(
       m_data, std::move(steps));
+  m_progress_index = m_data->prototype_index;
+  m_end_prototype_index = m_data->prototypes.size();
 }
 
 std::shared_ptr<OccEventCounterData> const &OccEventCounter::data() const {
@@ -1021,11 +1691,43 @@ std::shared_ptr<OccEventCounterData> const &OccEventCounter::data() const {
 }
 
 /// \brief Advance to the next allowed OccEvent
+///
+/// If `params.progress` is set, throws OperationCancelled if cancellation
+/// is requested.
 bool OccEventCounter::advance() {
+  Index prototype_index = m_data->prototype_index;
   m_stepper->advance();
+  if (is_finished() || m_data->prototype_index != prototype_index) {
+    m_event_index = 0;
+  } else {
+    ++m_event_index;
+  }
+  _report_progress();
   return !is_finished();
 }
 
+/// \brief Advance `params.progress` by the prototypes finished since it
+///     was last advanced, or check for cancellation
+///
+/// Prototypes in `[m_progress_index, m_end_prototype_index)` are reported
+/// by this counter, as counting over them finishes, so that prototypes
+/// shared by split counters are reported once.
+void OccEventCounter::_report_progress() {
+  auto const &progress = m_data->params.progress;
+  if (!progress) {
+    return;
+  }
+  Index index = is_finished() ? m_end_prototype_index
+                              : std::min(m_data->prototype_index,
+                                         m_end_prototype_index);
+  if (index > m_progress_index) {
+    progress->advance(index - m_progress_index);
+    m_progress_index = index;
+  } else if (!is_finished()) {
+    progress->check();
+  }
+}
+
 OccEvent const &OccEventCounter::value() const {
   if (is_finished()) {
     throw std::runtime_error(
@@ -1036,5 +1738,75 @@ OccEvent const &OccEventCounter::value() const {
 
 bool OccEventCounter::is_finished() const { return m_stepper->is_finished(); }
 
+/// \brief Current position, which may be used to resume counting
+///
+/// The state may be saved, for instance with `to_json`, and passed to the
+/// resuming constructor to continue counting from the current OccEvent.
+/// Throws if this counter was split, because resuming would count the
+/// events of the other counters again.
+OccEventCounterState OccEventCounter::state() const {
+  if (m_is_split) {
+    throw std::runtime_error(
+        "Error in OccEventCounter::state: counter was split");
+  }
+  OccEventCounterState _state;
+  if (is_finished()) {
+    _state.prototype_index = m_data->prototypes.size();
+    _state.event_index = 0;
+  } else {
+    _state.prototype_index = m_data->prototype_index;
+    _state.event_index = m_event_index;
+  }
+  return _state;
+}
+
+/// \brief Split off the events after the current subtree at step
+///     `level`, so they may be counted by another worker
+///
+/// \param level Step index, 0 (trajectories) to 3 (cluster prototypes).
+///     Must be less than `end_level()`.
+///
+/// \returns A counter which generates the events after the current
+///     subtree at `level`, beginning at the next allowed event. It may
+///     already be finished, if there were none. After this returns, this
+///     counter finishes once the events in the current subtree at `level`
+///     are generated, for instance, with `level == 3`, once the events on
+///     the current cluster are generated.
+///
+/// The events generated by the two counters together are the events this
+/// would have generated, in the same order. The returned counter has its
+/// own copy of the counter data, so it may be advanced by another thread
+/// (see the thread safety notes of `make_prim_periodic_occevent_prototypes`
+/// for `params`). Progress is reported once for each prototype, by the
+/// counter which finishes counting over it.
+std::unique_ptr<OccEventCounter> OccEventCounter::split(Index level) {
+  if (is_finished()) {
+    throw std::runtime_error(
+        "Error in OccEventCounter::split: counting is finished");
+  }
+  Index prototype_index = m_data->prototype_index;
+  std::unique_ptr<OccEventCounter> result(new OccEventCounter());
+  result->m_stepper = m_stepper->split(level);
+  result->m_data = result->m_stepper->data();
+  result->m_event_index = 0;
+  result->m_end_prototype_index = m_end_prototype_index;
+  result->m_is_split = true;
+  m_is_split = true;
+  if (level == Index(m_stepper->steps().size()) - 1) {
+    m_end_prototype_index = prototype_index + 1;
+  } else {
+    m_end_prototype_index = prototype_index;
+  }
+  result->m_progress_index = m_end_prototype_index;
+  result->_report_progress();
+  return result;
+}
+
+/// \brief Steps with index less than this may be split at
+///
+/// This is 4, unless this was split, in which case it is the level that
+/// this was last split at.
+Index OccEventCounter::end_level() const { return m_stepper->end_level(); }
+
 }  // namespace occ_events
 }  // namespace CASM
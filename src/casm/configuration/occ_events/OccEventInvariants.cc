@@ -18,21 +18,18 @@ std::vector<Eigen::Vector3d> make_unique_coordinates(OccEvent const &event,
                                                      OccSystem const &system) {
   double tol = system.prim->lattice().tol();
 
+  Eigen::Matrix3Xd coords = system.get_cartesian_coordinates(event);
   std::vector<Eigen::Vector3d> unique_coordinates;
-  for (auto const &traj : event) {
-    for (auto const &pos : traj.position) {
-      if (pos.is_in_resevoir) {
-        continue;
-      }
-      Eigen::Vector3d test_coord = system.get_cartesian_coordinate(pos);
-      auto begin = unique_coordinates.begin();
-      auto end = unique_coordinates.end();
-      auto almost_equal_f = [&](Eigen::Vector3d const &existing_coord) {
-        return almost_equal(test_coord, existing_coord, tol);
-      };
-      if (std::find_if(begin, end, almost_equal_f) == end) {
-        unique_coordinates.push_back(test_coord);
-      }
+  unique_coordinates.reserve(coords.cols());
+  for (Index i = 0; i < coords.cols(); ++i) {
+    Eigen::Vector3d test_coord = coords.col(i);
+    auto begin = unique_coordinates.begin();
+    auto end = unique_coordinates.end();
+    auto almost_equal_f = [&](Eigen::Vector3d const &existing_coord) {
+      return almost_equal(test_coord, existing_coord, tol);
+    };
+    if (std::find_if(begin, end, almost_equal_f) == end) {
+      unique_coordinates.push_back(test_coord);
     }
   }
   return unique_coordinates;
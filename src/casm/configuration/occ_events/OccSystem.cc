@@ -3,6 +3,7 @@
 #include <optional>
 
 #include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/occ_events/OccEvent.hh"
 #include "casm/configuration/occ_events/OccPosition.hh"
 #include "casm/crystallography/BasicStructure.hh"
 #include "casm/misc/algorithm.hh"
@@ -16,6 +17,51 @@
 namespace CASM {
 namespace occ_events {
 
+namespace {  // anonymous
+
+/// \brief Set the Cartesian coordinate of a non-resevoir OccPosition
+///
+/// \param coord Set to the Cartesian coordinate
+/// \param pos The position
+/// \param prim The prim structure
+/// \param L The prim lattice column matrix
+/// \param method Name of the calling method, for error messages
+template <typename CoordType>
+void _set_cartesian_coordinate(CoordType &&coord, OccPosition const &pos,
+                               xtal::BasicStructure const &prim,
+                               Eigen::Matrix3d const &L,
+                               std::string const &method) {
+  if (pos.is_in_resevoir) {
+    throw std::runtime_error("Error in " + method +
+                             ": OccPosition is in resevoir");
+  }
+
+  Index b = pos.integral_site_coordinate.sublattice();
+  if (b < 0 || b >= prim.basis().size()) {
+    throw std::runtime_error("Error in " + method +
+                             ": Invalid OccPosition sublattice");
+  }
+  xtal::Site const &site = prim.basis()[b];
+  if (pos.occupant_index < 0 ||
+      pos.occupant_index >= site.occupant_dof().size()) {
+    throw std::runtime_error("Error in " + method +
+                             ": Invalid OccPosition occupant_index");
+  }
+  coord = site.const_cart() +
+          L * pos.integral_site_coordinate.unitcell().cast<double>();
+  if (!pos.is_atom) {
+    return;
+  }
+  xtal::Molecule const &mol = site.occupant_dof()[pos.occupant_index];
+  if (pos.atom_position_index < 0 || pos.atom_position_index >= mol.size()) {
+    throw std::runtime_error("Error in " + method +
+                             ": Invalid OccPosition atom_position_index");
+  }
+  coord += mol.atom(pos.atom_position_index).cart();
+}
+
+}  // namespace
+
 OccSystem::OccSystem(std::shared_ptr<xtal::BasicStructure const> const &_prim,
                      std::vector<std::string> const &_chemical_name_list,
                      std::set<std::string> const &_vacancy_name_list)
@@ -109,6 +155,29 @@ OccSystem::OccSystem(std::shared_ptr<xtal::BasicStructure const> const &_prim,
     }
     ++b;
   }
+
+  // --- build flattened lookup tables ---
+
+  occupant_offset.push_back(0);
+  atom_position_offset.push_back(0);
+  for (Index b = 0; b < prim->basis().size(); ++b) {
+    for (Index occupant_index = 0;
+         occupant_index < occupant_to_chemical_index[b].size();
+         ++occupant_index) {
+      int chemical_index = occupant_to_chemical_index[b][occupant_index];
+      flat_occupant_to_chemical_index.push_back(chemical_index);
+      flat_occupant_to_orientation_index.push_back(
+          occupant_to_orientation_index[b][occupant_index]);
+      flat_occupant_is_vacancy.push_back(is_vacancy_list[chemical_index]);
+      flat_occupant_is_indivisible.push_back(
+          is_indivisible_chemical_list[chemical_index]);
+      auto const &names = atom_position_to_name_index[b][occupant_index];
+      flat_atom_position_to_name_index.insert(
+          flat_atom_position_to_name_index.end(), names.begin(), names.end());
+      atom_position_offset.push_back(flat_atom_position_to_name_index.size());
+    }
+    occupant_offset.push_back(flat_occupant_to_chemical_index.size());
+  }
 }
 
 OccPosition OccSystem::make_molecule_position(
@@ -312,39 +381,79 @@ void OccSystem::make_occ_positions(std::vector<OccPosition> &positions,
 
 Eigen::Vector3d OccSystem::get_cartesian_coordinate(
     OccPosition const &occ_position) const {
-  auto const &pos = occ_position;
-  if (pos.is_in_resevoir) {
-    throw std::runtime_error(
-        "Error in OccSystem::get_cartesian_coordinate: OccPosition is in "
-        "resevoir");
-  }
+  Eigen::Vector3d coord;
+  _set_cartesian_coordinate(coord, occ_position, *this->prim,
+                            this->prim->lattice().lat_column_mat(),
+                            "OccSystem::get_cartesian_coordinate");
+  return coord;
+}
 
-  Index b = pos.integral_site_coordinate.sublattice();
-  if (b < 0 || b >= this->prim->basis().size()) {
-    throw std::runtime_error(
-        "Error in OccSystem::get_cartesian_coordinate: Invalid OccPosition "
-        "sublattice");
-  }
-  xtal::Site const &site = this->prim->basis()[b];
-  if (pos.occupant_index < 0 ||
-      pos.occupant_index >= site.occupant_dof().size()) {
-    throw std::runtime_error(
-        "Error in OccSystem::get_cartesian_coordinate: Invalid OccPosition "
-        "occupant_index");
+/// \brief Cartesian coordinates of positions, as columns
+///
+/// Column `i` is the Cartesian coordinate of `positions[i]`, as given by
+/// `get_cartesian_coordinate`. Throws if any position is in the resevoir.
+Eigen::Matrix3Xd OccSystem::get_cartesian_coordinates(
+    std::vector<OccPosition> const &positions) const {
+  Eigen::Matrix3d const &L = this->prim->lattice().lat_column_mat();
+  Eigen::Matrix3Xd coords(3, positions.size());
+  for (Index i = 0; i < positions.size(); ++i) {
+    _set_cartesian_coordinate(coords.col(i), positions[i], *this->prim, L,
+                              "OccSystem::get_cartesian_coordinates");
   }
-  Eigen::Vector3d coord =
-      pos.integral_site_coordinate.coordinate(*this->prim).cart();
-  if (!pos.is_atom) {
-    return coord;
+  return coords;
+}
+
+/// \brief Cartesian coordinates of all non-resevoir positions in an
+///     event, as columns
+///
+/// Columns are in order of trajectory and then position along the
+/// trajectory, skipping positions in the resevoir.
+Eigen::Matrix3Xd OccSystem::get_cartesian_coordinates(
+    OccEvent const &event) const {
+  Eigen::VectorXl offsets;
+  return get_cartesian_coordinates(std::vector<OccEvent>({event}), offsets);
+}
+
+/// \brief Cartesian coordinates of all non-resevoir positions in many
+///     events, as columns
+///
+/// \param events The events
+/// \param offsets Set to the offset of the first column of each event, with
+///     size `events.size() + 1`, so the coordinates of `events[e]` are
+///     columns `[offsets(e), offsets(e+1))`
+///
+/// \returns coords, the Cartesian coordinates. The order of columns for each
+///     event is the same as for `get_cartesian_coordinates(event)`.
+Eigen::Matrix3Xd OccSystem::get_cartesian_coordinates(
+    std::vector<OccEvent> const &events, Eigen::VectorXl &offsets) const {
+  offsets.resize(events.size() + 1);
+  Index n = 0;
+  for (Index e = 0; e < events.size(); ++e) {
+    offsets(e) = n;
+    for (auto const &traj : events[e]) {
+      for (auto const &pos : traj.position) {
+        if (!pos.is_in_resevoir) {
+          ++n;
+        }
+      }
+    }
   }
-  xtal::Molecule const &mol = site.occupant_dof()[pos.occupant_index];
-  if (pos.atom_position_index < 0 || pos.atom_position_index >= mol.size()) {
-    throw std::runtime_error(
-        "Error in OccSystem::get_cartesian_coordinate: Invalid OccPosition "
-        "atom_position_index");
+  offsets(events.size()) = n;
+
+  Eigen::Matrix3d const &L = this->prim->lattice().lat_column_mat();
+  Eigen::Matrix3Xd coords(3, n);
+  Index i = 0;
+  for (auto const &event : events) {
+    for (auto const &traj : event) {
+      for (auto const &pos : traj.position) {
+        if (!pos.is_in_resevoir) {
+          _set_cartesian_coordinate(coords.col(i++), pos, *this->prim, L,
+                                    "OccSystem::get_cartesian_coordinates");
+        }
+      }
+    }
   }
-  coord += mol.atom(pos.atom_position_index).cart();
-  return coord;
+  return coords;
 }
 
 /// \brief Return reference to molecule occupant
@@ -403,7 +512,7 @@ void OccSystem::molecule_count(Eigen::VectorXi &count,
   Index i = 0;
   for (auto const &site : cluster) {
     b = site.sublattice();
-    count(occupant_to_chemical_index[b][occ[i]]) += 1;
+    count(flat_occupant_to_chemical_index[flat_occupant_index(b, occ[i])]) += 1;
     ++i;
   }
   return;
@@ -429,7 +538,8 @@ void OccSystem::orientation_count(Eigen::VectorXi &count,
   Index i = 0;
   for (auto const &site : cluster) {
     b = site.sublattice();
-    count(occupant_to_orientation_index[b][occ[i]]) += 1;
+    count(flat_occupant_to_orientation_index[flat_occupant_index(b, occ[i])]) +=
+        1;
     ++i;
   }
   return;
@@ -455,8 +565,10 @@ void OccSystem::atom_count(Eigen::VectorXi &count,
   Index i = 0;
   for (auto const &site : cluster) {
     b = site.sublattice();
-    for (auto const &atom_name_index : atom_position_to_name_index[b][occ[i]]) {
-      count(atom_name_index) += 1;
+    Index f = flat_occupant_index(b, occ[i]);
+    for (Index j = atom_position_offset[f]; j < atom_position_offset[f + 1];
+         ++j) {
+      count(flat_atom_position_to_name_index[j]) += 1;
     }
     ++i;
   }
@@ -484,8 +596,10 @@ bool OccSystem::is_molecule_conserving(
   Index i = 0;
   for (auto const &site : cluster) {
     b = site.sublattice();
-    count(occupant_to_chemical_index[b][occ_final[i]]) += 1;
-    count(occupant_to_chemical_index[b][occ_init[i]]) -= 1;
+    count(flat_occupant_to_chemical_index[flat_occupant_index(
+        b, occ_final[i])]) += 1;
+    count(flat_occupant_to_chemical_index[flat_occupant_index(
+        b, occ_init[i])]) -= 1;
     ++i;
   }
   return !count.any();
@@ -513,13 +627,15 @@ bool OccSystem::is_atom_conserving(Eigen::VectorXi &count,
   Index i = 0;
   for (auto const &site : cluster) {
     b = site.sublattice();
-    for (auto const &atom_name_index :
-         atom_position_to_name_index[b][occ_final[i]]) {
-      count(atom_name_index) += 1;
+    Index f_final = flat_occupant_index(b, occ_final[i]);
+    for (Index j = atom_position_offset[f_final];
+         j < atom_position_offset[f_final + 1]; ++j) {
+      count(flat_atom_position_to_name_index[j]) += 1;
     }
-    for (auto const &atom_name_index :
-         atom_position_to_name_index[b][occ_init[i]]) {
-      count(atom_name_index) -= 1;
+    Index f_init = flat_occupant_index(b, occ_init[i]);
+    for (Index j = atom_position_offset[f_init];
+         j < atom_position_offset[f_init + 1]; ++j) {
+      count(flat_atom_position_to_name_index[j]) -= 1;
     }
     ++i;
   }
@@ -595,8 +711,8 @@ bool OccSystem::is_any_unchanging_vacant_site(
   Index i = 0;
   for (auto const &site : cluster) {
     Index b = site.sublattice();
-    if (is_vacancy_list[occupant_to_chemical_index[b][occ_init[i]]] &&
-        is_vacancy_list[occupant_to_chemical_index[b][occ_final[i]]]) {
+    if (flat_occupant_is_vacancy[flat_occupant_index(b, occ_init[i])] &&
+        flat_occupant_is_vacancy[flat_occupant_index(b, occ_final[i])]) {
       return true;
     }
     ++i;
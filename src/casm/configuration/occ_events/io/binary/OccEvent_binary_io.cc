@@ -0,0 +1,194 @@
+#include "casm/configuration/occ_events/io/binary/OccEvent_binary_io.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "casm/configuration/occ_events/CompactOccEvent.hh"
+#include "casm/configuration/occ_events/OccEvent.hh"
+#include "casm/configuration/occ_events/OccEventCounter.hh"
+
+namespace CASM {
+
+namespace {  // (anonymous)
+
+char const binary_magic[8] = {'C', 'A', 'S', 'M', 'O', 'E', 'V', 'T'};
+std::uint64_t const binary_version = 1;
+
+/// Maximum number of values in one record, used to detect corrupt data
+std::uint64_t const max_record_size = std::uint64_t(1) << 32;
+
+void put_u64(std::vector<std::uint8_t> &data, std::uint64_t value) {
+  for (int k = 0; k < 8; ++k) {
+    data.push_back(static_cast<std::uint8_t>(value >> (8 * k)));
+  }
+}
+
+void put_i32(std::vector<std::uint8_t> &data, std::int32_t value) {
+  std::uint32_t bits = static_cast<std::uint32_t>(value);
+  for (int k = 0; k < 4; ++k) {
+    data.push_back(static_cast<std::uint8_t>(bits >> (8 * k)));
+  }
+}
+
+std::uint64_t get_u64(std::uint8_t const *data) {
+  std::uint64_t value = 0;
+  for (int k = 0; k < 8; ++k) {
+    value |= static_cast<std::uint64_t>(data[k]) << (8 * k);
+  }
+  return value;
+}
+
+std::int32_t get_i32(std::uint8_t const *data) {
+  std::uint32_t bits = 0;
+  for (int k = 0; k < 4; ++k) {
+    bits |= static_cast<std::uint32_t>(data[k]) << (8 * k);
+  }
+  return static_cast<std::int32_t>(bits);
+}
+
+/// \brief Read bytes from a stream, return false if the stream ends first
+bool read_bytes(std::istream &in, std::uint8_t *data, Index size) {
+  in.read(reinterpret_cast<char *>(data), size);
+  return in.gcount() == size;
+}
+
+/// \brief Read and check the header
+void read_header(std::istream &in) {
+  std::uint8_t header[16];
+  if (!read_bytes(in, header, 16) ||
+      !std::equal(binary_magic, binary_magic + 8, header)) {
+    throw std::runtime_error(
+        "Error reading OccEvent binary data: invalid header");
+  }
+  if (get_u64(header + 8) != binary_version) {
+    throw std::runtime_error(
+        "Error reading OccEvent binary data: unsupported version");
+  }
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param out The output stream
+/// \param write_header If true, write the header. Use false to append
+///     events to an existing stream.
+OccEventBinaryWriter::OccEventBinaryWriter(std::ostream &out,
+                                           bool write_header)
+    : m_out(out), m_n_written(0) {
+  if (write_header) {
+    m_out.write(binary_magic, 8);
+    put_u64(m_buffer, binary_version);
+    m_out.write(reinterpret_cast<char const *>(m_buffer.data()),
+                m_buffer.size());
+    if (!m_out) {
+      throw std::runtime_error(
+          "Error writing OccEvent binary data: write failed");
+    }
+  }
+}
+
+/// \brief Write one event
+void OccEventBinaryWriter::write(occ_events::OccEvent const &occ_event) {
+  occ_events::CompactOccEvent compact(occ_event);
+  auto const &values = compact.data();
+  m_buffer.clear();
+  m_buffer.reserve(8 + 4 * values.size());
+  put_u64(m_buffer, values.size());
+  for (std::int32_t value : values) {
+    put_i32(m_buffer, value);
+  }
+  m_out.write(reinterpret_cast<char const *>(m_buffer.data()),
+              m_buffer.size());
+  if (!m_out) {
+    throw std::runtime_error(
+        "Error writing OccEvent binary data: write failed");
+  }
+  ++m_n_written;
+}
+
+/// \brief Write events as they are produced by an OccEventCounter
+///
+/// \param counter The counter, which is advanced until finished
+/// \param offset The number of events produced by `counter` that are
+///     skipped before writing, to resume an interrupted write
+///
+/// \returns The number of events written
+Index OccEventBinaryWriter::write(occ_events::OccEventCounter &counter,
+                                  Index offset) {
+  Index n_before = m_n_written;
+  Index i = 0;
+  while (!counter.is_finished()) {
+    if (i >= offset) {
+      write(counter.value());
+    }
+    ++i;
+    counter.advance();
+  }
+  return m_n_written - n_before;
+}
+
+/// \brief Constructor
+///
+/// \param in The input stream, which is read from the header
+/// \param offset The number of events skipped before the first read
+OccEventBinaryReader::OccEventBinaryReader(std::istream &in, Index offset)
+    : m_in(in), m_index(0) {
+  read_header(m_in);
+  while (m_index < offset && _next_record(false)) {
+    ++m_index;
+  }
+}
+
+/// \brief Read the next event, return false if there are no more events
+bool OccEventBinaryReader::read(occ_events::OccEvent &occ_event) {
+  if (!_next_record(true)) {
+    return false;
+  }
+  occ_event = occ_events::CompactOccEvent(m_values).to_occevent();
+  ++m_index;
+  return true;
+}
+
+/// \brief Count the complete events in a stream
+///
+/// Reads `in` from the header to the end, without decoding events.
+Index OccEventBinaryReader::count(std::istream &in) {
+  OccEventBinaryReader reader(in);
+  while (reader._next_record(false)) {
+    ++reader.m_index;
+  }
+  return reader.m_index;
+}
+
+/// \brief Read the next record, return false if none
+///
+/// \param decode If true, read the packed values into m_values, else skip
+///     them
+bool OccEventBinaryReader::_next_record(bool decode) {
+  std::uint8_t size_bytes[8];
+  if (!read_bytes(m_in, size_bytes, 8)) {
+    return false;
+  }
+  std::uint64_t n_values = get_u64(size_bytes);
+  if (n_values == 0 || n_values > max_record_size) {
+    throw std::runtime_error(
+        "Error reading OccEvent binary data: invalid record size");
+  }
+  Index n_bytes = 4 * n_values;
+  if (!decode) {
+    m_in.ignore(n_bytes);
+    return m_in.gcount() == n_bytes;
+  }
+  std::vector<std::uint8_t> bytes(n_bytes);
+  if (!read_bytes(m_in, bytes.data(), n_bytes)) {
+    return false;
+  }
+  m_values.resize(n_values);
+  for (Index i = 0; i < n_values; ++i) {
+    m_values[i] = get_i32(bytes.data() + 4 * i);
+  }
+  return true;
+}
+
+}  // namespace CASM
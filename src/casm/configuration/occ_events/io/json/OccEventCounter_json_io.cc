@@ -129,6 +129,8 @@ jsonParser &to_json(occ_events::OccEventCounterParameters const &params,
   _to_json.if_not_default(params.skip_direct_exchange, true,
                           "skip_direct_exchange");
   _to_json.if_not_default(params.save_state_info, false, "save_state_info");
+  _to_json.if_not_default(params.n_shards, Index(1), "n_shards");
+  _to_json.if_not_default(params.shard_index, Index(0), "shard_index");
   return json;
 }
 
@@ -193,6 +195,36 @@ void parse(InputParser<occ_events::OccEventCounterParameters> &parser) {
                        true);
   parser.optional_else(params.save_state_info, "save_state_info", false);
 
+  parser.optional_else(params.n_shards, "n_shards", Index(1));
+  parser.optional_else(params.shard_index, "shard_index", Index(0));
+  if (params.n_shards < 1) {
+    parser.insert_error("n_shards", "Error: n_shards must be >= 1");
+  } else if (params.shard_index < 0 || params.shard_index >= params.n_shards) {
+    parser.insert_error("shard_index",
+                        "Error: shard_index must be in the range [0, "
+                        "n_shards)");
+  }
+
+  if (!parser.valid()) {
+    parser.value.reset();
+  }
+}
+
+/// \brief Write OccEventCounterState, to checkpoint counting
+jsonParser &to_json(occ_events::OccEventCounterState const &state,
+                    jsonParser &json) {
+  json.put_obj();
+  to_json(state.prototype_index, json["prototype_index"]);
+  to_json(state.event_index, json["event_index"]);
+  return json;
+}
+
+/// \brief Read OccEventCounterState, to resume counting
+void parse(InputParser<occ_events::OccEventCounterState> &parser) {
+  parser.value = std::make_unique<occ_events::OccEventCounterState>();
+  occ_events::OccEventCounterState &state = *parser.value;
+  parser.require(state.prototype_index, "prototype_index");
+  parser.require(state.event_index, "event_index");
   if (!parser.valid()) {
     parser.value.reset();
   }
@@ -0,0 +1,162 @@
+#include "casm/configuration/occ_events/io/json/OccEvent_jsonl_io.hh"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/configuration/occ_events/OccEvent.hh"
+#include "casm/configuration/occ_events/OccEventCounter.hh"
+#include "casm/configuration/occ_events/OccSystem.hh"
+
+namespace CASM {
+
+namespace {  // anonymous
+
+/// \brief Remove whitespace outside of JSON strings, so the value is
+///     written on one line
+std::string make_compact(std::string const &pretty) {
+  std::string compact;
+  compact.reserve(pretty.size());
+  bool in_string = false;
+  bool escaped = false;
+  for (char c : pretty) {
+    if (in_string) {
+      compact.push_back(c);
+      if (escaped) {
+        escaped = false;
+      } else if (c == '\\') {
+        escaped = true;
+      } else if (c == '"') {
+        in_string = false;
+      }
+    } else if (c == '"') {
+      compact.push_back(c);
+      in_string = true;
+    } else if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+      compact.push_back(c);
+    }
+  }
+  return compact;
+}
+
+/// \brief Return true if `line` is empty or only whitespace
+bool is_blank(std::string const &line) {
+  return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param out The output stream
+/// \param system The OccSystem used to write events
+/// \param options Options controlling which event properties are written
+OccEventJsonLinesWriter::OccEventJsonLinesWriter(
+    std::ostream &out, std::shared_ptr<occ_events::OccSystem const> system,
+    occ_events::OccEventOutputOptions options)
+    : m_out(out), m_system(system), m_options(options), m_n_written(0) {
+  if (m_system == nullptr) {
+    throw std::runtime_error(
+        "Error in OccEventJsonLinesWriter: system == nullptr");
+  }
+}
+
+/// \brief Options which write only event trajectories
+occ_events::OccEventOutputOptions OccEventJsonLinesWriter::default_options() {
+  occ_events::OccEventOutputOptions options;
+  options.include_cluster = false;
+  options.include_cluster_occupation = false;
+  options.include_event_invariants = false;
+  return options;
+}
+
+/// \brief Write one event
+void OccEventJsonLinesWriter::write(occ_events::OccEvent const &occ_event) {
+  jsonParser json;
+  to_json(occ_event, json, *m_system, m_options);
+  std::stringstream ss;
+  ss << json;
+  m_out << make_compact(ss.str()) << '\n';
+  if (!m_out) {
+    throw std::runtime_error(
+        "Error in OccEventJsonLinesWriter::write: write failed");
+  }
+  ++m_n_written;
+}
+
+/// \brief Write events as they are produced by an OccEventCounter
+///
+/// \param counter The counter, which is advanced until finished
+/// \param offset The number of events produced by `counter` that are
+///     skipped before writing, to resume an interrupted write
+///
+/// \returns The number of events written
+Index OccEventJsonLinesWriter::write(occ_events::OccEventCounter &counter,
+                                     Index offset) {
+  Index n_before = m_n_written;
+  Index i = 0;
+  while (!counter.is_finished()) {
+    if (i >= offset) {
+      write(counter.value());
+    }
+    ++i;
+    counter.advance();
+  }
+  return m_n_written - n_before;
+}
+
+/// \brief Constructor
+///
+/// \param in The input stream
+/// \param system The OccSystem used to read events
+/// \param offset The number of events skipped before the first read
+OccEventJsonLinesReader::OccEventJsonLinesReader(
+    std::istream &in, std::shared_ptr<occ_events::OccSystem const> system,
+    Index offset)
+    : m_in(in), m_system(system), m_index(0) {
+  if (m_system == nullptr) {
+    throw std::runtime_error(
+        "Error in OccEventJsonLinesReader: system == nullptr");
+  }
+  while (m_index < offset && _next_line()) {
+    ++m_index;
+  }
+}
+
+/// \brief Read the next event, return false if there are no more events
+bool OccEventJsonLinesReader::read(occ_events::OccEvent &occ_event) {
+  if (!_next_line()) {
+    return false;
+  }
+  jsonParser json = jsonParser::parse(m_line);
+  occ_event =
+      jsonConstructor<occ_events::OccEvent>::from_json(json, *m_system);
+  ++m_index;
+  return true;
+}
+
+/// \brief Count the events remaining in a stream
+///
+/// Reads `in` to the end, without parsing events.
+Index OccEventJsonLinesReader::count(std::istream &in) {
+  Index n = 0;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (!is_blank(line)) {
+      ++n;
+    }
+  }
+  return n;
+}
+
+/// \brief Read the next non-empty line, return false if none
+bool OccEventJsonLinesReader::_next_line() {
+  while (std::getline(m_in, m_line)) {
+    if (!is_blank(m_line)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace CASM
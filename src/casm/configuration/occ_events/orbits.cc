@@ -1,5 +1,8 @@
 #include "casm/configuration/occ_events/orbits.hh"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "casm/configuration/clusterography/IntegralCluster.hh"
 #include "casm/configuration/clusterography/orbits.hh"
 #include "casm/configuration/group/Group.hh"
@@ -9,6 +12,7 @@
 #include "casm/configuration/occ_events/OccEventCounter.hh"
 #include "casm/configuration/occ_events/OccEventInvariants.hh"
 #include "casm/configuration/occ_events/OccEventRep.hh"
+#include "casm/configuration/parallel.hh"
 #include "casm/crystallography/BasicStructure.hh"
 #include "casm/crystallography/SymType.hh"
 
@@ -48,6 +52,44 @@ std::set<OccEvent> make_prim_periodic_orbit(
                            prim_periodic_occevent_copy_apply);
 }
 
+/// \brief Constructor
+///
+/// \param occevent_symgroup_rep Symmetry group representation (as
+///     OccEventRep). Must remain valid for the lifetime of the cache.
+PrimPeriodicOccEventOrbitCache::PrimPeriodicOccEventOrbitCache(
+    std::vector<OccEventRep> const &occevent_symgroup_rep)
+    : m_occevent_symgroup_rep(&occevent_symgroup_rep) {}
+
+/// \brief Return the index of the orbit containing `occ_event`,
+///     generating the orbit if it has not been seen before
+Index PrimPeriodicOccEventOrbitCache::orbit_index(OccEvent const &occ_event) {
+  // translate to the origin and standardize, as
+  // prim_periodic_occevent_copy_apply does for the identity operation
+  OccEvent key = occ_event;
+  if (key.size()) {
+    key -= make_cluster(key)[0].unitcell();
+    standardize(key);
+  }
+  auto it = m_orbit_index.find(key);
+  if (it != m_orbit_index.end()) {
+    return it->second;
+  }
+
+  Index index = m_orbits.size();
+  m_orbits.push_back(make_prim_periodic_orbit(key, *m_occevent_symgroup_rep));
+  for (auto const &element : m_orbits.back()) {
+    m_orbit_index.emplace(element, index);
+  }
+  m_orbit_index.emplace(std::move(key), index);
+  return index;
+}
+
+/// \brief Return the canonical form of `occ_event`
+OccEvent const &PrimPeriodicOccEventOrbitCache::canonical_form(
+    OccEvent const &occ_event) {
+  return *m_orbits[orbit_index(occ_event)].rbegin();
+}
+
 /// \brief Generate equivalent OccEvent, translated to origin unit cell,
 ///     in a given order
 ///
@@ -193,34 +235,111 @@ std::shared_ptr<SymGroup const> make_occevent_group(
 
 /// \brief Make prototypes of distinct orbits of OccEvent, with periodic
 ///     symmetry of a prim
+///
+/// \param system OccSystem used to define and check OccEvent
+/// \param clusters Cluster orbit prototypes on which OccEvent are generated
+/// \param occevent_symgroup_rep Symmetry group representation
+/// \param params Options controlling the events generated
+/// \param custom_events OccEvent that are included regardless of `params`
+/// \param n_threads Number of threads used to generate OccEvent. If <= 0,
+///     uses the number of hardware threads.
+///
+/// \returns Canonical OccEvent, one per distinct orbit, sorted by
+///     invariants and then by OccEvent. The result does not depend on the
+///     number of threads.
+///
+/// Notes:
+/// - The events generated on each prototype cluster are independent, so
+///   clusters are distributed to threads, each with its own
+///   OccEventCounter, and the canonical events found by each thread are
+///   merged.
+/// - Each thread uses a PrimPeriodicOccEventOrbitCache, so the orbit of an
+///   event is generated once, and equivalent events generated later are
+///   found by lookup.
+/// - Clusters are assigned to threads in a strided order, because the
+///   number of events generated usually increases with cluster size and
+///   clusters are typically ordered by size.
+/// - If `n_threads != 1`, the filter functions in `params` must be safe to
+///   call concurrently. If `params.print_state_info` is set, a single
+///   thread is used so the output is in order.
+/// - If `params.progress` is set, progress is reported as one stage, with
+///   one work item per cluster, and OperationCancelled is thrown if
+///   cancellation is requested.
+/// - If `params.n_shards > 1`, only events on the clusters in shard
+///   `params.shard_index` are generated (see
+///   `OccEventCounterParameters::n_shards`), so that generation may be split
+///   across processes. Events from clusters in different shards are never
+///   equivalent, so the prototypes of all shards together are the prototypes
+///   generated with `n_shards == 1`. `custom_events` are included by every
+///   shard.
 std::vector<OccEvent> make_prim_periodic_occevent_prototypes(
     std::shared_ptr<OccSystem const> const &system,
     std::vector<clust::IntegralCluster> const &clusters,
     std::vector<OccEventRep> const &occevent_symgroup_rep,
     OccEventCounterParameters const &params,
-    std::vector<OccEvent> const &custom_events) {
-  // function to make an OccEvent canonical
-  auto _make_canonical = [&](OccEvent const &event) {
-    return group::make_canonical_element(
-        event, occevent_symgroup_rep.begin(), occevent_symgroup_rep.end(),
-        std::less<OccEvent>(), prim_periodic_occevent_copy_apply);
-  };
-
+    std::vector<OccEvent> const &custom_events, Index n_threads) {
   typedef std::pair<OccEventInvariants, OccEvent> pair_type;
   CompareOccEvent_f compare_f(system->prim->lattice().tol());
   std::set<pair_type, CompareOccEvent_f> prototype_events(compare_f);
 
-  OccEventCounter counter(system, clusters, params);
+  if (params.n_shards < 1 || params.shard_index < 0 ||
+      params.shard_index >= params.n_shards) {
+    throw std::runtime_error(
+        "Error in make_prim_periodic_occevent_prototypes: invalid shard_index "
+        "or n_shards");
+  }
+  std::vector<clust::IntegralCluster> shard_clusters;
+  for (Index i = params.shard_index; i < clusters.size();
+       i += params.n_shards) {
+    shard_clusters.push_back(clusters[i]);
+  }
+  OccEventCounterParameters worker_params = params;
+  worker_params.shard_index = 0;
+  worker_params.n_shards = 1;
 
-  while (!counter.is_finished()) {
-    prototype_events.emplace(OccEventInvariants(counter.value(), *system),
-                             _make_canonical(counter.value()));
-    counter.advance();
+  if (params.print_state_info) {
+    n_threads = 1;
+  }
+  Index n_workers = std::min<Index>(config::resolve_n_threads(n_threads),
+                                    std::max<Index>(shard_clusters.size(), 1));
+  std::vector<std::set<pair_type, CompareOccEvent_f>> worker_events(
+      n_workers, std::set<pair_type, CompareOccEvent_f>(compare_f));
+  config::begin_progress(params.progress,
+                         "make_prim_periodic_occevent_prototypes",
+                         shard_clusters.size());
+  config::parallel_for_chunks(
+      n_workers, n_workers,
+      [&](Index chunk_index, Index chunk_begin, Index chunk_end) {
+        for (Index w = chunk_begin; w < chunk_end; ++w) {
+          std::vector<clust::IntegralCluster> worker_clusters;
+          for (Index i = w; i < shard_clusters.size(); i += n_workers) {
+            worker_clusters.push_back(shard_clusters[i]);
+          }
+          if (worker_clusters.empty()) {
+            continue;
+          }
+          PrimPeriodicOccEventOrbitCache cache(occevent_symgroup_rep);
+          OccEventCounter counter(system, worker_clusters, worker_params);
+          while (!counter.is_finished()) {
+            cache.orbit_index(counter.value());
+            counter.advance();
+          }
+          for (auto const &orbit : cache.orbits()) {
+            OccEvent const &canonical_event = *orbit.rbegin();
+            worker_events[w].emplace(
+                OccEventInvariants(canonical_event, *system),
+                canonical_event);
+          }
+        }
+      });
+  for (auto const &events : worker_events) {
+    prototype_events.insert(events.begin(), events.end());
   }
 
+  PrimPeriodicOccEventOrbitCache cache(occevent_symgroup_rep);
   for (auto const &event : custom_events) {
     prototype_events.emplace(OccEventInvariants(event, *system),
-                             _make_canonical(event));
+                             cache.canonical_form(event));
   }
 
   std::vector<OccEvent> result;
@@ -236,10 +355,11 @@ std::vector<std::set<OccEvent>> make_prim_periodic_occevent_orbits(
     std::vector<clust::IntegralCluster> const &clusters,
     std::vector<OccEventRep> const &occevent_symgroup_rep,
     OccEventCounterParameters const &params,
-    std::vector<OccEvent> const &custom_events) {
+    std::vector<OccEvent> const &custom_events, Index n_threads) {
   std::vector<OccEvent> orbit_prototypes =
-      make_prim_periodic_occevent_prototypes(
-          system, clusters, occevent_symgroup_rep, params, custom_events);
+      make_prim_periodic_occevent_prototypes(system, clusters,
+                                             occevent_symgroup_rep, params,
+                                             custom_events, n_threads);
 
   // generate orbits from the unique OccEvent
   std::vector<std::set<OccEvent>> orbits;
@@ -0,0 +1,273 @@
+#include "casm/configuration/parallel.hh"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace CASM {
+namespace config {
+
+namespace {  // anonymous
+
+Index hardware_n_threads() {
+  Index n_hardware = std::thread::hardware_concurrency();
+  return n_hardware > 0 ? n_hardware : 1;
+}
+
+/// \brief The tasks of one call to run_on_thread_pool
+struct TaskGroup {
+  TaskGroup(std::function<void(Index)> const &_task, Index _n_tasks)
+      : task(_task), n_remaining(_n_tasks) {}
+
+  std::function<void(Index)> const &task;
+
+  /// Number of tasks not yet finished
+  std::atomic<Index> n_remaining;
+
+  std::mutex error_mutex;
+
+  /// First exception thrown by a task, if any
+  std::exception_ptr error;
+};
+
+struct Task {
+  TaskGroup *group;
+  Index index;
+};
+
+/// \brief Tasks pushed by one thread
+///
+/// The owning thread pushes and pops at the back, so it runs the tasks it
+/// added most recently (typically from a nested call) first. Other threads
+/// steal from the front.
+struct TaskQueue {
+  std::mutex mutex;
+  std::deque<Task> tasks;
+};
+
+/// \brief Process-wide work-stealing thread pool
+///
+/// - Queue 0 is shared by all threads that are not pool workers. Pool
+///   worker `i` (i >= 1) owns queue `i`.
+/// - Threads waiting for their tasks to finish run queued tasks, so nested
+///   calls do not deadlock or start more threads.
+/// - Worker threads are started when first needed, and not stopped. If the
+///   number of threads is decreased, extra workers stay idle.
+class ThreadPool {
+ public:
+  static constexpr Index max_n_queues = 1024;
+
+  ThreadPool() : m_n_threads(hardware_n_threads()), m_n_queued(0) {
+    m_queues[0] = std::make_unique<TaskQueue>();
+    m_n_queues = 1;
+  }
+
+  Index n_threads() const { return m_n_threads; }
+
+  void set_n_threads(Index _n_threads) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_n_threads = _n_threads > 0 ? _n_threads : hardware_n_threads();
+    }
+    m_cv.notify_all();
+  }
+
+  void run(Index n_tasks, std::function<void(Index)> const &task) {
+    _start_workers();
+    TaskGroup group(task, n_tasks);
+    Index q = this_queue_index();
+    {
+      TaskQueue &queue = *m_queues[q];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      for (Index i = n_tasks - 1; i >= 1; --i) {
+        queue.tasks.push_back(Task{&group, i});
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_n_queued += n_tasks - 1;
+    }
+    m_cv.notify_all();
+
+    _run(Task{&group, 0});
+    while (group.n_remaining.load() != 0) {
+      Task t;
+      if (_try_pop(q, t)) {
+        _run(t);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [&]() {
+        return group.n_remaining.load() == 0 || m_n_queued.load() > 0;
+      });
+    }
+    if (group.error) {
+      std::rethrow_exception(group.error);
+    }
+  }
+
+ private:
+  static Index &this_queue_index() {
+    thread_local Index index = 0;
+    return index;
+  }
+
+  /// \brief Start workers, so there are `n_threads() - 1` in total
+  void _start_workers() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Index n_workers = std::min(m_n_threads.load(), max_n_queues) - 1;
+    while (m_n_queues <= n_workers) {
+      Index q = m_n_queues.load();
+      m_queues[q] = std::make_unique<TaskQueue>();
+      m_n_queues = q + 1;
+      std::thread([this, q]() { _work(q); }).detach();
+    }
+  }
+
+  void _work(Index q) {
+    this_queue_index() = q;
+    while (true) {
+      Task t;
+      if (q < m_n_threads.load() && _try_pop(q, t)) {
+        _run(t);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [&]() {
+        return q < m_n_threads.load() && m_n_queued.load() > 0;
+      });
+    }
+  }
+
+  /// \brief Pop from the back of queue `q`, else steal from the front of
+  ///     another queue
+  bool _try_pop(Index q, Task &t) {
+    {
+      TaskQueue &queue = *m_queues[q];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        t = queue.tasks.back();
+        queue.tasks.pop_back();
+        --m_n_queued;
+        return true;
+      }
+    }
+    Index n_queues = m_n_queues.load();
+    for (Index k = 1; k < n_queues; ++k) {
+      TaskQueue &queue = *m_queues[(q + k) % n_queues];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        t = queue.tasks.front();
+        queue.tasks.pop_front();
+        --m_n_queued;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void _run(Task const &t) {
+    TaskGroup &group = *t.group;
+    try {
+      group.task(t.index);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(group.error_mutex);
+      if (!group.error) {
+        group.error = std::current_exception();
+      }
+    }
+    // `group` may be destroyed by its waiting thread once this is 0
+    if (group.n_remaining.fetch_sub(1) == 1) {
+      { std::lock_guard<std::mutex> lock(m_mutex); }
+      m_cv.notify_all();
+    }
+  }
+
+  std::mutex m_mutex;
+
+  std::condition_variable m_cv;
+
+  std::atomic<Index> m_n_threads;
+
+  /// Number of tasks in all queues
+  std::atomic<Index> m_n_queued;
+
+  /// Number of queues constructed, 1 + the number of workers
+  std::atomic<Index> m_n_queues;
+
+  /// Queues are constructed before they are counted in `m_n_queues`, and not
+  /// destroyed, so they can be read without locking `m_mutex`
+  std::array<std::unique_ptr<TaskQueue>, max_n_queues> m_queues;
+};
+
+ThreadPool &thread_pool() {
+  // not destroyed, because worker threads are not joined
+  static ThreadPool *pool = new ThreadPool();
+  return *pool;
+}
+
+}  // namespace
+
+/// \brief Return the default number of threads used by parallel functions
+///
+/// This is used when a function is called with `n_threads` <= 0, and it is
+/// the size of the process-wide thread pool used by `parallel_for_chunks`.
+/// It is `std::thread::hardware_concurrency()`, or 1 if that is not
+/// available, unless set by `set_default_n_threads`.
+Index default_n_threads() { return thread_pool().n_threads(); }
+
+/// \brief Set the default number of threads used by parallel functions
+///
+/// \param n_threads Number of threads, including the calling thread, that
+///     run chunks of `parallel_for_chunks` concurrently. If <= 0, resets to
+///     `std::thread::hardware_concurrency()`. A value of 1 makes all
+///     parallel functions run on the calling thread.
+void set_default_n_threads(Index n_threads) {
+  thread_pool().set_n_threads(n_threads);
+}
+
+/// \brief Run `task(i)` for each `i` in `[0, n_tasks)` on the process-wide
+///     thread pool, and wait for all to finish
+///
+/// \param n_tasks Number of tasks
+/// \param task Function with signature `void task(Index i)`. It must be safe
+///     to call `task` concurrently.
+///
+/// Notes:
+/// - Tasks are run by at most `default_n_threads()` threads, including the
+///   calling thread, which runs task 0 and then runs queued tasks while it
+///   waits. Idle threads steal queued tasks from other threads.
+/// - Calls from inside a task are added to the same pool, so nested
+///   parallelism does not start more threads.
+/// - Pool threads never call into Python, so bindings may release the GIL
+///   around functions that use the pool.
+/// - If `default_n_threads()` is 1, or if called inside an OpenMP parallel
+///   region, tasks are run in order on the calling thread.
+/// - If any task throws, all tasks are finished and then the first
+///   exception caught is rethrown.
+void run_on_thread_pool(Index n_tasks, std::function<void(Index)> const &task) {
+  if (n_tasks <= 0) {
+    return;
+  }
+  bool run_serially = (n_tasks == 1 || default_n_threads() == 1);
+#ifdef _OPENMP
+  run_serially = run_serially || omp_in_parallel();
+#endif
+  if (run_serially) {
+    for (Index i = 0; i < n_tasks; ++i) {
+      task(i);
+    }
+    return;
+  }
+  thread_pool().run(n_tasks, task);
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -1,13 +1,17 @@
 #include "casm/configuration/supercell_name.hh"
 
-#include "casm/casm_io/container/stream_io.hh"
+#include <algorithm>
+#include <charconv>
+#include <sstream>
+
 #include "casm/crystallography/Lattice.hh"
 #include "casm/misc/CASM_Eigen_math.hh"
-#include "casm/misc/string_algorithm.hh"
 
 namespace CASM {
 namespace config {
 
+namespace {
+
 /// \brief Return a string representing the HNF of a matrix
 ///
 /// String format is: SCELV_A_B_C_D_E_F, where:
@@ -20,48 +24,100 @@ namespace config {
 /// - F: H(0,1),
 /// - H: hermite_normal_form(matrix)
 std::string hermite_normal_form_name(const Eigen::Matrix3l &matrix) {
-  std::string name_str;
-
   Eigen::Matrix3i H = hermite_normal_form(matrix.cast<int>()).first;
-  name_str = "SCEL";
-  std::stringstream tname;
-  // Consider using a for loop with HermiteCounter_impl::_canonical_unroll here
-  tname << H(0, 0) * H(1, 1) * H(2, 2) << "_" << H(0, 0) << "_" << H(1, 1)
-        << "_" << H(2, 2) << "_" << H(1, 2) << "_" << H(0, 2) << "_" << H(0, 1);
-  name_str.append(tname.str());
+  long values[7] = {long(H(0, 0)) * H(1, 1) * H(2, 2),
+                    H(0, 0),
+                    H(1, 1),
+                    H(2, 2),
+                    H(1, 2),
+                    H(0, 2),
+                    H(0, 1)};
 
-  return name_str;
+  // "SCEL", then 7 values, each with a separator or sign and <= 19 digits
+  char buffer[4 + 7 * 21];
+  char *const last = buffer + sizeof(buffer);
+  char *ptr = std::copy_n("SCEL", 4, buffer);
+  for (int k = 0; k < 7; ++k) {
+    if (k != 0) {
+      *ptr++ = '_';
+    }
+    ptr = std::to_chars(ptr, last, values[k]).ptr;
+  }
+  return std::string(buffer, ptr);
 }
 
+}  // namespace
+
 /// \brief Inverse function of `hermite_normal_form_name`
+///
+/// \param hermite_normal_form_name A supercell name, with format
+///     "SCELV_T00_T11_T22_T12_T02_T01"
+///
+/// \returns The upper triangular matrix, T, with elements read from
+///     `hermite_normal_form_name`
 Eigen::Matrix3l make_hermite_normal_form(std::string hermite_normal_form_name) {
-  std::vector<std::string> tokens;
-  try {
-    char_separator sep("SCEL_");
-    tokenizer tok(hermite_normal_form_name, sep);
-    std::copy_if(tok.begin(), tok.end(), std::back_inserter(tokens),
-                 [](const std::string &val) { return !val.empty(); });
-    if (tokens.size() != 7) {
-      throw std::invalid_argument(
-          "Error in make_supercell: supercell name format error");
+  std::string const &name = hermite_normal_form_name;
+  long values[7];
+  char const *ptr = name.data();
+  char const *const last = name.data() + name.size();
+  std::string error;
+  if (name.compare(0, 4, "SCEL") != 0) {
+    error = "missing \"SCEL\" prefix";
+  } else {
+    ptr += 4;
+    for (int k = 0; k < 7 && error.empty(); ++k) {
+      if (k != 0) {
+        if (ptr == last || *ptr != '_') {
+          error = "missing separator";
+          break;
+        }
+        ++ptr;
+      }
+      auto result = std::from_chars(ptr, last, values[k]);
+      if (result.ec != std::errc()) {
+        error = "invalid integer value";
+      }
+      ptr = result.ptr;
+    }
+    if (error.empty() && ptr != last) {
+      error = "unexpected trailing characters";
     }
-    Eigen::Matrix3l T;
-    auto cast = [](std::string val) { return std::stol(val); };
-    T << cast(tokens[1]), cast(tokens[6]), cast(tokens[5]), 0, cast(tokens[2]),
-        cast(tokens[4]), 0, 0, cast(tokens[3]);
-    return T;
-  } catch (std::exception &e) {
+  }
+  if (!error.empty()) {
     std::string format = "SCELV_T00_T11_T22_T12_T02_T01";
     std::stringstream ss;
     ss << "Error in make_hermite_normal_form: "
        << "expected format: " << format << ", "
        << "name: |" << hermite_normal_form_name << "|"
        << ", "
-       << "tokens: " << tokens << ", "
-       << "tokens.size(): " << tokens.size() << ", "
-       << "error: " << e.what();
+       << "error: " << error;
     throw std::runtime_error(ss.str());
   }
+  Eigen::Matrix3l T;
+  T << values[1], values[6], values[5], 0, values[2], values[4], 0, 0,
+      values[3];
+  return T;
+}
+
+/// \brief Make the supercell name from a transformation matrix
+///
+/// The supercell name is a string generated from the hermite normal form,
+/// H, of `transformation_matrix_to_super`. See `make_supercell_name(
+/// xtal::Lattice const &, xtal::Lattice const&)` for the format.
+///
+/// This uses integer operations only, and should be preferred when the
+/// transformation matrix is known. For an existing Supercell, use
+/// `Supercell::name`, which is computed once on construction.
+///
+/// \param transformation_matrix_to_super The transformation matrix, T,
+///     where S = L * T, with S and L the superlattice and prim lattice
+///     vectors, as columns of a matrix.
+///
+/// \returns A name for the superlattice
+///
+std::string make_supercell_name(
+    Eigen::Matrix3l const &transformation_matrix_to_super) {
+  return hermite_normal_form_name(transformation_matrix_to_super);
 }
 
 /// \brief Make the supercell name of a superlattice
@@ -96,9 +152,8 @@ Eigen::Matrix3l make_hermite_normal_form(std::string hermite_normal_form_name) {
 ///
 std::string make_supercell_name(xtal::Lattice const &prim_lattice,
                                 xtal::Lattice const &superlattice) {
-  Eigen::Matrix3l T = xtal::make_transformation_matrix_to_super(
-      prim_lattice, superlattice, prim_lattice.tol());
-  return hermite_normal_form_name(T);
+  return make_supercell_name(xtal::make_transformation_matrix_to_super(
+      prim_lattice, superlattice, prim_lattice.tol()));
 }
 
 /// \brief Construct a superlattice from the supercell name
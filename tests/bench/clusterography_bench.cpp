@@ -0,0 +1,94 @@
+#include "benchmark/benchmark.h"
+#include "casm/configuration/clusterography/ClusterSpecs.hh"
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/configuration/occ_events/OccEventCounter.hh"
+#include "casm/configuration/occ_events/OccSystem.hh"
+#include "casm/configuration/sym_info/factor_group.hh"
+#include "casm/configuration/sym_info/unitcellcoord_sym_info.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief make_prim_periodic_orbits, for clusters of up to
+///     n = state.range(0) sites
+void bench_make_prim_periodic_orbits(benchmark::State &state,
+                                     xtal::BasicStructure const &structure,
+                                     double cutoff) {
+  auto prim = std::make_shared<xtal::BasicStructure const>(structure);
+  auto factor_group = sym_info::make_factor_group(*prim);
+  auto unitcellcoord_symgroup_rep =
+      sym_info::make_unitcellcoord_symgroup_rep(factor_group->element, *prim);
+  clust::SiteFilterFunction site_filter = clust::all_sites_filter;
+  std::vector<double> max_length(state.range(0) + 1, cutoff);
+  max_length[0] = 0.0;
+  max_length[1] = 0.0;
+  std::vector<clust::IntegralClusterOrbitGenerator> custom_generators = {};
+  Index n_orbits = 0;
+  for (auto _ : state) {
+    auto orbits = make_prim_periodic_orbits(prim, unitcellcoord_symgroup_rep,
+                                            site_filter, max_length,
+                                            custom_generators);
+    n_orbits = orbits.size();
+    benchmark::DoNotOptimize(orbits);
+  }
+  state.counters["n_orbits"] = n_orbits;
+}
+
+void BM_MakePrimPeriodicOrbits_FCC(benchmark::State &state) {
+  bench_make_prim_periodic_orbits(state, test::FCC_binary_prim(), 6.01);
+}
+BENCHMARK(BM_MakePrimPeriodicOrbits_FCC)
+    ->DenseRange(2, 4)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_MakePrimPeriodicOrbits_BCC(benchmark::State &state) {
+  bench_make_prim_periodic_orbits(state, test::BCC_binary_prim(), 4.01);
+}
+BENCHMARK(BM_MakePrimPeriodicOrbits_BCC)
+    ->DenseRange(2, 4)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_MakePrimPeriodicOrbits_ZrO(benchmark::State &state) {
+  bench_make_prim_periodic_orbits(state, test::ZrO_prim(), 5.17);
+}
+BENCHMARK(BM_MakePrimPeriodicOrbits_ZrO)
+    ->DenseRange(2, 3)
+    ->Unit(benchmark::kMillisecond);
+
+/// \brief OccEventCounter, for FCC binary triplet events
+///
+/// If state.range(0) is non-zero, allow subcluster events and direct
+/// exchange.
+void BM_OccEventCounter_FCC(benchmark::State &state) {
+  auto prim =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  auto system = std::make_shared<occ_events::OccSystem const>(
+      prim, occ_events::make_chemical_name_list(*prim, factor_group->element));
+  std::vector<clust::IntegralCluster> clusters(
+      {clust::IntegralCluster({xtal::UnitCellCoord(0, 0, 0, 0),
+                               xtal::UnitCellCoord(0, 1, 0, 0),
+                               xtal::UnitCellCoord(0, 0, 1, 0)})});
+  occ_events::OccEventCounterParameters params;
+  if (state.range(0)) {
+    params.allow_subcluster_events = true;
+    params.skip_direct_exchange = false;
+  }
+  Index count = 0;
+  for (auto _ : state) {
+    occ_events::OccEventCounter counter(system, clusters, params);
+    while (!counter.is_finished()) {
+      benchmark::DoNotOptimize(counter.value());
+      counter.advance();
+      ++count;
+    }
+  }
+  state.SetItemsProcessed(count);
+}
+BENCHMARK(BM_OccEventCounter_FCC)->Arg(0)->Arg(1);
+
+}  // namespace
@@ -0,0 +1,192 @@
+#include <random>
+
+#include "benchmark/benchmark.h"
+#include "casm/clexulator/DoFSpace.hh"
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/TimeReversalCanonicalizer.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/config_space_analysis.hh"
+#include "casm/configuration/dof_space_analysis.hh"
+#include "casm/configuration/enumeration/ConfigEnumAllOccupations.hh"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Make a configuration with random occupation, using a fixed seed
+config::Configuration make_random_configuration(
+    std::shared_ptr<config::Prim const> const &prim, Index n) {
+  Eigen::Matrix3l T = n * Eigen::Matrix3l::Identity();
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration configuration(supercell);
+  std::mt19937 engine(0);
+  auto const &basis = prim->basicstructure->basis();
+  Index n_vol = supercell->unitcell_index_converter.total_sites();
+  Eigen::VectorXi &occupation = configuration.dof_values.occupation;
+  for (Index l = 0; l < occupation.size(); ++l) {
+    int n_occupants = basis[l / n_vol].occupant_dof().size();
+    std::uniform_int_distribution<int> distribution(0, n_occupants - 1);
+    occupation(l) = distribution(engine);
+  }
+  return configuration;
+}
+
+/// \brief make_canonical_form, for T = n * I, with n = state.range(0)
+void bench_make_canonical_form(benchmark::State &state,
+                               xtal::BasicStructure const &structure) {
+  auto prim = config::make_shared_prim(structure);
+  config::Configuration configuration =
+      make_random_configuration(prim, state.range(0));
+  auto const &supercell = configuration.supercell;
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(make_canonical_form(configuration, begin, end));
+  }
+  state.counters["n_sites"] = configuration.dof_values.occupation.size();
+  Index n_ops = 0;
+  for (auto it = begin; it != end; ++it) {
+    ++n_ops;
+  }
+  state.counters["n_ops"] = n_ops;
+}
+
+void BM_MakeCanonicalForm_FCC(benchmark::State &state) {
+  bench_make_canonical_form(state, test::FCC_binary_prim());
+}
+BENCHMARK(BM_MakeCanonicalForm_FCC)->DenseRange(1, 3);
+
+void BM_MakeCanonicalForm_BCC(benchmark::State &state) {
+  bench_make_canonical_form(state, test::BCC_binary_prim());
+}
+BENCHMARK(BM_MakeCanonicalForm_BCC)->DenseRange(1, 3);
+
+void BM_MakeCanonicalForm_ZrO(benchmark::State &state) {
+  bench_make_canonical_form(state, test::ZrO_prim());
+}
+BENCHMARK(BM_MakeCanonicalForm_ZrO)->DenseRange(1, 3);
+
+/// \brief Make a configuration with random occupation and, if present,
+///     random continuous Cmagspin values, using a fixed seed
+config::Configuration make_random_magnetic_configuration(
+    std::shared_ptr<config::Prim const> const &prim, Index n) {
+  config::Configuration configuration = make_random_configuration(prim, n);
+  auto &local_dof_values = configuration.dof_values.local_dof_values;
+  auto it = local_dof_values.find("Cmagspin");
+  if (it != local_dof_values.end()) {
+    std::mt19937 engine(1);
+    std::uniform_int_distribution<int> distribution(-1, 1);
+    for (Index i = 0; i < it->second.size(); ++i) {
+      it->second(i) = distribution(engine);
+    }
+  }
+  return configuration;
+}
+
+/// \brief Canonical forms of magnetic configurations, for T = n * I, with
+///     n = state.range(0), using `make_canonical_form` (if
+///     `use_time_reversal` is false) or TimeReversalCanonicalizer
+void bench_magnetic_canonical_form(benchmark::State &state,
+                                   xtal::BasicStructure const &structure,
+                                   bool use_time_reversal) {
+  auto prim = config::make_shared_prim(structure);
+  config::Configuration configuration =
+      make_random_magnetic_configuration(prim, state.range(0));
+  auto const &supercell = configuration.supercell;
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  config::TimeReversalCanonicalizer canonicalizer(supercell);
+  for (auto _ : state) {
+    if (use_time_reversal) {
+      benchmark::DoNotOptimize(
+          canonicalizer.make_canonical_form(configuration));
+    } else {
+      benchmark::DoNotOptimize(
+          make_canonical_form(configuration, begin, end));
+    }
+  }
+  state.counters["n_sites"] = configuration.dof_values.occupation.size();
+}
+
+void BM_MakeCanonicalForm_Ising(benchmark::State &state) {
+  bench_magnetic_canonical_form(state, test::SimpleCubic_ising_prim(), false);
+}
+BENCHMARK(BM_MakeCanonicalForm_Ising)->DenseRange(2, 4);
+
+void BM_TimeReversalCanonicalForm_Ising(benchmark::State &state) {
+  bench_magnetic_canonical_form(state, test::SimpleCubic_ising_prim(), true);
+}
+BENCHMARK(BM_TimeReversalCanonicalForm_Ising)->DenseRange(2, 4);
+
+void BM_MakeCanonicalForm_Cmagspin(benchmark::State &state) {
+  bench_magnetic_canonical_form(state, test::FCC_binary_Cmagspin_prim(),
+                                false);
+}
+BENCHMARK(BM_MakeCanonicalForm_Cmagspin)->DenseRange(1, 3);
+
+void BM_TimeReversalCanonicalForm_Cmagspin(benchmark::State &state) {
+  bench_magnetic_canonical_form(state, test::FCC_binary_Cmagspin_prim(),
+                                true);
+}
+BENCHMARK(BM_TimeReversalCanonicalForm_Cmagspin)->DenseRange(1, 3);
+
+/// \brief config_space_analysis of all occupations of the FCC conventional
+///     cell
+void BM_ConfigSpaceAnalysis_FCC(benchmark::State &state) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  std::set<Index> sites;
+  for (Index l = 0; l < background.dof_values.occupation.size(); ++l) {
+    sites.insert(l);
+  }
+  std::map<std::string, config::Configuration> configurations;
+  config::ConfigEnumAllOccupations enumerator(background, sites);
+  while (enumerator.is_valid()) {
+    configurations.emplace(std::to_string(configurations.size()),
+                           enumerator.value());
+    enumerator.advance();
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(config::config_space_analysis(configurations));
+  }
+  state.counters["n_configurations"] = configurations.size();
+}
+BENCHMARK(BM_ConfigSpaceAnalysis_FCC)->Unit(benchmark::kMillisecond);
+
+/// \brief dof_space_analysis of a prim DoF space
+void bench_dof_space_analysis(benchmark::State &state,
+                              xtal::BasicStructure const &structure,
+                              DoFKey dof_key) {
+  auto xtal_prim = std::make_shared<xtal::BasicStructure const>(structure);
+  auto prim = config::make_shared_prim(xtal_prim);
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity();
+  clexulator::DoFSpace dof_space(dof_key, xtal_prim, T, std::nullopt,
+                                 std::nullopt);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(config::dof_space_analysis(dof_space, prim));
+  }
+}
+
+void BM_DoFSpaceAnalysis_FCC_occ(benchmark::State &state) {
+  bench_dof_space_analysis(state, test::FCC_ternary_prim(), "occ");
+}
+BENCHMARK(BM_DoFSpaceAnalysis_FCC_occ)->Unit(benchmark::kMillisecond);
+
+void BM_DoFSpaceAnalysis_ZrO_occ(benchmark::State &state) {
+  bench_dof_space_analysis(state, test::ZrO_prim(), "occ");
+}
+BENCHMARK(BM_DoFSpaceAnalysis_ZrO_occ)->Unit(benchmark::kMillisecond);
+
+void BM_DoFSpaceAnalysis_FCC_disp(benchmark::State &state) {
+  bench_dof_space_analysis(state, test::FCC_binary_disp_prim(), "disp");
+}
+BENCHMARK(BM_DoFSpaceAnalysis_FCC_disp)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,59 @@
+#include "benchmark/benchmark.h"
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/enumeration/ConfigEnumAllOccupations.hh"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief ConfigEnumAllOccupations throughput, for T = diag(1, 1, n), with
+///     n = state.range(0)
+void bench_enum_all_occupations(benchmark::State &state,
+                                xtal::BasicStructure const &structure) {
+  auto prim = config::make_shared_prim(structure);
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity();
+  T(2, 2) = state.range(0);
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  std::set<Index> sites;
+  for (Index l = 0; l < background.dof_values.occupation.size(); ++l) {
+    sites.insert(l);
+  }
+  Index count = 0;
+  for (auto _ : state) {
+    config::ConfigEnumAllOccupations enumerator(background, sites);
+    while (enumerator.is_valid()) {
+      benchmark::DoNotOptimize(enumerator.value());
+      enumerator.advance();
+      ++count;
+    }
+  }
+  state.SetItemsProcessed(count);
+}
+
+void BM_ConfigEnumAllOccupations_FCC(benchmark::State &state) {
+  bench_enum_all_occupations(state, test::FCC_binary_prim());
+}
+BENCHMARK(BM_ConfigEnumAllOccupations_FCC)->RangeMultiplier(2)->Range(4, 16);
+
+void BM_ConfigEnumAllOccupations_BCC(benchmark::State &state) {
+  bench_enum_all_occupations(state, test::BCC_binary_prim());
+}
+BENCHMARK(BM_ConfigEnumAllOccupations_BCC)->RangeMultiplier(2)->Range(4, 16);
+
+void BM_ConfigEnumAllOccupations_ZrO(benchmark::State &state) {
+  bench_enum_all_occupations(state, test::ZrO_prim());
+}
+BENCHMARK(BM_ConfigEnumAllOccupations_ZrO)->DenseRange(1, 4);
+
+void BM_ConfigEnumAllOccupations_Ising(benchmark::State &state) {
+  bench_enum_all_occupations(state, test::SimpleCubic_ising_prim());
+}
+BENCHMARK(BM_ConfigEnumAllOccupations_Ising)
+    ->RangeMultiplier(2)
+    ->Range(4, 16);
+
+}  // namespace
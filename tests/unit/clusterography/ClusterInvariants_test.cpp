@@ -0,0 +1,59 @@
+#include "casm/configuration/clusterography/ClusterInvariants.hh"
+
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/Coordinate.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
+#include "casm/misc/CASM_math.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+// ClusterInvariantsCalculator gives the same coordinates and invariants as
+// xtal::UnitCellCoord::coordinate
+TEST(ClusterInvariantsTest, Test1) {
+  xtal::BasicStructure prim = test::ZrO_prim();
+  double tol = prim.lattice().tol();
+  clust::ClusterInvariantsCalculator calculator(prim);
+
+  clust::IntegralCluster cluster({xtal::UnitCellCoord(0, 0, 0, 0),
+                                  xtal::UnitCellCoord(2, 1, 0, 0),
+                                  xtal::UnitCellCoord(3, 0, -1, 1)});
+  clust::IntegralCluster phenomenal({xtal::UnitCellCoord(1, 0, 0, 0)});
+
+  for (auto const &site : cluster) {
+    EXPECT_TRUE(CASM::almost_equal(calculator.cart(site),
+                                   site.coordinate(prim).const_cart(), tol));
+  }
+
+  clust::ClusterInvariants invariants(cluster, prim);
+  clust::ClusterInvariants calculated = calculator(cluster);
+  EXPECT_EQ(invariants.size(), 3);
+  EXPECT_EQ(invariants.distances().size(), 3);
+  EXPECT_TRUE(std::is_sorted(invariants.distances().begin(),
+                             invariants.distances().end()));
+  EXPECT_TRUE(clust::almost_equal(invariants, calculated, tol));
+
+  std::vector<double> expected;
+  for (Index i = 0; i < cluster.size(); ++i) {
+    for (Index j = i + 1; j < cluster.size(); ++j) {
+      expected.push_back((cluster[i].coordinate(prim).const_cart() -
+                          cluster[j].coordinate(prim).const_cart())
+                             .norm());
+    }
+  }
+  std::sort(expected.begin(), expected.end());
+  for (Index i = 0; i < expected.size(); ++i) {
+    EXPECT_TRUE(
+        CASM::almost_equal(invariants.distances()[i], expected[i], tol));
+  }
+
+  clust::ClusterInvariants local_invariants(cluster, phenomenal, prim);
+  EXPECT_EQ(local_invariants.phenomenal_distances().size(), 3);
+  EXPECT_TRUE(clust::almost_equal(local_invariants,
+                                  calculator(cluster, phenomenal), tol));
+  EXPECT_FALSE(clust::compare(local_invariants,
+                              calculator(cluster, phenomenal), tol));
+}
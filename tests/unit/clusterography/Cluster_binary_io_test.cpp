@@ -0,0 +1,83 @@
+#include "casm/configuration/clusterography/io/binary/Cluster_binary_io.hh"
+
+#include <fstream>
+#include <sstream>
+
+#include "casm/configuration/clusterography/ClusterSpecs.hh"
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/configuration/sym_info/factor_group.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+std::vector<std::set<clust::IntegralCluster>> make_FCC_orbits() {
+  auto prim =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  clust::ClusterSpecs cluster_specs(prim, factor_group);
+  cluster_specs.max_length = {0, 0, 4.01, 4.01};
+  return clust::make_orbits(cluster_specs);
+}
+
+}  // namespace
+
+TEST(ClusterBinaryIOTest, Orbits) {
+  auto orbits = make_FCC_orbits();
+  ASSERT_EQ(orbits.size(), 6);
+
+  std::stringstream ss;
+  write_orbits_binary(orbits, ss, "key");
+  ClusterBinaryReader reader(ss);
+  EXPECT_EQ(reader.key(), "key");
+  EXPECT_FALSE(reader.is_equivalents_info());
+  EXPECT_EQ(reader.n_orbits(), orbits.size());
+  EXPECT_EQ(reader.orbit_size(3), orbits[3].size());
+  EXPECT_EQ(reader.orbit(3), orbits[3]);
+  EXPECT_EQ(reader.orbits(), orbits);
+  EXPECT_THROW(reader.equivalents_info(), std::runtime_error);
+
+  // memory-mapped
+  test::TmpDir tmp_dir;
+  fs::path path = tmp_dir.path() / "orbits.bin";
+  {
+    std::ofstream out(path, std::ios::binary);
+    write_orbits_binary(orbits, out, "key");
+  }
+  ClusterBinaryReader mapped(path);
+  EXPECT_EQ(mapped.key(), "key");
+  EXPECT_EQ(mapped.orbits(), orbits);
+
+  // truncated data is invalid
+  std::string data = ss.str();
+  std::stringstream truncated(data.substr(0, data.size() - 1));
+  EXPECT_THROW(read_orbits_binary(truncated), std::runtime_error);
+}
+
+TEST(ClusterBinaryIOTest, EquivalentsInfo) {
+  auto orbits = make_FCC_orbits();
+  clust::EquivalentsInfo equivalents_info;
+  Index op_index = 0;
+  for (auto const &cluster : orbits[2]) {
+    equivalents_info.phenomenal_clusters.push_back(cluster);
+    equivalents_info.equivalent_generating_op_indices.push_back(op_index);
+    op_index += 3;
+  }
+
+  std::stringstream ss;
+  write_equivalents_info_binary(equivalents_info, ss);
+  ClusterBinaryReader reader(ss);
+  EXPECT_TRUE(reader.is_equivalents_info());
+  EXPECT_EQ(reader.key(), "");
+  EXPECT_EQ(reader.n_clusters(), orbits[2].size());
+  clust::EquivalentsInfo read = reader.equivalents_info();
+  EXPECT_EQ(read.phenomenal_clusters, equivalents_info.phenomenal_clusters);
+  EXPECT_EQ(read.equivalent_generating_op_indices,
+            equivalents_info.equivalent_generating_op_indices);
+  EXPECT_THROW(reader.orbits(), std::runtime_error);
+}
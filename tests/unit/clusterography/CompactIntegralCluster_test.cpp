@@ -0,0 +1,84 @@
+#include "casm/configuration/clusterography/CompactIntegralCluster.hh"
+
+#include "casm/configuration/clusterography/ClusterSpecs.hh"
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/configuration/group/Group.hh"
+#include "casm/configuration/sym_info/factor_group.hh"
+#include "casm/configuration/sym_info/unitcellcoord_sym_info.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/UnitCellCoordRep.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(CompactIntegralClusterTest, Test1) {
+  clust::IntegralCluster cluster({xtal::UnitCellCoord(1, 0, -1, 2),
+                                  xtal::UnitCellCoord(0, 0, 0, 0),
+                                  xtal::UnitCellCoord(0, 0, -1, 2)});
+  clust::CompactIntegralCluster compact(cluster);
+  EXPECT_EQ(compact.size(), 3);
+  EXPECT_EQ(compact.element(0), cluster.element(0));
+  EXPECT_EQ(compact.sublattice(0), 1);
+  EXPECT_EQ(compact.to_integral_cluster(), cluster);
+
+  // sort
+  compact.sort();
+  EXPECT_EQ(compact.to_integral_cluster(), cluster.sorted());
+
+  // translate
+  clust::CompactIntegralCluster translated(cluster);
+  translated += xtal::UnitCell(1, 2, 3);
+  clust::IntegralCluster expected = cluster;
+  expected += xtal::UnitCell(1, 2, 3);
+  EXPECT_EQ(translated.to_integral_cluster(), expected);
+  translated -= xtal::UnitCell(1, 2, 3);
+  EXPECT_EQ(translated, clust::CompactIntegralCluster(cluster));
+
+  // hash
+  clust::CompactIntegralClusterHash hash;
+  EXPECT_EQ(hash(translated), hash(clust::CompactIntegralCluster(cluster)));
+
+  // max_size
+  std::vector<xtal::UnitCellCoord> sites;
+  for (Index i = 0; i < clust::CompactIntegralCluster::max_size + 1; ++i) {
+    sites.emplace_back(0, i, 0, 0);
+  }
+  EXPECT_THROW(clust::CompactIntegralCluster(clust::IntegralCluster(sites)),
+               std::runtime_error);
+}
+
+// orbits converted to compact form are sorted, and compare consistently
+// with IntegralCluster
+TEST(CompactIntegralClusterTest, Test2) {
+  auto prim = std::make_shared<xtal::BasicStructure const>(test::ZrO_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  auto unitcellcoord_symgroup_rep =
+      sym_info::make_unitcellcoord_symgroup_rep(factor_group->element, *prim);
+  clust::SiteFilterFunction site_filter = clust::all_sites_filter;
+  std::vector<double> max_length = {0, 0, 5.17, 5.17};
+  std::vector<clust::IntegralClusterOrbitGenerator> custom_generators = {};
+
+  auto orbits =
+      make_prim_periodic_orbits(prim, unitcellcoord_symgroup_rep, site_filter,
+                                max_length, custom_generators);
+  auto compact_orbits = clust::make_compact_orbits(orbits);
+  ASSERT_EQ(compact_orbits.size(), orbits.size());
+
+  std::vector<clust::IntegralCluster> all;
+  std::vector<clust::CompactIntegralCluster> all_compact;
+  for (Index i = 0; i < orbits.size(); ++i) {
+    EXPECT_TRUE(
+        std::is_sorted(compact_orbits[i].begin(), compact_orbits[i].end()));
+    EXPECT_EQ(clust::make_integral_cluster_orbit(compact_orbits[i]),
+              orbits[i]);
+    all.insert(all.end(), orbits[i].begin(), orbits[i].end());
+    all_compact.insert(all_compact.end(), compact_orbits[i].begin(),
+                       compact_orbits[i].end());
+  }
+  for (Index i = 1; i < all.size(); ++i) {
+    EXPECT_EQ(all[i - 1] < all[i], all_compact[i - 1] < all_compact[i]);
+    EXPECT_EQ(all[i] < all[i - 1], all_compact[i] < all_compact[i - 1]);
+  }
+}
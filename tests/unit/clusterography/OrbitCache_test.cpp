@@ -0,0 +1,78 @@
+#include "casm/configuration/clusterography/OrbitCache.hh"
+
+#include "casm/configuration/clusterography/ClusterSpecs.hh"
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/group/Group.hh"
+#include "casm/configuration/sym_info/factor_group.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+clust::ClusterSpecs make_FCC_cluster_specs(std::vector<double> max_length) {
+  auto prim =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  clust::ClusterSpecs cluster_specs(prim, factor_group);
+  cluster_specs.max_length = max_length;
+  return cluster_specs;
+}
+
+}  // namespace
+
+TEST(OrbitCacheTest, Test1) {
+  clust::ClusterSpecs cluster_specs =
+      make_FCC_cluster_specs({0, 0, 4.01, 4.01});
+  clust::OrbitCache cache;
+
+  auto orbits = cache.make_orbits(cluster_specs);
+  EXPECT_EQ(*orbits, clust::make_orbits(cluster_specs));
+  EXPECT_EQ(orbits->size(), 6);
+  EXPECT_EQ(cache.size(), 1);
+
+  // equal specs, constructed separately, share orbits
+  clust::ClusterSpecs other = make_FCC_cluster_specs({0, 0, 4.01, 4.01});
+  EXPECT_EQ(cache.make_orbits(other), orbits);
+  EXPECT_EQ(cache.size(), 1);
+
+  // different specs do not
+  clust::ClusterSpecs different = make_FCC_cluster_specs({0, 0, 4.01});
+  auto different_orbits = cache.make_orbits(different);
+  EXPECT_NE(different_orbits, orbits);
+  EXPECT_EQ(different_orbits->size(), 4);
+  EXPECT_EQ(cache.size(), 2);
+
+  // custom site filters are not cached
+  clust::ClusterSpecs custom = make_FCC_cluster_specs({0, 0, 4.01, 4.01});
+  custom.site_filter_method = "custom";
+  EXPECT_FALSE(clust::make_orbit_cache_key(custom).has_value());
+  auto custom_orbits = cache.make_orbits(custom);
+  EXPECT_NE(custom_orbits, orbits);
+  EXPECT_EQ(*custom_orbits, *orbits);
+  EXPECT_EQ(cache.size(), 2);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(OrbitCacheTest, Test2) {
+  test::TmpDir tmp_dir;
+  clust::ClusterSpecs cluster_specs =
+      make_FCC_cluster_specs({0, 0, 4.01, 4.01});
+  std::string hash =
+      clust::make_orbit_cache_hash(*clust::make_orbit_cache_key(cluster_specs));
+
+  clust::OrbitCache cache(tmp_dir.path());
+  auto orbits = cache.make_orbits(cluster_specs);
+  EXPECT_TRUE(fs::exists(tmp_dir.path() / (hash + ".orbits")));
+
+  // a new cache reads the orbit file
+  clust::OrbitCache other_cache(tmp_dir.path());
+  auto read_orbits = other_cache.make_orbits(cluster_specs);
+  EXPECT_NE(read_orbits, orbits);
+  EXPECT_EQ(*read_orbits, *orbits);
+}
@@ -0,0 +1,67 @@
+#include "casm/configuration/clusterography/OrbitTable.hh"
+
+#include "casm/configuration/clusterography/ClusterSpecs.hh"
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/configuration/group/Group.hh"
+#include "casm/configuration/sym_info/factor_group.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(OrbitTableTest, Test1) {
+  auto prim = std::make_shared<xtal::BasicStructure const>(test::ZrO_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  clust::ClusterSpecs cluster_specs(prim, factor_group);
+  cluster_specs.max_length = {0, 0, 5.17, 5.17};
+  auto orbits = clust::make_orbits(cluster_specs);
+
+  clust::OrbitTable table = clust::make_orbit_table(orbits);
+  EXPECT_EQ(table.n_orbits(), orbits.size());
+  Index c = 0;
+  for (Index o = 0; o < orbits.size(); ++o) {
+    EXPECT_EQ(table.orbit_size(o), orbits[o].size());
+    for (auto const &cluster : orbits[o]) {
+      EXPECT_EQ(table.cluster_size(c), cluster.size());
+      EXPECT_EQ(table.cluster(c), cluster);
+      ++c;
+    }
+  }
+  EXPECT_EQ(table.n_clusters(), c);
+  EXPECT_EQ(table.sites.rows(), table.cluster_offsets(table.n_clusters()));
+  EXPECT_EQ(clust::make_orbits(table), orbits);
+
+  // empty
+  clust::OrbitTable empty_table = clust::make_orbit_table({});
+  EXPECT_EQ(empty_table.n_orbits(), 0);
+  EXPECT_EQ(empty_table.n_clusters(), 0);
+  EXPECT_TRUE(clust::make_orbits(empty_table).empty());
+}
+
+TEST(OrbitTableTest, Test2) {
+  auto prim = std::make_shared<xtal::BasicStructure const>(test::ZrO_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  clust::ClusterSpecs cluster_specs(prim, factor_group);
+  cluster_specs.max_length = {0, 0, 5.17, 5.17};
+  auto orbits = clust::make_orbits(cluster_specs);
+
+  Eigen::Matrix3l T;
+  T << 3, 0, 0, 0, 3, 0, 0, 0, 3;
+  xtal::UnitCellCoordIndexConverter converter(T, prim->basis().size());
+  auto orbits_as_indices = clust::make_orbits_as_indices(orbits, converter);
+
+  clust::OrbitIndexTable index_table =
+      clust::make_orbit_index_table(orbits_as_indices);
+  EXPECT_EQ(index_table.n_orbits(), orbits_as_indices.size());
+  EXPECT_EQ(clust::make_orbits_as_indices(index_table), orbits_as_indices);
+
+  clust::OrbitIndexTable index_table_from_table =
+      clust::make_orbit_index_table(clust::make_orbit_table(orbits), converter);
+  EXPECT_EQ(index_table_from_table.sites, index_table.sites);
+  EXPECT_EQ(index_table_from_table.cluster_offsets,
+            index_table.cluster_offsets);
+  EXPECT_EQ(index_table_from_table.orbit_offsets, index_table.orbit_offsets);
+}
@@ -0,0 +1,80 @@
+#include "casm/configuration/clusterography/SiteNeighborList.hh"
+
+#include "casm/configuration/clusterography/ClusterSpecs.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/Coordinate.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+// test FCC_binary_prim
+TEST(SiteNeighborListTest, Test1) {
+  auto prim = test::FCC_binary_prim();
+  clust::SiteNeighborList neighbor_list(prim, 4.01, clust::all_sites_filter);
+
+  // shells: the site itself, nearest neighbors, and next nearest neighbors
+  ASSERT_EQ(neighbor_list.shells().size(), 3);
+  EXPECT_NEAR(neighbor_list.shells()[0], 0.0, 1e-10);
+  EXPECT_NEAR(neighbor_list.shells()[1], 2.0 * std::sqrt(2.0), 1e-10);
+  EXPECT_NEAR(neighbor_list.shells()[2], 4.0, 1e-10);
+
+  auto const &neighbors = neighbor_list.neighbors(0);
+  EXPECT_EQ(neighbors.size(), 1 + 12 + 6);
+  std::vector<Index> shell_count(3, 0);
+  for (auto const &neighbor : neighbors) {
+    ++shell_count[neighbor.shell];
+    double d = (neighbor.site.coordinate(prim) -
+                xtal::UnitCellCoord(0, 0, 0, 0).coordinate(prim))
+                   .const_cart()
+                   .norm();
+    EXPECT_NEAR(neighbor.distance, d, 1e-10);
+  }
+  EXPECT_EQ(shell_count, std::vector<Index>({1, 12, 6}));
+
+  // distance uses translation symmetry
+  xtal::UnitCellCoord site_a(0, 1, 2, 3);
+  for (auto const &neighbor : neighbors) {
+    xtal::UnitCellCoord site_b(0, neighbor.site.unitcell() + site_a.unitcell());
+    EXPECT_NEAR(neighbor_list.distance(site_a, site_b), neighbor.distance,
+                1e-10);
+  }
+  EXPECT_TRUE(std::isinf(neighbor_list.distance(
+      xtal::UnitCellCoord(0, 0, 0, 0), xtal::UnitCellCoord(0, 3, 0, 0))));
+
+  // origin neighborhood
+  EXPECT_EQ(neighbor_list.origin_neighborhood(4.01).size(), 19);
+  EXPECT_EQ(neighbor_list.origin_neighborhood(3.0).size(), 13);
+  EXPECT_EQ(neighbor_list.origin_neighborhood(3.0),
+            clust::max_length_neighborhood(3.0)(prim, clust::all_sites_filter));
+  EXPECT_THROW(neighbor_list.origin_neighborhood(5.0), std::runtime_error);
+}
+
+// test ZrO (some sites with no DoF)
+TEST(SiteNeighborListTest, Test2) {
+  auto prim = test::ZrO_prim();
+  clust::SiteFilterFunction site_filter = clust::dof_sites_filter();
+  clust::SiteNeighborList neighbor_list(prim, 5.17, site_filter);
+
+  for (Index b = 0; b < prim.basis().size(); ++b) {
+    EXPECT_EQ(neighbor_list.is_included(b), site_filter(prim.basis()[b]));
+    for (auto const &neighbor : neighbor_list.neighbors(b)) {
+      EXPECT_TRUE(neighbor_list.is_included(neighbor.site.sublattice()));
+      EXPECT_LT(neighbor.distance, 5.17);
+    }
+  }
+
+  // all included sites within the radius of any origin unit cell site
+  for (auto const &site : neighbor_list.origin_neighborhood(5.17)) {
+    EXPECT_TRUE(neighbor_list.is_included(site.sublattice()));
+    double min_distance = std::numeric_limits<double>::infinity();
+    for (Index b = 0; b < prim.basis().size(); ++b) {
+      double d = (site.coordinate(prim) -
+                  xtal::UnitCellCoord(b, 0, 0, 0).coordinate(prim))
+                     .const_cart()
+                     .norm();
+      min_distance = std::min(min_distance, d);
+    }
+    EXPECT_LT(min_distance, 5.17);
+  }
+}
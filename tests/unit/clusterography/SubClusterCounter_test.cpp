@@ -0,0 +1,60 @@
+#include "casm/configuration/clusterography/SubClusterCounter.hh"
+
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/configuration/sym_info/factor_group.hh"
+#include "casm/configuration/sym_info/unitcellcoord_sym_info.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/UnitCellCoordRep.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(DistinctSubClusterCounterTest, Test1) {
+  auto prim =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  auto unitcellcoord_symgroup_rep =
+      sym_info::make_unitcellcoord_symgroup_rep(factor_group->element, *prim);
+
+  // nearest neighbor triplet and quadruplet
+  clust::IntegralCluster cluster({xtal::UnitCellCoord(0, 0, 0, 0),
+                                  xtal::UnitCellCoord(0, 1, 0, 0),
+                                  xtal::UnitCellCoord(0, 0, 1, 0)});
+  for (std::vector<Index> expected_multiplicity :
+       {std::vector<Index>({1, 3, 3, 1}),
+        std::vector<Index>({1, 4, 6, 4, 1})}) {
+    if (expected_multiplicity.size() == 5) {
+      cluster.elements().push_back(xtal::UnitCellCoord(0, 0, 0, 1));
+    }
+    auto site_reps = clust::make_prim_periodic_cluster_site_reps(
+        cluster, unitcellcoord_symgroup_rep);
+
+    // the identity leaves every cluster invariant
+    EXPECT_GT(site_reps.size(), 1);
+
+    clust::DistinctSubClusterCounter counter(cluster, site_reps);
+    std::vector<Index> multiplicity;
+    Index total = 0;
+    while (counter.valid()) {
+      // for these clusters, subclusters of equal size are equivalent
+      EXPECT_EQ(counter.value().size(), multiplicity.size());
+      multiplicity.push_back(counter.multiplicity());
+      total += counter.multiplicity();
+      counter.next();
+    }
+    EXPECT_EQ(multiplicity, expected_multiplicity);
+    EXPECT_EQ(total, Index(1) << cluster.size());
+  }
+
+  // with no cluster group operations, all subclusters are distinct
+  clust::DistinctSubClusterCounter counter(cluster, {});
+  clust::SubClusterCounter all_counter(cluster);
+  while (counter.valid()) {
+    EXPECT_EQ(counter.value(), all_counter.value());
+    EXPECT_EQ(counter.multiplicity(), 1);
+    counter.next();
+    all_counter.next();
+  }
+  EXPECT_FALSE(all_counter.valid());
+}
@@ -1,5 +1,7 @@
 #include "casm/configuration/clusterography/impact_neighborhood.hh"
 
+#include <algorithm>
+
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/casm_io/json/jsonParser.hh"
 #include "casm/configuration/clusterography/ClusterSpecs.hh"
@@ -10,6 +12,7 @@
 #include "casm/configuration/sym_info/factor_group.hh"
 #include "casm/configuration/sym_info/unitcellcoord_sym_info.hh"
 #include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
 #include "casm/crystallography/UnitCellCoordRep.hh"
 #include "gtest/gtest.h"
 #include "teststructures.hh"
@@ -85,6 +88,52 @@ TEST_F(FlowerNeighborhoodTest, Test2) {
   EXPECT_EQ(neighborhood.size(), 28);
 }
 
+TEST_F(FlowerNeighborhoodTest, NeighborhoodTable) {
+  clust::IntegralCluster phenomenal({xtal::UnitCellCoord(0, 0, 0, 0)});
+  std::set<xtal::UnitCellCoord> neighborhood;
+  add_to_flower_neighborhood(phenomenal, neighborhood, orbits);
+
+  std::vector<xtal::UnitCellCoord> flower =
+      make_flower_neighborhood(phenomenal, orbits);
+  EXPECT_EQ(flower, std::vector<xtal::UnitCellCoord>(neighborhood.begin(),
+                                                     neighborhood.end()));
+
+  clust::NeighborhoodTable table = make_flower_neighborhood_table(1, orbits);
+  ASSERT_EQ(table.n_sublattice(), 1);
+  ASSERT_EQ(table.neighborhood_size(0), 19);
+  for (Index s = 0; s < table.neighborhood_size(0); ++s) {
+    auto const &site = table.sites.row(s);
+    EXPECT_EQ(xtal::UnitCellCoord(site(0), site(1), site(2), site(3)),
+              flower[s]);
+  }
+
+  // supercell large enough that there are no periodic images
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  xtal::UnitCellCoordIndexConverter converter(T, 1);
+  clust::SupercellNeighborhoodTable supercell_table =
+      make_supercell_neighborhood_table(table, converter);
+  ASSERT_EQ(supercell_table.n_neighborhoods(), 64);
+  for (Index l = 0; l < 64; ++l) {
+    xtal::UnitCellCoord bijk = converter(l);
+    std::set<std::int32_t> expected;
+    for (auto const &site : neighborhood) {
+      expected.insert(converter(site + bijk.unitcell()));
+    }
+    EXPECT_EQ(std::vector<std::int32_t>(supercell_table.begin(l),
+                                        supercell_table.end(l)),
+              std::vector<std::int32_t>(expected.begin(), expected.end()));
+  }
+
+  // periodic images are removed
+  Eigen::Matrix3l T_small = Eigen::Matrix3l::Identity();
+  xtal::UnitCellCoordIndexConverter small_converter(T_small, 1);
+  clust::SupercellNeighborhoodTable small_table =
+      make_supercell_neighborhood_table(table, small_converter);
+  ASSERT_EQ(small_table.n_neighborhoods(), 1);
+  EXPECT_EQ(small_table.neighborhood_size(0), 1);
+  EXPECT_EQ(*small_table.begin(0), 0);
+}
+
 // test FCC_binary_prim - phenomenal == point cluster
 class LocalNeighborhoodTest : public testing::Test {
  protected:
@@ -134,6 +183,18 @@ TEST_F(LocalNeighborhoodTest, Test1) {
 
   // 19 + 19 - 10 overlap - 2 (does not include phenomenal sites)
   EXPECT_EQ(neighborhood.size(), 26);
+
+  std::vector<xtal::UnitCellCoord> local = make_local_neighborhood(orbits);
+  EXPECT_EQ(local, std::vector<xtal::UnitCellCoord>(neighborhood.begin(),
+                                                    neighborhood.end()));
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 4;
+  xtal::UnitCellCoordIndexConverter converter(T, 1);
+  clust::SupercellNeighborhoodTable table =
+      make_supercell_neighborhood_table({local}, converter);
+  ASSERT_EQ(table.n_neighborhoods(), 1);
+  EXPECT_EQ(table.neighborhood_size(0), 26);
+  EXPECT_TRUE(std::is_sorted(table.begin(0), table.end(0)));
 }
 
 TEST_F(LocalNeighborhoodTest, Test2) {
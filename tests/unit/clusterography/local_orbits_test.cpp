@@ -122,3 +122,45 @@ TEST(LocalOrbitTest, Test2) {
     EXPECT_EQ(orbit.size(), *orbit_size_it++);
   }
 }
+
+// test FCC_binary_prim - many phenomenal clusters, in parallel
+TEST(LocalOrbitTest, Test3) {
+  auto prim =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  auto factor_group_unitcellcoord_symgroup_rep =
+      sym_info::make_unitcellcoord_symgroup_rep(factor_group->element, *prim);
+  clust::SiteFilterFunction site_filter = clust::dof_sites_filter();
+  std::vector<double> max_length = {0, 0, 4.01, 4.01};
+  std::vector<double> cutoff_radius = {0, 4.01, 3.01, 3.01};
+  bool include_phenomenal_sites = false;
+
+  std::vector<clust::IntegralCluster> phenomenal_clusters = {
+      clust::IntegralCluster({xtal::UnitCellCoord(0, 0, 0, 0)}),
+      clust::IntegralCluster(
+          {xtal::UnitCellCoord(0, 0, 0, 0), xtal::UnitCellCoord(0, 0, 1, 0)}),
+      clust::IntegralCluster(
+          {xtal::UnitCellCoord(0, 1, 2, 3), xtal::UnitCellCoord(0, 1, 2, 4)}),
+      clust::IntegralCluster(
+          {xtal::UnitCellCoord(0, 0, 0, 0), xtal::UnitCellCoord(0, 1, 1, -1)})};
+  std::vector<std::shared_ptr<clust::SymGroup const>> cluster_groups;
+  for (auto const &phenomenal : phenomenal_clusters) {
+    cluster_groups.push_back(make_cluster_group(
+        phenomenal, factor_group, prim->lattice().lat_column_mat(),
+        factor_group_unitcellcoord_symgroup_rep));
+  }
+
+  auto all_orbits = make_local_orbits(prim, cluster_groups, site_filter,
+                                      max_length, {}, phenomenal_clusters,
+                                      cutoff_radius, include_phenomenal_sites,
+                                      /*n_threads=*/3);
+  ASSERT_EQ(all_orbits.size(), phenomenal_clusters.size());
+  for (Index i = 0; i < phenomenal_clusters.size(); ++i) {
+    auto unitcellcoord_symgroup_rep = sym_info::make_unitcellcoord_symgroup_rep(
+        cluster_groups[i]->element, *prim);
+    auto orbits = make_local_orbits(
+        prim, unitcellcoord_symgroup_rep, site_filter, max_length, {},
+        phenomenal_clusters[i], cutoff_radius, include_phenomenal_sites);
+    EXPECT_EQ(all_orbits[i], orbits);
+  }
+}
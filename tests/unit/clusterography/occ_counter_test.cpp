@@ -0,0 +1,82 @@
+#include "casm/configuration/clusterography/occ_counter.hh"
+
+#include <algorithm>
+#include <set>
+
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/configuration/group/Group.hh"
+#include "casm/configuration/sym_info/factor_group.hh"
+#include "casm/configuration/sym_info/occ_sym_info.hh"
+#include "casm/configuration/sym_info/unitcellcoord_sym_info.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/UnitCellCoordRep.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(CanonicalOccCounterTest, Test1) {
+  auto prim =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_dumbbell_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  auto unitcellcoord_symgroup_rep =
+      sym_info::make_unitcellcoord_symgroup_rep(factor_group->element, *prim);
+  sym_info::OccSymInfo occ_sym_info(factor_group->element, *prim);
+
+  // clang-format off
+  std::vector<clust::IntegralCluster> clusters({
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0)}),
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0),
+          xtal::UnitCellCoord(0, 0, 1, 0)})});
+  // clang-format on
+
+  for (auto const &cluster : clusters) {
+    auto cluster_group =
+        clust::make_cluster_group(cluster, factor_group,
+                                  prim->lattice().lat_column_mat(),
+                                  unitcellcoord_symgroup_rep);
+    std::vector<clust::ClusterOccSymOpRep> rep =
+        clust::make_cluster_occ_symgroup_rep(cluster, *cluster_group,
+                                             unitcellcoord_symgroup_rep,
+                                             occ_sym_info.occ_symgroup_rep);
+    EXPECT_EQ(rep.size(), cluster_group->element.size());
+
+    // expected: canonical occupations, in Counter order, and the number of
+    // distinct orbits
+    std::vector<std::vector<int>> expected;
+    std::set<std::vector<int>> canonical_forms;
+    Index n_occ = 0;
+    auto occ_counter = clust::make_occ_counter(cluster, *prim);
+    while (occ_counter.valid()) {
+      std::vector<int> const &occ = occ_counter();
+      std::vector<int> canonical_form = occ;
+      for (auto const &op : rep) {
+        canonical_form = std::max(canonical_form, clust::copy_apply(op, occ));
+      }
+      canonical_forms.insert(canonical_form);
+      if (clust::is_canonical_occ(occ, rep)) {
+        expected.push_back(occ);
+      }
+      ++n_occ;
+      ++occ_counter;
+    }
+    EXPECT_EQ(expected.size(), canonical_forms.size());
+
+    clust::CanonicalOccCounter counter(cluster, *prim, rep);
+    EXPECT_EQ(counter.values(), expected);
+    EXPECT_LT(counter.size(), n_occ);
+
+    Index n = 0;
+    while (counter.valid()) {
+      EXPECT_EQ(counter(), expected[n]);
+      ++n;
+      ++counter;
+    }
+    EXPECT_EQ(n, expected.size());
+  }
+}
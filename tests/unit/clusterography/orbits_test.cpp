@@ -4,8 +4,10 @@
 #include "casm/casm_io/json/jsonParser.hh"
 #include "casm/configuration/clusterography/ClusterInvariants.hh"
 #include "casm/configuration/clusterography/ClusterSpecs.hh"
+#include "casm/configuration/clusterography/IntegralCluster.hh"
 #include "casm/configuration/clusterography/io/json/IntegralCluster_json_io.hh"
 #include "casm/configuration/group/Group.hh"
+#include "casm/configuration/group/orbits.hh"
 #include "casm/configuration/sym_info/factor_group.hh"
 #include "casm/configuration/sym_info/unitcellcoord_sym_info.hh"
 #include "casm/crystallography/BasicStructure.hh"
@@ -240,3 +242,96 @@ TEST(PrimPeriodicOrbitTest, Test4) {
     EXPECT_EQ(orbit.begin()->size(), *cluster_size_it++);
   }
 }
+
+// test ZrO w/all_sites_filter, using multiple threads
+TEST(PrimPeriodicOrbitTest, Test5) {
+  auto prim = std::make_shared<xtal::BasicStructure const>(test::ZrO_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  auto unitcellcoord_symgroup_rep =
+      sym_info::make_unitcellcoord_symgroup_rep(factor_group->element, *prim);
+  clust::SiteFilterFunction site_filter = clust::all_sites_filter;
+  std::vector<double> max_length = {0, 0, 5.17, 5.17, 4.0};
+  std::vector<clust::IntegralClusterOrbitGenerator> custom_generators = {};
+
+  auto expected =
+      make_prim_periodic_orbits(prim, unitcellcoord_symgroup_rep, site_filter,
+                                max_length, custom_generators, 1);
+  for (Index n_threads : {2, 3, 0}) {
+    auto orbits =
+        make_prim_periodic_orbits(prim, unitcellcoord_symgroup_rep, site_filter,
+                                  max_length, custom_generators, n_threads);
+    EXPECT_EQ(orbits, expected);
+  }
+}
+
+// test extending FCC_binary orbits to larger max_length and more branches
+TEST(PrimPeriodicOrbitTest, Test6) {
+  auto prim =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  auto unitcellcoord_symgroup_rep =
+      sym_info::make_unitcellcoord_symgroup_rep(factor_group->element, *prim);
+  clust::SiteFilterFunction site_filter = clust::dof_sites_filter();
+  std::vector<double> prev_max_length = {0, 0, 2.9, 2.9};
+  std::vector<clust::IntegralClusterOrbitGenerator> custom_generators = {};
+
+  auto prev_orbits =
+      make_prim_periodic_orbits(prim, unitcellcoord_symgroup_rep, site_filter,
+                                prev_max_length, custom_generators);
+
+  std::vector<std::vector<double>> max_length_list = {
+      {0, 0, 2.9, 2.9}, {0, 0, 4.01, 4.01}, {0, 0, 4.01, 2.9, 2.9}};
+  for (auto const &max_length : max_length_list) {
+    auto expected =
+        make_prim_periodic_orbits(prim, unitcellcoord_symgroup_rep, site_filter,
+                                  max_length, custom_generators);
+    auto orbits = extend_prim_periodic_orbits(
+        prev_orbits, prev_max_length, prim, unitcellcoord_symgroup_rep,
+        site_filter, max_length, custom_generators);
+    EXPECT_EQ(orbits, expected);
+  }
+
+  // max_length may not decrease
+  EXPECT_THROW(extend_prim_periodic_orbits(
+                   prev_orbits, prev_max_length, prim,
+                   unitcellcoord_symgroup_rep, site_filter, {0, 0, 2.0, 2.9},
+                   custom_generators),
+               std::runtime_error);
+}
+
+// orbits and canonical elements made with scratch storage are the same as
+// made by copying
+TEST(PrimPeriodicOrbitTest, WithScratch) {
+  auto prim =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  auto unitcellcoord_symgroup_rep =
+      sym_info::make_unitcellcoord_symgroup_rep(factor_group->element, *prim);
+  auto begin = unitcellcoord_symgroup_rep.begin();
+  auto end = unitcellcoord_symgroup_rep.end();
+  std::less<clust::IntegralCluster> compare_f;
+
+  std::vector<clust::IntegralCluster> clusters(
+      {clust::IntegralCluster(),
+       clust::IntegralCluster({{0, 0, 0, 0}, {0, 1, 0, 0}}),
+       clust::IntegralCluster({{0, 0, 0, 0}, {0, 1, 1, 0}, {0, 2, 0, -1}})});
+  for (auto const &cluster : clusters) {
+    EXPECT_EQ(group::make_orbit_with_scratch(
+                  cluster, begin, end, compare_f,
+                  clust::prim_periodic_integral_cluster_apply_to),
+              group::make_orbit(
+                  cluster, begin, end, compare_f,
+                  clust::prim_periodic_integral_cluster_copy_apply));
+    EXPECT_EQ(group::make_canonical_element_with_scratch(
+                  cluster, begin, end, compare_f,
+                  clust::prim_periodic_integral_cluster_apply_to),
+              group::make_canonical_element(
+                  cluster, begin, end, compare_f,
+                  clust::prim_periodic_integral_cluster_copy_apply));
+    EXPECT_EQ(group::make_orbit_with_scratch(
+                  cluster, begin, end, compare_f,
+                  clust::local_integral_cluster_apply_to),
+              group::make_orbit(cluster, begin, end, compare_f,
+                                clust::local_integral_cluster_copy_apply));
+  }
+}
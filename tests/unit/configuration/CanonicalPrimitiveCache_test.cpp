@@ -0,0 +1,95 @@
+#include "casm/configuration/CanonicalPrimitiveCache.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Return the canonical form in the configuration's supercell, using all
+/// supercell operations
+config::Configuration make_expected_canonical_form(
+    config::Configuration const &configuration) {
+  return config::make_canonical_form(
+      configuration, config::SupercellSymOp::begin(configuration.supercell),
+      config::SupercellSymOp::end(configuration.supercell));
+}
+
+}  // namespace
+
+TEST(CanonicalPrimitiveCacheTest, ViaPrimitiveOccupation) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+
+  // motif: conventional FCC cell
+  Eigen::Matrix3l T_motif;
+  T_motif << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto motif_supercell =
+      std::make_shared<config::Supercell const>(prim, T_motif);
+  config::Configuration motif(motif_supercell);
+  motif.dof_values.occupation << 0, 1, 2, 1;
+
+  Eigen::Matrix3l T;
+  T << -2, 2, 2, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  config::CanonicalPrimitiveCache cache;
+  std::shared_ptr<config::Configuration const> canonical_primitive;
+  for (auto const &configuration :
+       config::make_all_super_configurations(motif, supercell)) {
+    config::Configuration expected =
+        make_expected_canonical_form(configuration);
+    EXPECT_EQ(config::make_canonical_form_via_primitive(configuration),
+              expected);
+
+    auto result = cache.make_canonical_form(configuration);
+    EXPECT_EQ(result.first, expected);
+    EXPECT_EQ(*result.second, config::make_in_canonical_supercell(
+                                  config::make_primitive(configuration)));
+
+    // all are equivalent as infinite crystals
+    if (!canonical_primitive) {
+      canonical_primitive = result.second;
+    }
+    EXPECT_EQ(*result.second, *canonical_primitive);
+    EXPECT_EQ(*cache.canonical_primitive(configuration), *canonical_primitive);
+  }
+  EXPECT_GT(cache.size(), 0);
+
+  // the motif itself, in its own supercell, has the same canonical primitive
+  EXPECT_EQ(*cache.canonical_primitive(motif), *canonical_primitive);
+
+  cache.set_max_size(1);
+  EXPECT_EQ(cache.size(), 1);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(CanonicalPrimitiveCacheTest, ViaPrimitiveContinuousDoF) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+
+  Eigen::Matrix3l T_motif;
+  T_motif << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto motif_supercell =
+      std::make_shared<config::Supercell const>(prim, T_motif);
+  config::Configuration motif(motif_supercell);
+  motif.dof_values.occupation << 1, 0;
+  motif.dof_values.local_dof_values.at("disp")(0, 0) = 0.01;
+  motif.dof_values.local_dof_values.at("disp")(2, 1) = -0.02;
+  motif.dof_values.global_dof_values.at("GLstrain")(0) = 0.01;
+
+  Eigen::Matrix3l T;
+  T << 4, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  for (auto const &configuration :
+       config::make_all_super_configurations(motif, supercell)) {
+    EXPECT_EQ(config::make_canonical_form_via_primitive(configuration),
+              make_expected_canonical_form(configuration));
+  }
+}
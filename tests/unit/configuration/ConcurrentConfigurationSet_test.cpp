@@ -0,0 +1,64 @@
+#include "casm/configuration/ConcurrentConfigurationSet.hh"
+
+#include <thread>
+
+#include "casm/configuration/Prim.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(ConcurrentConfigurationSetTest, Test1) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  config::ConcurrentSupercellSet supercells(prim);
+
+  // each thread inserts configurations into its own supercell
+  std::vector<Eigen::Matrix3l> T_list(4);
+  T_list[0] << 1, 0, 0, 0, 1, 0, 0, 0, 1;
+  T_list[1] << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  T_list[2] << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  T_list[3] << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+
+  auto insert_all = [&](auto &configurations, Index i) {
+    auto supercell = supercells.insert(T_list[i]).first->supercell;
+    config::Configuration configuration(supercell);
+    Eigen::VectorXi &occ = configuration.dof_values.occupation;
+    for (Index trial = 0; trial < 10; ++trial) {
+      occ.setZero();
+      occ(trial % occ.size()) = 1 + trial % 2;
+      configurations.insert(configuration);
+    }
+  };
+
+  config::ConcurrentConfigurationSet concurrent({}, 3);
+  std::vector<std::thread> threads;
+  for (Index i = 0; i < Index(T_list.size()); ++i) {
+    threads.emplace_back([&, i]() { insert_all(concurrent, i); });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(supercells.size(), T_list.size());
+
+  config::ConfigurationSet expected;
+  for (Index i = 0; i < Index(T_list.size()); ++i) {
+    insert_all(expected, i);
+  }
+
+  ASSERT_EQ(concurrent.size(), expected.size());
+  config::ConfigurationSet result = concurrent.to_configuration_set();
+  auto it = expected.begin();
+  for (auto const &record : result) {
+    EXPECT_EQ(record.configuration, it->configuration);
+    EXPECT_EQ(record.configuration_name, it->configuration_name);
+    EXPECT_EQ(concurrent.count(record.configuration), 1);
+    ++it;
+  }
+  EXPECT_EQ(result.next_config_id(), expected.next_config_id());
+
+  // insert_canonical finds existing supercells
+  auto const &name = supercells.insert(T_list[0]).first->supercell_name;
+  auto res = supercells.insert_canonical(name);
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(res.first, supercells.find_canonical_by_name(name));
+}
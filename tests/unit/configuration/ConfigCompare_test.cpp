@@ -156,3 +156,169 @@ TEST_F(ConfigCompareFCCTest, Test4) {
     --l_expected;
   }
 }
+
+TEST(ConfigCompareRebindTest, FCCTernaryGLStrainDisp) {
+  // a rebound comparator gives the same results as a new comparator
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  std::vector<config::Configuration> configurations;
+  for (Index i = 0; i < 3; ++i) {
+    config::Configuration configuration(supercell);
+    configuration.dof_values.occupation(i) = 1;
+    configuration.dof_values.occupation(3) = 2;
+    configuration.dof_values.local_dof_values.at("disp")(0, i) = 0.01 * i;
+    configuration.dof_values.global_dof_values.at("GLstrain")(i) = 0.01;
+    configurations.push_back(configuration);
+  }
+
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  config::ConfigIsEquivalent rebound_equal_to_f(configurations[0]);
+  config::ConfigCompare rebound_compare_f(configurations[0]);
+  for (auto const &configuration : configurations) {
+    rebound_equal_to_f.rebind(configuration);
+    rebound_compare_f.rebind(configuration);
+    EXPECT_EQ(&rebound_equal_to_f.config(), &configuration);
+    config::ConfigIsEquivalent equal_to_f(configuration);
+    config::ConfigCompare compare_f(configuration);
+    for (auto it = begin; it != end; ++it) {
+      EXPECT_EQ(rebound_equal_to_f(*it), equal_to_f(*it));
+      EXPECT_EQ(rebound_compare_f(*it), compare_f(*it));
+      for (auto const &other : configurations) {
+        EXPECT_EQ(rebound_equal_to_f(*it, other), equal_to_f(*it, other));
+        EXPECT_EQ(rebound_compare_f(*it, other), compare_f(*it, other));
+      }
+    }
+  }
+
+  // rebinding to a configuration in a different supercell throws
+  Eigen::Matrix3l T_other = Eigen::Matrix3l::Identity();
+  config::Configuration other(
+      std::make_shared<config::Supercell const>(prim, T_other));
+  EXPECT_THROW(rebound_equal_to_f.rebind(other), std::runtime_error);
+}
+
+namespace {
+
+/// Check that the comparator selected by ConfigIsEquivalent is `Expected`
+/// and gives the same results as the general comparator
+template <typename Expected>
+void check_specialized_is_equivalent(
+    xtal::BasicStructure const &structure,
+    std::set<std::string> const &which_dofs) {
+  using namespace config::ConfigIsEquivalentImpl;
+  auto prim = config::make_shared_prim(structure);
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  double tol = prim->basicstructure->lattice().tol();
+
+  std::vector<config::Configuration> configurations;
+  for (Index i = 0; i < 3; ++i) {
+    config::Configuration configuration(supercell);
+    if (prim->sym_info.has_occupation_dofs) {
+      configuration.dof_values.occupation(i) = 1;
+    }
+    for (auto &dof : configuration.dof_values.global_dof_values) {
+      dof.second(i) = 0.01;
+    }
+    for (auto &dof : configuration.dof_values.local_dof_values) {
+      dof.second(0, i) = 0.01 * i;
+    }
+    configurations.push_back(configuration);
+  }
+
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  auto perms = supercell->sym_info().combined_permutation_table();
+  for (auto const &configuration : configurations) {
+    config::ConfigIsEquivalent equal_to_f(configuration, tol, which_dofs);
+    GeneralIsEquivalent general_f(configuration, tol, which_dofs, perms);
+    bool is_expected = equal_to_f.visit([](auto const &f) {
+      return std::is_same_v<std::decay_t<decltype(f)>, Expected>;
+    });
+    EXPECT_TRUE(is_expected);
+
+    for (auto A = begin; A != end; ++A) {
+      EXPECT_EQ(equal_to_f(*A), general_f(*A));
+      if (!general_f(*A)) {
+        EXPECT_EQ(equal_to_f.is_less(), general_f.is_less());
+      }
+      for (auto const &other : configurations) {
+        bool result = general_f(*A, other);
+        EXPECT_EQ(equal_to_f(*A, other), result);
+        if (!result) {
+          EXPECT_EQ(equal_to_f.is_less(), general_f.is_less());
+        }
+        result = general_f(*A, *begin, other);
+        EXPECT_EQ(equal_to_f(*A, *begin, other), result);
+        if (!result) {
+          EXPECT_EQ(equal_to_f.is_less(), general_f.is_less());
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(ConfigIsEquivalentImplTest, SpecializedComparators) {
+  using namespace config::ConfigIsEquivalentImpl;
+  // occupation only
+  check_specialized_is_equivalent<
+      FixedDoFIsEquivalent<true, false, false, false>>(test::FCC_ternary_prim(),
+                                                       {"all"});
+  // anisotropic occupation only
+  check_specialized_is_equivalent<
+      FixedDoFIsEquivalent<true, true, false, false>>(
+      test::SimpleCubic_ising_prim(), {"all"});
+  // occupation and strain
+  check_specialized_is_equivalent<
+      FixedDoFIsEquivalent<true, false, true, false>>(
+      test::FCC_ternary_GLstrain_prim(), {"all"});
+  // occupation and displacement
+  check_specialized_is_equivalent<
+      FixedDoFIsEquivalent<true, false, false, true>>(
+      test::FCC_binary_disp_prim(), {"all"});
+  // displacement and strain
+  check_specialized_is_equivalent<
+      FixedDoFIsEquivalent<false, false, true, true>>(
+      test::FCC_ternary_GLstrain_disp_prim(), {"disp", "GLstrain"});
+  // occupation, displacement, and strain
+  check_specialized_is_equivalent<GeneralIsEquivalent>(
+      test::FCC_ternary_GLstrain_disp_prim(), {"all"});
+  // occupation and strain, with displacement not compared
+  check_specialized_is_equivalent<
+      FixedDoFIsEquivalent<true, false, true, false>>(
+      test::FCC_ternary_GLstrain_disp_prim(), {"occ", "GLstrain"});
+}
+
+TEST(ConfigCompareLazyTest, NoSymInfoWithoutOperations) {
+  // comparisons without operations do not construct the supercell symmetry
+  // info or its combined permutation table
+  for (auto const &structure : {test::FCC_binary_prim(),
+                                test::FCC_ternary_GLstrain_disp_prim()}) {
+    auto prim = config::make_shared_prim(structure);
+    Eigen::Matrix3l T;
+    T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+    auto supercell = std::make_shared<config::Supercell const>(prim, T);
+    config::Configuration A(supercell);
+    config::Configuration B(supercell);
+    B.dof_values.occupation(0) = 1;
+
+    EXPECT_TRUE(A < B);
+    EXPECT_FALSE(B < A);
+    config::ConfigIsEquivalent equal_to_f(A);
+    EXPECT_FALSE(equal_to_f(B));
+    EXPECT_FALSE(supercell->has_sym_info());
+
+    // the table is obtained on first use with an operation
+    auto begin = config::SupercellSymOp::begin(supercell);
+    EXPECT_TRUE(equal_to_f(*begin));
+    EXPECT_FALSE(equal_to_f(*begin, B));
+    EXPECT_TRUE(supercell->has_sym_info());
+  }
+}
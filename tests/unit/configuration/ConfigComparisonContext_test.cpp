@@ -0,0 +1,90 @@
+#include "casm/configuration/ConfigComparisonContext.hh"
+
+#include <thread>
+
+#include "casm/configuration/ConfigCompare.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/parallel.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(ConfigComparisonContextTest, Test1) {
+  using namespace config;
+  auto prim = make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto supercell = std::make_shared<Supercell const>(prim, T);
+  Configuration configuration(supercell);
+  configuration.dof_values.occupation(0) = 1;
+  configuration.dof_values.local_dof_values.at("disp")(0, 1) = 0.01;
+  configuration.dof_values.global_dof_values.at("GLstrain")(0) = 0.02;
+
+  std::vector<SupercellSymOp> ops(SupercellSymOp::begin(supercell),
+                                  SupercellSymOp::end(supercell));
+  ASSERT_GT(ops.size(), 1);
+
+  // one shared definition, one context per thread, same results as a
+  // serial ConfigIsEquivalent and ConfigCompare
+  ConfigComparisonDefinition definition(configuration);
+  EXPECT_EQ(&definition.config(), &configuration);
+  Index n_threads = 4;
+  std::vector<std::vector<char>> is_equal(n_threads);
+  std::vector<std::vector<char>> is_less(n_threads);
+  std::vector<std::thread> threads;
+  for (Index t = 0; t < n_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      ConfigComparisonContext context = definition.make_context();
+      for (Index k = 0; k < 10; ++k) {
+        for (auto const &A : ops) {
+          for (auto const &B : ops) {
+            if (k == 0) {
+              is_equal[t].push_back(context.equal(A, B));
+              is_less[t].push_back(context.less(A, B));
+            } else {
+              context.less(A, B);
+            }
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  ConfigIsEquivalent equal_to_f(configuration);
+  ConfigCompare compare_f(equal_to_f);
+  std::vector<char> expected_equal;
+  std::vector<char> expected_less;
+  for (auto const &A : ops) {
+    for (auto const &B : ops) {
+      expected_equal.push_back(equal_to_f(A, B));
+      expected_less.push_back(compare_f(A, B));
+    }
+  }
+  for (Index t = 0; t < n_threads; ++t) {
+    EXPECT_EQ(is_equal[t], expected_equal);
+    EXPECT_EQ(is_less[t], expected_less);
+  }
+
+  // parallel canonical form matches serial
+  EXPECT_EQ(make_canonical_form(configuration, ops.begin(), ops.end(), 4),
+            make_canonical_form(configuration, ops.begin(), ops.end()));
+
+  // shared SupercellSymOp: translation permutation into caller storage
+  SupercellSymOp const &op = ops.back();
+  sym_info::Permutation expected = op.translation_permute();
+  parallel_for_chunks(
+      100, n_threads, [&](Index chunk_index, Index begin, Index end) {
+        sym_info::Permutation permute;
+        for (Index i = begin; i < end; ++i) {
+          op.translation_permute(permute);
+          EXPECT_EQ(permute, expected);
+        }
+      });
+}
@@ -0,0 +1,203 @@
+#include "casm/configuration/ConfigurationBatch.hh"
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/make_simple_structure.hh"
+#include "casm/configuration/parallel.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Make configurations with occupation, strain, and displacement values
+std::vector<config::Configuration> make_test_configurations(
+    std::shared_ptr<config::Supercell const> const &supercell) {
+  std::vector<config::Configuration> configurations;
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  for (Index trial = 0; trial < 6; ++trial) {
+    config::Configuration configuration(supercell);
+    auto &dof_values = configuration.dof_values;
+    for (Index l = 0; l < n_sites; ++l) {
+      dof_values.occupation(l) = (l + trial) % 3 == 0 ? 1 : 0;
+    }
+    if (trial % 2) {
+      dof_values.global_dof_values.at("GLstrain")(0) = 0.01 * trial;
+      dof_values.local_dof_values.at("disp")(2, trial % n_sites) = 0.1;
+    }
+    configurations.push_back(configuration);
+  }
+  return configurations;
+}
+
+}  // namespace
+
+TEST(ConfigurationBatchTest, SetAndGet) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto configurations = make_test_configurations(supercell);
+
+  config::ConfigurationBatch batch(supercell, configurations.size());
+  EXPECT_EQ(batch.size(), configurations.size());
+  EXPECT_EQ(batch.n_sites(), 4);
+  EXPECT_EQ(batch.global_dof_values.at("GLstrain").cols(), 6);
+  EXPECT_EQ(batch.local_dof_values.at("disp").cols(), 12);
+  for (Index i = 0; i < configurations.size(); ++i) {
+    batch.set(i, configurations[i]);
+  }
+
+  // local values are stored column-major per configuration
+  EXPECT_EQ(batch.local_dof_values.at("disp")(1, 1 * 3 + 2), 0.1);
+
+  for (Index i = 0; i < configurations.size(); ++i) {
+    EXPECT_TRUE(batch.configuration(i) == configurations[i]);
+  }
+
+  batch.resize(2);
+  EXPECT_EQ(batch.size(), 2);
+  batch.push_back(configurations[5]);
+  EXPECT_EQ(batch.size(), 3);
+  EXPECT_TRUE(batch.configuration(1) == configurations[1]);
+  EXPECT_TRUE(batch.configuration(2) == configurations[5]);
+
+  // occupation only
+  config::ConfigurationBatch occ_batch(supercell, 1, false);
+  EXPECT_EQ(occ_batch.global_dof_values.size(), 0);
+  EXPECT_EQ(occ_batch.local_dof_values.size(), 0);
+  occ_batch.set(0, configurations[1]);
+  config::Configuration occ_configuration = occ_batch.configuration(0);
+  EXPECT_EQ(occ_configuration.dof_values.occupation,
+            configurations[1].dof_values.occupation);
+  EXPECT_TRUE(occ_configuration.dof_values.global_dof_values.at("GLstrain")
+                  .isZero());
+
+  // wrong supercell
+  Eigen::Matrix3l T2 = Eigen::Matrix3l::Identity();
+  auto other_supercell = std::make_shared<config::Supercell const>(prim, T2);
+  EXPECT_THROW(batch.set(0, config::Configuration(other_supercell)),
+               std::runtime_error);
+}
+
+TEST(ConfigurationBatchTest, BatchedOperations) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto configurations = make_test_configurations(supercell);
+
+  config::ConfigurationBatch batch(supercell);
+  for (auto const &configuration : configurations) {
+    batch.push_back(configuration);
+  }
+
+  Index n_ops = supercell->sym_info().factor_group->element.size() *
+                supercell->unitcell_index_converter.total_sites();
+  for (Index n_threads : {1, 2}) {
+    config::ConfigurationBatch canonical =
+        make_canonical_forms(batch, n_threads);
+    auto primitive = is_primitive(batch, n_threads);
+    auto n_equivalents = make_n_equivalents(batch, n_threads);
+    ASSERT_EQ(canonical.size(), batch.size());
+    ASSERT_EQ(primitive.size(), batch.size());
+    ASSERT_EQ(n_equivalents.size(), batch.size());
+    for (Index i = 0; i < batch.size(); ++i) {
+      auto const &configuration = configurations[i];
+      EXPECT_TRUE(canonical.configuration(i) ==
+                  config::make_canonical_form(
+                      configuration, config::SupercellSymOp::begin(supercell),
+                      config::SupercellSymOp::end(supercell)));
+      EXPECT_EQ(primitive(i), config::is_primitive(configuration));
+      Index n_invariant =
+          config::make_invariant_subgroup(
+              configuration, config::SupercellSymOp::begin(supercell),
+              config::SupercellSymOp::end(supercell))
+              .size();
+      EXPECT_EQ(n_equivalents(i), n_ops / n_invariant);
+    }
+  }
+
+  config::AtomicStructures structures = make_atomic_structures(batch);
+  config::AtomicStructures expected = make_atomic_structures(configurations);
+  EXPECT_EQ(structures.n_structures(), expected.n_structures());
+  EXPECT_EQ(structures.atom_offsets, expected.atom_offsets);
+  EXPECT_TRUE(structures.coords.isApprox(expected.coords));
+}
+
+TEST(ConfigurationBatchTest, ConfigurationSet) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  std::string name = supercells.insert(T).first->canonical_supercell_name;
+  auto supercell = supercells.insert_canonical(name).first->supercell;
+  auto configurations = make_test_configurations(supercell);
+
+  config::ConfigurationBatch batch(supercell);
+  for (auto const &configuration : configurations) {
+    batch.push_back(configuration);
+  }
+  batch.push_back(configurations[0]);
+
+  config::ConfigurationSet configuration_set;
+  EXPECT_EQ(insert_batch(configuration_set, batch), configurations.size());
+  EXPECT_EQ(configuration_set.size(), configurations.size());
+  EXPECT_EQ(insert_batch(configuration_set, batch), 0);
+
+  std::vector<std::string> configuration_ids;
+  config::ConfigurationBatch extracted = make_configuration_batch(
+      configuration_set, supercell, &configuration_ids);
+  ASSERT_EQ(extracted.size(), configuration_set.size());
+  ASSERT_EQ(configuration_ids.size(), configuration_set.size());
+  Index i = 0;
+  for (auto const &record : configuration_set) {
+    EXPECT_EQ(configuration_ids[i], record.configuration_id);
+    EXPECT_TRUE(extracted.configuration(i) == record.configuration);
+    ++i;
+  }
+}
+
+TEST(ConfigurationBatchTest, CanonicalFormsFreshLargeSupercell) {
+  // Supercells with >= 4096 sites make their permutation tables with
+  // parallel_for_chunks; here that happens on first access, from inside the
+  // chunks of make_canonical_forms
+  config::set_default_n_threads(4);
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << 4096, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto reference = std::make_shared<config::Supercell const>(prim, T);
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  ASSERT_EQ(n_sites, 4096);
+  ASSERT_FALSE(supercell->has_sym_info());
+
+  config::ConfigurationBatch batch(supercell);
+  for (Index trial = 0; trial < 8; ++trial) {
+    config::Configuration configuration(supercell);
+    for (Index l = 0; l < n_sites; ++l) {
+      configuration.dof_values.occupation(l) = (l % (trial + 2) == 0) ? 1 : 0;
+    }
+    batch.push_back(configuration);
+  }
+
+  config::ConfigurationBatch canonical = make_canonical_forms(batch, 4);
+  EXPECT_TRUE(supercell->has_sym_info());
+  ASSERT_EQ(canonical.size(), batch.size());
+  for (Index i = 0; i < batch.size(); ++i) {
+    config::Configuration configuration(reference);
+    configuration.dof_values = batch.configuration(i).dof_values;
+    config::Configuration expected = config::make_canonical_form(
+        configuration, config::SupercellSymOp::begin(reference),
+        config::SupercellSymOp::end(reference));
+    EXPECT_EQ(canonical.configuration(i).dof_values.occupation,
+              expected.dof_values.occupation);
+  }
+  config::set_default_n_threads(0);
+}
@@ -0,0 +1,43 @@
+#include "casm/configuration/ConfigurationFingerprint.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(ConfigurationFingerprintTest, Test1) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  config::ConfigurationFingerprintCalculator calculator(prim, 4.01);
+  EXPECT_EQ(calculator.n_occupant_classes(), 3);
+  EXPECT_EQ(calculator.pair_orbits().size(), 2);
+
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index l = 0; l < occ.size(); ++l) {
+    occ(l) = (l * 7 + (l * l) % 5) % 3;
+  }
+
+  // equivalent configurations have equal fingerprints
+  config::ConfigurationFingerprint fingerprint = calculator(configuration);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto const &equiv : make_equivalents(configuration, begin, end)) {
+    EXPECT_EQ(calculator(equiv), fingerprint);
+    EXPECT_TRUE(
+        is_equivalent(configuration, fingerprint, equiv, calculator(equiv)));
+  }
+
+  // a configuration with different composition has a different fingerprint
+  config::Configuration other(configuration);
+  other.dof_values.occupation(0) = (occ(0) + 1) % 3;
+  config::ConfigurationFingerprint other_fingerprint = calculator(other);
+  EXPECT_NE(other_fingerprint, fingerprint);
+  EXPECT_FALSE(
+      is_equivalent(configuration, fingerprint, other, other_fingerprint));
+}
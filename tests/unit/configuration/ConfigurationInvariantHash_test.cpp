@@ -0,0 +1,68 @@
+#include "casm/configuration/ConfigurationInvariantHash.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(InvariantConfigurationHasherTest, Test1) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  auto hasher = std::make_shared<config::InvariantConfigurationHasher const>(
+      prim, std::vector<double>({0.0, 0.0, 4.01, 3.01}));
+  EXPECT_EQ(hasher->n_occupant_classes(), 3);
+  // point, 2 pairs, 1 triplet
+  EXPECT_EQ(hasher->orbits().size(), 4);
+
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index l = 0; l < occ.size(); ++l) {
+    occ(l) = (l * 7 + (l * l) % 5) % 3;
+  }
+
+  // equivalent configurations have equal hashes
+  std::uint64_t hash = (*hasher)(configuration);
+  std::vector<Index> counts = hasher->make_counts(configuration);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  std::vector<config::Configuration> equivalents =
+      make_equivalents(configuration, begin, end);
+  for (auto const &equiv : equivalents) {
+    EXPECT_EQ(hasher->make_counts(equiv), counts);
+    EXPECT_EQ((*hasher)(equiv), hash);
+  }
+
+  // point counts are the composition
+  Index n_sites = occ.size();
+  Index total = 0;
+  for (Index c = 0; c < 3; ++c) {
+    total += counts[c];
+  }
+  EXPECT_EQ(total, n_sites);
+
+  // a configuration with different composition has a different hash
+  config::Configuration other(configuration);
+  other.dof_values.occupation(0) = (occ(0) + 1) % 3;
+  EXPECT_NE((*hasher)(other), hash);
+
+  // container dedups equivalents, with or without exact verification
+  for (bool verify_exact : {false, true}) {
+    config::InvariantHashConfigurationSet distinct(hasher, verify_exact);
+    EXPECT_TRUE(distinct.insert(configuration).second);
+    for (auto const &equiv : equivalents) {
+      auto result = distinct.insert(equiv);
+      EXPECT_FALSE(result.second);
+      EXPECT_EQ(result.first->configuration, configuration);
+    }
+    EXPECT_TRUE(distinct.insert(other).second);
+    EXPECT_EQ(distinct.size(), 2);
+    EXPECT_EQ(distinct.count(equivalents.back()), 1);
+    distinct.clear();
+    EXPECT_EQ(distinct.count(configuration), 0);
+  }
+}
@@ -0,0 +1,395 @@
+#include "casm/configuration/io/binary/ConfigurationSet_binary_io.hh"
+
+#include <fstream>
+#include <sstream>
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Make configurations with occupation, strain, and displacement values in
+/// two canonical supercells
+config::ConfigurationSet make_test_configurations(
+    config::SupercellSet &supercells) {
+  std::vector<Eigen::Matrix3l> T_list(2);
+  T_list[0] << 1, 0, 0, 0, 1, 0, 0, 0, 1;
+  T_list[1] << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+
+  config::ConfigurationSet configurations;
+  Index count = 0;
+  for (auto const &T : T_list) {
+    std::string name = supercells.insert(T).first->canonical_supercell_name;
+    auto supercell = supercells.insert_canonical(name).first->supercell;
+    for (Index trial = 0; trial < 5; ++trial, ++count) {
+      config::Configuration configuration(supercell);
+      auto &dof_values = configuration.dof_values;
+      dof_values.occupation.setConstant(trial % 3);
+      dof_values.global_dof_values.at("GLstrain").setConstant(0.01 * count);
+      dof_values.local_dof_values.at("disp").setConstant(-0.02 * count);
+      configurations.insert(configuration);
+    }
+  }
+  return configurations;
+}
+
+}  // namespace
+
+TEST(ConfigurationSetBinaryIOTest, RoundTrip) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      make_test_configurations(supercells);
+  ASSERT_EQ(configurations.size(), 10);
+
+  for (bool compress : {false, true}) {
+    std::stringstream ss;
+    write_binary(configurations, ss, compress, 3);
+
+    config::SupercellSet read_supercells(prim);
+    config::ConfigurationSet read_configurations;
+    read_binary(read_supercells, read_configurations, ss);
+
+    ASSERT_EQ(read_configurations.size(), configurations.size());
+    auto it = configurations.begin();
+    for (auto const &record : read_configurations) {
+      EXPECT_EQ(record.configuration_name, it->configuration_name);
+      EXPECT_EQ(record.configuration.dof_values.occupation,
+                it->configuration.dof_values.occupation);
+      EXPECT_TRUE(record.configuration.dof_values.global_dof_values.at(
+                      "GLstrain") ==
+                  it->configuration.dof_values.global_dof_values.at(
+                      "GLstrain"));
+      EXPECT_TRUE(
+          record.configuration.dof_values.local_dof_values.at("disp") ==
+          it->configuration.dof_values.local_dof_values.at("disp"));
+      ++it;
+    }
+    EXPECT_EQ(read_configurations.next_config_id(),
+              configurations.next_config_id());
+  }
+}
+
+TEST(ConfigurationSetBinaryIOTest, RandomAccess) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      make_test_configurations(supercells);
+
+  std::stringstream ss;
+  write_binary(configurations, ss, true, 3);
+
+  config::SupercellSet read_supercells(prim);
+  ConfigurationSetBinaryReader reader(ss, read_supercells);
+  ASSERT_EQ(reader.size(), configurations.size());
+  EXPECT_EQ(reader.find_by_name("not_a_configuration"), reader.size());
+
+  // read by name, in reverse order, which requires seeking to each chunk
+  std::vector<config::ConfigurationRecord const *> records;
+  for (auto const &record : configurations) {
+    records.push_back(&record);
+  }
+  for (auto it = records.rbegin(); it != records.rend(); ++it) {
+    Index i = reader.find_by_name((*it)->configuration_name);
+    ASSERT_LT(i, reader.size());
+    config::ConfigurationRecord record = reader.read(i);
+    EXPECT_EQ(record.configuration_name, (*it)->configuration_name);
+    EXPECT_EQ(record.configuration.dof_values.occupation,
+              (*it)->configuration.dof_values.occupation);
+    EXPECT_TRUE(
+        record.configuration.dof_values.local_dof_values.at("disp") ==
+        (*it)->configuration.dof_values.local_dof_values.at("disp"));
+  }
+}
+
+TEST(ConfigurationSetBinaryIOTest, MappedReader) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      make_test_configurations(supercells);
+  fs::path path =
+      fs::temp_directory_path() / "casm_ConfigurationSet_mapped_test.bin";
+
+  for (bool compress : {false, true}) {
+    {
+      std::ofstream file(path, std::ios::binary);
+      write_binary(configurations, file, compress, 3);
+    }
+
+    config::SupercellSet read_supercells(prim);
+    ConfigurationSetMappedReader reader(path, read_supercells);
+    ASSERT_EQ(reader.size(), configurations.size());
+    EXPECT_EQ(reader.is_compressed(), compress);
+    EXPECT_EQ(reader.next_config_id(), configurations.next_config_id());
+    EXPECT_EQ(reader.find_by_name("not_a_configuration"), reader.size());
+    EXPECT_EQ(reader.find_by_name("SCEL1_1_1_1_0_0_0/100"), reader.size());
+
+    // name index is sorted
+    auto const &name_index = reader.name_index();
+    ASSERT_EQ(name_index.size(), reader.size());
+    for (Index k = 1; k < name_index.size(); ++k) {
+      std::pair<std::string, std::string> prev(
+          reader.supercell_name(name_index[k - 1]),
+          reader.configuration_id(name_index[k - 1]));
+      std::pair<std::string, std::string> curr(
+          reader.supercell_name(name_index[k]),
+          reader.configuration_id(name_index[k]));
+      EXPECT_LT(prev, curr);
+    }
+
+    // read by name, in reverse order
+    std::vector<config::ConfigurationRecord const *> records;
+    for (auto const &record : configurations) {
+      records.push_back(&record);
+    }
+    for (auto it = records.rbegin(); it != records.rend(); ++it) {
+      Index i = reader.find_by_name((*it)->configuration_name);
+      ASSERT_LT(i, reader.size());
+      EXPECT_EQ(reader.configuration_name(i), (*it)->configuration_name);
+      config::ConfigurationRecord record = reader.read(i);
+      EXPECT_EQ(record.configuration_name, (*it)->configuration_name);
+      EXPECT_EQ(record.configuration.dof_values.occupation,
+                (*it)->configuration.dof_values.occupation);
+      EXPECT_TRUE(
+          record.configuration.dof_values.global_dof_values.at("GLstrain") ==
+          (*it)->configuration.dof_values.global_dof_values.at("GLstrain"));
+      EXPECT_TRUE(
+          record.configuration.dof_values.local_dof_values.at("disp") ==
+          (*it)->configuration.dof_values.local_dof_values.at("disp"));
+    }
+
+    // find by supercell
+    Index n_found = 0;
+    for (auto const &record : configurations) {
+      auto range = reader.find_by_supercell(record.supercell_name);
+      EXPECT_EQ(range.second - range.first, 5);
+      for (Index k = range.first; k < range.second; ++k) {
+        EXPECT_EQ(reader.supercell_name(name_index[k]), record.supercell_name);
+      }
+      ++n_found;
+    }
+    EXPECT_EQ(n_found, 10);
+    auto range = reader.find_by_supercell("not_a_supercell");
+    EXPECT_EQ(range.first, range.second);
+  }
+  fs::remove(path);
+}
+
+TEST(ConfigurationSetBinaryIOTest, Writer) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      make_test_configurations(supercells);
+  fs::path path =
+      fs::temp_directory_path() / "casm_ConfigurationSet_writer_test.bin";
+
+  for (bool compress : {false, true}) {
+    {
+      ConfigurationSetBinaryWriter writer(path, compress, 3);
+      for (auto const &record : configurations) {
+        writer.write(record.supercell_name, record.configuration_id,
+                     record.configuration);
+      }
+      EXPECT_EQ(writer.size(), configurations.size());
+      writer.finish(configurations.next_config_id());
+    }
+    EXPECT_FALSE(fs::exists(path.string() + ".chunks"));
+
+    // same bytes as write_binary
+    std::stringstream expected;
+    write_binary(configurations, expected, compress, 3);
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream written;
+    written << file.rdbuf();
+    EXPECT_EQ(written.str(), expected.str());
+  }
+  fs::remove(path);
+
+  // not finished: nothing written
+  {
+    ConfigurationSetBinaryWriter writer(path, true, 3);
+    writer.write(configurations.begin()->supercell_name,
+                 configurations.begin()->configuration_id,
+                 configurations.begin()->configuration);
+  }
+  EXPECT_FALSE(fs::exists(path));
+  EXPECT_FALSE(fs::exists(path.string() + ".chunks"));
+}
+
+TEST(ConfigurationSetBinaryIOTest, SinglePrecision) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      make_test_configurations(supercells);
+  fs::path path =
+      fs::temp_directory_path() / "casm_ConfigurationSet_single_test.bin";
+
+  std::stringstream double_ss;
+  write_binary(configurations, double_ss, false, 3);
+  {
+    std::ofstream file(path, std::ios::binary);
+    write_binary(configurations, file, false, 3, true);
+  }
+  std::stringstream single_ss;
+  write_binary(configurations, single_ss, false, 3, true);
+  EXPECT_LT(single_ss.str().size(), double_ss.str().size());
+
+  // values are rounded to float, and promoted to double when read
+  auto expect_rounded = [](config::ConfigurationRecord const &record,
+                           config::ConfigurationRecord const &original) {
+    auto const &dof_values = record.configuration.dof_values;
+    auto const &original_values = original.configuration.dof_values;
+    EXPECT_EQ(dof_values.occupation, original_values.occupation);
+    EXPECT_TRUE(
+        dof_values.global_dof_values.at("GLstrain") ==
+        original_values.global_dof_values.at("GLstrain")
+            .cast<float>()
+            .cast<double>());
+    EXPECT_TRUE(dof_values.local_dof_values.at("disp") ==
+                original_values.local_dof_values.at("disp")
+                    .cast<float>()
+                    .cast<double>());
+  };
+
+  config::SupercellSet read_supercells(prim);
+  config::ConfigurationSet read_configurations;
+  read_binary(read_supercells, read_configurations, single_ss);
+  ASSERT_EQ(read_configurations.size(), configurations.size());
+  auto it = configurations.begin();
+  for (auto const &record : read_configurations) {
+    EXPECT_EQ(record.configuration_name, it->configuration_name);
+    expect_rounded(record, *it);
+    ++it;
+  }
+
+  ConfigurationSetMappedReader reader(path, read_supercells);
+  EXPECT_TRUE(reader.is_single_precision());
+  for (auto const &record : configurations) {
+    Index i = reader.find_by_name(record.configuration_name);
+    ASSERT_LT(i, reader.size());
+    expect_rounded(reader.read(i), record);
+  }
+  fs::remove(path);
+}
+
+TEST(ConfigurationSetBinaryIOTest, PersistentConfigurationSet) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      make_test_configurations(supercells);
+  fs::path path =
+      fs::temp_directory_path() / "casm_PersistentConfigurationSet_test.bin";
+  fs::path log_path = path.string() + ".log";
+  fs::remove(path);
+  fs::remove(log_path);
+
+  auto expect_same = [&](config::ConfigurationSet const &read,
+                         Index n_expected) {
+    ASSERT_EQ(read.size(), n_expected);
+    for (auto const &record : read) {
+      auto it = configurations.find_by_name(record.configuration_name);
+      ASSERT_TRUE(it != configurations.end());
+      EXPECT_TRUE(record.configuration == it->configuration);
+    }
+  };
+
+  // commits append to the log; nothing is compacted
+  {
+    PersistentConfigurationSet persistent(path, supercells, true, 100);
+    EXPECT_EQ(persistent.data().size(), 0);
+    Index i = 0;
+    for (auto const &record : configurations) {
+      EXPECT_TRUE(persistent.insert(record.configuration).second);
+      if (++i % 4 == 0) {
+        persistent.commit();
+        EXPECT_EQ(persistent.n_pending(), 0);
+      }
+    }
+    EXPECT_EQ(persistent.n_pending(), 2);
+    EXPECT_EQ(persistent.n_logged(), 8);
+    // uncommitted configurations are lost
+  }
+  EXPECT_FALSE(fs::exists(path));
+  {
+    config::SupercellSet read_supercells(prim);
+    PersistentConfigurationSet persistent(path, read_supercells, true, 100);
+    expect_same(persistent.data(), 8);
+    EXPECT_EQ(persistent.n_logged(), 8);
+    for (auto const &record : configurations) {
+      persistent.insert(record.configuration);
+    }
+    persistent.commit();
+  }
+
+  // a torn final frame is discarded
+  Index log_size = fs::file_size(log_path);
+  {
+    std::ofstream log(log_path, std::ios::binary | std::ios::app);
+    log.write("\x10\x00\x00\x00\x00\x00\x00\x00\x01\x02\x03", 11);
+  }
+  {
+    config::SupercellSet read_supercells(prim);
+    PersistentConfigurationSet persistent(path, read_supercells, true, 100);
+    expect_same(persistent.data(), configurations.size());
+    EXPECT_EQ(persistent.data().next_config_id(),
+              configurations.next_config_id());
+    EXPECT_EQ(Index(fs::file_size(log_path)), log_size);
+
+    // compaction writes the store and resets the log
+    persistent.compact();
+    EXPECT_EQ(persistent.n_logged(), 0);
+    EXPECT_EQ(persistent.n_stored(), configurations.size());
+  }
+  EXPECT_TRUE(fs::exists(path));
+  EXPECT_EQ(fs::file_size(log_path), 24);
+  {
+    config::SupercellSet read_supercells(prim);
+    PersistentConfigurationSet persistent(path, read_supercells, true, 100);
+    expect_same(persistent.data(), configurations.size());
+    EXPECT_EQ(persistent.data().next_config_id(),
+              configurations.next_config_id());
+
+    // a log that does not follow the store is already in the store
+    persistent.set_next_config_id({});
+    persistent.commit();
+  }
+  {
+    std::ofstream file(path, std::ios::binary);
+    write_binary(configurations, file, false);
+  }
+  {
+    config::SupercellSet read_supercells(prim);
+    PersistentConfigurationSet persistent(path, read_supercells, true, 100);
+    expect_same(persistent.data(), configurations.size());
+    EXPECT_EQ(persistent.data().next_config_id(),
+              configurations.next_config_id());
+    EXPECT_EQ(persistent.n_logged(), 0);
+  }
+
+  // automatic compaction
+  fs::remove(path);
+  fs::remove(log_path);
+  {
+    PersistentConfigurationSet persistent(path, supercells, true, 4, 1.0);
+    for (auto const &record : configurations) {
+      persistent.insert(record.configuration);
+      persistent.commit();
+    }
+    EXPECT_TRUE(fs::exists(path));
+    EXPECT_LT(persistent.n_logged(), configurations.size());
+    EXPECT_EQ(persistent.n_stored() + persistent.n_logged(),
+              configurations.size());
+  }
+  {
+    config::SupercellSet read_supercells(prim);
+    PersistentConfigurationSet persistent(path, read_supercells);
+    expect_same(persistent.data(), configurations.size());
+  }
+  fs::remove(path);
+  fs::remove(log_path);
+}
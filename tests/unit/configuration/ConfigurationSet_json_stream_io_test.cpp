@@ -0,0 +1,184 @@
+#include "casm/configuration/io/json/ConfigurationSet_json_stream_io.hh"
+
+#include <algorithm>
+#include <sstream>
+
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/io/json/Configuration_json_io.hh"
+#include "casm/configuration/io/json/ConfigurationSet_jsonl_io.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Make configurations with occupation, strain, and displacement values in
+/// two canonical supercells
+config::ConfigurationSet make_test_configurations(
+    config::SupercellSet &supercells) {
+  std::vector<Eigen::Matrix3l> T_list(2);
+  T_list[0] << 1, 0, 0, 0, 1, 0, 0, 0, 1;
+  T_list[1] << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+
+  config::ConfigurationSet configurations;
+  Index count = 0;
+  for (auto const &T : T_list) {
+    std::string name = supercells.insert(T).first->canonical_supercell_name;
+    auto supercell = supercells.insert_canonical(name).first->supercell;
+    for (Index trial = 0; trial < 5; ++trial, ++count) {
+      config::Configuration configuration(supercell);
+      auto &dof_values = configuration.dof_values;
+      dof_values.occupation.setConstant(trial % 3);
+      dof_values.global_dof_values.at("GLstrain").setConstant(0.01 * count);
+      dof_values.local_dof_values.at("disp").setConstant(-0.02 * count);
+      configurations.insert(configuration);
+    }
+  }
+  return configurations;
+}
+
+/// A stream buffer that does not support seeking
+class UnseekableBuffer : public std::streambuf {
+ public:
+  explicit UnseekableBuffer(std::string _text) : m_text(std::move(_text)) {
+    setg(&m_text[0], &m_text[0], &m_text[0] + m_text.size());
+  }
+
+ private:
+  std::string m_text;
+};
+
+void expect_equal(config::ConfigurationSet const &read_configurations,
+                  config::ConfigurationSet const &configurations) {
+  ASSERT_EQ(read_configurations.size(), configurations.size());
+  auto it = configurations.begin();
+  for (auto const &record : read_configurations) {
+    EXPECT_EQ(record.configuration_name, it->configuration_name);
+    EXPECT_EQ(record.configuration.dof_values.occupation,
+              it->configuration.dof_values.occupation);
+    EXPECT_TRUE(
+        record.configuration.dof_values.global_dof_values.at("GLstrain")
+            .isApprox(
+                it->configuration.dof_values.global_dof_values.at("GLstrain")));
+    EXPECT_TRUE(
+        record.configuration.dof_values.local_dof_values.at("disp").isApprox(
+            it->configuration.dof_values.local_dof_values.at("disp")));
+    ++it;
+  }
+  EXPECT_EQ(read_configurations.next_config_id(),
+            configurations.next_config_id());
+}
+
+}  // namespace
+
+TEST(ConfigurationSetJsonStreamIOTest, ReadJsonStream) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      make_test_configurations(supercells);
+
+  for (bool write_prim_basis : {false, true}) {
+    jsonParser json;
+    to_json(configurations, json, write_prim_basis);
+    std::stringstream ss;
+    ss << json;
+
+    config::SupercellSet read_supercells(prim);
+    config::ConfigurationSet read_configurations;
+    read_json_stream(read_supercells, read_configurations, ss);
+    expect_equal(read_configurations, configurations);
+    EXPECT_EQ(read_supercells.size(), 2);
+  }
+}
+
+TEST(ConfigurationSetJsonStreamIOTest, Reader) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      make_test_configurations(supercells);
+
+  jsonParser json;
+  to_json(configurations, json);
+  std::stringstream ss;
+  ss << json;
+
+  // not seekable: "config_id" is complete after the last configuration
+  UnseekableBuffer buffer(ss.str());
+  std::istream in(&buffer);
+  config::SupercellSet read_supercells(prim);
+  ConfigurationSetJsonStreamReader reader(in, read_supercells);
+  config::ConfigurationSet read_configurations;
+  while (auto record = reader.read()) {
+    read_configurations.insert(*record);
+    EXPECT_EQ(reader.index(), read_configurations.size());
+  }
+  EXPECT_TRUE(reader.read() == nullptr);
+  read_configurations.set_next_config_id(reader.next_config_id());
+  expect_equal(read_configurations, configurations);
+}
+
+TEST(ConfigurationSetJsonStreamIOTest, Errors) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations;
+
+  {
+    std::stringstream ss(
+        R"({"version": "2.0", "supercells": {}, "config_id": {}})");
+    EXPECT_THROW(read_json_stream(supercells, configurations, ss),
+                 std::runtime_error);
+  }
+  {
+    std::stringstream ss(R"({"version": "1.0", "config_id": {}})");
+    EXPECT_THROW(read_json_stream(supercells, configurations, ss),
+                 std::runtime_error);
+  }
+  {
+    std::stringstream ss(
+        R"({"version": "1.0", "supercells": {"SCEL1_1_1_1_0_0_0": {"0": )"
+        R"({"dof": {"occ": [0, 0]}}}}})");
+    EXPECT_THROW(read_json_stream(supercells, configurations, ss),
+                 std::runtime_error);
+  }
+  {
+    std::stringstream ss(R"({"version": "1.0", "supercells": {)");
+    EXPECT_THROW(read_json_stream(supercells, configurations, ss),
+                 std::runtime_error);
+  }
+}
+
+TEST(ConfigurationSetJsonStreamIOTest, JsonLines) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      make_test_configurations(supercells);
+
+  for (bool prim_basis : {false, true}) {
+    std::stringstream ss;
+    ConfigurationJsonLinesWriter writer(ss, prim_basis);
+    for (auto const &record : configurations) {
+      writer.write(record);
+    }
+    EXPECT_EQ(writer.n_written(), configurations.size());
+
+    // one line per configuration, with empty lines skipped
+    std::string text = ss.str();
+    EXPECT_EQ(std::count(text.begin(), text.end(), '\n'),
+              configurations.size());
+    std::stringstream in("\n" + text + "\n");
+
+    config::SupercellSet read_supercells(prim);
+    config::ConfigurationSet read_configurations;
+    ConfigurationJsonLinesReader reader(in, read_supercells, prim_basis);
+    while (auto record = reader.read()) {
+      read_configurations.insert(*record);
+    }
+    EXPECT_EQ(reader.index(), configurations.size());
+    read_configurations.set_next_config_id(configurations.next_config_id());
+    expect_equal(read_configurations, configurations);
+  }
+}
@@ -0,0 +1,509 @@
+#include "casm/configuration/ConfigurationSet.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(UnorderedConfigurationSetTest, Test1) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  config::UnorderedConfigurationSet configurations;
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index trial = 0; trial < 10; ++trial) {
+    occ.setZero();
+    occ(trial % occ.size()) = 1 + trial % 2;
+    configurations.insert(configuration);
+  }
+  EXPECT_EQ(configurations.size(), 10);
+
+  // duplicates are not inserted
+  auto res = configurations.insert(configuration);
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(res.first->configuration, configuration);
+  EXPECT_EQ(configurations.size(), 10);
+
+  // find and find_by_name agree
+  auto it = configurations.find(configuration);
+  ASSERT_TRUE(it != configurations.end());
+  EXPECT_EQ(configurations.find_by_name(it->configuration_name), it);
+  EXPECT_EQ(configurations.count_by_name(it->configuration_name), 1);
+
+  // erase removes from all indices
+  std::string name = it->configuration_name;
+  EXPECT_EQ(configurations.erase(configuration), 1);
+  EXPECT_EQ(configurations.size(), 9);
+  EXPECT_EQ(configurations.count(configuration), 0);
+  EXPECT_EQ(configurations.count_by_name(name), 0);
+
+  // hash is consistent with operator==
+  config::Configuration other(supercell);
+  other.dof_values.occupation = occ;
+  EXPECT_EQ(config::make_configuration_hash(configuration),
+            config::make_configuration_hash(other));
+}
+
+TEST(ConfigurationSetTest, InsertMany) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  std::vector<config::Configuration> batch;
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index trial = 0; trial < 20; ++trial) {
+    occ.setZero();
+    occ(trial % occ.size()) = 1 + trial % 2;
+    occ((3 * trial) % occ.size()) = 2;
+    batch.push_back(configuration);
+  }
+
+  // serial path: insert canonical forms one at a time
+  config::ConfigurationSet expected;
+  for (auto const &c : batch) {
+    expected.insert(make_canonical_form(
+        c, config::SupercellSymOp::begin(supercell),
+        config::SupercellSymOp::end(supercell)));
+  }
+
+  for (Index n_threads : {1, 4}) {
+    config::ConfigurationSet configurations;
+    std::vector<config::Configuration> tmp = batch;
+    auto result = configurations.insert_many(std::move(tmp), n_threads);
+    ASSERT_EQ(result.size(), batch.size());
+    ASSERT_EQ(configurations.size(), expected.size());
+    auto it = expected.begin();
+    for (auto const &record : configurations) {
+      EXPECT_EQ(record.configuration, it->configuration);
+      EXPECT_EQ(record.configuration_name, it->configuration_name);
+      ++it;
+    }
+    EXPECT_EQ(configurations.next_config_id(), expected.next_config_id());
+  }
+}
+
+TEST(ConfigurationSetTest, Merge) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  T << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto other_supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  std::vector<config::Configuration> sequence;
+  for (Index trial = 0; trial < 20; ++trial) {
+    auto const &s = (trial % 3 == 0) ? other_supercell : supercell;
+    config::Configuration configuration(s);
+    Eigen::VectorXi &occ = configuration.dof_values.occupation;
+    occ(trial % occ.size()) = 1 + trial % 2;
+    occ((3 * trial) % occ.size()) = 2;
+    sequence.push_back(make_canonical_form(configuration,
+                                           config::SupercellSymOp::begin(s),
+                                           config::SupercellSymOp::end(s)));
+  }
+
+  // serial
+  config::ConfigurationSet expected;
+  for (auto const &configuration : sequence) {
+    expected.insert(configuration);
+  }
+  ASSERT_LT(expected.size(), sequence.size());
+
+  // contiguous shards of the sequence, merged in order
+  for (Index n_shards : {1, 2, 3, 6}) {
+    config::ConfigurationSet merged;
+    for (Index shard_index = 0; shard_index < n_shards; ++shard_index) {
+      config::ConfigurationSet shard;
+      Index begin = shard_index * sequence.size() / n_shards;
+      Index end = (shard_index + 1) * sequence.size() / n_shards;
+      for (Index i = begin; i < end; ++i) {
+        shard.insert(sequence[i]);
+      }
+      merged.merge(shard);
+    }
+    ASSERT_EQ(merged.size(), expected.size());
+    auto it = expected.begin();
+    for (auto const &record : merged) {
+      EXPECT_EQ(record.configuration, it->configuration);
+      EXPECT_EQ(record.configuration_name, it->configuration_name);
+      ++it;
+    }
+    EXPECT_EQ(merged.next_config_id(), expected.next_config_id());
+  }
+
+  // custom configuration_id are kept
+  config::ConfigurationSet shard;
+  shard.insert(config::ConfigurationRecord(sequence[0],
+                                           other_supercell->name, "custom"));
+  config::ConfigurationSet merged;
+  merged.merge(shard);
+  ASSERT_EQ(merged.size(), 1);
+  EXPECT_EQ(merged.begin()->configuration_id, "custom");
+}
+
+TEST(ConfigurationSetTest, MakeMergedConfigurationSet) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  T << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto other_supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  std::vector<config::Configuration> sequence;
+  for (Index trial = 0; trial < 30; ++trial) {
+    auto const &s = (trial % 3 == 0) ? other_supercell : supercell;
+    config::Configuration configuration(s);
+    Eigen::VectorXi &occ = configuration.dof_values.occupation;
+    occ(trial % occ.size()) = 1 + trial % 2;
+    occ((5 * trial) % occ.size()) = 2;
+    sequence.push_back(make_canonical_form(configuration,
+                                           config::SupercellSymOp::begin(s),
+                                           config::SupercellSymOp::end(s)));
+  }
+
+  // overlapping shards, one with a custom configuration_id, and a first set
+  // with existing next_config_id
+  std::vector<config::ConfigurationSet> shards(4);
+  shards[0].set_next_config_id({{supercell->name, 10}});
+  for (Index i = 0; i < sequence.size(); ++i) {
+    shards[i * 4 / sequence.size()].insert(sequence[i]);
+    if (i % 4 == 0) {
+      shards[3].insert(sequence[i]);
+    }
+  }
+  shards[2].insert(config::ConfigurationRecord(
+      sequence.back(), supercell->name, "custom"));
+
+  config::ConfigurationSet expected = shards[0];
+  for (Index k = 1; k < shards.size(); ++k) {
+    expected.merge(shards[k]);
+  }
+
+  std::vector<config::ConfigurationSet const *> sets;
+  for (auto const &shard : shards) {
+    sets.push_back(&shard);
+  }
+  for (Index n_threads : {1, 4}) {
+    config::ConfigurationSet merged =
+        config::make_merged_configuration_set(sets, n_threads);
+    ASSERT_EQ(merged.size(), expected.size());
+    auto it = expected.begin();
+    for (auto const &record : merged) {
+      EXPECT_EQ(record.configuration, it->configuration);
+      EXPECT_EQ(record.configuration_name, it->configuration_name);
+      ++it;
+    }
+    EXPECT_EQ(merged.next_config_id(), expected.next_config_id());
+    EXPECT_EQ(merged.count(sequence[0]), 1);
+  }
+
+  EXPECT_TRUE(config::make_merged_configuration_set({}).empty());
+}
+
+TEST(ConfigurationSetTest, FindByPrimitive) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  auto make_canonical = [](config::Configuration const &configuration) {
+    config::Configuration tmp =
+        config::make_in_canonical_supercell(configuration);
+    return make_canonical_form(tmp,
+                               config::SupercellSymOp::begin(tmp.supercell),
+                               config::SupercellSymOp::end(tmp.supercell));
+  };
+
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto motif_supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration motif(motif_supercell);
+  motif.dof_values.occupation << 1, 0;
+
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration tiled = config::copy_configuration(motif, supercell);
+  config::Configuration other(supercell);
+  other.dof_values.occupation(0) = 2;
+
+  config::ConfigurationSet configurations;
+  configurations.insert(make_canonical(motif));
+  EXPECT_EQ(configurations.count_by_primitive(motif), 1);
+  EXPECT_EQ(configurations.count_by_primitive(tiled), 1);
+  EXPECT_EQ(configurations.count_by_primitive(other), 0);
+
+  // the index is updated on insert, after first use
+  configurations.insert(make_canonical(tiled));
+  configurations.insert(make_canonical(other));
+  ASSERT_EQ(configurations.size(), 3);
+  auto found = configurations.find_by_primitive(tiled);
+  ASSERT_EQ(found.size(), 2);
+  for (auto it : found) {
+    EXPECT_EQ(it->primitive_canonical_key(),
+              config::make_primitive_canonical_key(motif));
+    EXPECT_EQ(it->primitive_canonical_key().supercell_name,
+              config::make_in_canonical_supercell(motif).supercell->name);
+  }
+  EXPECT_EQ(configurations.count_by_primitive(other), 1);
+
+  // the index is updated on erase
+  configurations.erase(found[0]);
+  EXPECT_EQ(configurations.count_by_primitive(motif), 1);
+
+  // copies rebuild the index
+  config::ConfigurationSet copy = configurations;
+  EXPECT_EQ(copy.count_by_primitive(motif), 1);
+  EXPECT_EQ(copy.find_by_primitive(motif)[0]->configuration,
+            configurations.find_by_primitive(motif)[0]->configuration);
+  copy.clear();
+  EXPECT_EQ(copy.count_by_primitive(motif), 0);
+}
+
+TEST(ConfigurationSetTest, SecondaryIndexes) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  auto make_canonical = [](config::Configuration const &configuration) {
+    return make_canonical_form(
+        configuration, config::SupercellSymOp::begin(configuration.supercell),
+        config::SupercellSymOp::end(configuration.supercell));
+  };
+
+  config::ConfigurationSet configurations;
+  Eigen::Matrix3l T;
+  T << 1, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto unit = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration A(unit);
+  config::Configuration B(unit);
+  B.dof_values.occupation(0) = 1;
+  configurations.insert(A);
+  configurations.insert(B);
+
+  T << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration AB(supercell);
+  AB.dof_values.occupation(0) = 1;
+  configurations.insert(make_canonical(AB));
+
+  EXPECT_EQ(configurations.find_by_supercell_name(unit->name).size(), 2);
+  EXPECT_EQ(configurations.find_by_volume(1, 1).size(), 2);
+  EXPECT_EQ(configurations.find_by_volume(1, 2).size(), 3);
+  EXPECT_EQ(configurations.find_by_volume(3, 8).size(), 0);
+  EXPECT_EQ(configurations.find_by_occupant_count(0, "B", 1, 1).size(), 2);
+  EXPECT_EQ(configurations.find_by_occupant_count(0, "A", 0, 0).size(), 1);
+  EXPECT_EQ(configurations.find_by_occupant_count(0, "C", 0, 10).size(), 0);
+  EXPECT_EQ(configurations.find_by_occupant_count(1, "A", 0, 10).size(), 0);
+
+  // the indexes are updated on insert and erase, after first use
+  config::Configuration BB(supercell);
+  BB.dof_values.occupation << 1, 1;
+  configurations.insert(BB);
+  auto found = configurations.find_by_occupant_count(0, "B", 2, 2);
+  ASSERT_EQ(found.size(), 1);
+  EXPECT_EQ(found[0]->configuration, BB);
+  auto by_volume = configurations.find_by_volume(2, 2);
+  ASSERT_EQ(by_volume.size(), 2);
+  configurations.erase(by_volume[0]);
+  EXPECT_EQ(configurations.find_by_volume(2, 2).size(), 1);
+  EXPECT_EQ(configurations.find_by_supercell_name(supercell->name).size(), 1);
+  EXPECT_EQ(configurations.find_by_occupant_count(0, "B", 1, 2).size(), 2);
+
+  // copies rebuild the indexes
+  config::ConfigurationSet copy = configurations;
+  EXPECT_EQ(copy.find_by_volume(1, 2).size(), 3);
+  copy.clear();
+  EXPECT_EQ(copy.find_by_volume(1, 2).size(), 0);
+}
+
+TEST(ConfigurationSetTest, FindByName) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration A(supercell);
+  config::Configuration B(supercell);
+  B.dof_values.occupation << 1, 0;
+  config::Configuration C(supercell);
+  C.dof_values.occupation << 1, 1;
+
+  config::ConfigurationSet configurations;
+  configurations.insert(A);
+  configurations.insert(B);
+  EXPECT_EQ(configurations.find_by_name(supercell->name + "/1")->configuration,
+            B);
+  EXPECT_EQ(configurations.count_by_name(supercell->name + "/2"), 0);
+  EXPECT_EQ(configurations.count_by_name("SCEL1_1_1_1_0_0_0/0"), 0);
+  EXPECT_EQ(configurations.count_by_name("other"), 0);
+
+  // the index is updated on insert and erase, after first use
+  configurations.insert(C);
+  EXPECT_EQ(configurations.find_by_name(supercell->name + "/2")->configuration,
+            C);
+  configurations.erase_by_name(supercell->name + "/0");
+  EXPECT_EQ(configurations.count_by_name(supercell->name + "/0"), 0);
+  EXPECT_EQ(configurations.size(), 2);
+
+  // non-unique names find the first record in order
+  configurations.insert(config::ConfigurationRecord(A, supercell->name, "1"));
+  config::Configuration const &first = (A < B) ? A : B;
+  config::Configuration const &second = (A < B) ? B : A;
+  auto it = configurations.find_by_name(supercell->name + "/1");
+  ASSERT_TRUE(it != configurations.end());
+  EXPECT_EQ(it->configuration, first);
+  configurations.erase(it);
+  it = configurations.find_by_name(supercell->name + "/1");
+  ASSERT_TRUE(it != configurations.end());
+  EXPECT_EQ(it->configuration, second);
+
+  config::NamePool pool;
+  EXPECT_EQ(pool.intern("a"), 0);
+  EXPECT_EQ(pool.intern("b"), 1);
+  EXPECT_EQ(pool.intern("a"), 0);
+  EXPECT_EQ(pool.find("c"), -1);
+  EXPECT_EQ(pool.name(1), "b");
+  EXPECT_EQ(pool.size(), 2);
+}
+
+TEST(ConfigurationSetTest, FindWithinTol) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  double tol = prim->basicstructure->lattice().tol();
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  config::ConfigurationSet configurations;
+  config::Configuration configuration(supercell);
+  Eigen::MatrixXd &disp = configuration.dof_values.local_dof_values["disp"];
+  for (Index i = 0; i < 5; ++i) {
+    disp.setZero();
+    disp(0, 0) = 0.1 * i;
+    configurations.insert(configuration);
+  }
+
+  // values within tolerance are found, values beyond tolerance are not
+  config::Configuration other(configuration);
+  Eigen::MatrixXd &other_disp = other.dof_values.local_dof_values["disp"];
+  other_disp(0, 0) = 0.2 + 0.5 * tol;
+  other_disp(1, 1) = -0.5 * tol;
+  auto it = configurations.find_within_tol(other);
+  ASSERT_TRUE(it != configurations.end());
+  EXPECT_EQ(it->configuration, other);
+  EXPECT_EQ(it->configuration.dof_values.local_dof_values.at("disp")(0, 0),
+            0.2);
+  other_disp(1, 1) = -2.0 * tol;
+  EXPECT_TRUE(configurations.find_within_tol(other) == configurations.end());
+
+  // the index is updated on insert and erase, after first use
+  configurations.insert(other);
+  EXPECT_TRUE(configurations.find_within_tol(other) != configurations.end());
+  configurations.erase(configurations.find_within_tol(other));
+  EXPECT_TRUE(configurations.find_within_tol(other) == configurations.end());
+  other_disp(1, 1) = 0.0;
+  it = configurations.find_within_tol(other);
+  ASSERT_TRUE(it != configurations.end());
+  configurations.erase(it);
+  EXPECT_TRUE(configurations.find_within_tol(other) == configurations.end());
+  EXPECT_EQ(configurations.size(), 4);
+
+  // the index is rebuilt after direct modification of the data
+  configurations.data().clear();
+  EXPECT_TRUE(configurations.find_within_tol(configuration) ==
+              configurations.end());
+
+  // other supercells are not found
+  Eigen::Matrix3l T2;
+  T2 << 1, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto supercell2 = std::make_shared<config::Supercell const>(prim, T2);
+  configurations.insert(config::Configuration(supercell));
+  EXPECT_TRUE(configurations.find_within_tol(config::Configuration(
+                  supercell2)) == configurations.end());
+  EXPECT_TRUE(configurations.find_within_tol(config::Configuration(
+                  supercell)) != configurations.end());
+}
+
+TEST(ConfigurationSetTest, MoveInsert) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration A(supercell);
+  config::Configuration B(supercell);
+  B.dof_values.occupation << 1, 0;
+
+  config::ConfigurationSet configurations;
+  config::UnorderedConfigurationSet unordered;
+  for (auto const &configuration : {A, B}) {
+    config::Configuration tmp = configuration;
+    EXPECT_TRUE(configurations.insert(std::move(tmp)).second);
+    tmp = configuration;
+    EXPECT_TRUE(unordered.insert(supercell->name, std::move(tmp)).second);
+  }
+  ASSERT_EQ(configurations.size(), 2);
+  EXPECT_EQ(configurations.find_by_name(supercell->name + "/1")->configuration,
+            B);
+  EXPECT_EQ(unordered.find_by_name(supercell->name + "/1")->configuration, B);
+
+  // if not inserted, the argument is left unchanged
+  config::Configuration tmp = B;
+  auto result = configurations.insert(std::move(tmp));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(result.first->configuration_id, "1");
+  EXPECT_EQ(tmp, B);
+  result = configurations.insert(supercell->name, std::move(tmp));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(tmp, B);
+  EXPECT_FALSE(unordered.insert(std::move(tmp)).second);
+  EXPECT_EQ(tmp, B);
+  EXPECT_EQ(configurations.next_config_id().at(supercell->name), 2);
+  EXPECT_EQ(unordered.next_config_id().at(supercell->name), 2);
+
+  // records
+  config::ConfigurationRecord record(B, supercell->name, "custom");
+  EXPECT_FALSE(configurations.insert(std::move(record)).second);
+  config::Configuration C(supercell);
+  C.dof_values.occupation << 1, 1;
+  EXPECT_TRUE(configurations
+                  .insert(config::ConfigurationRecord(C, supercell->name,
+                                                      "custom"))
+                  .second);
+  EXPECT_EQ(configurations.find_by_name(supercell->name + "/custom")
+                ->configuration,
+            C);
+}
+
+TEST(ConfigurationSetTest, CanonicalOpInfo) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  config::ConfigurationSet configurations;
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index trial = 0; trial < 6; ++trial) {
+    occ.setZero();
+    occ(trial % occ.size()) = 1 + trial % 2;
+    occ((trial + 1) % occ.size()) = 2;
+    // records of non-canonical configurations in the canonical supercell
+    configurations.insert(config::ConfigurationRecord(
+        configuration, supercell->name, std::to_string(trial)));
+  }
+
+  for (auto const &record : configurations) {
+    config::Configuration const &c = record.configuration;
+    EXPECT_EQ(record.to_canonical(), to_canonical(c, begin, end));
+    EXPECT_EQ(record.from_canonical(), from_canonical(c, begin, end));
+    EXPECT_EQ(record.invariant_subgroup_size(),
+              make_invariant_subgroup(c, begin, end).size());
+    EXPECT_EQ(copy_apply(record.to_canonical(), c),
+              make_canonical_form(c, begin, end));
+
+    // shared by copies
+    config::ConfigurationRecord copy = record;
+    EXPECT_EQ(&copy.canonical_op_info(), &record.canonical_op_info());
+  }
+}
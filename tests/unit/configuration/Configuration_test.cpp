@@ -1,5 +1,7 @@
 #include "casm/configuration/Configuration.hh"
 
+#include <sstream>
+
 #include "casm/casm_io/json/jsonParser.hh"
 #include "casm/configuration/Prim.hh"
 #include "casm/configuration/SupercellSymOp.hh"
@@ -197,3 +199,56 @@ TEST(ConfigurationWithPropertiesJsonTest, Test1) {
     EXPECT_EQ(dof_values_in.occupation, expected);
   }
 }
+
+TEST(ConfigurationJsonTest, WriteJson) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  config::Configuration configuration(supercell);
+  auto &dof_values = configuration.dof_values;
+  dof_values.occupation << 1, 0, 2, 0;
+  dof_values.global_dof_values.at("GLstrain") << 0.01, -0.02, 1.0 / 3.0, 0.0,
+      1e-12, 2.0;
+  dof_values.local_dof_values.at("disp").setRandom();
+
+  jsonParser expected;
+  to_json(configuration, expected);
+
+  std::string text;
+  write_json(configuration, text);
+  EXPECT_EQ(jsonParser::parse(text), expected);
+
+  std::stringstream ss;
+  write_json(configuration, ss);
+  EXPECT_EQ(ss.str(), text);
+
+  config::Configuration configuration_in =
+      jsonConstructor<config::Configuration>::from_json(
+          jsonParser::parse(text), prim);
+  EXPECT_EQ(configuration_in.dof_values.occupation, dof_values.occupation);
+  EXPECT_TRUE(configuration_in.dof_values.global_dof_values.at("GLstrain") ==
+              dof_values.global_dof_values.at("GLstrain"));
+  EXPECT_TRUE(configuration_in.dof_values.local_dof_values.at("disp") ==
+              dof_values.local_dof_values.at("disp"));
+}
+
+TEST(ConfigurationJsonTest, WriteJsonOccupationOnly) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  config::Configuration configuration(supercell);
+  configuration.dof_values.occupation << 1, 0;
+
+  jsonParser expected;
+  to_json(configuration, expected);
+
+  std::string text;
+  write_json(configuration, text);
+  EXPECT_EQ(jsonParser::parse(text), expected);
+}
@@ -0,0 +1,107 @@
+#include "casm/configuration/ContinuousDoFIndex.hh"
+
+#include <algorithm>
+#include <random>
+
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// Return indices of points within `half_width` of `x`, by checking all
+std::vector<Index> find_within_by_scan(std::vector<Eigen::VectorXd> const &X,
+                                       std::vector<char> const &is_erased,
+                                       Eigen::VectorXd const &x,
+                                       Eigen::VectorXd const &half_width) {
+  std::vector<Index> result;
+  for (Index i = 0; i < X.size(); ++i) {
+    if (!is_erased[i] &&
+        ((X[i] - x).cwiseAbs().array() <= half_width.array()).all()) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(ContinuousDoFIndexTest, Test1) {
+  std::mt19937_64 engine(0);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  Index dim = 4;
+  Eigen::VectorXd half_width(dim);
+  half_width << 0.3, 0.2, 0.4, 0.5;
+  config::ContinuousDoFIndex<Index> index(half_width);
+  EXPECT_EQ(index.dim(), dim);
+  EXPECT_TRUE(index.empty());
+
+  std::vector<Eigen::VectorXd> X;
+  std::vector<char> is_erased;
+  auto random_point = [&]() {
+    Eigen::VectorXd x(dim);
+    for (Index k = 0; k < dim; ++k) {
+      x(k) = dist(engine);
+    }
+    return x;
+  };
+  auto check = [&]() {
+    for (Index trial = 0; trial < 20; ++trial) {
+      Eigen::VectorXd x = random_point();
+      std::vector<Index> found = index.find_within(x);
+      std::sort(found.begin(), found.end());
+      EXPECT_EQ(found, find_within_by_scan(X, is_erased, x, half_width));
+    }
+  };
+
+  for (Index i = 0; i < 300; ++i) {
+    X.push_back(random_point());
+    is_erased.push_back(0);
+    index.insert(X.back(), i);
+    if (i % 37 == 0) {
+      check();
+    }
+  }
+  EXPECT_EQ(index.size(), 300);
+  check();
+
+  // erase, including enough to rebuild
+  for (Index i = 0; i < 300; i += 2) {
+    EXPECT_TRUE(index.erase(X[i], i));
+    EXPECT_FALSE(index.erase(X[i], i));
+    is_erased[i] = 1;
+  }
+  EXPECT_EQ(index.size(), 150);
+  check();
+  for (Index i = 1; i < 300; i += 4) {
+    EXPECT_TRUE(index.erase(X[i], i));
+    is_erased[i] = 1;
+  }
+  check();
+
+  // stop early
+  Eigen::VectorXd x = X[3];
+  ASSERT_GT(find_within_by_scan(X, is_erased, x, half_width).size(), 0);
+  Index n_calls = 0;
+  EXPECT_TRUE(index.find_if(x, [&](Index i) {
+    ++n_calls;
+    return true;
+  }));
+  EXPECT_EQ(n_calls, 1);
+  EXPECT_FALSE(index.find_if(x, [&](Index i) { return false; }));
+
+  EXPECT_THROW(index.find_within(Eigen::VectorXd::Zero(dim + 1)),
+               std::runtime_error);
+  index.clear();
+  EXPECT_TRUE(index.empty());
+  EXPECT_TRUE(index.find_within(X[3]).empty());
+}
+
+TEST(ContinuousDoFIndexTest, ProjectedHalfWidth) {
+  Eigen::MatrixXd projection(2, 3);
+  projection << 1.0, -2.0, 0.0, 0.5, 0.5, 0.5;
+  Eigen::VectorXd expected(2);
+  expected << 0.3, 0.15;
+  EXPECT_TRUE(config::make_projected_half_width(projection, 0.1)
+                  .isApprox(expected));
+}
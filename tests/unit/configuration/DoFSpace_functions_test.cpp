@@ -0,0 +1,148 @@
+#include "casm/configuration/DoFSpace_functions.hh"
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/dof_space_analysis.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+class SparseDoFSpaceTest : public testing::Test {
+ protected:
+  SparseDoFSpaceTest() {
+    xtal_prim = std::make_shared<xtal::BasicStructure const>(
+        test::FCC_binary_disp_prim());
+    prim = std::make_shared<config::Prim const>(xtal_prim);
+    // conventional FCC cell, 4 sites
+    T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  /// \brief Expect equal axes
+  void expect_equal_axes(config::SparseDoFSpace const &sparse,
+                         clexulator::DoFSpace const &dense) {
+    EXPECT_EQ(sparse.dim(), dense.basis.rows());
+    EXPECT_EQ(sparse.axis_site_index, *dense.axis_info.site_index);
+    EXPECT_EQ(sparse.axis_dof_component, *dense.axis_info.dof_component);
+  }
+
+  /// \brief Expect the same column space
+  void expect_same_span(Eigen::MatrixXd const &A, Eigen::MatrixXd const &B) {
+    ASSERT_EQ(A.cols(), B.cols());
+    Eigen::MatrixXd AB(A.rows(), A.cols() + B.cols());
+    AB << A, B;
+    Eigen::FullPivLU<Eigen::MatrixXd> lu_A(A);
+    Eigen::FullPivLU<Eigen::MatrixXd> lu_AB(AB);
+    EXPECT_EQ(lu_A.rank(), A.cols());
+    EXPECT_EQ(lu_AB.rank(), A.cols());
+  }
+
+  std::shared_ptr<xtal::BasicStructure const> xtal_prim;
+  std::shared_ptr<config::Prim const> prim;
+  Eigen::Matrix3l T;
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(SparseDoFSpaceTest, OccTest) {
+  using namespace config;
+  clexulator::DoFSpace dense = clexulator::make_dof_space("occ", xtal_prim, T);
+  SparseDoFSpace sparse = make_sparse_dof_space("occ", xtal_prim, T);
+  expect_equal_axes(sparse, dense);
+  EXPECT_EQ(sparse.basis.nonZeros(), sparse.dim());
+
+  // default occupation, by sublattice and by site
+  std::map<int, int> sublattice_index_to_default_occ({{0, 1}});
+  std::map<Index, int> site_index_to_default_occ({{0, 1}, {2, 1}});
+  std::vector<std::pair<clexulator::DoFSpace, SparseDoFSpace>> excluded;
+  excluded.emplace_back(exclude_default_occ_modes(dense),
+                        exclude_default_occ_modes(sparse));
+  excluded.emplace_back(
+      exclude_default_occ_modes(dense, false, sublattice_index_to_default_occ),
+      exclude_default_occ_modes(sparse, false,
+                                sublattice_index_to_default_occ));
+  excluded.emplace_back(
+      exclude_default_occ_modes(dense, false, std::nullopt,
+                                site_index_to_default_occ),
+      exclude_default_occ_modes(sparse, false, std::nullopt,
+                                site_index_to_default_occ));
+  for (auto const &pair : excluded) {
+    EXPECT_TRUE(
+        almost_equal(Eigen::MatrixXd(pair.second.basis), pair.first.basis));
+    EXPECT_TRUE(almost_equal(Eigen::MatrixXd(pair.second.basis_inv),
+                             pair.first.basis_inv));
+  }
+  std::map<int, int> invalid_default_occ({{0, 2}});
+  EXPECT_THROW(
+      exclude_default_occ_modes_by_sublattice(sparse, invalid_default_occ),
+      std::runtime_error);
+
+  // normal coordinates
+  std::vector<Configuration> configurations;
+  for (Index l = 0; l < 4; ++l) {
+    configurations.emplace_back(supercell);
+    configurations.back().dof_values.occupation(l) = 1;
+  }
+  auto const &dense_std = excluded[0].first;
+  auto const &sparse_std = excluded[0].second;
+  Eigen::MatrixXd X = make_normal_coordinates(configurations, sparse_std);
+  EXPECT_TRUE(
+      almost_equal(X, make_normal_coordinates(configurations, dense_std)));
+  for (Index i = 0; i < configurations.size(); ++i) {
+    EXPECT_TRUE(almost_equal(
+        Eigen::VectorXd(X.row(i).transpose()),
+        get_normal_coordinate(configurations[i].dof_values, sparse_std)));
+  }
+}
+
+TEST_F(SparseDoFSpaceTest, DispTest) {
+  using namespace config;
+  clexulator::DoFSpace dense = clexulator::make_dof_space("disp", xtal_prim, T);
+  SparseDoFSpace sparse = make_sparse_dof_space("disp", xtal_prim, T);
+  expect_equal_axes(sparse, dense);
+
+  // the sparse homogeneous mode complement is orthonormal, and orthogonal to
+  // uniform translations
+  clexulator::DoFSpace dense_excluded = exclude_homogeneous_mode_space(dense);
+  SparseDoFSpace sparse_excluded = exclude_homogeneous_mode_space(sparse);
+  Eigen::MatrixXd B(sparse_excluded.basis);
+  EXPECT_EQ(B.cols(), sparse.dim() - 3);
+  EXPECT_TRUE(almost_equal(Eigen::MatrixXd(B.transpose() * B),
+                           Eigen::MatrixXd::Identity(B.cols(), B.cols())));
+  for (Index c = 0; c < 3; ++c) {
+    Eigen::VectorXd u = Eigen::VectorXd::Zero(sparse.dim());
+    for (Index i = 0; i < sparse.dim(); ++i) {
+      if (sparse.axis_dof_component[i] == c) {
+        u(i) = 1.0;
+      }
+    }
+    EXPECT_TRUE(almost_zero(Eigen::VectorXd(B.transpose() * u)));
+  }
+  expect_same_span(B, dense_excluded.basis);
+  EXPECT_TRUE(
+      almost_equal(Eigen::MatrixXd(sparse_excluded.basis_inv), B.transpose()));
+
+  // normal coordinates
+  std::vector<Configuration> configurations;
+  for (Index l = 0; l < 4; ++l) {
+    configurations.emplace_back(supercell);
+    configurations.back().dof_values.local_dof_values.at("disp")(0, l) = 0.1;
+    configurations.back().dof_values.local_dof_values.at("disp")(2, 3) = -0.2;
+  }
+  clexulator::DoFSpace dense_from_sparse =
+      make_dense_dof_space(sparse_excluded);
+  EXPECT_TRUE(
+      almost_equal(make_normal_coordinates(configurations, sparse_excluded),
+                   make_normal_coordinates(configurations, dense_from_sparse)));
+
+  // symmetry analysis
+  DoFSpaceAnalysisResults dense_results =
+      dof_space_analysis(dense, prim, std::nullopt, true);
+  DoFSpaceAnalysisResults sparse_results =
+      dof_space_analysis(sparse, prim, std::nullopt, true);
+  EXPECT_EQ(sparse_results.symmetry_adapted_dof_space.basis.cols(),
+            dense_results.symmetry_adapted_dof_space.basis.cols());
+}
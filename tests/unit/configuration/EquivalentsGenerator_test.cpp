@@ -0,0 +1,81 @@
+#include "casm/configuration/EquivalentsGenerator.hh"
+
+#include <set>
+
+#include "casm/configuration/canonical_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+class EquivalentsGeneratorTest : public testing::Test {
+ protected:
+  EquivalentsGeneratorTest() {
+    auto prim =
+        config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+    Eigen::Matrix3l T;
+    T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  /// \brief Check that the generator visits exactly make_equivalents
+  void check(config::Configuration const &configuration) {
+    auto begin = config::SupercellSymOp::begin(supercell);
+    auto end = config::SupercellSymOp::end(supercell);
+    std::vector<config::Configuration> expected =
+        make_equivalents(configuration, begin, end);
+
+    config::EquivalentsGenerator generator(configuration, begin, end);
+    EXPECT_EQ(generator.size(), expected.size());
+    EXPECT_EQ(generator.invariant_subgroup().size() * generator.size(),
+              std::distance(begin, end));
+
+    std::set<config::Configuration> found;
+    Index count = 0;
+    while (generator.is_valid()) {
+      EXPECT_EQ(generator.value(), copy_apply(generator.op(), configuration));
+      found.insert(generator.value());
+      ++count;
+      generator.advance();
+    }
+    EXPECT_EQ(count, expected.size());
+    EXPECT_EQ(std::vector<config::Configuration>(found.begin(), found.end()),
+              expected);
+  }
+
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(EquivalentsGeneratorTest, Occupation) {
+  config::Configuration configuration(supercell);
+  configuration.dof_values.occupation << 0, 1, 2, 1;
+  check(configuration);
+}
+
+TEST_F(EquivalentsGeneratorTest, Displacement) {
+  config::Configuration configuration(supercell);
+  configuration.dof_values.local_dof_values.at("disp")(2, 2) = 1.0;
+  check(configuration);
+}
+
+TEST_F(EquivalentsGeneratorTest, Default) {
+  // the default configuration is invariant, so it is its only equivalent
+  config::Configuration configuration(supercell);
+  check(configuration);
+
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  config::EquivalentsGenerator generator(configuration, begin, end);
+  EXPECT_EQ(generator.size(), 1);
+}
+
+TEST_F(EquivalentsGeneratorTest, Subset) {
+  // operations need not form a group: use translations only
+  config::Configuration configuration(supercell);
+  configuration.dof_values.occupation << 0, 1, 0, 0;
+  auto begin = config::SupercellSymOp::translation_begin(supercell);
+  auto end = config::SupercellSymOp::translation_end(supercell);
+  config::EquivalentsGenerator generator(configuration, begin, end);
+  EXPECT_EQ(generator.size(),
+            make_equivalents(configuration, begin, end).size());
+}
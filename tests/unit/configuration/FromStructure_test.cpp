@@ -0,0 +1,104 @@
+#include "casm/configuration/FromStructure.hh"
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/make_simple_structure.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/Coordinate.hh"
+#include "casm/crystallography/SimpleStructure.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+class FromStructureTest : public testing::Test {
+ protected:
+  FromStructureTest() {
+    prim = config::make_shared_prim(test::FCC_binary_prim());
+  }
+
+  std::shared_ptr<config::Prim const> prim;
+};
+
+TEST_F(FromStructureTest, BatchTest1) {
+  // structures from configurations in several supercells
+  std::vector<config::Configuration> configurations;
+  for (Index i = 1; i <= 4; ++i) {
+    Eigen::Matrix3l T = Eigen::Matrix3l::Identity();
+    T(0, 0) = i;
+    auto supercell = std::make_shared<config::Supercell const>(prim, T);
+    for (Index j = 0; j < i; ++j) {
+      config::Configuration configuration(supercell);
+      configuration.dof_values.occupation(j) = 1;
+      configurations.push_back(configuration);
+    }
+  }
+
+  config::ToAtomicStructure to_structure;
+  std::vector<xtal::SimpleStructure> structures;
+  for (auto const &configuration : configurations) {
+    structures.push_back(to_structure(configuration));
+  }
+
+  // an invalid structure does not stop the batch
+  Index n_valid = structures.size();
+  xtal::SimpleStructure invalid = structures[0];
+  invalid.atom_info.names[0] = "X";
+  structures.push_back(invalid);
+
+  auto supercells = std::make_shared<config::SupercellSet>(prim);
+  std::vector<std::string> error_messages;
+  auto results = config::make_configurations_from_structures(
+      prim, structures, error_messages, "isotropic_atomic", supercells, 1.0,
+      3);
+
+  ASSERT_EQ(results.size(), structures.size());
+  ASSERT_EQ(error_messages.size(), structures.size());
+  EXPECT_EQ(supercells->size(), 4);
+  config::FromIsotropicAtomicStructure from_structure(prim);
+  for (Index i = 0; i < n_valid; ++i) {
+    ASSERT_TRUE(results[i].has_value());
+    EXPECT_TRUE(error_messages[i].empty());
+    EXPECT_TRUE(results[i]->configuration == configurations[i]);
+    EXPECT_TRUE(results[i]->configuration ==
+                from_structure(structures[i]).configuration);
+    EXPECT_EQ(results[i]->configuration.supercell,
+              supercells->find(configurations[i].supercell)->supercell);
+  }
+  EXPECT_FALSE(results[n_valid].has_value());
+  EXPECT_FALSE(error_messages[n_valid].empty());
+}
+
+TEST_F(FromStructureTest, SiteIndicesByCoordinateTest1) {
+  Eigen::Matrix3l T;
+  T << -2, 2, 2, 2, -2, 2, 2, 2, -2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto const &converter = supercell->unitcellcoord_index_converter;
+  Index n_sites = converter.total_sites();
+  Eigen::MatrixXd const &L_super =
+      supercell->superlattice.superlattice().lat_column_mat();
+
+  // site coordinates in reverse order, some shifted by a supercell lattice
+  // vector, with small perturbations
+  Eigen::MatrixXd coords(3, n_sites);
+  for (Index i = 0; i < n_sites; ++i) {
+    Index l = n_sites - 1 - i;
+    coords.col(i) = converter(l).coordinate(*prim->basicstructure).const_cart();
+    if (i % 3 == 0) {
+      coords.col(i) += L_super.col(i % 2);
+    }
+    coords(0, i) += 1e-4;
+  }
+  Eigen::MatrixXd not_a_site(3, 1);
+  not_a_site << 1.0, 0.0, 0.0;
+
+  std::vector<Index> site_indices =
+      config::make_site_indices_by_coordinate(coords, *supercell, 1e-3);
+  ASSERT_EQ(site_indices.size(), n_sites);
+  for (Index i = 0; i < n_sites; ++i) {
+    EXPECT_EQ(site_indices[i], n_sites - 1 - i);
+  }
+  EXPECT_EQ(config::make_site_indices_by_coordinate(not_a_site, *supercell,
+                                                    1e-3)[0],
+            -1);
+}
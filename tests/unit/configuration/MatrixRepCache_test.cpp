@@ -0,0 +1,88 @@
+#include "casm/configuration/MatrixRepCache.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+std::vector<config::SupercellSymOp> make_group(
+    std::shared_ptr<config::Supercell const> const &supercell) {
+  return std::vector<config::SupercellSymOp>(
+      config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+}
+
+}  // namespace
+
+TEST(MatrixRepCacheTest, LocalAndGlobalDoF) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  std::vector<config::SupercellSymOp> group = make_group(supercell);
+  std::set<Index> sites = {0, 1, 2, 3};
+
+  config::MatrixRepCache cache;
+  std::shared_ptr<config::SymGroup const> symgroup;
+  std::shared_ptr<config::SymGroup const> expected_symgroup;
+
+  // local DoF
+  auto rep = cache.matrix_rep(group, "disp", sites);
+  auto expected =
+      config::make_sparse_matrix_rep(group, "disp", sites, expected_symgroup);
+  ASSERT_EQ(rep->sparse_matrix_rep.size(), expected.size());
+  for (Index i = 0; i < expected.size(); ++i) {
+    EXPECT_TRUE(Eigen::MatrixXd(rep->sparse_matrix_rep[i])
+                    .isApprox(Eigen::MatrixXd(expected[i])));
+  }
+  EXPECT_EQ(rep->symgroup->element.size(), expected_symgroup->element.size());
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.total_bytes(), rep->memory_bytes());
+
+  // re-used for an equal supercell
+  auto other_supercell = std::make_shared<config::Supercell const>(prim, T);
+  EXPECT_EQ(cache.matrix_rep(make_group(other_supercell), "disp", sites), rep);
+  EXPECT_EQ(cache.size(), 1);
+
+  // dense
+  auto dense = cache.make_matrix_rep(group, "disp", sites, symgroup);
+  EXPECT_EQ(symgroup, rep->symgroup);
+  auto expected_dense =
+      config::make_local_dof_matrix_rep(group, "disp", sites, symgroup);
+  ASSERT_EQ(dense.size(), expected_dense.size());
+  for (Index i = 0; i < dense.size(); ++i) {
+    EXPECT_TRUE(dense[i].isApprox(expected_dense[i]));
+  }
+
+  // global DoF, sites are ignored
+  auto global_rep = cache.matrix_rep(group, "GLstrain", std::nullopt);
+  EXPECT_EQ(cache.matrix_rep(group, "GLstrain", sites), global_rep);
+  auto expected_global =
+      config::make_global_dof_matrix_rep(group, "GLstrain", symgroup);
+  ASSERT_EQ(global_rep->sparse_matrix_rep.size(), expected_global.size());
+  EXPECT_EQ(cache.size(), 2);
+
+  // different group
+  std::vector<config::SupercellSymOp> subgroup(group.begin(),
+                                               group.begin() + 1);
+  EXPECT_NE(cache.matrix_rep(subgroup, "disp", sites), rep);
+  EXPECT_EQ(cache.size(), 3);
+
+  // eviction
+  // (the full group local DoF rep is least recently used)
+  Index max_total_bytes = cache.total_bytes() - 1;
+  cache.set_max_total_bytes(max_total_bytes);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_LE(cache.total_bytes(), max_total_bytes);
+  EXPECT_NE(cache.matrix_rep(group, "disp", sites), rep);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.total_bytes(), 0);
+
+  EXPECT_THROW(cache.matrix_rep({}, "disp", sites), std::runtime_error);
+}
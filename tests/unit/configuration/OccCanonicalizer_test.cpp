@@ -0,0 +1,154 @@
+#include "casm/configuration/OccCanonicalizer.hh"
+
+#include "casm/configuration/canonical_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+void check_occ_canonicalizer(
+    std::shared_ptr<config::Supercell const> const &supercell, int n_occ) {
+  config::OccCanonicalizer canonicalizer(supercell);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  std::vector<config::SupercellSymOp> group(begin, end);
+  config::CanonicalWitnessList recent;
+
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index trial = 0; trial < 10; ++trial) {
+    for (Index l = 0; l < occ.size(); ++l) {
+      occ(l) = (l * 7 + trial * 3 + (l * trial) % 5) % n_occ;
+    }
+    config::Configuration canonical_configuration =
+        make_canonical_form(configuration, begin, end);
+    EXPECT_EQ(canonicalizer.is_canonical(configuration),
+              is_canonical(configuration, begin, end));
+    EXPECT_EQ(canonicalizer.find_witness(occ, group.begin(), group.end()),
+              find_non_canonical_witness(configuration, group.begin(),
+                                         group.end()));
+    auto witness =
+        canonicalizer.find_witness(occ, group.begin(), group.end(), recent);
+    EXPECT_EQ(witness == group.end(), is_canonical(configuration, begin, end));
+    if (witness != group.end()) {
+      EXPECT_LT(configuration, copy_apply(*witness, configuration));
+    }
+    EXPECT_EQ(canonicalizer.to_canonical(configuration),
+              to_canonical(configuration, begin, end));
+    EXPECT_EQ(canonicalizer.make_canonical_form(configuration),
+              canonical_configuration);
+    EXPECT_TRUE(canonicalizer.is_canonical(canonical_configuration));
+    EXPECT_EQ(canonicalizer.to_canonical_pruned(configuration),
+              to_canonical(configuration, begin, end));
+    EXPECT_EQ(canonicalizer.make_canonical_form_pruned(configuration),
+              canonical_configuration);
+  }
+}
+
+}  // namespace
+
+TEST(OccCanonicalizerTest, Test1) {
+  // uses stored translation permutations
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  EXPECT_TRUE(config::OccCanonicalizer::is_supported(*prim));
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  check_occ_canonicalizer(supercell, 3);
+}
+
+TEST(OccCanonicalizerTest, Test2) {
+  // more sites than one comparison block, uses translation table
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 5, 0, 0, 0, 5, 0, 0, 0, 3;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T, 0);
+  EXPECT_FALSE(supercell->sym_info().translation_permutations.has_value());
+  check_occ_canonicalizer(supercell, 3);
+}
+
+TEST(OccCanonicalizerTest, Test3) {
+  // occupants with magnetic spin, may be anisotropic
+  auto prim = config::make_shared_prim(test::SimpleCubic_ising_prim());
+  EXPECT_TRUE(config::OccCanonicalizer::is_supported(*prim));
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  check_occ_canonicalizer(supercell, 2);
+}
+
+TEST(OccCanonicalizerTest, Test4) {
+  // continuous DoF are not supported
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_prim());
+  EXPECT_FALSE(config::OccCanonicalizer::is_supported(*prim));
+}
+
+TEST(OccCanonicalizerTest, Test5) {
+  // dilute occupations, translation pruning
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 6, 0, 0, 0, 6, 0, 0, 0, 6;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::OccCanonicalizer canonicalizer(supercell);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  occ(10) = 1;
+  occ(37) = 2;
+  occ(101) = 1;
+  EXPECT_EQ(canonicalizer.make_canonical_form_pruned(configuration),
+            make_canonical_form(configuration, begin, end));
+  EXPECT_EQ(canonicalizer.to_canonical_pruned(configuration),
+            to_canonical(configuration, begin, end));
+}
+
+TEST(OccCanonicalizerTest, Test6) {
+  // sublattices with a single allowed occupant are skipped
+  auto prim = config::make_shared_prim(test::ZrO_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  Index n_vol = supercell->superlattice.size();
+  std::vector<std::pair<Index, Index>> expected_ranges = {
+      {2 * n_vol, 4 * n_vol}};
+  EXPECT_EQ(config::make_occupation_site_ranges(prim->sym_info, n_vol),
+            expected_ranges);
+
+  config::OccCanonicalizer canonicalizer(supercell);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index trial = 0; trial < 10; ++trial) {
+    for (Index l = 2 * n_vol; l < occ.size(); ++l) {
+      occ(l) = (l * 7 + trial * 3 + (l * trial) % 5) % 2;
+    }
+
+    // check against the greatest occupation by direct transformation
+    std::vector<int> expected(occ.data(), occ.data() + occ.size());
+    for (auto it = begin; it != end; ++it) {
+      Eigen::VectorXi after =
+          copy_apply(*it, configuration).dof_values.occupation;
+      std::vector<int> value(after.data(), after.data() + after.size());
+      expected = std::max(expected, value);
+    }
+    config::Configuration canonical_configuration =
+        make_canonical_form(configuration, begin, end);
+    Eigen::VectorXi const &canonical_occ =
+        canonical_configuration.dof_values.occupation;
+    EXPECT_EQ(std::vector<int>(canonical_occ.data(),
+                               canonical_occ.data() + canonical_occ.size()),
+              expected);
+    EXPECT_EQ(canonicalizer.make_canonical_form(configuration),
+              canonical_configuration);
+    EXPECT_EQ(canonicalizer.make_canonical_form_pruned(configuration),
+              canonical_configuration);
+    EXPECT_EQ(canonicalizer.to_canonical(configuration),
+              to_canonical(configuration, begin, end));
+  }
+}
@@ -0,0 +1,106 @@
+#include "casm/configuration/PackedOccupation.hh"
+
+#include "casm/configuration/ConfigIsEquivalent.hh"
+#include "casm/configuration/OccCanonicalizer.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(PackedOccupationTest, Test1) {
+  Eigen::VectorXi occ(5);
+  occ << 0, 2, 1, 15, 3;
+  config::PackedOccupation packed(occ);
+  EXPECT_EQ(packed.bits_per_site(), 4);
+  EXPECT_EQ(packed.data().size(), 3);
+  EXPECT_EQ(packed.unpack(), occ);
+
+  occ(3) = 16;
+  config::PackedOccupation packed_8(occ);
+  EXPECT_EQ(packed_8.bits_per_site(), 8);
+  EXPECT_EQ(packed_8.data().size(), 5);
+  EXPECT_EQ(packed_8.unpack(), occ);
+
+  // comparisons match lexicographical order of occupant indices
+  EXPECT_TRUE(packed < packed_8);
+  Eigen::VectorXi occ_b(5);
+  occ_b << 0, 2, 2, 0, 0;
+  config::PackedOccupation packed_b(occ_b);
+  EXPECT_TRUE(packed < packed_b);
+  EXPECT_TRUE(packed_8 < packed_b);
+  EXPECT_EQ(packed_b, config::PackedOccupation(occ_b));
+}
+
+TEST(PackedOccupationTest, Test2) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index l = 0; l < occ.size(); ++l) {
+    occ(l) = (l * 7 + (l * l) % 5) % 3;
+  }
+  config::PackedConfiguration packed(configuration);
+  EXPECT_EQ(packed.unpack(), configuration);
+
+  // PackedOccupationIsEquivalent matches ConfigIsEquivalent
+  config::ConfigIsEquivalent equal_to(configuration);
+  config::PackedOccupationIsEquivalent packed_equal_to(packed.occupation,
+                                                       *supercell);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto it = begin; it != end; ++it) {
+    bool is_equal = equal_to(*it);
+    EXPECT_EQ(packed_equal_to(*it), is_equal);
+    if (!is_equal) {
+      EXPECT_EQ(packed_equal_to.is_less(), equal_to.is_less());
+    }
+  }
+}
+
+TEST(OccConfigurationTest, Test1) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::OccCanonicalizer canonicalizer(supercell);
+
+  std::set<config::Configuration> configurations;
+  std::set<config::OccConfiguration> occ_configurations;
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index i = 0; i < 12; ++i) {
+    for (Index l = 0; l < occ.size(); ++l) {
+      occ(l) = (l * i + (i * i) % 5) % 3;
+    }
+    config::OccConfiguration occ_configuration(configuration);
+    EXPECT_EQ(occ_configuration.to_configuration(), configuration);
+
+    // primitive check and canonical form match Configuration
+    EXPECT_EQ(config::is_primitive(occ_configuration),
+              config::is_primitive(configuration));
+    config::Configuration canonical =
+        config::make_canonical_form(configuration,
+                                    config::SupercellSymOp::begin(supercell),
+                                    config::SupercellSymOp::end(supercell));
+    EXPECT_EQ(canonicalizer.make_canonical_form(occ_configuration)
+                  .to_configuration(),
+              canonical);
+    EXPECT_EQ(canonicalizer.make_canonical_form_pruned(occ_configuration)
+                  .to_configuration(),
+              canonical);
+    EXPECT_EQ(canonicalizer.is_canonical(occ_configuration),
+              canonical == configuration);
+
+    configurations.insert(configuration);
+    occ_configurations.insert(occ_configuration);
+  }
+
+  // set order matches Configuration
+  EXPECT_EQ(config::to_configurations(occ_configurations), configurations);
+}
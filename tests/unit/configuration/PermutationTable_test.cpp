@@ -0,0 +1,107 @@
+#include "casm/configuration/sym_info/PermutationTable.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(PermutationTableTest, NarrowAndWide) {
+  std::vector<config::sym_info::Permutation> permutations{{2, 0, 1},
+                                                          {0, 1, 2}};
+  config::sym_info::PermutationTable table(permutations);
+  EXPECT_FALSE(table.is_wide());
+  EXPECT_EQ(table.size(), 2);
+  EXPECT_EQ(table.permutation_size(), 3);
+  EXPECT_EQ(table.memory_bytes(), 6 * sizeof(std::uint16_t));
+  EXPECT_EQ(table(0, 0), 2);
+  EXPECT_EQ(table[0][2], 1);
+  EXPECT_EQ(config::sym_info::Permutation(table[0]), permutations[0]);
+  EXPECT_EQ(table.permutations(), permutations);
+
+  Index sum = 0;
+  table.visit(0, [&](auto const *perm) {
+    for (Index i = 0; i < table.permutation_size(); ++i) {
+      sum += perm[i] * i;
+    }
+  });
+  EXPECT_EQ(sum, 2);
+
+  // more than 2^16 sites uses 32-bit entries
+  config::sym_info::PermutationTable wide(2, 3, 70000);
+  EXPECT_TRUE(wide.is_wide());
+  EXPECT_EQ(wide.memory_bytes(), 6 * sizeof(std::uint32_t));
+  wide.set(1, 2, 69999);
+  EXPECT_EQ(wide(1, 2), 69999);
+  EXPECT_EQ(wide[1][2], 69999);
+  EXPECT_FALSE(wide == table);
+}
+
+TEST(PermutationTableTest, SupercellSymInfo) {
+  auto prim = config::make_shared_prim(test::ZrO_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto const &sym_info = supercell->sym_info();
+
+  std::vector<config::sym_info::Permutation> factor_group_permutations =
+      config::make_factor_group_permutations(
+          sym_info.factor_group->head_group_index,
+          prim->sym_info.unitcellcoord_symgroup_rep,
+          supercell->unitcellcoord_index_converter);
+  EXPECT_EQ(sym_info.factor_group_permutations.permutations(),
+            factor_group_permutations);
+  ASSERT_TRUE(sym_info.translation_permutations.has_value());
+  EXPECT_EQ(sym_info.translation_permutations->permutations(),
+            config::make_translation_permutations(
+                supercell->unitcell_index_converter,
+                supercell->unitcellcoord_index_converter));
+
+  // public API returns Index permutations
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto op = config::SupercellSymOp::begin(supercell); op != end; ++op) {
+    auto const &fg_perm =
+        factor_group_permutations[op.supercell_factor_group_index()];
+    config::sym_info::Permutation const &trans_perm = op.translation_permute();
+    config::sym_info::Permutation combined_perm = op.combined_permute();
+    for (Index i = 0; i < combined_perm.size(); ++i) {
+      EXPECT_EQ(combined_perm[i], fg_perm[trans_perm[i]]);
+      EXPECT_EQ(op.permute_index(i), combined_perm[i]);
+    }
+  }
+}
+
+TEST(PermutationTableTest, TranslationTablePermutations) {
+  auto prim = config::make_shared_prim(test::ZrO_prim());
+  Eigen::Matrix3l T;
+  T << 2, 1, 0, -1, 2, 1, 0, 0, 3;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto const &sym_info = supercell->sym_info();
+  auto const &head_group_index = sym_info.factor_group->head_group_index;
+
+  std::vector<config::sym_info::Permutation> expected_factor_group =
+      config::make_factor_group_permutations(
+          head_group_index, prim->sym_info.unitcellcoord_symgroup_rep,
+          supercell->unitcellcoord_index_converter);
+  std::vector<config::sym_info::Permutation> expected_translation =
+      config::make_translation_permutations(
+          supercell->unitcell_index_converter,
+          supercell->unitcellcoord_index_converter);
+  EXPECT_EQ(sym_info.factor_group_permutations.permutations(),
+            expected_factor_group);
+
+  // same result for any number of threads
+  for (Index n_threads : {1, 3, 0}) {
+    EXPECT_EQ(config::make_factor_group_permutations(
+                  head_group_index, prim->sym_info.unitcellcoord_symgroup_rep,
+                  sym_info.translation_table, n_threads)
+                  .permutations(),
+              expected_factor_group);
+    EXPECT_EQ(config::make_translation_permutations(sym_info.translation_table,
+                                                    n_threads)
+                  .permutations(),
+              expected_translation);
+  }
+}
@@ -0,0 +1,126 @@
+#include "casm/configuration/PrimSymInfoCache.hh"
+
+#include <sstream>
+
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/io/json/PrimSymInfo_json_io.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "gtest/gtest.h"
+#include "testdir.hh"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+void expect_equal(config::PrimSymInfo const &A, config::PrimSymInfo const &B) {
+  ASSERT_EQ(A.factor_group->element.size(), B.factor_group->element.size());
+  for (Index i = 0; i < A.factor_group->element.size(); ++i) {
+    auto const &opA = A.factor_group->element[i];
+    auto const &opB = B.factor_group->element[i];
+    EXPECT_TRUE(opA.matrix.isApprox(opB.matrix));
+    EXPECT_TRUE(opA.translation.isApprox(opB.translation) ||
+                (opA.translation.isZero() && opB.translation.isZero()));
+    EXPECT_EQ(opA.is_time_reversal_active, opB.is_time_reversal_active);
+    auto const &repA = A.unitcellcoord_symgroup_rep[i];
+    auto const &repB = B.unitcellcoord_symgroup_rep[i];
+    EXPECT_EQ(repA.point_matrix, repB.point_matrix);
+    EXPECT_EQ(repA.sublattice_index, repB.sublattice_index);
+    EXPECT_EQ(repA.unitcell_indices, repB.unitcell_indices);
+  }
+  EXPECT_EQ(A.factor_group->multiplication_table,
+            B.factor_group->multiplication_table);
+  EXPECT_EQ(A.point_group->element.size(), B.point_group->element.size());
+  EXPECT_EQ(A.has_occupation_dofs, B.has_occupation_dofs);
+  EXPECT_EQ(A.sublattice_has_occupation_dofs, B.sublattice_has_occupation_dofs);
+  EXPECT_EQ(A.has_aniso_occs, B.has_aniso_occs);
+  EXPECT_EQ(A.occ_symgroup_rep, B.occ_symgroup_rep);
+  EXPECT_EQ(A.max_n_occupants, B.max_n_occupants);
+  EXPECT_EQ(A.occ_remap_table, B.occ_remap_table);
+  EXPECT_EQ(A.atom_position_symgroup_rep, B.atom_position_symgroup_rep);
+
+  ASSERT_EQ(A.local_dof_symgroup_rep.size(), B.local_dof_symgroup_rep.size());
+  for (auto const &pair : A.local_dof_symgroup_rep) {
+    auto const &repB = B.local_dof_symgroup_rep.at(pair.first);
+    ASSERT_EQ(pair.second.size(), repB.size());
+    for (Index i = 0; i < pair.second.size(); ++i) {
+      ASSERT_EQ(pair.second[i].size(), repB[i].size());
+      for (Index b = 0; b < pair.second[i].size(); ++b) {
+        EXPECT_EQ(pair.second[i][b].rows(), repB[i][b].rows());
+        EXPECT_EQ(pair.second[i][b].cols(), repB[i][b].cols());
+        EXPECT_TRUE(pair.second[i][b].isApprox(repB[i][b]));
+      }
+    }
+  }
+  ASSERT_EQ(A.global_dof_symgroup_rep.size(),
+            B.global_dof_symgroup_rep.size());
+  for (auto const &pair : A.global_dof_symgroup_rep) {
+    auto const &repB = B.global_dof_symgroup_rep.at(pair.first);
+    ASSERT_EQ(pair.second.size(), repB.size());
+    for (Index i = 0; i < pair.second.size(); ++i) {
+      EXPECT_TRUE(pair.second[i].isApprox(repB[i]));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(PrimSymInfoCacheTest, JsonIO) {
+  for (auto const &prim :
+       {test::FCC_ternary_GLstrain_disp_prim(), test::FCC_dimer_prim(),
+        test::ZrO_prim(), test::SimpleCubic_ising_prim()}) {
+    config::PrimSymInfo prim_sym_info(prim);
+    jsonParser json;
+    to_json(prim_sym_info, json);
+    std::stringstream ss;
+    ss << json;
+    jsonParser read_json = jsonParser::parse(ss.str());
+    config::PrimSymInfo read_prim_sym_info =
+        jsonConstructor<config::PrimSymInfo>::from_json(read_json, prim);
+    expect_equal(read_prim_sym_info, prim_sym_info);
+  }
+}
+
+TEST(PrimSymInfoCacheTest, Memory) {
+  config::PrimSymInfoCache cache;
+  auto prim_sym_info = cache.prim_sym_info(test::FCC_binary_prim());
+  expect_equal(*prim_sym_info, config::PrimSymInfo(test::FCC_binary_prim()));
+  EXPECT_EQ(cache.size(), 1);
+
+  // equal prim, constructed separately, share PrimSymInfo
+  EXPECT_EQ(cache.prim_sym_info(test::FCC_binary_prim()), prim_sym_info);
+  EXPECT_EQ(cache.size(), 1);
+
+  // different prim do not
+  EXPECT_NE(cache.prim_sym_info(test::FCC_ternary_prim()), prim_sym_info);
+  EXPECT_EQ(cache.size(), 2);
+
+  auto basicstructure =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+  auto prim = cache.make_prim(basicstructure);
+  EXPECT_EQ(prim->basicstructure, basicstructure);
+  expect_equal(prim->sym_info, *prim_sym_info);
+  EXPECT_EQ(cache.size(), 2);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(PrimSymInfoCacheTest, CacheDir) {
+  test::TmpDir tmp_dir;
+  auto prim = test::FCC_ternary_GLstrain_disp_prim();
+  std::string hash = config::make_prim_sym_info_cache_hash(
+      config::make_prim_sym_info_cache_key(prim));
+
+  config::PrimSymInfoCache cache(tmp_dir.path());
+  auto prim_sym_info = cache.prim_sym_info(prim);
+  EXPECT_TRUE(fs::exists(tmp_dir.path() / (hash + ".json")));
+
+  // a new cache reads the PrimSymInfo file
+  config::PrimSymInfoCache other_cache(tmp_dir.path());
+  auto read_prim_sym_info = other_cache.prim_sym_info(prim);
+  EXPECT_NE(read_prim_sym_info, prim_sym_info);
+  expect_equal(*read_prim_sym_info, *prim_sym_info);
+}
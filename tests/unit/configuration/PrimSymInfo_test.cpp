@@ -95,3 +95,40 @@ TEST(PrimSymInfoTest, Test5) {
   EXPECT_EQ(prim_sym_info.local_dof_symgroup_rep.size(), 1);
   EXPECT_EQ(prim_sym_info.global_dof_symgroup_rep.size(), 0);
 }
+
+TEST(PrimSymInfoTest, OccRemapTable) {
+  auto prim = test::FCC_dimer_prim();
+  config::PrimSymInfo prim_sym_info(prim);
+
+  EXPECT_EQ(prim_sym_info.max_n_occupants, 3);
+  for (Index g = 0; g < prim_sym_info.occ_symgroup_rep.size(); ++g) {
+    auto const &occ_rep = prim_sym_info.occ_symgroup_rep[g];
+    for (Index b = 0; b < occ_rep.size(); ++b) {
+      std::int32_t const *remap = prim_sym_info.occ_remap(g, b);
+      for (Index occ = 0; occ < occ_rep[b].size(); ++occ) {
+        EXPECT_EQ(remap[occ], occ_rep[b][occ]);
+      }
+    }
+  }
+}
+
+TEST(PrimSymInfoTest, LocalDoFRepTable) {
+  config::PrimSymInfo prim_sym_info(test::FCC_ternary_GLstrain_disp_prim());
+
+  std::vector<DoFKey> expected_keys({"disp", "occ"});
+  EXPECT_EQ(prim_sym_info.local_dof_keys, expected_keys);
+  EXPECT_EQ(prim_sym_info.local_dof_id("disp"), 0);
+  EXPECT_EQ(prim_sym_info.local_dof_id("occ"), 1);
+  EXPECT_EQ(prim_sym_info.local_dof_id("GLstrain"), -1);
+  for (auto const &dof : prim_sym_info.local_dof_symgroup_rep) {
+    Index dof_id = prim_sym_info.local_dof_id(dof.first);
+    for (Index g = 0; g < dof.second.size(); ++g) {
+      for (Index b = 0; b < dof.second[g].size(); ++b) {
+        Eigen::MatrixXd const &M = dof.second[g][b];
+        EXPECT_EQ(prim_sym_info.local_dof_dim(dof_id, b), M.cols());
+        EXPECT_EQ(Eigen::MatrixXd(prim_sym_info.local_dof_rep(dof_id, g, b)),
+                  M);
+      }
+    }
+  }
+}
@@ -0,0 +1,100 @@
+#include "casm/configuration/ProgressMonitor.hh"
+
+#include <thread>
+
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/configuration/sym_info/factor_group.hh"
+#include "casm/configuration/sym_info/unitcellcoord_sym_info.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+struct ProgressReport {
+  std::string stage;
+  Index n_done;
+  Index n_total;
+};
+
+}  // namespace
+
+TEST(ProgressMonitorTest, Test1) {
+  std::vector<ProgressReport> reports;
+  config::ProgressMonitor progress(
+      [&](std::string const &stage, Index n_done, Index n_total) {
+        reports.push_back({stage, n_done, n_total});
+      },
+      nullptr, 0.0);
+
+  progress.begin("stage_a", 3);
+  ASSERT_EQ(reports.size(), 1);
+  EXPECT_EQ(reports.back().stage, "stage_a");
+  EXPECT_EQ(reports.back().n_done, 0);
+  EXPECT_EQ(reports.back().n_total, 3);
+
+  progress.advance();
+  progress.advance(2);
+  ASSERT_EQ(reports.size(), 3);
+  EXPECT_EQ(reports.back().n_done, 3);
+  EXPECT_EQ(progress.n_done(), 3);
+
+  // advance from another thread: counted, but not reported
+  std::thread worker([&]() { progress.advance(); });
+  worker.join();
+  EXPECT_EQ(reports.size(), 3);
+  EXPECT_EQ(progress.n_done(), 4);
+
+  // begin resets n_done
+  progress.begin("stage_b");
+  ASSERT_EQ(reports.size(), 4);
+  EXPECT_EQ(reports.back().stage, "stage_b");
+  EXPECT_EQ(reports.back().n_done, 0);
+  EXPECT_EQ(reports.back().n_total, -1);
+}
+
+TEST(ProgressMonitorTest, Test2) {
+  auto cancel_flag = std::make_shared<std::atomic<bool>>(false);
+  config::ProgressMonitor progress({}, cancel_flag);
+  progress.begin("stage_a", 10);
+  EXPECT_NO_THROW(progress.advance());
+  EXPECT_FALSE(progress.is_cancelled());
+
+  cancel_flag->store(true);
+  EXPECT_TRUE(progress.is_cancelled());
+  EXPECT_THROW(progress.advance(), config::OperationCancelled);
+  EXPECT_THROW(progress.check(), config::OperationCancelled);
+  EXPECT_THROW(progress.begin("stage_b"), config::OperationCancelled);
+}
+
+TEST(ProgressMonitorTest, Test3) {
+  auto prim =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+  auto factor_group = sym_info::make_factor_group(*prim);
+  auto unitcellcoord_symgroup_rep =
+      sym_info::make_unitcellcoord_symgroup_rep(factor_group->element, *prim);
+  clust::SiteFilterFunction site_filter = clust::dof_sites_filter();
+  std::vector<double> max_length = {0, 0, 4.01, 4.01};
+  std::vector<clust::IntegralClusterOrbitGenerator> custom_generators = {};
+
+  // reports each branch, and gives the same orbits
+  std::set<std::string> stages;
+  auto progress = std::make_shared<config::ProgressMonitor>(
+      [&](std::string const &stage, Index n_done, Index n_total) {
+        stages.insert(stage);
+      });
+  auto orbits = make_prim_periodic_orbits(
+      prim, unitcellcoord_symgroup_rep, site_filter, max_length,
+      custom_generators, 1, progress);
+  EXPECT_EQ(orbits.size(), 6);
+  EXPECT_EQ(stages.size(), 3);
+
+  // cancelled before starting
+  progress->cancel();
+  EXPECT_THROW(make_prim_periodic_orbits(prim, unitcellcoord_symgroup_rep,
+                                         site_filter, max_length,
+                                         custom_generators, 1, progress),
+               config::OperationCancelled);
+}
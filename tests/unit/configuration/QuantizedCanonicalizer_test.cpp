@@ -0,0 +1,101 @@
+#include "casm/configuration/QuantizedCanonicalizer.hh"
+
+#include <unordered_set>
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+class QuantizedCanonicalizerTest : public testing::Test {
+ protected:
+  QuantizedCanonicalizerTest() {
+    auto prim =
+        config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+    Eigen::Matrix3l T;
+    T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  /// \brief Set occupation and continuous DoF values on a grid
+  void set_values(config::Configuration &configuration, Index trial) {
+    auto &dof_values = configuration.dof_values;
+    Eigen::VectorXi &occ = dof_values.occupation;
+    for (Index l = 0; l < occ.size(); ++l) {
+      occ(l) = (l * 7 + trial * 3 + (l * trial) % 5) % 3;
+    }
+    Eigen::MatrixXd &disp = dof_values.local_dof_values.at("disp");
+    for (Index i = 0; i < disp.size(); ++i) {
+      disp(i) = quantum * ((i * 5 + trial) % 7 - 3);
+    }
+    Eigen::VectorXd &strain = dof_values.global_dof_values.at("GLstrain");
+    for (Index i = 0; i < strain.size(); ++i) {
+      strain(i) = quantum * ((i * 3 + trial) % 4 - 1);
+    }
+  }
+
+  double quantum = 0.01;
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(QuantizedCanonicalizerTest, Test1) {
+  EXPECT_TRUE(config::QuantizedCanonicalizer::is_supported(*supercell->prim));
+  config::QuantizedCanonicalizer canonicalizer(supercell, quantum);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  config::Configuration configuration(supercell);
+  for (Index trial = 0; trial < 10; ++trial) {
+    set_values(configuration, trial);
+
+    // quantize / dequantize round trip
+    config::QuantizedDoFValues quantized =
+        canonicalizer.quantize(configuration.dof_values);
+    EXPECT_EQ(canonicalizer.dequantize(quantized), configuration);
+
+    config::Configuration canonical_configuration =
+        make_canonical_form(configuration, begin, end);
+    EXPECT_EQ(canonicalizer.is_canonical(configuration),
+              is_canonical(configuration, begin, end));
+    EXPECT_EQ(canonicalizer.to_canonical(configuration),
+              to_canonical(configuration, begin, end));
+    EXPECT_EQ(canonicalizer.make_canonical_form(configuration),
+              canonical_configuration);
+    EXPECT_TRUE(canonicalizer.is_canonical(canonical_configuration));
+    EXPECT_EQ(canonicalizer.make_canonical_quantized(configuration),
+              canonicalizer.quantize(canonical_configuration.dof_values));
+  }
+}
+
+TEST_F(QuantizedCanonicalizerTest, HashSet) {
+  config::QuantizedCanonicalizer canonicalizer(supercell, quantum);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  config::Configuration configuration(supercell);
+  set_values(configuration, 3);
+
+  // all equivalents have equal quantized canonical forms and hash values
+  config::UnorderedConfigurationSet configuration_set({}, quantum);
+  std::unordered_set<config::QuantizedDoFValues,
+                     config::QuantizedDoFValuesHash>
+      quantized_set;
+  for (auto it = begin; it != end; ++it) {
+    config::Configuration equivalent = copy_apply(*it, configuration);
+    configuration_set.insert(canonicalizer.make_canonical_form(equivalent));
+    quantized_set.insert(canonicalizer.make_canonical_quantized(equivalent));
+  }
+  EXPECT_EQ(configuration_set.size(), 1);
+  EXPECT_EQ(quantized_set.size(), 1);
+  EXPECT_EQ(configuration_set.quantum(), quantum);
+}
+
+TEST_F(QuantizedCanonicalizerTest, OffGrid) {
+  config::QuantizedCanonicalizer canonicalizer(supercell, quantum);
+  config::Configuration configuration(supercell);
+  configuration.dof_values.local_dof_values.at("disp")(0, 0) = 0.005;
+  EXPECT_THROW(canonicalizer.quantize(configuration.dof_values),
+               std::runtime_error);
+}
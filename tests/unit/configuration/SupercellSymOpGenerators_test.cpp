@@ -0,0 +1,115 @@
+#include "casm/configuration/SupercellSymOpGenerators.hh"
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/group/subgroups.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Return the operations generated by `generators`, by repeated
+///     multiplication
+std::set<config::SupercellSymOp> make_generated(
+    std::vector<config::SupercellSymOp> const &generators) {
+  std::set<config::SupercellSymOp> generated(generators.begin(),
+                                             generators.end());
+  std::vector<config::SupercellSymOp> members(generated.begin(),
+                                              generated.end());
+  for (Index l = 0; l < members.size(); ++l) {
+    for (auto const &op : generators) {
+      config::SupercellSymOp product = members[l] * op;
+      if (generated.insert(product).second) {
+        members.push_back(product);
+      }
+    }
+  }
+  return generated;
+}
+
+}  // namespace
+
+TEST(GroupGeneratorsTest, Test1) {
+  auto basicstructure =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+  config::Prim prim(basicstructure);
+  auto const &factor_group = *prim.sym_info.factor_group;
+
+  std::vector<Index> generators = group::make_generators(factor_group);
+  EXPECT_LE(generators.size(), 6);
+  group::IndexBitset generator_bits(factor_group.element.size(), generators);
+  EXPECT_EQ(
+      group::make_closure(factor_group.multiplication_table, generator_bits)
+          .count(),
+      factor_group.element.size());
+
+  // not a subgroup
+  group::IndexBitset not_subgroup(factor_group.element.size());
+  not_subgroup.insert(0);
+  not_subgroup.insert(generators[0]);
+  if (!group::is_closed(factor_group.multiplication_table, not_subgroup)) {
+    EXPECT_THROW(
+        group::make_generators(factor_group.multiplication_table,
+                               not_subgroup),
+        std::runtime_error);
+  }
+}
+
+TEST(SupercellSymOpGeneratorsTest, Test1) {
+  using namespace config;
+  auto basicstructure =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+  auto prim = std::make_shared<Prim const>(basicstructure);
+
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<Supercell const>(prim, T);
+  auto begin = SupercellSymOp::begin(supercell);
+  auto end = SupercellSymOp::end(supercell);
+  std::vector<SupercellSymOp> supercell_group(begin, end);
+
+  Configuration background(supercell);
+  background.dof_values.occupation(0) = 1;
+  background.dof_values.occupation(1) = 1;
+  std::vector<SupercellSymOp> background_group =
+      make_invariant_subgroup(background, begin, end);
+  std::set<SupercellSymOp> background_set(background_group.begin(),
+                                          background_group.end());
+
+  for (auto const *group : {&supercell_group, &background_group}) {
+    // greedy generators generate the group, and each at least doubles it
+    std::vector<SupercellSymOp> generators = make_generators(*group);
+    EXPECT_LE(Index(1) << generators.size(), group->size());
+    std::set<SupercellSymOp> expected(group->begin(), group->end());
+    EXPECT_EQ(make_generated(generators), expected);
+
+    // stabilizer chain
+    SupercellSymOpStabilizerChain chain(*group);
+    EXPECT_EQ(chain.group_size(), group->size());
+    Index order = chain.kernel().size();
+    for (Index i = 0; i < chain.base().size(); ++i) {
+      order *= chain.basic_orbit(i).size();
+    }
+    EXPECT_EQ(order, group->size());
+    EXPECT_EQ(make_generated(chain.strong_generators()), expected);
+    for (auto const &op : chain.kernel()) {
+      for (Index l = 0; l < background.dof_values.occupation.size(); ++l) {
+        EXPECT_EQ(op.permute_index(l), l);
+      }
+    }
+  }
+
+  // membership
+  SupercellSymOpStabilizerChain chain(background_group);
+  for (auto const &op : supercell_group) {
+    EXPECT_EQ(chain.contains(op), background_set.count(op) == 1);
+  }
+
+  // not a group
+  std::vector<SupercellSymOp> not_group({supercell_group[1]});
+  EXPECT_THROW(make_generators(not_group), std::runtime_error);
+}
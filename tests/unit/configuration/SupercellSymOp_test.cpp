@@ -25,9 +25,9 @@ class SupercellSymOpFCCTest : public testing::Test {
 };
 
 TEST_F(SupercellSymOpFCCTest, Test1) {
-  EXPECT_EQ(supercell->sym_info.factor_group->element.size(), 48);
-  EXPECT_EQ(supercell->sym_info.translation_permutations->size(), 4);
-  EXPECT_EQ(supercell->sym_info.factor_group_permutations.size(), 48);
+  EXPECT_EQ(supercell->sym_info().factor_group->element.size(), 48);
+  EXPECT_EQ(supercell->sym_info().translation_permutations->size(), 4);
+  EXPECT_EQ(supercell->sym_info().factor_group_permutations.size(), 48);
 }
 
 TEST_F(SupercellSymOpFCCTest, Test2) {
@@ -219,6 +219,196 @@ TEST_F(SupercellSymOpFCCTernaryGLStrainDispTest, TestInverse) {
   }
 }
 
+TEST(SupercellSymOpTest, ProductAndInverseNonsymmorphic) {
+  // ZrO (hcp Zr) has factor group operations with fractional translations
+  auto prim = config::make_shared_prim(test::ZrO_prim());
+  Eigen::Matrix3l T;
+  T << 1, 0, 0, 0, 1, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto it_a = begin; it_a != end; ++it_a) {
+    // inverse(a) * a is the identity
+    config::SupercellSymOp identity = it_a.inverse() * (*it_a);
+    EXPECT_EQ(identity.supercell_factor_group_index(), 0);
+    EXPECT_EQ(identity.translation_index(), 0);
+
+    // (a * b) permutes as b, then a
+    for (auto it_b = begin; it_b != end; ++it_b) {
+      config::SupercellSymOp product = (*it_a) * (*it_b);
+      for (Index i = 0; i < n_sites; ++i) {
+        EXPECT_EQ(product.permute_index(i),
+                  it_b->permute_index(it_a->permute_index(i)));
+      }
+    }
+  }
+}
+
+TEST(SupercellSymOpTest, SupercellSymGroup) {
+  auto prim = config::make_shared_prim(test::ZrO_prim());
+  Eigen::Matrix3l T;
+  T << 1, 0, 0, 0, 1, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  auto symgroup = config::make_supercell_symgroup(supercell);
+  ASSERT_TRUE(symgroup != nullptr);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  EXPECT_EQ(symgroup->element.size(), std::distance(begin, end));
+
+  // products and inverses match SupercellSymOpHandle
+  for (Index i = 0; i < symgroup->element.size(); ++i) {
+    config::SupercellSymOpHandle const &a = symgroup->element[i];
+    EXPECT_EQ(a.op_index(), i);
+    EXPECT_EQ(symgroup->element[symgroup->inv(i)], a.inverse());
+    for (Index j = 0; j < symgroup->element.size(); ++j) {
+      config::SupercellSymOpHandle const &b = symgroup->element[j];
+      EXPECT_EQ(symgroup->element[symgroup->mult(i, j)], a * b);
+    }
+  }
+  EXPECT_FALSE(group::make_conjugacy_classes(*symgroup).empty());
+
+  // invariant subgroup
+  config::Configuration configuration(supercell);
+  configuration.dof_values.occupation(4) = 1;
+  auto subgroup = make_invariant_subgroup(configuration, symgroup);
+  std::vector<config::SupercellSymOp> expected =
+      make_invariant_subgroup(configuration, begin, end);
+  ASSERT_EQ(subgroup->element.size(), expected.size());
+  for (Index i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(subgroup->element[i], config::SupercellSymOpHandle(expected[i]));
+  }
+
+  // tables larger than the limit are not constructed
+  EXPECT_TRUE(config::make_supercell_symgroup(supercell, 0) == nullptr);
+}
+
+TEST_F(SupercellSymOpFCCTernaryGLStrainDispTest, TestWorkspace) {
+  // test copy_apply into existing values and apply with a workspace
+  config::Configuration configuration(supercell);
+  clexulator::ConfigDoFValues dof_values = configuration.dof_values;
+  dof_values.occupation(0) = 1;
+  dof_values.occupation(1) = 2;
+  dof_values.local_dof_values.at("disp")(0, 0) = 1.0;
+  dof_values.local_dof_values.at("disp")(1, 1) = 0.5;
+  dof_values.global_dof_values.at("GLstrain")(0) = 0.01;
+
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  // `dest` starts empty, and is re-used for all ops
+  clexulator::ConfigDoFValues dest;
+  clexulator::ConfigDoFValues workspace;
+  double const *disp_data = nullptr;
+  for (auto it = begin; it != end; ++it) {
+    clexulator::ConfigDoFValues expected = copy_apply(*it, dof_values);
+
+    copy_apply(*it, dof_values, dest);
+    EXPECT_TRUE(almost_equal(dest.occupation, expected.occupation));
+    EXPECT_TRUE(almost_equal(dest.local_dof_values.at("disp"),
+                             expected.local_dof_values.at("disp")));
+    EXPECT_TRUE(almost_equal(dest.global_dof_values.at("GLstrain"),
+                             expected.global_dof_values.at("GLstrain")));
+    if (disp_data != nullptr) {
+      // storage is re-used
+      EXPECT_EQ(dest.local_dof_values.at("disp").data(), disp_data);
+    }
+    disp_data = dest.local_dof_values.at("disp").data();
+
+    clexulator::ConfigDoFValues in_place = dof_values;
+    apply(*it, in_place, workspace);
+    EXPECT_TRUE(almost_equal(in_place.occupation, expected.occupation));
+    EXPECT_TRUE(almost_equal(in_place.local_dof_values.at("disp"),
+                             expected.local_dof_values.at("disp")));
+    EXPECT_TRUE(almost_equal(in_place.global_dof_values.at("GLstrain"),
+                             expected.global_dof_values.at("GLstrain")));
+  }
+}
+
+TEST_F(SupercellSymOpFCCTernaryGLStrainDispTest, TestBatchedDoFTransform) {
+  config::Configuration configuration(supercell);
+  clexulator::ConfigDoFValues dof_values = configuration.dof_values;
+  dof_values.occupation(0) = 1;
+  dof_values.occupation(1) = 2;
+  dof_values.local_dof_values.at("disp")(0, 0) = 1.0;
+  dof_values.local_dof_values.at("disp")(1, 1) = 0.5;
+  dof_values.local_dof_values.at("disp")(2, 3) = 0.25;
+  dof_values.global_dof_values.at("GLstrain")(0) = 0.01;
+  dof_values.global_dof_values.at("GLstrain")(3) = 0.02;
+
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  config::BatchedDoFTransform transform(dof_values, begin, end);
+
+  clexulator::ConfigDoFValues dest;
+  for (auto it = begin; it != end; ++it) {
+    EXPECT_TRUE(transform.contains(it->prim_factor_group_index()));
+    clexulator::ConfigDoFValues expected = copy_apply(*it, dof_values);
+    transform.copy_apply(*it, dest);
+    EXPECT_TRUE(almost_equal(dest.occupation, expected.occupation));
+    EXPECT_TRUE(almost_equal(dest.local_dof_values.at("disp"),
+                             expected.local_dof_values.at("disp")));
+    EXPECT_TRUE(almost_equal(dest.global_dof_values.at("GLstrain"),
+                             expected.global_dof_values.at("GLstrain")));
+  }
+
+  // only the given prim factor group operations are transformed
+  config::BatchedDoFTransform identity_transform(dof_values, *supercell,
+                                                 std::set<Index>({0}));
+  EXPECT_TRUE(identity_transform.contains(0));
+  EXPECT_FALSE(identity_transform.contains(1));
+  identity_transform.copy_apply(*begin, dest);
+  EXPECT_TRUE(almost_equal(dest.local_dof_values.at("disp"),
+                           dof_values.local_dof_values.at("disp")));
+}
+
+TEST_F(SupercellSymOpFCCTernaryGLStrainDispTest, TestHandle) {
+  // test SupercellSymOpHandle against SupercellSymOp
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  std::vector<config::SupercellSymOpHandle> handles;
+  for (auto it = begin; it != end; ++it) {
+    handles.emplace_back(*it);
+  }
+
+  Index op_index = 0;
+  sym_info::Permutation perm;
+  config::SupercellSymOp op = begin;
+  for (auto it = begin; it != end; ++it, ++op_index) {
+    config::SupercellSymOpHandle const &handle = handles[op_index];
+    EXPECT_EQ(handle.supercell(), supercell.get());
+    EXPECT_EQ(handle.op_index(), op_index);
+    EXPECT_EQ(handle.prim_factor_group_index(), it->prim_factor_group_index());
+    for (Index i = 0; i < n_sites; ++i) {
+      EXPECT_EQ(handle.permute_index(i), it->permute_index(i));
+    }
+    handle.combined_permute(perm);
+    EXPECT_EQ(perm, it->combined_permute());
+    EXPECT_EQ(handle.combined_permute(), it->combined_permute());
+    EXPECT_TRUE(almost_equal(handle.to_symop().matrix, it->to_symop().matrix));
+    EXPECT_EQ(handle.inverse(), config::SupercellSymOpHandle(it->inverse()));
+
+    // use one SupercellSymOp as a cursor
+    op.reset(handle.supercell_factor_group_index(), handle.translation_index());
+    EXPECT_EQ(op, *it);
+    EXPECT_EQ(config::SupercellSymOp(supercell, handle), *it);
+  }
+
+  for (Index a = 0; a < Index(handles.size()); a += 7) {
+    for (Index b = 0; b < Index(handles.size()); b += 5) {
+      auto product = config::SupercellSymOp(supercell, handles[a]) *
+                     config::SupercellSymOp(supercell, handles[b]);
+      EXPECT_EQ(handles[a] * handles[b],
+                config::SupercellSymOpHandle(product));
+    }
+  }
+  EXPECT_TRUE(handles.front() < handles.back());
+}
+
 // Test make global matrix rep
 TEST_F(SupercellSymOpFCCTernaryGLStrainDispTest, TestGlobalMatrixRep1) {
   config::Configuration configuration(supercell);
@@ -311,6 +501,44 @@ TEST_F(SupercellSymOpFCCTernaryGLStrainDispTest, TestLocalMatrixRep2) {
   EXPECT_EQ(disp_matrix_rep.size(), 2 * 16);
 }
 
+// Test make local sparse matrix rep
+TEST_F(SupercellSymOpFCCTernaryGLStrainDispTest, TestLocalSparseMatrixRep) {
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+
+  std::vector<config::SupercellSymOp> group(
+      config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+  std::set<Index> site_indices;
+  for (Index l = 0; l < n_sites; ++l) {
+    site_indices.emplace(l);
+  }
+
+  std::vector<Eigen::SparseMatrix<double>> sparse_rep =
+      make_local_dof_sparse_matrix_rep(group, "disp", site_indices, symgroup);
+  std::vector<Eigen::MatrixXd> dense_rep =
+      make_local_dof_matrix_rep(group, "disp", site_indices, symgroup);
+  ASSERT_EQ(sparse_rep.size(), 4 * 48);
+  ASSERT_EQ(dense_rep.size(), sparse_rep.size());
+
+  Index dim = 3 * n_sites;
+  for (Index i = 0; i < sparse_rep.size(); ++i) {
+    Eigen::SparseMatrix<double> const &M = sparse_rep[i];
+    EXPECT_EQ(M.rows(), dim);
+    EXPECT_EQ(M.cols(), dim);
+    EXPECT_LE(M.nonZeros(), 3 * dim);
+    EXPECT_TRUE(almost_equal(Eigen::MatrixXd(M), dense_rep[i]));
+    Eigen::MatrixXd MMt = Eigen::MatrixXd(M * M.transpose());
+    EXPECT_TRUE(almost_equal(MMt, Eigen::MatrixXd::Identity(dim, dim)));
+  }
+
+  // make_sparse_matrix_rep forwards to make_local_dof_sparse_matrix_rep
+  std::vector<Eigen::SparseMatrix<double>> sparse_rep_2 =
+      make_sparse_matrix_rep(group, "disp", site_indices, symgroup);
+  ASSERT_EQ(sparse_rep_2.size(), sparse_rep.size());
+  EXPECT_TRUE(almost_equal(Eigen::MatrixXd(sparse_rep_2[1]),
+                           Eigen::MatrixXd(sparse_rep[1])));
+}
+
 class SupercellSymOpSimpleCubicIsingTest : public testing::Test {
  protected:
   SupercellSymOpSimpleCubicIsingTest() {
@@ -344,3 +572,128 @@ TEST_F(SupercellSymOpSimpleCubicIsingTest, Test1) {
   EXPECT_TRUE(almost_equal(occ_count,
                            Eigen::VectorXi::Constant(size, 1 * 48 + 7 * 48)));
 }
+
+TEST(SupercellTranslationTableTest, Test1) {
+  // compare compact translation table to explicit translation permutations
+  auto prim = config::make_shared_prim(test::ZrO_prim());
+  Eigen::Matrix3l T;
+  T << 2, 1, 0, -1, 2, 1, 0, 1, 3;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T, 0);
+  EXPECT_FALSE(supercell->sym_info().translation_permutations.has_value());
+
+  config::SupercellTranslationTable const &table =
+      supercell->sym_info().translation_table;
+  Index n_unitcells = supercell->unitcell_index_converter.total_sites();
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  EXPECT_EQ(table.n_translations(), n_unitcells);
+  EXPECT_EQ(table.n_sites(), n_sites);
+
+  sym_info::Permutation perm;
+  for (Index t = 0; t < n_unitcells; ++t) {
+    sym_info::Permutation expected = config::make_translation_permutation(
+        t, supercell->unitcell_index_converter,
+        supercell->unitcellcoord_index_converter);
+    table.make_permutation(t, perm);
+    EXPECT_EQ(perm, expected);
+  }
+
+  // compare SupercellSymOp::permute_index to combined_permute
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto it = begin; it != end; ++it) {
+    sym_info::Permutation combined = it->combined_permute();
+    for (Index i = 0; i < n_sites; ++i) {
+      EXPECT_EQ(it->permute_index(i), combined[i]);
+    }
+  }
+}
+
+TEST(CombinedPermutationTableTest, Test1) {
+  auto prim = config::make_shared_prim(test::ZrO_prim());
+  Eigen::Matrix3l T;
+  T << 2, 1, 0, -1, 2, 1, 0, 1, 3;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T, 0);
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+
+  Index max_table_bytes = config::combined_permutation_table_max_bytes();
+  Index max_total_bytes = config::combined_permutation_table_max_total_bytes();
+  Index initial_total_bytes = config::combined_permutation_table_total_bytes();
+
+  // compare table to SupercellSymOp::permute_index
+  auto table = supercell->sym_info().combined_permutation_table();
+  ASSERT_TRUE(table != nullptr);
+  EXPECT_EQ(table->n_sites(), n_sites);
+  EXPECT_EQ(table->n_active_sites(), n_sites / 2);
+  EXPECT_FALSE(table->all_active());
+  EXPECT_EQ(table, supercell->sym_info().combined_permutation_table());
+  EXPECT_EQ(config::combined_permutation_table_total_bytes(),
+            initial_total_bytes + table->memory_bytes());
+  Index op_index = 0;
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto it = begin; it != end; ++it, ++op_index) {
+    for (Index i = 0; i < n_sites; ++i) {
+      if (table->active_index()[i] < 0) {
+        continue;
+      }
+      EXPECT_EQ(table->permute_index(op_index, i), it->permute_index(i));
+    }
+  }
+  EXPECT_EQ(op_index, table->n_ops());
+
+  // the least recently used table is evicted when over the total limit
+  auto other_supercell =
+      std::make_shared<config::Supercell const>(prim, Eigen::Matrix3l(T * 2));
+  config::set_combined_permutation_table_limits(max_table_bytes,
+                                                table->memory_bytes());
+  auto other_table = other_supercell->sym_info().combined_permutation_table();
+  ASSERT_TRUE(other_table != nullptr);
+  EXPECT_EQ(config::combined_permutation_table_total_bytes(),
+            other_table->memory_bytes());
+  EXPECT_NE(table, supercell->sym_info().combined_permutation_table());
+
+  // tables larger than the limit are not constructed
+  config::set_combined_permutation_table_limits(0, max_total_bytes);
+  EXPECT_TRUE(supercell->sym_info().combined_permutation_table() == nullptr);
+
+  config::set_combined_permutation_table_limits(max_table_bytes,
+                                                max_total_bytes);
+}
+
+TEST(SupercellActiveSitesTest, Test1) {
+  // ZrO: Zr sublattices 0 and 1 are fixed, O/Va sublattices 2 and 3 are not
+  auto prim = config::make_shared_prim(test::ZrO_prim());
+  Eigen::Matrix3l T;
+  T << 2, 1, 0, -1, 2, 1, 0, 1, 3;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  Index n_vol = supercell->superlattice.size();
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+
+  config::SupercellActiveSites const &active_sites =
+      supercell->sym_info().active_sites;
+  EXPECT_EQ(active_sites.n_sites, n_sites);
+  EXPECT_EQ(active_sites.n_active_sites, 2 * n_vol);
+  EXPECT_FALSE(active_sites.all_active);
+  ASSERT_EQ(active_sites.ranges.size(), 1);
+  EXPECT_EQ(active_sites.ranges[0].first, 2 * n_vol);
+  EXPECT_EQ(active_sites.ranges[0].second, 4 * n_vol);
+  EXPECT_EQ(active_sites.active_index[0], -1);
+  EXPECT_EQ(active_sites.active_index[2 * n_vol], 0);
+
+  // transformation over active sites only matches the full permutation
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index l = 2 * n_vol; l < n_sites; ++l) {
+    occ(l) = (l * 7 + l / 3) % 2;
+  }
+  clexulator::ConfigDoFValues dest;
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto it = begin; it != end; ++it) {
+    copy_apply(*it, configuration.dof_values, dest);
+    sym_info::Permutation perm = it->combined_permute();
+    for (Index l = 0; l < n_sites; ++l) {
+      EXPECT_EQ(dest.occupation(l), occ(perm[l]));
+    }
+  }
+}
@@ -1,6 +1,8 @@
 #include "casm/configuration/Supercell.hh"
 
 #include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/canonical_form.hh"
 #include "gtest/gtest.h"
 #include "teststructures.hh"
 
@@ -14,7 +16,147 @@ TEST(SupercellTest, Test1) {
   T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
   std::shared_ptr<config::Supercell const> supercell =
       std::make_shared<config::Supercell const>(prim, T);
-  EXPECT_EQ(supercell->sym_info.factor_group->element.size(), 48);
-  EXPECT_EQ(supercell->sym_info.translation_permutations->size(), 4);
-  EXPECT_EQ(supercell->sym_info.factor_group_permutations.size(), 48);
+  EXPECT_EQ(supercell->sym_info().factor_group->element.size(), 48);
+  EXPECT_EQ(supercell->sym_info().translation_permutations->size(), 4);
+  EXPECT_EQ(supercell->sym_info().factor_group_permutations.size(), 48);
+}
+
+TEST(SupercellTest, MakeSharedSupercellTest) {
+  std::shared_ptr<config::Prim const> prim =
+      config::make_shared_prim(test::FCC_binary_prim());
+
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell_a = config::make_shared_supercell(prim, T);
+  auto supercell_b = config::make_shared_supercell(prim, T);
+  EXPECT_EQ(supercell_a.get(), supercell_b.get());
+
+  // different max_n_translation_permutations gives a different Supercell
+  auto supercell_c = config::make_shared_supercell(prim, T, 0);
+  EXPECT_NE(supercell_a.get(), supercell_c.get());
+  EXPECT_EQ(*supercell_a, *supercell_c);
+
+  // different prim gives a different Supercell
+  std::shared_ptr<config::Prim const> other_prim =
+      config::make_shared_prim(test::FCC_binary_prim());
+  auto supercell_d = config::make_shared_supercell(other_prim, T);
+  EXPECT_NE(supercell_a.get(), supercell_d.get());
+  EXPECT_EQ(supercell_d->prim, other_prim);
+}
+
+TEST(SupercellTest, SupercellSetIndexTest) {
+  std::shared_ptr<config::Prim const> prim =
+      config::make_shared_prim(test::FCC_binary_prim());
+  config::SupercellSet supercells(prim);
+
+  Eigen::Matrix3l T1 = Eigen::Matrix3l::Identity();
+  Eigen::Matrix3l T2;
+  T2 << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  Eigen::Matrix3l T3 = 2 * Eigen::Matrix3l::Identity();
+
+  EXPECT_TRUE(supercells.insert(T1).second);
+  auto supercell_2 = config::make_shared_supercell(prim, T2);
+  EXPECT_TRUE(supercells.insert(supercell_2).second);
+  EXPECT_FALSE(supercells.insert(T2).second);
+  EXPECT_EQ(supercells.size(), 2);
+
+  // lookup by shared_ptr, matrix, and name agree
+  auto it = supercells.find(T2);
+  ASSERT_TRUE(it != supercells.end());
+  EXPECT_TRUE(supercells.find(supercell_2) == it);
+  EXPECT_EQ(supercells.count(supercell_2), 1);
+  EXPECT_EQ(supercells.count(T3), 0);
+  if (it->is_canonical) {
+    EXPECT_TRUE(supercells.find_canonical_by_name(it->supercell_name) == it);
+  }
+
+  // insert_canonical finds existing and inserts new
+  std::string name_1 = supercells.find(T1)->supercell_name;
+  EXPECT_FALSE(supercells.insert_canonical(name_1).second);
+  auto result = supercells.insert_canonical("SCEL8_2_2_2_0_0_0");
+  EXPECT_TRUE(result.second);
+  EXPECT_TRUE(supercells.find_canonical_by_name("SCEL8_2_2_2_0_0_0") ==
+              result.first);
+  EXPECT_EQ(supercells.size(), 3);
+
+  // erase removes from the indexes
+  EXPECT_EQ(supercells.erase(supercell_2), 1);
+  EXPECT_EQ(supercells.count(T2), 0);
+  EXPECT_EQ(supercells.erase(T2), 0);
+  EXPECT_EQ(supercells.erase_canonical_by_name("SCEL8_2_2_2_0_0_0"), 1);
+  EXPECT_EQ(supercells.count_canonical_by_name("SCEL8_2_2_2_0_0_0"), 0);
+  EXPECT_EQ(supercells.size(), 1);
+
+  // direct access to the data rebuilds the indexes
+  supercells.data().emplace(config::make_shared_supercell(prim, T2));
+  EXPECT_EQ(supercells.count(T2), 1);
+  EXPECT_EQ(supercells.count(T1), 1);
+
+  supercells.clear();
+  EXPECT_EQ(supercells.count(T1), 0);
+  EXPECT_TRUE(supercells.find_canonical_by_name(name_1) == supercells.end());
+}
+
+TEST(SupercellTest, EquivalentSupercellSymInfoTest) {
+  std::vector<Eigen::Matrix3l> T_list(3);
+  T_list[0] << 1, 1, 0, 0, 2, 0, 0, 0, 1;
+  T_list[1] << 1, 0, 0, 0, 1, 0, 0, 0, 3;
+  T_list[2] << 2, 1, 0, 0, 1, 1, 1, 0, 2;
+
+  // ZrO has factor group operations with non-lattice translations
+  for (auto const &xtal_prim : {test::ZrO_prim(), test::FCC_binary_prim()}) {
+    auto prim = config::make_shared_prim(xtal_prim);
+    for (auto const &T : T_list) {
+      auto supercell = std::make_shared<config::Supercell const>(prim, T);
+      auto canonical_supercell = config::make_canonical_form(*supercell);
+      auto shared_supercell = std::make_shared<config::Supercell const>(
+          prim, T, 100, canonical_supercell);
+
+      auto const &expected = supercell->sym_info();
+      auto const &sym_info = shared_supercell->sym_info();
+      EXPECT_EQ(sym_info.factor_group->head_group_index,
+                expected.factor_group->head_group_index);
+      EXPECT_EQ(sym_info.factor_group_permutations,
+                expected.factor_group_permutations);
+
+      // and in the other direction
+      Eigen::Matrix3l const &canonical_T =
+          canonical_supercell->superlattice.transformation_matrix_to_super();
+      config::Supercell shared_canonical_supercell(prim, canonical_T, 100,
+                                                   supercell);
+      EXPECT_EQ(shared_canonical_supercell.sym_info().factor_group_permutations,
+                canonical_supercell->sym_info().factor_group_permutations);
+    }
+
+    // not equivalent
+    auto other_supercell = std::make_shared<config::Supercell const>(
+        prim, Eigen::Matrix3l::Identity());
+    EXPECT_THROW(config::Supercell(prim, T_list[0], 100, other_supercell),
+                 std::runtime_error);
+  }
+}
+
+TEST(SupercellTest, SupercellSetEquivalentSymInfoTest) {
+  auto prim = config::make_shared_prim(test::ZrO_prim());
+  std::vector<Eigen::Matrix3l> T_list(2);
+  T_list[0] << 1, 1, 0, 0, 2, 0, 0, 0, 1;
+  T_list[1] << 2, 1, 0, 0, 1, 1, 1, 0, 2;
+
+  // insert the canonical supercell, then a non-canonical supercell, which
+  // shares the canonical supercell's symmetry info
+  Index n_checked = 0;
+  for (auto const &T : T_list) {
+    config::Supercell expected(prim, T);
+    if (config::is_canonical(expected)) {
+      continue;
+    }
+    config::SupercellSet supercells(prim);
+    supercells.insert_canonical(expected.canonical_name());
+    auto result = supercells.insert(T);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(result.first->supercell->sym_info().factor_group_permutations,
+              expected.sym_info().factor_group_permutations);
+    ++n_checked;
+  }
+  EXPECT_GT(n_checked, 0);
 }
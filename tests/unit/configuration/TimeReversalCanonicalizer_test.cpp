@@ -0,0 +1,82 @@
+#include "casm/configuration/TimeReversalCanonicalizer.hh"
+
+#include "casm/configuration/canonical_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Check TimeReversalCanonicalizer against canonical_form.hh
+void check_canonical_forms(std::vector<config::Configuration> const &configs) {
+  auto const &supercell = configs[0].supercell;
+  ASSERT_TRUE(
+      config::TimeReversalCanonicalizer::is_supported(*supercell->prim));
+  config::TimeReversalCanonicalizer canonicalizer(supercell);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  // spatial operations are half of the factor group
+  Index n_fg = supercell->sym_info().factor_group->element.size();
+  EXPECT_EQ(canonicalizer.spatial_factor_group_indices().size() * 2, n_fg);
+
+  for (auto const &configuration : configs) {
+    config::SupercellSymOp expected_op =
+        to_canonical(configuration, begin, end);
+    config::SupercellSymOp op = canonicalizer.to_canonical(configuration);
+    EXPECT_EQ(op.supercell_factor_group_index(),
+              expected_op.supercell_factor_group_index());
+    EXPECT_EQ(op.translation_index(), expected_op.translation_index());
+
+    config::Configuration canonical =
+        canonicalizer.make_canonical_form(configuration);
+    EXPECT_TRUE(canonical == make_canonical_form(configuration, begin, end));
+    EXPECT_EQ(canonicalizer.is_canonical(configuration),
+              is_canonical(configuration, begin, end));
+    EXPECT_TRUE(canonicalizer.is_canonical(canonical));
+  }
+}
+
+}  // namespace
+
+TEST(TimeReversalCanonicalizerTest, DiscreteMagspin) {
+  auto prim = config::make_shared_prim(test::SimpleCubic_ising_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  std::vector<config::Configuration> configs;
+  for (Index trial = 0; trial < 8; ++trial) {
+    config::Configuration configuration(supercell);
+    Eigen::VectorXi &occ = configuration.dof_values.occupation;
+    for (Index l = 0; l < occ.size(); ++l) {
+      occ(l) = ((l * 3 + trial) % 5) < 2 ? 1 : 0;
+    }
+    configs.push_back(configuration);
+  }
+  check_canonical_forms(configs);
+}
+
+TEST(TimeReversalCanonicalizerTest, ContinuousMagspin) {
+  auto prim = config::make_shared_prim(test::FCC_binary_Cmagspin_prim());
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  std::vector<config::Configuration> configs;
+  for (Index trial = 0; trial < 8; ++trial) {
+    config::Configuration configuration(supercell);
+    auto &dof_values = configuration.dof_values;
+    Eigen::VectorXi &occ = dof_values.occupation;
+    for (Index l = 0; l < occ.size(); ++l) {
+      occ(l) = (l + trial) % 2;
+    }
+    Eigen::MatrixXd &magspin = dof_values.local_dof_values.at("Cmagspin");
+    for (Index i = 0; i < magspin.size(); ++i) {
+      magspin(i) = 0.5 * ((i * 5 + trial) % 3 - 1);
+    }
+    configs.push_back(configuration);
+  }
+  check_canonical_forms(configs);
+}
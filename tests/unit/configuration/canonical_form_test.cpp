@@ -1,5 +1,7 @@
 #include "casm/configuration/canonical_form.hh"
 
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/copy_configuration.hh"
 #include "casm/misc/CASM_Eigen_math.hh"
 #include "gtest/gtest.h"
 #include "teststructures.hh"
@@ -49,6 +51,60 @@ TEST_F(CanonicalFormFCCTest, TestSupercell2) {
   EXPECT_EQ(equivalents.size(), 3);
 }
 
+TEST_F(CanonicalFormFCCTest, TestSupercellHNF) {
+  using namespace config;
+  Lattice const &prim_lattice = prim->basicstructure->lattice();
+  std::vector<Eigen::Matrix3l> frac_point_group = make_frac_point_matrices(
+      prim_lattice, prim->sym_info.point_group->element);
+  std::vector<Eigen::Matrix3l> frac_factor_group = make_frac_point_matrices(
+      prim_lattice, prim->sym_info.factor_group->element);
+  SupercellSet supercells(prim);
+
+  Eigen::Matrix3d S;
+  S << 4., 0, 0, 0, 8., 0, 0, 0, 4.;
+  auto tmp_supercell = std::make_shared<Supercell const>(
+      prim, xtal::Superlattice(prim_lattice, xtal::Lattice(S)));
+  Eigen::Matrix3l T =
+      tmp_supercell->superlattice.transformation_matrix_to_super();
+  Eigen::Matrix3l H = make_hnf(T);
+  EXPECT_EQ(H.determinant(), std::abs(T.determinant()));
+  EXPECT_EQ(make_hnf(H), H);
+
+  // one HNF per distinct equivalent lattice, canonical first
+  std::vector<Eigen::Matrix3l> hnfs =
+      make_equivalent_hnfs(T, frac_point_group);
+  EXPECT_EQ(hnfs.size(), make_equivalents(*tmp_supercell).size());
+  Eigen::Matrix3l canonical_hnf = make_canonical_hnf(T, frac_point_group);
+  EXPECT_EQ(hnfs[0], canonical_hnf);
+
+  auto canonical_supercell = make_canonical_form(*tmp_supercell);
+  Eigen::Matrix3l canonical_T =
+      canonical_supercell->superlattice.transformation_matrix_to_super();
+  for (auto const &equiv : make_equivalents(*tmp_supercell)) {
+    Eigen::Matrix3l equiv_T =
+        equiv->superlattice.transformation_matrix_to_super();
+    EXPECT_EQ(make_canonical_hnf(equiv_T, frac_point_group), canonical_hnf);
+
+    // integer and lattice-based operation search agree
+    EXPECT_EQ(
+        find_frac_op_index_to_supercell(equiv_T, canonical_T,
+                                        frac_factor_group),
+        prim_factor_group_index_to_supercell(equiv, canonical_supercell));
+
+    // SupercellSet canonical supercell is unchanged by the HNF memo
+    auto result = supercells.canonical_supercell(equiv);
+    EXPECT_EQ(*result.first, *canonical_supercell);
+  }
+  EXPECT_EQ(supercells.size(), 1);
+
+  // a different shape with the same volume is not equivalent
+  Eigen::Matrix3l T2;
+  T2 << 8, 0, 0, 0, 1, 0, 0, 0, 1;
+  EXPECT_EQ(std::abs(T2.determinant()), std::abs(T.determinant()));
+  EXPECT_NE(make_canonical_hnf(T2, frac_point_group), canonical_hnf);
+  EXPECT_EQ(find_frac_op_index_to_supercell(T, T2, frac_factor_group), -1);
+}
+
 TEST_F(CanonicalFormFCCTest, Test1) {
   config::Configuration configuration(supercell);
   Eigen::VectorXi &occ = configuration.dof_values.occupation;
@@ -66,6 +122,74 @@ TEST_F(CanonicalFormFCCTest, Test1) {
       almost_equal(canonical_configuration.dof_values.occupation, expected));
 }
 
+TEST_F(CanonicalFormFCCTest, NonCanonicalWitness) {
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  std::vector<config::SupercellSymOp> group(
+      config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+  config::CanonicalWitnessList recent(2);
+
+  occ << 0, 0, 1, 0;
+  auto first = find_non_canonical_witness(configuration, group.begin(),
+                                          group.end());
+  ASSERT_TRUE(first != group.end());
+  EXPECT_LT(configuration, copy_apply(*first, configuration));
+  EXPECT_FALSE(is_canonical(configuration, group.begin(), group.end()));
+  EXPECT_EQ(find_non_canonical_witness(configuration, group.begin(),
+                                       group.end(), recent),
+            first);
+  EXPECT_EQ(recent.n_scans(), 1);
+  EXPECT_EQ(recent.indices(), std::vector<Index>({first - group.begin()}));
+
+  // the recent witness is tried first
+  occ << 0, 1, 1, 0;
+  auto witness = find_non_canonical_witness(configuration, group.begin(),
+                                            group.end(), recent);
+  ASSERT_TRUE(witness != group.end());
+  EXPECT_LT(configuration, copy_apply(*witness, configuration));
+  EXPECT_EQ(recent.n_hits() + recent.n_scans(), 2);
+
+  // canonical: no witness
+  occ << 1, 0, 0, 0;
+  EXPECT_TRUE(find_non_canonical_witness(configuration, group.begin(),
+                                         group.end()) == group.end());
+  EXPECT_TRUE(find_non_canonical_witness(configuration, group.begin(),
+                                         group.end(), recent) == group.end());
+  EXPECT_LE(recent.indices().size(), 2);
+}
+
+TEST(CanonicalWitnessListTest, MoveToFront) {
+  config::CanonicalWitnessList recent(2);
+  std::vector<Index> tested;
+  auto is_witness_of = [&](std::set<Index> const &witnesses) {
+    return [&, witnesses](Index i) {
+      tested.push_back(i);
+      return witnesses.count(i) != 0;
+    };
+  };
+
+  EXPECT_EQ(recent.find(10, is_witness_of({5, 7})), 5);
+  EXPECT_EQ(tested, std::vector<Index>({0, 1, 2, 3, 4, 5}));
+  EXPECT_EQ(recent.find(10, is_witness_of({7})), 7);
+  EXPECT_EQ(recent.indices(), std::vector<Index>({7, 5}));
+
+  // a recent witness is found first, and moved to the front
+  tested.clear();
+  EXPECT_EQ(recent.find(10, is_witness_of({3, 5})), 5);
+  EXPECT_EQ(tested, std::vector<Index>({7, 5}));
+  EXPECT_EQ(recent.indices(), std::vector<Index>({5, 7}));
+
+  // at most max_size are kept, and recent witnesses are not tested twice
+  tested.clear();
+  EXPECT_EQ(recent.find(10, is_witness_of({6})), 6);
+  EXPECT_EQ(tested, std::vector<Index>({5, 7, 0, 1, 2, 3, 4, 6}));
+  EXPECT_EQ(recent.indices(), std::vector<Index>({6, 5}));
+  EXPECT_EQ(recent.find(10, is_witness_of({})), -1);
+  EXPECT_EQ(recent.n_hits(), 1);
+  EXPECT_EQ(recent.n_scans(), 4);
+}
+
 TEST_F(CanonicalFormFCCTest, Test2) {
   config::Configuration configuration(supercell);
   Eigen::VectorXi &occ = configuration.dof_values.occupation;
@@ -172,6 +296,46 @@ TEST_F(CanonicalFormFCCTernaryGLStrainDispTest, Test2) {
   EXPECT_EQ(equivalents.size(), 3);
 }
 
+TEST_F(CanonicalFormFCCTernaryGLStrainDispTest, EquivalenceMap) {
+  config::Configuration configuration(supercell);
+  clexulator::ConfigDoFValues &dof_values = configuration.dof_values;
+  dof_values.occupation(2) = 1;
+  dof_values.local_dof_values.at("disp")(2, 2) = 1.0;
+
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  std::vector<config::Configuration> equivalents =
+      make_equivalents(configuration, begin, end);
+  std::vector<std::vector<config::SupercellSymOp>> equivalence_map =
+      make_equivalence_map(equivalents, begin, end);
+  ASSERT_EQ(equivalence_map.size(), equivalents.size());
+
+  // compare to trial application of every operation
+  std::vector<std::vector<config::SupercellSymOp>> expected(
+      equivalents.size());
+  for (auto it = begin; it != end; ++it) {
+    config::Configuration equiv = copy_apply(*it, equivalents[0]);
+    auto equiv_it = std::find(equivalents.begin(), equivalents.end(), equiv);
+    ASSERT_TRUE(equiv_it != equivalents.end());
+    expected[equiv_it - equivalents.begin()].push_back(*it);
+  }
+  EXPECT_EQ(equivalence_map, expected);
+
+  // unsorted equivalents
+  std::reverse(equivalents.begin(), equivalents.end());
+  equivalence_map = make_equivalence_map(equivalents, begin, end);
+  ASSERT_EQ(equivalence_map.size(), equivalents.size());
+  Index n_ops = 0;
+  for (Index i = 0; i < equivalence_map.size(); ++i) {
+    for (auto const &op : equivalence_map[i]) {
+      EXPECT_EQ(copy_apply(op, equivalents[0]), equivalents[i]);
+      ++n_ops;
+    }
+  }
+  EXPECT_EQ(n_ops, std::distance(begin, end));
+}
+
 TEST_F(CanonicalFormFCCTernaryGLStrainDispTest, Test3) {
   config::Configuration configuration(supercell);
   clexulator::ConfigDoFValues &dof_values = configuration.dof_values;
@@ -234,3 +398,133 @@ TEST_F(CanonicalFormFCCTernaryGLStrainDispTest, Test4) {
       expected_GLstrain,
       canonical_configuration.dof_values.global_dof_values.at("GLstrain")));
 }
+
+class CanonicalFormParallelTest : public testing::Test {
+ protected:
+  CanonicalFormParallelTest() {
+    auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+    Eigen::Matrix3l T;
+    T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(CanonicalFormParallelTest, Test1) {
+  // parallel overloads give the same results as the serial versions
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index trial = 0; trial < 20; ++trial) {
+    for (Index l = 0; l < occ.size(); ++l) {
+      occ(l) = (l * 7 + trial * 3 + (l * trial) % 5) % 3;
+    }
+    for (Index n_threads : {1, 3, 8}) {
+      EXPECT_EQ(is_canonical(configuration, begin, end),
+                is_canonical(configuration, begin, end, n_threads));
+      EXPECT_EQ(to_canonical(configuration, begin, end),
+                to_canonical(configuration, begin, end, n_threads));
+      EXPECT_EQ(make_canonical_form(configuration, begin, end),
+                make_canonical_form(configuration, begin, end, n_threads));
+      EXPECT_EQ(make_invariant_subgroup(configuration, begin, end),
+                make_invariant_subgroup(configuration, begin, end, n_threads));
+    }
+  }
+}
+
+TEST_F(CanonicalFormParallelTest, MakeCanonicalForms) {
+  // batch version gives the same results as the single configuration version
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  std::vector<config::Configuration> configurations;
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index trial = 0; trial < 100; ++trial) {
+    for (Index l = 0; l < occ.size(); ++l) {
+      occ(l) = (l * 7 + trial * 3 + (l * trial) % 5) % 3;
+    }
+    configurations.push_back(configuration);
+  }
+
+  Index n_translations = supercell->unitcell_index_converter.total_sites();
+  for (Index n_threads : {1, 3}) {
+    std::vector<Index> op_indices;
+    std::vector<config::Configuration> canonical = make_canonical_forms(
+        configurations, supercell, n_threads, &op_indices);
+    ASSERT_EQ(canonical.size(), configurations.size());
+    ASSERT_EQ(op_indices.size(), configurations.size());
+    for (Index i = 0; i < Index(configurations.size()); ++i) {
+      EXPECT_EQ(canonical[i],
+                make_canonical_form(configurations[i], begin, end));
+      config::SupercellSymOp op(supercell, op_indices[i] / n_translations,
+                                op_indices[i] % n_translations);
+      EXPECT_EQ(op, to_canonical(configurations[i], begin, end));
+    }
+  }
+}
+
+TEST_F(CanonicalFormFCCTernaryGLStrainDispTest, MakeCanonicalForms) {
+  // batch version with continuous DoF
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  std::vector<config::Configuration> configurations;
+  for (Index trial = 0; trial < 10; ++trial) {
+    config::Configuration configuration(supercell);
+    clexulator::ConfigDoFValues &dof_values = configuration.dof_values;
+    dof_values.occupation(trial % 4) = 1 + trial % 2;
+    dof_values.global_dof_values.at("GLstrain")(trial % 6) = 0.01;
+    dof_values.local_dof_values.at("disp")(trial % 3, (trial + 1) % 4) = 0.1;
+    configurations.push_back(configuration);
+  }
+
+  std::vector<Index> op_indices;
+  std::vector<config::Configuration> canonical =
+      make_canonical_forms(configurations, supercell, 2, &op_indices);
+  Index n_translations = supercell->unitcell_index_converter.total_sites();
+  for (Index i = 0; i < Index(configurations.size()); ++i) {
+    EXPECT_EQ(canonical[i],
+              make_canonical_form(configurations[i], begin, end));
+    config::SupercellSymOp op(supercell, op_indices[i] / n_translations,
+                              op_indices[i] % n_translations);
+    EXPECT_EQ(op, to_canonical(configurations[i], begin, end));
+  }
+}
+
+TEST(CanonicalFormInvariantSubgroupTest, TranslationStabilizerFirst) {
+  // includes non-primitive configurations, with invariant translations
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  for (Index trial = 0; trial < 8; ++trial) {
+    config::Configuration configuration(supercell);
+    clexulator::ConfigDoFValues &dof_values = configuration.dof_values;
+    Index n_sites = dof_values.occupation.size();
+    for (Index l = 0; l < n_sites; ++l) {
+      dof_values.occupation(l) = (l % (trial + 1)) == 0 ? 1 : 0;
+    }
+    if (trial % 3 == 1) {
+      dof_values.local_dof_values.at("disp")(trial % 3, 0) = 0.1;
+    }
+    if (trial % 3 == 2) {
+      dof_values.global_dof_values.at("GLstrain")(0) = 0.01;
+    }
+
+    std::vector<config::SupercellSymOp> expected =
+        make_invariant_subgroup(configuration, begin, end);
+    std::vector<config::SupercellSymOp> subgroup =
+        make_invariant_subgroup(configuration);
+    ASSERT_EQ(subgroup.size(), expected.size());
+    for (Index i = 0; i < Index(subgroup.size()); ++i) {
+      EXPECT_EQ(subgroup[i], expected[i]);
+    }
+  }
+}
@@ -1,6 +1,7 @@
 #include "casm/configuration/config_space_analysis.hh"
 
 #include "casm/casm_io/Log.hh"
+#include "casm/configuration/DoFSpace_functions.hh"
 #include "casm/crystallography/io/BasicStructureIO.hh"
 #include "casm/misc/CASM_Eigen_math.hh"
 #include "gtest/gtest.h"
@@ -264,4 +265,193 @@ TEST_F(ConfigSpaceAnalysisTest, Test4) {
   expected.col(2) << 0.0, -0.5, 0.0, -0.5, 0.5, 0.0, 0.5, 0.0;
   expected.col(3) << 0.0, 0.5, 0.0, 0.5, 0.5, 0.0, 0.5, 0.0;
   EXPECT_TRUE(almost_equal(basis, expected));
-}
\ No newline at end of file
+}
+TEST_F(ConfigSpaceAnalysisTest, Test5) {
+  make_prim(test::FCC_binary_prim());
+  build_configurations_1();
+
+  // Perform config space analysis, storing equivalents
+  std::map<DoFKey, config::ConfigSpaceAnalysisResults> results =
+      config::config_space_analysis(
+          configurations, dofs, exclude_homogeneous_modes,
+          include_default_occ_modes, sublattice_index_to_default_occ,
+          site_index_to_default_occ, tol);
+
+  // Perform config space analysis, without storing equivalents
+  bool store_equivalents = false;
+  Index batch_size = 3;
+  Index n_threads = 2;
+  std::map<DoFKey, config::ConfigSpaceAnalysisResults> streaming_results =
+      config::config_space_analysis(
+          configurations, dofs, exclude_homogeneous_modes,
+          include_default_occ_modes, sublattice_index_to_default_occ,
+          site_index_to_default_occ, tol, store_equivalents, batch_size,
+          n_threads);
+
+  auto const &expected = results.at("occ");
+  auto const &streaming = streaming_results.at("occ");
+  EXPECT_TRUE(streaming.equivalent_configurations.empty());
+  EXPECT_TRUE(streaming.equivalent_dof_values.empty());
+  EXPECT_TRUE(almost_equal(streaming.projector, expected.projector))
+      << "streaming:\n"
+      << streaming.projector << "\nexpected:\n"
+      << expected.projector << std::endl;
+  EXPECT_TRUE(almost_equal(streaming.eigenvalues, expected.eigenvalues));
+  expect_same_basis_vectors(streaming.symmetry_adapted_dof_space.basis,
+                            expected.symmetry_adapted_dof_space.basis);
+}
+
+TEST_F(ConfigSpaceAnalysisTest, AccumulatorTest1) {
+  make_prim(test::FCC_binary_prim());
+  build_configurations_1();
+
+  std::map<DoFKey, config::ConfigSpaceAnalysisResults> results =
+      config::config_space_analysis(
+          configurations, dofs, exclude_homogeneous_modes,
+          include_default_occ_modes, sublattice_index_to_default_occ,
+          site_index_to_default_occ, tol);
+  auto const &expected = results.at("occ");
+
+  auto expect_same_results = [&](config::ConfigSpaceAnalysisResults const &r) {
+    EXPECT_TRUE(almost_equal(r.projector, expected.projector))
+        << "accumulated:\n"
+        << r.projector << "\nexpected:\n"
+        << expected.projector << std::endl;
+    EXPECT_TRUE(almost_equal(r.eigenvalues, expected.eigenvalues));
+    expect_same_basis_vectors(r.symmetry_adapted_dof_space.basis,
+                              expected.symmetry_adapted_dof_space.basis);
+  };
+
+  // add the prim cell configurations, then the others, which grows the
+  // supercell and rebuilds the projector
+  config::ConfigSpaceAnalysisAccumulator accumulator(prim, "occ");
+  std::map<std::string, config::Configuration> first(
+      {{"A1", configurations.at("A1")}, {"B1", configurations.at("B1")}});
+  EXPECT_EQ(accumulator.insert(first), 2);
+  EXPECT_EQ(accumulator.dim(), 1);
+  EXPECT_EQ(accumulator.results().eigenvalues.size(), 1);
+
+  std::map<std::string, config::Configuration> second(
+      {{"A3B1", configurations.at("A3B1")},
+       {"A1B3", configurations.at("A1B3")}});
+  EXPECT_EQ(accumulator.insert(second), 2);
+  EXPECT_EQ(accumulator.n_prototypes(), 4);
+  EXPECT_EQ(accumulator.dim(), expected.standard_dof_space.basis.cols());
+  expect_same_results(accumulator.results());
+
+  // equivalent configurations are skipped, and identifiers may not be reused
+  std::map<std::string, config::Configuration> again(
+      {{"A1_again", configurations.at("A1")}});
+  EXPECT_EQ(accumulator.insert(again), 0);
+  EXPECT_EQ(accumulator.insert(first), 0);
+  config::ConfigSpaceAnalysisAccumulator other(prim, "occ");
+  other.insert(first);
+  std::map<std::string, config::Configuration> reused(
+      {{"A1", configurations.at("A3B1")}});
+  EXPECT_THROW(other.insert(reused), std::runtime_error);
+  EXPECT_EQ(other.n_prototypes(), 2);
+
+  // continue from results, adding commensurate configurations by rank-k
+  // updates
+  std::map<std::string, config::Configuration> partial(
+      {{"A1", configurations.at("A1")},
+       {"A3B1", configurations.at("A3B1")},
+       {"A1B3", configurations.at("A1B3")}});
+  std::map<DoFKey, config::ConfigSpaceAnalysisResults> partial_results =
+      config::config_space_analysis(partial, dofs);
+  config::ConfigSpaceAnalysisAccumulator continued(partial_results.at("occ"));
+  EXPECT_EQ(continued.n_prototypes(), 3);
+  std::map<std::string, config::Configuration> remaining(
+      {{"B1", configurations.at("B1")}});
+  auto supercell = continued.supercell();
+  EXPECT_EQ(continued.insert(remaining), 1);
+  EXPECT_EQ(continued.supercell(), supercell);
+  expect_same_results(continued.results());
+  EXPECT_EQ(continued.results().equivalent_dof_values.size(), 4);
+}
+
+TEST_F(ConfigSpaceAnalysisTest, KPointTest1) {
+  make_prim(test::FCC_binary_prim());
+  build_configurations_1();
+
+  std::map<DoFKey, config::ConfigSpaceAnalysisResults> results =
+      config::config_space_analysis(
+          configurations, dofs, exclude_homogeneous_modes,
+          include_default_occ_modes, sublattice_index_to_default_occ,
+          site_index_to_default_occ, tol);
+  std::map<DoFKey, config::ConfigSpaceKPointAnalysisResults> kpoint_results =
+      config::config_space_kpoint_analysis(
+          configurations, dofs, exclude_homogeneous_modes,
+          include_default_occ_modes, sublattice_index_to_default_occ, tol);
+
+  // Gamma and the three X points, one axis each
+  auto const &kpoint_occ = kpoint_results.at("occ");
+  EXPECT_EQ(kpoint_occ.standard_dof_space.basis.cols(), 1);
+  EXPECT_EQ(kpoint_occ.kpoints.size(), 4);
+  EXPECT_TRUE(kpoint_occ.kpoints[0].is_zero());
+  for (auto const &kpoint : kpoint_occ.kpoints) {
+    EXPECT_EQ(kpoint.eigenvalues.size(), 1);
+  }
+
+  // same space as in the fully commensurate supercell
+  auto const &expected = results.at("occ").symmetry_adapted_dof_space;
+  EXPECT_EQ(kpoint_occ.dim(), expected.basis.cols());
+  auto supercell = std::make_shared<config::Supercell const>(
+      prim, *expected.transformation_matrix_to_super);
+  clexulator::DoFSpace dof_space =
+      config::make_kpoint_symmetry_adapted_dof_space(kpoint_occ, supercell);
+  ASSERT_EQ(dof_space.basis.rows(), expected.basis.rows());
+  ASSERT_EQ(dof_space.basis.cols(), expected.basis.cols());
+  Eigen::MatrixXd combined(expected.basis.rows(), 2 * expected.basis.cols());
+  combined << dof_space.basis, expected.basis;
+  Eigen::FullPivLU<Eigen::MatrixXd> lu(combined);
+  lu.setThreshold(1e-8);
+  EXPECT_EQ(lu.rank(), expected.basis.cols());
+
+  // not commensurate
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity();
+  EXPECT_THROW(config::make_kpoint_symmetry_adapted_dof_space(
+                   kpoint_occ,
+                   std::make_shared<config::Supercell const>(prim, T)),
+               std::runtime_error);
+}
+
+TEST_F(ConfigSpaceAnalysisTest, NormalCoordinatesTest1) {
+  // batch normal coordinates equal get_normal_coordinate, for each config
+  make_prim(test::FCC_binary_disp_prim());
+
+  Eigen::Matrix3l T;
+  T << -1, 1, 1,  //
+      1, -1, 1,   //
+      1, 1, -1;   //
+  auto shared_supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  std::vector<config::Configuration> configs;
+  config::Configuration config(shared_supercell);
+  for (Index i = 0; i < 4; ++i) {
+    config.dof_values.occupation(i) = 1;
+    Eigen::MatrixXd &disp = config.dof_values.local_dof_values.at("disp");
+    disp.col(i) << 0.01 * (i + 1), -0.02 * i, 0.03;
+    configs.push_back(config);
+  }
+
+  for (std::string dof_key : {"occ", "disp"}) {
+    clexulator::DoFSpace dof_space =
+        clexulator::make_dof_space(dof_key, xtal_prim, T);
+    Eigen::MatrixXd X = config::make_normal_coordinates(configs, dof_space);
+    ASSERT_EQ(X.rows(), configs.size());
+    ASSERT_EQ(X.cols(), dof_space.basis.cols());
+    for (Index i = 0; i < configs.size(); ++i) {
+      Eigen::VectorXd expected =
+          get_normal_coordinate(configs[i].dof_values, T, dof_space);
+      EXPECT_TRUE(almost_equal(Eigen::VectorXd(X.row(i)), expected))
+          << "dof_key: " << dof_key << " i: " << i;
+    }
+  }
+
+  // local DoF configurations must be in the DoFSpace supercell
+  clexulator::DoFSpace prim_dof_space = clexulator::make_dof_space(
+      "disp", xtal_prim, Eigen::Matrix3l::Identity());
+  EXPECT_THROW(config::make_normal_coordinates(configs, prim_dof_space),
+               std::runtime_error);
+}
@@ -1,6 +1,9 @@
 #include "casm/configuration/copy_configuration.hh"
 
+#include <algorithm>
+
 #include "casm/configuration/Configuration.hh"
+#include "casm/configuration/SupercellSet.hh"
 #include "casm/configuration/SupercellSymOp.hh"
 #include "casm/configuration/canonical_form.hh"
 #include "casm/misc/CASM_Eigen_math.hh"
@@ -153,6 +156,96 @@ TEST_F(CopyConfigurationFCCTest, MakePrimitiveTest1) {
   EXPECT_EQ(occ(primitive_configuration, {0, 1, 0, 0}), 0);
 }
 
+TEST_F(CopyConfigurationFCCTest, MakePrimitiveTest2) {
+  // 12-site supercell along the prim a vector, with periods of 12, 6, 4, 3,
+  // 2, and 1 unit cells, so the invariant translations include composite
+  // order translations
+  Eigen::Matrix3l T;
+  T << 12, 0, 0,  //
+      0, 1, 0,    //
+      0, 0, 1;    //
+  auto long_supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  for (Index period : {12, 6, 4, 3, 2, 1}) {
+    config::Configuration configuration(long_supercell);
+    for (Index i = 0; i < 12; ++i) {
+      occ(configuration, {0, i, 0, 0}) = (i % period == 0) ? 1 : 0;
+    }
+    EXPECT_EQ(is_primitive(configuration), period == 12);
+
+    config::Configuration primitive_configuration =
+        make_primitive(configuration);
+    EXPECT_EQ(total_sites(primitive_configuration), period);
+    EXPECT_TRUE(is_primitive(primitive_configuration));
+
+    // the primitive configuration tiles the original configuration
+    config::Configuration tiled =
+        copy_configuration(primitive_configuration, long_supercell);
+    EXPECT_TRUE(tiled == configuration) << "period: " << period;
+  }
+}
+
+TEST_F(CopyConfigurationFCCTest, CanonicalSuperConfigurationsTest1) {
+  // L1_0 ordering in the 2-atom xy supercell
+  config::Configuration motif(sub_supercell_xy);
+  occ(motif, {0, 0, 0, 0}) = 1;
+
+  Eigen::Matrix3l T;
+  T << -2, 2, 2, 2, -2, 2, 2, 2, -2;
+  auto big_supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto begin = config::SupercellSymOp::begin(big_supercell);
+  auto end = config::SupercellSymOp::end(big_supercell);
+
+  std::set<config::Configuration> expected;
+  for (auto const &configuration :
+       make_all_super_configurations(motif, big_supercell)) {
+    expected.insert(make_canonical_form(configuration, begin, end));
+  }
+
+  std::vector<config::Configuration> canonical =
+      make_canonical_super_configurations(motif, big_supercell);
+  EXPECT_EQ(canonical.size(), expected.size());
+  EXPECT_TRUE(std::equal(canonical.begin(), canonical.end(), expected.begin(),
+                         expected.end()));
+  for (auto const &configuration : canonical) {
+    EXPECT_TRUE(is_canonical(configuration, begin, end));
+  }
+}
+
+TEST_F(CopyConfigurationFCCTest, SuperConfigurationsBySubsetsThreadsTest1) {
+  // L1_0 ordering in the 2-atom xy supercell
+  config::Configuration motif(sub_supercell_xy);
+  occ(motif, {0, 0, 0, 0}) = 1;
+
+  Eigen::Matrix3l T;
+  T << -2, 2, 2, 2, -2, 2, 2, 2, -2;
+  auto big_supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  auto serial = make_all_super_configurations_by_subsets(motif, big_supercell);
+  EXPECT_EQ(serial.size(),
+            make_distinct_super_configurations(motif, big_supercell).size());
+  EXPECT_GT(serial.size(), 1);
+
+  // same subsets, in the same order, for any n_threads
+  for (Index n_threads : {2, 3, 0}) {
+    EXPECT_EQ(make_all_super_configurations_by_subsets(motif, big_supercell,
+                                                       n_threads),
+              serial);
+  }
+
+  // streamed subsets, in order
+  std::vector<std::vector<config::Configuration>> streamed;
+  Index n_subsets = for_each_super_configuration_subset(
+      motif, big_supercell,
+      [&](Index subset_index, std::vector<config::Configuration> &subset) {
+        EXPECT_EQ(subset_index, streamed.size());
+        streamed.push_back(std::move(subset));
+      },
+      2);
+  EXPECT_EQ(n_subsets, serial.size());
+  EXPECT_EQ(streamed, serial);
+}
+
 TEST_F(CopyConfigurationFCCTest, CopyTransformTest1) {
   // This creates a 4-site conventional FCC cell,
   // where z=0 has occ=1, z=1/2 has occ=0
@@ -220,6 +313,36 @@ TEST_F(CopyConfigurationFCCTest, InCanonicalSupercellTest1) {
                            expected_occ));
 }
 
+TEST_F(CopyConfigurationFCCTest, InCanonicalSupercellSetTest1) {
+  // configurations in equivalent supercells, mostly not canonical
+  std::vector<config::Configuration> configurations;
+  for (auto const &_supercell : {sub_supercell_xy, sub_supercell_yz}) {
+    config::Configuration configuration(_supercell);
+    configurations.push_back(configuration);
+    occ(configuration, {0, 0, 0, 0}) = 1;
+    configurations.push_back(configuration);
+  }
+
+  config::SupercellSet supercells(prim);
+  std::vector<config::Configuration> result =
+      make_in_canonical_supercell(configurations, supercells);
+  ASSERT_EQ(result.size(), configurations.size());
+  EXPECT_EQ(supercells.size(), 1);
+  for (Index i = 0; i < configurations.size(); ++i) {
+    EXPECT_TRUE(result[i] == make_in_canonical_supercell(configurations[i]));
+    EXPECT_EQ(result[i].supercell, supercells.begin()->supercell);
+  }
+
+  // the canonical supercell and transformation are remembered
+  auto canonical = supercells.canonical_supercell(sub_supercell_yz);
+  EXPECT_EQ(canonical.first, supercells.begin()->supercell);
+  EXPECT_EQ(canonical.first,
+            supercells.canonical_supercell(sub_supercell_yz).first);
+  EXPECT_EQ(canonical.second,
+            prim_factor_group_index_to_supercell(sub_supercell_yz,
+                                                 canonical.first));
+}
+
 TEST_F(CopyConfigurationFCCTest, InCanonicalSupercellTest2) {
   // start with non-canonical conventional 4-atom fcc supercell
   Eigen::Matrix3d L;
@@ -390,3 +513,73 @@ TEST_F(CopyConfigurationFCCTernaryGLStrainDispTest, Test1) {
     EXPECT_TRUE(is_canonical(tconfig, begin, end));
   }
 }
+
+TEST_F(CopyConfigurationFCCTernaryGLStrainDispTest, CopyMapTest1) {
+  Eigen::Matrix3l T_motif;
+  T_motif << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto motif_supercell =
+      std::make_shared<config::Supercell const>(prim, T_motif);
+  Eigen::Matrix3l T = 2 * T_motif;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  config::Configuration motif(motif_supercell);
+  occ(motif, {0, 0, 0, 0}) = 1;
+  occ(motif, {0, 0, 0, 1}) = 2;
+  disp(motif, {0, 0, 0, 0}) << 0.1, 0.2, 0.3;
+  disp(motif, {0, 0, 0, 1})(2) = 0.1;
+  strain(motif) << 0.01, 0.02, 0.03, 0.04, 0.05, 0.06;
+
+  // untransformed copy into the same supercell is the same configuration
+  auto copy_map = config::make_configuration_copy_map(motif_supercell,
+                                                      motif_supercell);
+  EXPECT_TRUE(copy_map->copy(motif) == motif);
+  EXPECT_EQ(copy_map, config::make_configuration_copy_map(motif_supercell,
+                                                          motif_supercell));
+
+  auto const &prim_sym_info = prim->sym_info;
+  auto const &converter = supercell->unitcellcoord_index_converter;
+  xtal::UnitCell translation(1, 0, 0);
+  xtal::UnitCell origin(0, 1, 0);
+  Index fg_size = prim_sym_info.factor_group->element.size();
+  for (Index fg = 0; fg < fg_size; ++fg) {
+    auto transformed_map = config::make_configuration_copy_map(
+        fg, translation, motif_supercell, supercell, origin);
+    EXPECT_EQ(transformed_map, config::make_configuration_copy_map(
+                                   fg, translation, motif_supercell, supercell,
+                                   origin));
+    config::Configuration new_config = transformed_map->copy(motif);
+
+    // check sites map according to:
+    //     new_config_unitcellcoord + origin = fg * motif_unitcellcoord + trans
+    auto const &disp_rep =
+        prim_sym_info.local_dof_symgroup_rep.at("disp")[fg];
+    auto const &motif_converter =
+        motif_supercell->unitcellcoord_index_converter;
+    for (Index l = 0; l < motif_converter.total_sites(); ++l) {
+      xtal::UnitCellCoord motif_ucc = motif_converter(l);
+      xtal::UnitCellCoord new_ucc =
+          copy_apply(prim_sym_info.unitcellcoord_symgroup_rep[fg], motif_ucc) +
+          translation - origin;
+      Index i = converter(new_ucc);
+      Index b = motif_ucc.sublattice();
+      EXPECT_EQ(occ(new_config, i),
+                prim_sym_info.occ_symgroup_rep[fg][b][occ(motif, l)]);
+      EXPECT_TRUE(almost_equal(Eigen::VectorXd(disp(new_config, i)),
+                               Eigen::VectorXd(disp_rep[b] * disp(motif, l))));
+    }
+    Eigen::VectorXd expected_strain =
+        prim_sym_info.global_dof_symgroup_rep.at("GLstrain")[fg] *
+        strain(motif);
+    EXPECT_TRUE(almost_equal(strain(new_config), expected_strain));
+
+    // global properties are transformed
+    config::ConfigurationWithProperties motif_with_properties(
+        motif, {}, {{"GLstrain", strain(motif)}});
+    config::ConfigurationWithProperties new_with_properties =
+        config::copy_configuration_with_properties(
+            fg, translation, motif_with_properties, supercell, origin);
+    EXPECT_TRUE(new_with_properties.configuration == new_config);
+    EXPECT_TRUE(almost_equal(
+        new_with_properties.global_properties.at("GLstrain"), expected_strain));
+  }
+}
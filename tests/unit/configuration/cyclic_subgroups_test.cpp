@@ -387,3 +387,151 @@ TEST(AllSubgroupsTest, Test2) {
             }),
             1);
 }
+
+TEST(SubgroupCacheTest, Test1) {
+  using namespace group;
+  config::PrimSymInfo prim_sym_info(test::FCC_binary_prim());
+  MultiplicationTable const &multiplication_table =
+      prim_sym_info.factor_group->multiplication_table;
+
+  SubgroupCache cache;
+  EXPECT_EQ(cache.size(), 0);
+  std::shared_ptr<std::set<SubgroupOrbit> const> all_subgroups =
+      cache.make_all_subgroups(multiplication_table);
+  EXPECT_EQ(all_subgroups->size(), 33);
+  EXPECT_EQ(*all_subgroups, make_all_subgroups(*prim_sym_info.factor_group));
+  EXPECT_EQ(cache.size(), 1);
+
+  // same group, same result
+  EXPECT_EQ(cache.make_all_subgroups(multiplication_table), all_subgroups);
+  EXPECT_EQ(cache.size(), 1);
+
+  std::shared_ptr<std::set<SubgroupOrbit> const> cyclic_subgroups =
+      cache.make_cyclic_subgroups(multiplication_table);
+  EXPECT_EQ(*cyclic_subgroups,
+            make_cyclic_subgroups(*prim_sym_info.factor_group));
+  EXPECT_EQ(cache.size(), 2);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(IndexBitsetTest, Test1) {
+  using namespace group;
+  IndexBitset bits(130, std::set<Index>({0, 63, 64, 129}));
+  EXPECT_EQ(bits.size(), 130);
+  EXPECT_EQ(bits.count(), 4);
+  EXPECT_TRUE(bits.contains(64));
+  EXPECT_FALSE(bits.contains(65));
+  EXPECT_EQ(bits.to_set(), std::set<Index>({0, 63, 64, 129}));
+  EXPECT_EQ(bits.find_next(64), 129);
+  EXPECT_EQ(bits.find_next(129), IndexBitset::npos);
+
+  EXPECT_FALSE(bits.insert(63));
+  bits.erase(63);
+  EXPECT_TRUE(bits.insert(65));
+  IndexBitset other(130, std::set<Index>({0, 65, 100}));
+  EXPECT_EQ((bits & other).to_set(), std::set<Index>({0, 65}));
+  EXPECT_EQ((bits | other).count(), 5);
+  EXPECT_EQ((bits - other).to_set(), std::set<Index>({64, 129}));
+  EXPECT_TRUE((bits & other).is_subset_of(other));
+  EXPECT_FALSE(bits.is_subset_of(other));
+}
+
+TEST(IndexBitsetTest, Test2) {
+  using namespace group;
+  config::PrimSymInfo prim_sym_info(test::FCC_binary_prim());
+  MultiplicationTable const &multiplication_table =
+      prim_sym_info.factor_group->multiplication_table;
+  Index n_elements = multiplication_table.size();
+  std::vector<Index> inverse_index = make_inverse_index(multiplication_table);
+
+  IndexBitset all(n_elements);
+  for (Index i = 0; i < n_elements; ++i) {
+    all.insert(i);
+    EXPECT_EQ(multiplication_table[i][inverse_index[i]], 0);
+  }
+  EXPECT_TRUE(is_closed(multiplication_table, all));
+
+  // every subgroup is closed, has the expected cosets, and is conjugate to
+  // the other subgroups in its orbit
+  for (auto const &orbit : make_all_subgroups(multiplication_table)) {
+    for (auto const &subgroup_indices : orbit) {
+      IndexBitset subgroup(n_elements, subgroup_indices);
+      EXPECT_TRUE(is_closed(multiplication_table, subgroup));
+      EXPECT_EQ(make_closure(multiplication_table, subgroup), subgroup);
+
+      std::vector<IndexBitset> cosets =
+          make_left_cosets(multiplication_table, subgroup);
+      EXPECT_EQ(cosets.size() * subgroup.count(), n_elements);
+      EXPECT_EQ(cosets[0], subgroup);
+      IndexBitset coset_union(n_elements);
+      for (auto const &coset : cosets) {
+        coset_union |= coset;
+      }
+      EXPECT_EQ(coset_union, all);
+
+      // the normalizer is a subgroup containing subgroup, with index equal
+      // to the orbit size
+      IndexBitset normalizer =
+          make_normalizer(multiplication_table, inverse_index, subgroup);
+      EXPECT_TRUE(is_closed(multiplication_table, normalizer));
+      EXPECT_TRUE(subgroup.is_subset_of(normalizer));
+      EXPECT_EQ(orbit.size() * normalizer.count(), n_elements);
+
+      for (Index X_index = 0; X_index < n_elements; ++X_index) {
+        IndexBitset conjugate = make_conjugate(
+            multiplication_table, inverse_index, subgroup, X_index);
+        EXPECT_EQ(orbit.count(conjugate.to_set()), 1);
+        EXPECT_EQ(conjugate == subgroup, normalizer.contains(X_index));
+      }
+    }
+  }
+
+  // the closure of any two elements is a subgroup
+  IndexBitset generators(n_elements, std::set<Index>({1, n_elements - 1}));
+  EXPECT_FALSE(is_closed(multiplication_table, generators));
+  IndexBitset closure = make_closure(multiplication_table, generators);
+  EXPECT_TRUE(is_closed(multiplication_table, closure));
+  EXPECT_TRUE(generators.is_subset_of(closure));
+
+  // equal sets have equal hashes
+  IndexBitsetHash hash;
+  EXPECT_EQ(hash(closure), hash(make_closure(multiplication_table, closure)));
+}
+
+TEST(ConjugacyClassesTest, Test1) {
+  using namespace group;
+  config::PrimSymInfo prim_sym_info(test::FCC_binary_prim());
+  config::SymGroup const &factor_group = *prim_sym_info.factor_group;
+  Index n_elements = factor_group.element.size();
+
+  // FCC factor group (m-3m) has 10 classes
+  std::vector<std::vector<Index>> const &conjugacy_classes =
+      factor_group.conjugacy_classes();
+  EXPECT_EQ(conjugacy_classes.size(), 10);
+  EXPECT_EQ(&conjugacy_classes, &factor_group.conjugacy_classes());
+  EXPECT_EQ(make_conjugacy_classes(factor_group), conjugacy_classes);
+
+  std::vector<Index> const &class_index = factor_group.class_index();
+  std::vector<Index> const &class_size = factor_group.class_size();
+  ASSERT_EQ(class_index.size(), n_elements);
+  ASSERT_EQ(class_size.size(), conjugacy_classes.size());
+  Index total_size = 0;
+  for (Index c = 0; c < conjugacy_classes.size(); ++c) {
+    EXPECT_EQ(class_size[c], conjugacy_classes[c].size());
+    total_size += class_size[c];
+    for (Index i : conjugacy_classes[c]) {
+      EXPECT_EQ(class_index[i], c);
+    }
+  }
+  EXPECT_EQ(total_size, n_elements);
+
+  // elements conjugate to an element are in its class
+  for (Index i = 0; i < n_elements; ++i) {
+    for (Index j = 0; j < n_elements; ++j) {
+      Index k = factor_group.mult(j, factor_group.mult(i, factor_group.inv(j)));
+      EXPECT_EQ(class_index[k], class_index[i]);
+    }
+  }
+}
@@ -1,5 +1,13 @@
 #include "casm/configuration/dof_space_analysis.hh"
 
+#include "casm/configuration/DoFSpaceAnalysisCache.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/group/Group.hh"
+#include "casm/configuration/irreps/CharacterTable.hh"
+#include "casm/configuration/irreps/IrrepDecompositionImpl.hh"
 #include "casm/crystallography/io/BasicStructureIO.hh"
 #include "casm/misc/CASM_Eigen_math.hh"
 #include "gtest/gtest.h"
@@ -357,6 +365,147 @@ TEST_F(DoFSpaceAnalysisTest, Test4b) {
   EXPECT_EQ(symmetry_adapted_subspace.cols(), 9);
 }
 
+TEST_F(DoFSpaceAnalysisTest, ParallelWedgesTest1) {
+  // conventional FCC disp, irreducible wedge does not depend on n_threads
+  make_prim(test::FCC_binary_disp_prim());
+
+  Eigen::Matrix3l T;
+  T << -1, 1, 1,  //
+      1, -1, 1,   //
+      1, 1, -1;   //
+  transformation_matrix_to_super = T;
+  make_dof_space("disp");
+
+  // Perform DoF space analysis
+  calc_wedges = true;
+  auto _analysis = [&](Index n_threads) {
+    return config::dof_space_analysis(
+        *dof_space, prim, configuration, exclude_homogeneous_modes,
+        include_default_occ_modes, sublattice_index_to_default_occ,
+        site_index_to_default_occ, calc_wedges, log, false, false, n_threads);
+  };
+  config::DoFSpaceAnalysisResults serial = _analysis(1);
+  config::DoFSpaceAnalysisResults parallel = _analysis(4);
+
+  // Check results
+  std::vector<irreps::SubWedge> const &expected =
+      serial.symmetry_report.irreducible_wedge;
+  std::vector<irreps::SubWedge> const &found =
+      parallel.symmetry_report.irreducible_wedge;
+  EXPECT_TRUE(expected.size() > 0);
+  ASSERT_EQ(found.size(), expected.size());
+  for (Index i = 0; i < expected.size(); ++i) {
+    EXPECT_TRUE(almost_equal(found[i].trans_mat, expected[i].trans_mat));
+  }
+
+  // symmetrized irreps do not depend on n_threads
+  EXPECT_TRUE(
+      almost_equal(parallel.symmetry_report.symmetry_adapted_subspace,
+                   serial.symmetry_report.symmetry_adapted_subspace));
+}
+
+TEST_F(DoFSpaceAnalysisTest, IrrepSymGroupRepTest1) {
+  // conventional FCC disp, irrep matrices are constructed from the sparse
+  // full space rep, equal to those from the dense full space matrices
+  make_prim(test::FCC_binary_disp_prim());
+
+  Eigen::Matrix3l T;
+  T << -1, 1, 1,  //
+      1, -1, 1,   //
+      1, 1, -1;   //
+  transformation_matrix_to_super = T;
+  make_dof_space("disp");
+
+  config::DoFSpaceAnalysisResults results = config::dof_space_analysis(
+      *dof_space, prim, configuration, exclude_homogeneous_modes,
+      include_default_occ_modes, sublattice_index_to_default_occ,
+      site_index_to_default_occ, calc_wedges, log);
+
+  irreps::VectorSpaceSymReport const &report = results.symmetry_report;
+  ASSERT_EQ(report.irrep_symgroup_rep.size(), report.irreps.size());
+  for (Index l = 0; l < report.irreps.size(); ++l) {
+    auto const &irrep = report.irreps[l];
+    ASSERT_EQ(report.irrep_symgroup_rep[l].size(), report.symgroup_rep.size());
+    for (Index o = 0; o < report.symgroup_rep.size(); ++o) {
+      Eigen::MatrixXd expected =
+          (irrep.trans_mat * report.symgroup_rep[o] *
+           irrep.trans_mat.transpose())
+              .real();
+      EXPECT_TRUE(almost_equal(report.irrep_symgroup_rep[l][o], expected));
+    }
+  }
+
+  // constructed from symgroup_rep if not provided
+  irreps::VectorSpaceSymReport other(
+      report.symgroup_rep, report.irreps, report.irreducible_wedge,
+      report.symmetry_adapted_subspace, report.axis_glossary);
+  ASSERT_EQ(other.irrep_symgroup_rep.size(), report.irrep_symgroup_rep.size());
+  for (Index l = 0; l < report.irreps.size(); ++l) {
+    for (Index o = 0; o < report.symgroup_rep.size(); ++o) {
+      EXPECT_TRUE(almost_equal(other.irrep_symgroup_rep[l][o],
+                               report.irrep_symgroup_rep[l][o]));
+    }
+  }
+}
+
+TEST_F(DoFSpaceAnalysisTest, CacheTest1) {
+  // conventional FCC disp, results are shared in memory and read from file
+  make_prim(test::FCC_binary_disp_prim());
+
+  Eigen::Matrix3l T;
+  T << -1, 1, 1,  //
+      1, -1, 1,   //
+      1, 1, -1;   //
+  transformation_matrix_to_super = T;
+  make_dof_space("disp");
+
+  test::TmpDir tmp_dir;
+  calc_wedges = true;
+  auto _analysis = [&](config::DoFSpaceAnalysisCache &cache) {
+    return cache.dof_space_analysis(
+        *dof_space, prim, configuration, exclude_homogeneous_modes,
+        include_default_occ_modes, sublattice_index_to_default_occ,
+        site_index_to_default_occ, calc_wedges, log);
+  };
+
+  config::DoFSpaceAnalysisCache cache(tmp_dir.path());
+  auto results = _analysis(cache);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(_analysis(cache), results);
+  EXPECT_EQ(std::distance(fs::directory_iterator(tmp_dir.path()),
+                          fs::directory_iterator()),
+            1);
+
+  config::DoFSpaceAnalysisCache other_cache(tmp_dir.path());
+  auto other_results = _analysis(other_cache);
+  EXPECT_NE(other_results, results);
+
+  // Check results read from file
+  irreps::VectorSpaceSymReport const &expected = results->symmetry_report;
+  irreps::VectorSpaceSymReport const &found = other_results->symmetry_report;
+  EXPECT_TRUE(almost_equal(other_results->symmetry_adapted_dof_space.basis,
+                           results->symmetry_adapted_dof_space.basis));
+  EXPECT_EQ(found.irrep_names, expected.irrep_names);
+  EXPECT_EQ(found.symgroup_rep.size(), expected.symgroup_rep.size());
+  ASSERT_EQ(found.irreps.size(), expected.irreps.size());
+  for (Index i = 0; i < expected.irreps.size(); ++i) {
+    EXPECT_TRUE(almost_equal(found.irreps[i].trans_mat,
+                             expected.irreps[i].trans_mat));
+    EXPECT_EQ(found.irreps[i].pseudo_irrep, expected.irreps[i].pseudo_irrep);
+  }
+  EXPECT_TRUE(expected.irreducible_wedge.size() > 0);
+  ASSERT_EQ(found.irreducible_wedge.size(), expected.irreducible_wedge.size());
+  for (Index i = 0; i < expected.irreducible_wedge.size(); ++i) {
+    EXPECT_TRUE(almost_equal(found.irreducible_wedge[i].trans_mat,
+                             expected.irreducible_wedge[i].trans_mat));
+  }
+
+  // Different options are a different key
+  calc_wedges = false;
+  EXPECT_NE(_analysis(cache), results);
+  EXPECT_EQ(cache.size(), 2);
+}
+
 TEST_F(DoFSpaceAnalysisTest, Test5) {
   read_prim_file("prim_ABC2.json");
   make_prim_dof_space("disp");
@@ -397,4 +546,254 @@ TEST_F(DoFSpaceAnalysisTest, Test6) {
   EXPECT_EQ(irreps.size(), 3);
   EXPECT_EQ(symmetry_adapted_subspace.rows(), 9);
   EXPECT_EQ(symmetry_adapted_subspace.cols(), 9);
-}
\ No newline at end of file
+}
+TEST_F(DoFSpaceAnalysisTest, CharacterTableTest1) {
+  make_prim(test::FCC_binary_prim());
+  config::SymGroup const &factor_group = *prim->sym_info.factor_group;
+  irreps::CharacterTable table = irreps::make_character_table(
+      factor_group.multiplication_table,
+      group::make_conjugacy_classes(factor_group));
+
+  // point group m-3m
+  EXPECT_EQ(table.group_size(), 48);
+  EXPECT_EQ(table.n_irreps(), 10);
+  EXPECT_EQ(table.irrep_dim,
+            std::vector<Index>({1, 1, 1, 1, 2, 2, 3, 3, 3, 3}));
+
+  // row orthogonality
+  for (Index i = 0; i < table.n_irreps(); ++i) {
+    for (Index j = 0; j < table.n_irreps(); ++j) {
+      std::complex<double> sum = 0.0;
+      for (Index c = 0; c < table.conjugacy_classes.size(); ++c) {
+        sum += double(table.conjugacy_classes[c].size()) *
+               table.characters(i, c) * std::conj(table.characters(j, c));
+      }
+      EXPECT_TRUE(almost_equal(sum.real(), (i == j) ? 48.0 : 0.0));
+      EXPECT_TRUE(almost_zero(sum.imag()));
+    }
+  }
+}
+
+TEST_F(DoFSpaceAnalysisTest, CharacterProjectionTest1) {
+  make_prim(test::FCC_binary_prim());
+
+  Eigen::Matrix3l T;
+  T << -1, 1, 1,  //
+      1, -1, 1,   //
+      1, 1, -1;   //
+  transformation_matrix_to_super = T;
+  make_dof_space("occ");
+
+  // Perform DoF space analysis, using character projection
+  bool use_character_projection = true;
+  config::DoFSpaceAnalysisResults results = config::dof_space_analysis(
+      *dof_space, prim, configuration, exclude_homogeneous_modes,
+      include_default_occ_modes, sublattice_index_to_default_occ,
+      site_index_to_default_occ, calc_wedges, log, use_character_projection);
+
+  // Check results, same as Test2
+  irreps::VectorSpaceSymReport const &symmetry_report = results.symmetry_report;
+  std::vector<irreps::IrrepInfo> const &irreps = symmetry_report.irreps;
+  Eigen::MatrixXd const &symmetry_adapted_subspace =
+      symmetry_report.symmetry_adapted_subspace;
+
+  EXPECT_EQ(irreps.size(), 2);
+  EXPECT_EQ(irreps[0].irrep_dim, 1);
+  EXPECT_EQ(irreps[1].irrep_dim, 3);
+  EXPECT_EQ(symmetry_adapted_subspace.rows(), 8);
+  EXPECT_EQ(symmetry_adapted_subspace.cols(), 4);
+}
+
+TEST_F(DoFSpaceAnalysisTest, CharacterProjectionTest2) {
+  read_prim_file("prim_ABC2.json");
+  make_prim_dof_space("disp");
+
+  // Perform DoF space analysis, using both methods
+  config::DoFSpaceAnalysisResults results = config::dof_space_analysis(
+      *dof_space, prim, configuration, exclude_homogeneous_modes,
+      include_default_occ_modes, sublattice_index_to_default_occ,
+      site_index_to_default_occ, calc_wedges, log);
+
+  bool use_character_projection = true;
+  config::DoFSpaceAnalysisResults projection_results =
+      config::dof_space_analysis(
+          *dof_space, prim, configuration, exclude_homogeneous_modes,
+          include_default_occ_modes, sublattice_index_to_default_occ,
+          site_index_to_default_occ, calc_wedges, log,
+          use_character_projection);
+
+  // Check results, same as Test5
+  std::vector<irreps::IrrepInfo> const &irreps =
+      projection_results.symmetry_report.irreps;
+  Eigen::MatrixXd const &symmetry_adapted_subspace =
+      projection_results.symmetry_report.symmetry_adapted_subspace;
+  EXPECT_EQ(irreps.size(), 15);
+  EXPECT_EQ(symmetry_adapted_subspace.rows(), 18);
+  EXPECT_EQ(symmetry_adapted_subspace.cols(), 15);
+
+  // Same irreducible spaces, as projectors
+  std::vector<irreps::IrrepInfo> const &expected =
+      results.symmetry_report.irreps;
+  ASSERT_EQ(irreps.size(), expected.size());
+  Eigen::MatrixXd expected_subspace =
+      results.symmetry_report.symmetry_adapted_subspace;
+  EXPECT_TRUE(almost_equal(
+      Eigen::MatrixXd(symmetry_adapted_subspace *
+                      symmetry_adapted_subspace.transpose()),
+      Eigen::MatrixXd(expected_subspace * expected_subspace.transpose())));
+}
+
+TEST_F(DoFSpaceAnalysisTest, KStarTest1) {
+  make_prim(test::FCC_binary_prim());
+
+  Eigen::Matrix3l T;
+  T << -1, 1, 1,  //
+      1, -1, 1,   //
+      1, 1, -1;   //
+  transformation_matrix_to_super = T;
+  make_dof_space("occ");
+
+  // k-stars: Gamma (1 k-point), X (3 k-points)
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  std::vector<config::SupercellSymOp> group(
+      config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+  std::vector<Eigen::MatrixXd> blocks =
+      config::make_kstar_subspaces(*dof_space, *supercell, group);
+  ASSERT_EQ(blocks.size(), 2);
+  EXPECT_EQ(blocks[0].cols(), 2);
+  EXPECT_EQ(blocks[1].cols(), 6);
+  EXPECT_TRUE(almost_zero(Eigen::MatrixXd(blocks[0].transpose() * blocks[1])));
+
+  // Perform DoF space analysis, using k-star blocks
+  bool use_character_projection = false;
+  bool use_kstar_blocks = true;
+  config::DoFSpaceAnalysisResults results = config::dof_space_analysis(
+      *dof_space, prim, configuration, exclude_homogeneous_modes,
+      include_default_occ_modes, sublattice_index_to_default_occ,
+      site_index_to_default_occ, calc_wedges, log, use_character_projection,
+      use_kstar_blocks);
+
+  // Check results, same as Test2
+  std::vector<irreps::IrrepInfo> const &irreps = results.symmetry_report.irreps;
+  Eigen::MatrixXd const &symmetry_adapted_subspace =
+      results.symmetry_report.symmetry_adapted_subspace;
+  EXPECT_EQ(irreps.size(), 2);
+  EXPECT_EQ(irreps[0].irrep_dim, 1);
+  EXPECT_EQ(irreps[1].irrep_dim, 3);
+  EXPECT_EQ(symmetry_adapted_subspace.rows(), 8);
+  EXPECT_EQ(symmetry_adapted_subspace.cols(), 4);
+}
+
+TEST_F(DoFSpaceAnalysisTest, KStarTest2) {
+  make_prim(test::FCC_binary_prim());
+
+  Eigen::Matrix3l T;
+  T << 2, 0, 0,  //
+      0, 2, 0,   //
+      0, 0, 2;   //
+  transformation_matrix_to_super = T;
+  make_dof_space("occ");
+
+  // k-stars: Gamma (1 k-point), X (3 k-points), L (4 k-points)
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  std::vector<config::SupercellSymOp> group(
+      config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+  std::vector<Eigen::MatrixXd> blocks =
+      config::make_kstar_subspaces(*dof_space, *supercell, group);
+  std::multiset<Index> block_dims;
+  for (auto const &block : blocks) {
+    block_dims.insert(block.cols());
+  }
+  EXPECT_EQ(block_dims, std::multiset<Index>({2, 6, 8}));
+
+  // Perform DoF space analysis, with and without k-star blocks
+  config::DoFSpaceAnalysisResults results = config::dof_space_analysis(
+      *dof_space, prim, configuration, exclude_homogeneous_modes,
+      include_default_occ_modes, sublattice_index_to_default_occ,
+      site_index_to_default_occ, calc_wedges, log);
+
+  bool use_character_projection = false;
+  bool use_kstar_blocks = true;
+  config::DoFSpaceAnalysisResults kstar_results = config::dof_space_analysis(
+      *dof_space, prim, configuration, exclude_homogeneous_modes,
+      include_default_occ_modes, sublattice_index_to_default_occ,
+      site_index_to_default_occ, calc_wedges, log, use_character_projection,
+      use_kstar_blocks);
+
+  std::multiset<Index> irrep_dims;
+  for (auto const &irrep : results.symmetry_report.irreps) {
+    irrep_dims.insert(irrep.irrep_dim);
+  }
+  std::multiset<Index> kstar_irrep_dims;
+  for (auto const &irrep : kstar_results.symmetry_report.irreps) {
+    kstar_irrep_dims.insert(irrep.irrep_dim);
+  }
+  EXPECT_EQ(kstar_irrep_dims, irrep_dims);
+  EXPECT_EQ(kstar_results.symmetry_report.symmetry_adapted_subspace.cols(),
+            results.symmetry_report.symmetry_adapted_subspace.cols());
+}
+
+TEST_F(DoFSpaceAnalysisTest, RealIrrepDecompositionTest1) {
+  using namespace irreps;
+  using namespace irreps::IrrepDecompositionImpl;
+  double const pi = std::acos(-1.0);
+  auto rotation = [&](double angle) {
+    Eigen::MatrixXd R(2, 2);
+    R << std::cos(angle), -std::sin(angle),  //
+        std::sin(angle), std::cos(angle);    //
+    return R;
+  };
+  Eigen::MatrixXd M(2, 2);
+  M << 1., 0.,  //
+      0., -1.;  //
+
+  // D3 acting on the plane: one 2-dim irrep of real type
+  MatrixRep D3_rep;
+  for (Index k = 0; k < 3; ++k) {
+    D3_rep.push_back(rotation(2.0 * pi * k / 3.0));
+  }
+  for (Index k = 0; k < 3; ++k) {
+    D3_rep.push_back(rotation(2.0 * pi * k / 3.0) * M);
+  }
+  GroupIndices D3_group({0, 1, 2, 3, 4, 5});
+  EXPECT_TRUE(
+      almost_equal(make_frobenius_schur_indicator(D3_rep, D3_group), 1.0));
+  EXPECT_TRUE(allows_real_irreps(D3_rep, D3_group));
+
+  // two copies, found in real arithmetic
+  MatrixRep D3_rep2;
+  for (auto const &R : D3_rep) {
+    Eigen::MatrixXd R2 = Eigen::MatrixXd::Zero(4, 4);
+    R2.topLeftCorner(2, 2) = R;
+    R2.bottomRightCorner(2, 2) = R;
+    D3_rep2.push_back(R2);
+  }
+  EXPECT_TRUE(allows_real_irreps(D3_rep2, D3_group));
+  std::vector<IrrepInfo> irreps = real_irrep_decomposition(D3_rep2, D3_group);
+  ASSERT_EQ(irreps.size(), 2);
+  Eigen::MatrixXd T(4, 4);
+  for (Index i = 0; i < 2; ++i) {
+    EXPECT_EQ(irreps[i].irrep_dim, 2);
+    EXPECT_FALSE(irreps[i].complex);
+    EXPECT_FALSE(irreps[i].pseudo_irrep);
+    T.middleRows(2 * i, 2) = irreps[i].trans_mat.real();
+  }
+  EXPECT_TRUE(almost_equal(Eigen::MatrixXd(T * T.transpose()),
+                           Eigen::MatrixXd::Identity(4, 4)));
+  EXPECT_EQ(irrep_decomposition(D3_rep2, D3_group, true).size(), 2);
+
+  // C3 acting on the plane: a pair of complex irreps, not real type
+  MatrixRep C3_rep(D3_rep.begin(), D3_rep.begin() + 3);
+  GroupIndices C3_group({0, 1, 2});
+  EXPECT_TRUE(almost_zero(make_frobenius_schur_indicator(C3_rep, C3_group)));
+  EXPECT_FALSE(allows_real_irreps(C3_rep, C3_group));
+  EXPECT_EQ(real_irrep_decomposition(C3_rep, C3_group).size(), 0);
+  irreps = irrep_decomposition(C3_rep, C3_group, true);
+  ASSERT_EQ(irreps.size(), 2);
+  EXPECT_TRUE(irreps[0].complex);
+  irreps = irrep_decomposition(C3_rep, C3_group, false);
+  ASSERT_EQ(irreps.size(), 1);
+  EXPECT_TRUE(irreps[0].pseudo_irrep);
+}
@@ -0,0 +1,95 @@
+#include "casm/configuration/instrumentation.hh"
+
+#include <thread>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace instrumentation = CASM::config::instrumentation;
+
+class InstrumentationTest : public testing::Test {
+ protected:
+  InstrumentationTest() {
+    instrumentation::set_enabled(false);
+    instrumentation::reset();
+  }
+
+  ~InstrumentationTest() {
+    instrumentation::set_enabled(false);
+    instrumentation::reset();
+  }
+};
+
+TEST_F(InstrumentationTest, Test1) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+
+  instrumentation::set_enabled(true);
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration configuration(supercell);
+  configuration.dof_values.occupation(0) = 1;
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  config::Configuration canonical_configuration =
+      make_canonical_form(configuration, begin, end);
+  instrumentation::set_enabled(false);
+
+  // not recorded while disabled
+  make_canonical_form(configuration, begin, end);
+
+  instrumentation::Results results = instrumentation::results();
+  EXPECT_EQ(results.counts.size(), 5);
+  EXPECT_EQ(results.seconds.size(), 4);
+  EXPECT_EQ(results.calls.size(), 4);
+  if (!instrumentation::is_compiled()) {
+    EXPECT_EQ(results.counts.at("canonical_forms"), 0);
+    return;
+  }
+  EXPECT_EQ(results.counts.at("supercells_constructed"), 1);
+  EXPECT_EQ(results.counts.at("canonical_forms"), 1);
+  EXPECT_GE(results.counts.at("op_applications"), 1);
+  EXPECT_GT(results.counts.at("comparisons"), 0);
+  EXPECT_EQ(results.calls.at("canonical_form"), 1);
+  EXPECT_EQ(results.calls.at("supercell_sym_info"), 1);
+  EXPECT_GE(results.seconds.at("canonical_form"), 0.0);
+
+  instrumentation::reset();
+  results = instrumentation::results();
+  for (auto const &value : results.counts) {
+    EXPECT_EQ(value.second, 0);
+  }
+}
+
+TEST_F(InstrumentationTest, Threads) {
+  if (!instrumentation::is_compiled()) {
+    return;
+  }
+  instrumentation::set_enabled(true);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 10; ++j) {
+        instrumentation::count(instrumentation::Counter::comparisons);
+        // nested scopes are timed once
+        instrumentation::ScopedTimer outer(instrumentation::Timer::json_io);
+        instrumentation::ScopedTimer inner(instrumentation::Timer::json_io);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  instrumentation::set_enabled(false);
+
+  instrumentation::Results results = instrumentation::results();
+  EXPECT_EQ(results.counts.at("comparisons"), 40);
+  EXPECT_EQ(results.calls.at("json_io"), 40);
+}
@@ -215,3 +215,72 @@ TEST_F(MakeSimpleStructureTestStrainDisp, Test1) {
   // check disp
   EXPECT_FALSE(structure.atom_info.properties.count("disp"));
 }
+
+TEST_F(MakeSimpleStructureTestStrainDisp, AtomicStructuresTest1) {
+  std::vector<config::Configuration> configurations;
+
+  config::Configuration configuration(supercell);
+  configurations.push_back(configuration);
+
+  configuration.dof_values.occupation(0) = 1;
+  configuration.dof_values.occupation(1) = 2;
+  configuration.dof_values.local_dof_values.at("disp").col(0) << 0.01, 0.0,
+      -0.01;
+  configuration.dof_values.global_dof_values.at("GLstrain")(2) = 0.1;
+  configurations.push_back(configuration);
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity();
+  T(0, 0) = 2;
+  config::Configuration other(
+      std::make_shared<config::Supercell const>(prim, T));
+  other.dof_values.occupation(1) = 2;
+  other.dof_values.local_dof_values.at("disp").col(1) << 0.0, 0.02, 0.0;
+  configurations.push_back(other);
+
+  config::AtomicStructures structures =
+      config::make_atomic_structures(configurations);
+  ASSERT_EQ(structures.n_structures(), configurations.size());
+  EXPECT_EQ(structures.lat_column_mat.cols(), 3 * configurations.size());
+  for (Index i = 0; i < configurations.size(); ++i) {
+    xtal::SimpleStructure expected = make_simple_structure(configurations[i]);
+    Index n_atoms = expected.atom_info.names.size();
+    ASSERT_EQ(structures.n_atoms(i), n_atoms);
+    EXPECT_TRUE(almost_equal(
+        Eigen::MatrixXd(structures.lat_column_mat.middleCols(3 * i, 3)),
+        Eigen::MatrixXd(expected.lat_column_mat)));
+    EXPECT_TRUE(almost_equal(
+        Eigen::MatrixXd(structures.coords.middleCols(
+            structures.atom_offsets(i), n_atoms)),
+        expected.atom_info.coords));
+    for (Index a = 0; a < n_atoms; ++a) {
+      int type = structures.atom_type(structures.atom_offsets(i) + a);
+      EXPECT_EQ(structures.atom_type_names[type], expected.atom_info.names[a]);
+    }
+  }
+}
+
+TEST_F(MakeSimpleStructureTestStrainDisp, SameStrainTest1) {
+  // configurations with the same supercell and strain, different disp
+  config::Configuration configuration(supercell);
+  configuration.dof_values.global_dof_values.at("GLstrain")(2) = 0.1;
+  xtal::SimpleStructure structure_0 = make_simple_structure(configuration);
+
+  configuration.dof_values.local_dof_values.at("disp").col(1) << 0.0, 0.01,
+      0.02;
+  xtal::SimpleStructure structure_1 = make_simple_structure(configuration);
+
+  // same in an equal supercell that is not shared
+  config::Configuration other(std::make_shared<config::Supercell const>(
+      prim, supercell->superlattice.transformation_matrix_to_super()));
+  other.dof_values = configuration.dof_values;
+  xtal::SimpleStructure expected = make_simple_structure(other);
+
+  EXPECT_TRUE(almost_equal(structure_0.lat_column_mat,
+                           structure_1.lat_column_mat));
+  EXPECT_TRUE(almost_equal(structure_1.lat_column_mat,
+                           expected.lat_column_mat));
+  EXPECT_TRUE(
+      almost_equal(structure_1.atom_info.coords, expected.atom_info.coords));
+  EXPECT_FALSE(
+      almost_equal(structure_0.atom_info.coords, structure_1.atom_info.coords));
+}
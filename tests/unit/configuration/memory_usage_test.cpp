@@ -0,0 +1,108 @@
+#include "casm/configuration/memory_usage.hh"
+
+#include "casm/configuration/CanonicalPrimitiveCache.hh"
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/MatrixRepCache.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(MemoryUsageTest, SupercellAndConfigurationSet) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  EXPECT_GT(prim->sym_info.memory_bytes(),
+            prim->sym_info.factor_group->element.size() * sizeof(SymOp));
+
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  Index initial_total_bytes = config::supercell_sym_info_total_bytes();
+  {
+    auto supercell = std::make_shared<config::Supercell const>(prim, T);
+    EXPECT_FALSE(supercell->has_sym_info());
+    Index supercell_bytes = supercell->memory_bytes();
+    EXPECT_EQ(config::supercell_sym_info_total_bytes(), initial_total_bytes);
+
+    config::SupercellSymInfo const &sym_info = supercell->sym_info();
+    EXPECT_TRUE(supercell->has_sym_info());
+    ASSERT_TRUE(sym_info.translation_permutations.has_value());
+    EXPECT_GT(sym_info.memory_bytes(),
+              sym_info.translation_permutations->memory_bytes() +
+                  sym_info.factor_group_permutations.memory_bytes());
+    EXPECT_EQ(supercell->memory_bytes(),
+              supercell_bytes + sym_info.memory_bytes());
+    EXPECT_EQ(config::supercell_sym_info_total_bytes(),
+              initial_total_bytes + sym_info.memory_bytes());
+
+    config::ConfigurationSet configurations;
+    Index empty_bytes = configurations.memory_bytes();
+    config::Configuration configuration(supercell);
+    configurations.insert(configuration);
+    configuration.dof_values.occupation(0) = 1;
+    configurations.insert(configuration);
+    EXPECT_GT(configurations.memory_bytes(),
+              empty_bytes + 2 * configuration.memory_bytes());
+  }
+  EXPECT_EQ(config::supercell_sym_info_total_bytes(), initial_total_bytes);
+
+  config::MemoryUsage usage = config::memory_usage();
+  EXPECT_EQ(usage.total_bytes(),
+            usage.supercell_sym_info_bytes +
+                usage.combined_permutation_table_bytes +
+                usage.matrix_rep_cache_bytes +
+                usage.canonical_primitive_cache_bytes +
+                usage.orbit_cache_bytes + usage.prim_sym_info_cache_bytes);
+}
+
+TEST(MemoryUsageTest, MemoryBudget) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto reference = std::make_shared<config::Supercell const>(prim, T);
+  ASSERT_TRUE(reference->sym_info().translation_permutations.has_value());
+  EXPECT_FALSE(config::memory_budget().has_value());
+
+  // with no room, caches are evicted and translation permutations are not
+  // stored
+  config::set_memory_budget(0);
+  ASSERT_TRUE(config::memory_budget().has_value());
+  EXPECT_EQ(*config::memory_budget(), 0);
+  EXPECT_FALSE(config::memory_budget_allows(1));
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  EXPECT_FALSE(supercell->sym_info().translation_permutations.has_value());
+  auto const &table = supercell->sym_info().translation_table;
+  auto const &expected = *reference->sym_info().translation_permutations;
+  for (Index t = 0; t < table.n_translations(); ++t) {
+    for (Index i = 0; i < table.n_sites(); ++i) {
+      EXPECT_EQ(table.permute_index(t, i), expected(t, i));
+    }
+  }
+
+  auto combined = supercell->sym_info().combined_permutation_table();
+  ASSERT_TRUE(combined != nullptr);
+  EXPECT_EQ(config::combined_permutation_table_total_bytes(), 0);
+
+  std::vector<config::SupercellSymOp> group(
+      config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+  auto rep = config::default_matrix_rep_cache().matrix_rep(group, "occ",
+                                                           std::set<Index>{0});
+  EXPECT_FALSE(rep->sparse_matrix_rep.empty());
+  EXPECT_EQ(config::default_matrix_rep_cache().total_bytes(), 0);
+
+  config::Configuration configuration(supercell);
+  configuration.dof_values.occupation(0) = 1;
+  auto primitive =
+      config::default_canonical_primitive_cache().canonical_primitive(
+          configuration);
+  EXPECT_EQ(primitive->supercell->superlattice.size(), 8);
+  EXPECT_EQ(config::default_canonical_primitive_cache().total_bytes(), 0);
+
+  // without a budget, translation permutations are stored
+  config::set_memory_budget(std::nullopt);
+  EXPECT_TRUE(config::memory_budget_allows(Index(1) << 40));
+  auto other = std::make_shared<config::Supercell const>(prim, T);
+  EXPECT_TRUE(other->sym_info().translation_permutations.has_value());
+}
@@ -0,0 +1,72 @@
+#include "casm/configuration/numa.hh"
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/memory_usage.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(NumaTest, Topology) {
+  EXPECT_GE(config::numa_node_count(), 1);
+  EXPECT_GE(config::current_numa_node(), 0);
+  EXPECT_LT(config::current_numa_node(), config::numa_node_count());
+
+  EXPECT_FALSE(config::numa_replication_is_enabled());
+  config::set_numa_replication_enabled(true);
+  EXPECT_TRUE(config::numa_replication_is_enabled());
+  config::set_numa_replication_enabled(false);
+  EXPECT_FALSE(config::numa_replication_is_enabled());
+}
+
+TEST(NumaTest, SupercellReplica) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::SupercellSymInfo const &sym_info = supercell->sym_info();
+  Index supercell_bytes = supercell->memory_bytes();
+  Index total_bytes = config::supercell_sym_info_total_bytes();
+
+  // never the home node
+  Index node = config::numa_node_count();
+  auto replica = supercell->numa_replica(node);
+  ASSERT_TRUE(replica != nullptr);
+  EXPECT_EQ(supercell->numa_replica(node), replica);
+  EXPECT_TRUE(replica->has_sym_info());
+  EXPECT_EQ(*replica, *supercell);
+  EXPECT_EQ(replica->name, supercell->name);
+
+  config::SupercellSymInfo const &replica_sym_info = replica->sym_info();
+  EXPECT_NE(&replica_sym_info, &sym_info);
+  EXPECT_EQ(replica_sym_info.factor_group, sym_info.factor_group);
+  EXPECT_TRUE(replica_sym_info.factor_group_permutations ==
+              sym_info.factor_group_permutations);
+  ASSERT_TRUE(replica_sym_info.translation_permutations.has_value());
+  EXPECT_TRUE(*replica_sym_info.translation_permutations ==
+              *sym_info.translation_permutations);
+  EXPECT_EQ(config::supercell_sym_info_total_bytes(),
+            total_bytes + replica_sym_info.memory_bytes());
+  EXPECT_EQ(supercell->memory_bytes(),
+            supercell_bytes + replica->memory_bytes());
+
+  // replica operations apply to configurations in the supercell
+  config::Configuration configuration(supercell);
+  configuration.dof_values.occupation(0) = 1;
+  configuration.dof_values.occupation(3) = 1;
+  config::Configuration expected = config::make_canonical_form(
+      configuration, config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+  config::Configuration canonical = config::make_canonical_form(
+      configuration, config::SupercellSymOp::begin(replica),
+      config::SupercellSymOp::end(replica));
+  EXPECT_EQ(canonical.supercell, supercell);
+  EXPECT_EQ(canonical, expected);
+
+  // disabled, or only one node
+  EXPECT_EQ(config::local_supercell(supercell), supercell);
+}
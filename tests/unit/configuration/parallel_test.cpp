@@ -0,0 +1,78 @@
+#include "casm/configuration/parallel.hh"
+
+#include <atomic>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+TEST(ParallelTest, ChunksTest) {
+  for (Index n_threads : {1, 2, 3, 8}) {
+    std::vector<int> count(100, 0);
+    std::vector<std::pair<Index, Index>> chunks(n_threads, {-1, -1});
+    config::parallel_for_chunks(
+        count.size(), n_threads, [&](Index c, Index begin, Index end) {
+          chunks[c] = {begin, end};
+          for (Index i = begin; i < end; ++i) {
+            count[i] += 1;
+          }
+        });
+    for (int x : count) {
+      EXPECT_EQ(x, 1);
+    }
+    // contiguous, in order of chunk index
+    EXPECT_EQ(chunks.front().first, 0);
+    EXPECT_EQ(chunks.back().second, count.size());
+    for (Index c = 1; c < n_threads; ++c) {
+      EXPECT_EQ(chunks[c].first, chunks[c - 1].second);
+    }
+  }
+}
+
+TEST(ParallelTest, NestedTest) {
+  std::atomic<Index> count{0};
+  config::parallel_for_chunks(8, 8, [&](Index c, Index begin, Index end) {
+    config::parallel_for_chunks(
+        100, 8, [&](Index c_inner, Index begin_inner, Index end_inner) {
+          count += end_inner - begin_inner;
+        });
+  });
+  EXPECT_EQ(count.load(), 800);
+}
+
+TEST(ParallelTest, ExceptionTest) {
+  std::atomic<Index> count{0};
+  EXPECT_THROW(config::parallel_for_chunks(
+                   8, 8,
+                   [&](Index c, Index begin, Index end) {
+                     ++count;
+                     if (c == 3) {
+                       throw std::runtime_error("chunk 3");
+                     }
+                   }),
+               std::runtime_error);
+  // all chunks are finished before rethrowing
+  EXPECT_EQ(count.load(), 8);
+}
+
+TEST(ParallelTest, DefaultNThreadsTest) {
+  Index n_threads_init = config::default_n_threads();
+  EXPECT_GE(n_threads_init, 1);
+  EXPECT_EQ(config::resolve_n_threads(0), n_threads_init);
+  EXPECT_EQ(config::resolve_n_threads(3), 3);
+
+  // with a pool of 1 thread, chunks are run in order on the calling thread
+  config::set_default_n_threads(1);
+  EXPECT_EQ(config::default_n_threads(), 1);
+  std::vector<Index> order;
+  std::thread::id caller = std::this_thread::get_id();
+  config::parallel_for_chunks(10, 4, [&](Index c, Index begin, Index end) {
+    EXPECT_EQ(std::this_thread::get_id(), caller);
+    order.push_back(c);
+  });
+  EXPECT_EQ(order, std::vector<Index>({0, 1, 2, 3}));
+
+  config::set_default_n_threads(0);
+  EXPECT_EQ(config::default_n_threads(), n_threads_init);
+}
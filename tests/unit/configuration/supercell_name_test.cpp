@@ -1,5 +1,8 @@
 #include "casm/configuration/supercell_name.hh"
 
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/canonical_form.hh"
 #include "casm/crystallography/BasicStructureTools.hh"
 #include "casm/crystallography/SymTools.hh"
 #include "gtest/gtest.h"
@@ -70,3 +73,37 @@ TEST_F(SupercellNameTest, Test3) {
   EXPECT_TRUE(
       is_symmetrically_equivalent(recreated_superlattice, superlattice));
 }
+
+TEST_F(SupercellNameTest, TransformationMatrixTest) {
+  // standard cubic FCC unit cell
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  std::string name = config::make_supercell_name(T);
+  EXPECT_EQ(name, "SCEL4_2_2_1_1_1_0");
+
+  Eigen::Matrix3l H = config::make_hermite_normal_form(name);
+  EXPECT_EQ(config::make_supercell_name(H), name);
+  EXPECT_EQ(H.determinant(), 4);
+
+  EXPECT_THROW(config::make_hermite_normal_form("SCEL4_2_2_1_1_1"),
+               std::runtime_error);
+  EXPECT_THROW(config::make_hermite_normal_form("SCEL4_2_2_1_1_1_0x"),
+               std::runtime_error);
+  EXPECT_THROW(config::make_hermite_normal_form("4_2_2_1_1_1_0"),
+               std::runtime_error);
+}
+
+TEST_F(SupercellNameTest, SupercellNameTest) {
+  auto shared_prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << 1, 0, 0, 0, 1, 0, 0, 0, 4;
+  auto supercell = config::make_shared_supercell(shared_prim, T);
+  auto const &superlattice = supercell->superlattice;
+  EXPECT_EQ(supercell->name,
+            config::make_supercell_name(superlattice.prim_lattice(),
+                                        superlattice.superlattice()));
+
+  auto canonical_supercell = config::make_canonical_form(*supercell);
+  EXPECT_EQ(supercell->canonical_name(), canonical_supercell->name);
+  EXPECT_EQ(canonical_supercell->canonical_name(), canonical_supercell->name);
+}
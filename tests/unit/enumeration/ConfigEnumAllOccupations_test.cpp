@@ -0,0 +1,282 @@
+#include "casm/configuration/enumeration/ConfigEnumAllOccupations.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/enumeration/ConfigurationFilter.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Enumerate with the filtered enumerator, in batches
+std::vector<config::Configuration> enumerate_filtered(
+    config::Configuration const &background, std::set<Index> const &sites,
+    bool skip_non_primitive,
+    std::optional<std::vector<config::SupercellSymOp>> const &subgroup,
+    std::shared_ptr<config::ConfigurationFilter const> filter = nullptr) {
+  config::ConfigEnumAllOccupations enumerator(background, sites,
+                                              skip_non_primitive, subgroup,
+                                              filter);
+  std::vector<config::Configuration> result;
+  while (enumerator.is_valid()) {
+    for (auto const &configuration : enumerator.next_batch(7)) {
+      result.push_back(configuration);
+    }
+  }
+  return result;
+}
+
+/// Enumerate all occupations and filter afterwards
+std::vector<config::Configuration> enumerate_then_filter(
+    config::Configuration const &background, std::set<Index> const &sites,
+    bool skip_non_primitive,
+    std::optional<std::vector<config::SupercellSymOp>> const &subgroup) {
+  config::ConfigEnumAllOccupations enumerator(background, sites);
+  std::vector<config::Configuration> result;
+  while (enumerator.is_valid()) {
+    config::Configuration const &configuration = enumerator.value();
+    if ((!skip_non_primitive || is_primitive(configuration)) &&
+        (!subgroup.has_value() ||
+         is_canonical(configuration, subgroup->begin(), subgroup->end()))) {
+      result.push_back(configuration);
+    }
+    enumerator.advance();
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(ConfigEnumAllOccupationsTest, FilteredFCCBinary) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  std::set<Index> sites;
+  for (Index l = 0; l < background.dof_values.occupation.size(); ++l) {
+    sites.insert(l);
+  }
+  auto subgroup = make_invariant_subgroup(
+      background, sites, config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+
+  // not filtered
+  EXPECT_EQ(enumerate_filtered(background, sites, false, std::nullopt).size(),
+            16);
+
+  // filtered, occupation-only prim uses OccCanonicalizer
+  auto expected = enumerate_then_filter(background, sites, true, subgroup);
+  auto filtered = enumerate_filtered(background, sites, true, subgroup);
+  EXPECT_EQ(filtered, expected);
+  EXPECT_LT(filtered.size(), 16);
+
+  // with a ConfigurationFilter
+  auto f = std::make_shared<config::GenericConfigurationFilter>();
+  f->primitive_only = false;
+  f->canonical_only = false;
+  f->f = [](config::Configuration const &configuration) {
+    return configuration.dof_values.occupation.sum() == 1;
+  };
+  filtered = enumerate_filtered(background, sites, true, subgroup, f);
+  ASSERT_EQ(filtered.size(), 1);
+  EXPECT_EQ(filtered[0].dof_values.occupation.sum(), 1);
+}
+
+TEST(ConfigEnumAllOccupationsTest, RecentWitnesses) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  std::set<Index> sites;
+  for (Index l = 0; l < background.dof_values.occupation.size(); ++l) {
+    sites.insert(l);
+  }
+  std::vector<config::SupercellSymOp> subgroup(
+      config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+
+  config::ConfigEnumAllOccupations enumerator(background, sites, false,
+                                              subgroup);
+  std::vector<config::Configuration> filtered;
+  while (enumerator.is_valid()) {
+    filtered.push_back(enumerator.value());
+    enumerator.advance();
+  }
+  EXPECT_EQ(filtered,
+            enumerate_then_filter(background, sites, false, subgroup));
+
+  // every value is checked once, and some are rejected by a recent witness
+  config::CanonicalWitnessList const &recent = enumerator.recent_witnesses();
+  EXPECT_EQ(recent.n_hits() + recent.n_scans(), 256);
+  EXPECT_GT(recent.n_hits(), 0);
+  EXPECT_GE(recent.n_scans(), filtered.size());
+}
+
+TEST(ConfigEnumAllOccupationsTest, FilteredFCCTernaryGLstrain) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  std::set<Index> sites{0, 1};
+  auto subgroup = make_invariant_subgroup(
+      background, sites, config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+
+  auto expected = enumerate_then_filter(background, sites, true, subgroup);
+  auto filtered = enumerate_filtered(background, sites, true, subgroup);
+  EXPECT_EQ(filtered, expected);
+  EXPECT_LT(filtered.size(), 9);
+}
+
+TEST(ConfigEnumAllOccupationsTest, Resume) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  std::set<Index> sites;
+  for (Index l = 0; l < background.dof_values.occupation.size(); ++l) {
+    sites.insert(l);
+  }
+  auto subgroup = make_invariant_subgroup(
+      background, sites, config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+
+  std::vector<config::Configuration> values;
+  std::vector<std::vector<int>> states;
+  config::ConfigEnumAllOccupations enumerator(background, sites, true,
+                                              subgroup);
+  while (enumerator.is_valid()) {
+    values.push_back(enumerator.value());
+    states.push_back(enumerator.state());
+    enumerator.advance();
+  }
+  ASSERT_GT(values.size(), 2);
+
+  // resuming from each state gives the remaining values
+  for (Index i = 0; i < values.size(); ++i) {
+    config::ConfigEnumAllOccupations resumed(background, sites, true,
+                                             subgroup);
+    resumed.resume(states[i]);
+    Index j = i;
+    while (resumed.is_valid()) {
+      ASSERT_LT(j, values.size());
+      EXPECT_EQ(resumed.value(), values[j]);
+      ++j;
+      resumed.advance();
+    }
+    EXPECT_EQ(j, values.size());
+  }
+
+  // a state preceding the current value
+  config::ConfigEnumAllOccupations resumed(background, sites, true, subgroup);
+  resumed.resume(states[1]);
+  EXPECT_THROW(resumed.resume(states[0]), std::runtime_error);
+}
+
+TEST(ConfigEnumAllOccupationsTest, Shards) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  std::set<Index> sites;
+  for (Index l = 0; l < background.dof_values.occupation.size(); ++l) {
+    sites.insert(l);
+  }
+  auto subgroup = make_invariant_subgroup(
+      background, sites, config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+
+  for (bool skip_non_primitive : {false, true}) {
+    std::vector<config::Configuration> expected =
+        enumerate_filtered(background, sites, skip_non_primitive, subgroup);
+
+    // shards, in order, visit the same values in the same order
+    for (Index n_shards : {1, 2, 3, 7, 100}) {
+      std::vector<config::Configuration> values;
+      for (Index shard_index = 0; shard_index < n_shards; ++shard_index) {
+        config::ConfigEnumAllOccupations enumerator(
+            background, sites, skip_non_primitive, subgroup, nullptr,
+            shard_index, n_shards);
+        while (enumerator.is_valid()) {
+          values.push_back(enumerator.value());
+          enumerator.advance();
+        }
+      }
+      EXPECT_EQ(values, expected);
+    }
+  }
+
+  // resume within a shard
+  config::ConfigEnumAllOccupations shard(background, sites, false, subgroup,
+                                         nullptr, 1, 2);
+  std::vector<config::Configuration> values;
+  std::vector<std::vector<int>> states;
+  while (shard.is_valid()) {
+    values.push_back(shard.value());
+    states.push_back(shard.state());
+    shard.advance();
+  }
+  ASSERT_GT(values.size(), 1);
+  config::ConfigEnumAllOccupations resumed(background, sites, false, subgroup,
+                                           nullptr, 1, 2);
+  resumed.resume(states[1]);
+  EXPECT_EQ(resumed.value(), values[1]);
+
+  // a state in another shard
+  config::ConfigEnumAllOccupations first(background, sites, false, subgroup,
+                                         nullptr, 0, 2);
+  EXPECT_THROW(first.resume(states[0]), std::runtime_error);
+
+  EXPECT_THROW(config::ConfigEnumAllOccupations(background, sites, false,
+                                                subgroup, nullptr, 2, 2),
+               std::runtime_error);
+}
+
+TEST(ConfigEnumAllOccupationsTest, InvariantSubgroup) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  // background with one fixed site, enumerate on the others
+  config::Configuration background(supercell);
+  background.dof_values.occupation(0) = 2;
+  std::set<Index> sites{1, 2, 3};
+  auto subgroup = make_invariant_subgroup(background, sites, begin, end);
+
+  // without and with a canonical subgroup
+  for (bool use_subgroup : {false, true}) {
+    std::optional<std::vector<config::SupercellSymOp>> canonical_subgroup;
+    if (use_subgroup) {
+      canonical_subgroup = subgroup;
+    }
+    config::ConfigEnumAllOccupations enumerator(background, sites, false,
+                                                canonical_subgroup);
+    Index count = 0;
+    while (enumerator.is_valid()) {
+      config::Configuration const &configuration = enumerator.value();
+      std::vector<config::SupercellSymOp> expected =
+          use_subgroup ? make_invariant_subgroup(configuration, sites,
+                                                 subgroup.begin(),
+                                                 subgroup.end())
+                       : make_invariant_subgroup(configuration, sites, begin,
+                                                 end);
+      EXPECT_EQ(enumerator.invariant_subgroup_size(), expected.size());
+      EXPECT_EQ(enumerator.invariant_subgroup(), expected);
+      enumerator.advance();
+      ++count;
+    }
+    EXPECT_GT(count, 0);
+  }
+}
@@ -0,0 +1,205 @@
+#include "casm/configuration/enumeration/ConfigEnumCanonicalOccupations.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/enumeration/ConfigEnumAllOccupations.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+std::set<config::Configuration> enumerate_canonical(
+    config::Configuration const &background, std::set<Index> const &sites,
+    std::vector<config::SupercellSymOp> const &group) {
+  config::ConfigEnumCanonicalOccupations enumerator(background, sites, group);
+  std::set<config::Configuration> result;
+  while (enumerator.is_valid()) {
+    EXPECT_TRUE(result.insert(enumerator.value()).second);
+    enumerator.advance();
+  }
+  return result;
+}
+
+std::set<config::Configuration> enumerate_all_canonical(
+    config::Configuration const &background, std::set<Index> const &sites,
+    std::vector<config::SupercellSymOp> const &group) {
+  config::ConfigEnumAllOccupations enumerator(background, sites, false, group);
+  std::set<config::Configuration> result;
+  while (enumerator.is_valid()) {
+    result.insert(enumerator.value());
+    enumerator.advance();
+  }
+  return result;
+}
+
+std::set<Index> all_sites(config::Configuration const &configuration) {
+  std::set<Index> sites;
+  for (Index l = 0; l < configuration.dof_values.occupation.size(); ++l) {
+    sites.insert(l);
+  }
+  return sites;
+}
+
+void check(config::Configuration const &background,
+           std::set<Index> const &sites) {
+  auto supercell = background.supercell;
+  auto group = make_invariant_subgroup(
+      background, sites, config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+  auto expected = enumerate_all_canonical(background, sites, group);
+  auto canonical = enumerate_canonical(background, sites, group);
+  EXPECT_FALSE(canonical.empty());
+  EXPECT_EQ(canonical, expected);
+}
+
+}  // namespace
+
+TEST(ConfigEnumCanonicalOccupationsTest, FCCTernary) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+
+  // all sites
+  check(background, all_sites(background));
+
+  // a subset of sites, in a non-uniform background
+  background.dof_values.occupation(3) = 2;
+  check(background, {0, 1});
+}
+
+TEST(ConfigEnumCanonicalOccupationsTest, SimpleCubicIsing) {
+  // anisotropic occupants
+  auto prim = config::make_shared_prim(test::SimpleCubic_ising_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  check(background, all_sites(background));
+}
+
+TEST(ConfigEnumCanonicalOccupationsTest, FCCTernaryGLstrain) {
+  // canonical check with non-zero global DoF
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  check(background, all_sites(background));
+
+  // group which does not leave global DoF invariant
+  background.dof_values.global_dof_values.at("GLstrain")(0) = 0.01;
+  std::set<Index> sites = all_sites(background);
+  std::vector<config::SupercellSymOp> group(
+      config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+  EXPECT_EQ(enumerate_canonical(background, sites, group),
+            enumerate_all_canonical(background, sites, group));
+}
+
+TEST(ConfigEnumCanonicalOccupationsTest, FCCTernaryFixedComposition) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  std::set<Index> sites = all_sites(background);
+
+  // FCC_ternary occupants are "A", "B", "C"; fix the number of "B" and "C"
+  std::vector<config::OccupantCountConstraint> constraints(2);
+  constraints[0].occupant_name = "B";
+  constraints[0].site_indices = sites;
+  constraints[0].min_count = constraints[0].max_count = 2;
+  constraints[1].occupant_name = "C";
+  constraints[1].site_indices = sites;
+  constraints[1].min_count = 1;
+  constraints[1].max_count = 2;
+
+  auto count = [](config::Configuration const &configuration, int value) {
+    Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+    return (occupation.array() == value).count();
+  };
+
+  // without symmetry: all occupations with the composition
+  config::ConfigEnumCanonicalOccupations no_sym_enumerator(
+      background, sites, {}, false, constraints);
+  Index n_no_sym = 0;
+  while (no_sym_enumerator.is_valid()) {
+    auto const &configuration = no_sym_enumerator.value();
+    EXPECT_EQ(count(configuration, 1), 2);
+    EXPECT_TRUE(count(configuration, 2) == 1 || count(configuration, 2) == 2);
+    ++n_no_sym;
+    no_sym_enumerator.advance();
+  }
+  // 8!/(2!1!5!) + 8!/(2!2!4!)
+  EXPECT_EQ(n_no_sym, 168 + 420);
+
+  // with symmetry: the canonical occupations with the composition
+  auto group = make_invariant_subgroup(
+      background, sites, config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+  std::set<config::Configuration> expected;
+  for (auto const &configuration :
+       enumerate_canonical(background, sites, group)) {
+    if (count(configuration, 1) == 2 &&
+        (count(configuration, 2) == 1 || count(configuration, 2) == 2)) {
+      expected.insert(configuration);
+    }
+  }
+  config::ConfigEnumCanonicalOccupations enumerator(background, sites, group,
+                                                    false, constraints);
+  std::set<config::Configuration> canonical;
+  while (enumerator.is_valid()) {
+    canonical.insert(enumerator.value());
+    enumerator.advance();
+  }
+  EXPECT_FALSE(canonical.empty());
+  EXPECT_EQ(canonical, expected);
+}
+
+TEST(ConfigEnumCanonicalOccupationsTest, Resume) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  std::set<Index> sites = all_sites(background);
+  auto group = make_invariant_subgroup(
+      background, sites, config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+
+  std::vector<config::Configuration> values;
+  std::vector<std::vector<int>> states;
+  config::ConfigEnumCanonicalOccupations enumerator(background, sites, group);
+  while (enumerator.is_valid()) {
+    values.push_back(enumerator.value());
+    states.push_back(enumerator.state());
+    enumerator.advance();
+  }
+  ASSERT_GT(values.size(), 2);
+
+  // resuming from each state gives the remaining values
+  for (Index i = 0; i < values.size(); ++i) {
+    config::ConfigEnumCanonicalOccupations resumed(background, sites, group);
+    resumed.resume(states[i]);
+    Index j = i;
+    while (resumed.is_valid()) {
+      ASSERT_LT(j, values.size());
+      EXPECT_EQ(resumed.value(), values[j]);
+      ++j;
+      resumed.advance();
+    }
+    EXPECT_EQ(j, values.size());
+  }
+
+  // a non-canonical state is not a value of the enumeration
+  std::vector<int> non_canonical(sites.size(), 0);
+  non_canonical.back() = 1;
+  config::ConfigEnumCanonicalOccupations resumed(background, sites, group);
+  EXPECT_THROW(resumed.resume(non_canonical), std::runtime_error);
+  EXPECT_FALSE(resumed.is_valid());
+}
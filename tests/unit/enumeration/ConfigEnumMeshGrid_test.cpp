@@ -0,0 +1,128 @@
+#include "casm/configuration/enumeration/ConfigEnumMeshGrid.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/dof_space_analysis.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+void expect_same_dof_values(config::Configuration const &A,
+                            config::Configuration const &B) {
+  EXPECT_EQ(A.dof_values.local_dof_values.size(),
+            B.dof_values.local_dof_values.size());
+  for (auto const &pair : B.dof_values.local_dof_values) {
+    EXPECT_TRUE(almost_equal(A.dof_values.local_dof_values.at(pair.first),
+                             pair.second));
+  }
+  EXPECT_EQ(A.dof_values.global_dof_values.size(),
+            B.dof_values.global_dof_values.size());
+  for (auto const &pair : B.dof_values.global_dof_values) {
+    EXPECT_TRUE(almost_equal(A.dof_values.global_dof_values.at(pair.first),
+                             pair.second));
+  }
+}
+
+/// Enumerate with next_batch, check each configuration against
+/// set_dof_space_values, and check batches match advance
+std::vector<Eigen::VectorXd> check_enumeration(
+    config::ConfigEnumMeshGrid enumerator,
+    config::Configuration const &background,
+    clexulator::DoFSpace const &dof_space) {
+  config::ConfigEnumMeshGrid single(enumerator);
+  std::vector<Eigen::VectorXd> points;
+  while (enumerator.is_valid()) {
+    Eigen::MatrixXd order_parameters;
+    std::vector<Index> subwedge_indices;
+    std::vector<config::Configuration> batch =
+        enumerator.next_batch(5, order_parameters, subwedge_indices);
+    EXPECT_EQ(order_parameters.cols(), batch.size());
+    EXPECT_EQ(subwedge_indices.size(), batch.size());
+    for (Index i = 0; i < batch.size(); ++i) {
+      config::Configuration expected = background;
+      set_dof_space_values(expected, dof_space, order_parameters.col(i));
+      expect_same_dof_values(batch[i], expected);
+
+      EXPECT_TRUE(single.is_valid());
+      EXPECT_EQ(single.subwedge_index(), subwedge_indices[i]);
+      EXPECT_TRUE(
+          almost_equal(single.order_parameters(), order_parameters.col(i)));
+      expect_same_dof_values(single.value(), expected);
+      single.advance();
+      points.push_back(order_parameters.col(i));
+    }
+  }
+  EXPECT_FALSE(single.is_valid());
+  return points;
+}
+
+}  // namespace
+
+TEST(ConfigEnumMeshGridTest, Test1) {
+  // local disp DoFSpace in the prim, enumerated in a conventional FCC
+  // supercell
+  auto xtal_prim = std::make_shared<xtal::BasicStructure const>(
+      test::FCC_binary_disp_prim());
+  auto prim = std::make_shared<config::Prim const>(xtal_prim);
+  clexulator::DoFSpace dof_space("disp", xtal_prim, Eigen::Matrix3l::Identity(),
+                                 std::nullopt, std::nullopt);
+
+  Eigen::Matrix3l T;
+  T << -1, 1, 1,  //
+      1, -1, 1,   //
+      1, 1, -1;   //
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+
+  std::vector<Eigen::VectorXd> xi(3, Eigen::VectorXd(2));
+  xi[0] << -0.1, 0.1;
+  xi[1] << 0.0, 0.2;
+  xi[2] << 0.05, 0.15;
+  config::ConfigEnumMeshGrid enumerator(background, dof_space, xi);
+  std::vector<Eigen::VectorXd> points =
+      check_enumeration(enumerator, background, dof_space);
+  EXPECT_EQ(points.size(), 8);
+}
+
+TEST(ConfigEnumMeshGridTest, Test2) {
+  // global GLstrain DoFSpace, enumerated in the irreducible wedge
+  auto xtal_prim = std::make_shared<xtal::BasicStructure const>(
+      test::SimpleCubic_GLstrain_prim());
+  auto prim = std::make_shared<config::Prim const>(xtal_prim);
+  clexulator::DoFSpace dof_space("GLstrain", xtal_prim, std::nullopt,
+                                 std::nullopt, std::nullopt);
+
+  auto supercell = std::make_shared<config::Supercell const>(
+      prim, Eigen::Matrix3l::Identity());
+  config::Configuration background(supercell);
+
+  bool calc_wedges = true;
+  config::DoFSpaceAnalysisResults results = config::dof_space_analysis(
+      dof_space, prim, background, std::nullopt, false, std::nullopt,
+      std::nullopt, calc_wedges);
+  std::vector<irreps::SubWedge> const &irreducible_wedge =
+      results.symmetry_report.irreducible_wedge;
+  ASSERT_TRUE(irreducible_wedge.size() > 0);
+
+  clexulator::DoFSpace const &adapted_dof_space =
+      results.symmetry_adapted_dof_space;
+
+  double stop = 0.1;
+  Index num = 3;
+  config::ConfigEnumMeshGrid enumerator(background, adapted_dof_space,
+                                        irreducible_wedge, stop, num);
+  std::vector<Eigen::VectorXd> points =
+      check_enumeration(enumerator, background, adapted_dof_space);
+  EXPECT_TRUE(points.size() > 0);
+
+  // without trimming, more points
+  config::ConfigEnumMeshGrid untrimmed(background, adapted_dof_space,
+                                       irreducible_wedge, stop, num, false);
+  EXPECT_TRUE(
+      check_enumeration(untrimmed, background, adapted_dof_space).size() >
+      points.size());
+}
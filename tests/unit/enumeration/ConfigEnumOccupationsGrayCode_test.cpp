@@ -0,0 +1,49 @@
+#include "casm/configuration/enumeration/ConfigEnumOccupationsGrayCode.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/enumeration/ConfigEnumAllOccupations.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(ConfigEnumOccupationsGrayCodeTest, FCCTernary) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  background.dof_values.occupation(2) = 2;
+  std::set<Index> sites{0, 1, 3};
+
+  std::set<config::Configuration> expected;
+  config::ConfigEnumAllOccupations all_enumerator(background, sites);
+  while (all_enumerator.is_valid()) {
+    expected.insert(all_enumerator.value());
+    all_enumerator.advance();
+  }
+  EXPECT_EQ(expected.size(), 27);
+
+  std::set<config::Configuration> visited;
+  config::ConfigEnumOccupationsGrayCode enumerator(background, sites);
+  EXPECT_EQ(enumerator.last_change().site_index, -1);
+  Eigen::VectorXi previous = enumerator.value().dof_values.occupation;
+  while (enumerator.is_valid()) {
+    Eigen::VectorXi const &current = enumerator.value().dof_values.occupation;
+    if (!visited.empty()) {
+      // exactly one site changes, by one occupant index
+      auto const &delta = enumerator.last_change();
+      EXPECT_EQ((current.array() != previous.array()).count(), 1);
+      EXPECT_EQ(previous(delta.site_index), delta.old_value);
+      EXPECT_EQ(current(delta.site_index), delta.new_value);
+      EXPECT_EQ(std::abs(delta.new_value - delta.old_value), 1);
+      EXPECT_EQ(sites.count(delta.site_index), 1);
+    }
+    EXPECT_TRUE(visited.insert(enumerator.value()).second);
+    previous = current;
+    enumerator.advance();
+  }
+  EXPECT_EQ(visited, expected);
+  EXPECT_EQ(enumerator.last_change().site_index, -1);
+}
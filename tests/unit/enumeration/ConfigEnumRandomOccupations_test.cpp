@@ -0,0 +1,102 @@
+#include "casm/configuration/enumeration/ConfigEnumRandomOccupations.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/enumeration/ConfigEnumCanonicalOccupations.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(ConfigEnumRandomOccupationsTest, MakeSublatticeComposition) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << 3, 0, 0, 0, 1, 0, 0, 0, 1;
+  config::Supercell supercell(prim, T);
+
+  std::map<std::string, double> fractions({{"A", 0.5}, {"B", 0.5}});
+  config::SiteComposition composition =
+      config::make_sublattice_composition(supercell, {0}, fractions);
+  EXPECT_EQ(composition.site_indices.size(), 3);
+  std::map<std::string, Index> expected({{"A", 2}, {"B", 1}});
+  EXPECT_EQ(composition.occupant_counts, expected);
+
+  std::map<std::string, double> invalid({{"A", 0.5}, {"B", 0.6}});
+  EXPECT_THROW(config::make_sublattice_composition(supercell, {0}, invalid),
+               std::runtime_error);
+}
+
+TEST(ConfigEnumRandomOccupationsTest, FCCBinary) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  config::Configuration background(supercell);
+  std::map<std::string, double> fractions({{"A", 0.5}, {"B", 0.5}});
+  std::vector<config::SiteComposition> compositions(
+      {config::make_sublattice_composition(*supercell, {0}, fractions)});
+
+  // expected: all distinct configurations with 4 "B"
+  config::OccupantCountConstraint constraint;
+  constraint.occupant_name = "B";
+  constraint.site_indices = compositions[0].site_indices;
+  constraint.min_count = constraint.max_count = 4;
+  std::vector<config::SupercellSymOp> group(
+      config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+  config::ConfigEnumCanonicalOccupations enumerator(
+      background, constraint.site_indices, group, false, {constraint});
+  std::set<config::Configuration> expected;
+  while (enumerator.is_valid()) {
+    expected.insert(enumerator.value());
+    enumerator.advance();
+  }
+  EXPECT_GT(expected.size(), 3);
+
+  // with enough attempts, all are generated, once each
+  config::ConfigEnumRandomOccupations generator(background, compositions, 1);
+  std::vector<config::Configuration> batch =
+      generator.next_batch(expected.size() + 1, 10000);
+  std::set<config::Configuration> generated(batch.begin(), batch.end());
+  EXPECT_EQ(generated.size(), batch.size());
+  EXPECT_EQ(generated, expected);
+  EXPECT_EQ(generator.n_unique(), expected.size());
+  EXPECT_EQ(generator.n_attempts(), 10000);
+  EXPECT_EQ(generator.n_duplicates(), 10000 - expected.size());
+  EXPECT_TRUE(generator.next_batch(1, 100).empty());
+  EXPECT_FALSE(generator.insert(*batch.begin()));
+
+  // results depend on seed, not on n_threads
+  auto make_sequence = [&](std::uint64_t seed, Index n_threads) {
+    config::ConfigEnumRandomOccupations g(background, compositions, seed,
+                                          false, n_threads);
+    std::vector<config::Configuration> result;
+    for (Index i = 0; i < 3; ++i) {
+      for (auto const &configuration : g.next_batch(1, 100)) {
+        result.push_back(configuration);
+      }
+    }
+    return result;
+  };
+  EXPECT_EQ(make_sequence(2, 1), make_sequence(2, 4));
+  EXPECT_EQ(make_sequence(2, 1).size(), 3);
+
+  // candidates have the requested composition
+  for (Index i = 0; i < 10; ++i) {
+    config::Configuration candidate = generator.make_candidate(i);
+    EXPECT_EQ(candidate.dof_values.occupation.sum(), 4);
+  }
+
+  // invalid compositions
+  std::vector<config::SiteComposition> overlapping({compositions[0],
+                                                    compositions[0]});
+  EXPECT_THROW(
+      config::ConfigEnumRandomOccupations(background, overlapping, 0),
+      std::runtime_error);
+  std::vector<config::SiteComposition> wrong_count(compositions);
+  wrong_count[0].occupant_counts["B"] += 1;
+  EXPECT_THROW(
+      config::ConfigEnumRandomOccupations(background, wrong_count, 0),
+      std::runtime_error);
+}
@@ -0,0 +1,197 @@
+#include "casm/configuration/enumeration/ConfigEnumSubWedgeSampling.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/dof_space_analysis.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+class SimpleCubicGLstrainSamplingTest : public testing::Test {
+ protected:
+  SimpleCubicGLstrainSamplingTest()
+      : xtal_prim(std::make_shared<xtal::BasicStructure const>(
+            test::SimpleCubic_GLstrain_prim())),
+        prim(std::make_shared<config::Prim const>(xtal_prim)),
+        dof_space("GLstrain", xtal_prim, std::nullopt, std::nullopt,
+                  std::nullopt),
+        background(std::make_shared<config::Supercell const>(
+            prim, Eigen::Matrix3l::Identity())) {
+    bool calc_wedges = true;
+    config::DoFSpaceAnalysisResults results = config::dof_space_analysis(
+        dof_space, prim, background, std::nullopt, false, std::nullopt,
+        std::nullopt, calc_wedges);
+    irreducible_wedge = results.symmetry_report.irreducible_wedge;
+    adapted_dof_space = std::make_unique<clexulator::DoFSpace>(
+        results.symmetry_adapted_dof_space);
+  }
+
+  /// Enumerate with next_batch, check each configuration against
+  /// set_dof_space_values, and check batches match advance
+  Eigen::MatrixXd check_enumeration(
+      config::ConfigEnumSubWedgeSampling enumerator,
+      std::vector<Index> &subwedge_indices) {
+    config::ConfigEnumSubWedgeSampling single(enumerator);
+    std::vector<Eigen::VectorXd> points;
+    subwedge_indices.clear();
+    while (enumerator.is_valid()) {
+      Eigen::MatrixXd order_parameters;
+      std::vector<Index> batch_subwedge_indices;
+      std::vector<config::Configuration> batch =
+          enumerator.next_batch(7, order_parameters, batch_subwedge_indices);
+      EXPECT_EQ(order_parameters.cols(), batch.size());
+      for (Index i = 0; i < batch.size(); ++i) {
+        config::Configuration expected = background;
+        set_dof_space_values(expected, *adapted_dof_space,
+                             order_parameters.col(i));
+        EXPECT_TRUE(almost_equal(
+            batch[i].dof_values.global_dof_values.at("GLstrain"),
+            expected.dof_values.global_dof_values.at("GLstrain")));
+
+        EXPECT_TRUE(single.is_valid());
+        EXPECT_EQ(single.subwedge_index(), batch_subwedge_indices[i]);
+        EXPECT_TRUE(
+            almost_equal(single.order_parameters(), order_parameters.col(i)));
+        single.advance();
+        points.push_back(order_parameters.col(i));
+        subwedge_indices.push_back(batch_subwedge_indices[i]);
+      }
+    }
+    EXPECT_FALSE(single.is_valid());
+    Eigen::MatrixXd result(adapted_dof_space->basis.cols(), points.size());
+    for (Index i = 0; i < points.size(); ++i) {
+      result.col(i) = points[i];
+    }
+    return result;
+  }
+
+  std::shared_ptr<xtal::BasicStructure const> xtal_prim;
+  std::shared_ptr<config::Prim const> prim;
+  clexulator::DoFSpace dof_space;
+  config::Configuration background;
+  std::vector<irreps::SubWedge> irreducible_wedge;
+  std::unique_ptr<clexulator::DoFSpace> adapted_dof_space;
+};
+
+}  // namespace
+
+TEST(SobolSequenceTest, Test1) {
+  // first points after the origin, in 2 dimensions
+  config::SobolSequence sobol(2);
+  Eigen::MatrixXd expected(2, 4);
+  expected.col(0) << 0.5, 0.5;
+  expected.col(1) << 0.75, 0.25;
+  expected.col(2) << 0.25, 0.75;
+  expected.col(3) << 0.375, 0.375;
+  for (Index i = 0; i < expected.cols(); ++i) {
+    EXPECT_TRUE(almost_equal(sobol.next(), Eigen::VectorXd(expected.col(i))));
+  }
+  EXPECT_EQ(sobol.size(), 4);
+
+  // each of the first 2^k points, along each axis, is in a distinct
+  // interval of width 2^-k, when the origin is included
+  Index dim = config::SobolSequence::max_dim();
+  config::SobolSequence high(dim);
+  Index n = 64;
+  std::vector<std::set<Index>> intervals(dim, std::set<Index>({0}));
+  for (Index i = 1; i < n; ++i) {
+    Eigen::VectorXd u = high.next();
+    for (Index j = 0; j < dim; ++j) {
+      EXPECT_TRUE(u(j) >= 0.0 && u(j) < 1.0);
+      intervals[j].insert(Index(u(j) * n));
+    }
+  }
+  for (Index j = 0; j < dim; ++j) {
+    EXPECT_EQ(intervals[j].size(), n);
+  }
+  EXPECT_THROW(config::SobolSequence(dim + 1), std::runtime_error);
+}
+
+TEST_F(SimpleCubicGLstrainSamplingTest, Test1) {
+  ASSERT_TRUE(irreducible_wedge.size() > 0);
+  double stop = 0.1;
+  Index n_points = 20;
+  std::vector<Index> subwedge_indices;
+
+  for (auto method : {config::SubWedgeSamplingMethod::sobol,
+                      config::SubWedgeSamplingMethod::latin_hypercube,
+                      config::SubWedgeSamplingMethod::uniform}) {
+    // without trimming, n_points in each SubWedge
+    config::ConfigEnumSubWedgeSampling untrimmed(
+        background, *adapted_dof_space, irreducible_wedge, stop, n_points,
+        method, false);
+    Eigen::MatrixXd points = check_enumeration(untrimmed, subwedge_indices);
+    EXPECT_EQ(points.cols(), n_points * irreducible_wedge.size());
+    for (Index i = 0; i < points.cols(); ++i) {
+      EXPECT_EQ(subwedge_indices[i], i / n_points);
+    }
+
+    // with trimming, points are in the ellipsoid
+    config::ConfigEnumSubWedgeSampling trimmed(background, *adapted_dof_space,
+                                               irreducible_wedge, stop,
+                                               n_points, method);
+    points = check_enumeration(trimmed, subwedge_indices);
+    EXPECT_TRUE(points.cols() > 0);
+    EXPECT_TRUE(points.cols() <= n_points * irreducible_wedge.size());
+    for (Index i = 0; i < points.cols(); ++i) {
+      EXPECT_LE(points.col(i).norm(), stop + 1e-8);
+    }
+  }
+
+  // same seed, same points
+  auto method = config::SubWedgeSamplingMethod::uniform;
+  config::ConfigEnumSubWedgeSampling a(background, *adapted_dof_space,
+                                       irreducible_wedge, stop, n_points,
+                                       method, true, 1);
+  config::ConfigEnumSubWedgeSampling b(background, *adapted_dof_space,
+                                       irreducible_wedge, stop, n_points,
+                                       method, true, 1);
+  EXPECT_TRUE(almost_equal(check_enumeration(a, subwedge_indices),
+                           check_enumeration(b, subwedge_indices)));
+}
+
+TEST_F(SimpleCubicGLstrainSamplingTest, RefinementTest) {
+  double stop = 0.1;
+  std::vector<Index> subwedge_indices;
+  config::ConfigEnumSubWedgeSampling coarse(
+      background, *adapted_dof_space, irreducible_wedge, stop, 10,
+      config::SubWedgeSamplingMethod::sobol, false);
+  Eigen::MatrixXd coarse_points = check_enumeration(coarse, subwedge_indices);
+
+  // refine around two points
+  Eigen::MatrixXd centers(coarse_points.rows(), 2);
+  centers.col(0) = coarse_points.col(0);
+  centers.col(1) = coarse_points.col(coarse_points.cols() - 1);
+  std::vector<Index> center_subwedge_indices(
+      {subwedge_indices.front(), subwedge_indices.back()});
+  double half_width = 0.01;
+  std::vector<Index> n_points({5, 15});
+  config::ConfigEnumSubWedgeSampling refined(
+      background, *adapted_dof_space, irreducible_wedge, stop, centers,
+      center_subwedge_indices, half_width, n_points,
+      config::SubWedgeSamplingMethod::sobol, false);
+  ASSERT_EQ(refined.regions().size(), 2);
+  Eigen::MatrixXd points = check_enumeration(refined, subwedge_indices);
+  ASSERT_EQ(points.cols(), 20);
+
+  // points are near their center, in the center's SubWedge
+  for (Index i = 0; i < points.cols(); ++i) {
+    Index c = (i < 5) ? 0 : 1;
+    EXPECT_EQ(subwedge_indices[i], center_subwedge_indices[c]);
+    auto const &region = refined.regions()[c];
+    EXPECT_EQ(region.subwedge_index, center_subwedge_indices[c]);
+    EXPECT_TRUE((region.upper - region.lower).maxCoeff() <=
+                2 * half_width + 1e-8);
+  }
+
+  // sizes must match
+  std::vector<Index> wrong_size({5});
+  EXPECT_THROW(config::ConfigEnumSubWedgeSampling(
+                   background, *adapted_dof_space, irreducible_wedge, stop,
+                   centers, center_subwedge_indices, half_width, wrong_size),
+               std::runtime_error);
+}
@@ -0,0 +1,126 @@
+#include "casm/configuration/enumeration/ConfigurationFilter.hh"
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+std::shared_ptr<config::Supercell const> make_supercell(
+    std::shared_ptr<config::Prim const> const &prim, Index n) {
+  Eigen::Matrix3l T;
+  T << n, 0, 0, 0, n, 0, 0, 0, n;
+  return std::make_shared<config::Supercell const>(prim, T);
+}
+
+}  // namespace
+
+TEST(ConfigurationFilterTest, SupercellVolumeFilter) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  config::Configuration configuration(make_supercell(prim, 2));
+
+  config::SupercellVolumeFilter filter;
+  EXPECT_TRUE(filter(configuration));
+  filter.max_volume = 8;
+  EXPECT_TRUE(filter(configuration));
+  filter.min_volume = 9;
+  filter.max_volume = 27;
+  EXPECT_FALSE(filter(configuration));
+}
+
+TEST(ConfigurationFilterTest, SublatticeCompositionFilter) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  config::Configuration configuration(make_supercell(prim, 2));
+  configuration.dof_values.occupation(0) = 1;
+  configuration.dof_values.occupation(1) = 1;
+
+  // x_B = 0.25
+  config::SublatticeCompositionFilter filter;
+  filter.occupant_name = "B";
+  filter.min_fraction = 0.25;
+  filter.max_fraction = 0.5;
+  EXPECT_TRUE(filter(configuration));
+  filter.sublattice_indices = {0};
+  EXPECT_TRUE(filter(configuration));
+  filter.min_fraction = 0.3;
+  EXPECT_FALSE(filter(configuration));
+
+  // x_A = 0.75
+  filter.occupant_name = "A";
+  filter.min_fraction = 0.0;
+  filter.max_fraction = 0.5;
+  EXPECT_FALSE(filter(configuration));
+
+  // no sites
+  filter.sublattice_indices = {1};
+  EXPECT_THROW(filter(configuration), std::runtime_error);
+}
+
+TEST(ConfigurationFilterTest, OccupantCountFilter) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  auto supercell = make_supercell(prim, 2);
+  config::Configuration configuration(supercell);
+  configuration.dof_values.occupation(0) = 1;
+  configuration.dof_values.occupation(5) = 1;
+
+  config::OccupantCountConstraint constraint;
+  constraint.occupant_name = "B";
+  constraint.site_indices = {0, 1, 2, 3};
+  constraint.min_count = 1;
+  constraint.max_count = 1;
+  std::vector<config::OccupantCountConstraint> constraints({constraint});
+  config::OccupantCountFilter filter(supercell, constraints);
+  EXPECT_TRUE(filter(configuration));
+  configuration.dof_values.occupation(1) = 1;
+  EXPECT_FALSE(filter(configuration));
+
+  // other supercell
+  config::Configuration other(make_supercell(prim, 3));
+  EXPECT_THROW(filter(other), std::runtime_error);
+
+  // out of range
+  constraints[0].site_indices.insert(8);
+  EXPECT_THROW(config::OccupantCountFilter(supercell, constraints),
+               std::runtime_error);
+}
+
+TEST(ConfigurationFilterTest, ClusterCountFilter) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  clust::IntegralCluster pair({{0, 0, 0, 0}, {0, 1, 0, 0}});
+  std::set<clust::IntegralCluster> orbit = make_prim_periodic_orbit(
+      pair, prim->sym_info.unitcellcoord_symgroup_rep);
+  EXPECT_EQ(orbit.size(), 6);
+
+  // no periodic images of nearest neighbor pairs coincide in a 4x4x4
+  // supercell
+  auto supercell = make_supercell(prim, 4);
+  config::Configuration configuration(supercell);
+  auto const &converter = supercell->unitcellcoord_index_converter;
+  Index l0 = converter(xtal::UnitCellCoord(0, 0, 0, 0));
+  Index l1 = converter(xtal::UnitCellCoord(0, 1, 0, 0));
+
+  // no B-B nearest neighbor pairs
+  config::ClusterCountFilter none(orbit, "B", 0.0, 0.0);
+  EXPECT_TRUE(none(configuration));
+  configuration.dof_values.occupation(l0) = 1;
+  EXPECT_TRUE(none(configuration));
+  configuration.dof_values.occupation(l1) = 1;
+  EXPECT_FALSE(none(configuration));
+
+  // copies share the cluster sites
+  config::ClusterCountFilter one(orbit, "B", 1.0 / 64, 1.0 / 64);
+  config::ClusterCountFilter copy(one);
+  EXPECT_TRUE(one(configuration));
+  EXPECT_TRUE(copy(configuration));
+
+  // six pairs per unit cell
+  configuration.dof_values.occupation.setOnes();
+  EXPECT_TRUE(config::ClusterCountFilter(orbit, "B", 6.0, 6.0)(configuration));
+  EXPECT_FALSE(config::ClusterCountFilter(orbit, "B", 6.5)(configuration));
+  EXPECT_FALSE(config::ClusterCountFilter(orbit, "A", 1.0)(configuration));
+}
@@ -0,0 +1,320 @@
+#include "casm/configuration/enumeration/EnumerationPipeline.hh"
+
+#include <atomic>
+
+#include <fstream>
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/enumeration/BatchPrefetcher.hh"
+#include "casm/configuration/enumeration/BoundedQueue.hh"
+#include "casm/configuration/enumeration/ConfigEnumAllOccupations.hh"
+#include "casm/configuration/enumeration/ConfigEnumCanonicalOccupations.hh"
+#include "casm/configuration/enumeration/ConfigurationSink.hh"
+#include "casm/configuration/io/binary/ConfigurationSet_binary_io.hh"
+#include "casm/configuration/io/json/ConfigurationSet_jsonl_io.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+config::Configuration make_background() {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  return config::Configuration(supercell);
+}
+
+std::set<Index> all_sites(config::Configuration const &background) {
+  std::set<Index> sites;
+  for (Index l = 0; l < background.dof_values.occupation.size(); ++l) {
+    sites.insert(l);
+  }
+  return sites;
+}
+
+bool has_three_B(config::Configuration const &configuration) {
+  return configuration.dof_values.occupation.sum() == 3;
+}
+
+}  // namespace
+
+TEST(EnumerationPipelineTest, Test1) {
+  config::Configuration background = make_background();
+  std::set<Index> sites = all_sites(background);
+  auto canonicalize = config::make_canonical_form_transform();
+
+  // serial
+  config::ConfigurationSet expected;
+  config::ConfigEnumAllOccupations serial_enumerator(background, sites);
+  while (serial_enumerator.is_valid()) {
+    config::Configuration configuration = serial_enumerator.value();
+    canonicalize(configuration);
+    if (has_three_B(configuration)) {
+      expected.insert(configuration);
+    }
+    serial_enumerator.advance();
+  }
+  EXPECT_FALSE(expected.empty());
+
+  // pipeline: same configurations, in the same order, for any number of
+  // threads
+  for (Index n_threads : {1, 2, 4}) {
+    config::EnumerationPipelineOptions options;
+    options.batch_size = 7;
+    options.queue_capacity = 1;
+    options.n_transform_threads = n_threads;
+    options.n_filter_threads = n_threads;
+
+    config::ConfigEnumAllOccupations enumerator(background, sites);
+    std::vector<config::Configuration> accepted;
+    config::ConfigurationSet configurations;
+    config::EnumerationPipelineStats stats = config::run_enumeration_pipeline(
+        config::make_enumeration_source(enumerator), canonicalize,
+        has_three_B,
+        [&](std::vector<config::Configuration> &batch) {
+          for (auto const &configuration : batch) {
+            accepted.push_back(configuration);
+            configurations.insert(configuration);
+          }
+        },
+        options);
+    EXPECT_EQ(stats.n_enumerated, 256);
+    EXPECT_EQ(stats.n_batches, (256 + 6) / 7);
+    EXPECT_EQ(stats.n_accepted, 56);
+    EXPECT_EQ(accepted.size(), 56);
+    ASSERT_EQ(configurations.size(), expected.size());
+    auto it = configurations.begin();
+    for (auto const &record : expected) {
+      EXPECT_EQ(it->configuration_name, record.configuration_name);
+      EXPECT_EQ(it->configuration, record.configuration);
+      ++it;
+    }
+  }
+
+  // no transform or filter
+  config::ConfigEnumAllOccupations enumerator(background, sites);
+  config::EnumerationPipelineStats stats = config::run_enumeration_pipeline(
+      config::make_enumeration_source(enumerator), nullptr, nullptr,
+      nullptr);
+  EXPECT_EQ(stats.n_enumerated, 256);
+  EXPECT_EQ(stats.n_accepted, 256);
+}
+
+TEST(EnumerationPipelineTest, ErrorTest) {
+  config::Configuration background = make_background();
+  std::set<Index> sites = all_sites(background);
+  config::EnumerationPipelineOptions options;
+  options.batch_size = 3;
+  options.n_filter_threads = 2;
+
+  std::atomic<Index> n_calls(0);
+  auto throwing_filter = [&](config::Configuration const &configuration) {
+    if (++n_calls == 100) {
+      throw std::runtime_error("filter error");
+    }
+    return true;
+  };
+  config::ConfigEnumAllOccupations enumerator(background, sites);
+  EXPECT_THROW(config::run_enumeration_pipeline(
+                   config::make_enumeration_source(enumerator), nullptr,
+                   throwing_filter, nullptr, options),
+               std::runtime_error);
+
+  auto throwing_sink = [](std::vector<config::Configuration> &batch) {
+    throw std::runtime_error("sink error");
+  };
+  config::ConfigEnumAllOccupations enumerator_2(background, sites);
+  EXPECT_THROW(config::run_enumeration_pipeline(
+                   config::make_enumeration_source(enumerator_2), nullptr,
+                   nullptr, throwing_sink, options),
+               std::runtime_error);
+}
+
+TEST(EnumerationPipelineTest, SinkTest) {
+  config::Configuration background = make_background();
+  std::set<Index> sites = all_sites(background);
+  auto const &supercell = background.supercell;
+
+  // 3 "B" amongst all sites, canonical
+  config::OccupantCountConstraint constraint;
+  constraint.occupant_name = "B";
+  constraint.site_indices = sites;
+  constraint.min_count = constraint.max_count = 3;
+  config::ConfigurationPredicate filter = config::make_all_of_predicate(
+      {config::make_occupant_count_predicate(supercell, {constraint}),
+       config::make_is_canonical_predicate()});
+
+  config::ConfigurationSet expected;
+  config::ConfigEnumAllOccupations serial_enumerator(background, sites);
+  while (serial_enumerator.is_valid()) {
+    if (has_three_B(serial_enumerator.value()) &&
+        is_canonical(serial_enumerator.value(),
+                     config::SupercellSymOp::begin(supercell),
+                     config::SupercellSymOp::end(supercell))) {
+      expected.insert(serial_enumerator.value());
+    }
+    serial_enumerator.advance();
+  }
+  EXPECT_FALSE(expected.empty());
+
+  config::EnumerationPipelineOptions options;
+  options.batch_size = 10;
+  options.n_filter_threads = 2;
+  auto check = [&](config::ConfigurationSet const &configurations) {
+    ASSERT_EQ(configurations.size(), expected.size());
+    auto it = configurations.begin();
+    for (auto const &record : expected) {
+      EXPECT_EQ(it->configuration_name, record.configuration_name);
+      EXPECT_EQ(it->configuration, record.configuration);
+      ++it;
+    }
+  };
+
+  // ConfigurationSet
+  {
+    config::ConfigEnumAllOccupations enumerator(background, sites);
+    config::ConfigurationSet configurations;
+    config::ConfigurationSetSink sink(configurations);
+    config::run_enumeration_pipeline(
+        config::make_enumeration_source(enumerator), nullptr, filter, sink,
+        options);
+    EXPECT_EQ(sink.size(), expected.size());
+    check(configurations);
+  }
+
+  // JSON Lines
+  fs::path path = fs::temp_directory_path() / "casm_ConfigurationSink.jsonl";
+  {
+    config::ConfigEnumAllOccupations enumerator(background, sites);
+    config::JsonLinesConfigurationSink sink(path);
+    config::run_enumeration_pipeline(
+        config::make_enumeration_source(enumerator), nullptr, filter, sink,
+        options);
+    EXPECT_EQ(sink.size(), expected.size());
+    EXPECT_EQ(sink.next_config_id(), expected.next_config_id());
+
+    std::ifstream in(path);
+    config::SupercellSet supercells(supercell->prim);
+    config::ConfigurationSet configurations;
+    ConfigurationJsonLinesReader reader(in, supercells);
+    while (auto record = reader.read()) {
+      configurations.insert(*record);
+    }
+    check(configurations);
+  }
+  fs::remove(path);
+
+  // binary
+  path = fs::temp_directory_path() / "casm_ConfigurationSink.bin";
+  {
+    config::ConfigEnumAllOccupations enumerator(background, sites);
+    config::BinaryConfigurationSink sink(path, true, 4);
+    config::run_enumeration_pipeline(
+        config::make_enumeration_source(enumerator), nullptr, filter, sink,
+        options);
+    EXPECT_EQ(sink.size(), expected.size());
+
+    std::ifstream in(path, std::ios::binary);
+    config::SupercellSet supercells(supercell->prim);
+    config::ConfigurationSet configurations;
+    read_binary(supercells, configurations, in);
+    check(configurations);
+    EXPECT_EQ(configurations.next_config_id(), expected.next_config_id());
+  }
+  fs::remove(path);
+
+  // primitive predicate
+  auto is_primitive = config::make_is_primitive_predicate();
+  EXPECT_FALSE(is_primitive(background));
+  config::Configuration one_B = background;
+  one_B.dof_values.occupation(0) = 1;
+  EXPECT_TRUE(is_primitive(one_B));
+}
+
+TEST(BoundedQueueTest, Test1) {
+  config::BoundedQueue<Index> queue(2);
+  EXPECT_TRUE(queue.push(1));
+  EXPECT_TRUE(queue.push(2));
+  queue.close();
+  EXPECT_FALSE(queue.push(3));
+  Index value = -1;
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(BatchPrefetcherTest, Test1) {
+  auto background = make_background();
+  std::set<Index> sites = all_sites(background);
+  std::vector<config::Configuration> expected =
+      config::ConfigEnumAllOccupations(background, sites).next_batch(1000);
+
+  // batches are returned in order, no more than n_batches_ahead are
+  // produced ahead of the consumer
+  config::ConfigEnumAllOccupations enumerator(background, sites);
+  std::atomic<Index> n_produced(0);
+  config::BatchPrefetcher<std::vector<config::Configuration>> prefetcher(
+      [&](std::vector<config::Configuration> &batch) {
+        if (!enumerator.is_valid()) {
+          return false;
+        }
+        batch = enumerator.next_batch(10);
+        ++n_produced;
+        return true;
+      },
+      2);
+  EXPECT_EQ(prefetcher.n_batches_ahead(), 2);
+  std::vector<config::Configuration> batch;
+  std::vector<config::Configuration> found;
+  Index n_taken = 0;
+  while (prefetcher.next(batch)) {
+    ++n_taken;
+    // n_batches_ahead in the queue, plus one in progress
+    EXPECT_LE(n_produced.load(), n_taken + 3);
+    found.insert(found.end(), batch.begin(), batch.end());
+  }
+  EXPECT_EQ(n_taken, 26);
+  EXPECT_EQ(found, expected);
+  EXPECT_FALSE(prefetcher.next(batch));
+}
+
+TEST(BatchPrefetcherTest, ErrorTest) {
+  // batches produced before an error are returned first
+  Index n = 0;
+  config::BatchPrefetcher<Index> prefetcher(
+      [&](Index &batch) {
+        if (n == 3) {
+          throw std::runtime_error("test error");
+        }
+        batch = n++;
+        return true;
+      },
+      1);
+  Index batch = -1;
+  for (Index i = 0; i < 3; ++i) {
+    EXPECT_TRUE(prefetcher.next(batch));
+    EXPECT_EQ(batch, i);
+  }
+  EXPECT_THROW(prefetcher.next(batch), std::runtime_error);
+  EXPECT_FALSE(prefetcher.next(batch));
+
+  // stop an unbounded producer
+  config::BatchPrefetcher<Index> unbounded(
+      [](Index &batch) {
+        batch = 0;
+        return true;
+      },
+      4);
+  EXPECT_TRUE(unbounded.next(batch));
+  unbounded.stop();
+  EXPECT_FALSE(unbounded.next(batch));
+}
@@ -0,0 +1,113 @@
+#include "casm/configuration/enumeration/LocalCanonicalKey.hh"
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/enumeration/OccEventInfo.hh"
+#include "casm/configuration/enumeration/background_configuration.hh"
+#include "casm/configuration/occ_events/OccSystem.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+class FCCBinaryLocalCanonicalKeyTest : public testing::Test {
+ protected:
+  FCCBinaryLocalCanonicalKeyTest() {
+    auto basicstructure =
+        std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+    prim = std::make_shared<config::Prim>(basicstructure);
+    system = std::make_shared<occ_events::OccSystem>(
+        prim->basicstructure,
+        occ_events::make_chemical_name_list(
+            *prim->basicstructure, prim->sym_info.factor_group->element));
+  }
+
+  std::shared_ptr<config::Prim const> prim;
+  std::shared_ptr<occ_events::OccSystem> system;
+};
+
+TEST_F(FCCBinaryLocalCanonicalKeyTest, Test1) {
+  using namespace config;
+  using namespace occ_events;
+
+  // sites at origin and xy-face center
+  OccEvent event(
+      {OccTrajectory({system->make_atom_position({0, 0, 0, 0}, "A", 0),
+                      system->make_atom_position({0, 0, 0, 1}, "B", 0)}),
+       OccTrajectory({system->make_atom_position({0, 0, 0, 1}, "B", 0),
+                      system->make_atom_position({0, 0, 0, 0}, "A", 0)})});
+  auto event_prim_info = std::make_shared<OccEventPrimInfo>(prim, event);
+
+  Eigen::Matrix3d L;
+  L.col(0) << 8., 0., 0.;
+  L.col(1) << 0., 8., 0.;
+  L.col(2) << 0., 0., 8.;
+  auto supercell = std::make_shared<Supercell const>(prim, xtal::Lattice(L));
+  OccEventSupercellInfo info(event_prim_info, supercell);
+  auto const &event_group = info.supercellsymop_symgroup_rep;
+
+  LocalCanonicalKey all_sites_key(supercell, info.sites, info.occ_init,
+                                  info.occ_final, event_group);
+  EXPECT_EQ(all_sites_key.ordered_sites().size(), 32);
+  EXPECT_EQ(all_sites_key.n_neighborhood_sites(), 32);
+  EXPECT_TRUE(all_sites_key.is_complete());
+
+  // event sites first, then non-decreasing distance
+  auto const &distances = all_sites_key.ordered_distances();
+  EXPECT_NEAR(distances[0], 0.0, TOL);
+  EXPECT_NEAR(distances[1], 0.0, TOL);
+  for (Index i = 1; i < distances.size(); ++i) {
+    EXPECT_LE(distances[i - 1], distances[i] + TOL);
+  }
+
+  std::set<Index> neighborhood;
+  for (Index i = 0; i < distances.size(); ++i) {
+    if (distances[i] < 3.0) {
+      neighborhood.insert(all_sites_key.ordered_sites()[i]);
+    }
+  }
+  LocalCanonicalKey local_key(supercell, info.sites, info.occ_init,
+                              info.occ_final, event_group, neighborhood);
+  EXPECT_EQ(local_key.n_neighborhood_sites(), neighborhood.size());
+  EXPECT_LT(local_key.n_neighborhood_sites(), 32);
+
+  std::vector<Configuration> configurations;
+  for (Index i = 0; i < 12; ++i) {
+    Configuration configuration(supercell);
+    for (Index l = 0; l < 32; ++l) {
+      configuration.dof_values.occupation(l) = ((7 * l + 3 * i) % 5 < 2);
+    }
+    configurations.push_back(configuration);
+  }
+
+  // equivalents have equal keys
+  for (auto const &configuration : configurations) {
+    std::vector<int> key = local_key.key(configuration);
+    std::vector<int> neighborhood_key =
+        local_key.neighborhood_key(configuration);
+    EXPECT_EQ(neighborhood_key.size(), local_key.n_neighborhood_sites());
+    for (auto const &op : event_group) {
+      Configuration equivalent = copy_apply(op, configuration);
+      EXPECT_EQ(local_key.key(equivalent), key);
+      EXPECT_EQ(local_key.neighborhood_key(equivalent), neighborhood_key);
+      EXPECT_TRUE(local_key.is_equivalent(configuration, equivalent));
+    }
+  }
+
+  // agrees with comparing canonical forms
+  for (auto const &A : configurations) {
+    Configuration canonical_A = make_canonical_form(
+        A, info.sites, info.occ_init, info.occ_final, event_group);
+    for (auto const &B : configurations) {
+      Configuration canonical_B = make_canonical_form(
+          B, info.sites, info.occ_init, info.occ_final, event_group);
+      bool expected = (canonical_A == canonical_B);
+      EXPECT_EQ(local_key.is_equivalent(A, B), expected);
+      EXPECT_EQ(all_sites_key.is_equivalent(A, B), expected);
+      std::vector<int> key_A = all_sites_key.key(A);
+      EXPECT_EQ(all_sites_key.key(B) == key_A, expected);
+    }
+  }
+}
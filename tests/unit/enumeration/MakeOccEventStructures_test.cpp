@@ -6,6 +6,7 @@
 #include "casm/crystallography/BasicStructure.hh"
 #include "casm/crystallography/SimpleStructure.hh"
 #include "casm/crystallography/io/SimpleStructureIO.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
 #include "gtest/gtest.h"
 #include "teststructures.hh"
 
@@ -85,3 +86,62 @@ TEST_F(MakeOccEventStructuresTest, Test1) {
     EXPECT_EQ(structure.atom_info.size(), 2);
   }
 }
+
+// batch images match MakeOccEventStructures
+TEST_F(MakeOccEventStructuresTest, Test2) {
+  using namespace clust;
+  using namespace config;
+  using namespace occ_events;
+
+  // events: 1NN A-Va exchange, and the equivalent B-Va exchange
+  std::vector<OccEvent> events(
+      {OccEvent(
+           {OccTrajectory({system->make_atom_position({0, 0, 0, 0}, "A", 0),
+                           system->make_atom_position({0, 0, 0, -1}, "A", 0)}),
+            OccTrajectory(
+                {system->make_atom_position({0, 0, 0, -1}, "Va", 0),
+                 system->make_atom_position({0, 0, 0, 0}, "Va", 0)})}),
+       OccEvent(
+           {OccTrajectory({system->make_atom_position({0, 0, 0, 0}, "B", 0),
+                           system->make_atom_position({0, 1, 0, 0}, "B", 0)}),
+            OccTrajectory(
+                {system->make_atom_position({0, 1, 0, 0}, "Va", 0),
+                 system->make_atom_position({0, 0, 0, 0}, "Va", 0)})})});
+
+  // configuration: conventional 4-site FCC, with one B
+  Eigen::Matrix3d L;
+  L.col(0) << 4., 0., 0.;
+  L.col(1) << 0., 4., 0.;
+  L.col(2) << 0., 0., 4.;
+  auto supercell = std::make_shared<Supercell const>(prim, xtal::Lattice(L));
+  Configuration configuration(supercell);
+  configuration.dof_values.occupation << 0, 1, 0, 0;
+
+  std::vector<double> factors({0.0, 0.25, 0.5, 0.75, 1.0});
+  for (bool skip_event_occupants : {false, true}) {
+    MakeOccEventImages make_images(configuration, system,
+                                   skip_event_occupants);
+    OccEventImages images = make_images(events, factors);
+    ASSERT_EQ(images.n_events(), events.size());
+    EXPECT_EQ(images.n_images, factors.size());
+    for (Index e = 0; e < events.size(); ++e) {
+      MakeOccEventStructures f(configuration, events[e], system,
+                               skip_event_occupants);
+      for (Index k = 0; k < factors.size(); ++k) {
+        xtal::SimpleStructure structure = f(factors[k]);
+        ASSERT_EQ(images.n_atoms(e), structure.atom_info.size());
+        EXPECT_TRUE(almost_equal(images.lat_column_mat,
+                                 structure.lat_column_mat, 1e-10));
+        Eigen::MatrixXd coords =
+            images.coords.middleCols(images.image_begin(e, k),
+                                     images.n_atoms(e));
+        EXPECT_TRUE(almost_equal(coords, structure.atom_info.coords, 1e-10));
+        for (Index a = 0; a < images.n_atoms(e); ++a) {
+          Index c = images.atom_type(images.atom_offsets(e) + a);
+          EXPECT_EQ(system->chemical_name_list[c],
+                    structure.atom_info.names[a]);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,125 @@
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/enumeration/OccEventInfo.hh"
+#include "casm/configuration/enumeration/OrbitPartition.hh"
+#include "casm/configuration/occ_events/OccSystem.hh"
+#include "casm/configuration/occ_events/orbits.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+class FCCBinaryOccEventSupercellInfoCacheTest : public testing::Test {
+ protected:
+  FCCBinaryOccEventSupercellInfoCacheTest() {
+    auto basicstructure =
+        std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+    prim = std::make_shared<config::Prim>(basicstructure);
+    system = std::make_shared<occ_events::OccSystem>(
+        prim->basicstructure,
+        occ_events::make_chemical_name_list(
+            *prim->basicstructure, prim->sym_info.factor_group->element));
+  }
+
+  /// \brief Check cached data against data constructed directly, for every
+  ///     equivalent of `event`, and a translation of each, and return the
+  ///     number of events checked
+  Index check(occ_events::OccEvent const &event,
+              std::shared_ptr<config::Supercell const> const &supercell,
+              std::set<clust::IntegralCluster> const &prototype_local_clusters,
+              Index &n_conjugated) {
+    using namespace config;
+    using namespace occ_events;
+    OccEventSupercellInfoCache cache(prim);
+    auto const &occevent_symgroup_rep =
+        *make_shared_occevent_symgroup_rep(prim);
+    std::set<OccEvent> orbit =
+        make_prim_periodic_orbit(event, occevent_symgroup_rep);
+
+    std::vector<OccEvent> events;
+    for (auto const &equivalent : orbit) {
+      events.push_back(equivalent);
+      events.push_back(equivalent);
+      events.back() += xtal::UnitCell(1, 0, 0);
+    }
+    for (auto const &e : events) {
+      auto info = cache.supercell_info(e, supercell);
+      EXPECT_EQ(info, cache.supercell_info(e, supercell));
+
+      OccEventSupercellInfo expected(
+          std::make_shared<OccEventPrimInfo const>(prim, e), supercell);
+      EXPECT_EQ(info->sites, expected.sites);
+      EXPECT_EQ(info->occ_init, expected.occ_init);
+      EXPECT_EQ(info->occ_final, expected.occ_final);
+      EXPECT_EQ(info->supercellsymop_symgroup_rep,
+                expected.supercellsymop_symgroup_rep);
+      if (cache.prototype_op(e, supercell).has_value()) {
+        ++n_conjugated;
+      }
+
+      // local orbits are closed under the event group
+      auto table = cache.local_orbit_site_table(e, supercell,
+                                                prototype_local_clusters);
+      EXPECT_GT(table->n_orbits(), 0);
+      auto indices_rep = make_indices_group_rep(
+          expected.supercellsymop_symgroup_rep);
+      for (Index o = 0; o < table->n_orbits(); ++o) {
+        std::vector<SiteSet> clusters;
+        for (Index r = table->orbit_offsets[o];
+             r < table->orbit_offsets[o + 1]; ++r) {
+          clusters.emplace_back(table->cluster_begin(r),
+                                table->cluster_end(r));
+        }
+        EXPECT_NO_THROW(make_cluster_orbit_generators(clusters, indices_rep));
+      }
+    }
+
+    // prototype table is the same as constructing directly
+    auto prototype_info = cache.prototype_prim_info(event);
+    auto table = cache.local_orbit_site_table(prototype_info->event, supercell,
+                                              prototype_local_clusters);
+    SupercellOrbitSiteTable expected_table(
+        supercell,
+        prototype_info->make_local_orbits(prototype_local_clusters), false);
+    EXPECT_EQ(table->sites, expected_table.sites);
+    EXPECT_EQ(table->orbit_offsets, expected_table.orbit_offsets);
+    return events.size();
+  }
+
+  std::shared_ptr<config::Prim const> prim;
+  std::shared_ptr<occ_events::OccSystem> system;
+};
+
+TEST_F(FCCBinaryOccEventSupercellInfoCacheTest, Test1) {
+  using namespace clust;
+  using namespace config;
+  using namespace occ_events;
+
+  // sites at origin and xy-face center
+  OccEvent event(
+      {OccTrajectory({system->make_atom_position({0, 0, 0, 0}, "A", 0),
+                      system->make_atom_position({0, 0, 0, 1}, "B", 0)}),
+       OccTrajectory({system->make_atom_position({0, 0, 0, 1}, "B", 0),
+                      system->make_atom_position({0, 0, 0, 0}, "A", 0)})});
+  std::set<IntegralCluster> local_clusters(
+      {IntegralCluster({{0, 1, 0, 0}}), IntegralCluster({{0, -1, 1, 1}})});
+
+  // cubic supercell: every equivalent is related to the prototype by a
+  // supercell operation
+  Eigen::Matrix3d L;
+  L.col(0) << 8., 0., 0.;
+  L.col(1) << 0., 8., 0.;
+  L.col(2) << 0., 0., 8.;
+  auto cubic = std::make_shared<Supercell const>(prim, xtal::Lattice(L));
+  Index n_conjugated = 0;
+  Index n_events = check(event, cubic, local_clusters, n_conjugated);
+  EXPECT_EQ(n_conjugated, n_events);
+
+  // tetragonal supercell: some equivalents are made directly
+  L.col(2) << 0., 0., 4.;
+  auto tetragonal = std::make_shared<Supercell const>(prim, xtal::Lattice(L));
+  n_conjugated = 0;
+  n_events = check(event, tetragonal, local_clusters, n_conjugated);
+  EXPECT_GT(n_conjugated, 0);
+  EXPECT_LT(n_conjugated, n_events);
+}
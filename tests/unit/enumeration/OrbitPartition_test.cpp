@@ -0,0 +1,111 @@
+#include "casm/configuration/enumeration/OrbitPartition.hh"
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/clusterography/orbits.hh"
+#include "casm/configuration/group/orbits.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(DisjointSetsTest, Test1) {
+  config::DisjointSets sets(6);
+  EXPECT_EQ(sets.n_sets(), 6);
+  EXPECT_TRUE(sets.join(0, 3));
+  EXPECT_TRUE(sets.join(3, 5));
+  EXPECT_FALSE(sets.join(5, 0));
+  EXPECT_TRUE(sets.join(1, 2));
+  EXPECT_EQ(sets.n_sets(), 3);
+  EXPECT_EQ(sets.find(0), sets.find(5));
+  EXPECT_EQ(sets.find(1), sets.find(2));
+  EXPECT_NE(sets.find(0), sets.find(1));
+  EXPECT_NE(sets.find(4), sets.find(1));
+}
+
+TEST(OrbitPartitionTest, Test1) {
+  using namespace config;
+  auto basicstructure =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+  auto prim = std::make_shared<Prim const>(basicstructure);
+
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto supercell = std::make_shared<Supercell const>(prim, T);
+  auto begin = SupercellSymOp::begin(supercell);
+  auto end = SupercellSymOp::end(supercell);
+  std::vector<SupercellSymOp> supercell_group(begin, end);
+
+  // all sites are equivalent under the supercell group
+  EXPECT_EQ(make_site_orbits(supercell_group).size(), 1);
+
+  // background with a lower symmetry
+  Configuration background(supercell);
+  background.dof_values.occupation(0) = 1;
+  background.dof_values.occupation(1) = 1;
+  std::vector<SupercellSymOp> background_group =
+      make_invariant_subgroup(background, begin, end);
+  std::vector<sym_info::Permutation> indices_rep =
+      make_indices_group_rep(background_group);
+
+  // site orbits match orbits made by applying every operation
+  std::set<std::set<Index>> expected_site_orbits;
+  for (Index l = 0; l < background.dof_values.occupation.size(); ++l) {
+    std::set<Index> orbit;
+    for (auto const &perm : indices_rep) {
+      orbit.insert(perm[l]);
+    }
+    expected_site_orbits.insert(orbit);
+  }
+  std::set<std::set<Index>> site_orbits;
+  for (auto const &orbit : make_site_orbits(background_group)) {
+    site_orbits.emplace(orbit.begin(), orbit.end());
+  }
+  EXPECT_EQ(site_orbits, expected_site_orbits);
+
+  // pair clusters, closed under the supercell group
+  clust::IntegralCluster pair(
+      {xtal::UnitCellCoord(0, 0, 0, 0), xtal::UnitCellCoord(0, 1, 0, 0)});
+  auto orbit = clust::make_prim_periodic_orbit(
+      pair, prim->sym_info.unitcellcoord_symgroup_rep);
+  auto orbits_as_indices = clust::make_orbits_as_indices(
+      {orbit}, supercell->unitcellcoord_index_converter);
+  std::vector<sym_info::Permutation> supercell_indices_rep =
+      make_indices_group_rep(supercell_group);
+  std::set<std::set<Index>> clusters;
+  for (auto const &cluster : orbits_as_indices[0]) {
+    for (auto const &perm : supercell_indices_rep) {
+      std::set<Index> image;
+      for (Index l : cluster) {
+        image.insert(perm[l]);
+      }
+      clusters.insert(image);
+    }
+  }
+
+  // generators match group::make_orbit_generators using every operation
+  auto copy_apply_f = [](sym_info::Permutation const &perm,
+                         std::set<Index> const &cluster) {
+    std::set<Index> image;
+    for (Index l : cluster) {
+      image.insert(perm[l]);
+    }
+    return image;
+  };
+  auto expected = group::make_orbit_generators(
+      clusters, indices_rep.begin(), indices_rep.end(),
+      std::less<std::set<Index>>(), copy_apply_f);
+  std::set<std::set<Index>> generators =
+      make_cluster_orbit_generators(clusters, background_group);
+  EXPECT_EQ(generators,
+            std::set<std::set<Index>>(expected.begin(), expected.end()));
+  EXPECT_GT(generators.size(), 1);
+
+  // clusters must be closed under the group
+  std::set<std::set<Index>> not_closed = {*clusters.begin()};
+  EXPECT_THROW(make_cluster_orbit_generators(not_closed, supercell_group),
+               std::runtime_error);
+}
@@ -0,0 +1,91 @@
+#include "casm/configuration/enumeration/ScelEnum.hh"
+
+#include <set>
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// Return the canonical transformation matrices of all supercells visited
+std::vector<Eigen::Matrix3l> enumerate_T(config::ScelEnum &enumerator) {
+  std::vector<Eigen::Matrix3l> result;
+  while (enumerator.is_valid()) {
+    EXPECT_EQ(enumerator.hermite_normal_form().determinant(),
+              enumerator.volume());
+    result.push_back(enumerator.transformation_matrix_to_super());
+    enumerator.advance();
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(ScelEnumTest, FCC) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+
+  // distinct superlattices by volume: 1, 2, 3, 7, 5, 10, 7, 20
+  std::vector<Index> expected = {1, 2, 3, 7, 5, 10, 7, 20};
+  for (Index volume = 1; volume <= expected.size(); ++volume) {
+    config::ScelEnum enumerator(prim, volume, volume);
+    EXPECT_EQ(enumerate_T(enumerator).size(), expected[volume - 1]);
+  }
+
+  config::ScelEnum enumerator(prim, 1, 4);
+  std::set<std::shared_ptr<config::Supercell const>,
+           config::CompareSharedSupercell>
+      supercells;
+  while (enumerator.is_valid()) {
+    auto const &supercell = enumerator.value();
+    EXPECT_TRUE(config::is_canonical(*supercell));
+    EXPECT_EQ(supercell->superlattice.transformation_matrix_to_super(),
+              enumerator.transformation_matrix_to_super());
+    supercells.insert(supercell);
+    enumerator.advance();
+  }
+  EXPECT_EQ(supercells.size(), 13);
+}
+
+TEST(ScelEnumTest, Options) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+
+  config::ScelEnum diagonal(prim, 1, 4, "abc", std::nullopt, true);
+  EXPECT_EQ(enumerate_T(diagonal).size(), 5);
+
+  config::ScelEnum fixed_shape(prim, 1, 10, "abc", std::nullopt, true, true);
+  EXPECT_EQ(enumerate_T(fixed_shape).size(), 2);
+
+  Eigen::Matrix3l unit_cell;
+  unit_cell << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  config::ScelEnum with_unit_cell(prim, 1, 4, "abc", unit_cell);
+  EXPECT_EQ(enumerate_T(with_unit_cell).size(), 19);
+
+  config::ScelEnum one_dir(prim, 1, 6, "a");
+  EXPECT_EQ(enumerate_T(one_dir).size(), 6);
+
+  EXPECT_THROW(config::ScelEnum(prim, 0, 4), std::runtime_error);
+  EXPECT_THROW(config::ScelEnum(prim, 1, 4, "abd"), std::runtime_error);
+}
+
+TEST(ScelEnumTest, Shards) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  config::ScelEnum enumerator(prim, 1, 6);
+  std::vector<Eigen::Matrix3l> all = enumerate_T(enumerator);
+
+  Index n_shards = 3;
+  std::vector<Eigen::Matrix3l> combined(all.size());
+  for (Index shard_index = 0; shard_index < n_shards; ++shard_index) {
+    config::ScelEnum shard(prim, 1, 6, "abc", std::nullopt, false, false,
+                           shard_index, n_shards);
+    std::vector<Eigen::Matrix3l> values = enumerate_T(shard);
+    for (Index i = 0; i < values.size(); ++i) {
+      combined[i * n_shards + shard_index] = values[i];
+    }
+  }
+  EXPECT_EQ(combined, all);
+}
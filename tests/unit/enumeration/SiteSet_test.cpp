@@ -0,0 +1,67 @@
+#include "casm/configuration/enumeration/SiteSet.hh"
+
+#include <unordered_set>
+
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+TEST(SiteSetTest, Test1) {
+  std::set<Index> sites = {5, 1, 3};
+  config::SiteSet site_set(sites);
+  EXPECT_EQ(site_set.size(), 3);
+  EXPECT_EQ(site_set.to_set(), sites);
+  EXPECT_EQ(std::vector<Index>(site_set.begin(), site_set.end()),
+            std::vector<Index>({1, 3, 5}));
+
+  // permutation images are sorted
+  // 1 -> 4, 3 -> 3, 5 -> 1
+  sym_info::Permutation perm = {0, 4, 2, 3, 5, 1};
+  config::SiteSet image = config::copy_apply(perm, site_set);
+  EXPECT_EQ(std::vector<Index>(image.begin(), image.end()),
+            std::vector<Index>({1, 3, 4}));
+}
+
+TEST(SiteSetTest, CompareTest) {
+  // comparison is the same as for std::set<Index>
+  std::vector<std::set<Index>> sets = {{}, {0}, {0, 1}, {0, 2}, {1},
+                                       {1, 2, 3}, {2}};
+  for (auto const &A : sets) {
+    for (auto const &B : sets) {
+      EXPECT_EQ(config::SiteSet(A) < config::SiteSet(B), A < B);
+      EXPECT_EQ(config::SiteSet(A) == config::SiteSet(B), A == B);
+    }
+  }
+
+  std::unordered_set<config::SiteSet, config::SiteSetHash> unique;
+  for (auto const &A : sets) {
+    unique.emplace(A);
+    unique.emplace(A);
+  }
+  EXPECT_EQ(unique.size(), sets.size());
+}
+
+TEST(SiteSetTest, LargeSetTest) {
+  // sets larger than inline_capacity
+  std::set<Index> sites;
+  for (Index l = 0; l < 2 * config::SiteSet::inline_capacity; ++l) {
+    sites.insert(3 * l);
+  }
+  config::SiteSet site_set(sites);
+  EXPECT_EQ(site_set.to_set(), sites);
+
+  sym_info::Permutation perm(3 * sites.size());
+  for (Index l = 0; l < perm.size(); ++l) {
+    perm[l] = perm.size() - 1 - l;
+  }
+  config::SiteSet image = config::copy_apply(perm, site_set);
+  std::set<Index> expected;
+  for (Index l : sites) {
+    expected.insert(perm[l]);
+  }
+  EXPECT_EQ(image.to_set(), expected);
+
+  // re-assign a small set to the same storage
+  image.assign_permuted(perm, config::SiteSet(std::set<Index>({0, 1})));
+  EXPECT_EQ(image.to_set(), std::set<Index>({perm[1], perm[0]}));
+}
@@ -0,0 +1,97 @@
+#include "casm/configuration/enumeration/SupercellOccEventTable.hh"
+
+#include <algorithm>
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/occ_events/OccEvent.hh"
+#include "casm/configuration/occ_events/OccEventRep.hh"
+#include "casm/configuration/occ_events/OccSystem.hh"
+#include "casm/configuration/occ_events/orbits.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+class FCCBinarySupercellOccEventTableTest : public testing::Test {
+ protected:
+  FCCBinarySupercellOccEventTableTest() {
+    auto basicstructure =
+        std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+    prim = std::make_shared<config::Prim>(basicstructure);
+    system = std::make_shared<occ_events::OccSystem>(
+        prim->basicstructure,
+        occ_events::make_chemical_name_list(
+            *prim->basicstructure, prim->sym_info.factor_group->element));
+    occevent_symgroup_rep = occ_events::make_occevent_symgroup_rep(
+        prim->sym_info.factor_group->element, *prim->basicstructure);
+  }
+
+  std::shared_ptr<config::Prim const> prim;
+  std::shared_ptr<occ_events::OccSystem> system;
+  std::vector<occ_events::OccEventRep> occevent_symgroup_rep;
+};
+
+TEST_F(FCCBinarySupercellOccEventTableTest, Test1) {
+  using namespace occ_events;
+
+  // A-B exchange between nearest neighbors
+  OccEvent event(
+      {OccTrajectory({system->make_atom_position({0, 0, 0, 0}, "A", 0),
+                      system->make_atom_position({0, 1, 0, 0}, "A", 0)}),
+       OccTrajectory({system->make_atom_position({0, 1, 0, 0}, "B", 0),
+                      system->make_atom_position({0, 0, 0, 0}, "B", 0)})});
+  std::vector<std::set<OccEvent>> event_orbits(
+      {make_prim_periodic_orbit(event, occevent_symgroup_rep)});
+
+  Eigen::Matrix3l T;
+  T << 3, 0, 0, 0, 3, 0, 0, 0, 3;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto const &converter = supercell->unitcellcoord_index_converter;
+  Index n_sites = converter.total_sites();
+
+  config::SupercellOccEventTable table(supercell, event_orbits);
+  EXPECT_EQ(table.n_translations, 27);
+  EXPECT_EQ(table.n_orbits(), 1);
+  EXPECT_EQ(table.orbit_size(0), event_orbits[0].size());
+  EXPECT_EQ(table.n_events(), event_orbits[0].size() * 27);
+  EXPECT_EQ(table.site_event_offsets.size(), n_sites + 1);
+
+  // event sites and occupation
+  Index e = 0;
+  for (auto const &equiv : event_orbits[0]) {
+    auto cluster_occupation = make_cluster_occupation(equiv);
+    for (Index t = 0; t < table.n_translations; ++t) {
+      Index r = table.row(0, e, t);
+      EXPECT_EQ(table.orbit_index(r), 0);
+      ASSERT_EQ(table.event_size(r), 2);
+      xtal::UnitCell translation = supercell->unitcell_index_converter(t);
+      for (Index i = 0; i < 2; ++i) {
+        EXPECT_EQ(table.sites_begin(r)[i],
+                  converter(cluster_occupation.first[i] + translation));
+        EXPECT_EQ(table.occ_init_begin(r)[i], cluster_occupation.second[0][i]);
+        EXPECT_EQ(table.occ_final_begin(r)[i],
+                  cluster_occupation.second[1][i]);
+      }
+    }
+    ++e;
+  }
+
+  // events involving each site: each site has 12 nearest neighbors
+  for (Index l = 0; l < n_sites; ++l) {
+    std::vector<Index> expected;
+    for (Index r = 0; r < table.n_events(); ++r) {
+      if (std::find(table.sites_begin(r), table.sites_end(r), l) !=
+          table.sites_end(r)) {
+        expected.push_back(r);
+      }
+    }
+    std::vector<Index> site_events(table.site_events_begin(l),
+                                   table.site_events_end(l));
+    EXPECT_EQ(site_events, expected);
+    EXPECT_EQ(site_events.size(), 12);
+  }
+}
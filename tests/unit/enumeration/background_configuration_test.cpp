@@ -110,4 +110,9 @@ TEST_F(FCCBinaryBackgroundConfigurationTest, Test2) {
   //   std::cout << c.dof_values.occupation.transpose() << std::endl;
   // }
   EXPECT_EQ(backgrounds.size(), 2);
+
+  // result does not depend on the number of threads
+  std::set<Configuration> backgrounds_parallel =
+      event_supercell_info.make_distinct_background_configurations(motif, 4);
+  EXPECT_TRUE(backgrounds_parallel == backgrounds);
 }
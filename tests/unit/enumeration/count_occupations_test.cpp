@@ -0,0 +1,85 @@
+#include "casm/configuration/enumeration/count_occupations.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/enumeration/ConfigEnumAllOccupations.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Count canonical occupations by enumeration, by number of "B"
+std::map<Index, Index> enumerate_counts_by_n_B(
+    std::shared_ptr<config::Supercell const> const &supercell) {
+  config::Configuration background(supercell);
+  std::set<Index> sites;
+  for (Index l = 0; l < background.dof_values.occupation.size(); ++l) {
+    sites.insert(l);
+  }
+  std::vector<config::SupercellSymOp> group(
+      config::SupercellSymOp::begin(supercell),
+      config::SupercellSymOp::end(supercell));
+  config::ConfigEnumAllOccupations enumerator(background, sites, false,
+                                              group);
+  std::map<Index, Index> result;
+  while (enumerator.is_valid()) {
+    Eigen::VectorXi const &occ = enumerator.value().dof_values.occupation;
+    result[(occ.array() == 1).count()] += 1;
+    enumerator.advance();
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(CountOccupationsTest, FCCTernary) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity();
+  auto prim_supercell = std::make_shared<config::Supercell const>(prim, T);
+  EXPECT_EQ(config::count_distinct_occupations(prim_supercell), "3");
+
+  std::vector<Eigen::Matrix3l> T_list(2);
+  T_list[0] << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  T_list[1] << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  for (auto const &T_super : T_list) {
+    auto supercell = std::make_shared<config::Supercell const>(prim, T_super);
+    std::map<Index, Index> expected = enumerate_counts_by_n_B(supercell);
+    Index total = 0;
+    for (auto const &pair : expected) {
+      total += pair.second;
+    }
+    for (Index n_threads : {1, 3}) {
+      EXPECT_EQ(config::count_distinct_occupations(supercell, {}, n_threads),
+                std::to_string(total));
+      for (Index n_B = 0; n_B <= T_super.determinant(); ++n_B) {
+        EXPECT_EQ(
+            config::count_distinct_occupations(supercell, {{"B", n_B}},
+                                               n_threads),
+            std::to_string(expected[n_B]));
+      }
+    }
+  }
+
+  // fixed composition of all occupants
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  EXPECT_EQ(config::count_distinct_occupations(
+                supercell, {{"A", 2}, {"B", 1}, {"C", 1}}),
+            "1");
+  EXPECT_EQ(config::count_distinct_occupations(
+                supercell, {{"A", 2}, {"B", 2}, {"C", 1}}),
+            "0");
+}
+
+TEST(CountOccupationsTest, LargeCount) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_prim());
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 6;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  // 3^216 is larger than any fixed size integer
+  std::string count = config::count_distinct_occupations(supercell);
+  EXPECT_GT(count.size(), 90);
+}
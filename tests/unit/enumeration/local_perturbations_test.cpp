@@ -195,7 +195,7 @@ class FCCBinaryLocalPerturbationsTest : public testing::Test {
               << supercell->superlattice.superlattice().lat_column_mat()
               << std::endl;
     std::cout << "supercell factor group:" << std::endl;
-    print_group(*supercell->sym_info.factor_group,
+    print_group(*supercell->sym_info().factor_group,
                 prim->basicstructure->lattice());
     std::cout << std::endl;
 
@@ -258,6 +258,11 @@ class FCCBinaryLocalPerturbationsTest : public testing::Test {
 
     // check total number
     EXPECT_EQ(all.size(), expected_total_perturbations);
+
+    // check multi-threaded results are the same
+    EXPECT_EQ(event_supercell_info.make_all_distinct_local_perturbations(
+                  motif, local_clusters, 4),
+              all);
   }
 
   std::shared_ptr<config::Prim const> prim;
@@ -444,3 +449,37 @@ TEST_F(FCCBinaryLocalPerturbationsTest, Test4) {
                       expected_perturbations_by_background,
                       expected_total_perturbations);
 }
+
+// the OccEventRep symgroup rep is shared by prim, and matches a rep
+// constructed directly from the prim factor group
+TEST_F(FCCBinaryLocalPerturbationsTest, Test5) {
+  using namespace config;
+  using namespace occ_events;
+
+  auto rep = make_shared_occevent_symgroup_rep(prim);
+  EXPECT_EQ(rep, make_shared_occevent_symgroup_rep(prim));
+
+  auto expected = make_occevent_symgroup_rep(
+      prim->sym_info.factor_group->element, *prim->basicstructure);
+  ASSERT_EQ(rep->size(), expected.size());
+
+  OccEvent event(
+      {OccTrajectory({system->make_atom_position({0, 0, 0, 0}, "A", 0),
+                      system->make_atom_position({0, 1, 0, 0}, "A", 0)})});
+  for (Index i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(copy_apply(rep->at(i), event),
+              copy_apply(expected.at(i), event));
+  }
+
+  // a different prim does not share the rep
+  auto other_prim = std::make_shared<Prim const>(prim->basicstructure);
+  EXPECT_NE(make_shared_occevent_symgroup_rep(other_prim), rep);
+
+  OccEventPrimInfo event_prim_info(prim, event);
+  EXPECT_EQ(event_prim_info.occevent_symgroup_rep, rep);
+
+  // the prim's basicstructure and factor group share the rep
+  EXPECT_EQ(make_shared_occevent_symgroup_rep(prim->sym_info.factor_group,
+                                              prim->basicstructure),
+            rep);
+}
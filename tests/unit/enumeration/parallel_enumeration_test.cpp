@@ -0,0 +1,122 @@
+#include "casm/configuration/enumeration/parallel_enumeration.hh"
+
+#include <cmath>
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/enumeration/ConfigEnumCanonicalOccupations.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+std::vector<config::Configuration> make_backgrounds(
+    config::SupercellSet &supercells) {
+  std::vector<Eigen::Matrix3l> T_list(3);
+  T_list[0] << 1, 0, 0, 0, 1, 0, 0, 0, 1;
+  T_list[1] << 2, 0, 0, 0, 1, 0, 0, 0, 1;
+  T_list[2] << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+  std::vector<config::Configuration> backgrounds;
+  for (auto const &T : T_list) {
+    std::string name = supercells.insert(T).first->canonical_supercell_name;
+    backgrounds.emplace_back(
+        supercells.insert_canonical(name).first->supercell);
+  }
+  return backgrounds;
+}
+
+}  // namespace
+
+TEST(ParallelEnumerationTest, FCCBinary) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  config::SupercellSet supercells(prim);
+  std::vector<config::Configuration> backgrounds =
+      make_backgrounds(supercells);
+
+  // serial
+  std::vector<config::Configuration> expected;
+  for (auto const &background : backgrounds) {
+    auto const &supercell = background.supercell;
+    std::set<Index> sites;
+    for (Index l = 0; l < background.dof_values.occupation.size(); ++l) {
+      sites.insert(l);
+    }
+    auto group = make_invariant_subgroup(
+        background, sites, config::SupercellSymOp::begin(supercell),
+        config::SupercellSymOp::end(supercell));
+    config::ConfigEnumCanonicalOccupations enumerator(background, sites,
+                                                      group, true);
+    while (enumerator.is_valid()) {
+      expected.push_back(enumerator.value());
+      enumerator.advance();
+    }
+  }
+  EXPECT_FALSE(expected.empty());
+
+  // parallel: same configurations, in the same order
+  for (Index n_threads : {1, 2, 4}) {
+    EXPECT_EQ(config::make_occupations_parallel(backgrounds, true, true,
+                                                n_threads),
+              expected);
+  }
+
+  // not skipping non-canonical: all occupations
+  EXPECT_EQ(
+      config::make_occupations_parallel(backgrounds, false, false, 4).size(),
+      2 + 4 + 256);
+
+  // insertion gives the same names, regardless of the number of threads
+  config::ConfigurationSet serial_set;
+  config::insert_occupations_parallel(serial_set, backgrounds, true, true, 1);
+  config::ConfigurationSet parallel_set;
+  config::insert_occupations_parallel(parallel_set, backgrounds, true, true,
+                                      4);
+  ASSERT_EQ(serial_set.size(), parallel_set.size());
+  auto it = parallel_set.begin();
+  for (auto const &record : serial_set) {
+    EXPECT_EQ(record.configuration_name, it->configuration_name);
+    ++it;
+  }
+}
+
+TEST(ParallelEnumerationTest, Estimate) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  config::SupercellSet supercells(prim);
+  std::vector<config::Configuration> backgrounds =
+      make_backgrounds(supercells);
+
+  for (bool skip_non_primitive : {false, true}) {
+    // few enough tasks to enumerate all: exact counts
+    auto estimates = config::estimate_occupations_parallel(
+        backgrounds, skip_non_primitive, true, 16, 16.0);
+    ASSERT_EQ(estimates.size(), backgrounds.size());
+    for (Index b = 0; b < Index(backgrounds.size()); ++b) {
+      auto const &estimate = estimates[b];
+      Index n_sites = backgrounds[b].dof_values.occupation.size();
+      EXPECT_EQ(estimate.n_variable_sites, n_sites);
+      EXPECT_EQ(estimate.n_candidates, std::pow(2.0, n_sites));
+      EXPECT_GT(estimate.group_size, 0);
+      EXPECT_TRUE(estimate.n_configurations_is_exact);
+      Index expected =
+          config::make_occupations_parallel({backgrounds[b]},
+                                            skip_non_primitive, true)
+              .size();
+      EXPECT_EQ(estimate.n_configurations, double(expected));
+      EXPECT_GE(estimate.seconds, 0.0);
+      EXPECT_GT(estimate.bytes, 0.0);
+    }
+  }
+
+  // sampled: 2^8 candidates in 2^6 tasks, 4 sampled
+  auto estimates = config::estimate_occupations_parallel(
+      {backgrounds[2]}, true, true, 4, 4.0);
+  ASSERT_EQ(estimates.size(), 1);
+  EXPECT_EQ(estimates[0].n_tasks, 64.0);
+  EXPECT_EQ(estimates[0].n_sampled_tasks, 4);
+  EXPECT_FALSE(estimates[0].n_configurations_is_exact);
+  EXPECT_LE(estimates[0].n_configurations, 256.0);
+}
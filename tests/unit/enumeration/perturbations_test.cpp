@@ -4,6 +4,8 @@
 #include "casm/configuration/clusterography/IntegralCluster.hh"
 #include "casm/configuration/clusterography/orbits.hh"
 #include "casm/configuration/copy_configuration.hh"
+#include "casm/configuration/enumeration/ExternalConfigurationSet.hh"
+#include "casm/configuration/enumeration/SupercellOrbitSiteTable.hh"
 #include "casm/crystallography/BasicStructure.hh"
 #include "casm/crystallography/UnitCellCoord.hh"
 #include "gtest/gtest.h"
@@ -242,4 +244,129 @@ TEST_F(FCCBinaryPerturbationsTest, Test7) {
     }
     EXPECT_EQ(perturbations.size(), 5);
   }
-}
\ No newline at end of file
+}
+// SupercellOrbitSiteTable gives the same distinct cluster sites as
+// orbits_as_indices, for each background in a supercell
+TEST_F(FCCBinaryPerturbationsTest, Test8) {
+  using namespace clust;
+
+  Eigen::Matrix3d motif_L;
+  // conventional 4-atom fcc supercell
+  motif_L.col(0) << 4., 0., 0.;
+  motif_L.col(1) << 0., 4., 0.;
+  motif_L.col(2) << 0., 0., 4.;
+  auto motif_supercell =
+      std::make_shared<config::Supercell const>(prim, xtal::Lattice(motif_L));
+
+  // L12 config
+  config::Configuration motif(motif_supercell);
+  motif.dof_values.occupation(0) = 1;
+
+  Eigen::Matrix3d L;
+  L.col(0) << 4., 0., 0.;
+  L.col(1) << 0., 4., 0.;
+  L.col(2) << 0., 0., 8.;
+  supercell = std::make_shared<config::Supercell const>(prim, xtal::Lattice(L));
+
+  std::vector<std::set<clust::IntegralCluster>> orbits;
+  for (auto const &cluster :
+       {clust::IntegralCluster({{0, 0, 0, 0}}),
+        clust::IntegralCluster({{0, 0, 0, 0}, {0, 1, 0, 0}}),
+        clust::IntegralCluster({{0, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}})}) {
+    orbits.emplace_back(make_prim_periodic_orbit(
+        cluster, prim->sym_info.unitcellcoord_symgroup_rep));
+  }
+  auto orbits_as_indices = clust::make_orbits_as_indices(
+      orbits, supercell->unitcellcoord_index_converter);
+  config::SupercellOrbitSiteTable orbit_site_table(supercell, orbits);
+  EXPECT_EQ(orbit_site_table.n_orbits(), orbits.size());
+  EXPECT_EQ(orbit_site_table.n_translations, 8);
+  for (Index o = 0; o < orbits.size(); ++o) {
+    EXPECT_EQ(orbit_site_table.orbit_size(o), orbits[o].size());
+  }
+
+  std::vector<config::Configuration> backgrounds(
+      {config::Configuration(supercell),
+       config::copy_configuration(motif, supercell)});
+  for (auto const &background : backgrounds) {
+    EXPECT_EQ(make_distinct_cluster_sites(background, orbit_site_table),
+              make_distinct_cluster_sites(background, orbits_as_indices));
+  }
+
+  // translations are required
+  config::SupercellOrbitSiteTable untranslated(supercell, orbits, false);
+  EXPECT_THROW(make_distinct_cluster_sites(backgrounds[0], untranslated),
+               std::runtime_error);
+}
+
+TEST_F(FCCBinaryPerturbationsTest, ForEachPeriodicTest) {
+  Eigen::Matrix3d motif_L;
+  // conventional 4-atom fcc supercell
+  motif_L.col(0) << 4., 0., 0.;
+  motif_L.col(1) << 0., 4., 0.;
+  motif_L.col(2) << 0., 0., 4.;
+  auto motif_supercell =
+      std::make_shared<config::Supercell const>(prim, xtal::Lattice(motif_L));
+
+  // L12 config
+  config::Configuration motif(motif_supercell);
+  motif.dof_values.occupation(0) = 1;
+
+  Eigen::Matrix3d L;
+  L.col(0) << 4., 0., 0.;
+  L.col(1) << 0., 4., 0.;
+  L.col(2) << 0., 0., 8.;
+  supercell = std::make_shared<config::Supercell const>(prim, xtal::Lattice(L));
+
+  std::vector<std::set<clust::IntegralCluster>> orbits;
+  for (auto const &cluster :
+       {clust::IntegralCluster({{0, 0, 0, 0}}),
+        clust::IntegralCluster({{0, 0, 0, 0}, {0, 1, 0, 0}})}) {
+    orbits.emplace_back(make_prim_periodic_orbit(
+        cluster, prim->sym_info.unitcellcoord_symgroup_rep));
+  }
+  config::SupercellOrbitSiteTable orbit_site_table(supercell, orbits);
+
+  // expected: accumulate over distinct backgrounds
+  std::set<config::Configuration> expected;
+  for (auto const &equivs :
+       config::make_all_super_configurations_by_subsets(motif, supercell)) {
+    auto perturbations = config::make_distinct_perturbations(
+        equivs[0], make_distinct_cluster_sites(equivs[0], orbit_site_table));
+    expected.insert(perturbations.begin(), perturbations.end());
+  }
+
+  // memory only
+  {
+    std::vector<config::Configuration> found;
+    config::ExternalConfigurationSet distinct(supercell);
+    Index n = config::for_each_distinct_periodic_perturbation(
+        motif, orbit_site_table,
+        [&](config::Configuration const &x) { found.push_back(x); }, distinct);
+    EXPECT_EQ(n, expected.size());
+    EXPECT_EQ(std::set<config::Configuration>(found.begin(), found.end()),
+              expected);
+    EXPECT_EQ(distinct.n_runs(), 0);
+  }
+
+  // spill to run files
+  fs::path spill_dir = fs::temp_directory_path() / "casm_perturbations_test";
+  fs::create_directories(spill_dir);
+  {
+    std::vector<config::Configuration> found;
+    config::ExternalConfigurationSet distinct(supercell, spill_dir, 2);
+    Index n = config::for_each_distinct_periodic_perturbation(
+        motif, orbit_site_table,
+        [&](config::Configuration const &x) { found.push_back(x); }, distinct);
+    EXPECT_EQ(n, expected.size());
+    EXPECT_EQ(found.size(), expected.size());
+    EXPECT_EQ(std::set<config::Configuration>(found.begin(), found.end()),
+              expected);
+    EXPECT_GT(distinct.n_runs(), 0);
+    for (auto const &x : expected) {
+      EXPECT_TRUE(distinct.contains(x));
+    }
+  }
+  EXPECT_TRUE(fs::is_empty(spill_dir));
+  fs::remove_all(spill_dir);
+}
@@ -0,0 +1,120 @@
+#include "casm/configuration/occ_events/CompactOccEvent.hh"
+
+#include <algorithm>
+
+#include "casm/configuration/group/Group.hh"
+#include "casm/configuration/occ_events/OccEvent.hh"
+#include "casm/configuration/occ_events/OccEventRep.hh"
+#include "casm/configuration/occ_events/OccSystem.hh"
+#include "casm/configuration/occ_events/orbits.hh"
+#include "casm/configuration/sym_info/factor_group.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+// FCC binary tests
+class FCCBinaryCompactOccEventTest : public testing::Test {
+ protected:
+  std::shared_ptr<xtal::BasicStructure const> prim;
+  std::shared_ptr<occ_events::SymGroup const> factor_group;
+  std::vector<occ_events::OccEventRep> occevent_symgroup_rep;
+  std::unique_ptr<occ_events::OccSystem> system;
+
+  FCCBinaryCompactOccEventTest() {
+    prim =
+        std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+    factor_group = sym_info::make_factor_group(*prim);
+    occevent_symgroup_rep =
+        occ_events::make_occevent_symgroup_rep(factor_group->element, *prim);
+    system = std::make_unique<occ_events::OccSystem>(
+        prim,
+        occ_events::make_chemical_name_list(*prim, factor_group->element));
+  }
+};
+
+TEST_F(FCCBinaryCompactOccEventTest, Test1) {
+  using namespace CASM::occ_events;
+
+  xtal::UnitCellCoord site0(0, 0, 0, 0);
+  xtal::UnitCellCoord site1(0, 1, 0, 0);
+
+  OccEvent occ_event(
+      {OccTrajectory({system->make_molecule_position(site0, "B"),
+                      system->make_molecule_position(site1, "B")}),
+       OccTrajectory({system->make_atom_position(site1, "A"),
+                      system->make_atom_position(site0, "A")}),
+       OccTrajectory({system->make_molecule_in_resevoir_position("A"),
+                      system->make_molecule_position(site0, "A")})});
+
+  CompactOccEvent compact(occ_event);
+  EXPECT_EQ(compact.size(), 3);
+  EXPECT_EQ(compact.data().size(),
+            1 + 3 * (1 + 2 * CompactOccEvent::position_width));
+  EXPECT_EQ(compact.to_occevent(), occ_event);
+
+  // translate
+  CompactOccEvent translated(occ_event);
+  translated += xtal::UnitCell(1, 2, 3);
+  EXPECT_EQ(translated.to_occevent(), occ_event + xtal::UnitCell(1, 2, 3));
+  translated -= xtal::UnitCell(1, 2, 3);
+  EXPECT_EQ(translated, compact);
+
+  // hash
+  CompactOccEventHash hash;
+  EXPECT_EQ(hash(translated), hash(compact));
+
+  // from packed values
+  EXPECT_EQ(CompactOccEvent(compact.data()), compact);
+  std::vector<std::int32_t> truncated(compact.data().begin(),
+                                      compact.data().end() - 1);
+  EXPECT_THROW(CompactOccEvent{truncated}, std::runtime_error);
+
+  // empty
+  EXPECT_EQ(CompactOccEvent().size(), 0);
+  EXPECT_EQ(CompactOccEvent().to_occevent(), OccEvent());
+  EXPECT_EQ(CompactOccEvent(OccEvent()), CompactOccEvent());
+}
+
+// orbits converted to compact form are sorted, and compare consistently
+// with OccEvent
+TEST_F(FCCBinaryCompactOccEventTest, Test2) {
+  using namespace CASM::occ_events;
+
+  xtal::UnitCellCoord site0(0, 0, 0, 0);
+  xtal::UnitCellCoord site1(0, 1, 0, 0);
+  xtal::UnitCellCoord site2(0, 0, 1, 0);
+
+  std::vector<OccEvent> prototypes(
+      {OccEvent(
+           {OccTrajectory({system->make_molecule_position(site0, "B"),
+                           system->make_molecule_position(site1, "B")}),
+            OccTrajectory({system->make_molecule_position(site1, "A"),
+                           system->make_molecule_position(site0, "A")})}),
+       OccEvent(
+           {OccTrajectory({system->make_molecule_position(site0, "B"),
+                           system->make_molecule_position(site1, "B")}),
+            OccTrajectory({system->make_molecule_position(site1, "A"),
+                           system->make_molecule_position(site2, "A")}),
+            OccTrajectory({system->make_molecule_position(site2, "A"),
+                           system->make_molecule_position(site0, "A")})})});
+
+  std::vector<OccEvent> all;
+  for (auto const &prototype : prototypes) {
+    std::set<OccEvent> orbit =
+        make_prim_periodic_orbit(prototype, occevent_symgroup_rep);
+    all.insert(all.end(), orbit.begin(), orbit.end());
+  }
+  std::vector<CompactOccEvent> all_compact = make_compact_occevents(all);
+  EXPECT_TRUE(std::is_sorted(all_compact.begin(), all_compact.end()));
+  EXPECT_EQ(make_occevents(all_compact), all);
+
+  for (Index i = 0; i < all.size(); ++i) {
+    for (Index j = 0; j < all.size(); ++j) {
+      EXPECT_EQ(all[i] < all[j], all_compact[i] < all_compact[j]);
+      EXPECT_EQ(all[i] == all[j], all_compact[i] == all_compact[j]);
+    }
+  }
+}
@@ -1,3 +1,4 @@
+#include "casm/configuration/ProgressMonitor.hh"
 #include "casm/configuration/group/Group.hh"
 #include "casm/configuration/occ_events/OccEventCounter.hh"
 #include "casm/configuration/occ_events/OccEventRep.hh"
@@ -155,6 +156,36 @@ TEST_F(FCCBinaryOccEventCounterTest, Test2) {
   EXPECT_EQ(prototypes.size(), 4);
 }
 
+// parallel generation over prototype clusters gives the same result
+TEST_F(FCCBinaryOccEventCounterTest, Test3) {
+  using namespace CASM::occ_events;
+
+  // clang-format off
+  std::vector<clust::IntegralCluster> clusters({
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0)}),
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 1, -1)}),
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0),
+          xtal::UnitCellCoord(0, 0, 1, 0)})});
+  // clang-format on
+
+  OccEventCounterParameters params;
+  params.allow_subcluster_events = true;
+
+  std::vector<OccEvent> expected = make_prim_periodic_occevent_prototypes(
+      system, clusters, occevent_symgroup_rep, params);
+  for (Index n_threads : {2, 3, 8, 0}) {
+    std::vector<OccEvent> prototypes = make_prim_periodic_occevent_prototypes(
+        system, clusters, occevent_symgroup_rep, params, {}, n_threads);
+    EXPECT_EQ(prototypes, expected);
+  }
+}
+
 TEST(OccEventCounterParametersJsonIO, Test1) {
   occ_events::OccEventCounterParameters params;
   _check_json_io(params);
@@ -172,4 +203,203 @@ TEST(OccEventCounterParametersJsonIO, Test1) {
   params.min_cluster_size = 2;
   params.max_cluster_size = 4;
   _check_json_io(params);
+
+  params = occ_events::OccEventCounterParameters();
+  params.n_shards = 3;
+  params.shard_index = 2;
+  _check_json_io(params);
+
+  jsonParser json;
+  json["n_shards"] = 2;
+  json["shard_index"] = 2;
+  InputParser<occ_events::OccEventCounterParameters> parser(json);
+  EXPECT_FALSE(parser.valid());
+}
+
+TEST_F(FCCBinaryOccEventCounterTest, ResumeTest1) {
+  using namespace CASM::occ_events;
+
+  // clang-format off
+  std::vector<clust::IntegralCluster> clusters({
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0)}),
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0),
+          xtal::UnitCellCoord(0, 0, 1, 0)})});
+  // clang-format on
+  OccEventCounterParameters params;
+  params.allow_subcluster_events = true;
+
+  std::vector<OccEvent> events;
+  std::vector<OccEventCounterState> states;
+  OccEventCounter counter(system, clusters, params);
+  while (!counter.is_finished()) {
+    events.push_back(counter.value());
+    states.push_back(counter.state());
+    counter.advance();
+  }
+  ASSERT_GT(events.size(), 2);
+  EXPECT_EQ(counter.state().prototype_index, clusters.size());
+
+  // resume from each state, after checkpointing through JSON
+  for (Index i = 0; i < events.size(); ++i) {
+    jsonParser json;
+    to_json(states[i], json);
+    InputParser<OccEventCounterState> parser(json);
+    ASSERT_TRUE(parser.valid());
+
+    OccEventCounter resumed(system, clusters, params, *parser.value);
+    Index j = i;
+    while (!resumed.is_finished()) {
+      ASSERT_LT(j, events.size());
+      EXPECT_TRUE(resumed.value() == events[j]);
+      ++j;
+      resumed.advance();
+    }
+    EXPECT_EQ(j, events.size());
+  }
+
+  // resume from the finished state
+  OccEventCounter resumed(system, clusters, params, counter.state());
+  EXPECT_TRUE(resumed.is_finished());
+}
+
+// split counters generate the same events, in the same order
+TEST_F(FCCBinaryOccEventCounterTest, SplitTest1) {
+  using namespace CASM::occ_events;
+
+  // clang-format off
+  std::vector<clust::IntegralCluster> clusters({
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0)}),
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0),
+          xtal::UnitCellCoord(0, 0, 1, 0)})});
+  // clang-format on
+  OccEventCounterParameters params;
+  params.allow_subcluster_events = true;
+
+  std::vector<OccEvent> expected;
+  OccEventCounter counter(system, clusters, params);
+  EXPECT_EQ(counter.end_level(), 4);
+  while (!counter.is_finished()) {
+    expected.push_back(counter.value());
+    counter.advance();
+  }
+  ASSERT_GT(expected.size(), 2);
+
+  auto collect = [](OccEventCounter &c, std::vector<OccEvent> &events) {
+    while (!c.is_finished()) {
+      events.push_back(c.value());
+      c.advance();
+    }
+  };
+
+  for (Index i = 0; i < expected.size(); ++i) {
+    for (Index level = 0; level < 4; ++level) {
+      auto progress = std::make_shared<config::ProgressMonitor>();
+      progress->begin("split", clusters.size());
+      OccEventCounterParameters split_params = params;
+      split_params.progress = progress;
+      OccEventCounter first(system, clusters, split_params);
+      std::vector<OccEvent> events;
+      for (Index j = 0; j < i; ++j) {
+        events.push_back(first.value());
+        first.advance();
+      }
+      std::unique_ptr<OccEventCounter> second = first.split(level);
+      EXPECT_EQ(first.end_level(), level);
+      EXPECT_THROW(first.state(), std::runtime_error);
+      EXPECT_THROW(first.split(level), std::runtime_error);
+
+      // split the second counter again, at its outer-most level
+      std::unique_ptr<OccEventCounter> third;
+      if (!second->is_finished()) {
+        third = second->split(3);
+      }
+      collect(first, events);
+      collect(*second, events);
+      if (third) {
+        collect(*third, events);
+      }
+      EXPECT_TRUE(events == expected);
+      EXPECT_EQ(progress->n_done(), clusters.size());
+    }
+  }
+}
+
+// sharded generation over prototype clusters gives the same result
+TEST_F(FCCBinaryOccEventCounterTest, ShardTest1) {
+  using namespace CASM::occ_events;
+
+  // clang-format off
+  std::vector<clust::IntegralCluster> clusters({
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0)}),
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 1, -1)}),
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0),
+          xtal::UnitCellCoord(0, 0, 1, 0)})});
+  // clang-format on
+
+  OccEventCounterParameters params;
+  params.allow_subcluster_events = true;
+
+  std::vector<OccEvent> expected_events;
+  OccEventCounter counter(system, clusters, params);
+  while (!counter.is_finished()) {
+    expected_events.push_back(counter.value());
+    counter.advance();
+  }
+  std::vector<OccEvent> expected = make_prim_periodic_occevent_prototypes(
+      system, clusters, occevent_symgroup_rep, params);
+
+  for (Index n_shards : {1, 2, 3, 5}) {
+    Index n_events = 0;
+    std::vector<OccEvent> prototypes;
+    for (Index shard_index = 0; shard_index < n_shards; ++shard_index) {
+      OccEventCounterParameters shard_params = params;
+      shard_params.n_shards = n_shards;
+      shard_params.shard_index = shard_index;
+
+      // counter visits the events on the shard's clusters
+      OccEventCounter shard_counter(system, clusters, shard_params);
+      while (!shard_counter.is_finished()) {
+        auto const &cluster = shard_counter.data()->cluster;
+        Index i = std::find(clusters.begin(), clusters.end(), cluster) -
+                  clusters.begin();
+        EXPECT_EQ(i % n_shards, shard_index);
+        EXPECT_TRUE(std::find(expected_events.begin(), expected_events.end(),
+                              shard_counter.value()) !=
+                    expected_events.end());
+        ++n_events;
+        shard_counter.advance();
+      }
+
+      for (auto const &event : make_prim_periodic_occevent_prototypes(
+               system, clusters, occevent_symgroup_rep, shard_params)) {
+        prototypes.push_back(event);
+      }
+    }
+    EXPECT_EQ(n_events, expected_events.size());
+    ASSERT_EQ(prototypes.size(), expected.size());
+    for (auto const &event : prototypes) {
+      EXPECT_TRUE(std::find(expected.begin(), expected.end(), event) !=
+                  expected.end());
+    }
+  }
+
+  OccEventCounterParameters invalid_params = params;
+  invalid_params.n_shards = 2;
+  invalid_params.shard_index = 2;
+  EXPECT_THROW(OccEventCounter(system, clusters, invalid_params),
+               std::runtime_error);
 }
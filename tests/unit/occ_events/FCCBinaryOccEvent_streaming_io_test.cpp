@@ -0,0 +1,168 @@
+#include <sstream>
+
+#include "casm/configuration/clusterography/IntegralCluster.hh"
+#include "casm/configuration/occ_events/OccEvent.hh"
+#include "casm/configuration/occ_events/OccEventCounter.hh"
+#include "casm/configuration/occ_events/OccSystem.hh"
+#include "casm/configuration/occ_events/definitions.hh"
+#include "casm/configuration/occ_events/io/binary/OccEvent_binary_io.hh"
+#include "casm/configuration/occ_events/io/json/OccEvent_jsonl_io.hh"
+#include "casm/configuration/sym_info/factor_group.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+// FCC binary tests
+class FCCBinaryOccEventStreamingIOTest : public testing::Test {
+ protected:
+  std::shared_ptr<xtal::BasicStructure const> prim;
+  std::shared_ptr<occ_events::SymGroup const> factor_group;
+  std::shared_ptr<occ_events::OccSystem const> system;
+  std::vector<clust::IntegralCluster> clusters;
+
+  FCCBinaryOccEventStreamingIOTest() {
+    prim =
+        std::make_shared<xtal::BasicStructure const>(test::FCC_binary_prim());
+    factor_group = sym_info::make_factor_group(*prim);
+    system = std::make_shared<occ_events::OccSystem const>(
+        prim,
+        occ_events::make_chemical_name_list(*prim, factor_group->element));
+    clusters = {clust::IntegralCluster({xtal::UnitCellCoord(0, 0, 0, 0),
+                                        xtal::UnitCellCoord(0, 1, 0, 0),
+                                        xtal::UnitCellCoord(0, 0, 1, 0)})};
+  }
+
+  std::vector<occ_events::OccEvent> make_events() const {
+    occ_events::OccEventCounterParameters params;
+    occ_events::OccEventCounter counter(system, clusters, params);
+    std::vector<occ_events::OccEvent> events;
+    while (!counter.is_finished()) {
+      events.push_back(counter.value());
+      counter.advance();
+    }
+    return events;
+  }
+};
+
+TEST_F(FCCBinaryOccEventStreamingIOTest, JsonLinesTest) {
+  std::vector<occ_events::OccEvent> expected = make_events();
+  ASSERT_EQ(expected.size(), 10);
+
+  // write as the counter produces events
+  std::stringstream ss;
+  OccEventJsonLinesWriter writer(ss, system);
+  occ_events::OccEventCounter counter(system, clusters,
+                                      occ_events::OccEventCounterParameters());
+  EXPECT_EQ(writer.write(counter), expected.size());
+  EXPECT_EQ(writer.n_written(), expected.size());
+
+  // read all
+  {
+    std::stringstream in(ss.str());
+    OccEventJsonLinesReader reader(in, system);
+    occ_events::OccEvent event;
+    std::vector<occ_events::OccEvent> found;
+    while (reader.read(event)) {
+      found.push_back(event);
+    }
+    EXPECT_EQ(found, expected);
+    EXPECT_EQ(reader.index(), expected.size());
+  }
+
+  // count
+  {
+    std::stringstream in(ss.str());
+    EXPECT_EQ(OccEventJsonLinesReader::count(in), expected.size());
+  }
+
+  // read from offset
+  {
+    std::stringstream in(ss.str());
+    OccEventJsonLinesReader reader(in, system, 7);
+    occ_events::OccEvent event;
+    EXPECT_TRUE(reader.read(event));
+    EXPECT_EQ(event, expected[7]);
+  }
+
+  // resume an interrupted write
+  {
+    std::stringstream partial;
+    OccEventJsonLinesWriter partial_writer(partial, system);
+    for (Index i = 0; i < 4; ++i) {
+      partial_writer.write(expected[i]);
+    }
+    std::stringstream in(partial.str());
+    Index offset = OccEventJsonLinesReader::count(in);
+    OccEventJsonLinesWriter resume_writer(partial, system);
+    occ_events::OccEventCounter counter(
+        system, clusters, occ_events::OccEventCounterParameters());
+    EXPECT_EQ(resume_writer.write(counter, offset), expected.size() - 4);
+    EXPECT_EQ(partial.str(), ss.str());
+  }
+}
+
+TEST_F(FCCBinaryOccEventStreamingIOTest, BinaryTest) {
+  std::vector<occ_events::OccEvent> expected = make_events();
+
+  // write as the counter produces events
+  std::stringstream ss;
+  OccEventBinaryWriter writer(ss);
+  occ_events::OccEventCounter counter(system, clusters,
+                                      occ_events::OccEventCounterParameters());
+  EXPECT_EQ(writer.write(counter), expected.size());
+
+  // read all
+  {
+    std::stringstream in(ss.str());
+    OccEventBinaryReader reader(in);
+    occ_events::OccEvent event;
+    std::vector<occ_events::OccEvent> found;
+    while (reader.read(event)) {
+      found.push_back(event);
+    }
+    EXPECT_EQ(found, expected);
+  }
+
+  // read from offset
+  {
+    std::stringstream in(ss.str());
+    OccEventBinaryReader reader(in, 7);
+    occ_events::OccEvent event;
+    EXPECT_TRUE(reader.read(event));
+    EXPECT_EQ(event, expected[7]);
+    EXPECT_EQ(reader.index(), 8);
+  }
+
+  // an incomplete final record is the end of the stream
+  {
+    std::string data = ss.str();
+    std::stringstream in(data.substr(0, data.size() - 3));
+    EXPECT_EQ(OccEventBinaryReader::count(in), expected.size() - 1);
+  }
+
+  // resume an interrupted write
+  {
+    std::stringstream partial;
+    OccEventBinaryWriter partial_writer(partial);
+    for (Index i = 0; i < 4; ++i) {
+      partial_writer.write(expected[i]);
+    }
+    std::stringstream in(partial.str());
+    Index offset = OccEventBinaryReader::count(in);
+    EXPECT_EQ(offset, 4);
+    OccEventBinaryWriter resume_writer(partial, false);
+    occ_events::OccEventCounter counter(
+        system, clusters, occ_events::OccEventCounterParameters());
+    resume_writer.write(counter, offset);
+    EXPECT_EQ(partial.str(), ss.str());
+  }
+
+  // invalid header
+  {
+    std::stringstream in("not an event file");
+    EXPECT_THROW(OccEventBinaryReader reader(in), std::runtime_error);
+  }
+}
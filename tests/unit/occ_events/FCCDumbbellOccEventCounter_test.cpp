@@ -1,3 +1,4 @@
+#include "casm/configuration/clusterography/orbits.hh"
 #include "casm/configuration/group/Group.hh"
 #include "casm/configuration/occ_events/OccEventCounter.hh"
 #include "casm/configuration/occ_events/OccEventRep.hh"
@@ -8,6 +9,7 @@
 #include "casm/crystallography/BasicStructure.hh"
 #include "casm/crystallography/SymInfo.hh"
 #include "casm/crystallography/UnitCellCoord.hh"
+#include "casm/crystallography/UnitCellCoordRep.hh"
 #include "gtest/gtest.h"
 #include "teststructures.hh"
 
@@ -197,3 +199,202 @@ TEST_F(FCCDumbbellOccEventCounterTest, Test2) {
 
   EXPECT_EQ(prototypes.size(), 5);
 }
+
+// occupations skipped using count criteria bounds (the default) give the
+// same events as checking every occupation (when saving state info)
+TEST_F(FCCDumbbellOccEventCounterTest, Test3) {
+  using namespace CASM::occ_events;
+
+  // clang-format off
+  std::vector<clust::IntegralCluster> clusters({
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0)}),
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0),
+          xtal::UnitCellCoord(0, 0, 1, 0)})});
+  // clang-format on
+
+  auto make_events = [&](OccEventCounterParameters const &params) {
+    OccEventCounter counter(system, clusters, params);
+    std::vector<OccEvent> events;
+    while (!counter.is_finished()) {
+      events.push_back(counter.value());
+      counter.advance();
+    }
+    return events;
+  };
+
+  auto check = [&](OccEventCounterParameters params) {
+    std::vector<OccEvent> events = make_events(params);
+    params.save_state_info = true;
+    EXPECT_EQ(events, make_events(params));
+    return events.size();
+  };
+
+  {
+    OccEventCounterParameters params;
+    params.required_init_orientation_count = to_VectorXi({1, 0, 0, 1});
+    params.required_final_orientation_count = to_VectorXi({1, 0, 0, 1});
+    EXPECT_GT(check(params), 0);
+  }
+
+  {
+    OccEventCounterParameters params;
+    params.required_init_orientation_count = to_VectorXi({0, 1, 1, 0});
+    EXPECT_GT(check(params), 0);
+  }
+
+  {
+    OccEventCounterParameters params;
+    params.min_init_molecule_count = to_VectorXi({1, 1});
+    params.max_final_atom_count = to_VectorXi({4});
+    EXPECT_GT(check(params), 0);
+  }
+
+  {
+    OccEventCounterParameters params;
+    params.required_init_molecule_count = to_VectorXi({3, 0});
+    params.require_molecule_conservation = true;
+    check(params);
+  }
+}
+
+// trajectories memoized by sublattice and occupation pattern (the default)
+// give the same events as checking the trajectories on every cluster
+TEST_F(FCCDumbbellOccEventCounterTest, Test4) {
+  using namespace CASM::occ_events;
+
+  // clang-format off
+  std::vector<clust::IntegralCluster> clusters({
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0)}),
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 1, -1)}),
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0),
+          xtal::UnitCellCoord(0, 0, 1, 0)})});
+  // clang-format on
+
+  auto make_events = [&](OccEventCounterParameters const &params) {
+    OccEventCounter counter(system, clusters, params);
+    std::vector<OccEvent> events;
+    while (!counter.is_finished()) {
+      events.push_back(counter.value());
+      counter.advance();
+    }
+    return events;
+  };
+
+  auto check = [&](OccEventCounterParameters params) {
+    std::vector<OccEvent> events = make_events(params);
+    params.memoize_trajectories = false;
+    EXPECT_EQ(events, make_events(params));
+    return events.size();
+  };
+
+  {
+    OccEventCounterParameters params;
+    params.required_init_orientation_count = to_VectorXi({1, 0, 0, 1});
+    params.required_final_orientation_count = to_VectorXi({1, 0, 0, 1});
+    EXPECT_GT(check(params), 0);
+  }
+
+  {
+    OccEventCounterParameters params;
+    params.skip_direct_exchange = false;
+    params.required_init_orientation_count = to_VectorXi({0, 1, 1, 0});
+    EXPECT_GT(check(params), 0);
+  }
+}
+
+// initial occupations reduced by cluster group give the same distinct
+// events as counting all initial occupations
+TEST_F(FCCDumbbellOccEventCounterTest, Test5) {
+  using namespace CASM::occ_events;
+
+  // clang-format off
+  std::vector<clust::IntegralCluster> clusters({
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0)}),
+      clust::IntegralCluster({
+          xtal::UnitCellCoord(0, 0, 0, 0),
+          xtal::UnitCellCoord(0, 1, 0, 0),
+          xtal::UnitCellCoord(0, 0, 1, 0)})});
+  // clang-format on
+
+  std::vector<xtal::UnitCellCoordRep> unitcellcoord_symgroup_rep;
+  for (auto const &rep : occevent_symgroup_rep) {
+    unitcellcoord_symgroup_rep.push_back(rep.unitcellcoord_rep);
+  }
+  std::vector<std::set<clust::IntegralCluster>> orbits;
+  std::vector<std::vector<std::shared_ptr<SymGroup const>>> cluster_groups;
+  for (auto const &cluster : clusters) {
+    orbits.push_back(
+        clust::make_prim_periodic_orbit(cluster, unitcellcoord_symgroup_rep));
+    cluster_groups.push_back(clust::make_cluster_groups(
+        orbits.back(), factor_group, prim->lattice().lat_column_mat(),
+        unitcellcoord_symgroup_rep));
+  }
+  std::vector<clust::IntegralCluster> prototypes;
+  for (auto const &orbit : orbits) {
+    prototypes.push_back(*orbit.begin());
+  }
+
+  auto make_prototypes = [&](OccEventCounter &counter, Index &n_events) {
+    PrimPeriodicOccEventOrbitCache cache(occevent_symgroup_rep);
+    n_events = 0;
+    while (!counter.is_finished()) {
+      cache.orbit_index(counter.value());
+      ++n_events;
+      counter.advance();
+    }
+    std::set<OccEvent> result;
+    for (auto const &orbit : cache.orbits()) {
+      result.insert(*orbit.rbegin());
+    }
+    return result;
+  };
+
+  auto check = [&](OccEventCounterParameters const &params,
+                   Index &n_reduced) {
+    Index n_events;
+    OccEventCounter counter(system, prototypes, params);
+    std::set<OccEvent> expected = make_prototypes(counter, n_events);
+    OccEventCounter reduced_counter(system, orbits, cluster_groups,
+                                    occevent_symgroup_rep, params);
+    EXPECT_EQ(make_prototypes(reduced_counter, n_reduced), expected);
+    EXPECT_LE(n_reduced, n_events);
+    return n_events;
+  };
+
+  Index n_reduced;
+  Index n_events;
+  {
+    OccEventCounterParameters params;
+    params.required_init_molecule_count = to_VectorXi({1, 1});
+    n_events = check(params, n_reduced);
+    EXPECT_LT(n_reduced, n_events);
+  }
+
+  {
+    OccEventCounterParameters params;
+    params.allow_reverse_occ = true;
+    params.required_init_molecule_count = to_VectorXi({1, 1});
+    n_events = check(params, n_reduced);
+    EXPECT_LT(n_reduced, n_events);
+  }
+
+  {
+    // orientation counts may not be invariant, so are not reduced
+    OccEventCounterParameters params;
+    params.required_init_orientation_count = to_VectorXi({1, 0, 0, 1});
+    n_events = check(params, n_reduced);
+    EXPECT_EQ(n_reduced, n_events);
+  }
+}
@@ -1,11 +1,13 @@
 #include "casm/configuration/occ_events/OccSystem.hh"
 
 #include "casm/configuration/group/Group.hh"
+#include "casm/configuration/occ_events/OccEvent.hh"
 #include "casm/configuration/occ_events/OccPosition.hh"
 #include "casm/configuration/occ_events/definitions.hh"
 #include "casm/configuration/sym_info/factor_group.hh"
 #include "casm/crystallography/BasicStructure.hh"
 #include "casm/crystallography/UnitCellCoord.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
 #include "gtest/gtest.h"
 #include "teststructures.hh"
 
@@ -114,6 +116,45 @@ TEST(OccSystemTest, Test3) {
             std::vector<std::string>({"A2.x", "A2.y", "A2.z"}));
 }
 
+TEST(OccSystemTest, FlattenedTables) {
+  auto prim =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_dimer_prim());
+  std::shared_ptr<occ_events::SymGroup const> factor_group =
+      sym_info::make_factor_group(*prim);
+  occ_events::OccSystem system(
+      prim, occ_events::make_chemical_name_list(*prim, factor_group->element));
+
+  Index n_sublat = prim->basis().size();
+  ASSERT_EQ(system.occupant_offset.size(), n_sublat + 1);
+  for (Index b = 0; b < n_sublat; ++b) {
+    xtal::UnitCellCoord site(b, 0, 0, 0);
+    Index n_occupants = prim->basis()[b].occupant_dof().size();
+    EXPECT_EQ(system.occupant_offset[b + 1] - system.occupant_offset[b],
+              n_occupants);
+    for (Index occ = 0; occ < n_occupants; ++occ) {
+      Index f = system.flat_occupant_index(b, occ);
+      Index chemical_index = system.occupant_to_chemical_index[b][occ];
+      EXPECT_EQ(system.flat_occupant_to_chemical_index[f], chemical_index);
+      EXPECT_EQ(system.flat_occupant_to_orientation_index[f],
+                system.occupant_to_orientation_index[b][occ]);
+      EXPECT_EQ(bool(system.flat_occupant_is_vacancy[f]),
+                bool(system.is_vacancy_list[chemical_index]));
+      EXPECT_EQ(bool(system.flat_occupant_is_indivisible[f]),
+                bool(system.is_indivisible_chemical_list[chemical_index]));
+
+      auto const &names = system.atom_position_to_name_index[b][occ];
+      EXPECT_EQ(system.atom_position_offset[f + 1] -
+                    system.atom_position_offset[f],
+                names.size());
+      for (Index i = 0; i < names.size(); ++i) {
+        occ_events::OccPosition p = system.make_atom_position(site, occ, i);
+        EXPECT_EQ(system.get_atom_name_index(p), names[i]);
+        EXPECT_EQ(system.get_chemical_index(p), chemical_index);
+      }
+    }
+  }
+}
+
 TEST(MakeResevoirPositionTest, Test1) {
   auto prim =
       std::make_shared<xtal::BasicStructure const>(test::FCC_dimer_prim());
@@ -194,3 +235,58 @@ TEST(MakeAtomicComponentPositionTest, Test1) {
   EXPECT_EQ(occ_position.occupant_index, 1);
   EXPECT_EQ(occ_position.atom_position_index, 1);
 }
+
+TEST(GetCartesianCoordinatesTest, Test1) {
+  auto prim =
+      std::make_shared<xtal::BasicStructure const>(test::FCC_dimer_prim());
+  std::shared_ptr<occ_events::SymGroup const> factor_group =
+      sym_info::make_factor_group(*prim);
+  occ_events::OccSystem system(
+      prim, occ_events::make_chemical_name_list(*prim, factor_group->element));
+
+  // dimer rotation and translation, with a position in the resevoir
+  occ_events::OccEvent event(
+      {occ_events::OccTrajectory(
+           {system.make_atom_position({0, 0, 0, 0}, "A2.x", 0),
+            system.make_atom_position({0, 1, 0, 0}, "A2.y", 1)}),
+       occ_events::OccTrajectory(
+           {system.make_atom_position({0, 0, 0, 0}, "A2.x", 1),
+            system.make_molecule_in_resevoir_position("A2")})});
+
+  std::vector<occ_events::OccPosition> positions;
+  for (auto const &traj : event) {
+    for (auto const &pos : traj.position) {
+      if (!pos.is_in_resevoir) {
+        positions.push_back(pos);
+      }
+    }
+  }
+  ASSERT_EQ(positions.size(), 3);
+
+  Eigen::Matrix3Xd coords = system.get_cartesian_coordinates(event);
+  ASSERT_EQ(coords.cols(), positions.size());
+  for (Index i = 0; i < positions.size(); ++i) {
+    EXPECT_TRUE(almost_equal(Eigen::Vector3d(coords.col(i)),
+                             system.get_cartesian_coordinate(positions[i]),
+                             1e-10));
+  }
+  EXPECT_TRUE(almost_equal(system.get_cartesian_coordinates(positions), coords,
+                           1e-10));
+
+  // many events
+  Eigen::VectorXl offsets;
+  Eigen::Matrix3Xd all_coords = system.get_cartesian_coordinates(
+      std::vector<occ_events::OccEvent>({event, event}), offsets);
+  ASSERT_EQ(offsets.size(), 3);
+  EXPECT_EQ(offsets(0), 0);
+  EXPECT_EQ(offsets(1), 3);
+  EXPECT_EQ(offsets(2), 6);
+  EXPECT_TRUE(almost_equal(Eigen::Matrix3Xd(all_coords.rightCols(3)), coords,
+                           1e-10));
+
+  // resevoir positions throw
+  EXPECT_THROW(system.get_cartesian_coordinates(
+                   std::vector<occ_events::OccPosition>(
+                       {system.make_molecule_in_resevoir_position("A2")})),
+               std::runtime_error);
+}
@@ -1,6 +1,7 @@
 #include "casm/configuration/occ_events/orbits.hh"
 
 #include "casm/configuration/group/Group.hh"
+#include "casm/configuration/group/orbits.hh"
 #include "casm/configuration/occ_events/OccEvent.hh"
 #include "casm/configuration/occ_events/OccEventRep.hh"
 #include "casm/configuration/occ_events/OccSystem.hh"
@@ -128,3 +129,50 @@ TEST_F(FCCBinaryOccEventOrbitTest, Test4) {
       occevent_symgroup_rep);
   EXPECT_EQ(occevent_group->element.size(), 2);
 }
+
+TEST_F(FCCBinaryOccEventOrbitTest, Test5) {
+  using namespace CASM::occ_events;
+
+  xtal::UnitCellCoord site0(0, 0, 0, 0);
+  xtal::UnitCellCoord site1(0, 1, 0, 0);
+  xtal::UnitCellCoord site2(0, 0, 1, 0);
+
+  OccEvent occ_event(
+      {OccTrajectory({system->make_molecule_position(site0, "B"),
+                      system->make_molecule_position(site1, "B")}),
+       OccTrajectory({system->make_molecule_position(site1, "A"),
+                      system->make_molecule_position(site2, "A")}),
+       OccTrajectory({system->make_molecule_position(site2, "A"),
+                      system->make_molecule_position(site0, "A")})});
+
+  std::set<OccEvent> orbit =
+      make_prim_periodic_orbit(occ_event, occevent_symgroup_rep);
+  OccEvent canonical_event = group::make_canonical_element(
+      occ_event, occevent_symgroup_rep.begin(), occevent_symgroup_rep.end(),
+      std::less<OccEvent>(), prim_periodic_occevent_copy_apply);
+
+  PrimPeriodicOccEventOrbitCache cache(occevent_symgroup_rep);
+  EXPECT_EQ(cache.canonical_form(occ_event), canonical_event);
+  EXPECT_EQ(cache.orbits().size(), 1);
+  EXPECT_EQ(cache.orbits()[0], orbit);
+
+  // equivalent events, including translated events, are found by lookup
+  OccEventHash hash;
+  for (auto const &element : orbit) {
+    OccEvent translated = element + xtal::UnitCell(1, -2, 3);
+    EXPECT_EQ(cache.orbit_index(translated), 0);
+    EXPECT_EQ(cache.canonical_form(element), canonical_event);
+    translated -= xtal::UnitCell(1, -2, 3);
+    EXPECT_EQ(hash(translated), hash(element));
+  }
+  EXPECT_EQ(cache.orbits().size(), 1);
+
+  // an event in another orbit
+  OccEvent other_event(
+      {OccTrajectory({system->make_molecule_position(site0, "B"),
+                      system->make_molecule_position(site1, "B")}),
+       OccTrajectory({system->make_molecule_position(site1, "A"),
+                      system->make_molecule_position(site0, "A")})});
+  EXPECT_EQ(cache.orbit_index(other_event), 1);
+  EXPECT_EQ(cache.orbits().size(), 2);
+}
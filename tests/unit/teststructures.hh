@@ -86,6 +86,28 @@ inline CASM::xtal::BasicStructure FCC_binary_prim() {
   return struc;
 }
 
+inline CASM::xtal::BasicStructure BCC_binary_prim() {
+  using namespace CASM;
+  using namespace CASM::xtal;
+
+  // lattice vectors as cols
+  Eigen::Matrix3d lat;
+  lat << -1.0, 1.0, 1.0, 1.0, -1.0, 1.0, 1.0, 1.0, -1.0;
+
+  BasicStructure struc{Lattice{lat}};
+  struc.set_title("BCC_binary");
+
+  Molecule A = Molecule::make_atom("A");
+  Molecule B = Molecule::make_atom("B");
+
+  struc.push_back(
+      Site(Coordinate(Eigen::Vector3d::Zero(), struc.lattice(), CART),
+           std::vector<Molecule>{A, B}));
+  struc.set_unique_names({{"A", "B"}});
+
+  return struc;
+}
+
 inline CASM::xtal::BasicStructure FCC_binary_vacancy_prim() {
   using namespace CASM;
   using namespace CASM::xtal;
@@ -232,6 +254,29 @@ inline CASM::xtal::BasicStructure SimpleCubic_ising_prim() {
   return struc;
 }
 
+inline CASM::xtal::BasicStructure FCC_binary_Cmagspin_prim() {
+  using namespace CASM;
+  using namespace CASM::xtal;
+
+  // lattice vectors as cols
+  Eigen::Matrix3d lat;
+  lat << 0.0, 2.0, 2.0, 2.0, 0.0, 2.0, 2.0, 2.0, 0.0;
+
+  BasicStructure struc{Lattice{lat}};
+  struc.set_title("FCC_binary_Cmagspin");
+
+  Molecule A = Molecule::make_atom("A");
+  Molecule B = Molecule::make_atom("B");
+  SiteDoFSet magspin_dofset{AnisoValTraits("Cmagspin")};
+  Site site{Coordinate(Eigen::Vector3d::Zero(), struc.lattice(), CART),
+            std::vector<Molecule>{A, B},
+            std::vector<SiteDoFSet>{magspin_dofset}};
+  struc.push_back(site);
+  struc.set_unique_names({{"A", "B"}});
+
+  return struc;
+}
+
 inline CASM::xtal::BasicStructure FCC_ternary_GLstrain_prim() {
   using namespace CASM;
   using namespace CASM::xtal;